@@ -83,6 +83,39 @@ private:
     typedef Benchmark INHERITED;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// This bench clips to the same antialiased path every frame, as a UI with a fixed rounded
+// viewport does, so repeated clips can be served from the cache.
+class AAClipRepeatBench : public Benchmark {
+    SkPath fClipPath;
+    SkRect fDrawRect;
+
+public:
+    AAClipRepeatBench() {
+        fClipPath.addCircle(200.5f, 200.5f, 190);
+        fClipPath.addCircle(200.5f, 200.5f, 120);
+        fClipPath.setFillType(SkPath::kEvenOdd_FillType);
+        fDrawRect.set(0, 0, 400, 400);
+    }
+
+protected:
+    const char* onGetName() override { return "aaclip_path_repeat"; }
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        this->setupPaint(&paint);
+
+        for (int i = 0; i < loops; ++i) {
+            canvas->save();
+            canvas->clipPath(fClipPath, kIntersect_SkClipOp, true);
+            canvas->drawRect(fDrawRect, paint);
+            canvas->restore();
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 // This bench tests out nested clip stacks. It is intended to simulate
 // how WebKit nests clips.
@@ -253,5 +286,6 @@ DEF_BENCH(return new AAClipBench(false, false);)
 DEF_BENCH(return new AAClipBench(false, true);)
 DEF_BENCH(return new AAClipBench(true, false);)
 DEF_BENCH(return new AAClipBench(true, true);)
+DEF_BENCH(return new AAClipRepeatBench();)
 DEF_BENCH(return new NestedAAClipBench(false);)
 DEF_BENCH(return new NestedAAClipBench(true);)
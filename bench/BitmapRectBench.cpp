@@ -44,6 +44,7 @@ class BitmapRectBench : public Benchmark {
     bool                    fSlightMatrix;
     uint8_t                 fAlpha;
     SkFilterQuality         fFilterQuality;
+    SkScalar                fScale;
     SkString                fName;
     SkRect                  fSrcR, fDstR;
 
@@ -51,10 +52,11 @@ class BitmapRectBench : public Benchmark {
     static const int kHeight = 128;
 public:
     BitmapRectBench(U8CPU alpha, SkFilterQuality filterQuality,
-                    bool slightMatrix)  {
+                    bool slightMatrix, SkScalar scale = 1)  {
         fAlpha = SkToU8(alpha);
         fFilterQuality = filterQuality;
         fSlightMatrix = slightMatrix;
+        fScale = scale;
 
         fBitmap.setInfo(SkImageInfo::MakeN32Premul(kWidth, kHeight));
     }
@@ -65,6 +67,9 @@ protected:
                      fAlpha,
                      kNone_SkFilterQuality == fFilterQuality ? "no" : "",
                      fSlightMatrix ? "trans" : "identity");
+        if (fScale != 1) {
+            fName.appendf("_scale_%g", fScale);
+        }
         return fName.c_str();
     }
 
@@ -75,7 +80,7 @@ protected:
         draw_into_bitmap(fBitmap);
 
         fSrcR.iset(0, 0, kWidth, kHeight);
-        fDstR.iset(0, 0, kWidth, kHeight);
+        fDstR.set(0, 0, kWidth * fScale, kHeight * fScale);
 
         if (fSlightMatrix) {
             // want fractional translate
@@ -113,3 +118,10 @@ DEF_BENCH(return new BitmapRectBench(0x80, kLow_SkFilterQuality, false))
 
 DEF_BENCH(return new BitmapRectBench(0xFF, kNone_SkFilterQuality, true))
 DEF_BENCH(return new BitmapRectBench(0xFF, kLow_SkFilterQuality, true))
+
+// Exact downscales, and integer upscales without filtering.
+DEF_BENCH(return new BitmapRectBench(0xFF, kLow_SkFilterQuality, false, 0.5f))
+DEF_BENCH(return new BitmapRectBench(0xFF, kLow_SkFilterQuality, false, 0.25f))
+DEF_BENCH(return new BitmapRectBench(0x80, kLow_SkFilterQuality, false, 0.5f))
+DEF_BENCH(return new BitmapRectBench(0xFF, kNone_SkFilterQuality, false, 2))
+DEF_BENCH(return new BitmapRectBench(0xFF, kNone_SkFilterQuality, false, 4))
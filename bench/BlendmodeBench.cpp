@@ -9,17 +9,22 @@
 #include "SkBlendModePriv.h"
 #include "SkCanvas.h"
 #include "SkFont.h"
+#include "SkGradientShader.h"
 #include "SkPaint.h"
 #include "SkRandom.h"
 #include "SkString.h"
 #include "SkTextBlob.h"
 
-// Benchmark that draws non-AA rects or AA text with an SkXfermode::Mode.
+// Benchmark that draws non-AA rects, AA text, or non-AA rects filled with a dithered gradient
+// with an SkXfermode::Mode.  Run these with the 565 and a8 configs to cover those blitters too;
+// dithering only has an effect on 565.
 class XfermodeBench : public Benchmark {
 public:
-    XfermodeBench(SkBlendMode mode, bool aa) : fBlendMode(mode) {
-        fAA = aa;
-        fName.printf("blendmode_%s_%s", aa ? "mask" : "rect", SkBlendMode_Name(mode));
+    enum Kind { kRect_Kind, kMask_Kind, kDitheredGradient_Kind };
+
+    XfermodeBench(SkBlendMode mode, Kind kind) : fBlendMode(mode), fKind(kind) {
+        static const char* kNames[] = { "rect", "mask", "ditherrect" };
+        fName.printf("blendmode_%s_%s", kNames[kind], SkBlendMode_Name(mode));
     }
 
 protected:
@@ -34,7 +39,7 @@ protected:
             SkPaint paint;
             paint.setBlendMode(fBlendMode);
             paint.setColor(random.nextU());
-            if (fAA) {
+            if (fKind == kMask_Kind) {
                 // Draw text to exercise AA code paths.
                 SkFont font;
                 font.setSize(random.nextRangeScalar(12, 96));
@@ -54,6 +59,13 @@ protected:
                     w,
                     h
                 );
+                if (fKind == kDitheredGradient_Kind) {
+                    SkPoint pts[] = { {rect.fLeft, rect.fTop}, {rect.fRight, rect.fBottom} };
+                    SkColor colors[] = { random.nextU(), random.nextU() };
+                    paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                                 SkShader::kClamp_TileMode));
+                    paint.setDither(true);
+                }
                 for (int j = 0; j < 1000; ++j) {
                     canvas->drawRect(rect, paint);
                 }
@@ -63,17 +75,18 @@ protected:
 
 private:
     SkBlendMode fBlendMode;
+    Kind        fKind;
     SkString    fName;
-    bool        fAA;
 
     typedef Benchmark INHERITED;
 };
 
 //////////////////////////////////////////////////////////////////////////////
 
-#define BENCH(...)                                             \
-    DEF_BENCH( return new XfermodeBench(__VA_ARGS__, true); )  \
-    DEF_BENCH( return new XfermodeBench(__VA_ARGS__, false); )
+#define BENCH(...)                                                                       \
+    DEF_BENCH( return new XfermodeBench(__VA_ARGS__, XfermodeBench::kMask_Kind); )       \
+    DEF_BENCH( return new XfermodeBench(__VA_ARGS__, XfermodeBench::kRect_Kind); )       \
+    DEF_BENCH( return new XfermodeBench(__VA_ARGS__, XfermodeBench::kDitheredGradient_Kind); )
 
 BENCH(SkBlendMode::kClear)
 BENCH(SkBlendMode::kSrc)
@@ -9,12 +9,16 @@
 #include "SkCanvas.h"
 #include "SkPath.h"
 #include "SkPathOps.h"
+#include "SkRRect.h"
 
 class ClipStrategyBench : public Benchmark {
 public:
     enum class Mode {
         kClipPath,
         kMask,
+        // Deeply nested rounded rect clips, like UI cards in scrolling containers, with several
+        // draws at the innermost level.
+        kNestedRRects,
     };
 
     ClipStrategyBench(Mode mode, size_t count)
@@ -27,8 +31,10 @@ public:
             this->forEachClipCircle([&](float x, float y, float r) {
                 fClipPath.addCircle(x, y, r);
             });
-        } else {
+        } else if (fMode == Mode::kMask) {
             fName.append("mask_");
+        } else {
+            fName.append("nested_rrects_");
         }
         fName.appendf("%zu", count);
     }
@@ -48,6 +54,11 @@ protected:
         for (int i = 0; i < loops; ++i) {
             SkAutoCanvasRestore acr(canvas, false);
 
+            if (fMode == Mode::kNestedRRects) {
+                this->drawNestedRRects(canvas, p);
+                continue;
+            }
+
             if (fMode == Mode::kClipPath) {
                 canvas->save();
                 canvas->clipPath(fClipPath, true);
@@ -63,6 +74,22 @@ protected:
     }
 
 private:
+    void drawNestedRRects(SkCanvas* canvas, const SkPaint& paint) {
+        SkRect r = SkRect::MakeWH(this->getSize().x(), this->getSize().y());
+        float inset = std::min(r.width(), r.height()) / (4 * (fCount + 1));
+        for (size_t i = 0; i < fCount; ++i) {
+            r.inset(inset, inset);
+            canvas->save();
+            canvas->clipRRect(SkRRect::MakeRectXY(r, inset, inset), true);
+        }
+        SkRect cell = SkRect::MakeXYWH(r.x(), r.y(), r.width() / 8, r.height() / 8);
+        for (int y = 0; y < 8; ++y) {
+            for (int x = 0; x < 8; ++x) {
+                canvas->drawRect(cell.makeOffset(x * cell.width(), y * cell.height()), paint);
+            }
+        }
+    }
+
     template <typename Func>
     void forEachClipCircle(Func&& func) {
         auto q = static_cast<float>(this->getSize().x()) / (fCount + 1);
@@ -89,3 +116,6 @@ DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kMask, 1  );)
 DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kMask, 5  );)
 DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kMask, 10 );)
 DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kMask, 100);)
+
+DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kNestedRRects, 5  );)
+DEF_BENCH( return new ClipStrategyBench(ClipStrategyBench::Mode::kNestedRRects, 100);)
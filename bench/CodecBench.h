@@ -11,17 +11,20 @@
 #include "Benchmark.h"
 #include "SkAutoMalloc.h"
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkImageInfo.h"
 #include "SkRefCnt.h"
 #include "SkString.h"
 
 /**
- *  Time SkCodec.
+ *  Time SkCodec.  With useExecutor, decodes with SkCodec::Options::fExecutor set to a thread
+ *  pool, to compare against the serial decode of the same image.
  */
 class CodecBench : public Benchmark {
 public:
     // Calls encoded->ref()
-    CodecBench(SkString basename, SkData* encoded, SkColorType colorType, SkAlphaType alphaType);
+    CodecBench(SkString basename, SkData* encoded, SkColorType colorType, SkAlphaType alphaType,
+               bool useExecutor = false);
 
 protected:
     const char* onGetName() override;
@@ -34,6 +37,8 @@ private:
     const SkColorType       fColorType;
     const SkAlphaType       fAlphaType;
     sk_sp<SkData>           fData;
+    const bool              fUseExecutor;
+    std::unique_ptr<SkExecutor> fExecutor;  // Set in onDelayedSetup if fUseExecutor.
     SkImageInfo             fInfo;          // Set in onDelayedSetup.
     SkAutoMalloc            fPixelStorage;
     typedef Benchmark INHERITED;
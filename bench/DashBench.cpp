@@ -173,6 +173,14 @@ static void make_cubic(SkPath* path) {
                   x0 + 600 * SK_Scalar1, y0);
 }
 
+// A chart-like polyline with many short segments.
+static void make_long_poly(SkPath* path) {
+    path->moveTo(0, 0);
+    for (int i = 1; i < 10000; ++i) {
+        path->lineTo(SkIntToScalar(i), SkIntToScalar((i * 37) % 100));
+    }
+}
+
 class MakeDashBench : public Benchmark {
     SkString fName;
     SkPath   fPath;
@@ -450,6 +458,7 @@ DEF_BENCH( return new DashBench(PARAM(gDots), 4); )
 DEF_BENCH( return new MakeDashBench(make_poly, "poly"); )
 DEF_BENCH( return new MakeDashBench(make_quad, "quad"); )
 DEF_BENCH( return new MakeDashBench(make_cubic, "cubic"); )
+DEF_BENCH( return new MakeDashBench(make_long_poly, "long_poly"); )
 DEF_BENCH( return new DashLineBench(0, false); )
 DEF_BENCH( return new DashLineBench(SK_Scalar1, false); )
 DEF_BENCH( return new DashLineBench(2 * SK_Scalar1, false); )
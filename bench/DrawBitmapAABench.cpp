@@ -60,6 +60,11 @@ DEF_BENCH( return new DrawBitmapAABench(false, SkMatrix::MakeScale(1.17f), "scal
 
 DEF_BENCH( return new DrawBitmapAABench(false, SkMatrix::MakeTrans(17.5f, 17.5f), "translate"); )
 
+// Thumbnail-style downscales by exact powers of two.
+DEF_BENCH( return new DrawBitmapAABench(false, SkMatrix::MakeScale(0.5f), "half"); )
+
+DEF_BENCH( return new DrawBitmapAABench(false, SkMatrix::MakeScale(0.25f), "quarter"); )
+
 DEF_BENCH(
     SkMatrix m;
     m.reset();
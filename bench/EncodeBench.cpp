@@ -6,8 +6,10 @@
  */
 
 #include "Benchmark.h"
+#include "CodecBench.h"
 #include "Resources.h"
 #include "SkBitmap.h"
+#include "SkData.h"
 #include "SkJpegEncoder.h"
 #include "SkPngEncoder.h"
 #include "SkWebpEncoder.h"
@@ -18,6 +20,8 @@
 //
 // There is no corresponding DecodeBench class. Decoder benchmarks are run by:
 // nanobench --benchType skcodec --images your_images_directory
+// The exception is the Codec_*_png_* benches at the bottom, which decode our own single-filter
+// PNG encodes to time each PNG unfiltering routine within a whole decode.
 
 class EncodeBench : public Benchmark {
 public:
@@ -122,4 +126,47 @@ DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 6), "PNG_6n"));
 DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 3), "PNG_3n"));
 DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 1), "PNG_1n"));
 
+DEF_BENCH(return new EncodeBench(srcs[0], PNG(kUp,    6), "PNG_6u"));
+DEF_BENCH(return new EncodeBench(srcs[0], PNG(kAvg,   6), "PNG_6a"));
+DEF_BENCH(return new EncodeBench(srcs[0], PNG(kPaeth, 6), "PNG_6p"));
+
+// mandrill_512 encoded as PNG with only the given filter, as RGB, or as RGBA with varying alpha.
+static Benchmark* png_decode_bench(SkPngEncoder::FilterFlag filter, const char* filterName,
+                                   bool alpha) {
+    SkBitmap bitmap;
+    SkAssertResult(GetResourceAsBitmap(srcs[0], &bitmap));
+    if (alpha) {
+        bitmap.setAlphaType(kUnpremul_SkAlphaType);
+        for (int y = 0; y < bitmap.height(); y++) {
+            for (int x = 0; x < bitmap.width(); x++) {
+                uint32_t* px = bitmap.getAddr32(x, y);
+                *px = (*px & 0x00FFFFFF) | (uint32_t)((x + y) & 0xFF) << 24;
+            }
+        }
+    }
+
+    SkDynamicMemoryWStream stream;
+    SkPixmap pixmap;
+    SkAssertResult(bitmap.peekPixels(&pixmap));
+    SkAssertResult(encode_png(&stream, pixmap, filter, 6));
+    sk_sp<SkData> encoded = stream.detachAsData();
+
+    return new CodecBench(SkStringPrintf("mandrill_512_png_%s%s", filterName,
+                                         alpha ? "_rgba" : "_rgb"),
+                          encoded.get(), kN32_SkColorType,
+                          alpha ? kPremul_SkAlphaType : kOpaque_SkAlphaType);
+}
+
+#define PNG_DECODE(FLAG, NAME) \
+    DEF_BENCH(return png_decode_bench(SkPngEncoder::FilterFlag::FLAG, NAME, false)); \
+    DEF_BENCH(return png_decode_bench(SkPngEncoder::FilterFlag::FLAG, NAME, true))
+
+PNG_DECODE(kNone,  "none");
+PNG_DECODE(kSub,   "sub");
+PNG_DECODE(kUp,    "up");
+PNG_DECODE(kAvg,   "avg");
+PNG_DECODE(kPaeth, "paeth");
+PNG_DECODE(kAll,   "all");
+
+#undef PNG_DECODE
 #undef PNG
@@ -11,6 +11,7 @@
 #include "GrMemoryPool.h"
 #include "SkRandom.h"
 #include "SkTDArray.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 
 #include <new>
@@ -170,8 +171,67 @@ private:
     typedef Benchmark INHERITED;
 };
 
+/**
+ * This benchmark mimics several DDL recorders running at once: each thread fills its own pool
+ * with objects and then either releases them one at a time, or destructs them and returns all of
+ * the memory at once with releaseAll().
+ */
+class GrMemoryPoolBenchThreaded : public Benchmark {
+    enum {
+        kThreads = 4,
+        M = 4 * (1 << 10),
+    };
+public:
+    GrMemoryPoolBenchThreaded(bool bulkRelease) : fBulkRelease(bulkRelease) {}
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fBulkRelease ? "grmemorypool_threaded_bulk" : "grmemorypool_threaded";
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkTaskGroup().batch(kThreads, [&](int threadIndex) {
+            GrMemoryPool pool(16384, 16384);
+            SkRandom r(threadIndex);
+            std::unique_ptr<D*[]> objects(new D*[M]);
+            for (int i = 0; i < loops; i++) {
+                uint32_t count = r.nextRangeU(0, M-1);
+                for (uint32_t j = 0; j < count; j++) {
+                    objects[j] = new (pool.allocate(sizeof(D))) D;
+                }
+                if (fBulkRelease) {
+                    for (uint32_t j = 0; j < count; j++) {
+                        objects[j]->~D();
+                    }
+                    pool.releaseAll();
+                } else {
+                    for (uint32_t j = 0; j < count; j++) {
+                        objects[j]->~D();
+                        pool.release(objects[j]);
+                    }
+                }
+            }
+        });
+    }
+
+private:
+    struct D {
+        int gStuff[10];
+    };
+
+    bool fBulkRelease;
+
+    typedef Benchmark INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new GrMemoryPoolBenchStack(); )
 DEF_BENCH( return new GrMemoryPoolBenchRandom(); )
 DEF_BENCH( return new GrMemoryPoolBenchQueue(); )
+DEF_BENCH( return new GrMemoryPoolBenchThreaded(false); )
+DEF_BENCH( return new GrMemoryPoolBenchThreaded(true); )
@@ -0,0 +1,101 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+
+#include "SkCanvas.h"
+#include "SkImage.h"
+#include "SkRandom.h"
+#include "SkSurface.h"
+
+/**
+ * Draws many distinct small images once each per frame, laid out in a grid with no overlaps, like
+ * a UI that doesn't pack its icons into a sprite sheet. Every draw becomes a GrTextureOp with its
+ * own texture, so this measures how well those get batched into few draws when the backend can
+ * sample several textures per draw (see GrCaps::imageMultitexturingSupport()).
+ */
+class GrTextureOpBench : public Benchmark {
+public:
+    enum class Mode { kDrawImage, kImageSet };
+
+    GrTextureOpBench(int imageCnt, Mode mode) : fImageCnt(imageCnt), fMode(mode) {
+        fName.appendf("gr_texture_op_%d_images_%s", fImageCnt,
+                      Mode::kDrawImage == mode ? "draw_image" : "image_set");
+    }
+
+    bool isSuitableFor(Backend backend) override { return kGPU_Backend == backend; }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onPerCanvasPreDraw(SkCanvas* canvas) override {
+        auto ii = SkImageInfo::Make(kImageSize, kImageSize, kRGBA_8888_SkColorType,
+                                    kPremul_SkAlphaType, nullptr);
+        SkRandom random;
+        fImages.reset(new sk_sp<SkImage>[fImageCnt]);
+        for (int i = 0; i < fImageCnt; ++i) {
+            auto surf = canvas->makeSurface(ii);
+            if (!surf) {
+                fImages.reset();
+                return;
+            }
+            surf->getCanvas()->clear(random.nextU() | 0xFF000000);
+            fImages[i] = surf->makeImageSnapshot();
+        }
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override { fImages.reset(); }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        if (!fImages) {
+            return;
+        }
+        static constexpr int kImagesPerRow = kDeviceSize / kImageSize;
+        SkPaint paint;
+        paint.setFilterQuality(kNone_SkFilterQuality);
+        std::unique_ptr<SkCanvas::ImageSetEntry[]> set;
+        if (Mode::kImageSet == fMode) {
+            set.reset(new SkCanvas::ImageSetEntry[fImageCnt]);
+        }
+        for (int l = 0; l < loops; ++l) {
+            for (int i = 0; i < fImageCnt; ++i) {
+                SkScalar x = (i % kImagesPerRow) * kImageSize;
+                SkScalar y = (i / kImagesPerRow % kImagesPerRow) * kImageSize;
+                if (set) {
+                    set[i] = {fImages[i], SkRect::MakeIWH(kImageSize, kImageSize),
+                              SkRect::MakeXYWH(x, y, kImageSize, kImageSize), 1.f,
+                              SkCanvas::kNone_QuadAAFlags};
+                } else {
+                    canvas->drawImage(fImages[i].get(), x, y, &paint);
+                }
+            }
+            if (set) {
+                canvas->experimental_DrawImageSetV1(set.get(), fImageCnt, kNone_SkFilterQuality,
+                                                    SkBlendMode::kSrcOver);
+            }
+            // Prevent any batching between "frames".
+            canvas->flush();
+        }
+    }
+
+private:
+    SkIPoint onGetSize() override { return {kDeviceSize, kDeviceSize}; }
+
+    static constexpr int kImageSize = 16;
+    static constexpr int kDeviceSize = 512;
+
+    std::unique_ptr<sk_sp<SkImage>[]> fImages;
+    SkString fName;
+    int fImageCnt;
+    Mode fMode;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new GrTextureOpBench(100, GrTextureOpBench::Mode::kDrawImage));
+DEF_BENCH(return new GrTextureOpBench(500, GrTextureOpBench::Mode::kDrawImage));
+DEF_BENCH(return new GrTextureOpBench(500, GrTextureOpBench::Mode::kImageSet));
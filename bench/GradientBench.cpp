@@ -35,6 +35,7 @@ static const SkColor gColors[] = {
 
 static const SkColor gShallowColors[] = { 0xFF555555, 0xFF444444 };
 static const SkScalar gPos[] = {0.25f, 0.75f};
+static const SkScalar g3Pos[] = {0, 0.3f, 1};
 
 // We have several special-cases depending on the number (and spacing) of colors, so
 // try to exercise those here.
@@ -44,6 +45,7 @@ static const GradData gGradData[] = {
     { 3, gColors, nullptr, "_3color" },
     { 2, gShallowColors, nullptr, "_shallow" },
     { 2, gColors, gPos, "_pos" },
+    { 3, gColors, g3Pos, "_3color_pos" },
 };
 
 /// Ignores scale
@@ -282,6 +284,7 @@ DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[2], SkShader::kM
 DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[0]); )
 DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[1]); )
 DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[2]); )
+DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[5]); )
 // Draw a radial gradient of radius 1/2 on a rectangle; half the lines should
 // be completely pinned, the other half should pe partially pinned
 DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[0], SkShader::kClamp_TileMode, kRect_GeomType, 0.5f); )
@@ -295,6 +298,7 @@ DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[0], SkShader::kR
 DEF_BENCH( return new GradientBench(kSweep_GradType); )
 DEF_BENCH( return new GradientBench(kSweep_GradType, gGradData[1]); )
 DEF_BENCH( return new GradientBench(kSweep_GradType, gGradData[2]); )
+DEF_BENCH( return new GradientBench(kSweep_GradType, gGradData[5]); )
 DEF_BENCH( return new GradientBench(kConical_GradType); )
 DEF_BENCH( return new GradientBench(kConical_GradType, gGradData[1]); )
 DEF_BENCH( return new GradientBench(kConical_GradType, gGradData[2]); )
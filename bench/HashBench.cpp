@@ -0,0 +1,89 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkChecksum.h"
+#include "SkRandom.h"
+#include "SkString.h"
+#include "SkTFlatHashTable.h"
+#include "SkTHash.h"
+
+#include <vector>
+
+// Looks up keys in a table of pointers to entries, the way SkStrike's glyph map and
+// SkResourceCache use their tables.  Half of the lookups miss.
+namespace {
+
+struct Entry {
+    uint32_t fKey;
+    int      fValue;
+};
+
+struct EntryTraits {
+    static uint32_t GetKey(const Entry* e) { return e->fKey; }
+    static uint32_t Hash(uint32_t key) { return SkChecksum::Mix(key); }
+};
+
+template <typename Table>
+class HashFindBench : public Benchmark {
+public:
+    HashFindBench(const char* tableName, int count) : fCount(count) {
+        fName.printf("hash_find_%s_%d", tableName, count);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkRandom random;
+        fEntries.resize(fCount);
+        for (int i = 0; i < fCount; i++) {
+            fEntries[i] = {random.nextU() | 1, i};
+            fTable.set(&fEntries[i]);
+        }
+        // Odd keys were inserted, so even keys miss.
+        fQueries.resize(1024);
+        for (uint32_t& query : fQueries) {
+            query = random.nextBool() ? fEntries[random.nextULessThan(fCount)].fKey
+                                      : random.nextU() & ~1u;
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        int found = 0;
+        for (int i = 0; i < loops; i++) {
+            for (uint32_t query : fQueries) {
+                found += fTable.findOrNull(query) != nullptr;
+            }
+        }
+        fFound = found;
+    }
+
+private:
+    SkString           fName;
+    const int          fCount;
+    std::vector<Entry> fEntries;
+    std::vector<uint32_t> fQueries;
+    Table              fTable;
+    volatile int       fFound = 0;
+
+    typedef Benchmark INHERITED;
+};
+
+using LinearTable = SkTHashTable<Entry*, uint32_t, EntryTraits>;
+using FlatTable = SkTFlatHashTable<Entry*, uint32_t, EntryTraits>;
+
+}  // namespace
+
+DEF_BENCH(return new HashFindBench<LinearTable>("SkTHashTable", 100);)
+DEF_BENCH(return new HashFindBench<LinearTable>("SkTHashTable", 100000);)
+DEF_BENCH(return new HashFindBench<FlatTable>("SkTFlatHashTable", 100);)
+DEF_BENCH(return new HashFindBench<FlatTable>("SkTFlatHashTable", 100000);)
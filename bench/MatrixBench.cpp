@@ -269,6 +269,7 @@ DEF_BENCH( return new InvertMapRectMatrixBench(
 static SkMatrix make_trans() { return SkMatrix::MakeTrans(2, 3); }
 static SkMatrix make_scale() { SkMatrix m(make_trans()); m.postScale(1.5f, 0.5f); return m; }
 static SkMatrix make_afine() { SkMatrix m(make_trans()); m.postRotate(15); return m; }
+static SkMatrix make_persp() { SkMatrix m(make_afine()); m.setPerspX(0.01f); return m; }
 
 class MapPointsMatrixBench : public MatrixBench {
 protected:
@@ -297,6 +298,7 @@ DEF_BENCH( return new MapPointsMatrixBench("mappoints_identity", SkMatrix::I());
 DEF_BENCH( return new MapPointsMatrixBench("mappoints_trans", make_trans()); )
 DEF_BENCH( return new MapPointsMatrixBench("mappoints_scale", make_scale()); )
 DEF_BENCH( return new MapPointsMatrixBench("mappoints_affine", make_afine()); )
+DEF_BENCH( return new MapPointsMatrixBench("mappoints_persp", make_persp()); )
 
 ///////////////////////////////////////////////////////////////////////////////
 
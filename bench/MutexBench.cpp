@@ -10,6 +10,9 @@
 #include "SkSpinlock.h"
 #include "SkString.h"
 
+#include <thread>
+#include <vector>
+
 template <typename Mutex>
 class MutexBench : public Benchmark {
 public:
@@ -59,9 +62,67 @@ private:
     SkSharedMutex fMu;
 };
 
+// Many threads share one lock, mostly for reading and writing one time in 16, like the font and
+// typeface caches do. Each thread runs all the loops, so time per loop is the cost of a lock and
+// unlock under that much contention.
+class ContendedSharedBench : public Benchmark {
+public:
+    ContendedSharedBench(SkSharedMutex::Bias bias, int threads)
+        : fMu(bias)
+        , fThreads(threads) {
+        fBenchName.printf("SkSharedMutex_contended_%s_%d",
+                          SkSharedMutex::Bias::kReaders == bias ? "readers" : "fair", threads);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fBenchName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < fThreads; t++) {
+            threads.emplace_back([this, loops, t] {
+                int sum = 0;
+                for (int i = 0; i < loops; i++) {
+                    if ((i + t) % 16 == 0) {
+                        fMu.acquire();
+                        fValue++;
+                        fMu.release();
+                    } else {
+                        fMu.acquireShared();
+                        sum += fValue;
+                        fMu.releaseShared();
+                    }
+                }
+                fSink = sum;
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+    SkString fBenchName;
+    SkSharedMutex fMu;
+    const int fThreads;
+    int fValue = 0;
+    std::atomic<int> fSink{0};
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new MutexBench<SkSharedMutex>(SkString("SkSharedMutex")); )
 DEF_BENCH( return new MutexBench<SkMutex>(SkString("SkMutex")); )
 DEF_BENCH( return new MutexBench<SkSpinlock>(SkString("SkSpinlock")); )
 DEF_BENCH( return new SharedBench; )
+DEF_BENCH( return new ContendedSharedBench(SkSharedMutex::Bias::kFair, 4); )
+DEF_BENCH( return new ContendedSharedBench(SkSharedMutex::Bias::kReaders, 4); )
+DEF_BENCH( return new ContendedSharedBench(SkSharedMutex::Bias::kFair, 16); )
+DEF_BENCH( return new ContendedSharedBench(SkSharedMutex::Bias::kReaders, 16); )
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkCpu.h"
+#include "SkGradientShader.h"
+#include "SkOpts.h"
+#include "SkPaint.h"
+#include "SkString.h"
+
+namespace SkOpts {
+    // Defined in src/opts/SkOpts_{hsw,skx}.cpp.
+    void Init_hsw();
+    void Init_skx();
+}
+
+// Draws a gradient into an F16 bitmap (which keeps us on the highp float pipeline) using the
+// stages from one particular x86 SkOpts tier, so we can compare hsw's 8 lanes to skx's 16.
+class OptsTierGradientBench : public Benchmark {
+public:
+    enum class Tier { kHSW, kSKX };
+
+    OptsTierGradientBench(Tier tier, int stops) : fTier(tier), fStops(stops) {
+        fName.printf("opts_gradient_%d_stops_%s", stops, tier == Tier::kHSW ? "hsw" : "skx");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+    #if defined(SK_CPU_X86) && !defined(SK_BUILD_NO_OPTS)
+        return backend == kNonRendering_Backend &&
+               SkCpu::Supports(fTier == Tier::kHSW ? SkCpu::HSW : SkCpu::SKX);
+    #else
+        return false;
+    #endif
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fBitmap.allocPixels(SkImageInfo::Make(512, 512, kRGBA_F16_SkColorType,
+                                              kPremul_SkAlphaType));
+
+        SkColor colors[16];
+        for (int i = 0; i < fStops; i++) {
+            colors[i] = i & 1 ? SK_ColorRED : SK_ColorBLUE;
+        }
+        const SkPoint pts[] = {{0, 0}, {512, 512}};
+        fPaint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, fStops,
+                                                      SkShader::kClamp_TileMode));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+    #if defined(SK_CPU_X86) && !defined(SK_BUILD_NO_OPTS)
+        // SkRasterPipeline reads SkOpts' stage tables each time it compiles a pipeline,
+        // so swapping tiers here takes effect on the very next draw.
+        SkOpts::Init_hsw();
+        if (fTier == Tier::kSKX) {
+            SkOpts::Init_skx();
+        }
+
+        SkCanvas canvas(fBitmap);
+        for (int i = 0; i < loops; i++) {
+            canvas.drawPaint(fPaint);
+        }
+
+        // Put back the best stages this machine supports.
+        if (SkCpu::Supports(SkCpu::SKX)) {
+            SkOpts::Init_skx();
+        }
+    #endif
+    }
+
+private:
+    Tier     fTier;
+    int      fStops;
+    SkString fName;
+    SkBitmap fBitmap;
+    SkPaint  fPaint;
+
+    typedef Benchmark INHERITED;
+};
+
+using Tier = OptsTierGradientBench::Tier;
+DEF_BENCH( return new OptsTierGradientBench(Tier::kHSW,  2); )
+DEF_BENCH( return new OptsTierGradientBench(Tier::kSKX,  2); )
+DEF_BENCH( return new OptsTierGradientBench(Tier::kHSW, 12); )
+DEF_BENCH( return new OptsTierGradientBench(Tier::kSKX, 12); )
@@ -224,6 +224,40 @@ struct PDFShaderBench : public Benchmark {
     }
 };
 
+// A page of charts: many gradients that share a few color ramps but not their geometry.
+struct PDFGradientPageBench : public Benchmark {
+    SkShader::TileMode fTileMode;
+    SkString fName;
+    PDFGradientPageBench(SkShader::TileMode tileMode) : fTileMode(tileMode) {
+        fName.printf("PDFGradientPage_%s",
+                     tileMode == SkShader::kClamp_TileMode ? "clamp" : "repeat");
+    }
+    const char* onGetName() final { return fName.c_str(); }
+    bool isSuitableFor(Backend b) final { return b == kNonRendering_Backend; }
+    void onDraw(int loops, SkCanvas*) final {
+        const SkColor ramps[][3] = {
+            {SK_ColorRED, SK_ColorYELLOW, SK_ColorGREEN},
+            {SK_ColorBLUE, SK_ColorCYAN, SK_ColorWHITE},
+            {SK_ColorBLACK, SK_ColorGRAY, SK_ColorMAGENTA},
+        };
+        const SkScalar stops[] = {0.0f, 0.4f, 1.0f};
+        while (loops-- > 0) {
+            SkNullWStream nullStream;
+            auto doc = SkPDF::MakeDocument(&nullStream);
+            SkCanvas* canvas = doc->beginPage(612, 792);
+            for (int i = 0; i < 200; ++i) {
+                SkRect bar = SkRect::MakeXYWH((i % 20) * 30.0f, (i / 20) * 78.0f, 24, 70);
+                const SkPoint pts[2] = {{bar.left(), bar.bottom()}, {bar.left(), bar.top()}};
+                SkPaint paint;
+                paint.setShader(SkGradientShader::MakeLinear(
+                        pts, ramps[i % SK_ARRAY_COUNT(ramps)], stops, 3, fTileMode));
+                canvas->drawRect(bar, paint);
+            }
+            doc->close();
+        }
+    }
+};
+
 struct WritePDFTextBenchmark : public Benchmark {
     std::unique_ptr<SkWStream> fWStream;
     WritePDFTextBenchmark() : fWStream(new SkNullWStream) {}
@@ -249,6 +283,8 @@ DEF_BENCH(return new PDFJpegImageBench;)
 DEF_BENCH(return new PDFCompressionBench;)
 DEF_BENCH(return new PDFColorComponentBench;)
 DEF_BENCH(return new PDFShaderBench;)
+DEF_BENCH(return new PDFGradientPageBench(SkShader::kClamp_TileMode);)
+DEF_BENCH(return new PDFGradientPageBench(SkShader::kRepeat_TileMode);)
 DEF_BENCH(return new WritePDFTextBenchmark;)
 
 #ifdef SK_PDF_ENABLE_SLOW_TESTS
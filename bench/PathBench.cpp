@@ -9,12 +9,14 @@
 #include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkColorPriv.h"
+#include "SkData.h"
 #include "SkPaint.h"
 #include "SkPath.h"
 #include "SkRandom.h"
 #include "SkShader.h"
 #include "SkString.h"
 #include "SkTArray.h"
+#include "SkTLazy.h"
 
 enum Flags {
     kStroke_Flag = 1 << 0,
@@ -883,6 +885,68 @@ private:
     typedef Benchmark INHERITED;
 };
 
+#include "SkPathContainsIndex.h"
+
+// Point-in-path queries against a polygon with many edges, either walking the path each time or
+// going through an SkPathContainsIndex built once up front.
+class PathContainsBench : public Benchmark {
+public:
+    PathContainsBench(bool useIndex) : fUseIndex(useIndex) {
+        fName.printf("path_contains_%s", useIndex ? "index" : "path");
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+private:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        for (int i = 0; i < kEdgeCnt; ++i) {
+            SkScalar radius = rand.nextRangeScalar(200, 500);
+            SkScalar angle = i * SK_ScalarPI * 2 / kEdgeCnt;
+            SkPoint pt = { 500 + radius * SkScalarCos(angle), 500 + radius * SkScalarSin(angle) };
+            if (i == 0) {
+                fPath.moveTo(pt);
+            } else {
+                fPath.lineTo(pt);
+            }
+        }
+        fPath.close();
+        fIndex.init(fPath);
+
+        fQueryPts.setCount(kQueryPtCnt);
+        for (SkPoint& pt : fQueryPts) {
+            pt.set(rand.nextRangeScalar(0, 1000), rand.nextRangeScalar(0, 1000));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        int count = 0;
+        for (int i = 0; i < loops; ++i) {
+            const SkPoint& pt = fQueryPts[i % kQueryPtCnt];
+            count += fUseIndex ? fIndex->contains(pt.fX, pt.fY) : fPath.contains(pt.fX, pt.fY);
+        }
+        fCount = count;
+    }
+
+    static constexpr int kEdgeCnt = 2000;
+    static constexpr int kQueryPtCnt = 400;
+
+    SkString                        fName;
+    bool                            fUseIndex;
+    SkPath                          fPath;
+    SkTLazy<SkPathContainsIndex>    fIndex;
+    SkTDArray<SkPoint>              fQueryPts;
+    int                             fCount = 0;
+
+    typedef Benchmark INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "SkGeometry.h"
@@ -1174,6 +1238,8 @@ DEF_BENCH( return new ArbRoundRectBench(true); )
 DEF_BENCH( return new ConservativelyContainsBench(ConservativelyContainsBench::kRect_Type); )
 DEF_BENCH( return new ConservativelyContainsBench(ConservativelyContainsBench::kRoundRect_Type); )
 DEF_BENCH( return new ConservativelyContainsBench(ConservativelyContainsBench::kOval_Type); )
+DEF_BENCH( return new PathContainsBench(false); )
+DEF_BENCH( return new PathContainsBench(true); )
 
 #include "SkPathOps.h"
 #include "SkPathPriv.h"
@@ -1242,3 +1308,126 @@ DEF_BENCH( return new CommonConvexBench(200, 16, false, false); )
 DEF_BENCH( return new CommonConvexBench(200, 16, true,  false); )
 DEF_BENCH( return new CommonConvexBench(200, 16, false, true); )
 DEF_BENCH( return new CommonConvexBench(200, 16, true,  true); )
+
+// Builds a long polyline point by point, in one run, or from arrays.
+class PolylineBuildBench : public Benchmark {
+public:
+    enum Mode { kLineTo, kPolylineTo, kMake };
+
+    PolylineBuildBench(Mode mode) : fMode(mode) {
+        static const char* kNames[] = { "lineTo", "polylineTo", "Make" };
+        fName.printf("path_build_polyline_%s", kNames[mode]);
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        for (int i = 0; i < kPoints; ++i) {
+            fPoints[i].set(rand.nextF() * 640, rand.nextF() * 480);
+        }
+        fVerbs[0] = SkPath::kMove_Verb;
+        memset(fVerbs + 1, SkPath::kLine_Verb, kPoints - 1);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkPath path;
+            switch (fMode) {
+                case kLineTo:
+                    path.moveTo(fPoints[0]);
+                    for (int j = 1; j < kPoints; ++j) {
+                        path.lineTo(fPoints[j]);
+                    }
+                    break;
+                case kPolylineTo:
+                    path.incReserve(kPoints);
+                    path.moveTo(fPoints[0]);
+                    path.polylineTo(fPoints + 1, kPoints - 1);
+                    break;
+                case kMake:
+                    path = SkPath::Make(fPoints, kPoints, fVerbs, kPoints, nullptr, 0,
+                                        SkPath::kWinding_FillType);
+                    break;
+            }
+            path.updateBoundsCache();
+        }
+    }
+
+private:
+    static constexpr int kPoints = 10000;
+
+    Mode     fMode;
+    SkString fName;
+    SkPoint  fPoints[kPoints];
+    uint8_t  fVerbs[kPoints];
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new PolylineBuildBench(PolylineBuildBench::kLineTo); )
+DEF_BENCH( return new PolylineBuildBench(PolylineBuildBench::kPolylineTo); )
+DEF_BENCH( return new PolylineBuildBench(PolylineBuildBench::kMake); )
+
+class PathDeserializeBench : public Benchmark {
+public:
+    PathDeserializeBench(bool curves)
+        : fName(curves ? "path_deserialize_curves" : "path_deserialize_polyline")
+        , fCurves(curves) {}
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        auto randPt = [&rand]() { return SkPoint::Make(rand.nextF() * 640, rand.nextF() * 480); };
+        SkPath path;
+        for (int i = 0; i < kSegments; ++i) {
+            if (i % 100 == 0) {
+                path.moveTo(randPt());
+            }
+            switch (fCurves ? i % 4 : 0) {
+                case 0: path.lineTo(randPt()); break;
+                case 1: path.quadTo(randPt(), randPt()); break;
+                case 2: path.conicTo(randPt(), randPt(), 0.5f); break;
+                case 3: path.cubicTo(randPt(), randPt(), randPt()); break;
+            }
+            if (i % 100 == 99) {
+                path.close();
+            }
+        }
+        fData = path.serialize();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            SkPath path;
+            path.readFromMemory(fData->data(), fData->size());
+        }
+    }
+
+private:
+    static constexpr int kSegments = 10000;
+
+    SkString      fName;
+    bool          fCurves;
+    sk_sp<SkData> fData;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new PathDeserializeBench(false); )
+DEF_BENCH( return new PathDeserializeBench(true); )
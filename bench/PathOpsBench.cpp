@@ -96,3 +96,31 @@ static SkPath makerects() {
 }
 
 DEF_BENCH( return new PathOpsSimplifyBench("rects", makerects()); )
+
+// Many small contours in a wide band, so most pairs overlap vertically but not horizontally.
+static SkPath makerow(int count) {
+    SkRandom rand;
+    SkPath path;
+    for (int i = 0; i < count; ++i) {
+        SkScalar x = i * 4 + rand.nextUScalar1() * 2;
+        SkScalar y = rand.nextUScalar1() * 4;
+        path.addCircle(x, y, 3);
+    }
+    return path;
+}
+
+// Many small contours scattered over a square.
+static SkPath makescatter(int count) {
+    SkRandom rand;
+    SkPath path;
+    SkScalar scale = SkScalarSqrt(SkIntToScalar(count)) * 8;
+    for (int i = 0; i < count; ++i) {
+        SkScalar x = rand.nextUScalar1() * scale;
+        SkScalar y = rand.nextUScalar1() * scale;
+        path.addRect({x, y, x + 6, y + 6});
+    }
+    return path;
+}
+
+DEF_BENCH( return new PathOpsSimplifyBench("row_1000", makerow(1000)); )
+DEF_BENCH( return new PathOpsSimplifyBench("scatter_1000", makescatter(1000)); )
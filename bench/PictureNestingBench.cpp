@@ -12,6 +12,7 @@
 #include "SkPaint.h"
 #include "SkPicture.h"
 #include "SkPictureRecorder.h"
+#include "SkRect.h"
 #include "SkString.h"
 
 class PictureNesting : public Benchmark {
@@ -138,6 +139,10 @@ public:
         : INHERITED("playback", maxLevel, maxPictureLevel) {
     }
 protected:
+    PictureNestingPlayback(const char* name, int maxLevel, int maxPictureLevel)
+        : INHERITED(name, maxLevel, maxPictureLevel) {
+    }
+
     void onDelayedSetup() override {
         this->INHERITED::onDelayedSetup();
 
@@ -156,12 +161,35 @@ protected:
         }
     }
 
-private:
     sk_sp<SkPicture> fPicture;
 
+private:
     typedef PictureNesting INHERITED;
 };
 
+// Plays back into a small clip, like a scrolled view showing a corner of a deeply nested UI.
+// Most of the nested pictures' ops are offscreen.
+class PictureNestingClippedPlayback : public PictureNestingPlayback {
+public:
+    PictureNestingClippedPlayback(int maxLevel, int maxPictureLevel)
+        : INHERITED("clipped_playback", maxLevel, maxPictureLevel) {
+    }
+protected:
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkIPoint canvasSize = onGetSize();
+        canvas->save();
+        canvas->clipRect(SkRect::MakeXYWH(canvasSize.x() * 0.25f, canvasSize.y() * 0.75f,
+                                          canvasSize.x() * 0.125f, canvasSize.y() * 0.125f));
+        for (int i = 0; i < loops; i++) {
+            canvas->drawPicture(fPicture);
+        }
+        canvas->restore();
+    }
+
+private:
+    typedef PictureNestingPlayback INHERITED;
+};
+
 DEF_BENCH( return new PictureNestingRecording(8, 0); )
 DEF_BENCH( return new PictureNestingRecording(8, 1); )
 DEF_BENCH( return new PictureNestingRecording(8, 2); )
@@ -181,3 +209,10 @@ DEF_BENCH( return new PictureNestingPlayback(8, 5); )
 DEF_BENCH( return new PictureNestingPlayback(8, 6); )
 DEF_BENCH( return new PictureNestingPlayback(8, 7); )
 DEF_BENCH( return new PictureNestingPlayback(8, 8); )
+
+DEF_BENCH( return new PictureNestingClippedPlayback(8, 0); )
+DEF_BENCH( return new PictureNestingClippedPlayback(8, 1); )
+DEF_BENCH( return new PictureNestingClippedPlayback(8, 3); )
+DEF_BENCH( return new PictureNestingClippedPlayback(8, 5); )
+DEF_BENCH( return new PictureNestingClippedPlayback(8, 6); )
+DEF_BENCH( return new PictureNestingClippedPlayback(8, 8); )
@@ -95,6 +95,53 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Time how long it takes to perform a batch of queries on an R-Tree, as tiled playback would.
+class RTreeBatchQueryBench : public Benchmark {
+public:
+    RTreeBatchQueryBench(const char* name, MakeRectProc proc) : fProc(proc) {
+        fName.printf("rtree_%s_batch_query", name);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+    void onDelayedSetup() override {
+        SkRandom rand;
+        SkAutoTMalloc<SkRect> rects(NUM_QUERY_RECTS);
+        for (int i = 0; i < NUM_QUERY_RECTS; ++i) {
+            rects[i] = fProc(rand, i, NUM_QUERY_RECTS);
+        }
+        fTree.insert(rects.get(), NUM_QUERY_RECTS);
+
+        // A grid of tiles covering the whole area.
+        const SkScalar tileSize = GENERATE_EXTENTS / kTilesPerSide;
+        for (int i = 0; i < kNumTiles; ++i) {
+            fTiles[i] = SkRect::MakeXYWH((i % kTilesPerSide) * tileSize,
+                                         (i / kTilesPerSide) * tileSize, tileSize, tileSize);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            SkTDArray<int> hits[kNumTiles];
+            fTree.batchSearch(fTiles, kNumTiles, hits);
+        }
+    }
+private:
+    static const int kTilesPerSide = 8,
+                     kNumTiles = kTilesPerSide * kTilesPerSide;
+
+    SkRTree fTree;
+    SkRect fTiles[kNumTiles];
+    MakeRectProc fProc;
+    SkString fName;
+    typedef Benchmark INHERITED;
+};
+
 static inline SkRect make_XYordered_rects(SkRandom& rand, int index, int numRects) {
     SkRect out;
     out.fLeft   = SkIntToScalar(index % GRID_WIDTH);
@@ -136,3 +183,6 @@ DEF_BENCH(return new RTreeQueryBench("XY", &make_XYordered_rects));
 DEF_BENCH(return new RTreeQueryBench("YX", &make_YXordered_rects));
 DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects));
 DEF_BENCH(return new RTreeQueryBench("concentric", &make_concentric_rects));
+
+DEF_BENCH(return new RTreeBatchQueryBench("XY", &make_XYordered_rects));
+DEF_BENCH(return new RTreeBatchQueryBench("random", &make_random_rects));
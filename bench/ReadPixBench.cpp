@@ -8,6 +8,7 @@
 #include "Benchmark.h"
 #include "SkBitmap.h"
 #include "SkCanvas.h"
+#include "SkColorSpace.h"
 
 
 /**
@@ -147,3 +148,66 @@ DEF_BENCH( return new GetAlphafBench(kRGB_888x_SkColorType, "rgbx"); )
 DEF_BENCH( return new GetAlphafBench(kRGBA_F16_SkColorType, "f16"); )
 DEF_BENCH( return new GetAlphafBench(kRGBA_F32_SkColorType, "f32"); )
 
+
+
+// Times SkConvertPixels (via SkPixmap::readPixels) for conversions common in interop code.
+class ConvertPixelsBench : public Benchmark {
+    SkString    fName;
+    SkImageInfo fSrcInfo, fDstInfo;
+public:
+    ConvertPixelsBench(const SkImageInfo& src, const SkImageInfo& dst, const char label[])
+        : fSrcInfo(src), fDstInfo(dst) {
+        fName.printf("convertpix_%s_%dx%d", label, src.width(), src.height());
+    }
+
+protected:
+    void onDelayedSetup() override {
+        fSrc.allocPixels(fSrcInfo);
+        fSrc.eraseColor(0x88112233);
+        fDst.allocPixels(fDstInfo);
+    }
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            fSrc.pixmap().readPixels(fDst.pixmap());
+        }
+    }
+
+private:
+    SkBitmap fSrc, fDst;
+
+    typedef Benchmark INHERITED;
+};
+
+static SkImageInfo convert_info(int w, int h, SkColorType ct, SkAlphaType at,
+                                sk_sp<SkColorSpace> cs = nullptr) {
+    return SkImageInfo::Make(w, h, ct, at, cs ? std::move(cs) : SkColorSpace::MakeSRGB());
+}
+
+static sk_sp<SkColorSpace> p3() {
+    return SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB, SkNamedGamut::kDCIP3);
+}
+
+// Wide images, and narrow ones where per-row overhead dominates.
+#define DEF_CONVERT_BENCHES(W, H)                                                                \
+    DEF_BENCH( return new ConvertPixelsBench(                                                    \
+            convert_info(W, H, kBGRA_8888_SkColorType, kPremul_SkAlphaType),                     \
+            convert_info(W, H, kRGBA_8888_SkColorType, kPremul_SkAlphaType), "bgra_rgba"); )     \
+    DEF_BENCH( return new ConvertPixelsBench(                                                    \
+            convert_info(W, H, kRGBA_8888_SkColorType, kUnpremul_SkAlphaType),                  \
+            convert_info(W, H, kRGBA_8888_SkColorType, kPremul_SkAlphaType, p3()),               \
+            "unpremul_srgb_premul_p3"); )                                                        \
+    DEF_BENCH( return new ConvertPixelsBench(                                                    \
+            convert_info(W, H, kRGBA_F16_SkColorType, kPremul_SkAlphaType),                      \
+            convert_info(W, H, kRGBA_8888_SkColorType, kPremul_SkAlphaType), "f16_8888"); )
+
+DEF_CONVERT_BENCHES(1024, 1024)
+DEF_CONVERT_BENCHES(8, 16384)
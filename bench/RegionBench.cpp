@@ -8,6 +8,7 @@
 #include "SkRandom.h"
 #include "SkRegion.h"
 #include "SkString.h"
+#include "SkTArray.h"
 
 static bool union_proc(SkRegion& a, SkRegion& b) {
     SkRegion result;
@@ -129,3 +130,42 @@ DEF_BENCH(return new RegionBench(SMALL, containsrect_proc, "containsrect");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrgn_proc, "intersectsrgn");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrect_proc, "intersectsrect");)
 DEF_BENCH(return new RegionBench(SMALL, containsxy_proc, "containsxy");)
+
+// Builds a region from many overlapping rects at once, as a damage tracker does each frame.
+class RegionSetRectsBench : public Benchmark {
+public:
+    RegionSetRectsBench(int count) {
+        fName.printf("region_setrects_%d", count);
+
+        SkRandom rand;
+        for (int i = 0; i < count; i++) {
+            int x = rand.nextU() % 1024;
+            int y = rand.nextU() % 768;
+            fRects.push_back(SkIRect::MakeXYWH(x, y, rand.nextRangeU(1, 128),
+                                               rand.nextRangeU(1, 128)));
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkRegion rgn;
+        for (int i = 0; i < loops; ++i) {
+            rgn.setRects(fRects.begin(), fRects.count());
+        }
+    }
+
+private:
+    SkTArray<SkIRect> fRects;
+    SkString          fName;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new RegionSetRectsBench(SMALL);)
+DEF_BENCH(return new RegionSetRectsBench(256);)
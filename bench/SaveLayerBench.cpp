@@ -0,0 +1,50 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+#include "SkCanvas.h"
+#include "SkPaint.h"
+#include "SkString.h"
+
+// Draws a small rect into each of a run of alpha layers, the way UI frames fade views in and out.
+// Most of the cost is allocating, clearing and compositing the layers.
+class SaveLayerBench : public Benchmark {
+public:
+    SaveLayerBench(int size) : fSize(size) {
+        fName.printf("savelayer_alpha_%d", size);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return kRaster_Backend == backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setColor(SK_ColorBLUE);
+        const SkRect bounds = SkRect::MakeWH(SkIntToScalar(fSize), SkIntToScalar(fSize));
+        const SkRect rect = SkRect::MakeXYWH(4, 4, 16, 16);
+        for (int i = 0; i < loops; i++) {
+            for (int j = 0; j < 10; j++) {
+                canvas->saveLayerAlpha(&bounds, 0x80);
+                canvas->drawRect(rect, paint);
+                canvas->restore();
+            }
+        }
+    }
+
+private:
+    SkString  fName;
+    const int fSize;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new SaveLayerBench(64);)
+DEF_BENCH(return new SaveLayerBench(512);)
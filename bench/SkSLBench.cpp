@@ -0,0 +1,117 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Benchmark.h"
+
+#if SK_SUPPORT_GPU
+
+#include "SkSLCompiler.h"
+
+// Fragment shaders shaped like the ones GrGLSLProgramBuilder produces: each stage declares its
+// uniforms and helper functions, and not every stage uses everything it declares.
+static const char* kShaders[] = {
+    "uniform float4 urectUniform_Stage1;"
+    "uniform half4 ucolor_Stage0;"
+    "uniform half4 uunused_Stage0;"
+    "in float2 vcoord_Stage0;"
+    "half coverage_Stage1(float2 p) {"
+    "    return half(saturate(p.x - urectUniform_Stage1.x) *"
+    "                saturate(urectUniform_Stage1.z - p.x));"
+    "}"
+    "half4 modulate_Stage1(half4 c, half a) { return c * a; }"
+    "void main() {"
+    "    half4 outputColor_Stage0 = ucolor_Stage0;"
+    "    sk_FragColor = modulate_Stage1(outputColor_Stage0, coverage_Stage1(sk_FragCoord.xy));"
+    "}",
+
+    "uniform float3 ucircle_Stage1;"
+    "uniform half4 ustart_Stage2;"
+    "uniform half4 uend_Stage2;"
+    "uniform half4 udebug_Stage2;"
+    "in float2 vcoord_Stage0;"
+    "half circleEdge_Stage1(float2 p) {"
+    "    return half(saturate(ucircle_Stage1.z * (1.0 - length(ucircle_Stage1.xy - p))));"
+    "}"
+    "half4 lerpColor_Stage2(half t) { return mix(ustart_Stage2, uend_Stage2, t); }"
+    "half4 debugColor_Stage2() { return udebug_Stage2; }"
+    "void main() {"
+    "    half t = half(clamp(vcoord_Stage0.x, 0, 1));"
+    "    sk_FragColor = lerpColor_Stage2(t) * circleEdge_Stage1(sk_FragCoord.xy);"
+    "}",
+
+    "uniform half4 ukernel_Stage1[4];"
+    "uniform half uweight_Stage1;"
+    "uniform sampler2D uTextureSampler_0_Stage1;"
+    "in float2 vcoord_Stage0;"
+    "half4 tap_Stage1(float2 coord, half w) {"
+    "    return texture(uTextureSampler_0_Stage1, coord) * w;"
+    "}"
+    "half luminance(half4 c) { return dot(c.rgb, half3(0.3, 0.6, 0.1)); }"
+    "void main() {"
+    "    half4 sum = half4(0);"
+    "    for (int i = 0; i < 4; i++) {"
+    "        sum += tap_Stage1(vcoord_Stage0 + float2(ukernel_Stage1[i].xy), ukernel_Stage1[i].z);"
+    "    }"
+    "    sk_FragColor = sum * uweight_Stage1;"
+    "}",
+};
+
+/**
+ * Compiles a corpus of fragment shaders from SkSL to GLSL, with or without function inlining.
+ */
+class SkSLCompileBench : public Benchmark {
+public:
+    SkSLCompileBench(bool inlining)
+        : fName(inlining ? "sksl_compile_glsl_inline" : "sksl_compile_glsl_noinline")
+        , fInlining(inlining) {}
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        fCaps = SkSL::ShaderCapsFactory::Default();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkSL::Program::Settings settings;
+        settings.fCaps = fCaps.get();
+        if (!fInlining) {
+            settings.fInlineThreshold = 0;
+        }
+        for (int i = 0; i < loops; i++) {
+            for (const char* src : kShaders) {
+                SkSL::Compiler compiler;
+                std::unique_ptr<SkSL::Program> program =
+                        compiler.convertProgram(SkSL::Program::kFragment_Kind, SkSL::String(src),
+                                                settings);
+                SkSL::String glsl;
+                if (!program || !compiler.toGLSL(*program, &glsl)) {
+                    SkDebugf("%s\n", compiler.errorText().c_str());
+                    SK_ABORT("compile failed");
+                }
+            }
+        }
+    }
+
+private:
+    SkString fName;
+    bool fInlining;
+    sk_sp<GrShaderCaps> fCaps;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new SkSLCompileBench(true);)
+DEF_BENCH(return new SkSLCompileBench(false);)
+
+#endif
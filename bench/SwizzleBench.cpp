@@ -18,10 +18,11 @@ public:
     const char* onGetName() override { return fName; }
     void onDraw(int loops, SkCanvas*) override {
         static const int K = 1023; // Arbitrary, but nice to be a non-power-of-two to trip up SIMD.
-        uint32_t dst[K], src[K];
+        uint32_t dst[K];
+        uint64_t src[K];  // Big enough for the 16-bit sources too.
         while (loops --> 0) {
-            if (fFn_u32) { fFn_u32(dst,                 src, K); }
-            if (fFn_u8)  { fFn_u8 (dst, (const uint8_t*)src, K); }
+            if (fFn_u32) { fFn_u32(dst, (const uint32_t*)src, K); }
+            if (fFn_u8)  { fFn_u8 (dst, (const uint8_t* )src, K); }
         }
     }
 private:
@@ -41,3 +42,37 @@ DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_RGBA", SkOpts::grayA_to_RGBA
 DEF_BENCH(return new SwizzleBench("SkOpts::grayA_to_rgbA", SkOpts::grayA_to_rgbA));
 DEF_BENCH(return new SwizzleBench("SkOpts::inverted_CMYK_to_RGB1", SkOpts::inverted_CMYK_to_RGB1));
 DEF_BENCH(return new SwizzleBench("SkOpts::inverted_CMYK_to_BGR1", SkOpts::inverted_CMYK_to_BGR1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGB16_to_RGB1",  SkOpts::RGB16_to_RGB1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGB16_to_BGR1",  SkOpts::RGB16_to_BGR1));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBA16_to_RGBA", SkOpts::RGBA16_to_RGBA));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBA16_to_BGRA", SkOpts::RGBA16_to_BGRA));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBA16_to_rgbA", SkOpts::RGBA16_to_rgbA));
+DEF_BENCH(return new SwizzleBench("SkOpts::RGBA16_to_bgrA", SkOpts::RGBA16_to_bgrA));
+
+class PngUnfilterBench : public Benchmark {
+public:
+    PngUnfilterBench(const char* name, SkOpts::PngUnfilter fn) : fName(name), fFn(fn) {}
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return fName; }
+    void onDraw(int loops, SkCanvas*) override {
+        static const int K = 3 * 4 * 1023;  // A whole number of both 3- and 4-byte pixels.
+        uint8_t row[K], prev[K];
+        memset(row,  0x5a, K);
+        memset(prev, 0xa5, K);
+        while (loops --> 0) {
+            fFn(row, prev, K);
+        }
+    }
+private:
+    const char*         fName;
+    SkOpts::PngUnfilter fFn;
+};
+
+DEF_BENCH(return new PngUnfilterBench("SkOpts::png_unfilter_up",     SkOpts::png_unfilter_up));
+DEF_BENCH(return new PngUnfilterBench("SkOpts::png_unfilter_sub3",   SkOpts::png_unfilter_sub3));
+DEF_BENCH(return new PngUnfilterBench("SkOpts::png_unfilter_sub4",   SkOpts::png_unfilter_sub4));
+DEF_BENCH(return new PngUnfilterBench("SkOpts::png_unfilter_avg3",   SkOpts::png_unfilter_avg3));
+DEF_BENCH(return new PngUnfilterBench("SkOpts::png_unfilter_avg4",   SkOpts::png_unfilter_avg4));
+DEF_BENCH(return new PngUnfilterBench("SkOpts::png_unfilter_paeth3", SkOpts::png_unfilter_paeth3));
+DEF_BENCH(return new PngUnfilterBench("SkOpts::png_unfilter_paeth4", SkOpts::png_unfilter_paeth4));
@@ -28,6 +28,10 @@ UB_IDX = -1
 SLOWER = 0
 FASTER = 1
 
+# Allocation metrics written by nanobench when built with
+# skia_enable_allocation_counting=true. Any increase over the baseline is flagged.
+ALLOC_METRICS = ['allocs_per_loop', 'alloc_bytes_per_loop', 'peak_alloc_bytes']
+
 # URL prefix for the bench dashboard page. Showing recent 15 days of data.
 DASHBOARD_URL_PREFIX = 'http://go/skpdash/#15'
 
@@ -43,6 +47,9 @@ def usage():
     print '   See bench_expectations_<builder>.txt for data format / examples.'
     print '-r <revision> the git commit hash or svn revision for checking '
     print '   bench values.'
+    print '--alloc-baseline <file> --alloc-current <file> nanobench'
+    print '   --outResultsFile JSON files to compare allocation metrics between.'
+    print '   Exits with an error if any bench allocates more than in baseline.'
 
 
 class Label:
@@ -190,12 +197,51 @@ def check_expectations(lines, expectations, key_suffix):
         exit(1)
 
 
+def read_nanobench_allocs(filename):
+    """Reads allocation metrics from a nanobench --outResultsFile JSON file.
+
+    Returns:
+      a dictionary mapping (bench, config) to {metric: value}.
+    """
+    allocs = {}
+    results = json.load(open(filename)).get('results', {})
+    for bench, configs in results.iteritems():
+        for config, values in configs.iteritems():
+            if not isinstance(values, dict):
+                continue
+            metrics = dict((m, values[m]) for m in ALLOC_METRICS if m in values)
+            if metrics:
+                allocs[(bench, config)] = metrics
+    return allocs
+
+def check_allocations(baseline_file, current_file):
+    """Flags every bench whose allocation metrics went up since the baseline."""
+    baseline = read_nanobench_allocs(baseline_file)
+    current = read_nanobench_allocs(current_file)
+    increases = []
+    for key in sorted(current):
+        if key not in baseline:
+            continue
+        for metric in ALLOC_METRICS:
+            if metric not in current[key] or metric not in baseline[key]:
+                continue
+            before, after = baseline[key][metric], current[key][metric]
+            if after > before:
+                increases.append('Bench %s_%s %s went up: %s -> %s.' % (
+                    key[0], key[1], metric, before, after))
+    if increases:
+        header = '%s allocation metrics increased:' % len(increases)
+        sys.stderr.write('\n'.join(['Exception:', header] + increases + ['\n']))
+        exit(1)
+
+
 def main():
     """Parses command line and checks bench expectations."""
     try:
         opts, _ = getopt.getopt(sys.argv[1:],
                                 "a:b:d:e:r:",
-                                "default-setting=")
+                                ["default-setting=", "alloc-baseline=",
+                                 "alloc-current="])
     except getopt.GetoptError, err:
         print str(err)
         usage()
@@ -206,6 +252,8 @@ def main():
     rep = '25th'  # bench representation algorithm, default to 25th
     rev = None  # git commit hash or svn revision number
     bot = None
+    alloc_baseline = None
+    alloc_current = None
 
     try:
         for option, value in opts:
@@ -219,6 +267,10 @@ def main():
                 read_expectations(bench_expectations, value)
             elif option == "-r":
                 rev = value
+            elif option == "--alloc-baseline":
+                alloc_baseline = value
+            elif option == "--alloc-current":
+                alloc_current = value
             else:
                 usage()
                 assert False, "unhandled option"
@@ -226,6 +278,10 @@ def main():
         usage()
         sys.exit(2)
 
+    if alloc_baseline and alloc_current:
+        check_allocations(alloc_baseline, alloc_current)
+        return
+
     if directory is None or bot is None or rev is None:
         usage()
         sys.exit(2)
@@ -16,12 +16,14 @@
 #include "CodecBenchPriv.h"
 #include "CrashHandler.h"
 #include "GMBench.h"
+#include "PerfCounters.h"
 #include "ProcStats.h"
 #include "RecordingBench.h"
 #include "ResultsWriter.h"
 #include "SKPAnimationBench.h"
 #include "SKPBench.h"
 #include "SkAndroidCodec.h"
+#include "SkAllocationCounter.h"
 #include "SkAutoMalloc.h"
 #include "SkBBoxHierarchy.h"
 #include "SkBitmapRegionDecoder.h"
@@ -53,7 +55,9 @@
 #endif  // SK_XML
 
 #include <stdlib.h>
+#include <atomic>
 #include <thread>
+#include <vector>
 
 extern bool gSkForceRasterPipelineBlitter;
 
@@ -136,6 +140,13 @@ DEFINE_string(benchType,  "",
         "Apply usual --match rules to bench type: micro, recording, piping, playback, skcodec, etc.");
 
 DEFINE_bool(forceRasterPipeline, false, "sets gSkForceRasterPipelineBlitter");
+DEFINE_int32(throughputThreads, 0,
+             "If > 1, also run each micro bench on this many threads at once, each with its own "
+             "bench instance and surface, and report aggregate throughput and scaling efficiency "
+             "versus one thread. Only raster and non-rendering configs are measured.");
+DEFINE_bool(perfCounters, false,
+            "Record hardware counters (instructions, cycles, cache and branch misses) for each "
+            "sample and write them per loop to --outResultsFile. Linux and Android only.");
 
 static double now_ms() { return SkTime::GetNSecs() * 1e-6; }
 
@@ -238,12 +249,24 @@ struct GPUTarget : public Target {
     }
 };
 
-static double time(int loops, Benchmark* bench, Target* target) {
+#ifdef SK_COUNT_ALLOCATIONS
+// Allocations made during the timed part of the most recent call to time().
+static SkAllocationCounts gAllocationCounts;
+#endif
+
+static double time(int loops, Benchmark* bench, Target* target,
+                   sk_tools::PerfCounters* counters = nullptr) {
     SkCanvas* canvas = target->getCanvas();
     if (canvas) {
         canvas->clear(SK_ColorWHITE);
     }
     bench->preDraw(canvas);
+    if (counters) {
+        counters->start();
+    }
+#ifdef SK_COUNT_ALLOCATIONS
+    SkAllocationCounter::Reset();
+#endif
     double start = now_ms();
     canvas = target->beginTiming(canvas);
     bench->draw(loops, canvas);
@@ -252,6 +275,12 @@ static double time(int loops, Benchmark* bench, Target* target) {
     }
     target->endTiming();
     double elapsed = now_ms() - start;
+#ifdef SK_COUNT_ALLOCATIONS
+    gAllocationCounts = SkAllocationCounter::Get();
+#endif
+    if (counters) {
+        counters->stop();
+    }
     bench->postDraw(canvas);
     return elapsed;
 }
@@ -572,6 +601,61 @@ static void cleanup_run(Target* target) {
     delete target;
 }
 
+typedef Benchmark* (*BenchFactory)(void*);
+
+// Runs 'rounds' rounds of 'loops' draws on each of 'threads' threads at once. Every thread gets
+// its own bench instance (from factory) and its own raster surface, so the only things they share
+// are Skia's global caches and the allocator. Returns aggregate draws per millisecond, measured
+// from when all threads are set up until the last one finishes.
+static double threaded_throughput(BenchFactory factory, const Config& config,
+                                  int loops, int rounds, int threads) {
+    std::atomic<int>  ready{0};
+    std::atomic<bool> go{false};
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            std::unique_ptr<Benchmark> bench(factory(nullptr));
+            bench->delayedSetup();
+            sk_sp<SkSurface> surface;
+            SkCanvas* canvas = nullptr;
+            if (Benchmark::kRaster_Backend == config.backend) {
+                SkImageInfo info = SkImageInfo::Make(bench->getSize().fX, bench->getSize().fY,
+                                                     config.color, config.alpha,
+                                                     config.colorSpace);
+                surface = SkSurface::MakeRaster(info);
+                canvas = surface->getCanvas();
+            }
+            bench->perCanvasPreDraw(canvas);
+
+            ready++;
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            for (int round = 0; round < rounds; ++round) {
+                if (canvas) {
+                    canvas->clear(SK_ColorWHITE);
+                }
+                bench->preDraw(canvas);
+                bench->draw(loops, canvas);
+                bench->postDraw(canvas);
+            }
+            bench->perCanvasPostDraw(canvas);
+        });
+    }
+
+    while (ready.load() < threads) {
+        std::this_thread::yield();
+    }
+    double start = now_ms();
+    go = true;
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    double elapsed = now_ms() - start;
+    return sk_ieee_double_divide((double)threads * rounds * loops, elapsed);
+}
+
 static void collect_files(const SkCommandLineFlags::StringArray& paths, const char* ext,
                           SkTArray<SkString>* list) {
     for (int i = 0; i < paths.count(); ++i) {
@@ -598,6 +682,7 @@ public:
                       , fCurrentSVG(0)
                       , fCurrentUseMPD(0)
                       , fCurrentCodec(0)
+                      , fCurrentExecutorCodec(0)
                       , fCurrentAndroidCodec(0)
                       , fCurrentBRDImage(0)
                       , fCurrentColorType(0)
@@ -703,9 +788,14 @@ public:
         return bench.release();
     }
 
+    // Factory for the current bench if it came from BenchRegistry (DEF_BENCH), else nullptr.
+    BenchFactory currentFactory() const { return fCurrentFactory; }
+
     Benchmark* rawNext() {
+        fCurrentFactory = nullptr;
         if (fBenches) {
-            Benchmark* bench = fBenches->get()(nullptr);
+            fCurrentFactory = fBenches->get();
+            Benchmark* bench = fCurrentFactory(nullptr);
             fBenches = fBenches->next();
             fSourceType = "bench";
             fBenchType  = "micro";
@@ -893,6 +983,36 @@ public:
             fCurrentColorType = 0;
         }
 
+        // Run CodecBenches that decode on an executor, for the codecs that use one.
+        for (; fCurrentExecutorCodec < fImages.count(); fCurrentExecutorCodec++) {
+            fSourceType = "image";
+            fBenchType = "skcodec";
+            const SkString& path = fImages[fCurrentExecutorCodec];
+            if (SkCommandLineFlags::ShouldSkip(FLAGS_match, path.c_str())) {
+                continue;
+            }
+            sk_sp<SkData> encoded(SkData::MakeFromFileName(path.c_str()));
+            std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(encoded));
+            if (!codec) {
+                continue;
+            }
+            switch (codec->getEncodedFormat()) {
+                case SkEncodedImageFormat::kJPEG:
+                case SkEncodedImageFormat::kPNG:
+                    break;
+                default:
+                    continue;
+            }
+
+            SkAlphaType alphaType = codec->getInfo().alphaType();
+            if (kUnpremul_SkAlphaType == alphaType) {
+                alphaType = kPremul_SkAlphaType;
+            }
+            fCurrentExecutorCodec++;
+            return new CodecBench(SkOSPath::Basename(path.c_str()), encoded.get(),
+                                  kN32_SkColorType, alphaType, true);
+        }
+
         // Run AndroidCodecBenches
         const int sampleSizes[] = { 2, 4, 8 };
         for (; fCurrentAndroidCodec < fImages.count(); fCurrentAndroidCodec++) {
@@ -1072,6 +1192,7 @@ private:
     int fCurrentSVG;
     int fCurrentUseMPD;
     int fCurrentCodec;
+    int fCurrentExecutorCodec;
     int fCurrentAndroidCodec;
     int fCurrentBRDImage;
     int fCurrentColorType;
@@ -1079,6 +1200,7 @@ private:
     int fCurrentSubsetType;
     int fCurrentSampleSize;
     int fCurrentAnimSKP;
+    BenchFactory fCurrentFactory = nullptr;
 };
 
 // Some runs (mostly, Valgrind) are so slow that the bot framework thinks we've hung.
@@ -1164,6 +1286,15 @@ int main(int argc, char** argv) {
     const double overhead = estimate_timer_overhead();
     SkDebugf("Timer overhead: %s\n", HUMANIZE(overhead));
 
+    std::unique_ptr<sk_tools::PerfCounters> perfCounters;
+    if (FLAGS_perfCounters) {
+        perfCounters.reset(new sk_tools::PerfCounters);
+        if (!perfCounters->isAvailable()) {
+            SkDebugf("WARNING: no hardware counters available; ignoring --perfCounters.\n");
+            perfCounters.reset();
+        }
+    }
+
     SkTArray<double> samples;
 
     if (kAutoTuneLoops != FLAGS_loops) {
@@ -1256,19 +1387,57 @@ int main(int argc, char** argv) {
                 } while (now_ms() < stop);
             }
 
+            // Per-loop hardware counts, one entry per sample for each counter.
+            SkTArray<double> counts[sk_tools::PerfCounters::kCounterCount];
+#ifdef SK_COUNT_ALLOCATIONS
+            // The fewest allocations seen in any sample, so one-time setup doesn't count.
+            SkAllocationCounts allocs;
+            allocs.fCount = allocs.fBytes = allocs.fPeakBytes = SK_MaxS64;
+#endif
+            auto sample = [&] {
+                double ms = time(loops, bench.get(), target, perfCounters.get()) / loops;
+#ifdef SK_COUNT_ALLOCATIONS
+                allocs.fCount     = SkTMin(allocs.fCount,     gAllocationCounts.fCount);
+                allocs.fBytes     = SkTMin(allocs.fBytes,     gAllocationCounts.fBytes);
+                allocs.fPeakBytes = SkTMin(allocs.fPeakBytes, gAllocationCounts.fPeakBytes);
+#endif
+                if (perfCounters) {
+                    for (int c = 0; c < sk_tools::PerfCounters::kCounterCount; c++) {
+                        auto counter = (sk_tools::PerfCounters::Counter)c;
+                        counts[c].push_back((double)perfCounters->read(counter) / loops);
+                    }
+                }
+                return ms;
+            };
+
             if (FLAGS_ms) {
                 samples.reset();
                 auto stop = now_ms() + FLAGS_ms;
                 do {
-                    samples.push_back(time(loops, bench.get(), target) / loops);
+                    samples.push_back(sample());
                 } while (now_ms() < stop);
             } else {
                 samples.reset(FLAGS_samples);
                 for (int s = 0; s < FLAGS_samples; s++) {
-                    samples[s] = time(loops, bench.get(), target) / loops;
+                    samples[s] = sample();
                 }
             }
 
+            double throughput1 = 0, throughputN = 0;
+            const bool measureThroughput = FLAGS_throughputThreads > 1 &&
+                                           benchStream.currentFactory() &&
+                                           (Benchmark::kRaster_Backend == configs[i].backend ||
+                                            Benchmark::kNonRendering_Backend == configs[i].backend);
+            if (measureThroughput) {
+                const int rounds = SkTMax(FLAGS_samples, 1);
+                throughput1 = threaded_throughput(benchStream.currentFactory(), configs[i],
+                                                  loops, rounds, 1);
+                throughputN = threaded_throughput(benchStream.currentFactory(), configs[i],
+                                                  loops, rounds, FLAGS_throughputThreads);
+            }
+            const double scaling =
+                    sk_ieee_double_divide(throughputN, throughput1 * FLAGS_throughputThreads);
+
             SkTArray<SkString> keys;
             SkTArray<double> values;
             bool gpuStatsDump = FLAGS_gpuStatsDump && Benchmark::kGPU_Backend == configs[i].backend;
@@ -1308,6 +1477,30 @@ int main(int argc, char** argv) {
             }
             log.endArray(); // samples
             benchStream.fillCurrentMetrics(log);
+#ifdef SK_COUNT_ALLOCATIONS
+            log.appendMetric("allocs_per_loop", (double)allocs.fCount / loops);
+            log.appendMetric("alloc_bytes_per_loop", (double)allocs.fBytes / loops);
+            log.appendMetric("peak_alloc_bytes", (double)allocs.fPeakBytes);
+#endif
+            if (perfCounters) {
+                for (int c = 0; c < sk_tools::PerfCounters::kCounterCount; c++) {
+                    auto counter = (sk_tools::PerfCounters::Counter)c;
+                    if (!perfCounters->isAvailable(counter)) {
+                        continue;
+                    }
+                    log.beginArray(sk_tools::PerfCounters::Name(counter));
+                    for (double count : counts[c]) {
+                        log.appendDoubleDigits(count, 16);
+                    }
+                    log.endArray();
+                }
+            }
+            if (measureThroughput) {
+                log.appendS32("throughput_threads", FLAGS_throughputThreads);
+                log.appendMetric("throughput_1_per_ms", throughput1);
+                log.appendMetric("throughput_n_per_ms", throughputN);
+                log.appendMetric("scaling_efficiency", scaling);
+            }
             if (gpuStatsDump) {
                 // dump to json, only SKPBench currently returns valid keys / values
                 SkASSERT(keys.count() == values.count());
@@ -1371,6 +1564,29 @@ int main(int argc, char** argv) {
                         );
             }
 
+#ifdef SK_COUNT_ALLOCATIONS
+            if (!FLAGS_quiet) {
+                SkDebugf("\tallocs/loop %.4g\tbytes/loop %.4g\tpeak bytes %lld\t%s\t%s\n"
+                         , (double)allocs.fCount / loops
+                         , (double)allocs.fBytes / loops
+                         , (long long)allocs.fPeakBytes
+                         , config
+                         , bench->getUniqueName()
+                         );
+            }
+#endif
+
+            if (measureThroughput) {
+                SkDebugf("\t%d threads: %.3g/ms (1 thread: %.3g/ms), %.0f%% scaling\t%s\t%s\n"
+                         , FLAGS_throughputThreads
+                         , throughputN
+                         , throughput1
+                         , scaling * 100
+                         , config
+                         , bench->getUniqueName()
+                         );
+            }
+
             if (FLAGS_gpuStats && Benchmark::kGPU_Backend == configs[i].backend) {
                 target->dumpStats();
             }
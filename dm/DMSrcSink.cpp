@@ -35,7 +35,6 @@
 #include "SkLiteRecorder.h"
 #include "SkMakeUnique.h"
 #include "SkMallocPixelRef.h"
-#include "SkMultiPictureDocumentPriv.h"
 #include "SkMultiPictureDraw.h"
 #include "SkNullCanvas.h"
 #include "SkOSFile.h"
@@ -1243,19 +1242,14 @@ bool SVGSrc::veto(SinkFlags flags) const {
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 MSKPSrc::MSKPSrc(Path path) : fPath(path) {
-    std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(fPath.c_str());
-    int count = SkMultiPictureDocumentReadPageCount(stream.get());
-    if (count > 0) {
-        fPages.reset(count);
-        (void)SkMultiPictureDocumentReadPageSizes(stream.get(), &fPages[0], fPages.count());
-    }
+    fReader = SkMultiPictureDocumentReader::Make(SkData::MakeFromFileName(fPath.c_str()));
 }
 
-int MSKPSrc::pageCount() const { return fPages.count(); }
+int MSKPSrc::pageCount() const { return fReader ? fReader->pageCount() : 0; }
 
 SkISize MSKPSrc::size() const { return this->size(0); }
 SkISize MSKPSrc::size(int i) const {
-    return i >= 0 && i < fPages.count() ? fPages[i].fSize.toCeil() : SkISize{0, 0};
+    return i >= 0 && i < this->pageCount() ? fReader->pageSize(i).toCeil() : SkISize{0, 0};
 }
 
 Error MSKPSrc::draw(SkCanvas* c) const { return this->draw(0, c); }
@@ -1263,20 +1257,14 @@ Error MSKPSrc::draw(int i, SkCanvas* canvas) const {
     if (this->pageCount() == 0) {
         return SkStringPrintf("Unable to parse MultiPictureDocument file: %s", fPath.c_str());
     }
-    if (i >= fPages.count() || i < 0) {
+    if (i >= this->pageCount() || i < 0) {
         return SkStringPrintf("MultiPictureDocument page number out of range: %d", i);
     }
-    SkPicture* page = fPages[i].fPicture.get();
+    // Pages are read on demand and not kept, so only the pages being drawn are in memory.
+    sk_sp<SkPicture> page = fReader->readPage(i);
     if (!page) {
-        std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(fPath.c_str());
-        if (!stream) {
-            return SkStringPrintf("Unable to open file: %s", fPath.c_str());
-        }
-        if (!SkMultiPictureDocumentRead(stream.get(), &fPages[0], fPages.count())) {
-            return SkStringPrintf("SkMultiPictureDocument reader failed on page %d: %s", i,
-                                  fPath.c_str());
-        }
-        page = fPages[i].fPicture.get();
+        return SkStringPrintf("SkMultiPictureDocument reader failed on page %d: %s", i,
+                              fPath.c_str());
     }
     canvas->drawPicture(page);
     return "";
@@ -311,7 +311,7 @@ public:
 
 private:
     Path fPath;
-    mutable SkTArray<SkDocumentPage> fPages;
+    std::unique_ptr<SkMultiPictureDocumentReader> fReader;
 };
 
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
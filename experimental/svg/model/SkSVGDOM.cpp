@@ -5,9 +5,11 @@
  * found in the LICENSE file.
  */
 
+#include "SkBBHFactory.h"
 #include "SkCanvas.h"
 #include "SkDOM.h"
 #include "SkParsePath.h"
+#include "SkPictureRecorder.h"
 #include "SkSVGAttributeParser.h"
 #include "SkSVGCircle.h"
 #include "SkSVGClipPath.h"
@@ -32,6 +34,9 @@
 #include "SkString.h"
 #include "SkTSearch.h"
 #include "SkTo.h"
+#include "SkXMLParser.h"
+
+#include <vector>
 
 namespace {
 
@@ -399,20 +404,40 @@ void set_string_attribute(const sk_sp<SkSVGNode>& node, const char* name, const
     }
 }
 
+void set_node_attribute(const sk_sp<SkSVGNode>& svgNode, const char* name, const char* value,
+                        SkSVGIDMapper* mapper) {
+    // We're handling id attributes out of band for now.
+    if (!strcmp(name, "id")) {
+        mapper->set(SkString(value), svgNode);
+        return;
+    }
+    set_string_attribute(svgNode, name, value);
+}
+
 void parse_node_attributes(const SkDOM& xmlDom, const SkDOM::Node* xmlNode,
                            const sk_sp<SkSVGNode>& svgNode, SkSVGIDMapper* mapper) {
     const char* name, *value;
     SkDOM::AttrIter attrIter(xmlDom, xmlNode);
     while ((name = attrIter.next(&value))) {
-        // We're handling id attributes out of band for now.
-        if (!strcmp(name, "id")) {
-            mapper->set(SkString(value), svgNode);
-            continue;
-        }
-        set_string_attribute(svgNode, name, value);
+        set_node_attribute(svgNode, name, value, mapper);
     }
 }
 
+sk_sp<SkSVGNode> make_svg_node(const char* elem) {
+    const int tagIndex = SkStrSearch(&gTagFactories[0].fKey,
+                                     SkTo<int>(SK_ARRAY_COUNT(gTagFactories)),
+                                     elem, sizeof(gTagFactories[0]));
+    if (tagIndex < 0) {
+#if defined(SK_VERBOSE_SVG_PARSING)
+        SkDebugf("unhandled element: <%s>\n", elem);
+#endif
+        return nullptr;
+    }
+
+    SkASSERT(SkTo<size_t>(tagIndex) < SK_ARRAY_COUNT(gTagFactories));
+    return gTagFactories[tagIndex].fValue();
+}
+
 sk_sp<SkSVGNode> construct_svg_node(const SkDOM& dom, const ConstructionContext& ctx,
                                     const SkDOM::Node* xmlNode) {
     const char* elem = dom.getName(xmlNode);
@@ -426,18 +451,10 @@ sk_sp<SkSVGNode> construct_svg_node(const SkDOM& dom, const ConstructionContext&
 
     SkASSERT(elemType == SkDOM::kElement_Type);
 
-    const int tagIndex = SkStrSearch(&gTagFactories[0].fKey,
-                                     SkTo<int>(SK_ARRAY_COUNT(gTagFactories)),
-                                     elem, sizeof(gTagFactories[0]));
-    if (tagIndex < 0) {
-#if defined(SK_VERBOSE_SVG_PARSING)
-        SkDebugf("unhandled element: <%s>\n", elem);
-#endif
+    sk_sp<SkSVGNode> node = make_svg_node(elem);
+    if (!node) {
         return nullptr;
     }
-
-    SkASSERT(SkTo<size_t>(tagIndex) < SK_ARRAY_COUNT(gTagFactories));
-    sk_sp<SkSVGNode> node = gTagFactories[tagIndex].fValue();
     parse_node_attributes(dom, xmlNode, node, ctx.fIDMapper);
 
     ConstructionContext localCtx(ctx, node);
@@ -452,6 +469,60 @@ sk_sp<SkSVGNode> construct_svg_node(const SkDOM& dom, const ConstructionContext&
     return node;
 }
 
+// Builds the same tree as construct_svg_node(), but straight from the parser callbacks, so the
+// document is never held in memory as an SkDOM. Attribute names and values are used in place in
+// the parser's buffers.
+class SVGNodeBuilder : public SkXMLParser {
+public:
+    explicit SVGNodeBuilder(SkSVGIDMapper* mapper) : fIDMapper(mapper) {}
+
+    sk_sp<SkSVGNode> detachRoot() { return std::move(fRoot); }
+
+protected:
+    bool onStartElement(const char elem[]) override {
+        // Unknown elements are dropped along with everything inside them.
+        sk_sp<SkSVGNode> node;
+        if (!fSkipDepth && !(fRoot && fStack.empty())) {
+            node = make_svg_node(elem);
+        }
+        if (!node) {
+            fSkipDepth++;
+            return false;
+        }
+
+        if (fStack.empty()) {
+            fRoot = node;
+        } else {
+            fStack.back()->appendChild(node);
+        }
+        fStack.push_back(std::move(node));
+        return false;
+    }
+
+    bool onAddAttribute(const char name[], const char value[]) override {
+        if (!fSkipDepth) {
+            SkASSERT(!fStack.empty());
+            set_node_attribute(fStack.back(), name, value, fIDMapper);
+        }
+        return false;
+    }
+
+    bool onEndElement(const char[]) override {
+        if (fSkipDepth) {
+            fSkipDepth--;
+        } else {
+            fStack.pop_back();
+        }
+        return false;
+    }
+
+private:
+    SkSVGIDMapper*                fIDMapper;
+    sk_sp<SkSVGNode>              fRoot;
+    std::vector<sk_sp<SkSVGNode>> fStack;
+    int                           fSkipDepth = 0;
+};
+
 } // anonymous namespace
 
 SkSVGDOM::SkSVGDOM()
@@ -471,15 +542,36 @@ sk_sp<SkSVGDOM> SkSVGDOM::MakeFromDOM(const SkDOM& xmlDom) {
 }
 
 sk_sp<SkSVGDOM> SkSVGDOM::MakeFromStream(SkStream& svgStream) {
-    SkDOM xmlDom;
-    if (!xmlDom.build(svgStream)) {
+    sk_sp<SkSVGDOM> dom = sk_make_sp<SkSVGDOM>();
+
+    SVGNodeBuilder builder(&dom->fIDMapper);
+    if (!builder.parse(svgStream)) {
         return nullptr;
     }
+    dom->fRoot = builder.detachRoot();
+
+    // Reset the default container size to match the intrinsic SVG size.
+    dom->setContainerSize(dom->intrinsicSize());
 
-    return MakeFromDOM(xmlDom);
+    return dom;
 }
 
 void SkSVGDOM::render(SkCanvas* canvas) const {
+    if (!fCacheRendering) {
+        this->renderNodes(canvas);
+        return;
+    }
+
+    if (!fCachedPicture) {
+        SkRTreeFactory factory;
+        SkPictureRecorder recorder;
+        this->renderNodes(recorder.beginRecording(SkRect::MakeSize(fContainerSize), &factory));
+        fCachedPicture = recorder.finishRecordingAsPicture();
+    }
+    canvas->drawPicture(fCachedPicture);
+}
+
+void SkSVGDOM::renderNodes(SkCanvas* canvas) const {
     if (fRoot) {
         SkSVGLengthContext       lctx(fContainerSize);
         SkSVGPresentationContext pctx;
@@ -502,10 +594,20 @@ const SkSize& SkSVGDOM::containerSize() const {
 }
 
 void SkSVGDOM::setContainerSize(const SkSize& containerSize) {
-    // TODO: inval
+    if (containerSize != fContainerSize) {
+        fCachedPicture.reset();
+    }
     fContainerSize = containerSize;
 }
 
 void SkSVGDOM::setRoot(sk_sp<SkSVGNode> root) {
     fRoot = std::move(root);
+    fCachedPicture.reset();
+}
+
+void SkSVGDOM::setCacheRendering(bool cache) {
+    fCacheRendering = cache;
+    if (!cache) {
+        fCachedPicture.reset();
+    }
 }
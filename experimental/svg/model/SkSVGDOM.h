@@ -8,6 +8,7 @@
 #ifndef SkSVGDOM_DEFINED
 #define SkSVGDOM_DEFINED
 
+#include "SkPicture.h"
 #include "SkRefCnt.h"
 #include "SkSize.h"
 #include "SkSVGIDMapper.h"
@@ -31,15 +32,27 @@ public:
 
     void setRoot(sk_sp<SkSVGNode>);
 
+    /**
+     * When enabled, the first render() records the document into an SkPicture with an R-tree,
+     * and later calls play that back, so only the parts of the document that intersect the
+     * canvas clip are drawn. The picture is rebuilt after setRoot() or setContainerSize().
+     * Off by default.
+     */
+    void setCacheRendering(bool);
+
     void render(SkCanvas*) const;
 
 private:
     SkSize intrinsicSize() const;
+    void renderNodes(SkCanvas*) const;
 
     SkSize           fContainerSize;
     sk_sp<SkSVGNode> fRoot;
     SkSVGIDMapper    fIDMapper;
 
+    bool                     fCacheRendering = false;
+    mutable sk_sp<SkPicture> fCachedPicture;
+
     typedef SkRefCnt INHERITED;
 };
 
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkHardwareJpeg_DEFINED
+#define SkHardwareJpeg_DEFINED
+
+#include "SkImageGenerator.h"
+
+class SkData;
+
+namespace SkHardwareJpeg {
+    /**
+     *  Images with fewer pixels than this are left to the CPU; below it the hardware decoder's
+     *  setup cost outweighs the decode and upload it saves.
+     */
+    static constexpr int kMinPixels = 2 * 1024 * 1024;
+
+    /**
+     *  If data is a baseline YCbCr jpeg of at least kMinPixels, with no rotation, and the
+     *  platform has a hardware jpeg decoder that accepts it, decodes it straight into a new
+     *  AHardwareBuffer and returns a generator that wraps that buffer as a texture.  The pixels
+     *  never pass through the CPU and are never uploaded.
+     *
+     *  Returns nullptr otherwise (and always, except on Android with __ANDROID_API__ >= 26 and
+     *  SK_SUPPORT_GPU); callers should then decode with SkCodec as usual.
+     */
+    SK_API std::unique_ptr<SkImageGenerator> MakeGenerator(sk_sp<SkData> data);
+}
+
+#endif//SkHardwareJpeg_DEFINED
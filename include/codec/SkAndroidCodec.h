@@ -263,6 +263,42 @@ public:
      */
     SkCodec::Result getAndroidPixels(const SkImageInfo& info, void* pixels, size_t rowBytes);
 
+    /**
+     *  Returns the dimensions that decodeRegion() will scale |subset| down to,
+     *  when asked for no less than |targetSize|.
+     *
+     *  This is the smallest size at least as large as |targetSize| that the
+     *  codec can reach without resampling. For JPEG, that combines
+     *  libjpeg-turbo's DCT scaling by any of 1/8, 2/8, ..., 8/8 with
+     *  sampling, so it can be much closer to |targetSize| than any
+     *  fSampleSize. If |targetSize| is larger than |subset|, this is the
+     *  size of |subset|.
+     *
+     *  @param subset     Must be a valid subset of the original image
+     *                    dimensions and a subset supported by SkAndroidCodec.
+     *  @return           Size of the scaled region.  Or zero size if either of
+     *                    the inputs is invalid.
+     */
+    SkISize getRegionDimensions(const SkIRect& subset, const SkISize& targetSize) const;
+
+    /**
+     *  Decode |subset| of the image, scaled down to the dimensions of |info|,
+     *  in a single pass.
+     *
+     *  This is meant for clients like tiled viewers, which decode many small
+     *  regions of a large image at various zoom levels. The JPEG decoder only
+     *  decodes the MCU columns covering |subset|, at the reduced DCT scale.
+     *
+     *  @param info   Its dimensions must be those returned by
+     *                getRegionDimensions() for |subset|.
+     *  @param subset Must be a valid subset of the original image
+     *                dimensions and a subset supported by SkAndroidCodec.
+     *  @return Result kSuccess, or another value explaining the type of failure.
+     */
+    SkCodec::Result decodeRegion(const SkImageInfo& info, void* pixels, size_t rowBytes,
+            const SkIRect& subset,
+            SkCodec::ZeroInitialized zeroInit = SkCodec::kNo_ZeroInitialized);
+
     SkCodec::Result getPixels(const SkImageInfo& info, void* pixels, size_t rowBytes) {
         return this->getAndroidPixels(info, pixels, rowBytes);
     }
@@ -279,6 +315,16 @@ protected:
     virtual SkCodec::Result onGetAndroidPixels(const SkImageInfo& info, void* pixels,
             size_t rowBytes, const AndroidOptions& options) = 0;
 
+    /**
+     *  The default implementations pick the largest fSampleSize that keeps
+     *  the region at least as large as |targetSize|, and decode with
+     *  getAndroidPixels().
+     */
+    virtual SkISize onGetRegionDimensions(const SkIRect& subset, const SkISize& targetSize) const;
+
+    virtual SkCodec::Result onDecodeRegion(const SkImageInfo& info, void* pixels,
+            size_t rowBytes, const SkIRect& subset, SkCodec::ZeroInitialized zeroInit);
+
 private:
     const SkImageInfo               fInfo;
     const ExifOrientationBehavior   fOrientationBehavior;
@@ -26,6 +26,7 @@
 
 class SkColorSpace;
 class SkData;
+class SkExecutor;
 class SkFrameHolder;
 class SkPngChunkReader;
 class SkSampler;
@@ -257,6 +258,7 @@ public:
             , fSubset(nullptr)
             , fFrameIndex(0)
             , fPriorFrame(kNoFrame)
+            , fExecutor(nullptr)
         {}
 
         ZeroInitialized            fZeroInitialized;
@@ -300,6 +302,17 @@ public:
          *  If set to kNoFrame, the codec will decode any necessary required frame(s) first.
          */
         int                        fPriorFrame;
+
+        /**
+         *  If not NULL, getPixels() and incrementalDecode() may split the decode into
+         *  independent pieces and run them on this executor.  They still return only once
+         *  every row they report is decoded, and the result is the same as without it.
+         *
+         *  Currently used by getPixels() for baseline JPEGs with restart markers, and by
+         *  getPixels() and incrementalDecode() for non-interlaced PNGs.  Ignored by
+         *  scanline decodes.
+         */
+        SkExecutor*                fExecutor;
     };
 
     /**
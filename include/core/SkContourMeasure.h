@@ -27,6 +27,15 @@ public:
     bool SK_WARN_UNUSED_RESULT getPosTan(SkScalar distance, SkPoint* position,
                                          SkVector* tangent) const;
 
+    /** Calls getPosTan() for each of the count distances, storing the results in positions and
+     *  tangents, either of which may be null. Runs of increasing distances are found without
+     *  searching all of the segments, so this is cheaper than separate calls when sampling
+     *  along the contour.
+     *  Returns false if any distance could not be evaluated; its results are left unchanged.
+     */
+    bool SK_WARN_UNUSED_RESULT getPosTan(const SkScalar distances[], int count,
+                                         SkPoint positions[], SkVector tangents[]) const;
+
     enum MatrixFlags {
         kGetPosition_MatrixFlag     = 0x01,
         kGetTangent_MatrixFlag      = 0x02,
@@ -84,9 +93,18 @@ private:
                      SkScalar length, bool isClosed);
     ~SkContourMeasure() override {}
 
-    const Segment* distanceToSegment(SkScalar distance, SkScalar* t) const;
+    // If segHint is not null, it is the index of the segment found by the previous query, and
+    // is updated to the one found by this query. Queries with increasing distances then walk
+    // forward from it instead of searching all of the segments.
+    const Segment* distanceToSegment(SkScalar distance, SkScalar* t, int* segHint = nullptr) const;
+
+    bool getPosTan(SkScalar distance, SkPoint* position, SkVector* tangent, int* segHint) const;
+    bool getSegment(SkScalar startD, SkScalar stopD, SkPath* dst, bool startWithMoveTo,
+                    int* segHint) const;
 
+    friend class SkContourMeasureCache;
     friend class SkContourMeasureIter;
+    friend class SkPathMeasure;
 };
 
 class SK_API SkContourMeasureIter : SkNoncopyable {
@@ -72,6 +72,13 @@ public:
      */
     static int SetFontCacheCountLimit(int count);
 
+    /**
+     *  Return the number of times the font cache was asked for an entry and already had it, or
+     *  had to create it, since the process started. Text looks up one entry per run it draws.
+     */
+    static int64_t GetFontCacheHitCount();
+    static int64_t GetFontCacheMissCount();
+
     /*
      *  Returns the maximum point size for text that may be cached.
      *
@@ -103,6 +110,22 @@ public:
      */
     static void PurgeFontCache();
 
+    /**
+     *  Write the glyphs currently in the font cache (their metrics, and any images and paths
+     *  already made for them) to a file, so a later process can start with them by calling
+     *  LoadFontCacheSnapshot() instead of rasterizing them again. Glyphs drawn with path effects
+     *  or mask filters are not written. Returns false if the file could not be written.
+     */
+    static bool WriteFontCacheSnapshot(const char path[]);
+
+    /**
+     *  Memory map a file written by WriteFontCacheSnapshot() and add its glyphs to the font
+     *  cache. Glyphs whose typeface can't be found, or is no longer the same font, are skipped.
+     *  Returns false if the file can't be read, was written by an incompatible version of the
+     *  snapshot format, or is corrupt.
+     */
+    static bool LoadFontCacheSnapshot(const char path[]);
+
     /**
      *  Scaling bitmaps with the kHigh_SkFilterQuality setting is
      *  expensive, so the result is saved in the global Scaled Image
@@ -112,6 +135,13 @@ public:
      */
     static size_t GetResourceCacheTotalBytesUsed();
 
+    /**
+     *  Return the number of lookups in the resource cache that found a valid entry, or did not,
+     *  since the process started.
+     */
+    static int64_t GetResourceCacheHitCount();
+    static int64_t GetResourceCacheMissCount();
+
     /**
      *  These functions get/set the memory usage limit for the resource cache, used for temporary
      *  bitmaps and other resources. Entries are purged from the cache when the memory useage
@@ -178,24 +178,42 @@ public:
 
     // Experimental
     enum CompressionType {
-        kETC1_CompressionType,
-        kLast_CompressionType = kETC1_CompressionType,
+        kETC1_CompressionType,  //!< opaque ETC1 RGB8, 8 bytes per 4x4 block
+        kBC1_CompressionType,   //!< opaque BC1 (DXT1) RGB, 8 bytes per 4x4 block
+        kLast_CompressionType = kBC1_CompressionType,
     };
 
     /** Creates a GPU-backed SkImage from compressed data.
 
-        SkImage is returned if format of the compressed data is supported.
-        Supported formats vary by platform.
+        If mipMapped equals GrMipMapped::kYes, data holds every level of the mip chain, largest
+        first, each padded out to whole 4x4 blocks. Otherwise data holds only the base level.
 
-        @param context  GPU context
-        @param data     compressed data to store in SkImage
-        @param width    width of full SkImage
-        @param height   height of full SkImage
-        @param type     type of compression used
-        @return         created SkImage, or nullptr
+        If context cannot texture from the compression type, the data is decompressed and
+        uploaded as RGBA. If context is nullptr, returns the result of
+        MakeRasterFromCompressed().
+
+        @param context    GPU context
+        @param data       compressed data to store in SkImage
+        @param width      width of full SkImage
+        @param height     height of full SkImage
+        @param type       type of compression used
+        @param mipMapped  whether data holds a full mip chain
+        @return           created SkImage, or nullptr
     */
     static sk_sp<SkImage> MakeFromCompressed(GrContext* context, sk_sp<SkData> data,
-                                             int width, int height, CompressionType type);
+                                             int width, int height, CompressionType type,
+                                             GrMipMapped mipMapped = GrMipMapped::kNo);
+
+    /** Creates a raster SkImage by decompressing the base level of compressed data.
+
+        @param data    compressed data, as for MakeFromCompressed()
+        @param width   width of full SkImage
+        @param height  height of full SkImage
+        @param type    type of compression used
+        @return        created SkImage, or nullptr if data is too small
+    */
+    static sk_sp<SkImage> MakeRasterFromCompressed(sk_sp<SkData> data, int width, int height,
+                                                   CompressionType type);
 
     /** User function called when supplied texture may be deleted.
     */
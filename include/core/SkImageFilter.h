@@ -380,6 +380,14 @@ protected:
                                       const Context&,
                                       SkIPoint* offset) const;
 
+    // Helper function which filters every input, as filterInput() does, into results[i] and
+    // offsets[i]. An input that appears more than once in the list is only evaluated once, and
+    // for raster sources the distinct inputs are evaluated in parallel on the default SkExecutor.
+    void filterInputs(SkSpecialImage* src,
+                      const Context&,
+                      sk_sp<SkSpecialImage> results[],
+                      SkIPoint offsets[]) const;
+
     /**
      *  Return true (and return a ref'd colorfilter) if this node in the DAG is just a
      *  colorfilter w/o CropRect constraints.
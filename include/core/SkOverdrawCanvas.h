@@ -61,9 +61,12 @@ private:
     void drawPosTextCommon(const SkGlyphID[], int, const SkScalar[], int, const SkPoint&,
                            const SkFont&, const SkPaint&);
 
-    inline SkPaint overdrawPaint(const SkPaint& paint);
+    inline const SkPaint& overdrawPaint(const SkPaint& paint);
 
     SkPaint   fPaint;
+    // fPaint with the style and stroke width of the current draw, reused to avoid copying fPaint
+    // for every draw.
+    SkPaint   fStyledPaint;
 
     typedef SkCanvasVirtualEnforcer<SkNWayCanvas> INHERITED;
 };
@@ -176,6 +176,30 @@ public:
         kInverseEvenOdd_FillType, //!< is enclosed by an even number of contours
     };
 
+    /** Constructs SkPath from arrays of verbs, SkPoint, and conic weights in one step, without
+        the per-verb bookkeeping of moveTo(), lineTo() and friends. verbs holds SkPath::Verb
+        values in drawing order; each verb consumes as many points as it would when added by
+        the matching call, and each kConic_Verb consumes one weight. Bounds are computed once.
+
+        Returns an empty SkPath with FillType ft if the arrays are inconsistent: if a verb other
+        than kMove_Verb comes before the first kMove_Verb, if a verb is not a valid
+        SkPath::Verb, or if pointCount or conicWeightCount differ from what verbs consume.
+
+        @param pts               array of SkPoint
+        @param pointCount        number of SkPoint in pts
+        @param verbs             array of SkPath::Verb, stored as bytes
+        @param verbCount         number of verbs in verbs
+        @param conicWeights      array of conic weights
+        @param conicWeightCount  number of weights in conicWeights
+        @param ft                FillType of the returned SkPath
+        @param isVolatile        value passed to setIsVolatile()
+        @return                  SkPath containing verbs, pts, and conicWeights
+    */
+    static SkPath Make(const SkPoint pts[], int pointCount,
+                       const uint8_t verbs[], int verbCount,
+                       const SkScalar conicWeights[], int conicWeightCount,
+                       FillType ft, bool isVolatile = false);
+
     /** Returns FillType, the rule used to fill SkPath. FillType of a new SkPath is
         kWinding_FillType.
 
@@ -546,6 +570,15 @@ public:
     */
     void incReserve(int extraPtCount);
 
+    /** Grows SkPath verb array and SkPoint array to contain extraPtCount additional SkPoint
+        and extraVerbCount additional verbs. Use with polylineTo() or addPoly() when the number
+        of verbs is known to differ from the number of points.
+
+        @param extraPtCount    number of additional SkPoint to allocate
+        @param extraVerbCount  number of additional verbs to allocate
+    */
+    void incReserve(int extraPtCount, int extraVerbCount);
+
     /** Shrinks SkPath verb array and SkPoint array storage to discard unused capacity.
         May reduce the heap overhead for SkPath known to be fully constructed.
     */
@@ -604,6 +637,19 @@ public:
         return this->lineTo(p.fX, p.fY);
     }
 
+    /** Adds a line from last point to pts[0], then a line to each following SkPoint in pts,
+        growing the verb and SkPoint arrays once for the whole run. Equivalent to calling
+        lineTo() count times. If SkPath is empty, or last SkPath::Verb is kClose_Verb, last point
+        is set to (0, 0) before adding the first line.
+
+        Has no effect if count is less than one.
+
+        @param pts    end SkPoint of each added line
+        @param count  number of SkPoint in pts
+        @return       reference to SkPath
+    */
+    SkPath& polylineTo(const SkPoint pts[], int count);
+
     /** Adds line from last point to vector (dx, dy). If SkPath is empty, or last SkPath::Verb is
         kClose_Verb, last point is set to (0, 0) before adding line.
 
@@ -1703,6 +1749,8 @@ private:
     size_t readAsRRect(const void*, size_t);
     size_t readFromMemory_LE3(const void*, size_t);
     size_t readFromMemory_EQ4(const void*, size_t);
+    bool readVerbsAndPoints_EQ4(FillType, const SkPoint*, int, const SkScalar*, int,
+                                const uint8_t*, int);
 
     friend class Iter;
     friend class SkPathPriv;
@@ -9,6 +9,7 @@
 #define SkPathMeasure_DEFINED
 
 #include "../private/SkNoncopyable.h"
+#include "../private/SkTArray.h"
 #include "../private/SkTDArray.h"
 #include "SkContourMeasure.h"
 #include "SkPath.h"
@@ -79,8 +80,18 @@ public:
 #endif
 
 private:
-    SkContourMeasureIter    fIter;
-    sk_sp<SkContourMeasure> fContour;
+    // Contours of non-volatile paths come from a cache shared by all measures of the path, and
+    // are handed out from fCachedContours. Other paths are measured one contour at a time.
+    SkContourMeasureIter                fIter;
+    SkTArray<sk_sp<SkContourMeasure>>  fCachedContours;
+    int                                 fNextCachedContour = 0;
+    sk_sp<SkContourMeasure>             fContour;
+    // Where the last query into fContour ended. Dashing and other walks along the path ask for
+    // increasing distances, which are then found without searching the whole contour.
+    int                                 fSegmentHint = 0;
+
+    void reset(const SkPath&, bool forceClosed, SkScalar resScale);
+    sk_sp<SkContourMeasure> nextContourMeasure();
 };
 
 #endif
@@ -25,6 +25,7 @@
 class SkCanvas;
 class SkData;
 struct SkDeserialProcs;
+class SkExecutor;
 class SkImage;
 struct SkSerialProcs;
 class SkStream;
@@ -87,6 +88,18 @@ public:
     static sk_sp<SkPicture> MakeFromData(const void* data, size_t size,
                                          const SkDeserialProcs* procs = nullptr);
 
+    /** Recreates SkPicture that was serialized into data, like MakeFromData(), but reads
+        data in place instead of copying it. The op stream is played back straight from
+        data, and encoded images keep a reference to data and are decoded on first use.
+        Pass SkData::MakeFromFileName() to load a large .skp without reading it into memory.
+
+        @param data   container for serial data; may be a file mapping
+        @param procs  custom serial data decoders; may be nullptr
+        @return       SkPicture constructed from data
+    */
+    static sk_sp<SkPicture> MakeFromMappedData(sk_sp<SkData> data,
+                                               const SkDeserialProcs* procs = nullptr);
+
     /** \class SkPicture::AbortCallback
         AbortCallback is an abstract class. An implementation of AbortCallback may
         passed as a parameter to SkPicture::playback, to stop it before all drawing
@@ -133,6 +146,20 @@ public:
     */
     virtual void playback(SkCanvas* canvas, AbortCallback* callback = nullptr) const = 0;
 
+    /** Replays the drawing commands on the specified canvas, splitting the canvas clip into
+        tiles of tileSize and playing back each tile on executor. Each tile is drawn directly
+        into the pixels of canvas, and is culled against the picture's bounding box hierarchy,
+        if it has one. The result matches playback().
+
+        Falls back to playback() on the calling thread if canvas pixels are not accessible,
+        if canvas clip is not SkRect, if executor is nullptr, or if tileSize is empty.
+
+        @param canvas    receiver of drawing commands; typically raster
+        @param executor  runs tiles in parallel; may be nullptr
+        @param tileSize  width and height of each tile in device pixels
+    */
+    void playbackTiled(SkCanvas* canvas, SkExecutor* executor, SkISize tileSize) const;
+
     /** Returns cull SkRect for this picture, passed in when SkPicture was created.
         Returned SkRect does not specify clipping SkRect for SkPicture; cull is hint
         of SkPicture bounds.
@@ -213,7 +240,8 @@ private:
 
     void serialize(SkWStream*, const SkSerialProcs*, class SkRefCntSet* typefaces) const;
     static sk_sp<SkPicture> MakeFromStream(SkStream*, const SkDeserialProcs*,
-                                           class SkTypefacePlayback*);
+                                           class SkTypefacePlayback*,
+                                           const SkData* mapped = nullptr);
     friend class SkPictureData;
 
     /** Return true if the SkStream/Buffer represents a serialized picture, and
@@ -267,10 +295,12 @@ private:
     // V66: Add saveBehind
     // V67: Blobs serialize fonts instead of paints
     // V68: Paint doesn't serialize font-related stuff
+    // V69: Pad streams so the op data and buffer are 4-byte aligned
+    // V70: Repeated flattenables in the picture buffer refer back to their first copy
 
     // Only SKPs within the min/current picture version range (inclusive) can be read.
     static const uint32_t     MIN_PICTURE_VERSION = 56;     // august 2017
-    static const uint32_t CURRENT_PICTURE_VERSION = 68;
+    static const uint32_t CURRENT_PICTURE_VERSION = 70;
 
     static_assert(MIN_PICTURE_VERSION <= 62, "Remove kFontAxes_bad from SkFontDescriptor.cpp");
 
@@ -36,6 +36,10 @@ public:
         // If you call drawPicture() or drawDrawable() on the recording canvas, this flag forces
         // that object to playback its contents immediately rather than reffing the object.
         kPlaybackDrawPicture_RecordFlag     = 1 << 0,
+        // Compare the new recording against the last picture this recorder finished with the
+        // same flag. If every op is unchanged, finishRecordingAsPicture() returns that picture
+        // again; if only op bounds are unchanged, its bounding box hierarchy is shared.
+        kReuseUnchanged_RecordFlag          = 1 << 1,
     };
 
     enum FinishFlags {
@@ -111,6 +115,8 @@ private:
     friend class SkPictureRecorderReplayTester; // for unit testing
     void partialReplay(SkCanvas* canvas) const;
 
+    struct ReuseState;
+
     bool                        fActivelyRecording;
     uint32_t                    fFlags;
     SkRect                      fCullRect;
@@ -118,6 +124,7 @@ private:
     std::unique_ptr<SkRecorder> fRecorder;
     sk_sp<SkRecord>             fRecord;
     std::unique_ptr<SkMiniRecorder> fMiniRecorder;
+    std::unique_ptr<ReuseState> fReuse;
 
     typedef SkNoncopyable INHERITED;
 };
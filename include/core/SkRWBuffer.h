@@ -14,6 +14,7 @@ struct SkBufferBlock;
 struct SkBufferHead;
 class SkRWBuffer;
 class SkStreamAsset;
+class SkStreamRewindable;
 
 /**
  *  Contains a read-only, thread-sharable block of memory. To access the memory, the caller must
@@ -96,6 +97,18 @@ public:
 
     std::unique_ptr<SkStreamAsset> makeStreamSnapshot() const;
 
+    /**
+     *  Returns a stream that, unlike a snapshot, keeps up with bytes appended after it was made.
+     *  It may be read on another thread while this thread goes on appending, without locking:
+     *  a read returns whatever has been appended so far, so a short read means the data has not
+     *  arrived yet. The stream may outlive this buffer.
+     *
+     *  This is meant for decoding data while it downloads. Make one SkCodec from the stream once
+     *  the header has arrived, then call SkCodec::incrementalDecode() after each append(); it
+     *  resumes where the previous call ran out of data instead of parsing the image again.
+     */
+    std::unique_ptr<SkStreamRewindable> makeGrowingStream();
+
 #ifdef SK_DEBUG
     void validate() const;
 #else
@@ -357,6 +357,12 @@ private:
     size_t fOffset;
     size_t fOriginalOffset;
 
+    // Small reads are served from fBuffer, which holds the bytes of the file from fBufferOffset
+    // on, so that reading a few bytes at a time doesn't take a system call each.
+    std::unique_ptr<char[]> fBuffer;
+    size_t fBufferOffset;
+    size_t fBufferLength;
+
     typedef SkStreamAsset INHERITED;
 };
 
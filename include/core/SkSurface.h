@@ -670,6 +670,60 @@ public:
     */
     bool readPixels(const SkBitmap& dst, int srcX, int srcY);
 
+    /** Caller data passed to ReadPixelsCallback and ReadPixelsYUV420Callback; may be nullptr. */
+    typedef void* ReadPixelsContext;
+
+    /** User function called when an asyncReadPixels() request completes. pixels is nullptr if
+        the read failed; otherwise it points to rows rowBytes apart that are only valid for the
+        duration of the call.
+    */
+    typedef void (*ReadPixelsCallback)(ReadPixelsContext context, const void* pixels,
+                                       size_t rowBytes);
+
+    /** User function called when an asyncReadPixelsYUV420() request completes. planes holds the
+        Y, U and V planes in that order, or is nullptr if the read failed. The planes are only
+        valid for the duration of the call.
+    */
+    typedef void (*ReadPixelsYUV420Callback)(ReadPixelsContext context, const void* planes[3],
+                                             const size_t rowBytes[3]);
+
+    /** Copies SkRect of pixels from SkSurface like readPixels(), but passes them to callback
+        instead of waiting for them.
+
+        Source SkRect corners are (srcX, srcY) and (srcX + dstInfo.width(),
+        srcY + dstInfo.height()), and must be contained in SkSurface. Otherwise callback is
+        called with nullptr.
+
+        On a GPU-backed SkSurface pending drawing is flushed and the pixels are copied into a
+        transfer buffer on the GPU. callback is called once the GPU has finished, by a later
+        flush or by GrContext::checkAsyncWorkCompletion(), so several frames can be in flight.
+        Raster surfaces, and GPU reads that need conversions the GPU can't do, read the pixels
+        immediately and call callback before returning.
+
+        @param dstInfo   width, height, SkColorType, and SkAlphaType of the pixels to read
+        @param srcX      offset into readable pixels on x-axis
+        @param srcY      offset into readable pixels on y-axis
+        @param callback  function called with the pixels
+        @param context   passed to callback
+    */
+    void asyncReadPixels(const SkImageInfo& dstInfo, int srcX, int srcY,
+                         ReadPixelsCallback callback, ReadPixelsContext context);
+
+    /** Converts srcRect of SkSurface to YUV with 4:2:0 subsampling and passes the planes to
+        callback, as asyncReadPixels() does. The conversion is drawn, so on a GPU-backed
+        SkSurface it runs on the GPU and only the planes are read back.
+
+        The Y plane is srcRect.width() by srcRect.height() bytes. The U and V planes are half
+        that, rounded up, and average 2x2 blocks of source pixels.
+
+        @param yuvColorSpace  the coefficients and range of the conversion
+        @param srcRect        area of SkSurface to convert; must be contained in SkSurface
+        @param callback       function called with the planes
+        @param context        passed to callback
+    */
+    void asyncReadPixelsYUV420(SkYUVColorSpace yuvColorSpace, const SkIRect& srcRect,
+                               ReadPixelsYUV420Callback callback, ReadPixelsContext context);
+
     /** Copies SkRect of pixels from the src SkPixmap to the SkSurface.
 
         Source SkRect corners are (0, 0) and (src.width(), src.height()).
@@ -159,6 +159,19 @@ struct Metadata {
         Experimental.
     */
     SkExecutor* fExecutor = nullptr;
+
+    /** PDF streams may be compressed to save space.
+        Use this to specify the desired compression vs time tradeoff.
+        With an fExecutor, large streams are also cut into blocks that are
+        compressed in parallel, which costs a few bytes per 128 KiB.
+    */
+    enum class CompressionLevel : int {
+        Default = -1,
+        None = 0,
+        LowButFast = 1,
+        Average = 6,
+        HighButSlow = 9,
+    } fCompressionLevel = CompressionLevel::Default;
 };
 
 /** Associate a node ID with subsequent drawing commands in an
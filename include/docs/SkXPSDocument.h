@@ -14,13 +14,18 @@
 
 #include "SkDocument.h"
 
+class SkExecutor;
 struct IXpsOMObjectFactory;
 
 namespace SkXPS {
 
+/** If executor is not nullptr, it is used to subset the embedded fonts in
+    parallel when the document is closed. The caller retains ownership.
+*/
 SK_API sk_sp<SkDocument> MakeDocument(SkWStream* stream,
                                       IXpsOMObjectFactory* xpsFactory,
-                                      SkScalar dpi = SK_ScalarDefaultRasterDPI);
+                                      SkScalar dpi = SK_ScalarDefaultRasterDPI,
+                                      SkExecutor* executor = nullptr);
 
 }  // namespace SkXPS
 #endif  // SK_BUILD_FOR_WIN
@@ -15,10 +15,29 @@
 class SK_API SkEncoder : SkNoncopyable {
 public:
 
+    /**
+     *  Supplies the pixels to encode a few rows at a time, rather than as one SkPixmap.  This lets
+     *  us encode images too large to hold in memory, e.g. an SkPicture rasterized in strips.
+     */
+    class SK_API RowSource {
+    public:
+        virtual ~RowSource() {}
+
+        /**
+         *  Write rows [y, y + dst.height()) of the image into |dst|, which has the width, color
+         *  type, alpha type and color space that the encoder was created with.  Rows are
+         *  requested in order, each exactly once.  Return false to fail the encode.
+         */
+        virtual bool readRows(int y, const SkPixmap& dst) = 0;
+    };
+
     /**
      *  Encode |numRows| rows of input.  If the caller requests more rows than are remaining
      *  in the src, this will encode all of the remaining rows.  |numRows| must be greater
      *  than zero.
+     *
+     *  When encoding from a RowSource, the rows are read into a buffer of |numRows| rows,
+     *  so the size of each call decides how much memory the encode uses.
      */
     bool encodeRows(int numRows);
 
@@ -32,11 +51,32 @@ protected:
         : fSrc(src)
         , fCurrRow(0)
         , fStorage(storageBytes)
+        , fRowSource(nullptr)
+        , fRowsAllocated(0)
+    {}
+
+    SkEncoder(const SkImageInfo& info, RowSource* source, size_t storageBytes)
+        : fSrc(info, nullptr, info.minRowBytes())
+        , fCurrRow(0)
+        , fStorage(storageBytes)
+        , fRowSource(source)
+        , fRowsAllocated(0)
     {}
 
-    const SkPixmap&        fSrc;
+    /**
+     *  Returns row |y| of the input, which must be one of the rows passed to onEncodeRows().
+     */
+    const void* srcRow(int y) const;
+
+    // When encoding from a RowSource, this describes the image but has no pixels.
+    const SkPixmap         fSrc;
     int                    fCurrRow;
     SkAutoTMalloc<uint8_t> fStorage;
+
+private:
+    RowSource*             fRowSource;
+    SkAutoTMalloc<uint8_t> fRows;
+    int                    fRowsAllocated;
 };
 
 #endif
@@ -82,6 +82,18 @@ public:
     static std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src,
                                            const Options& options);
 
+    /**
+     *  Create a jpeg encoder that will encode an image described by |info| to the |dst| stream,
+     *  reading its pixels from |source| as encodeRows() is called.
+     *  |options| may be used to control the encoding behavior.
+     *
+     *  |dst| and |source| are unowned but must remain valid for the lifetime of the object.
+     *
+     *  This returns nullptr on an invalid or unsupported |info|.
+     */
+    static std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkImageInfo& info,
+                                           RowSource* source, const Options& options);
+
     ~SkJpegEncoder() override;
 
 protected:
@@ -89,6 +101,7 @@ protected:
 
 private:
     SkJpegEncoder(std::unique_ptr<SkJpegEncoderMgr>, const SkPixmap& src);
+    SkJpegEncoder(std::unique_ptr<SkJpegEncoderMgr>, const SkImageInfo& info, RowSource* source);
 
     std::unique_ptr<SkJpegEncoderMgr> fEncoderMgr;
     typedef SkEncoder INHERITED;
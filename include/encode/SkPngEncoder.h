@@ -80,12 +80,25 @@ public:
     static std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src,
                                            const Options& options);
 
+    /**
+     *  Create a png encoder that will encode an image described by |info| to the |dst| stream,
+     *  reading its pixels from |source| as encodeRows() is called.
+     *  |options| may be used to control the encoding behavior.
+     *
+     *  |dst| and |source| are unowned but must remain valid for the lifetime of the object.
+     *
+     *  This returns nullptr on an invalid or unsupported |info|.
+     */
+    static std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkImageInfo& info,
+                                           RowSource* source, const Options& options);
+
     ~SkPngEncoder() override;
 
 protected:
     bool onEncodeRows(int numRows) override;
 
     SkPngEncoder(std::unique_ptr<SkPngEncoderMgr>, const SkPixmap& src);
+    SkPngEncoder(std::unique_ptr<SkPngEncoderMgr>, const SkImageInfo& info, RowSource* source);
 
     std::unique_ptr<SkPngEncoderMgr> fEncoderMgr;
     typedef SkEncoder INHERITED;
@@ -10,6 +10,7 @@
 
 #include "SkEncoder.h"
 
+class SkExecutor;
 class SkWStream;
 
 namespace SkWebpEncoder {
@@ -19,6 +20,18 @@ namespace SkWebpEncoder {
         kLossless,
     };
 
+    /**
+     *  Presets trading encoding speed for file size.  They pick libwebp's |method| and, for
+     *  lossy compression, its number of |segments| and token |partitions|.
+     */
+    enum class Speed {
+        kDefault,   // Chrome's choices: method 3 for lossy, 0 for lossless.
+        kFastest,
+        kFast,
+        kSmall,
+        kSmallest,
+    };
+
     struct SK_API Options {
         /**
          *  |fCompression| determines whether we will use webp lossy or lossless compression.
@@ -34,6 +47,22 @@ namespace SkWebpEncoder {
          */
         Compression fCompression = Compression::kLossy;
         float fQuality = 100.0f;
+
+        /**
+         *  Trades encoding speed for file size.  See Speed above.
+         */
+        Speed fSpeed = Speed::kDefault;
+
+        /**
+         *  If not NULL, libwebp may use a second thread within each encode, and EncodeAnimated()
+         *  encodes its frames concurrently on this executor.  The output does not change.
+         */
+        SkExecutor* fExecutor = nullptr;
+    };
+
+    struct SK_API Frame {
+        SkPixmap fPixmap;
+        int      fDuration;  // In milliseconds.
     };
 
     /**
@@ -43,6 +72,17 @@ namespace SkWebpEncoder {
      *  Returns true on success.  Returns false on an invalid or unsupported |src|.
      */
     SK_API bool Encode(SkWStream* dst, const SkPixmap& src, const Options& options);
+
+    /**
+     *  Encode |frameCount| |frames| as an animated webp, looping forever, to the |dst| stream.
+     *  Every frame must have the dimensions of the first, and the color space of the first is
+     *  the one embedded.  Each frame is encoded on its own, as a key frame, so that with
+     *  |options|.fExecutor they can be encoded in parallel.
+     *
+     *  Returns true on success.  Returns false on invalid or unsupported |frames|.
+     */
+    SK_API bool EncodeAnimated(SkWStream* dst, const Frame frames[], int frameCount,
+                               const Options& options);
 }
 
 #endif
@@ -8,6 +8,7 @@
 #ifndef GrContext_DEFINED
 #define GrContext_DEFINED
 
+#include "SkImage.h"
 #include "SkMatrix.h"
 #include "SkPathEffect.h"
 #include "SkTypes.h"
@@ -26,6 +27,7 @@ class GrContextThreadSafeProxy;
 class GrFragmentProcessor;
 struct GrGLInterface;
 class GrGpu;
+class GrOpTimingDump;
 struct GrMockOptions;
 class GrPath;
 class GrRenderTargetContext;
@@ -157,6 +159,8 @@ public:
     /**
      *  Specify the GPU resource cache limits. If the current cache exceeds either
      *  of these, it will be purged (LRU) to keep the cache within these limits.
+     *  The budget of the text blob cache scales with maxResourceBytes: it is 4MB
+     *  for the default 96MB.
      *
      *  @param maxResources The maximum number of resources that can be held in
      *                      the cache.
@@ -173,7 +177,8 @@ public:
 
     /**
      * Purge GPU resources that haven't been used in the past 'msNotUsed' milliseconds or are
-     * otherwise marked for deletion, regardless of whether the context is under budget.
+     * otherwise marked for deletion, regardless of whether the context is under budget. Cached
+     * text blobs that haven't been drawn in that time are purged too.
      */
     void performDeferredCleanup(std::chrono::milliseconds msNotUsed);
 
@@ -224,6 +229,12 @@ public:
      */
     bool colorTypeSupportedAsImage(SkColorType) const;
 
+    /**
+     * Can the GPU texture directly from data of the given compression type. If not,
+     * SkImage::MakeFromCompressed() decompresses the data before uploading it.
+     */
+    bool compressionTypeSupported(SkImage::CompressionType) const;
+
     /**
      * Can a SkSurface be created with the given color type. To check whether MSAA is supported
      * use maxSurfaceSampleCountForColorType().
@@ -304,10 +315,46 @@ public:
     // Chrome is using this!
     void dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const;
 
+    /**
+     * Starts or stops measuring the GPU time of each op and op list with timestamp queries. Each
+     * query adds a little GPU work, so this is off by default. Returns false if the backend
+     * can't measure GPU time; currently that needs GL with timer queries.
+     */
+    bool setOpTimingEnabled(bool enabled);
+
+    /**
+     * Reports the GPU time of the ops and op lists executed since the previous call, totaled by
+     * class, to opTimingDump. Timings show up a few flushes late, once the GPU has actually
+     * finished the work.
+     */
+    void dumpOpTimings(GrOpTimingDump* opTimingDump);
+
+    /**
+     * Calls back the SkSurface::asyncReadPixels() requests whose GPU work has finished. Flushes
+     * check too, so this is only needed when nothing is being drawn. If waitForAll is true, blocks
+     * until every outstanding request has been called back.
+     */
+    void checkAsyncWorkCompletion(bool waitForAll = false);
+
     bool supportsDistanceFieldText() const;
 
     void storeVkPipelineCacheData();
 
+    /**
+     * Compiles the program identified by key so that no draw has to wait for it later. The key
+     * must be one that this context's GrContextOptions::PersistentCache has already stored data
+     * for, e.g. one recorded by tools/skp_program_keys or read back from a GrFilePersistentCache;
+     * the program is built from that data rather than from scratch. Returns false if the backend
+     * doesn't support precompiling (currently only GL does), if the cache has no data for key, or
+     * if the data doesn't compile.
+     *
+     * This can be called on a worker thread with its own GrContext made on a GL context that
+     * shares objects with the one used for drawing, as long as both GrContexts use the same
+     * PersistentCache. Note that the compiled program lives in the program cache of the GrContext
+     * that precompile() is called on.
+     */
+    bool precompile(const SkData& key);
+
 protected:
     GrContext(GrBackendApi, const GrContextOptions&, int32_t contextID = SK_InvalidGenID);
 
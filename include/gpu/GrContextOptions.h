@@ -72,6 +72,28 @@ struct SK_API GrContextOptions {
      */
     SkExecutor* fExecutor = nullptr;
 
+    /**
+     * If true, and fExecutor is set, the Vulkan backend issues the commands for each render pass
+     * to its secondary command buffers on fExecutor's threads, while later GrOpLists in the flush
+     * are still being executed. The primary command buffer is then filled in when the flush is
+     * submitted.
+     */
+    bool fParallelVulkanRecording = false;
+
+    /**
+     * Size in bytes of the VkDeviceMemory blocks that the Vulkan backend's default memory
+     * allocator sub-allocates images and buffers from. Zero selects the default of 4MB. Ignored
+     * when the client supplies its own GrVkMemoryAllocator.
+     */
+    size_t fVulkanMemoryBlockSize = 0;
+
+    /**
+     * Images and buffers needing at least this many bytes get their own VkDeviceMemory from the
+     * Vulkan backend's default memory allocator instead of a slice of a shared block. Keeping large
+     * allocations out of the shared blocks limits how much they fragment. Zero disables this.
+     */
+    size_t fVulkanDedicatedAllocationThreshold = 0;
+
     /** Construct mipmaps manually, via repeated downsampling draw-calls. This is used when
         the driver's implementation (glGenerateMipmap) contains bugs. This requires mipmap
         level and LOD control (ie desktop or ES3). */
@@ -102,6 +124,21 @@ struct SK_API GrContextOptions {
      */
     bool fDisableGpuYUVConversion = false;
 
+    /**
+     * If true, and fExecutor is set, codec-backed images that can decode to YUV planes are decoded
+     * on fExecutor's threads when they are first drawn, instead of on the recording thread. The
+     * planes are uploaded when the draw is flushed and converted to RGB on the GPU.
+     */
+    bool fDecodeYUVImagesOnWorkerThreads = false;
+
+    /**
+     * If nonzero, and fExecutor is set, opaque codec-backed images are also compressed to ETC1 on
+     * fExecutor's threads when they are uploaded, and kept in a CPU-side cache of up to this many
+     * bytes. When the GPU resource cache purges such an image's texture, it is re-uploaded from
+     * the compressed blocks instead of being decoded again. Ignored if the GPU can't sample ETC1.
+     */
+    size_t fCompressedImageCacheBytes = 0;
+
     /**
      * The maximum size of cache textures used for Skia's Glyph cache.
      */
@@ -120,12 +157,28 @@ struct SK_API GrContextOptions {
      */
     float fGlyphsAsPathsFontSize = -1.f;
 
+    /**
+     * Draw distance field text from multi-channel distance fields generated from the glyph
+     * outlines. These keep glyph corners sharp when magnified, so a single atlas entry serves a
+     * much wider range of scales and the default fGlyphsAsPathsFontSize is raised accordingly.
+     * The fields are stored in the color glyph atlas and cost four times the memory.
+     */
+    bool fMultiChannelDistanceFieldText = false;
+
     /**
      * Can the glyph atlas use multiple textures. If allowed, the each texture's size is bound by
      * fGlypheCacheTextureMaximumBytes.
      */
     Enable fAllowMultipleGlyphCacheTextures = Enable::kDefault;
 
+    /**
+     * The most textures the glyph atlas may use for each mask format when it is allowed to use
+     * more than one. Extra textures are only created once the earlier ones fill up and are
+     * released again when they fall out of use. Values above 4 are limited to 16 and by the
+     * number of texture samplers the GPU supports.
+     */
+    int fMaxGlyphCacheTextures = 4;
+
     /**
      * Bugs on certain drivers cause stencil buffers to leak. This flag causes Skia to avoid
      * allocating stencil buffers and use alternate rasterization paths, avoiding the leak.
@@ -164,6 +217,40 @@ struct SK_API GrContextOptions {
      */
     Enable fReduceOpListSplitting = Enable::kDefault;
 
+    /**
+     * Ganesh normally only tries to merge a new op with the last few ops recorded to its opList.
+     * With this set it will try every earlier op that the new one can be reordered past, using a
+     * spatial index of the recorded ops' bounds to find them quickly. This can save many draws
+     * when text, rects and images are interleaved, at some cost in recording time.
+     */
+    bool fUnboundedOpMerging = false;
+
+    /**
+     * With this set, a picture drawn with SkCanvas::drawPicture() on a GrContext's surface is
+     * rendered once into a budgeted texture, keyed by the picture and its device-space transform,
+     * and later draws of the same picture under the same transform just composite that texture.
+     * Nested pictures are retained the same way. This saves re-recording the picture's ops when
+     * static content is drawn every frame. Because the texture is drawn with src-over, pictures
+     * containing other blend modes, and antialiased clip edges, may render slightly differently.
+     */
+    bool fRetainPictureDraws = false;
+
+    /**
+     * When the backend supports it, image draws of different textures are batched into a single
+     * draw that samples from an array of textures, choosing one per quad. This disables that and
+     * falls back to one mesh per texture.
+     */
+    bool fDisableImageMultitexturing = false;
+
+    /**
+     * By default, going over the resource cache budget releases enough purgeable resources to get
+     * back under it right away, which can put a burst of driver object deletions in the middle of
+     * a frame. When this is non-zero, the cache instead purges down to slightly under its budget
+     * over several flushes, releasing at most this many bytes of resources per flush.
+     * GrContext::performDeferredCleanup() finishes any purge that is still in progress.
+     */
+    size_t fResourceCacheIncrementalPurgeBytes = 0;
+
     /**
      * Some ES3 contexts report the ES2 external image extension, but not the ES3 version.
      * If support for external images is critical, enabling this option will cause Ganesh to limit
@@ -178,6 +265,12 @@ struct SK_API GrContextOptions {
      */
     bool fDisableDriverCorrectnessWorkarounds = false;
 
+    /**
+     * Maximum number of GPU programs or pipelines to keep active in the runtime cache. The Vulkan
+     * backend may grow its cache up to four times this size when draws keep missing it.
+     */
+    int fRuntimeProgramCacheSize = 256;
+
     /**
      * Cache in which to store compiled shader binaries between runs.
      */
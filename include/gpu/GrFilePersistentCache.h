@@ -0,0 +1,88 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrFilePersistentCache_DEFINED
+#define GrFilePersistentCache_DEFINED
+
+#include "GrContextOptions.h"
+#include "SkData.h"
+#include "SkString.h"
+#include "../private/SkMutex.h"
+#include "../private/SkOnce.h"
+
+#include <memory>
+#include <unordered_map>
+
+class SkExecutor;
+class SkTaskGroup;
+
+/**
+ * A GrContextOptions::PersistentCache backed by a single file. The file is memory-mapped when
+ * first needed, and load() hands out zero-copy views into the mapping. New entries from store()
+ * are kept in memory until flush() writes the whole cache back out.
+ *
+ * The keys in the file are the program descriptions GrContexts asked for in earlier runs, so the
+ * file doubles as a manifest of the programs an app will need at startup. Call preload() right
+ * after creating the cache to map and index it on an SkExecutor, off the thread that will
+ * issue the first flush.
+ *
+ * The cache may be shared by multiple GrContexts with the same options and caps, and its methods
+ * may be called from any thread.
+ */
+class SK_API GrFilePersistentCache : public GrContextOptions::PersistentCache {
+public:
+    explicit GrFilePersistentCache(const char path[]);
+    ~GrFilePersistentCache() override;
+
+    GrFilePersistentCache(const GrFilePersistentCache&) = delete;
+    GrFilePersistentCache& operator=(const GrFilePersistentCache&) = delete;
+
+    sk_sp<SkData> load(const SkData& key) override;
+    void store(const SkData& key, const SkData& data) override;
+
+    /**
+     * Maps the file, indexes its entries, and touches every cached blob on executor, so that the
+     * first load() calls don't stall on disk. Does nothing if the cache has already been indexed.
+     */
+    void preload(SkExecutor* executor);
+
+    /** Number of entries, both from the file and from calls to store(). */
+    int count();
+
+    /**
+     * Writes every entry back to the file if anything new has been stored since it was read.
+     * Returns false if the file could not be written.
+     */
+    bool flush();
+
+private:
+    struct Key {
+        Key() = default;
+        explicit Key(sk_sp<SkData> key) : fKey(std::move(key)) {}
+        bool operator==(const Key& that) const {
+            return that.fKey->size() == fKey->size() &&
+                   !memcmp(fKey->data(), that.fKey->data(), that.fKey->size());
+        }
+        sk_sp<SkData> fKey;
+    };
+
+    struct Hash {
+        size_t operator()(const Key& key) const;
+    };
+
+    void readFile();
+    void ensureIndexed() { fIndexOnce([this] { this->readFile(); }); }
+
+    SkString                                     fPath;
+    SkOnce                                       fIndexOnce;
+    std::unique_ptr<SkTaskGroup>                 fPreload;
+    SkMutex                                      fMutex;
+    std::unordered_map<Key, sk_sp<SkData>, Hash> fMap;
+    bool                                         fDirty = false;
+};
+
+#endif
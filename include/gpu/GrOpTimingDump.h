@@ -0,0 +1,34 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrOpTimingDump_DEFINED
+#define GrOpTimingDump_DEFINED
+
+#include "SkTypes.h"
+
+/**
+ * Interface for reading back GPU op timings, see GrContext::setOpTimingEnabled().
+ * This interface is meant to be passed as argument to GrContext::dumpOpTimings().
+ * The implementation of this interface is provided by the embedder.
+ */
+class SK_API GrOpTimingDump {
+public:
+    virtual ~GrOpTimingDump() = default;
+
+    /**
+     *  Reports the GPU time spent on one kind of work since the previous dump.
+     *  Arguments:
+     *    name: the class name of the GrOp, e.g. "CircleOp", or of the GrOpList, e.g.
+     *        "GrRenderTargetOpList". An op list's time includes its ops and the clears, loads
+     *        and stores around them.
+     *    count: the number of op chains or op lists that were timed.
+     *    gpuNanoseconds: their total GPU time.
+     */
+    virtual void dumpOpTiming(const char* name, int count, uint64_t gpuNanoseconds) = 0;
+};
+
+#endif
@@ -11,6 +11,7 @@
 #include "../private/SkTDArray.h"
 #include "SkPreConfig.h"
 
+class SkExecutor;
 class SkPath;
 struct SkRect;
 
@@ -96,10 +97,16 @@ public:
     /** Computes the sum of all paths and operands, and resets the builder to its
         initial state.
 
+        If every operand is a union with a non-inverse path and executor is not null, the
+        paths are unioned pairwise in a tree instead of one after another, with each level's
+        pairs running as tasks on executor. Paths whose bounds can't reach each other, even
+        through other paths, are resolved separately and never intersected.
+
         @param result The product of the operands.
+        @param executor Optional executor for the tree union.
         @return True if the operation succeeded.
       */
-    bool resolve(SkPath* result);
+    bool resolve(SkPath* result, SkExecutor* executor = nullptr);
 
 private:
     SkTArray<SkPath> fPathRefs;
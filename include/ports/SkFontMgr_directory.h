@@ -18,4 +18,11 @@ class SkFontMgr;
  */
 SK_API sk_sp<SkFontMgr> SkFontMgr_New_Custom_Directory(const char* dir);
 
+/** Create a custom font manager which scans a given directory for font files, keeping what it
+ *  learns about each file in an index at 'indexPath'. Files which have not changed since they
+ *  were indexed are not opened until one of their typefaces is used, and the index records the
+ *  characters each face maps so matchFamilyStyleCharacter() can find a fallback.
+ */
+SK_API sk_sp<SkFontMgr> SkFontMgr_New_Custom_Directory(const char* dir, const char* indexPath);
+
 #endif // SkFontMgr_directory_DEFINED
@@ -59,8 +59,9 @@ enum GrPixelConfig {
     kRGBA_half_GrPixelConfig,
     kRGBA_half_Clamped_GrPixelConfig,
     kRGB_ETC1_GrPixelConfig,
+    kRGB_BC1_GrPixelConfig,
 
-    kLast_GrPixelConfig = kRGB_ETC1_GrPixelConfig
+    kLast_GrPixelConfig = kRGB_BC1_GrPixelConfig
 };
 static const int kGrPixelConfigCnt = kLast_GrPixelConfig + 1;
 
@@ -748,8 +749,9 @@ enum class GrGpuBufferType {
     kIndex,
     kXferCpuToGpu,
     kXferGpuToCpu,
+    kDrawIndirect,
 };
-static const int kGrGpuBufferTypeCount = static_cast<int>(GrGpuBufferType::kXferGpuToCpu) + 1;
+static const int kGrGpuBufferTypeCount = static_cast<int>(GrGpuBufferType::kDrawIndirect) + 1;
 
 /**
  * Provides a performance hint regarding the frequency at which a data store will be accessed.
@@ -761,8 +763,14 @@ enum GrAccessPattern {
     kStatic_GrAccessPattern,
     /** Data store will be specified once and used at most a few times. (Also can't be cached.) */
     kStream_GrAccessPattern,
+    /**
+     * Data store is mapped once for writing and stays mapped while the GPU reads from it. The
+     * client must not overwrite data the GPU may still be reading. Requires
+     * GrCaps::persistentlyMappedBufferSupport().
+     */
+    kPersistentlyMapped_GrAccessPattern,
 
-    kLast_GrAccessPattern = kStream_GrAccessPattern
+    kLast_GrAccessPattern = kPersistentlyMapped_GrAccessPattern
 };
 
 // Flags shared between the GrSurface & GrSurfaceProxy class hierarchies
@@ -827,6 +835,11 @@ T* const* unique_ptr_address_as_pointer_address(std::unique_ptr<T> const* up) {
  */
 typedef uint64_t GrFence;
 
+/*
+ * A GPU timestamp recorded between commands, see GrGpu::insertTimestampQuery()
+ */
+typedef uint64_t GrTimestampQuery;
+
 /**
  * Used to include or exclude specific GPU path renderers for testing purposes.
  */
@@ -902,6 +915,7 @@ static inline GrSRGBEncoded GrPixelConfigIsSRGBEncoded(GrPixelConfig config) {
         case kRGBA_half_GrPixelConfig:
         case kRGBA_half_Clamped_GrPixelConfig:
         case kRGB_ETC1_GrPixelConfig:
+        case kRGB_BC1_GrPixelConfig:
             return GrSRGBEncoded::kNo;
     }
     SK_ABORT("Invalid pixel config");
@@ -944,6 +958,7 @@ static inline size_t GrBytesPerPixel(GrPixelConfig config) {
             return 8;
         case kUnknown_GrPixelConfig:
         case kRGB_ETC1_GrPixelConfig:
+        case kRGB_BC1_GrPixelConfig:
             return 0;
     }
     SK_ABORT("Invalid pixel config");
@@ -961,6 +976,7 @@ static inline bool GrPixelConfigIsOpaque(GrPixelConfig config) {
         case kGray_8_as_Red_GrPixelConfig:
         case kRG_float_GrPixelConfig:
         case kRGB_ETC1_GrPixelConfig:
+        case kRGB_BC1_GrPixelConfig:
             return true;
         case kAlpha_8_GrPixelConfig:
         case kAlpha_8_as_Alpha_GrPixelConfig:
@@ -1010,6 +1026,7 @@ static inline bool GrPixelConfigIsAlphaOnly(GrPixelConfig config) {
         case kRGBA_half_GrPixelConfig:
         case kRGBA_half_Clamped_GrPixelConfig:
         case kRGB_ETC1_GrPixelConfig:
+        case kRGB_BC1_GrPixelConfig:
             return false;
     }
     SK_ABORT("Invalid pixel config.");
@@ -1036,6 +1053,7 @@ static inline bool GrPixelConfigIsFloatingPoint(GrPixelConfig config) {
         case kSBGRA_8888_GrPixelConfig:
         case kRGBA_1010102_GrPixelConfig:
         case kRGB_ETC1_GrPixelConfig:
+        case kRGB_BC1_GrPixelConfig:
             return false;
         case kRGBA_float_GrPixelConfig:
         case kRG_float_GrPixelConfig:
@@ -1063,6 +1081,7 @@ static inline GrClampType GrPixelConfigClampType(GrPixelConfig config) {
 static inline bool GrPixelConfigIsCompressed(GrPixelConfig config) {
     switch (config) {
         case kRGB_ETC1_GrPixelConfig:
+        case kRGB_BC1_GrPixelConfig:
             return true;
         case kUnknown_GrPixelConfig:
         case kAlpha_8_GrPixelConfig:
@@ -1099,6 +1118,7 @@ static inline bool GrPixelConfigIsCompressed(GrPixelConfig config) {
 static inline GrPixelConfig GrMakePixelConfigUncompressed(GrPixelConfig config) {
     switch (config) {
         case kRGB_ETC1_GrPixelConfig:
+        case kRGB_BC1_GrPixelConfig:
             return kRGBA_8888_GrPixelConfig;
         case kUnknown_GrPixelConfig:
         case kAlpha_8_GrPixelConfig:
@@ -1138,9 +1158,10 @@ static inline size_t GrCompressedFormatDataSize(GrPixelConfig config,
 
     switch (config) {
         case kRGB_ETC1_GrPixelConfig:
-            SkASSERT((width & 3) == 0);
-            SkASSERT((height & 3) == 0);
-            return (width >> 2) * (height >> 2) * 8;
+        case kRGB_BC1_GrPixelConfig:
+            // Both use 8 byte 4x4 blocks. Partial blocks at the edges (or in small mip levels)
+            // take up a whole block.
+            return ((width + 3) >> 2) * ((height + 3) >> 2) * 8;
 
         case kUnknown_GrPixelConfig:
         case kAlpha_8_GrPixelConfig:
@@ -1195,6 +1216,7 @@ static inline GrSLPrecision GrSLSamplerPrecision(GrPixelConfig config) {
         case kSRGBA_8888_GrPixelConfig:
         case kSBGRA_8888_GrPixelConfig:
         case kRGB_ETC1_GrPixelConfig:
+        case kRGB_BC1_GrPixelConfig:
             return kLow_GrSLPrecision;
         case kRGBA_float_GrPixelConfig:
         case kRG_float_GrPixelConfig:
@@ -1234,6 +1256,7 @@ enum class GrColorType {
     kRG_F32,
     kRGBA_F32,
     kRGB_ETC1,   // This type doesn't appear in SkColorType at all.
+    kRGB_BC1,    // Nor does this one.
 };
 
 static inline SkColorType GrColorTypeToSkColorType(GrColorType ct) {
@@ -1254,6 +1277,7 @@ static inline SkColorType GrColorTypeToSkColorType(GrColorType ct) {
         case GrColorType::kRG_F32:           return kUnknown_SkColorType;
         case GrColorType::kRGBA_F32:         return kRGBA_F32_SkColorType;
         case GrColorType::kRGB_ETC1:         return kUnknown_SkColorType;
+        case GrColorType::kRGB_BC1:          return kUnknown_SkColorType;
     }
     SK_ABORT("Invalid GrColorType");
     return kUnknown_SkColorType;
@@ -1299,6 +1323,7 @@ static inline uint32_t GrColorTypeComponentFlags(GrColorType ct) {
                                                     kGreen_SkColorTypeComponentFlag;
         case GrColorType::kRGBA_F32:         return kRGBA_SkColorTypeComponentFlags;
         case GrColorType::kRGB_ETC1:         return kRGB_SkColorTypeComponentFlags;
+        case GrColorType::kRGB_BC1:          return kRGB_SkColorTypeComponentFlags;
     }
     SK_ABORT("Invalid GrColorType");
     return kUnknown_SkColorType;
@@ -1316,6 +1341,7 @@ static inline int GrColorTypeBytesPerPixel(GrColorType ct) {
     switch (ct) {
         case GrColorType::kUnknown:          return 0;
         case GrColorType::kRGB_ETC1:         return 0;
+        case GrColorType::kRGB_BC1:          return 0;
         case GrColorType::kAlpha_8:          return 1;
         case GrColorType::kRGB_565:          return 2;
         case GrColorType::kABGR_4444:        return 2;
@@ -1395,6 +1421,9 @@ static inline GrColorType GrPixelConfigToColorTypeAndEncoding(GrPixelConfig conf
         case kRGB_ETC1_GrPixelConfig:
             *srgbEncoded = GrSRGBEncoded::kNo;
             return GrColorType::kRGB_ETC1;
+        case kRGB_BC1_GrPixelConfig:
+            *srgbEncoded = GrSRGBEncoded::kNo;
+            return GrColorType::kRGB_BC1;
         case kAlpha_8_as_Alpha_GrPixelConfig:
             *srgbEncoded = GrSRGBEncoded::kNo;
             return GrColorType::kAlpha_8;
@@ -1483,6 +1512,10 @@ static inline GrPixelConfig GrColorTypeToPixelConfig(GrColorType config,
         case GrColorType::kRGB_ETC1:
             return (GrSRGBEncoded::kYes == srgbEncoded) ? kUnknown_GrPixelConfig
                                                         : kRGB_ETC1_GrPixelConfig;
+
+        case GrColorType::kRGB_BC1:
+            return (GrSRGBEncoded::kYes == srgbEncoded) ? kUnknown_GrPixelConfig
+                                                        : kRGB_BC1_GrPixelConfig;
     }
     SK_ABORT("Invalid GrColorType");
     return kUnknown_GrPixelConfig;
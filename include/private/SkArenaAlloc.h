@@ -61,8 +61,26 @@
 // recursion of the RunDtorsOnBlock to be limited to O(log size-of-memory). Block size grow using
 // the Fibonacci sequence which means that for 2^32 memory there are 48 allocations, and for 2^48
 // there are 71 allocations.
+//
+// Heap blocks can be drawn from a BlockCache instead of new[], so that arenas that are created and
+// destroyed over and over (for example, once per draw) reuse the same memory rather than
+// allocating it again each time.
 class SkArenaAlloc {
 public:
+    // A source of heap blocks for SkArenaAlloc that outlives the arenas using it. Blocks handed
+    // out by get() and blocks returned to put() are allocated with new char[].
+    class BlockCache {
+    public:
+        virtual ~BlockCache() = default;
+
+        // Returns a block of at least size bytes, setting *blockSize to its actual size, or
+        // nullptr if there is none.
+        virtual char* get(uint32_t size, uint32_t* blockSize) = 0;
+
+        // Takes ownership of a block the arena no longer needs.
+        virtual void put(char* block, uint32_t blockSize) = 0;
+    };
+
     SkArenaAlloc(char* block, size_t blockSize, size_t firstHeapAllocation);
 
     explicit SkArenaAlloc(size_t firstHeapAllocation)
@@ -136,6 +154,13 @@ public:
     // Destroy all allocated objects, free any heap allocations.
     void reset();
 
+    // Draws all further heap blocks from cache, and hands them back to it when the arena is
+    // reset or destroyed. The cache must outlive the arena.
+    void setBlockCache(BlockCache* cache) { fBlockCache = cache; }
+
+    // The total size of the heap blocks the arena has allocated since it was created or reset.
+    size_t heapBytes() const { return fHeapBytes; }
+
 private:
     static void AssertRelease(bool cond) { if (!cond) { ::abort(); } }
     static uint32_t ToU32(size_t v) {
@@ -149,6 +174,7 @@ private:
     static char* SkipPod(char* footerEnd);
     static void RunDtorsOnBlock(char* footerEnd);
     static char* NextBlock(char* footerEnd);
+    static char* NextCachedBlock(char* footerEnd);
 
     void installFooter(FooterAction* releaser, uint32_t padding);
     void installUint32Footer(FooterAction* action, uint32_t value, uint32_t padding);
@@ -216,6 +242,8 @@ private:
     char* const    fFirstBlock;
     const uint32_t fFirstSize;
     const uint32_t fFirstHeapAllocationSize;
+    BlockCache*    fBlockCache {nullptr};
+    size_t         fHeapBytes {0};
 
     // Use the Fibonacci sequence as the growth factor for block size. The size of the block
     // allocated is fFib0 * fFirstHeapAllocationSize. Using 2 ^ n * fFirstHeapAllocationSize
@@ -178,6 +178,13 @@ public:
         *x = xy.val[0];
         *y = xy.val[1];
     }
+    AI static void Store2(void* dst, const SkNx& a, const SkNx& b) {
+        float32x4x2_t xy = {{
+            a.fVec,
+            b.fVec,
+        }};
+        vst2q_f32((float*) dst, xy);
+    }
 
     AI static void Load4(const void* ptr, SkNx* r, SkNx* g, SkNx* b, SkNx* a) {
         float32x4x4_t rgba = vld4q_f32((const float*) ptr);
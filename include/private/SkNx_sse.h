@@ -137,10 +137,15 @@ public:
     AI void store(void* ptr) const { _mm_storeu_ps((float*)ptr, fVec); }
 
     AI static void Load2(const void* ptr, SkNx* x, SkNx* y) {
-        SkNx lo = SkNx::Load((const float*)ptr+0),
-             hi = SkNx::Load((const float*)ptr+4);
-        *x = SkNx{lo[0], lo[2], hi[0], hi[2]};
-        *y = SkNx{lo[1], lo[3], hi[1], hi[3]};
+        __m128 lo = _mm_loadu_ps((const float*)ptr+0),
+               hi = _mm_loadu_ps((const float*)ptr+4);
+        *x = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2,0,2,0));
+        *y = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3,1,3,1));
+    }
+
+    AI static void Store2(void* dst, const SkNx& a, const SkNx& b) {
+        _mm_storeu_ps((float*)dst+0, _mm_unpacklo_ps(a.fVec, b.fVec));
+        _mm_storeu_ps((float*)dst+4, _mm_unpackhi_ps(a.fVec, b.fVec));
     }
 
     AI static void Load4(const void* ptr, SkNx* r, SkNx* g, SkNx* b, SkNx* a) {
@@ -20,6 +20,7 @@
 #include <atomic>
 #include <limits>
 
+class SkArenaAlloc;
 class SkRBuffer;
 class SkWBuffer;
 
@@ -150,6 +151,21 @@ public:
      */
     static SkPathRef* CreateEmpty();
 
+    /**
+     * Gets a new, uniquely owned path ref with no verbs or points whose verb and point storage is
+     * allocated from arena rather than the heap. Growing it never frees storage; the arena
+     * reclaims all of it at once. The path ref must not outlive arena.
+     */
+    static SkPathRef* CreateInArena(SkArenaAlloc* arena, int reserveVerbs, int reservePoints);
+
+    /**
+     * Returns a new ref to ref, or to a heap-backed copy of it if its storage lives in an arena.
+     * Use this wherever a path ref may be shared beyond the lifetime of its owner.
+     */
+    static SkPathRef* RefOrCopyToHeap(SkPathRef* ref);
+
+    bool isArenaBacked() const { return fArena != nullptr; }
+
     /**
      *  Returns true if all of the points in this path are finite, meaning there
      *  are no infinities and no NaNs.
@@ -350,6 +366,7 @@ private:
         fVerbs = nullptr;
         fPoints = nullptr;
         fFreeSpace = 0;
+        fArena = nullptr;
         fGenerationID = kEmptyGenID;
         fSegmentMask = 0;
         fIsOval = false;
@@ -417,7 +434,7 @@ private:
         ptrdiff_t sizeDelta = this->currSize() - minSize;
 
         if (sizeDelta < 0 || static_cast<size_t>(sizeDelta) >= 3 * minSize) {
-            sk_free(fPoints);
+            this->freeStorage();
             fPoints = nullptr;
             fVerbs = nullptr;
             fFreeSpace = 0;
@@ -482,6 +499,12 @@ private:
         } else {
             SK_ABORT("Path too big.");
         }
+        if (fArena) {
+            this->growInArena(oldSize, newSize);
+            fFreeSpace += growSize;
+            SkDEBUGCODE(this->validate();)
+            return;
+        }
         // Note that realloc could memcpy more than we need. It seems to be a win anyway. TODO:
         // encapsulate this.
         fPoints = reinterpret_cast<SkPoint*>(sk_realloc_throw(fPoints, newSize));
@@ -494,6 +517,16 @@ private:
         SkDEBUGCODE(this->validate();)
     }
 
+    // Moves the points and verbs to a fresh newSize byte block from fArena.
+    void growInArena(size_t oldSize, size_t newSize);
+
+    // Frees the point and verb storage unless it belongs to fArena.
+    void freeStorage() {
+        if (!fArena) {
+            sk_free(fPoints);
+        }
+    }
+
     /**
      * Private, non-const-ptr version of the public function verbsMemBegin().
      */
@@ -552,6 +585,7 @@ private:
     int                 fVerbCnt;
     int                 fPointCnt;
     size_t              fFreeSpace; // redundant but saves computation
+    SkArenaAlloc*       fArena;     // if set, owns the fPoints/fVerbs allocation
     SkTDArray<SkScalar> fConicWeights;
 
     enum {
@@ -14,6 +14,16 @@ class SkWStream;
 
 class SK_API SkSVGCanvas {
 public:
+    enum {
+        /**
+         *  Write each gradient, image pattern, clip, larger path and bitmap to a <defs> the first
+         *  time it is drawn, and refer back to it with <use> or url(#id) on later draws, instead
+         *  of writing it out again. Shaders are matched by identity, paths and bitmaps by
+         *  generation ID and clips by clip stack state.
+         */
+        kDedupResources_Flag = 0x01,
+    };
+
     /**
      *  Returns a new canvas that will generate SVG commands from its draw calls, and send
      *  them to the provided stream. Ownership of the stream is not transfered, and it must
@@ -24,8 +34,10 @@ public:
      *
      *  The 'bounds' parameter defines an initial SVG viewport (viewBox attribute on the root
      *  SVG element).
+     *
+     *  'flags' is a combination of the flags above.
      */
-    static std::unique_ptr<SkCanvas> Make(const SkRect& bounds, SkWStream*);
+    static std::unique_ptr<SkCanvas> Make(const SkRect& bounds, SkWStream*, uint32_t flags = 0);
 };
 
 #endif
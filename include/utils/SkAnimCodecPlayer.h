@@ -10,6 +10,8 @@
 
 #include "SkCodec.h"
 
+class SkData;
+class SkExecutor;
 class SkImage;
 
 class SkAnimCodecPlayer {
@@ -44,6 +46,18 @@ public:
      */
     bool seek(uint32_t msec);
 
+    /**
+     *  Decodes every frame of an encoded (possibly animated) image, and returns them in frame
+     *  order.  A frame that failed to decode is null; the vector is empty if no codec could be
+     *  made.
+     *
+     *  With an executor, frames that depend on no other frame are decoded concurrently, each
+     *  with its own codec, and each frame that requires a prior frame is composed on top of it
+     *  as soon as that prior frame is done.  Without one, the frames are decoded in order on
+     *  the calling thread.
+     */
+    static std::vector<sk_sp<SkImage>> DecodeFrames(sk_sp<SkData> encoded,
+                                                    SkExecutor* executor = nullptr);
 
 private:
     std::unique_ptr<SkCodec>        fCodec;
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkDDLTiledRenderer_DEFINED
+#define SkDDLTiledRenderer_DEFINED
+
+#include "../private/SkTArray.h"
+#include "SkRect.h"
+#include "SkRefCnt.h"
+#include "SkSurfaceCharacterization.h"
+
+class GrContext;
+class SkDeferredDisplayList;
+class SkExecutor;
+class SkImage;
+class SkPicture;
+class SkSurface;
+
+/**
+ *  SkDDLTiledRenderer splits a destination surface into tiles, records an SkPicture into one
+ *  SkDeferredDisplayList per tile (in parallel on an SkExecutor), and replays them in order.
+ *
+ *  Every tile's DDL is recorded against the whole destination's characterization and clipped
+ *  to its tile, so the DDLs replay straight into the destination with no per-tile surfaces.
+ *
+ *  Each distinct image in the picture is uploaded to the destination GrContext once, before
+ *  recording starts, and every tile draws it through a promise image fulfilled by that one
+ *  texture, rather than each recorder uploading its own copy.
+ */
+class SK_API SkDDLTiledRenderer {
+public:
+    static constexpr int kDefaultTileSize = 512;
+
+    /**
+     *  Partitions the surface described by characterization into a grid of tiles no larger
+     *  than tileSize on a side, in row-major order.
+     */
+    explicit SkDDLTiledRenderer(const SkSurfaceCharacterization& characterization,
+                                int tileSize = kDefaultTileSize);
+    ~SkDDLTiledRenderer();
+
+    int numTiles() const { return fTiles.count(); }
+    const SkIRect& tile(int i) const { return fTiles[i]; }
+
+    /**
+     *  Records picture into one DDL per tile, replacing any recorded earlier.  Must be called on
+     *  the thread that owns context, which must be the context the characterization came from;
+     *  the picture's images are uploaded to it first.  The tiles are then recorded on executor's
+     *  threads, or on this one if executor is nullptr, and this returns once they're all done.
+     *
+     *  Returns false if the characterization is invalid, context doesn't match it, or any tile
+     *  fails to record.
+     */
+    bool record(GrContext* context, const SkPicture* picture, SkExecutor* executor);
+
+    /**
+     *  Replays the recorded DDLs, in tile order, into dst, which must be compatible with the
+     *  characterization.  This may be called any number of times after a successful record().
+     */
+    bool draw(SkSurface* dst) const;
+
+    /**
+     *  Drops the recorded DDLs and this renderer's refs on the uploaded images.
+     */
+    void reset();
+
+private:
+    class SharedImage;
+    struct TileContext;
+
+    static sk_sp<SkImage> MakeTileImage(const void* data, size_t length, void* ctx);
+
+    const SkSurfaceCharacterization                        fCharacterization;
+    SkTArray<SkIRect, true>                                fTiles;
+    SkTArray<std::unique_ptr<SkDeferredDisplayList>, true> fDisplayLists;
+    SkTArray<sk_sp<SharedImage>, true>                     fImages;
+};
+
+#endif
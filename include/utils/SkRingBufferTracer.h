@@ -0,0 +1,71 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRingBufferTracer_DEFINED
+#define SkRingBufferTracer_DEFINED
+
+#include "SkEventTracer.h"
+
+#include <memory>
+
+class SkWStream;
+
+/**
+ *  An SkEventTracer cheap enough to leave installed in shipping builds.
+ *
+ *  Each thread that traces writes fixed-size records into its own ring buffer, without locks or
+ *  allocation, keeping only its most recent events. Call dumpJSON() to write what is buffered in
+ *  the Chrome trace viewer (chrome://tracing) format.
+ *
+ *  Category filtering happens once per trace site, when the site first looks up its category;
+ *  sites in disabled categories then cost a load and a branch.
+ *
+ *  Only one argument per event is kept, and TRACE_STR_COPY string arguments are dropped.
+ */
+class SK_API SkRingBufferTracer : public SkEventTracer {
+public:
+    /**
+     *  categories is a comma-separated list of the categories to record (e.g. "skia,skia.gpu"),
+     *  or nullptr to record every category. Each thread keeps its latest eventsPerThread events,
+     *  rounded up to a power of two.
+     */
+    explicit SkRingBufferTracer(const char* categories = nullptr, int eventsPerThread = 16384);
+    ~SkRingBufferTracer() override;
+
+    /**
+     *  Writes the buffered events to stream as JSON. Events that threads write while this runs
+     *  may or may not be included, and the oldest ones may be torn.
+     */
+    void dumpJSON(SkWStream* stream) const;
+
+    const uint8_t* getCategoryGroupEnabled(const char* name) override;
+    const char* getCategoryGroupName(const uint8_t* categoryEnabledFlag) override;
+
+    SkEventTracer::Handle addTraceEvent(char phase,
+                                        const uint8_t* categoryEnabledFlag,
+                                        const char* name,
+                                        uint64_t id,
+                                        int32_t numArgs,
+                                        const char** argNames,
+                                        const uint8_t* argTypes,
+                                        const uint64_t* argValues,
+                                        uint8_t flags) override;
+
+    void updateTraceEventDuration(const uint8_t* categoryEnabledFlag,
+                                  const char* name,
+                                  SkEventTracer::Handle handle) override;
+
+private:
+    struct State;
+    struct ThreadBuffer;
+
+    ThreadBuffer* threadBuffer();
+
+    std::unique_ptr<State> fState;
+};
+
+#endif
@@ -8,12 +8,14 @@
 #include "SkBlendMode.h"
 #include "SkBlurTypes.h"
 #include "SkCanvas.h"
+#include "SkCodec.h"
 #include "SkColor.h"
 #include "SkCornerPathEffect.h"
 #include "SkDashPathEffect.h"
 #include "SkData.h"
 #include "SkDiscretePathEffect.h"
 #include "SkEncodedImageFormat.h"
+#include "SkExecutor.h"
 #include "SkFilterQuality.h"
 #include "SkFont.h"
 #include "SkFontMgr.h"
@@ -559,6 +561,46 @@ namespace emscripten {
     }
 }
 
+#ifdef CK_ENABLE_THREADS
+// Matches PTHREAD_POOL_SIZE in compile.sh. Workers can't be spawned while the main thread is
+// blocked waiting on them, so we never ask for more than were started up front.
+static constexpr int kMaxThreads = 8;
+static std::unique_ptr<SkExecutor> gThreadPool;
+
+// Installs a FIFO pool of the given size as SkExecutor::GetDefault(), which SkTaskGroup users
+// (blurs, image filters, picture shader tiles) pick up automatically. 0 or less restores
+// single-threaded rendering.
+void SetThreadCount(int threads) {
+    threads = SkTMin(threads, kMaxThreads);
+    SkExecutor::SetDefault(nullptr);
+    gThreadPool = threads > 0 ? SkExecutor::MakeFIFOThreadPool(threads) : nullptr;
+    if (gThreadPool) {
+        SkExecutor::SetDefault(gThreadPool.get());
+    }
+}
+
+// Decodes eagerly so codecs that can split their work (e.g. non-interlaced PNG) run on the pool.
+sk_sp<SkImage> DecodeOnThreadPool(sk_sp<SkData> bytes) {
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(bytes);
+    if (!codec) {
+        return nullptr;
+    }
+    SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType);
+    if (info.alphaType() == kUnpremul_SkAlphaType) {
+        info = info.makeAlphaType(kPremul_SkAlphaType);
+    }
+    size_t rowBytes = info.minRowBytes();
+    sk_sp<SkData> pixels = SkData::MakeUninitialized(info.computeByteSize(rowBytes));
+    SkCodec::Options options;
+    options.fExecutor = gThreadPool.get();
+    if (codec->getPixels(info, pixels->writable_data(), rowBytes, &options) !=
+            SkCodec::kSuccess) {
+        return nullptr;
+    }
+    return SkImage::MakeRasterData(info, std::move(pixels), rowBytes);
+}
+#endif
+
 // Some timesignatures below have uintptr_t instead of a pointer to a primative
 // type (e.g. SkScalar). This is necessary because we can't use "bind" (EMSCRIPTEN_BINDINGS)
 // and pointers to primitive types (Only bound types like SkPoint). We could if we used
@@ -585,8 +627,21 @@ EMSCRIPTEN_BINDINGS(Skia) {
                                                   size_t length)->sk_sp<SkImage> {
         uint8_t* imgData = reinterpret_cast<uint8_t*>(iptr);
         sk_sp<SkData> bytes = SkData::MakeFromMalloc(imgData, length);
+#ifdef CK_ENABLE_THREADS
+        if (gThreadPool) {
+            if (sk_sp<SkImage> image = DecodeOnThreadPool(bytes)) {
+                return image;
+            }
+        }
+#endif
         return SkImage::MakeFromEncoded(std::move(bytes));
     }), allow_raw_pointers());
+#ifdef CK_ENABLE_THREADS
+    function("_setThreadCount", &SetThreadCount);
+    constant("threads", true);
+#else
+    constant("threads", false);
+#endif
     function("_getRasterDirectSurface", optional_override([](const SimpleImageInfo ii,
                                                              uintptr_t /* uint8_t*  */ pPtr,
                                                              size_t rowBytes)->sk_sp<SkSurface> {
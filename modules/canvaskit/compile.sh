@@ -38,6 +38,21 @@ else
   BUILD_DIR=${BUILD_DIR:="out/canvaskit_wasm"}
 fi
 
+# WASM threads (pthreads on SharedArrayBuffer) for multi-core raster work. Browsers only
+# allow this on cross-origin isolated pages. Memory growth is not supported together with
+# pthreads, so these builds reserve a larger fixed heap instead.
+GN_THREADS_FLAGS=""
+WASM_THREADS="-s ALLOW_MEMORY_GROWTH=1 -s TOTAL_MEMORY=128MB"
+if [[ $@ == *threads* ]]; then
+  echo "Building with WASM threads"
+  BUILD_DIR="${BUILD_DIR}_threads"
+  GN_THREADS_FLAGS="\"-s\", \"USE_PTHREADS=1\", \"-DCK_ENABLE_THREADS\","
+  # Workers can't be started while the main thread blocks, so pre-spawn them. Keep this in
+  # sync with kMaxThreads in canvaskit_bindings.cpp.
+  WASM_THREADS="-s USE_PTHREADS=1 -s PTHREAD_POOL_SIZE=8 \
+                -s TOTAL_MEMORY=512MB -DCK_ENABLE_THREADS"
+fi
+
 mkdir -p $BUILD_DIR
 
 GN_GPU="skia_enable_gpu=true"
@@ -145,6 +160,7 @@ echo "Compiling bitcode"
     \"-DSKNX_NO_SIMD\", \"-DSK_DISABLE_AAA\", \"-DSK_DISABLE_DAA\", \"-DSK_DISABLE_READBUFFER\",
     \"-DSK_DISABLE_EFFECT_DESERIALIZATION\",
     ${GN_GPU_FLAGS}
+    ${GN_THREADS_FLAGS}
     ${EXTRA_CFLAGS}
   ] \
   is_debug=false \
@@ -220,6 +236,7 @@ ${EMCXX} \
     -DSK_DISABLE_AAA \
     -DSK_DISABLE_DAA \
     $WASM_GPU \
+    $WASM_THREADS \
     -std=c++14 \
     --bind \
     --pre-js $BASE_DIR/preamble.js \
@@ -239,13 +256,11 @@ ${EMCXX} \
     $BUILD_DIR/libskshaper.a \
     $SHAPER_LIB \
     $BUILD_DIR/libskia.a \
-    -s ALLOW_MEMORY_GROWTH=1 \
     -s EXPORT_NAME="CanvasKitInit" \
     -s FORCE_FILESYSTEM=0 \
     -s MODULARIZE=1 \
     -s NO_EXIT_RUNTIME=1 \
     -s STRICT=1 \
-    -s TOTAL_MEMORY=128MB \
     -s USE_FREETYPE=1 \
     -s USE_LIBPNG=1 \
     -s WARN_UNALIGNED=1 \
@@ -32,7 +32,9 @@ var CanvasKit = {
 	/** @return {ImageData} */
 	ImageData: function() {},
 
+	Free: function() {},
 	GetWebGLContext: function() {},
+	Malloc: function() {},
 	MakeBlurMaskFilter: function() {},
 	MakeCanvas: function() {},
 	MakeCanvasSurface: function() {},
@@ -61,6 +63,7 @@ var CanvasKit = {
 	getSkDataBytes: function() {},
 	multiplyByAlpha: function() {},
 	setCurrentContext: function() {},
+	setThreadCount: function() {},
 
 	// private API (i.e. things declared in the bindings that we use
 	// in the pre-js file)
@@ -77,6 +80,7 @@ var CanvasKit = {
 	_drawShapedText: function() {},
 	_getRasterDirectSurface: function() {},
 	_getRasterN32PremulSurface: function() {},
+	_setThreadCount: function() {},
 
 	// The testing object is meant to expose internal functions
 	// for more fine-grained testing, e.g. parseColor
@@ -258,6 +262,7 @@ var CanvasKit = {
 		// private API
 		_flush: function() {},
 		_getRasterN32PremulSurface: function() {},
+	_setThreadCount: function() {},
 		delete: function() {},
 	},
 
@@ -280,6 +285,7 @@ var CanvasKit = {
 
 	// Constants and Enums
 	gpu: {},
+	threads: {},
 	skottie: {},
 
 	TRANSPARENT: {},
@@ -59,12 +59,33 @@ function almostEqual(floata, floatb) {
 
 var nullptr = 0; // emscripten doesn't like to take null as uintptr_t
 
+// Arrays returned by CanvasKit.Malloc are views directly into the WASM heap;
+// they are flagged with this property so the copy helpers below can hand their
+// address to C++ as-is instead of copying them.
+var MALLOCED_ARRAY_FLAG = '_ck';
+
+function isMallocedArray(arr) {
+  return !!(arr && arr[MALLOCED_ARRAY_FLAG]);
+}
+
+// Frees ptr, unless it is the address of an array the user got from
+// CanvasKit.Malloc (in which case the user owns it and must CanvasKit.Free it).
+function freeArraysThatAreNotMallocedByUsers(ptr, arr) {
+  if (ptr && !isMallocedArray(arr)) {
+    CanvasKit._free(ptr);
+  }
+}
+
 // arr can be a normal JS array or a TypedArray
 // dest is something like CanvasKit.HEAPF32
+// If arr came from CanvasKit.Malloc, no copy is made and its address is returned.
 function copy1dArray(arr, dest) {
   if (!arr || !arr.length) {
     return nullptr;
   }
+  if (isMallocedArray(arr)) {
+    return arr.byteOffset;
+  }
   var ptr = CanvasKit._malloc(arr.length * dest.BYTES_PER_ELEMENT);
   // In c++ terms, the WASM heap is a uint8_t*, a long buffer/array of single
   // byte elements. When we run _malloc, we always get an offset/pointer into
@@ -80,12 +101,16 @@ function copy1dArray(arr, dest) {
 }
 
 // arr should be a non-jagged 2d JS array (TypedArrays can't be nested
-//     inside themselves.)
+//     inside themselves.), or an already-flattened array from CanvasKit.Malloc,
+//     which is passed through without a copy.
 // dest is something like CanvasKit.HEAPF32
 function copy2dArray(arr, dest) {
   if (!arr || !arr.length) {
     return nullptr;
   }
+  if (isMallocedArray(arr)) {
+    return arr.byteOffset;
+  }
   var ptr = CanvasKit._malloc(arr.length * arr[0].length * dest.BYTES_PER_ELEMENT);
   var idx = 0;
   var adjustedPtr = ptr / dest.BYTES_PER_ELEMENT;
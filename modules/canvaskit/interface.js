@@ -223,7 +223,7 @@ CanvasKit.onRuntimeInitialized = function() {
       var a = args;
       this._addRoundRect(a[0], a[1], a[2], a[3], rptr, ccw);
     }
-    CanvasKit._free(rptr);
+    freeArraysThatAreNotMallocedByUsers(rptr, radii);
     return this;
   };
 
@@ -398,14 +398,33 @@ CanvasKit.onRuntimeInitialized = function() {
   }
 
   // returns Uint8Array
+  // If dest (an array from CanvasKit.Malloc, at least h * dstRowBytes bytes
+  // long) is provided, the pixels are written straight into it and dest is
+  // returned; otherwise a new Uint8Array is returned.
   CanvasKit.SkCanvas.prototype.readPixels = function(x, y, w, h, alphaType,
-                                                     colorType, dstRowBytes) {
+                                                     colorType, dstRowBytes, dest) {
     // supply defaults (which are compatible with HTMLCanvas's getImageData)
     alphaType = alphaType || CanvasKit.AlphaType.Unpremul;
     colorType = colorType || CanvasKit.ColorType.RGBA_8888;
     dstRowBytes = dstRowBytes || (4 * w);
 
     var len = h * dstRowBytes
+    if (dest) {
+      if (!isMallocedArray(dest)) {
+        throw 'readPixels dest must come from CanvasKit.Malloc';
+      }
+      if (dest.byteLength < len) {
+        throw 'readPixels dest needs ' + len + ' bytes, has ' + dest.byteLength;
+      }
+      var ok = this._readPixels({
+        'width': w,
+        'height': h,
+        'colorType': colorType,
+        'alphaType': alphaType,
+      }, dest.byteOffset, dstRowBytes, x, y);
+      return ok ? dest : null;
+    }
+
     var pptr = CanvasKit._malloc(len);
     var ok = this._readPixels({
       'width': w,
@@ -438,8 +457,11 @@ CanvasKit.onRuntimeInitialized = function() {
     colorType = colorType || CanvasKit.ColorType.RGBA_8888;
     var srcRowBytes = bytesPerPixel * srcWidth;
 
-    var pptr = CanvasKit._malloc(pixels.byteLength);
-    CanvasKit.HEAPU8.set(pixels, pptr);
+    var pptr = pixels.byteOffset;
+    if (!isMallocedArray(pixels)) {
+      pptr = CanvasKit._malloc(pixels.byteLength);
+      CanvasKit.HEAPU8.set(pixels, pptr);
+    }
 
     var ok = this._writePixels({
       'width': srcWidth,
@@ -448,7 +470,7 @@ CanvasKit.onRuntimeInitialized = function() {
       'alphaType': alphaType,
     }, pptr, srcRowBytes, destX, destY);
 
-    CanvasKit._free(pptr);
+    freeArraysThatAreNotMallocedByUsers(pptr, pixels);
     return ok;
   }
 
@@ -491,6 +513,12 @@ CanvasKit.onRuntimeInitialized = function() {
     return blob;
   }
 
+  // In builds with WASM threads (see `compile.sh threads`), spread raster work over the
+  // available cores by default. Clients can call setThreadCount(0) to opt out.
+  if (CanvasKit.threads) {
+    CanvasKit.setThreadCount(navigator.hardwareConcurrency || 1);
+  }
+
   // Run through the JS files that are added at compile time.
   if (CanvasKit._extraInitializations) {
     CanvasKit._extraInitializations.forEach(function(init) {
@@ -499,6 +527,38 @@ CanvasKit.onRuntimeInitialized = function() {
   }
 }; // end CanvasKit.onRuntimeInitialized, that is, anything changing prototypes or dynamic.
 
+// Sets the number of worker threads used for software rendering and image
+// decoding (capped at the size of the pre-started worker pool). Only has an
+// effect in builds made with WASM threads, i.e. when CanvasKit.threads is true.
+CanvasKit.setThreadCount = function(threads) {
+  if (CanvasKit.threads) {
+    CanvasKit._setThreadCount(threads);
+  }
+}
+
+// Allocates a TypedArray of the given type (e.g. Float32Array) and length that
+// lives on the WASM heap. Passing it to CanvasKit APIs that take arrays (for
+// example readPixels, writePixels, MakeSkVertices and the gradient shaders)
+// avoids copying the data in or out of the heap on every call. The array
+// stays valid until it is passed to CanvasKit.Free; if the heap grows, views
+// made before the growth are detached, so re-create them rather than cache
+// them across allocations.
+CanvasKit.Malloc = function(typedArray, len) {
+  var byteLen = len * typedArray.BYTES_PER_ELEMENT;
+  var ptr = CanvasKit._malloc(byteLen);
+  var ta = new typedArray(CanvasKit.HEAPU8.buffer, ptr, len);
+  ta[MALLOCED_ARRAY_FLAG] = true;
+  return ta;
+}
+
+// Releases an array returned by CanvasKit.Malloc.
+CanvasKit.Free = function(typedArray) {
+  if (isMallocedArray(typedArray)) {
+    CanvasKit._free(typedArray.byteOffset);
+    typedArray[MALLOCED_ARRAY_FLAG] = false;
+  }
+}
+
 CanvasKit.LTRBRect = function(l, t, r, b) {
   return {
     fLeft: l,
@@ -533,7 +593,7 @@ CanvasKit.MakeSkDashPathEffect = function(intervals, phase) {
   }
   var ptr = copy1dArray(intervals, CanvasKit.HEAPF32);
   var dpe = CanvasKit._MakeSkDashPathEffect(ptr, intervals.length, phase);
-  CanvasKit._free(ptr);
+  freeArraysThatAreNotMallocedByUsers(ptr, intervals);
   return dpe;
 }
 
@@ -601,8 +661,8 @@ CanvasKit.MakeLinearGradientShader = function(start, end, colors, pos, mode, loc
                                                   colors.length, mode, flags);
   }
 
-  CanvasKit._free(colorPtr);
-  CanvasKit._free(posPtr);
+  freeArraysThatAreNotMallocedByUsers(colorPtr, colors);
+  freeArraysThatAreNotMallocedByUsers(posPtr, pos);
   return lgs;
 }
 
@@ -623,8 +683,8 @@ CanvasKit.MakeRadialGradientShader = function(center, radius, colors, pos, mode,
                                                   colors.length, mode, flags);
   }
 
-  CanvasKit._free(colorPtr);
-  CanvasKit._free(posPtr);
+  freeArraysThatAreNotMallocedByUsers(colorPtr, colors);
+  freeArraysThatAreNotMallocedByUsers(posPtr, pos);
   return rgs;
 }
 
@@ -648,11 +708,15 @@ CanvasKit.MakeTwoPointConicalGradientShader = function(start, startRadius, end,
                         colorPtr, posPtr, colors.length, mode, flags);
   }
 
-  CanvasKit._free(colorPtr);
-  CanvasKit._free(posPtr);
+  freeArraysThatAreNotMallocedByUsers(colorPtr, colors);
+  freeArraysThatAreNotMallocedByUsers(posPtr, pos);
   return rgs;
 }
 
+// positions, textureCoordinates, boneIndices and boneWeights are 2d arrays
+// (e.g. [[x0, y0], [x1, y1]]) or flat arrays from CanvasKit.Malloc
+// (e.g. [x0, y0, x1, y1]). colors and indices are 1d. Arrays from
+// CanvasKit.Malloc are read in place, with no intermediate copy.
 CanvasKit.MakeSkVertices = function(mode, positions, textureCoordinates, colors,
                                     boneIndices, boneWeights, indices, isVolatile) {
   var positionPtr = copy2dArray(positions,          CanvasKit.HEAPF32);
@@ -672,14 +736,15 @@ CanvasKit.MakeSkVertices = function(mode, positions, textureCoordinates, colors,
   var idxCount = (indices && indices.length) || 0;
   // _MakeVertices will copy all the values in, so we are free to release
   // the memory after.
-  var vertices = CanvasKit._MakeSkVertices(mode, positions.length, positionPtr,
+  var vertexCount = isMallocedArray(positions) ? positions.length / 2 : positions.length;
+  var vertices = CanvasKit._MakeSkVertices(mode, vertexCount, positionPtr,
                                            texPtr, colorPtr, boneIdxPtr, boneWtPtr,
                                            idxCount, idxPtr, isVolatile);
-  positionPtr && CanvasKit._free(positionPtr);
-  texPtr && CanvasKit._free(texPtr);
-  colorPtr && CanvasKit._free(colorPtr);
-  idxPtr && CanvasKit._free(idxPtr);
-  boneIdxPtr && CanvasKit._free(boneIdxPtr);
-  boneWtPtr && CanvasKit._free(boneWtPtr);
+  freeArraysThatAreNotMallocedByUsers(positionPtr, positions);
+  freeArraysThatAreNotMallocedByUsers(texPtr, textureCoordinates);
+  freeArraysThatAreNotMallocedByUsers(colorPtr, colors);
+  freeArraysThatAreNotMallocedByUsers(idxPtr, indices);
+  freeArraysThatAreNotMallocedByUsers(boneIdxPtr, boneIndices);
+  freeArraysThatAreNotMallocedByUsers(boneWtPtr, boneWeights);
   return vertices;
 };
\ No newline at end of file
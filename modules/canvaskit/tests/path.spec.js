@@ -202,4 +202,42 @@ describe('CanvasKit\'s Path Behavior', function() {
             done();
         }));
     });
+
+    it('can read pixels into and make vertices from Malloc\'d arrays', function(done) {
+        LoadCanvasKit.then(catchException(done, () => {
+            const surface = CanvasKit.MakeCanvasSurface('test');
+            expect(surface).toBeTruthy('Could not make surface')
+            if (!surface) {
+                done();
+                return;
+            }
+            const canvas = surface.getCanvas();
+            canvas.clear(CanvasKit.WHITE);
+
+            const positions = CanvasKit.Malloc(Float32Array, 6);
+            positions.set([0, 0, 20, 0, 0, 20]);
+            const colors = CanvasKit.Malloc(Int32Array, 3);
+            colors.set([CanvasKit.RED, CanvasKit.RED, CanvasKit.RED]);
+            const vertices = CanvasKit.MakeSkVertices(CanvasKit.VertexMode.Triangles,
+                                                      positions, null, colors);
+            expect(vertices.vertexCount()).toBe(3);
+
+            const paint = new CanvasKit.SkPaint();
+            canvas.drawVertices(vertices, CanvasKit.BlendMode.Src, paint);
+
+            const pixels = CanvasKit.Malloc(Uint8Array, 4 * 4 * 4);
+            const result = canvas.readPixels(2, 2, 4, 4, null, null, null, pixels);
+            expect(result).toBe(pixels);
+            // Top-left pixel of the read is inside the red triangle.
+            expect(Array.from(pixels.subarray(0, 4))).toEqual([255, 0, 0, 255]);
+
+            CanvasKit.Free(positions);
+            CanvasKit.Free(colors);
+            CanvasKit.Free(pixels);
+            vertices.delete();
+            paint.delete();
+            surface.delete();
+            done();
+        }));
+    });
 });
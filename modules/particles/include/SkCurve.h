@@ -72,7 +72,7 @@ struct SkCurve {
         fSegments.push_back().setConstant(c);
     }
 
-    SkScalar eval(const SkParticleUpdateParams& params, SkParticleState& ps) const;
+    SkScalar eval(const SkParticleUpdateParams& params, SkParticles& ps, int i) const;
     void visitFields(SkFieldVisitor* v);
 
     // Parameters that determine our x-value during evaluation
@@ -118,7 +118,7 @@ struct SkColorCurve {
         fSegments.push_back().setConstant(c);
     }
 
-    SkColor4f eval(const SkParticleUpdateParams& params, SkParticleState& ps) const;
+    SkColor4f eval(const SkParticleUpdateParams& params, SkParticles& ps, int i) const;
     void visitFields(SkFieldVisitor* v);
 
     SkParticleValue                     fInput;
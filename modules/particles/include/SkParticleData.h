@@ -12,7 +12,7 @@
 #include "SkPoint.h"
 #include "SkRandom.h"
 #include "SkReflected.h"
-#include "SkRSXform.h"
+#include "SkTemplates.h"
 
 /*
  *  Various structs used to communicate particle information among emitters, affectors, etc.
@@ -30,40 +30,56 @@ static constexpr SkFieldVisitor::EnumStringMapping gParticleFrameMapping[] = {
     { kVelocity_ParticleFrame, "Velocity" },
 };
 
-struct SkParticlePose {
-    SkPoint  fPosition;
-    SkVector fHeading;
-    SkScalar fScale;
-
-    SkRSXform asRSXform(SkPoint ofs) const {
-        const float s =  fHeading.fX * fScale;
-        const float c = -fHeading.fY * fScale;
-        return SkRSXform::Make(c, s,
-                               fPosition.fX + -c * ofs.fX +  s * ofs.fY,
-                               fPosition.fY + -s * ofs.fX + -c * ofs.fY);
-    }
-};
+/**
+ * Particle state is stored as a structure of arrays: one float array per channel, so that
+ * affectors and the fixed-function update can stream through a single quantity for a whole span
+ * of particles (four at a time, with SkNx). Index i in every channel belongs to particle i.
+ */
+struct SkParticles {
+    enum Channel {
+        kAge,             // Normalized age [0, 1]
+        kInvLifetime,     // 1 / Lifetime
+        kPositionX,
+        kPositionY,
+        kHeadingX,
+        kHeadingY,
+        kScale,
+        kVelocityX,
+        kVelocityY,
+        kVelocityAngular,
+        kColorR,
+        kColorG,
+        kColorB,
+        kColorA,
+        kSpriteFrame,     // Parameter to drawable for animated sprites, etc.
+
+        kNumChannels,
+    };
 
-struct SkParticleVelocity {
-    SkVector fLinear;
-    SkScalar fAngular;
-};
+    SkAutoTMalloc<float>    fData[kNumChannels];
+    SkAutoTMalloc<SkRandom> fRandom;
 
-struct SkParticleState {
-    float              fAge;          // Normalized age [0, 1]
-    float              fInvLifetime;  // 1 / Lifetime
-    SkParticlePose     fPose;
-    SkParticleVelocity fVelocity;
-    SkColor4f          fColor;
-    SkScalar           fFrame;        // Parameter to drawable for animated sprites, etc.
-    SkRandom           fRandom;
+    void realloc(int capacity) {
+        for (auto& channel : fData) {
+            channel.realloc(capacity);
+        }
+        fRandom.realloc(capacity);
+    }
+
+    // Moves every channel of particle 'from' into slot 'to'.
+    void copy(int to, int from) {
+        for (auto& channel : fData) {
+            channel[to] = channel[from];
+        }
+        fRandom[to] = fRandom[from];
+    }
 
-    SkVector getFrameHeading(SkParticleFrame frame) const {
+    SkVector getFrameHeading(SkParticleFrame frame, int i) const {
         switch (frame) {
             case kLocal_ParticleFrame:
-                return fPose.fHeading;
+                return { fData[kHeadingX][i], fData[kHeadingY][i] };
             case kVelocity_ParticleFrame: {
-                SkVector heading = fVelocity.fLinear;
+                SkVector heading = { fData[kVelocityX][i], fData[kVelocityY][i] };
                 if (!heading.normalize()) {
                     heading.set(0, -1);
                 }
@@ -118,7 +134,7 @@ struct SkParticleValue {
     };
 
     void visitFields(SkFieldVisitor* v);
-    float eval(const SkParticleUpdateParams& params, SkParticleState& ps) const;
+    float eval(const SkParticleUpdateParams& params, SkParticles& ps, int i) const;
 
     int   fSource   = kAge_Source;
     int   fFrame    = kWorld_ParticleFrame;
@@ -133,7 +149,7 @@ struct SkParticleValue {
     float fBias     = 0.0f;
 
 private:
-    float getSourceValue(const SkParticleUpdateParams& params, SkParticleState& ps) const;
+    float getSourceValue(const SkParticleUpdateParams& params, SkParticles& ps, int i) const;
 };
 
 #endif // SkParticleData_DEFINED
@@ -11,7 +11,7 @@
 #include "SkReflected.h"
 
 class SkCanvas;
-struct SkParticleState;
+struct SkParticles;
 class SkPaint;
 class SkString;
 
@@ -19,7 +19,8 @@ class SkParticleDrawable : public SkReflected {
 public:
     REFLECTED_ABSTRACT(SkParticleDrawable, SkReflected)
 
-    virtual void draw(SkCanvas* canvas, const SkParticleState particles[], int count,
+    // Draws the first count particles, typically with a single drawAtlas.
+    virtual void draw(SkCanvas* canvas, const SkParticles& particles, int count,
                       const SkPaint* paint) = 0;
 
     static void RegisterDrawableTypes();
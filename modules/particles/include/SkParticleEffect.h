@@ -10,15 +10,16 @@
 
 #include "SkAutoMalloc.h"
 #include "SkCurve.h"
+#include "SkParticleData.h"
 #include "SkRandom.h"
 #include "SkRefCnt.h"
 #include "SkTArray.h"
 
 class SkCanvas;
+class SkExecutor;
 class SkFieldVisitor;
 class SkParticleAffector;
 class SkParticleDrawable;
-struct SkParticleState;
 
 class SkParticleEffectParams : public SkRefCnt {
 public:
@@ -47,12 +48,30 @@ public:
     void update(double now);
     void draw(SkCanvas* canvas);
 
+    /**
+     *  Advances every effect in effects[0..count) to time 'now', exactly as calling update(now)
+     *  on each would. With an executor, independent effects are advanced concurrently, and the
+     *  per-particle update work of large effects is split into chunks of kUpdateChunkSize. The
+     *  results do not depend on the number of threads. Without one, runs serially.
+     */
+    static void UpdateAll(SkParticleEffect* const effects[], int count, double now,
+                          SkExecutor* executor = nullptr);
+
+    static constexpr int kUpdateChunkSize = 4096;
+
     bool isAlive() const { return fSpawnTime >= 0; }
     int getCount() const { return fCount; }
 
 private:
     void setCapacity(int capacity);
 
+    // update() is split into three phases so UpdateAll can run the middle one in chunks:
+    // aging, removal and spawning (serial, uses fRandom), the per-particle update affectors and
+    // integration on [start, start + count), and end-of-life bookkeeping.
+    bool beginUpdate(double now, SkParticleUpdateParams* params);
+    void updateParticles(const SkParticleUpdateParams& params, int start, int count);
+    void endUpdate(double now);
+
     sk_sp<SkParticleEffectParams> fParams;
 
     SkRandom fRandom;
@@ -64,8 +83,8 @@ private:
     double fLastTime;
     float  fSpawnRemainder;
 
-    SkAutoTMalloc<SkParticleState> fParticles;
-    SkAutoTMalloc<SkRandom>        fStableRandoms;
+    SkParticles             fParticles;
+    SkAutoTMalloc<SkRandom> fStableRandoms;
 
     // Cached
     int fCapacity;
@@ -79,20 +79,20 @@ void SkCurveSegment::visitFields(SkFieldVisitor* v) {
     }
 }
 
-SkScalar SkCurve::eval(const SkParticleUpdateParams& params, SkParticleState& ps) const {
+SkScalar SkCurve::eval(const SkParticleUpdateParams& params, SkParticles& ps, int i) const {
     SkASSERT(fSegments.count() == fXValues.count() + 1);
 
-    float x = fInput.eval(params, ps);
+    float x = fInput.eval(params, ps, i);
 
-    int i = 0;
-    for (; i < fXValues.count(); ++i) {
-        if (x <= fXValues[i]) {
+    int seg = 0;
+    for (; seg < fXValues.count(); ++seg) {
+        if (x <= fXValues[seg]) {
             break;
         }
     }
 
-    SkScalar rangeMin = (i == 0) ? 0.0f : fXValues[i - 1];
-    SkScalar rangeMax = (i == fXValues.count()) ? 1.0f : fXValues[i];
+    SkScalar rangeMin = (seg == 0) ? 0.0f : fXValues[seg - 1];
+    SkScalar rangeMax = (seg == fXValues.count()) ? 1.0f : fXValues[seg];
     SkScalar segmentX = (x - rangeMin) / (rangeMax - rangeMin);
     if (!SkScalarIsFinite(segmentX)) {
         segmentX = rangeMin;
@@ -101,9 +101,9 @@ SkScalar SkCurve::eval(const SkParticleUpdateParams& params, SkParticleState& ps
 
     // Always pull t and negate here, so that the stable generator behaves consistently, even if
     // our segments use an inconsistent feature-set.
-    SkScalar t = ps.fRandom.nextF();
-    bool negate = ps.fRandom.nextBool();
-    return fSegments[i].eval(segmentX, t, negate);
+    SkScalar t = ps.fRandom[i].nextF();
+    bool negate = ps.fRandom[i].nextBool();
+    return fSegments[seg].eval(segmentX, t, negate);
 }
 
 void SkCurve::visitFields(SkFieldVisitor* v) {
@@ -152,26 +152,26 @@ void SkColorCurveSegment::visitFields(SkFieldVisitor* v) {
     }
 }
 
-SkColor4f SkColorCurve::eval(const SkParticleUpdateParams& params, SkParticleState& ps) const {
+SkColor4f SkColorCurve::eval(const SkParticleUpdateParams& params, SkParticles& ps, int i) const {
     SkASSERT(fSegments.count() == fXValues.count() + 1);
 
-    float x = fInput.eval(params, ps);
+    float x = fInput.eval(params, ps, i);
 
-    int i = 0;
-    for (; i < fXValues.count(); ++i) {
-        if (x <= fXValues[i]) {
+    int seg = 0;
+    for (; seg < fXValues.count(); ++seg) {
+        if (x <= fXValues[seg]) {
             break;
         }
     }
 
-    SkScalar rangeMin = (i == 0) ? 0.0f : fXValues[i - 1];
-    SkScalar rangeMax = (i == fXValues.count()) ? 1.0f : fXValues[i];
+    SkScalar rangeMin = (seg == 0) ? 0.0f : fXValues[seg - 1];
+    SkScalar rangeMax = (seg == fXValues.count()) ? 1.0f : fXValues[seg];
     SkScalar segmentX = (x - rangeMin) / (rangeMax - rangeMin);
     if (!SkScalarIsFinite(segmentX)) {
         segmentX = rangeMin;
     }
     SkASSERT(0.0f <= segmentX && segmentX <= 1.0f);
-    return fSegments[i].eval(segmentX, ps.fRandom.nextF());
+    return fSegments[seg].eval(segmentX, ps.fRandom[i].nextF());
 }
 
 void SkColorCurve::visitFields(SkFieldVisitor* v) {
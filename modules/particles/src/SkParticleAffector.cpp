@@ -9,6 +9,7 @@
 
 #include "SkContourMeasure.h"
 #include "SkCurve.h"
+#include "SkNx.h"
 #include "SkParsePath.h"
 #include "SkParticleData.h"
 #include "SkPath.h"
@@ -17,9 +18,9 @@
 
 
 void SkParticleAffector::apply(const SkParticleUpdateParams& params,
-                               SkParticleState ps[], int count) {
+                               SkParticles& ps, int start, int count) {
     if (fEnabled) {
-        this->onApply(params, ps, count);
+        this->onApply(params, ps, start, count);
     }
 }
 
@@ -40,19 +41,23 @@ public:
 
     REFLECTED(SkLinearVelocityAffector, SkParticleAffector)
 
-    void onApply(const SkParticleUpdateParams& params, SkParticleState ps[], int count) override {
-        for (int i = 0; i < count; ++i) {
-            float angle = fAngle.eval(params, ps[i]);
+    void onApply(const SkParticleUpdateParams& params, SkParticles& ps, int start,
+                 int count) override {
+        float* velocityX = ps.fData[SkParticles::kVelocityX];
+        float* velocityY = ps.fData[SkParticles::kVelocityY];
+        for (int i = start; i < start + count; ++i) {
+            float angle = fAngle.eval(params, ps, i);
             SkScalar c_local, s_local = SkScalarSinCos(SkDegreesToRadians(angle), &c_local);
-            SkVector heading = ps[i].getFrameHeading(static_cast<SkParticleFrame>(fFrame));
+            SkVector heading = ps.getFrameHeading(static_cast<SkParticleFrame>(fFrame), i);
             SkScalar c = heading.fX * c_local - heading.fY * s_local;
             SkScalar s = heading.fX * s_local + heading.fY * c_local;
-            float strength = fStrength.eval(params, ps[i]);
-            SkVector force = { c * strength, s * strength };
+            float strength = fStrength.eval(params, ps, i);
             if (fForce) {
-                ps[i].fVelocity.fLinear += force * params.fDeltaTime;
+                velocityX[i] += c * strength * params.fDeltaTime;
+                velocityY[i] += s * strength * params.fDeltaTime;
             } else {
-                ps[i].fVelocity.fLinear = force;
+                velocityX[i] = c * strength;
+                velocityY[i] = s * strength;
             }
         }
     }
@@ -80,13 +85,15 @@ public:
 
     REFLECTED(SkAngularVelocityAffector, SkParticleAffector)
 
-    void onApply(const SkParticleUpdateParams& params, SkParticleState ps[], int count) override {
-        for (int i = 0; i < count; ++i) {
-            float strength = fStrength.eval(params, ps[i]);
+    void onApply(const SkParticleUpdateParams& params, SkParticles& ps, int start,
+                 int count) override {
+        float* angular = ps.fData[SkParticles::kVelocityAngular];
+        for (int i = start; i < start + count; ++i) {
+            float strength = fStrength.eval(params, ps, i);
             if (fForce) {
-                ps[i].fVelocity.fAngular += strength * params.fDeltaTime;
+                angular[i] += strength * params.fDeltaTime;
             } else {
-                ps[i].fVelocity.fAngular = strength;
+                angular[i] = strength;
             }
         }
     }
@@ -110,13 +117,40 @@ public:
 
     REFLECTED(SkPointForceAffector, SkParticleAffector)
 
-    void onApply(const SkParticleUpdateParams& params, SkParticleState ps[], int count) override {
-        for (int i = 0; i < count; ++i) {
-            SkVector toPoint = fPoint - ps[i].fPose.fPosition;
-            SkScalar lenSquare = toPoint.dot(toPoint);
-            toPoint.normalize();
-            ps[i].fVelocity.fLinear +=
-                    toPoint * (fConstant + (fInvSquare / lenSquare)) * params.fDeltaTime;
+    void onApply(const SkParticleUpdateParams& params, SkParticles& ps, int start,
+                 int count) override {
+        // Nothing here depends on curves or random state, so run four particles at a time.
+        const float* posX = ps.fData[SkParticles::kPositionX];
+        const float* posY = ps.fData[SkParticles::kPositionY];
+        float* velX = ps.fData[SkParticles::kVelocityX];
+        float* velY = ps.fData[SkParticles::kVelocityY];
+        const Sk4f pointX(fPoint.fX), pointY(fPoint.fY), dt(params.fDeltaTime);
+        const Sk4f constant(fConstant), invSquare(fInvSquare);
+
+        auto force = [&](const Sk4f& px, const Sk4f& py, Sk4f* vx, Sk4f* vy) {
+            Sk4f toX = pointX - px,
+                 toY = pointY - py,
+                 lenSquare = toX * toX + toY * toY;
+            // Particles sitting exactly on the point feel no force (and don't produce NaNs).
+            Sk4f scale = (lenSquare > 0).thenElse(
+                    (constant + invSquare / lenSquare) * dt / lenSquare.sqrt(), 0);
+            *vx = *vx + toX * scale;
+            *vy = *vy + toY * scale;
+        };
+
+        int i = start;
+        for (; i + 4 <= start + count; i += 4) {
+            Sk4f vx = Sk4f::Load(velX + i),
+                 vy = Sk4f::Load(velY + i);
+            force(Sk4f::Load(posX + i), Sk4f::Load(posY + i), &vx, &vy);
+            vx.store(velX + i);
+            vy.store(velY + i);
+        }
+        for (; i < start + count; ++i) {
+            Sk4f vx(velX[i]), vy(velY[i]);
+            force(Sk4f(posX[i]), Sk4f(posY[i]), &vx, &vy);
+            velX[i] = vx[0];
+            velY[i] = vy[0];
         }
     }
 
@@ -142,13 +176,14 @@ public:
 
     REFLECTED(SkOrientationAffector, SkParticleAffector)
 
-    void onApply(const SkParticleUpdateParams& params, SkParticleState ps[], int count) override {
-        for (int i = 0; i < count; ++i) {
-            float angle = fAngle.eval(params, ps[i]);
+    void onApply(const SkParticleUpdateParams& params, SkParticles& ps, int start,
+                 int count) override {
+        for (int i = start; i < start + count; ++i) {
+            float angle = fAngle.eval(params, ps, i);
             SkScalar c_local, s_local = SkScalarSinCos(SkDegreesToRadians(angle), &c_local);
-            SkVector heading = ps[i].getFrameHeading(static_cast<SkParticleFrame>(fFrame));
-            ps[i].fPose.fHeading.set(heading.fX * c_local - heading.fY * s_local,
-                                     heading.fX * s_local + heading.fY * c_local);
+            SkVector heading = ps.getFrameHeading(static_cast<SkParticleFrame>(fFrame), i);
+            ps.fData[SkParticles::kHeadingX][i] = heading.fX * c_local - heading.fY * s_local;
+            ps.fData[SkParticles::kHeadingY][i] = heading.fX * s_local + heading.fY * c_local;
         }
     }
 
@@ -174,22 +209,25 @@ public:
 
     REFLECTED(SkPositionInCircleAffector, SkParticleAffector)
 
-    void onApply(const SkParticleUpdateParams& params, SkParticleState ps[], int count) override {
-        for (int i = 0; i < count; ++i) {
+    void onApply(const SkParticleUpdateParams& params, SkParticles& ps, int start,
+                 int count) override {
+        for (int i = start; i < start + count; ++i) {
             SkVector v;
             do {
-                v.fX = ps[i].fRandom.nextSScalar1();
-                v.fY = ps[i].fRandom.nextSScalar1();
+                v.fX = ps.fRandom[i].nextSScalar1();
+                v.fY = ps.fRandom[i].nextSScalar1();
             } while (v.dot(v) > 1);
 
-            SkPoint center = { fX.eval(params, ps[i]), fY.eval(params, ps[i]) };
-            SkScalar radius = fRadius.eval(params, ps[i]);
-            ps[i].fPose.fPosition = center + (v * radius);
+            SkPoint center = { fX.eval(params, ps, i), fY.eval(params, ps, i) };
+            SkScalar radius = fRadius.eval(params, ps, i);
+            ps.fData[SkParticles::kPositionX][i] = center.fX + v.fX * radius;
+            ps.fData[SkParticles::kPositionY][i] = center.fY + v.fY * radius;
             if (fSetHeading) {
                 if (!v.normalize()) {
                     v.set(0, -1);
                 }
-                ps[i].fPose.fHeading = v;
+                ps.fData[SkParticles::kHeadingX][i] = v.fX;
+                ps.fData[SkParticles::kHeadingY][i] = v.fY;
             }
         }
     }
@@ -221,25 +259,30 @@ public:
 
     REFLECTED(SkPositionOnPathAffector, SkParticleAffector)
 
-    void onApply(const SkParticleUpdateParams& params, SkParticleState ps[], int count) override {
+    void onApply(const SkParticleUpdateParams& params, SkParticles& ps, int start,
+                 int count) override {
         if (fContours.empty()) {
             return;
         }
 
-        for (int i = 0; i < count; ++i) {
-            float t = fInput.eval(params, ps[i]);
+        for (int i = start; i < start + count; ++i) {
+            float t = fInput.eval(params, ps, i);
             SkScalar len = fTotalLength * t;
             int idx = 0;
             while (idx < fContours.count() && len > fContours[idx]->length()) {
                 len -= fContours[idx++]->length();
             }
+            SkPoint pos;
             SkVector localXAxis;
-            if (!fContours[idx]->getPosTan(len, &ps[i].fPose.fPosition, &localXAxis)) {
-                ps[i].fPose.fPosition = { 0, 0 };
+            if (!fContours[idx]->getPosTan(len, &pos, &localXAxis)) {
+                pos = { 0, 0 };
                 localXAxis = { 1, 0 };
             }
+            ps.fData[SkParticles::kPositionX][i] = pos.fX;
+            ps.fData[SkParticles::kPositionY][i] = pos.fY;
             if (fSetHeading) {
-                ps[i].fPose.fHeading.set(localXAxis.fY, -localXAxis.fX);
+                ps.fData[SkParticles::kHeadingX][i] = localXAxis.fY;
+                ps.fData[SkParticles::kHeadingY][i] = -localXAxis.fX;
             }
         }
     }
@@ -296,26 +339,31 @@ public:
 
     REFLECTED(SkPositionOnTextAffector, SkParticleAffector)
 
-    void onApply(const SkParticleUpdateParams& params, SkParticleState ps[], int count) override {
+    void onApply(const SkParticleUpdateParams& params, SkParticles& ps, int start,
+                 int count) override {
         if (fContours.empty()) {
             return;
         }
 
         // TODO: Refactor to share code with PositionOnPathAffector
-        for (int i = 0; i < count; ++i) {
-            float t = fInput.eval(params, ps[i]);
+        for (int i = start; i < start + count; ++i) {
+            float t = fInput.eval(params, ps, i);
             SkScalar len = fTotalLength * t;
             int idx = 0;
             while (idx < fContours.count() && len > fContours[idx]->length()) {
                 len -= fContours[idx++]->length();
             }
+            SkPoint pos;
             SkVector localXAxis;
-            if (!fContours[idx]->getPosTan(len, &ps[i].fPose.fPosition, &localXAxis)) {
-                ps[i].fPose.fPosition = { 0, 0 };
+            if (!fContours[idx]->getPosTan(len, &pos, &localXAxis)) {
+                pos = { 0, 0 };
                 localXAxis = { 1, 0 };
             }
+            ps.fData[SkParticles::kPositionX][i] = pos.fX;
+            ps.fData[SkParticles::kPositionY][i] = pos.fY;
             if (fSetHeading) {
-                ps[i].fPose.fHeading.set(localXAxis.fY, -localXAxis.fX);
+                ps.fData[SkParticles::kHeadingX][i] = localXAxis.fY;
+                ps.fData[SkParticles::kHeadingY][i] = -localXAxis.fX;
             }
         }
     }
@@ -371,9 +419,10 @@ public:
 
     REFLECTED(SkSizeAffector, SkParticleAffector)
 
-    void onApply(const SkParticleUpdateParams& params, SkParticleState ps[], int count) override {
-        for (int i = 0; i < count; ++i) {
-            ps[i].fPose.fScale = fCurve.eval(params, ps[i]);
+    void onApply(const SkParticleUpdateParams& params, SkParticles& ps, int start,
+                 int count) override {
+        for (int i = start; i < start + count; ++i) {
+            ps.fData[SkParticles::kScale][i] = fCurve.eval(params, ps, i);
         }
     }
 
@@ -392,9 +441,10 @@ public:
 
     REFLECTED(SkFrameAffector, SkParticleAffector)
 
-    void onApply(const SkParticleUpdateParams& params, SkParticleState ps[], int count) override {
-        for (int i = 0; i < count; ++i) {
-            ps[i].fFrame = fCurve.eval(params, ps[i]);
+    void onApply(const SkParticleUpdateParams& params, SkParticles& ps, int start,
+                 int count) override {
+        for (int i = start; i < start + count; ++i) {
+            ps.fData[SkParticles::kSpriteFrame][i] = fCurve.eval(params, ps, i);
         }
     }
 
@@ -414,9 +464,14 @@ public:
 
     REFLECTED(SkColorAffector, SkParticleAffector)
 
-    void onApply(const SkParticleUpdateParams& params, SkParticleState ps[], int count) override {
-        for (int i = 0; i < count; ++i) {
-            ps[i].fColor = fCurve.eval(params, ps[i]);
+    void onApply(const SkParticleUpdateParams& params, SkParticles& ps, int start,
+                 int count) override {
+        for (int i = start; i < start + count; ++i) {
+            SkColor4f c = fCurve.eval(params, ps, i);
+            ps.fData[SkParticles::kColorR][i] = c.fR;
+            ps.fData[SkParticles::kColorG][i] = c.fG;
+            ps.fData[SkParticles::kColorB][i] = c.fB;
+            ps.fData[SkParticles::kColorA][i] = c.fA;
         }
     }
 
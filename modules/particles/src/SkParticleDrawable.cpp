@@ -10,6 +10,7 @@
 #include "SkAutoMalloc.h"
 #include "SkCanvas.h"
 #include "SkImage.h"
+#include "SkNx.h"
 #include "SkPaint.h"
 #include "SkParticleData.h"
 #include "SkRect.h"
@@ -27,14 +28,52 @@ static sk_sp<SkImage> make_circle_image(int radius) {
     return surface->makeImageSnapshot();
 }
 
+// Packs four unpremul float colors into four SkColors (ARGB).
+static Sk4i to_skcolors(const Sk4f& r, const Sk4f& g, const Sk4f& b, const Sk4f& a) {
+    auto to_byte = [](const Sk4f& x) {
+        return SkNx_cast<int32_t>(Sk4f::Min(Sk4f::Max(x, 0.0f), 1.0f) * 255.0f + 0.5f);
+    };
+    return (to_byte(a) << 24) | (to_byte(r) << 16) | (to_byte(g) << 8) | to_byte(b);
+}
+
+// Builds the xform and color arrays for drawAtlas straight from the particle channels, four
+// particles at a time.
 struct DrawAtlasArrays {
-    DrawAtlasArrays(const SkParticleState particles[], int count, SkPoint center)
+    DrawAtlasArrays(const SkParticles& particles, int count, SkPoint center)
             : fXforms(count)
             , fRects(count)
             , fColors(count) {
-        for (int i = 0; i < count; ++i) {
-            fXforms[i] = particles[i].fPose.asRSXform(center);
-            fColors[i] = particles[i].fColor.toSkColor();
+        const float* posX   = particles.fData[SkParticles::kPositionX];
+        const float* posY   = particles.fData[SkParticles::kPositionY];
+        const float* headX  = particles.fData[SkParticles::kHeadingX];
+        const float* headY  = particles.fData[SkParticles::kHeadingY];
+        const float* scale  = particles.fData[SkParticles::kScale];
+        const float* colorR = particles.fData[SkParticles::kColorR];
+        const float* colorG = particles.fData[SkParticles::kColorG];
+        const float* colorB = particles.fData[SkParticles::kColorB];
+        const float* colorA = particles.fData[SkParticles::kColorA];
+        const Sk4f ofsX(center.fX), ofsY(center.fY);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            Sk4f s =  Sk4f::Load(headX + i) * Sk4f::Load(scale + i),
+                 c = -Sk4f::Load(headY + i) * Sk4f::Load(scale + i),
+                 tx = Sk4f::Load(posX + i) - c * ofsX + s * ofsY,
+                 ty = Sk4f::Load(posY + i) - s * ofsX - c * ofsY;
+            // SkRSXform is { fSCos, fSSin, fTx, fTy }, so this interleaves straight into place.
+            Sk4f::Store4(fXforms.get() + i, c, s, tx, ty);
+
+            Sk4f r = Sk4f::Load(colorR + i), g = Sk4f::Load(colorG + i),
+                 b = Sk4f::Load(colorB + i), a = Sk4f::Load(colorA + i);
+            to_skcolors(r, g, b, a).store(fColors.get() + i);
+        }
+        for (; i < count; ++i) {
+            const float s =  headX[i] * scale[i];
+            const float c = -headY[i] * scale[i];
+            fXforms[i] = SkRSXform::Make(c, s,
+                                         posX[i] - c * center.fX + s * center.fY,
+                                         posY[i] - s * center.fX - c * center.fY);
+            fColors[i] = to_skcolors(colorR[i], colorG[i], colorB[i], colorA[i])[0];
         }
     }
 
@@ -52,7 +91,7 @@ public:
 
     REFLECTED(SkCircleDrawable, SkParticleDrawable)
 
-    void draw(SkCanvas* canvas, const SkParticleState particles[], int count,
+    void draw(SkCanvas* canvas, const SkParticles& particles, int count,
               const SkPaint* paint) override {
         SkPoint center = { SkIntToScalar(fRadius), SkIntToScalar(fRadius) };
         DrawAtlasArrays arrays(particles, count, center);
@@ -93,15 +132,16 @@ public:
 
     REFLECTED(SkImageDrawable, SkParticleDrawable)
 
-    void draw(SkCanvas* canvas, const SkParticleState particles[], int count,
+    void draw(SkCanvas* canvas, const SkParticles& particles, int count,
               const SkPaint* paint) override {
         SkRect baseRect = getBaseRect();
         SkPoint center = { baseRect.width() * 0.5f, baseRect.height() * 0.5f };
         DrawAtlasArrays arrays(particles, count, center);
 
         int frameCount = fCols * fRows;
+        const float* spriteFrames = particles.fData[SkParticles::kSpriteFrame];
         for (int i = 0; i < count; ++i) {
-            int frame = static_cast<int>(particles[i].fFrame * frameCount + 0.5f);
+            int frame = static_cast<int>(spriteFrames[i] * frameCount + 0.5f);
             frame = SkTPin(frame, 0, frameCount - 1);
             int row = frame / fCols;
             int col = frame % fCols;
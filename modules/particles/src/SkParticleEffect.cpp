@@ -9,11 +9,15 @@
 
 #include "SkCanvas.h"
 #include "SkColorData.h"
+#include "SkNx.h"
 #include "SkPaint.h"
 #include "SkParticleAffector.h"
 #include "SkParticleDrawable.h"
 #include "SkReflected.h"
 #include "SkRSXform.h"
+#include "SkTaskGroup.h"
+
+#include <algorithm>
 
 void SkParticleEffectParams::visitFields(SkFieldVisitor* v) {
     v->visit("MaxCount", fMaxCount);
@@ -27,6 +31,18 @@ void SkParticleEffectParams::visitFields(SkFieldVisitor* v) {
     v->visit("Update", fUpdateAffectors);
 }
 
+// dst[i] += rate[i] * dt, for i in [0, count), four at a time.
+static void advance_channel(float* dst, const float* rate, float dt, int count) {
+    const Sk4f dt4(dt);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        (Sk4f::Load(dst + i) + Sk4f::Load(rate + i) * dt4).store(dst + i);
+    }
+    for (; i < count; ++i) {
+        dst[i] += rate[i] * dt;
+    }
+}
+
 SkParticleEffect::SkParticleEffect(sk_sp<SkParticleEffectParams> params, const SkRandom& random)
         : fParams(std::move(params))
         , fRandom(random)
@@ -46,13 +62,66 @@ void SkParticleEffect::start(double now, bool looping) {
 }
 
 void SkParticleEffect::update(double now) {
-    if (!this->isAlive() || !fParams->fDrawable) {
+    SkParticleUpdateParams updateParams;
+    if (this->beginUpdate(now, &updateParams)) {
+        this->updateParticles(updateParams, 0, fCount);
+        this->endUpdate(now);
+    }
+}
+
+constexpr int SkParticleEffect::kUpdateChunkSize;
+
+void SkParticleEffect::UpdateAll(SkParticleEffect* const effects[], int count, double now,
+                                 SkExecutor* executor) {
+    if (!executor) {
+        for (int i = 0; i < count; ++i) {
+            effects[i]->update(now);
+        }
         return;
     }
 
+    SkAutoTMalloc<SkParticleUpdateParams> params(count);
+    SkAutoTMalloc<bool> active(count);
+
+    // Aging and spawning draw from each effect's own generator in order, so they run once per
+    // effect. Different effects share nothing, though, so they can run concurrently.
+    SkTaskGroup tg(*executor);
+    tg.batch(count, [&](int i) {
+        active[i] = effects[i]->beginUpdate(now, &params[i]);
+    });
+    tg.wait();
+
+    // The update pass only touches each particle's own channels and restored stable generator,
+    // so splitting it into chunks gives the same results no matter how many threads run them.
+    for (int i = 0; i < count; ++i) {
+        if (!active[i]) {
+            continue;
+        }
+        SkParticleEffect* effect = effects[i];
+        for (int start = 0; start < effect->fCount; start += kUpdateChunkSize) {
+            int n = SkTMin(kUpdateChunkSize, effect->fCount - start);
+            tg.add([effect, &params, i, start, n] {
+                effect->updateParticles(params[i], start, n);
+            });
+        }
+    }
+    tg.wait();
+
+    for (int i = 0; i < count; ++i) {
+        if (active[i]) {
+            effects[i]->endUpdate(now);
+        }
+    }
+}
+
+bool SkParticleEffect::beginUpdate(double now, SkParticleUpdateParams* params) {
+    if (!this->isAlive() || !fParams->fDrawable) {
+        return false;
+    }
+
     float deltaTime = static_cast<float>(now - fLastTime);
     if (deltaTime <= 0.0f) {
-        return;
+        return false;
     }
     fLastTime = now;
 
@@ -64,19 +133,22 @@ void SkParticleEffect::update(double now) {
     float effectAge = static_cast<float>((now - fSpawnTime) / fParams->fEffectDuration);
     effectAge = fLooping ? fmodf(effectAge, 1.0f) : SkTPin(effectAge, 0.0f, 1.0f);
 
-    SkParticleUpdateParams updateParams;
+    SkParticleUpdateParams& updateParams = *params;
     updateParams.fDeltaTime = deltaTime;
     updateParams.fEffectAge = effectAge;
 
     // During spawn, values that refer to kAge_Source get the *effect* age
     updateParams.fAgeSource = SkParticleValue::kEffectAge_Source;
 
+    float* age         = fParticles.fData[SkParticles::kAge];
+    float* invLifetime = fParticles.fData[SkParticles::kInvLifetime];
+
     // Advance age for existing particles, and remove any that have reached their end of life
+    advance_channel(age, invLifetime, deltaTime, fCount);
     for (int i = 0; i < fCount; ++i) {
-        fParticles[i].fAge += fParticles[i].fInvLifetime * deltaTime;
-        if (fParticles[i].fAge > 1.0f) {
+        if (age[i] > 1.0f) {
             // NOTE: This is fast, but doesn't preserve drawing order. Could be a problem...
-            fParticles[i]     = fParticles[fCount - 1];
+            fParticles.copy(i, fCount - 1);
             fStableRandoms[i] = fStableRandoms[fCount - 1];
             --i;
             --fCount;
@@ -91,62 +163,84 @@ void SkParticleEffect::update(double now) {
     if (numToSpawn) {
         const int spawnBase = fCount;
 
+        static constexpr float kSpawnDefaults[SkParticles::kNumChannels] = {
+            0.0f,                    // kAge
+            0.0f,                    // kInvLifetime (computed below)
+            0.0f, 0.0f,              // kPositionX, kPositionY
+            0.0f, -1.0f,             // kHeadingX, kHeadingY
+            1.0f,                    // kScale
+            0.0f, 0.0f, 0.0f,        // kVelocityX, kVelocityY, kVelocityAngular
+            1.0f, 1.0f, 1.0f, 1.0f,  // kColorR, kColorG, kColorB, kColorA
+            0.0f,                    // kSpriteFrame
+        };
+        for (int c = 0; c < SkParticles::kNumChannels; ++c) {
+            std::fill_n(fParticles.fData[c].get() + spawnBase, numToSpawn, kSpawnDefaults[c]);
+        }
         for (int i = 0; i < numToSpawn; ++i) {
             // Mutate our SkRandom so each particle definitely gets a different generator
             fRandom.nextU();
-            fParticles[fCount].fAge = 0.0f;
-            fParticles[fCount].fPose.fPosition = { 0.0f, 0.0f };
-            fParticles[fCount].fPose.fHeading = { 0.0f, -1.0f };
-            fParticles[fCount].fPose.fScale = 1.0f;
-            fParticles[fCount].fVelocity.fLinear = { 0.0f, 0.0f };
-            fParticles[fCount].fVelocity.fAngular = 0.0f;
-            fParticles[fCount].fColor = { 1.0f, 1.0f, 1.0f, 1.0f };
-            fParticles[fCount].fFrame = 0.0f;
-            fParticles[fCount].fRandom = fRandom;
+            fParticles.fRandom[fCount] = fRandom;
             fCount++;
         }
 
         // Apply spawn affectors
         for (auto affector : fParams->fSpawnAffectors) {
             if (affector) {
-                affector->apply(updateParams, fParticles + spawnBase, numToSpawn);
+                affector->apply(updateParams, fParticles, spawnBase, numToSpawn);
             }
         }
 
         // Now stash copies of the random generators and compute particle lifetimes
         // (so the curve can refer to spawn-computed source values)
         for (int i = spawnBase; i < fCount; ++i) {
-            fParticles[i].fInvLifetime =
-                sk_ieee_float_divide(1.0f, fParams->fLifetime.eval(updateParams, fParticles[i]));
-            fStableRandoms[i] = fParticles[i].fRandom;
+            invLifetime[i] =
+                sk_ieee_float_divide(1.0f, fParams->fLifetime.eval(updateParams, fParticles, i));
+            fStableRandoms[i] = fParticles.fRandom[i];
         }
     }
 
     // Restore all stable random generators so update affectors get consistent behavior each frame
     for (int i = 0; i < fCount; ++i) {
-        fParticles[i].fRandom = fStableRandoms[i];
+        fParticles.fRandom[i] = fStableRandoms[i];
     }
 
     // During update, values that refer to kAge_Source get the *particle* age
     updateParams.fAgeSource = SkParticleValue::kParticleAge_Source;
+    return true;
+}
 
+void SkParticleEffect::updateParticles(const SkParticleUpdateParams& updateParams, int start,
+                                       int count) {
     // Apply update rules
     for (auto affector : fParams->fUpdateAffectors) {
         if (affector) {
-            affector->apply(updateParams, fParticles, fCount);
+            affector->apply(updateParams, fParticles, start, count);
         }
     }
 
     // Do fixed-function update work (integration of position and orientation)
-    for (int i = 0; i < fCount; ++i) {
-        fParticles[i].fPose.fPosition += fParticles[i].fVelocity.fLinear * deltaTime;
-
-        SkScalar c, s = SkScalarSinCos(fParticles[i].fVelocity.fAngular * deltaTime, &c);
-        SkVector oldHeading = fParticles[i].fPose.fHeading;
-        fParticles[i].fPose.fHeading = { oldHeading.fX * c - oldHeading.fY * s,
-                                         oldHeading.fX * s + oldHeading.fY * c };
+    const float deltaTime = updateParams.fDeltaTime;
+    advance_channel(fParticles.fData[SkParticles::kPositionX] + start,
+                    fParticles.fData[SkParticles::kVelocityX] + start, deltaTime, count);
+    advance_channel(fParticles.fData[SkParticles::kPositionY] + start,
+                    fParticles.fData[SkParticles::kVelocityY] + start, deltaTime, count);
+
+    float* headingX = fParticles.fData[SkParticles::kHeadingX];
+    float* headingY = fParticles.fData[SkParticles::kHeadingY];
+    const float* angular = fParticles.fData[SkParticles::kVelocityAngular];
+    for (int i = start; i < start + count; ++i) {
+        if (angular[i] == 0.0f) {
+            continue;
+        }
+        SkScalar c, s = SkScalarSinCos(angular[i] * deltaTime, &c);
+        float oldX = headingX[i],
+              oldY = headingY[i];
+        headingX[i] = oldX * c - oldY * s;
+        headingY[i] = oldX * s + oldY * c;
     }
+}
 
+void SkParticleEffect::endUpdate(double now) {
     // Mark effect as dead if we've reached the end (and are not looping)
     if (!fLooping && (now - fSpawnTime) > fParams->fEffectDuration) {
         fSpawnTime = -1.0;
@@ -157,7 +251,7 @@ void SkParticleEffect::draw(SkCanvas* canvas) {
     if (this->isAlive() && fParams->fDrawable) {
         SkPaint paint;
         paint.setFilterQuality(SkFilterQuality::kMedium_SkFilterQuality);
-        fParams->fDrawable->draw(canvas, fParticles.get(), fCount, &paint);
+        fParams->fDrawable->draw(canvas, fParticles, fCount, &paint);
     }
 }
 
@@ -222,42 +316,47 @@ void SkParticleValue::visitFields(SkFieldVisitor* v) {
 }
 
 float SkParticleValue::getSourceValue(const SkParticleUpdateParams& params,
-                                      SkParticleState& ps) const {
+                                      SkParticles& ps, int i) const {
     switch ((kAge_Source == fSource) ? params.fAgeSource : fSource) {
         // Do all the simple (non-frame-dependent) sources first:
-        case kRandom_Source:      return ps.fRandom.nextF();
-        case kParticleAge_Source: return ps.fAge;
+        case kRandom_Source:      return ps.fRandom[i].nextF();
+        case kParticleAge_Source: return ps.fData[SkParticles::kAge][i];
         case kEffectAge_Source:   return params.fEffectAge;
 
-        case kPositionX_Source:   return ps.fPose.fPosition.fX;
-        case kPositionY_Source:   return ps.fPose.fPosition.fY;
-        case kScale_Source:       return ps.fPose.fScale;
-        case kRotation_Source:    return ps.fVelocity.fAngular;
+        case kPositionX_Source:   return ps.fData[SkParticles::kPositionX][i];
+        case kPositionY_Source:   return ps.fData[SkParticles::kPositionY][i];
+        case kScale_Source:       return ps.fData[SkParticles::kScale][i];
+        case kRotation_Source:    return ps.fData[SkParticles::kVelocityAngular][i];
 
-        case kColorR_Source:      return ps.fColor.fR;
-        case kColorG_Source:      return ps.fColor.fG;
-        case kColorB_Source:      return ps.fColor.fB;
-        case kColorA_Source:      return ps.fColor.fA;
-        case kSpriteFrame_Source: return ps.fFrame;
+        case kColorR_Source:      return ps.fData[SkParticles::kColorR][i];
+        case kColorG_Source:      return ps.fData[SkParticles::kColorG][i];
+        case kColorB_Source:      return ps.fData[SkParticles::kColorB][i];
+        case kColorA_Source:      return ps.fData[SkParticles::kColorA][i];
+        case kSpriteFrame_Source: return ps.fData[SkParticles::kSpriteFrame][i];
     }
 
     SkASSERT(source_needs_frame(fSource));
-    SkVector frameUp = ps.getFrameHeading(static_cast<SkParticleFrame>(fFrame));
+    SkVector frameUp = ps.getFrameHeading(static_cast<SkParticleFrame>(fFrame), i);
     SkVector frameRight = { -frameUp.fY, frameUp.fX };
+    SkVector heading  = { ps.fData[SkParticles::kHeadingX][i],
+                          ps.fData[SkParticles::kHeadingY][i] };
+    SkVector velocity = { ps.fData[SkParticles::kVelocityX][i],
+                          ps.fData[SkParticles::kVelocityY][i] };
 
     switch (fSource) {
-        case kHeadingX_Source:  return ps.fPose.fHeading.dot(frameRight);
-        case kHeadingY_Source:  return ps.fPose.fHeading.dot(frameUp);
-        case kVelocityX_Source: return ps.fVelocity.fLinear.dot(frameRight);
-        case kVelocityY_Source: return ps.fVelocity.fLinear.dot(frameUp);
+        case kHeadingX_Source:  return heading.dot(frameRight);
+        case kHeadingY_Source:  return heading.dot(frameUp);
+        case kVelocityX_Source: return velocity.dot(frameRight);
+        case kVelocityY_Source: return velocity.dot(frameUp);
     }
 
     SkDEBUGFAIL("Unreachable");
     return 0.0f;
 }
 
-float SkParticleValue::eval(const SkParticleUpdateParams& params, SkParticleState& ps) const {
-    float v = this->getSourceValue(params, ps);
+float SkParticleValue::eval(const SkParticleUpdateParams& params, SkParticles& ps,
+                            int i) const {
+    float v = this->getSourceValue(params, ps, i);
     v = (v * fScale) + fBias;
 
     switch (fTileMode) {
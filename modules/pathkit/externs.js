@@ -28,6 +28,10 @@ var PathKit = {
 	_FromCmds: function(ptr, size) {},
 	loadCmdsTypedArray: function(arr) {},
 	FromCmds: function(arr) {},
+	_FromCmdsBatch: function(cptr, lptr, numPaths) {},
+	FromCmdsBatch: function(cmds, lengths) {},
+	MakeFromOpBatch: function(paths, op) {},
+	SimplifyBatch: function(paths) {},
 	_SkCubicMap: function(cp1, cp2) {},
 	cubicYFromX: function(cpx1, cpy1, cpx2, cpy2, X) {},
 	cubicPtFromT: function(cpx1, cpy1, cpx2, cpy2, T) {},
@@ -36,6 +40,10 @@ var PathKit = {
 	 * @type {Float32Array}
 	 */
 	HEAPF32: {},
+	/**
+	 * @type {Int32Array}
+	 */
+	HEAP32: {},
 
 	SkPath: {
 		_addPath: function(path, scaleX, skewX, transX, skewY, scaleY, transY, pers0, pers1, pers2) {},
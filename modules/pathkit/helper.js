@@ -58,10 +58,27 @@
     return [ptr, len];
   }
 
+  // Copies a Float32Array (or other TypedArray) into the WASM heap in one go.
+  // Returns the pointer, which must be _free'd.
+  function copyTypedArray(ta, heap) {
+    var ptr = PathKit._malloc(ta.length * heap.BYTES_PER_ELEMENT);
+    heap.set(ta, ptr / heap.BYTES_PER_ELEMENT);
+    return ptr;
+  }
+
   // Experimentation has shown that using TypedArrays to pass arrays from
   // JS to C++ is faster than passing the JS Arrays across.
-  // See above for example of cmds.
+  // See above for example of cmds. cmds may also be an already-flat
+  // Float32Array of verbs and their arguments, e.g.
+  //   new Float32Array([PathKit.MOVE_VERB, 0, 10, PathKit.LINE_VERB, 30, 40])
+  // which skips the flattening step entirely.
   PathKit.FromCmds = function(cmds) {
+    if (cmds instanceof Float32Array) {
+      var ptr = copyTypedArray(cmds, PathKit.HEAPF32);
+      var path = PathKit._FromCmds(ptr, cmds.length);
+      PathKit._free(ptr);
+      return path;
+    }
     var ptrLen = PathKit.loadCmdsTypedArray(cmds);
     var path = PathKit._FromCmds(ptrLen[0], ptrLen[1]);
     // TODO(kjlubick): cache this memory blob somehow.
@@ -69,6 +86,23 @@
     return path;
   }
 
+  // Builds many paths with a single call into WASM. cmds is a flat
+  // Float32Array holding the commands of every path back to back (in the
+  // same format as FromCmds), and lengths[i] is how many floats of cmds
+  // belong to path i. Returns an array of SkPaths, with null for any path
+  // whose commands were malformed.
+  PathKit.FromCmdsBatch = function(cmds, lengths) {
+    if (!(cmds instanceof Float32Array)) {
+      cmds = new Float32Array(cmds);
+    }
+    var cptr = copyTypedArray(cmds, PathKit.HEAPF32);
+    var lptr = copyTypedArray(new Int32Array(lengths), PathKit.HEAP32);
+    var paths = PathKit._FromCmdsBatch(cptr, lptr, lengths.length);
+    PathKit._free(cptr);
+    PathKit._free(lptr);
+    return paths;
+  }
+
   /**
    * A common pattern is to call this function in sequence with the same
    * params. We can just remember the last one to speed things up.
@@ -92,26 +92,18 @@ JSArray EMSCRIPTEN_KEEPALIVE ToCmds(const SkPath& path) {
     return cmds;
 }
 
-// This type signature is a mess, but it's necessary. See, we can't use "bind" (EMSCRIPTEN_BINDINGS)
-// and pointers to primitive types (Only bound types like SkPoint). We could if we used
-// cwrap (see https://becominghuman.ai/passing-and-returning-webassembly-array-parameters-a0f572c65d97)
-// but that requires us to stick to C code and, AFAIK, doesn't allow us to return nice things like
-// SkPath or SkOpBuilder.
-//
-// So, basically, if we are using C++ and EMSCRIPTEN_BINDINGS, we can't have primative pointers
-// in our function type signatures. (this gives an error message like "Cannot call foo due to unbound
-// types Pi, Pf").  But, we can just pretend they are numbers and cast them to be pointers and
-// the compiler is happy.
-SkPathOrNull EMSCRIPTEN_KEEPALIVE FromCmds(uintptr_t /* float* */ cptr, int numCmds) {
-    const auto* cmds = reinterpret_cast<const float*>(cptr);
-    SkPath path;
+// Appends the verbs in cmds[0..numCmds) to path. Returns false if the commands are malformed.
+static bool AppendCmds(const float* cmds, int numCmds, SkPath* outPath) {
+    SkPath& path = *outPath;
+    // Every verb takes at least one float, and most take two per point.
+    path.incReserve(numCmds / 2);
     float x1, y1, x2, y2, x3, y3;
 
     // if there are not enough arguments, bail with the path we've constructed so far.
     #define CHECK_NUM_ARGS(n) \
         if ((i + n) > numCmds) { \
             SkDebugf("Not enough args to match the verbs. Saw %d commands\n", numCmds); \
-            return emscripten::val::null(); \
+            return false; \
         }
 
     for(int i = 0; i < numCmds;){
@@ -151,15 +143,53 @@ SkPathOrNull EMSCRIPTEN_KEEPALIVE FromCmds(uintptr_t /* float* */ cptr, int numC
                 break;
             default:
                 SkDebugf("  path: UNKNOWN command %f, aborting dump...\n", cmds[i-1]);
-                return emscripten::val::null();
+                return false;
         }
     }
 
     #undef CHECK_NUM_ARGS
 
+    return true;
+}
+
+// This type signature is a mess, but it's necessary. See, we can't use "bind" (EMSCRIPTEN_BINDINGS)
+// and pointers to primitive types (Only bound types like SkPoint). We could if we used
+// cwrap (see https://becominghuman.ai/passing-and-returning-webassembly-array-parameters-a0f572c65d97)
+// but that requires us to stick to C code and, AFAIK, doesn't allow us to return nice things like
+// SkPath or SkOpBuilder.
+//
+// So, basically, if we are using C++ and EMSCRIPTEN_BINDINGS, we can't have primative pointers
+// in our function type signatures. (this gives an error message like "Cannot call foo due to unbound
+// types Pi, Pf").  But, we can just pretend they are numbers and cast them to be pointers and
+// the compiler is happy.
+SkPathOrNull EMSCRIPTEN_KEEPALIVE FromCmds(uintptr_t /* float* */ cptr, int numCmds) {
+    SkPath path;
+    if (!AppendCmds(reinterpret_cast<const float*>(cptr), numCmds, &path)) {
+        return emscripten::val::null();
+    }
     return emscripten::val(path);
 }
 
+// Builds many paths from one command buffer in a single call. lptr holds numPaths lengths; path i
+// is made from the next lengths[i] floats of cptr. Returns an array of paths (null entries for
+// malformed ones).
+JSArray EMSCRIPTEN_KEEPALIVE FromCmdsBatch(uintptr_t /* float* */ cptr,
+                                           uintptr_t /* int32_t* */ lptr, int numPaths) {
+    const auto* cmds = reinterpret_cast<const float*>(cptr);
+    const auto* lengths = reinterpret_cast<const int32_t*>(lptr);
+    JSArray paths = emscripten::val::array();
+    for (int p = 0; p < numPaths; ++p) {
+        SkPath path;
+        if (AppendCmds(cmds, lengths[p], &path)) {
+            paths.call<void>("push", path);
+        } else {
+            paths.call<void>("push", emscripten::val::null());
+        }
+        cmds += lengths[p];
+    }
+    return paths;
+}
+
 SkPath EMSCRIPTEN_KEEPALIVE NewPath() {
     return SkPath();
 }
@@ -259,6 +289,37 @@ SkPathOrNull EMSCRIPTEN_KEEPALIVE MakeFromOp(const SkPath& pathOne, const SkPath
     return emscripten::val::null();
 }
 
+// Combines paths[0] with each of paths[1..] in turn using op, in one call. Unions of many paths go
+// through SkOpBuilder, which merges them far faster than a chain of pairwise ops.
+SkPathOrNull EMSCRIPTEN_KEEPALIVE MakeFromOpBatch(emscripten::val /* SkPath[] */ paths,
+                                                  SkPathOp op) {
+    const int count = paths["length"].as<int>();
+    if (count == 0) {
+        return emscripten::val::null();
+    }
+    SkOpBuilder builder;
+    for (int i = 0; i < count; ++i) {
+        const SkPath* path = paths[i].as<SkPath*>(allow_raw_pointers());
+        builder.add(*path, i == 0 ? kUnion_SkPathOp : op);
+    }
+    SkPath out;
+    if (builder.resolve(&out)) {
+        return emscripten::val(out);
+    }
+    return emscripten::val::null();
+}
+
+// Simplifies every path in paths in place. Returns true only if all of them succeeded.
+bool EMSCRIPTEN_KEEPALIVE ApplySimplifyBatch(emscripten::val /* SkPath[] */ paths) {
+    const int count = paths["length"].as<int>();
+    bool ok = true;
+    for (int i = 0; i < count; ++i) {
+        SkPath* path = paths[i].as<SkPath*>(allow_raw_pointers());
+        ok &= Simplify(*path, path);
+    }
+    return ok;
+}
+
 SkPathOrNull EMSCRIPTEN_KEEPALIVE ResolveBuilder(SkOpBuilder& builder) {
     SkPath path;
     if (builder.resolve(&path)) {
@@ -552,10 +613,13 @@ EMSCRIPTEN_BINDINGS(skia) {
     function("NewPath", &CopyPath);
     // FromCmds is defined in helper.js to make use of TypedArrays transparent.
     function("_FromCmds", &FromCmds);
+    function("_FromCmdsBatch", &FromCmdsBatch);
     // Path2D is opaque, so we can't read in from it.
 
     // PathOps
     function("MakeFromOp", &MakeFromOp);
+    function("MakeFromOpBatch", &MakeFromOpBatch);
+    function("SimplifyBatch", &ApplySimplifyBatch);
 
     enum_<SkPathOp>("PathOp")
         .value("DIFFERENCE",         SkPathOp::kDifference_SkPathOp)
@@ -227,4 +227,40 @@ describe('PathKit\'s PathOps Behavior', function() {
             });
         }));
     });
+
+    it('builds, unions and simplifies many paths with the batch APIs', function(done) {
+        LoadPathKit.then(catchException(done, () => {
+            const M = PathKit.MOVE_VERB, L = PathKit.LINE_VERB, Z = PathKit.CLOSE_VERB;
+            // Three overlapping 10x10 squares, each 12 floats long, in one buffer.
+            let cmds = [];
+            let lengths = [];
+            for (let i = 0; i < 3; i++) {
+                let x = i * 5;
+                cmds.push(M, x, 0, L, x + 10, 0, L, x + 10, 10, L, x, 10, Z);
+                lengths.push(12);
+            }
+            let paths = PathKit.FromCmdsBatch(new Float32Array(cmds), lengths);
+            expect(paths.length).toBe(3);
+            for (let i = 0; i < 3; i++) {
+                let single = PathKit.FromCmds(new Float32Array(cmds.slice(i * 12, i * 12 + 12)));
+                expect(paths[i].equals(single)).toBe(true);
+                single.delete();
+            }
+
+            let union = PathKit.MakeFromOpBatch(paths, PathKit.PathOp.UNION);
+            expect(union).not.toBeNull();
+            let bounds = union.getBounds();
+            expect(bounds.fLeft).toBe(0);
+            expect(bounds.fRight).toBe(20);
+            expect(bounds.fBottom).toBe(10);
+
+            expect(PathKit.SimplifyBatch(paths)).toBe(true);
+
+            union.delete();
+            for (let path of paths) {
+                path.delete();
+            }
+            done();
+        }));
+    });
 });
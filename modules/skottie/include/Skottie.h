@@ -24,7 +24,7 @@ class SkStream;
 
 namespace skjson { class ObjectValue; }
 
-namespace sksg { class Scene;  }
+namespace sksg { class InvalidationController; class Scene; }
 
 namespace skottie {
 
@@ -170,6 +170,12 @@ public:
         sk_sp<Animation> make(const char* data, size_t length);
         sk_sp<Animation> makeFromFile(const char path[]);
 
+        /**
+         * Builds an animation from an already parsed JSON DOM. The DOM is only read, so several
+         * builders may instantiate the same DOM concurrently (e.g. one Animation per thread).
+         */
+        sk_sp<Animation> make(const skjson::ObjectValue&);
+
     private:
         sk_sp<ResourceProvider> fResourceProvider;
         sk_sp<SkFontMgr>        fFontMgr;
@@ -212,9 +218,13 @@ public:
      * Updates the animation state for |t|.
      *
      * @param t   normalized [0..1] frame selector (0 -> first frame, 1 -> final frame)
+     * @param ic  optional invalidation controller (dirty region tracking)
      *
+     * When |ic| is provided, it accumulates the areas changed by this seek, in animation
+     * coordinates (pre |dst| mapping).  Clients can then clip the next render() to the damaged
+     * area: content outside the clip is not drawn.
      */
-    void seek(SkScalar t);
+    void seek(SkScalar t, sksg::InvalidationController* ic = nullptr);
 
     /**
      * Returns the animation duration in seconds.
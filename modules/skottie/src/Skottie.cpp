@@ -275,7 +275,8 @@ AnimationBuilder::AnimationBuilder(sk_sp<ResourceProvider> rp, sk_sp<SkFontMgr>
     , fStats(stats)
     , fDuration(duration)
     , fFrameRate(framerate)
-    , fHasNontrivialBlending(false) {}
+    , fHasNontrivialBlending(false)
+    , fCompVisibility({ -SK_ScalarInfinity, SK_ScalarInfinity }) {}
 
 std::unique_ptr<sksg::Scene> AnimationBuilder::parse(const skjson::ObjectValue& jroot) {
     this->dispatchMarkers(jroot["markers"]);
@@ -283,6 +284,11 @@ std::unique_ptr<sksg::Scene> AnimationBuilder::parse(const skjson::ObjectValue&
     this->parseAssets(jroot["assets"]);
     this->parseFonts(jroot["fonts"], jroot["chars"]);
 
+    // The top-level composition is only ticked within the animation [in..out] range.
+    const auto in_point = ParseDefault<float>(jroot["ip"], 0.0f);
+    fCompVisibility = { in_point,
+                        SkTMax(ParseDefault<float>(jroot["op"], SK_ScalarMax), in_point) };
+
     AnimatorScope animators;
     auto root = this->attachComposition(jroot, &animators);
 
@@ -449,16 +455,6 @@ sk_sp<Animation> Animation::Builder::make(SkStream* stream) {
 sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
-    // Sanitize factory args.
-    class NullResourceProvider final : public ResourceProvider {
-        sk_sp<SkData> load(const char[], const char[]) const override { return nullptr; }
-    };
-    auto resolvedProvider = fResourceProvider
-            ? fResourceProvider : sk_make_sp<NullResourceProvider>();
-
-    memset(&fStats, 0, sizeof(struct Stats));
-
-    fStats.fJsonSize = data_len;
     const auto t0 = std::chrono::steady_clock::now();
 
     const skjson::DOM dom(data, data_len);
@@ -467,12 +463,35 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
         if (fLogger) {
             fLogger->log(Logger::Level::kError, "Failed to parse JSON input.\n");
         }
+        memset(&fStats, 0, sizeof(struct Stats));
+        fStats.fJsonSize = data_len;
         return nullptr;
     }
-    const auto& json = dom.root().as<skjson::ObjectValue>();
 
     const auto t1 = std::chrono::steady_clock::now();
-    fStats.fJsonParseTimeMS = std::chrono::duration<float, std::milli>{t1-t0}.count();
+
+    auto animation = this->make(dom.root().as<skjson::ObjectValue>());
+
+    fStats.fJsonSize         = data_len;
+    fStats.fJsonParseTimeMS  = std::chrono::duration<float, std::milli>{t1-t0}.count();
+    fStats.fTotalLoadTimeMS += fStats.fJsonParseTimeMS;
+
+    return animation;
+}
+
+sk_sp<Animation> Animation::Builder::make(const skjson::ObjectValue& json) {
+    TRACE_EVENT0("skottie", TRACE_FUNC);
+
+    // Sanitize factory args.
+    class NullResourceProvider final : public ResourceProvider {
+        sk_sp<SkData> load(const char[], const char[]) const override { return nullptr; }
+    };
+    auto resolvedProvider = fResourceProvider
+            ? fResourceProvider : sk_make_sp<NullResourceProvider>();
+
+    memset(&fStats, 0, sizeof(struct Stats));
+
+    const auto t1 = std::chrono::steady_clock::now();
 
     const auto version  = ParseDefault<SkString>(json["v"], SkString());
     const auto size     = SkSize::Make(ParseDefault<float>(json["w"], 0.0f),
@@ -504,7 +523,7 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
 
     const auto t2 = std::chrono::steady_clock::now();
     fStats.fSceneParseTimeMS = std::chrono::duration<float, std::milli>{t2-t1}.count();
-    fStats.fTotalLoadTimeMS  = std::chrono::duration<float, std::milli>{t2-t0}.count();
+    fStats.fTotalLoadTimeMS  = fStats.fSceneParseTimeMS;
 
     if (!scene && fLogger) {
         fLogger->log(Logger::Level::kError, "Could not parse animation.\n");
@@ -582,13 +601,13 @@ void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderF
     fScene->render(canvas);
 }
 
-void Animation::seek(SkScalar t) {
+void Animation::seek(SkScalar t, sksg::InvalidationController* ic) {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
     if (!fScene)
         return;
 
-    fScene->animate(fInPoint + SkTPin(t, 0.0f, 1.0f) * (fOutPoint - fInPoint));
+    fScene->animate(fInPoint + SkTPin(t, 0.0f, 1.0f) * (fOutPoint - fInPoint), ic);
 }
 
 sk_sp<Animation> Animation::Make(const char* data, size_t length) {
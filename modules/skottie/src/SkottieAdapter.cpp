@@ -483,8 +483,21 @@ sk_sp<SkTextBlob> TextAdapter::makeBlob() const {
     return blobMaker.makeBlob();
 }
 
+// Whether two text values shape to the same blob. Colors and stroke width only affect the paints.
+static bool same_shaping(const TextValue& a, const TextValue& b) {
+    return a.fTypeface == b.fTypeface
+        && a.fText     == b.fText
+        && a.fTextSize == b.fTextSize
+        && a.fAlign    == b.fAlign;
+}
+
 void TextAdapter::apply() {
-    fTextNode->setBlob(this->makeBlob());
+    // Shaping is by far the most expensive part of a text update, so paint-only animations
+    // reuse the current blob.
+    if (!fTextNode->getBlob() || !same_shaping(fText, fShapedText)) {
+        fTextNode->setBlob(this->makeBlob());
+        fShapedText = fText;
+    }
     fFillColor->setColor(fText.fFillColor);
     fStrokeColor->setColor(fText.fStrokeColor);
     fStrokeColor->setStrokeWidth(fText.fStrokeWidth);
@@ -286,6 +286,7 @@ private:
     sk_sp<SkTextBlob> makeBlob() const;
 
     sk_sp<sksg::Group>     fRoot;
+    TextValue              fShapedText;   // the value the current blob was shaped from
     sk_sp<sksg::TextBlob>  fTextNode;
     sk_sp<sksg::Color>     fFillColor,
                            fStrokeColor;
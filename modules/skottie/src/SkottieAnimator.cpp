@@ -43,11 +43,27 @@ protected:
 
     const KeyframeRec& frame(float t) {
         if (!fCachedRec || !fCachedRec->contains(t)) {
-            fCachedRec = findFrame(t);
+            // Sequential seeks typically land in the next frame: check it before searching.
+            const auto* next = fCachedRec ? fCachedRec + 1 : nullptr;
+            fCachedRec = (next && next <= &fRecs.back() && next->contains(t))
+                ? next
+                : this->findFrame(t);
         }
         return *fCachedRec;
     }
 
+    // Returns the (eased) interpolation factor for |t| within |rec|, clamped to [0..1].
+    float lerpFactor(const KeyframeRec& rec, float t) const {
+        SkASSERT(rec.isValid());
+        if (rec.isConstant() || t <= rec.t0) {
+            return 0;
+        }
+        if (t >= rec.t1) {
+            return 1;
+        }
+        return this->localT(rec, t);
+    }
+
     float localT(const KeyframeRec& rec, float t) const {
         SkASSERT(rec.isValid());
         SkASSERT(!rec.isConstant());
@@ -190,7 +206,18 @@ public:
 
 protected:
     void onTick(float t) override {
-        fApplyFunc(*this->eval(this->frame(t), t, &fScratch));
+        const auto& rec = this->frame(t);
+        const auto  lt  = this->lerpFactor(rec, t);
+
+        // Holds and clamped ranges yield the same value on consecutive ticks: skip re-applying
+        // it, to avoid redundant adapter work downstream.
+        if (&rec == fAppliedRec && lt == fAppliedT) {
+            return;
+        }
+        fAppliedRec = &rec;
+        fAppliedT   = lt;
+
+        fApplyFunc(*this->eval(rec, lt, &fScratch));
     }
 
 private:
@@ -224,15 +251,14 @@ private:
         return SkToInt(fVs.size()) - 1;
     }
 
-    const T* eval(const KeyframeRec& rec, float t, T* v) const {
+    const T* eval(const KeyframeRec& rec, float lt, T* v) const {
         SkASSERT(rec.isValid());
-        if (rec.isConstant() || t <= rec.t0) {
+        if (lt <= 0) {
             return &fVs[rec.vidx0];
-        } else if (t >= rec.t1) {
+        } else if (lt >= 1) {
             return &fVs[rec.vidx1];
         }
 
-        const auto lt = this->localT(rec, t);
         const auto& v0 = fVs[rec.vidx0];
         const auto& v1 = fVs[rec.vidx1];
         ValueTraits<T>::Lerp(v0, v1, lt, v);
@@ -249,6 +275,10 @@ private:
     // during animation.
     T                                   fScratch; // lerp storage
 
+    // Last applied frame and interpolation factor.
+    const KeyframeRec*                  fAppliedRec = nullptr;
+    float                               fAppliedT   = 0;
+
     using INHERITED = KeyframeAnimatorBase;
 };
 
@@ -475,6 +475,19 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachLayer(const skjson::ObjectValue*
         return nullptr;
     }
 
+    int type = ParseDefault<int>((*jlayer)["ty"], -1);
+
+    // Precomps can be arbitrarily expensive to build, so we skip those which are never active
+    // within the current composition's visibility window.  Mattes are always attached, as they
+    // affect the next layer.
+    if (type == 0 && !ParseDefault<bool>((*jlayer)["td"], false) &&
+        (layer_info.fOutPoint < fCompVisibility.fInPoint ||
+         layer_info.fInPoint  > fCompVisibility.fOutPoint)) {
+        // A pending matte would have applied to this layer.
+        layerCtx->fCurrentMatte.reset();
+        return nullptr;
+    }
+
     const AutoPropertyTracker apt(this, *jlayer);
 
     using LayerAttacher = sk_sp<sksg::RenderNode> (AnimationBuilder::*)(const skjson::ObjectValue&,
@@ -489,7 +502,6 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachLayer(const skjson::ObjectValue*
         &AnimationBuilder::attachTextLayer,     // 'ty': 5
     };
 
-    int type = ParseDefault<int>((*jlayer)["ty"], -1);
     if (type < 0 || type >= SkTo<int>(SK_ARRAY_COUNT(gLayerAttachers))) {
         return nullptr;
     }
@@ -19,7 +19,7 @@ namespace skottie {
 namespace internal {
 
 sk_sp<sksg::RenderNode> AnimationBuilder::attachPrecompLayer(const skjson::ObjectValue& jlayer,
-                                                             const LayerInfo&,
+                                                             const LayerInfo& layer_info,
                                                              AnimatorScope* ascope) const {
     const skjson::ObjectValue* time_remap = jlayer["tm"];
     // Empirically, a time mapper supersedes start/stretch.
@@ -29,6 +29,26 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachPrecompLayer(const skjson::Objec
                                        !SkScalarNearlyEqual(stretch_time, 1) ||
                                        time_remap;
 
+    const auto t_bias  = -start_time,
+               t_scale = sk_ieee_float_divide(1, stretch_time),
+               c_scale = sk_float_isfinite(t_scale) ? t_scale : 0;
+
+    // The nested composition is only ticked while this layer is active, so its visibility window
+    // is the layer lifespan (clipped to our own window), mapped to the nested time domain.
+    // Remapped time is unconstrained.
+    const auto parent_visibility = fCompVisibility;
+    if (time_remap) {
+        fCompVisibility = { -SK_ScalarInfinity, SK_ScalarInfinity };
+    } else if (c_scale == 0) {
+        fCompVisibility = { 0, 0 };
+    } else {
+        const auto t0 = (SkTMax(layer_info.fInPoint , parent_visibility.fInPoint ) + t_bias)
+                        * c_scale,
+                   t1 = (SkTMin(layer_info.fOutPoint, parent_visibility.fOutPoint) + t_bias)
+                        * c_scale;
+        fCompVisibility = { SkTMin(t0, t1), SkTMax(t0, t1) };
+    }
+
     AnimatorScope local_animators;
     auto precomp_layer = this->attachAssetRef(jlayer,
                                               requires_time_mapping ? &local_animators : ascope,
@@ -37,6 +57,8 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachPrecompLayer(const skjson::Objec
                                                   return this->attachComposition(jcomp, ascope);
                                               });
 
+    fCompVisibility = parent_visibility;
+
     // Applies a bias/scale/remap t-adjustment to child animators.
     class CompTimeMapper final : public sksg::GroupAnimator {
     public:
@@ -65,11 +87,8 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachPrecompLayer(const skjson::Objec
     };
 
     if (requires_time_mapping) {
-        const auto t_bias  = -start_time,
-                   t_scale = sk_ieee_float_divide(1, stretch_time);
         auto time_mapper =
-            skstd::make_unique<CompTimeMapper>(std::move(local_animators), t_bias,
-                                               sk_float_isfinite(t_scale) ? t_scale : 0);
+            skstd::make_unique<CompTimeMapper>(std::move(local_animators), t_bias, c_scale);
         if (time_remap) {
             // The lambda below captures a raw pointer to the mapper object.  That should be safe,
             // because both the lambda and the mapper are scoped/owned by ctx->fAnimators.
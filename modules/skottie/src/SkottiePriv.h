@@ -208,6 +208,10 @@ private:
     SkTHashMap<SkString, FontInfo>               fFonts;
     mutable SkTHashMap<SkString, ImageAssetInfo> fImageAssetCache;
 
+    // Time window (in the local time of the composition being attached) outside of which the
+    // composition is never ticked.  Layers entirely outside this window are never visible.
+    mutable LayerInfo                            fCompVisibility;
+
     using INHERITED = SkNoncopyable;
 };
 
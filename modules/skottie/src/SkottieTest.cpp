@@ -5,13 +5,20 @@
  * found in the LICENSE file.
  */
 
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkData.h"
 #include "SkMatrix.h"
+#include "SkSGInvalidationController.h"
 #include "Skottie.h"
 #include "SkottieProperty.h"
+#include "SkottieUtils.h"
 #include "SkStream.h"
 
 #include "Test.h"
 
+#include <algorithm>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -217,3 +224,252 @@ DEF_TEST(Skottie_Annotations, reporter) {
     REPORTER_ASSERT(reporter, std::get<1>(observer->fMarkers[1]) == 0.75f);
     REPORTER_ASSERT(reporter, std::get<2>(observer->fMarkers[1]) == 0.75f);
 }
+
+DEF_TEST(Skottie_FrameRenderer, reporter) {
+    static constexpr char json[] = R"({
+                                     "v": "5.2.1",
+                                     "w": 32,
+                                     "h": 32,
+                                     "fr": 10,
+                                     "ip": 0,
+                                     "op": 10,
+                                     "layers": [
+                                       {
+                                         "ty": 1,
+                                         "sw": 8,
+                                         "sh": 8,
+                                         "sc": "#ff0000",
+                                         "ip": 0,
+                                         "op": 10,
+                                         "ks": {
+                                           "p": { "a": 1, "k": [
+                                             { "t": 0, "s": [ 0, 0 ], "e": [ 24, 24 ] },
+                                             { "t": 10 }
+                                           ]},
+                                           "o": { "a": 1, "k": [
+                                             { "t": 0, "s": 100, "e": 20 },
+                                             { "t": 10 }
+                                           ]}
+                                         }
+                                       }
+                                     ]
+                                   })";
+
+    static constexpr size_t kFrameCount = 16;
+
+    const auto render = [](const Animation& anim, SkBitmap* bm) {
+        bm->allocN32Pixels(32, 32);
+        bm->eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas canvas(*bm);
+        anim.render(&canvas);
+    };
+
+    auto renderer = skottie_utils::FrameRenderer::Make(SkData::MakeWithCopy(json, strlen(json)));
+    REPORTER_ASSERT(reporter, renderer);
+    if (!renderer) {
+        return;
+    }
+
+    std::vector<SkBitmap> frames(kFrameCount);
+    renderer->renderFrames(0, 1, kFrameCount, 4, [&](size_t i, const Animation& anim) {
+        render(anim, &frames[i]);
+    });
+
+    SkMemoryStream stream(json, strlen(json));
+    auto animation = Animation::Make(&stream);
+    REPORTER_ASSERT(reporter, animation);
+
+    for (size_t i = 0; i < kFrameCount; ++i) {
+        animation->seek(i * (1.0f / (kFrameCount - 1)));
+
+        SkBitmap expected;
+        render(*animation, &expected);
+
+        REPORTER_ASSERT(reporter, !frames[i].drawsNothing());
+        REPORTER_ASSERT(reporter, !memcmp(expected.getPixels(), frames[i].getPixels(),
+                                          expected.computeByteSize()), "frame %zu", i);
+    }
+}
+
+DEF_TEST(Skottie_PrecompVisibility, reporter) {
+    // "hidden" is outside the animation range, and "deep" is outside the (time shifted) range
+    // of its parent composition: neither should be instantiated.
+    static constexpr char json[] = R"({
+                                     "v": "5.2.1",
+                                     "w": 100,
+                                     "h": 100,
+                                     "fr": 10,
+                                     "ip": 0,
+                                     "op": 10,
+                                     "assets": [
+                                       {
+                                         "id": "comp",
+                                         "layers": [
+                                           {
+                                             "ty": 1, "nm": "inner", "ip": 0, "op": 100,
+                                             "sw": 10, "sh": 10, "sc": "#ff0000", "ks": {}
+                                           }
+                                         ]
+                                       },
+                                       {
+                                         "id": "nested",
+                                         "layers": [
+                                           {
+                                             "ty": 0, "nm": "deep", "refId": "comp",
+                                             "ip": 0, "op": 10, "ks": {}
+                                           }
+                                         ]
+                                       }
+                                     ],
+                                     "layers": [
+                                       {
+                                         "ty": 0, "nm": "visible", "refId": "comp",
+                                         "ip": 0, "op": 10, "ks": {}
+                                       },
+                                       {
+                                         "ty": 0, "nm": "hidden", "refId": "comp",
+                                         "ip": 20, "op": 30, "ks": {}
+                                       },
+                                       {
+                                         "ty": 0, "nm": "shifted", "refId": "nested",
+                                         "ip": 0, "op": 10, "st": 50, "ks": {}
+                                       }
+                                     ]
+                                   })";
+
+    class TestPropertyObserver final : public PropertyObserver {
+    public:
+        void onOpacityProperty(const char node_name[],
+                               const PropertyObserver::LazyHandle<OpacityPropertyHandle>&) override {
+            fNames.push_back(node_name);
+        }
+
+        std::vector<std::string> fNames;
+    };
+
+    SkMemoryStream stream(json, strlen(json));
+    auto observer = sk_make_sp<TestPropertyObserver>();
+
+    auto animation = skottie::Animation::Builder()
+            .setPropertyObserver(observer)
+            .make(&stream);
+
+    REPORTER_ASSERT(reporter, animation);
+
+    // "shifted" ends up with no content, so it is dropped as well.
+    std::sort(observer->fNames.begin(), observer->fNames.end());
+    const std::vector<std::string> expected = { "inner", "visible" };
+    REPORTER_ASSERT(reporter, observer->fNames == expected);
+}
+
+DEF_TEST(Skottie_KeyframeSeek, reporter) {
+    // Opacity keyframes: 0 -> 100 over [0..10], then 100 -> 50 over [10..20].
+    static constexpr char json[] = R"({
+                                     "v": "5.2.1",
+                                     "w": 100,
+                                     "h": 100,
+                                     "fr": 10,
+                                     "ip": 0,
+                                     "op": 20,
+                                     "layers": [
+                                       {
+                                         "ty": 1, "nm": "layer", "ip": 0, "op": 20,
+                                         "sw": 10, "sh": 10, "sc": "#ff0000",
+                                         "ks": {
+                                           "o": { "a": 1, "k": [
+                                             { "t":  0, "s": 0  , "e": 100 },
+                                             { "t": 10, "s": 100, "e": 50  },
+                                             { "t": 20 }
+                                           ]}
+                                         }
+                                       }
+                                     ]
+                                   })";
+
+    class TestPropertyObserver final : public PropertyObserver {
+    public:
+        void onOpacityProperty(const char[],
+                               const PropertyObserver::LazyHandle<OpacityPropertyHandle>& lh)
+                               override {
+            fHandle = lh();
+        }
+
+        std::unique_ptr<OpacityPropertyHandle> fHandle;
+    };
+
+    SkMemoryStream stream(json, strlen(json));
+    auto observer = sk_make_sp<TestPropertyObserver>();
+
+    auto animation = skottie::Animation::Builder()
+            .setPropertyObserver(observer)
+            .make(&stream);
+
+    REPORTER_ASSERT(reporter, animation);
+    REPORTER_ASSERT(reporter, observer->fHandle);
+
+    // Sequential, repeated and random-access seeks must all land on the right frame.
+    static constexpr struct {
+        float t, opacity;
+    } gTests[] = {
+        { 0.00f,   0 }, { 0.25f,  50 }, { 0.50f, 100 }, { 0.75f, 75 }, { 1.00f, 50 },
+        { 1.00f,  50 }, { 0.25f,  50 }, { 0.75f,  75 }, { 0.00f,  0 }, { 0.50f, 100 },
+    };
+
+    for (const auto& tst : gTests) {
+        animation->seek(tst.t);
+        REPORTER_ASSERT(reporter,
+                        SkScalarNearlyEqual(observer->fHandle->get(), tst.opacity),
+                        "t: %f, opacity: %f", tst.t, observer->fHandle->get());
+    }
+}
+
+DEF_TEST(Skottie_SeekDamage, reporter) {
+    // A 10x10 solid moving from (0,0) to (50,0) over [0..10], then holding still.
+    static constexpr char json[] = R"({
+                                     "v": "5.2.1",
+                                     "w": 100,
+                                     "h": 100,
+                                     "fr": 10,
+                                     "ip": 0,
+                                     "op": 20,
+                                     "layers": [
+                                       {
+                                         "ty": 1, "ip": 0, "op": 20,
+                                         "sw": 10, "sh": 10, "sc": "#ff0000",
+                                         "ks": {
+                                           "p": { "a": 1, "k": [
+                                             { "t":  0, "s": [ 0, 0 ], "e": [ 50, 0 ] },
+                                             { "t": 10 }
+                                           ]}
+                                         }
+                                       }
+                                     ]
+                                   })";
+
+    SkMemoryStream stream(json, strlen(json));
+    auto animation = Animation::Make(&stream);
+    REPORTER_ASSERT(reporter, animation);
+
+    // Flush the initial (full) damage.
+    {
+        sksg::InvalidationController ic;
+        animation->seek(0, &ic);
+    }
+
+    sksg::InvalidationController ic;
+    animation->seek(0.25f, &ic);
+    REPORTER_ASSERT(reporter, ic.bounds() == SkRect::MakeLTRB(0, 0, 35, 10));
+
+    ic.reset();
+    animation->seek(0.25f, &ic);
+    REPORTER_ASSERT(reporter, ic.bounds().isEmpty());
+
+    ic.reset();
+    animation->seek(0.5f, &ic);
+    animation->seek(0.75f, &ic);
+    REPORTER_ASSERT(reporter, ic.bounds() == SkRect::MakeLTRB(25, 0, 60, 10));
+
+    ic.reset();
+    animation->seek(1, &ic);
+    REPORTER_ASSERT(reporter, ic.bounds().isEmpty());
+}
@@ -7,6 +7,7 @@
 
 #include "SkCanvas.h"
 #include "SkCommandLineFlags.h"
+#include "SkData.h"
 #include "SkGraphics.h"
 #include "SkMakeUnique.h"
 #include "SkOSFile.h"
@@ -30,6 +31,8 @@ DEFINE_double(fps, 30, "Decode frames per second.");
 DEFINE_int32(width , 800, "Render width.");
 DEFINE_int32(height, 600, "Render height.");
 
+DEFINE_int32(threads, 0, "Number of rendering threads (0 -> one per core).");
+
 namespace {
 
 class Sink {
@@ -38,7 +41,7 @@ public:
     Sink(const Sink&) = delete;
     Sink& operator=(const Sink&) = delete;
 
-    bool handleFrame(const sk_sp<skottie::Animation>& anim, size_t idx) const {
+    bool handleFrame(const skottie::Animation& anim, size_t idx) const {
         const auto frame_file = SkStringPrintf("0%06d.%s", idx, fExtension.c_str());
         SkFILEWStream stream (SkOSPath::Join(FLAGS_writePath[0], frame_file.c_str()).c_str());
 
@@ -54,7 +57,7 @@ public:
 protected:
     Sink(const char* ext) : fExtension(ext) {}
 
-    virtual bool saveFrame(const sk_sp<skottie::Animation>& anim, SkFILEWStream*) const = 0;
+    virtual bool saveFrame(const skottie::Animation& anim, SkFILEWStream*) const = 0;
 
 private:
     const SkString fExtension;
@@ -62,28 +65,25 @@ private:
 
 class PNGSink final : public Sink {
 public:
-    PNGSink()
-        : INHERITED("png")
-        , fSurface(SkSurface::MakeRasterN32Premul(FLAGS_width, FLAGS_height)) {
-        if (!fSurface) {
+    PNGSink() : INHERITED("png") {}
+
+    // Frames are rendered concurrently, so each one gets its own surface.
+    bool saveFrame(const skottie::Animation& anim, SkFILEWStream* stream) const override {
+        auto surface = SkSurface::MakeRasterN32Premul(FLAGS_width, FLAGS_height);
+        if (!surface) {
             SkDebugf("Could not allocate a %d x %d surface.\n", FLAGS_width, FLAGS_height);
+            return false;
         }
-    }
-
-    bool saveFrame(const sk_sp<skottie::Animation>& anim, SkFILEWStream* stream) const override {
-        if (!fSurface) return false;
 
-        auto* canvas = fSurface->getCanvas();
-        SkAutoCanvasRestore acr(canvas, true);
-
-        canvas->concat(SkMatrix::MakeRectToRect(SkRect::MakeSize(anim->size()),
+        auto* canvas = surface->getCanvas();
+        canvas->concat(SkMatrix::MakeRectToRect(SkRect::MakeSize(anim.size()),
                                                 SkRect::MakeIWH(FLAGS_width, FLAGS_height),
                                                 SkMatrix::kCenter_ScaleToFit));
 
         canvas->clear(SK_ColorTRANSPARENT);
-        anim->render(canvas);
+        anim.render(canvas);
 
-        auto png_data = fSurface->makeImageSnapshot()->encodeToData();
+        auto png_data = surface->makeImageSnapshot()->encodeToData();
         if (!png_data) {
             SkDebugf("Failed to encode frame!\n");
             return false;
@@ -93,8 +93,6 @@ public:
     }
 
 private:
-    const sk_sp<SkSurface> fSurface;
-
     using INHERITED = Sink;
 };
 
@@ -102,14 +100,14 @@ class SKPSink final : public Sink {
 public:
     SKPSink() : INHERITED("skp") {}
 
-    bool saveFrame(const sk_sp<skottie::Animation>& anim, SkFILEWStream* stream) const override {
+    bool saveFrame(const skottie::Animation& anim, SkFILEWStream* stream) const override {
         SkPictureRecorder recorder;
 
         auto canvas = recorder.beginRecording(FLAGS_width, FLAGS_height);
-        canvas->concat(SkMatrix::MakeRectToRect(SkRect::MakeSize(anim->size()),
+        canvas->concat(SkMatrix::MakeRectToRect(SkRect::MakeSize(anim.size()),
                                                 SkRect::MakeIWH(FLAGS_width, FLAGS_height),
                                                 SkMatrix::kCenter_ScaleToFit));
-        anim->render(canvas);
+        anim.render(canvas);
         recorder.finishRecordingAsPicture()->serialize(stream);
 
         return true;
@@ -186,12 +184,12 @@ int main(int argc, char** argv) {
 
     auto logger = sk_make_sp<Logger>();
 
-    auto anim = skottie::Animation::Builder()
-            .setLogger(logger)
-            .setResourceProvider(
-                skottie_utils::FileResourceProvider::Make(SkOSPath::Dirname(FLAGS_input[0])))
-            .makeFromFile(FLAGS_input[0]);
-    if (!anim) {
+    auto renderer = skottie_utils::FrameRenderer::Make(
+            SkData::MakeFromFileName(FLAGS_input[0]),
+            skottie_utils::FileResourceProvider::Make(SkOSPath::Dirname(FLAGS_input[0])),
+            nullptr,
+            logger);
+    if (!renderer) {
         SkDebugf("Could not load animation: '%s'.\n", FLAGS_input[0]);
         return 1;
     }
@@ -201,13 +199,13 @@ int main(int argc, char** argv) {
     static constexpr double kMaxFrames = 10000;
     const auto t0 = SkTPin(FLAGS_t0, 0.0, 1.0),
                t1 = SkTPin(FLAGS_t1,  t0, 1.0),
-               advance = 1 / std::min(anim->duration() * FLAGS_fps, kMaxFrames);
+               advance = 1 / std::min(renderer->animation()->duration() * FLAGS_fps, kMaxFrames);
+    const auto frame_count = static_cast<size_t>((t1 - t0) / advance) + 1;
 
-    size_t frame_index = 0;
-    for (auto t = t0; t <= t1; t += advance) {
-        anim->seek(t);
-        sink->handleFrame(anim, frame_index++);
-    }
+    renderer->renderFrames(t0, t0 + advance * (frame_count - 1), frame_count, FLAGS_threads,
+                           [&](size_t index, const skottie::Animation& anim) {
+        sink->handleFrame(anim, index);
+    });
 
     return 0;
 }
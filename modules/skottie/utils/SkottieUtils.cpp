@@ -10,10 +10,18 @@
 #include "SkAnimCodecPlayer.h"
 #include "SkData.h"
 #include "SkCodec.h"
+#include "SkExecutor.h"
+#include "SkFontMgr.h"
 #include "SkImage.h"
+#include "SkJSON.h"
 #include "SkMakeUnique.h"
+#include "SkMutex.h"
 #include "SkOSFile.h"
 #include "SkOSPath.h"
+#include "SkTaskGroup.h"
+
+#include <algorithm>
+#include <thread>
 
 namespace skottie_utils {
 
@@ -60,6 +68,158 @@ sk_sp<skottie::ImageAsset> FileResourceProvider::loadImageAsset(const char resou
     return MultiFrameImageAsset::Make(this->load(resource_path, resource_name));
 }
 
+namespace {
+
+class StaticImageAsset final : public skottie::ImageAsset {
+public:
+    explicit StaticImageAsset(sk_sp<SkImage> image) : fImage(std::move(image)) {}
+
+    bool isMultiFrame() override { return false; }
+
+    sk_sp<SkImage> getFrame(float) override { return fImage; }
+
+private:
+    const sk_sp<SkImage> fImage;
+};
+
+} // namespace
+
+// Shares resources between the FrameRenderer instances.  Calls into the wrapped provider are
+// serialized, as ResourceProviders are not required to be thread safe.
+class FrameRenderer::CachingResourceProvider final : public skottie::ResourceProvider {
+public:
+    explicit CachingResourceProvider(sk_sp<skottie::ResourceProvider> proxy)
+        : fProxy(std::move(proxy)) {}
+
+    sk_sp<SkData> load(const char resource_path[], const char resource_name[]) const override {
+        const auto key = SkOSPath::Join(resource_path, resource_name);
+
+        SkAutoMutexAcquire lock(fMutex);
+        if (const auto* data = fData.find(key)) {
+            return *data;
+        }
+        return *fData.set(key, fProxy ? fProxy->load(resource_path, resource_name) : nullptr);
+    }
+
+    sk_sp<skottie::ImageAsset> loadImageAsset(const char resource_path[],
+                                              const char resource_name[]) const override {
+        if (!fProxy) {
+            return nullptr;
+        }
+
+        const auto key = SkOSPath::Join(resource_path, resource_name);
+
+        SkAutoMutexAcquire lock(fMutex);
+        if (const auto* asset = fImages.find(key)) {
+            return *asset;
+        }
+
+        // Multi-frame assets are stateful (and typically not thread safe), so each instance
+        // gets its own.  Static ones are decoded once and shared.
+        auto asset = fProxy->loadImageAsset(resource_path, resource_name);
+        if (asset && !asset->isMultiFrame()) {
+            asset = sk_make_sp<StaticImageAsset>(asset->getFrame(0));
+            fImages.set(key, asset);
+        }
+        return asset;
+    }
+
+    sk_sp<SkData> loadFont(const char name[], const char url[]) const override {
+        const auto key = SkOSPath::Join(name, url);
+
+        SkAutoMutexAcquire lock(fMutex);
+        if (const auto* data = fFonts.find(key)) {
+            return *data;
+        }
+        return *fFonts.set(key, fProxy ? fProxy->loadFont(name, url) : nullptr);
+    }
+
+private:
+    const sk_sp<skottie::ResourceProvider> fProxy;
+
+    mutable SkMutex                                              fMutex;
+    mutable SkTHashMap<SkString, sk_sp<SkData>>                  fData,
+                                                                 fFonts;
+    mutable SkTHashMap<SkString, sk_sp<skottie::ImageAsset>>     fImages;
+};
+
+std::unique_ptr<FrameRenderer> FrameRenderer::Make(sk_sp<SkData> json,
+                                                   sk_sp<skottie::ResourceProvider> rp,
+                                                   sk_sp<SkFontMgr> fontmgr,
+                                                   sk_sp<skottie::Logger> logger) {
+    if (!json) {
+        return nullptr;
+    }
+
+    auto dom = skstd::make_unique<skjson::DOM>(static_cast<const char*>(json->data()),
+                                               json->size());
+    if (!dom->root().is<skjson::ObjectValue>()) {
+        if (logger) {
+            logger->log(skottie::Logger::Level::kError, "Failed to parse JSON input.\n");
+        }
+        return nullptr;
+    }
+
+    std::unique_ptr<FrameRenderer> renderer(
+            new FrameRenderer(std::move(json), std::move(dom),
+                              sk_make_sp<CachingResourceProvider>(std::move(rp)),
+                              std::move(fontmgr)));
+
+    renderer->fAnimation = renderer->makeInstance(std::move(logger));
+
+    return renderer->fAnimation ? std::move(renderer) : nullptr;
+}
+
+FrameRenderer::FrameRenderer(sk_sp<SkData> data, std::unique_ptr<skjson::DOM> dom,
+                             sk_sp<CachingResourceProvider> rp, sk_sp<SkFontMgr> fontmgr)
+    : fData(std::move(data))
+    , fDOM(std::move(dom))
+    , fResourceProvider(std::move(rp))
+    , fFontMgr(std::move(fontmgr)) {}
+
+FrameRenderer::~FrameRenderer() = default;
+
+sk_sp<skottie::Animation> FrameRenderer::makeInstance(sk_sp<skottie::Logger> logger) const {
+    return skottie::Animation::Builder()
+            .setResourceProvider(fResourceProvider)
+            .setFontManager(fFontMgr)
+            .setLogger(std::move(logger))
+            .make(fDOM->root().as<skjson::ObjectValue>());
+}
+
+void FrameRenderer::renderFrames(float t0, float t1, size_t count, int threads,
+                                 const FrameProc& proc) const {
+    if (!count) {
+        return;
+    }
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(threads);
+
+    // A few runs per thread keeps the load balanced when frame complexity varies over time.
+    static constexpr size_t kRunsPerThread = 4;
+    const auto thread_count = threads > 0 ? static_cast<size_t>(threads)
+                                          : std::max<size_t>(1, std::thread::hardware_concurrency());
+    const auto runs     = std::min(count, thread_count * kRunsPerThread),
+               run_size = (count + runs - 1) / runs;
+    const auto dt       = count > 1 ? (t1 - t0) / (count - 1) : 0.0f;
+
+    SkTaskGroup tg(*executor);
+    tg.batch(SkToInt((count + run_size - 1) / run_size), [&](int run) {
+        auto anim = this->makeInstance(nullptr);
+        if (!anim) {
+            return;
+        }
+
+        const auto begin = run * run_size,
+                   end   = std::min(begin + run_size, count);
+        for (auto i = begin; i < end; ++i) {
+            anim->seek(t0 + dt * i);
+            proc(i, *anim);
+        }
+    });
+    tg.wait();
+}
+
 class CustomPropertyManager::PropertyInterceptor final : public skottie::PropertyObserver {
 public:
     explicit PropertyInterceptor(CustomPropertyManager* mgr) : fMgr(mgr) {}
@@ -14,6 +14,7 @@
 #include "SkString.h"
 #include "SkTHash.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -21,8 +22,11 @@
 
 class SkAnimCodecPlayer;
 class SkData;
+class SkFontMgr;
 class SkImage;
 
+namespace skjson { class DOM; }
+
 namespace skottie_utils {
 
 class MultiFrameImageAsset final : public skottie::ImageAsset {
@@ -136,6 +140,53 @@ private:
     std::vector<MarkerInfo>                   fMarkers;
 };
 
+/**
+ * FrameRenderer renders ranges of animation frames concurrently.
+ *
+ * Animation::seek() mutates the scene graph, so an Animation cannot be shared between threads.
+ * Instead, the JSON is parsed once and each worker instantiates its own Animation from the shared
+ * (read-only) DOM.  External resources are fetched through an internal cache, so that encoded
+ * data, fonts and static images are loaded and decoded once, and shared by all instances.
+ *
+ * Property and marker observers are not supported: intercepted handles would only ever affect
+ * one of the worker instances.
+ */
+class FrameRenderer final {
+public:
+    static std::unique_ptr<FrameRenderer> Make(sk_sp<SkData> json,
+                                               sk_sp<skottie::ResourceProvider> = nullptr,
+                                               sk_sp<SkFontMgr> = nullptr,
+                                               sk_sp<skottie::Logger> = nullptr);
+    ~FrameRenderer();
+
+    // The logger (if any) only receives messages for this first, validating instance.
+    const sk_sp<skottie::Animation>& animation() const { return fAnimation; }
+
+    // Invoked once per frame, with the animation already seeked to the frame time.  Calls for
+    // different frames happen concurrently, on different threads, and in no particular order.
+    using FrameProc = std::function<void(size_t index, const skottie::Animation&)>;
+
+    // Renders |count| frames evenly spaced over [t0..t1] (in the Animation::seek() domain) on
+    // up to |threads| worker threads (0 -> one per core).  Each thread renders a contiguous run
+    // of frames, to keep the scene graph revalidation incremental.  Blocks until all frames
+    // have been processed.
+    void renderFrames(float t0, float t1, size_t count, int threads, const FrameProc&) const;
+
+private:
+    class CachingResourceProvider;
+
+    FrameRenderer(sk_sp<SkData>, std::unique_ptr<skjson::DOM>, sk_sp<CachingResourceProvider>,
+                  sk_sp<SkFontMgr>);
+
+    sk_sp<skottie::Animation> makeInstance(sk_sp<skottie::Logger>) const;
+
+    const sk_sp<SkData>                  fData;
+    const std::unique_ptr<skjson::DOM>   fDOM;
+    const sk_sp<CachingResourceProvider> fResourceProvider;
+    const sk_sp<SkFontMgr>               fFontMgr;
+    sk_sp<skottie::Animation>            fAnimation;
+};
+
 } // namespace skottie_utils
 
 #endif // SkottieUtils_DEFINED
@@ -12,10 +12,16 @@
 
 #include <vector>
 
+class SkPicture;
+
 namespace sksg {
 
 /**
  * Concrete node, grouping together multiple descendants.
+ *
+ * Groups which render unchanged (no revalidation, same render context) for a few consecutive
+ * frames are recorded into a picture and replayed from it, until the next revalidation.  The
+ * memory held by these caches is capped by a global budget.
  */
 class Group : public RenderNode {
 public:
@@ -44,8 +50,17 @@ protected:
     SkRect onRevalidate(InvalidationController*, const SkMatrix&) override;
 
 private:
+    void renderChildren(SkCanvas*, const RenderContext*) const;
+    void purgeCache() const;
+
     std::vector<sk_sp<RenderNode>> fChildren;
 
+    // Static content cache.
+    mutable sk_sp<SkPicture>       fCachedPicture;
+    mutable RenderContext          fCachedContext;
+    mutable size_t                 fCachedBytes   = 0;
+    mutable int                    fStableRenders = 0;
+
     typedef RenderNode INHERITED;
 };
 
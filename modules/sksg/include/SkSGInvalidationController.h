@@ -29,6 +29,9 @@ public:
 
     void inval(const SkRect&, const SkMatrix& ctm = SkMatrix::I());
 
+    // Discards all accumulated damage, for reuse across frames.
+    void reset();
+
     const SkRect& bounds() const { return fBounds;        }
     const SkRect*  begin() const { return fRects.begin(); }
     const SkRect*    end() const { return fRects.end();   }
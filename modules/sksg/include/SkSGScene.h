@@ -19,6 +19,7 @@ struct SkPoint;
 
 namespace sksg {
 
+class InvalidationController;
 class RenderNode;
 
 /**
@@ -67,7 +68,12 @@ public:
     Scene& operator=(const Scene&) = delete;
 
     void render(SkCanvas*) const;
-    void animate(float t);
+
+    // Ticks all animators.  When an InvalidationController is provided, the scene is also
+    // revalidated and the resulting damage (in scene coordinates) is accumulated into it:
+    // clients can then restrict rendering to the damaged area, as nodes which fall entirely
+    // outside the canvas clip are skipped.
+    void animate(float t, InvalidationController* ic = nullptr);
     const RenderNode* nodeAt(const SkPoint&) const;
 
     void setShowInval(bool show) { fShowInval = show; }
@@ -66,6 +66,8 @@ private:
     SkFontHinting           fHinting  = kNormal_SkFontHinting;
 
     sk_sp<SkTextBlob> fBlob; // cached text blob
+    SkFont            fBlobFont; // the font and text fBlob was built from, so that changes which
+    SkString          fBlobText; // don't affect the blob (position, alignment) can reuse it
 
     using INHERITED = GeometryNode;
 };
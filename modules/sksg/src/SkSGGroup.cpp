@@ -7,10 +7,27 @@
 
 #include "SkSGGroup.h"
 
+#include "SkCanvas.h"
+#include "SkPicture.h"
+#include "SkPictureRecorder.h"
+
 #include <algorithm>
+#include <atomic>
 
 namespace sksg {
 
+namespace {
+
+// Number of consecutive renders without revalidation before a group gets cached.
+static constexpr int    kCacheRenderThreshold = 3;
+
+// Upper bound for the memory held by all group caches.
+static constexpr size_t kCacheBudget = 16 * 1024 * 1024;
+
+static std::atomic<size_t> gCacheBytes{0};
+
+} // namespace
+
 Group::Group(std::vector<sk_sp<RenderNode>> children)
     : fChildren(std::move(children)) {
     for (const auto& child : fChildren) {
@@ -22,6 +39,17 @@ Group::~Group() {
     for (const auto& child : fChildren) {
         this->unobserveInval(child);
     }
+    this->purgeCache();
+}
+
+void Group::purgeCache() const {
+    if (fCachedPicture) {
+        SkASSERT(gCacheBytes >= fCachedBytes);
+        gCacheBytes -= fCachedBytes;
+        fCachedPicture.reset();
+        fCachedBytes = 0;
+    }
+    fStableRenders = 0;
 }
 
 void Group::clear() {
@@ -55,6 +83,44 @@ void Group::removeChild(const sk_sp<RenderNode>& node) {
 }
 
 void Group::onRender(SkCanvas* canvas, const RenderContext* ctx) const {
+    // The cached content bakes in the render context, so it is only valid for the same context.
+    const RenderContext render_ctx = ctx ? *ctx : RenderContext();
+    if (render_ctx.fOpacity     != fCachedContext.fOpacity     ||
+        render_ctx.fColorFilter != fCachedContext.fColorFilter ||
+        render_ctx.fBlendMode   != fCachedContext.fBlendMode) {
+        this->purgeCache();
+        fCachedContext = render_ctx;
+    }
+
+    if (!fCachedPicture && ++fStableRenders > kCacheRenderThreshold &&
+        gCacheBytes < kCacheBudget) {
+        SkPictureRecorder recorder;
+        this->renderChildren(recorder.beginRecording(this->bounds()), ctx);
+        auto picture = recorder.finishRecordingAsPicture();
+        const auto bytes = picture->approximateBytesUsed();
+
+        if (gCacheBytes.fetch_add(bytes) + bytes <= kCacheBudget) {
+            fCachedPicture = picture;
+            fCachedBytes   = bytes;
+        } else {
+            // Over budget: use the recording for this frame only, and retry later.
+            gCacheBytes -= bytes;
+            fStableRenders = 0;
+        }
+
+        canvas->drawPicture(picture);
+        return;
+    }
+
+    if (fCachedPicture) {
+        canvas->drawPicture(fCachedPicture);
+        return;
+    }
+
+    this->renderChildren(canvas, ctx);
+}
+
+void Group::renderChildren(SkCanvas* canvas, const RenderContext* ctx) const {
     // TODO: this heuristic works at the moment, but:
     //   a) it is fragile because it relies on all leaf render nodes being atomic draws
     //   b) could be improved by e.g. detecting all leaf render draws are non-overlapping
@@ -79,6 +145,8 @@ const RenderNode* Group::onNodeAt(const SkPoint& p) const {
 SkRect Group::onRevalidate(InvalidationController* ic, const SkMatrix& ctm) {
     SkASSERT(this->hasInval());
 
+    this->purgeCache();
+
     SkRect bounds = SkRect::MakeEmpty();
 
     for (const auto& child : fChildren) {
@@ -17,7 +17,9 @@ RenderNode::RenderNode(uint32_t inval_traits) : INHERITED(inval_traits) {}
 
 void RenderNode::render(SkCanvas* canvas, const RenderContext* ctx) const {
     SkASSERT(!this->hasInval());
-    if (!this->bounds().isEmpty()) {
+    // Bounds are conservative, so anything outside the clip (e.g. a partial repaint of the
+    // damaged area) can be skipped wholesale.
+    if (!this->bounds().isEmpty() && !canvas->quickReject(this->bounds())) {
         this->onRender(canvas, ctx);
     }
 }
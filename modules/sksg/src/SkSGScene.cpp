@@ -63,10 +63,14 @@ void Scene::render(SkCanvas* canvas) const {
     }
 }
 
-void Scene::animate(float t) {
+void Scene::animate(float t, InvalidationController* ic) {
     for (const auto& anim : fAnimators) {
         anim->tick(t);
     }
+
+    if (ic) {
+        fRoot->revalidate(ic, SkMatrix::I());
+    }
 }
 
 const RenderNode* Scene::nodeAt(const SkPoint& p) const {
@@ -43,8 +43,6 @@ SkPoint Text::alignedPosition(SkScalar advance) const {
 }
 
 SkRect Text::onRevalidate(InvalidationController*, const SkMatrix&) {
-    // TODO: we could potentially track invals which don't require rebuilding the blob.
-
     SkFont font;
     font.setTypeface(fTypeface);
     font.setSize(fSize);
@@ -57,7 +55,12 @@ SkRect Text::onRevalidate(InvalidationController*, const SkMatrix&) {
     //  1) SkTextBlob has some trouble computing accurate bounds with alignment.
     //  2) SkPaint::Align is slated for deprecation.
 
-    fBlob = SkTextBlob::MakeFromText(fText.c_str(), fText.size(), font, kUTF8_SkTextEncoding);
+    if (!fBlob || !(font == fBlobFont) || !fText.equals(fBlobText)) {
+        fBlob = SkTextBlob::MakeFromText(fText.c_str(), fText.size(), font,
+                                         kUTF8_SkTextEncoding);
+        fBlobFont = font;
+        fBlobText = fText;
+    }
     if (!fBlob) {
         return SkRect::MakeEmpty();
     }
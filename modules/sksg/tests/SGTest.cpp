@@ -9,6 +9,7 @@
 
 #if !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "SkNoDrawCanvas.h"
 #include "SkRect.h"
 #include "SkRectPriv.h"
 #include "SkSGColor.h"
@@ -17,6 +18,7 @@
 #include "SkSGInvalidationController.h"
 #include "SkSGRect.h"
 #include "SkSGRenderEffect.h"
+#include "SkSGScene.h"
 #include "SkSGTransform.h"
 #include "SkTo.h"
 
@@ -346,4 +348,48 @@ DEF_TEST(SGInvalidation, reporter) {
     inval_group_remove(reporter);
 }
 
+DEF_TEST(SGGroupCache, reporter) {
+    class CountingCanvas final : public SkNoDrawCanvas {
+    public:
+        CountingCanvas() : INHERITED(500, 500) {}
+
+        int fRects    = 0,
+            fPictures = 0;
+
+    protected:
+        void onDrawRect(const SkRect&, const SkPaint&) override { fRects++; }
+        void onDrawPicture(const SkPicture*, const SkMatrix*, const SkPaint*) override {
+            fPictures++;
+        }
+
+    private:
+        using INHERITED = SkNoDrawCanvas;
+    };
+
+    auto color = sksg::Color::Make(SK_ColorBLACK);
+    auto grp   = sksg::Group::Make();
+    grp->addChild(sksg::Draw::Make(sksg::Rect::Make(SkRect::MakeWH(100, 100)), color));
+    grp->addChild(sksg::Draw::Make(sksg::Rect::Make(SkRect::MakeXYWH(200, 0, 100, 100)), color));
+
+    auto scene = sksg::Scene::Make(grp, sksg::AnimatorList());
+
+    const auto check_render = [&](int expected_rects, int expected_pictures) {
+        CountingCanvas canvas;
+        scene->render(&canvas);
+        REPORTER_ASSERT(reporter, canvas.fRects    == expected_rects);
+        REPORTER_ASSERT(reporter, canvas.fPictures == expected_pictures);
+    };
+
+    // The first few frames are rendered directly, then the (unchanged) group gets cached.
+    check_render(2, 0);
+    check_render(2, 0);
+    check_render(2, 0);
+    check_render(0, 1);
+    check_render(0, 1);
+
+    // Invalidation purges the cache.
+    color->setColor(SK_ColorRED);
+    check_render(2, 0);
+}
+
 #endif // !defined(SK_BUILD_FOR_GOOGLE3)
@@ -8,6 +8,7 @@
 #ifndef SkShaper_DEFINED
 #define SkShaper_DEFINED
 
+#include <functional>
 #include <memory>
 
 #include "SkPoint.h"
@@ -15,6 +16,7 @@
 #include "SkTextBlob.h"
 #include "SkTypeface.h"
 
+class SkExecutor;
 class SkFont;
 
 /**
@@ -32,6 +34,14 @@ public:
 
     static std::unique_ptr<SkShaper> Make();
 
+    /** Returns a shaper that remembers what 'shaper' produced for recently shaped text, and
+        replays it for later calls with the same text, font, direction and width instead of
+        shaping again. Results are dropped least recently used first to keep them under
+        'byteBudget'. The returned shaper may be used from several threads at once.
+     */
+    static std::unique_ptr<SkShaper> MakeCaching(std::unique_ptr<SkShaper> shaper,
+                                                 size_t byteBudget);
+
     SkShaper();
     virtual ~SkShaper();
 
@@ -70,6 +80,27 @@ public:
                           SkPoint point,
                           SkScalar width) const = 0;
 
+    struct Paragraph {
+        const char* fUtf8Text;
+        size_t      fTextBytes;
+        bool        fLeftToRight;
+    };
+
+    /** Shapes 'paragraphs' concurrently on 'executor' and reports them to 'handler' in order, as
+        if shape() had been called for each in turn, starting at 'point' and then wherever the
+        previous one ended. Each task shapes with its own shaper from 'makeShaper', so shapers
+        that keep state between calls are never shared across threads. Returns the end point of
+        the last paragraph.
+     */
+    static SkPoint ShapeParagraphs(SkExecutor& executor,
+                                   const std::function<std::unique_ptr<SkShaper>()>& makeShaper,
+                                   RunHandler* handler,
+                                   const SkFont& font,
+                                   const Paragraph paragraphs[],
+                                   int count,
+                                   SkPoint point,
+                                   SkScalar width);
+
 private:
     SkShaper(const SkShaper&) = delete;
     SkShaper& operator=(const SkShaper&) = delete;
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkShapedText.h"
+#include "SkSpan.h"
+#include "SkTo.h"
+
+namespace {
+
+class RecordingRunHandler final : public SkShaper::RunHandler {
+public:
+    RecordingRunHandler(const char* utf8Text, SkShapedText* shaped)
+        : fUtf8Text(utf8Text), fShaped(shaped) {}
+
+    Buffer newRunBuffer(const RunInfo& info, const SkFont& font, int glyphCount,
+                        SkSpan<const char> utf8) override {
+        fShaped->fRuns.emplace_back();
+        SkShapedText::Run& run = fShaped->fRuns.back();
+        run.fInfo = info;
+        run.fFont = font;
+        run.fUtf8Offset = utf8.data() - fUtf8Text;
+        run.fUtf8Size = utf8.size();
+        run.fGlyphs.resize(glyphCount);
+        run.fPositions.resize(glyphCount);
+        run.fClusters.resize(glyphCount);
+        return { run.fGlyphs.data(), run.fPositions.data(), run.fClusters.data() };
+    }
+
+    void commitRun() override {}
+
+    void commitLine() override {
+        if (fShaped->fRuns.empty()) {
+            fShaped->fLinesBefore++;
+        } else {
+            fShaped->fRuns.back().fLinesAfter++;
+        }
+    }
+
+private:
+    const char* fUtf8Text;
+    SkShapedText* fShaped;
+};
+
+}  // namespace
+
+sk_sp<SkShapedText> SkShapedText::Make(const SkShaper& shaper, const SkFont& font,
+                                       const char* utf8text, size_t textBytes, bool leftToRight,
+                                       SkScalar width) {
+    sk_sp<SkShapedText> shaped(new SkShapedText);
+    RecordingRunHandler recorder(utf8text, shaped.get());
+    shaped->fEnd = shaper.shape(&recorder, font, utf8text, textBytes, leftToRight, {0, 0}, width);
+    return shaped;
+}
+
+SkPoint SkShapedText::replay(SkShaper::RunHandler* handler, const char* utf8text,
+                             SkPoint point) const {
+    for (int i = 0; i < fLinesBefore; ++i) {
+        handler->commitLine();
+    }
+    for (const Run& run : fRuns) {
+        int glyphCount = SkToInt(run.fGlyphs.size());
+        const auto buffer = handler->newRunBuffer(
+                run.fInfo, run.fFont, glyphCount,
+                SkSpan<const char>(utf8text + run.fUtf8Offset, run.fUtf8Size));
+        memcpy(buffer.glyphs, run.fGlyphs.data(), glyphCount * sizeof(SkGlyphID));
+        for (int i = 0; i < glyphCount; ++i) {
+            buffer.positions[i] = run.fPositions[i] + point;
+        }
+        if (buffer.clusters) {
+            memcpy(buffer.clusters, run.fClusters.data(), glyphCount * sizeof(uint32_t));
+        }
+        handler->commitRun();
+        for (int i = 0; i < run.fLinesAfter; ++i) {
+            handler->commitLine();
+        }
+    }
+    return fEnd + point;
+}
+
+size_t SkShapedText::bytesUsed() const {
+    size_t bytes = sizeof(SkShapedText) + fRuns.size() * sizeof(Run);
+    for (const Run& run : fRuns) {
+        bytes += run.fGlyphs.size() * (sizeof(SkGlyphID) + sizeof(SkPoint) + sizeof(uint32_t));
+    }
+    return bytes;
+}
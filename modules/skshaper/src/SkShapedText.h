@@ -0,0 +1,50 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkShapedText_DEFINED
+#define SkShapedText_DEFINED
+
+#include "SkFont.h"
+#include "SkRefCnt.h"
+#include "SkShaper.h"
+
+#include <vector>
+
+/**
+ * Everything a RunHandler was told while shaping one piece of text, with positions relative to
+ * the starting point and utf8 ranges relative to the start of the text, so it can be reported
+ * again later for the same text somewhere else.
+ */
+struct SkShapedText : public SkNVRefCnt<SkShapedText> {
+    struct Run {
+        SkShaper::RunHandler::RunInfo fInfo;
+        SkFont fFont;
+        size_t fUtf8Offset;
+        size_t fUtf8Size;
+        std::vector<SkGlyphID> fGlyphs;
+        std::vector<SkPoint> fPositions;
+        std::vector<uint32_t> fClusters;
+        int fLinesAfter = 0;
+    };
+
+    // Shapes the text at the origin with 'shaper' and records the result.
+    static sk_sp<SkShapedText> Make(const SkShaper& shaper, const SkFont& font,
+                                    const char* utf8text, size_t textBytes, bool leftToRight,
+                                    SkScalar width);
+
+    // Reports the recorded runs and lines to 'handler' as if 'utf8text' had been shaped at
+    // 'point'. Returns the point 'shaper' returned, offset the same way.
+    SkPoint replay(SkShaper::RunHandler* handler, const char* utf8text, SkPoint point) const;
+
+    size_t bytesUsed() const;
+
+    int fLinesBefore = 0;
+    std::vector<Run> fRuns;
+    SkPoint fEnd = {0, 0};
+};
+
+#endif  // SkShapedText_DEFINED
@@ -5,10 +5,15 @@
  * found in the LICENSE file.
  */
 
+#include "SkMutex.h"
+#include "SkShapedText.h"
 #include "SkShaper.h"
 #include "SkSpan.h"
+#include "SkTaskGroup.h"
 #include "SkTextBlobPriv.h"
 
+#include <vector>
+
 std::unique_ptr<SkShaper> SkShaper::Make() {
 #ifdef SK_SHAPER_HARFBUZZ_AVAILABLE
     std::unique_ptr<SkShaper> shaper = SkShaper::MakeHarfBuzz();
@@ -22,6 +27,48 @@ std::unique_ptr<SkShaper> SkShaper::Make() {
 SkShaper::SkShaper() {}
 SkShaper::~SkShaper() {}
 
+SkPoint SkShaper::ShapeParagraphs(SkExecutor& executor,
+                                  const std::function<std::unique_ptr<SkShaper>()>& makeShaper,
+                                  RunHandler* handler,
+                                  const SkFont& font,
+                                  const Paragraph paragraphs[],
+                                  int count,
+                                  SkPoint point,
+                                  SkScalar width) {
+    std::unique_ptr<sk_sp<SkShapedText>[]> shaped(new sk_sp<SkShapedText>[count]);
+
+    // Shapers go back here when a task is done with them, for the next task to reuse.
+    SkMutex idleMutex;
+    std::vector<std::unique_ptr<SkShaper>> idle;
+
+    SkTaskGroup tasks(executor);
+    tasks.batch(count, [&](int i) {
+        std::unique_ptr<SkShaper> shaper;
+        {
+            SkAutoMutexAcquire lock(idleMutex);
+            if (!idle.empty()) {
+                shaper = std::move(idle.back());
+                idle.pop_back();
+            }
+        }
+        if (!shaper) {
+            shaper = makeShaper();
+        }
+        const Paragraph& paragraph = paragraphs[i];
+        shaped[i] = SkShapedText::Make(*shaper, font, paragraph.fUtf8Text, paragraph.fTextBytes,
+                                       paragraph.fLeftToRight, width);
+
+        SkAutoMutexAcquire lock(idleMutex);
+        idle.push_back(std::move(shaper));
+    });
+    tasks.wait();
+
+    for (int i = 0; i < count; ++i) {
+        point = shaped[i]->replay(handler, paragraphs[i].fUtf8Text, point);
+    }
+    return point;
+}
+
 SkShaper::RunHandler::Buffer SkTextBlobBuilderRunHandler::newRunBuffer(const RunInfo&,
                                                                        const SkFont& font,
                                                                        int glyphCount,
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkChecksum.h"
+#include "SkMakeUnique.h"
+#include "SkMutex.h"
+#include "SkOpts.h"
+#include "SkShapedText.h"
+#include "SkShaper.h"
+#include "SkString.h"
+#include "SkTDynamicHash.h"
+#include "SkTInternalLList.h"
+
+namespace {
+
+struct Key {
+    Key(const SkFont& font, const char* utf8text, size_t textBytes, bool leftToRight,
+        SkScalar width)
+        : fText(utf8text, textBytes)
+        , fFont(font)
+        , fLeftToRight(leftToRight)
+        , fWidth(width) {
+        uint32_t fontID = font.getTypeface() ? font.getTypeface()->uniqueID() : 0;
+        SkScalar fontValues[] = { font.getSize(), font.getScaleX(), font.getSkewX(), width };
+        uint32_t fontBits = (uint32_t)font.isSubpixel()         << 0 |
+                            (uint32_t)font.isLinearMetrics()    << 1 |
+                            (uint32_t)font.isEmbolden()         << 2 |
+                            (uint32_t)font.isEmbeddedBitmaps()  << 3 |
+                            (uint32_t)font.isForceAutoHinting() << 4 |
+                            (uint32_t)font.getEdging()          << 5 |
+                            (uint32_t)font.getHinting()         << 7 |
+                            (uint32_t)leftToRight               << 10;
+        fHash = SkOpts::hash(utf8text, textBytes, fontID);
+        fHash = SkOpts::hash(fontValues, sizeof(fontValues), fHash);
+        fHash = SkChecksum::Mix(fHash ^ fontBits);
+    }
+
+    bool operator==(const Key& that) const {
+        return fHash == that.fHash &&
+               fFont == that.fFont &&
+               fLeftToRight == that.fLeftToRight &&
+               fWidth == that.fWidth &&
+               fText.equals(that.fText);
+    }
+
+    SkString fText;
+    SkFont fFont;
+    bool fLeftToRight;
+    SkScalar fWidth;
+    uint32_t fHash;
+};
+
+struct Entry {
+    Entry(Key&& key, sk_sp<const SkShapedText> shaped)
+        : fKey(std::move(key))
+        , fShaped(std::move(shaped))
+        , fBytes(sizeof(Entry) + fKey.fText.size() + fShaped->bytesUsed()) {}
+
+    static const Key& GetKey(const Entry& entry) { return entry.fKey; }
+    static uint32_t Hash(const Key& key) { return key.fHash; }
+
+    Key fKey;
+    sk_sp<const SkShapedText> fShaped;
+    size_t fBytes;
+
+    SK_DECLARE_INTERNAL_LLIST_INTERFACE(Entry);
+};
+
+class SkShaperCaching : public SkShaper {
+public:
+    SkShaperCaching(std::unique_ptr<SkShaper> shaper, size_t byteBudget)
+        : fShaper(std::move(shaper)), fByteBudget(byteBudget) {}
+
+    ~SkShaperCaching() override {
+        while (Entry* entry = fLRU.head()) {
+            this->remove(entry);
+        }
+    }
+
+private:
+    SkPoint shape(RunHandler* handler,
+                  const SkFont& srcFont,
+                  const char* utf8text,
+                  size_t textBytes,
+                  bool leftToRight,
+                  SkPoint point,
+                  SkScalar width) const override;
+
+    void remove(Entry* entry) const {
+        fUsedBytes -= entry->fBytes;
+        fLRU.remove(entry);
+        fHash.remove(entry->fKey);
+        delete entry;
+    }
+
+    std::unique_ptr<SkShaper> fShaper;
+    const size_t fByteBudget;
+
+    // Guards fShaper, which may keep state between calls to shape().
+    mutable SkMutex fShaperMutex;
+
+    // Guards the cache below. Never held while calling a RunHandler.
+    mutable SkMutex fCacheMutex;
+    mutable SkTDynamicHash<Entry, Key, Entry> fHash;
+    mutable SkTInternalLList<Entry> fLRU;
+    mutable size_t fUsedBytes = 0;
+};
+
+}  // namespace
+
+SkPoint SkShaperCaching::shape(RunHandler* handler,
+                               const SkFont& srcFont,
+                               const char* utf8text,
+                               size_t textBytes,
+                               bool leftToRight,
+                               SkPoint point,
+                               SkScalar width) const {
+    Key key(srcFont, utf8text, textBytes, leftToRight, width);
+    sk_sp<const SkShapedText> shaped;
+    {
+        SkAutoMutexAcquire lock(fCacheMutex);
+        if (Entry* entry = fHash.find(key)) {
+            fLRU.remove(entry);
+            fLRU.addToHead(entry);
+            shaped = entry->fShaped;
+        }
+    }
+
+    if (!shaped) {
+        {
+            SkAutoMutexAcquire lock(fShaperMutex);
+            shaped = SkShapedText::Make(*fShaper, srcFont, utf8text, textBytes, leftToRight,
+                                        width);
+        }
+
+        SkAutoMutexAcquire lock(fCacheMutex);
+        if (!fHash.find(key)) {
+            Entry* entry = new Entry(std::move(key), shaped);
+            fHash.add(entry);
+            fLRU.addToHead(entry);
+            fUsedBytes += entry->fBytes;
+            while (fUsedBytes > fByteBudget) {
+                this->remove(fLRU.tail());
+            }
+        }
+    }
+
+    return shaped->replay(handler, utf8text, point);
+}
+
+std::unique_ptr<SkShaper> SkShaper::MakeCaching(std::unique_ptr<SkShaper> shaper,
+                                                size_t byteBudget) {
+    return skstd::make_unique<SkShaperCaching>(std::move(shaper), byteBudget);
+}
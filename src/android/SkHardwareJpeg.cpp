@@ -0,0 +1,82 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkHardwareJpeg.h"
+#include "SkData.h"
+
+#if defined(SK_BUILD_FOR_ANDROID) && __ANDROID_API__ >= 26 && SK_SUPPORT_GPU && \
+    defined(SK_HAS_JPEG_LIBRARY)
+
+#include "GrAHardwareBufferImageGenerator.h"
+#include "SkCodec.h"
+#include "SkJpegCodec.h"
+
+#include <android/hardware_buffer.h>
+
+#if __has_include("JpegHardwareDecoderAPI.h")
+    #include "JpegHardwareDecoderAPI.h"
+#else
+    #include "SkStubJpegHardwareDecoderAPI.h"
+#endif
+
+std::unique_ptr<SkImageGenerator> SkHardwareJpeg::MakeGenerator(sk_sp<SkData> data) {
+    if (!data || !SkJpegCodec::IsJpeg(data->data(), data->size())) {
+        return nullptr;
+    }
+
+    std::unique_ptr<JpegHardwareDecoder> decoder(createJpegHardwareDecoder());
+    if (!decoder) {
+        return nullptr;
+    }
+
+    // Reading the header is cheap next to the decode, and tells us if the hardware can help.
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+    if (!codec || SkEncodedImageFormat::kJPEG != codec->getEncodedFormat()
+               || kTopLeft_SkEncodedOrigin != codec->getOrigin()
+               || !static_cast<SkJpegCodec*>(codec.get())->isBaselineYCbCr()) {
+        return nullptr;
+    }
+
+    const SkImageInfo& info = codec->getInfo();
+    if (info.width() * (int64_t) info.height() < kMinPixels
+            || !decoder->canDecode(info.width(), info.height())) {
+        return nullptr;
+    }
+
+    AHardwareBuffer_Desc desc;
+    desc.width  = info.width();
+    desc.height = info.height();
+    desc.layers = 1;
+    desc.format = AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM;
+    desc.usage  = AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE | decoder->outputUsage();
+    desc.stride = 0;
+    desc.rfu0   = 0;
+    desc.rfu1   = 0;
+
+    AHardwareBuffer* buffer = nullptr;
+    if (0 != AHardwareBuffer_allocate(&desc, &buffer)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SkImageGenerator> generator;
+    if (decoder->decode(data->data(), data->size(), buffer)) {
+        generator = GrAHardwareBufferImageGenerator::Make(buffer, kOpaque_SkAlphaType,
+                                                          info.refColorSpace(),
+                                                          kTopLeft_GrSurfaceOrigin);
+    }
+    // The generator holds its own reference to the buffer.
+    AHardwareBuffer_release(buffer);
+    return generator;
+}
+
+#else
+
+std::unique_ptr<SkImageGenerator> SkHardwareJpeg::MakeGenerator(sk_sp<SkData>) {
+    return nullptr;
+}
+
+#endif
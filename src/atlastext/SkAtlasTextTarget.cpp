@@ -103,6 +103,11 @@ public:
         SkDebugf("Path glyph??");
     }
 
+    void drawShape(const GrClip&, GrPaint&&, GrAA, const SkMatrix& viewMatrix,
+                   const GrShape&) override {
+        SkDebugf("Path glyph??");
+    }
+
     void makeGrPaint(GrMaskFormat, const SkPaint& skPaint, const SkMatrix&,
                      GrPaint* grPaint) override {
         grPaint->setColor4f(skPaint.getColor4f().premul());
@@ -77,10 +77,10 @@ void SkInternalAtlasTextContext::recordDraw(const void* srcVertexData, int glyph
     memcpy(vertexData, srcVertexData, vertexDataSize);
     for (int i = 0; i < 4 * glyphCnt; ++i) {
         auto* vertex = reinterpret_cast<SkAtlasTextRenderer::SDFVertex*>(vertexData) + i;
-        // GrTextContext encodes a texture index into the lower bit of each texture coord.
+        // GrTextContext encodes a texture index into the lower bits of each texture coord.
         // This isn't expected by SkAtlasTextRenderer subclasses.
-        vertex->fTextureCoordX /= 2;
-        vertex->fTextureCoordY /= 2;
+        vertex->fTextureCoordX = GrDrawOpAtlas::UnpackTexel(vertex->fTextureCoordX);
+        vertex->fTextureCoordY = GrDrawOpAtlas::UnpackTexel(vertex->fTextureCoordY);
         matrix.mapHomogeneousPoints(&vertex->fPosition, &vertex->fPosition, 1);
     }
     fDraws.append(&fArena,
@@ -410,3 +410,73 @@ SkCodec::Result SkAndroidCodec::getAndroidPixels(const SkImageInfo& info, void*
         size_t rowBytes) {
     return this->getAndroidPixels(info, pixels, rowBytes, nullptr);
 }
+
+// Returns the largest sample size that keeps |subset| at least as large as |targetSize|, or 1.
+static int region_sample_size(const SkAndroidCodec* codec, const SkIRect& subset,
+                              const SkISize& targetSize) {
+    int sampleSize = SkTMax(1, SkTMin(subset.width()  / targetSize.width(),
+                                      subset.height() / targetSize.height()));
+    for (; sampleSize > 1; sampleSize--) {
+        // Codecs may round the sampled dimensions either way.
+        const SkISize dims = codec->getSampledSubsetDimensions(sampleSize, subset);
+        if (dims.width() >= targetSize.width() && dims.height() >= targetSize.height()) {
+            break;
+        }
+    }
+    return sampleSize;
+}
+
+SkISize SkAndroidCodec::getRegionDimensions(const SkIRect& subset,
+                                            const SkISize& targetSize) const {
+    SkIRect copySubset = subset;
+    if (!this->getSupportedSubset(&copySubset) || copySubset != subset || targetSize.isEmpty()) {
+        return {0, 0};
+    }
+
+    if (ExifOrientationBehavior::kRespect == fOrientationBehavior
+            && kTopLeft_SkEncodedOrigin != fCodec->getOrigin()) {
+        // getAndroidPixels() knows how to orient the output, so stick to it.
+        return this->SkAndroidCodec::onGetRegionDimensions(subset, targetSize);
+    }
+    return this->onGetRegionDimensions(subset, targetSize);
+}
+
+SkCodec::Result SkAndroidCodec::decodeRegion(const SkImageInfo& info, void* pixels,
+        size_t rowBytes, const SkIRect& subset, SkCodec::ZeroInitialized zeroInit) {
+    if (!pixels) {
+        return SkCodec::kInvalidParameters;
+    }
+    if (rowBytes < info.minRowBytes()) {
+        return SkCodec::kInvalidParameters;
+    }
+    SkIRect copySubset = subset;
+    if (!this->getSupportedSubset(&copySubset) || copySubset != subset || info.isEmpty()) {
+        return SkCodec::kInvalidParameters;
+    }
+
+    if (ExifOrientationBehavior::kRespect == fOrientationBehavior
+            && kTopLeft_SkEncodedOrigin != fCodec->getOrigin()) {
+        return this->SkAndroidCodec::onDecodeRegion(info, pixels, rowBytes, subset, zeroInit);
+    }
+    return this->onDecodeRegion(info, pixels, rowBytes, subset, zeroInit);
+}
+
+SkISize SkAndroidCodec::onGetRegionDimensions(const SkIRect& subset,
+                                              const SkISize& targetSize) const {
+    return this->getSampledSubsetDimensions(region_sample_size(this, subset, targetSize), subset);
+}
+
+SkCodec::Result SkAndroidCodec::onDecodeRegion(const SkImageInfo& info, void* pixels,
+        size_t rowBytes, const SkIRect& subset, SkCodec::ZeroInitialized zeroInit) {
+    const int sampleSize = region_sample_size(this, subset, info.dimensions());
+    if (this->getSampledSubsetDimensions(sampleSize, subset) != info.dimensions()) {
+        return SkCodec::kInvalidScale;
+    }
+
+    SkIRect androidSubset = subset;
+    AndroidOptions options;
+    options.fZeroInitialized = zeroInit;
+    options.fSubset = &androidSubset;
+    options.fSampleSize = sampleSize;
+    return this->getAndroidPixels(info, pixels, rowBytes, &options);
+}
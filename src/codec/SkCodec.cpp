@@ -22,6 +22,7 @@
 #endif
 #include "SkRawCodec.h"
 #include "SkStream.h"
+#include "SkTraceEvent.h"
 #include "SkWbmpCodec.h"
 #include "SkWebpCodec.h"
 #ifdef SK_HAS_WUFFS_LIBRARY
@@ -307,6 +308,7 @@ SkCodec::Result SkCodec::handleFrameIndex(const SkImageInfo& info, void* pixels,
 
 SkCodec::Result SkCodec::getPixels(const SkImageInfo& dstInfo, void* pixels, size_t rowBytes,
                                    const Options* options) {
+    TRACE_EVENT0("skia", TRACE_FUNC);
     SkImageInfo info = dstInfo;
     if (!info.colorSpace()) {
         info = info.makeColorSpace(SkColorSpace::MakeSRGB());
@@ -382,6 +384,7 @@ SkCodec::Result SkCodec::getPixels(const SkImageInfo& dstInfo, void* pixels, siz
 
 SkCodec::Result SkCodec::startIncrementalDecode(const SkImageInfo& dstInfo, void* pixels,
         size_t rowBytes, const SkCodec::Options* options) {
+    TRACE_EVENT0("skia", TRACE_FUNC);
     fStartedIncrementalDecode = false;
 
     SkImageInfo info = dstInfo;
@@ -513,6 +516,7 @@ SkCodec::Result SkCodec::startScanlineDecode(const SkImageInfo& dstInfo,
 }
 
 int SkCodec::getScanlines(void* dst, int countLines, size_t rowBytes) {
+    TRACE_EVENT0("skia", TRACE_FUNC);
     if (fCurrScanline < 0) {
         return 0;
     }
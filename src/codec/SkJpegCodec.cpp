@@ -13,10 +13,14 @@
 #include "SkJpegDecoderMgr.h"
 #include "SkJpegInfo.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkTo.h"
 #include "SkTypes.h"
 
+#include <atomic>
+#include <vector>
+
 // stdio is needed for libjpeg-turbo
 #include <stdio.h>
 #include "SkJpegUtility.h"
@@ -306,6 +310,13 @@ SkJpegCodec::SkJpegCodec(SkEncodedInfo&& info, std::unique_ptr<SkStream> stream,
     , fSwizzleSrcRow(nullptr)
     , fColorXformSrcRow(nullptr)
     , fSwizzlerSubset(SkIRect::MakeEmpty())
+    , fIncrementalDst(nullptr)
+    , fIncrementalRowBytes(0)
+    , fIncrementalRow(0)
+    , fOutputPassesDone(0)
+    , fOutputPassStarted(false)
+    , fFinalOutputPass(false)
+    , fFinalDctMethod(JDCT_ISLOW)
 {}
 
 /*
@@ -369,6 +380,12 @@ SkISize SkJpegCodec::onGetScaledDimensions(float desiredScale) const {
     return SkISize::Make(dinfo.output_width, dinfo.output_height);
 }
 
+bool SkJpegCodec::isBaselineYCbCr() const {
+    const jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    return !dinfo->progressive_mode && !dinfo->arith_code && 8 == dinfo->data_precision &&
+           3 == dinfo->num_components && JCS_YCbCr == dinfo->jpeg_color_space;
+}
+
 bool SkJpegCodec::onRewind() {
     JpegDecoderMgr* decoderMgr = nullptr;
     if (kSuccess != ReadHeader(this->stream(), nullptr, &decoderMgr, nullptr)) {
@@ -493,10 +510,13 @@ bool SkJpegCodec::onDimensionsSupported(const SkISize& size) {
 }
 
 int SkJpegCodec::readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count,
-                          const Options& opts) {
+                          const Options& opts, bool* error) {
     // Set the jump location for libjpeg-turbo errors
     skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
     if (setjmp(jmp)) {
+        if (error) {
+            *error = true;
+        }
         return 0;
     }
 
@@ -569,6 +589,270 @@ static inline bool needs_swizzler_to_convert_from_cmyk(J_COLOR_SPACE jpegColorTy
     return !hasCMYKColorSpace || !hasColorSpaceXform;
 }
 
+/*
+ * Restart stripes.
+ *
+ * A baseline scan resets its DC predictors after every RSTn marker, so the entropy-coded data
+ * from the restart interval that begins one MCU row up to the one that begins a later MCU row
+ * is a complete scan of that band of the image.  Each band is decoded as its own small jpeg:
+ * the original tables and frame header with the height patched to the band's, the band's
+ * entropy-coded data with its restart markers renumbered from RST0, and an EOI.
+ *
+ * Fancy upsampling looks at the chroma rows on either side, so each band is decoded with an
+ * extra group of MCU rows above and below it, which are thrown away.  That makes the result
+ * identical to decoding the whole image at once.
+ */
+namespace {
+
+struct JpegRestartLayout {
+    std::vector<uint8_t> fHeader;         // SOI through SOS, without the larger APPn segments.
+    size_t               fHeightOffset;   // Where the frame height is in fHeader.
+    int                  fComponents;
+    std::vector<size_t>  fIntervalStart;  // Offset in the file of each restart interval.
+    size_t               fScanEnd;        // Offset in the file of the EOI after the scan.
+};
+
+}  // namespace
+
+static size_t read_u16(const uint8_t* data) { return (data[0] << 8) | data[1]; }
+
+static bool find_restart_intervals(const uint8_t* data, size_t size, JpegRestartLayout* layout) {
+    if (size < 4 || 0xFF != data[0] || 0xD8 != data[1]) {
+        return false;
+    }
+    layout->fHeader.assign(data, data + 2);
+
+    bool sawFrame = false;
+    size_t i = 2;
+    for (;;) {
+        while (i + 1 < size && 0xFF == data[i] && 0xFF == data[i + 1]) {
+            i++;  // Fill bytes.
+        }
+        if (i + 4 > size || 0xFF != data[i]) {
+            return false;
+        }
+        const uint8_t marker = data[i + 1];
+        const size_t length = read_u16(data + i + 2);
+        if (length < 2 || length > size - i - 2) {
+            return false;
+        }
+        const uint8_t* segment = data + i;
+        i += 2 + length;
+
+        if (marker >= 0xC0 && marker <= 0xCF && 0xC4 != marker && 0xC8 != marker &&
+                0xCC != marker) {
+            // Only sequential Huffman-coded frames; not progressive, lossless or arithmetic.
+            if (marker > 0xC1 || sawFrame || length < 8) {
+                return false;
+            }
+            sawFrame = true;
+            layout->fHeightOffset = layout->fHeader.size() + 5;
+            layout->fComponents = segment[9];
+        } else if ((marker >= 0xE1 && marker <= 0xED) || 0xEF == marker || 0xFE == marker) {
+            // Exif, ICC and the like, and comments, don't affect the pixels.  APP0 and
+            // APP14 (whose Adobe segment picks the color transform) are kept.
+            continue;
+        }
+        layout->fHeader.insert(layout->fHeader.end(), segment, segment + 2 + length);
+        if (0xDA == marker) {
+            // Every component must be in this one scan.
+            if (!sawFrame || length < 3 || segment[4] != layout->fComponents) {
+                return false;
+            }
+            break;
+        }
+    }
+
+    layout->fIntervalStart.assign(1, i);
+    for (; i + 1 < size; i++) {
+        if (0xFF != data[i]) {
+            continue;
+        }
+        const uint8_t marker = data[i + 1];
+        if (0x00 == marker) {
+            i++;  // A stuffed zero.
+        } else if (0xFF == marker) {
+            // A fill byte; the marker is still to come.
+        } else if (marker >= 0xD0 && marker <= 0xD7) {
+            if (marker - 0xD0 != (int)((layout->fIntervalStart.size() - 1) & 7)) {
+                return false;
+            }
+            layout->fIntervalStart.push_back(i + 2);
+            i++;
+        } else if (0xD9 == marker) {
+            layout->fScanEnd = i;
+            return true;
+        } else {
+            // DNL, or another scan: not something we can cut up.
+            return false;
+        }
+    }
+    return false;
+}
+
+bool SkJpegCodec::decodeRestartStripes(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                                       const Options& options) {
+    SkASSERT(options.fExecutor);
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    if (0 == dinfo->restart_interval || dinfo->progressive_mode || dinfo->arith_code ||
+            dinfo->comps_in_scan != dinfo->num_components) {
+        return false;
+    }
+
+    const uint8_t* data = (const uint8_t*)this->stream()->getMemoryBase();
+    if (!data) {
+        return false;
+    }
+    JpegRestartLayout layout;
+    if (!find_restart_intervals(data, this->stream()->getLength(), &layout) ||
+            layout.fComponents != dinfo->num_components) {
+        return false;
+    }
+
+    {
+        skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
+        if (setjmp(jmp)) {
+            return false;
+        }
+        jpeg_calc_output_dimensions(dinfo);
+    }
+
+    // A lone component's MCU is a single block, whatever its sampling factors.
+    const bool interleaved = dinfo->num_components > 1;
+    const int mcuWidth  = interleaved ? 8 * dinfo->max_h_samp_factor : 8;
+    const int mcuHeight = interleaved ? 8 * dinfo->max_v_samp_factor : 8;
+    if (0 != (mcuHeight * dinfo->scale_num) % dinfo->scale_denom) {
+        return false;
+    }
+    const int outRowsPerMcuRow = mcuHeight * dinfo->scale_num / dinfo->scale_denom;
+    const int imageHeight = (int)dinfo->image_height;
+    const int mcusPerRow = ((int)dinfo->image_width + mcuWidth - 1) / mcuWidth;
+    const int mcuRows = (imageHeight + mcuHeight - 1) / mcuHeight;
+    const int interval = (int)dinfo->restart_interval;
+    const size_t intervals = ((size_t)mcusPerRow * mcuRows + interval - 1) / interval;
+    if (layout.fIntervalStart.size() != intervals) {
+        return false;
+    }
+
+    // Stripes can only start on MCU rows that begin a restart interval, which come every
+    // `period` rows.  Keep stripes at least four periods tall, so the context rows decoded
+    // twice stay a small part of the work.
+    int a = interval, b = mcusPerRow;
+    while (b) {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    const int period = interval / a;
+    constexpr int kMaxStripes = 16;
+    int stripeRows = SkTMax(4 * period, (mcuRows + kMaxStripes - 1) / kMaxStripes);
+    stripeRows = (stripeRows + period - 1) / period * period;
+    const int stripes = (mcuRows + stripeRows - 1) / stripeRows;
+    if (stripes < 2) {
+        return false;
+    }
+
+    if (needs_swizzler_to_convert_from_cmyk(dinfo->out_color_space,
+                                            this->getEncodedInfo().profile(), this->colorXform())) {
+        this->initializeSwizzler(dstInfo, options, true);
+    }
+    const int xformWidth = fSwizzler ? fSwizzler->swizzleWidth() : dstInfo.width();
+    const size_t decodeBytes = get_row_bytes(dinfo);
+    const size_t xformBytes = fSwizzler && this->colorXform() ? xformWidth * sizeof(uint32_t) : 0;
+
+    std::atomic<bool> failed{false};
+    auto decodeStripe = [&](int stripe) {
+        const int firstRow  = stripe * stripeRows;
+        const int endRow    = SkTMin(firstRow + stripeRows, mcuRows);
+        const int decodeFirstRow = SkTMax(0, firstRow - period);
+        const int decodeEndRow   = SkTMin(mcuRows, endRow + period);
+
+        const size_t firstInterval = (size_t)decodeFirstRow * mcusPerRow / interval;
+        const size_t endInterval   = decodeEndRow == mcuRows
+                                   ? intervals : (size_t)decodeEndRow * mcusPerRow / interval;
+        const size_t begin = layout.fIntervalStart[firstInterval];
+        const size_t end   = endInterval < intervals ? layout.fIntervalStart[endInterval] - 2
+                                                     : layout.fScanEnd;
+
+        std::vector<uint8_t> jpeg(layout.fHeader);
+        const size_t headerSize = jpeg.size();
+        const int height = (decodeEndRow == mcuRows ? imageHeight : decodeEndRow * mcuHeight)
+                         - decodeFirstRow * mcuHeight;
+        jpeg[layout.fHeightOffset + 0] = (uint8_t)(height >> 8);
+        jpeg[layout.fHeightOffset + 1] = (uint8_t)(height & 0xFF);
+        jpeg.insert(jpeg.end(), data + begin, data + end);
+        for (size_t i = firstInterval + 1; i < endInterval; i++) {
+            jpeg[headerSize + layout.fIntervalStart[i] - 1 - begin] =
+                    (uint8_t)(0xD0 + ((i - firstInterval - 1) & 7));
+        }
+        jpeg.push_back(0xFF);
+        jpeg.push_back(0xD9);
+
+        SkAutoTMalloc<uint8_t> storage(decodeBytes + xformBytes);
+        JSAMPLE* decodeRow = storage.get();
+        uint32_t* xformRow = SkTAddOffset<uint32_t>(storage.get(), decodeBytes);
+
+        SkMemoryStream stream(jpeg.data(), jpeg.size(), false);
+        JpegDecoderMgr decoderMgr(&stream);
+        skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr.errorMgr());
+        if (setjmp(jmp)) {
+            return false;
+        }
+        decoderMgr.init();
+        jpeg_decompress_struct* sinfo = decoderMgr.dinfo();
+        if (JPEG_HEADER_OK != jpeg_read_header(sinfo, true)) {
+            return false;
+        }
+        sinfo->out_color_space = dinfo->out_color_space;
+        sinfo->dither_mode = dinfo->dither_mode;
+        sinfo->scale_num = dinfo->scale_num;
+        sinfo->scale_denom = dinfo->scale_denom;
+        if (!jpeg_start_decompress(sinfo) || sinfo->output_width != dinfo->output_width ||
+                get_row_bytes(sinfo) != decodeBytes) {
+            return false;
+        }
+
+        const int skipRows = (firstRow - decodeFirstRow) * outRowsPerMcuRow;
+        const int dstFirstRow = firstRow * outRowsPerMcuRow;
+        const int dstEndRow = SkTMin(endRow * outRowsPerMcuRow, (int)dinfo->output_height);
+        if (skipRows + dstEndRow - dstFirstRow > (int)sinfo->output_height) {
+            return false;
+        }
+
+        for (int y = 0; y < skipRows + dstEndRow - dstFirstRow; y++) {
+            if (1 != jpeg_read_scanlines(sinfo, &decodeRow, 1)) {
+                return false;
+            }
+            if (y < skipRows) {
+                continue;
+            }
+            void* dstRow = SkTAddOffset<void>(dst, (dstFirstRow + y - skipRows) * rowBytes);
+            if (fSwizzler) {
+                if (this->colorXform()) {
+                    fSwizzler->swizzle(xformRow, decodeRow);
+                    this->applyColorXform(dstRow, xformRow, xformWidth);
+                } else {
+                    fSwizzler->swizzle(dstRow, decodeRow);
+                }
+            } else if (this->colorXform()) {
+                this->applyColorXform(dstRow, decodeRow, xformWidth);
+            } else {
+                memcpy(dstRow, decodeRow, decodeBytes);
+            }
+        }
+        return true;
+    };
+
+    SkTaskGroup taskGroup(*options.fExecutor);
+    taskGroup.batch(stripes, [&](int stripe) {
+        if (!failed && !decodeStripe(stripe)) {
+            failed = true;
+        }
+    });
+    taskGroup.wait();
+    return !failed;
+}
+
 /*
  * Performs the jpeg decode
  */
@@ -590,6 +874,10 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
         return fDecoderMgr->returnFailure("setjmp", kInvalidInput);
     }
 
+    if (options.fExecutor && this->decodeRestartStripes(dstInfo, dst, dstRowBytes, options)) {
+        return kSuccess;
+    }
+
     if (!jpeg_start_decompress(dinfo)) {
         return fDecoderMgr->returnFailure("startDecompress", kInvalidInput);
     }
@@ -700,6 +988,160 @@ SkSampler* SkJpegCodec::getSampler(bool createIfNecessary) {
     return fSwizzler.get();
 }
 
+SkCodec::Result SkJpegCodec::onStartIncrementalDecode(const SkImageInfo& dstInfo, void* dst,
+                                                      size_t rowBytes, const Options& options) {
+    if (options.fSubset) {
+        // Subsets are not supported.
+        return kUnimplemented;
+    }
+
+    // Set the jump location for libjpeg errors
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return fDecoderMgr->returnFailure("setjmp", kInvalidInput);
+    }
+
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    fDecoderMgr->sourceMgr()->startSuspending();
+
+    // Otherwise jpeg_start_decompress() would read a multiple scan image to the end before
+    // producing any rows.  In buffered-image mode it reads no input at all.
+    dinfo->buffered_image = jpeg_has_multiple_scans(dinfo);
+    if (!jpeg_start_decompress(dinfo)) {
+        return fDecoderMgr->returnFailure("startDecompress", kInvalidInput);
+    }
+    SkASSERT(1 == dinfo->rec_outbuf_height);
+
+    if (needs_swizzler_to_convert_from_cmyk(dinfo->out_color_space,
+                                            this->getEncodedInfo().profile(), this->colorXform())) {
+        this->initializeSwizzler(dstInfo, options, true);
+    }
+    this->allocateStorage(dstInfo);
+
+    fIncrementalDst = dst;
+    fIncrementalRowBytes = rowBytes;
+    fIncrementalRow = 0;
+    fOutputPassesDone = 0;
+    // A single scan image is decoded in one pass, which jpeg_start_decompress() has started.
+    fOutputPassStarted = !dinfo->buffered_image;
+    fFinalOutputPass = !dinfo->buffered_image;
+    fFinalDctMethod = dinfo->dct_method;
+    return kSuccess;
+}
+
+bool SkJpegCodec::readIncrementalRows(bool* error) {
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    const int height = dinfo->output_height;
+    const int sampleY = fSwizzler ? fSwizzler->sampleY() : 1;
+    if (1 == sampleY) {
+        void* dst = SkTAddOffset<void>(fIncrementalDst, fIncrementalRow * fIncrementalRowBytes);
+        fIncrementalRow += this->readRows(this->dstInfo(), dst, fIncrementalRowBytes,
+                                          height - fIncrementalRow, this->options(), error);
+        return fIncrementalRow == height;
+    }
+
+    // SkSampledCodec has asked for every sampleY'th row.  The rest are decoded and dropped.
+    const int scaledHeight = get_scaled_dimension(height, sampleY);
+    while (fIncrementalRow < height) {
+        int rows;
+        if (is_coord_necessary(fIncrementalRow, sampleY, scaledHeight)) {
+            void* dst = SkTAddOffset<void>(fIncrementalDst,
+                    get_dst_coord(fIncrementalRow, sampleY) * fIncrementalRowBytes);
+            rows = this->readRows(this->dstInfo(), dst, fIncrementalRowBytes, 1, this->options(),
+                                  error);
+        } else {
+            JSAMPLE* unused = fSwizzleSrcRow;
+            rows = jpeg_read_scanlines(dinfo, &unused, 1);
+        }
+        if (0 == rows) {
+            return false;
+        }
+        fIncrementalRow++;
+    }
+    return true;
+}
+
+int SkJpegCodec::incrementalRowsDecoded() const {
+    // Once an output pass has finished, every row holds at least a preview.
+    const int height = fDecoderMgr->dinfo()->output_height;
+    const int rows = fOutputPassesDone > 0 ? height : fIncrementalRow;
+    const int sampleY = fSwizzler ? fSwizzler->sampleY() : 1;
+    if (1 == sampleY) {
+        return rows;
+    }
+    const int startRow = get_start_coord(sampleY);
+    if (rows <= startRow) {
+        return 0;
+    }
+    return SkTMin((rows - startRow - 1) / sampleY + 1, get_scaled_dimension(height, sampleY));
+}
+
+SkCodec::Result SkJpegCodec::onIncrementalDecode(int* rowsDecoded) {
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+
+    // Set the jump location for libjpeg errors
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        if (rowsDecoded) {
+            *rowsDecoded = this->incrementalRowsDecoded();
+        }
+        return fDecoderMgr->returnFailure("setjmp", kErrorInInput);
+    }
+
+    // Each libjpeg call below may suspend for lack of input.  It is then called again once the
+    // source manager has more, or on the next call to this method.
+    for (;;) {
+        bool suspended = false;
+        if (!fOutputPassStarted) {
+            // Take in the input that has arrived, so the pass shows the newest scan.
+            int status;
+            do {
+                status = jpeg_consume_input(dinfo);
+            } while (JPEG_SUSPENDED != status && JPEG_REACHED_EOI != status);
+
+            // Until all the input is in, each pass is only a preview, so use the faster DCT.
+            // Block smoothing, on by default, softens the blocks of the first, DC only, scans.
+            fFinalOutputPass = jpeg_input_complete(dinfo);
+            dinfo->dct_method = fFinalOutputPass ? (J_DCT_METHOD) fFinalDctMethod : JDCT_IFAST;
+            suspended = !jpeg_start_output(dinfo, dinfo->input_scan_number);
+            if (!suspended) {
+                fOutputPassStarted = true;
+                fIncrementalRow = 0;
+            }
+        }
+
+        if (!suspended) {
+            bool error = false;
+            suspended = !this->readIncrementalRows(&error);
+            if (error) {
+                if (rowsDecoded) {
+                    *rowsDecoded = this->incrementalRowsDecoded();
+                }
+                return fDecoderMgr->returnFailure("readRows", kErrorInInput);
+            }
+        }
+
+        if (!suspended && dinfo->buffered_image) {
+            suspended = !jpeg_finish_output(dinfo);
+            if (!suspended) {
+                fOutputPassStarted = false;
+                fOutputPassesDone++;
+            }
+        }
+
+        if (!suspended) {
+            if (fFinalOutputPass) {
+                return kSuccess;
+            }
+        } else if (!fDecoderMgr->sourceMgr()->fetchMoreInput()) {
+            if (rowsDecoded) {
+                *rowsDecoded = this->incrementalRowsDecoded();
+            }
+            return kIncompleteInput;
+        }
+    }
+}
+
 SkCodec::Result SkJpegCodec::onStartScanlineDecode(const SkImageInfo& dstInfo,
         const Options& options) {
     // Set the jump location for libjpeg errors
@@ -781,7 +1223,24 @@ bool SkJpegCodec::onSkipScanlines(int count) {
         return fDecoderMgr->returnFalse("onSkipScanlines");
     }
 
-    return (uint32_t) count == jpeg_skip_scanlines(fDecoderMgr->dinfo(), count);
+    // When the IDCT scales, jpeg_skip_scanlines() can corrupt the rows that follow a skip of
+    // less than an iMCU row.  It would read and discard most of those rows anyway, so do that
+    // here instead.  SkSampledCodec hits this whenever it samples a DCT scaled image.
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    const int outRowsPerMcuRow = 8 * dinfo->max_v_samp_factor * dinfo->scale_num /
+                                 dinfo->scale_denom;
+    if (dinfo->scale_num != dinfo->scale_denom && count < outRowsPerMcuRow) {
+        SkAutoTMalloc<uint8_t> storage(get_row_bytes(dinfo));
+        JSAMPLE* row = storage.get();
+        for (int i = 0; i < count; i++) {
+            if (1 != jpeg_read_scanlines(dinfo, &row, 1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    return (uint32_t) count == jpeg_skip_scanlines(dinfo, count);
 }
 
 static bool is_yuv_supported(jpeg_decompress_struct* dinfo) {
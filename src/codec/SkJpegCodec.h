@@ -31,6 +31,12 @@ public:
      */
     static std::unique_ptr<SkCodec> MakeFromStream(std::unique_ptr<SkStream>, Result*);
 
+    /*
+     * Is this a baseline (sequential, Huffman coded, 8-bit) three channel YCbCr jpeg, the kind
+     * that hardware jpeg decoders handle?
+     */
+    bool isBaselineYCbCr() const;
+
 protected:
 
     /*
@@ -107,7 +113,34 @@ private:
     void initializeSwizzler(const SkImageInfo& dstInfo, const Options& options,
                             bool needsCMYKToRGB);
     void allocateStorage(const SkImageInfo& dstInfo);
-    int readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count, const Options&);
+    /*
+     * Returns the number of rows read.  If error is non-null, it is set when that is short
+     * because of a libjpeg error rather than missing input.
+     */
+    int readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count, const Options&,
+                 bool* error = nullptr);
+
+    /*
+     * Decodes the image as independent stripes on options.fExecutor, if it is a baseline jpeg
+     * with restart markers at the start of enough MCU rows.  Returns false, leaving fDecoderMgr
+     * ready for a normal decode, if the image can't be decoded this way or any stripe fails.
+     */
+    bool decodeRestartStripes(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                              const Options&);
+
+    /*
+     * Incremental decoding, as the stream grows.  The source manager suspends when it runs out of
+     * input, and each call resumes where libjpeg left off.  Images with multiple scans, like
+     * progressive jpegs, are decoded in libjpeg's buffered-image mode: after each scan arrives,
+     * an output pass writes the whole image, refined by that scan, to dst.
+     */
+    Result onStartIncrementalDecode(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                                    const Options&) override;
+    Result onIncrementalDecode(int* rowsDecoded) override;
+    // Reads the rest of the current output pass into fIncrementalDst, returning false if it
+    // suspends first.
+    bool readIncrementalRows(bool* error);
+    int incrementalRowsDecoded() const;
 
     /*
      * Scanline decoding.
@@ -136,6 +169,15 @@ private:
 
     std::unique_ptr<SkSwizzler>        fSwizzler;
 
+    // Incremental decode state.  fIncrementalRow is the next output row of the current pass.
+    void*                              fIncrementalDst;
+    size_t                             fIncrementalRowBytes;
+    int                                fIncrementalRow;
+    int                                fOutputPassesDone;
+    bool                               fOutputPassStarted;
+    bool                               fFinalOutputPass;
+    int                                fFinalDctMethod;  // J_DCT_METHOD
+
     friend class SkRawCodec;
 
     typedef SkCodec INHERITED;
@@ -58,6 +58,11 @@ public:
      */
     skjpeg_error_mgr* errorMgr() { return &fErrorMgr; }
 
+    /*
+     * Get the source manager, e.g. to switch it to I/O suspension
+     */
+    skjpeg_source_mgr* sourceMgr() { return &fSrcMgr; }
+
     /*
      * Get function for the decompress info struct
      */
@@ -88,6 +88,34 @@ static void sk_term_source(j_decompress_ptr dinfo)
     // need to modify SkJpegCodec to call jpeg_finish_decompress().
 }
 
+// Functions for suspending sources //
+
+/*
+ * Suspend, leaving next_input_byte at libjpeg's restart point.  fetchMoreInput() loads more data
+ * after it before libjpeg is called again.
+ */
+static boolean sk_fill_suspending_input_buffer(j_decompress_ptr dinfo) {
+    return false;
+}
+
+/*
+ * libjpeg does not let skip_input_data() suspend, so skips past the buffered input are finished
+ * by fetchMoreInput().
+ */
+static void sk_skip_suspending_input_data(j_decompress_ptr dinfo, long numBytes) {
+    skjpeg_source_mgr* src = (skjpeg_source_mgr*) dinfo->src;
+    size_t bytes = (size_t) numBytes;
+
+    if (bytes > src->bytes_in_buffer) {
+        src->fSkipPending += bytes - src->bytes_in_buffer;
+        src->next_input_byte += src->bytes_in_buffer;
+        src->bytes_in_buffer = 0;
+    } else {
+        src->next_input_byte += numBytes;
+        src->bytes_in_buffer -= numBytes;
+    }
+}
+
 // Functions for memory backed sources //
 
 /*
@@ -123,6 +151,9 @@ static boolean sk_fill_mem_input_buffer (j_decompress_ptr cinfo) {
  */
 skjpeg_source_mgr::skjpeg_source_mgr(SkStream* stream)
     : fStream(stream)
+    , fSuspendingCapacity(0)
+    , fSkipPending(0)
+    , fSuspending(false)
 {
     if (stream->hasLength() && stream->getMemoryBase()) {
         init_source = sk_init_mem_source;
@@ -140,3 +171,44 @@ skjpeg_source_mgr::skjpeg_source_mgr(SkStream* stream)
         term_source = sk_term_source;
     }
 }
+
+void skjpeg_source_mgr::startSuspending() {
+    if (fill_input_buffer != sk_fill_buffered_input_buffer) {
+        return;
+    }
+    fill_input_buffer = sk_fill_suspending_input_buffer;
+    skip_input_data = sk_skip_suspending_input_data;
+    fSuspending = true;
+}
+
+bool skjpeg_source_mgr::fetchMoreInput() {
+    if (!fSuspending) {
+        return false;
+    }
+    if (fSkipPending > 0) {
+        fSkipPending -= fStream->skip(fSkipPending);
+        if (fSkipPending > 0) {
+            return false;
+        }
+    }
+
+    // Keep the input from libjpeg's restart point on, moving it to the front of the buffer.
+    const size_t unread = bytes_in_buffer;
+    if (fSuspendingCapacity < unread + kBufferSize) {
+        const size_t capacity = SkTMax(2 * fSuspendingCapacity, unread + 16 * kBufferSize);
+        SkAutoTMalloc<uint8_t> larger(capacity);
+        if (unread > 0) {
+            memcpy(larger.get(), next_input_byte, unread);
+        }
+        fSuspendingBuffer = std::move(larger);
+        fSuspendingCapacity = capacity;
+    } else if (unread > 0) {
+        memmove(fSuspendingBuffer.get(), next_input_byte, unread);
+    }
+
+    const size_t bytes = fStream->read(fSuspendingBuffer.get() + unread,
+                                       fSuspendingCapacity - unread);
+    next_input_byte = (const JOCTET*) fSuspendingBuffer.get();
+    bytes_in_buffer = unread + bytes;
+    return bytes > 0;
+}
@@ -11,6 +11,7 @@
 
 #include "SkJpegPriv.h"
 #include "SkStream.h"
+#include "SkTemplates.h"
 
 #include <setjmp.h>
 // stdio is needed for jpeglib
@@ -32,6 +33,20 @@ void skjpeg_err_exit(j_common_ptr cinfo);
 struct skjpeg_source_mgr : jpeg_source_mgr {
     skjpeg_source_mgr(SkStream* stream);
 
+    /*
+     * Switches a stream backed source to libjpeg's I/O suspension protocol, for decoding data
+     * that is still arriving.  When the buffered input runs out, libjpeg returns to its caller,
+     * backtracking to a restart point whose data is kept; call fetchMoreInput() before calling
+     * libjpeg again.  Memory backed sources already hold all the data there will be.
+     */
+    void startSuspending();
+
+    /*
+     * Reads whatever the stream now has after the input libjpeg has yet to consume.  Returns
+     * false if there is nothing new.
+     */
+    bool fetchMoreInput();
+
     SkStream* fStream; // unowned
     enum {
         // TODO (msarett): Experiment with different buffer sizes.
@@ -39,6 +54,14 @@ struct skjpeg_source_mgr : jpeg_source_mgr {
         kBufferSize = 1024
     };
     uint8_t fBuffer[kBufferSize];
+
+    // Only used once suspending.  libjpeg may backtrack over a whole marker segment or MCU, so
+    // the buffer grows when it is filled by input that libjpeg has not finished with.
+    SkAutoTMalloc<uint8_t> fSuspendingBuffer;
+    size_t                 fSuspendingCapacity;
+    // Bytes libjpeg asked to skip beyond the end of the buffer.
+    size_t                 fSkipPending;
+    bool                   fSuspending;
 };
 
 #endif
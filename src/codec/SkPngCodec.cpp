@@ -10,6 +10,7 @@
 #include "SkColorData.h"
 #include "SkColorSpace.h"
 #include "SkColorTable.h"
+#include "SkExecutor.h"
 #include "SkMacros.h"
 #include "SkMath.h"
 #include "SkOpts.h"
@@ -19,11 +20,15 @@
 #include "SkSize.h"
 #include "SkStream.h"
 #include "SkSwizzler.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkUtils.h"
 
 #include "png.h"
+#include "zlib.h"
 #include <algorithm>
+#include <atomic>
+#include <functional>
 
 #ifdef SK_BUILD_FOR_ANDROID_FRAMEWORK
     #include "SkAndroidFrameworkUtils.h"
@@ -133,16 +138,18 @@ static inline bool is_chunk(const png_byte* chunk, const char* tag) {
     return memcmp(chunk + 4, tag, 4) == 0;
 }
 
+// Passes the next *length bytes of the stream to libpng, counting *length down as it goes, so
+// that a caller whose stream ran out can pick up the rest once more data arrives.
 static inline bool process_data(png_structp png_ptr, png_infop info_ptr,
-        SkStream* stream, void* buffer, size_t bufferSize, size_t length) {
-    while (length > 0) {
-        const size_t bytesToProcess = std::min(bufferSize, length);
+        SkStream* stream, void* buffer, size_t bufferSize, size_t* length) {
+    while (*length > 0) {
+        const size_t bytesToProcess = std::min(bufferSize, *length);
         const size_t bytesRead = stream->read(buffer, bytesToProcess);
         png_process_data(png_ptr, info_ptr, (png_bytep) buffer, bytesRead);
+        *length -= bytesRead;
         if (bytesRead < bytesToProcess) {
             return false;
         }
-        length -= bytesToProcess;
     }
     return true;
 }
@@ -186,7 +193,8 @@ bool AutoCleanPng::decodeBounds() {
 
         png_process_data(fPng_ptr, fInfo_ptr, chunk, 8);
         // Process the full chunk + CRC.
-        if (!process_data(fPng_ptr, fInfo_ptr, fStream, buffer, kBufferSize, length + 4)) {
+        size_t remaining = length + 4;
+        if (!process_data(fPng_ptr, fInfo_ptr, fStream, buffer, kBufferSize, &remaining)) {
             return false;
         }
     }
@@ -194,6 +202,163 @@ bool AutoCleanPng::decodeBounds() {
     return false;
 }
 
+/*
+ *  Inflates and unfilters IDAT for SkPngCodec, instead of libpng.  Only used for images libpng
+ *  would hand back untransformed (non-interlaced, 8-bit RGB or RGBA), so the rows are identical,
+ *  but the Sub, Avg and Paeth filters use the SkOpts routines however libpng itself was built.
+ *
+ *  Starts where AutoCleanPng::decodeBounds() stops, at the first IDAT's data, and keeps its place
+ *  in the stream between calls, so incremental decodes can pick up when more data arrives.
+ */
+class SkPngIdatReader : SkNoncopyable {
+public:
+    SkPngIdatReader(int width, int bytesPerPixel, size_t firstIdatLength)
+        : fRowBytes(width * bytesPerPixel)
+        , fRow(nullptr)
+        , fPrev(nullptr)
+        , fRowFilled(0)
+        , fRowsRead(0)
+        , fChunkRemaining(firstIdatLength)
+        , fChunkTrailerFilled(0)
+        , fCrc(crc32(0, (const Bytef*)"IDAT", 4))
+    {
+        SkASSERT(3 == bytesPerPixel || 4 == bytesPerPixel);
+        fUp = SkOpts::png_unfilter_up;
+        if (3 == bytesPerPixel) {
+            fSub   = SkOpts::png_unfilter_sub3;
+            fAvg   = SkOpts::png_unfilter_avg3;
+            fPaeth = SkOpts::png_unfilter_paeth3;
+        } else {
+            fSub   = SkOpts::png_unfilter_sub4;
+            fAvg   = SkOpts::png_unfilter_avg4;
+            fPaeth = SkOpts::png_unfilter_paeth4;
+        }
+
+        // Each row is stored with its filter type byte in front.  The row before the first is
+        // all zeros.
+        fStorage.reset(2 * (fRowBytes + 1));
+        sk_bzero(fStorage.get(), 2 * (fRowBytes + 1));
+        fRow  = fStorage.get();
+        fPrev = fStorage.get() + fRowBytes + 1;
+
+        memset(&fZStream, 0, sizeof(fZStream));
+        // Like PNG_MAXIMUM_INFLATE_WINDOW, always allow the largest window, in case the stream
+        // understates it.
+        fZStreamReady = Z_OK == inflateInit2(&fZStream, 15);
+    }
+
+    ~SkPngIdatReader() {
+        if (fZStreamReady) {
+            inflateEnd(&fZStream);
+        }
+    }
+
+    int rowsRead() const { return fRowsRead; }
+
+    /**
+     *  Returns the next unfiltered row, valid until the next call.  Returns nullptr if the stream
+     *  runs out first, setting *error if that's because the image data is malformed rather
+     *  than just incomplete.
+     */
+    uint8_t* nextRow(SkStream* stream, bool* error) {
+        if (!fZStreamReady) {
+            *error = true;
+            return nullptr;
+        }
+
+        const size_t filteredRowBytes = fRowBytes + 1;
+        while (fRowFilled < filteredRowBytes) {
+            if (0 == fZStream.avail_in && !this->readIdat(stream, error)) {
+                return nullptr;
+            }
+            fZStream.next_out  = fRow + fRowFilled;
+            fZStream.avail_out = filteredRowBytes - fRowFilled;
+            const int ret = inflate(&fZStream, Z_NO_FLUSH);
+            fRowFilled = filteredRowBytes - fZStream.avail_out;
+            if ((Z_STREAM_END == ret && fRowFilled < filteredRowBytes)
+                    || (Z_OK != ret && Z_STREAM_END != ret && Z_BUF_ERROR != ret)) {
+                *error = true;
+                return nullptr;
+            }
+        }
+
+        uint8_t* row = fRow + 1;
+        const uint8_t* prev = fPrev + 1;
+        switch (fRow[0]) {
+            case PNG_FILTER_VALUE_NONE:                                break;
+            case PNG_FILTER_VALUE_SUB:   fSub  (row, prev, fRowBytes); break;
+            case PNG_FILTER_VALUE_UP:    fUp   (row, prev, fRowBytes); break;
+            case PNG_FILTER_VALUE_AVG:   fAvg  (row, prev, fRowBytes); break;
+            case PNG_FILTER_VALUE_PAETH: fPaeth(row, prev, fRowBytes); break;
+            default:
+                *error = true;
+                return nullptr;
+        }
+
+        std::swap(fRow, fPrev);
+        fRowFilled = 0;
+        fRowsRead++;
+        return row;
+    }
+
+private:
+    // Refills fZStream's input from the current IDAT, or from the next one if it's used up.
+    // Returns false if the stream runs out, or (setting *error) if the image data ends or a
+    // chunk is corrupt.
+    bool readIdat(SkStream* stream, bool* error) {
+        while (0 == fChunkRemaining) {
+            // What's left of this chunk is its CRC, followed by the next chunk's length and type.
+            fChunkTrailerFilled += stream->read(fChunkTrailer + fChunkTrailerFilled,
+                                                sizeof(fChunkTrailer) - fChunkTrailerFilled);
+            if (fChunkTrailerFilled < sizeof(fChunkTrailer)) {
+                return false;
+            }
+            fChunkTrailerFilled = 0;
+
+            if (png_get_uint_32(fChunkTrailer) != fCrc || !is_chunk(fChunkTrailer + 4, "IDAT")) {
+                *error = true;
+                return false;
+            }
+            fChunkRemaining = png_get_uint_32(fChunkTrailer + 4);
+            fCrc = crc32(0, fChunkTrailer + 8, 4);
+        }
+
+        const size_t bytesRead = stream->read(fInput, SkTMin(fChunkRemaining, sizeof(fInput)));
+        if (0 == bytesRead) {
+            return false;
+        }
+        fCrc = crc32(fCrc, fInput, bytesRead);
+        fChunkRemaining -= bytesRead;
+
+        fZStream.next_in  = fInput;
+        fZStream.avail_in = bytesRead;
+        return true;
+    }
+
+    const size_t            fRowBytes;
+    SkOpts::PngUnfilter     fUp;
+    SkOpts::PngUnfilter     fSub;
+    SkOpts::PngUnfilter     fAvg;
+    SkOpts::PngUnfilter     fPaeth;
+
+    SkAutoTMalloc<uint8_t>  fStorage;
+    uint8_t*                fRow;           // Being inflated.
+    uint8_t*                fPrev;          // The last row returned.
+    size_t                  fRowFilled;
+    int                     fRowsRead;
+
+    z_stream                fZStream;
+    bool                    fZStreamReady;
+
+    size_t                  fChunkRemaining;
+    uint8_t                 fChunkTrailer[12];
+    size_t                  fChunkTrailerFilled;
+    uLong                   fCrc;
+
+    // Arbitrary buffer size, matching SkPngCodec::processData().
+    uint8_t                 fInput[4096];
+};
+
 bool SkPngCodec::processData() {
     switch (setjmp(PNG_JMPBUF(fPng_ptr))) {
         case kPngError:
@@ -211,37 +376,64 @@ bool SkPngCodec::processData() {
             SkASSERT(false);
     }
 
+    if (fReadsIdat) {
+        if (!fDecodedIdat) {
+            fIdatReader.reset(new SkPngIdatReader(this->dimensions().width(),
+                    SkEncodedInfo::kRGBA_Color == this->getEncodedInfo().color() ? 4 : 3,
+                    fIdatLength));
+            fDecodedIdat = true;
+        }
+
+        while (fIdatReader->rowsRead() < this->dimensions().height()) {
+            const int rowNum = fIdatReader->rowsRead();
+            bool error = false;
+            uint8_t* row = fIdatReader->nextRow(this->stream(), &error);
+            if (!row) {
+                return !error;
+            }
+            this->idatRowCallback(row, rowNum);
+        }
+        return true;
+    }
+
     // Arbitrary buffer size
     constexpr size_t kBufferSize = 4096;
     char buffer[kBufferSize];
 
+    // If the stream ran out partway through a chunk on an earlier call, e.g. because it is
+    // still being downloaded, this resumes where that call stopped.
     bool iend = false;
     while (true) {
-        size_t length;
-        if (fDecodedIdat) {
-            // Parse chunk length and type.
-            if (this->stream()->read(buffer, 8) < 8) {
-                break;
-            }
+        if (0 == fChunkRemaining) {
+            size_t length;
+            if (fDecodedIdat) {
+                // Parse chunk length and type, which may have arrived only in part.
+                fChunkHeaderFilled += this->stream()->read(fChunkHeader + fChunkHeaderFilled,
+                                                           8 - fChunkHeaderFilled);
+                if (fChunkHeaderFilled < 8) {
+                    break;
+                }
+                fChunkHeaderFilled = 0;
 
-            png_byte* chunk = reinterpret_cast<png_byte*>(buffer);
-            png_process_data(fPng_ptr, fInfo_ptr, chunk, 8);
-            if (is_chunk(chunk, "IEND")) {
-                iend = true;
-            }
+                png_process_data(fPng_ptr, fInfo_ptr, fChunkHeader, 8);
+                if (is_chunk(fChunkHeader, "IEND")) {
+                    iend = true;
+                }
 
-            length = png_get_uint_32(chunk);
-        } else {
-            length = fIdatLength;
-            png_byte idat[] = {0, 0, 0, 0, 'I', 'D', 'A', 'T'};
-            png_save_uint_32(idat, length);
-            png_process_data(fPng_ptr, fInfo_ptr, idat, 8);
-            fDecodedIdat = true;
+                length = png_get_uint_32(fChunkHeader);
+            } else {
+                length = fIdatLength;
+                png_byte idat[] = {0, 0, 0, 0, 'I', 'D', 'A', 'T'};
+                png_save_uint_32(idat, length);
+                png_process_data(fPng_ptr, fInfo_ptr, idat, 8);
+                fDecodedIdat = true;
+            }
+            fChunkRemaining = length + 4;
         }
 
-        // Process the full chunk + CRC.
-        if (!process_data(fPng_ptr, fInfo_ptr, this->stream(), buffer, kBufferSize, length + 4)
-                || iend) {
+        // Process the rest of the chunk + CRC.
+        if (!process_data(fPng_ptr, fInfo_ptr, this->stream(), buffer, kBufferSize,
+                          &fChunkRemaining) || iend) {
             break;
         }
     }
@@ -430,6 +622,20 @@ std::unique_ptr<SkEncodedInfo::ICCProfile> read_color_profile(png_structp png_pt
 #endif // LIBPNG >= 1.6
 }
 
+static size_t color_xform_src_row_bytes(const SkEncodedInfo& info, int width) {
+    const int bitsPerPixel = info.bitsPerPixel();
+
+    // If we have more than 8-bits (per component) of precision, we will keep that
+    // extra precision.  Otherwise, we will transform straight from RGB, RGBA or gray,
+    // or swizzle to RGBA_8888 first, none of which needs more than 4 bytes per pixel.
+    const size_t bytesPerPixel = (bitsPerPixel > 32) ? bitsPerPixel / 8 : 4;
+    return width * bytesPerPixel;
+}
+
+size_t SkPngCodec::colorXformSrcRowBytes() const {
+    return color_xform_src_row_bytes(this->getEncodedInfo(), this->dstInfo().width());
+}
+
 void SkPngCodec::allocateStorage(const SkImageInfo& dstInfo) {
     switch (fXformMode) {
         case kSwizzleOnly_XformMode:
@@ -439,13 +645,7 @@ void SkPngCodec::allocateStorage(const SkImageInfo& dstInfo) {
             // be created later if we are sampling.  We'll go ahead and allocate
             // enough memory to swizzle if necessary.
         case kSwizzleColor_XformMode: {
-            const int bitsPerPixel = this->getEncodedInfo().bitsPerPixel();
-
-            // If we have more than 8-bits (per component) of precision, we will keep that
-            // extra precision.  Otherwise, we will swizzle to RGBA_8888 before transforming.
-            const size_t bytesPerPixel = (bitsPerPixel > 32) ? bitsPerPixel / 8 : 4;
-            const size_t colorXformBytes = dstInfo.width() * bytesPerPixel;
-            fStorage.reset(colorXformBytes);
+            fStorage.reset(color_xform_src_row_bytes(this->getEncodedInfo(), dstInfo.width()));
             fColorXformSrcRow = fStorage.get();
             break;
         }
@@ -460,6 +660,8 @@ static skcms_PixelFormat png_select_xform_format(const SkEncodedInfo& info) {
         } else if (SkEncodedInfo::kRGB_Color == info.color()) {
             return skcms_PixelFormat_RGB_161616BE;
         }
+    } else if (SkEncodedInfo::kRGB_Color == info.color()) {
+        return skcms_PixelFormat_RGB_888;
     } else if (SkEncodedInfo::kGray_Color == info.color()) {
         return skcms_PixelFormat_G_8;
     }
@@ -467,7 +669,7 @@ static skcms_PixelFormat png_select_xform_format(const SkEncodedInfo& info) {
     return skcms_PixelFormat_RGBA_8888;
 }
 
-void SkPngCodec::applyXformRow(void* dst, const void* src) {
+void SkPngCodec::applyXformRow(void* dst, const void* src, void* colorXformSrcRow) const {
     switch (fXformMode) {
         case kSwizzleOnly_XformMode:
             fSwizzler->swizzle(dst, (const uint8_t*) src);
@@ -476,8 +678,8 @@ void SkPngCodec::applyXformRow(void* dst, const void* src) {
             this->applyColorXform(dst, src, fXformWidth);
             break;
         case kSwizzleColor_XformMode:
-            fSwizzler->swizzle(fColorXformSrcRow, (const uint8_t*) src);
-            this->applyColorXform(dst, fColorXformSrcRow, fXformWidth);
+            fSwizzler->swizzle(colorXformSrcRow, (const uint8_t*) src);
+            this->applyColorXform(dst, colorXformSrcRow, fXformWidth);
             break;
     }
 }
@@ -490,6 +692,101 @@ static SkCodec::Result log_and_return_error(bool success) {
     return SkCodec::kErrorInInput;
 }
 
+/*
+ *  With an SkExecutor, the normal (non-interlaced) decoder overlaps libpng's inflate and
+ *  unfilter, which have to run in row order on the decoding thread, with the swizzle and color
+ *  transform of rows libpng has already produced.  Each row is copied out of libpng's buffer
+ *  into a batch, and a full batch is transformed on the executor while the decoding thread goes
+ *  on to fill the next one.  A batch is refilled only once its previous rows are written, so at
+ *  most kBatches are in flight.  finish() waits for all of them.
+ */
+class SkPngRowPipeline : SkNoncopyable {
+public:
+    using XformProc = std::function<void(void* dst, const void* src, void* colorXformSrcRow)>;
+
+    // Decodes with fewer rows than this are not worth handing to another thread.
+    static constexpr int kMinRows = 64;
+
+    SkPngRowPipeline(SkExecutor& executor, XformProc xform, size_t srcRowBytes,
+                     size_t colorXformSrcRowBytes, size_t dstRowBytes)
+        : fExecutor(executor)
+        , fTaskGroup(executor)
+        , fXform(std::move(xform))
+        , fSrcRowBytes(srcRowBytes)
+        , fDstRowBytes(dstRowBytes)
+        , fCurrent(0)
+        , fRowsInCurrent(0)
+    {
+        for (Batch& batch : fBatches) {
+            batch.fRows.reset(kRowsPerBatch * srcRowBytes);
+            batch.fColorXformSrcRow.reset(colorXformSrcRowBytes);
+        }
+    }
+
+    ~SkPngRowPipeline() { this->finish(); }
+
+    // Queues src, a row straight from libpng, to be transformed into dst.  Consecutive calls
+    // must pass consecutive dst rows.
+    void addRow(void* dst, const void* src) {
+        Batch& batch = fBatches[fCurrent];
+        if (0 == fRowsInCurrent) {
+            while (batch.fBusy.load(std::memory_order_acquire)) {
+                fExecutor.borrow();
+            }
+            batch.fDst = dst;
+        }
+        memcpy(batch.fRows.get() + fRowsInCurrent * fSrcRowBytes, src, fSrcRowBytes);
+        if (++fRowsInCurrent == kRowsPerBatch) {
+            this->submit();
+        }
+    }
+
+    // Blocks until every row passed to addRow() has been written.
+    void finish() {
+        if (fRowsInCurrent > 0) {
+            this->submit();
+        }
+        fTaskGroup.wait();
+    }
+
+private:
+    static constexpr int kBatches      = 8;
+    static constexpr int kRowsPerBatch = 16;
+
+    struct Batch {
+        SkAutoTMalloc<uint8_t> fRows;
+        SkAutoTMalloc<uint8_t> fColorXformSrcRow;
+        void*                  fDst   = nullptr;
+        int                    fCount = 0;
+        std::atomic<bool>      fBusy{false};
+    };
+
+    void submit() {
+        Batch* batch = &fBatches[fCurrent];
+        batch->fCount = fRowsInCurrent;
+        batch->fBusy.store(true, std::memory_order_relaxed);
+        fTaskGroup.add([this, batch] {
+            void* dst = batch->fDst;
+            for (int i = 0; i < batch->fCount; i++) {
+                fXform(dst, batch->fRows.get() + i * fSrcRowBytes, batch->fColorXformSrcRow.get());
+                dst = SkTAddOffset<void>(dst, fDstRowBytes);
+            }
+            batch->fBusy.store(false, std::memory_order_release);
+        });
+        fCurrent = (fCurrent + 1) % kBatches;
+        fRowsInCurrent = 0;
+    }
+
+    SkExecutor&  fExecutor;
+    SkTaskGroup  fTaskGroup;
+    XformProc    fXform;
+    const size_t fSrcRowBytes;
+    const size_t fDstRowBytes;
+    Batch        fBatches[kBatches];
+    int          fCurrent;
+    int          fRowsInCurrent;
+};
+
 class SkPngNormalDecoder : public SkPngCodec {
 public:
     SkPngNormalDecoder(SkEncodedInfo&& info, std::unique_ptr<SkStream> stream,
@@ -500,6 +797,7 @@ public:
         , fRowBytes(0)
         , fFirstRow(0)
         , fLastRow(0)
+        , fDecodingAllRows(false)
     {}
 
     static void AllRowsCallback(png_structp png_ptr, png_bytep row, png_uint_32 rowNum, int /*pass*/) {
@@ -520,15 +818,59 @@ private:
     int                         fLastRow;
     int                         fRowsNeeded;
 
+    // Which of AllRowsCallback and RowCallback is installed.
+    bool                        fDecodingAllRows;
+
+    // Only set for the duration of a processData() call that decodes on options().fExecutor.
+    std::unique_ptr<SkPngRowPipeline> fPipeline;
+
     typedef SkPngCodec INHERITED;
 
     static SkPngNormalDecoder* GetDecoder(png_structp png_ptr) {
         return static_cast<SkPngNormalDecoder*>(png_get_progressive_ptr(png_ptr));
     }
 
+    // Like processData(), but when there is an executor and enough rows to make it worthwhile,
+    // transforms rows on the executor while libpng works on the following ones.
+    bool processDataPipelined(int rowsWanted) {
+        SkExecutor* executor = this->options().fExecutor;
+        if (executor && rowsWanted >= SkPngRowPipeline::kMinRows) {
+            fPipeline.reset(new SkPngRowPipeline(*executor,
+                    [this](void* dst, const void* src, void* colorXformSrcRow) {
+                        this->applyXformRow(dst, src, colorXformSrcRow);
+                    },
+                    png_get_rowbytes(this->png_ptr(), this->info_ptr()),
+                    this->colorXformSrcRowBytes(), fRowBytes));
+        }
+
+        const bool success = this->processData();
+        // Rows already handed to the pipeline count as written, so every one of them has to
+        // land in dst before returning, whether or not libpng ran out of data.
+        fPipeline.reset();
+        return success;
+    }
+
+    void idatRowCallback(uint8_t* row, int rowNum) override {
+        if (fDecodingAllRows) {
+            this->allRowsCallback(row, rowNum);
+        } else {
+            this->rowCallback(row, rowNum);
+        }
+    }
+
+    void writeRow(png_bytep row) {
+        if (fPipeline) {
+            fPipeline->addRow(fDst, row);
+        } else {
+            this->applyXformRow(fDst, row);
+        }
+        fDst = SkTAddOffset<void>(fDst, fRowBytes);
+    }
+
     Result decodeAllRows(void* dst, size_t rowBytes, int* rowsDecoded) override {
         const int height = this->dimensions().height();
         png_set_progressive_read_fn(this->png_ptr(), this, nullptr, AllRowsCallback, nullptr);
+        fDecodingAllRows = true;
         fDst = dst;
         fRowBytes = rowBytes;
 
@@ -536,7 +878,7 @@ private:
         fFirstRow = 0;
         fLastRow = height - 1;
 
-        const bool success = this->processData();
+        const bool success = this->processDataPipelined(height);
         if (success && fRowsWrittenToOutput == height) {
             return kSuccess;
         }
@@ -551,12 +893,12 @@ private:
     void allRowsCallback(png_bytep row, int rowNum) {
         SkASSERT(rowNum == fRowsWrittenToOutput);
         fRowsWrittenToOutput++;
-        this->applyXformRow(fDst, row);
-        fDst = SkTAddOffset<void>(fDst, fRowBytes);
+        this->writeRow(row);
     }
 
     void setRange(int firstRow, int lastRow, void* dst, size_t rowBytes) override {
         png_set_progressive_read_fn(this->png_ptr(), this, nullptr, RowCallback, nullptr);
+        fDecodingAllRows = false;
         fFirstRow = firstRow;
         fLastRow = lastRow;
         fDst = dst;
@@ -571,7 +913,7 @@ private:
             fRowsNeeded = get_scaled_dimension(fLastRow - fFirstRow + 1, sampleY);
         }
 
-        const bool success = this->processData();
+        const bool success = this->processDataPipelined(fRowsNeeded - fRowsWrittenToOutput);
         if (success && fRowsWrittenToOutput == fRowsNeeded) {
             return kSuccess;
         }
@@ -594,8 +936,7 @@ private:
 
         // If there is no swizzler, all rows are needed.
         if (!this->swizzler() || this->swizzler()->rowNeeded(rowNum - fFirstRow)) {
-            this->applyXformRow(fDst, row);
-            fDst = SkTAddOffset<void>(fDst, fRowBytes);
+            this->writeRow(row);
             fRowsWrittenToOutput++;
         }
 
@@ -969,6 +1310,31 @@ void AutoCleanPng::infoCallback(size_t idatLength) {
     this->releasePngPtrs();
 }
 
+// Can SkPngIdatReader decode this image's data in place of libpng?
+static bool reads_idat(png_structp png_ptr, png_infop info_ptr, SkPngChunkReader* chunkReader) {
+    // A chunk reader might want chunks between, or after, the IDATs.
+    if (chunkReader) {
+        return false;
+    }
+
+    png_uint_32 width, height;
+    int bitDepth, colorType, interlaceType;
+    png_get_IHDR(png_ptr, info_ptr, &width, &height, &bitDepth, &colorType, &interlaceType,
+                 nullptr, nullptr);
+    if (8 != bitDepth || PNG_INTERLACE_NONE != interlaceType) {
+        return false;
+    }
+    switch (colorType) {
+        case PNG_COLOR_TYPE_RGB:
+            // Otherwise libpng is expanding tRNS to alpha.
+            return !png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS);
+        case PNG_COLOR_TYPE_RGBA:
+            return true;
+        default:
+            return false;
+    }
+}
+
 SkPngCodec::SkPngCodec(SkEncodedInfo&& encodedInfo, std::unique_ptr<SkStream> stream,
                        SkPngChunkReader* chunkReader, void* png_ptr, void* info_ptr, int bitDepth)
     : INHERITED(std::move(encodedInfo), png_select_xform_format(encodedInfo), std::move(stream))
@@ -979,6 +1345,9 @@ SkPngCodec::SkPngCodec(SkEncodedInfo&& encodedInfo, std::unique_ptr<SkStream> st
     , fBitDepth(bitDepth)
     , fIdatLength(0)
     , fDecodedIdat(false)
+    , fChunkRemaining(0)
+    , fChunkHeaderFilled(0)
+    , fReadsIdat(reads_idat((png_structp)png_ptr, (png_infop)info_ptr, chunkReader))
 {}
 
 SkPngCodec::~SkPngCodec() {
@@ -1015,11 +1384,6 @@ SkCodec::Result SkPngCodec::initializeXforms(const SkImageInfo& dstInfo, const O
     bool skipFormatConversion = false;
     switch (this->getEncodedInfo().color()) {
         case SkEncodedInfo::kRGB_Color:
-            if (this->getEncodedInfo().bitsPerComponent() != 16) {
-                break;
-            }
-
-            // Fall through
         case SkEncodedInfo::kRGBA_Color:
         case SkEncodedInfo::kGray_Color:
             skipFormatConversion = this->colorXform();
@@ -1084,8 +1448,7 @@ void SkPngCodec::initializeSwizzler(const SkImageInfo& dstInfo, const Options& o
         int srcBPP = 0;
         switch (this->getEncodedInfo().color()) {
             case SkEncodedInfo::kRGB_Color:
-                SkASSERT(this->getEncodedInfo().bitsPerComponent() == 16);
-                srcBPP = 6;
+                srcBPP = this->getEncodedInfo().bitsPerComponent() * 3 / 8;
                 break;
             case SkEncodedInfo::kRGBA_Color:
                 srcBPP = this->getEncodedInfo().bitsPerComponent() / 2;
@@ -1133,6 +1496,9 @@ bool SkPngCodec::onRewind() {
     fPng_ptr = png_ptr;
     fInfo_ptr = info_ptr;
     fDecodedIdat = false;
+    fChunkRemaining = 0;
+    fChunkHeaderFilled = 0;
+    fIdatReader.reset();
     return true;
 }
 
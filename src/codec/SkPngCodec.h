@@ -15,6 +15,7 @@
 #include "SkRefCnt.h"
 #include "SkSwizzler.h"
 
+class SkPngIdatReader;
 class SkStream;
 
 class SkPngCodec : public SkCodec {
@@ -53,7 +54,14 @@ protected:
     bool onRewind() override;
 
     SkSampler* getSampler(bool createIfNecessary) override;
-    void applyXformRow(void* dst, const void* src);
+    void applyXformRow(void* dst, const void* src) {
+        this->applyXformRow(dst, src, fColorXformSrcRow);
+    }
+    // As above, but swizzles into colorXformSrcRow rather than the shared fColorXformSrcRow,
+    // so rows can be transformed on several threads at once.  colorXformSrcRow must hold
+    // colorXformSrcRowBytes().
+    void applyXformRow(void* dst, const void* src, void* colorXformSrcRow) const;
+    size_t colorXformSrcRowBytes() const;
 
     voidp png_ptr() { return fPng_ptr; }
     voidp info_ptr() { return fInfo_ptr; }
@@ -110,12 +118,28 @@ private:
     virtual void setRange(int firstRow, int lastRow, void* dst, size_t rowBytes) = 0;
     virtual Result decode(int* rowsDecoded) = 0;
 
+    // Called by processData() with each row when fIdatReader, rather than libpng, is decoding
+    // the image data.  Stands in for the libpng row callback the subclass installed.
+    virtual void idatRowCallback(uint8_t* row, int rowNum) { SkASSERT(false); }
+
     XformMode                      fXformMode;
     int                            fXformWidth;
 
     size_t                         fIdatLength;
     bool                           fDecodedIdat;
 
+    // Where processData() stopped when the stream ran out, so the next call can resume there:
+    // the bytes of the current chunk (and its CRC) not yet passed to libpng, and however much of
+    // the next chunk's header has been read.
+    size_t                         fChunkRemaining;
+    uint8_t                        fChunkHeader[8];
+    size_t                         fChunkHeaderFilled;
+
+    // Set for non-interlaced 8-bit RGB and RGBA images, which need no libpng transforms.  Those
+    // are inflated and unfiltered by fIdatReader instead, using SkOpts' unfiltering routines.
+    const bool                       fReadsIdat;
+    std::unique_ptr<SkPngIdatReader> fIdatReader;
+
     typedef SkCodec INHERITED;
 };
 #endif  // SkPngCodec_DEFINED
@@ -350,3 +350,130 @@ SkCodec::Result SkSampledCodec::sampledDecode(const SkImageInfo& info, void* pix
             return SkCodec::kUnimplemented;
     }
 }
+
+SkSampledCodec::RegionScale SkSampledCodec::findRegionScale(const SkIRect& subset,
+                                                            const SkISize& targetSize) const {
+    const SkISize dims = this->codec()->dimensions();
+
+    // The whole region, unscaled, is always a candidate.
+    RegionScale best = { dims, subset, 1, subset.size() };
+    int64_t bestArea = sk_64_mul(subset.width(), subset.height());
+
+    // libjpeg-turbo can scale to 1/8, 2/8, ..., 7/8.
+    for (int num = 1; num < 8; num++) {
+        const SkISize nativeSize = this->codec()->getScaledDimensions(num / 8.0f);
+
+        // Round the region outwards, so that it covers all of |subset|.
+        auto scaleDown = [](int coord, int nativeDim, int dim) {
+            return SkToInt((int64_t) coord * nativeDim / dim);
+        };
+        auto scaleUp = [](int coord, int nativeDim, int dim) {
+            return SkToInt(((int64_t) coord * nativeDim + dim - 1) / dim);
+        };
+        const SkIRect nativeSubset = SkIRect::MakeLTRB(
+                scaleDown(subset.left(),   nativeSize.width(),  dims.width()),
+                scaleDown(subset.top(),    nativeSize.height(), dims.height()),
+                scaleUp  (subset.right(),  nativeSize.width(),  dims.width()),
+                scaleUp  (subset.bottom(), nativeSize.height(), dims.height()));
+        if (nativeSubset.width()  < targetSize.width() ||
+            nativeSubset.height() < targetSize.height()) {
+            continue;
+        }
+
+        const int sampleSize = SkTMin(nativeSubset.width()  / targetSize.width(),
+                                      nativeSubset.height() / targetSize.height());
+        const SkISize scaledSize = { get_scaled_dimension(nativeSubset.width(),  sampleSize),
+                                     get_scaled_dimension(nativeSubset.height(), sampleSize) };
+        const int64_t area = sk_64_mul(scaledSize.width(), scaledSize.height());
+        if (area < bestArea) {
+            best = { nativeSize, nativeSubset, sampleSize, scaledSize };
+            bestArea = area;
+        }
+    }
+
+    // Sampling the unscaled region may still beat every DCT scale.
+    const int sampleSize = SkTMax(1, SkTMin(subset.width()  / targetSize.width(),
+                                            subset.height() / targetSize.height()));
+    const SkISize scaledSize = { get_scaled_dimension(subset.width(),  sampleSize),
+                                 get_scaled_dimension(subset.height(), sampleSize) };
+    if (sk_64_mul(scaledSize.width(), scaledSize.height()) < bestArea) {
+        best = { dims, subset, sampleSize, scaledSize };
+    }
+    return best;
+}
+
+SkISize SkSampledCodec::onGetRegionDimensions(const SkIRect& subset,
+                                              const SkISize& targetSize) const {
+    if (this->codec()->getEncodedFormat() != SkEncodedImageFormat::kJPEG) {
+        return INHERITED::onGetRegionDimensions(subset, targetSize);
+    }
+    return this->findRegionScale(subset, targetSize).fDimensions;
+}
+
+SkCodec::Result SkSampledCodec::onDecodeRegion(const SkImageInfo& info, void* pixels,
+        size_t rowBytes, const SkIRect& subset, SkCodec::ZeroInitialized zeroInit) {
+    if (this->codec()->getEncodedFormat() != SkEncodedImageFormat::kJPEG) {
+        return INHERITED::onDecodeRegion(info, pixels, rowBytes, subset, zeroInit);
+    }
+
+    const RegionScale scale = this->findRegionScale(subset, info.dimensions());
+    if (scale.fDimensions != info.dimensions()) {
+        return SkCodec::kInvalidScale;
+    }
+
+    // jpeg_crop_scanline() limits the decode to the columns of the region, and skipping rows
+    // avoids the IDCT for the rows above it, so there is nothing to gain from an incremental
+    // decode here.
+    SkCodec::Options codecOptions;
+    codecOptions.fZeroInitialized = zeroInit;
+    SkIRect scanlineSubset = SkIRect::MakeXYWH(scale.fNativeSubset.x(), 0,
+            scale.fNativeSubset.width(), scale.fNativeSize.height());
+    codecOptions.fSubset = &scanlineSubset;
+
+    const SkImageInfo nativeInfo = info.makeWH(scale.fNativeSize.width(),
+                                               scale.fNativeSize.height());
+    SkCodec::Result result = this->codec()->startScanlineDecode(nativeInfo, &codecOptions);
+    if (SkCodec::kSuccess != result) {
+        return result;
+    }
+    SkASSERT(this->codec()->getScanlineOrder() == SkCodec::kTopDown_SkScanlineOrder);
+
+    const int sampleSize = scale.fSampleSize;
+    const int dstHeight = info.height();
+    if (1 == sampleSize) {
+        if (!this->codec()->skipScanlines(scale.fNativeSubset.y())) {
+            this->codec()->fillIncompleteImage(info, pixels, rowBytes, zeroInit, dstHeight, 0);
+            return SkCodec::kIncompleteInput;
+        }
+        if (this->codec()->getScanlines(pixels, dstHeight, rowBytes) != dstHeight) {
+            return SkCodec::kIncompleteInput;
+        }
+        return SkCodec::kSuccess;
+    }
+
+    SkSampler* sampler = this->codec()->getSampler(true);
+    if (!sampler) {
+        return SkCodec::kUnimplemented;
+    }
+    if (sampler->setSampleX(sampleSize) != info.width()) {
+        return SkCodec::kInvalidScale;
+    }
+
+    if (!this->codec()->skipScanlines(scale.fNativeSubset.y() + get_start_coord(sampleSize))) {
+        this->codec()->fillIncompleteImage(info, pixels, rowBytes, zeroInit, dstHeight, 0);
+        return SkCodec::kIncompleteInput;
+    }
+    void* pixelPtr = pixels;
+    for (int y = 0; y < dstHeight; y++) {
+        if (1 != this->codec()->getScanlines(pixelPtr, 1, rowBytes)) {
+            this->codec()->fillIncompleteImage(info, pixels, rowBytes, zeroInit, dstHeight, y + 1);
+            return SkCodec::kIncompleteInput;
+        }
+        if (y < dstHeight - 1 && !this->codec()->skipScanlines(sampleSize - 1)) {
+            this->codec()->fillIncompleteImage(info, pixels, rowBytes, zeroInit, dstHeight, y + 1);
+            return SkCodec::kIncompleteInput;
+        }
+        pixelPtr = SkTAddOffset<void>(pixelPtr, rowBytes);
+    }
+    return SkCodec::kSuccess;
+}
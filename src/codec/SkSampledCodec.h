@@ -29,7 +29,30 @@ protected:
     SkCodec::Result onGetAndroidPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
             const AndroidOptions& options) override;
 
+    SkISize onGetRegionDimensions(const SkIRect& subset, const SkISize& targetSize) const override;
+
+    SkCodec::Result onDecodeRegion(const SkImageInfo& info, void* pixels, size_t rowBytes,
+            const SkIRect& subset, SkCodec::ZeroInitialized zeroInit) override;
+
 private:
+    /**
+     *  How a JPEG region is scaled: first by libjpeg-turbo to fNativeSize, in
+     *  which the region is fNativeSubset, then by sampling with fSampleSize.
+     */
+    struct RegionScale {
+        SkISize fNativeSize;
+        SkIRect fNativeSubset;
+        int     fSampleSize;
+        SkISize fDimensions;
+    };
+
+    /**
+     *  Finds the RegionScale that decodes |subset| to the smallest dimensions
+     *  no smaller than |targetSize|, preferring more DCT scaling on ties.
+     *  Only for JPEG.
+     */
+    RegionScale findRegionScale(const SkIRect& subset, const SkISize& targetSize) const;
+
     /**
      *  Find the best way to account for native scaling.
      *
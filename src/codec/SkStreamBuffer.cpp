@@ -13,6 +13,8 @@ SkStreamBuffer::SkStreamBuffer(std::unique_ptr<SkStream> stream)
     , fBytesBuffered(0)
     , fHasLengthAndPosition(fStream->hasLength() && fStream->hasPosition())
     , fTrulyBuffered(0)
+    , fMemoryBase(fHasLengthAndPosition
+                  ? static_cast<const char*>(fStream->getMemoryBase()) : nullptr)
 {}
 
 SkStreamBuffer::~SkStreamBuffer() {
@@ -21,6 +23,12 @@ SkStreamBuffer::~SkStreamBuffer() {
 
 const char* SkStreamBuffer::get() const {
     SkASSERT(fBytesBuffered >= 1);
+    if (fMemoryBase) {
+        // Nothing has been read, so the stream is still at the start of the
+        // buffer.
+        SkASSERT(0 == fTrulyBuffered);
+        return fMemoryBase + fStream->getPosition();
+    }
     if (fHasLengthAndPosition && fTrulyBuffered < fBytesBuffered) {
         const size_t bytesToBuffer = fBytesBuffered - fTrulyBuffered;
         char* dst = SkTAddOffset<char>(const_cast<char*>(fBuffer), fTrulyBuffered);
@@ -75,6 +83,11 @@ sk_sp<SkData> SkStreamBuffer::getDataAtPosition(size_t position, size_t length)
     SkASSERT(length <= fStream->getLength() &&
              position <= fStream->getLength() - length);
 
+    if (fMemoryBase) {
+        // It is safe to make without copy because we hold onto the stream.
+        return SkData::MakeWithoutCopy(fMemoryBase + position, length);
+    }
+
     const size_t oldPosition = fStream->getPosition();
     if (!fStream->seek(position)) {
         return nullptr;
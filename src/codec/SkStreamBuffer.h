@@ -32,6 +32,9 @@ public:
      *
      *  The number of bytes buffered is the number passed to buffer()
      *  after the last call to flush().
+     *
+     *  If the stream is backed by memory, this points into that memory
+     *  rather than at a copy.
      */
     const char* get() const;
 
@@ -82,7 +85,9 @@ public:
      *
      *  @param position Position to retrieve data, as marked by markPosition().
      *  @param length   Amount of data required at position.
-     *  @return SkData The data at position.
+     *  @return SkData The data at position. If the stream is backed by
+     *      memory, this shares that memory rather than copying it, and is
+     *      only valid for the lifetime of this SkStreamBuffer.
      */
     sk_sp<SkData> getDataAtPosition(size_t position, size_t length);
 
@@ -108,6 +113,10 @@ private:
     // The second call to get() needs to only truly buffer the part that was
     // not already buffered.
     mutable size_t              fTrulyBuffered;
+    // If the stream has a length and position and is also backed by memory,
+    // get() and getDataAtPosition() point straight into that memory, and
+    // nothing is ever read into fBuffer. fTrulyBuffered then stays at zero.
+    const char* const           fMemoryBase;
     // Only used if !fHasLengthAndPosition. In that case, markPosition will
     // copy into an SkData, stored here.
     SkTHashMap<size_t, SkData*> fMarkedData;
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkStubJpegHardwareDecoderAPI_DEFINED
+#define SkStubJpegHardwareDecoderAPI_DEFINED
+
+// This stub implementation of JpegHardwareDecoderAPI.h lets us compile SkHardwareJpeg.cpp
+// even when the platform has no hardware jpeg decoder.  It, of course, does nothing and
+// fails to decode.
+
+#include <stddef.h>
+#include <stdint.h>
+
+extern "C" {
+    typedef struct AHardwareBuffer AHardwareBuffer;
+}
+
+struct JpegHardwareDecoder {
+    virtual ~JpegHardwareDecoder() {}
+
+    // Can the hardware decode a baseline YCbCr jpeg of these dimensions?
+    virtual bool canDecode(int width, int height) = 0;
+
+    // AHardwareBuffer usage bits the decoder needs to write into the destination buffer.
+    virtual uint64_t outputUsage() = 0;
+
+    // Decodes the whole jpeg in data into buffer, an AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM
+    // buffer with the jpeg's dimensions.  Blocks until the decode is finished.
+    virtual bool decode(const void* data, size_t size, AHardwareBuffer* buffer) = 0;
+};
+
+static inline JpegHardwareDecoder* createJpegHardwareDecoder() {
+    return nullptr;
+}
+
+#endif//SkStubJpegHardwareDecoderAPI_DEFINED
@@ -28,7 +28,29 @@
 
 #define SK_WUFFS_CODEC_BUFFER_SIZE 4096
 
+// If the SkStream is backed by memory, point the io_buffer at all of it, so
+// that Wuffs reads straight from the stream's memory instead of from copies.
+static bool wrap_memory(wuffs_base__io_buffer* b, SkStream* s) {
+    const void* base = s->getMemoryBase();
+    if (!base || !s->hasLength() || !s->hasPosition()) {
+        return false;
+    }
+    // Wuffs never writes through an io_buffer's reader, and fill_buffer does
+    // not compact a buffer that wraps the stream's memory.
+    b->data = wuffs_base__make_slice_u8(static_cast<uint8_t*>(const_cast<void*>(base)),
+                                        s->getLength());
+    b->meta = wuffs_base__null_io_buffer_meta();
+    b->meta.wi = s->getLength();
+    b->meta.ri = s->getPosition();
+    b->meta.closed = true;
+    return true;
+}
+
 static bool fill_buffer(wuffs_base__io_buffer* b, SkStream* s) {
+    if (b->data.ptr == s->getMemoryBase()) {
+        // The io_buffer already holds the whole stream.
+        return false;
+    }
     b->compact();
     size_t num_read = s->read(b->data.ptr + b->meta.wi, b->data.len - b->meta.wi);
     b->meta.wi += num_read;
@@ -341,6 +363,11 @@ SkWuffsCodec::SkWuffsCodec(SkEncodedInfo&&
     // Initialize fIOBuffer's fields, copying any outstanding data from iobuf to
     // fIOBuffer, as iobuf's backing array may not be valid for the lifetime of
     // this SkWuffsCodec object, but fIOBuffer's backing array (fBuffer) is.
+    // If iobuf wraps fStream's memory, it stays valid for as long as fStream.
+    if (iobuf.data.ptr == fStream->getMemoryBase()) {
+        fIOBuffer = iobuf;
+        return;
+    }
     SkASSERT(iobuf.data.len == SK_WUFFS_CODEC_BUFFER_SIZE);
     memmove(fBuffer, iobuf.data.ptr, iobuf.meta.wi);
     fIOBuffer.data = wuffs_base__make_slice_u8(fBuffer, SK_WUFFS_CODEC_BUFFER_SIZE);
@@ -800,7 +827,9 @@ SkCodec::Result SkWuffsCodec::resetDecoder() {
     if (!fStream->rewind()) {
         return SkCodec::kInternalError;
     }
-    fIOBuffer.meta = wuffs_base__null_io_buffer_meta();
+    if (!wrap_memory(&fIOBuffer, fStream.get())) {
+        fIOBuffer.meta = wuffs_base__null_io_buffer_meta();
+    }
 
     SkCodec::Result result =
         reset_and_decode_image_config(fDecoder.get(), nullptr, &fIOBuffer, fStream.get());
@@ -866,6 +895,7 @@ std::unique_ptr<SkCodec> SkWuffsCodec_MakeFromStream(std::unique_ptr<SkStream> s
     wuffs_base__io_buffer iobuf =
         wuffs_base__make_io_buffer(wuffs_base__make_slice_u8(buffer, SK_WUFFS_CODEC_BUFFER_SIZE),
                                    wuffs_base__null_io_buffer_meta());
+    wrap_memory(&iobuf, stream.get());
     wuffs_base__image_config imgcfg = wuffs_base__null_image_config();
 
     // Wuffs is primarily a C library, not a C++ one. Furthermore, outside of
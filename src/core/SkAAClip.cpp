@@ -643,6 +643,13 @@ bool SkAAClip::setRect(const SkIRect& bounds) {
 #endif
 }
 
+size_t SkAAClip::computeRunsSize() const {
+    if (!fRunHead) {
+        return 0;
+    }
+    return sizeof(RunHead) + fRunHead->fRowCount * sizeof(YOffset) + fRunHead->fDataSize;
+}
+
 bool SkAAClip::isRect() const {
     if (this->isEmpty()) {
         return false;
@@ -864,12 +871,15 @@ bool SkAAClip::quickContains(int left, int top, int right, int bottom) const {
 
 class SkAAClip::Builder {
     SkIRect fBounds;
+    // Every row's runs are appended to fData, one row after the next, so the finished clip
+    // can take them in a single copy. Only the last row is ever still growing.
     struct Row {
         int fY;
         int fWidth;
-        SkTDArray<uint8_t>* fData;
+        int fOffset;
     };
-    SkTDArray<Row>  fRows;
+    SkTDArray<Row>      fRows;
+    SkTDArray<uint8_t>  fData;
     Row* fCurrRow;
     int fPrevY;
     int fWidth;
@@ -883,15 +893,6 @@ public:
         fMinY = bounds.fTop;
     }
 
-    ~Builder() {
-        Row* row = fRows.begin();
-        Row* stop = fRows.end();
-        while (row < stop) {
-            delete row->fData;
-            row += 1;
-        }
-    }
-
     const SkIRect& getBounds() const { return fBounds; }
 
     void addRun(int x, int y, U8CPU alpha, int count) {
@@ -909,24 +910,21 @@ public:
             row = this->flushRow(true);
             row->fY = y;
             row->fWidth = 0;
-            SkASSERT(row->fData);
-            SkASSERT(0 == row->fData->count());
+            SkASSERT(row->fOffset == fData.count());
             fCurrRow = row;
         }
 
         SkASSERT(row->fWidth <= x);
         SkASSERT(row->fWidth < fBounds.width());
 
-        SkTDArray<uint8_t>& data = *row->fData;
-
         int gap = x - row->fWidth;
         if (gap) {
-            AppendRun(data, 0, gap);
+            AppendRun(fData, 0, gap);
             row->fWidth += gap;
             SkASSERT(row->fWidth < fBounds.width());
         }
 
-        AppendRun(data, alpha, count);
+        AppendRun(fData, alpha, count);
         row->fWidth += count;
         SkASSERT(row->fWidth <= fBounds.width());
     }
@@ -1001,12 +999,7 @@ public:
         const Row* row = fRows.begin();
         const Row* stop = fRows.end();
 
-        size_t dataSize = 0;
-        while (row < stop) {
-            dataSize += row->fData->count();
-            row += 1;
-        }
-
+        size_t dataSize = fData.count();
         if (0 == dataSize) {
             return target->setEmpty();
         }
@@ -1019,26 +1012,19 @@ public:
         RunHead* head = RunHead::Alloc(fRows.count(), dataSize);
         YOffset* yoffset = head->yoffsets();
         uint8_t* data = head->data();
-        uint8_t* baseData = data;
+        memcpy(data, fData.begin(), dataSize);
 
-        row = fRows.begin();
         SkDEBUGCODE(int prevY = row->fY - 1;)
         while (row < stop) {
             SkASSERT(prevY < row->fY);  // must be monotonic
             SkDEBUGCODE(prevY = row->fY);
 
             yoffset->fY = row->fY - adjustY;
-            yoffset->fOffset = SkToU32(data - baseData);
+            yoffset->fOffset = SkToU32(row->fOffset);
             yoffset += 1;
 
-            size_t n = row->fData->count();
-            memcpy(data, row->fData->begin(), n);
-#ifdef SK_DEBUG
-            size_t bytesNeeded = compute_row_length(data, fBounds.width());
-            SkASSERT(bytesNeeded == n);
-#endif
-            data += n;
-
+            SkASSERT(compute_row_length(data + row->fOffset, fBounds.width()) ==
+                     (size_t)this->rowLength(row - fRows.begin()));
             row += 1;
         }
 
@@ -1054,10 +1040,9 @@ public:
         for (y = 0; y < fRows.count(); ++y) {
             const Row& row = fRows[y];
             SkDebugf("Y:%3d W:%3d", row.fY, row.fWidth);
-            const SkTDArray<uint8_t>& data = *row.fData;
-            int count = data.count();
+            int count = this->rowLength(y);
             SkASSERT(!(count & 1));
-            const uint8_t* ptr = data.begin();
+            const uint8_t* ptr = fData.begin() + row.fOffset;
             for (int x = 0; x < count; x += 2) {
                 SkDebugf(" [%3d:%02X]", ptr[0], ptr[1]);
                 ptr += 2;
@@ -1073,8 +1058,8 @@ public:
             const Row& row = fRows[i];
             SkASSERT(prevY < row.fY);
             SkASSERT(fWidth == row.fWidth);
-            int count = row.fData->count();
-            const uint8_t* ptr = row.fData->begin();
+            int count = this->rowLength(i);
+            const uint8_t* ptr = fData.begin() + row.fOffset;
             SkASSERT(!(count & 1));
             int w = 0;
             for (int x = 0; x < count; x += 2) {
@@ -1096,10 +1081,16 @@ public:
     }
 
 private:
+    int rowLength(int index) const {
+        int end = index + 1 < fRows.count() ? fRows[index + 1].fOffset : fData.count();
+        return end - fRows[index].fOffset;
+    }
+
     void flushRowH(Row* row) {
         // flush current row if needed
+        SkASSERT(row == fRows.end() - 1);
         if (row->fWidth < fWidth) {
-            AppendRun(*row->fData, 0, fWidth - row->fWidth);
+            AppendRun(fData, 0, fWidth - row->fWidth);
             row->fWidth = fWidth;
         }
     }
@@ -1116,25 +1107,26 @@ private:
             Row* curr = &fRows[count - 1];
             SkASSERT(prev->fWidth == fWidth);
             SkASSERT(curr->fWidth == fWidth);
-            if (*prev->fData == *curr->fData) {
+            int prevLength = curr->fOffset - prev->fOffset;
+            if (prevLength == fData.count() - curr->fOffset &&
+                !memcmp(fData.begin() + prev->fOffset, fData.begin() + curr->fOffset, prevLength)) {
                 prev->fY = curr->fY;
+                fData.setCount(curr->fOffset);
                 if (readyForAnother) {
-                    curr->fData->rewind();
                     next = curr;
                 } else {
-                    delete curr->fData;
                     fRows.removeShuffle(count - 1);
                 }
             } else {
                 if (readyForAnother) {
                     next = fRows.append();
-                    next->fData = new SkTDArray<uint8_t>;
+                    next->fOffset = fData.count();
                 }
             }
         } else {
             if (readyForAnother) {
                 next = fRows.append();
-                next->fData = new SkTDArray<uint8_t>;
+                next->fOffset = fData.count();
             }
         }
         return next;
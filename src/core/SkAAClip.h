@@ -58,6 +58,11 @@ public:
      */
     void copyToMask(SkMask*) const;
 
+    /**
+     *  Returns the number of bytes held by the clip's runs. Copies of a clip share them.
+     */
+    size_t computeRunsSize() const;
+
     // called internally
 
     bool quickContains(int left, int top, int right, int bottom) const;
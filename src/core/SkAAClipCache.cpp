@@ -0,0 +1,66 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkAAClipCache.h"
+#include "SkMatrix.h"
+#include "SkPath.h"
+#include "SkResourceCache.h"
+
+namespace {
+static unsigned gAAClipKeyNamespaceLabel;
+
+struct AAClipKey : public SkResourceCache::Key {
+public:
+    AAClipKey(const SkPath& path, const SkMatrix& matrix, const SkIRect& clipBounds)
+        : fGenID(path.getGenerationID())
+        , fFillType(path.getFillType())
+        , fClipBounds(clipBounds)
+    {
+        matrix.get9(fMatrix);
+        this->init(&gAAClipKeyNamespaceLabel, 0,
+                   sizeof(fGenID) + sizeof(fFillType) + sizeof(fClipBounds) + sizeof(fMatrix));
+    }
+
+    uint32_t fGenID;
+    int32_t  fFillType;
+    SkIRect  fClipBounds;
+    SkScalar fMatrix[9];
+};
+
+struct AAClipRec : public SkResourceCache::Rec {
+    AAClipRec(const AAClipKey& key, const SkAAClip& clip)
+        : fKey(key)
+        , fClip(clip)
+    {}
+
+    AAClipKey fKey;
+    SkAAClip  fClip;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fClip.computeRunsSize(); }
+    const char* getCategory() const override { return "aaclip"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const AAClipRec& rec = static_cast<const AAClipRec&>(baseRec);
+        *static_cast<SkAAClip*>(contextData) = rec.fClip;
+        return true;
+    }
+};
+} // namespace
+
+bool SkAAClipCache::Find(const SkPath& path, const SkMatrix& matrix, const SkIRect& clipBounds,
+                         SkAAClip* clip) {
+    AAClipKey key(path, matrix, clipBounds);
+    return SkResourceCache::Find(key, AAClipRec::Visitor, clip);
+}
+
+void SkAAClipCache::Add(const SkPath& path, const SkMatrix& matrix, const SkIRect& clipBounds,
+                        const SkAAClip& clip) {
+    AAClipKey key(path, matrix, clipBounds);
+    SkResourceCache::Add(new AAClipRec(key, clip));
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkAAClipCache_DEFINED
+#define SkAAClipCache_DEFINED
+
+#include "SkAAClip.h"
+#include "SkRect.h"
+
+class SkMatrix;
+class SkPath;
+
+/**
+ *  Remembers antialiased path clips in the global SkResourceCache, keyed by the path's
+ *  generation ID and fill type, the matrix that maps it to device space, and the device
+ *  rect it was clipped to. SkAAClip shares its runs between copies, so a hit costs a ref.
+ */
+class SkAAClipCache {
+public:
+    /**
+     *  On success, sets clip to the cached result and returns true.
+     */
+    static bool Find(const SkPath& path, const SkMatrix& matrix, const SkIRect& clipBounds,
+                     SkAAClip* clip);
+
+    /**
+     *  Adds the result of rasterizing path under matrix, clipped to clipBounds.
+     */
+    static void Add(const SkPath& path, const SkMatrix& matrix, const SkIRect& clipBounds,
+                    const SkAAClip& clip);
+};
+
+#endif
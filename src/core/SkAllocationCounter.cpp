@@ -0,0 +1,104 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkAllocationCounter.h"
+
+#ifdef SK_COUNT_ALLOCATIONS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(SK_BUILD_FOR_MAC) || defined(SK_BUILD_FOR_IOS)
+    #include <malloc/malloc.h>
+    static size_t usable_size(void* p) { return malloc_size(p); }
+#elif defined(SK_BUILD_FOR_WIN)
+    #include <malloc.h>
+    static size_t usable_size(void* p) { return _msize(p); }
+#else
+    #include <malloc.h>
+    static size_t usable_size(void* p) { return malloc_usable_size(p); }
+#endif
+
+static std::atomic<int64_t> gCount{0};
+static std::atomic<int64_t> gBytes{0};
+static std::atomic<int64_t> gLiveBytes{0};
+static std::atomic<int64_t> gPeakLiveBytes{0};
+static std::atomic<int64_t> gBaselineLiveBytes{0};
+
+void SkAllocationCounter::Reset() {
+    int64_t live = gLiveBytes.load(std::memory_order_relaxed);
+    gCount.store(0, std::memory_order_relaxed);
+    gBytes.store(0, std::memory_order_relaxed);
+    gBaselineLiveBytes.store(live, std::memory_order_relaxed);
+    gPeakLiveBytes.store(live, std::memory_order_relaxed);
+}
+
+SkAllocationCounts SkAllocationCounter::Get() {
+    SkAllocationCounts counts;
+    counts.fCount     = gCount.load(std::memory_order_relaxed);
+    counts.fBytes     = gBytes.load(std::memory_order_relaxed);
+    counts.fPeakBytes = gPeakLiveBytes.load(std::memory_order_relaxed)
+                      - gBaselineLiveBytes.load(std::memory_order_relaxed);
+    return counts;
+}
+
+void SkAllocationCounter::OnAlloc(void* p) {
+    if (!p) {
+        return;
+    }
+    int64_t size = usable_size(p);
+    gCount.fetch_add(1, std::memory_order_relaxed);
+    gBytes.fetch_add(size, std::memory_order_relaxed);
+    int64_t live = gLiveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    int64_t peak = gPeakLiveBytes.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !gPeakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+}
+
+void SkAllocationCounter::OnFree(void* p) {
+    if (p) {
+        gLiveBytes.fetch_sub(usable_size(p), std::memory_order_relaxed);
+    }
+}
+
+// Replace the global operator new/delete so that allocations made with new are counted too.
+// The sized, array and nothrow forms of delete all forward to these by default.
+
+void* operator new(size_t size) {
+    void* p = malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    SkAllocationCounter::OnAlloc(p);
+    return p;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    void* p = malloc(size ? size : 1);
+    SkAllocationCounter::OnAlloc(p);
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept {
+    SkAllocationCounter::OnFree(p);
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    operator delete(p);
+}
+
+#endif
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkAllocationCounter_DEFINED
+#define SkAllocationCounter_DEFINED
+
+#include "SkTypes.h"
+
+#ifdef SK_COUNT_ALLOCATIONS
+
+/**
+ *  Process-wide allocation counting, compiled in only with SK_COUNT_ALLOCATIONS (the GN arg
+ *  skia_enable_allocation_counting). sk_malloc/sk_realloc/sk_free and the global operator
+ *  new/delete report to it. Byte counts are the allocator's usable size, which may be slightly
+ *  larger than what was asked for.
+ */
+struct SkAllocationCounts {
+    int64_t fCount     = 0;  // allocations since Reset()
+    int64_t fBytes     = 0;  // bytes allocated since Reset()
+    int64_t fPeakBytes = 0;  // peak live bytes since Reset(), relative to live bytes at Reset()
+};
+
+namespace SkAllocationCounter {
+    void Reset();
+    SkAllocationCounts Get();
+
+    // Called by the allocation entry points. Both ignore nullptr.
+    void OnAlloc(void*);
+    void OnFree(void*);
+}
+
+#endif
+
+#endif
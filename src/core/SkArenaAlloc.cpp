@@ -38,8 +38,10 @@ SkArenaAlloc::~SkArenaAlloc() {
 }
 
 void SkArenaAlloc::reset() {
+    BlockCache* cache = fBlockCache;
     this->~SkArenaAlloc();
     new (this) SkArenaAlloc{fFirstBlock, fFirstSize, fFirstHeapAllocationSize};
+    fBlockCache = cache;
 }
 
 void SkArenaAlloc::installFooter(FooterAction* action, uint32_t padding) {
@@ -88,6 +90,23 @@ char* SkArenaAlloc::NextBlock(char* footerEnd) {
     return nullptr;
 }
 
+// A cached block starts with the cache it came from and its size, followed by the usual pointer to
+// the previous block.
+char* SkArenaAlloc::NextCachedBlock(char* footerEnd) {
+    char* objEnd = footerEnd - (sizeof(Footer) + sizeof(char*));
+    char* next;
+    memmove(&next, objEnd, sizeof(char*));
+    RunDtorsOnBlock(next);
+
+    char* block = objEnd - (sizeof(uint32_t) + sizeof(BlockCache*));
+    BlockCache* cache;
+    uint32_t blockSize;
+    memmove(&cache, block, sizeof(BlockCache*));
+    memmove(&blockSize, block + sizeof(BlockCache*), sizeof(uint32_t));
+    cache->put(block, blockSize);
+    return nullptr;
+}
+
 void SkArenaAlloc::installUint32Footer(FooterAction* action, uint32_t value, uint32_t padding) {
     memmove(fCursor, &value, sizeof(uint32_t));
     fCursor += sizeof(uint32_t);
@@ -95,7 +114,9 @@ void SkArenaAlloc::installUint32Footer(FooterAction* action, uint32_t value, uin
 }
 
 void SkArenaAlloc::ensureSpace(uint32_t size, uint32_t alignment) {
-    constexpr uint32_t headerSize = sizeof(Footer) + sizeof(ptrdiff_t);
+    // Room for the cache and block size of a cached block, too.
+    constexpr uint32_t headerSize =
+            sizeof(Footer) + sizeof(ptrdiff_t) + sizeof(BlockCache*) + sizeof(uint32_t);
     // The chrome c++ library we use does not define std::max_align_t.
     // This must be conservative to add the right amount of extra memory to handle the alignment
     // padding.
@@ -128,13 +149,33 @@ void SkArenaAlloc::ensureSpace(uint32_t size, uint32_t alignment) {
         allocationSize = (allocationSize + mask) & ~mask;
     }
 
-    char* newBlock = new char[allocationSize];
+    char* newBlock = nullptr;
+    if (fBlockCache) {
+        uint32_t blockSize;
+        newBlock = fBlockCache->get(allocationSize, &blockSize);
+        if (newBlock) {
+            assert(blockSize >= allocationSize);
+            allocationSize = blockSize;
+        }
+    }
+    if (!newBlock) {
+        newBlock = new char[allocationSize];
+    }
+    fHeapBytes += allocationSize;
 
     auto previousDtor = fDtorCursor;
     fCursor = newBlock;
     fDtorCursor = newBlock;
     fEnd = fCursor + allocationSize;
-    this->installPtrFooter(NextBlock, previousDtor, 0);
+    if (fBlockCache) {
+        memmove(fCursor, &fBlockCache, sizeof(BlockCache*));
+        fCursor += sizeof(BlockCache*);
+        memmove(fCursor, &allocationSize, sizeof(uint32_t));
+        fCursor += sizeof(uint32_t);
+        this->installPtrFooter(NextCachedBlock, previousDtor, 0);
+    } else {
+        this->installPtrFooter(NextBlock, previousDtor, 0);
+    }
 }
 
 char* SkArenaAlloc::allocObjectWithFooter(uint32_t sizeIncludingFooter, uint32_t alignment) {
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkArenaAllocBlockCache.h"
+#include "SkTLS.h"
+
+constexpr uint32_t SkArenaAllocBlockCache::kMaxBlockSize;
+constexpr int SkArenaAllocBlockCache::kMaxBlocks;
+
+static void* create_cache() { return new SkArenaAllocBlockCache; }
+static void delete_cache(void* cache) { delete static_cast<SkArenaAllocBlockCache*>(cache); }
+
+SkArenaAllocBlockCache* SkArenaAllocBlockCache::Get() {
+    return static_cast<SkArenaAllocBlockCache*>(SkTLS::Get(create_cache, delete_cache));
+}
+
+SkArenaAllocBlockCache::~SkArenaAllocBlockCache() {
+    this->purge();
+}
+
+char* SkArenaAllocBlockCache::get(uint32_t size, uint32_t* blockSize) {
+    // Take the smallest block that fits.
+    int best = -1;
+    for (int i = 0; i < fCount; ++i) {
+        if (fBlocks[i].fSize >= size && (best < 0 || fBlocks[i].fSize < fBlocks[best].fSize)) {
+            best = i;
+        }
+    }
+    if (best < 0) {
+        return nullptr;
+    }
+    char* block = fBlocks[best].fBlock;
+    *blockSize = fBlocks[best].fSize;
+    fBlocks[best] = fBlocks[--fCount];
+    return block;
+}
+
+void SkArenaAllocBlockCache::put(char* block, uint32_t blockSize) {
+    if (blockSize > kMaxBlockSize) {
+        delete[] block;
+        return;
+    }
+    if (fCount == kMaxBlocks) {
+        // Make room by dropping the smallest block, as it is the least useful.
+        int smallest = 0;
+        for (int i = 1; i < fCount; ++i) {
+            if (fBlocks[i].fSize < fBlocks[smallest].fSize) {
+                smallest = i;
+            }
+        }
+        if (fBlocks[smallest].fSize >= blockSize) {
+            delete[] block;
+            return;
+        }
+        delete[] fBlocks[smallest].fBlock;
+        fBlocks[smallest] = fBlocks[--fCount];
+    }
+    fBlocks[fCount++] = { block, blockSize };
+}
+
+void SkArenaAllocBlockCache::purge() {
+    for (int i = 0; i < fCount; ++i) {
+        delete[] fBlocks[i].fBlock;
+    }
+    fCount = 0;
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkArenaAllocBlockCache_DEFINED
+#define SkArenaAllocBlockCache_DEFINED
+
+#include "SkArenaAlloc.h"
+#include "SkTypes.h"
+
+#include <atomic>
+
+/**
+ * A small per-thread cache of SkArenaAlloc heap blocks. Arenas that live on the stack for the
+ * length of a draw hand their blocks back here when they are destroyed, so the next draw on the
+ * same thread reuses them instead of going back to malloc.
+ *
+ * An arena using this cache must be destroyed on the thread that created it.
+ */
+class SkArenaAllocBlockCache : public SkArenaAlloc::BlockCache {
+public:
+    ~SkArenaAllocBlockCache() override;
+
+    /** Returns the calling thread's cache. */
+    static SkArenaAllocBlockCache* Get();
+
+    char* get(uint32_t size, uint32_t* blockSize) override;
+    void put(char* block, uint32_t blockSize) override;
+
+    /** Frees all of the cached blocks. */
+    void purge();
+
+    int count() const { return fCount; }
+
+    // Blocks larger than this go straight back to the heap.
+    static constexpr uint32_t kMaxBlockSize = 64 * 1024;
+    static constexpr int kMaxBlocks = 4;
+
+private:
+    struct Block {
+        char*    fBlock;
+        uint32_t fSize;
+    };
+
+    Block fBlocks[kMaxBlocks];
+    int   fCount = 0;
+};
+
+/**
+ * Records the largest amount of heap an arena at one call site has needed, so that later arenas
+ * at that call site can ask for it all in their first heap block instead of growing block by
+ * block. Intended to be a static at the call site; it may be shared between threads.
+ */
+class SkArenaAllocSizeHint {
+public:
+    /** The first heap allocation size to pass to the next arena. */
+    size_t firstHeapAllocation() const {
+        return fPeakHeapBytes.load(std::memory_order_relaxed);
+    }
+
+    /** Notes the heap usage of an arena that is about to be destroyed. */
+    void record(const SkArenaAlloc& arena) {
+        size_t bytes = SkTMin<size_t>(arena.heapBytes(), SkArenaAllocBlockCache::kMaxBlockSize);
+        size_t peak = fPeakHeapBytes.load(std::memory_order_relaxed);
+        while (bytes > peak &&
+               !fPeakHeapBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {}
+    }
+
+private:
+    std::atomic<size_t> fPeakHeapBytes{0};
+};
+
+#endif
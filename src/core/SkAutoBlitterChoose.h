@@ -9,6 +9,7 @@
 #define SkAutoBlitterChoose_DEFINED
 
 #include "SkArenaAlloc.h"
+#include "SkArenaAllocBlockCache.h"
 #include "SkBlitter.h"
 #include "SkDraw.h"
 #include "SkMacros.h"
@@ -19,11 +20,16 @@ class SkPixmap;
 
 class SkAutoBlitterChoose : SkNoncopyable {
 public:
-    SkAutoBlitterChoose() {}
+    SkAutoBlitterChoose() {
+        fAlloc.setBlockCache(SkArenaAllocBlockCache::Get());
+    }
     SkAutoBlitterChoose(const SkDraw& draw, const SkMatrix* matrix, const SkPaint& paint,
-                        bool drawCoverage = false) {
+                        bool drawCoverage = false) : SkAutoBlitterChoose() {
         this->choose(draw, matrix, paint, drawCoverage);
     }
+    ~SkAutoBlitterChoose() {
+        SizeHint()->record(fAlloc);
+    }
 
     SkBlitter*  operator->() { return fBlitter; }
     SkBlitter*  get() const { return fBlitter; }
@@ -46,10 +52,17 @@ public:
     }
 
 private:
+    // Blitters that outgrow the inline storage usually do so by the same amount draw after draw,
+    // so size the first heap block from what earlier draws needed.
+    static SkArenaAllocSizeHint* SizeHint() {
+        static SkArenaAllocSizeHint gHint;
+        return &gHint;
+    }
+
     // Owned by fAlloc, which will handle the delete.
     SkBlitter* fBlitter = nullptr;
 
-    SkSTArenaAlloc<kSkBlitterContextSize> fAlloc;
+    SkSTArenaAlloc<kSkBlitterContextSize> fAlloc{SizeHint()->firstHeapAllocation()};
 };
 #define SkAutoBlitterChoose(...) SK_REQUIRE_LOCAL_VAR(SkAutoBlitterChoose)
 
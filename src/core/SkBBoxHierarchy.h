@@ -31,6 +31,16 @@ public:
      */
     virtual void search(const SkRect& query, SkTDArray<int>* results) const = 0;
 
+    /**
+     * Populate results[i] with the indices of bounding boxes intersecting queries[i], for each
+     * of the N queries. Subclasses may answer them all in one traversal.
+     */
+    virtual void batchSearch(const SkRect queries[], int N, SkTDArray<int> results[]) const {
+        for (int i = 0; i < N; ++i) {
+            this->search(queries[i], &results[i]);
+        }
+    }
+
     virtual size_t bytesUsed() const = 0;
 
     // Get the root bound.
@@ -10,6 +10,7 @@
 #include "SkPictureCommon.h"
 #include "SkRecord.h"
 #include "SkRecordDraw.h"
+#include "SkRTree.h"
 #include "SkTraceEvent.h"
 
 SkBigPicture::SkBigPicture(const SkRect& cull,
@@ -35,10 +36,30 @@ void SkBigPicture::playback(SkCanvas* canvas, AbortCallback* callback) const {
                  this->drawablePicts(),
                  nullptr,
                  this->drawableCount(),
-                 useBBH ? fBBH.get() : nullptr,
+                 useBBH ? this->playbackBBH() : nullptr,
                  callback);
 }
 
+// Building an SkRTree costs about as much as one full playback. Below this many ops the
+// search saves too little to pay for it, unless some of the ops are themselves pictures.
+static constexpr int kMinOpsForLazyBBH = 8;
+
+const SkBBoxHierarchy* SkBigPicture::playbackBBH() const {
+    if (fBBH || fRecord->count() < kMinOpsForLazyBBH) {
+        return fBBH.get();
+    }
+    fLazyBBHOnce([this] {
+        TRACE_EVENT0("skia", "SkBigPicture::buildBBH");
+        SkAutoTMalloc<SkRect> bounds(fRecord->count());
+        SkRecordFillBounds(fCullRect, *fRecord, bounds);
+
+        auto rtree = sk_make_sp<SkRTree>(fCullRect.width() / fCullRect.height());
+        rtree->insert(bounds, fRecord->count());
+        fLazyBBH = std::move(rtree);
+    });
+    return fLazyBBH.get();
+}
+
 void SkBigPicture::partialPlayback(SkCanvas* canvas,
                                    int start,
                                    int stop,
@@ -60,12 +60,19 @@ public:
 private:
     int drawableCount() const;
     SkPicture const* const* drawablePicts() const;
+    // Returns fBBH, or if there is none, an SkRTree built the first time it's asked for.
+    const SkBBoxHierarchy* playbackBBH() const;
 
     const SkRect                         fCullRect;
     const size_t                         fApproxBytesUsedBySubPictures;
     sk_sp<const SkRecord>                fRecord;
     std::unique_ptr<const SnapshotArray> fDrawablePicts;
     sk_sp<const SkBBoxHierarchy>         fBBH;
+
+    // Pictures recorded without a BBH, most often those nested in other pictures, build one
+    // when they are first played back into a clip that doesn't contain them.
+    mutable SkOnce                       fLazyBBHOnce;
+    mutable sk_sp<const SkBBoxHierarchy> fLazyBBH;
 };
 
 #endif//SkBigPicture_DEFINED
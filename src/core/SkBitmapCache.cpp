@@ -285,13 +285,13 @@ static SkResourceCache::DiscardableFactory get_fact(SkResourceCache* localCache)
 }
 
 const SkMipMap* SkMipMapCache::AddAndRef(const SkBitmapProvider& provider,
-                                         SkResourceCache* localCache) {
+                                         SkResourceCache* localCache, int levelCount) {
     SkBitmap src;
     if (!provider.asBitmap(&src)) {
         return nullptr;
     }
 
-    SkMipMap* mipmap = SkMipMap::Build(src, get_fact(localCache));
+    SkMipMap* mipmap = SkMipMap::Build(src, get_fact(localCache), levelCount);
     if (mipmap) {
         MipMapRec* rec = new MipMapRec(provider.makeCacheDesc(), mipmap);
         CHECK_LOCAL(localCache, add, Add, rec);
@@ -60,8 +60,10 @@ class SkMipMapCache {
 public:
     static const SkMipMap* FindAndRef(const SkBitmapCacheDesc&,
                                       SkResourceCache* localCache = nullptr);
+    // levelCount is passed on to SkMipMap::Build(); -1 builds all levels (SkMipMap::kAllLevels).
     static const SkMipMap* AddAndRef(const SkBitmapProvider&,
-                                     SkResourceCache* localCache = nullptr);
+                                     SkResourceCache* localCache = nullptr,
+                                     int levelCount = -1);
 };
 
 #endif
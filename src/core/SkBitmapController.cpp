@@ -76,18 +76,25 @@ bool SkBitmapController::State::processMediumRequest(const SkBitmapProvider& pro
     }
 
     if (invScaleSize.width() > SK_Scalar1 || invScaleSize.height() > SK_Scalar1) {
+        const SkSize scale = SkSize::Make(SkScalarInvert(invScaleSize.width()),
+                                          SkScalarInvert(invScaleSize.height()));
+        // Only build the levels this draw needs. If a later draw needs a smaller level than a
+        // cached partial mipmap has, replace it with a complete one rather than growing it one
+        // level at a time.
+        const int neededLevels = SkMipMap::LevelForScale(scale);
         fCurrMip.reset(SkMipMapCache::FindAndRef(provider.makeCacheDesc()));
-        if (nullptr == fCurrMip.get()) {
+        if (fCurrMip && !fCurrMip->complete() && fCurrMip->countLevels() < neededLevels) {
             fCurrMip.reset(SkMipMapCache::AddAndRef(provider));
-            if (nullptr == fCurrMip.get()) {
-                return false;
-            }
+        } else if (nullptr == fCurrMip.get()) {
+            fCurrMip.reset(SkMipMapCache::AddAndRef(provider, nullptr,
+                                                    SkTMax(neededLevels, 1)));
+        }
+        if (nullptr == fCurrMip.get()) {
+            return false;
         }
         // diagnostic for a crasher...
         SkASSERT_RELEASE(fCurrMip->data());
 
-        const SkSize scale = SkSize::Make(SkScalarInvert(invScaleSize.width()),
-                                          SkScalarInvert(invScaleSize.height()));
         SkMipMap::Level level;
         if (fCurrMip->extractLevel(scale, &level)) {
             const SkSize& invScaleFixup = level.fScale;
@@ -11,7 +11,9 @@
 #include "SkImageFilter.h"
 #include "SkImageFilterCache.h"
 #include "SkMakeUnique.h"
+#include "SkMallocPixelRef.h"
 #include "SkMatrix.h"
+#include "SkMutex.h"
 #include "SkPaint.h"
 #include "SkPath.h"
 #include "SkPixmap.h"
@@ -22,6 +24,7 @@
 #include "SkStrikeCache.h"
 #include "SkSurface.h"
 #include "SkTLazy.h"
+#include "SkTDArray.h"
 #include "SkVertices.h"
 
 struct Bounder {
@@ -245,10 +248,123 @@ SkBitmapDevice::SkBitmapDevice(const SkBitmap& bitmap, const SkSurfaceProps& sur
     }
 }
 
+// Layers are allocated and freed at a high rate (often several times per frame, with the same
+// sizes each time), so the pixel memory of freed layers is kept for reuse by later ones. That
+// saves the malloc, and for large layers the page faults of touching freshly mapped memory.
+// Layer pixels can outlive their device (e.g. in snapshots taken by image filters) and be
+// released on any thread, so the pool is shared and guarded by a mutex.
+namespace {
+
+class LayerPixelPool {
+public:
+    static LayerPixelPool* Get() {
+        static LayerPixelPool* gPool = new LayerPixelPool;
+        return gPool;
+    }
+
+    // Returns size bytes of memory, zeroed if zero is true, or nullptr on failure.
+    void* alloc(size_t size, bool zero) {
+        void* addr = nullptr;
+        {
+            SkAutoMutexAcquire lock(fMutex);
+            // Take the smallest free block that fits, unless it would waste more than half of it.
+            int best = -1;
+            for (int i = 0; i < fBlocks.count(); ++i) {
+                size_t blockSize = fBlocks[i].fSize;
+                if (blockSize >= size && blockSize / 2 <= size &&
+                    (best < 0 || blockSize < fBlocks[best].fSize)) {
+                    best = i;
+                }
+            }
+            if (best >= 0) {
+                addr = fBlocks[best].fAddr;
+                fBytes -= fBlocks[best].fSize;
+                fBlocks.removeShuffle(best);
+            }
+        }
+        if (addr) {
+            // Only the bytes the layer uses need clearing, not the whole block.
+            if (zero) {
+                memset(addr, 0, size);
+            }
+            return addr;
+        }
+        return zero ? sk_calloc_canfail(size) : sk_malloc_canfail(size);
+    }
+
+    void release(void* addr, size_t size) {
+        {
+            SkAutoMutexAcquire lock(fMutex);
+            if (size <= kMaxBytes / 2) {
+                // Evict the oldest blocks to make room.
+                while (fBlocks.count() >= kMaxBlocks || fBytes + size > kMaxBytes) {
+                    fBytes -= fBlocks[0].fSize;
+                    sk_free(fBlocks[0].fAddr);
+                    fBlocks.remove(0);
+                }
+                fBlocks.push_back({addr, size});
+                fBytes += size;
+                return;
+            }
+        }
+        sk_free(addr);
+    }
+
+private:
+    static constexpr int    kMaxBlocks = 16;
+    static constexpr size_t kMaxBytes = 16 * 1024 * 1024;
+
+    struct Block {
+        void*  fAddr;
+        size_t fSize;
+    };
+
+    SkMutex          fMutex;
+    SkTDArray<Block> fBlocks;  // Oldest first.
+    size_t           fBytes = 0;
+};
+
+}  // namespace
+
+// The pool recycles the whole allocation, so it remembers the allocated size in the context.
+static void release_layer_pixels(void* addr, void* context) {
+    LayerPixelPool::Get()->release(addr, reinterpret_cast<size_t>(context));
+}
+
+static bool alloc_layer_pixels(const SkImageInfo& info, SkBitmap* bitmap) {
+    size_t rowBytes = info.minRowBytes();
+    size_t size = info.computeByteSize(rowBytes);
+    if (SkImageInfo::ByteSizeOverflowed(size)) {
+        return false;
+    }
+    // As in SkBitmapDevice::Create(), opaque layers have no sensible default color.
+    void* addr = LayerPixelPool::Get()->alloc(size, !info.isOpaque());
+    if (!addr) {
+        return false;
+    }
+    sk_sp<SkPixelRef> pr = SkMallocPixelRef::MakeWithProc(info, rowBytes, addr,
+                                                          release_layer_pixels,
+                                                          reinterpret_cast<void*>(size));
+    if (!pr) {
+        return false;
+    }
+    bitmap->setInfo(info, rowBytes);
+    bitmap->setPixelRef(std::move(pr), 0, 0);
+    return true;
+}
+
 SkBitmapDevice* SkBitmapDevice::Create(const SkImageInfo& origInfo,
                                        const SkSurfaceProps& surfaceProps,
                                        bool trackCoverage,
                                        SkRasterHandleAllocator* allocator) {
+    return Create(origInfo, surfaceProps, trackCoverage, allocator, false);
+}
+
+SkBitmapDevice* SkBitmapDevice::Create(const SkImageInfo& origInfo,
+                                       const SkSurfaceProps& surfaceProps,
+                                       bool trackCoverage,
+                                       SkRasterHandleAllocator* allocator,
+                                       bool isLayer) {
     SkAlphaType newAT = origInfo.alphaType();
     if (!valid_for_bitmap_device(origInfo, &newAT)) {
         return nullptr;
@@ -267,6 +383,10 @@ SkBitmapDevice* SkBitmapDevice::Create(const SkImageInfo& origInfo,
         if (!hndl) {
             return nullptr;
         }
+    } else if (isLayer) {
+        if (!alloc_layer_pixels(info, &bitmap)) {
+            return nullptr;
+        }
     } else if (info.isOpaque()) {
         // If this bitmap is opaque, we don't have any sensible default color,
         // so we just return uninitialized pixels.
@@ -303,7 +423,7 @@ void SkBitmapDevice::replaceBitmapBackendForRasterSurface(const SkBitmap& bm) {
 SkBaseDevice* SkBitmapDevice::onCreateDevice(const CreateInfo& cinfo, const SkPaint*) {
     const SkSurfaceProps surfaceProps(this->surfaceProps().flags(), cinfo.fPixelGeometry);
     return SkBitmapDevice::Create(cinfo.fInfo, surfaceProps, cinfo.fTrackCoverage,
-                                  cinfo.fAllocator);
+                                  cinfo.fAllocator, true);
 }
 
 bool SkBitmapDevice::onAccessPixels(SkPixmap* pmap) {
@@ -601,6 +721,57 @@ private:
 
 }  // anonymous ns
 
+// Each filter computes only the part of its output within the clip bounds it is given, and asks
+// its inputs for just the area that part depends on (see SkImageFilter::mapContext()). So
+// filtering tile by tile gives the same pixels as filtering the whole clip at once, with
+// intermediate results no larger than a tile plus the filters' halos.
+void SkBitmapDevice::drawFilteredSpecialInTiles(SkSpecialImage* src, int x, int y,
+                                                const SkPaint& origPaint, const SkMatrix& matrix,
+                                                const SkIRect& clipBounds) {
+    SkImageFilter* filter = origPaint.getImageFilter();
+    SkASSERT(filter);
+
+    // Skip the tiles the filter can't draw to.
+    SkIRect area = filter->filterBounds(SkIRect::MakeWH(src->width(), src->height()), matrix,
+                                        SkImageFilter::kForward_MapDirection);
+    if (!area.intersect(clipBounds)) {
+        return;
+    }
+
+    SkPaint paint(origPaint);
+    paint.setImageFilter(nullptr);
+    if (paint.getMaskFilter()) {
+        paint.setMaskFilter(paint.getMaskFilter()->makeWithMatrix(this->ctm()));
+    }
+
+    SkImageFilter::OutputProperties outputProperties(fBitmap.colorType(), fBitmap.colorSpace());
+    for (int top = area.fTop; top < area.fBottom; top += kMaxFilterTileSize) {
+        for (int left = area.fLeft; left < area.fRight; left += kMaxFilterTileSize) {
+            SkIRect tile = SkIRect::MakeLTRB(left, top,
+                                             SkTMin(left + kMaxFilterTileSize, area.fRight),
+                                             SkTMin(top + kMaxFilterTileSize, area.fBottom));
+            // The results of one tile are of no use to the others, so they aren't cached.
+            SkImageFilter::Context ctx(matrix, tile, nullptr, outputProperties);
+            SkIPoint offset = SkIPoint::Make(0, 0);
+            sk_sp<SkSpecialImage> filteredImage = filter->filterImage(src, ctx, &offset);
+            SkBitmap resultBM;
+            if (!filteredImage || !filteredImage->getROPixels(&resultBM)) {
+                continue;
+            }
+            // Don't let one tile's result draw over its neighbors.
+            SkIRect resultBounds = SkIRect::MakeXYWH(offset.x(), offset.y(),
+                                                     resultBM.width(), resultBM.height());
+            SkBitmap tileBM;
+            if (!resultBounds.intersect(tile) ||
+                !resultBM.extractSubset(&tileBM, resultBounds.makeOffset(-offset.x(),
+                                                                         -offset.y()))) {
+                continue;
+            }
+            this->drawSprite(tileBM, x + resultBounds.x(), y + resultBounds.y(), paint);
+        }
+    }
+}
+
 void SkBitmapDevice::drawSpecial(SkSpecialImage* src, int x, int y, const SkPaint& origPaint,
                                  SkImage* clipImage, const SkMatrix& clipMatrix) {
     SkASSERT(!src->isTextureBacked());
@@ -613,7 +784,13 @@ void SkBitmapDevice::drawSpecial(SkSpecialImage* src, int x, int y, const SkPain
         const SkMatrix matrix = SkMatrix::Concat(
             SkMatrix::MakeTrans(SkIntToScalar(-x), SkIntToScalar(-y)), this->ctm());
         const SkIRect clipBounds = fRCStack.rc().getBounds().makeOffset(-x, -y);
-        sk_sp<SkImageFilterCache> cache(this->getImageFilterCache());
+        if (!clipImage &&
+            (clipBounds.width() > kMaxFilterTileSize || clipBounds.height() > kMaxFilterTileSize)) {
+            this->drawFilteredSpecialInTiles(src, x, y, *paint, matrix, clipBounds);
+            return;
+        }
+        sk_sp<SkImageFilterCache> cache(
+                this->getImageFilterCache(filter, clipBounds, fBitmap.colorType()));
         SkImageFilter::OutputProperties outputProperties(fBitmap.colorType(), fBitmap.colorSpace());
         SkImageFilter::Context ctx(matrix, clipBounds, cache.get(), outputProperties);
 
@@ -719,7 +896,8 @@ sk_sp<SkSurface> SkBitmapDevice::makeSurface(const SkImageInfo& info, const SkSu
     return SkSurface::MakeRaster(info, &props);
 }
 
-SkImageFilterCache* SkBitmapDevice::getImageFilterCache() {
+SkImageFilterCache* SkBitmapDevice::getImageFilterCache(const SkImageFilter*, const SkIRect&,
+                                                        SkColorType) {
     SkImageFilterCache* cache = SkImageFilterCache::Get();
     cache->ref();
     return cache;
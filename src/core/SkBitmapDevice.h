@@ -146,6 +146,19 @@ private:
 
     class BDDraw;
 
+    // Image filters whose clip bounds are larger than this in either dimension are evaluated one
+    // tile of at most this size at a time, to bound the memory of their intermediate results.
+    static constexpr int kMaxFilterTileSize = 2048;
+
+    void drawFilteredSpecialInTiles(SkSpecialImage*, int x, int y, const SkPaint&,
+                                    const SkMatrix& filterMatrix, const SkIRect& clipBounds);
+
+    // Layers take their pixels from a pool of recently freed layer memory.
+    static SkBitmapDevice* Create(const SkImageInfo&, const SkSurfaceProps&,
+                                  bool trackCoverage,
+                                  SkRasterHandleAllocator*,
+                                  bool isLayer);
+
     // used to change the backend's pixels (and possibly config/rowbytes)
     // but cannot change the width/height, so there should be no change to
     // any clip information.
@@ -155,7 +168,8 @@ private:
 
     sk_sp<SkSurface> makeSurface(const SkImageInfo&, const SkSurfaceProps&) override;
 
-    SkImageFilterCache* getImageFilterCache() override;
+    SkImageFilterCache* getImageFilterCache(const SkImageFilter*, const SkIRect& clipBounds,
+                                            SkColorType) override;
 
     SkBitmap    fBitmap;
     void*       fRasterHandle = nullptr;
@@ -75,6 +75,92 @@ static void Clamp_S32_opaque_D32_nofilter_DX_shaderproc(const void* sIn, int x,
     }
 }
 
+// As above, but specialized for upscales of 2x or more, where every source pixel is repeated
+// across a run of destination pixels. The runs are computed from the same fixed-point stepping,
+// so the results match the shaderproc above exactly.
+static void Clamp_S32_opaque_D32_nofilter_upscale_shaderproc(const void* sIn, int x, int y,
+                                                             SkPMColor* dst, int count) {
+    const SkBitmapProcState& s = *static_cast<const SkBitmapProcState*>(sIn);
+    SkASSERT((s.fInvType & ~(SkMatrix::kTranslate_Mask |
+                             SkMatrix::kScale_Mask)) == 0);
+    SkASSERT(s.fAlphaScale == 256);
+
+    const int maxX = s.fPixmap.width() - 1;
+    SkFractionalInt fx;
+    int dstY;
+    {
+        const SkBitmapProcStateAutoMapper mapper(s, x, y);
+        const int maxY = s.fPixmap.height() - 1;
+        dstY = SkClampMax(mapper.intY(), maxY);
+        fx = mapper.fractionalIntX();
+    }
+
+    const SkPMColor* src = s.fPixmap.addr32(0, dstY);
+    const SkFractionalInt dx = s.fInvSxFractionalInt;
+    SkASSERT(dx > 0 && dx <= SkIntToFixed3232(1) / 2);
+
+    while (count > 0) {
+        int index = SkFractionalIntToInt(fx);
+        // The number of steps until fx reaches the next source pixel, rounded up.
+        SkFractionalInt toNext = SkIntToFixed3232(index + 1) - fx;
+        int n = (int)SkTMin<SkFractionalInt>(count, (toNext + dx - 1) / dx);
+        sk_memset32(dst, src[SkClampMax(index, maxX)], n);
+        dst += n;
+        count -= n;
+        fx += dx * n;
+    }
+}
+
+// Filtered sampling from 8888 to 8888 with clamp tiling when the inverse matrix scales both X
+// and Y by an even integer N and translates by whole pixels. Every sample point then lies exactly
+// halfway between two source pixels in each direction, so the bilerp is just the average of a
+// 2x2 block, and each step moves N pixels to the right. This matches what the filter matrix proc
+// and S32_alpha_D32_filter_DX produce, bit for bit.
+static void Clamp_S32_alpha_D32_filter_evenscale_shaderproc(const void* sIn, int x, int y,
+                                                            SkPMColor* dst, int count) {
+    const SkBitmapProcState& s = *static_cast<const SkBitmapProcState*>(sIn);
+    SkASSERT(s.fInvType <= (SkMatrix::kTranslate_Mask | SkMatrix::kScale_Mask));
+    SkASSERT(kLow_SkFilterQuality == s.fFilterQuality);
+    SkASSERT(s.fAlphaScale <= 256);
+
+    const int maxX = s.fPixmap.width() - 1,
+              maxY = s.fPixmap.height() - 1;
+    const int stepX = SkScalarRoundToInt(s.fInvMatrix.getScaleX());
+    int x0, y0;
+    {
+        const SkBitmapProcStateAutoMapper mapper(s, x, y);
+        x0 = mapper.intX();
+        y0 = mapper.intY();
+    }
+    const SkPMColor* row0 = s.fPixmap.addr32(0, SkClampMax(y0,     maxY));
+    const SkPMColor* row1 = s.fPixmap.addr32(0, SkClampMax(y0 + 1, maxY));
+
+    const unsigned alphaScale = s.fAlphaScale;
+    auto average = [alphaScale](SkPMColor a, SkPMColor b, SkPMColor c, SkPMColor d) {
+        // Sum two channels at a time, in 16-bit lanes.
+        const uint32_t mask = 0xFF00FF;
+        uint32_t lo = (a & mask) + (b & mask) + (c & mask) + (d & mask);
+        uint32_t hi = ((a >> 8) & mask) + ((b >> 8) & mask) + ((c >> 8) & mask) + ((d >> 8) & mask);
+        lo = (lo >> 2) & mask;
+        hi = (hi >> 2) & mask;
+        if (alphaScale < 256) {
+            lo = ((lo * alphaScale) >> 8) & mask;
+            hi = ((hi * alphaScale) >> 8) & mask;
+        }
+        return lo | (hi << 8);
+    };
+
+    for (int i = 0; i < count; ++i, x0 += stepX) {
+        if ((unsigned)x0 < (unsigned)maxX) {
+            dst[i] = average(row0[x0], row0[x0 + 1], row1[x0], row1[x0 + 1]);
+        } else {
+            int ix0 = SkClampMax(x0, maxX),
+                ix1 = SkClampMax(x0 + 1, maxX);
+            dst[i] = average(row0[ix0], row0[ix1], row1[ix0], row1[ix1]);
+        }
+    }
+}
+
 static void S32_alpha_D32_nofilter_DX(const SkBitmapProcState& s,
                                       const uint32_t* xy, int count, SkPMColor* colors) {
     SkASSERT(count > 0 && colors != nullptr);
@@ -231,6 +317,17 @@ bool SkBitmapProcInfo::init(const SkMatrix& inv, const SkPaint& paint) {
     return true;
 }
 
+// True if the matrix scales by the same even integer in X and Y (at most 64) and translates by
+// whole pixels, so that filtered samples fall exactly between pairs of source pixels.
+static bool is_even_integer_scale(const SkMatrix& m) {
+    SkScalar sx = m.getScaleX();
+    return (m.getType() & ~SkMatrix::kTranslate_Mask) == SkMatrix::kScale_Mask &&
+           sx == m.getScaleY() && sx >= 2 && sx <= 64 &&
+           sx == SkScalarRoundToScalar(sx) && 0 == (SkScalarRoundToInt(sx) & 1) &&
+           m.getTranslateX() == SkScalarRoundToScalar(m.getTranslateX()) &&
+           m.getTranslateY() == SkScalarRoundToScalar(m.getTranslateY());
+}
+
 /*
  *  Analyze filter-quality and matrix, and decide how to implement that.
  *
@@ -273,7 +370,13 @@ bool SkBitmapProcState::chooseProcs() {
     if (fAlphaScale == 256
             && fFilterQuality == kNone_SkFilterQuality
             && SkShader::kClamp_TileMode == fTileModeX) {
-        fShaderProc32 = Clamp_S32_opaque_D32_nofilter_DX_shaderproc;
+        fShaderProc32 = fInvSxFractionalInt > 0 && fInvSxFractionalInt <= SkIntToFixed3232(1) / 2
+                ? Clamp_S32_opaque_D32_nofilter_upscale_shaderproc
+                : Clamp_S32_opaque_D32_nofilter_DX_shaderproc;
+    } else if (fFilterQuality == kLow_SkFilterQuality
+            && SkShader::kClamp_TileMode == fTileModeX
+            && is_even_integer_scale(fInvMatrix)) {
+        fShaderProc32 = Clamp_S32_alpha_D32_filter_evenscale_shaderproc;
     } else {
         fShaderProc32 = this->chooseShaderProc32();
     }
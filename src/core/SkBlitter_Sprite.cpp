@@ -189,20 +189,8 @@ SkBlitter* SkBlitter::ChooseSprite(const SkPixmap& dst, const SkPaint& paint,
         if (!blitter && SkSpriteBlitter_Memcpy::Supports(dst, source, paint)) {
             blitter = allocator->make<SkSpriteBlitter_Memcpy>(source);
         }
-        if (!blitter) {
-            switch (dst.colorType()) {
-                case kN32_SkColorType:
-                    blitter = SkSpriteBlitter::ChooseL32(source, paint, allocator);
-                    break;
-                case kRGB_565_SkColorType:
-                    blitter = SkSpriteBlitter::ChooseL565(source, paint, allocator);
-                    break;
-                case kAlpha_8_SkColorType:
-                    blitter = SkSpriteBlitter::ChooseLA8(source, paint, allocator);
-                    break;
-                default:
-                    break;
-            }
+        if (!blitter && dst.colorType() == kN32_SkColorType) {
+            blitter = SkSpriteBlitter::ChooseL32(source, paint, allocator);
         }
     }
     if (!blitter && !paint.getMaskFilter()) {
@@ -7,6 +7,7 @@
 
 #include "SkBlurMask.h"
 #include "SkBlurPriv.h"
+#include "SkExecutor.h"
 #include "SkGpuBlurUtils.h"
 #include "SkMaskFilterBase.h"
 #include "SkReadBuffer.h"
@@ -287,7 +288,7 @@ bool SkBlurMaskFilterImpl::filterMask(SkMask* dst, const SkMask& src,
                                       const SkMatrix& matrix,
                                       SkIPoint* margin) const {
     SkScalar sigma = this->computeXformedSigma(matrix);
-    return SkBlurMask::BoxBlur(dst, src, sigma, fBlurStyle, margin);
+    return SkBlurMask::BoxBlur(dst, src, sigma, fBlurStyle, margin, &SkExecutor::GetDefault());
 }
 
 bool SkBlurMaskFilterImpl::filterRectMask(SkMask* dst, const SkRect& r,
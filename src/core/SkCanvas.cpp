@@ -2818,6 +2818,10 @@ void SkCanvas::onDrawPicture(const SkPicture* picture, const SkMatrix* matrix,
         }
     }
 
+    if (!paint && this->getTopDevice()->drawRetainedPicture(picture, matrix)) {
+        return;
+    }
+
     SkAutoCanvasMatrixPaint acmp(this, matrix, paint, picture->cullRect());
     picture->playback(this);
 }
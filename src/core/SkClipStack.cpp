@@ -40,6 +40,9 @@ SkClipStack::Element::Element(const Element& that) {
     fFiniteBoundType = that.fFiniteBoundType;
     fFiniteBound = that.fFiniteBound;
     fIsIntersectionOfRects = that.fIsIntersectionOfRects;
+    fIsSingleRRect = that.fIsSingleRRect;
+    fSingleRRectAA = that.fSingleRRectAA;
+    fSingleRRect = that.fSingleRRect;
     fGenID = that.fGenID;
 }
 
@@ -156,6 +159,8 @@ void SkClipStack::Element::initCommon(int saveCount, SkClipOp op, bool doAA) {
     fFiniteBoundType = kInsideOut_BoundsType;
     fFiniteBound.setEmpty();
     fIsIntersectionOfRects = false;
+    fIsSingleRRect = false;
+    fSingleRRectAA = false;
     fGenID = kInvalidGenID;
 }
 
@@ -245,6 +250,7 @@ void SkClipStack::Element::setEmpty() {
     fFiniteBound.setEmpty();
     fFiniteBoundType = kNormal_BoundsType;
     fIsIntersectionOfRects = false;
+    fIsSingleRRect = false;
     fDeviceSpaceRRect.setEmpty();
     fDeviceSpacePath.reset();
     fGenID = kEmptyGenID;
@@ -255,6 +261,7 @@ void SkClipStack::Element::checkEmpty() const {
     SkASSERT(fFiniteBound.isEmpty());
     SkASSERT(kNormal_BoundsType == fFiniteBoundType);
     SkASSERT(!fIsIntersectionOfRects);
+    SkASSERT(!fIsSingleRRect);
     SkASSERT(kEmptyGenID == fGenID);
     SkASSERT(fDeviceSpaceRRect.isEmpty());
     SkASSERT(!fDeviceSpacePath.isValid());
@@ -561,6 +568,45 @@ void SkClipStack::Element::updateBoundAndGenID(const Element* prior) {
             SkASSERT(0);
             break;
     }
+
+    this->updateSingleRRect(prior);
+}
+
+void SkClipStack::Element::updateSingleRRect(const Element* prior) {
+    fIsSingleRRect = false;
+    if (kNormal_BoundsType != fFiniteBoundType) {
+        return;
+    }
+    if (fIsIntersectionOfRects) {
+        fSingleRRect.setRect(fFiniteBound);
+        fSingleRRectAA = fDoAA;
+        fIsSingleRRect = true;
+        return;
+    }
+    if (DeviceSpaceType::kRect != fDeviceSpaceType && DeviceSpaceType::kRRect != fDeviceSpaceType) {
+        return;
+    }
+    if (kReplace_SkClipOp == fOp || (kIntersect_SkClipOp == fOp && nullptr == prior)) {
+        fSingleRRect = fDeviceSpaceRRect;
+        fSingleRRectAA = fDoAA;
+        fIsSingleRRect = true;
+        return;
+    }
+    if (kIntersect_SkClipOp != fOp || !prior->fIsSingleRRect) {
+        return;
+    }
+    // The intersection of two rrects is only another rrect when one contains the other. As in
+    // isRRect(), the antialiasing of the outer rrect is ignored.
+    if (prior->fSingleRRect.contains(fDeviceSpaceRRect.getBounds())) {
+        fSingleRRect = fDeviceSpaceRRect;
+        fSingleRRectAA = fDoAA;
+        fIsSingleRRect = true;
+    } else if (fDeviceSpaceRRect.contains(prior->fSingleRRect.getBounds()) ||
+               fDeviceSpaceRRect == prior->fSingleRRect) {
+        fSingleRRect = prior->fSingleRRect;
+        fSingleRRectAA = prior->fSingleRRectAA;
+        fIsSingleRRect = true;
+    }
 }
 
 // This constant determines how many Element's are allocated together as a block in
@@ -699,6 +745,11 @@ void SkClipStack::getBounds(SkRect* canvFiniteBound,
 }
 
 bool SkClipStack::internalQuickContains(const SkRect& rect) const {
+    SkRRect singleRRect;
+    bool aa;
+    if (this->isSingleRRect(&singleRRect, &aa)) {
+        return singleRRect.contains(rect);
+    }
 
     Iter iter(*this, Iter::kTop_IterStart);
     const Element* element = iter.prev();
@@ -724,6 +775,11 @@ bool SkClipStack::internalQuickContains(const SkRect& rect) const {
 }
 
 bool SkClipStack::internalQuickContains(const SkRRect& rrect) const {
+    SkRRect singleRRect;
+    bool aa;
+    if (this->isSingleRRect(&singleRRect, &aa)) {
+        return singleRRect.contains(rrect.getBounds()) || singleRRect == rrect;
+    }
 
     Iter iter(*this, Iter::kTop_IterStart);
     const Element* element = iter.prev();
@@ -959,16 +1015,24 @@ void SkClipStack::getConservativeBounds(int offsetX,
     }
 }
 
+bool SkClipStack::isSingleRRect(SkRRect* rrect, bool* aa) const {
+    const Element* back = static_cast<const Element*>(fDeque.back());
+    if (!back || !back->fIsSingleRRect) {
+        return false;
+    }
+    *rrect = back->fSingleRRect;
+    *aa = back->fSingleRRectAA;
+    return true;
+}
+
 bool SkClipStack::isRRect(const SkRect& bounds, SkRRect* rrect, bool* aa) const {
     const Element* back = static_cast<const Element*>(fDeque.back());
     if (!back) {
         // TODO: return bounds?
         return false;
     }
-    // First check if the entire stack is known to be a rect by the top element.
-    if (back->fIsIntersectionOfRects && back->fFiniteBoundType == BoundsType::kNormal_BoundsType) {
-        rrect->setRect(back->fFiniteBound);
-        *aa = back->isAA();
+    // First check if the entire stack is known to be a rect or rrect by the top element.
+    if (this->isSingleRRect(rrect, aa)) {
         return true;
     }
 
@@ -217,6 +217,12 @@ public:
         // equivalent to a single rect intersection? IIOW, is the clip effectively a rectangle.
         bool fIsIntersectionOfRects;
 
+        // Likewise, is the clip effectively the rrect fSingleRRect (antialiased if fSingleRRectAA)?
+        // This is tracked incrementally so that queries stay O(1) however deep the stack gets.
+        bool fIsSingleRRect;
+        bool fSingleRRectAA;
+        SkRRect fSingleRRect;
+
         uint32_t fGenID;
 #if SK_SUPPORT_GPU
         mutable GrProxyProvider*      fProxyProvider = nullptr;
@@ -257,6 +263,9 @@ public:
         /** Determines possible finite bounds for the Element given the previous element of the
             stack */
         void updateBoundAndGenID(const Element* prior);
+        /** Determines whether the stack up to and including this Element is equivalent to a single
+            rrect, given the previous element of the stack. Called by updateBoundAndGenID(). */
+        void updateSingleRRect(const Element* prior);
         // The different combination of fill & inverse fill when combining bounding boxes
         enum FillCombo {
             kPrev_Cur_FillCombo,
@@ -378,6 +387,13 @@ public:
      */
     bool isRRect(const SkRect& bounds, SkRRect* rrect, bool* aa) const;
 
+    /**
+     * Returns true if the entire stack is known to be equivalent to intersection with a single
+     * rrect, regardless of what is drawn. Unlike isRRect() this does not walk the stack: the answer
+     * is cached on each save level as clips are added, so it is O(1) at any depth.
+     */
+    bool isSingleRRect(SkRRect* rrect, bool* aa) const;
+
     /**
      * The generation ID has three reserved values to indicate special
      * (potentially ignorable) cases
@@ -60,12 +60,15 @@ SkColorSpaceXformSteps::SkColorSpaceXformSteps(SkColorSpace* src, SkAlphaType sr
     #endif
     }
 
-    // Fill out all the transfer functions we'll use.
-    src->   transferFn(&this->srcTF   .g);
-    dst->invTransferFn(&this->dstTFInv.g);
-
-    this->srcTF_is_sRGB = src->gammaCloseToSRGB();
-    this->dstTF_is_sRGB = dst->gammaCloseToSRGB();
+    // Fill out the transfer functions we'll use.  The others are left unset.
+    if (this->flags.linearize) {
+        src->transferFn(&this->srcTF.g);
+        this->srcTF_is_sRGB = src->gammaCloseToSRGB();
+    }
+    if (this->flags.encode) {
+        dst->invTransferFn(&this->dstTFInv.g);
+        this->dstTF_is_sRGB = dst->gammaCloseToSRGB();
+    }
 
     // If we linearize then immediately reencode with the same transfer function, skip both.
     if ( this->flags.linearize       &&
@@ -178,9 +181,20 @@ void SkColorSpaceXformSteps::apply(SkRasterPipeline* p, bool src_is_normalized)
 //////////////
 
 bool sk_can_use_legacy_blits(SkColorSpace* src, SkColorSpace* dst) {
-    // When considering legacy blits, we only supported premul, so set those here
-    SkAlphaType srcAT = kPremul_SkAlphaType;
-    SkAlphaType dstAT = kPremul_SkAlphaType;
+    // When considering legacy blits, we only supported premul.  This is called per draw, so
+    // rather than building premul->premul steps (and their gamut matrix) we follow the same
+    // decisions from the hashes alone: no steps are needed as long as the gamuts match and the
+    // transfer functions match or are both linear.
+    if (!src) { src = sk_srgb_singleton(); }
+    if (!dst) { dst = src; }
+
+    bool legacy = src->hash() == dst->hash()
+              || (src->toXYZD50Hash() == dst->toXYZD50Hash() &&
+                  (src->gammaIsLinear() ? dst->gammaIsLinear()
+                                        : !dst->gammaIsLinear() &&
+                                          src->transferFnHash() == dst->transferFnHash()));
 
-    return SkColorSpaceXformSteps(src, srcAT, dst, dstAT).flags.mask() == 0;
+    SkASSERT(legacy == (SkColorSpaceXformSteps(src, kPremul_SkAlphaType,
+                                               dst, kPremul_SkAlphaType).flags.mask() == 0));
+    return legacy;
 }
@@ -13,14 +13,24 @@
 #include "SkImage.h"
 #include "SkImage_Base.h"
 #include "SkImageFilter.h"
+#include "SkImageGenerator.h"
 #include "SkImagePriv.h"
+#include "SkMakeUnique.h"
 #include "SkShaderBase.h"
 
+// Converted images can be large, so keep fewer of them around than the other objects.
+static constexpr int kPersistentImageCacheCount = 16;
+static constexpr int kPersistentCacheCount = 64;
+
 SkColorSpaceXformer::SkColorSpaceXformer(sk_sp<SkColorSpace> dst)
     : fDst(std::move(dst))
     , fFromSRGBSteps(sk_srgb_singleton(), kUnpremul_SkAlphaType,
                      fDst.get()         , kUnpremul_SkAlphaType)
-    , fReentryCount(0) {
+    , fReentryCount(0)
+    , fPersistentImageCache(kPersistentImageCacheCount)
+    , fPersistentColorFilterCache(kPersistentCacheCount)
+    , fPersistentImageFilterCache(kPersistentCacheCount)
+    , fPersistentShaderCache(kPersistentCacheCount) {
 
     SkRasterPipeline p(&fAlloc);
     p.append(SkRasterPipeline::load_8888, &fFromSRGBSrc);
@@ -54,6 +64,10 @@ std::unique_ptr<SkColorSpaceXformer> SkColorSpaceXformer::Make(sk_sp<SkColorSpac
 // clients may choose to not discard xformers immediately - in which case, caching indefinitely
 // is problematic.  The solution is to limit the cache scope to the top level apply() call
 // (i.e. we only keep cached objects alive while transforming).
+//
+// On top of that, a small LRU cache of each kind outlives the top level call. A canvas playing
+// back a picture tends to see the same paints over and over, and without it every draw would
+// transform the same shaders, color filters and images again.
 
 class SkColorSpaceXformer::AutoCachePurge {
 public:
@@ -75,6 +89,7 @@ private:
 
 template <typename T>
 sk_sp<T> SkColorSpaceXformer::cachedApply(const T* src, Cache<T>* cache,
+                                          PersistentCache<T>* persistentCache,
                                           sk_sp<T> (*applyFunc)(const T*, SkColorSpaceXformer*)) {
     if (!src) {
         return nullptr;
@@ -84,9 +99,14 @@ sk_sp<T> SkColorSpaceXformer::cachedApply(const T* src, Cache<T>* cache,
     if (auto* xformed = cache->find(key)) {
         return sk_ref_sp(xformed->get());
     }
+    if (auto* xformed = persistentCache->find(src)) {
+        cache->set(std::move(key), xformed->fXformed);
+        return xformed->fXformed;
+    }
 
     auto xformed = applyFunc(src, this);
-    cache->set(std::move(key), xformed);
+    cache->set(key, xformed);
+    persistentCache->insert(src, { std::move(key), xformed });
 
     return xformed;
 }
@@ -95,13 +115,49 @@ void SkColorSpaceXformer::purgeCaches() {
     fImageCache.reset();
     fColorFilterCache.reset();
     fImageFilterCache.reset();
+    fShaderCache.reset();
 }
 
+namespace {
+
+// Converts a raster image's pixels to another color space only when they are asked for, so that
+// images that are never actually sampled are never converted. SkImage_Lazy caches the result.
+class ColorSpaceXformGenerator : public SkImageGenerator {
+public:
+    ColorSpaceXformGenerator(sk_sp<SkImage> src, sk_sp<SkColorSpace> dst)
+            : INHERITED(SkImageInfo::Make(src->width(), src->height(), src->colorType(),
+                                          src->alphaType(), std::move(dst)))
+            , fSrc(std::move(src)) {}
+
+protected:
+    bool onGetPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                     const Options&) override {
+        return fSrc->readPixels(info, pixels, rowBytes, 0, 0);
+    }
+
+private:
+    sk_sp<SkImage> fSrc;
+
+    typedef SkImageGenerator INHERITED;
+};
+
+}  // namespace
+
 sk_sp<SkImage> SkColorSpaceXformer::apply(const SkImage* src) {
     const AutoCachePurge autoPurge(this);
-    return this->cachedApply<SkImage>(src, &fImageCache,
+    return this->cachedApply<SkImage>(src, &fImageCache, &fPersistentImageCache,
         [](const SkImage* img, SkColorSpaceXformer* xformer) {
-            return img->makeColorSpace(xformer->fDst);
+            if (img->isTextureBacked() || img->isLazyGenerated()) {
+                // These already convert on the GPU or as they decode.
+                return img->makeColorSpace(xformer->fDst);
+            }
+            SkColorSpace* colorSpace = img->colorSpace() ? img->colorSpace()
+                                                         : sk_srgb_singleton();
+            if (SkColorSpace::Equals(colorSpace, xformer->fDst.get()) || img->isAlphaOnly()) {
+                return sk_ref_sp(const_cast<SkImage*>(img));
+            }
+            return SkImage::MakeFromGenerator(skstd::make_unique<ColorSpaceXformGenerator>(
+                    sk_ref_sp(const_cast<SkImage*>(img)), xformer->fDst));
         });
 }
 
@@ -121,6 +177,7 @@ sk_sp<SkImage> SkColorSpaceXformer::apply(const SkBitmap& src) {
 sk_sp<SkColorFilter> SkColorSpaceXformer::apply(const SkColorFilter* colorFilter) {
     const AutoCachePurge autoPurge(this);
     return this->cachedApply<SkColorFilter>(colorFilter, &fColorFilterCache,
+                                            &fPersistentColorFilterCache,
         [](const SkColorFilter* f, SkColorSpaceXformer* xformer) {
             return f->makeColorSpace(xformer);
         });
@@ -129,6 +186,7 @@ sk_sp<SkColorFilter> SkColorSpaceXformer::apply(const SkColorFilter* colorFilter
 sk_sp<SkImageFilter> SkColorSpaceXformer::apply(const SkImageFilter* imageFilter) {
     const AutoCachePurge autoPurge(this);
     return this->cachedApply<SkImageFilter>(imageFilter, &fImageFilterCache,
+                                            &fPersistentImageFilterCache,
         [](const SkImageFilter* f, SkColorSpaceXformer* xformer) {
             return f->makeColorSpace(xformer);
         });
@@ -136,7 +194,10 @@ sk_sp<SkImageFilter> SkColorSpaceXformer::apply(const SkImageFilter* imageFilter
 
 sk_sp<SkShader> SkColorSpaceXformer::apply(const SkShader* shader) {
     const AutoCachePurge autoPurge(this);
-    return as_SB(shader)->makeColorSpace(this);
+    return this->cachedApply<SkShader>(shader, &fShaderCache, &fPersistentShaderCache,
+        [](const SkShader* s, SkColorSpaceXformer* xformer) {
+            return as_SB(s)->makeColorSpace(xformer);
+        });
 }
 
 void SkColorSpaceXformer::apply(SkColor* xformed, const SkColor* srgb, int n) {
@@ -11,6 +11,7 @@
 #include "SkCanvas.h"
 #include "SkColor.h"
 #include "SkColorSpaceXformSteps.h"
+#include "SkLRUCache.h"
 #include "SkRasterPipeline.h"
 #include "SkRefCnt.h"
 #include "SkTHash.h"
@@ -48,8 +49,19 @@ private:
     template <typename T>
     using Cache = SkTHashMap<sk_sp<T>, sk_sp<T>>;
 
+    // Survives across top-level apply() calls, so that objects reused draw after draw are only
+    // transformed once. The source is kept alive so that its address stays a unique key.
     template <typename T>
-    sk_sp<T> cachedApply(const T*, Cache<T>*, sk_sp<T> (*)(const T*, SkColorSpaceXformer*));
+    struct Xformed {
+        sk_sp<T> fSrc;
+        sk_sp<T> fXformed;
+    };
+    template <typename T>
+    using PersistentCache = SkLRUCache<const T*, Xformed<T>>;
+
+    template <typename T>
+    sk_sp<T> cachedApply(const T*, Cache<T>*, PersistentCache<T>*,
+                         sk_sp<T> (*)(const T*, SkColorSpaceXformer*));
 
     void purgeCaches();
 
@@ -67,6 +79,12 @@ private:
     Cache<SkImage      > fImageCache;
     Cache<SkColorFilter> fColorFilterCache;
     Cache<SkImageFilter> fImageFilterCache;
+    Cache<SkShader     > fShaderCache;
+
+    PersistentCache<SkImage      > fPersistentImageCache;
+    PersistentCache<SkColorFilter> fPersistentColorFilterCache;
+    PersistentCache<SkImageFilter> fPersistentImageFilterCache;
+    PersistentCache<SkShader     > fPersistentShaderCache;
 };
 
 #endif
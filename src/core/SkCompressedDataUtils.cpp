@@ -0,0 +1,115 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkCompressedDataUtils.h"
+
+#include "SkBitmap.h"
+#include "SkColorData.h"
+#include "SkMipMap.h"
+#include "SkTemplates.h"
+#include "etc1.h"
+
+// Both of the supported types use 8 byte 4x4 blocks.
+static size_t level_size(int width, int height) {
+    return ((width + 3) / 4) * ((height + 3) / 4) * 8;
+}
+
+size_t SkCompressedDataSize(SkImage::CompressionType, int width, int height, bool mipMapped) {
+    size_t totalSize = level_size(width, height);
+    if (mipMapped) {
+        int levels = SkMipMap::ComputeLevelCount(width, height);
+        for (int i = 0; i < levels; ++i) {
+            width = SkTMax(1, width / 2);
+            height = SkTMax(1, height / 2);
+            totalSize += level_size(width, height);
+        }
+    }
+    return totalSize;
+}
+
+static SkPMColor expand_565(uint16_t c) {
+    unsigned r = SkR16ToR32(SkGetPackedR16(c));
+    unsigned g = SkG16ToG32(SkGetPackedG16(c));
+    unsigned b = SkB16ToB32(SkGetPackedB16(c));
+    return SkPackARGB32NoCheck(0xFF, r, g, b);
+}
+
+static SkPMColor lerp(SkPMColor a, SkPMColor b, int num, int den) {
+    auto channel = [&](int shift) {
+        unsigned ca = (a >> shift) & 0xFF,
+                 cb = (b >> shift) & 0xFF;
+        return ((ca * (den - num) + cb * num) / den) & 0xFF;
+    };
+    return SkPackARGB32NoCheck(0xFF, channel(SK_R32_SHIFT), channel(SK_G32_SHIFT),
+                               channel(SK_B32_SHIFT));
+}
+
+// BC1 blocks are two little-endian RGB565 endpoints followed by 2 bits per texel. When the first
+// endpoint is the larger one the block has four colors, otherwise it has three and black. The
+// alpha of the black texels is ignored, as for BC1 RGB.
+static void decompress_bc1(const uint8_t* src, int width, int height, SkBitmap* dst) {
+    for (int by = 0; by < height; by += 4) {
+        for (int bx = 0; bx < width; bx += 4) {
+            uint16_t c0 = src[0] | (src[1] << 8),
+                     c1 = src[2] | (src[3] << 8);
+            uint32_t indices = src[4] | (src[5] << 8) | (src[6] << 16) | (src[7] << 24);
+            src += 8;
+
+            SkPMColor colors[4];
+            colors[0] = expand_565(c0);
+            colors[1] = expand_565(c1);
+            if (c0 > c1) {
+                colors[2] = lerp(colors[0], colors[1], 1, 3);
+                colors[3] = lerp(colors[0], colors[1], 2, 3);
+            } else {
+                colors[2] = lerp(colors[0], colors[1], 1, 2);
+                colors[3] = SkPackARGB32NoCheck(0xFF, 0, 0, 0);
+            }
+
+            for (int y = 0; y < 4; ++y) {
+                for (int x = 0; x < 4; ++x, indices >>= 2) {
+                    if (bx + x < width && by + y < height) {
+                        *dst->getAddr32(bx + x, by + y) = colors[indices & 0x3];
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void decompress_etc1(const uint8_t* src, int width, int height, SkBitmap* dst) {
+    SkAutoTMalloc<uint8_t> rgb(width * height * 3);
+    etc1_decode_image(src, rgb.get(), width, height, 3, width * 3);
+    const uint8_t* row = rgb.get();
+    for (int y = 0; y < height; ++y, row += width * 3) {
+        SkPMColor* pixels = dst->getAddr32(0, y);
+        for (int x = 0; x < width; ++x) {
+            pixels[x] = SkPackARGB32NoCheck(0xFF, row[3*x], row[3*x + 1], row[3*x + 2]);
+        }
+    }
+}
+
+bool SkDecompress(const void* data, size_t length, int width, int height,
+                  SkImage::CompressionType type, SkBitmap* dst) {
+    if (width <= 0 || height <= 0 || length < level_size(width, height)) {
+        return false;
+    }
+    if (!dst->tryAllocPixels(SkImageInfo::MakeN32(width, height, kOpaque_SkAlphaType))) {
+        return false;
+    }
+
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+    switch (type) {
+        case SkImage::kETC1_CompressionType:
+            decompress_etc1(src, width, height, dst);
+            return true;
+        case SkImage::kBC1_CompressionType:
+            decompress_bc1(src, width, height, dst);
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkCompressedDataUtils_DEFINED
+#define SkCompressedDataUtils_DEFINED
+
+#include "SkImage.h"
+
+class SkBitmap;
+
+/**
+ * Returns the number of bytes of compressed data needed for an image of the given dimensions,
+ * including every level of the mip chain when mipMapped is true.
+ */
+size_t SkCompressedDataSize(SkImage::CompressionType, int width, int height, bool mipMapped);
+
+/**
+ * Decompresses the base level of data into an opaque kRGBA_8888 bitmap. Returns false if data
+ * is too small for the dimensions.
+ */
+bool SkDecompress(const void* data, size_t length, int width, int height,
+                  SkImage::CompressionType, SkBitmap* dst);
+
+#endif
@@ -517,17 +517,43 @@ int SkTKSearch(const T base[], int count, const K& key) {
     return hi;
 }
 
+// Walking further than this from the hint is left to the binary search.
+static constexpr int kMaxSegmentHintSteps = 8;
+
+// The segment distances strictly increase, so both the walk and SkTKSearch find the first
+// segment whose distance is at least the key.
+template <typename T>
+static int walk_from_hint(const T base[], int count, SkScalar distance, int hint) {
+    if (hint < 0 || hint >= count || (hint > 0 && !(base[hint - 1].fDistance < distance))) {
+        return -1;
+    }
+    for (int steps = 0; steps < kMaxSegmentHintSteps; ++steps) {
+        if (!(base[hint].fDistance < distance) || hint == count - 1) {
+            return hint;
+        }
+        ++hint;
+    }
+    return -1;
+}
+
 const SkContourMeasure::Segment* SkContourMeasure::distanceToSegment( SkScalar distance,
-                                                                     SkScalar* t) const {
+                                                                     SkScalar* t,
+                                                                     int* segHint) const {
     SkDEBUGCODE(SkScalar length = ) this->length();
     SkASSERT(distance >= 0 && distance <= length);
 
     const Segment*  seg = fSegments.begin();
     int             count = fSegments.count();
 
-    int index = SkTKSearch<Segment, SkScalar>(seg, count, distance);
-    // don't care if we hit an exact match or not, so we xor index if it is negative
-    index ^= (index >> 31);
+    int index = segHint ? walk_from_hint(seg, count, distance, *segHint) : -1;
+    if (index < 0) {
+        index = SkTKSearch<Segment, SkScalar>(seg, count, distance);
+        // don't care if we hit an exact match or not, so we xor index if it is negative
+        index ^= (index >> 31);
+    }
+    if (segHint) {
+        *segHint = index;
+    }
     seg = &seg[index];
 
     // now interpolate t-values with the prev segment (if possible)
@@ -550,6 +576,22 @@ const SkContourMeasure::Segment* SkContourMeasure::distanceToSegment( SkScalar d
 }
 
 bool SkContourMeasure::getPosTan(SkScalar distance, SkPoint* pos, SkVector* tangent) const {
+    return this->getPosTan(distance, pos, tangent, nullptr);
+}
+
+bool SkContourMeasure::getPosTan(const SkScalar distances[], int count, SkPoint positions[],
+                                 SkVector tangents[]) const {
+    bool success = true;
+    int segHint = 0;
+    for (int i = 0; i < count; ++i) {
+        success &= this->getPosTan(distances[i], positions ? &positions[i] : nullptr,
+                                   tangents ? &tangents[i] : nullptr, &segHint);
+    }
+    return success;
+}
+
+bool SkContourMeasure::getPosTan(SkScalar distance, SkPoint* pos, SkVector* tangent,
+                                 int* segHint) const {
     if (SkScalarIsNaN(distance)) {
         return false;
     }
@@ -565,7 +607,7 @@ bool SkContourMeasure::getPosTan(SkScalar distance, SkPoint* pos, SkVector* tang
     }
 
     SkScalar        t;
-    const Segment*  seg = this->distanceToSegment(distance, &t);
+    const Segment*  seg = this->distanceToSegment(distance, &t, segHint);
     if (SkScalarIsNaN(t)) {
         return false;
     }
@@ -597,6 +639,11 @@ bool SkContourMeasure::getMatrix(SkScalar distance, SkMatrix* matrix, MatrixFlag
 
 bool SkContourMeasure::getSegment(SkScalar startD, SkScalar stopD, SkPath* dst,
                                   bool startWithMoveTo) const {
+    return this->getSegment(startD, stopD, dst, startWithMoveTo, nullptr);
+}
+
+bool SkContourMeasure::getSegment(SkScalar startD, SkScalar stopD, SkPath* dst,
+                                  bool startWithMoveTo, int* segHint) const {
     SkASSERT(dst);
 
     SkScalar length = this->length();    // ensure we have built our segments
@@ -616,11 +663,11 @@ bool SkContourMeasure::getSegment(SkScalar startD, SkScalar stopD, SkPath* dst,
 
     SkPoint  p;
     SkScalar startT, stopT;
-    const Segment* seg = this->distanceToSegment(startD, &startT);
+    const Segment* seg = this->distanceToSegment(startD, &startT, segHint);
     if (!SkScalarIsFinite(startT)) {
         return false;
     }
-    const Segment* stopSeg = this->distanceToSegment(stopD, &stopT);
+    const Segment* stopSeg = this->distanceToSegment(stopD, &stopT, segHint);
     if (!SkScalarIsFinite(stopT)) {
         return false;
     }
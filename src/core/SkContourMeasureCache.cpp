@@ -0,0 +1,100 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkContourMeasureCache.h"
+#include "SkPathPriv.h"
+#include "SkPathRef.h"
+#include "SkResourceCache.h"
+
+// Measuring a couple of lines is cheaper than a trip through the cache.
+static constexpr int kMinVerbsToCacheMeasure = 4;
+
+static uint64_t make_measure_shared_id(uint32_t pathGenID) {
+    uint64_t sharedID = SkSetFourByteTag('m', 'e', 'a', 's');
+    return (sharedID << 32) | pathGenID;
+}
+
+namespace {
+static unsigned gMeasureKeyNamespaceLabel;
+
+struct MeasureKey : public SkResourceCache::Key {
+public:
+    MeasureKey(const SkPath& path, bool forceClosed, SkScalar resScale)
+        : fResScale(resScale)
+        , fForceClosed(forceClosed)
+    {
+        this->init(&gMeasureKeyNamespaceLabel, make_measure_shared_id(path.getGenerationID()),
+                   sizeof(fResScale) + sizeof(fForceClosed));
+    }
+
+    SkScalar fResScale;
+    uint32_t fForceClosed;
+};
+
+struct MeasureRec : public SkResourceCache::Rec {
+    MeasureRec(const MeasureKey& key, const SkContourMeasureCache::Contours& contours)
+        : fKey(key), fContours(contours) {}
+
+    MeasureKey                      fKey;
+    SkContourMeasureCache::Contours fContours;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + SkContourMeasureCache::BytesUsed(fContours);
+    }
+    const char* getCategory() const override { return "contour-measure"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const MeasureRec& rec = static_cast<const MeasureRec&>(baseRec);
+        *(SkContourMeasureCache::Contours*)contextData = rec.fContours;
+        return true;
+    }
+};
+
+class MeasureInvalidator : public SkPathRef::GenIDChangeListener {
+public:
+    explicit MeasureInvalidator(uint32_t pathGenID) : fPathGenID(pathGenID) {}
+
+private:
+    uint32_t fPathGenID;
+
+    void onChange() override {
+        SkResourceCache::PostPurgeSharedID(make_measure_shared_id(fPathGenID));
+    }
+};
+} // namespace
+
+size_t SkContourMeasureCache::BytesUsed(const Contours& contours) {
+    size_t bytes = contours.count() * sizeof(SkContourMeasure);
+    for (const auto& contour : contours) {
+        bytes += contour->fSegments.bytes() + contour->fPts.bytes();
+    }
+    return bytes;
+}
+
+bool SkContourMeasureCache::FindOrMake(const SkPath& path, bool forceClosed, SkScalar resScale,
+                                       Contours* contours) {
+    if (path.isVolatile() || path.countVerbs() < kMinVerbsToCacheMeasure) {
+        return false;
+    }
+
+    MeasureKey key(path, forceClosed, resScale);
+    if (SkResourceCache::Find(key, MeasureRec::Visitor, contours)) {
+        return true;
+    }
+
+    contours->reset();
+    SkContourMeasureIter iter(path, forceClosed, resScale);
+    while (sk_sp<SkContourMeasure> contour = iter.next()) {
+        contours->push_back(std::move(contour));
+    }
+    SkResourceCache::Add(new MeasureRec(key, *contours));
+    SkPathPriv::AddGenIDChangeListener(
+            path, sk_make_sp<MeasureInvalidator>(path.getGenerationID()));
+    return true;
+}
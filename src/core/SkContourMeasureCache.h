@@ -0,0 +1,35 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkContourMeasureCache_DEFINED
+#define SkContourMeasureCache_DEFINED
+
+#include "SkContourMeasure.h"
+#include "SkTArray.h"
+
+/**
+ * Shares the contour measures of a path between everything that walks it: trim and dash path
+ * effects, text on path, and other SkPathMeasure users. The measures are kept in the
+ * SkResourceCache, keyed by the path's generation ID, and are purged when the path changes or
+ * is deleted.
+ */
+class SkContourMeasureCache {
+public:
+    using Contours = SkTArray<sk_sp<SkContourMeasure>>;
+
+    /**
+     * If path is worth caching, sets contours to the measures SkContourMeasureIter produces for
+     * it, computing and caching them if needed, and returns true. Otherwise returns false and
+     * the path should be measured directly.
+     */
+    static bool FindOrMake(const SkPath& path, bool forceClosed, SkScalar resScale,
+                           Contours* contours);
+
+    static size_t BytesUsed(const Contours&);
+};
+
+#endif
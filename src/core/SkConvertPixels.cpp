@@ -178,10 +178,24 @@ static void convert_with_pipeline(const SkImageInfo& dstInfo, void* dstRow, size
     pipeline.run(0,0, srcInfo.width(), srcInfo.height());
 }
 
-void SkConvertPixels(const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
-                     const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB) {
-    SkASSERT(dstInfo.dimensions() == srcInfo.dimensions());
-    SkASSERT(SkImageInfoValidConversion(dstInfo, srcInfo));
+void SkConvertPixels(const SkImageInfo& origDstInfo,       void* dstPixels, size_t dstRB,
+                     const SkImageInfo& origSrcInfo, const void* srcPixels, size_t srcRB) {
+    SkASSERT(origDstInfo.dimensions() == origSrcInfo.dimensions());
+    SkASSERT(SkImageInfoValidConversion(origDstInfo, origSrcInfo));
+
+    // Every conversion works pixel by pixel, so when neither buffer has any padding between rows
+    // we can treat them as one long row. That saves the per-row overhead and leaves only one
+    // partial tail for the SIMD loops, which matters most for narrow images.
+    SkImageInfo dstInfo = origDstInfo,
+                srcInfo = origSrcInfo;
+    int64_t pixelCount = sk_64_mul(srcInfo.width(), srcInfo.height());
+    if (srcInfo.height() > 1 && pixelCount <= SK_MaxS32 &&
+        srcRB == srcInfo.minRowBytes() && dstRB == dstInfo.minRowBytes()) {
+        dstInfo = dstInfo.makeWH((int)pixelCount, 1);
+        srcInfo = srcInfo.makeWH((int)pixelCount, 1);
+        dstRB = dstInfo.minRowBytes();
+        srcRB = srcInfo.minRowBytes();
+    }
 
     SkColorSpaceXformSteps steps{srcInfo.colorSpace(), srcInfo.alphaType(),
                                  dstInfo.colorSpace(), dstInfo.alphaType()};
@@ -141,27 +141,6 @@ private:
     typedef SkShaderBlitter INHERITED;
 };
 
-///////////////////////////////////////////////////////////////////////////////////////////////////
-
-typedef void (*SkS32D16BlendProc)(uint16_t*, const SkPMColor*, int, uint8_t);
-
-class SkRGB565_Shader_Blitter : public SkShaderBlitter {
-public:
-    SkRGB565_Shader_Blitter(const SkPixmap& device, const SkPaint&, SkShaderBase::Context*);
-    ~SkRGB565_Shader_Blitter() override;
-    void blitH(int x, int y, int width) override;
-    void blitAntiH(int x, int y, const SkAlpha[], const int16_t[]) override;
-
-    static bool Supports(const SkPixmap& device, const SkPaint&);
-
-private:
-    SkPMColor*          fBuffer;
-    SkS32D16BlendProc   fBlend;
-    SkS32D16BlendProc   fBlendCoverage;
-
-    typedef SkShaderBlitter INHERITED;
-};
-
 ///////////////////////////////////////////////////////////////////////////////
 
 // Neither of these ever returns nullptr, but this first factory may return a SkNullBlitter.
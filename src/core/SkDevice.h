@@ -18,6 +18,7 @@ class SkBitmap;
 struct SkDrawShadowRec;
 class SkGlyphRun;
 class SkGlyphRunList;
+class SkImageFilter;
 class SkImageFilterCache;
 struct SkIRect;
 class SkMatrix;
@@ -240,6 +241,10 @@ protected:
 
     virtual void drawDrawable(SkDrawable*, const SkMatrix*, SkCanvas*);
 
+    // Draws the picture from a retained rendering of it, or returns false if the caller should
+    // play it back instead.
+    virtual bool drawRetainedPicture(const SkPicture*, const SkMatrix*) { return false; }
+
     virtual void drawSpecial(SkSpecialImage*, int x, int y, const SkPaint&,
                              SkImage* clipImage, const SkMatrix& clipMatrix);
     virtual sk_sp<SkSpecialImage> makeSpecial(const SkBitmap&);
@@ -363,7 +368,11 @@ private:
      */
     virtual void flush() {}
 
-    virtual SkImageFilterCache* getImageFilterCache() { return nullptr; }
+    // Returns the cache to use while filtering with dag, clipped to clipBounds.
+    virtual SkImageFilterCache* getImageFilterCache(const SkImageFilter* dag,
+                                                    const SkIRect& clipBounds, SkColorType) {
+        return nullptr;
+    }
 
     friend class SkNoPixelsDevice;
     friend class SkBitmapDevice;
@@ -304,18 +304,17 @@ void SkDraw::drawVertices(SkVertices::VertexMode vmode, int vertexCount,
                 SkScan::FillTriangle(tmp, *fRC, blitter);
             }
         } else {
+            // Neighboring triangles often share their texture mapping, e.g. the two halves of
+            // each drawAtlas() sprite, or a whole mesh whose texture coordinates are an affine
+            // image of its positions. They can share a blitter too: the tricolor matrix is read
+            // through a pointer when the pipeline runs, so only the texture mapping bakes into it.
+            SkSTArenaAlloc<2048> innerAlloc;
+            SkBlitter* blitter = nullptr;
+            SkMatrix blitterLocalM, blitterCTM;
             while (vertProc(&state)) {
-                SkSTArenaAlloc<2048> innerAlloc;
-
-                const SkMatrix* ctm = fMatrix;
-                SkMatrix tmpCtm;
-                if (textures) {
-                    SkMatrix localM;
-                    if (!texture_to_matrix(state, vertices, textures, &localM)) {
-                        continue;
-                    }
-                    tmpCtm = SkMatrix::Concat(*fMatrix, localM);
-                    ctm = &tmpCtm;
+                SkMatrix localM;
+                if (!texture_to_matrix(state, vertices, textures, &localM)) {
+                    continue;
                 }
 
                 if (matrix43 && !update_tricolor_matrix(ctmInv, vertices, dstColors,
@@ -324,10 +323,16 @@ void SkDraw::drawVertices(SkVertices::VertexMode vmode, int vertexCount,
                     continue;
                 }
 
+                if (!blitter || localM != blitterLocalM) {
+                    innerAlloc.reset();
+                    blitterLocalM = localM;
+                    blitterCTM = SkMatrix::Concat(*fMatrix, localM);
+                    blitter = SkCreateRasterPipelineBlitter(fDst, p, blitterCTM, &innerAlloc);
+                }
+
                 SkPoint tmp[] = {
                     devVerts[state.f0], devVerts[state.f1], devVerts[state.f2]
                 };
-                auto blitter = SkCreateRasterPipelineBlitter(fDst, p, *ctm, &innerAlloc);
                 SkScan::FillTriangle(tmp, *fRC, blitter);
             }
         }
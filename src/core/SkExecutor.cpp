@@ -11,6 +11,7 @@
 #include "SkSemaphore.h"
 #include "SkSpinlock.h"
 #include "SkTArray.h"
+#include <atomic>
 #include <deque>
 #include <thread>
 
@@ -131,6 +132,252 @@ private:
     SkSemaphore           fWorkAvailable;
 };
 
+// A Chase-Lev work-stealing deque.  Only the owning thread may push() and pop() at the bottom,
+// while any thread may steal() from the top.  No locks are taken on either side.
+// See Lê et al., "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013.
+class SkWorkStealingDeque {
+public:
+    using Work = std::function<void(void)>;
+
+    SkWorkStealingDeque() : fTop(0), fBottom(0), fArray(new Array(kInitialLog2Capacity)) {}
+
+    ~SkWorkStealingDeque() {
+        // Nobody else can be touching us now, so relaxed loads are fine.
+        Array* array = fArray.load(std::memory_order_relaxed);
+        for (int64_t i = fTop.load(std::memory_order_relaxed),
+                     b = fBottom.load(std::memory_order_relaxed); i < b; i++) {
+            delete array->get(i);
+        }
+        delete array;
+    }
+
+    // Owner only.
+    void push(Work* work) {
+        int64_t b = fBottom.load(std::memory_order_relaxed),
+                t = fTop   .load(std::memory_order_acquire);
+        Array* array = fArray.load(std::memory_order_relaxed);
+        if (b - t > array->capacity() - 1) {
+            array = this->grow(array, t, b);
+        }
+        array->put(b, work);
+        std::atomic_thread_fence(std::memory_order_release);
+        fBottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only.  Returns nullptr if the deque is empty.
+    Work* pop() {
+        int64_t b = fBottom.load(std::memory_order_relaxed) - 1;
+        Array* array = fArray.load(std::memory_order_relaxed);
+        fBottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = fTop.load(std::memory_order_relaxed);
+
+        Work* work = nullptr;
+        if (t <= b) {
+            work = array->get(b);
+            if (t == b) {
+                // This was the last item, so we race against steal() for it.
+                if (!fTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                            std::memory_order_relaxed)) {
+                    work = nullptr;
+                }
+                fBottom.store(b + 1, std::memory_order_relaxed);
+            }
+        } else {
+            fBottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return work;
+    }
+
+    // Any thread.  Returns nullptr if the deque is empty or we lost a race for its top.
+    Work* steal() {
+        int64_t t = fTop.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = fBottom.load(std::memory_order_acquire);
+
+        if (t < b) {
+            Array* array = fArray.load(std::memory_order_acquire);
+            Work* work = array->get(t);
+            if (fTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                       std::memory_order_relaxed)) {
+                return work;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    static constexpr int kInitialLog2Capacity = 8;
+
+    class Array {
+    public:
+        explicit Array(int log2Capacity)
+            : fMask((int64_t(1) << log2Capacity) - 1)
+            , fLog2Capacity(log2Capacity)
+            , fSlots(new std::atomic<Work*>[fMask + 1]) {}
+
+        int64_t capacity() const { return fMask + 1; }
+        int     log2Capacity() const { return fLog2Capacity; }
+
+        Work* get(int64_t i) const {
+            return fSlots[i & fMask].load(std::memory_order_acquire);
+        }
+        void put(int64_t i, Work* work) {
+            fSlots[i & fMask].store(work, std::memory_order_release);
+        }
+
+    private:
+        int64_t                                fMask;
+        int                                    fLog2Capacity;
+        std::unique_ptr<std::atomic<Work*>[]>  fSlots;
+    };
+
+    Array* grow(Array* array, int64_t t, int64_t b) {
+        Array* bigger = new Array(array->log2Capacity() + 1);
+        for (int64_t i = t; i < b; i++) {
+            bigger->put(i, array->get(i));
+        }
+        fArray.store(bigger, std::memory_order_release);
+        // A thief may still be reading from the old array, so we keep it around until we die.
+        fRetired.emplace_back(array);
+        return bigger;
+    }
+
+    std::atomic<int64_t>             fTop;
+    std::atomic<int64_t>             fBottom;
+    std::atomic<Array*>              fArray;
+    SkTArray<std::unique_ptr<Array>> fRetired;
+};
+
+// An SkWorkStealingThreadPool gives each of its threads its own SkWorkStealingDeque.
+// Work added from a pool thread goes to that thread's own deque, work added from any other
+// thread goes to a shared injection queue, and idle threads steal from each other.
+class SkWorkStealingThreadPool final : public SkExecutor {
+public:
+    explicit SkWorkStealingThreadPool(int threads)
+        : fDeques(new SkWorkStealingDeque[threads])
+        , fDequeCount(threads) {
+        // Make sure every thread ID is known before any thread can look for its own deque.
+        SkAutoExclusive lock(fStartupLock);
+        for (int i = 0; i < threads; i++) {
+            fThreads.emplace_back(&Loop, this, i);
+            fThreadIDs.push_back(fThreads.back().get_id());
+        }
+    }
+
+    ~SkWorkStealingThreadPool() override {
+        // Signal each thread that it's time to shut down.
+        for (int i = 0; i < fThreads.count(); i++) {
+            this->add(nullptr);
+        }
+        // Wait for each thread to shut down.
+        for (int i = 0; i < fThreads.count(); i++) {
+            fThreads[i].join();
+        }
+        // Anything left in the injection queue was never run; clean it up.
+        for (auto work : fInjected) {
+            delete work;
+        }
+    }
+
+    void add(std::function<void(void)> work) override {
+        auto boxed = new std::function<void(void)>(std::move(work));
+
+        int self = this->currentThreadIndex();
+        if (self >= 0 && *boxed) {
+            fDeques[self].push(boxed);
+        } else {
+            // Shutdown signals always go through the injection queue,
+            // which any thread may find once it's out of local work.
+            SkAutoExclusive lock(fInjectedLock);
+            fInjected.emplace_back(boxed);
+        }
+        // Each signal promises exactly one piece of work to exactly one waiter.
+        fWorkAvailable.signal(1);
+    }
+
+    void borrow() override {
+        // If there is work waiting, do it.
+        if (fWorkAvailable.try_wait()) {
+            SkAssertResult(this->do_work(this->currentThreadIndex()));
+        }
+    }
+
+private:
+    // Returns the index of the calling thread in this pool, or -1 if it isn't one of ours.
+    int currentThreadIndex() const {
+        std::thread::id me = std::this_thread::get_id();
+        for (int i = 0; i < fThreadIDs.count(); i++) {
+            if (fThreadIDs[i] == me) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // Find one piece of work: our own deque first, then the injection queue, then steal.
+    std::function<void(void)>* find_work(int self) {
+        const int N = fDequeCount;
+        for (;;) {
+            if (self >= 0) {
+                if (auto work = fDeques[self].pop()) {
+                    return work;
+                }
+            }
+            {
+                SkAutoExclusive lock(fInjectedLock);
+                if (!fInjected.empty()) {
+                    auto work = fInjected.front();
+                    fInjected.pop_front();
+                    return work;
+                }
+            }
+            // Start stealing just past ourselves to spread thieves across victims.
+            for (int i = 1; i <= N; i++) {
+                int victim = (self + i + N) % N;
+                if (victim != self) {
+                    if (auto work = fDeques[victim].steal()) {
+                        return work;
+                    }
+                }
+            }
+            // We've been promised work, but someone else got there first or it's
+            // still being published.  Keep looking.
+            std::this_thread::yield();
+        }
+    }
+
+    // This method should be called only when fWorkAvailable indicates there's work to do.
+    bool do_work(int self) {
+        std::unique_ptr<std::function<void(void)>> work(this->find_work(self));
+        if (!*work) {
+            return false;  // This is Loop()'s signal to shut down.
+        }
+        (*work)();
+        return true;
+    }
+
+    static void Loop(SkWorkStealingThreadPool* pool, int self) {
+        {
+            SkAutoExclusive lock(pool->fStartupLock);
+        }
+        do {
+            pool->fWorkAvailable.wait();
+        } while (pool->do_work(self));
+    }
+
+    using WorkList = std::deque<std::function<void(void)>*>;
+
+    SkTArray<std::thread>                  fThreads;
+    SkTArray<std::thread::id>              fThreadIDs;
+    std::unique_ptr<SkWorkStealingDeque[]> fDeques;
+    int                                    fDequeCount;
+    SkMutex                                fStartupLock;
+    WorkList                               fInjected;
+    SkMutex                                fInjectedLock;
+    SkSemaphore                            fWorkAvailable;
+};
+
 std::unique_ptr<SkExecutor> SkExecutor::MakeFIFOThreadPool(int threads) {
     using WorkList = std::deque<std::function<void(void)>>;
     return skstd::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores());
@@ -139,3 +386,6 @@ std::unique_ptr<SkExecutor> SkExecutor::MakeLIFOThreadPool(int threads) {
     using WorkList = SkTArray<std::function<void(void)>>;
     return skstd::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores());
 }
+std::unique_ptr<SkExecutor> SkExecutor::MakeWorkStealingThreadPool(int threads) {
+    return skstd::make_unique<SkWorkStealingThreadPool>(threads > 0 ? threads : num_cores());
+}
@@ -228,17 +228,23 @@ void SkGlyphRunListPainter::drawForBitmapDevice(
             matrix.postTranslate(rounding.x(), rounding.y());
             matrix.mapPoints(fPositions, glyphRun.positions().data(), runSize);
 
+            // Glyphs outside of device space are skipped along with the non-finite ones.
+            for (size_t i = 0; i < runSize; i++) {
+                if (!check_glyph_position(fPositions[i])) {
+                    fPositions[i] = {SK_ScalarNaN, SK_ScalarNaN};
+                }
+            }
+            // Make all the missing glyphs of the run at once, rather than asking for them one by
+            // one as the masks are built.
+            int drawableGlyphCount = cache->prepareForDrawing(
+                    glyphRun.glyphsIDs().data(), fPositions, SkToInt(runSize), fGlyphPos);
+
             SkTDArray<SkMask> masks;
-            masks.setReserve(runSize);
-            const SkPoint* positionCursor = fPositions;
-            for (auto glyphID : glyphRun.glyphsIDs()) {
-                auto position = *positionCursor++;
-                if (check_glyph_position(position)) {
-                    const SkGlyph& glyph = cache->getGlyphMetrics(glyphID, position);
-                    const void* image;
-                    if (!glyph.isEmpty() && (image = cache->findImage(glyph))) {
-                        masks.push_back(create_mask(glyph, position, image));
-                    }
+            masks.setReserve(drawableGlyphCount);
+            for (int i = 0; i < drawableGlyphCount; i++) {
+                const SkGlyphPos& glyphPos = fGlyphPos[i];
+                if (const void* image = glyphPos.glyph->fImage) {
+                    masks.push_back(create_mask(*glyphPos.glyph, glyphPos.position, image));
                 }
             }
             bitmapDevice->paintMasks(SkSpan<const SkMask>{masks.begin(), masks.size()}, runPaint);
@@ -821,6 +827,7 @@ void GrTextBlob::generateFromGlyphRunList(const GrShaderCaps& shaderCaps,
     const SkPaint& runPaint = glyphRunList.paint();
     this->initReusableBlob(SkPaintPriv::ComputeLuminanceColor(runPaint), viewMatrix,
                            origin.x(), origin.y());
+    fCaptureGlyphImages = options.fCaptureGlyphImages;
 
     glyphPainter->processGlyphRunList(glyphRunList,
                                       viewMatrix,
@@ -853,6 +860,7 @@ void GrTextBlob::processDeviceMasks(SkSpan<const SkGlyphPos> masks,
                    SkScalarFloorToScalar(mask.position.fY)};
         run->appendDeviceSpaceGlyph(currStrike, *mask.glyph, pt);
     }
+    this->captureGlyphImages(masks, strike, currStrike.get());
 }
 
 void GrTextBlob::processSourcePaths(SkSpan<const SkGlyphPos> paths,
@@ -893,7 +901,8 @@ void GrTextBlob::processSourceSDFT(SkSpan<const SkGlyphPos> masks,
     run->setSubRunHasDistanceFields(
             runFont.getEdging() == SkFont::Edging::kSubpixelAntiAlias,
             runFont.hasSomeAntiAliasing(),
-            hasWCoord);
+            hasWCoord,
+            fStrikeCache->multiChannelDistanceFields());
     this->setMinAndMaxScale(minScale, maxScale);
     run->setupFont(strike->strikeSpec());
     sk_sp<GrTextStrike> currStrike = fStrikeCache->getStrike(strike->getDescriptor());
@@ -901,6 +910,7 @@ void GrTextBlob::processSourceSDFT(SkSpan<const SkGlyphPos> masks,
         run->appendSourceSpaceGlyph(
                 currStrike, *mask.glyph, mask.position, cacheToSourceScale);
     }
+    this->captureGlyphImages(masks, strike, currStrike.get());
 }
 
 void GrTextBlob::processSourceFallback(SkSpan<const SkGlyphPos> masks,
@@ -920,6 +930,7 @@ void GrTextBlob::processSourceFallback(SkSpan<const SkGlyphPos> masks,
         run->appendSourceSpaceGlyph
                 (grStrike, *mask.glyph, mask.position, cacheToSourceScale);
     }
+    this->captureGlyphImages(masks, strike, grStrike.get());
 }
 
 void GrTextBlob::processDeviceFallback(SkSpan<const SkGlyphPos> masks,
@@ -933,6 +944,18 @@ void GrTextBlob::processDeviceFallback(SkSpan<const SkGlyphPos> masks,
     for (const auto& mask : masks) {
         run->appendDeviceSpaceGlyph(grStrike, *mask.glyph, mask.position);
     }
+    this->captureGlyphImages(masks, strike, grStrike.get());
+}
+
+void GrTextBlob::captureGlyphImages(SkSpan<const SkGlyphPos> masks, SkStrikeInterface* strike,
+                                    GrTextStrike* grStrike) {
+    if (!fCaptureGlyphImages) {
+        return;
+    }
+    for (const auto& mask : masks) {
+        grStrike->captureGlyphImage(grStrike->getGlyph(*mask.glyph), *mask.glyph, strike,
+                                    fStrikeCache->getMasks());
+    }
 }
 
 #if GR_TEST_UTILS
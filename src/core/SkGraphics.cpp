@@ -10,6 +10,7 @@
 #include "SkBlitter.h"
 #include "SkCanvas.h"
 #include "SkCpu.h"
+#include "SkData.h"
 #include "SkGeometry.h"
 #include "SkImageFilter.h"
 #include "SkMath.h"
@@ -133,6 +134,14 @@ int SkGraphics::GetFontCacheCountUsed() {
     return SkStrikeCache::GlobalStrikeCache()->getCacheCountUsed();
 }
 
+int64_t SkGraphics::GetFontCacheHitCount() {
+    return SkStrikeCache::GlobalStrikeCache()->getLookupHits();
+}
+
+int64_t SkGraphics::GetFontCacheMissCount() {
+    return SkStrikeCache::GlobalStrikeCache()->getLookupMisses();
+}
+
 int SkGraphics::GetFontCachePointSizeLimit() {
     return SkStrikeCache::GlobalStrikeCache()->getCachePointSizeLimit();
 }
@@ -145,3 +154,13 @@ void SkGraphics::PurgeFontCache() {
     SkStrikeCache::GlobalStrikeCache()->purgeAll();
     SkTypefaceCache::PurgeAll();
 }
+
+bool SkGraphics::WriteFontCacheSnapshot(const char path[]) {
+    SkFILEWStream stream(path);
+    return stream.isValid() && SkStrikeCache::GlobalStrikeCache()->writeSnapshot(&stream);
+}
+
+bool SkGraphics::LoadFontCacheSnapshot(const char path[]) {
+    sk_sp<SkData> data = SkData::MakeFromFileName(path);
+    return data && SkStrikeCache::GlobalStrikeCache()->readSnapshot(data->data(), data->size());
+}
@@ -8,6 +8,7 @@
 #include "SkImageFilter.h"
 
 #include "SkCanvas.h"
+#include "SkExecutor.h"
 #include "SkFuzzLogging.h"
 #include "SkImageFilterCache.h"
 #include "SkLocalMatrixImageFilter.h"
@@ -17,6 +18,10 @@
 #include "SkSafe32.h"
 #include "SkSpecialImage.h"
 #include "SkSpecialSurface.h"
+#include "SkTArray.h"
+#include "SkTHash.h"
+#include "SkTaskGroup.h"
+#include "SkTemplates.h"
 #include "SkValidationUtils.h"
 #include "SkWriteBuffer.h"
 #if SK_SUPPORT_GPU
@@ -467,6 +472,51 @@ sk_sp<SkSpecialImage> SkImageFilter::filterInput(int index,
     return result;
 }
 
+void SkImageFilter::filterInputs(SkSpecialImage* src,
+                                 const Context& ctx,
+                                 sk_sp<SkSpecialImage> results[],
+                                 SkIPoint offsets[]) const {
+    const int count = this->countInputs();
+
+    // Every input is filtered with the same src and context, so an input filter that is shared
+    // by several slots (e.g. SkMergeImageFilter::Make(blur, blur)) has the same result in each.
+    SkTHashMap<const SkImageFilter*, int> firstSlot;
+    SkAutoSTMalloc<4, int> sourceSlot(count);
+    SkSTArray<4, int> distinctSlots;
+    for (int i = 0; i < count; ++i) {
+        offsets[i] = SkIPoint::Make(0, 0);
+        if (const int* first = firstSlot.find(this->getInput(i))) {
+            sourceSlot[i] = *first;
+        } else {
+            firstSlot.set(this->getInput(i), i);
+            sourceSlot[i] = i;
+            distinctSlots.push_back(i);
+        }
+    }
+
+    auto filterSlot = [&](int index) {
+        int i = distinctSlots[index];
+        results[i] = this->filterInput(i, src, ctx, &offsets[i]);
+    };
+    // GPU filters record work into a single context, so only raster branches can run in parallel.
+    if (distinctSlots.count() > 1 && !src->isTextureBacked()) {
+        SkTaskGroup taskGroup(SkExecutor::GetDefault());
+        taskGroup.batch(distinctSlots.count(), filterSlot);
+        taskGroup.wait();
+    } else {
+        for (int index = 0; index < distinctSlots.count(); ++index) {
+            filterSlot(index);
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        if (sourceSlot[i] != i) {
+            results[i] = results[sourceSlot[i]];
+            offsets[i] = offsets[sourceSlot[i]];
+        }
+    }
+}
+
 void SkImageFilter::PurgeCache() {
     SkImageFilterCache::Get()->purge();
 }
@@ -15,6 +15,7 @@
 #include "SkOpts.h"
 #include "SkRefCnt.h"
 #include "SkSpecialImage.h"
+#include "SkTArray.h"
 #include "SkTDynamicHash.h"
 #include "SkTHash.h"
 #include "SkTInternalLList.h"
@@ -158,6 +159,35 @@ SkImageFilterCache* SkImageFilterCache::Create(size_t maxBytes) {
     return new CacheImpl(maxBytes);
 }
 
+size_t SkImageFilterCache::TransientSize(const SkImageFilter* dag, const SkIRect& clipBounds,
+                                         SkColorType colorType) {
+    // Count the distinct nodes; a filter shared by several branches is only cached once.
+    SkTHashSet<const SkImageFilter*> visited;
+    SkTArray<const SkImageFilter*> stack;
+    if (dag) {
+        stack.push_back(dag);
+    }
+    while (!stack.empty()) {
+        const SkImageFilter* filter = stack.back();
+        stack.pop_back();
+        if (visited.contains(filter)) {
+            continue;
+        }
+        visited.add(filter);
+        for (int i = 0; i < filter->countInputs(); ++i) {
+            if (const SkImageFilter* input = filter->getInput(i)) {
+                stack.push_back(input);
+            }
+        }
+    }
+
+    uint64_t bytes = static_cast<uint64_t>(visited.count()) *
+                     SkColorTypeBytesPerPixel(colorType) *
+                     (clipBounds.isEmpty() ? 0 : sk_64_mul(clipBounds.width(),
+                                                           clipBounds.height()));
+    return static_cast<size_t>(SkTPin<uint64_t>(bytes, kDefaultTransientSize, kMaxTransientSize));
+}
+
 SkImageFilterCache* SkImageFilterCache::Get() {
     static SkOnce once;
     static SkImageFilterCache* cache;
@@ -8,6 +8,7 @@
 #ifndef SkImageFilterCache_DEFINED
 #define SkImageFilterCache_DEFINED
 
+#include "SkImageInfo.h"
 #include "SkMatrix.h"
 #include "SkRefCnt.h"
 
@@ -50,10 +51,17 @@ struct SkImageFilterCacheKey {
 // (result, offset).
 class SkImageFilterCache : public SkRefCnt {
 public:
-    enum { kDefaultTransientSize = 32 * 1024 * 1024 };
+    enum {
+        kDefaultTransientSize = 32 * 1024 * 1024,
+        kMaxTransientSize = 256 * 1024 * 1024,
+    };
 
     virtual ~SkImageFilterCache() {}
     static SkImageFilterCache* Create(size_t maxBytes);
+    // Returns a size for a transient cache that can hold a clip-sized result for every distinct
+    // node of the DAG, so results shared between branches are not evicted before they are reused.
+    // The size is between kDefaultTransientSize and kMaxTransientSize.
+    static size_t TransientSize(const SkImageFilter* dag, const SkIRect& clipBounds, SkColorType);
     static SkImageFilterCache* Get();
     virtual sk_sp<SkSpecialImage> get(const SkImageFilterCacheKey& key, SkIPoint* offset) const = 0;
     virtual void set(const SkImageFilterCacheKey& key, SkSpecialImage* image,
@@ -69,6 +69,18 @@ public:
         return fMap.count();
     }
 
+    int maxCount() const {
+        return fMaxCount;
+    }
+
+    // Changes the capacity, evicting the least recently used entries if there are now too many.
+    void setMaxCount(int maxCount) {
+        fMaxCount = maxCount;
+        while (fMap.count() > fMaxCount) {
+            this->remove(fLRU.tail()->fKey);
+        }
+    }
+
     template <typename Fn>  // f(V*)
     void foreach(Fn&& fn) {
         typename SkTInternalLList<Entry>::Iter iter;
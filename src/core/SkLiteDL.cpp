@@ -14,7 +14,9 @@
 #include "SkImage.h"
 #include "SkImageFilter.h"
 #include "SkMath.h"
+#include "SkLiteRecorder.h"
 #include "SkPicture.h"
+#include "SkPictureRecorder.h"
 #include "SkRSXform.h"
 #include "SkRegion.h"
 #include "SkTextBlob.h"
@@ -63,6 +65,14 @@ namespace {
     enum class Type : uint8_t { TYPES(M) };
 #undef M
 
+    // Ops which only change the matrix or clip.  They have no effect past the next restore().
+    static constexpr bool is_state_op(Type type) {
+        return type == Type::Save      || type == Type::Restore  ||
+               type == Type::Concat    || type == Type::SetMatrix || type == Type::Translate ||
+               type == Type::ClipPath  || type == Type::ClipRect  || type == Type::ClipRRect ||
+               type == Type::ClipRegion;
+    }
+
     struct Op {
         uint32_t type :  8;
         uint32_t skip : 24;
@@ -483,6 +493,9 @@ void* SkLiteDL::push(size_t pod, Args&&... args) {
     new (op) T{ std::forward<Args>(args)... };
     op->type = (uint32_t)T::kType;
     op->skip = skip;
+    if (!is_state_op(T::kType)) {
+        fDrawnUntil = fUsed;
+    }
     return op+1;
 }
 
@@ -502,14 +515,32 @@ inline void SkLiteDL::map(const Fn fns[], Args... args) const {
 
 void SkLiteDL::flush() { this->push<Flush>(0); }
 
-void SkLiteDL::   save() { this->push   <Save>(0); }
-void SkLiteDL::restore() { this->push<Restore>(0); }
+constexpr size_t SkLiteDL::kKeepSave;
+
+void SkLiteDL::save() {
+    fSaveOffsets.push_back(fUsed);
+    this->push<Save>(0);
+}
+void SkLiteDL::restore() {
+    if (!fSaveOffsets.isEmpty()) {
+        size_t offset;
+        fSaveOffsets.pop(&offset);
+        if (offset != kKeepSave && fDrawnUntil <= offset) {
+            // Nothing has been drawn since the save(), so it and the state ops after it are noops.
+            this->rewind(offset);
+            return;
+        }
+    }
+    this->push<Restore>(0);
+}
 void SkLiteDL::saveLayer(const SkRect* bounds, const SkPaint* paint,
                          const SkImageFilter* backdrop, const SkImage* clipMask,
                          const SkMatrix* clipMatrix, SkCanvas::SaveLayerFlags flags) {
+    fSaveOffsets.push_back(kKeepSave);
     this->push<SaveLayer>(0, bounds, paint, backdrop, clipMask, clipMatrix, flags);
 }
 void SkLiteDL::saveBehind(const SkRect* subset) {
+    fSaveOffsets.push_back(kKeepSave);
     this->push<SaveBehind>(0, subset);
 }
 
@@ -668,6 +699,33 @@ void SkLiteDL::draw(SkCanvas* canvas) const {
     this->map(draw_fns, canvas, canvas->getTotalMatrix());
 }
 
+sk_sp<SkPicture> SkLiteDL::makePicture(const SkRect& cullRect, SkBBHFactory* bbhFactory) const {
+    SkPictureRecorder recorder;
+    this->draw(recorder.beginRecording(cullRect, bbhFactory));
+    return recorder.finishRecordingAsPicture();
+}
+
+std::unique_ptr<SkLiteDL> SkLiteDL::MakeFromPicture(const SkPicture& picture) {
+    std::unique_ptr<SkLiteDL> dl(new SkLiteDL);
+    SkLiteRecorder recorder;
+    recorder.reset(dl.get(), picture.cullRect().roundOut());
+    picture.playback(&recorder);
+    return dl;
+}
+
+void SkLiteDL::rewind(size_t offset) {
+    SkASSERT(offset <= fUsed);
+    auto end = fBytes.get() + fUsed;
+    for (uint8_t* ptr = fBytes.get() + offset; ptr < end; ) {
+        auto op = (const Op*)ptr;
+        if (auto fn = dtor_fns[op->type]) {
+            fn(op);
+        }
+        ptr += op->skip;
+    }
+    fUsed = offset;
+}
+
 SkLiteDL::~SkLiteDL() {
     this->reset();
 }
@@ -677,4 +735,6 @@ void SkLiteDL::reset() {
 
     // Leave fBytes and fReserved alone.
     fUsed   = 0;
+    fSaveOffsets.rewind();
+    fDrawnUntil = 0;
 }
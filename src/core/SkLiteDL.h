@@ -16,12 +16,24 @@
 #include "SkTDArray.h"
 #include "SkTemplates.h"
 
+class SkBBHFactory;
+
 class SkLiteDL final {
 public:
     ~SkLiteDL();
 
+    /** Returns a display list with the ops of the picture. */
+    static std::unique_ptr<SkLiteDL> MakeFromPicture(const SkPicture&);
+
     void draw(SkCanvas* canvas) const;
 
+    /**
+     *  Records this display list into an SkPicture, e.g. to serialize it, or to build a bounding
+     *  box hierarchy with bbhFactory for culled playback. The picture goes through the usual
+     *  SkRecordOptimize passes.
+     */
+    sk_sp<SkPicture> makePicture(const SkRect& cullRect, SkBBHFactory* bbhFactory = nullptr) const;
+
     void reset();
     bool empty() const { return fUsed == 0; }
 
@@ -84,9 +96,19 @@ private:
     template <typename Fn, typename... Args>
     void map(const Fn[], Args...) const;
 
+    // Destroys the ops recorded at or after offset, and drops them.
+    void rewind(size_t offset);
+
     SkAutoTMalloc<uint8_t> fBytes;
     size_t                 fUsed = 0;
     size_t                 fReserved = 0;
+
+    // The offsets of the open save() ops, or kKeepSave for those which may not be dropped.
+    // A save() whose restore() comes before any drawing op is removed with everything after it.
+    static constexpr size_t kKeepSave = ~(size_t)0;
+    SkTDArray<size_t>      fSaveOffsets;
+    // The offset just past the last op which draws anything.
+    size_t                 fDrawnUntil = 0;
 };
 
 #endif//SkLiteDL_DEFINED
@@ -7,11 +7,11 @@
 
 #include "SkMaskBlurFilter.h"
 
-#include "SkArenaAlloc.h"
 #include "SkColorPriv.h"
 #include "SkGaussFilter.h"
 #include "SkMalloc.h"
 #include "SkNx.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkTo.h"
 
@@ -248,9 +248,14 @@ public:
 //
 //   window = floor(sigma * 3 * sqrt(2 * kPi) / 4 + 0.5)
 //   For window <= 255, the largest value for sigma is 136.
+//
+// Larger sigmas are blurred on a downsampled copy of the mask, up to kMaxSigma.
+static constexpr double kMaxScanSigma = 136.0;
+static constexpr double kMaxSigma = 16 * kMaxScanSigma;
+
 SkMaskBlurFilter::SkMaskBlurFilter(double sigmaW, double sigmaH)
-    : fSigmaW{SkTPin(sigmaW, 0.0, 136.0)}
-    , fSigmaH{SkTPin(sigmaH, 0.0, 136.0)}
+    : fSigmaW{SkTPin(sigmaW, 0.0, kMaxSigma)}
+    , fSigmaH{SkTPin(sigmaH, 0.0, kMaxSigma)}
 {
     SkASSERT(sigmaW >= 0);
     SkASSERT(sigmaH >= 0);
@@ -949,17 +954,234 @@ static SkIPoint small_blur(double sigmaX, double sigmaY, const SkMask& src, SkMa
     return {radiusX, radiusY};
 }
 
+// Bands of rows are handed to the executor once a pass touches at least this many pixels.
+static constexpr int64_t kMinParallelPixels = 256 * 256;
+static constexpr int kRowsPerBand = 64;
+
+// Calls fn(begin, end) over the rows [0, rowCount), splitting them into bands run on the
+// executor if the pass is big enough. Each row of a pass is an independent 1D scan, so the
+// bands need no overlap and the result does not depend on how the rows are split.
+template <typename Fn>
+static void for_each_band(SkExecutor* executor, int rowCount, int rowWidth, Fn&& fn) {
+    if (executor && rowCount > kRowsPerBand &&
+        static_cast<int64_t>(rowCount) * rowWidth >= kMinParallelPixels) {
+        const int bands = (rowCount + kRowsPerBand - 1) / kRowsPerBand;
+        SkTaskGroup taskGroup(*executor);
+        taskGroup.batch(bands, [&](int band) {
+            int begin = band * kRowsPerBand;
+            fn(begin, SkTMin(begin + kRowsPerBand, rowCount));
+        });
+        taskGroup.wait();
+    } else {
+        fn(0, rowCount);
+    }
+}
+
+// Blur the src rows [y0, y1) horizontally, writing them transposed into columns of tmp.
+static void blur_rows_and_transpose(const PlanGauss::Scan& scanW, const SkMask& src,
+                                    int y0, int y1, uint8_t* tmp, int tmpW, int tmpH) {
+    int srcW = src.fBounds.width();
+    const uint8_t* row = src.fImage + y0 * static_cast<size_t>(src.fRowBytes);
+    switch (src.fFormat) {
+        case SkMask::kBW_Format: {
+            auto start = SkMask::AlphaIter<SkMask::kBW_Format>(row, 0);
+            auto end = SkMask::AlphaIter<SkMask::kBW_Format>(row + (srcW / 8), srcW % 8);
+            for (int y = y0; y < y1; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
+                auto tmpStart = &tmp[y];
+                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
+            }
+        } break;
+        case SkMask::kA8_Format: {
+            auto start = SkMask::AlphaIter<SkMask::kA8_Format>(row);
+            auto end = SkMask::AlphaIter<SkMask::kA8_Format>(row + srcW);
+            for (int y = y0; y < y1; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
+                auto tmpStart = &tmp[y];
+                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
+            }
+        } break;
+        case SkMask::kARGB32_Format: {
+            const uint32_t* argbStart = reinterpret_cast<const uint32_t*>(row);
+            auto start = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart);
+            auto end = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart + srcW);
+            for (int y = y0; y < y1; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
+                auto tmpStart = &tmp[y];
+                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
+            }
+        } break;
+        case SkMask::kLCD16_Format: {
+            const uint16_t* lcdStart = reinterpret_cast<const uint16_t*>(row);
+            auto start = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart);
+            auto end = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart + srcW);
+            for (int y = y0; y < y1; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
+                auto tmpStart = &tmp[y];
+                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
+            }
+        } break;
+        default:
+            SK_ABORT("Unhandled format.");
+    }
+}
+
+// Sum the alpha of one src row into sums, scale adjacent pixels to a sum.
+template <typename AlphaIter>
+static void sum_row(AlphaIter src, int srcW, int scale, uint32_t* sums) {
+    for (int x = 0; x < srcW; ++x, ++src) {
+        sums[x / scale] += *src;
+    }
+}
+
+// Box filter src down by scale into an A8 image. Pixels past the edge of src count as zero, the
+// same as they do for the blur.
+static void downsample_mask(const SkMask& src, int scale, uint8_t* small, int smallW, int smallH,
+                            SkExecutor* executor) {
+    int srcW = src.fBounds.width(),
+        srcH = src.fBounds.height();
+    uint32_t area = scale * scale;
+
+    for_each_band(executor, smallH, smallW, [&](int begin, int end) {
+        SkAutoTMalloc<uint32_t> sums(smallW);
+        for (int sy = begin; sy < end; ++sy) {
+            sk_bzero(sums.get(), smallW * sizeof(uint32_t));
+            for (int y = sy * scale; y < SkTMin((sy + 1) * scale, srcH); ++y) {
+                const uint8_t* row = src.fImage + y * static_cast<size_t>(src.fRowBytes);
+                switch (src.fFormat) {
+                    case SkMask::kBW_Format:
+                        sum_row(SkMask::AlphaIter<SkMask::kBW_Format>(row, 0),
+                                srcW, scale, sums.get());
+                        break;
+                    case SkMask::kA8_Format:
+                        sum_row(SkMask::AlphaIter<SkMask::kA8_Format>(row),
+                                srcW, scale, sums.get());
+                        break;
+                    case SkMask::kARGB32_Format:
+                        sum_row(SkMask::AlphaIter<SkMask::kARGB32_Format>(
+                                        reinterpret_cast<const uint32_t*>(row)),
+                                srcW, scale, sums.get());
+                        break;
+                    case SkMask::kLCD16_Format:
+                        sum_row(SkMask::AlphaIter<SkMask::kLCD16_Format>(
+                                        reinterpret_cast<const uint16_t*>(row)),
+                                srcW, scale, sums.get());
+                        break;
+                    default:
+                        SK_ABORT("Unhandled format.");
+                }
+            }
+            uint8_t* smallRow = small + sy * static_cast<size_t>(smallW);
+            for (int sx = 0; sx < smallW; ++sx) {
+                smallRow[sx] = SkTo<uint8_t>((sums[sx] + area / 2) / area);
+            }
+        }
+    });
+}
+
+// Bilinearly scale the blurred small mask up by scale into dst. Pixel i of small covers the dst
+// pixels [i * scale, (i + 1) * scale).
+static void upsample_mask(const SkMask& small, int scale, SkMask* dst, SkExecutor* executor) {
+    int smallW = small.fBounds.width(),
+        smallH = small.fBounds.height(),
+        dstW = dst->fBounds.width(),
+        dstH = dst->fBounds.height();
+
+    auto sample = [scale](int d, int limit, int* i0, int* i1, float* t) {
+        float u = SkTPin((d + 0.5f) / scale - 0.5f, 0.0f, static_cast<float>(limit - 1));
+        *i0 = static_cast<int>(u);
+        *i1 = SkTMin(*i0 + 1, limit - 1);
+        *t  = u - *i0;
+    };
+
+    SkAutoTMalloc<int>   x0s(dstW), x1s(dstW);
+    SkAutoTMalloc<float> fxs(dstW);
+    for (int x = 0; x < dstW; ++x) {
+        sample(x, smallW, &x0s[x], &x1s[x], &fxs[x]);
+    }
+
+    for_each_band(executor, dstH, dstW, [&](int begin, int end) {
+        for (int y = begin; y < end; ++y) {
+            int y0, y1;
+            float fy;
+            sample(y, smallH, &y0, &y1, &fy);
+            const uint8_t* row0 = small.fImage + y0 * static_cast<size_t>(small.fRowBytes);
+            const uint8_t* row1 = small.fImage + y1 * static_cast<size_t>(small.fRowBytes);
+            uint8_t* dstRow = dst->fImage + y * static_cast<size_t>(dst->fRowBytes);
+            for (int x = 0; x < dstW; ++x) {
+                float fx = fxs[x];
+                float top    = row0[x0s[x]] + (row0[x1s[x]] - row0[x0s[x]]) * fx,
+                      bottom = row1[x0s[x]] + (row1[x1s[x]] - row1[x0s[x]]) * fx;
+                dstRow[x] = static_cast<uint8_t>(top + (bottom - top) * fy + 0.5f);
+            }
+        }
+    });
+}
+
+// Sigmas too large for the sliding window sums are blurred at a lower resolution, the same way
+// SkGpuBlurUtils handles large sigmas: box filter the src down by a power of two, blur with the
+// scaled sigmas, and bilinearly scale the result back up.
+static SkIPoint downsampled_blur(double sigmaW, double sigmaH, const SkMask& src, SkMask* dst,
+                                 SkExecutor* executor) {
+    int scale = 2;
+    while (std::max(sigmaW, sigmaH) / scale > kMaxScanSigma) {
+        scale *= 2;
+    }
+
+    SkMaskBlurFilter smallFilter{sigmaW / scale, sigmaH / scale};
+
+    int smallW = (src.fBounds.width()  + scale - 1) / scale,
+        smallH = (src.fBounds.height() + scale - 1) / scale;
+
+    SkMask smallSrc;
+    smallSrc.fBounds.set(0, 0, smallW, smallH);
+    smallSrc.fRowBytes = SkTo<uint32_t>(smallW);
+    smallSrc.fFormat = SkMask::kA8_Format;
+    smallSrc.fImage = nullptr;
+
+    // Find the border of the small blur without doing any work.
+    SkMask smallDst;
+    SkIPoint smallBorder = smallFilter.blur(smallSrc, &smallDst);
+    int borderW = smallBorder.x() * scale,
+        borderH = smallBorder.y() * scale;
+
+    *dst = SkMask::PrepareDestination(borderW, borderH, src);
+    if (src.fImage == nullptr) {
+        return {borderW, borderH};
+    }
+    if (dst->fImage == nullptr) {
+        dst->fBounds.setEmpty();
+        return {0, 0};
+    }
+
+    SkAutoTMalloc<uint8_t> smallImage(smallW * static_cast<size_t>(smallH));
+    downsample_mask(src, scale, smallImage.get(), smallW, smallH, executor);
+    smallSrc.fImage = smallImage.get();
+
+    smallFilter.blur(smallSrc, &smallDst, executor);
+    SkAutoMaskFreeImage autoSmallDst(smallDst.fImage);
+    if (smallDst.fImage == nullptr) {
+        SkMask::FreeImage(dst->fImage);
+        dst->fImage = nullptr;
+        dst->fBounds.setEmpty();
+        return {0, 0};
+    }
+
+    // The small blur covers the dst exactly, except for the pixels lost rounding src up to a
+    // whole number of small pixels, which only extend the blurred edge.
+    upsample_mask(smallDst, scale, dst, executor);
+
+    return {borderW, borderH};
+}
+
 // TODO: assuming sigmaW = sigmaH. Allow different sigmas. Right now the
 // API forces the sigmas to be the same.
-SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
+SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst, SkExecutor* executor) const {
+
+    if (fSigmaW > kMaxScanSigma || fSigmaH > kMaxScanSigma) {
+        return downsampled_blur(fSigmaW, fSigmaH, src, dst, executor);
+    }
 
     if (fSigmaW < 2.0 && fSigmaH < 2.0) {
         return small_blur(fSigmaW, fSigmaH, src, dst);
     }
 
-    // 1024 is a place holder guess until more analysis can be done.
-    SkSTArenaAlloc<1024> alloc;
-
     PlanGauss planW(fSigmaW);
     PlanGauss planH(fSigmaH);
 
@@ -982,68 +1204,32 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
         dstH = dst->fBounds.height();
     SkASSERT(srcW >= 0 && srcH >= 0 && dstW >= 0 && dstH >= 0);
 
-    auto bufferSize = std::max(planW.bufferSize(), planH.bufferSize());
-    auto buffer = alloc.makeArrayDefault<uint32_t>(bufferSize);
-
     // Blur both directions.
     int tmpW = srcH,
         tmpH = dstW;
 
-    auto tmp = alloc.makeArrayDefault<uint8_t>(tmpW * tmpH);
+    SkAutoTMalloc<uint8_t> tmp(tmpW * static_cast<size_t>(tmpH));
 
-    // Blur horizontally, and transpose.
-    const PlanGauss::Scan& scanW = planW.makeBlurScan(srcW, buffer);
-    switch (src.fFormat) {
-        case SkMask::kBW_Format: {
-            const uint8_t* bwStart = src.fImage;
-            auto start = SkMask::AlphaIter<SkMask::kBW_Format>(bwStart, 0);
-            auto end = SkMask::AlphaIter<SkMask::kBW_Format>(bwStart + (srcW / 8), srcW % 8);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kA8_Format: {
-            const uint8_t* a8Start = src.fImage;
-            auto start = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start);
-            auto end = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kARGB32_Format: {
-            const uint32_t* argbStart = reinterpret_cast<const uint32_t*>(src.fImage);
-            auto start = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart);
-            auto end = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kLCD16_Format: {
-            const uint16_t* lcdStart = reinterpret_cast<const uint16_t*>(src.fImage);
-            auto start = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart);
-            auto end = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        default:
-            SK_ABORT("Unhandled format.");
-    }
+    // Blur horizontally, and transpose. Each band scans with its own window buffer.
+    for_each_band(executor, srcH, srcW, [&](int begin, int end) {
+        SkAutoTMalloc<uint32_t> buffer(planW.bufferSize());
+        const PlanGauss::Scan& scanW = planW.makeBlurScan(srcW, buffer.get());
+        blur_rows_and_transpose(scanW, src, begin, end, tmp.get(), tmpW, tmpH);
+    });
 
     // Blur vertically (scan in memory order because of the transposition),
     // and transpose back to the original orientation.
-    const PlanGauss::Scan& scanH = planH.makeBlurScan(tmpW, buffer);
-    for (int y = 0; y < tmpH; y++) {
-        auto tmpStart = &tmp[y * tmpW];
-        auto dstStart = &dst->fImage[y];
-
-        scanH.blur(tmpStart, tmpStart + tmpW,
-                   dstStart, dst->fRowBytes, dstStart + dst->fRowBytes * dstH);
-    }
+    for_each_band(executor, tmpH, tmpW, [&](int begin, int end) {
+        SkAutoTMalloc<uint32_t> buffer(planH.bufferSize());
+        const PlanGauss::Scan& scanH = planH.makeBlurScan(tmpW, buffer.get());
+        for (int y = begin; y < end; y++) {
+            auto tmpStart = &tmp[y * tmpW];
+            auto dstStart = &dst->fImage[y];
+
+            scanH.blur(tmpStart, tmpStart + tmpW,
+                       dstStart, dst->fRowBytes, dstStart + dst->fRowBytes * dstH);
+        }
+    });
 
     return {SkTo<int32_t>(borderW), SkTo<int32_t>(borderH)};
 }
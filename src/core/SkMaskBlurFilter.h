@@ -15,6 +15,8 @@
 #include "SkMask.h"
 #include "SkTypes.h"
 
+class SkExecutor;
+
 // Implement a single channel Gaussian blur. The specifics for implementation are taken from:
 // https://drafts.fxtf.org/filters/#feGaussianBlurElement
 class SkMaskBlurFilter {
@@ -26,8 +28,10 @@ public:
     // returns true iff the sigmas will result in an identity mask (no blurring)
     bool hasNoBlur() const;
 
-    // Given a src SkMask, generate dst SkMask returning the border width and height.
-    SkIPoint blur(const SkMask& src, SkMask* dst) const;
+    // Given a src SkMask, generate dst SkMask returning the border width and height. If an
+    // executor is supplied, large masks are blurred in bands of rows on it; the result is the
+    // same as blurring on the calling thread.
+    SkIPoint blur(const SkMask& src, SkMask* dst, SkExecutor* executor = nullptr) const;
 
 private:
     const double fSigmaW;
@@ -12,7 +12,9 @@
 #include "SkHalf.h"
 #include "SkImageInfoPriv.h"
 #include "SkMathPriv.h"
+#include "SkOpts.h"
 #include "SkNx.h"
+#include "SkTaskGroup.h"
 #include "SkTo.h"
 #include "SkTypes.h"
 #include <new>
@@ -78,6 +80,22 @@ struct ColorTypeFilter_F16 {
     }
 };
 
+struct ColorTypeFilter_1010102 {
+    typedef uint32_t Type;
+    static Sk4i Expand(uint32_t x) {
+        return Sk4i((x >>  0) & 0x3ff,
+                    (x >> 10) & 0x3ff,
+                    (x >> 20) & 0x3ff,
+                    (x >> 30)        );
+    }
+    static uint32_t Compact(const Sk4i& x) {
+        return (x[0] <<  0) |
+               (x[1] << 10) |
+               (x[2] << 20) |
+               (x[3] << 30);
+    }
+};
+
 template <typename T> T add_121(const T& a, const T& b, const T& c) {
     return a + b + b + c;
 }
@@ -300,6 +318,25 @@ template <typename F> void downsample_3_3(void* dst, const void* src, size_t src
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Levels at least this large are split into bands of rows when Build() is given an executor.
+static constexpr int64_t kMinParallelLevelPixels = 256 * 256;
+static constexpr int kRowsPerBand = 64;
+
+typedef void FilterProc(void*, const void* srcPtr, size_t srcRB, int count);
+
+// Filters rows [y0, y1) of dst from the rows of src above them.
+static void downsample_rows(FilterProc* proc, const SkPixmap& src, const SkPixmap& dst,
+                            int y0, int y1) {
+    const size_t srcRB = src.rowBytes();
+    const char* srcBasePtr = (const char*)src.addr() + srcRB * 2 * y0;
+    char* dstBasePtr = (char*)dst.writable_addr() + dst.rowBytes() * y0;
+    for (int y = y0; y < y1; y++) {
+        proc(dstBasePtr, srcBasePtr, srcRB, dst.width());
+        srcBasePtr += srcRB * 2; // jump two rows
+        dstBasePtr += dst.rowBytes();
+    }
+}
+
 size_t SkMipMap::AllocLevelsSize(int levelCount, size_t pixelSize) {
     if (levelCount < 0) {
         return 0;
@@ -311,9 +348,8 @@ size_t SkMipMap::AllocLevelsSize(int levelCount, size_t pixelSize) {
     return SkTo<int32_t>(size);
 }
 
-SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
-    typedef void FilterProc(void*, const void* srcPtr, size_t srcRB, int count);
-
+SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact, int levelCount,
+                          SkExecutor* executor) {
     FilterProc* proc_1_2 = nullptr;
     FilterProc* proc_1_3 = nullptr;
     FilterProc* proc_2_1 = nullptr;
@@ -329,10 +365,11 @@ SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
     switch (ct) {
         case kRGBA_8888_SkColorType:
         case kBGRA_8888_SkColorType:
+        case kRGB_888x_SkColorType:
             proc_1_2 = downsample_1_2<ColorTypeFilter_8888>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_8888>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_8888>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_8888>;
+            proc_2_2 = SkOpts::downsample_2_2_8888;
             proc_2_3 = downsample_2_3<ColorTypeFilter_8888>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_8888>;
             proc_3_2 = downsample_3_2<ColorTypeFilter_8888>;
@@ -380,6 +417,17 @@ SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
             proc_3_2 = downsample_3_2<ColorTypeFilter_F16>;
             proc_3_3 = downsample_3_3<ColorTypeFilter_F16>;
             break;
+        case kRGBA_1010102_SkColorType:
+        case kRGB_101010x_SkColorType:
+            proc_1_2 = downsample_1_2<ColorTypeFilter_1010102>;
+            proc_1_3 = downsample_1_3<ColorTypeFilter_1010102>;
+            proc_2_1 = downsample_2_1<ColorTypeFilter_1010102>;
+            proc_2_2 = downsample_2_2<ColorTypeFilter_1010102>;
+            proc_2_3 = downsample_2_3<ColorTypeFilter_1010102>;
+            proc_3_1 = downsample_3_1<ColorTypeFilter_1010102>;
+            proc_3_2 = downsample_3_2<ColorTypeFilter_1010102>;
+            proc_3_3 = downsample_3_3<ColorTypeFilter_1010102>;
+            break;
         default:
             return nullptr;
     }
@@ -389,8 +437,12 @@ SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
     }
     // whip through our loop to compute the exact size needed
     size_t size = 0;
-    int countLevels = ComputeLevelCount(src.width(), src.height());
-    for (int currentMipLevel = countLevels; currentMipLevel >= 0; currentMipLevel--) {
+    const int maxLevels = ComputeLevelCount(src.width(), src.height());
+    int countLevels = maxLevels;
+    if (kAllLevels != levelCount) {
+        countLevels = SkTPin(levelCount, 1, maxLevels);
+    }
+    for (int currentMipLevel = countLevels - 1; currentMipLevel >= 0; currentMipLevel--) {
         SkISize mipSize = ComputeLevelSize(src.width(), src.height(), currentMipLevel);
         size += SkColorTypeMinRowBytes(ct, mipSize.fWidth) * mipSize.fHeight;
     }
@@ -414,6 +466,7 @@ SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
     // init
     mipmap->fCS = sk_ref_sp(src.info().colorSpace());
     mipmap->fCount = countLevels;
+    mipmap->fComplete = (countLevels == maxLevels);
     mipmap->fLevels = (Level*)mipmap->writable_data();
     SkASSERT(mipmap->fLevels);
 
@@ -472,14 +525,17 @@ SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
                                          SkIntToScalar(height) / src.height());
 
         const SkPixmap& dstPM = levels[i].fPixmap;
-        const void* srcBasePtr = srcPM.addr();
-        void* dstBasePtr = dstPM.writable_addr();
-
-        const size_t srcRB = srcPM.rowBytes();
-        for (int y = 0; y < height; y++) {
-            proc(dstBasePtr, srcBasePtr, srcRB, width);
-            srcBasePtr = (char*)srcBasePtr + srcRB * 2; // jump two rows
-            dstBasePtr = (char*)dstBasePtr + dstPM.rowBytes();
+        if (executor && sk_64_mul(width, height) >= kMinParallelLevelPixels) {
+            // Each level depends on the one before it, but its rows are independent.
+            const int bands = (height + kRowsPerBand - 1) / kRowsPerBand;
+            SkTaskGroup taskGroup(*executor);
+            taskGroup.batch(bands, [&](int band) {
+                int y0 = band * kRowsPerBand;
+                downsample_rows(proc, srcPM, dstPM, y0, SkTMin(y0 + kRowsPerBand, height));
+            });
+            taskGroup.wait();
+        } else {
+            downsample_rows(proc, srcPM, dstPM, 0, height);
         }
         srcPM = dstPM;
         addr += height * rowBytes;
@@ -549,11 +605,7 @@ SkISize SkMipMap::ComputeLevelSize(int baseWidth, int baseHeight, int level) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-bool SkMipMap::extractLevel(const SkSize& scaleSize, Level* levelPtr) const {
-    if (nullptr == fLevels) {
-        return false;
-    }
-
+int SkMipMap::LevelForScale(const SkSize& scaleSize) {
     SkASSERT(scaleSize.width() >= 0 && scaleSize.height() >= 0);
 
 #ifndef SK_SUPPORT_LEGACY_ANISOTROPIC_MIPMAP_SCALE
@@ -567,17 +619,26 @@ bool SkMipMap::extractLevel(const SkSize& scaleSize, Level* levelPtr) const {
 #endif
 
     if (scale >= SK_Scalar1 || scale <= 0 || !SkScalarIsFinite(scale)) {
-        return false;
+        return 0;
     }
 
     SkScalar L = -SkScalarLog2(scale);
     if (!SkScalarIsFinite(L)) {
-        return false;
+        return 0;
     }
     SkASSERT(L >= 0);
     int level = SkScalarFloorToInt(L);
 
     SkASSERT(level >= 0);
+    return level;
+}
+
+bool SkMipMap::extractLevel(const SkSize& scaleSize, Level* levelPtr) const {
+    if (nullptr == fLevels) {
+        return false;
+    }
+
+    int level = LevelForScale(scaleSize);
     if (level <= 0) {
         return false;
     }
@@ -595,12 +656,13 @@ bool SkMipMap::extractLevel(const SkSize& scaleSize, Level* levelPtr) const {
 
 // Helper which extracts a pixmap from the src bitmap
 //
-SkMipMap* SkMipMap::Build(const SkBitmap& src, SkDiscardableFactoryProc fact) {
+SkMipMap* SkMipMap::Build(const SkBitmap& src, SkDiscardableFactoryProc fact, int levelCount,
+                          SkExecutor* executor) {
     SkPixmap srcPixmap;
     if (!src.peekPixels(&srcPixmap)) {
         return nullptr;
     }
-    return Build(srcPixmap, fact);
+    return Build(srcPixmap, fact, levelCount, executor);
 }
 
 int SkMipMap::countLevels() const {
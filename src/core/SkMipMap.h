@@ -17,6 +17,7 @@
 
 class SkBitmap;
 class SkDiscardableMemory;
+class SkExecutor;
 
 typedef SkDiscardableMemory* (*SkDiscardableFactoryProc)(size_t bytes);
 
@@ -29,8 +30,15 @@ typedef SkDiscardableMemory* (*SkDiscardableFactoryProc)(size_t bytes);
  */
 class SkMipMap : public SkCachedData {
 public:
-    static SkMipMap* Build(const SkPixmap& src, SkDiscardableFactoryProc);
-    static SkMipMap* Build(const SkBitmap& src, SkDiscardableFactoryProc);
+    static constexpr int kAllLevels = -1;
+
+    // If levelCount is not kAllLevels, only the first levelCount levels are built (see
+    // LevelForScale()), and the result is not complete(). If an executor is given, large levels
+    // are filtered in parallel bands of rows on it.
+    static SkMipMap* Build(const SkPixmap& src, SkDiscardableFactoryProc,
+                           int levelCount = kAllLevels, SkExecutor* = nullptr);
+    static SkMipMap* Build(const SkBitmap& src, SkDiscardableFactoryProc,
+                           int levelCount = kAllLevels, SkExecutor* = nullptr);
 
     // Determines how many levels a SkMipMap will have without creating that mipmap.
     // This does not include the base mipmap level that the user provided when
@@ -51,12 +59,19 @@ public:
         SkSize      fScale; // < 1.0
     };
 
+    // Returns the 1-based level that extractLevel() would choose for this scale, ignoring how many
+    // levels the mipmap has, or 0 if the scale does not call for a mipmap.
+    static int LevelForScale(const SkSize& scale);
+
     bool extractLevel(const SkSize& scale, Level*) const;
 
     // countLevels returns the number of mipmap levels generated (which does not
     // include the base mipmap level).
     int countLevels() const;
 
+    // False if Build() was asked to stop before the smallest level.
+    bool complete() const { return fComplete; }
+
     // |index| is an index into the generated mipmap levels. It does not include
     // the base level. So index 0 represents mipmap level 1.
     bool getLevel(int index, Level*) const;
@@ -70,6 +85,7 @@ private:
     sk_sp<SkColorSpace> fCS;
     Level*              fLevels;    // managed by the baseclass, may be null due to onDataChanged.
     int                 fCount;
+    bool                fComplete;
 
     SkMipMap(void* malloc, size_t size) : INHERITED(malloc, size) {}
     SkMipMap(size_t size, SkDiscardableMemory* dm) : INHERITED(size, dm) {}
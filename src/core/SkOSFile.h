@@ -69,6 +69,9 @@ bool    sk_isdir(const char *path);
 // Returns the number of bytes read or SIZE_MAX if failed.
 size_t sk_qread(FILE*, void* buffer, size_t count, size_t offset);
 
+// Hints that the file will mostly be read front to back, so the OS can read ahead more of it.
+void    sk_fadvise_sequential(FILE*);
+
 
 // Create a new directory at this path; returns true if successful.
 // If the directory already existed, this will return true.
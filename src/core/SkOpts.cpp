@@ -40,6 +40,9 @@
 #include "SkBlitMask_opts.h"
 #include "SkBlitRow_opts.h"
 #include "SkChecksum_opts.h"
+#include "SkMatrix_opts.h"
+#include "SkMipMap_opts.h"
+#include "SkPngFilter_opts.h"
 #include "SkRasterPipeline_opts.h"
 #include "SkSwizzler_opts.h"
 #include "SkUtils_opts.h"
@@ -67,11 +70,30 @@ namespace SkOpts {
     DEFINE_DEFAULT(grayA_to_rgbA);
     DEFINE_DEFAULT(inverted_CMYK_to_RGB1);
     DEFINE_DEFAULT(inverted_CMYK_to_BGR1);
+    DEFINE_DEFAULT(RGB16_to_RGB1);
+    DEFINE_DEFAULT(RGB16_to_BGR1);
+    DEFINE_DEFAULT(RGBA16_to_RGBA);
+    DEFINE_DEFAULT(RGBA16_to_BGRA);
+    DEFINE_DEFAULT(RGBA16_to_rgbA);
+    DEFINE_DEFAULT(RGBA16_to_bgrA);
+
+    DEFINE_DEFAULT(png_unfilter_up);
+    DEFINE_DEFAULT(png_unfilter_sub3);
+    DEFINE_DEFAULT(png_unfilter_sub4);
+    DEFINE_DEFAULT(png_unfilter_avg3);
+    DEFINE_DEFAULT(png_unfilter_avg4);
+    DEFINE_DEFAULT(png_unfilter_paeth3);
+    DEFINE_DEFAULT(png_unfilter_paeth4);
 
     DEFINE_DEFAULT(memset16);
     DEFINE_DEFAULT(memset32);
     DEFINE_DEFAULT(memset64);
 
+    DEFINE_DEFAULT(matrix_map_affine_pts);
+    DEFINE_DEFAULT(matrix_map_persp_pts);
+
+    DEFINE_DEFAULT(downsample_2_2_8888);
+
     DEFINE_DEFAULT(hash_fn);
 
     DEFINE_DEFAULT(S32_alpha_D32_filter_DX);
@@ -97,6 +119,7 @@ namespace SkOpts {
     void Init_sse42();
     void Init_avx();
     void Init_hsw();
+    void Init_skx();
     void Init_crc32();
 
     static void init() {
@@ -118,6 +141,9 @@ namespace SkOpts {
             if (SkCpu::Supports(SkCpu::AVX)) { Init_avx();   }
             if (SkCpu::Supports(SkCpu::HSW)) { Init_hsw();   }
         #endif
+        #if SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_AVX512
+            if (SkCpu::Supports(SkCpu::SKX)) { Init_skx();   }
+        #endif
 
     #elif defined(SK_CPU_ARM64)
         if (SkCpu::Supports(SkCpu::CRC32)) { Init_crc32(); }
@@ -13,6 +13,8 @@
 #include "SkXfermodePriv.h"
 
 struct SkBitmapProcState;
+class SkMatrix;
+struct SkPoint;
 
 namespace SkOpts {
     // Call to replace pointers to portable functions with pointers to CPU-specific functions.
@@ -43,10 +45,33 @@ namespace SkOpts {
                            grayA_to_RGBA,   // i.e. expand to color channels
                            grayA_to_rgbA;   // i.e. expand to color channels and premultiply
 
+    // As above, but from big-endian 16-bit components (as in PNG), keeping their high bytes.
+    extern Swizzle_8888_u8 RGB16_to_RGB1,   // i.e. narrow and insert an opaque alpha
+                           RGB16_to_BGR1,   // i.e. narrow, swap RB and insert an opaque alpha
+                           RGBA16_to_RGBA,  // i.e. just narrow
+                           RGBA16_to_BGRA,  // i.e. narrow and swap RB
+                           RGBA16_to_rgbA,  // i.e. narrow and premultiply
+                           RGBA16_to_bgrA;  // i.e. narrow, swap RB and premultiply
+
+    // Undo a PNG row filter in place, given the previous row (already unfiltered).
+    // The 3 and 4 are bytes per pixel.
+    typedef void (*PngUnfilter)(uint8_t* row, const uint8_t* prev, int bytes);
+    extern PngUnfilter png_unfilter_up,
+                       png_unfilter_sub3,   png_unfilter_sub4,
+                       png_unfilter_avg3,   png_unfilter_avg4,
+                       png_unfilter_paeth3, png_unfilter_paeth4;
+
     extern void (*memset16)(uint16_t[], uint16_t, int);
     extern void SK_API (*memset32)(uint32_t[], uint32_t, int);
     extern void (*memset64)(uint64_t[], uint64_t, int);
 
+    // Map count points through an affine or perspective matrix (SkMatrix::mapPoints procs).
+    extern void (*matrix_map_affine_pts)(const SkMatrix&, SkPoint dst[], const SkPoint src[], int);
+    extern void (*matrix_map_persp_pts )(const SkMatrix&, SkPoint dst[], const SkPoint src[], int);
+
+    // Box filters 2x2 blocks of 8888 pixels from two rows at src into count pixels at dst.
+    extern void (*downsample_2_2_8888)(void* dst, const void* src, size_t srcRB, int count);
+
     // The fastest high quality 32-bit hash we can provide on this platform.
     extern uint32_t (*hash_fn)(const void*, size_t, uint32_t seed);
     static inline uint32_t hash(const void* data, size_t bytes, uint32_t seed=0) {
@@ -59,6 +59,7 @@ SkOverdrawCanvas::SkOverdrawCanvas(SkCanvas* canvas)
     fPaint.setAntiAlias(false);
     fPaint.setBlendMode(SkBlendMode::kPlus);
     fPaint.setColorFilter(SkColorFilter::MakeMatrixFilterRowMajor255(kIncrementAlpha));
+    fStyledPaint = fPaint;
 }
 
 void SkOverdrawCanvas::drawPosTextCommon(const SkGlyphID glyphs[], int count, const SkScalar pos[],
@@ -166,11 +167,9 @@ void SkOverdrawCanvas::onDrawVerticesObject(const SkVertices* vertices,
 void SkOverdrawCanvas::onDrawAtlas(const SkImage* image, const SkRSXform xform[],
                                    const SkRect texs[], const SkColor colors[], int count,
                                    SkBlendMode mode, const SkRect* cull, const SkPaint* paint) {
-    SkPaint* paintPtr = &fPaint;
-    SkPaint storage;
+    const SkPaint* paintPtr = &fPaint;
     if (paint) {
-        storage = this->overdrawPaint(*paint);
-        paintPtr = &storage;
+        paintPtr = &this->overdrawPaint(*paint);
     }
 
     fList[0]->onDrawAtlas(image, xform, texs, colors, count, mode, cull, paintPtr);
@@ -260,9 +259,11 @@ void SkOverdrawCanvas::onDrawShadowRec(const SkPath& path, const SkDrawShadowRec
     fList[0]->onDrawRect(bounds, fPaint);
 }
 
-inline SkPaint SkOverdrawCanvas::overdrawPaint(const SkPaint& paint) {
-    SkPaint newPaint = fPaint;
-    newPaint.setStyle(paint.getStyle());
-    newPaint.setStrokeWidth(paint.getStrokeWidth());
-    return newPaint;
+inline const SkPaint& SkOverdrawCanvas::overdrawPaint(const SkPaint& paint) {
+    if (SkPaint::kFill_Style == paint.getStyle()) {
+        return fPaint;
+    }
+    fStyledPaint.setStyle(paint.getStyle());
+    fStyledPaint.setStrokeWidth(paint.getStrokeWidth());
+    return fStyledPaint;
 }
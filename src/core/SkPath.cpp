@@ -14,6 +14,7 @@
 #include "SkMacros.h"
 #include "SkMath.h"
 #include "SkMatrixPriv.h"
+#include "SkPathContainsIndex.h"
 #include "SkPathPriv.h"
 #include "SkPathRef.h"
 #include "SkPointPriv.h"
@@ -159,6 +160,74 @@ SkPath::SkPath()
     fIsBadForDAA = false;
 }
 
+SkPath SkPath::Make(const SkPoint pts[], int pointCount,
+                    const uint8_t verbs[], int verbCount,
+                    const SkScalar conicWeights[], int conicWeightCount,
+                    FillType ft, bool isVolatile) {
+    SkPath path;
+    path.setFillType(ft);
+    path.setIsVolatile(isVolatile);
+    if (verbCount <= 0) {
+        return path;
+    }
+
+    // Walk the verbs once to check them against the points and weights, tracking where the last
+    // contour starts the same way moveTo() and close() would.
+    int expectedPoints = 0;
+    int expectedWeights = 0;
+    int lastMoveToIndex = INITIAL_LASTMOVETOINDEX_VALUE;
+    bool needMove = true;
+    for (int i = 0; i < verbCount; ++i) {
+        switch (verbs[i]) {
+            case kMove_Verb:
+                lastMoveToIndex = expectedPoints;
+                needMove = false;
+                expectedPoints += 1;
+                break;
+            case kConic_Verb:
+                expectedWeights += 1;
+                // fall through
+            case kLine_Verb:
+            case kQuad_Verb:
+            case kCubic_Verb:
+                if (needMove) {
+                    return path;
+                }
+                expectedPoints += SkPathPriv::PtsInIter(verbs[i]) - 1;
+                break;
+            case kClose_Verb:
+                if (needMove) {
+                    return path;
+                }
+                lastMoveToIndex ^= ~lastMoveToIndex >> (8 * sizeof(lastMoveToIndex) - 1);
+                break;
+            default:
+                return path;
+        }
+    }
+    if (expectedPoints != pointCount || expectedWeights != conicWeightCount) {
+        return path;
+    }
+
+    sk_sp<SkPathRef> ref(new SkPathRef);
+    ref->resetToSize(verbCount, pointCount, conicWeightCount);
+    // SkPathRef stores verbs back to front.
+    uint8_t* dstVerbs = ref->verbsMemWritable();
+    for (int i = 0; i < verbCount; ++i) {
+        dstVerbs[verbCount - 1 - i] = verbs[i];
+    }
+    sk_careful_memcpy(ref->fPoints, pts, pointCount * sizeof(SkPoint));
+    sk_careful_memcpy(ref->fConicWeights.begin(), conicWeights,
+                      conicWeightCount * sizeof(SkScalar));
+    ref->fSegmentMask = ref->computeSegmentMask();
+    ref->computeBounds();
+
+    path.fPathRef = std::move(ref);
+    path.fLastMoveToIndex = lastMoveToIndex;
+    SkDEBUGCODE(path.validate();)
+    return path;
+}
+
 void SkPath::resetFields() {
     //fPathRef is assumed to have been emptied by the caller.
     fLastMoveToIndex = INITIAL_LASTMOVETOINDEX_VALUE;
@@ -171,7 +240,7 @@ void SkPath::resetFields() {
 }
 
 SkPath::SkPath(const SkPath& that)
-    : fPathRef(SkRef(that.fPathRef.get())) {
+    : fPathRef(SkPathRef::RefOrCopyToHeap(that.fPathRef.get())) {
     this->copyFields(that);
     SkDEBUGCODE(that.validate();)
 }
@@ -184,7 +253,7 @@ SkPath& SkPath::operator=(const SkPath& that) {
     SkDEBUGCODE(that.validate();)
 
     if (this != &that) {
-        fPathRef.reset(SkRef(that.fPathRef.get()));
+        fPathRef.reset(SkPathRef::RefOrCopyToHeap(that.fPathRef.get()));
         this->copyFields(that);
     }
     SkDEBUGCODE(this->validate();)
@@ -775,6 +844,14 @@ void SkPath::incReserve(int inc) {
     SkDEBUGCODE(this->validate();)
 }
 
+void SkPath::incReserve(int extraPtCount, int extraVerbCount) {
+    SkDEBUGCODE(this->validate();)
+    if (extraPtCount > 0 || extraVerbCount > 0) {
+        SkPathRef::Editor(&fPathRef, SkTMax(extraVerbCount, 0), SkTMax(extraPtCount, 0));
+    }
+    SkDEBUGCODE(this->validate();)
+}
+
 SkPath& SkPath::moveTo(SkScalar x, SkScalar y) {
     SkDEBUGCODE(this->validate();)
 
@@ -821,6 +898,23 @@ SkPath& SkPath::lineTo(SkScalar x, SkScalar y) {
     return *this;
 }
 
+SkPath& SkPath::polylineTo(const SkPoint pts[], int count) {
+    SkDEBUGCODE(this->validate();)
+    if (count <= 0) {
+        return *this;
+    }
+
+    this->injectMoveToIfNeeded();
+
+    SkPathRef::Editor ed(&fPathRef, count, count);
+    SkPoint* p = ed.growForRepeatedVerb(kLine_Verb, count);
+    memcpy(p, pts, count * sizeof(SkPoint));
+
+    DIRTY_AFTER_EDIT;
+    SkDEBUGCODE(this->validate();)
+    return *this;
+}
+
 SkPath& SkPath::rLineTo(SkScalar x, SkScalar y) {
     this->injectMoveToIfNeeded();  // This can change the result of this->getLastPt().
     SkPoint pt;
@@ -3572,45 +3666,12 @@ static bool contains_inclusive(const SkRect& r, SkScalar x, SkScalar y) {
     return r.fLeft <= x && x <= r.fRight && r.fTop <= y && y <= r.fBottom;
 }
 
-bool SkPath::contains(SkScalar x, SkScalar y) const {
-    bool isInverse = this->isInverseFillType();
-    if (this->isEmpty()) {
-        return isInverse;
-    }
-
-    if (!contains_inclusive(this->getBounds(), x, y)) {
-        return isInverse;
-    }
-
-    SkPath::Iter iter(*this, true);
-    bool done = false;
-    int w = 0;
-    int onCurveCount = 0;
-    do {
-        SkPoint pts[4];
-        switch (iter.next(pts, false)) {
-            case SkPath::kMove_Verb:
-            case SkPath::kClose_Verb:
-                break;
-            case SkPath::kLine_Verb:
-                w += winding_line(pts, x, y, &onCurveCount);
-                break;
-            case SkPath::kQuad_Verb:
-                w += winding_quad(pts, x, y, &onCurveCount);
-                break;
-            case SkPath::kConic_Verb:
-                w += winding_conic(pts, x, y, iter.conicWeight(), &onCurveCount);
-                break;
-            case SkPath::kCubic_Verb:
-                w += winding_cubic(pts, x, y, &onCurveCount);
-                break;
-            case SkPath::kDone_Verb:
-                done = true;
-                break;
-       }
-    } while (!done);
-    bool evenOddFill = SkPath::kEvenOdd_FillType == this->getFillType()
-            || SkPath::kInverseEvenOdd_FillType == this->getFillType();
+// Turns the winding and on-curve count of (x, y), accumulated over all of path's edges, into
+// the result of SkPath::contains().
+static bool resolve_winding(const SkPath& path, SkScalar x, SkScalar y, int w, int onCurveCount) {
+    bool isInverse = path.isInverseFillType();
+    bool evenOddFill = SkPath::kEvenOdd_FillType == path.getFillType()
+            || SkPath::kInverseEvenOdd_FillType == path.getFillType();
     if (evenOddFill) {
         w &= 1;
     }
@@ -3625,8 +3686,8 @@ bool SkPath::contains(SkScalar x, SkScalar y) const {
     }
     // If the point touches an even number of curves, and the fill is winding, check for
     // coincidence. Count coincidence as places where the on curve points have identical tangents.
-    iter.setPath(*this, true);
-    done = false;
+    SkPath::Iter iter(path, true);
+    bool done = false;
     SkTDArray<SkVector> tangents;
     do {
         SkPoint pts[4];
@@ -3673,6 +3734,191 @@ bool SkPath::contains(SkScalar x, SkScalar y) const {
     return SkToBool(tangents.count()) ^ isInverse;
 }
 
+bool SkPath::contains(SkScalar x, SkScalar y) const {
+    bool isInverse = this->isInverseFillType();
+    if (this->isEmpty()) {
+        return isInverse;
+    }
+
+    if (!contains_inclusive(this->getBounds(), x, y)) {
+        return isInverse;
+    }
+
+    SkPath::Iter iter(*this, true);
+    bool done = false;
+    int w = 0;
+    int onCurveCount = 0;
+    do {
+        SkPoint pts[4];
+        switch (iter.next(pts, false)) {
+            case SkPath::kMove_Verb:
+            case SkPath::kClose_Verb:
+                break;
+            case SkPath::kLine_Verb:
+                w += winding_line(pts, x, y, &onCurveCount);
+                break;
+            case SkPath::kQuad_Verb:
+                w += winding_quad(pts, x, y, &onCurveCount);
+                break;
+            case SkPath::kConic_Verb:
+                w += winding_conic(pts, x, y, iter.conicWeight(), &onCurveCount);
+                break;
+            case SkPath::kCubic_Verb:
+                w += winding_cubic(pts, x, y, &onCurveCount);
+                break;
+            case SkPath::kDone_Verb:
+                done = true;
+                break;
+       }
+    } while (!done);
+    return resolve_winding(*this, x, y, w, onCurveCount);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+SkPathContainsIndex::SkPathContainsIndex(const SkPath& path)
+        : fPath(path)
+        , fBounds(path.getBounds())
+        , fBandScale(0)
+        , fBandCount(1) {
+    // Chop the edges at the same y extrema the winding_* helpers do, so that querying the
+    // monotonic pieces gives exactly the winding SkPath::contains() computes.
+    SkPath::Iter iter(path, true);
+    SkPoint pts[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts, false)) != SkPath::kDone_Verb) {
+        switch (verb) {
+            case SkPath::kLine_Verb:
+                this->addEdge(verb, pts);
+                break;
+            case SkPath::kQuad_Verb: {
+                SkPoint dst[5];
+                int n = 0;
+                const SkPoint* mono = pts;
+                if (!is_mono_quad(pts[0].fY, pts[1].fY, pts[2].fY)) {
+                    n = SkChopQuadAtYExtrema(pts, dst);
+                    mono = dst;
+                }
+                this->addEdge(verb, mono);
+                if (n > 0) {
+                    this->addEdge(verb, &mono[2]);
+                }
+                break;
+            }
+            case SkPath::kConic_Verb: {
+                SkConic conic(pts, iter.conicWeight());
+                SkConic chopped[2];
+                bool isMono = is_mono_quad(pts[0].fY, pts[1].fY, pts[2].fY) ||
+                              !conic.chopAtYExtrema(chopped);
+                if (isMono) {
+                    this->addEdge(verb, conic.fPts, conic.fW);
+                } else {
+                    this->addEdge(verb, chopped[0].fPts, chopped[0].fW);
+                    this->addEdge(verb, chopped[1].fPts, chopped[1].fW);
+                }
+                break;
+            }
+            case SkPath::kCubic_Verb: {
+                SkPoint dst[10];
+                int n = SkChopCubicAtYExtrema(pts, dst);
+                for (int i = 0; i <= n; ++i) {
+                    this->addEdge(verb, &dst[i * 3]);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    // Aim for a band per edge, so a band holds a handful of edges plus the ones spanning it.
+    static constexpr int kMaxBands = 1024;
+    SkScalar height = fBounds.height();
+    if (fBounds.isFinite() && height > 0) {
+        fBandCount = SkTPin(fEdges.count(), 1, kMaxBands);
+        fBandScale = fBandCount / height;
+    }
+
+    // Bucket the edges by band, counting first so the band lists can be packed into one array.
+    fBandStarts.setCount(fBandCount + 1);
+    sk_bzero(fBandStarts.begin(), fBandStarts.bytes());
+    SkAutoSTMalloc<64, int> firstBand(fEdges.count()), lastBand(fEdges.count());
+    for (int i = 0; i < fEdges.count(); ++i) {
+        const Edge& edge = fEdges[i];
+        int ptCount = SkPathPriv::PtsInIter(edge.fVerb);
+        SkScalar top = edge.fPts[0].fY, bottom = edge.fPts[0].fY;
+        for (int j = 1; j < ptCount; ++j) {
+            top = SkTMin(top, edge.fPts[j].fY);
+            bottom = SkTMax(bottom, edge.fPts[j].fY);
+        }
+        firstBand[i] = this->bandOf(top);
+        lastBand[i] = this->bandOf(bottom);
+        for (int band = firstBand[i]; band <= lastBand[i]; ++band) {
+            fBandStarts[band + 1]++;
+        }
+    }
+    for (int band = 0; band < fBandCount; ++band) {
+        fBandStarts[band + 1] += fBandStarts[band];
+    }
+    fBandEdges.setCount(fBandStarts[fBandCount]);
+    SkAutoSTMalloc<64, int> cursor(fBandCount);
+    memcpy(cursor.get(), fBandStarts.begin(), fBandCount * sizeof(int));
+    for (int i = 0; i < fEdges.count(); ++i) {
+        for (int band = firstBand[i]; band <= lastBand[i]; ++band) {
+            fBandEdges[cursor[band]++] = i;
+        }
+    }
+}
+
+void SkPathContainsIndex::addEdge(SkPath::Verb verb, const SkPoint pts[], SkScalar weight) {
+    Edge* edge = fEdges.append();
+    memcpy(edge->fPts, pts, SkPathPriv::PtsInIter(verb) * sizeof(SkPoint));
+    edge->fWeight = weight;
+    edge->fVerb = verb;
+}
+
+int SkPathContainsIndex::bandOf(SkScalar y) const {
+    return SkTPin(SkScalarFloorToInt((y - fBounds.fTop) * fBandScale), 0, fBandCount - 1);
+}
+
+bool SkPathContainsIndex::contains(SkScalar x, SkScalar y) const {
+    bool isInverse = fPath.isInverseFillType();
+    if (fPath.isEmpty() || !contains_inclusive(fBounds, x, y)) {
+        return isInverse;
+    }
+
+    int band = this->bandOf(y);
+    int w = 0;
+    int onCurveCount = 0;
+    for (int i = fBandStarts[band]; i < fBandStarts[band + 1]; ++i) {
+        const Edge& edge = fEdges[fBandEdges[i]];
+        switch (edge.fVerb) {
+            case SkPath::kLine_Verb:
+                w += winding_line(edge.fPts, x, y, &onCurveCount);
+                break;
+            case SkPath::kQuad_Verb:
+                w += winding_mono_quad(edge.fPts, x, y, &onCurveCount);
+                break;
+            case SkPath::kConic_Verb:
+                w += winding_mono_conic(SkConic(edge.fPts, edge.fWeight), x, y, &onCurveCount);
+                break;
+            case SkPath::kCubic_Verb:
+                w += winding_mono_cubic(edge.fPts, x, y, &onCurveCount);
+                break;
+            default:
+                SkASSERT(false);
+                break;
+        }
+    }
+    return resolve_winding(fPath, x, y, w, onCurveCount);
+}
+
+void SkPathContainsIndex::contains(const SkPoint pts[], int count, bool results[]) const {
+    for (int i = 0; i < count; ++i) {
+        results[i] = this->contains(pts[i].fX, pts[i].fY);
+    }
+}
+
 int SkPath::ConvertConicToQuads(const SkPoint& p0, const SkPoint& p1, const SkPoint& p2,
                                 SkScalar w, SkPoint pts[], int pow2) {
     const SkConic conic(p0, p1, p2, w);
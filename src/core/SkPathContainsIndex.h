@@ -0,0 +1,59 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPathContainsIndex_DEFINED
+#define SkPathContainsIndex_DEFINED
+
+#include "SkPath.h"
+#include "SkTDArray.h"
+
+/**
+ * Answers SkPath::contains() queries for one path without walking all of its verbs. The path is
+ * chopped once into edges that are monotonic in y, and the edges are bucketed into horizontal
+ * bands, so a query only computes the winding of the edges that cross the query's band.
+ *
+ * Results are identical to SkPath::contains(). The index keeps a reference to the path it was
+ * built from; callers that cache it should rebuild when isValidFor() returns false.
+ */
+class SkPathContainsIndex {
+public:
+    explicit SkPathContainsIndex(const SkPath&);
+
+    /** Returns true if the index was built from a path with the same contents and fill type. */
+    bool isValidFor(const SkPath& path) const {
+        return fPath.getGenerationID() == path.getGenerationID() &&
+               fPath.getFillType() == path.getFillType();
+    }
+
+    bool contains(SkScalar x, SkScalar y) const;
+
+    /** Sets results[i] to contains(pts[i].fX, pts[i].fY) for each of the count points. */
+    void contains(const SkPoint pts[], int count, bool results[]) const;
+
+    int countEdges() const { return fEdges.count(); }
+
+private:
+    struct Edge {
+        SkPoint        fPts[4];
+        SkScalar       fWeight;
+        SkPath::Verb   fVerb;
+    };
+
+    void addEdge(SkPath::Verb, const SkPoint pts[], SkScalar weight = 1);
+    int bandOf(SkScalar y) const;
+
+    SkPath              fPath;
+    SkRect              fBounds;
+    SkScalar            fBandScale;
+    int                 fBandCount;
+    SkTDArray<Edge>     fEdges;
+    // Edge indices for band i are fBandEdges[fBandStarts[i] .. fBandStarts[i + 1]).
+    SkTDArray<int>      fBandStarts;
+    SkTDArray<int>      fBandEdges;
+};
+
+#endif
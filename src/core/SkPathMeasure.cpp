@@ -7,20 +7,37 @@
 
 #include "SkPathMeasure.h"
 #include "SkContourMeasure.h"
+#include "SkContourMeasureCache.h"
 
 SkPathMeasure::SkPathMeasure() {}
 
-SkPathMeasure::SkPathMeasure(const SkPath& path, bool forceClosed, SkScalar resScale)
-    : fIter(path, forceClosed, resScale)
-{
-    fContour = fIter.next();
+SkPathMeasure::SkPathMeasure(const SkPath& path, bool forceClosed, SkScalar resScale) {
+    this->reset(path, forceClosed, resScale);
 }
 
 SkPathMeasure::~SkPathMeasure() {}
 
 void SkPathMeasure::setPath(const SkPath* path, bool forceClosed) {
-    fIter.reset(path ? *path : SkPath(), forceClosed);
-    fContour = fIter.next();
+    this->reset(path ? *path : SkPath(), forceClosed, 1);
+}
+
+void SkPathMeasure::reset(const SkPath& path, bool forceClosed, SkScalar resScale) {
+    fNextCachedContour = 0;
+    if (SkContourMeasureCache::FindOrMake(path, forceClosed, resScale, &fCachedContours)) {
+        fIter.reset(SkPath(), false);
+    } else {
+        fCachedContours.reset();
+        fIter.reset(path, forceClosed, resScale);
+    }
+    fContour = this->nextContourMeasure();
+    fSegmentHint = 0;
+}
+
+sk_sp<SkContourMeasure> SkPathMeasure::nextContourMeasure() {
+    if (fNextCachedContour < fCachedContours.count()) {
+        return fCachedContours[fNextCachedContour++];
+    }
+    return fIter.next();
 }
 
 SkScalar SkPathMeasure::getLength() {
@@ -28,7 +45,7 @@ SkScalar SkPathMeasure::getLength() {
 }
 
 bool SkPathMeasure::getPosTan(SkScalar distance, SkPoint* position, SkVector* tangent) {
-    return fContour && fContour->getPosTan(distance, position, tangent);
+    return fContour && fContour->getPosTan(distance, position, tangent, &fSegmentHint);
 }
 
 bool SkPathMeasure::getMatrix(SkScalar distance, SkMatrix* matrix, MatrixFlags flags) {
@@ -36,7 +53,7 @@ bool SkPathMeasure::getMatrix(SkScalar distance, SkMatrix* matrix, MatrixFlags f
 }
 
 bool SkPathMeasure::getSegment(SkScalar startD, SkScalar stopD, SkPath* dst, bool startWithMoveTo) {
-    return fContour && fContour->getSegment(startD, stopD, dst, startWithMoveTo);
+    return fContour && fContour->getSegment(startD, stopD, dst, startWithMoveTo, &fSegmentHint);
 }
 
 bool SkPathMeasure::isClosed() {
@@ -44,7 +61,8 @@ bool SkPathMeasure::isClosed() {
 }
 
 bool SkPathMeasure::nextContour() {
-    fContour = fIter.next();
+    fContour = this->nextContourMeasure();
+    fSegmentHint = 0;
     return !!fContour;
 }
 
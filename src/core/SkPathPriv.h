@@ -284,6 +284,21 @@ public:
         SkRect tmp;
         return (path.fPathRef->fIsRRect | path.fPathRef->fIsOval) || path.isRect(&tmp);
     }
+
+    /**
+     *  Empties path and backs its points and verbs with storage from arena instead of the heap,
+     *  for transient paths that are built and thrown away many times. Copies of path move back
+     *  to heap storage, but path itself, and any path it is swapped with, must not outlive arena.
+     */
+    static void UseArenaStorage(SkPath* path, SkArenaAlloc* arena,
+                                int reserveVerbs = 0, int reservePoints = 0) {
+        path->fPathRef.reset(SkPathRef::CreateInArena(arena, reserveVerbs, reservePoints));
+        path->resetFields();
+    }
+
+    static bool IsArenaBacked(const SkPath& path) {
+        return path.fPathRef->isArenaBacked();
+    }
 };
 
 #endif
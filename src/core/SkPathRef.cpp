@@ -7,6 +7,7 @@
 
 #include "SkPathRef.h"
 
+#include "SkArenaAlloc.h"
 #include "SkBuffer.h"
 #include "SkNx.h"
 #include "SkOnce.h"
@@ -73,7 +74,8 @@ void SkPath::shrinkToFit() {
         sk_careful_memcpy(newAlloc, fPathRef->fPoints, ptsSize);
         sk_careful_memcpy((char*)newAlloc + minSize - vrbSize, fPathRef->verbsMemBegin(), vrbSize);
 
-        sk_free(fPathRef->fPoints);
+        fPathRef->freeStorage();
+        fPathRef->fArena = nullptr;
         fPathRef->fPoints = static_cast<SkPoint*>(newAlloc);
         fPathRef->fVerbs = (uint8_t*)newAlloc + minSize;
         fPathRef->fFreeSpace = 0;
@@ -94,7 +96,7 @@ SkPathRef::~SkPathRef() {
     // to read one that's not valid and then free its memory without asserting.
     this->callGenIDChangeListeners();
     SkASSERT(fGenIDChangeListeners.empty());  // These are raw ptrs.
-    sk_free(fPoints);
+    this->freeStorage();
 
     SkDEBUGCODE(fPoints = nullptr;)
     SkDEBUGCODE(fVerbs = nullptr;)
@@ -116,6 +118,34 @@ SkPathRef* SkPathRef::CreateEmpty() {
     return SkRef(gEmpty);
 }
 
+SkPathRef* SkPathRef::CreateInArena(SkArenaAlloc* arena, int reserveVerbs, int reservePoints) {
+    SkASSERT(arena);
+    SkPathRef* ref = new SkPathRef;
+    ref->fArena = arena;
+    ref->incReserve(reserveVerbs, reservePoints);
+    return ref;
+}
+
+SkPathRef* SkPathRef::RefOrCopyToHeap(SkPathRef* ref) {
+    if (!ref->isArenaBacked()) {
+        return SkRef(ref);
+    }
+    SkPathRef* copy = new SkPathRef;
+    copy->copy(*ref, 0, 0);
+    return copy;
+}
+
+void SkPathRef::growInArena(size_t oldSize, size_t newSize) {
+    SkASSERT(fArena);
+    void* storage = fArena->makeBytesAlignedTo(newSize, alignof(SkPoint));
+    size_t verbSize = fVerbCnt * sizeof(uint8_t);
+    sk_careful_memcpy(storage, fPoints, fPointCnt * sizeof(SkPoint));
+    sk_careful_memcpy(SkTAddOffset<void>(storage, newSize - verbSize),
+                      SkTAddOffset<void>(fPoints, oldSize - verbSize), verbSize);
+    fPoints = static_cast<SkPoint*>(storage);
+    fVerbs = SkTAddOffset<uint8_t>(storage, newSize);
+}
+
 static void transform_dir_and_start(const SkMatrix& matrix, bool isRRect, bool* isCCW,
                                     unsigned* start) {
     int inStart = *start;
@@ -177,8 +207,7 @@ void SkPathRef::CreateTransformedCopy(sk_sp<SkPathRef>* dst,
     SkDEBUGCODE(src.validate();)
     if (matrix.isIdentity()) {
         if (dst->get() != &src) {
-            src.ref();
-            dst->reset(const_cast<SkPathRef*>(&src));
+            dst->reset(RefOrCopyToHeap(const_cast<SkPathRef*>(&src)));
             SkDEBUGCODE((*dst)->validate();)
         }
         return;
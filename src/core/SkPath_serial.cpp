@@ -224,6 +224,11 @@ size_t SkPath::readFromMemory_EQ4(const void* storage, size_t length) {
     }
     SkASSERT(buffer.pos() <= length);
 
+    if (this->readVerbsAndPoints_EQ4(extract_filltype(packed), points, pts, conics, cnx,
+                                     verbs, vbs)) {
+        return buffer.pos();
+    }
+
 #define CHECK_POINTS_CONICS(p, c)       \
     do {                                \
         if (p && ((pts -= p) < 0)) {    \
@@ -278,6 +283,77 @@ size_t SkPath::readFromMemory_EQ4(const void* storage, size_t length) {
     return buffer.pos();
 }
 
+bool SkPath::readVerbsAndPoints_EQ4(FillType fillType, const SkPoint* points, int pts,
+                                    const SkScalar* conics, int cnx,
+                                    const uint8_t* verbs, int vbs) {
+    SkPath tmp;
+    tmp.setFillType(fillType);
+
+    // Paths written by writeToMemory() almost always hold exactly what the moveTo(), lineTo(),
+    // etc. calls in readFromMemory_EQ4() would rebuild, so check the verbs in one pass and copy
+    // the arrays as they are. Anything those calls would change -- a missing moveTo, a repeated
+    // close, a conic weight that isn't kept as a conic -- is left to the verb-by-verb build.
+    // Verbs are stored back to front, as in SkPathRef.
+    int expectedPts = 0;
+    int expectedCnx = 0;
+    int lastMoveToIndex = tmp.fLastMoveToIndex;
+    bool needMove = true;
+    for (int i = vbs - 1; i >= 0; --i) {
+        switch (verbs[i]) {
+            case kMove_Verb:
+                lastMoveToIndex = expectedPts;
+                needMove = false;
+                expectedPts += 1;
+                break;
+            case kConic_Verb: {
+                if (expectedCnx >= cnx) {
+                    return false;
+                }
+                SkScalar w = conics[expectedCnx++];
+                if (!(w > 0) || !SkScalarIsFinite(w) || w == SK_Scalar1) {
+                    return false;
+                }
+            }   // fall through
+            case kLine_Verb:
+            case kQuad_Verb:
+            case kCubic_Verb:
+                if (needMove) {
+                    return false;
+                }
+                expectedPts += SkPathPriv::PtsInIter(verbs[i]) - 1;
+                break;
+            case kClose_Verb:
+                if (needMove) {
+                    return false;
+                }
+                needMove = true;
+                lastMoveToIndex ^= ~lastMoveToIndex >> (8 * sizeof(lastMoveToIndex) - 1);
+                break;
+            default:
+                return false;
+        }
+        if (expectedPts > pts) {
+            return false;
+        }
+    }
+    if (expectedPts != pts || expectedCnx != cnx) {
+        return false;
+    }
+
+    sk_sp<SkPathRef> ref(new SkPathRef);
+    ref->resetToSize(vbs, pts, cnx);
+    sk_careful_memcpy(ref->verbsMemWritable(), verbs, vbs * sizeof(uint8_t));
+    sk_careful_memcpy(ref->fPoints, points, pts * sizeof(SkPoint));
+    sk_careful_memcpy(ref->fConicWeights.begin(), conics, cnx * sizeof(SkScalar));
+    ref->fSegmentMask = ref->computeSegmentMask();
+
+    tmp.fPathRef = std::move(ref);
+    tmp.fLastMoveToIndex = lastMoveToIndex;
+    SkDEBUGCODE(tmp.validate();)
+    *this = std::move(tmp);
+    return true;
+}
+
 size_t SkPath::readFromMemory_LE3(const void* storage, size_t length) {
     SkRBuffer buffer(storage, length);
 
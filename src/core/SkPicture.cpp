@@ -7,6 +7,10 @@
 
 #include "SkPicture.h"
 
+#include "SkBBoxHierarchy.h"
+#include "SkBigPicture.h"
+#include "SkBitmap.h"
+#include "SkCanvas.h"
 #include "SkImageGenerator.h"
 #include "SkMathPriv.h"
 #include "SkPictureCommon.h"
@@ -16,6 +20,9 @@
 #include "SkPictureRecord.h"
 #include "SkPictureRecorder.h"
 #include "SkSerialProcs.h"
+#include "SkSurfaceProps.h"
+#include "SkTaskGroup.h"
+#include "SkTemplates.h"
 #include "SkTo.h"
 #include <atomic>
 
@@ -40,6 +47,76 @@ SkPicture::SkPicture() {
     } while (fUniqueID == 0);
 }
 
+void SkPicture::playbackTiled(SkCanvas* canvas, SkExecutor* executor, SkISize tileSize) const {
+    SkASSERT(canvas);
+
+    SkImageInfo info;
+    size_t rowBytes;
+    SkIPoint origin;
+    void* pixels = canvas->accessTopLayerPixels(&info, &rowBytes, &origin);
+
+    // Tiles only compose exactly when every draw is hard-clipped to its integer tile.
+    if (!pixels || !executor || tileSize.isEmpty() || !canvas->isClipRect()) {
+        this->playback(canvas);
+        return;
+    }
+
+    // The canvas clip and matrix are global, so we shift both into the top layer's space.
+    SkIRect clip = canvas->getDeviceClipBounds().makeOffset(-origin.x(), -origin.y());
+    if (!clip.intersect(info.bounds())) {
+        return;
+    }
+    SkMatrix ctm = canvas->getTotalMatrix();
+    ctm.postTranslate(SkIntToScalar(-origin.x()), SkIntToScalar(-origin.y()));
+
+    SkSurfaceProps props(0, kUnknown_SkPixelGeometry);
+    canvas->getProps(&props);
+
+    SkBitmap bitmap;
+    if (!bitmap.installPixels(info, pixels, rowBytes)) {
+        this->playback(canvas);
+        return;
+    }
+
+    const int cols = (clip.width()  + tileSize.width()  - 1) / tileSize.width(),
+              rows = (clip.height() + tileSize.height() - 1) / tileSize.height();
+    auto tile_bounds = [&](int i) {
+        SkIRect tile = SkIRect::MakeXYWH(clip.fLeft + (i % cols) * tileSize.width(),
+                                         clip.fTop  + (i / cols) * tileSize.height(),
+                                         tileSize.width(), tileSize.height());
+        return tile.intersect(clip) ? tile : SkIRect::MakeEmpty();
+    };
+
+    // With a BBH we can find every tile that draws nothing in one search, and skip them.
+    const SkBigPicture* big = this->asSkBigPicture();
+    SkMatrix inverse;
+    SkAutoTArray<SkTDArray<int>> tileOps;
+    if (big && big->bbh() && ctm.invert(&inverse)) {
+        SkAutoTMalloc<SkRect> queries(cols * rows);
+        for (int i = 0; i < cols * rows; i++) {
+            // Outset like SkCanvas::getLocalClipBounds(), to match what playback searches.
+            SkRect tile = SkRect::Make(tile_bounds(i).makeOutset(1, 1));
+            inverse.mapRect(&queries[i], tile);
+        }
+        tileOps.reset(cols * rows);
+        big->bbh()->batchSearch(queries, cols * rows, tileOps.get());
+    }
+
+    SkTaskGroup(*executor).batch(cols * rows, [&](int i) {
+        SkIRect tile = tile_bounds(i);
+        if (tile.isEmpty() || (tileOps.get() && tileOps[i].isEmpty())) {
+            return;
+        }
+
+        // Each tile gets its own canvas, sharing the destination pixels.
+        // Tiles never overlap, so no two threads ever touch the same pixel.
+        SkCanvas tileCanvas(bitmap, props);
+        tileCanvas.clipRect(SkRect::Make(tile));
+        tileCanvas.setMatrix(ctm);
+        this->playback(&tileCanvas);
+    });
+}
+
 static const char kMagic[] = { 's', 'k', 'i', 'a', 'p', 'i', 'c', 't' };
 
 SkPictInfo SkPicture::createHeader() const {
@@ -152,8 +229,16 @@ sk_sp<SkPicture> SkPicture::MakeFromData(const SkData* data, const SkDeserialPro
     return MakeFromStream(&stream, procs, nullptr);
 }
 
+sk_sp<SkPicture> SkPicture::MakeFromMappedData(sk_sp<SkData> data, const SkDeserialProcs* procs) {
+    if (!data) {
+        return nullptr;
+    }
+    SkMemoryStream stream(data);
+    return MakeFromStream(&stream, procs, nullptr, data.get());
+}
+
 sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialProcs* procsPtr,
-                                           SkTypefacePlayback* typefaces) {
+                                           SkTypefacePlayback* typefaces, const SkData* mapped) {
     SkPictInfo info;
     if (!StreamIsSKP(stream, &info)) {
         return nullptr;
@@ -169,7 +254,7 @@ sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialPro
     switch (trailingStreamByteAfterPictInfo) {
         case kPictureData_TrailingStreamByteAfterPictInfo: {
             std::unique_ptr<SkPictureData> data(
-                    SkPictureData::CreateFromStream(stream, info, procs, typefaces));
+                    SkPictureData::CreateFromStream(stream, info, procs, typefaces, mapped));
             return Forwardport(info, data.get(), nullptr);
         }
         case kCustom_TrailingStreamByteAfterPictInfo: {
@@ -93,6 +93,32 @@ static void write_tag_size(SkWStream* stream, uint32_t tag, size_t size) {
     stream->write32(SkToU32(size));
 }
 
+// Pads the stream so the contents of the next tag start 4-byte aligned, which lets a reader of
+// a mapped file use them in place.
+static void write_padding(SkWStream* stream) {
+    size_t padding = SkAlign4(stream->bytesWritten()) - stream->bytesWritten();
+    if (padding) {
+        write_tag_size(stream, SK_PICT_PADDING_TAG, padding);
+        stream->write("\0\0\0", padding);
+    }
+}
+
+// Reads 'size' bytes from the stream. If the stream reads from 'mapped', shares 'mapped'
+// instead of copying, as long as the bytes are aligned for an SkReadBuffer.
+static sk_sp<SkData> read_stream_data(SkStream* stream, size_t size, const SkData* mapped) {
+    if (mapped && stream->getMemoryBase() == mapped->data() && stream->hasPosition()) {
+        size_t offset = stream->getPosition();
+        if (offset > mapped->size() || size > mapped->size() - offset) {
+            return nullptr;
+        }
+        if (SkIsAlign4((uintptr_t)mapped->bytes() + offset)) {
+            return stream->skip(size) == size ? SkData::MakeSubset(mapped, offset, size)
+                                              : nullptr;
+        }
+    }
+    return SkData::MakeFromStream(stream, size);
+}
+
 void SkPictureData::WriteFactories(SkWStream* stream, const SkFactorySet& rec) {
     int count = rec.count();
 
@@ -199,6 +225,7 @@ static SkSerialProcs skip_typeface_proc(const SkSerialProcs& procs) {
 void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
                               SkRefCntSet* topLevelTypeFaceSet) const {
     // This can happen at pretty much any time, so might as well do it first.
+    write_padding(stream);
     write_tag_size(stream, SK_PICT_READER_TAG, fOpData->size());
     stream->write(fOpData->bytes(), fOpData->size());
 
@@ -211,6 +238,7 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
     SkFactorySet factSet;  // buffer refs factSet, so factSet must come first.
     SkBinaryWriteBuffer buffer;
     buffer.setFactoryRecorder(sk_ref_sp(&factSet));
+    buffer.setDedupFlattenables(true);
     buffer.setSerialProcs(skip_typeface_proc(procs));
     buffer.setTypefaceRecorder(sk_ref_sp(typefaceSet));
     this->flattenToBuffer(buffer);
@@ -238,6 +266,7 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
     }
 
     // Write the buffer.
+    write_padding(stream);
     write_tag_size(stream, SK_PICT_BUFFER_SIZE_TAG, buffer.bytesWritten());
     buffer.writeToStream(stream);
 
@@ -281,11 +310,12 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
                                    uint32_t tag,
                                    uint32_t size,
                                    const SkDeserialProcs& procs,
-                                   SkTypefacePlayback* topLevelTFPlayback) {
+                                   SkTypefacePlayback* topLevelTFPlayback,
+                                   const SkData* mapped) {
     switch (tag) {
         case SK_PICT_READER_TAG:
             SkASSERT(nullptr == fOpData);
-            fOpData = SkData::MakeFromStream(stream, size);
+            fOpData = read_stream_data(stream, size, mapped);
             if (!fOpData) {
                 return false;
             }
@@ -321,21 +351,30 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             fPictures.reserve(SkToInt(size));
 
             for (uint32_t i = 0; i < size; i++) {
-                auto pic = SkPicture::MakeFromStream(stream, &procs, topLevelTFPlayback);
+                auto pic = SkPicture::MakeFromStream(stream, &procs, topLevelTFPlayback, mapped);
                 if (!pic) {
                     return false;
                 }
                 fPictures.push_back(std::move(pic));
             }
         } break;
+        case SK_PICT_PADDING_TAG:
+            if (stream->skip(size) != size) {
+                return false;
+            }
+            break;
         case SK_PICT_BUFFER_SIZE_TAG: {
-            SkAutoMalloc storage(size);
-            if (stream->read(storage.get(), size) != size) {
+            sk_sp<SkData> storage = read_stream_data(stream, size, mapped);
+            if (!storage) {
                 return false;
             }
 
-            SkReadBuffer buffer(storage.get(), size);
+            SkReadBuffer buffer(storage->data(), size);
             buffer.setVersion(fInfo.getVersion());
+            if (mapped) {
+                // Encoded images are left in the mapping, to be decoded when first drawn.
+                buffer.setBackingData(sk_ref_sp(mapped));
+            }
 
             if (!fFactoryPlayback) {
                 return false;
@@ -467,13 +506,14 @@ void SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t
 SkPictureData* SkPictureData::CreateFromStream(SkStream* stream,
                                                const SkPictInfo& info,
                                                const SkDeserialProcs& procs,
-                                               SkTypefacePlayback* topLevelTFPlayback) {
+                                               SkTypefacePlayback* topLevelTFPlayback,
+                                               const SkData* mapped) {
     std::unique_ptr<SkPictureData> data(new SkPictureData(info));
     if (!topLevelTFPlayback) {
         topLevelTFPlayback = &data->fTFPlayback;
     }
 
-    if (!data->parseStream(stream, procs, topLevelTFPlayback)) {
+    if (!data->parseStream(stream, procs, topLevelTFPlayback, mapped)) {
         return nullptr;
     }
     return data.release();
@@ -492,7 +532,8 @@ SkPictureData* SkPictureData::CreateFromBuffer(SkReadBuffer& buffer,
 
 bool SkPictureData::parseStream(SkStream* stream,
                                 const SkDeserialProcs& procs,
-                                SkTypefacePlayback* topLevelTFPlayback) {
+                                SkTypefacePlayback* topLevelTFPlayback,
+                                const SkData* mapped) {
     for (;;) {
         uint32_t tag;
         if (!stream->readU32(&tag)) { return false; }
@@ -502,7 +543,7 @@ bool SkPictureData::parseStream(SkStream* stream,
 
         uint32_t size;
         if (!stream->readU32(&size)) { return false; }
-        if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback)) {
+        if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback, mapped)) {
             return false; // we're invalid
         }
     }
@@ -12,11 +12,35 @@
 #include "SkPictureRecorder.h"
 #include "SkRecord.h"
 #include "SkRecordDraw.h"
+#include "SkRecordHash.h"
 #include "SkRecordOpts.h"
 #include "SkRecordedDrawable.h"
 #include "SkRecorder.h"
+#include "SkTDArray.h"
 #include "SkTypes.h"
 
+// What kReuseUnchanged_RecordFlag remembers about the last picture finished with it.
+// fPicture keeps alive every refcounted object whose address went into fOpHashes.
+struct SkPictureRecorder::ReuseState {
+    sk_sp<SkPicture>         fPicture;
+    SkRect                   fUserCullRect;
+    bool                     fHadBBH;
+    SkTDArray<uint32_t>      fOpHashes;      // One per op, before SkRecordOptimize().
+    SkTDArray<SkRect>        fBounds;        // One per op, after SkRecordOptimize().
+    sk_sp<SkBBoxHierarchy>   fBBH;
+};
+
+// Hashes every op in record, returning false if any op can't be hashed.
+static bool hash_ops(const SkRecord& record, SkTDArray<uint32_t>* hashes) {
+    hashes->setCount(record.count());
+    for (int i = 0; i < record.count(); i++) {
+        if (!SkRecordHashOp(record, i, &(*hashes)[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 SkPictureRecorder::SkPictureRecorder() {
     fActivelyRecording = false;
     fMiniRecorder.reset(new SkMiniRecorder);
@@ -63,6 +87,27 @@ sk_sp<SkPicture> SkPictureRecorder::finishRecordingAsPicture(uint32_t finishFlag
         return pic;
     }
 
+    // With kReuseUnchanged_RecordFlag, hash the ops before SkRecordOptimize() rewrites them.
+    std::unique_ptr<ReuseState> reuse;
+    if (fFlags & kReuseUnchanged_RecordFlag) {
+        reuse.reset(new ReuseState);
+        reuse->fUserCullRect = fCullRect;
+        reuse->fHadBBH = fBBH != nullptr;
+        if (!hash_ops(*fRecord, &reuse->fOpHashes)) {
+            reuse.reset();
+            fReuse.reset();
+        } else if (fReuse && fReuse->fUserCullRect == reuse->fUserCullRect &&
+                   fReuse->fHadBBH == reuse->fHadBBH &&
+                   fReuse->fOpHashes.count() == reuse->fOpHashes.count() &&
+                   0 == memcmp(fReuse->fOpHashes.begin(), reuse->fOpHashes.begin(),
+                               reuse->fOpHashes.bytes())) {
+            // Nothing changed since the last picture: hand it out again.
+            fRecord.reset();
+            fBBH.reset();
+            return fReuse->fPicture;
+        }
+    }
+
     // TODO: delay as much of this work until just before first playback?
     SkRecordOptimize(fRecord.get());
 
@@ -73,7 +118,18 @@ sk_sp<SkPicture> SkPictureRecorder::finishRecordingAsPicture(uint32_t finishFlag
     if (fBBH.get()) {
         SkAutoTMalloc<SkRect> bounds(fRecord->count());
         SkRecordFillBounds(fCullRect, *fRecord, bounds);
-        fBBH->insert(bounds, fRecord->count());
+        if (reuse) {
+            reuse->fBounds.append(fRecord->count(), bounds.get());
+        }
+        if (fReuse && reuse && fReuse->fBBH &&
+            fReuse->fBounds.count() == reuse->fBounds.count() &&
+            0 == memcmp(fReuse->fBounds.begin(), reuse->fBounds.begin(),
+                        reuse->fBounds.bytes())) {
+            // Ops changed but none moved, so the previous hierarchy still indexes them.
+            fBBH = fReuse->fBBH;
+        } else {
+            fBBH->insert(bounds, fRecord->count());
+        }
 
         // Now that we've calculated content bounds, we can update fCullRect, often trimming it.
         // TODO: get updated fCullRect from bounds instead of forcing the BBH to return it?
@@ -87,8 +143,16 @@ sk_sp<SkPicture> SkPictureRecorder::finishRecordingAsPicture(uint32_t finishFlag
     for (int i = 0; pictList && i < pictList->count(); i++) {
         subPictureBytes += pictList->begin()[i]->approximateBytesUsed();
     }
-    return sk_make_sp<SkBigPicture>(fCullRect, fRecord.release(), pictList, fBBH.release(),
-                                    subPictureBytes);
+    if (reuse) {
+        reuse->fBBH = fBBH;
+    }
+    sk_sp<SkPicture> picture = sk_make_sp<SkBigPicture>(fCullRect, fRecord.release(), pictList,
+                                                        fBBH.release(), subPictureBytes);
+    if (reuse) {
+        reuse->fPicture = picture;
+        fReuse = std::move(reuse);
+    }
+    return picture;
 }
 
 sk_sp<SkPicture> SkPictureRecorder::finishRecordingAsPictureWithCull(const SkRect& cullRect,
@@ -5,7 +5,10 @@
  * found in the LICENSE file.
  */
 
+#include "SkMathPriv.h"
+#include "SkNx.h"
 #include "SkRTree.h"
+#include "SkTemplates.h"
 
 SkRTree::SkRTree(SkScalar aspectRatio)
     : fCount(0), fAspectRatio(isfinite(aspectRatio) ? aspectRatio : 1) {}
@@ -32,7 +35,7 @@ void SkRTree::insert(const SkRect boundsArray[], int N) {
 
         Branch* b = branches.push();
         b->fBounds = bounds;
-        b->fOpIndex = i;
+        b->fChild.fOpIndex = i;
     }
 
     fCount = branches.count();
@@ -40,9 +43,8 @@ void SkRTree::insert(const SkRect boundsArray[], int N) {
         if (1 == fCount) {
             fNodes.setReserve(1);
             Node* n = this->allocateNodeAtLevel(0);
-            n->fNumChildren = 1;
-            n->fChildren[0] = branches[0];
-            fRoot.fSubtree = n;
+            n->appendChild(branches[0]);
+            fRoot.fChild.fSubtree = n;
             fRoot.fBounds  = branches[0].fBounds;
         } else {
             fNodes.setReserve(CountNodes(fCount, fAspectRatio));
@@ -57,9 +59,49 @@ SkRTree::Node* SkRTree::allocateNodeAtLevel(uint16_t level) {
     SkASSERT(fNodes.begin() == p);  // If this fails, we didn't setReserve() enough.
     out->fNumChildren = 0;
     out->fLevel = level;
+    for (int i = 0; i < kPaddedChildren; ++i) {
+        out->fLeft[i]  = out->fTop[i]    =  SK_ScalarInfinity;
+        out->fRight[i] = out->fBottom[i] = -SK_ScalarInfinity;
+    }
     return out;
 }
 
+void SkRTree::Node::appendChild(const Branch& branch) {
+    SkASSERT(fNumChildren < kMaxChildren);
+    int i = fNumChildren++;
+    fLeft  [i] = branch.fBounds.fLeft;
+    fTop   [i] = branch.fBounds.fTop;
+    fRight [i] = branch.fBounds.fRight;
+    fBottom[i] = branch.fBounds.fBottom;
+    fChildren[i] = branch.fChild;
+}
+
+SkRect SkRTree::Node::childBounds(int i) const {
+    return SkRect::MakeLTRB(fLeft[i], fTop[i], fRight[i], fBottom[i]);
+}
+
+uint32_t SkRTree::Node::intersects(const SkRect& query) const {
+    // Like SkRect::Intersects(): the larger left edge must be left of the smaller right edge,
+    // and likewise top and bottom. Padding slots have left > right, so they never intersect.
+    const Sk4f qL(query.fLeft), qT(query.fTop), qR(query.fRight), qB(query.fBottom);
+    uint32_t mask = 0;
+    for (int i = 0; i < fNumChildren; i += kLanes) {
+        Sk4f l = Sk4f::Max(Sk4f::Load(fLeft   + i), qL),
+             t = Sk4f::Max(Sk4f::Load(fTop    + i), qT),
+             r = Sk4f::Min(Sk4f::Load(fRight  + i), qR),
+             b = Sk4f::Min(Sk4f::Load(fBottom + i), qB);
+        Sk4f hit = (l < r).thenElse(t < b, 0.0f);
+        if (hit.anyTrue()) {
+            uint32_t lanes[kLanes];
+            hit.store(lanes);
+            for (int j = 0; j < kLanes; ++j) {
+                mask |= (lanes[j] & 1) << (i + j);
+            }
+        }
+    }
+    return mask;
+}
+
 // This function parallels bulkLoad, but just counts how many nodes bulkLoad would allocate.
 int SkRTree::CountNodes(int branches, SkScalar aspectRatio) {
     if (branches == 1) {
@@ -142,16 +184,14 @@ SkRTree::Branch SkRTree::bulkLoad(SkTDArray<Branch>* branches, int level) {
                 }
             }
             Node* n = allocateNodeAtLevel(level);
-            n->fNumChildren = 1;
-            n->fChildren[0] = (*branches)[currentBranch];
+            n->appendChild((*branches)[currentBranch]);
             Branch b;
             b.fBounds = (*branches)[currentBranch].fBounds;
-            b.fSubtree = n;
+            b.fChild.fSubtree = n;
             ++currentBranch;
             for (int k = 1; k < incrementBy && currentBranch < branches->count(); ++k) {
                 b.fBounds.join((*branches)[currentBranch].fBounds);
-                n->fChildren[k] = (*branches)[currentBranch];
-                ++n->fNumChildren;
+                n->appendChild((*branches)[currentBranch]);
                 ++currentBranch;
             }
             (*branches)[newBranches] = b;
@@ -162,21 +202,73 @@ SkRTree::Branch SkRTree::bulkLoad(SkTDArray<Branch>* branches, int level) {
     return this->bulkLoad(branches, level + 1);
 }
 
+// Returns the index of the lowest set bit, so children are visited in order.
+static int lowest_bit(uint32_t bits) {
+    SkASSERT(bits);
+    return 31 - SkCLZ(bits & (0u - bits));
+}
+
 void SkRTree::search(const SkRect& query, SkTDArray<int>* results) const {
     if (fCount > 0 && SkRect::Intersects(fRoot.fBounds, query)) {
-        this->search(fRoot.fSubtree, query, results);
+        this->search(fRoot.fChild.fSubtree, query, results);
+    }
+}
+
+void SkRTree::search(const Node* node, const SkRect& query, SkTDArray<int>* results) const {
+    for (uint32_t hits = node->intersects(query); hits; hits &= hits - 1) {
+        int i = lowest_bit(hits);
+        if (0 == node->fLevel) {
+            results->push_back(node->fChildren[i].fOpIndex);
+        } else {
+            this->search(node->fChildren[i].fSubtree, query, results);
+        }
+    }
+}
+
+void SkRTree::batchSearch(const SkRect queries[], int N, SkTDArray<int> results[]) const {
+    if (0 == fCount) {
+        return;
+    }
+    SkTDArray<int> active;
+    for (int q = 0; q < N; ++q) {
+        if (SkRect::Intersects(fRoot.fBounds, queries[q])) {
+            active.push_back(q);
+        }
+    }
+    if (!active.isEmpty()) {
+        this->batchSearch(fRoot.fChild.fSubtree, queries, active.begin(), active.count(),
+                          results);
     }
 }
 
-void SkRTree::search(Node* node, const SkRect& query, SkTDArray<int>* results) const {
-    for (int i = 0; i < node->fNumChildren; ++i) {
-        if (SkRect::Intersects(node->fChildren[i].fBounds, query)) {
-            if (0 == node->fLevel) {
-                results->push_back(node->fChildren[i].fOpIndex);
-            } else {
-                this->search(node->fChildren[i].fSubtree, query, results);
+void SkRTree::batchSearch(const Node* node, const SkRect queries[], const int active[],
+                          int count, SkTDArray<int> results[]) const {
+    // Test every query still live at this node against all its children once...
+    SkAutoSTMalloc<64, uint32_t> hits(count);
+    uint32_t anyHits = 0;
+    for (int q = 0; q < count; ++q) {
+        hits[q] = node->intersects(queries[active[q]]);
+        anyHits |= hits[q];
+    }
+
+    // ... then follow each child with just the queries that hit it.
+    SkAutoSTMalloc<64, int> childActive(count);
+    for (; anyHits; anyHits &= anyHits - 1) {
+        int i = lowest_bit(anyHits);
+        int childCount = 0;
+        for (int q = 0; q < count; ++q) {
+            if (hits[q] & (1 << i)) {
+                childActive[childCount++] = active[q];
             }
         }
+        if (0 == node->fLevel) {
+            for (int q = 0; q < childCount; ++q) {
+                results[childActive[q]].push_back(node->fChildren[i].fOpIndex);
+            }
+        } else {
+            this->batchSearch(node->fChildren[i].fSubtree, queries, childActive.get(),
+                              childCount, results);
+        }
     }
 }
 
@@ -42,12 +42,13 @@ public:
 
     void insert(const SkRect[], int N) override;
     void search(const SkRect& query, SkTDArray<int>* results) const override;
+    void batchSearch(const SkRect queries[], int N, SkTDArray<int> results[]) const override;
     size_t bytesUsed() const override;
 
     // Methods and constants below here are only public for tests.
 
     // Return the depth of the tree structure.
-    int getDepth() const { return fCount ? fRoot.fSubtree->fLevel + 1 : 0; }
+    int getDepth() const { return fCount ? fRoot.fChild.fSubtree->fLevel + 1 : 0; }
     // Insertion count (not overall node count, which may be greater).
     int getCount() const { return fCount; }
 
@@ -61,21 +62,40 @@ public:
 private:
     struct Node;
 
+    union Child {
+        Node* fSubtree;
+        int fOpIndex;
+    };
+
     struct Branch {
-        union {
-            Node* fSubtree;
-            int fOpIndex;
-        };
+        Child fChild;
         SkRect fBounds;
     };
 
+    // search() tests this many children's bounds at a time.
+    static const int kLanes = 4,
+                     kPaddedChildren = (kMaxChildren + kLanes - 1) / kLanes * kLanes;
+
     struct Node {
         uint16_t fNumChildren;
         uint16_t fLevel;
-        Branch fChildren[kMaxChildren];
+        // The children's bounds are kept an edge at a time, so search() can load them straight
+        // into vectors. Unused slots hold bounds that intersect nothing.
+        float fLeft  [kPaddedChildren];
+        float fTop   [kPaddedChildren];
+        float fRight [kPaddedChildren];
+        float fBottom[kPaddedChildren];
+        Child fChildren[kMaxChildren];
+
+        void appendChild(const Branch&);
+        SkRect childBounds(int i) const;
+        // Returns a bit mask of the children whose bounds intersect 'query'.
+        uint32_t intersects(const SkRect& query) const;
     };
 
-    void search(Node* root, const SkRect& query, SkTDArray<int>* results) const;
+    void search(const Node* root, const SkRect& query, SkTDArray<int>* results) const;
+    void batchSearch(const Node* root, const SkRect queries[], const int active[], int count,
+                     SkTDArray<int> results[]) const;
 
     // Consumes the input array.
     Branch bulkLoad(SkTDArray<Branch>* branches, int level = 0);
@@ -66,9 +66,12 @@ private:
 
 struct SkBufferHead {
     mutable std::atomic<int32_t> fRefCnt;
+    // How many bytes the writer has appended, for readers that keep up with it.  Stored (with
+    // release) after the bytes and any new block's fNext are written.
+    std::atomic<size_t> fPublished;
     SkBufferBlock   fBlock;
 
-    SkBufferHead(size_t capacity) : fRefCnt(1), fBlock(capacity) {}
+    SkBufferHead(size_t capacity) : fRefCnt(1), fPublished(0), fBlock(capacity) {}
 
     static size_t LengthToCapacity(size_t length) {
         const size_t minSize = kMinAllocSize - sizeof(SkBufferHead);
@@ -131,7 +134,6 @@ SkROBuffer::SkROBuffer(const SkBufferHead* head, size_t available, const SkBuffe
 {
     if (head) {
         fHead->ref();
-        SkASSERT(available > 0);
         head->validate(available, tail);
     } else {
         SkASSERT(0 == available);
@@ -234,6 +236,7 @@ void SkRWBuffer::append(const void* src, size_t length, size_t reserve) {
         written = fTail->append(src, length);
         SkASSERT(written == length);
     }
+    fHead->fPublished.store(fTotalUsed, std::memory_order_release);
     this->validate();
 }
 
@@ -362,3 +365,87 @@ private:
 std::unique_ptr<SkStreamAsset> SkRWBuffer::makeStreamSnapshot() const {
     return skstd::make_unique<SkROBufferStreamAsset>(this->makeROBufferSnapshot());
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Reads as far as the writer has published.  Like SkROBuffer, it relies on the writer filling
+// each block before starting the next, so it can step through a block by its fCapacity without
+// looking at fUsed, and it only follows fNext once the published size says the next block has
+// bytes in it.
+class SkRWBufferGrowingStream : public SkStreamRewindable {
+public:
+    SkRWBufferGrowingStream(const SkBufferHead* head) : fHead(head) {
+        fHead->ref();
+        this->rewind();
+    }
+
+    ~SkRWBufferGrowingStream() override { fHead->unref(); }
+
+    size_t read(void* dst, size_t request) override {
+        const size_t published = fHead->fPublished.load(std::memory_order_acquire);
+        request = SkTMin(request, published - fGlobalOffset);
+        size_t bytesRead = 0;
+        while (bytesRead < request) {
+            if (fLocalOffset == fBlock->fCapacity) {
+                fBlock = fBlock->fNext;
+                fLocalOffset = 0;
+                SkASSERT(fBlock);
+            }
+            size_t amount = SkTMin(fBlock->fCapacity - fLocalOffset, request - bytesRead);
+            if (dst) {
+                memcpy((char*)dst + bytesRead, (const char*)fBlock->startData() + fLocalOffset,
+                       amount);
+            }
+            fLocalOffset += amount;
+            bytesRead += amount;
+        }
+        fGlobalOffset += bytesRead;
+        return bytesRead;
+    }
+
+    size_t peek(void* dst, size_t request) const override {
+        SkRWBufferGrowingStream* self = const_cast<SkRWBufferGrowingStream*>(this);
+        const SkBufferBlock* block = fBlock;
+        const size_t localOffset = fLocalOffset,
+                     globalOffset = fGlobalOffset;
+        size_t bytesPeeked = self->read(dst, request);
+        self->fBlock = block;
+        self->fLocalOffset = localOffset;
+        self->fGlobalOffset = globalOffset;
+        return bytesPeeked;
+    }
+
+    // Only true until the writer appends more.
+    bool isAtEnd() const override {
+        return fHead->fPublished.load(std::memory_order_acquire) == fGlobalOffset;
+    }
+
+    bool rewind() override {
+        fBlock = &fHead->fBlock;
+        fLocalOffset = fGlobalOffset = 0;
+        return true;
+    }
+
+    bool hasPosition() const override { return true; }
+    size_t getPosition() const override { return fGlobalOffset; }
+
+private:
+    SkStreamRewindable* onDuplicate() const override {
+        return new SkRWBufferGrowingStream(fHead);
+    }
+
+    const SkBufferHead*  fHead;
+    const SkBufferBlock* fBlock;
+    size_t               fLocalOffset;
+    size_t               fGlobalOffset;
+};
+
+std::unique_ptr<SkStreamRewindable> SkRWBuffer::makeGrowingStream() {
+    this->validate();
+    if (nullptr == fHead) {
+        // The stream needs the head to follow the blocks appended later.
+        fHead = SkBufferHead::Alloc(0);
+        fTail = &fHead->fBlock;
+    }
+    return skstd::make_unique<SkRWBufferGrowingStream>(fHead);
+}
@@ -6,6 +6,7 @@
  */
 
 #include "SkRasterClip.h"
+#include "SkAAClipCache.h"
 #include "SkPath.h"
 #include "SkRegionPriv.h"
 
@@ -248,6 +249,8 @@ bool SkRasterClip::op(const SkRRect& rrect, const SkMatrix& matrix, const SkIRec
 
     SkPath path;
     path.addRRect(rrect);
+    // This path is rebuilt every time, so there is no point remembering its clip.
+    path.setIsVolatile(true);
 
     return this->op(path, matrix, bounds, op, doAA);
 }
@@ -277,26 +280,46 @@ bool SkRasterClip::op(const SkPath& path, const SkMatrix& matrix, const SkIRect&
             // FIXME: we should also be able to do this when this->isBW(),
             // but relaxing the test above triggers GM asserts in
             // SkRgnBuilder::blitH(). We need to investigate what's going on.
-            return this->setPath(devPath, this->bwRgn(), doAA);
+            return this->setCachedPath(path, matrix, devPath, this->bwRgn(), doAA);
         } else {
             base.setRect(this->getBounds());
             SkRasterClip clip;
-            clip.setPath(devPath, base, doAA);
+            clip.setCachedPath(path, matrix, devPath, base, doAA);
             return this->op(clip, op);
         }
     } else {
         base.setRect(bounds);
 
         if (SkRegion::kReplace_Op == op) {
-            return this->setPath(devPath, base, doAA);
+            return this->setCachedPath(path, matrix, devPath, base, doAA);
         } else {
             SkRasterClip clip;
-            clip.setPath(devPath, base, doAA);
+            clip.setCachedPath(path, matrix, devPath, base, doAA);
             return this->op(clip, op);
         }
     }
 }
 
+// Antialiased clips of the same path under the same matrix tend to repeat frame after frame, so
+// they are worth remembering. The key is the source path, since devPath is always volatile.
+bool SkRasterClip::setCachedPath(const SkPath& srcPath, const SkMatrix& matrix,
+                                 const SkPath& devPath, const SkRegion& clip, bool doAA) {
+    if (!doAA || srcPath.isVolatile() || !clip.isRect()) {
+        return this->setPath(devPath, clip, doAA);
+    }
+
+    AUTO_RASTERCLIP_VALIDATE(*this);
+
+    if (this->isBW()) {
+        this->convertToAA();
+    }
+    if (!SkAAClipCache::Find(srcPath, matrix, clip.getBounds(), &fAA)) {
+        (void)fAA.setPath(devPath, &clip, doAA);
+        SkAAClipCache::Add(srcPath, matrix, clip.getBounds(), fAA);
+    }
+    return this->updateCacheAndReturnNonEmpty();
+}
+
 bool SkRasterClip::setPath(const SkPath& path, const SkIRect& clip, bool doAA) {
     SkRegion tmp;
     tmp.setRect(clip);
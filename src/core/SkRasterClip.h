@@ -165,6 +165,8 @@ private:
 
     bool setPath(const SkPath& path, const SkRegion& clip, bool doAA);
     bool setPath(const SkPath& path, const SkIRect& clip, bool doAA);
+    bool setCachedPath(const SkPath& srcPath, const SkMatrix& matrix, const SkPath& devPath,
+                       const SkRegion& clip, bool doAA);
     bool op(const SkRasterClip&, SkRegion::Op);
     bool setConservativeRect(const SkRect& r, const SkIRect& clipR, bool isInverse);
 
@@ -7,6 +7,7 @@
 
 #include "SkRasterPipeline.h"
 #include "SkOpts.h"
+#include "SkRasterPipelineJIT.h"
 #include <algorithm>
 
 SkRasterPipeline::SkRasterPipeline(SkArenaAlloc* alloc) : fAlloc(alloc) {
@@ -292,6 +293,15 @@ SkRasterPipeline::StartPipelineFn SkRasterPipeline::build_pipeline(void** ip) co
             *--ip = (void*)SkOpts::stages_highp[st->stage];
         }
     }
+
+#if defined(SK_RASTER_PIPELINE_JIT)
+    SkAutoSTMalloc<32, SkRasterPipelineJIT::Stage> stages(fNumStages);
+    int n = fNumStages;
+    for (const StageList* st = fStages; st; st = st->prev) {
+        stages[--n] = { st->rawFunction ? -1 : (int)st->stage, st->ctx != nullptr };
+    }
+    SkRasterPipelineJIT::Fuse(stages.get(), fNumStages, ip);
+#endif
     return SkOpts::start_pipeline_highp;
 }
 
@@ -40,6 +40,7 @@
     M(force_opaque) M(force_opaque_dst)                            \
     M(set_rgb) M(unbounded_set_rgb) M(swap_rb) M(swap_rb_dst)      \
     M(from_srgb) M(to_srgb)                                        \
+    M(from_pq)   M(to_pq)     M(from_hlg)  M(to_hlg)               \
     M(black_color) M(white_color) M(uniform_color) M(unbounded_uniform_color) \
     M(seed_shader) M(dither)                                       \
     M(load_a8)   M(load_a8_dst)   M(store_a8)   M(gather_a8)       \
@@ -51,6 +52,7 @@
     M(load_1010102) M(load_1010102_dst) M(store_1010102) M(gather_1010102) \
     M(alpha_to_gray) M(alpha_to_gray_dst) M(luminance_to_alpha)    \
     M(bilerp_clamp_8888)                                           \
+    M(bilerp_repeat_8888)                                          \
     M(store_u16_be)                                                \
     M(load_src) M(store_src) M(load_dst) M(store_dst)              \
     M(scale_u8) M(scale_565) M(scale_1_float)                      \
@@ -79,6 +81,7 @@
     M(evenly_spaced_gradient)                                      \
     M(gradient)                                                    \
     M(evenly_spaced_2_stop_gradient)                               \
+    M(three_stop_gradient)                                         \
     M(xy_to_unit_angle)                                            \
     M(xy_to_radius)                                                \
     M(xy_to_2pt_conical_strip)                                     \
@@ -156,6 +159,14 @@ struct SkRasterPipeline_EvenlySpaced2StopGradientCtx {
     bool interpolatedInPremul;
 };
 
+// Two intervals split at t_mid, chosen with a select instead of a gather.
+struct SkRasterPipeline_3StopGradientCtx {
+    float f[2][4];
+    float b[2][4];
+    float t_mid;
+    bool interpolatedInPremul;
+};
+
 struct SkRasterPipeline_2PtConicalCtx {
     uint32_t fMask[SkRasterPipeline_kMaxStride];
     float    fP0,
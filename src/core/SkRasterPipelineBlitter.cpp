@@ -64,16 +64,17 @@ private:
 
     // Built lazily on first use.
     std::function<void(size_t, size_t, size_t, size_t)> fBlitRect,
-                                                        fBlitAntiH,
                                                         fBlitMaskA8,
                                                         fBlitMaskLCD16,
                                                         fBlitMask3D;
 
     // These values are pointed to by the blit pipelines above,
     // which allows us to adjust them from call to call.
-    float fCurrentCoverage = 0.0f;
     float fDitherRate      = 0.0f;
 
+    // One row of coverage, indexed by x, where blitAntiH() gathers its runs.  Allocated lazily.
+    uint8_t* fCoverageRow = nullptr;
+
     typedef SkBlitter INHERITED;
 };
 
@@ -311,37 +312,48 @@ void SkRasterPipelineBlitter::blitRect(int x, int y, int w, int h) {
     fBlitRect(x,y,w,h);
 }
 
-void SkRasterPipelineBlitter::blitAntiH(int x, int y, const SkAlpha aa[], const int16_t runs[]) {
-    if (!fBlitAntiH) {
-        SkRasterPipeline p(fAlloc);
-        p.extend(fColorPipeline);
-        p.append_gamut_clamp_if_normalized(fDst.info());
-        if (SkBlendMode_ShouldPreScaleCoverage(fBlend, /*rgb_coverage=*/false)) {
-            p.append(SkRasterPipeline::scale_1_float, &fCurrentCoverage);
-            this->append_load_dst(&p);
-            SkBlendMode_AppendStages(fBlend, &p);
-        } else {
-            this->append_load_dst(&p);
-            SkBlendMode_AppendStages(fBlend, &p);
-            p.append(SkRasterPipeline::lerp_1_float, &fCurrentCoverage);
-        }
+// Opaque runs at least this long are blit on their own with blitH(), which may be a memset.
+static const int kMinOpaqueRun = 8;
 
-        this->append_store(&p);
-        fBlitAntiH = p.compile();
+void SkRasterPipelineBlitter::blitAntiH(int x, int y, const SkAlpha aa[], const int16_t runs[]) {
+    // Along antialiased edges coverage changes nearly every pixel, so running the pipeline once
+    // per run would mean many runs of only a pixel or two.  Instead we gather the coverage of each
+    // stretch of partially covered pixels into fCoverageRow and blit it as a one-row A8 mask.
+    if (!fCoverageRow) {
+        fCoverageRow = fAlloc->makeArrayDefault<uint8_t>(fDst.width());
     }
 
+    int start = x;  // Coverage from start up to x has been gathered but not yet blit.
+    auto flush = [&] {
+        if (start < x) {
+            SkIRect clip = {start,y, x,y+1};
+
+            SkMask mask;
+            mask.fImage    = fCoverageRow + start;
+            mask.fBounds   = clip;
+            mask.fRowBytes = 0;
+            mask.fFormat   = SkMask::kA8_Format;
+
+            this->blitMask(mask, clip);
+        }
+    };
+
     for (int16_t run = *runs; run > 0; run = *runs) {
-        switch (*aa) {
-            case 0x00:                       break;
-            case 0xff: this->blitH(x,y,run); break;
-            default:
-                fCurrentCoverage = *aa * (1/255.0f);
-                fBlitAntiH(x,y,run,1);
+        SkASSERT(0 <= x && x + run <= fDst.width());
+        if (*aa == 0x00 || (*aa == 0xff && run >= kMinOpaqueRun)) {
+            flush();
+            if (*aa == 0xff) {
+                this->blitH(x,y,run);
+            }
+            start = x + run;
+        } else {
+            memset(fCoverageRow + x, *aa, run);
         }
         x    += run;
         runs += run;
         aa   += run;
     }
+    flush();
 }
 
 void SkRasterPipelineBlitter::blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) {
@@ -0,0 +1,524 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkRasterPipelineJIT.h"
+
+// We only know the stage calling convention for wide (JUMPER_NARROW_STAGES == 0) x86-64 stages.
+#if defined(SK_RASTER_PIPELINE_JIT) && defined(SK_LLVM_AVAILABLE) && \
+    defined(__x86_64__) && !defined(_WIN32)
+
+#include "SkCpu.h"
+#include "SkMutex.h"
+#include "SkOnce.h"
+#include "SkOpts.h"
+#include "SkRasterPipeline.h"
+#include "SkString.h"
+#include "SkTHash.h"
+
+#include "llvm-c/Analysis.h"
+#include "llvm-c/Core.h"
+#include "llvm-c/OrcBindings.h"
+#include "llvm-c/Support.h"
+#include "llvm-c/Target.h"
+#include "llvm-c/Transforms/PassManagerBuilder.h"
+#include "llvm/ExecutionEngine/RTDyldMemoryManager.h"
+
+using Stage = SkRasterPipelineJIT::Stage;
+
+// Stages we know how to emit, and whether each takes a context.  These are all pure arithmetic on
+// the r,g,b,a,dr,dg,db,da registers, so they never look at tail, dx, or dy.
+static bool is_fusable(const Stage& st) {
+    switch (st.id) {
+        case SkRasterPipeline::move_src_dst:
+        case SkRasterPipeline::move_dst_src:
+        case SkRasterPipeline::clamp_0:
+        case SkRasterPipeline::clamp_1:
+        case SkRasterPipeline::clamp_a:
+        case SkRasterPipeline::clamp_a_dst:
+        case SkRasterPipeline::premul:
+        case SkRasterPipeline::premul_dst:
+        case SkRasterPipeline::force_opaque:
+        case SkRasterPipeline::force_opaque_dst:
+        case SkRasterPipeline::swap_rb:
+        case SkRasterPipeline::swap_rb_dst:
+        case SkRasterPipeline::black_color:
+        case SkRasterPipeline::white_color:
+        case SkRasterPipeline::clear:
+        case SkRasterPipeline::srcatop:
+        case SkRasterPipeline::dstatop:
+        case SkRasterPipeline::srcin:
+        case SkRasterPipeline::dstin:
+        case SkRasterPipeline::srcout:
+        case SkRasterPipeline::dstout:
+        case SkRasterPipeline::srcover:
+        case SkRasterPipeline::dstover:
+        case SkRasterPipeline::modulate:
+        case SkRasterPipeline::multiply:
+        case SkRasterPipeline::plus_:
+        case SkRasterPipeline::screen:
+        case SkRasterPipeline::xor_:
+            return !st.hasCtx;
+
+        case SkRasterPipeline::uniform_color:
+        case SkRasterPipeline::unbounded_uniform_color:
+        case SkRasterPipeline::scale_1_float:
+        case SkRasterPipeline::lerp_1_float:
+        case SkRasterPipeline::matrix_4x5:
+            return st.hasCtx;
+    }
+    return false;
+}
+
+static uint64_t resolve_symbol(const char* name, void*) {
+    return llvm::RTDyldMemoryManager::getSymbolAddressInProcess(name);
+}
+
+namespace {
+
+class Fuser {
+public:
+    static Fuser* Get() {
+        static SkOnce once;
+        static Fuser* fuser;
+        once([]{ fuser = new Fuser; });
+        return fuser;
+    }
+
+    // Returns the fused stage for this run, or null if it's not (yet) worth compiling.
+    void* lookup(const Stage run[], int count) {
+        if (SkOpts::start_pipeline_highp != fStartPipeline) {
+            return nullptr;  // Someone swapped SkOpts tiers since we probed the stage width.
+        }
+
+        SkString key;
+        for (int i = 0; i < count; i++) {
+            key.appendU32((run[i].id << 1) | run[i].hasCtx);
+            key.append(",");
+        }
+
+        SkAutoMutexAcquire lock(fMutex);
+        Entry* entry = fCache.find(key);
+        if (!entry) {
+            entry = fCache.set(key, Entry{0, nullptr, false});
+        }
+        if (!entry->fn && !entry->failed && ++entry->builds >= SkRasterPipelineJIT::kHotBuilds) {
+            entry->fn     = this->compile(run, count);
+            entry->failed = !entry->fn;
+        }
+        return entry->fn;
+    }
+
+private:
+    struct Entry {
+        int   builds;
+        void* fn;
+        bool  failed;
+    };
+
+    Fuser() {
+        // Ask the active highp stages how many pixels they hold.  callback has no lowp version,
+        // and this one-stage pipeline has no run for Fuse() to look up, so we won't recurse.
+        struct Probe : SkRasterPipeline_CallbackCtx {
+            int stride = 0;
+        } probe;
+        probe.fn = [](SkRasterPipeline_CallbackCtx* self, int active) {
+            ((Probe*)self)->stride = active;
+        };
+        SkSTArenaAlloc<256> alloc;
+        SkRasterPipeline p(&alloc);
+        p.append(SkRasterPipeline::callback, &probe);
+        p.run(0,0, SkRasterPipeline_kMaxStride,1);
+
+        fStartPipeline = SkOpts::start_pipeline_highp;
+        fStride        = probe.stride;
+        fFMA           = fStride == 16 || (fStride == 8 && SkCpu::Supports(SkCpu::HSW));
+        const char* cpu = fStride == 16 ? "skylake-avx512"
+                        : fStride ==  8 ? (fFMA ? "haswell" : "sandybridge")
+                        : nullptr;
+
+        LLVMInitializeNativeTarget();
+        LLVMInitializeNativeAsmPrinter();
+        LLVMLinkInMCJIT();
+        if (LLVMLoadLibraryPermanently(nullptr)) {
+            SK_ABORT("LLVMLoadLibraryPermanently failed");
+        }
+
+        char* triple = LLVMGetDefaultTargetTriple();
+        char* error;
+        LLVMTargetRef target;
+        if (LLVMGetTargetFromTriple(triple, &target, &error) || !LLVMTargetHasJIT(target)) {
+            SK_ABORT("no LLVM JIT target");
+        }
+        LLVMTargetMachineRef targetMachine = LLVMCreateTargetMachine(target, triple, cpu, nullptr,
+                                                                     LLVMCodeGenLevelAggressive,
+                                                                     LLVMRelocDefault,
+                                                                     LLVMCodeModelJITDefault);
+        LLVMDisposeMessage(triple);
+        fDataLayout = LLVMCreateTargetDataLayout(targetMachine);
+        fJITStack   = LLVMOrcCreateInstance(targetMachine);  // Takes ownership of targetMachine.
+
+        fContext = LLVMContextCreate();
+        fFloat   = LLVMFloatTypeInContext(fContext);
+        fF       = LLVMVectorType(fFloat, fStride);
+        fSizeT   = LLVMInt64TypeInContext(fContext);
+        fPtr     = LLVMPointerType(LLVMInt8TypeInContext(fContext), 0);
+        LLVMTypeRef params[] = { fSizeT, LLVMPointerType(fPtr, 0), fSizeT, fSizeT,
+                                 fF, fF, fF, fF, fF, fF, fF, fF };
+        fStageType = LLVMFunctionType(LLVMVoidTypeInContext(fContext),
+                                      params, SK_ARRAY_COUNT(params), false);
+    }
+
+    // Everything needed to emit one fused stage.
+    struct Emitter {
+        Fuser*         self;
+        LLVMBuilderRef builder;
+        LLVMValueRef   fma;
+        LLVMValueRef   program;
+        LLVMValueRef   r,g,b,a, dr,dg,db,da;
+
+        LLVMValueRef splat(float v) {
+            LLVMValueRef lanes[SkRasterPipeline_kMaxStride];
+            for (int i = 0; i < self->fStride; i++) {
+                lanes[i] = LLVMConstReal(self->fFloat, v);
+            }
+            return LLVMConstVector(lanes, self->fStride);
+        }
+        LLVMValueRef splat(LLVMValueRef v) {
+            LLVMTypeRef I32 = LLVMInt32TypeInContext(self->fContext);
+            LLVMValueRef vec = LLVMBuildInsertElement(builder, LLVMGetUndef(self->fF), v,
+                                                      LLVMConstInt(I32, 0, false), "");
+            return LLVMBuildShuffleVector(builder, vec, LLVMGetUndef(self->fF),
+                                          LLVMConstNull(LLVMVectorType(I32, self->fStride)), "");
+        }
+
+        // Load float ctx[i] from the context in program slot, broadcast to all lanes.
+        LLVMValueRef ctx(int slot, int i) {
+            LLVMValueRef index = LLVMConstInt(self->fSizeT, slot, false);
+            LLVMValueRef ptr   = LLVMBuildLoad(builder,
+                                               LLVMBuildGEP(builder, program, &index, 1, ""), "");
+            ptr = LLVMBuildBitCast(builder, ptr, LLVMPointerType(self->fFloat, 0), "");
+            index = LLVMConstInt(self->fSizeT, i, false);
+            return this->splat(LLVMBuildLoad(builder, LLVMBuildGEP(builder, ptr, &index, 1, ""),
+                                             ""));
+        }
+
+        LLVMValueRef add(LLVMValueRef x, LLVMValueRef y) { return LLVMBuildFAdd(builder,x,y,""); }
+        LLVMValueRef sub(LLVMValueRef x, LLVMValueRef y) { return LLVMBuildFSub(builder,x,y,""); }
+        LLVMValueRef mul(LLVMValueRef x, LLVMValueRef y) { return LLVMBuildFMul(builder,x,y,""); }
+        LLVMValueRef inv(LLVMValueRef x) { return this->sub(this->splat(1.0f), x); }
+
+        // Matches the x86 min/max instructions, which return y when either argument is NaN.
+        LLVMValueRef min(LLVMValueRef x, LLVMValueRef y) {
+            return LLVMBuildSelect(builder, LLVMBuildFCmp(builder, LLVMRealOLT, x,y, ""), x,y, "");
+        }
+        LLVMValueRef max(LLVMValueRef x, LLVMValueRef y) {
+            return LLVMBuildSelect(builder, LLVMBuildFCmp(builder, LLVMRealOGT, x,y, ""), x,y, "");
+        }
+        LLVMValueRef mad(LLVMValueRef f, LLVMValueRef m, LLVMValueRef a) {
+            if (fma) {
+                LLVMValueRef args[] = { f, m, a };
+                return LLVMBuildCall(builder, fma, args, 3, "");
+            }
+            return this->add(this->mul(f, m), a);
+        }
+
+        template <typename Fn>
+        void blend(Fn&& fn) {
+            r = fn(r,dr,a,da);
+            g = fn(g,dg,a,da);
+            b = fn(b,db,a,da);
+            a = fn(a,da,a,da);
+        }
+
+        // Emit one stage whose context, if any, lives in program slot.  Mirrors the highp
+        // STAGE()s in SkRasterPipeline_opts.h.
+        void emit(int stage, int slot) {
+            using V = LLVMValueRef;
+            switch (stage) {
+                case SkRasterPipeline::move_src_dst: dr = r; dg = g; db = b; da = a; break;
+                case SkRasterPipeline::move_dst_src: r = dr; g = dg; b = db; a = da; break;
+
+                case SkRasterPipeline::clamp_0: {
+                    V zero = this->splat(0.0f);
+                    r = this->max(r, zero);
+                    g = this->max(g, zero);
+                    b = this->max(b, zero);
+                    a = this->max(a, zero);
+                } break;
+                case SkRasterPipeline::clamp_1: {
+                    V one = this->splat(1.0f);
+                    r = this->min(r, one);
+                    g = this->min(g, one);
+                    b = this->min(b, one);
+                    a = this->min(a, one);
+                } break;
+                case SkRasterPipeline::clamp_a:
+                    a = this->min(a, this->splat(1.0f));
+                    r = this->min(r, a);
+                    g = this->min(g, a);
+                    b = this->min(b, a);
+                    break;
+                case SkRasterPipeline::clamp_a_dst:
+                    da = this->min(da, this->splat(1.0f));
+                    dr = this->min(dr, da);
+                    dg = this->min(dg, da);
+                    db = this->min(db, da);
+                    break;
+
+                case SkRasterPipeline::premul:
+                    r = this->mul(r, a);
+                    g = this->mul(g, a);
+                    b = this->mul(b, a);
+                    break;
+                case SkRasterPipeline::premul_dst:
+                    dr = this->mul(dr, da);
+                    dg = this->mul(dg, da);
+                    db = this->mul(db, da);
+                    break;
+
+                case SkRasterPipeline::force_opaque:      a = this->splat(1.0f); break;
+                case SkRasterPipeline::force_opaque_dst: da = this->splat(1.0f); break;
+
+                case SkRasterPipeline::swap_rb:     std::swap( r,  b); break;
+                case SkRasterPipeline::swap_rb_dst: std::swap(dr, db); break;
+
+                case SkRasterPipeline::black_color:
+                    r = g = b = this->splat(0.0f);
+                    a = this->splat(1.0f);
+                    break;
+                case SkRasterPipeline::white_color:
+                    r = g = b = a = this->splat(1.0f);
+                    break;
+                case SkRasterPipeline::uniform_color:
+                case SkRasterPipeline::unbounded_uniform_color:
+                    // SkRasterPipeline_UniformColorCtx starts with float r,g,b,a.
+                    r = this->ctx(slot, 0);
+                    g = this->ctx(slot, 1);
+                    b = this->ctx(slot, 2);
+                    a = this->ctx(slot, 3);
+                    break;
+
+                case SkRasterPipeline::scale_1_float: {
+                    V c = this->ctx(slot, 0);
+                    r = this->mul(r, c);
+                    g = this->mul(g, c);
+                    b = this->mul(b, c);
+                    a = this->mul(a, c);
+                } break;
+                case SkRasterPipeline::lerp_1_float: {
+                    V c = this->ctx(slot, 0);
+                    r = this->mad(this->sub(r, dr), c, dr);
+                    g = this->mad(this->sub(g, dg), c, dg);
+                    b = this->mad(this->sub(b, db), c, db);
+                    a = this->mad(this->sub(a, da), c, da);
+                } break;
+                case SkRasterPipeline::matrix_4x5: {
+                    V m[20];
+                    for (int i = 0; i < 20; i++) {
+                        m[i] = this->ctx(slot, i);
+                    }
+                    V R = this->mad(r,m[0], this->mad(g,m[4], this->mad(b,m[ 8],
+                                                                this->mad(a,m[12], m[16])))),
+                      G = this->mad(r,m[1], this->mad(g,m[5], this->mad(b,m[ 9],
+                                                                this->mad(a,m[13], m[17])))),
+                      B = this->mad(r,m[2], this->mad(g,m[6], this->mad(b,m[10],
+                                                                this->mad(a,m[14], m[18])))),
+                      A = this->mad(r,m[3], this->mad(g,m[7], this->mad(b,m[11],
+                                                                this->mad(a,m[15], m[19]))));
+                    r = R;
+                    g = G;
+                    b = B;
+                    a = A;
+                } break;
+
+                case SkRasterPipeline::clear:
+                    r = g = b = a = this->splat(0.0f);
+                    break;
+                case SkRasterPipeline::srcatop:
+                    this->blend([&](V s, V d, V sa, V da) {
+                        return this->add(this->mul(s, da), this->mul(d, this->inv(sa)));
+                    });
+                    break;
+                case SkRasterPipeline::dstatop:
+                    this->blend([&](V s, V d, V sa, V da) {
+                        return this->add(this->mul(d, sa), this->mul(s, this->inv(da)));
+                    });
+                    break;
+                case SkRasterPipeline::srcin:
+                    this->blend([&](V s, V, V, V da) { return this->mul(s, da); });
+                    break;
+                case SkRasterPipeline::dstin:
+                    this->blend([&](V, V d, V sa, V) { return this->mul(d, sa); });
+                    break;
+                case SkRasterPipeline::srcout:
+                    this->blend([&](V s, V, V, V da) { return this->mul(s, this->inv(da)); });
+                    break;
+                case SkRasterPipeline::dstout:
+                    this->blend([&](V, V d, V sa, V) { return this->mul(d, this->inv(sa)); });
+                    break;
+                case SkRasterPipeline::srcover:
+                    this->blend([&](V s, V d, V sa, V) { return this->mad(d, this->inv(sa), s); });
+                    break;
+                case SkRasterPipeline::dstover:
+                    this->blend([&](V s, V d, V, V da) { return this->mad(s, this->inv(da), d); });
+                    break;
+                case SkRasterPipeline::modulate:
+                    this->blend([&](V s, V d, V, V) { return this->mul(s, d); });
+                    break;
+                case SkRasterPipeline::multiply:
+                    this->blend([&](V s, V d, V sa, V da) {
+                        return this->add(this->add(this->mul(s, this->inv(da)),
+                                                   this->mul(d, this->inv(sa))),
+                                         this->mul(s, d));
+                    });
+                    break;
+                case SkRasterPipeline::plus_:
+                    this->blend([&](V s, V d, V, V) {
+                        return this->min(this->add(s, d), this->splat(1.0f));
+                    });
+                    break;
+                case SkRasterPipeline::screen:
+                    this->blend([&](V s, V d, V, V) {
+                        return this->sub(this->add(s, d), this->mul(s, d));
+                    });
+                    break;
+                case SkRasterPipeline::xor_:
+                    this->blend([&](V s, V d, V sa, V da) {
+                        return this->add(this->mul(s, this->inv(da)),
+                                         this->mul(d, this->inv(sa)));
+                    });
+                    break;
+                default:
+                    SkASSERT(false);
+            }
+        }
+    };
+
+    // Called with fMutex held.
+    void* compile(const Stage run[], int count) {
+        SkString name = SkStringPrintf("sk_fused_stage_%d", fCompiled++);
+        LLVMModuleRef module = LLVMModuleCreateWithNameInContext(name.c_str(), fContext);
+        LLVMSetModuleDataLayout(module, fDataLayout);
+
+        LLVMValueRef fn = LLVMAddFunction(module, name.c_str(), fStageType);
+        if (fStride == 16) {
+            // Keep the 16-wide registers in zmm, as the SKX stages we chain with expect.
+            LLVMAddTargetDependentFunctionAttr(fn, "prefer-vector-width",    "512");
+            LLVMAddTargetDependentFunctionAttr(fn, "min-legal-vector-width", "512");
+        }
+
+        LLVMValueRef params[12];
+        LLVMGetParams(fn, params);
+
+        Emitter e;
+        e.self    = this;
+        e.builder = LLVMCreateBuilderInContext(fContext);
+        e.fma     = nullptr;
+        if (fFMA) {
+            LLVMTypeRef fmaParams[] = { fF, fF, fF };
+            e.fma = LLVMAddFunction(module, SkStringPrintf("llvm.fma.v%df32", fStride).c_str(),
+                                    LLVMFunctionType(fF, fmaParams, 3, false));
+        }
+        e.program = params[1];
+        e.r  = params[ 4]; e.g  = params[ 5]; e.b  = params[ 6]; e.a  = params[ 7];
+        e.dr = params[ 8]; e.dg = params[ 9]; e.db = params[10]; e.da = params[11];
+        LLVMPositionBuilderAtEnd(e.builder, LLVMAppendBasicBlockInContext(fContext, fn, "entry"));
+
+        // On entry program points just past our own function slot, i.e. at run[0]'s context.
+        int slot = 0;
+        for (int i = 0; i < count; i++) {
+            e.emit(run[i].id, slot);
+            slot += run[i].hasCtx ? 2 : 1;
+        }
+
+        // The next stage's function is in the slot where the last fused stage's would end.
+        LLVMValueRef index = LLVMConstInt(fSizeT, slot - 1, false);
+        LLVMValueRef next  = LLVMBuildLoad(e.builder,
+                                           LLVMBuildGEP(e.builder, e.program, &index, 1, ""), "");
+        next  = LLVMBuildBitCast(e.builder, next, LLVMPointerType(fStageType, 0), "");
+        index = LLVMConstInt(fSizeT, slot, false);
+        LLVMValueRef args[] = {
+            params[0], LLVMBuildGEP(e.builder, e.program, &index, 1, ""), params[2], params[3],
+            e.r, e.g, e.b, e.a, e.dr, e.dg, e.db, e.da,
+        };
+        LLVMSetTailCall(LLVMBuildCall(e.builder, next, args, SK_ARRAY_COUNT(args), ""), true);
+        LLVMBuildRetVoid(e.builder);
+        LLVMDisposeBuilder(e.builder);
+
+        if (LLVMVerifyFunction(fn, LLVMPrintMessageAction)) {
+            LLVMDisposeModule(module);
+            return nullptr;
+        }
+
+        LLVMPassManagerBuilderRef pmb = LLVMPassManagerBuilderCreate();
+        LLVMPassManagerBuilderSetOptLevel(pmb, 3);
+        LLVMPassManagerRef functionPM = LLVMCreateFunctionPassManagerForModule(module);
+        LLVMPassManagerBuilderPopulateFunctionPassManager(pmb, functionPM);
+        LLVMInitializeFunctionPassManager(functionPM);
+        LLVMRunFunctionPassManager(functionPM, fn);
+        LLVMFinalizeFunctionPassManager(functionPM);
+        LLVMDisposePassManager(functionPM);
+        LLVMPassManagerBuilderDispose(pmb);
+
+        // fJITStack keeps the compiled code alive for as long as we do, which is forever.
+        LLVMSharedModuleRef shared = LLVMOrcMakeSharedModule(module);
+        LLVMOrcModuleHandle handle;
+        LLVMOrcAddEagerlyCompiledIR(fJITStack, &handle, shared, resolve_symbol, nullptr);
+        LLVMOrcDisposeSharedModuleRef(shared);
+
+        LLVMOrcTargetAddress address;
+        if (LLVMOrcGetSymbolAddress(fJITStack, &address, name.c_str())) {
+            return nullptr;
+        }
+        return (void*)address;
+    }
+
+    void (*fStartPipeline)(size_t,size_t,size_t,size_t, void**);
+    int                fStride;
+    bool               fFMA;
+    int                fCompiled = 0;
+
+    LLVMContextRef     fContext;
+    LLVMTargetDataRef  fDataLayout;
+    LLVMOrcJITStackRef fJITStack;
+    LLVMTypeRef        fFloat,
+                       fF,
+                       fSizeT,
+                       fPtr,
+                       fStageType;
+
+    SkMutex                      fMutex;
+    SkTHashMap<SkString, Entry>  fCache;
+};
+
+}  // namespace
+
+void SkRasterPipelineJIT::Fuse(const Stage stages[], int count, void** program) {
+    int slot = 0;
+    for (int i = 0; i < count; ) {
+        int end = i;
+        while (end < count && is_fusable(stages[end])) {
+            end++;
+        }
+        // Runs of one stage would gain nothing.  Checking this before Fuser::Get() also keeps
+        // the Fuser's own probe pipeline from recursing back into it.
+        if (end - i >= 2) {
+            if (void* fused = Fuser::Get()->lookup(stages + i, end - i)) {
+                program[slot] = fused;
+            }
+        }
+        for (end = SkTMax(end, i+1); i < end; i++) {
+            slot += stages[i].hasCtx ? 2 : 1;
+        }
+    }
+}
+
+#else
+
+void SkRasterPipelineJIT::Fuse(const Stage[], int, void**) {}
+
+#endif
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRasterPipelineJIT_DEFINED
+#define SkRasterPipelineJIT_DEFINED
+
+#include "SkTypes.h"
+
+/**
+ * Fuses runs of simple arithmetic stages in a highp SkRasterPipeline program into single stages
+ * compiled with LLVM, removing the per-stage indirect call and letting LLVM schedule the math of
+ * the whole run together.  Only active when the skia_enable_raster_pipeline_jit gn arg is set
+ * (which in turn needs skia_llvm_path); otherwise Fuse() is a no-op.
+ *
+ * Compiled runs are cached by their stage ids and context layout, not their context pointers, so
+ * the same code serves every pipeline of that shape.  A run is compiled only once it has been
+ * built kHotBuilds times; pipelines that are built once and thrown away never pay for LLVM.
+ */
+class SkRasterPipelineJIT {
+public:
+    struct Stage {
+        int  id;        // An SkRasterPipeline::StockStage, or -1 for a raw function.
+        bool hasCtx;    // Does this stage take a context slot in the program?
+    };
+
+    static constexpr int kHotBuilds = 8;
+
+    // The highp program starting at program holds stages[0..count) in order.  Fusable runs have
+    // their first stage's function replaced in place; the rest of their slots are left alone.
+    static void Fuse(const Stage stages[], int count, void** program);
+};
+
+#endif
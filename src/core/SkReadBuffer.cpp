@@ -161,8 +161,9 @@ void SkReadBuffer::readColor4f(SkColor4f* color) {
 }
 
 void SkReadBuffer::readPoint(SkPoint* point) {
-    point->fX = this->readScalar();
-    point->fY = this->readScalar();
+    if (!this->readPad32(point, sizeof(SkPoint))) {
+        point->set(0, 0);
+    }
 }
 
 void SkReadBuffer::readPoint3(SkPoint3* point) {
@@ -257,12 +258,21 @@ sk_sp<SkData> SkReadBuffer::readByteArrayAsData() {
         return nullptr;
     }
 
-    SkAutoMalloc buffer(numBytes);
-    if (!this->readByteArray(buffer.get(), numBytes)) {
-        return nullptr;
-    }
+    (void)this->readUInt();
+    const void* src = this->skip(numBytes);
+    return src ? this->makeData(src, numBytes) : nullptr;
+}
 
-    return SkData::MakeFromMalloc(buffer.release(), numBytes);
+sk_sp<SkData> SkReadBuffer::makeData(const void* src, size_t size) const {
+    if (fBackingData) {
+        const char* base = (const char*)fBackingData->data();
+        const char* bytes = (const char*)src;
+        if (bytes >= base && size <= fBackingData->size() &&
+            bytes - base <= (ptrdiff_t)(fBackingData->size() - size)) {
+            return SkData::MakeSubset(fBackingData.get(), bytes - base, size);
+        }
+    }
+    return SkData::MakeWithCopy(src, size);
 }
 
 uint32_t SkReadBuffer::getArrayCount() {
@@ -319,11 +329,12 @@ sk_sp<SkImage> SkReadBuffer::readImage() {
         return nullptr;
     }
 
-    sk_sp<SkData> data = SkData::MakeUninitialized(size);
-    if (!this->readPad32(data->writable_data(), size)) {
+    const void* src = this->skip(size);
+    if (!src) {
         this->validate(false);
         return nullptr;
     }
+    sk_sp<SkData> data = this->makeData(src, size);
     if (this->isVersionLT(kDontNegateImageSize_Version)) {
         (void)this->read32();   // originX
         (void)this->read32();   // originY
@@ -372,9 +383,18 @@ sk_sp<SkTypeface> SkReadBuffer::readTypeface() {
 
 SkFlattenable* SkReadBuffer::readFlattenable(SkFlattenable::Type ft) {
     SkFlattenable::Factory factory = nullptr;
+    size_t start = fReader.offset();
 
     if (fFactoryCount > 0) {
         int32_t index = this->read32();
+        if ((uint32_t)index == SkBinaryWriteBuffer::kFlattenableBackReference) {
+            uint32_t firstOffset = this->readUInt();
+            sk_sp<SkFlattenable>* first = fFlattenablesByOffset.find(firstOffset);
+            if (!this->validate(first && (!*first || (*first)->getFlattenableType() == ft))) {
+                return nullptr;
+            }
+            return SkSafeRef(first->get());
+        }
         if (0 == index || !this->isValid()) {
             return nullptr; // writer failed to give us the flattenable
         }
@@ -434,6 +454,9 @@ SkFlattenable* SkReadBuffer::readFlattenable(SkFlattenable::Type ft) {
     if (!this->isValid()) {
         return nullptr;
     }
+    if (fFactoryCount > 0) {
+        fFlattenablesByOffset.set(SkToU32(start), obj);
+    }
     return obj.release();
 }
 
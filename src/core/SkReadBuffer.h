@@ -47,6 +47,8 @@ public:
         kSaveBehind_Version                = 66,
         kSerializeFonts_Version            = 67,
         kPaintDoesntSerializeFonts_Version = 68,
+        kAlignedStreamData_Version         = 69,
+        kDedupFlattenables_Version         = 70,
     };
 
     /**
@@ -168,6 +170,12 @@ public:
     void setDeserialProcs(const SkDeserialProcs& procs);
     const SkDeserialProcs& getDeserialProcs() const { return fProcs; }
 
+    /**
+     *  Call this when the buffer's memory lies inside 'data'. Byte arrays and encoded images
+     *  read from the buffer then share 'data' instead of being copied out of it.
+     */
+    void setBackingData(sk_sp<const SkData> data) { fBackingData = std::move(data); }
+
     /**
      *  If isValid is false, sets the buffer to be "invalid". Returns true if the buffer
      *  is still valid.
@@ -211,8 +219,11 @@ private:
     void setInvalid();
     bool readArray(void* value, size_t size, size_t elementSize);
     void setMemory(const void*, size_t);
+    // Returns 'size' bytes at 'src', sharing fBackingData if they lie inside it.
+    sk_sp<SkData> makeData(const void* src, size_t size) const;
 
     SkReader32 fReader;
+    sk_sp<const SkData> fBackingData;
 
     // Only used if we do not have an fFactoryArray.
     SkTHashMap<uint32_t, SkFlattenable::Factory> fFlattenableDict;
@@ -225,6 +236,10 @@ private:
     SkFlattenable::Factory* fFactoryArray;
     int                     fFactoryCount;
 
+    // Flattenables read with fFactoryArray, by the offset they were read from, so that
+    // SkBinaryWriteBuffer::kFlattenableBackReference can refer back to them.
+    SkTHashMap<uint32_t, sk_sp<SkFlattenable>> fFlattenablesByOffset;
+
     SkDeserialProcs fProcs;
 
     static bool IsPtrAlign4(const void* ptr) {
@@ -255,6 +270,8 @@ public:
         kSaveBehind_Version                = 66,
         kSerializeFonts_Version            = 67,
         kPaintDoesntSerializeFonts_Version = 68,
+        kAlignedStreamData_Version         = 69,
+        kDedupFlattenables_Version         = 70,
     };
 
     bool isVersionLT(Version) const { return false; }
@@ -321,6 +338,7 @@ public:
     bool readScalarArray (SkScalar*,  size_t) { return false; }
 
     sk_sp<SkData> readByteArrayAsData() { return nullptr; }
+    void setBackingData(sk_sp<const SkData>) {}
     uint32_t getArrayCount() { return 0; }
 
     sk_sp<SkImage>    readImage()    { return nullptr; }
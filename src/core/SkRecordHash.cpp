@@ -0,0 +1,248 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkAutoMalloc.h"
+#include "SkOpts.h"
+#include "SkPatchUtils.h"
+#include "SkPathPriv.h"
+#include "SkRecord.h"
+#include "SkRecordHash.h"
+#include "SkRecords.h"
+#include "SkTemplates.h"
+
+namespace {
+
+class OpHasher {
+public:
+    uint32_t fHash = 0;
+    bool fHashable = true;
+
+    template <typename T>
+    void operator()(const T& op) {
+        this->mixPOD(T::kType);
+        this->mix(op);
+    }
+
+private:
+    void mixBytes(const void* bytes, size_t size) {
+        fHash = SkOpts::hash_fn(bytes, size, fHash);
+    }
+    template <typename T>
+    void mixPOD(const T& value) { this->mixBytes(&value, sizeof(value)); }
+    template <typename T>
+    void mixArray(const T* values, int count) {
+        this->mixPOD(values != nullptr);
+        if (values) {
+            this->mixBytes(values, count * sizeof(T));
+        }
+    }
+    template <typename T>
+    void mixPtr(const sk_sp<T>& ptr) { this->mixPOD(ptr.get()); }
+    template <typename T>
+    void mixOptional(const SkRecords::Optional<T>& opt) {
+        this->mixPOD(opt != nullptr);
+        if (opt) {
+            this->mixValue(*opt);
+        }
+    }
+
+    void mixValue(const SkRect& rect) { this->mixPOD(rect); }
+    void mixValue(const SkRRect& rrect) { this->mixPOD(rrect); }
+    void mixValue(const SkPaint& paint) { this->mixPOD(paint.getHash()); }
+    void mixValue(const SkMatrix& matrix) {
+        // Skip SkMatrix's lazily computed type mask.
+        SkScalar values[9];
+        matrix.get9(values);
+        this->mixPOD(values);
+    }
+    void mixValue(const SkPath& path) {
+        this->mixPOD(path.getFillType());
+        this->mixBytes(SkPathPriv::VerbData(path), path.countVerbs());
+        this->mixArray(SkPathPriv::PointData(path), path.countPoints());
+        this->mixArray(SkPathPriv::ConicWeightData(path), SkPathPriv::ConicWeightCnt(path));
+    }
+    void mixValue(const SkRegion& region) {
+        size_t size = region.writeToMemory(nullptr);
+        SkAutoSMalloc<256> storage(size);
+        region.writeToMemory(storage.get());
+        this->mixBytes(storage.get(), size);
+    }
+
+    void mix(const SkRecords::NoOp&) {}
+    void mix(const SkRecords::Flush&) {}
+    void mix(const SkRecords::Restore& op) { this->mixValue(op.matrix); }
+    void mix(const SkRecords::Save&) {}
+    void mix(const SkRecords::SaveLayer& op) {
+        this->mixOptional(op.bounds);
+        this->mixOptional(op.paint);
+        this->mixPtr(op.backdrop);
+        this->mixPtr(op.clipMask);
+        this->mixOptional(op.clipMatrix);
+        this->mixPOD(op.saveLayerFlags);
+    }
+    void mix(const SkRecords::SaveBehind& op) { this->mixOptional(op.subset); }
+    void mix(const SkRecords::SetMatrix& op) { this->mixValue(op.matrix); }
+    void mix(const SkRecords::Concat& op) { this->mixValue(op.matrix); }
+    void mix(const SkRecords::Translate& op) {
+        this->mixPOD(op.dx);
+        this->mixPOD(op.dy);
+    }
+    void mix(const SkRecords::ClipPath& op) {
+        this->mixValue(op.path);
+        this->mixPOD(op.opAA);
+    }
+    void mix(const SkRecords::ClipRRect& op) {
+        this->mixValue(op.rrect);
+        this->mixPOD(op.opAA);
+    }
+    void mix(const SkRecords::ClipRect& op) {
+        this->mixValue(op.rect);
+        this->mixPOD(op.opAA);
+    }
+    void mix(const SkRecords::ClipRegion& op) {
+        this->mixValue(op.region);
+        this->mixPOD(op.op);
+    }
+    void mix(const SkRecords::DrawArc& op) {
+        this->mixValue(op.paint);
+        this->mixValue(op.oval);
+        this->mixPOD(op.startAngle);
+        this->mixPOD(op.sweepAngle);
+        this->mixPOD(op.useCenter);
+    }
+    void mix(const SkRecords::DrawDRRect& op) {
+        this->mixValue(op.paint);
+        this->mixValue(op.outer);
+        this->mixValue(op.inner);
+    }
+    void mix(const SkRecords::DrawDrawable&) { fHashable = false; }
+    void mix(const SkRecords::DrawImage& op) {
+        this->mixOptional(op.paint);
+        this->mixPtr(op.image);
+        this->mixPOD(op.left);
+        this->mixPOD(op.top);
+    }
+    void mix(const SkRecords::DrawImageLattice& op) {
+        this->mixOptional(op.paint);
+        this->mixPtr(op.image);
+        this->mixArray(op.xDivs.operator int*(), op.xCount);
+        this->mixArray(op.yDivs.operator int*(), op.yCount);
+        this->mixArray(op.flags.operator SkCanvas::Lattice::RectType*(), op.flagCount);
+        this->mixArray(op.colors.operator SkColor*(), op.flagCount);
+        this->mixPOD(op.src);
+        this->mixValue(op.dst);
+    }
+    void mix(const SkRecords::DrawImageRect& op) {
+        this->mixOptional(op.paint);
+        this->mixPtr(op.image);
+        this->mixOptional(op.src);
+        this->mixValue(op.dst);
+        this->mixPOD(op.constraint);
+    }
+    void mix(const SkRecords::DrawImageNine& op) {
+        this->mixOptional(op.paint);
+        this->mixPtr(op.image);
+        this->mixPOD(op.center);
+        this->mixValue(op.dst);
+    }
+    void mix(const SkRecords::DrawImageSet& op) {
+        for (int i = 0; i < op.count; ++i) {
+            const SkCanvas::ImageSetEntry& entry = op.set[i];
+            this->mixPtr(entry.fImage);
+            this->mixValue(entry.fSrcRect);
+            this->mixValue(entry.fDstRect);
+            this->mixPOD(entry.fAlpha);
+            this->mixPOD(entry.fAAFlags);
+        }
+        this->mixPOD(op.quality);
+        this->mixPOD(op.mode);
+    }
+    void mix(const SkRecords::DrawOval& op) {
+        this->mixValue(op.paint);
+        this->mixValue(op.oval);
+    }
+    void mix(const SkRecords::DrawPaint& op) { this->mixValue(op.paint); }
+    void mix(const SkRecords::DrawBehind& op) { this->mixValue(op.paint); }
+    void mix(const SkRecords::DrawPath& op) {
+        this->mixValue(op.paint);
+        this->mixValue(op.path);
+    }
+    void mix(const SkRecords::DrawPicture& op) {
+        this->mixOptional(op.paint);
+        this->mixPtr(op.picture);
+        this->mixValue(op.matrix);
+    }
+    void mix(const SkRecords::DrawPoints& op) {
+        this->mixValue(op.paint);
+        this->mixPOD(op.mode);
+        this->mixArray(op.pts, op.count);
+    }
+    void mix(const SkRecords::DrawRRect& op) {
+        this->mixValue(op.paint);
+        this->mixValue(op.rrect);
+    }
+    void mix(const SkRecords::DrawRect& op) {
+        this->mixValue(op.paint);
+        this->mixValue(op.rect);
+    }
+    void mix(const SkRecords::DrawEdgeAARect& op) {
+        this->mixValue(op.rect);
+        this->mixPOD(op.aa);
+        this->mixPOD(op.color);
+        this->mixPOD(op.mode);
+    }
+    void mix(const SkRecords::DrawRegion& op) {
+        this->mixValue(op.paint);
+        this->mixValue(op.region);
+    }
+    void mix(const SkRecords::DrawTextBlob& op) {
+        this->mixValue(op.paint);
+        this->mixPtr(op.blob);
+        this->mixPOD(op.x);
+        this->mixPOD(op.y);
+    }
+    void mix(const SkRecords::DrawPatch& op) {
+        this->mixValue(op.paint);
+        this->mixArray(op.cubics.operator SkPoint*(), SkPatchUtils::kNumCtrlPts);
+        this->mixArray(op.colors.operator SkColor*(), 4);
+        this->mixArray(op.texCoords.operator SkPoint*(), 4);
+        this->mixPOD(op.bmode);
+    }
+    void mix(const SkRecords::DrawAtlas& op) {
+        this->mixOptional(op.paint);
+        this->mixPtr(op.atlas);
+        this->mixArray(op.xforms.operator SkRSXform*(), op.count);
+        this->mixArray(op.texs.operator SkRect*(), op.count);
+        this->mixArray(op.colors.operator SkColor*(), op.count);
+        this->mixPOD(op.mode);
+        this->mixOptional(op.cull);
+    }
+    void mix(const SkRecords::DrawVertices& op) {
+        this->mixValue(op.paint);
+        this->mixPtr(op.vertices);
+        this->mixArray(op.bones.operator SkVertices::Bone*(), op.boneCount);
+        this->mixPOD(op.bmode);
+    }
+    void mix(const SkRecords::DrawShadowRec& op) {
+        this->mixValue(op.path);
+        this->mixPOD(op.rec);
+    }
+    void mix(const SkRecords::DrawAnnotation& op) {
+        this->mixValue(op.rect);
+        this->mixBytes(op.key.c_str(), op.key.size());
+        this->mixPtr(op.value);
+    }
+};
+
+}  // namespace
+
+bool SkRecordHashOp(const SkRecord& record, int i, uint32_t* hash) {
+    OpHasher hasher;
+    record.visit(i, hasher);
+    *hash = hasher.fHash;
+    return hasher.fHashable;
+}
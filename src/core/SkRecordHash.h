@@ -0,0 +1,21 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRecordHash_DEFINED
+#define SkRecordHash_DEFINED
+
+#include "SkTypes.h"
+
+class SkRecord;
+
+// Hashes the type and content of the op record[i] into *hash, returning false if the op can't
+// be hashed. Refcounted objects (images, blobs, pictures, effects on paints) are hashed by
+// address, so two hashes only compare meaningfully while the records they came from are alive.
+// Drawables can change after recording, so ops that draw them are never hashable.
+bool SkRecordHashOp(const SkRecord& record, int i, uint32_t* hash);
+
+#endif//SkRecordHash_DEFINED
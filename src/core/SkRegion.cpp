@@ -10,6 +10,7 @@
 #include "SkMacros.h"
 #include "SkRegionPriv.h"
 #include "SkSafeMath.h"
+#include "SkTArray.h"
 #include "SkTemplates.h"
 #include "SkTo.h"
 #include "SkUTF.h"
@@ -649,13 +650,30 @@ void SkRegion::translate(int dx, int dy, SkRegion* dst) const {
 
 bool SkRegion::setRects(const SkIRect rects[], int count) {
     if (0 == count) {
-        this->setEmpty();
-    } else {
-        this->setRect(rects[0]);
-        for (int i = 1; i < count; i++) {
-            this->op(rects[i], kUnion_Op);
+        return this->setEmpty();
+    }
+    if (1 == count) {
+        return this->setRect(rects[0]);
+    }
+
+    // Union the rects pairwise in a balanced tree rather than folding them in one at a time.
+    // Each level of the tree walks every run once, so building the union costs O(n log n) in
+    // the size of the result instead of O(n^2).
+    SkTArray<SkRegion> level(count);
+    for (int i = 0; i < count; i++) {
+        level.push_back(SkRegion(rects[i]));
+    }
+    while (level.count() > 1) {
+        int n = level.count();
+        for (int i = 0; i < n / 2; i++) {
+            level[i].op(level[2*i], level[2*i + 1], kUnion_Op);
         }
+        if (n & 1) {
+            level[n / 2].swap(level[n - 1]);
+        }
+        level.pop_back_n(n / 2);
     }
+    this->swap(level[0]);
     return !this->isEmpty();
 }
 
@@ -1030,6 +1048,48 @@ static bool setRegionCheck(SkRegion* result, const SkRegion& rgn) {
     return result ? result->setRegion(rgn) : !rgn.isEmpty();
 }
 
+// Two rects whose union is itself a rect: they share a pair of opposite edges and overlap or
+// touch along the other axis.
+static bool rect_union_is_rect(const SkIRect& a, const SkIRect& b, SkIRect* result) {
+    bool stacked = a.fLeft == b.fLeft && a.fRight == b.fRight &&
+                   a.fTop <= b.fBottom && b.fTop <= a.fBottom;
+    bool abutted = a.fTop == b.fTop && a.fBottom == b.fBottom &&
+                   a.fLeft <= b.fRight && b.fLeft <= a.fRight;
+    if (stacked || abutted) {
+        result->set(SkMin32(a.fLeft, b.fLeft), SkMin32(a.fTop, b.fTop),
+                    SkMax32(a.fRight, b.fRight), SkMax32(a.fBottom, b.fBottom));
+        return true;
+    }
+    return false;
+}
+
+// Subtracting b from a leaves a rect when b spans a along one axis and covers one end of it
+// along the other. The rects are known to intersect, and b does not contain a.
+static bool rect_difference_is_rect(const SkIRect& a, const SkIRect& b, SkIRect* result) {
+    *result = a;
+    if (b.fLeft <= a.fLeft && b.fRight >= a.fRight) {
+        if (b.fTop <= a.fTop) {
+            result->fTop = b.fBottom;
+            return true;
+        }
+        if (b.fBottom >= a.fBottom) {
+            result->fBottom = b.fTop;
+            return true;
+        }
+    }
+    if (b.fTop <= a.fTop && b.fBottom >= a.fBottom) {
+        if (b.fLeft <= a.fLeft) {
+            result->fLeft = b.fRight;
+            return true;
+        }
+        if (b.fRight >= a.fRight) {
+            result->fRight = b.fLeft;
+            return true;
+        }
+    }
+    return false;
+}
+
 bool SkRegion::Oper(const SkRegion& rgnaOrig, const SkRegion& rgnbOrig, Op op,
                     SkRegion* result) {
     SkASSERT((unsigned)op < kOpCount);
@@ -1068,6 +1128,9 @@ bool SkRegion::Oper(const SkRegion& rgnaOrig, const SkRegion& rgnbOrig, Op op,
         if (b_rect && rgnb->fBounds.containsNoEmptyCheck(rgna->fBounds)) {
             return setEmptyCheck(result);
         }
+        if (a_rect && b_rect && rect_difference_is_rect(rgna->fBounds, rgnb->fBounds, &bounds)) {
+            return setRectCheck(result, bounds);
+        }
         break;
 
     case kIntersect_Op:
@@ -1099,6 +1162,9 @@ bool SkRegion::Oper(const SkRegion& rgnaOrig, const SkRegion& rgnbOrig, Op op,
         if (b_rect && rgnb->fBounds.contains(rgna->fBounds)) {
             return setRegionCheck(result, *rgnb);
         }
+        if (a_rect && b_rect && rect_union_is_rect(rgna->fBounds, rgnb->fBounds, &bounds)) {
+            return setRectCheck(result, bounds);
+        }
         break;
 
     case kXOR_Op:
@@ -13,12 +13,17 @@
 #include <string>
 #include <tuple>
 
+#include "SkArenaAlloc.h"
+#include "SkData.h"
 #include "SkDevice.h"
 #include "SkDraw.h"
 #include "SkGlyphRun.h"
+#include "SkOpts.h"
+#include "SkPackBits.h"
 #include "SkRemoteGlyphCacheImpl.h"
 #include "SkStrike.h"
 #include "SkStrikeCache.h"
+#include "SkTHash.h"
 #include "SkTLazy.h"
 #include "SkTraceEvent.h"
 #include "SkTypeface_remote.h"
@@ -69,6 +74,15 @@ static const SkDescriptor* create_descriptor(
 
 size_t pad(size_t size, size_t alignment) { return (size + (alignment - 1)) & ~(alignment - 1); }
 
+// How each glyph image is sent. Images are deduplicated within each writeStrikeData call, so
+// kSameAs refers to the images in the same piece of strike data, counted in the order they were
+// sent.
+enum class ImageEncoding : uint8_t {
+    kRaw,     // The image, aligned for its mask format.
+    kPacked,  // A uint32_t size followed by that many bytes of SkPackBits data.
+    kSameAs,  // A uint32_t index of an identical image sent earlier.
+};
+
 class Serializer {
 public:
     Serializer(std::vector<uint8_t>* buffer) : fBuffer{buffer} { }
@@ -103,8 +117,40 @@ public:
         return &(*fBuffer)[aligned];
     }
 
+    void writeImage(const uint8_t* image, size_t size, size_t alignment) {
+        uint32_t hash = SkOpts::hash(image, size);
+        if (const int* index = fImageIndices.find(hash)) {
+            if (fImages[*index]->size() == size && !memcmp(fImages[*index]->data(), image, size)) {
+                write<ImageEncoding>(ImageEncoding::kSameAs);
+                write<uint32_t>(*index);
+                return;
+            }
+        } else {
+            fImageIndices.set(hash, fImages.count());
+        }
+        fImages.push_back(SkData::MakeWithCopy(image, size));
+
+        // Masks are mostly runs of empty or full coverage, which pack well.
+        fPacked.reset(SkPackBits::ComputeMaxSize8(size));
+        size_t packedSize = SkPackBits::Pack8(image, size, fPacked.get(),
+                                              SkPackBits::ComputeMaxSize8(size));
+        if (packedSize + sizeof(uint32_t) < size) {
+            write<ImageEncoding>(ImageEncoding::kPacked);
+            write<uint32_t>(SkToU32(packedSize));
+            memcpy(allocate(packedSize, 1), fPacked.get(), packedSize);
+        } else {
+            write<ImageEncoding>(ImageEncoding::kRaw);
+            memcpy(allocate(size, alignment), image, size);
+        }
+    }
+
 private:
     std::vector<uint8_t>* fBuffer;
+
+    // Every image sent so far, and where to find the first one with each hash.
+    SkTArray<sk_sp<SkData>> fImages;
+    SkTHashMap<uint32_t, int> fImageIndices;
+    SkAutoTMalloc<uint8_t> fPacked;
 };
 
 // -- Deserializer -------------------------------------------------------------------------------
@@ -139,6 +185,49 @@ public:
       return this->ensureAtLeast(size, alignment);
     }
 
+    // Reads an image written by Serializer::writeImage into memory owned by the Deserializer.
+    const void* readImage(size_t size, size_t alignment) {
+        ImageEncoding encoding;
+        if (!read<ImageEncoding>(&encoding)) return nullptr;
+
+        if (encoding == ImageEncoding::kSameAs) {
+            uint32_t index = 0u;
+            if (!read<uint32_t>(&index) || index >= fImages.size()) return nullptr;
+            if (fImageSizes[index] != size) return nullptr;
+            return fImages[index];
+        }
+
+        uint8_t* image = fImageAlloc.makeArrayDefault<uint8_t>(size);
+        if (encoding == ImageEncoding::kPacked) {
+            uint32_t packedSize = 0u;
+            if (!read<uint32_t>(&packedSize)) return nullptr;
+            auto* packed = this->ensureAtLeast(packedSize, 1);
+            if (!packed) return nullptr;
+            SkAutoTMalloc<uint8_t> packedCopy(packedSize);
+            memcpy(packedCopy.get(), const_cast<const char*>(packed), packedSize);
+            if (SkPackBits::Unpack8(packedCopy.get(), packedSize, image, size) != (int)size) {
+                return nullptr;
+            }
+        } else if (encoding == ImageEncoding::kRaw) {
+            auto* raw = this->ensureAtLeast(size, alignment);
+            if (!raw) return nullptr;
+            memcpy(image, const_cast<const char*>(raw), size);
+        } else {
+            return nullptr;
+        }
+        fImages.push_back(image);
+        fImageSizes.push_back(size);
+        return image;
+    }
+
+    // Images can only be shared within the strike data from a single writeStrikeData call.
+    void startStrikeData() {
+        fImages.clear();
+        fImageSizes.clear();
+    }
+
+    bool done() const { return fBytesRead == fMemorySize; }
+
 private:
     const volatile char* ensureAtLeast(size_t size, size_t alignment) {
         size_t padded = pad(fBytesRead, alignment);
@@ -155,6 +244,11 @@ private:
     const volatile char* fMemory;
     size_t fMemorySize;
     size_t fBytesRead = 0u;
+
+    // The images read so far, for ImageEncoding::kSameAs to refer to.
+    SkArenaAlloc fImageAlloc{4096};
+    std::vector<const uint8_t*> fImages;
+    std::vector<size_t> fImageSizes;
 };
 
 // Paths use a SkWriter32 which requires 4 byte alignment.
@@ -215,6 +309,7 @@ void SkTextBlobCacheDiffCanvas::TrackLayerDevice::drawGlyphRunList(
     GrTextContext::Options options;
     options.fMinDistanceFieldFontSize = fSettings.fMinDistanceFieldFontSize;
     options.fMaxDistanceFieldFontSize = fSettings.fMaxDistanceFieldFontSize;
+    options.fMultiChannelDistanceFieldText = fSettings.fMultiChannelDistanceFieldText;
     GrTextContext::SanitizeOptions(&options);
 
     fPainter.processGlyphRunList(glyphRunList,
@@ -486,10 +581,12 @@ void SkStrikeServer::SkGlyphCacheState::writePendingGlyphs(Serializer* serialize
         auto imageSize = glyph.computeImageSize();
         if (imageSize == 0u) continue;
 
-        glyph.fImage = serializer->allocate(imageSize, glyph.formatAlignment());
+        SkAutoTMalloc<uint8_t> image(imageSize);
+        glyph.fImage = image.get();
         fContext->getImage(glyph);
         // TODO: Generating the image can change the mask format, do we need to update it in the
         // serialized glyph?
+        serializer->writeImage(image.get(), imageSize, glyph.formatAlignment());
     }
     fPendingGlyphImages.clear();
 
@@ -682,106 +779,111 @@ bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySi
     SkASSERT(memorySize != 0u);
     Deserializer deserializer(static_cast<const volatile char*>(memory), memorySize);
 
-    uint64_t typefaceSize = 0u;
-    if (!deserializer.read<uint64_t>(&typefaceSize)) READ_FAILURE
+    // Each piece of strike data written by the server is read in turn.
+    do {
+        deserializer.startStrikeData();
 
-    for (size_t i = 0; i < typefaceSize; ++i) {
-        WireTypeface wire;
-        if (!deserializer.read<WireTypeface>(&wire)) READ_FAILURE
+        uint64_t typefaceSize = 0u;
+        if (!deserializer.read<uint64_t>(&typefaceSize)) READ_FAILURE
 
-        // TODO(khushalsagar): The typeface no longer needs a reference to the
-        // SkStrikeClient, since all needed glyphs must have been pushed before
-        // raster.
-        addTypeface(wire);
-    }
+        for (size_t i = 0; i < typefaceSize; ++i) {
+            WireTypeface wire;
+            if (!deserializer.read<WireTypeface>(&wire)) READ_FAILURE
 
-    uint64_t strikeCount = 0u;
-    if (!deserializer.read<uint64_t>(&strikeCount)) READ_FAILURE
-
-    for (size_t i = 0; i < strikeCount; ++i) {
-        bool has_glyphs = false;
-        if (!deserializer.read<bool>(&has_glyphs)) READ_FAILURE
-
-        if (!has_glyphs) continue;
-
-        StrikeSpec spec;
-        if (!deserializer.read<StrikeSpec>(&spec)) READ_FAILURE
-
-        SkAutoDescriptor sourceAd;
-        if (!deserializer.readDescriptor(&sourceAd)) READ_FAILURE
-
-        SkFontMetrics fontMetrics;
-        if (!deserializer.read<SkFontMetrics>(&fontMetrics)) READ_FAILURE
-
-        // Get the local typeface from remote fontID.
-        auto* tf = fRemoteFontIdToTypeface.find(spec.typefaceID)->get();
-        // Received strikes for a typeface which doesn't exist.
-        if (!tf) READ_FAILURE
-
-        // Replace the ContextRec in the desc from the server to create the client
-        // side descriptor.
-        // TODO: Can we do this in-place and re-compute checksum? Instead of a complete copy.
-        SkAutoDescriptor ad;
-        auto* client_desc = auto_descriptor_from_desc(sourceAd.getDesc(), tf->uniqueID(), &ad);
-
-        auto strike = fStrikeCache->findStrikeExclusive(*client_desc);
-        if (strike == nullptr) {
-            // Note that we don't need to deserialize the effects since we won't be generating any
-            // glyphs here anyway, and the desc is still correct since it includes the serialized
-            // effects.
-            SkScalerContextEffects effects;
-            auto scaler = SkStrikeCache::CreateScalerContext(*client_desc, effects, *tf);
-            strike = fStrikeCache->createStrikeExclusive(
-                    *client_desc, std::move(scaler), &fontMetrics,
-                    skstd::make_unique<DiscardableStrikePinner>(spec.discardableHandleId,
-                                                                fDiscardableHandleManager));
-            auto proxyContext = static_cast<SkScalerContextProxy*>(strike->getScalerContext());
-            proxyContext->initCache(strike.get(), fStrikeCache);
+            // TODO(khushalsagar): The typeface no longer needs a reference to the
+            // SkStrikeClient, since all needed glyphs must have been pushed before
+            // raster.
+            addTypeface(wire);
         }
 
-        uint64_t glyphImagesCount = 0u;
-        if (!deserializer.read<uint64_t>(&glyphImagesCount)) READ_FAILURE
-        for (size_t j = 0; j < glyphImagesCount; j++) {
-            SkTLazy<SkGlyph> glyph;
-            if (!readGlyph(glyph, &deserializer)) READ_FAILURE
-
-            SkGlyph* allocatedGlyph = strike->getRawGlyphByID(glyph->getPackedID());
-
-            // Update the glyph unless it's already got an image (from fallback),
-            // preserving any path that might be present.
-            if (allocatedGlyph->fImage == nullptr) {
-                auto* glyphPath = allocatedGlyph->fPathData;
-                *allocatedGlyph = *glyph;
-                allocatedGlyph->fPathData = glyphPath;
+        uint64_t strikeCount = 0u;
+        if (!deserializer.read<uint64_t>(&strikeCount)) READ_FAILURE
+
+        for (size_t i = 0; i < strikeCount; ++i) {
+            bool has_glyphs = false;
+            if (!deserializer.read<bool>(&has_glyphs)) READ_FAILURE
+
+            if (!has_glyphs) continue;
+
+            StrikeSpec spec;
+            if (!deserializer.read<StrikeSpec>(&spec)) READ_FAILURE
+
+            SkAutoDescriptor sourceAd;
+            if (!deserializer.readDescriptor(&sourceAd)) READ_FAILURE
+
+            SkFontMetrics fontMetrics;
+            if (!deserializer.read<SkFontMetrics>(&fontMetrics)) READ_FAILURE
+
+            // Get the local typeface from remote fontID.
+            auto* tf = fRemoteFontIdToTypeface.find(spec.typefaceID)->get();
+            // Received strikes for a typeface which doesn't exist.
+            if (!tf) READ_FAILURE
+
+            // Replace the ContextRec in the desc from the server to create the client
+            // side descriptor.
+            // TODO: Can we do this in-place and re-compute checksum? Instead of a complete copy.
+            SkAutoDescriptor ad;
+            auto* client_desc = auto_descriptor_from_desc(sourceAd.getDesc(), tf->uniqueID(), &ad);
+
+            auto strike = fStrikeCache->findStrikeExclusive(*client_desc);
+            if (strike == nullptr) {
+                // Note that we don't need to deserialize the effects since we won't be generating
+                // any glyphs here anyway, and the desc is still correct since it includes the
+                // serialized effects.
+                SkScalerContextEffects effects;
+                auto scaler = SkStrikeCache::CreateScalerContext(*client_desc, effects, *tf);
+                strike = fStrikeCache->createStrikeExclusive(
+                        *client_desc, std::move(scaler), &fontMetrics,
+                        skstd::make_unique<DiscardableStrikePinner>(spec.discardableHandleId,
+                                                                    fDiscardableHandleManager));
+                auto proxyContext = static_cast<SkScalerContextProxy*>(strike->getScalerContext());
+                proxyContext->initCache(strike.get(), fStrikeCache);
             }
 
-            auto imageSize = glyph->computeImageSize();
-            if (imageSize == 0u) continue;
+            uint64_t glyphImagesCount = 0u;
+            if (!deserializer.read<uint64_t>(&glyphImagesCount)) READ_FAILURE
+            for (size_t j = 0; j < glyphImagesCount; j++) {
+                SkTLazy<SkGlyph> glyph;
+                if (!readGlyph(glyph, &deserializer)) READ_FAILURE
 
-            auto* image = deserializer.read(imageSize, allocatedGlyph->formatAlignment());
-            if (!image) READ_FAILURE
-            strike->initializeImage(image, imageSize, allocatedGlyph);
-        }
+                SkGlyph* allocatedGlyph = strike->getRawGlyphByID(glyph->getPackedID());
 
-        uint64_t glyphPathsCount = 0u;
-        if (!deserializer.read<uint64_t>(&glyphPathsCount)) READ_FAILURE
-        for (size_t j = 0; j < glyphPathsCount; j++) {
-            SkTLazy<SkGlyph> glyph;
-            if (!readGlyph(glyph, &deserializer)) READ_FAILURE
+                // Update the glyph unless it's already got an image (from fallback),
+                // preserving any path that might be present.
+                if (allocatedGlyph->fImage == nullptr) {
+                    auto* glyphPath = allocatedGlyph->fPathData;
+                    *allocatedGlyph = *glyph;
+                    allocatedGlyph->fPathData = glyphPath;
+                }
 
-            SkGlyph* allocatedGlyph = strike->getRawGlyphByID(glyph->getPackedID());
+                auto imageSize = glyph->computeImageSize();
+                if (imageSize == 0u) continue;
 
-            // Update the glyph unless it's already got a path (from fallback),
-            // preserving any image that might be present.
-            if (allocatedGlyph->fPathData == nullptr) {
-                auto* glyphImage = allocatedGlyph->fImage;
-                *allocatedGlyph = *glyph;
-                allocatedGlyph->fImage = glyphImage;
+                auto* image = deserializer.readImage(imageSize, allocatedGlyph->formatAlignment());
+                if (!image) READ_FAILURE
+                strike->initializeImage(image, imageSize, allocatedGlyph);
             }
 
-            if (!read_path(&deserializer, allocatedGlyph, strike.get())) READ_FAILURE
+            uint64_t glyphPathsCount = 0u;
+            if (!deserializer.read<uint64_t>(&glyphPathsCount)) READ_FAILURE
+            for (size_t j = 0; j < glyphPathsCount; j++) {
+                SkTLazy<SkGlyph> glyph;
+                if (!readGlyph(glyph, &deserializer)) READ_FAILURE
+
+                SkGlyph* allocatedGlyph = strike->getRawGlyphByID(glyph->getPackedID());
+
+                // Update the glyph unless it's already got a path (from fallback),
+                // preserving any image that might be present.
+                if (allocatedGlyph->fPathData == nullptr) {
+                    auto* glyphImage = allocatedGlyph->fImage;
+                    *allocatedGlyph = *glyph;
+                    allocatedGlyph->fImage = glyphImage;
+                }
+
+                if (!read_path(&deserializer, allocatedGlyph, strike.get())) READ_FAILURE
+            }
         }
-    }
+    } while (!deserializer.done());
 
     return true;
 }
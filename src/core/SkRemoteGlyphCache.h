@@ -59,6 +59,7 @@ public:
         bool fContextSupportsDistanceFieldText = true;
         SkScalar fMinDistanceFieldFontSize = -1.f;
         SkScalar fMaxDistanceFieldFontSize = -1.f;
+        bool fMultiChannelDistanceFieldText = false;
         int fMaxTextureSize = 0;
         size_t fMaxTextureBytes = 0u;
     };
@@ -121,7 +122,9 @@ public:
 
     // Serializes the strike data captured using a SkTextBlobCacheDiffCanvas. Any
     // handles locked using the DiscardableHandleManager will be assumed to be
-    // unlocked after this call.
+    // unlocked after this call. The data is appended to memory, so the data for
+    // several frames can be batched into one buffer and read with a single
+    // SkStrikeClient::readStrikeData call.
     void writeStrikeData(std::vector<uint8_t>* memory);
 
     // Methods used internally in skia ------------------------------------------
@@ -206,7 +209,8 @@ public:
 
     // Deserializes the strike data from a SkStrikeServer. All messages generated
     // from a server when serializing the ops must be deserialized before the op
-    // is rasterized.
+    // is rasterized. The memory may hold the data from several writeStrikeData
+    // calls, one after another.
     // Returns false if the data is invalid.
     bool readStrikeData(const volatile void* memory, size_t memorySize);
 
@@ -47,6 +47,9 @@ public:
 
     bool decideCouldDrawFromPath(const SkGlyph& glyph) override;
 
+    // Images are only generated on the client, in its own strikes.
+    const void* findImage(const SkGlyph&) override { return nullptr; }
+
     void onAboutToExitScope() override {}
 
 private:
@@ -60,7 +60,7 @@ void SkResourceCache::Key::init(void* nameSpace, uint64_t sharedID, size_t dataS
                          (fCount32 - kUnhashedLocal32s) << 2);
 }
 
-#include "SkTHash.h"
+#include "SkTFlatHashTable.h"
 
 namespace {
     struct HashTraits {
@@ -72,7 +72,7 @@ namespace {
 }
 
 class SkResourceCache::Hash :
-    public SkTHashTable<SkResourceCache::Rec*, SkResourceCache::Key, HashTraits> {};
+    public SkTFlatHashTable<SkResourceCache::Rec*, SkResourceCache::Key, HashTraits> {};
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -83,6 +83,8 @@ void SkResourceCache::init() {
     fHash = new Hash;
     fTotalBytesUsed = 0;
     fCount = 0;
+    fHitCount = 0;
+    fMissCount = 0;
     fSingleAllocationByteLimit = 0;
 
     // One of these should be explicit set by the caller after we return.
@@ -119,12 +121,15 @@ bool SkResourceCache::find(const Key& key, FindVisitor visitor, void* context) {
         Rec* rec = *found;
         if (visitor(*rec, context)) {
             this->moveToHead(rec);  // for our LRU
+            fHitCount++;
             return true;
         } else {
             this->remove(rec);  // stale
+            fMissCount++;
             return false;
         }
     }
+    fMissCount++;
     return false;
 }
 
@@ -449,86 +454,149 @@ void SkResourceCache::checkMessages() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-SK_DECLARE_STATIC_MUTEX(gMutex);
-static SkResourceCache* gResourceCache = nullptr;
+// The global cache can be split into shards, each with its own lock, LRU, and an equal share of
+// the budget.  Recs are assigned to shards by Key::hash(), so threads working on unrelated keys
+// rarely contend.  Each shard applies the discardable count limit on its own.
+#ifndef SK_RESOURCE_CACHE_SHARD_COUNT
+    #define SK_RESOURCE_CACHE_SHARD_COUNT 1
+#endif
+
+static const int kShardCount = SK_RESOURCE_CACHE_SHARD_COUNT;
+static_assert(kShardCount > 0, "need at least one resource cache shard");
+
+static SkBaseMutex      gMutex[kShardCount];
+static SkResourceCache* gResourceCache[kShardCount];
+
+static int shard_of(const SkResourceCache::Key& key) {
+    return key.hash() % kShardCount;
+}
+
+// Shard 0 picks up any remainder, so the shard limits always sum to the total.
+static size_t shard_byte_limit(int shard, size_t totalLimit) {
+    return totalLimit / kShardCount + (shard == 0 ? totalLimit % kShardCount : 0);
+}
 
-/** Must hold gMutex when calling. */
-static SkResourceCache* get_cache() {
-    // gMutex is always held when this is called, so we don't need to be fancy in here.
-    gMutex.assertHeld();
-    if (nullptr == gResourceCache) {
+/** Must hold gMutex[shard] when calling. */
+static SkResourceCache* get_cache(int shard = 0) {
+    // gMutex[shard] is always held when this is called, so we don't need to be fancy in here.
+    gMutex[shard].assertHeld();
+    if (nullptr == gResourceCache[shard]) {
 #ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
-        gResourceCache = new SkResourceCache(SkDiscardableMemory::Create);
+        gResourceCache[shard] = new SkResourceCache(SkDiscardableMemory::Create);
 #else
-        gResourceCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
+        gResourceCache[shard] =
+                new SkResourceCache(shard_byte_limit(shard, SK_DEFAULT_IMAGE_CACHE_LIMIT));
 #endif
     }
-    return gResourceCache;
+    return gResourceCache[shard];
 }
 
 size_t SkResourceCache::GetTotalBytesUsed() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getTotalBytesUsed();
+    size_t used = 0;
+    for (int i = 0; i < kShardCount; i++) {
+        SkAutoMutexAcquire am(gMutex[i]);
+        used += get_cache(i)->getTotalBytesUsed();
+    }
+    return used;
+}
+
+int64_t SkResourceCache::GetHitCount() {
+    int64_t count = 0;
+    for (int i = 0; i < kShardCount; i++) {
+        SkAutoMutexAcquire am(gMutex[i]);
+        count += get_cache(i)->getHitCount();
+    }
+    return count;
+}
+
+int64_t SkResourceCache::GetMissCount() {
+    int64_t count = 0;
+    for (int i = 0; i < kShardCount; i++) {
+        SkAutoMutexAcquire am(gMutex[i]);
+        count += get_cache(i)->getMissCount();
+    }
+    return count;
 }
 
 size_t SkResourceCache::GetTotalByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getTotalByteLimit();
+    size_t limit = 0;
+    for (int i = 0; i < kShardCount; i++) {
+        SkAutoMutexAcquire am(gMutex[i]);
+        limit += get_cache(i)->getTotalByteLimit();
+    }
+    return limit;
 }
 
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->setTotalByteLimit(newLimit);
+    size_t prevLimit = 0;
+    for (int i = 0; i < kShardCount; i++) {
+        SkAutoMutexAcquire am(gMutex[i]);
+        prevLimit += get_cache(i)->setTotalByteLimit(shard_byte_limit(i, newLimit));
+    }
+    return prevLimit;
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-    SkAutoMutexAcquire am(gMutex);
+    SkAutoMutexAcquire am(gMutex[0]);
     return get_cache()->discardableFactory();
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-    SkAutoMutexAcquire am(gMutex);
+    SkAutoMutexAcquire am(gMutex[0]);
     return get_cache()->newCachedData(bytes);
 }
 
 void SkResourceCache::Dump() {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->dump();
+    for (int i = 0; i < kShardCount; i++) {
+        SkAutoMutexAcquire am(gMutex[i]);
+        get_cache(i)->dump();
+    }
 }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->setSingleAllocationByteLimit(size);
+    size_t prevLimit = 0;
+    for (int i = 0; i < kShardCount; i++) {
+        SkAutoMutexAcquire am(gMutex[i]);
+        prevLimit = get_cache(i)->setSingleAllocationByteLimit(size);
+    }
+    return prevLimit;
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
+    SkAutoMutexAcquire am(gMutex[0]);
     return get_cache()->getSingleAllocationByteLimit();
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getEffectiveSingleAllocationByteLimit();
+    // A single allocation has to fit in the smallest shard's budget, the last one's.
+    SkAutoMutexAcquire am(gMutex[kShardCount - 1]);
+    return get_cache(kShardCount - 1)->getEffectiveSingleAllocationByteLimit();
 }
 
 void SkResourceCache::PurgeAll() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->purgeAll();
+    for (int i = 0; i < kShardCount; i++) {
+        SkAutoMutexAcquire am(gMutex[i]);
+        get_cache(i)->purgeAll();
+    }
 }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->find(key, visitor, context);
+    int shard = shard_of(key);
+    SkAutoMutexAcquire am(gMutex[shard]);
+    return get_cache(shard)->find(key, visitor, context);
 }
 
 void SkResourceCache::Add(Rec* rec, void* payload) {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->add(rec, payload);
+    int shard = shard_of(rec->getKey());
+    SkAutoMutexAcquire am(gMutex[shard]);
+    get_cache(shard)->add(rec, payload);
 }
 
 void SkResourceCache::VisitAll(Visitor visitor, void* context) {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->visitAll(visitor, context);
+    for (int i = 0; i < kShardCount; i++) {
+        SkAutoMutexAcquire am(gMutex[i]);
+        get_cache(i)->visitAll(visitor, context);
+    }
 }
 
 void SkResourceCache::PostPurgeSharedID(uint64_t sharedID) {
@@ -546,6 +614,14 @@ size_t SkGraphics::GetResourceCacheTotalBytesUsed() {
     return SkResourceCache::GetTotalBytesUsed();
 }
 
+int64_t SkGraphics::GetResourceCacheHitCount() {
+    return SkResourceCache::GetHitCount();
+}
+
+int64_t SkGraphics::GetResourceCacheMissCount() {
+    return SkResourceCache::GetMissCount();
+}
+
 size_t SkGraphics::GetResourceCacheTotalByteLimit() {
     return SkResourceCache::GetTotalByteLimit();
 }
@@ -137,7 +137,9 @@ public:
 
     /*
      *  The following static methods are thread-safe wrappers around a global
-     *  instance of this cache.
+     *  instance of this cache.  If SK_RESOURCE_CACHE_SHARD_COUNT is defined, that
+     *  instance is split by Key::hash() into that many independently locked shards,
+     *  and the byte totals and limits below are summed over all of them.
      */
 
     /**
@@ -158,6 +160,8 @@ public:
 
     static size_t GetTotalBytesUsed();
     static size_t GetTotalByteLimit();
+    static int64_t GetHitCount();
+    static int64_t GetMissCount();
     static size_t SetTotalByteLimit(size_t newLimit);
 
     static size_t SetSingleAllocationByteLimit(size_t);
@@ -222,6 +226,8 @@ public:
 
     size_t getTotalBytesUsed() const { return fTotalBytesUsed; }
     size_t getTotalByteLimit() const { return fTotalByteLimit; }
+    int64_t getHitCount() const { return fHitCount; }
+    int64_t getMissCount() const { return fMissCount; }
 
     /**
      *  This is respected by SkBitmapProcState::possiblyScaleImage.
@@ -269,6 +275,8 @@ private:
     size_t  fTotalByteLimit;
     size_t  fSingleAllocationByteLimit;
     int     fCount;
+    int64_t fHitCount;
+    int64_t fMissCount;
 
     SkMessageBus<PurgeSharedIDMessage>::Inbox fPurgeSharedIDInbox;
 
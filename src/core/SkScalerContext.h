@@ -282,6 +282,21 @@ public:
     bool SK_WARN_UNUSED_RESULT getPath(SkPackedGlyphID, SkPath*);
     void        getFontMetrics(SkFontMetrics*);
 
+    /** Brackets a run of getMetrics(), getImage() and getPath() calls for many glyphs, so that a
+     *  port can do its per-glyph setup (locking, setting up the font's size and transform) once
+     *  for the whole run. Nothing but glyph calls on this context may happen during the batch.
+     */
+    class AutoGlyphBatch : SkNoncopyable {
+    public:
+        explicit AutoGlyphBatch(SkScalerContext* context) : fContext(context) {
+            fContext->beginGlyphBatch();
+        }
+        ~AutoGlyphBatch() { fContext->endGlyphBatch(); }
+
+    private:
+        SkScalerContext* fContext;
+    };
+
     /** Return the size in bytes of the associated gamma lookup table
      */
     static size_t GetGammaLUTSize(SkScalar contrast, SkScalar paintGamma, SkScalar deviceGamma,
@@ -392,6 +407,10 @@ protected:
      */
     virtual uint16_t generateCharToGlyph(SkUnichar unichar) = 0;
 
+    /** Called at the start and end of an AutoGlyphBatch. */
+    virtual void beginGlyphBatch() {}
+    virtual void endGlyphBatch() {}
+
     void forceGenerateImageFromPath() { fGenerateImageFromPath = true; }
     void forceOffGenerateImageFromPath() { fGenerateImageFromPath = false; }
 
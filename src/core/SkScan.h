@@ -14,6 +14,7 @@
 #include "SkRect.h"
 #include <atomic>
 
+class SkExecutor;
 class SkRasterClip;
 class SkRegion;
 class SkBlitter;
@@ -44,6 +45,11 @@ public:
 
     static void FillPath(const SkPath&, const SkIRect&, SkBlitter*);
 
+    // When set, DAA splits very large paths into horizontal bands and generates each band's
+    // coverage deltas on this executor.  Blitting still happens in order on the calling thread.
+    // Does not take ownership.  Not thread safe; pass nullptr to go back to single-threaded DAA.
+    static void SetDAAExecutor(SkExecutor*);
+
     ///////////////////////////////////////////////////////////////////////////
     // rasterclip
 
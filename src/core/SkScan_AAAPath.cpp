@@ -12,6 +12,7 @@
 #include "SkEdge.h"
 #include "SkEdgeBuilder.h"
 #include "SkGeometry.h"
+#include "SkNx.h"
 #include "SkPath.h"
 #include "SkQuadClipper.h"
 #include "SkRasterClip.h"
@@ -896,6 +897,55 @@ static SK_ALWAYS_INLINE void blit_trapezoid_row(AdditiveBlitter* blitter, int y,
     }
 }
 
+// In the full rows of a convex path, each edge usually crosses a single column of pixels, with
+// full coverage in between. edges holds the row's snapped {ul, ll, ur, lr}; if the row is that
+// simple, we compute both edges' alphas at once and blit the whole row with one blitAntiH() of
+// up to three runs, rather than with a blitter call for each edge and one for the middle.
+// alphas and runs must have room for the row's width plus one. Returns false, having blit
+// nothing, if the row isn't that simple.
+static SK_ALWAYS_INLINE bool blit_convex_full_row(SkBlitter* blitter, int y, const Sk4i& edges,
+                                                  SkAlpha* alphas, int16_t* runs) {
+    // Order the two ends of each edge: lo = {min(ul, ll), _, min(ur, lr), _}, and hi likewise.
+    Sk4i swapped = SkNx_shuffle<1,0,3,2>(edges),
+         lo      = Sk4i::Min(edges, swapped),
+         hi      = Sk4i::Max(edges, swapped);
+
+    SkFixed joinLeft = SkFixedCeilToFixed(hi[0]);
+    SkFixed joinRite = SkFixedFloorToFixed(lo[2]);
+    if (joinLeft > joinRite || joinLeft - lo[0] > SK_Fixed1 || hi[2] - joinRite > SK_Fixed1) {
+        return false;
+    }
+
+    // Each edge's alpha is trapezoidToAlpha() of its ends' distances from the full pixels.
+    Sk4i dist = (Sk4i(joinLeft, joinLeft, joinRite, joinRite) - edges).abs();
+    SkAlpha leftAlpha = (dist[0] + dist[1]) >> 9;
+    SkAlpha riteAlpha = (dist[2] + dist[3]) >> 9;
+
+    int x = SkFixedFloorToInt(joinLeft),
+        n = 0;
+    if (lo[0] < joinLeft) {
+        x--;
+        alphas[0] = leftAlpha;
+        runs  [0] = 1;
+        n = 1;
+    }
+    if (int fullLen = SkFixedFloorToInt(joinRite - joinLeft)) {
+        alphas[n] = 0xFF;
+        runs  [n] = fullLen;
+        n += fullLen;
+    }
+    if (hi[2] > joinRite) {
+        alphas[n] = riteAlpha;
+        runs  [n] = 1;
+        n++;
+    }
+    if (n > 0) {
+        runs[n] = 0;
+        blitter->blitAntiH(x, y, alphas, runs);
+    }
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 static bool operator<(const SkAnalyticEdge& a, const SkAnalyticEdge& b) {
@@ -1004,6 +1054,11 @@ static inline void aaa_walk_convex_edges(SkAnalyticEdge* prevHead,
 
     SkFixed y = SkTMax(leftE->fUpperY, riteE->fUpperY);
 
+    // Row buffers for blit_convex_full_row(), allocated when first needed.
+    SkAutoSTMalloc<256, SkAlpha> fullRowAlphas;
+    SkAutoSTMalloc<256, int16_t> fullRowRuns;
+    bool fullRowBuffersReady = false;
+
     #ifdef SK_DEBUG
     int frac_y_cnt = 0;
     int total_y_cnt = 0;
@@ -1175,21 +1230,37 @@ static inline void aaa_walk_convex_edges(SkAnalyticEdge* prevHead,
                     left = nextLeft; rite = nextRite; y = nextY;
                 }
 
-                while (count > 1) { // Full rows in the middle
+                if (count > 1 && !isUsingMask && !fullRowBuffersReady) {
+                    int width = SkFixedCeilToInt(riteBound) - SkFixedFloorToInt(leftBound) + 2;
+                    fullRowAlphas.reset(width);
+                    fullRowRuns.reset(width);
+                    fullRowBuffersReady = true;
+                }
+
+                // Full rows in the middle. We step both edges together, each edge's upper and
+                // lower x in one vector: {left, nextLeft, rite, nextRite}.
+                Sk4i edges(left, left + dLeft, rite, rite + dRite),
+                     step(dLeft, dLeft, dRite, dRite);
+                while (count > 1) {
                     count--;
                     if (isUsingMask) {
                         maskRow = static_cast<MaskAdditiveBlitter*>(blitter)->getRow(y >> 16);
                     }
-                    SkFixed nextY = y + SK_Fixed1, nextLeft = left + dLeft, nextRite = rite + dRite;
-                    SkASSERT((left & kSnapMask) >= leftBound && (rite & kSnapMask) <= riteBound &&
-                            (nextLeft & kSnapMask) >= leftBound &&
-                            (nextRite & kSnapMask) <= riteBound);
-                    blit_trapezoid_row(blitter, y >> 16, left & kSnapMask, rite & kSnapMask,
-                            nextLeft & kSnapMask, nextRite & kSnapMask,
-                            leftE->fDY, riteE->fDY, 0xFF, maskRow, isUsingMask);
+                    SkFixed nextY = y + SK_Fixed1;
+                    Sk4i snapped = edges & kSnapMask;
+                    SkASSERT(snapped[0] >= leftBound && snapped[2] <= riteBound &&
+                             snapped[1] >= leftBound && snapped[3] <= riteBound);
+                    if (isUsingMask ||
+                            !blit_convex_full_row(blitter->getRealBlitter(), y >> 16, snapped,
+                                                  fullRowAlphas.get(), fullRowRuns.get())) {
+                        blit_trapezoid_row(blitter, y >> 16, snapped[0], snapped[2],
+                                snapped[1], snapped[3], leftE->fDY, riteE->fDY, 0xFF,
+                                maskRow, isUsingMask);
+                    }
                     blitter->flush_if_y_changed(y, nextY);
-                    left = nextLeft; rite = nextRite; y = nextY;
+                    edges = edges + step; y = nextY;
                 }
+                left = edges[0]; rite = edges[2];
             }
 
             if (isUsingMask) {
@@ -12,6 +12,7 @@
 #include "SkCoverageDelta.h"
 #include "SkEdge.h"
 #include "SkEdgeBuilder.h"
+#include "SkExecutor.h"
 #include "SkGeometry.h"
 #include "SkMask.h"
 #include "SkPath.h"
@@ -21,9 +22,16 @@
 #include "SkScan.h"
 #include "SkScanPriv.h"
 #include "SkTSort.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkUTF.h"
 
+static SkExecutor* gDAAExecutor = nullptr;
+
+void SkScan::SetDAAExecutor(SkExecutor* executor) {
+    gDAAExecutor = executor;
+}
+
 #if defined(SK_DISABLE_DAA)
 void SkScan::DAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& ir,
                          const SkIRect& clipBounds, bool forceRLE, SkDAARecord* record) {
@@ -324,6 +332,54 @@ void gen_alpha_deltas(const SkPath& path, const SkIRect& clippedIR, const SkIRec
     }
 }
 
+// Paths with fewer points than this aren't worth splitting across threads.
+static constexpr int kMinPointsForBands = 4096;
+// Each band is at least this tall, so edge building per band doesn't dominate.
+static constexpr int kMinBandHeight     = 64;
+static constexpr int kMaxBands          = 32;
+
+// Deltas are generated independently per band: each band rebuilds the edges it needs, clipped to
+// its own rows, into its own SkCoverageDeltaList.  The bands are then blitted top to bottom.
+static void banded_daa_fill_path(SkExecutor* executor, const SkPath& path, SkBlitter* blitter,
+                                 const SkIRect& clippedIR, const SkIRect& clipBounds,
+                                 bool forceRLE, bool skipRect, bool isEvenOdd, bool isConvex) {
+    const int bandCount  = SkTMin(clippedIR.height() / kMinBandHeight, kMaxBands);
+    const int bandHeight = (clippedIR.height() + bandCount - 1) / bandCount;
+
+    struct Band {
+        Band() : fAlloc(16 << 10) {}
+
+        SkArenaAlloc         fAlloc;
+        SkCoverageDeltaList* fList = nullptr;
+        SkIRect              fClip;
+    };
+    std::unique_ptr<Band[]> bands(new Band[bandCount]);
+
+    SkTaskGroup(*executor).batch(bandCount, [&](int i) {
+        Band& band = bands[i];
+
+        // Keep the full clip width so edges to the right of the path still cull the same way.
+        band.fClip = SkIRect::MakeLTRB(clipBounds.fLeft,
+                                       clippedIR.fTop + i * bandHeight,
+                                       clipBounds.fRight,
+                                       SkTMin(clippedIR.fTop + (i + 1) * bandHeight,
+                                              clippedIR.fBottom));
+        SkIRect bandIR = clippedIR;
+        if (band.fClip.isEmpty() || !bandIR.intersect(band.fClip)) {
+            return;
+        }
+
+        band.fList = band.fAlloc.make<SkCoverageDeltaList>(&band.fAlloc, bandIR, forceRLE);
+        gen_alpha_deltas(path, bandIR, band.fClip, *band.fList, nullptr, skipRect, false);
+    });
+
+    for (int i = 0; i < bandCount; i++) {
+        if (bands[i].fList) {
+            blitter->blitCoverageDeltas(bands[i].fList, bands[i].fClip, isEvenOdd, false, isConvex);
+        }
+    }
+}
+
 void SkScan::DAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& ir,
                          const SkIRect& clipBounds, bool forceRLE, SkDAARecord* record) {
     bool containedInClip = clipBounds.contains(ir);
@@ -343,6 +399,16 @@ void SkScan::DAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect&
         return;
     }
 
+    // The threaded backend already splits work its own way, so only band when there's no record.
+    // Inverse fills need to cover rows with no deltas at all, so we leave those alone too.
+    if (gDAAExecutor && !record && !isInverse &&
+            path.countPoints() >= kMinPointsForBands &&
+            clippedIR.height() >= 2 * kMinBandHeight) {
+        banded_daa_fill_path(gDAAExecutor, path, blitter, clippedIR, clipBounds,
+                             forceRLE, skipRect, isEvenOdd, isConvex);
+        return;
+    }
+
 #ifdef SK_BUILD_FOR_GOOGLE3
     constexpr int STACK_SIZE = 12 << 10; // 12K stack size alloc; Google3 has 16K limit.
 #else
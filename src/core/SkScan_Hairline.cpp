@@ -203,6 +203,7 @@ void SkScan::HairRect(const SkRect& rect, const SkRasterClip& clip, SkBlitter* b
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "SkPath.h"
+#include "SkPathPriv.h"
 #include "SkGeometry.h"
 #include "SkNx.h"
 
@@ -562,6 +563,9 @@ void hair_path(const SkPath& path, const SkRasterClip& rclip, SkBlitter* blitter
     SkPoint             pts[4], firstPt, lastPt;
     SkPath::Verb        verb, prevVerb;
     SkAutoConicToQuads  converter;
+    // Index of the next point of the path that iter will return.
+    const SkPoint*      pathPts = SkPathPriv::PointData(path);
+    int                 ptIndex = 0;
 
     if (SkPaint::kButt_Cap != capStyle) {
         prevVerb = SkPath::kDone_Verb;
@@ -570,12 +574,25 @@ void hair_path(const SkPath& path, const SkRasterClip& rclip, SkBlitter* blitter
         switch (verb) {
             case SkPath::kMove_Verb:
                 firstPt = lastPt = pts[0];
+                ptIndex += 1;
                 break;
             case SkPath::kLine_Verb:
-                if (SkPaint::kButt_Cap != capStyle) {
+                if (SkPaint::kButt_Cap == capStyle) {
+                    // Without caps each line is drawn as is, so a run of lines is one polyline
+                    // that lineproc can take straight from the path's points.
+                    int lineCount = 1;
+                    while (iter.peek() == SkPath::kLine_Verb) {
+                        iter.next(pts);
+                        lineCount += 1;
+                    }
+                    SkASSERT(!memcmp(&pathPts[ptIndex + lineCount - 1], &pts[1], sizeof(SkPoint)));
+                    lineproc(&pathPts[ptIndex - 1], lineCount + 1, clip, blitter);
+                    ptIndex += lineCount;
+                } else {
                     extend_pts<capStyle>(prevVerb, iter.peek(), pts, 2);
+                    lineproc(pts, 2, clip, blitter);
+                    ptIndex += 1;
                 }
-                lineproc(pts, 2, clip, blitter);
                 lastPt = pts[1];
                 break;
             case SkPath::kQuad_Verb:
@@ -584,6 +601,7 @@ void hair_path(const SkPath& path, const SkRasterClip& rclip, SkBlitter* blitter
                 }
                 hairquad(pts, clip, insetClip, outsetClip, blitter, compute_quad_level(pts), lineproc);
                 lastPt = pts[2];
+                ptIndex += 2;
                 break;
             case SkPath::kConic_Verb: {
                 if (SkPaint::kButt_Cap != capStyle) {
@@ -599,6 +617,7 @@ void hair_path(const SkPath& path, const SkRasterClip& rclip, SkBlitter* blitter
                     quadPts += 2;
                 }
                 lastPt = pts[2];
+                ptIndex += 2;
                 break;
             }
             case SkPath::kCubic_Verb: {
@@ -607,6 +626,7 @@ void hair_path(const SkPath& path, const SkRasterClip& rclip, SkBlitter* blitter
                 }
                 haircubic(pts, clip, insetClip, outsetClip, blitter, kMaxCubicSubdivideLevel, lineproc);
                 lastPt = pts[3];
+                ptIndex += 3;
             } break;
             case SkPath::kClose_Verb:
                 pts[0] = lastPt;
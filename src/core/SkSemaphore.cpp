@@ -40,6 +40,97 @@
             AnnotateHappensAfter(__FILE__, __LINE__, &fSemaphore);
         }
     };
+#elif defined(__linux__) || (defined(SK_BUILD_FOR_WIN) && _WIN32_WINNT >= 0x0602/*Windows 8*/)
+    #if defined(__linux__)
+        #include <linux/futex.h>
+        #include <sys/syscall.h>
+        #include <unistd.h>
+
+        // Sleeps only if *addr still holds expected.  Interrupts and spurious wake-ups return
+        // early, which is fine, as callers check again and loop.
+        static void wait_on_address(std::atomic<int>* addr, int expected) {
+            syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+        }
+        static void wake_by_address(std::atomic<int>* addr, int n) {
+            syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, n, nullptr, nullptr, 0);
+        }
+    #else
+        static void wait_on_address(std::atomic<int>* addr, int expected) {
+            WaitOnAddress(addr, &expected, sizeof(int), INFINITE/*timeout in ms*/);
+        }
+        static void wake_by_address(std::atomic<int>* addr, int n) {
+            while (n --> 0) { WakeByAddressSingle(addr); }
+        }
+    #endif
+
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+        #include <emmintrin.h>
+        static void cpu_relax() { _mm_pause(); }
+    #else
+        static void cpu_relax() { /*spin*/ }
+    #endif
+
+    // Waits spin for at most this many pauses before sleeping.
+    static const int kMaxSpins = 100;
+
+    // Rather than a kernel semaphore, we count wake-ups in fTokens ourselves and sleep on its
+    // address with a futex (or WaitOnAddress on Windows).  Neither side enters the kernel unless
+    // it must: a waiter only when no token has arrived after spinning a while, and a signal only
+    // when some waiter is actually asleep.
+    struct SkBaseSemaphore::OSSemaphore {
+        std::atomic<int> fTokens{0};
+        std::atomic<int> fSleepers{0};
+        // A running average of how many spins recent waits took to find a token.
+        std::atomic<int> fAverageSpins{0};
+
+        void signal(int n) {
+            // Both this and sleep() use sequentially consistent operations, so either we see the
+            // sleeper here, or it sees our tokens before going to sleep.
+            fTokens.fetch_add(n, std::memory_order_seq_cst);
+            if (fSleepers.load(std::memory_order_seq_cst) > 0) {
+                wake_by_address(&fTokens, n);
+            }
+        }
+
+        void wait() {
+            // The thread that will signal us is often running on another core and about to do
+            // so; a short spin catches that far sooner than a trip through the kernel to sleep
+            // and back.  Like glibc's adaptive mutexes, we spin up to twice as long as recent
+            // waits needed, so waits that usually end up asleep soon stop spinning much at all.
+            int average = fAverageSpins.load(std::memory_order_relaxed),
+                limit   = SkTMin(kMaxSpins, 2 * average + 10),
+                spins   = 0;
+            while (!this->tryTake()) {
+                if (++spins > limit) {
+                    this->sleep();
+                    spins = 0;
+                    break;
+                }
+                cpu_relax();
+            }
+            fAverageSpins.store(average + (spins - average) / 8, std::memory_order_relaxed);
+        }
+
+        bool tryTake() {
+            int tokens = fTokens.load(std::memory_order_seq_cst);
+            while (tokens > 0) {
+                if (fTokens.compare_exchange_weak(tokens, tokens - 1,
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void sleep() {
+            fSleepers.fetch_add(1, std::memory_order_seq_cst);
+            while (!this->tryTake()) {
+                wait_on_address(&fTokens, 0);
+            }
+            fSleepers.fetch_sub(1, std::memory_order_relaxed);
+        }
+    };
 #elif defined(SK_BUILD_FOR_WIN)
     struct SkBaseSemaphore::OSSemaphore {
         HANDLE fSemaphore;
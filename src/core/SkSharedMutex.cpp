@@ -115,8 +115,9 @@
         SkTDArray<SkThreadID> fThreadIDs;
     };
 
-    SkSharedMutex::SkSharedMutex()
-        : fCurrentShared(new ThreadIDSet)
+    SkSharedMutex::SkSharedMutex(Bias bias)
+        : fReaderBiased(Bias::kReaders == bias)
+        , fCurrentShared(new ThreadIDSet)
         , fWaitingExclusive(new ThreadIDSet)
         , fWaitingShared(new ThreadIDSet){
         ANNOTATE_RWLOCK_CREATE(this);
@@ -189,12 +190,14 @@
 
     void SkSharedMutex::acquireShared() {
         SkThreadID threadID(SkGetThreadID());
-        int exclusiveWaitingCount;
+        bool mustWait;
         int sharedQueueSelect;
         {
             SkAutoMutexAcquire l(&fMu);
-            exclusiveWaitingCount = fWaitingExclusive->count();
-            if (exclusiveWaitingCount > 0) {
+            // Reader biased locks let new readers join running ones, ahead of waiting writers.
+            mustWait = fWaitingExclusive->count() > 0
+                       && !(fReaderBiased && fCurrentShared->count() > 0);
+            if (mustWait) {
                 if (!fWaitingShared->tryAdd(threadID)) {
                     SkDEBUGFAILF("Thread %lx was already waiting!\n", threadID);
                 }
@@ -206,7 +209,7 @@
             sharedQueueSelect = fSharedQueueSelect;
         }
 
-        if (exclusiveWaitingCount > 0) {
+        if (mustWait) {
             fSharedQueue[sharedQueueSelect].wait();
         }
 
@@ -261,7 +264,11 @@
         kWaitingSharedMask     = ((1 << kLogThreadCount) - 1) << kWaitingSharedOffset,
     };
 
-    SkSharedMutex::SkSharedMutex() : fQueueCounts(0) { ANNOTATE_RWLOCK_CREATE(this); }
+    SkSharedMutex::SkSharedMutex(Bias bias)
+        : fReaderBiased(Bias::kReaders == bias)
+        , fQueueCounts(0) {
+        ANNOTATE_RWLOCK_CREATE(this);
+    }
     SkSharedMutex::~SkSharedMutex() {  ANNOTATE_RWLOCK_DESTROY(this); }
     void SkSharedMutex::acquire() {
         // Increment the count of exclusive queue waiters.
@@ -320,10 +327,15 @@
     void SkSharedMutex::acquireShared() {
         int32_t oldQueueCounts = fQueueCounts.load(std::memory_order_relaxed);
         int32_t newQueueCounts;
+        bool mustWait;
         do {
             newQueueCounts = oldQueueCounts;
-            // If there are waiting exclusives then this shared lock waits else it runs.
-            if ((newQueueCounts & kWaitingExclusiveMask) > 0) {
+            // If there are waiting exclusives then this shared lock waits else it runs. A reader
+            // biased lock also runs if other shared locks are running, since no exclusive can
+            // run until they are all done anyway.
+            mustWait = (newQueueCounts & kWaitingExclusiveMask) > 0
+                       && !(fReaderBiased && (newQueueCounts & kSharedMask) > 0);
+            if (mustWait) {
                 newQueueCounts += 1 << kWaitingSharedOffset;
             } else {
                 newQueueCounts += 1 << kSharedOffset;
@@ -332,8 +344,8 @@
                                                        std::memory_order_acquire,
                                                        std::memory_order_relaxed));
 
-        // If there are waiting exclusives, then this shared waits until after it runs.
-        if ((newQueueCounts & kWaitingExclusiveMask) > 0) {
+        // If this shared lock must wait, it runs after the next exclusive.
+        if (mustWait) {
             fSharedQueue.wait();
         }
         ANNOTATE_RWLOCK_ACQUIRED(this, 0);
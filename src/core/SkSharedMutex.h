@@ -24,11 +24,21 @@
 // implementation is cribbed from Preshing's article:
 // http://preshing.com/20150316/semaphores-are-surprisingly-versatile/
 //
-// This lock does not obey strict queue ordering. It will always alternate between readers and
-// a single writer.
+// This lock does not obey strict queue ordering. By default it will always alternate between
+// readers and a single writer.
 class SkSharedMutex {
 public:
-    SkSharedMutex();
+    // With kFair, once a writer is waiting new readers wait behind it, even while other readers
+    // still hold the lock. With kReaders, new readers join readers that already hold the lock, and
+    // only wait when a writer holds it or is next with no readers running. That suits locks read
+    // far more often than they are written, like caches, but writers can starve while reads keep
+    // overlapping.
+    enum class Bias {
+        kFair,
+        kReaders,
+    };
+
+    SkSharedMutex(Bias bias = Bias::kFair);
     ~SkSharedMutex();
     // Acquire lock for exclusive use.
     void acquire();
@@ -49,6 +59,7 @@ public:
     void assertHeldShared() const;
 
 private:
+    const bool fReaderBiased;
 #ifdef SK_DEBUG
     class ThreadIDSet;
     std::unique_ptr<ThreadIDSet> fCurrentShared;
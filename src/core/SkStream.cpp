@@ -152,12 +152,17 @@ bool SkWStream::writeStream(SkStream* stream, size_t length) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// SkFILEStream reads at least this much at a time.
+static constexpr size_t kFILEStreamBufferSize = 32 * 1024;
+
 SkFILEStream::SkFILEStream(std::shared_ptr<FILE> file, size_t size,
                            size_t offset, size_t originalOffset)
     : fFILE(std::move(file))
     , fSize(size)
     , fOffset(SkTMin(offset, fSize))
     , fOriginalOffset(SkTMin(originalOffset, fSize))
+    , fBufferOffset(0)
+    , fBufferLength(0)
 { }
 
 SkFILEStream::SkFILEStream(std::shared_ptr<FILE> file, size_t size, size_t offset)
@@ -168,7 +173,11 @@ SkFILEStream::SkFILEStream(FILE* file)
     : SkFILEStream(std::shared_ptr<FILE>(file, sk_fclose),
                    file ? sk_fgetsize(file) : 0,
                    file ? sk_ftell(file) : 0)
-{ }
+{
+    if (file) {
+        sk_fadvise_sequential(file);
+    }
+}
 
 
 SkFILEStream::SkFILEStream(const char path[])
@@ -183,21 +192,59 @@ void SkFILEStream::close() {
     fFILE.reset();
     fSize = 0;
     fOffset = 0;
+    fBuffer.reset();
+    fBufferLength = 0;
 }
 
 size_t SkFILEStream::read(void* buffer, size_t size) {
     if (size > fSize - fOffset) {
         size = fSize - fOffset;
     }
-    size_t bytesRead = size;
-    if (buffer) {
-        bytesRead = sk_qread(fFILE.get(), buffer, size, fOffset);
+    if (!buffer) {
+        fOffset += size;
+        return size;
     }
-    if (bytesRead == SIZE_MAX) {
-        return 0;
+
+    char* dst = static_cast<char*>(buffer);
+    size_t bytesRead = 0;
+    if (fOffset >= fBufferOffset && fOffset < fBufferOffset + fBufferLength) {
+        size_t bytes = SkTMin(size, fBufferOffset + fBufferLength - fOffset);
+        memcpy(dst, fBuffer.get() + (fOffset - fBufferOffset), bytes);
+        dst += bytes;
+        size -= bytes;
+        fOffset += bytes;
+        bytesRead += bytes;
     }
-    fOffset += bytesRead;
-    return bytesRead;
+    if (size == 0) {
+        return bytesRead;
+    }
+
+    if (size >= kFILEStreamBufferSize) {
+        // Large reads gain nothing from the buffer; read straight into the caller's memory.
+        size_t bytes = sk_qread(fFILE.get(), dst, size, fOffset);
+        if (bytes == SIZE_MAX) {
+            return bytesRead;
+        }
+        fOffset += bytes;
+        return bytesRead + bytes;
+    }
+
+    if (!fBuffer) {
+        fBuffer.reset(new char[kFILEStreamBufferSize]);
+    }
+    size_t bytes = sk_qread(fFILE.get(), fBuffer.get(), SkTMin(kFILEStreamBufferSize, fSize - fOffset),
+                            fOffset);
+    if (bytes == SIZE_MAX) {
+        fBufferLength = 0;
+        return bytesRead;
+    }
+    fBufferOffset = fOffset;
+    fBufferLength = bytes;
+
+    bytes = SkTMin(size, bytes);
+    memcpy(dst, fBuffer.get(), bytes);
+    fOffset += bytes;
+    return bytesRead + bytes;
 }
 
 bool SkFILEStream::isAtEnd() const {
@@ -882,24 +929,38 @@ std::unique_ptr<SkStreamAsset> SkDynamicMemoryWStream::detachAsStream() {
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
-static sk_sp<SkData> mmap_filename(const char path[]) {
+// Files smaller than this are read into memory with a single read, which costs less than setting
+// up and later tearing down a mapping. Either way the stream has a memory base to share.
+static constexpr size_t kMinMmapSize = 64 * 1024;
+
+static sk_sp<SkData> map_or_read_filename(const char path[]) {
     FILE* file = sk_fopen(path, kRead_SkFILE_Flag);
     if (nullptr == file) {
         return nullptr;
     }
 
-    auto data = SkData::MakeFromFILE(file);
+    sk_sp<SkData> data;
+    size_t size = sk_fgetsize(file);
+    if (size >= kMinMmapSize) {
+        data = SkData::MakeFromFILE(file);
+    } else if (size > 0) {
+        data = SkData::MakeUninitialized(size);
+        if (sk_qread(file, data->writable_data(), size, 0) != size) {
+            data = nullptr;
+        }
+    }
     sk_fclose(file);
     return data;
 }
 
 std::unique_ptr<SkStreamAsset> SkStream::MakeFromFile(const char path[]) {
-    auto data(mmap_filename(path));
+    auto data(map_or_read_filename(path));
     if (data) {
         return skstd::make_unique<SkMemoryStream>(std::move(data));
     }
 
-    // If we get here, then our attempt at using mmap failed, so try normal file access.
+    // If we get here, the file could not be mapped or read up front (e.g. it is not a regular
+    // file), so read it through the stream's buffer.
     auto stream = skstd::make_unique<SkFILEStream>(path);
     if (!stream->isValid()) {
         return nullptr;
@@ -257,6 +257,20 @@ int SkStrike::glyphMetrics(const SkGlyphID glyphIDs[],
     return drawableGlyphCount;
 }
 
+int SkStrike::prepareForDrawing(const SkGlyphID glyphIDs[],
+                                const SkPoint positions[],
+                                int n,
+                                SkGlyphPos result[]) {
+    SkScalerContext::AutoGlyphBatch batch(fScalerContext.get());
+
+    int drawableGlyphCount = this->glyphMetrics(glyphIDs, positions, n, result);
+    for (int i = 0; i < drawableGlyphCount; i++) {
+        this->findImage(*result[i].glyph);
+    }
+
+    return drawableGlyphCount;
+}
+
 #include "../pathops/SkPathOpsCubic.h"
 #include "../pathops/SkPathOpsQuad.h"
 
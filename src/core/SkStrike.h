@@ -17,6 +17,7 @@
 #include "SkTHash.h"
 #include "SkScalerContext.h"
 #include "SkStrikeInterface.h"
+#include "SkTFlatHashTable.h"
 #include "SkTemplates.h"
 #include <memory>
 
@@ -73,10 +74,16 @@ public:
     /** Return the number of glyphs currently cached. */
     int countCachedGlyphs() const;
 
+    /** Call fn with each glyph currently cached. */
+    template <typename Fn>
+    void forEachCachedGlyph(Fn&& fn) const {
+        fGlyphMap.foreach([&fn](const SkGlyph* glyph) { fn(*glyph); });
+    }
+
     /** Return the image associated with the glyph. If it has not been generated this will
         trigger that.
     */
-    const void* findImage(const SkGlyph&);
+    const void* findImage(const SkGlyph&) override;
 
     /** Initializes the image associated with the glyph with |data|.
      */
@@ -138,6 +145,12 @@ public:
 
     int glyphMetrics(const SkGlyphID[], const SkPoint[], int n, SkGlyphPos result[]) override;
 
+    /** Same as glyphMetrics(), but also makes the image of each glyph returned. The missing
+     *  metrics, and then the missing images, are all generated in one scaler context batch
+     *  instead of one glyph at a time. Glyphs too big for an image are left without one.
+     */
+    int prepareForDrawing(const SkGlyphID[], const SkPoint[], int n, SkGlyphPos result[]);
+
     void onAboutToExitScope() override;
 
     /** Return the approx RAM usage for this cache. */
@@ -222,7 +235,7 @@ private:
     // Map from a combined GlyphID and sub-pixel position to a SkGlyph*.
     // The actual glyph is stored in the fAlloc. This structure provides an
     // unchanging pointer as long as the cache is alive.
-    SkTHashTable<SkGlyph*, SkPackedGlyphID, GlyphMapHashTraits> fGlyphMap;
+    SkTFlatHashTable<SkGlyph*, SkPackedGlyphID, GlyphMapHashTraits> fGlyphMap;
 
     // so we don't grow our arrays a lot
     static constexpr size_t kMinGlyphCount = 8;
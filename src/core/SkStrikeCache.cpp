@@ -7,15 +7,21 @@
 
 #include "SkStrikeCache.h"
 
+#include <algorithm>
 #include <cctype>
+#include <vector>
 
 #include "SkGlyphRunPainter.h"
 #include "SkGraphics.h"
 #include "SkMutex.h"
+#include "SkReadBuffer.h"
+#include "SkStream.h"
 #include "SkStrike.h"
+#include "SkTHash.h"
 #include "SkTemplates.h"
 #include "SkTraceMemoryDump.h"
 #include "SkTypeface.h"
+#include "SkWriteBuffer.h"
 
 class SkStrikeCache::Node final : public SkStrikeInterface {
 public:
@@ -46,6 +52,10 @@ public:
         return fStrike.decideCouldDrawFromPath(glyph);
     }
 
+    const void* findImage(const SkGlyph& glyph) override {
+        return fStrike.findImage(glyph);
+    }
+
     const SkDescriptor& getDescriptor() const override {
         return fStrike.getDescriptor();
     }
@@ -59,8 +69,11 @@ public:
     }
 
     SkStrikeCache* const            fStrikeCache;
-    Node*                           fNext{nullptr};
+    Node*                           fNext{nullptr};     // Bucket links, guarded by its fLock.
     Node*                           fPrev{nullptr};
+    bool                            fInBucket{false};   // Only touched by whoever claims us.
+    std::atomic<bool>               fInUse{true};       // New strikes start out claimed.
+    std::atomic<uint64_t>           fLastUse{0};
     SkStrike                        fStrike;
     std::unique_ptr<SkStrikePinner> fPinner;
 };
@@ -127,11 +140,13 @@ bool operator == (decltype(nullptr), const SkStrikeCache::ExclusiveStrikePtr& rh
 }
 
 SkStrikeCache::~SkStrikeCache() {
-    Node* node = fHead;
-    while (node) {
-        Node* next = node->fNext;
-        delete node;
-        node = next;
+    for (Bucket& bucket : fBuckets) {
+        Node* node = bucket.fHead;
+        while (node) {
+            Node* next = node->fNext;
+            delete node;
+            node = next;
+        }
     }
 }
 
@@ -173,8 +188,11 @@ auto SkStrikeCache::findOrCreateStrike(const SkDescriptor& desc,
                                        const SkTypeface& typeface) -> Node* {
     Node* node = this->findAndDetachStrike(desc);
     if (node == nullptr) {
+        fLookupMisses.fetch_add(1, std::memory_order_relaxed);
         auto scaler = CreateScalerContext(desc, effects, typeface);
         node = this->createStrike(desc, std::move(scaler));
+    } else {
+        fLookupHits.fetch_add(1, std::memory_order_relaxed);
     }
     return node;
 }
@@ -184,8 +202,11 @@ SkScopedStrike SkStrikeCache::findOrCreateScopedStrike(const SkDescriptor& desc,
                                                        const SkTypeface& typeface) {
     Node* node = this->findAndDetachStrike(desc);
     if (node == nullptr) {
+        fLookupMisses.fetch_add(1, std::memory_order_relaxed);
         auto scaler = CreateScalerContext(desc, effects, typeface);
         node = this->createStrike(desc, std::move(scaler));
+    } else {
+        fLookupHits.fetch_add(1, std::memory_order_relaxed);
     }
     return SkScopedStrike{node};
 }
@@ -303,18 +324,253 @@ void SkStrikeCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
     GlobalStrikeCache()->forEachStrike(visitor);
 }
 
+namespace {
+    // Bump the version whenever the snapshot layout changes.
+    constexpr uint32_t kSnapshotMagic   = SkSetFourByteTag('s', 'k', 's', 'c');
+    constexpr uint32_t kSnapshotVersion = 1;
+}  // namespace
+
+// Typeface uniqueIDs only mean something within one process, so snapshots name their typefaces by
+// descriptor. The head table's checkSumAdjustment covers the whole font file, so it tells us
+// whether that name still finds the same font.
+static uint32_t font_checksum(const SkTypeface& typeface) {
+    uint32_t checksum = 0;
+    typeface.getTableData(SkSetFourByteTag('h', 'e', 'a', 'd'), 8, sizeof(checksum), &checksum);
+    return checksum;
+}
+
+static void write_glyph(const SkGlyph& glyph, SkWriteBuffer* buffer) {
+    buffer->writeUInt(glyph.getGlyphID());
+    buffer->writeInt(glyph.getSubXFixed());
+    buffer->writeInt(glyph.getSubYFixed());
+    buffer->writeScalar(glyph.fAdvanceX);
+    buffer->writeScalar(glyph.fAdvanceY);
+    buffer->writeUInt(glyph.fWidth);
+    buffer->writeUInt(glyph.fHeight);
+    buffer->writeInt(glyph.fTop);
+    buffer->writeInt(glyph.fLeft);
+    buffer->writeInt(glyph.fForceBW);
+    buffer->writeUInt(glyph.fMaskFormat);
+
+    // Only the images and paths something asked for are in the strike.
+    buffer->writeByteArray(glyph.fImage, glyph.fImage ? glyph.computeImageSize() : 0);
+    const SkPath* path = glyph.path();
+    buffer->writeDataAsByteArray((path ? path->serialize() : SkData::MakeEmpty()).get());
+}
+
+static void read_glyph(SkReadBuffer* buffer, SkStrike* strike) {
+    uint32_t code       = buffer->readUInt();
+    SkFixed  subX       = buffer->readInt();
+    SkFixed  subY       = buffer->readInt();
+    float    advanceX   = buffer->readScalar();
+    float    advanceY   = buffer->readScalar();
+    uint32_t width      = buffer->readUInt();
+    uint32_t height     = buffer->readUInt();
+    int32_t  top        = buffer->readInt();
+    int32_t  left       = buffer->readInt();
+    int32_t  forceBW    = buffer->readInt();
+    uint32_t maskFormat = buffer->readUInt();
+    uint32_t imageSize  = buffer->readUInt();
+    const void* image   = buffer->skip(imageSize);
+    uint32_t pathSize   = buffer->readUInt();
+    const void* path    = buffer->skip(pathSize);
+
+    buffer->validate(SkTFitsIn<uint16_t>(width) && SkTFitsIn<uint16_t>(height) &&
+                     SkTFitsIn<int16_t>(top) && SkTFitsIn<int16_t>(left) &&
+                     SkTFitsIn<int8_t>(forceBW) &&
+                     (maskFormat < SkMask::kCountMaskFormats ||
+                      maskFormat == MASK_FORMAT_JUST_ADVANCE));
+    if (!buffer->isValid() || strike == nullptr || code >= strike->getGlyphCount()) {
+        return;
+    }
+
+    SkGlyph* glyph = strike->getRawGlyphByID(SkPackedGlyphID(SkToU16(code), subX, subY));
+    // Keep what the strike already worked out for itself.
+    if (!glyph->isFullMetrics()) {
+        glyph->fAdvanceX   = advanceX;
+        glyph->fAdvanceY   = advanceY;
+        glyph->fWidth      = SkToU16(width);
+        glyph->fHeight     = SkToU16(height);
+        glyph->fTop        = SkToS16(top);
+        glyph->fLeft       = SkToS16(left);
+        glyph->fForceBW    = SkToS8(forceBW);
+        glyph->fMaskFormat = SkToU8(maskFormat);
+    }
+    if (imageSize > 0 && imageSize == glyph->computeImageSize()) {
+        strike->initializeImage(image, imageSize, glyph);
+    }
+    if (pathSize > 0 && !glyph->isEmpty()) {
+        buffer->validate(strike->initializePath(glyph, path, pathSize));
+    }
+}
+
+bool SkStrikeCache::writeSnapshot(SkWStream* stream) const {
+    std::vector<sk_sp<SkTypeface>> typefaces;
+    SkTHashMap<SkFontID, uint32_t> typefaceIndices;
+    SkBinaryWriteBuffer strikes;
+    uint32_t strikeCount = 0;
+
+    auto visitor = [&](const SkStrike& strike) {
+        // Effects would have to be unflattened to rebuild the scaler context; leave them out.
+        if (strike.getDescriptor().findEntry(kEffects_SkDescriptorTag, nullptr)) {
+            return;
+        }
+
+        SkTypeface* typeface = strike.getScalerContext()->getTypeface();
+        uint32_t* index = typefaceIndices.find(typeface->uniqueID());
+        if (index == nullptr) {
+            index = typefaceIndices.set(typeface->uniqueID(), SkToU32(typefaces.size()));
+            typefaces.push_back(sk_ref_sp(typeface));
+        }
+
+        strikes.writeUInt(*index);
+        strikes.writePad32(&strike.getScalerContext()->getRec(), sizeof(SkScalerContextRec));
+        strikes.writePad32(&strike.getFontMetrics(), sizeof(SkFontMetrics));
+        strikes.writeUInt(strike.countCachedGlyphs());
+        strike.forEachCachedGlyph([&strikes](const SkGlyph& glyph) {
+            write_glyph(glyph, &strikes);
+        });
+        strikeCount += 1;
+    };
+    this->forEachStrike(visitor);
+
+    SkBinaryWriteBuffer header;
+    header.writeUInt(kSnapshotMagic);
+    header.writeUInt(kSnapshotVersion);
+    header.writeUInt(sizeof(SkScalerContextRec));
+    header.writeUInt(SkToU32(typefaces.size()));
+    for (const sk_sp<SkTypeface>& typeface : typefaces) {
+        sk_sp<SkData> descriptor =
+                typeface->serialize(SkTypeface::SerializeBehavior::kDontIncludeData);
+        header.writeDataAsByteArray(descriptor.get());
+        header.writeInt(typeface->countGlyphs());
+        header.writeInt(typeface->getUnitsPerEm());
+        header.writeUInt(font_checksum(*typeface));
+    }
+    header.writeUInt(strikeCount);
+
+    return header.writeToStream(stream) && strikes.writeToStream(stream);
+}
+
+bool SkStrikeCache::readSnapshot(const void* data, size_t size) {
+    SkReadBuffer buffer(data, size);
+    if (buffer.readUInt() != kSnapshotMagic ||
+        buffer.readUInt() != kSnapshotVersion ||
+        buffer.readUInt() != sizeof(SkScalerContextRec)) {
+        return false;
+    }
+
+    // Typefaces that can't be found again, or that are now a different font, stay null and their
+    // strikes are skipped.
+    uint32_t typefaceCount = buffer.readUInt();
+    if (!buffer.validateCanReadN<uint32_t>(typefaceCount)) {
+        return false;
+    }
+    std::vector<sk_sp<SkTypeface>> typefaces(typefaceCount);
+    for (sk_sp<SkTypeface>& typeface : typefaces) {
+        sk_sp<SkData> descriptor = buffer.readByteArrayAsData();
+        int glyphCount = buffer.readInt();
+        int unitsPerEm = buffer.readInt();
+        uint32_t checksum = buffer.readUInt();
+        if (!buffer.isValid()) {
+            return false;
+        }
+
+        SkMemoryStream stream(std::move(descriptor));
+        typeface = SkTypeface::MakeDeserialize(&stream);
+        if (typeface && (typeface->countGlyphs() != glyphCount ||
+                         typeface->getUnitsPerEm() != unitsPerEm ||
+                         font_checksum(*typeface) != checksum)) {
+            typeface = nullptr;
+        }
+    }
+
+    uint32_t strikeCount = buffer.readUInt();
+    for (uint32_t i = 0; i < strikeCount && buffer.isValid(); ++i) {
+        uint32_t typefaceIndex = buffer.readUInt();
+        SkScalerContextRec rec;
+        SkFontMetrics metrics;
+        buffer.readPad32(&rec, sizeof(rec));
+        buffer.readPad32(&metrics, sizeof(metrics));
+        uint32_t glyphCount = buffer.readUInt();
+        if (!buffer.validate(typefaceIndex < typefaceCount)) {
+            break;
+        }
+
+        ExclusiveStrikePtr strike;
+        if (SkTypeface* typeface = typefaces[typefaceIndex].get()) {
+            rec.fFontID = typeface->uniqueID();
+            SkAutoDescriptor ad;
+            SkScalerContextEffects noEffects;
+            SkDescriptor* desc =
+                    SkScalerContext::AutoDescriptorGivenRecAndEffects(rec, noEffects, &ad);
+            strike = this->findStrikeExclusive(*desc);
+            if (strike == nullptr) {
+                // A real scaler context, so glyphs missing from the snapshot still rasterize.
+                strike = this->createStrikeExclusive(
+                        *desc, CreateScalerContext(*desc, noEffects, *typeface), &metrics);
+            }
+        }
+        for (uint32_t j = 0; j < glyphCount && buffer.isValid(); ++j) {
+            read_glyph(&buffer, strike.get());
+        }
+    }
+
+    return buffer.isValid();
+}
+
 
 void SkStrikeCache::attachNode(Node* node) {
     if (node == nullptr) {
         return;
     }
-    SkAutoExclusive ac(fLock);
-
-    this->validate();
     node->fStrike.validate();
 
-    this->internalAttachToHead(node);
-    this->internalPurge();
+    if (!node->fInBucket) {
+        Bucket& bucket = this->bucketFor(node->fStrike.getDescriptor());
+        SkAutoExclusive ac(bucket.fLock);
+
+        node->fNext = bucket.fHead;
+        if (bucket.fHead) {
+            bucket.fHead->fPrev = node;
+        }
+        bucket.fHead = node;
+        node->fInBucket = true;
+    }
+
+    node->fLastUse.store(fUseClock.fetch_add(1, std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+    this->unclaim(node);
+
+    if (this->isOverBudget()) {
+        SkAutoExclusive ac(fPurgeLock);
+        this->internalPurge();
+    }
+}
+
+bool SkStrikeCache::tryClaim(Node* node) {
+    bool idle = false;
+    if (!node->fInUse.compare_exchange_strong(idle, true, std::memory_order_acquire,
+                                                          std::memory_order_relaxed)) {
+        return false;
+    }
+    fCacheCount.fetch_sub(1, std::memory_order_relaxed);
+    fTotalMemoryUsed.fetch_sub(node->fStrike.getMemoryUsed(), std::memory_order_relaxed);
+    return true;
+}
+
+void SkStrikeCache::unclaim(Node* node) {
+    SkASSERT(node->fInUse.load(std::memory_order_relaxed));
+    fCacheCount.fetch_add(1, std::memory_order_relaxed);
+    fTotalMemoryUsed.fetch_add(node->fStrike.getMemoryUsed(), std::memory_order_relaxed);
+    node->fInUse.store(false, std::memory_order_release);
+}
+
+bool SkStrikeCache::isOverBudget() const {
+    return fTotalMemoryUsed.load(std::memory_order_relaxed) >
+               fCacheSizeLimit.load(std::memory_order_relaxed)
+        || fCacheCount.load(std::memory_order_relaxed) >
+               fCacheCountLimit.load(std::memory_order_relaxed);
 }
 
 SkExclusiveStrikePtr SkStrikeCache::findStrikeExclusive(const SkDescriptor& desc) {
@@ -322,11 +578,12 @@ SkExclusiveStrikePtr SkStrikeCache::findStrikeExclusive(const SkDescriptor& desc
 }
 
 auto SkStrikeCache::findAndDetachStrike(const SkDescriptor& desc) -> Node* {
-    SkAutoExclusive ac(fLock);
+    Bucket& bucket = this->bucketFor(desc);
+    SkAutoExclusive ac(bucket.fLock);
 
-    for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
-        if (node->fStrike.getDescriptor() == desc) {
-            this->internalDetachCache(node);
+    for (Node* node = bucket.fHead; node != nullptr; node = node->fNext) {
+        // Strikes already checked out are skipped, just as if they were detached from the cache.
+        if (node->fStrike.getDescriptor() == desc && this->tryClaim(node)) {
             return node;
         }
     }
@@ -363,27 +620,33 @@ static bool loose_compare(const SkDescriptor& lhs, const SkDescriptor& rhs) {
 
 bool SkStrikeCache::desperationSearchForImage(const SkDescriptor& desc, SkGlyph* glyph,
                                               SkStrike* targetCache) {
-    SkAutoExclusive ac(fLock);
-
     SkGlyphID glyphID = glyph->getGlyphID();
     SkFixed targetSubX = glyph->getSubXFixed(),
             targetSubY = glyph->getSubYFixed();
 
-    for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
-        if (loose_compare(node->fStrike.getDescriptor(), desc)) {
+    for (Bucket& bucket : fBuckets) {
+        SkAutoExclusive ac(bucket.fLock);
+
+        for (Node* node = bucket.fHead; node != nullptr; node = node->fNext) {
+            if (!loose_compare(node->fStrike.getDescriptor(), desc) || !this->tryClaim(node)) {
+                continue;
+            }
+            // This desperate-match node may disappear as soon as we unclaim it, so we
+            // need to copy the glyph from node into this strike, including a
+            // deep copy of the mask.
+            const SkGlyph* fallback = nullptr;
             auto targetGlyphID = SkPackedGlyphID(glyphID, targetSubX, targetSubY);
             if (node->fStrike.isGlyphCached(glyphID, targetSubX, targetSubY)) {
-                SkGlyph* fallback = node->fStrike.getRawGlyphByID(targetGlyphID);
-                // This desperate-match node may disappear as soon as we drop fLock, so we
-                // need to copy the glyph from node into this strike, including a
-                // deep copy of the mask.
-                targetCache->initializeGlyphFromFallback(glyph, *fallback);
-                return true;
+                fallback = node->fStrike.getRawGlyphByID(targetGlyphID);
+            } else {
+                // Look for any sub-pixel pos for this glyph, in case there is a pos mismatch.
+                fallback = node->fStrike.getCachedGlyphAnySubPix(glyphID);
             }
-
-            // Look for any sub-pixel pos for this glyph, in case there is a pos mismatch.
-            if (const auto* fallback = node->fStrike.getCachedGlyphAnySubPix(glyphID)) {
+            if (fallback) {
                 targetCache->initializeGlyphFromFallback(glyph, *fallback);
+            }
+            this->unclaim(node);
+            if (fallback) {
                 return true;
             }
         }
@@ -394,25 +657,33 @@ bool SkStrikeCache::desperationSearchForImage(const SkDescriptor& desc, SkGlyph*
 
 bool SkStrikeCache::desperationSearchForPath(
         const SkDescriptor& desc, SkGlyphID glyphID, SkPath* path) {
-    SkAutoExclusive ac(fLock);
-
     // The following is wrong there is subpixel positioning with paths...
     // Paths are only ever at sub-pixel position (0,0), so we can just try that directly rather
     // than try our packed position first then search all others on failure like for masks.
     //
     // This will have to search the sub-pixel positions too.
     // There is also a problem with accounting for cache size with shared path data.
-    for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
-        if (loose_compare(node->fStrike.getDescriptor(), desc)) {
+    for (Bucket& bucket : fBuckets) {
+        SkAutoExclusive ac(bucket.fLock);
+
+        for (Node* node = bucket.fHead; node != nullptr; node = node->fNext) {
+            if (!loose_compare(node->fStrike.getDescriptor(), desc) || !this->tryClaim(node)) {
+                continue;
+            }
+            bool found = false;
             if (node->fStrike.isGlyphCached(glyphID, 0, 0)) {
                 SkGlyph* from = node->fStrike.getRawGlyphByID(SkPackedGlyphID(glyphID));
                 if (from->fPathData != nullptr) {
                     // We can just copy the path out by value here, so no need to worry
                     // about the lifetime of this desperate-match node.
                     *path = from->fPathData->fPath;
-                    return true;
+                    found = true;
                 }
             }
+            this->unclaim(node);
+            if (found) {
+                return true;
+            }
         }
     }
     return false;
@@ -454,22 +725,27 @@ auto SkStrikeCache::createStrike(
 }
 
 void SkStrikeCache::purgeAll() {
-    SkAutoExclusive ac(fLock);
+    SkAutoExclusive ac(fPurgeLock);
     this->internalPurge(fTotalMemoryUsed);
 }
 
 size_t SkStrikeCache::getTotalMemoryUsed() const {
-    SkAutoExclusive ac(fLock);
     return fTotalMemoryUsed;
 }
 
 int SkStrikeCache::getCacheCountUsed() const {
-    SkAutoExclusive ac(fLock);
     return fCacheCount;
 }
 
+int64_t SkStrikeCache::getLookupHits() const {
+    return fLookupHits.load(std::memory_order_relaxed);
+}
+
+int64_t SkStrikeCache::getLookupMisses() const {
+    return fLookupMisses.load(std::memory_order_relaxed);
+}
+
 int SkStrikeCache::getCacheCountLimit() const {
-    SkAutoExclusive ac(fLock);
     return fCacheCountLimit;
 }
 
@@ -479,16 +755,14 @@ size_t SkStrikeCache::setCacheSizeLimit(size_t newLimit) {
         newLimit = minLimit;
     }
 
-    SkAutoExclusive ac(fLock);
+    SkAutoExclusive ac(fPurgeLock);
 
-    size_t prevLimit = fCacheSizeLimit;
-    fCacheSizeLimit = newLimit;
+    size_t prevLimit = fCacheSizeLimit.exchange(newLimit);
     this->internalPurge();
     return prevLimit;
 }
 
 size_t  SkStrikeCache::getCacheSizeLimit() const {
-    SkAutoExclusive ac(fLock);
     return fCacheSizeLimit;
 }
 
@@ -497,16 +771,15 @@ int SkStrikeCache::setCacheCountLimit(int newCount) {
         newCount = 0;
     }
 
-    SkAutoExclusive ac(fLock);
+    SkAutoExclusive ac(fPurgeLock);
 
-    int prevCount = fCacheCountLimit;
-    fCacheCountLimit = newCount;
+    int prevCount = fCacheCountLimit.exchange(newCount);
     this->internalPurge();
     return prevCount;
 }
 
 int SkStrikeCache::getCachePointSizeLimit() const {
-    SkAutoExclusive ac(fLock);
+    SkAutoExclusive ac(fPurgeLock);
     return fPointSizeLimit;
 }
 
@@ -515,7 +788,7 @@ int SkStrikeCache::setCachePointSizeLimit(int newLimit) {
         newLimit = 0;
     }
 
-    SkAutoExclusive ac(fLock);
+    SkAutoExclusive ac(fPurgeLock);
 
     int prevLimit = fPointSizeLimit;
     fPointSizeLimit = newLimit;
@@ -523,33 +796,46 @@ int SkStrikeCache::setCachePointSizeLimit(int newLimit) {
 }
 
 void SkStrikeCache::forEachStrike(std::function<void(const SkStrike&)> visitor) const {
-    SkAutoExclusive ac(fLock);
+    // Holding fPurgeLock keeps every node alive, so we only need the bucket lock to walk it.
+    SkAutoExclusive ac(fPurgeLock);
 
     this->validate();
 
-    for (Node* node = this->internalGetHead(); node != nullptr; node = node->fNext) {
-        visitor(node->fStrike);
+    auto self = const_cast<SkStrikeCache*>(this);
+    for (Bucket& bucket : fBuckets) {
+        SkAutoExclusive bc(bucket.fLock);
+        for (Node* node = bucket.fHead; node != nullptr; node = node->fNext) {
+            if (self->tryClaim(node)) {
+                visitor(node->fStrike);
+                self->unclaim(node);
+            }
+        }
     }
 }
 
 size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
     this->validate();
 
+    size_t totalMemoryUsed = fTotalMemoryUsed,
+           cacheSizeLimit  = fCacheSizeLimit;
+    int    cacheCount      = fCacheCount,
+           cacheCountLimit = fCacheCountLimit;
+
     size_t bytesNeeded = 0;
-    if (fTotalMemoryUsed > fCacheSizeLimit) {
-        bytesNeeded = fTotalMemoryUsed - fCacheSizeLimit;
+    if (totalMemoryUsed > cacheSizeLimit) {
+        bytesNeeded = totalMemoryUsed - cacheSizeLimit;
     }
     bytesNeeded = SkTMax(bytesNeeded, minBytesNeeded);
     if (bytesNeeded) {
         // no small purges!
-        bytesNeeded = SkTMax(bytesNeeded, fTotalMemoryUsed >> 2);
+        bytesNeeded = SkTMax(bytesNeeded, totalMemoryUsed >> 2);
     }
 
     int countNeeded = 0;
-    if (fCacheCount > fCacheCountLimit) {
-        countNeeded = fCacheCount - fCacheCountLimit;
+    if (cacheCount > cacheCountLimit) {
+        countNeeded = cacheCount - cacheCountLimit;
         // no small purges!
-        countNeeded = SkMax32(countNeeded, fCacheCount >> 2);
+        countNeeded = SkMax32(countNeeded, cacheCount >> 2);
     }
 
     // early exit
@@ -557,23 +843,49 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
         return 0;
     }
 
+    // Only we delete nodes, so they all stay valid while we hold fPurgeLock, even unlocked.
+    std::vector<Node*> nodes;
+    for (Bucket& bucket : fBuckets) {
+        SkAutoExclusive ac(bucket.fLock);
+        for (Node* node = bucket.fHead; node != nullptr; node = node->fNext) {
+            nodes.push_back(node);
+        }
+    }
+    // Least recently used first.
+    std::sort(nodes.begin(), nodes.end(), [](const Node* a, const Node* b) {
+        return a->fLastUse.load(std::memory_order_relaxed) <
+               b->fLastUse.load(std::memory_order_relaxed);
+    });
+
     size_t  bytesFreed = 0;
     int     countFreed = 0;
 
-    // Start at the tail and proceed backwards deleting; the list is in LRU
-    // order, with unimportant entries at the tail.
-    Node* node = this->internalGetTail();
-    while (node != nullptr && (bytesFreed < bytesNeeded || countFreed < countNeeded)) {
-        Node* prev = node->fPrev;
-
-        // Only delete if the strike is not pinned.
-        if (node->fPinner == nullptr || node->fPinner->canDelete()) {
-            bytesFreed += node->fStrike.getMemoryUsed();
-            countFreed += 1;
-            this->internalDetachCache(node);
-            delete node;
+    for (size_t i = 0; i < nodes.size() && (bytesFreed < bytesNeeded || countFreed < countNeeded);
+         ++i) {
+        Node* node = nodes[i];
+        Bucket& bucket = this->bucketFor(node->fStrike.getDescriptor());
+        SkAutoExclusive ac(bucket.fLock);
+
+        // Only delete if the strike is idle and not pinned.
+        if (!this->tryClaim(node)) {
+            continue;
+        }
+        if (node->fPinner != nullptr && !node->fPinner->canDelete()) {
+            this->unclaim(node);
+            continue;
+        }
+        bytesFreed += node->fStrike.getMemoryUsed();
+        countFreed += 1;
+
+        if (node->fPrev) {
+            node->fPrev->fNext = node->fNext;
+        } else {
+            bucket.fHead = node->fNext;
         }
-        node = prev;
+        if (node->fNext) {
+            node->fNext->fPrev = node->fPrev;
+        }
+        delete node;
     }
 
     this->validate();
@@ -588,40 +900,6 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
     return bytesFreed;
 }
 
-void SkStrikeCache::internalAttachToHead(Node* node) {
-    SkASSERT(nullptr == node->fPrev && nullptr == node->fNext);
-    if (fHead) {
-        fHead->fPrev = node;
-        node->fNext = fHead;
-    }
-    fHead = node;
-
-    if (fTail == nullptr) {
-        fTail = node;
-    }
-
-    fCacheCount += 1;
-    fTotalMemoryUsed += node->fStrike.getMemoryUsed();
-}
-
-void SkStrikeCache::internalDetachCache(Node* node) {
-    SkASSERT(fCacheCount > 0);
-    fCacheCount -= 1;
-    fTotalMemoryUsed -= node->fStrike.getMemoryUsed();
-
-    if (node->fPrev) {
-        node->fPrev->fNext = node->fNext;
-    } else {
-        fHead = node->fNext;
-    }
-    if (node->fNext) {
-        node->fNext->fPrev = node->fPrev;
-    } else {
-        fTail = node->fPrev;
-    }
-    node->fPrev = node->fNext = nullptr;
-}
-
 void SkStrikeCache::ValidateGlyphCacheDataSize() {
 #ifdef SK_DEBUG
     GlobalStrikeCache()->validateGlyphCacheDataSize();
@@ -638,20 +916,20 @@ void SkStrikeCache::validateGlyphCacheDataSize() const {
 
 #ifdef SK_DEBUG
 void SkStrikeCache::validate() const {
-    size_t computedBytes = 0;
-    int computedCount = 0;
-
-    const Node* node = fHead;
-    while (node != nullptr) {
-        computedBytes += node->fStrike.getMemoryUsed();
-        computedCount += 1;
-        node = node->fNext;
+    // Other threads may be claiming and releasing strikes, so the totals are only approximate;
+    // check that the buckets are well formed instead.
+    for (int i = 0; i < kBucketCount; ++i) {
+        Bucket& bucket = fBuckets[i];
+        SkAutoExclusive ac(bucket.fLock);
+
+        const Node* prev = nullptr;
+        for (const Node* node = bucket.fHead; node != nullptr; node = node->fNext) {
+            SkASSERT(node->fPrev == prev);
+            SkASSERT(node->fInBucket || node->fInUse);
+            SkASSERT(node->fStrike.getDescriptor().getChecksum() % kBucketCount == (uint32_t)i);
+            prev = node;
+        }
     }
-
-    SkASSERTF(fCacheCount == computedCount, "fCacheCount: %d, computedCount: %d", fCacheCount,
-              computedCount);
-    SkASSERTF(fTotalMemoryUsed == computedBytes, "fTotalMemoryUsed: %d, computedBytes: %d",
-              fTotalMemoryUsed, computedBytes);
 }
 #endif
 
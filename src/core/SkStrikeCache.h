@@ -8,6 +8,7 @@
 #ifndef SkStrikeCache_DEFINED
 #define SkStrikeCache_DEFINED
 
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -18,6 +19,7 @@
 
 class SkStrike;
 class SkTraceMemoryDump;
+class SkWStream;
 
 #ifndef SK_DEFAULT_FONT_CACHE_COUNT_LIMIT
     #define SK_DEFAULT_FONT_CACHE_COUNT_LIMIT   2048
@@ -149,6 +151,13 @@ public:
     // SkTraceMemoryDump interface.
     static void DumpMemoryStatistics(SkTraceMemoryDump* dump);
 
+    // Write the glyphs of every idle strike to the stream, or add strikes written that way back
+    // to this cache. Strikes with path effects or mask filters are not written. Reading skips
+    // strikes whose typeface can't be found or no longer matches the one that was written, and
+    // fails if the data was written by a different snapshot version.
+    bool writeSnapshot(SkWStream*) const;
+    bool readSnapshot(const void* data, size_t size);
+
     // call when a glyphcache is available for caching (i.e. not in use)
     void attachNode(Node* node);
 
@@ -162,6 +171,10 @@ public:
     size_t setCacheSizeLimit(size_t limit);
     size_t getTotalMemoryUsed() const;
 
+    // Lookups through findOrCreateStrike() that found an existing strike, or had to create one.
+    int64_t getLookupHits() const;
+    int64_t getLookupMisses() const;
+
     int  getCachePointSizeLimit() const;
     int  setCachePointSizeLimit(int limit);
 
@@ -176,28 +189,44 @@ public:
 #endif
 
 private:
+    // Strikes live in buckets chosen by their descriptor's checksum.  Finding a strike only locks
+    // its bucket and atomically claims the node, so lookups for different strikes don't contend.
+    struct Bucket {
+        SkSpinlock fLock;
+        Node*      fHead{nullptr};
+    };
+    static constexpr int kBucketCount = 64;
+
+    Bucket& bucketFor(const SkDescriptor& desc) {
+        return fBuckets[desc.getChecksum() % kBucketCount];
+    }
+
+    // Take exclusive use of an idle node, or give it back.  A claimed node is never purged.
+    bool tryClaim(Node*);
+    void unclaim(Node*);
 
-    // The following methods can only be called when mutex is already held.
-    Node* internalGetHead() const { return fHead; }
-    Node* internalGetTail() const { return fTail; }
-    void internalDetachCache(Node*);
-    void internalAttachToHead(Node*);
+    bool isOverBudget() const;
 
     // Checkout budgets, modulated by the specified min-bytes-needed-to-purge,
-    // and attempt to purge caches to match.
+    // and attempt to purge caches to match.  fPurgeLock must be held; it is the only
+    // thing that deletes nodes, so holding it keeps every node in the buckets alive.
     // Returns number of bytes freed.
     size_t internalPurge(size_t minBytesNeeded = 0);
 
     void forEachStrike(std::function<void(const SkStrike&)> visitor) const;
 
-    mutable SkSpinlock fLock;
-    Node*              fHead{nullptr};
-    Node*              fTail{nullptr};
-    size_t             fTotalMemoryUsed{0};
-    size_t             fCacheSizeLimit{SK_DEFAULT_FONT_CACHE_LIMIT};
-    int32_t            fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
-    int32_t            fCacheCount{0};
-    int32_t            fPointSizeLimit{SK_DEFAULT_FONT_CACHE_POINT_SIZE_LIMIT};
+    // Memory and count track only the strikes sitting idle in the cache, as if checked-out
+    // strikes had been removed from it.
+    mutable SkSpinlock    fPurgeLock;
+    mutable Bucket        fBuckets[kBucketCount];
+    std::atomic<size_t>   fTotalMemoryUsed{0};
+    std::atomic<size_t>   fCacheSizeLimit{SK_DEFAULT_FONT_CACHE_LIMIT};
+    std::atomic<int32_t>  fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
+    std::atomic<int32_t>  fCacheCount{0};
+    std::atomic<uint64_t> fUseClock{0};
+    std::atomic<int64_t>  fLookupHits{0};
+    std::atomic<int64_t>  fLookupMisses{0};
+    int32_t               fPointSizeLimit{SK_DEFAULT_FONT_CACHE_POINT_SIZE_LIMIT};
 };
 
 using SkExclusiveStrikePtr = SkStrikeCache::ExclusiveStrikePtr;
@@ -7,10 +7,13 @@
 
 #include "SkStrokerPriv.h"
 
+#include "SkArenaAlloc.h"
 #include "SkGeometry.h"
 #include "SkMacros.h"
 #include "SkPathPriv.h"
 #include "SkPointPriv.h"
+#include "SkResourceCache.h"
+#include "SkTLazy.h"
 #include "SkTo.h"
 
 #include <utility>
@@ -142,7 +145,11 @@ public:
 
     void done(SkPath* dst, bool isLine) {
         this->finishContour(false, isLine);
-        dst->swap(fOuter);
+        if (SkPathPriv::IsArenaBacked(fOuter)) {
+            *dst = fOuter;      // finishContour() swapped in fInner; copying moves it to the heap
+        } else {
+            dst->swap(fOuter);
+        }
     }
 
     SkScalar getResScale() const { return fResScale; }
@@ -170,6 +177,9 @@ private:
     SkStrokerPriv::CapProc  fCapper;
     SkStrokerPriv::JoinProc fJoiner;
 
+    // Backs the temporary paths (fInner, fCusper), so stroking many short contours doesn't keep
+    // growing heap allocations. Must be declared before the paths that use it.
+    SkSTArenaAlloc<1024> fTempStorage;
     SkPath  fInner, fOuter, fCusper; // outer is our working answer, inner is temp
 
     enum StrokeType {
@@ -375,8 +385,9 @@ SkPathStroker::SkPathStroker(const SkPath& src,
     // 1x for inner == 'wag' (worst contour length would be better guess)
     fOuter.incReserve(src.countPoints() * 3);
     fOuter.setIsVolatile(true);
-    fInner.incReserve(src.countPoints());
+    SkPathPriv::UseArenaStorage(&fInner, &fTempStorage, src.countPoints(), src.countPoints());
     fInner.setIsVolatile(true);
+    SkPathPriv::UseArenaStorage(&fCusper, &fTempStorage);
     // TODO : write a common error function used by stroking and filling
     // The '4' below matches the fill scan converter's error term
     fInvResScale = SkScalarInvert(resScale * 4);
@@ -1352,6 +1363,79 @@ void SkStroke::setJoin(SkPaint::Join join) {
 
 // If src==dst, then we use a tmp path to record the stroke, and then swap
 // its contents with src when we're done.
+///////////////////////////////////////////////////////////////////////////////
+
+// Stroking a long path is expensive, and the same path is often stroked again on every frame,
+// so the outlines of larger non-volatile paths are kept in the SkResourceCache. Entries are
+// purged when the source path ref changes or is deleted.
+static constexpr int kMinVerbsToCacheStroke = 32;
+
+static uint64_t make_stroke_shared_id(uint32_t pathGenID) {
+    uint64_t sharedID = SkSetFourByteTag('s', 't', 'r', 'k');
+    return (sharedID << 32) | pathGenID;
+}
+
+namespace {
+static unsigned gStrokeKeyNamespaceLabel;
+
+struct StrokeKey : public SkResourceCache::Key {
+public:
+    StrokeKey(const SkPath& src, SkScalar width, SkScalar miterLimit, SkScalar resScale,
+              unsigned cap, unsigned join, bool doFill)
+        : fWidth(width)
+        , fMiterLimit(miterLimit)
+        , fResScale(resScale)
+        , fStyle(cap | (join << 8) | ((unsigned)doFill << 16) | ((unsigned)src.getFillType() << 24))
+    {
+        this->init(&gStrokeKeyNamespaceLabel, make_stroke_shared_id(src.getGenerationID()),
+                   sizeof(fWidth) + sizeof(fMiterLimit) + sizeof(fResScale) + sizeof(fStyle));
+    }
+
+    SkScalar fWidth;
+    SkScalar fMiterLimit;
+    SkScalar fResScale;
+    uint32_t fStyle;
+};
+
+struct StrokeRec : public SkResourceCache::Rec {
+    StrokeRec(const StrokeKey& key, const SkPath& stroke) : fKey(key), fStroke(stroke) {}
+
+    StrokeKey fKey;
+    SkPath    fStroke;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + fStroke.countPoints() * sizeof(SkPoint) + fStroke.countVerbs();
+    }
+    const char* getCategory() const override { return "stroke"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const StrokeRec& rec = static_cast<const StrokeRec&>(baseRec);
+        *(SkPath*)contextData = rec.fStroke;
+        return true;
+    }
+};
+
+class StrokeInvalidator : public SkPathRef::GenIDChangeListener {
+public:
+    explicit StrokeInvalidator(uint32_t pathGenID) : fPathGenID(pathGenID) {}
+
+private:
+    uint32_t fPathGenID;
+
+    void onChange() override {
+        SkResourceCache::PostPurgeSharedID(make_stroke_shared_id(fPathGenID));
+    }
+};
+} // namespace
+
+static bool can_cache_stroke(const SkPath& src) {
+    return !src.isVolatile() && src.countVerbs() >= kMinVerbsToCacheStroke;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 class AutoTmpPath {
 public:
     AutoTmpPath(const SkPath& src, SkPath** dst) : fSrc(src) {
@@ -1403,6 +1487,14 @@ void SkStroke::strokePath(const SkPath& src, SkPath* dst) const {
         }
     }
 
+    SkTLazy<StrokeKey> key;
+    if (can_cache_stroke(src)) {
+        key.init(src, fWidth, fMiterLimit, fResScale, fCap, fJoin, fDoFill);
+        if (SkResourceCache::Find(*key.get(), StrokeRec::Visitor, dst)) {
+            return;
+        }
+    }
+
     // We can always ignore centers for stroke and fill convex line-only paths
     // TODO: remove the line-only restriction
     bool ignoreCenter = fDoFill && (src.getSegmentMasks() == SkPath::kLine_SegmentMask) &&
@@ -1496,6 +1588,12 @@ DONE:
         SkASSERT(!dst->isInverseFillType());
         dst->toggleInverseFillType();
     }
+
+    if (key.isValid()) {
+        SkResourceCache::Add(new StrokeRec(*key.get(), *dst));
+        SkPathPriv::AddGenIDChangeListener(
+                src, sk_make_sp<StrokeInvalidator>(src.getGenerationID()));
+    }
 }
 
 static SkPath::Direction reverse_direction(SkPath::Direction dir) {
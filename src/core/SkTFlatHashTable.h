@@ -0,0 +1,273 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTFlatHashTable_DEFINED
+#define SkTFlatHashTable_DEFINED
+
+#include "SkChecksum.h"
+#include "SkMathPriv.h"
+#include "SkTemplates.h"
+#include "SkTypes.h"
+
+#include <string.h>
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    #include <emmintrin.h>
+#elif defined(SK_ARM_HAS_NEON)
+    #include <arm_neon.h>
+#endif
+
+// A drop-in replacement for SkTHashTable, with the same API and Traits, for hot lookups.
+//
+// Alongside the slots it keeps one control byte per slot: 7 bits of the entry's hash if the slot
+// is full, or a marker for empty and deleted slots.  Slots are probed a group of 16 at a time,
+// comparing all 16 control bytes in one SIMD instruction, so a lookup usually touches a single
+// cache line of control bytes and then compares only the keys whose hash bits match.
+//
+// Unlike SkTHashTable, removing an entry leaves a tombstone, which is cleared on the next resize.
+template <typename T, typename K, typename Traits = T>
+class SkTFlatHashTable {
+public:
+    SkTFlatHashTable() {}
+    SkTFlatHashTable(SkTFlatHashTable&& other)
+        : fCount(other.fCount)
+        , fDeleted(other.fDeleted)
+        , fCapacity(other.fCapacity)
+        , fCtrl(std::move(other.fCtrl))
+        , fSlots(std::move(other.fSlots)) {
+        other.fCount = other.fDeleted = other.fCapacity = 0;
+    }
+
+    SkTFlatHashTable& operator=(SkTFlatHashTable&& other) {
+        if (this != &other) {
+            this->~SkTFlatHashTable();
+            new (this) SkTFlatHashTable(std::move(other));
+        }
+        return *this;
+    }
+
+    // Clear the table.
+    void reset() { *this = SkTFlatHashTable(); }
+
+    // How many entries are in the table?
+    int count() const { return fCount; }
+
+    // Approximately how many bytes of memory do we use beyond sizeof(*this)?
+    size_t approxBytesUsed() const { return fCapacity * (sizeof(T) + 1); }
+
+    // As with SkTHashTable, pointers returned by set() and find() are valid only until the next
+    // call to set(), and entries must not be changed so that their key changes.
+
+    // Copy val into the hash table, returning a pointer to the copy now in the table.
+    // If there already is an entry in the table with the same key, we overwrite it.
+    T* set(T val) {
+        uint32_t hash = Hash(Traits::GetKey(val));
+        if (T* existing = this->find(Traits::GetKey(val), hash)) {
+            *existing = std::move(val);
+            return existing;
+        }
+        if (8 * (fCount + fDeleted + 1) > 7 * fCapacity) {
+            // Grow if we're more than half full of live entries, otherwise just clear tombstones.
+            this->resize(fCapacity == 0                 ? kGroupSize
+                       : 2 * (fCount + 1) > fCapacity ? fCapacity * 2
+                                                      : fCapacity);
+        }
+        return this->uncheckedInsert(std::move(val), hash);
+    }
+
+    // If there is an entry in the table with this key, return a pointer to it.  If not, null.
+    T* find(const K& key) const {
+        return this->find(key, Hash(key));
+    }
+
+    // If there is an entry in the table with this key, return it.  If not, null.
+    // This only works for pointer type T, and cannot be used to find an nullptr entry.
+    T findOrNull(const K& key) const {
+        if (T* p = this->find(key)) {
+            return *p;
+        }
+        return nullptr;
+    }
+
+    // Remove the value with this key from the hash table.
+    void remove(const K& key) {
+        T* found = this->find(key);
+        SkASSERT(found);
+        int index = SkToInt(found - fSlots.get());
+        // If this slot's group still has an empty slot, no probe has ever passed over the group,
+        // so the slot can simply become empty.  Otherwise probes must keep going past it.
+        int groupStart = index & ~(kGroupSize - 1);
+        if (Match(fCtrl.get() + groupStart, kEmpty)) {
+            fCtrl[index] = kEmpty;
+        } else {
+            fCtrl[index] = kDeleted;
+            fDeleted++;
+        }
+        fSlots[index] = T();
+        fCount--;
+    }
+
+    // Call fn on every entry in the table.  You may mutate the entries, but be very careful.
+    template <typename Fn>  // f(T*)
+    void foreach(Fn&& fn) {
+        for (int i = 0; i < fCapacity; i++) {
+            if (IsFull(fCtrl[i])) {
+                fn(&fSlots[i]);
+            }
+        }
+    }
+
+    // Call fn on every entry in the table.  You may not mutate anything.
+    template <typename Fn>  // f(T) or f(const T&)
+    void foreach(Fn&& fn) const {
+        for (int i = 0; i < fCapacity; i++) {
+            if (IsFull(fCtrl[i])) {
+                fn(fSlots[i]);
+            }
+        }
+    }
+
+private:
+    static constexpr int kGroupSize = 16;
+    // Full slots hold the low 7 bits of the hash, so they never have the high bit set.
+    static constexpr uint8_t kEmpty   = 0x80;
+    static constexpr uint8_t kDeleted = 0xFE;
+
+    // Both the group a key starts probing at and its control byte come from its hash, so mix it
+    // in case Traits::Hash() leaves some bits weak.
+    static uint32_t Hash(const K& key) { return SkChecksum::CheapMix(Traits::Hash(key)); }
+
+    static bool IsFull(uint8_t ctrl) { return ctrl < 0x80; }
+    static uint8_t H2(uint32_t hash) { return hash & 0x7F; }
+    static uint32_t H1(uint32_t hash) { return hash >> 7; }
+
+    // Returns a bit for each of the 16 control bytes in the group that equals byte.
+    static uint32_t Match(const uint8_t* group, uint8_t byte) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+        __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)byte)));
+#elif defined(SK_ARM_HAS_NEON)
+        return MoveMask(vceqq_u8(vld1q_u8(group), vdupq_n_u8(byte)));
+#else
+        uint32_t bits = 0;
+        for (int i = 0; i < kGroupSize; i++) {
+            bits |= (uint32_t)(group[i] == byte) << i;
+        }
+        return bits;
+#endif
+    }
+
+    // Returns a bit for each slot in the group that is empty or deleted.
+    static uint32_t MatchFree(const uint8_t* group) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+        return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#elif defined(SK_ARM_HAS_NEON)
+        return MoveMask(vtstq_u8(vld1q_u8(group), vdupq_n_u8(0x80)));
+#else
+        uint32_t bits = 0;
+        for (int i = 0; i < kGroupSize; i++) {
+            bits |= (uint32_t)(group[i] >> 7) << i;
+        }
+        return bits;
+#endif
+    }
+
+#if SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_SSE2 && defined(SK_ARM_HAS_NEON)
+    // NEON has no movemask; weight each all-ones lane by its bit and add up each half.
+    static uint32_t MoveMask(uint8x16_t lanes) {
+        static const uint8_t kBits[16] = { 1, 2, 4, 8, 16, 32, 64, 128,
+                                           1, 2, 4, 8, 16, 32, 64, 128 };
+        uint8x16_t weighted = vandq_u8(lanes, vld1q_u8(kBits));
+        uint8x8_t lo = vget_low_u8(weighted),
+                  hi = vget_high_u8(weighted);
+        lo = vpadd_u8(lo, lo); lo = vpadd_u8(lo, lo); lo = vpadd_u8(lo, lo);
+        hi = vpadd_u8(hi, hi); hi = vpadd_u8(hi, hi); hi = vpadd_u8(hi, hi);
+        return vget_lane_u8(lo, 0) | ((uint32_t)vget_lane_u8(hi, 0) << 8);
+    }
+#endif
+
+    static int LowestBit(uint32_t bits) {
+        SkASSERT(bits);
+        return 31 - SkCLZ(bits & (0u - bits));
+    }
+
+    // Visits groups in triangular order, which reaches every group when the count is a power of 2.
+    T* find(const K& key, uint32_t hash) const {
+        if (fCapacity == 0) {
+            return nullptr;
+        }
+        const int groupMask = fCapacity / kGroupSize - 1;
+        int group = H1(hash) & groupMask;
+        for (int step = 1; step <= groupMask + 1; step++) {
+            const int start = group * kGroupSize;
+            const uint8_t* ctrl = fCtrl.get() + start;
+            for (uint32_t bits = Match(ctrl, H2(hash)); bits; bits &= bits - 1) {
+                T& val = fSlots[start + LowestBit(bits)];
+                if (key == Traits::GetKey(val)) {
+                    return &val;
+                }
+            }
+            if (Match(ctrl, kEmpty)) {
+                return nullptr;
+            }
+            group = (group + step) & groupMask;
+        }
+        return nullptr;
+    }
+
+    T* uncheckedInsert(T&& val, uint32_t hash) {
+        const int groupMask = fCapacity / kGroupSize - 1;
+        int group = H1(hash) & groupMask;
+        for (int step = 1; step <= groupMask + 1; step++) {
+            const int start = group * kGroupSize;
+            if (uint32_t bits = MatchFree(fCtrl.get() + start)) {
+                int index = start + LowestBit(bits);
+                if (fCtrl[index] == kDeleted) {
+                    fDeleted--;
+                }
+                fCtrl[index] = H2(hash);
+                fSlots[index] = std::move(val);
+                fCount++;
+                return &fSlots[index];
+            }
+            group = (group + step) & groupMask;
+        }
+        SkASSERT(false);
+        return nullptr;
+    }
+
+    void resize(int capacity) {
+        SkASSERT(capacity >= kGroupSize && SkIsPow2(capacity));
+        int oldCapacity = fCapacity;
+        SkDEBUGCODE(int oldCount = fCount);
+
+        SkAutoTMalloc<uint8_t> oldCtrl = std::move(fCtrl);
+        SkAutoTArray<T> oldSlots = std::move(fSlots);
+        fCount = fDeleted = 0;
+        fCapacity = capacity;
+        fCtrl.reset(capacity);
+        memset(fCtrl.get(), kEmpty, capacity);
+        fSlots = SkAutoTArray<T>(capacity);
+
+        for (int i = 0; i < oldCapacity; i++) {
+            if (IsFull(oldCtrl[i])) {
+                uint32_t hash = Hash(Traits::GetKey(oldSlots[i]));
+                this->uncheckedInsert(std::move(oldSlots[i]), hash);
+            }
+        }
+        SkASSERT(fCount == oldCount);
+    }
+
+    int fCount = 0, fDeleted = 0, fCapacity = 0;
+    SkAutoTMalloc<uint8_t> fCtrl;
+    SkAutoTArray<T> fSlots;
+
+    SkTFlatHashTable(const SkTFlatHashTable&) = delete;
+    SkTFlatHashTable& operator=(const SkTFlatHashTable&) = delete;
+};
+
+#endif
@@ -6,7 +6,7 @@
  */
 
 #include "SkTypefaceCache.h"
-#include "SkMutex.h"
+#include "SkSharedMutex.h"
 #include <atomic>
 
 #define TYPEFACE_CACHE_LIMIT    1024
@@ -18,13 +18,38 @@ void SkTypefaceCache::add(sk_sp<SkTypeface> face) {
         this->purge(TYPEFACE_CACHE_LIMIT >> 2);
     }
 
-    fTypefaces.emplace_back(std::move(face));
+    fTypefaces.push_back(Rec{std::move(face), 0, false});
+}
+
+void SkTypefaceCache::add(sk_sp<SkTypeface> face, uint32_t hash) {
+    if (fTypefaces.count() >= TYPEFACE_CACHE_LIMIT) {
+        this->purge(TYPEFACE_CACHE_LIMIT >> 2);
+    }
+
+    SkSTArray<1, SkTypeface*, true>* bucket = fHashedTypefaces.find(hash);
+    if (!bucket) {
+        bucket = fHashedTypefaces.set(hash, SkSTArray<1, SkTypeface*, true>());
+    }
+    bucket->push_back(face.get());
+    fTypefaces.push_back(Rec{std::move(face), hash, true});
 }
 
 sk_sp<SkTypeface> SkTypefaceCache::findByProcAndRef(FindProc proc, void* ctx) const {
-    for (const sk_sp<SkTypeface>& typeface : fTypefaces) {
-        if (proc(typeface.get(), ctx)) {
-            return typeface;
+    for (const Rec& rec : fTypefaces) {
+        if (proc(rec.fTypeface.get(), ctx)) {
+            return rec.fTypeface;
+        }
+    }
+    return nullptr;
+}
+
+sk_sp<SkTypeface> SkTypefaceCache::findByHashAndRef(uint32_t hash, FindProc proc,
+                                                    void* ctx) const {
+    if (const SkSTArray<1, SkTypeface*, true>* bucket = fHashedTypefaces.find(hash)) {
+        for (SkTypeface* typeface : *bucket) {
+            if (proc(typeface, ctx)) {
+                return sk_ref_sp(typeface);
+            }
         }
     }
     return nullptr;
@@ -34,7 +59,21 @@ void SkTypefaceCache::purge(int numToPurge) {
     int count = fTypefaces.count();
     int i = 0;
     while (i < count) {
-        if (fTypefaces[i]->unique()) {
+        const Rec& rec = fTypefaces[i];
+        if (rec.fTypeface->unique()) {
+            if (rec.fHashed) {
+                SkSTArray<1, SkTypeface*, true>* bucket = fHashedTypefaces.find(rec.fHash);
+                SkASSERT(bucket);
+                for (int j = 0; j < bucket->count(); ++j) {
+                    if ((*bucket)[j] == rec.fTypeface.get()) {
+                        bucket->removeShuffle(j);
+                        break;
+                    }
+                }
+                if (bucket->empty()) {
+                    fHashedTypefaces.remove(rec.fHash);
+                }
+            }
             fTypefaces.removeShuffle(i);
             --count;
             if (--numToPurge == 0) {
@@ -62,20 +101,35 @@ SkFontID SkTypefaceCache::NewFontID() {
     return nextID++;
 }
 
-SK_DECLARE_STATIC_MUTEX(gMutex);
+// Lookups far outnumber additions, so they only take the lock shared and don't wait on each
+// other, nor on additions queued behind lookups already running.
+static SkSharedMutex& cache_mutex() {
+    static SkSharedMutex* mutex = new SkSharedMutex(SkSharedMutex::Bias::kReaders);
+    return *mutex;
+}
 
 void SkTypefaceCache::Add(sk_sp<SkTypeface> face) {
-    SkAutoMutexAcquire ama(gMutex);
+    SkAutoExclusive lock(cache_mutex());
     Get().add(std::move(face));
 }
 
+void SkTypefaceCache::Add(sk_sp<SkTypeface> face, uint32_t hash) {
+    SkAutoExclusive lock(cache_mutex());
+    Get().add(std::move(face), hash);
+}
+
 sk_sp<SkTypeface> SkTypefaceCache::FindByProcAndRef(FindProc proc, void* ctx) {
-    SkAutoMutexAcquire ama(gMutex);
+    SkAutoSharedMutexShared lock(cache_mutex());
     return Get().findByProcAndRef(proc, ctx);
 }
 
+sk_sp<SkTypeface> SkTypefaceCache::FindByHashAndRef(uint32_t hash, FindProc proc, void* ctx) {
+    SkAutoSharedMutexShared lock(cache_mutex());
+    return Get().findByHashAndRef(hash, proc, ctx);
+}
+
 void SkTypefaceCache::PurgeAll() {
-    SkAutoMutexAcquire ama(gMutex);
+    SkAutoExclusive lock(cache_mutex());
     Get().purgeAll();
 }
 
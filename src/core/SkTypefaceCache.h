@@ -11,6 +11,7 @@
 #define SkTypefaceCache_DEFINED
 
 #include "SkRefCnt.h"
+#include "SkTHash.h"
 #include "SkTypeface.h"
 #include "SkTArray.h"
 
@@ -31,6 +32,12 @@ public:
      */
     void add(sk_sp<SkTypeface>);
 
+    /**
+     *  Add a typeface under a hash of whatever identifies it, so that findByHashAndRef() only
+     *  has to call its proc on the typefaces added with the same hash.
+     */
+    void add(sk_sp<SkTypeface>, uint32_t hash);
+
     /**
      *  Iterate through the cache, calling proc(typeface, ctx) for each typeface.
      *  If proc returns true, then return that typeface.
@@ -38,6 +45,11 @@ public:
      */
     sk_sp<SkTypeface> findByProcAndRef(FindProc proc, void* ctx) const;
 
+    /**
+     *  Like findByProcAndRef(), but only considers the typefaces added with hash.
+     */
+    sk_sp<SkTypeface> findByHashAndRef(uint32_t hash, FindProc proc, void* ctx) const;
+
     /**
      *  This will unref all of the typefaces in the cache for which the cache
      *  is the only owner. Normally this is handled automatically as needed.
@@ -55,7 +67,9 @@ public:
     // These are static wrappers around a global instance of a cache.
 
     static void Add(sk_sp<SkTypeface>);
+    static void Add(sk_sp<SkTypeface>, uint32_t hash);
     static sk_sp<SkTypeface> FindByProcAndRef(FindProc proc, void* ctx);
+    static sk_sp<SkTypeface> FindByHashAndRef(uint32_t hash, FindProc proc, void* ctx);
     static void PurgeAll();
 
     /**
@@ -68,7 +82,15 @@ private:
 
     void purge(int count);
 
-    SkTArray<sk_sp<SkTypeface>> fTypefaces;
+    struct Rec {
+        sk_sp<SkTypeface> fTypeface;
+        uint32_t          fHash;
+        bool              fHashed;
+    };
+
+    SkTArray<Rec> fTypefaces;
+    // The typefaces in fTypefaces that were added with a hash, grouped by that hash.
+    SkTHashMap<uint32_t, SkSTArray<1, SkTypeface*, true>> fHashedTypefaces;
 };
 
 #endif
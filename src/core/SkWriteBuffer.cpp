@@ -10,6 +10,7 @@
 #include "SkBitmap.h"
 #include "SkData.h"
 #include "SkImagePriv.h"
+#include "SkOpts.h"
 #include "SkPaintPriv.h"
 #include "SkPtrRecorder.h"
 #include "SkStream.h"
@@ -222,6 +223,7 @@ void SkBinaryWriteBuffer::writeFlattenable(const SkFlattenable* flattenable) {
     SkFlattenable::Factory factory = flattenable->getFactory();
     SkASSERT(factory);
 
+    size_t start = fWriter.bytesWritten();
     if (fFactorySet) {
         this->write32(fFactorySet->add(factory));
     } else {
@@ -257,4 +259,49 @@ void SkBinaryWriteBuffer::writeFlattenable(const SkFlattenable* flattenable) {
     size_t objSize = fWriter.bytesWritten() - offset;
     // record the obj's size
     fWriter.overwriteTAt(offset - sizeof(uint32_t), SkToU32(objSize));
+
+    if (fDedupFlattenables && fFactorySet) {
+        this->dedupFlattenable(start);
+    }
+}
+
+constexpr uint32_t SkBinaryWriteBuffer::kFlattenableBackReference;
+
+void SkBinaryWriteBuffer::dedupFlattenable(size_t start) {
+    size_t size = fWriter.bytesWritten() - start;
+    // A back reference takes two words, so only larger flattenables are worth sharing.
+    if (size <= 2 * sizeof(uint32_t)) {
+        return;
+    }
+    const uint8_t* bytes = (const uint8_t*)&fWriter.readTAt<uint32_t>(start);
+    uint32_t hash = SkOpts::hash(bytes, size);
+
+    const int* head = fWrittenByHash.find(hash);
+    for (int i = head ? *head : -1; i >= 0; i = fWrittenFlattenables[i].fPrev) {
+        const WrittenFlattenable& written = fWrittenFlattenables[i];
+        if (written.fSize != size ||
+            memcmp(&fWriter.readTAt<uint32_t>(written.fOffset), bytes, size)) {
+            continue;
+        }
+        uint32_t firstOffset = written.fOffset;
+
+        // Forget the flattenables nested inside the copy we're about to drop.
+        while (!fWrittenFlattenables.empty() && fWrittenFlattenables.back().fOffset >= start) {
+            const WrittenFlattenable& nested = fWrittenFlattenables.back();
+            if (nested.fPrev >= 0) {
+                fWrittenByHash.set(nested.fHash, nested.fPrev);
+            } else {
+                fWrittenByHash.remove(nested.fHash);
+            }
+            fWrittenFlattenables.pop_back();
+        }
+
+        fWriter.rewindToOffset(start);
+        this->writeUInt(kFlattenableBackReference);
+        this->writeUInt(firstOffset);
+        return;
+    }
+
+    fWrittenFlattenables.push_back({hash, SkToU32(start), SkToU32(size), head ? *head : -1});
+    fWrittenByHash.set(hash, fWrittenFlattenables.count() - 1);
 }
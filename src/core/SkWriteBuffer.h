@@ -11,6 +11,7 @@
 #include "SkData.h"
 #include "SkFlattenable.h"
 #include "SkSerialProcs.h"
+#include "SkTArray.h"
 #include "SkWriter32.h"
 #include "../private/SkTHash.h"
 
@@ -126,7 +127,21 @@ public:
     void setFactoryRecorder(sk_sp<SkFactorySet>);
     void setTypefaceRecorder(sk_sp<SkRefCntSet>);
 
+    /**
+     *  Only valid with a factory recorder. When enabled, a flattenable whose serialized bytes
+     *  match one already written to this buffer is written as kFlattenableBackReference followed
+     *  by the offset of the first copy. The reader must read the buffer from its start with the
+     *  matching factory playback. SkPicture uses this for its paint and effect buffer.
+     */
+    void setDedupFlattenables(bool dedup) { fDedupFlattenables = dedup; }
+
+    static constexpr uint32_t kFlattenableBackReference = 0xFFFFFFFF;
+
 private:
+    // Looks for an earlier copy of the flattenable just written at offset start, and if there is
+    // one, replaces the new copy with a back reference.
+    void dedupFlattenable(size_t start);
+
     sk_sp<SkFactorySet> fFactorySet;
     sk_sp<SkRefCntSet> fTFSet;
 
@@ -134,6 +149,18 @@ private:
 
     // Only used if we do not have an fFactorySet
     SkTHashMap<SkFlattenable::Factory, uint32_t> fFlattenableDict;
+
+    // Flattenables written so far, when deduping. Entries with the same hash are chained
+    // through fPrev, and fWrittenByHash holds the most recent entry for each hash.
+    struct WrittenFlattenable {
+        uint32_t fHash;
+        uint32_t fOffset;
+        uint32_t fSize;
+        int      fPrev;
+    };
+    bool                               fDedupFlattenables = false;
+    SkTArray<WrittenFlattenable, true> fWrittenFlattenables;
+    SkTHashMap<uint32_t, int>          fWrittenByHash;
 };
 
 #endif // SkWriteBuffer_DEFINED
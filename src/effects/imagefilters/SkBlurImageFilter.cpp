@@ -14,6 +14,7 @@
 #include "SkBitmap.h"
 #include "SkColorData.h"
 #include "SkColorSpaceXformer.h"
+#include "SkExecutor.h"
 #include "SkImageFilterPriv.h"
 #include "SkTFitsIn.h"
 #include "SkGpuBlurUtils.h"
@@ -21,6 +22,7 @@
 #include "SkOpts.h"
 #include "SkReadBuffer.h"
 #include "SkSpecialImage.h"
+#include "SkTaskGroup.h"
 #include "SkWriteBuffer.h"
 
 #if SK_SUPPORT_GPU
@@ -387,6 +389,43 @@ static void blur_one_direction(Sk4u* buffer, int window,
     }
 }
 
+// Lines of a blur are handed to the executor in bands once a pass touches this many pixels.
+static constexpr int64_t kMinParallelPixels = 256 * 256;
+static constexpr int kLinesPerBand = 64;
+
+// Run blur_one_direction over srcH independent lines, splitting them into bands on the executor
+// if the pass is big enough. Each band has its own window buffers, and because every line is
+// blurred on its own the result is the same as blurring all the lines at once.
+static void blur_one_direction_in_bands(SkExecutor* executor, int window,
+                                        int srcLeft, int srcRight, int dstRight,
+                                        const uint32_t* src, int srcXStride, int srcYStride,
+                                        int srcH,
+                                              uint32_t* dst, int dstXStride, int dstYStride) {
+    auto bufferSize = calculate_buffer(window);
+    auto blurLines = [&](int begin, int end) {
+        // The amount 1024 is enough for buffers up to 10 sigma.
+        SkSTArenaAlloc<1024> alloc;
+        Sk4u* buffer = alloc.makeArrayDefault<Sk4u>(bufferSize);
+        blur_one_direction(
+                buffer, window, srcLeft, srcRight, dstRight,
+                src + (int64_t)begin * srcYStride, srcXStride, srcYStride, end - begin,
+                dst + (int64_t)begin * dstYStride, dstXStride, dstYStride);
+    };
+
+    if (executor && srcH > kLinesPerBand &&
+        (int64_t)srcH * dstRight >= kMinParallelPixels) {
+        const int bands = (srcH + kLinesPerBand - 1) / kLinesPerBand;
+        SkTaskGroup taskGroup(*executor);
+        taskGroup.batch(bands, [&](int band) {
+            int begin = band * kLinesPerBand;
+            blurLines(begin, SkTMin(begin + kLinesPerBand, srcH));
+        });
+        taskGroup.wait();
+    } else {
+        blurLines(0, srcH);
+    }
+}
+
 static sk_sp<SkSpecialImage> copy_image_with_bounds(
         SkSpecialImage *source, const sk_sp<SkSpecialImage> &input,
         SkIRect srcBounds, SkIRect dstBounds) {
@@ -456,7 +495,7 @@ static sk_sp<SkSpecialImage> copy_image_with_bounds(
 static sk_sp<SkSpecialImage> cpu_blur(
         SkVector sigma,
         SkSpecialImage *source, const sk_sp<SkSpecialImage> &input,
-        SkIRect srcBounds, SkIRect dstBounds) {
+        SkIRect srcBounds, SkIRect dstBounds, SkExecutor* executor) {
     auto windowW = calculate_window(sigma.x()),
          windowH = calculate_window(sigma.y());
 
@@ -493,14 +532,6 @@ static sk_sp<SkSpecialImage> cpu_blur(
         return nullptr;
     }
 
-    auto bufferSizeW = calculate_buffer(windowW),
-         bufferSizeH = calculate_buffer(windowH);
-
-    // The amount 1024 is enough for buffers up to 10 sigma. The tmp bitmap will be
-    // allocated on the heap.
-    SkSTArenaAlloc<1024> alloc;
-    Sk4u* buffer = alloc.makeArrayDefault<Sk4u>(std::max(bufferSizeW, bufferSizeH));
-
     // Basic Plan: The three cases to handle
     // * Horizontal and Vertical - blur horizontally while copying values from the source to
     //     the destination. Then, do an in-place vertical blur.
@@ -541,16 +572,17 @@ static sk_sp<SkSpecialImage> cpu_blur(
         intermediateWidth = dstW;
         intermediateDst = static_cast<uint32_t *>(dst.getPixels());
 
-        blur_one_direction(
-                buffer, windowW,
+        blur_one_direction_in_bands(
+                executor, windowW,
                 srcBounds.left(), srcBounds.right(), dstBounds.right(),
                 static_cast<uint32_t *>(src.getPixels()), 1, src.rowBytesAsPixels(), srcH,
                 intermediateSrc, 1, intermediateRowBytesAsPixels);
     }
 
     if (windowH > 1) {
-        blur_one_direction(
-                buffer, windowH,
+        // The columns are blurred in place, but each column only reads and writes itself.
+        blur_one_direction_in_bands(
+                executor, windowH,
                 srcBounds.top(), srcBounds.bottom(), dstBounds.bottom(),
                 intermediateSrc, intermediateRowBytesAsPixels, 1, intermediateWidth,
                 intermediateDst, dst.rowBytesAsPixels(), 1);
@@ -607,7 +639,8 @@ sk_sp<SkSpecialImage> SkBlurImageFilterImpl::onFilterImage(SkSpecialImage* sourc
     } else
 #endif
     {
-        result = cpu_blur(sigma, source, input, inputBounds, dstBounds);
+        result = cpu_blur(sigma, source, input, inputBounds, dstBounds,
+                          &SkExecutor::GetDefault());
     }
 
     // Return the resultOffset if the blur succeeded.
@@ -151,7 +151,7 @@ public:
                             const SkPoint3& lightColor) const= 0;
 };
 
-class DiffuseLightingType : public BaseLightingType {
+class DiffuseLightingType final : public BaseLightingType {
 public:
     DiffuseLightingType(SkScalar kd)
         : fKD(kd) {}
@@ -173,7 +173,7 @@ static SkScalar max_component(const SkPoint3& p) {
     return p.x() > p.y() ? (p.x() > p.z() ? p.x() : p.z()) : (p.y() > p.z() ? p.y() : p.z());
 }
 
-class SpecularLightingType : public BaseLightingType {
+class SpecularLightingType final : public BaseLightingType {
 public:
     SpecularLightingType(SkScalar ks, SkScalar shininess)
         : fKS(ks), fShininess(shininess) {}
@@ -280,9 +280,11 @@ public:
     }
 };
 
-template <class PixelFetcher>
-static void lightBitmap(const BaseLightingType& lightingType,
-                 const SkImageFilterLight* l,
+// Templated on the concrete (final) lighting and light types, so that the per-pixel calls to
+// light(), surfaceToLight() and lightColor() are direct and can be inlined.
+template <class LightingType, class LightType, class PixelFetcher>
+static void lightBitmap(const LightingType& lightingType,
+                 const LightType* l,
                  const SkBitmap& src,
                  SkBitmap* dst,
                  SkScalar surfaceScale,
@@ -371,21 +373,6 @@ static void lightBitmap(const BaseLightingType& lightingType,
     }
 }
 
-static void lightBitmap(const BaseLightingType& lightingType,
-                 const SkImageFilterLight* light,
-                 const SkBitmap& src,
-                 SkBitmap* dst,
-                 SkScalar surfaceScale,
-                 const SkIRect& bounds) {
-    if (src.bounds().contains(bounds)) {
-        lightBitmap<UncheckedPixelFetcher>(
-            lightingType, light, src, dst, surfaceScale, bounds);
-    } else {
-        lightBitmap<DecalPixelFetcher>(
-            lightingType, light, src, dst, surfaceScale, bounds);
-    }
-}
-
 enum BoundaryMode {
     kTopLeft_BoundaryMode,
     kTop_BoundaryMode,
@@ -833,7 +820,7 @@ static SkColor xform_color(const SkPoint3& color, SkColorSpaceXformer* xformer)
     return xformer->apply(origColor);
 }
 
-class SkDistantLight : public SkImageFilterLight {
+class SkDistantLight final : public SkImageFilterLight {
 public:
     SkDistantLight(const SkPoint3& direction, SkColor color)
       : INHERITED(color), fDirection(direction) {
@@ -891,7 +878,7 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////
 
-class SkPointLight : public SkImageFilterLight {
+class SkPointLight final : public SkImageFilterLight {
 public:
     SkPointLight(const SkPoint3& location, SkColor color)
      : INHERITED(color), fLocation(location) {}
@@ -958,7 +945,7 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////
 
-class SkSpotLight : public SkImageFilterLight {
+class SkSpotLight final : public SkImageFilterLight {
 public:
     SkSpotLight(const SkPoint3& location,
                 const SkPoint3& target,
@@ -1116,6 +1103,45 @@ private:
     typedef SkImageFilterLight INHERITED;
 };
 
+template <class LightingType, class LightType>
+static void lightBitmap(const LightingType& lightingType,
+                        const LightType* light,
+                        const SkBitmap& src,
+                        SkBitmap* dst,
+                        SkScalar surfaceScale,
+                        const SkIRect& bounds) {
+    if (src.bounds().contains(bounds)) {
+        lightBitmap<LightingType, LightType, UncheckedPixelFetcher>(
+            lightingType, light, src, dst, surfaceScale, bounds);
+    } else {
+        lightBitmap<LightingType, LightType, DecalPixelFetcher>(
+            lightingType, light, src, dst, surfaceScale, bounds);
+    }
+}
+
+template <class LightingType>
+static void lightBitmap(const LightingType& lightingType,
+                        const SkImageFilterLight* light,
+                        const SkBitmap& src,
+                        SkBitmap* dst,
+                        SkScalar surfaceScale,
+                        const SkIRect& bounds) {
+    switch (light->type()) {
+        case SkImageFilterLight::kDistant_LightType:
+            lightBitmap(lightingType, static_cast<const SkDistantLight*>(light),
+                        src, dst, surfaceScale, bounds);
+            break;
+        case SkImageFilterLight::kPoint_LightType:
+            lightBitmap(lightingType, static_cast<const SkPointLight*>(light),
+                        src, dst, surfaceScale, bounds);
+            break;
+        case SkImageFilterLight::kSpot_LightType:
+            lightBitmap(lightingType, static_cast<const SkSpotLight*>(light),
+                        src, dst, surfaceScale, bounds);
+            break;
+    }
+}
+
 // According to the spec, the specular term should be in the range [1, 128] :
 // http://www.w3.org/TR/SVG/filters.html#feSpecularLightingSpecularExponentAttribute
 const SkScalar SkSpotLight::kSpecularExponentMin = 1.0f;
@@ -10,6 +10,7 @@
 #include "SkColorData.h"
 #include "SkColorSpaceXformer.h"
 #include "SkImageFilterPriv.h"
+#include "SkNx.h"
 #include "SkReadBuffer.h"
 #include "SkSpecialImage.h"
 #include "SkWriteBuffer.h"
@@ -185,7 +186,8 @@ void SkMatrixConvolutionImageFilter::filterPixels(const SkBitmap& src,
     for (int y = rect.fTop; y < rect.fBottom; ++y) {
         SkPMColor* dptr = result->getAddr32(rect.fLeft - offset.fX, y - offset.fY);
         for (int x = rect.fLeft; x < rect.fRight; ++x) {
-            SkScalar sumA = 0, sumR = 0, sumG = 0, sumB = 0;
+            // All four channels are summed at once, in the byte order of SkPMColor.
+            Sk4f sum(0);
             for (int cy = 0; cy < fKernelSize.fHeight; cy++) {
                 for (int cx = 0; cx < fKernelSize.fWidth; cx++) {
                     SkPMColor s = PixelFetcher::fetch(src,
@@ -193,14 +195,13 @@ void SkMatrixConvolutionImageFilter::filterPixels(const SkBitmap& src,
                                                       y + cy - fKernelOffset.fY,
                                                       bounds);
                     SkScalar k = fKernel[cy * fKernelSize.fWidth + cx];
-                    if (convolveAlpha) {
-                        sumA += SkGetPackedA32(s) * k;
-                    }
-                    sumR += SkGetPackedR32(s) * k;
-                    sumG += SkGetPackedG32(s) * k;
-                    sumB += SkGetPackedB32(s) * k;
+                    sum = sum + SkNx_cast<float>(Sk4b::Load(&s)) * k;
                 }
             }
+            SkScalar sumA = sum[SK_A32_SHIFT / 8],
+                     sumR = sum[SK_R32_SHIFT / 8],
+                     sumG = sum[SK_G32_SHIFT / 8],
+                     sumB = sum[SK_B32_SHIFT / 8];
             int a = convolveAlpha
                   ? SkClampMax(SkScalarFloorToInt(sumA * fGain + fBias), 255)
                   : 255;
@@ -14,6 +14,7 @@
 #include "SkReadBuffer.h"
 #include "SkRect.h"
 #include "SkSpecialImage.h"
+#include "SkTemplates.h"
 #include "SkWriteBuffer.h"
 
 #if SK_SUPPORT_GPU
@@ -642,6 +643,107 @@ namespace {
         }
     }
 #endif
+
+    // The per-channel maximum (dilate) or minimum (erode) of two pixels.
+    template<MorphType type>
+    static inline SkPMColor extreme(SkPMColor a, SkPMColor b) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+        __m128i va = _mm_cvtsi32_si128(a),
+                vb = _mm_cvtsi32_si128(b);
+        return _mm_cvtsi128_si32(type == kDilate ? _mm_max_epu8(va, vb) : _mm_min_epu8(va, vb));
+#elif defined(SK_ARM_HAS_NEON)
+        uint8x8_t va = vreinterpret_u8_u32(vdup_n_u32(a)),
+                  vb = vreinterpret_u8_u32(vdup_n_u32(b));
+        return vget_lane_u32(vreinterpret_u32_u8(type == kDilate ? vmax_u8(va, vb)
+                                                                 : vmin_u8(va, vb)), 0);
+#else
+        auto op = [](int x, int y) { return type == kDilate ? SkTMax(x, y) : SkTMin(x, y); };
+        return SkPackARGB32(op(SkGetPackedA32(a), SkGetPackedA32(b)),
+                            op(SkGetPackedR32(a), SkGetPackedR32(b)),
+                            op(SkGetPackedG32(a), SkGetPackedG32(b)),
+                            op(SkGetPackedB32(a), SkGetPackedB32(b)));
+#endif
+    }
+
+    // Vertically, below this radius the direct loops in morph() beat the bookkeeping of
+    // morph_van_herk(). Horizontally morph() walks down columns, so it never wins.
+    static constexpr int kMinVanHerkRadiusY = 2;
+
+    // The van Herk/Gil-Werman algorithm, which takes three extreme() calls per pixel whatever
+    // the radius. Each line, padded by radius identity pixels at each end, is split into blocks
+    // of the window size 2 * radius + 1. A running extreme from the start of each block (prefix)
+    // and one from its end (suffix) are computed. A window is either a whole block or straddles
+    // one block boundary, so it is always suffix[start] combined with prefix[start + 2 * radius].
+    //
+    // Vertical lines are processed 16 at a time, so that their pixels are read a row at a time.
+    template<MorphType type, MorphDirection direction>
+    static void morph_van_herk(const SkPMColor* src, SkPMColor* dst,
+                               int radius, int width, int height, int srcStride, int dstStride) {
+        const int srcStrideX = direction == MorphDirection::kX ? 1 : srcStride;
+        const int dstStrideX = direction == MorphDirection::kX ? 1 : dstStride;
+        const int srcStrideY = direction == MorphDirection::kX ? srcStride : 1;
+        const int dstStrideY = direction == MorphDirection::kX ? dstStride : 1;
+        constexpr int kLines = direction == MorphDirection::kX ? 1 : 16;
+        const SkPMColor identity = type == kDilate ? 0 : 0xFFFFFFFF;
+
+        radius = SkMin32(radius, width - 1);
+        const int window = 2 * radius + 1;
+        const int paddedWidth = width + 2 * radius;
+        SkAutoTMalloc<SkPMColor> prefix(paddedWidth * kLines),
+                                 suffix(paddedWidth * kLines);
+
+        for (int y = 0; y < height; y += kLines) {
+            const int lines = SkTMin(kLines, height - y);
+            const SkPMColor* lineSrc = src + y * srcStrideY;
+            SkPMColor* lineDst = dst + y * dstStrideY;
+            auto srcPixel = [=](int i, int j) {
+                int x = i - radius;
+                return 0 <= x && x < width ? lineSrc[x * srcStrideX + j * srcStrideY] : identity;
+            };
+
+            for (int i = 0; i < paddedWidth; ++i) {
+                SkPMColor* p = &prefix[i * kLines];
+                if (0 == i % window) {
+                    for (int j = 0; j < lines; ++j) {
+                        p[j] = srcPixel(i, j);
+                    }
+                } else {
+                    for (int j = 0; j < lines; ++j) {
+                        p[j] = extreme<type>(p[j - kLines], srcPixel(i, j));
+                    }
+                }
+            }
+            for (int i = paddedWidth - 1; i >= 0; --i) {
+                SkPMColor* s = &suffix[i * kLines];
+                if (window - 1 == i % window || paddedWidth - 1 == i) {
+                    for (int j = 0; j < lines; ++j) {
+                        s[j] = srcPixel(i, j);
+                    }
+                } else {
+                    for (int j = 0; j < lines; ++j) {
+                        s[j] = extreme<type>(s[j + kLines], srcPixel(i, j));
+                    }
+                }
+            }
+            for (int x = 0; x < width; ++x) {
+                const SkPMColor* s = &suffix[x * kLines];
+                const SkPMColor* p = &prefix[(x + 2 * radius) * kLines];
+                for (int j = 0; j < lines; ++j) {
+                    lineDst[x * dstStrideX + j * dstStrideY] = extreme<type>(s[j], p[j]);
+                }
+            }
+        }
+    }
+
+    template<MorphType type, MorphDirection direction>
+    static void morph_any_radius(const SkPMColor* src, SkPMColor* dst,
+                                 int radius, int width, int height, int srcStride, int dstStride) {
+        if (direction == MorphDirection::kY && radius < kMinVanHerkRadiusY) {
+            morph<type, direction>(src, dst, radius, width, height, srcStride, dstStride);
+        } else {
+            morph_van_herk<type, direction>(src, dst, radius, width, height, srcStride, dstStride);
+        }
+    }
 }  // namespace
 
 sk_sp<SkSpecialImage> SkMorphologyImageFilter::onFilterImage(SkSpecialImage* source,
@@ -722,11 +824,11 @@ sk_sp<SkSpecialImage> SkMorphologyImageFilter::onFilterImage(SkSpecialImage* sou
     SkMorphologyImageFilter::Proc procX, procY;
 
     if (kDilate_Op == this->op()) {
-        procX = &morph<kDilate, MorphDirection::kX>;
-        procY = &morph<kDilate, MorphDirection::kY>;
+        procX = &morph_any_radius<kDilate, MorphDirection::kX>;
+        procY = &morph_any_radius<kDilate, MorphDirection::kY>;
     } else {
-        procX = &morph<kErode,  MorphDirection::kX>;
-        procY = &morph<kErode,  MorphDirection::kY>;
+        procX = &morph_any_radius<kErode,  MorphDirection::kX>;
+        procY = &morph_any_radius<kErode,  MorphDirection::kY>;
     }
 
     if (width > 0 && height > 0) {
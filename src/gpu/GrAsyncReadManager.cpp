@@ -0,0 +1,63 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrAsyncReadManager.h"
+
+#include "GrCaps.h"
+#include "GrGpu.h"
+
+GrAsyncReadManager::~GrAsyncReadManager() {
+    // The GrGpu fails everything on disconnect, so only a clean teardown gets here with reads.
+    this->failAll(false);
+}
+
+void GrAsyncReadManager::add(sk_sp<GrGpuBuffer> buffer, size_t rowBytes,
+                             SkSurface::ReadPixelsCallback callback,
+                             SkSurface::ReadPixelsContext context) {
+    SkASSERT(buffer && callback);
+    SkASSERT(fGpu->caps()->fenceSyncSupport());
+    // The fence has to come after the transfer on the queue, which needs the transfer submitted.
+    fGpu->finishFlush(nullptr, SkSurface::BackendSurfaceAccess::kNoAccess, kNone_GrFlushFlags, 0,
+                      nullptr, nullptr, nullptr);
+    GrFence fence = fGpu->insertFence();
+    fPending.push_back({std::move(buffer), fence, rowBytes, callback, context});
+}
+
+void GrAsyncReadManager::check(bool waitForAll) {
+    if (fChecking) {
+        return;
+    }
+    fChecking = true;
+    while (!fPending.empty()) {
+        // Waiting with a timeout of zero polls the fence.
+        bool passed = fGpu->waitFence(fPending.front().fFence, waitForAll ? ~0ULL : 0);
+        if (!passed && !waitForAll) {
+            break;
+        }
+        Read read = std::move(fPending.front());
+        fPending.pop_front();
+        fGpu->deleteFence(read.fFence);
+        // If an unbounded wait failed the GPU is gone, so report the read as failed.
+        const void* pixels = passed ? read.fBuffer->map() : nullptr;
+        read.fCallback(read.fContext, pixels, pixels ? read.fRowBytes : 0);
+        if (pixels) {
+            read.fBuffer->unmap();
+        }
+    }
+    fChecking = false;
+}
+
+void GrAsyncReadManager::failAll(bool abandoned) {
+    while (!fPending.empty()) {
+        Read read = std::move(fPending.front());
+        fPending.pop_front();
+        if (!abandoned) {
+            fGpu->deleteFence(read.fFence);
+        }
+        read.fCallback(read.fContext, nullptr, 0);
+    }
+}
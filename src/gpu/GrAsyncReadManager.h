@@ -0,0 +1,65 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrAsyncReadManager_DEFINED
+#define GrAsyncReadManager_DEFINED
+
+#include "GrGpuBuffer.h"
+#include "GrTypesPriv.h"
+#include "SkSurface.h"
+
+#include <deque>
+
+class GrGpu;
+
+/**
+ * Owns the transfer buffers of asynchronous pixel reads until the GPU has written them. Each read
+ * is submitted with a fence after it, and its callback gets the mapped buffer once the fence has
+ * passed. Fences pass in submission order, so reads complete in the order they were added.
+ */
+class GrAsyncReadManager {
+public:
+    explicit GrAsyncReadManager(GrGpu* gpu) : fGpu(gpu) {}
+    ~GrAsyncReadManager();
+
+    /**
+     * Submits the GPU work recorded so far, which must include the transfer into 'buffer', and
+     * fences it. 'buffer' holds tightly packed rows of 'rowBytes' each.
+     */
+    void add(sk_sp<GrGpuBuffer> buffer, size_t rowBytes, SkSurface::ReadPixelsCallback callback,
+             SkSurface::ReadPixelsContext context);
+
+    /**
+     * Calls back the reads whose fences have passed. If 'waitForAll' is true, blocks until every
+     * outstanding read has completed.
+     */
+    void check(bool waitForAll);
+
+    /**
+     * Calls back every outstanding read with null pixels. When the context is abandoned the
+     * fences are forgotten rather than deleted.
+     */
+    void failAll(bool abandoned);
+
+    int count() const { return SkToInt(fPending.size()); }
+
+private:
+    struct Read {
+        sk_sp<GrGpuBuffer>              fBuffer;
+        GrFence                         fFence;
+        size_t                          fRowBytes;
+        SkSurface::ReadPixelsCallback   fCallback;
+        SkSurface::ReadPixelsContext    fContext;
+    };
+
+    GrGpu*           fGpu;
+    std::deque<Read> fPending;
+    // Callbacks may start new reads, which flush and check again.
+    bool             fChecking = false;
+};
+
+#endif
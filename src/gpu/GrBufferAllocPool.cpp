@@ -18,6 +18,8 @@
 #include "SkSafeMath.h"
 #include "SkTraceEvent.h"
 
+#include <limits>
+
 sk_sp<GrBufferAllocPool::CpuBufferCache> GrBufferAllocPool::CpuBufferCache::Make(
         int maxBuffersToCache) {
     return sk_sp<CpuBufferCache>(new CpuBufferCache(maxBuffersToCache));
@@ -68,6 +70,86 @@ void GrBufferAllocPool::CpuBufferCache::releaseAll() {
 
 //////////////////////////////////////////////////////////////////////////////
 
+constexpr int GrBufferAllocPool::PersistentBufferRing::kFrameCount;
+constexpr int GrBufferAllocPool::PersistentBufferRing::kMaxFreeBuffers;
+
+sk_sp<GrBufferAllocPool::PersistentBufferRing> GrBufferAllocPool::PersistentBufferRing::Make(
+        GrGpu* gpu) {
+    if (!gpu->caps()->persistentlyMappedBufferSupport()) {
+        return nullptr;
+    }
+    return sk_sp<PersistentBufferRing>(new PersistentBufferRing(gpu));
+}
+
+GrBufferAllocPool::PersistentBufferRing::~PersistentBufferRing() {
+    for (Frame& frame : fFrames) {
+        if (frame.fFence) {
+            fGpu->deleteFence(frame.fFence);
+        }
+    }
+}
+
+sk_sp<GrGpuBuffer> GrBufferAllocPool::PersistentBufferRing::makeBuffer(GrGpuBufferType type,
+                                                                       size_t size) {
+    Buffer buffer;
+    for (int i = 0; i < fFreeBuffers.count(); ++i) {
+        if (fFreeBuffers[i].fType == type && fFreeBuffers[i].fBuffer->size() >= size) {
+            buffer = std::move(fFreeBuffers[i]);
+            fFreeBuffers.removeShuffle(i);
+            break;
+        }
+    }
+    if (!buffer.fBuffer) {
+        auto resourceProvider = fGpu->getContext()->priv().resourceProvider();
+        buffer.fBuffer = resourceProvider->createBuffer(size, type,
+                                                        kPersistentlyMapped_GrAccessPattern);
+        if (!buffer.fBuffer) {
+            return nullptr;
+        }
+        buffer.fType = type;
+    }
+    sk_sp<GrGpuBuffer> result = buffer.fBuffer;
+    fFrames[fCurrFrame].fBuffers.push_back(std::move(buffer));
+    return result;
+}
+
+void GrBufferAllocPool::PersistentBufferRing::endFlush() {
+    Frame* frame = &fFrames[fCurrFrame];
+    SkASSERT(!frame->fFence);
+    if (frame->fBuffers.empty()) {
+        // Nothing to protect, so there's no need to move on to the next frame.
+        return;
+    }
+    frame->fFence = fGpu->insertFence();
+
+    fCurrFrame = (fCurrFrame + 1) % kFrameCount;
+    frame = &fFrames[fCurrFrame];
+    if (!frame->fFence) {
+        return;
+    }
+    // This is the frame from kFrameCount flushes ago, so the wait should rarely block. If it
+    // fails we can't tell whether the GPU is done with the buffers, so they aren't reused.
+    bool signaled = fGpu->waitFence(frame->fFence, std::numeric_limits<uint64_t>::max());
+    fGpu->deleteFence(frame->fFence);
+    frame->fFence = 0;
+    for (Buffer& buffer : frame->fBuffers) {
+        if (signaled && fFreeBuffers.count() < kMaxFreeBuffers) {
+            fFreeBuffers.push_back(std::move(buffer));
+        }
+    }
+    frame->fBuffers.reset();
+}
+
+void GrBufferAllocPool::PersistentBufferRing::abandon() {
+    for (Frame& frame : fFrames) {
+        frame.fFence = 0;
+        frame.fBuffers.reset();
+    }
+    fFreeBuffers.reset();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 #ifdef SK_DEBUG
     #define VALIDATE validate
 #else
@@ -86,9 +168,11 @@ void GrBufferAllocPool::CpuBufferCache::releaseAll() {
 constexpr size_t GrBufferAllocPool::kDefaultBufferSize;
 
 GrBufferAllocPool::GrBufferAllocPool(GrGpu* gpu, GrGpuBufferType bufferType,
-                                     sk_sp<CpuBufferCache> cpuBufferCache)
+                                     sk_sp<CpuBufferCache> cpuBufferCache,
+                                     sk_sp<PersistentBufferRing> bufferRing)
         : fBlocks(8)
         , fCpuBufferCache(std::move(cpuBufferCache))
+        , fBufferRing(std::move(bufferRing))
         , fGpu(gpu)
         , fBufferType(bufferType) {}
 
@@ -354,16 +438,18 @@ bool GrBufferAllocPool::createBlock(size_t requestSize) {
 
     SkASSERT(!fBufferPtr);
 
-    // If the buffer is CPU-backed we "map" it because it is free to do so and saves a copy.
-    // Otherwise when buffer mapping is supported we map if the buffer size is greater than the
-    // threshold.
+    // If the buffer is CPU-backed or persistently mapped we "map" it because it is free to do so
+    // and saves a copy. Otherwise when buffer mapping is supported we map if the buffer size is
+    // greater than the threshold.
     if (block.fBuffer->isCpuBuffer()) {
         fBufferPtr = static_cast<GrCpuBuffer*>(block.fBuffer.get())->data();
         SkASSERT(fBufferPtr);
     } else {
-        if (GrCaps::kNone_MapFlags != fGpu->caps()->mapBufferFlags() &&
-            size > fGpu->caps()->bufferMapThreshold()) {
-            fBufferPtr = static_cast<GrGpuBuffer*>(block.fBuffer.get())->map();
+        GrGpuBuffer* buffer = static_cast<GrGpuBuffer*>(block.fBuffer.get());
+        if (kPersistentlyMapped_GrAccessPattern == buffer->accessPattern() ||
+            (GrCaps::kNone_MapFlags != fGpu->caps()->mapBufferFlags() &&
+             size > fGpu->caps()->bufferMapThreshold())) {
+            fBufferPtr = buffer->map();
         }
     }
     if (!fBufferPtr) {
@@ -428,13 +514,20 @@ sk_sp<GrBuffer> GrBufferAllocPool::getBuffer(size_t size) {
         return fCpuBufferCache ? fCpuBufferCache->makeBuffer(size, mustInitialize)
                                : GrCpuBuffer::Make(size);
     }
+    if (fBufferRing) {
+        if (auto buffer = fBufferRing->makeBuffer(fBufferType, size)) {
+            return std::move(buffer);
+        }
+    }
     return resourceProvider->createBuffer(size, fBufferType, kDynamic_GrAccessPattern);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-GrVertexBufferAllocPool::GrVertexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache)
-        : GrBufferAllocPool(gpu, GrGpuBufferType::kVertex, std::move(cpuBufferCache)) {}
+GrVertexBufferAllocPool::GrVertexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache,
+                                                 sk_sp<PersistentBufferRing> bufferRing)
+        : GrBufferAllocPool(gpu, GrGpuBufferType::kVertex, std::move(cpuBufferCache),
+                            std::move(bufferRing)) {}
 
 void* GrVertexBufferAllocPool::makeSpace(size_t vertexSize,
                                          int vertexCount,
@@ -486,8 +579,10 @@ void* GrVertexBufferAllocPool::makeSpaceAtLeast(size_t vertexSize, int minVertex
 
 ////////////////////////////////////////////////////////////////////////////////
 
-GrIndexBufferAllocPool::GrIndexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache)
-        : GrBufferAllocPool(gpu, GrGpuBufferType::kIndex, std::move(cpuBufferCache)) {}
+GrIndexBufferAllocPool::GrIndexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache,
+                                               sk_sp<PersistentBufferRing> bufferRing)
+        : GrBufferAllocPool(gpu, GrGpuBufferType::kIndex, std::move(cpuBufferCache),
+                            std::move(bufferRing)) {}
 
 void* GrIndexBufferAllocPool::makeSpace(int indexCount, sk_sp<const GrBuffer>* buffer,
                                         int* startIndex) {
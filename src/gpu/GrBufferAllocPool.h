@@ -17,6 +17,7 @@
 #include "SkTypes.h"
 
 class GrGpu;
+class GrGpuBuffer;
 
 /**
  * A pool of geometry buffers tied to a GrGpu.
@@ -56,6 +57,52 @@ public:
         int fMaxBuffersToCache = 0;
     };
 
+    /**
+     * A set of persistently mapped GPU buffers that can be shared by the pools of successive
+     * flushes. Writing to them needs no map, unmap or copy, so they are used in place of new
+     * buffers when the backend supports them (GrCaps::persistentlyMappedBufferSupport()).
+     *
+     * Buffers handed out during a flush are held until endFlush() is called after the flush's
+     * work has been submitted. That inserts a fence, and the buffers are only handed out again
+     * once the ring has cycled through kFrameCount flushes and that fence has signaled.
+     */
+    class PersistentBufferRing : public GrNonAtomicRef<PersistentBufferRing> {
+    public:
+        static constexpr int kFrameCount = 3;
+
+        /** Returns nullptr if the GrGpu can't make persistently mapped buffers. */
+        static sk_sp<PersistentBufferRing> Make(GrGpu*);
+
+        ~PersistentBufferRing();
+
+        sk_sp<GrGpuBuffer> makeBuffer(GrGpuBufferType, size_t size);
+
+        /** Marks the end of the buffers' use by the current flush. */
+        void endFlush();
+
+        /** Forgets the fences without deleting them and drops all the buffers. */
+        void abandon();
+
+    private:
+        static constexpr int kMaxFreeBuffers = 8;
+
+        PersistentBufferRing(GrGpu* gpu) : fGpu(gpu) {}
+
+        struct Buffer {
+            sk_sp<GrGpuBuffer> fBuffer;
+            GrGpuBufferType fType;
+        };
+        struct Frame {
+            SkTArray<Buffer> fBuffers;
+            GrFence fFence = 0;
+        };
+
+        GrGpu* fGpu;
+        Frame fFrames[kFrameCount];
+        int fCurrFrame = 0;
+        SkTArray<Buffer> fFreeBuffers;
+    };
+
     /**
      * Ensures all buffers are unmapped and have all data written to them.
      * Call before drawing using buffers from the pool.
@@ -81,8 +128,10 @@ protected:
      * @param cpuBufferCache        If non-null a cache for client side array buffers
      *                              or staging buffers used before data is uploaded to
      *                              GPU buffer objects.
+     * @param bufferRing            If non-null the source of persistently mapped buffers.
      */
-    GrBufferAllocPool(GrGpu* gpu, GrGpuBufferType bufferType, sk_sp<CpuBufferCache> cpuBufferCache);
+    GrBufferAllocPool(GrGpu* gpu, GrGpuBufferType bufferType, sk_sp<CpuBufferCache> cpuBufferCache,
+                      sk_sp<PersistentBufferRing> bufferRing = nullptr);
 
     virtual ~GrBufferAllocPool();
 
@@ -159,6 +208,7 @@ private:
 
     SkTArray<BufferBlock> fBlocks;
     sk_sp<CpuBufferCache> fCpuBufferCache;
+    sk_sp<PersistentBufferRing> fBufferRing;
     sk_sp<GrCpuBuffer> fCpuStagingBuffer;
     GrGpu* fGpu;
     GrGpuBufferType fBufferType;
@@ -177,8 +227,10 @@ public:
      * @param cpuBufferCache        If non-null a cache for client side array buffers
      *                              or staging buffers used before data is uploaded to
      *                              GPU buffer objects.
+     * @param bufferRing            If non-null the source of persistently mapped buffers.
      */
-    GrVertexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache);
+    GrVertexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache,
+                          sk_sp<PersistentBufferRing> bufferRing = nullptr);
 
     /**
      * Returns a block of memory to hold vertices. A buffer designated to hold
@@ -256,8 +308,10 @@ public:
      * @param cpuBufferCache        If non-null a cache for client side array buffers
      *                              or staging buffers used before data is uploaded to
      *                              GPU buffer objects.
+     * @param bufferRing            If non-null the source of persistently mapped buffers.
      */
-    GrIndexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache);
+    GrIndexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache,
+                         sk_sp<PersistentBufferRing> bufferRing = nullptr);
 
     /**
      * Returns a block of memory to hold indices. A buffer designated to hold
@@ -31,13 +31,16 @@ GrCaps::GrCaps(const GrContextOptions& options) {
     fUsesMixedSamples = false;
     fUsePrimitiveRestart = false;
     fPreferClientSideDynamicBuffers = false;
+    fPersistentlyMappedBufferSupport = false;
     fPreferFullscreenClears = false;
     fMustClearUploadedBufferData = false;
     fSupportsAHardwareBufferImages = false;
     fFenceSyncSupport = false;
     fCrossContextTextureSupport = false;
+    fTimestampQuerySupport = false;
     fHalfFloatVertexAttributeSupport = false;
     fDynamicStateArrayGeometryProcessorTextureSupport = false;
+    fImageMultitexturingSupport = false;
     fPerformPartialClearsAsDraws = false;
     fPerformColorClearsAsDraws = false;
     fPerformStencilClearsAsDraws = false;
@@ -118,6 +121,8 @@ void GrCaps::applyOptionsOverrides(const GrContextOptions& options) {
         fMaxWindowRectangles = GrWindowRectangles::kMaxWindows;
     }
     fAvoidStencilBuffers = options.fAvoidStencilBuffers;
+    fImageMultitexturingSupport = !options.fDisableImageMultitexturing &&
+                                  fShaderCaps->maxFragmentSamplers() > 1;
 
     fDriverBugWorkarounds.applyOverrides(options.fDriverBugWorkarounds);
 }
@@ -150,6 +155,7 @@ static const char* pixel_config_name(GrPixelConfig config) {
         case kRGBA_half_GrPixelConfig: return "RGBAHalf";
         case kRGBA_half_Clamped_GrPixelConfig: return "RGBAHalfClamped";
         case kRGB_ETC1_GrPixelConfig: return "RGBETC1";
+        case kRGB_BC1_GrPixelConfig: return "RGBBC1";
     }
     SK_ABORT("Invalid pixel config");
     return "<invalid>";
@@ -194,14 +200,17 @@ void GrCaps::dumpJSON(SkJSONWriter* writer) const {
     writer->appendBool("Uses Mixed Samples", fUsesMixedSamples);
     writer->appendBool("Use primitive restart", fUsePrimitiveRestart);
     writer->appendBool("Prefer client-side dynamic buffers", fPreferClientSideDynamicBuffers);
+    writer->appendBool("Persistently mapped buffer support", fPersistentlyMappedBufferSupport);
     writer->appendBool("Prefer fullscreen clears", fPreferFullscreenClears);
     writer->appendBool("Must clear buffer memory", fMustClearUploadedBufferData);
     writer->appendBool("Supports importing AHardwareBuffers", fSupportsAHardwareBufferImages);
     writer->appendBool("Fence sync support", fFenceSyncSupport);
     writer->appendBool("Cross context texture support", fCrossContextTextureSupport);
+    writer->appendBool("Timestamp query support", fTimestampQuerySupport);
     writer->appendBool("Half float vertex attribute support", fHalfFloatVertexAttributeSupport);
     writer->appendBool("Specify GeometryProcessor textures as a dynamic state array",
                        fDynamicStateArrayGeometryProcessorTextureSupport);
+    writer->appendBool("Image multitexturing support", fImageMultitexturingSupport);
     writer->appendBool("Use draws for partial clears", fPerformPartialClearsAsDraws);
     writer->appendBool("Use draws for color clears", fPerformColorClearsAsDraws);
     writer->appendBool("Use draws for stencil clip clears", fPerformStencilClearsAsDraws);
@@ -67,6 +67,11 @@ public:
 
     bool preferClientSideDynamicBuffers() const { return fPreferClientSideDynamicBuffers; }
 
+    // Can buffers be created with kPersistentlyMapped_GrAccessPattern? Such buffers stay mapped
+    // for their whole lifetime and writes are visible to the GPU without unmapping, so the client
+    // has to use fences to avoid overwriting data the GPU hasn't read yet.
+    bool persistentlyMappedBufferSupport() const { return fPersistentlyMappedBufferSupport; }
+
     // On tilers, an initial fullscreen clear is an OPTIMIZATION. It allows the hardware to
     // initialize each tile with a constant value rather than loading each pixel from memory.
     bool preferFullscreenClears() const { return fPreferFullscreenClears; }
@@ -241,6 +246,12 @@ public:
 
     bool fenceSyncSupport() const { return fFenceSyncSupport; }
     bool crossContextTextureSupport() const { return fCrossContextTextureSupport; }
+
+    /**
+     * Can the GrGpu record GPU timestamps between the commands it issues? This is what
+     * GrContext::setOpTimingEnabled() needs.
+     */
+    bool timestampQuerySupport() const { return fTimestampQuerySupport; }
     /**
      * Returns whether or not we will be able to do a copy given the passed in params
      */
@@ -251,6 +262,10 @@ public:
         return fDynamicStateArrayGeometryProcessorTextureSupport;
     }
 
+    // Can GrTextureOp sample from several textures in a single draw, picking one per quad with a
+    // vertex attribute? This lets it batch draws of distinct images into one mesh.
+    bool imageMultitexturingSupport() const { return fImageMultitexturingSupport; }
+
     // Not all backends support clearing with a scissor test (e.g. Metal), this will always
     // return true if performColorClearsAsDraws() returns true.
     bool performPartialClearsAsDraws() const {
@@ -341,6 +356,7 @@ protected:
     bool fUsesMixedSamples                           : 1;
     bool fUsePrimitiveRestart                        : 1;
     bool fPreferClientSideDynamicBuffers             : 1;
+    bool fPersistentlyMappedBufferSupport            : 1;
     bool fPreferFullscreenClears                     : 1;
     bool fMustClearUploadedBufferData                : 1;
     bool fSupportsAHardwareBufferImages              : 1;
@@ -364,9 +380,14 @@ protected:
     // Requires fence sync support in GL.
     bool fCrossContextTextureSupport                 : 1;
 
+    bool fTimestampQuerySupport                      : 1;
+
     // Not (yet) implemented in VK backend.
     bool fDynamicStateArrayGeometryProcessorTextureSupport : 1;
 
+    // Set from the shader caps and GrContextOptions in applyOptionsOverrides().
+    bool fImageMultitexturingSupport                 : 1;
+
     BlendEquationSupport fBlendEquationSupport;
     uint32_t fAdvBlendEqBlacklist;
     GR_STATIC_ASSERT(kLast_GrBlendEquation < 32);
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrCompressedImageCache.h"
+
+#include "SkAutoMalloc.h"
+#include "SkAutoPixmapStorage.h"
+#include "SkBitmap.h"
+#include "SkTraceEvent.h"
+#include "etc1.h"
+
+GrCompressedImageCache::~GrCompressedImageCache() {
+    this->purgeAll();
+}
+
+void GrCompressedImageCache::encodeAndAdd(const GrUniqueKey& key, const SkBitmap& bitmap) {
+    TRACE_EVENT0("skia.gpu", TRACE_FUNC);
+    SkASSERT(bitmap.isOpaque());
+    const int width = bitmap.width();
+    const int height = bitmap.height();
+
+    // ETC1 encodes 4x4 blocks of packed RGB888, so we convert and encode one row of blocks at a
+    // time rather than making a full size copy of the image.
+    static constexpr int kBlockDim = 4;
+    static constexpr size_t kBytesPerBlock = 8;
+    SkAutoPixmapStorage rgba;
+    if (!rgba.tryAlloc(SkImageInfo::Make(width, kBlockDim, kRGBA_8888_SkColorType,
+                                         kOpaque_SkAlphaType, bitmap.refColorSpace()))) {
+        return;
+    }
+    const size_t rgbRowBytes = 3 * width;
+    SkAutoMalloc rgb(kBlockDim * rgbRowBytes);
+
+    sk_sp<SkData> blocks = SkData::MakeUninitialized(etc1_get_encoded_data_size(width, height));
+    const size_t blockRowBytes = ((width + kBlockDim - 1) / kBlockDim) * kBytesPerBlock;
+    uint8_t* dst = static_cast<uint8_t*>(blocks->writable_data());
+    for (int y = 0; y < height; y += kBlockDim, dst += blockRowBytes) {
+        const int rows = SkTMin(kBlockDim, height - y);
+        if (!bitmap.readPixels(rgba, 0, y)) {
+            return;
+        }
+        for (int row = 0; row < rows; ++row) {
+            const uint8_t* src = static_cast<const uint8_t*>(rgba.addr(0, row));
+            uint8_t* rgbRow = static_cast<uint8_t*>(rgb.get()) + row * rgbRowBytes;
+            for (int x = 0; x < width; ++x) {
+                memcpy(rgbRow + 3 * x, src + 4 * x, 3);
+            }
+        }
+        if (etc1_encode_image(static_cast<const etc1_byte*>(rgb.get()), width, rows, 3,
+                              rgbRowBytes, dst)) {
+            return;
+        }
+    }
+
+    this->add(key, std::move(blocks), width, height);
+}
+
+void GrCompressedImageCache::add(const GrUniqueKey& key, sk_sp<SkData> blocks,
+                                 int width, int height) {
+    SkAutoMutexAcquire lock(fMutex);
+    if (Entry* existing = fEntries.find(key)) {
+        this->removeEntry(existing);
+    }
+    if (blocks->size() > fMaxBytes) {
+        return;
+    }
+    Entry* entry = new Entry(key, std::move(blocks), width, height);
+    fEntries.add(entry);
+    fLRU.addToHead(entry);
+    fBytes += entry->fBlocks->size();
+    this->purgeToBudget();
+}
+
+sk_sp<SkData> GrCompressedImageCache::find(const GrUniqueKey& key, int* width, int* height) {
+    SkAutoMutexAcquire lock(fMutex);
+    Entry* entry = fEntries.find(key);
+    if (!entry) {
+        return nullptr;
+    }
+    fLRU.remove(entry);
+    fLRU.addToHead(entry);
+    *width = entry->fWidth;
+    *height = entry->fHeight;
+    return entry->fBlocks;
+}
+
+bool GrCompressedImageCache::has(const GrUniqueKey& key) {
+    SkAutoMutexAcquire lock(fMutex);
+    return SkToBool(fEntries.find(key));
+}
+
+void GrCompressedImageCache::remove(const GrUniqueKey& key) {
+    SkAutoMutexAcquire lock(fMutex);
+    if (Entry* entry = fEntries.find(key)) {
+        this->removeEntry(entry);
+    }
+}
+
+void GrCompressedImageCache::purgeAll() {
+    SkAutoMutexAcquire lock(fMutex);
+    while (Entry* entry = fLRU.tail()) {
+        this->removeEntry(entry);
+    }
+}
+
+void GrCompressedImageCache::removeEntry(Entry* entry) {
+    fMutex.assertHeld();
+    fEntries.remove(entry->fKey);
+    fLRU.remove(entry);
+    SkASSERT(fBytes >= entry->fBlocks->size());
+    fBytes -= entry->fBlocks->size();
+    delete entry;
+}
+
+void GrCompressedImageCache::purgeToBudget() {
+    fMutex.assertHeld();
+    while (fBytes > fMaxBytes) {
+        Entry* entry = fLRU.tail();
+        SkASSERT(entry);
+        this->removeEntry(entry);
+    }
+}
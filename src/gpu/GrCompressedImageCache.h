@@ -0,0 +1,95 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrCompressedImageCache_DEFINED
+#define GrCompressedImageCache_DEFINED
+
+#include "GrResourceKey.h"
+#include "SkData.h"
+#include "SkMutex.h"
+#include "SkRefCnt.h"
+#include "SkTDynamicHash.h"
+#include "SkTInternalLList.h"
+
+class SkBitmap;
+
+/**
+ * A CPU-side tier behind the GrResourceCache for image textures. It holds ETC1-compressed copies
+ * of opaque image textures, keyed by the textures' unique keys, at an eighth of the memory of
+ * the RGBA texels. When the GrResourceCache purges such a texture, the image can be re-uploaded
+ * from the compressed blocks instead of being decoded again.
+ *
+ * Entries are encoded on worker threads, so all of the methods are thread-safe. The least
+ * recently used entries are dropped to stay within the budget.
+ */
+class GrCompressedImageCache : public SkRefCnt {
+public:
+    GrCompressedImageCache(size_t maxBytes) : fMaxBytes(maxBytes) {}
+    ~GrCompressedImageCache() override;
+
+    /**
+     * Encodes the opaque bitmap to ETC1 and adds the result under key, replacing any previous
+     * entry. Meant to be called on a worker thread.
+     */
+    void encodeAndAdd(const GrUniqueKey& key, const SkBitmap&);
+
+    /**
+     * Returns the ETC1 blocks for key and marks the entry as most recently used, or nullptr if
+     * there is no entry. The dimensions of the image are returned in width and height.
+     */
+    sk_sp<SkData> find(const GrUniqueKey& key, int* width, int* height);
+
+    bool has(const GrUniqueKey& key);
+
+    void remove(const GrUniqueKey& key);
+
+    void purgeAll();
+
+    size_t getBytes() {
+        SkAutoMutexAcquire lock(fMutex);
+        return fBytes;
+    }
+    int count() {
+        SkAutoMutexAcquire lock(fMutex);
+        return fEntries.count();
+    }
+
+    // Exposed for testing: adds already encoded blocks.
+    void add(const GrUniqueKey& key, sk_sp<SkData> blocks, int width, int height);
+
+private:
+    struct Entry {
+        Entry(const GrUniqueKey& key, sk_sp<SkData> blocks, int width, int height)
+                : fKey(key), fBlocks(std::move(blocks)), fWidth(width), fHeight(height) {}
+
+        GrUniqueKey   fKey;
+        sk_sp<SkData> fBlocks;
+        int           fWidth;
+        int           fHeight;
+
+        SK_DECLARE_INTERNAL_LLIST_INTERFACE(Entry);
+
+        // for SkTDynamicHash
+        static const GrUniqueKey& GetKey(const Entry& entry) { return entry.fKey; }
+        static uint32_t Hash(const GrUniqueKey& key) { return key.hash(); }
+    };
+
+    // Both of these require fMutex to be held.
+    void removeEntry(Entry*);
+    void purgeToBudget();
+
+    SkMutex                                 fMutex;
+    SkTDynamicHash<Entry, GrUniqueKey>      fEntries;
+    // Most recently used at the head.
+    SkTInternalLList<Entry>                 fLRU;
+    size_t                                  fBytes = 0;
+    const size_t                            fMaxBytes;
+
+    typedef SkRefCnt INHERITED;
+};
+
+#endif
@@ -6,10 +6,12 @@
  */
 
 #include "GrContext.h"
+#include "GrAsyncReadManager.h"
 #include "GrBackendSemaphore.h"
 #include "GrDrawingManager.h"
 #include "GrGpu.h"
 #include "GrMemoryPool.h"
+#include "GrOpTimer.h"
 #include "GrPathRendererChain.h"
 #include "GrProxyProvider.h"
 #include "GrRenderTargetProxy.h"
@@ -76,6 +78,8 @@ bool GrContext::init(sk_sp<const GrCaps> caps, sk_sp<GrSkSLFPFactoryCache> FPFac
 
     if (fGpu) {
         fResourceCache = new GrResourceCache(this->caps(), this->singleOwner(), this->contextID());
+        fResourceCache->setIncrementalPurgeBytes(
+                this->options().fResourceCacheIncrementalPurgeBytes);
         fResourceProvider = new GrResourceProvider(fGpu.get(), fResourceCache, this->singleOwner(),
                                                    this->explicitlyAllocateGPUResources());
     }
@@ -92,6 +96,11 @@ bool GrContext::init(sk_sp<const GrCaps> caps, sk_sp<GrSkSLFPFactoryCache> FPFac
         fTaskGroup = skstd::make_unique<SkTaskGroup>(*this->options().fExecutor);
     }
 
+    if (fResourceCache && fTaskGroup && this->options().fCompressedImageCacheBytes &&
+        this->caps()->isConfigTexturable(kRGB_ETC1_GrPixelConfig)) {
+        fResourceCache->enableCompressedImageCache(this->options().fCompressedImageCacheBytes);
+    }
+
     fPersistentCache = this->options().fPersistentCache;
 
     return true;
@@ -182,6 +191,7 @@ void GrContext::performDeferredCleanup(std::chrono::milliseconds msNotUsed) {
     auto purgeTime = GrStdSteadyClock::now() - msNotUsed;
 
     fResourceCache->purgeAsNeeded();
+    fResourceCache->finishIncrementalPurge();
     fResourceCache->purgeResourcesNotUsedSince(purgeTime);
 
     if (auto ccpr = this->drawingManager()->getCoverageCountingPathRenderer()) {
@@ -189,8 +199,8 @@ void GrContext::performDeferredCleanup(std::chrono::milliseconds msNotUsed) {
     }
 
     // The textBlob Cache doesn't actually hold any GPU resource but this is a convenient
-    // place to purge stale blobs
-    this->getTextBlobCache()->purgeStaleBlobs();
+    // place to purge stale and unused blobs
+    this->getTextBlobCache()->purgeBlobsNotUsedSince(purgeTime);
 }
 
 void GrContext::purgeUnlockedResources(size_t bytesToPurge, bool preferScratchResources) {
@@ -225,6 +235,10 @@ bool GrContext::colorTypeSupportedAsImage(SkColorType colorType) const {
     return this->caps()->isConfigTexturable(config);
 }
 
+bool GrContext::compressionTypeSupported(SkImage::CompressionType type) const {
+    return this->caps()->isConfigTexturable(SkCompressionTypeToGrPixelConfig(type));
+}
+
 int GrContext::maxSurfaceSampleCountForColorType(SkColorType colorType) const {
     GrPixelConfig config = SkColorType2GrPixelConfig(colorType);
     return this->caps()->maxRenderTargetSampleCount(config);
@@ -278,6 +292,34 @@ void GrContext::storeVkPipelineCacheData() {
     }
 }
 
+bool GrContext::setOpTimingEnabled(bool enabled) {
+    ASSERT_SINGLE_OWNER
+    RETURN_FALSE_IF_ABANDONED
+    return fGpu && fGpu->setOpTimingEnabled(enabled);
+}
+
+void GrContext::dumpOpTimings(GrOpTimingDump* opTimingDump) {
+    ASSERT_SINGLE_OWNER
+    RETURN_IF_ABANDONED
+    if (GrOpTimer* opTimer = fGpu ? fGpu->opTimer() : nullptr) {
+        opTimer->dump(opTimingDump);
+    }
+}
+
+void GrContext::checkAsyncWorkCompletion(bool waitForAll) {
+    ASSERT_SINGLE_OWNER
+    RETURN_IF_ABANDONED
+    if (fGpu) {
+        fGpu->asyncReadManager()->check(waitForAll);
+    }
+}
+
+bool GrContext::precompile(const SkData& key) {
+    ASSERT_SINGLE_OWNER
+    RETURN_FALSE_IF_ABANDONED
+    return fGpu && fGpu->precompile(key);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 std::unique_ptr<GrFragmentProcessor> GrContext::createPMToUPMEffect(
@@ -333,13 +375,20 @@ void GrContext::getResourceCacheLimits(int* maxResources, size_t* maxResourceByt
 void GrContext::setResourceCacheLimits(int maxResources, size_t maxResourceBytes) {
     ASSERT_SINGLE_OWNER
     fResourceCache->setLimits(maxResources, maxResourceBytes);
+    this->getTextBlobCache()->setBudget(
+            GrTextBlobCache::BudgetForResourceBytes(maxResourceBytes));
 }
 
 //////////////////////////////////////////////////////////////////////////////
 void GrContext::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const {
     ASSERT_SINGLE_OWNER
     fResourceCache->dumpMemoryStatistics(traceMemoryDump);
+    const GrTextBlobCache* textBlobCache = this->getTextBlobCache();
     traceMemoryDump->dumpNumericValue("skia/gr_text_blob_cache", "size", "bytes",
-                                      this->getTextBlobCache()->usedBytes());
+                                      textBlobCache->usedBytes());
+    traceMemoryDump->dumpNumericValue("skia/gr_text_blob_cache", "budget_size", "bytes",
+                                      textBlobCache->getBudget());
+    traceMemoryDump->dumpNumericValue("skia/gr_text_blob_cache", "blob_count", "objects",
+                                      textBlobCache->blobCount());
 }
 
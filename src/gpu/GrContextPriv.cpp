@@ -18,6 +18,7 @@
 #include "GrSurfacePriv.h"
 #include "GrTexture.h"
 #include "GrTextureContext.h"
+#include "GrTextureProxyPriv.h"
 #include "SkAutoPixmapStorage.h"
 #include "SkImage_Base.h"
 #include "SkImage_Gpu.h"
@@ -246,6 +247,7 @@ static bool valid_premul_color_type(GrColorType ct) {
         case GrColorType::kRG_F32:           return false;
         case GrColorType::kRGBA_F32:         return true;
         case GrColorType::kRGB_ETC1:         return false;
+        case GrColorType::kRGB_BC1:          return false;
     }
     SK_ABORT("Invalid GrColorType");
     return false;
@@ -274,6 +276,7 @@ static bool valid_premul_config(GrPixelConfig config) {
         case kRGBA_half_GrPixelConfig:          return true;
         case kRGBA_half_Clamped_GrPixelConfig:  return true;
         case kRGB_ETC1_GrPixelConfig:           return false;
+        case kRGB_BC1_GrPixelConfig:            return false;
         case kAlpha_8_as_Alpha_GrPixelConfig:   return false;
         case kAlpha_8_as_Red_GrPixelConfig:     return false;
         case kAlpha_half_as_Red_GrPixelConfig:  return false;
@@ -317,6 +320,10 @@ bool GrContextPriv::readSurfacePixels(GrSurfaceContext* src, int left, int top,
 
     GrSurfaceProxy* srcProxy = src->asSurfaceProxy();
     GrSurface* srcSurface = srcProxy->peekSurface();
+    if (GrTextureProxy* srcTextureProxy = srcProxy->asTextureProxy()) {
+        // No op list may have uploaded a deferred texture's contents yet.
+        srcTextureProxy->texPriv().uploadDeferredNow(fContext->fGpu.get());
+    }
 
     if (!GrSurfacePriv::AdjustReadPixelParams(srcSurface->width(), srcSurface->height(),
                                               GrColorTypeBytesPerPixel(dstColorType), &left, &top,
@@ -735,6 +742,7 @@ void GrContextPriv::dumpCacheStats(SkString* out) const {
 #if GR_CACHE_STATS
     fContext->fResourceCache->dumpStats(out);
 #endif
+    fContext->getTextBlobCache()->dumpStats(out);
 }
 
 void GrContextPriv::dumpCacheStatsKeyValuePairs(SkTArray<SkString>* keys,
@@ -742,6 +750,7 @@ void GrContextPriv::dumpCacheStatsKeyValuePairs(SkTArray<SkString>* keys,
 #if GR_CACHE_STATS
     fContext->fResourceCache->dumpStatsKeyValuePairs(keys, values);
 #endif
+    fContext->getTextBlobCache()->dumpStatsKeyValuePairs(keys, values);
 }
 
 void GrContextPriv::printCacheStats() const {
@@ -13,6 +13,7 @@
 #include "SkRefCnt.h"
 #include "SkSemaphore.h"
 
+#include "GrGpu.h"
 #include "GrOpFlushState.h"
 #include "GrTextureProxyPriv.h"
 
@@ -53,15 +54,10 @@ public:
             return;
         }
 
-        auto uploadMask = [this, proxy](GrDeferredTextureUploadWritePixelsFn& writePixelsFn) {
+        GrGpu* gpu = flushState->gpu();
+        auto uploadMask = [this, gpu, proxy](GrDeferredTextureUploadWritePixelsFn& writePixelsFn) {
             this->wait();
-            GrColorType pixelColorType = SkColorTypeToGrColorType(this->fPixels.info().colorType());
-            // If the worker thread was unable to allocate pixels, this check will fail, and we'll
-            // end up drawing with an uninitialized mask texture, but at least we won't crash.
-            if (this->fPixels.addr()) {
-                writePixelsFn(proxy, 0, 0, this->fPixels.width(), this->fPixels.height(),
-                              pixelColorType, this->fPixels.addr(), this->fPixels.rowBytes());
-            }
+            this->onUpload(gpu, proxy, writePixelsFn);
             // Upload has finished, so tell the proxy to release this GrDeferredProxyUploader
             proxy->texPriv().resetDeferredUploader();
         };
@@ -69,6 +65,24 @@ public:
         fScheduledUpload = true;
     }
 
+    /**
+     * Waits for the worker thread and uploads right away, outside of any flush. This is for
+     * textures that are about to be used directly (read back or handed to the client) without an
+     * op list having scheduled their upload. Like the ASAP upload, this deletes the uploader.
+     */
+    void uploadNow(GrGpu* gpu, GrTextureProxy* proxy) {
+        SkASSERT(!fScheduledUpload);
+        this->wait();
+        GrDeferredTextureUploadWritePixelsFn writePixelsFn =
+                [gpu](GrTextureProxy* dstProxy, int left, int top, int width, int height,
+                      GrColorType srcColorType, const void* buffer, size_t rowBytes) {
+                    return gpu->writePixels(dstProxy->peekSurface(), left, top, width, height,
+                                            srcColorType, buffer, rowBytes);
+                };
+        this->onUpload(gpu, proxy, writePixelsFn);
+        proxy->texPriv().resetDeferredUploader();
+    }
+
     void signalAndFreeData() {
         this->freeData();
         fPixelsReady.signal();
@@ -77,6 +91,21 @@ public:
     SkAutoPixmapStorage* getPixels() { return &fPixels; }
 
 protected:
+    /**
+     * Called on the flushing thread once the worker thread has signaled. The default uploads
+     * fPixels with writePixelsFn.
+     */
+    virtual void onUpload(GrGpu*, GrTextureProxy* proxy,
+                          GrDeferredTextureUploadWritePixelsFn& writePixelsFn) {
+        GrColorType pixelColorType = SkColorTypeToGrColorType(this->fPixels.info().colorType());
+        // If the worker thread was unable to allocate pixels, this check will fail, and we'll
+        // end up drawing with an uninitialized mask texture, but at least we won't crash.
+        if (this->fPixels.addr()) {
+            writePixelsFn(proxy, 0, 0, this->fPixels.width(), this->fPixels.height(),
+                          pixelColorType, this->fPixels.addr(), this->fPixels.rowBytes());
+        }
+    }
+
     void wait() {
         if (!fWaited) {
             fPixelsReady.wait();
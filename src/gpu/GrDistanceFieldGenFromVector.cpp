@@ -14,8 +14,12 @@
 #include "SkGeometry.h"
 #include "SkMatrix.h"
 #include "SkPathOps.h"
+#include "SkPathOpsCubic.h"
 #include "SkPointPriv.h"
 #include "SkRectPriv.h"
+#include "SkTemplates.h"
+
+#include <utility>
 
 /**
  * If a scanline (a row of texel) cross from the kRight_SegSide
@@ -877,3 +881,426 @@ bool GrGenerateDistanceFieldFromPath(unsigned char* distanceField,
     }
     return true;
 }
+
+///////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Multi-channel distance fields
+ *
+ * Each edge of the path is given a color: a subset of the red, green and blue channels, chosen so
+ * that the two edges meeting at a corner share only one channel. Every channel stores the signed
+ * distance to the nearest edge of that channel, extended past the edge's endpoints along its
+ * tangents. Near a corner the channels disagree, and the median of the three reproduces the
+ * corner exactly even when the field is magnified, where a single channel would round it off.
+ */
+
+enum EdgeColor {
+    kRed_EdgeColor     = 0x1,
+    kGreen_EdgeColor   = 0x2,
+    kBlue_EdgeColor    = 0x4,
+    kYellow_EdgeColor  = kRed_EdgeColor | kGreen_EdgeColor,
+    kMagenta_EdgeColor = kRed_EdgeColor | kBlue_EdgeColor,
+    kCyan_EdgeColor    = kGreen_EdgeColor | kBlue_EdgeColor,
+    kWhite_EdgeColor   = kRed_EdgeColor | kGreen_EdgeColor | kBlue_EdgeColor,
+};
+
+// sin(3), the same threshold msdfgen uses: joins that turn more sharply than this are corners
+static const float kCornerCrossThreshold = 0.14112f;
+
+struct MSDFEdge {
+    // line uses 2 pts, quad uses 3 pts
+    SkPoint fPts[3];
+    bool    fIsQuad;
+    int     fColor;
+
+    SkPoint eval(float t) const {
+        if (!fIsQuad) {
+            return fPts[0] + (fPts[1] - fPts[0]) * t;
+        }
+        float mt = 1 - t;
+        return fPts[0] * (mt * mt) + fPts[1] * (2 * mt * t) + fPts[2] * (t * t);
+    }
+
+    SkVector tangent(float t) const {
+        if (!fIsQuad) {
+            return fPts[1] - fPts[0];
+        }
+        return (fPts[1] - fPts[0]) * (1 - t) + (fPts[2] - fPts[1]) * t;
+    }
+
+    SkRect bounds() const {
+        SkRect bounds;
+        bounds.set(fPts, fIsQuad ? 3 : 2);
+        return bounds;
+    }
+
+    void reverse() {
+        std::swap(fPts[0], fPts[fIsQuad ? 2 : 1]);
+    }
+};
+
+typedef SkTArray<MSDFEdge, true> MSDFEdgeArray;
+
+// Distance from a texel center to an edge, negative inside the path.
+struct EdgeDistance {
+    float fDist;
+    // How close to perpendicular the direction to the texel is to the edge. At a vertex shared by
+    // two edges both are equally near, and the more perpendicular one gives the correct sign.
+    float fOrthogonality;
+    float fT;
+
+    bool isCloserThan(const EdgeDistance& that) const {
+        float d0 = SkScalarAbs(fDist);
+        float d1 = SkScalarAbs(that.fDist);
+        if (SkScalarNearlyEqual(d0, d1, 1.0f / (1 << 12))) {
+            return fOrthogonality > that.fOrthogonality;
+        }
+        return d0 < d1;
+    }
+};
+
+struct MSDFData {
+    EdgeDistance fNearest[3];
+    float        fPseudoDist[3];
+};
+
+static void add_msdf_line(const SkPoint pts[2], MSDFEdgeArray* edges) {
+    if (pts[0] == pts[1]) {
+        return;
+    }
+    MSDFEdge& edge = edges->push_back();
+    edge.fPts[0] = pts[0];
+    edge.fPts[1] = pts[1];
+    edge.fIsQuad = false;
+    edge.fColor = kWhite_EdgeColor;
+}
+
+static void add_msdf_quad(const SkPoint pts[3], MSDFEdgeArray* edges) {
+    if (SkPointPriv::DistanceToSqd(pts[0], pts[1]) < kCloseSqd ||
+        SkPointPriv::DistanceToSqd(pts[1], pts[2]) < kCloseSqd ||
+        is_colinear(pts)) {
+        SkPoint linePts[2] = { pts[0], pts[2] };
+        add_msdf_line(linePts, edges);
+        return;
+    }
+    MSDFEdge& edge = edges->push_back();
+    memcpy(edge.fPts, pts, 3 * sizeof(SkPoint));
+    edge.fIsQuad = true;
+    edge.fColor = kWhite_EdgeColor;
+}
+
+static bool is_corner(const MSDFEdge& prev, const MSDFEdge& next) {
+    SkVector a = prev.tangent(1);
+    SkVector b = next.tangent(0);
+    if (!a.normalize() || !b.normalize()) {
+        return false;
+    }
+    return SkPoint::DotProduct(a, b) <= 0 ||
+           SkScalarAbs(SkPoint::CrossProduct(a, b)) > kCornerCrossThreshold;
+}
+
+// Colors the edges of one closed contour.
+static void color_contour(MSDFEdge* edges, int count) {
+    SkSTArray<16, int, true> corners;
+    for (int i = 0; i < count; ++i) {
+        if (is_corner(edges[(i + count - 1) % count], edges[i])) {
+            corners.push_back(i);
+        }
+    }
+
+    if (corners.empty()) {
+        // A smooth contour has no corners to preserve.
+        for (int i = 0; i < count; ++i) {
+            edges[i].fColor = kWhite_EdgeColor;
+        }
+    } else if (1 == corners.count()) {
+        // A teardrop: split the contour into thirds so that the two edges meeting at the corner
+        // differ. A single edge can't be split here, so its corner is left rounded.
+        static const int kTeardropColors[3] = {
+            kMagenta_EdgeColor, kWhite_EdgeColor, kYellow_EdgeColor
+        };
+        for (int i = 0; i < count; ++i) {
+            int index = (corners[0] + i) % count;
+            switch (count) {
+                case 1:
+                    edges[index].fColor = kWhite_EdgeColor;
+                    break;
+                case 2:
+                    edges[index].fColor = i ? kYellow_EdgeColor : kMagenta_EdgeColor;
+                    break;
+                default:
+                    edges[index].fColor = kTeardropColors[3 * i / count];
+                    break;
+            }
+        }
+    } else {
+        // Switch colors at every corner. The last run of edges meets the first, so it must not
+        // repeat the first color.
+        static const int kCycleColors[3] = {
+            kCyan_EdgeColor, kMagenta_EdgeColor, kYellow_EdgeColor
+        };
+        int splineCount = corners.count();
+        int spline = 0;
+        for (int i = 0; i < count; ++i) {
+            int index = (corners[0] + i) % count;
+            if (spline + 1 < splineCount && corners[spline + 1] == index) {
+                ++spline;
+            }
+            int color = kCycleColors[spline % 3];
+            if (spline == splineCount - 1 && 0 == spline % 3) {
+                color = kCycleColors[1];
+            }
+            edges[index].fColor = color;
+        }
+    }
+}
+
+// Makes the inside of the path lie to the left of every contour (with y pointing down, to the
+// side of (-dy, dx)), so that the sign of each edge's distance can be read off the edge alone.
+static void orient_contour(MSDFEdge* edges, int count, const SkPath& path) {
+    int longest = 0;
+    SkScalar longestLength = 0;
+    for (int i = 0; i < count; ++i) {
+        SkScalar length = SkPoint::Distance(edges[i].fPts[0], edges[i].fPts[edges[i].fIsQuad + 1]);
+        if (length > longestLength) {
+            longest = i;
+            longestLength = length;
+        }
+    }
+    const MSDFEdge& edge = edges[longest];
+    SkPoint mid = edge.eval(0.5f);
+    SkVector normal = edge.tangent(0.5f);
+    if (!normal.setLength(kClose)) {
+        return;
+    }
+    normal.set(-normal.fY, normal.fX);
+    bool leftInside = path.contains(mid.fX + normal.fX, mid.fY + normal.fY);
+    bool rightInside = path.contains(mid.fX - normal.fX, mid.fY - normal.fY);
+    if (leftInside || !rightInside) {
+        return;
+    }
+    for (int i = 0; i < count; ++i) {
+        edges[i].reverse();
+    }
+    for (int i = 0, j = count - 1; i < j; ++i, --j) {
+        std::swap(edges[i], edges[j]);
+    }
+}
+
+static float nearest_t(const MSDFEdge& edge, const SkPoint& point) {
+    if (!edge.fIsQuad) {
+        SkVector ab = edge.fPts[1] - edge.fPts[0];
+        float t = SkPoint::DotProduct(point - edge.fPts[0], ab) / SkPoint::DotProduct(ab, ab);
+        return SkTPin(t, 0.0f, 1.0f);
+    }
+
+    // The quad is p0 + 2ta + t^2 b. The nearest point zeroes the derivative of its squared
+    // distance to the point, a cubic in t.
+    SkVector a = edge.fPts[1] - edge.fPts[0];
+    SkVector b = edge.fPts[2] - edge.fPts[1] * 2 + edge.fPts[0];
+    SkVector q = edge.fPts[0] - point;
+    double roots[3];
+    int rootCount = SkDCubic::RootsValidT(SkPoint::DotProduct(b, b),
+                                          3 * SkPoint::DotProduct(a, b),
+                                          2 * SkPoint::DotProduct(a, a) + SkPoint::DotProduct(q, b),
+                                          SkPoint::DotProduct(q, a), roots);
+    float bestT = 0;
+    float bestDistSq = SkPointPriv::DistanceToSqd(edge.fPts[0], point);
+    if (SkPointPriv::DistanceToSqd(edge.fPts[2], point) < bestDistSq) {
+        bestT = 1;
+        bestDistSq = SkPointPriv::DistanceToSqd(edge.fPts[2], point);
+    }
+    for (int i = 0; i < rootCount; ++i) {
+        float t = (float)roots[i];
+        float distSq = SkPointPriv::DistanceToSqd(edge.eval(t), point);
+        if (distSq < bestDistSq) {
+            bestT = t;
+            bestDistSq = distSq;
+        }
+    }
+    return bestT;
+}
+
+static EdgeDistance distance_to_edge(const MSDFEdge& edge, const SkPoint& point) {
+    EdgeDistance result;
+    result.fT = nearest_t(edge, point);
+    SkVector toPoint = point - edge.eval(result.fT);
+    SkVector dir = edge.tangent(result.fT);
+    float dist = toPoint.length();
+    if (!dir.normalize() || SkScalarNearlyZero(dist)) {
+        result.fDist = dist;
+        result.fOrthogonality = 1;
+        return result;
+    }
+    float cross = SkPoint::CrossProduct(dir, toPoint);
+    result.fDist = cross > 0 ? -dist : dist;
+    result.fOrthogonality = SkScalarAbs(cross) / dist;
+    return result;
+}
+
+// Past an endpoint, measure the distance to the edge's tangent line instead of to the endpoint,
+// so that the channels keep disagreeing all the way out from a corner.
+static float pseudo_distance(const MSDFEdge& edge, const EdgeDistance& distance,
+                             const SkPoint& point) {
+    if (distance.fT > 0 && distance.fT < 1) {
+        return distance.fDist;
+    }
+    SkVector dir = edge.tangent(distance.fT);
+    if (!dir.normalize()) {
+        return distance.fDist;
+    }
+    SkVector toPoint = point - edge.eval(distance.fT);
+    float along = SkPoint::DotProduct(toPoint, dir);
+    if ((0 == distance.fT && along < 0) || (1 == distance.fT && along > 0)) {
+        float pseudo = -SkPoint::CrossProduct(dir, toPoint);
+        if (SkScalarAbs(pseudo) <= SkScalarAbs(distance.fDist)) {
+            return pseudo;
+        }
+    }
+    return distance.fDist;
+}
+
+static inline float median(float a, float b, float c) {
+    return SkTMax(SkTMin(a, b), SkTMin(SkTMax(a, b), c));
+}
+
+bool GrGenerateMultiChannelDistanceFieldFromPath(unsigned char* distanceField,
+                                                 const SkPath& path, const SkMatrix& drawMatrix,
+                                                 int width, int height, size_t rowBytes) {
+    SkASSERT(distanceField);
+    SkASSERT(rowBytes >= 4 * (size_t)width);
+
+    SkPath simplifiedPath;
+    SkPath workingPath;
+    if (Simplify(path, &simplifiedPath)) {
+        workingPath = simplifiedPath;
+    } else {
+        workingPath = path;
+    }
+
+    if (!IsDistanceFieldSupportedFillType(workingPath.getFillType())) {
+        return false;
+    }
+
+    // translate path to offset (SK_DistanceFieldPad, SK_DistanceFieldPad)
+    SkMatrix dfMatrix = drawMatrix;
+    dfMatrix.postTranslate(SK_DistanceFieldPad, SK_DistanceFieldPad);
+    workingPath.transform(dfMatrix);
+
+    MSDFEdgeArray edges;
+    SkSTArray<8, int, true> contourStarts;
+    SkPath::Iter iter(workingPath, true);
+    for (;;) {
+        SkPoint pts[4];
+        SkPath::Verb verb = iter.next(pts);
+        switch (verb) {
+            case SkPath::kMove_Verb:
+                contourStarts.push_back(edges.count());
+                break;
+            case SkPath::kLine_Verb:
+                add_msdf_line(pts, &edges);
+                break;
+            case SkPath::kQuad_Verb:
+                add_msdf_quad(pts, &edges);
+                break;
+            case SkPath::kConic_Verb: {
+                SkScalar weight = iter.conicWeight();
+                SkAutoConicToQuads converter;
+                const SkPoint* quadPts = converter.computeQuads(pts, weight, kConicTolerance);
+                for (int i = 0; i < converter.countQuads(); ++i) {
+                    add_msdf_quad(quadPts + 2*i, &edges);
+                }
+                break;
+            }
+            case SkPath::kCubic_Verb: {
+                SkSTArray<15, SkPoint, true> quads;
+                GrPathUtils::convertCubicToQuads(pts, SK_Scalar1, &quads);
+                for (int q = 0; q < quads.count(); q += 3) {
+                    add_msdf_quad(&quads[q], &edges);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        if (verb == SkPath::kDone_Verb) {
+            break;
+        }
+    }
+    contourStarts.push_back(edges.count());
+
+    for (int c = 0; c + 1 < contourStarts.count(); ++c) {
+        int start = contourStarts[c];
+        int count = contourStarts[c + 1] - start;
+        if (count > 0) {
+            orient_contour(&edges[start], count, workingPath);
+            color_contour(&edges[start], count);
+        }
+    }
+
+    SkAutoTMalloc<MSDFData> data(width * height);
+    for (int i = 0; i < width * height; ++i) {
+        for (int channel = 0; channel < 3; ++channel) {
+            data[i].fNearest[channel] = { SK_ScalarMax, 0, 0 };
+            data[i].fPseudoDist[channel] = SK_ScalarMax;
+        }
+    }
+
+    // Texels further than SK_DistanceFieldMagnitude from an edge clamp to the same value, so each
+    // edge only needs to visit the texels near it.
+    for (const MSDFEdge& edge : edges) {
+        SkIRect texels = edge.bounds().makeOutset(SK_DistanceFieldMagnitude + 1,
+                                                  SK_DistanceFieldMagnitude + 1).roundOut();
+        if (!texels.intersect(SkIRect::MakeWH(width, height))) {
+            continue;
+        }
+        for (int row = texels.fTop; row < texels.fBottom; ++row) {
+            for (int col = texels.fLeft; col < texels.fRight; ++col) {
+                const SkPoint point = SkPoint::Make(col + 0.5f, row + 0.5f);
+                MSDFData& texel = data[row * width + col];
+                EdgeDistance distance = distance_to_edge(edge, point);
+                float pseudo = SK_ScalarMax;
+                for (int channel = 0; channel < 3; ++channel) {
+                    if ((edge.fColor & (1 << channel)) &&
+                        distance.isCloserThan(texel.fNearest[channel])) {
+                        if (SK_ScalarMax == pseudo) {
+                            pseudo = pseudo_distance(edge, distance, point);
+                        }
+                        texel.fNearest[channel] = distance;
+                        texel.fPseudoDist[channel] = pseudo;
+                    }
+                }
+            }
+        }
+    }
+
+    for (int row = 0; row < height; ++row) {
+        unsigned char* dst = distanceField + row * rowBytes;
+        for (int col = 0; col < width; ++col, dst += 4) {
+            const MSDFData& texel = data[row * width + col];
+            float sign = workingPath.contains(col + 0.5f, row + 0.5f) ? -1 : 1;
+            float nearest = SK_DistanceFieldMagnitude;
+            float channels[3];
+            for (int channel = 0; channel < 3; ++channel) {
+                float dist = SkScalarAbs(texel.fNearest[channel].fDist);
+                nearest = SkTMin(nearest, dist);
+                channels[channel] = dist < SK_DistanceFieldMagnitude
+                                  ? texel.fPseudoDist[channel]
+                                  : sign * SK_DistanceFieldMagnitude;
+            }
+            float trueDist = sign * nearest;
+
+            // Where the channels would put the texel on the wrong side of the path, use the true
+            // distance in all of them and give up on a sharp corner there.
+            if (median(channels[0], channels[1], channels[2]) * sign < 0) {
+                channels[0] = channels[1] = channels[2] = trueDist;
+            }
+
+            dst[0] = pack_distance_field_val<SK_DistanceFieldMagnitude>(channels[0]);
+            dst[1] = pack_distance_field_val<SK_DistanceFieldMagnitude>(channels[1]);
+            dst[2] = pack_distance_field_val<SK_DistanceFieldMagnitude>(channels[2]);
+            dst[3] = pack_distance_field_val<SK_DistanceFieldMagnitude>(trueDist);
+        }
+    }
+    return true;
+}
@@ -30,6 +30,23 @@ bool GrGenerateDistanceFieldFromPath(unsigned char* distanceField,
                                      const SkPath& path, const SkMatrix& viewMatrix,
                                      int width, int height, size_t rowBytes);
 
+/** Given a vector path, generate a multi-channel distance field. Each texel is four bytes: the
+ *  median of the first three is the signed distance, which stays sharp at corners under
+ *  magnification, and the fourth holds the ordinary single-channel distance. Because the median
+ *  doesn't depend on channel order the result can be stored as either RGBA or BGRA.
+ *
+ *  @param distanceField     The distance field to be generated. Should already be allocated
+ *                           by the client with the padding defined in "SkDistanceFieldGen.h".
+ *  @param path              The path we're using to generate the distance field.
+ *  @param matrix            Transformation matrix for path.
+ *  @param width             Width of the distance field.
+ *  @param height            Height of the distance field.
+ *  @param rowBytes          Size of each row in the distance field, in bytes.
+ */
+bool GrGenerateMultiChannelDistanceFieldFromPath(unsigned char* distanceField,
+                                                 const SkPath& path, const SkMatrix& viewMatrix,
+                                                 int width, int height, size_t rowBytes);
+
 inline bool IsDistanceFieldSupportedFillType(SkPath::FillType fFillType)
 {
     return (SkPath::kEvenOdd_FillType == fFillType ||
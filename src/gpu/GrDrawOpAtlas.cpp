@@ -38,10 +38,11 @@ std::unique_ptr<GrDrawOpAtlas> GrDrawOpAtlas::Make(GrProxyProvider* proxyProvide
                                                    GrPixelConfig config, int width,
                                                    int height, int plotWidth, int plotHeight,
                                                    AllowMultitexturing allowMultitexturing,
-                                                   GrDrawOpAtlas::EvictionFunc func, void* data) {
+                                                   GrDrawOpAtlas::EvictionFunc func, void* data,
+                                                   int maxPages) {
     std::unique_ptr<GrDrawOpAtlas> atlas(new GrDrawOpAtlas(proxyProvider, format, config, width,
                                                            height, plotWidth, plotHeight,
-                                                           allowMultitexturing));
+                                                           allowMultitexturing, maxPages));
     if (!atlas->getProxies()[0]) {
         return nullptr;
     }
@@ -181,7 +182,8 @@ void GrDrawOpAtlas::Plot::resetRects() {
 
 GrDrawOpAtlas::GrDrawOpAtlas(GrProxyProvider* proxyProvider, const GrBackendFormat& format,
                              GrPixelConfig config, int width, int height,
-                             int plotWidth, int plotHeight, AllowMultitexturing allowMultitexturing)
+                             int plotWidth, int plotHeight, AllowMultitexturing allowMultitexturing,
+                             int maxPages)
         : fFormat(format)
         , fPixelConfig(config)
         , fTextureWidth(width)
@@ -190,7 +192,8 @@ GrDrawOpAtlas::GrDrawOpAtlas(GrProxyProvider* proxyProvider, const GrBackendForm
         , fPlotHeight(plotHeight)
         , fAtlasGeneration(kInvalidAtlasGeneration + 1)
         , fPrevFlushToken(GrDeferredUploadToken::AlreadyFlushedToken())
-        , fMaxPages(AllowMultitexturing::kYes == allowMultitexturing ? kMaxMultitexturePages : 1)
+        , fMaxPages(AllowMultitexturing::kYes == allowMultitexturing
+                            ? SkTPin(maxPages, 1, kMaxPages) : 1)
         , fNumActivePages(0) {
     int numPlotsX = width/plotWidth;
     int numPlotsY = height/plotHeight;
@@ -282,22 +285,30 @@ GrDrawOpAtlas::ErrorCode GrDrawOpAtlas::addToAtlas(GrResourceProvider* resourceP
     // flushed to the gpu if we're at max page allocation, or if the plot has aged out otherwise.
     // We wait until we've grown to the full number of pages to begin evicting already flushed
     // plots so that we can maximize the opportunity for reuse.
-    // As before we prioritize this upload to the first pages, not the most recently used.
+    // Of those, evict the one whose last use is oldest; with many pages the LRU plot of the first
+    // page may well have been used in the previous flush while a later page holds stale data.
+    // Ties go to the first pages, as above.
     if (fNumActivePages == this->maxPages()) {
+        Plot* plot = nullptr;
         for (unsigned int pageIdx = 0; pageIdx < fNumActivePages; ++pageIdx) {
-            Plot* plot = fPages[pageIdx].fPlotList.tail();
-            SkASSERT(plot);
-            if (plot->lastUseToken() < target->tokenTracker()->nextTokenToFlush()) {
-                this->processEvictionAndResetRects(plot);
-                SkASSERT(GrBytesPerPixel(fProxies[pageIdx]->config()) == plot->bpp());
-                SkDEBUGCODE(bool verify = )plot->addSubImage(width, height, image, loc);
-                SkASSERT(verify);
-                if (!this->updatePlot(target, id, plot)) {
-                    return ErrorCode::kError;
-                }
-                return ErrorCode::kSucceeded;
+            Plot* currentPlot = fPages[pageIdx].fPlotList.tail();
+            SkASSERT(currentPlot);
+            if (currentPlot->lastUseToken() < target->tokenTracker()->nextTokenToFlush() &&
+                (!plot || currentPlot->lastUseToken() < plot->lastUseToken())) {
+                plot = currentPlot;
             }
         }
+        if (plot) {
+            this->processEvictionAndResetRects(plot);
+            SkASSERT(GrBytesPerPixel(fProxies[GetPageIndexFromID(plot->id())]->config()) ==
+                     plot->bpp());
+            SkDEBUGCODE(bool verify = )plot->addSubImage(width, height, image, loc);
+            SkASSERT(verify);
+            if (!this->updatePlot(target, id, plot)) {
+                return ErrorCode::kError;
+            }
+            return ErrorCode::kSucceeded;
+        }
     } else {
         // If we haven't activated all the available pages, try to create a new one and add to it
         if (!this->activateNewPage(resourceProvider)) {
@@ -15,6 +15,7 @@
 #include "SkSize.h"
 #include "SkTDArray.h"
 #include "SkTInternalLList.h"
+#include "SkTo.h"
 
 #include "ops/GrDrawOp.h"
 
@@ -48,14 +49,33 @@ class GrRectanizer;
  * and passes in the given GrDrawUploadToken.
  */
 class GrDrawOpAtlas {
-private:
-    static constexpr auto kMaxMultitexturePages = 4;
-
-
 public:
     /** Is the atlas allowed to use more than one texture? */
     enum class AllowMultitexturing : bool { kNo, kYes };
 
+    /**
+     * The page index of an entry is packed into the low kPageIndexBits of both its u and v texel
+     * coordinates (the high half of the index in u, the low half in v), which bounds the number
+     * of pages an atlas can have.
+     */
+    static constexpr int kPageIndexBits = 2;
+    static constexpr int kMaxPages = 1 << (2 * kPageIndexBits);
+    /** The page count used when multitexturing is allowed and no other count is requested. */
+    static constexpr int kDefaultMaxPages = 4;
+
+    static uint16_t PackU(int u, uint32_t pageIdx) {
+        SkASSERT(pageIdx < kMaxPages);
+        return SkToU16(u << kPageIndexBits | pageIdx >> kPageIndexBits);
+    }
+    static uint16_t PackV(int v, uint32_t pageIdx) {
+        SkASSERT(pageIdx < kMaxPages);
+        return SkToU16(v << kPageIndexBits | (pageIdx & ((1 << kPageIndexBits) - 1)));
+    }
+    static uint16_t UnpackTexel(uint16_t coord) { return coord >> kPageIndexBits; }
+    static uint16_t UnpackPageBits(uint16_t coord) {
+        return coord & ((1 << kPageIndexBits) - 1);
+    }
+
     static constexpr int kMaxPlots = 32; // restricted by the fPlotAlreadyUpdated bitfield
                                          // in BulkUseTokenUpdater
 
@@ -89,6 +109,8 @@ public:
      *                          evict data
      *  @param data             User supplied data which will be passed into func whenever an
      *                          eviction occurs
+     *  @param maxPages         The most textures the atlas may grow to if multitexturing is
+     *                          allowed, at most kMaxPages
      *  @return                 An initialized GrDrawOpAtlas, or nullptr if creation fails
      */
     static std::unique_ptr<GrDrawOpAtlas> Make(GrProxyProvider*,
@@ -97,7 +119,8 @@ public:
                                                int width, int height,
                                                int plotWidth, int plotHeight,
                                                AllowMultitexturing allowMultitexturing,
-                                               GrDrawOpAtlas::EvictionFunc func, void* data);
+                                               GrDrawOpAtlas::EvictionFunc func, void* data,
+                                               int maxPages = kDefaultMaxPages);
 
     /**
      * Adds a width x height subimage to the atlas. Upon success it returns 'kSucceeded' and returns
@@ -210,8 +233,8 @@ public:
 
         static constexpr int kMinItems = 4;
         SkSTArray<kMinItems, PlotData, true> fPlotsToUpdate;
-        uint32_t fPlotAlreadyUpdated[kMaxMultitexturePages]; // TODO: increase this to uint64_t
-                                                             //       to allow more plots per page
+        uint32_t fPlotAlreadyUpdated[kMaxPages]; // TODO: increase this to uint64_t
+                                                 //       to allow more plots per page
 
         friend class GrDrawOpAtlas;
     };
@@ -248,7 +271,7 @@ public:
 private:
     GrDrawOpAtlas(GrProxyProvider*, const GrBackendFormat& format, GrPixelConfig, int width,
                   int height, int plotWidth, int plotHeight,
-                  AllowMultitexturing allowMultitexturing);
+                  AllowMultitexturing allowMultitexturing, int maxPages);
 
     /**
      * The backing GrTexture for a GrDrawOpAtlas is broken into a spatial grid of Plots. The Plots
@@ -312,7 +335,7 @@ private:
         static GrDrawOpAtlas::AtlasID CreateId(uint32_t pageIdx, uint32_t plotIdx,
                                                uint64_t generation) {
             SkASSERT(pageIdx < (1 << 8));
-            SkASSERT(pageIdx < kMaxMultitexturePages);
+            SkASSERT(pageIdx < kMaxPages);
             SkASSERT(plotIdx < (1 << 8));
             SkASSERT(generation < ((uint64_t)1 << 48));
             return generation << 16 | plotIdx << 8 | pageIdx;
@@ -410,8 +433,8 @@ private:
         PlotList fPlotList;
     };
     // proxies kept separate to make it easier to pass them up to client
-    sk_sp<GrTextureProxy> fProxies[kMaxMultitexturePages];
-    Page fPages[kMaxMultitexturePages];
+    sk_sp<GrTextureProxy> fProxies[kMaxPages];
+    Page fPages[kMaxPages];
     uint32_t fMaxPages;
 
     uint32_t fNumActivePages;
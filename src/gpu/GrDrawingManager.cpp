@@ -30,6 +30,7 @@
 #include "GrTracing.h"
 #include "SkDeferredDisplayList.h"
 #include "SkSurface_Gpu.h"
+#include "SkTime.h"
 #include "SkTTopoSort.h"
 #include "ccpr/GrCoverageCountingPathRenderer.h"
 #include "text/GrTextContext.h"
@@ -172,6 +173,14 @@ void GrDrawingManager::cleanup() {
     fSoftwarePathRenderer = nullptr;
 
     fOnFlushCBObjects.reset();
+
+    if (fPersistentBufferRing) {
+        // The fences can't be deleted once the backend context may be gone.
+        if (this->wasAbandoned()) {
+            fPersistentBufferRing->abandon();
+        }
+        fPersistentBufferRing.reset();
+    }
 }
 
 GrDrawingManager::~GrDrawingManager() {
@@ -230,6 +239,9 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy* proxy,
     }
 
     fFlushing = true;
+#if GR_GPU_STATS
+    double flushStartMs = SkTime::GetMSecs();
+#endif
 
     auto resourceProvider = direct->priv().resourceProvider();
     auto resourceCache = direct->priv().getResourceCache();
@@ -248,9 +260,11 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy* proxy,
         // buffer object. Each pool only requires one staging buffer at a time.
         int maxCachedBuffers = fContext->priv().caps()->preferClientSideDynamicBuffers() ? 2 : 6;
         fCpuBufferCache = GrBufferAllocPool::CpuBufferCache::Make(maxCachedBuffers);
+        fPersistentBufferRing = GrBufferAllocPool::PersistentBufferRing::Make(gpu);
     }
 
-    GrOpFlushState flushState(gpu, resourceProvider, &fTokenTracker, fCpuBufferCache);
+    GrOpFlushState flushState(gpu, resourceProvider, &fTokenTracker, fCpuBufferCache,
+                              fPersistentBufferRing);
 
     GrOnFlushResourceProvider onFlushProvider(this);
     // TODO: AFAICT the only reason fFlushState is on GrDrawingManager rather than on the
@@ -345,9 +359,19 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy* proxy,
     opMemoryPool->isEmpty();
 #endif
 
+#if GR_GPU_STATS
+    double submitStartMs = SkTime::GetMSecs();
+    gpu->stats()->addFlushPrepareMs(submitStartMs - flushStartMs);
+#endif
     GrSemaphoresSubmitted result = gpu->finishFlush(proxy, access, flags, numSemaphores,
                                                     backendSemaphores, finishedProc,
                                                     finishedContext);
+#if GR_GPU_STATS
+    gpu->stats()->addSubmitMs(SkTime::GetMSecs() - submitStartMs);
+#endif
+    if (fPersistentBufferRing) {
+        fPersistentBufferRing->endFlush();
+    }
 
     flushState.deinstantiateProxyTracker()->deinstantiateAllProxies();
 
@@ -415,6 +439,11 @@ bool GrDrawingManager::executeOpLists(int startIndex, int stopIndex, GrOpFlushSt
         // TODO: handle this instantiation via lazy surface proxies?
         // Instantiate all deferred proxies (being built on worker threads) so we can upload them
         opList->instantiateDeferredProxies(resourceProvider);
+        // OpLists are prepared one at a time even when the DAG has no edge between them: ops
+        // write into the shared flush state's vertex and upload buffers and into atlases shared
+        // across opLists, and none of those are thread-safe. CPU work that can run in parallel is
+        // instead moved to worker threads when ops are recorded (software path masks, small path
+        // distance fields) and only waited on here.
         opList->prepare(flushState);
     }
 
@@ -508,6 +537,12 @@ GrSemaphoresSubmitted GrDrawingManager::prepareSurfaceForExternalIO(
         return result;
     }
 
+    // A texture still being filled by a worker thread won't be uploaded by an op list before the
+    // client gets it, so upload it now.
+    if (GrTextureProxy* textureProxy = proxy->asTextureProxy()) {
+        textureProxy->texPriv().uploadDeferredNow(gpu);
+    }
+
     GrSurface* surface = proxy->peekSurface();
     if (auto* rt = surface->asRenderTarget()) {
         gpu->resolveRenderTarget(rt);
@@ -638,10 +673,11 @@ sk_sp<GrRenderTargetOpList> GrDrawingManager::newRTOpList(GrRenderTargetProxy* r
     }
 
     sk_sp<GrRenderTargetOpList> opList(new GrRenderTargetOpList(
-                                                        resourceProvider,
-                                                        fContext->priv().refOpMemoryPool(),
-                                                        rtp,
-                                                        fContext->priv().auditTrail()));
+                                                    resourceProvider,
+                                                    fContext->priv().refOpMemoryPool(),
+                                                    rtp,
+                                                    fContext->priv().auditTrail(),
+                                                    fContext->priv().options().fUnboundedOpMerging));
     SkASSERT(rtp->getLastOpList() == opList.get());
 
     if (managedOpList) {
@@ -176,6 +176,7 @@ private:
     // This cache is used by both the vertex and index pools. It reuses memory across multiple
     // flushes.
     sk_sp<GrBufferAllocPool::CpuBufferCache> fCpuBufferCache;
+    sk_sp<GrBufferAllocPool::PersistentBufferRing> fPersistentBufferRing;
 
     OpListDAG                         fDAG;
     GrOpList*                         fActiveOpList = nullptr;
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrFilePersistentCache.h"
+
+#include "SkExecutor.h"
+#include "SkMakeUnique.h"
+#include "SkOpts.h"
+#include "SkStream.h"
+#include "SkTaskGroup.h"
+
+#include <stdio.h>
+
+// File layout, all little-endian uint32_t fields, each blob padded to 4 bytes:
+//   kMagic, kVersion, count,
+//   count x { keySize, dataSize, key bytes, data bytes }
+static constexpr uint32_t kMagic   = 0x63706b73;  // 'skpc'
+static constexpr uint32_t kVersion = 1;
+
+size_t GrFilePersistentCache::Hash::operator()(const Key& key) const {
+    return SkOpts::hash_fn(key.fKey->data(), key.fKey->size(), 0);
+}
+
+GrFilePersistentCache::GrFilePersistentCache(const char path[]) : fPath(path) {}
+
+GrFilePersistentCache::~GrFilePersistentCache() {
+    if (fPreload) {
+        fPreload->wait();
+    }
+}
+
+void GrFilePersistentCache::readFile() {
+    // SkData::MakeFromFileName() mmaps the file, so every entry below is a view into the mapping.
+    sk_sp<SkData> file = SkData::MakeFromFileName(fPath.c_str());
+    if (!file) {
+        return;
+    }
+
+    const size_t size = file->size();
+    auto read_u32 = [&](size_t offset, uint32_t* value) {
+        if (offset > size || size - offset < sizeof(uint32_t)) {
+            return false;
+        }
+        memcpy(value, file->bytes() + offset, sizeof(uint32_t));
+        return true;
+    };
+
+    uint32_t magic, version, count;
+    if (!read_u32(0, &magic) || magic != kMagic ||
+        !read_u32(4, &version) || version != kVersion ||
+        !read_u32(8, &count)) {
+        return;
+    }
+
+    SkAutoExclusive lock(fMutex);
+    size_t offset = 12;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t keySize, dataSize;
+        if (!read_u32(offset, &keySize) || !read_u32(offset + 4, &dataSize)) {
+            break;
+        }
+        offset += 8;
+
+        size_t paddedKeySize  = SkAlign4(keySize),
+               paddedDataSize = SkAlign4(dataSize);
+        if (size - offset < paddedKeySize || size - offset - paddedKeySize < paddedDataSize) {
+            break;  // Truncated or corrupt; keep what we've read so far.
+        }
+
+        Key key(SkData::MakeSubset(file.get(), offset, keySize));
+        sk_sp<SkData> data = SkData::MakeSubset(file.get(), offset + paddedKeySize, dataSize);
+        offset += paddedKeySize + paddedDataSize;
+
+        // Anything stored before we finished reading is newer than the file.
+        fMap.emplace(std::move(key), std::move(data));
+    }
+}
+
+void GrFilePersistentCache::preload(SkExecutor* executor) {
+    if (!executor) {
+        this->ensureIndexed();
+        return;
+    }
+    {
+        SkAutoExclusive lock(fMutex);
+        if (fPreload) {
+            return;
+        }
+        fPreload = skstd::make_unique<SkTaskGroup>(*executor);
+    }
+    fPreload->add([this] {
+        this->ensureIndexed();
+
+        // Fault in every page now, rather than when a GrContext first needs the program.
+        SkAutoExclusive lock(fMutex);
+        uint32_t sum = 0;
+        for (const auto& entry : fMap) {
+            const uint8_t* bytes = entry.second->bytes();
+            for (size_t i = 0; i < entry.second->size(); i += 4096) {
+                sum += bytes[i];
+            }
+        }
+        sk_ignore_unused_variable(sum);
+    });
+}
+
+sk_sp<SkData> GrFilePersistentCache::load(const SkData& key) {
+    this->ensureIndexed();
+
+    Key lookup(SkData::MakeWithoutCopy(key.data(), key.size()));
+    SkAutoExclusive lock(fMutex);
+    auto result = fMap.find(lookup);
+    return result == fMap.end() ? nullptr : result->second;
+}
+
+void GrFilePersistentCache::store(const SkData& key, const SkData& data) {
+    this->ensureIndexed();
+
+    Key copy(SkData::MakeWithCopy(key.data(), key.size()));
+    SkAutoExclusive lock(fMutex);
+    fMap[std::move(copy)] = SkData::MakeWithCopy(data.data(), data.size());
+    fDirty = true;
+}
+
+int GrFilePersistentCache::count() {
+    this->ensureIndexed();
+
+    SkAutoExclusive lock(fMutex);
+    return SkToInt(fMap.size());
+}
+
+bool GrFilePersistentCache::flush() {
+    this->ensureIndexed();
+
+    SkAutoExclusive lock(fMutex);
+    if (!fDirty) {
+        return true;
+    }
+
+    // Our entries may point into the mapped file, so write somewhere else and swap it in after.
+    SkString tmpPath = SkStringPrintf("%s.tmp", fPath.c_str());
+    {
+        SkFILEWStream stream(tmpPath.c_str());
+        if (!stream.isValid()) {
+            return false;
+        }
+
+        static const uint8_t kZeros[4] = {0, 0, 0, 0};
+        auto write_padded = [&](const SkData& blob) {
+            return stream.write(blob.data(), blob.size()) &&
+                   stream.write(kZeros, SkAlign4(blob.size()) - blob.size());
+        };
+
+        bool ok = stream.write32(kMagic) &&
+                  stream.write32(kVersion) &&
+                  stream.write32(SkToU32(fMap.size()));
+        for (const auto& entry : fMap) {
+            ok = ok && stream.write32(SkToU32(entry.first.fKey->size()))
+                    && stream.write32(SkToU32(entry.second->size()))
+                    && write_padded(*entry.first.fKey)
+                    && write_padded(*entry.second);
+        }
+        if (!ok) {
+            return false;
+        }
+        stream.fsync();
+    }
+
+    if (0 != rename(tmpPath.c_str(), fPath.c_str())) {
+        return false;
+    }
+    fDirty = false;
+    return true;
+}
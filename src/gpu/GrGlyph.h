@@ -19,11 +19,16 @@
 struct GrGlyph {
     enum MaskStyle {
         kCoverage_MaskStyle,
-        kDistance_MaskStyle
+        kDistance_MaskStyle,
+        // A distance field per edge color, stored in the RGB channels of the ARGB atlas
+        kMultiChannelDistance_MaskStyle
     };
 
     static GrMaskFormat FormatFromSkGlyph(const SkGlyph& glyph) {
-        SkMask::Format format = static_cast<SkMask::Format>(glyph.fMaskFormat);
+        return FormatFromSkMaskFormat(static_cast<SkMask::Format>(glyph.fMaskFormat));
+    }
+
+    static GrMaskFormat FormatFromSkMaskFormat(SkMask::Format format) {
         switch (format) {
             case SkMask::kBW_Format:
             case SkMask::kSDF_Format:
@@ -49,16 +54,18 @@ struct GrGlyph {
                                    glyph.fHeight);
     }
 
-    static MaskStyle MaskStyleFromSkGlyph(const SkGlyph& skGlyph) {
-        return (SkMask::Format)skGlyph.fMaskFormat == SkMask::kSDF_Format
-           ? GrGlyph::MaskStyle::kDistance_MaskStyle
-           : GrGlyph::MaskStyle::kCoverage_MaskStyle;
+    static MaskStyle MaskStyleFromSkGlyph(const SkGlyph& skGlyph, bool multiChannel) {
+        if ((SkMask::Format)skGlyph.fMaskFormat != SkMask::kSDF_Format) {
+            return GrGlyph::MaskStyle::kCoverage_MaskStyle;
+        }
+        return multiChannel ? GrGlyph::MaskStyle::kMultiChannelDistance_MaskStyle
+                            : GrGlyph::MaskStyle::kDistance_MaskStyle;
     }
 
-    GrGlyph(const SkGlyph& skGlyph)
+    GrGlyph(const SkGlyph& skGlyph, bool multiChannelDistanceField = false)
         : fPackedID{skGlyph.getPackedID()}
         , fMaskFormat{FormatFromSkGlyph(skGlyph)}
-        , fMaskStyle{MaskStyleFromSkGlyph(skGlyph)}
+        , fMaskStyle{MaskStyleFromSkGlyph(skGlyph, multiChannelDistanceField)}
         , fBounds{BoundsFromSkGlyph(skGlyph)} {}
 
 
@@ -90,6 +97,11 @@ struct GrGlyph {
     int height() const { return fBounds.height(); }
     uint32_t pageIndex() const { return GrDrawOpAtlas::GetPageIndexFromID(fID); }
     MaskStyle maskStyle() const { return fMaskStyle; }
+    // The atlas holding the glyph's image. fMaskFormat still decides the vertex layout, which for
+    // a multi-channel distance field is the same as for an ordinary one.
+    GrMaskFormat atlasFormat() const {
+        return kMultiChannelDistance_MaskStyle == fMaskStyle ? kARGB_GrMaskFormat : fMaskFormat;
+    }
 
     // GetKey and Hash for the the hash table.
     static const SkPackedGlyphID& GetKey(const GrGlyph& glyph) {
@@ -106,6 +118,9 @@ struct GrGlyph {
     const GrIRect16        fBounds;
     SkIPoint16             fAtlasLocation{0, 0};
     GrDrawOpAtlas::AtlasID fID{GrDrawOpAtlas::kInvalidAtlasID};
+    // A copy of the glyph's image in fMaskFormat, with rows packed tightly. It's taken while
+    // recording into a DDL, so that replay can add the glyph to the atlas without the SkStrike.
+    const void*            fImage{nullptr};
 };
 
 #endif
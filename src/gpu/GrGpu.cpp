@@ -8,6 +8,7 @@
 
 #include "GrGpu.h"
 
+#include "GrAsyncReadManager.h"
 #include "GrBackendSemaphore.h"
 #include "GrBackendSurface.h"
 #include "GrCaps.h"
@@ -15,6 +16,7 @@
 #include "GrContextPriv.h"
 #include "GrGpuResourcePriv.h"
 #include "GrMesh.h"
+#include "GrOpTimer.h"
 #include "GrPathRendering.h"
 #include "GrPipeline.h"
 #include "GrRenderTargetPriv.h"
@@ -40,7 +42,36 @@ GrGpu::GrGpu(GrContext* context)
 
 GrGpu::~GrGpu() {}
 
-void GrGpu::disconnect(DisconnectType) {}
+void GrGpu::disconnect(DisconnectType type) {
+    if (fOpTimer && DisconnectType::kAbandon == type) {
+        fOpTimer->abandon();
+    }
+    fOpTimer.reset();
+    if (fAsyncReadManager) {
+        fAsyncReadManager->failAll(DisconnectType::kAbandon == type);
+    }
+}
+
+GrAsyncReadManager* GrGpu::asyncReadManager() {
+    if (!fAsyncReadManager) {
+        fAsyncReadManager.reset(new GrAsyncReadManager(this));
+    }
+    return fAsyncReadManager.get();
+}
+
+bool GrGpu::setOpTimingEnabled(bool enabled) {
+    if (!enabled) {
+        fOpTimer.reset();
+        return true;
+    }
+    if (!this->caps()->timestampQuerySupport()) {
+        return false;
+    }
+    if (!fOpTimer) {
+        fOpTimer.reset(new GrOpTimer(this));
+    }
+    return true;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -330,6 +361,32 @@ bool GrGpu::transferPixels(GrTexture* texture, int left, int top, int width, int
     return false;
 }
 
+bool GrGpu::transferPixelsFrom(GrSurface* surface, int left, int top, int width, int height,
+                               GrColorType dstColorType, GrGpuBuffer* transferBuffer,
+                               size_t offset) {
+    SkASSERT(surface);
+    SkASSERT(transferBuffer);
+
+    // We require that the read region is contained in the surface
+    SkIRect subRect = SkIRect::MakeXYWH(left, top, width, height);
+    SkIRect bounds = SkIRect::MakeWH(surface->width(), surface->height());
+    if (!bounds.contains(subRect)) {
+        return false;
+    }
+    if (offset + GrColorTypeBytesPerPixel(dstColorType) * width * height >
+        transferBuffer->size()) {
+        return false;
+    }
+
+    this->handleDirtyContext();
+    if (this->onTransferPixelsFrom(surface, left, top, width, height, dstColorType,
+                                   transferBuffer, offset)) {
+        fStats.incTransfersFromSurface();
+        return true;
+    }
+    return false;
+}
+
 bool GrGpu::regenerateMipMapLevels(GrTexture* texture) {
     SkASSERT(texture);
     SkASSERT(this->caps()->mipMapSupport());
@@ -425,6 +482,9 @@ GrSemaphoresSubmitted GrGpu::finishFlush(GrSurfaceProxy* proxy,
     this->onFinishFlush(proxy, access, flags,
                         (numSemaphores > 0 && this->caps()->fenceSyncSupport()),
                         finishedProc, finishedContext);
+    if (fAsyncReadManager) {
+        fAsyncReadManager->check(false);
+    }
     return this->caps()->fenceSyncSupport() ? GrSemaphoresSubmitted::kYes
                                             : GrSemaphoresSubmitted::kNo;
 }
@@ -460,8 +520,18 @@ void GrGpu::Stats::dump(SkString* out) {
     out->appendf("Textures Created: %d\n", fTextureCreates);
     out->appendf("Texture Uploads: %d\n", fTextureUploads);
     out->appendf("Transfers to Texture: %d\n", fTransfersToTexture);
+    out->appendf("Transfers from Surface: %d\n", fTransfersFromSurface);
     out->appendf("Stencil Buffer Creates: %d\n", fStencilAttachmentCreates);
     out->appendf("Number of draws: %d\n", fNumDraws);
+    out->appendf("Number of op executions: %d\n", fNumOpExecutions);
+    out->appendf("Pipeline State Cache Hits: %d\n", fPipelineStateCacheHits);
+    out->appendf("Pipeline State Cache Misses: %d\n", fPipelineStateCacheMisses);
+    out->appendf("Redundant Calls Skipped: %d\n", fRedundantCallsSkipped);
+    out->appendf("Texture Cache Hits: %d\n", fTextureCacheHits);
+    out->appendf("Texture Cache Misses: %d\n", fTextureCacheMisses);
+    out->appendf("Atlas Uploads: %d\n", fAtlasUploads);
+    out->appendf("Flush Prepare ms: %.3f\n", fFlushPrepareMs);
+    out->appendf("Submit ms: %.3f\n", fSubmitMs);
 }
 
 void GrGpu::Stats::dumpKeyValuePairs(SkTArray<SkString>* keys, SkTArray<double>* values) {
@@ -470,6 +540,15 @@ void GrGpu::Stats::dumpKeyValuePairs(SkTArray<SkString>* keys, SkTArray<double>*
     keys->push_back(SkString("texture_uploads")); values->push_back(fTextureUploads);
     keys->push_back(SkString("number_of_draws")); values->push_back(fNumDraws);
     keys->push_back(SkString("number_of_failed_draws")); values->push_back(fNumFailedDraws);
+    keys->push_back(SkString("number_of_op_executions")); values->push_back(fNumOpExecutions);
+    keys->push_back(SkString("pipeline_state_cache_hits"));
+    values->push_back(fPipelineStateCacheHits);
+    keys->push_back(SkString("pipeline_state_cache_misses"));
+    values->push_back(fPipelineStateCacheMisses);
+    keys->push_back(SkString("redundant_calls_skipped")); values->push_back(fRedundantCallsSkipped);
+    keys->push_back(SkString("texture_cache_hits")); values->push_back(fTextureCacheHits);
+    keys->push_back(SkString("texture_cache_misses")); values->push_back(fTextureCacheMisses);
+    keys->push_back(SkString("atlas_uploads")); values->push_back(fAtlasUploads);
 }
 
 #endif
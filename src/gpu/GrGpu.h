@@ -22,6 +22,7 @@
 #include "SkTArray.h"
 #include <map>
 
+class GrAsyncReadManager;
 class GrBackendRenderTarget;
 class GrBackendSemaphore;
 class GrGpuBuffer;
@@ -29,6 +30,7 @@ class GrContext;
 struct GrContextOptions;
 class GrGLContext;
 class GrMesh;
+class GrOpTimer;
 class GrPath;
 class GrPathRenderer;
 class GrPathRendererChain;
@@ -41,6 +43,7 @@ class GrStencilAttachment;
 class GrStencilSettings;
 class GrSurface;
 class GrTexture;
+class SkData;
 class SkJSONWriter;
 
 class GrGpu : public SkRefCnt {
@@ -227,6 +230,25 @@ public:
                         GrColorType bufferColorType, GrGpuBuffer* transferBuffer, size_t offset,
                         size_t rowBytes);
 
+    /**
+     * Reads a rectangle of pixels from a surface into a GrGpuBuffer without waiting for the GPU.
+     * The rows are tightly packed in the buffer starting at offset. The data is only valid once
+     * the work has been submitted and has completed, e.g. after a fence inserted after it has
+     * passed. Returns false if the backend can't do this for the surface, in which case the
+     * caller should fall back to readPixels().
+     *
+     * @param surface          The surface to read from. Reads happen as if it were top-left.
+     * @param left             left edge of the rectangle to read (inclusive)
+     * @param top              top edge of the rectangle to read (inclusive)
+     * @param width            width of rectangle to read in pixels.
+     * @param height           height of rectangle to read in pixels.
+     * @param dstColorType     the color type to write into the buffer.
+     * @param transferBuffer   GrBuffer to write pixels to (type must be "kXferGpuToCpu")
+     * @param offset           offset from the start of the buffer
+     */
+    bool transferPixelsFrom(GrSurface* surface, int left, int top, int width, int height,
+                            GrColorType dstColorType, GrGpuBuffer* transferBuffer, size_t offset);
+
     // After the client interacts directly with the 3D context state the GrGpu
     // must resync its internal state and assumptions about 3D context state.
     // Each time this occurs the GrGpu bumps a timestamp.
@@ -324,10 +346,20 @@ public:
             fTextureCreates = 0;
             fTextureUploads = 0;
             fTransfersToTexture = 0;
+            fTransfersFromSurface = 0;
             fStencilAttachmentCreates = 0;
             fNumDraws = 0;
             fNumFailedDraws = 0;
             fNumFinishFlushes = 0;
+            fNumOpExecutions = 0;
+            fPipelineStateCacheHits = 0;
+            fPipelineStateCacheMisses = 0;
+            fRedundantCallsSkipped = 0;
+            fTextureCacheHits = 0;
+            fTextureCacheMisses = 0;
+            fAtlasUploads = 0;
+            fFlushPrepareMs = 0;
+            fSubmitMs = 0;
         }
 
         int renderTargetBinds() const { return fRenderTargetBinds; }
@@ -340,10 +372,34 @@ public:
         void incTextureUploads() { fTextureUploads++; }
         int transfersToTexture() const { return fTransfersToTexture; }
         void incTransfersToTexture() { fTransfersToTexture++; }
+        int transfersFromSurface() const { return fTransfersFromSurface; }
+        void incTransfersFromSurface() { fTransfersFromSurface++; }
         void incStencilAttachmentCreates() { fStencilAttachmentCreates++; }
         void incNumDraws() { fNumDraws++; }
         void incNumFailedDraws() { ++fNumFailedDraws; }
         void incNumFinishFlushes() { ++fNumFinishFlushes; }
+        void incNumOpExecutions() { ++fNumOpExecutions; }
+        int pipelineStateCacheHits() const { return fPipelineStateCacheHits; }
+        void incPipelineStateCacheHits() { ++fPipelineStateCacheHits; }
+        int pipelineStateCacheMisses() const { return fPipelineStateCacheMisses; }
+        void incPipelineStateCacheMisses() { ++fPipelineStateCacheMisses; }
+        // Backend API calls not made because they would not have changed any state.
+        int redundantCallsSkipped() const { return fRedundantCallsSkipped; }
+        void incRedundantCallsSkipped() { ++fRedundantCallsSkipped; }
+        // Lookups of uniquely keyed textures, e.g. uploaded images and cached masks.
+        int textureCacheHits() const { return fTextureCacheHits; }
+        void incTextureCacheHits() { ++fTextureCacheHits; }
+        int textureCacheMisses() const { return fTextureCacheMisses; }
+        void incTextureCacheMisses() { ++fTextureCacheMisses; }
+        // Uploads made at flush time on behalf of ops, which is how the atlases are filled.
+        int atlasUploads() const { return fAtlasUploads; }
+        void incAtlasUploads() { ++fAtlasUploads; }
+        // CPU time spent in flushes preparing and executing op lists, and then submitting the
+        // resulting work to the backend.
+        double flushPrepareMs() const { return fFlushPrepareMs; }
+        void addFlushPrepareMs(double ms) { fFlushPrepareMs += ms; }
+        double submitMs() const { return fSubmitMs; }
+        void addSubmitMs(double ms) { fSubmitMs += ms; }
 #if GR_TEST_UTILS
         void dump(SkString*);
         void dumpKeyValuePairs(SkTArray<SkString>* keys, SkTArray<double>* values);
@@ -351,16 +407,27 @@ public:
         int numDraws() const { return fNumDraws; }
         int numFailedDraws() const { return fNumFailedDraws; }
         int numFinishFlushes() const { return fNumFinishFlushes; }
+        int numOpExecutions() const { return fNumOpExecutions; }
     private:
         int fRenderTargetBinds;
         int fShaderCompilations;
         int fTextureCreates;
         int fTextureUploads;
         int fTransfersToTexture;
+        int fTransfersFromSurface;
         int fStencilAttachmentCreates;
         int fNumDraws;
         int fNumFailedDraws;
         int fNumFinishFlushes;
+        int fNumOpExecutions;
+        int fPipelineStateCacheHits;
+        int fPipelineStateCacheMisses;
+        int fRedundantCallsSkipped;
+        int fTextureCacheHits;
+        int fTextureCacheMisses;
+        int fAtlasUploads;
+        double fFlushPrepareMs;
+        double fSubmitMs;
 #else
 
 #if GR_TEST_UTILS
@@ -372,10 +439,20 @@ public:
         void incTextureCreates() {}
         void incTextureUploads() {}
         void incTransfersToTexture() {}
+        void incTransfersFromSurface() {}
         void incStencilAttachmentCreates() {}
         void incNumDraws() {}
         void incNumFailedDraws() {}
         void incNumFinishFlushes() {}
+        void incNumOpExecutions() {}
+        void incPipelineStateCacheHits() {}
+        void incPipelineStateCacheMisses() {}
+        void incRedundantCallsSkipped() {}
+        void incTextureCacheHits() {}
+        void incTextureCacheMisses() {}
+        void incAtlasUploads() {}
+        void addFlushPrepareMs(double) {}
+        void addSubmitMs(double) {}
 #endif
     };
 
@@ -463,6 +540,32 @@ public:
 
     virtual void storeVkPipelineCacheData() {}
 
+    /**
+     * Compiles the program for a key the context's PersistentCache holds data for, ahead of the
+     * first draw that needs it. See GrContext::precompile().
+     */
+    virtual bool precompile(const SkData&) { return false; }
+
+    /**
+     * Turns timing of the GPU work of each op on or off, see GrContext::setOpTimingEnabled().
+     * Returns false if the caps don't have timestampQuerySupport().
+     */
+    bool setOpTimingEnabled(bool enabled);
+
+    // Null unless op timing is enabled.
+    GrOpTimer* opTimer() { return fOpTimer.get(); }
+
+    // Tracks the buffers of asynchronous pixel reads until their fences pass.
+    GrAsyncReadManager* asyncReadManager();
+
+    // Timestamp queries for GrOpTimer. insertTimestampQuery() returns 0 if no query was made.
+    // getTimestampQueryResult() returns false if the GPU hasn't reached the query yet.
+    virtual GrTimestampQuery insertTimestampQuery() { return 0; }
+    virtual bool getTimestampQueryResult(GrTimestampQuery, uint64_t* nanoseconds) { return false; }
+    virtual void deleteTimestampQuery(GrTimestampQuery) {}
+    // Returns true if the outstanding timestamps can't be compared anymore, and resets that state.
+    virtual bool checkTimestampQueriesDisjoint() { return false; }
+
 protected:
     // Handles cases where a surface will be updated without a call to flushRenderTarget.
     void didWriteToSurface(GrSurface* surface, GrSurfaceOrigin origin, const SkIRect* bounds,
@@ -521,6 +624,12 @@ private:
                                   GrColorType colorType, GrGpuBuffer* transferBuffer, size_t offset,
                                   size_t rowBytes) = 0;
 
+    // overridden by backend-specific derived class to perform the surface-to-buffer transfer
+    virtual bool onTransferPixelsFrom(GrSurface*, int left, int top, int width, int height,
+                                      GrColorType, GrGpuBuffer* transferBuffer, size_t offset) {
+        return false;
+    }
+
     // overridden by backend-specific derived class to perform the resolve
     virtual void onResolveRenderTarget(GrRenderTarget* target) = 0;
 
@@ -553,6 +662,8 @@ private:
     // The context owns us, not vice-versa, so this ptr is not ref'ed by Gpu.
     GrContext* fContext;
     GrSamplePatternDictionary fSamplePatternDictionary;
+    std::unique_ptr<GrOpTimer> fOpTimer;
+    std::unique_ptr<GrAsyncReadManager> fAsyncReadManager;
 
     friend class GrPathRendering;
     typedef SkRefCnt INHERITED;
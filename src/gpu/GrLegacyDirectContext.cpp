@@ -94,12 +94,19 @@ protected:
             allowMultitexturing = GrDrawOpAtlas::AllowMultitexturing::kYes;
         }
 
+        // Every page is another sampler in the text shaders, so past the default count leave
+        // half of them for the clip and the paint's effects.
+        int maxPages = SkTPin(this->options().fMaxGlyphCacheTextures, 1, GrDrawOpAtlas::kMaxPages);
+        maxPages = SkTMin(maxPages,
+                          SkTMax<int>(GrDrawOpAtlas::kDefaultMaxPages,
+                                      this->caps()->shaderCaps()->maxFragmentSamplers() / 2));
+
         GrStrikeCache* glyphCache = this->priv().getGrStrikeCache();
         GrProxyProvider* proxyProvider = this->priv().proxyProvider();
 
         fAtlasManager = new GrAtlasManager(proxyProvider, glyphCache,
                                            this->options().fGlyphCacheTextureMaximumBytes,
-                                           allowMultitexturing);
+                                           allowMultitexturing, maxPages);
         this->priv().addOnFlushCallbackObject(fAtlasManager);
 
         return true;
@@ -18,11 +18,22 @@
     #define VALIDATE
 #endif
 
+GrOpMemoryPool::~GrOpMemoryPool() {
+    if (fBulkRelease) {
+        SkASSERT(0 == fLiveCount);
+        fMemoryPool.releaseAll();
+    }
+}
+
 void GrOpMemoryPool::release(std::unique_ptr<GrOp> op) {
     GrOp* tmp = op.release();
     SkASSERT(tmp);
     tmp->~GrOp();
-    fMemoryPool.release(tmp);
+    SkASSERT(fLiveCount > 0);
+    --fLiveCount;
+    if (!fBulkRelease) {
+        fMemoryPool.release(tmp);
+    }
 }
 
 constexpr size_t GrMemoryPool::kSmallestMinAllocSize;
@@ -148,6 +159,26 @@ void GrMemoryPool::release(void* p) {
     VALIDATE;
 }
 
+void GrMemoryPool::releaseAll() {
+    VALIDATE;
+    BlockHeader* block = fHead->fNext;
+    while (block) {
+        BlockHeader* next = block->fNext;
+        DeleteBlock(block);
+        block = next;
+    }
+    fHead->fNext = nullptr;
+    fHead->fCurrPtr = reinterpret_cast<intptr_t>(fHead) + kHeaderSize;
+    fHead->fLiveCount = 0;
+    fHead->fFreeSize = fHead->fSize - kHeaderSize;
+    fTail = fHead;
+    fSize = 0;
+    SkDEBUGCODE(fAllocationCnt = 0);
+    SkDEBUGCODE(fAllocBlockCnt = 0);
+    SkDEBUGCODE(fAllocatedIDs.reset());
+    VALIDATE;
+}
+
 GrMemoryPool::BlockHeader* GrMemoryPool::CreateBlock(size_t blockSize) {
     blockSize = SkTMax<size_t>(blockSize, kHeaderSize);
     BlockHeader* block =
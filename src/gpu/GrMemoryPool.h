@@ -51,6 +51,12 @@ public:
      */
     void release(void* p);
 
+    /**
+     * Releases every outstanding allocation at once and frees all but the preallocated block.
+     * Nothing is destructed, so any objects in the pool must already have been.
+     */
+    void releaseAll();
+
     /**
      * Returns true if there are no unreleased allocations.
      */
@@ -130,26 +136,39 @@ class GrOp;
 // ref counting
 class GrOpMemoryPool : public SkRefCnt {
 public:
-    GrOpMemoryPool(size_t preallocSize, size_t minAllocSize)
-            : fMemoryPool(preallocSize, minAllocSize) {
+    /**
+     * When bulkRelease is true, release() only destructs ops and the memory is returned all at
+     * once when the pool is destroyed. Each DDL recorder has its own pool, so it is only ever
+     * used from one thread at a time, and the ops it holds all die together with the DDL.
+     */
+    GrOpMemoryPool(size_t preallocSize, size_t minAllocSize, bool bulkRelease = false)
+            : fMemoryPool(preallocSize, minAllocSize)
+            , fBulkRelease(bulkRelease) {
     }
 
+    ~GrOpMemoryPool() override;
+
     template <typename Op, typename... OpArgs>
     std::unique_ptr<Op> allocate(OpArgs&&... opArgs) {
-        char* mem = (char*) fMemoryPool.allocate(sizeof(Op));
+        char* mem = (char*) this->allocate(sizeof(Op));
         return std::unique_ptr<Op>(new (mem) Op(std::forward<OpArgs>(opArgs)...));
     }
 
     void* allocate(size_t size) {
+        ++fLiveCount;
         return fMemoryPool.allocate(size);
     }
 
     void release(std::unique_ptr<GrOp> op);
 
-    bool isEmpty() const { return fMemoryPool.isEmpty(); }
+    bool isEmpty() const { return 0 == fLiveCount; }
+
+    size_t size() const { return fMemoryPool.size(); }
 
 private:
     GrMemoryPool fMemoryPool;
+    int          fLiveCount = 0;
+    const bool   fBulkRelease;
 };
 
 #endif
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrOpBoundsGrid.h"
+
+#include "GrRect.h"
+
+GrOpBoundsGrid::GrOpBoundsGrid(int width, int height)
+        : fCols(SkTMax(1, (width  + kCellSize - 1) / kCellSize))
+        , fRows(SkTMax(1, (height + kCellSize - 1) / kCellSize)) {
+    fCells.reset(fCols * fRows);
+}
+
+SkIRect GrOpBoundsGrid::cells(const SkRect& bounds) const {
+    // Pin before converting so huge bounds can't overflow.  A point shared by two overlapping
+    // rects always lands in a cell both of them touch.
+    auto col = [this](float x) { return (int)SkTPin(x / kCellSize, 0.0f, (float)(fCols - 1)); };
+    auto row = [this](float y) { return (int)SkTPin(y / kCellSize, 0.0f, (float)(fRows - 1)); };
+    return SkIRect::MakeLTRB(col(bounds.fLeft), row(bounds.fTop),
+                             col(bounds.fRight), row(bounds.fBottom));
+}
+
+void GrOpBoundsGrid::add(const SkRect& bounds, int chainIndex) {
+    SkASSERT(bounds.isFinite());
+    SkIRect cells = this->cells(bounds);
+    for (int y = cells.fTop; y <= cells.fBottom; ++y) {
+        for (int x = cells.fLeft; x <= cells.fRight; ++x) {
+            fCells[y * fCols + x].push_back({bounds, chainIndex});
+        }
+    }
+}
+
+int GrOpBoundsGrid::lastOverlap(const SkRect& bounds) const {
+    int last = -1;
+    SkIRect cells = this->cells(bounds);
+    for (int y = cells.fTop; y <= cells.fBottom; ++y) {
+        for (int x = cells.fLeft; x <= cells.fRight; ++x) {
+            for (const Entry& entry : fCells[y * fCols + x]) {
+                if (entry.fChainIndex > last && GrRectsOverlap(entry.fBounds, bounds)) {
+                    last = entry.fChainIndex;
+                }
+            }
+        }
+    }
+    return last;
+}
+
+void GrOpBoundsGrid::reset() {
+    for (auto& cell : fCells) {
+        cell.reset();
+    }
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrOpBoundsGrid_DEFINED
+#define GrOpBoundsGrid_DEFINED
+
+#include "SkRect.h"
+#include "SkTArray.h"
+
+/**
+ * Buckets the bounds of the ops recorded into a GrRenderTargetOpList's chains by a coarse grid
+ * over the render target, so that the opList can find the latest chain a new op overlaps (and so
+ * must stay after) without walking every chain.  Bounds outside the render target land in the
+ * edge cells.
+ */
+class GrOpBoundsGrid {
+public:
+    GrOpBoundsGrid(int width, int height);
+
+    // Records that the chain at chainIndex draws within bounds.
+    void add(const SkRect& bounds, int chainIndex);
+
+    // Returns the index of the latest chain with anything recorded overlapping bounds, or -1.
+    int lastOverlap(const SkRect& bounds) const;
+
+    void reset();
+
+private:
+    static constexpr int kCellSize = 128;
+
+    struct Entry {
+        SkRect fBounds;
+        int    fChainIndex;
+    };
+
+    // The range of cells, inclusive, that bounds touches.
+    SkIRect cells(const SkRect& bounds) const;
+
+    int                                    fCols;
+    int                                    fRows;
+    SkTArray<SkTArray<Entry, true>>        fCells;
+};
+
+#endif
@@ -17,9 +17,10 @@
 
 GrOpFlushState::GrOpFlushState(GrGpu* gpu, GrResourceProvider* resourceProvider,
                                GrTokenTracker* tokenTracker,
-                               sk_sp<GrBufferAllocPool::CpuBufferCache> cpuBufferCache)
-        : fVertexPool(gpu, cpuBufferCache)
-        , fIndexPool(gpu, std::move(cpuBufferCache))
+                               sk_sp<GrBufferAllocPool::CpuBufferCache> cpuBufferCache,
+                               sk_sp<GrBufferAllocPool::PersistentBufferRing> bufferRing)
+        : fVertexPool(gpu, cpuBufferCache, bufferRing)
+        , fIndexPool(gpu, std::move(cpuBufferCache), std::move(bufferRing))
         , fGpu(gpu)
         , fResourceProvider(resourceProvider)
         , fTokenTracker(tokenTracker) {}
@@ -97,6 +98,7 @@ void GrOpFlushState::doUpload(GrDeferredTextureUploadFn& upload) {
         return this->fGpu->writePixels(dstSurface, left, top, width, height, srcColorType, buffer,
                                        rowBytes);
     };
+    fGpu->stats()->incAtlasUploads();
     upload(wp);
 }
 
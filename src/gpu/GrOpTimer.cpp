@@ -0,0 +1,118 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrOpTimer.h"
+
+#include "GrGpu.h"
+#include "GrOpTimingDump.h"
+
+GrOpTimer::~GrOpTimer() {
+    for (const OpList& opList : fPending) {
+        this->deleteQueries(opList);
+    }
+}
+
+void GrOpTimer::beginOpList() {
+    SkASSERT(!fInOpList);
+    if (fPending.size() >= kMaxPendingOpLists) {
+        this->resolve();
+    }
+    if (fPending.size() >= kMaxPendingOpLists) {
+        // The GPU is far behind, stop waiting on the oldest op list.
+        this->deleteQueries(fPending.front());
+        fPending.pop_front();
+    }
+    fPending.emplace_back();
+    fInOpList = true;
+    this->mark(nullptr);
+}
+
+void GrOpTimer::endOpChain(const char* opName) {
+    SkASSERT(fInOpList && opName);
+    this->mark(opName);
+}
+
+void GrOpTimer::endOpList(const char* opListName) {
+    SkASSERT(fInOpList && opListName);
+    this->mark(opListName);
+    fPending.back().fName = opListName;
+    fInOpList = false;
+}
+
+void GrOpTimer::mark(const char* name) {
+    if (GrTimestampQuery query = fGpu->insertTimestampQuery()) {
+        fPending.back().fMarks.push_back({query, name});
+    }
+}
+
+void GrOpTimer::resolve() {
+    // The op list being executed, if any, isn't finished yet.
+    size_t finishedCnt = fPending.size() - (fInOpList ? 1 : 0);
+    if (fGpu->checkTimestampQueriesDisjoint()) {
+        // Something like a GPU clock change happened while the queries were outstanding.
+        for (size_t i = 0; i < finishedCnt; ++i) {
+            this->deleteQueries(fPending.front());
+            fPending.pop_front();
+        }
+        return;
+    }
+    for (; finishedCnt > 0; --finishedCnt) {
+        const OpList& opList = fPending.front();
+        int markCnt = opList.fMarks.count();
+        // Timestamps complete in order, so once the last one is ready they all are.
+        uint64_t end;
+        if (markCnt > 1 && !fGpu->getTimestampQueryResult(opList.fMarks.back().fQuery, &end)) {
+            break;
+        }
+        uint64_t start, prev;
+        // A mark can be missing if its query couldn't be created. Only time whole op lists.
+        if (markCnt > 1 && opList.fMarks[0].fName == nullptr &&
+            opList.fMarks.back().fName == opList.fName &&
+            fGpu->getTimestampQueryResult(opList.fMarks[0].fQuery, &start)) {
+            prev = start;
+            for (int i = 1; i < markCnt - 1; ++i) {
+                uint64_t time;
+                if (fGpu->getTimestampQueryResult(opList.fMarks[i].fQuery, &time)) {
+                    this->addTime(opList.fMarks[i].fName, time - prev);
+                    prev = time;
+                }
+            }
+            this->addTime(opList.fName, end - start);
+        }
+        this->deleteQueries(opList);
+        fPending.pop_front();
+    }
+}
+
+void GrOpTimer::addTime(const char* name, uint64_t nanoseconds) {
+    SkString key(name);
+    Total* total = fTotals.find(key);
+    if (!total) {
+        total = fTotals.set(key, Total());
+    }
+    total->fCount++;
+    total->fNanoseconds += nanoseconds;
+}
+
+void GrOpTimer::dump(GrOpTimingDump* dump) {
+    this->resolve();
+    fTotals.foreach([dump](const SkString& name, Total* total) {
+        dump->dumpOpTiming(name.c_str(), total->fCount, total->fNanoseconds);
+    });
+    fTotals.reset();
+}
+
+void GrOpTimer::abandon() {
+    fPending.clear();
+    fInOpList = false;
+}
+
+void GrOpTimer::deleteQueries(const OpList& opList) {
+    for (const Mark& mark : opList.fMarks) {
+        fGpu->deleteTimestampQuery(mark.fQuery);
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrOpTimer_DEFINED
+#define GrOpTimer_DEFINED
+
+#include "GrTypesPriv.h"
+#include "SkString.h"
+#include "SkTArray.h"
+#include "SkTHash.h"
+
+#include <deque>
+
+class GrGpu;
+class GrOpTimingDump;
+
+/**
+ * Times the GPU work of each op chain and op list with timestamp queries written between them.
+ * Reading a timestamp back before the GPU has passed it would stall, so queries are only resolved
+ * once they have completed, and their totals are kept by op name until the next dump().
+ */
+class GrOpTimer {
+public:
+    explicit GrOpTimer(GrGpu* gpu) : fGpu(gpu) {}
+    ~GrOpTimer();
+
+    /** Marks the start of an op list's GPU work. */
+    void beginOpList();
+    /** Marks the end of an op chain in the current op list. Names must be static strings. */
+    void endOpChain(const char* opName);
+    /** Marks the end of the current op list's GPU work. */
+    void endOpList(const char* opListName);
+
+    /** Resolves the completed queries and reports the totals since the previous dump. */
+    void dump(GrOpTimingDump*);
+
+    /** Forgets the outstanding queries without deleting them, for when the context is lost. */
+    void abandon();
+
+private:
+    struct Mark {
+        GrTimestampQuery fQuery;
+        // What ran between the previous mark and this one, null for the start of an op list.
+        const char*      fName;
+    };
+
+    struct OpList {
+        SkSTArray<8, Mark> fMarks;
+        const char*        fName = nullptr;
+    };
+
+    struct Total {
+        int      fCount = 0;
+        uint64_t fNanoseconds = 0;
+    };
+
+    // When this many op lists are waiting on the GPU, resolve what's ready without a dump().
+    static constexpr size_t kMaxPendingOpLists = 256;
+
+    void mark(const char* name);
+    void resolve();
+    void addTime(const char* name, uint64_t nanoseconds);
+    void deleteQueries(const OpList&);
+
+    GrGpu*                     fGpu;
+    // Op lists in execution order. The back one is being executed if fInOpList is set.
+    std::deque<OpList>         fPending;
+    bool                       fInOpList = false;
+    SkTHashMap<SkString, Total> fTotals;
+};
+
+#endif
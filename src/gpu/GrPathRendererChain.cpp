@@ -45,6 +45,9 @@ GrPathRendererChain::GrPathRendererChain(GrRecordingContext* context, const Opti
     if (options.fGpuPathRenderers & GpuPathRenderers::kAAConvex) {
         fChain.push_back(sk_make_sp<GrAAConvexPathRenderer>());
     }
+    // CCPR is what takes complex fills off the CPU. The compute rasterizer in src/compute/skc
+    // can't be chained here yet: it only has an OpenCL 1.2 backend, is not part of the GN build,
+    // and has no way to run on a GrVkGpu's VkDevice or to composite into a render target.
     if (options.fGpuPathRenderers & GpuPathRenderers::kCoverageCounting) {
         using AllowCaching = GrCoverageCountingPathRenderer::AllowCaching;
         if (auto ccpr = GrCoverageCountingPathRenderer::CreateIfSupported(
@@ -200,6 +200,8 @@ public:
     uint32_t getBlendInfoKey() const;
 
 private:
+    friend class GrProgramDesc;  // Fills in fProcessorKeyCache.
+
     void markAsBad() { fFlags |= kIsBad_Flag; }
 
     /** This is a continuation of the public "Flags" enum. */
@@ -223,6 +225,17 @@ private:
 
     // This value is also the index in fFragmentProcessors where coverage processors begin.
     int fNumColorProcessors;
+
+    // The fragment and xfer processor part of the last program key built for this pipeline. The
+    // processors are immutable, so it can be reused by the pipeline's later draws as long as the
+    // primitive processor gives the same coord transform keys, which is all the part depends on.
+    struct ProcessorKeyCache {
+        SkSTArray<8, uint32_t, true> fTransformKeys;
+        SkTArray<uint8_t, true> fKey;
+        GrProcessor::CustomFeatures fFeatures = GrProcessor::CustomFeatures::kNone;
+        bool fValid = false;
+    };
+    mutable ProcessorKeyCache fProcessorKeyCache;
 };
 
 #endif
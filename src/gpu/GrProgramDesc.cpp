@@ -206,28 +206,48 @@ bool GrProgramDesc::Build(
     }
     GrProcessor::CustomFeatures processorFeatures = primProc.requestedFeatures();
 
-    for (int i = 0; i < pipeline.numFragmentProcessors(); ++i) {
-        const GrFragmentProcessor& fp = pipeline.getFragmentProcessor(i);
-        if (!gen_frag_proc_and_meta_keys(primProc, fp, gpu, shaderCaps, &b)) {
+    // The rest of the processor keys only depend on primProc through the coord transform keys, so
+    // if those match the last draw with this pipeline, we can reuse its keys.
+    SkSTArray<8, uint32_t, true> transformKeys;
+    for (GrFragmentProcessor::Iter iter(pipeline); const GrFragmentProcessor* fp = iter.next();) {
+        transformKeys.push_back(primProc.getTransformKey(fp->coordTransforms(),
+                                                         fp->numCoordTransforms()));
+    }
+    GrPipeline::ProcessorKeyCache& cache = pipeline.fProcessorKeyCache;
+    if (!cache.fValid || cache.fTransformKeys != transformKeys) {
+        cache.fValid = false;
+        cache.fKey.reset();
+        cache.fFeatures = GrProcessor::CustomFeatures::kNone;
+        GrProcessorKeyBuilder cacheBuilder(&cache.fKey);
+
+        for (int i = 0; i < pipeline.numFragmentProcessors(); ++i) {
+            const GrFragmentProcessor& fp = pipeline.getFragmentProcessor(i);
+            if (!gen_frag_proc_and_meta_keys(primProc, fp, gpu, shaderCaps, &cacheBuilder)) {
+                desc->key().reset();
+                return false;
+            }
+            cache.fFeatures |= fp.requestedFeatures();
+        }
+
+        const GrXferProcessor& xp = pipeline.getXferProcessor();
+        const GrSurfaceOrigin* originIfDstTexture = nullptr;
+        GrSurfaceOrigin origin;
+        if (pipeline.dstTextureProxy()) {
+            origin = pipeline.dstTextureProxy()->origin();
+            originIfDstTexture = &origin;
+        }
+        xp.getGLSLProcessorKey(shaderCaps, &cacheBuilder, originIfDstTexture);
+        if (!gen_meta_key(xp, shaderCaps, &cacheBuilder)) {
             desc->key().reset();
             return false;
         }
-        processorFeatures |= fp.requestedFeatures();
-    }
+        cache.fFeatures |= xp.requestedFeatures();
 
-    const GrXferProcessor& xp = pipeline.getXferProcessor();
-    const GrSurfaceOrigin* originIfDstTexture = nullptr;
-    GrSurfaceOrigin origin;
-    if (pipeline.dstTextureProxy()) {
-        origin = pipeline.dstTextureProxy()->origin();
-        originIfDstTexture = &origin;
-    }
-    xp.getGLSLProcessorKey(shaderCaps, &b, originIfDstTexture);
-    if (!gen_meta_key(xp, shaderCaps, &b)) {
-        desc->key().reset();
-        return false;
+        cache.fTransformKeys = transformKeys;
+        cache.fValid = true;
     }
-    processorFeatures |= xp.requestedFeatures();
+    desc->key().push_back_n(cache.fKey.count(), cache.fKey.begin());
+    processorFeatures |= cache.fFeatures;
 
     if (processorFeatures & GrProcessor::CustomFeatures::kSampleLocations) {
         SkASSERT(pipeline.isHWAntialiasState());
@@ -10,6 +10,8 @@
 #include "GrCaps.h"
 #include "GrContext.h"
 #include "GrContextPriv.h"
+#include "GrDeferredProxyUploader.h"
+#include "GrGpu.h"
 #include "GrImageContext.h"
 #include "GrImageContextPriv.h"
 #include "GrRenderTarget.h"
@@ -19,6 +21,7 @@
 #include "GrSurfaceProxyPriv.h"
 #include "GrTexture.h"
 #include "GrTextureProxyCacheAccess.h"
+#include "GrTextureProxyPriv.h"
 #include "GrTextureRenderTargetProxy.h"
 #include "../private/GrSingleOwner.h"
 #include "SkAutoPixmapStorage.h"
@@ -28,7 +31,9 @@
 #include "SkImage_Base.h"
 #include "SkImageInfoPriv.h"
 #include "SkImagePriv.h"
+#include "SkConvertPixels.h"
 #include "SkMipMap.h"
+#include "SkTaskGroup.h"
 #include "SkTraceEvent.h"
 
 #define ASSERT_SINGLE_OWNER \
@@ -162,12 +167,16 @@ sk_sp<GrTextureProxy> GrProxyProvider::findOrCreateProxyByUniqueKey(const GrUniq
         return nullptr;
     }
 
+    GrContext* direct = fImageContext->priv().asDirectContext();
+
     sk_sp<GrTextureProxy> result = this->findProxyByUniqueKey(key, origin);
     if (result) {
+        if (direct) {
+            direct->priv().getGpu()->stats()->incTextureCacheHits();
+        }
         return result;
     }
 
-    GrContext* direct = fImageContext->priv().asDirectContext();
     if (!direct) {
         return nullptr;
     }
@@ -176,8 +185,10 @@ sk_sp<GrTextureProxy> GrProxyProvider::findOrCreateProxyByUniqueKey(const GrUniq
 
     GrGpuResource* resource = resourceCache->findAndRefUniqueResource(key);
     if (!resource) {
+        direct->priv().getGpu()->stats()->incTextureCacheMisses();
         return nullptr;
     }
+    direct->priv().getGpu()->stats()->incTextureCacheHits();
 
     sk_sp<GrTexture> texture(static_cast<GrSurface*>(resource)->asTexture());
     SkASSERT(texture);
@@ -189,6 +200,113 @@ sk_sp<GrTextureProxy> GrProxyProvider::findOrCreateProxyByUniqueKey(const GrUniq
     return result;
 }
 
+namespace {
+
+/**
+ * Uploads a large raster image through a transfer buffer. The buffer is mapped on the owning
+ * thread, a worker thread copies the pixels into it, and the upload unmaps it and has the GPU copy
+ * it into the texture, so neither the copy nor the transfer holds up the thread that flushes.
+ */
+class ImageUploader : public GrDeferredProxyUploader {
+public:
+    ImageUploader(sk_sp<SkImage> image, sk_sp<GrGpuBuffer> buffer, void* mappedPixels,
+                  size_t rowBytes)
+            : fImage(std::move(image))
+            , fBuffer(std::move(buffer))
+            , fMappedPixels(mappedPixels)
+            , fRowBytes(rowBytes) {}
+
+    ~ImageUploader() override {
+        // The worker may still be writing to the buffer if the proxy died before a flush.
+        this->wait();
+        if (fBuffer->isMapped() && !fBuffer->wasDestroyed()) {
+            fBuffer->unmap();
+        }
+    }
+
+    // Runs on the worker thread.
+    void copyPixels() {
+        TRACE_EVENT0("skia.gpu", "Threaded Image Upload Staging");
+        SkPixmap pixmap;
+        SkAssertResult(fImage->peekPixels(&pixmap));
+        SkRectMemcpy(fMappedPixels, fRowBytes, pixmap.addr(), pixmap.rowBytes(), fRowBytes,
+                     pixmap.height());
+        this->signalAndFreeData();
+    }
+
+private:
+    void onUpload(GrGpu* gpu, GrTextureProxy* proxy,
+                  GrDeferredTextureUploadWritePixelsFn& writePixelsFn) override {
+        fBuffer->unmap();
+        GrColorType colorType = SkColorTypeToGrColorType(fImage->colorType());
+        if (!gpu->transferPixels(proxy->peekTexture(), 0, 0, fImage->width(), fImage->height(),
+                                 colorType, fBuffer.get(), 0, fRowBytes)) {
+            // The image still has the pixels if the backend can't transfer this config.
+            SkPixmap pixmap;
+            SkAssertResult(fImage->peekPixels(&pixmap));
+            writePixelsFn(proxy, 0, 0, pixmap.width(), pixmap.height(), colorType, pixmap.addr(),
+                          pixmap.rowBytes());
+        }
+    }
+
+    sk_sp<SkImage>     fImage;
+    sk_sp<GrGpuBuffer> fBuffer;
+    void*              fMappedPixels;
+    size_t             fRowBytes;
+};
+
+}  // namespace
+
+sk_sp<GrTextureProxy> GrProxyProvider::createAsyncUploadProxy(const sk_sp<SkImage>& srcImage,
+                                                              const GrBackendFormat& format,
+                                                              const GrSurfaceDesc& desc,
+                                                              SkBudgeted budgeted,
+                                                              SkBackingFit fit,
+                                                              GrInternalSurfaceFlags surfaceFlags) {
+    // Smaller images upload faster than a worker thread can be scheduled.
+    static constexpr size_t kMinAsyncUploadBytes = 1 << 20;
+
+    GrContext* direct = fImageContext->priv().asDirectContext();
+    SkTaskGroup* taskGroup = direct ? direct->priv().getTaskGroup() : nullptr;
+    if (!taskGroup) {
+        return nullptr;
+    }
+    // The copy happens after this returns, so the pixels must not change.
+    const SkBitmap* bitmap = as_IB(srcImage)->onPeekBitmap();
+    if (!bitmap || !bitmap->isImmutable() || bitmap->computeByteSize() < kMinAsyncUploadBytes) {
+        return nullptr;
+    }
+
+    GrResourceProvider* resourceProvider = direct->priv().resourceProvider();
+    size_t rowBytes = bitmap->info().minRowBytes();
+    sk_sp<GrGpuBuffer> buffer = resourceProvider->createBuffer(
+            rowBytes * bitmap->height(), GrGpuBufferType::kXferCpuToGpu, kStream_GrAccessPattern);
+    if (!buffer) {
+        return nullptr;
+    }
+    void* mappedPixels = buffer->map();
+    if (!mappedPixels) {
+        return nullptr;
+    }
+
+    // The upload happens at the start of a flush, out of order with ops, so the proxy can't have
+    // pending IO.
+    sk_sp<GrTextureProxy> proxy = this->createProxy(
+            format, desc, kTopLeft_GrSurfaceOrigin, fit, budgeted,
+            surfaceFlags | GrInternalSurfaceFlags::kNoPendingIO);
+    if (!proxy || !proxy->instantiate(resourceProvider)) {
+        buffer->unmap();
+        return nullptr;
+    }
+
+    auto uploader = skstd::make_unique<ImageUploader>(srcImage, std::move(buffer), mappedPixels,
+                                                      rowBytes);
+    ImageUploader* uploaderRaw = uploader.get();
+    taskGroup->add([uploaderRaw] { uploaderRaw->copyPixels(); });
+    proxy->texPriv().setDeferredUploader(std::move(uploader));
+    return proxy;
+}
+
 sk_sp<GrTextureProxy> GrProxyProvider::createTextureProxy(sk_sp<SkImage> srcImage,
                                                           GrSurfaceDescFlags descFlags,
                                                           int sampleCnt,
@@ -245,6 +363,11 @@ sk_sp<GrTextureProxy> GrProxyProvider::createTextureProxy(sk_sp<SkImage> srcImag
     desc.fSampleCnt = sampleCnt;
     desc.fConfig = config;
 
+    if (sk_sp<GrTextureProxy> proxy = this->createAsyncUploadProxy(srcImage, format, desc,
+                                                                   budgeted, fit, surfaceFlags)) {
+        return proxy;
+    }
+
     sk_sp<GrTextureProxy> proxy = this->createLazyProxy(
             [desc, budgeted, srcImage, fit, surfaceFlags](GrResourceProvider* resourceProvider) {
                 SkPixmap pixMap;
@@ -427,23 +550,51 @@ sk_sp<GrTextureProxy> GrProxyProvider::createProxy(const GrBackendFormat& format
                                                     fit, budgeted, surfaceFlags));
 }
 
-sk_sp<GrTextureProxy> GrProxyProvider::createProxy(sk_sp<SkData> data, const GrSurfaceDesc& desc) {
+sk_sp<GrTextureProxy> GrProxyProvider::createProxy(sk_sp<SkData> data, const GrSurfaceDesc& desc,
+                                                   GrMipMapped mipMapped) {
     if (!this->caps()->isConfigTexturable(desc.fConfig)) {
         return nullptr;
     }
+    SkASSERT(GrMipMapped::kNo == mipMapped || GrPixelConfigIsCompressed(desc.fConfig));
+    if (GrMipMapped::kYes == mipMapped && !this->caps()->mipMapSupport()) {
+        return nullptr;
+    }
+
+    // Find where each level starts in the data. Compressed levels are packed by whole blocks.
+    int mipLevelCount = 1;
+    if (GrMipMapped::kYes == mipMapped) {
+        mipLevelCount = SkMipMap::ComputeLevelCount(desc.fWidth, desc.fHeight) + 1;
+    }
+    SkTArray<size_t> levelOffsets(mipLevelCount);
+    size_t dataSize = 0;
+    for (int i = 0, w = desc.fWidth, h = desc.fHeight; i < mipLevelCount; ++i) {
+        levelOffsets.push_back(dataSize);
+        dataSize += GrPixelConfigIsCompressed(desc.fConfig)
+                            ? GrCompressedFormatDataSize(desc.fConfig, w, h)
+                            : (size_t)w * h * GrBytesPerPixel(desc.fConfig);
+        w = SkTMax(1, w / 2);
+        h = SkTMax(1, h / 2);
+    }
+    if (data->size() < dataSize) {
+        return nullptr;
+    }
 
     const GrColorType ct = GrPixelConfigToColorType(desc.fConfig);
     const GrBackendFormat format =
                             this->caps()->getBackendFormatFromGrColorType(ct, GrSRGBEncoded::kNo);
 
     sk_sp<GrTextureProxy> proxy = this->createLazyProxy(
-        [desc, data](GrResourceProvider* resourceProvider) {
-            GrMipLevel texels;
-            texels.fPixels = data->data();
-            texels.fRowBytes = GrBytesPerPixel(desc.fConfig)*desc.fWidth;
-            return resourceProvider->createTexture(desc, SkBudgeted::kYes, &texels, 1);
+        [desc, data, levelOffsets](GrResourceProvider* resourceProvider) {
+            SkAutoSTMalloc<14, GrMipLevel> texels(levelOffsets.count());
+            for (int i = 0; i < levelOffsets.count(); ++i) {
+                texels[i].fPixels = data->bytes() + levelOffsets[i];
+                texels[i].fRowBytes = GrBytesPerPixel(desc.fConfig) *
+                                      SkTMax(1, desc.fWidth >> i);
+            }
+            return resourceProvider->createTexture(desc, SkBudgeted::kYes, texels.get(),
+                                                   levelOffsets.count());
         },
-        format, desc, kTopLeft_GrSurfaceOrigin, GrMipMapped::kNo, SkBackingFit::kExact,
+        format, desc, kTopLeft_GrSurfaceOrigin, mipMapped, SkBackingFit::kExact,
         SkBudgeted::kYes);
 
     if (!proxy) {
@@ -96,9 +96,12 @@ public:
     }
 
     /*
-     * Create a texture proxy with data. It's assumed that the data is packed tightly.
+     * Create a texture proxy with data. It's assumed that the data is packed tightly. If mipMapped
+     * is kYes the data must hold the full chain of mip levels, largest first (this is only
+     * supported for compressed configs).
      */
-    sk_sp<GrTextureProxy> createProxy(sk_sp<SkData>, const GrSurfaceDesc& desc);
+    sk_sp<GrTextureProxy> createProxy(sk_sp<SkData>, const GrSurfaceDesc& desc,
+                                      GrMipMapped mipMapped = GrMipMapped::kNo);
 
     // These match the definitions in SkImage & GrTexture.h, for whence they came
     typedef void* ReleaseContext;
@@ -249,6 +252,13 @@ private:
 
     sk_sp<GrTextureProxy> createWrapped(sk_sp<GrTexture> tex, GrSurfaceOrigin origin);
 
+    // For createTextureProxy(). If the context has a task group and the image is large, returns
+    // an instantiated proxy whose pixels a worker thread copies into a mapped transfer buffer,
+    // to be transferred into the texture before the first flush that uses it.
+    sk_sp<GrTextureProxy> createAsyncUploadProxy(const sk_sp<SkImage>&, const GrBackendFormat&,
+                                                 const GrSurfaceDesc&, SkBudgeted, SkBackingFit,
+                                                 GrInternalSurfaceFlags);
+
     struct UniquelyKeyedProxyHashTraits {
         static const GrUniqueKey& GetKey(const GrTextureProxy& p) { return p.getUniqueKey(); }
 
@@ -56,7 +56,8 @@ bool GrRecordingContext::init(sk_sp<const GrCaps> caps, sk_sp<GrSkSLFPFactoryCac
     }
 
     fStrikeCache.reset(new GrStrikeCache(this->caps(),
-                                        this->options().fGlyphCacheTextureMaximumBytes));
+                                        this->options().fGlyphCacheTextureMaximumBytes,
+                                        this->options().fMultiChannelDistanceFieldText));
 
     fTextBlobCache.reset(new GrTextBlobCache(textblobcache_overbudget_CB, this,
                                              this->contextID()));
@@ -88,6 +89,9 @@ void GrRecordingContext::setupDrawingManager(bool explicitlyAllocate, bool sortO
     textContextOptions.fMaxDistanceFieldFontSize = this->options().fGlyphsAsPathsFontSize;
     textContextOptions.fMinDistanceFieldFontSize = this->options().fMinDistanceFieldFontSize;
     textContextOptions.fDistanceFieldVerticesAlwaysHaveW = false;
+    textContextOptions.fMultiChannelDistanceFieldText =
+            this->options().fMultiChannelDistanceFieldText;
+    textContextOptions.fCaptureGlyphImages = !this->proxyProvider()->renderingDirectly();
 #if SK_SUPPORT_ATLAS_TEXT
     if (GrContextOptions::Enable::kYes == this->options().fDistanceFieldGlyphVerticesAlwaysHaveW) {
         textContextOptions.fDistanceFieldVerticesAlwaysHaveW = true;
@@ -122,7 +126,10 @@ sk_sp<GrOpMemoryPool> GrRecordingContext::refOpMemoryPool() {
         // DDL TODO: should the size of the memory pool be decreased in DDL mode? CPU-side memory
         // consumed in DDL mode vs. normal mode for a single skp might be a good metric of wasted
         // memory.
-        fOpMemoryPool = sk_sp<GrOpMemoryPool>(new GrOpMemoryPool(16384, 16384));
+        // A DDL's ops are all deleted together when it is replayed or destroyed, so a recording
+        // context's pool skips the per-op bookkeeping and frees its blocks in bulk.
+        bool bulkRelease = !this->asDirectContext();
+        fOpMemoryPool = sk_sp<GrOpMemoryPool>(new GrOpMemoryPool(16384, 16384, bulkRelease));
     }
 
     SkASSERT(fOpMemoryPool);
@@ -111,9 +111,18 @@ GrReducedClip::GrReducedClip(const SkClipStack& stack, const SkRect& queryBounds
         }
         fHasScissor = true;
 
-        // Now that we have determined the bounds to use and filtered out the trivial cases, call
-        // the helper that actually walks the stack.
-        this->walkStack(stack, tighterQuery);
+        SkRRect singleRRect;
+        bool singleRRectAA;
+        if (stack.isSingleRRect(&singleRRect, &singleRRectAA)) {
+            // The stack already knows that it is equivalent to a single rrect, so there is no need
+            // to walk it.
+            this->clipSingleRRect(singleRRect, singleRRectAA, stack.getTopmostGenID(),
+                                  tighterQuery);
+        } else {
+            // Now that we have determined the bounds to use and filtered out the trivial cases,
+            // call the helper that actually walks the stack.
+            this->walkStack(stack, tighterQuery);
+        }
     }
 
     if (SK_InvalidGenID != fAAClipRectGenID && // Is there an AA clip rect?
@@ -478,6 +487,42 @@ void GrReducedClip::walkStack(const SkClipStack& stack, const SkRect& queryBound
     fInitialState = static_cast<GrReducedClip::InitialState>(initialTriState);
 }
 
+void GrReducedClip::clipSingleRRect(const SkRRect& rrect, bool aa, uint32_t genID,
+                                    const SkRect& queryBounds) {
+    fInitialState = InitialState::kAllIn;
+    if (rrect.contains(queryBounds)) {
+        return;
+    }
+
+    SkIRect rrectIBounds;
+    if (!aa) {
+        rrect.getBounds().round(&rrectIBounds);
+    } else {
+        rrectIBounds = GrClip::GetPixelIBounds(rrect.getBounds());
+    }
+    SkASSERT(fHasScissor);
+    if (!fScissor.intersect(rrectIBounds)) {
+        this->makeEmpty();
+        return;
+    }
+
+    if (rrect.isRect()) {
+        // Non-aa and pixel aligned rects are fully implemented by the scissor.
+        if (aa && !GrClip::IsPixelAligned(rrect.rect())) {
+            fAAClipRect = rrect.rect();
+            fAAClipRectGenID = genID;
+        }
+        return;
+    }
+
+    if (ClipResult::kNotClipped == this->addAnalyticFP(rrect, Invert::kNo, GrAA(aa))) {
+        fMaskElements.addToHead(rrect, SkMatrix::I(), kReplace_SkClipOp, aa);
+        fInitialState = InitialState::kAllOut;
+        fMaskGenID = genID;
+        fMaskRequiresAA = aa;
+    }
+}
+
 GrReducedClip::ClipResult GrReducedClip::clipInsideElement(const Element* element) {
     SkIRect elementIBounds;
     if (!element->isAA()) {
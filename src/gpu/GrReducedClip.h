@@ -103,6 +103,10 @@ public:
 private:
     void walkStack(const SkClipStack&, const SkRect& queryBounds);
 
+    // Reduces a stack that SkClipStack::isSingleRRect() has found to be equivalent to one rrect,
+    // whose mask would have the given generation ID.
+    void clipSingleRRect(const SkRRect&, bool aa, uint32_t genID, const SkRect& queryBounds);
+
     enum class ClipResult {
         kNotClipped,
         kClipped,
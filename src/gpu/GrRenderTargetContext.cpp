@@ -9,6 +9,7 @@
 #include "../private/GrAuditTrail.h"
 #include "../private/SkShadowFlags.h"
 #include "GrAppliedClip.h"
+#include "GrAsyncReadManager.h"
 #include "GrBackendSemaphore.h"
 #include "GrBlurUtils.h"
 #include "GrCaps.h"
@@ -16,6 +17,7 @@
 #include "GrContextPriv.h"
 #include "GrDrawingManager.h"
 #include "GrFixedClip.h"
+#include "GrGpu.h"
 #include "GrGpuResourcePriv.h"
 #include "GrMemoryPool.h"
 #include "GrOpList.h"
@@ -81,6 +83,14 @@ public:
                                              clip, paint, viewMatrix, shape);
     }
 
+    void drawShape(const GrClip& clip, GrPaint&& paint, GrAA aa,
+                   const SkMatrix& viewMatrix, const GrShape& shape) override {
+        if (fRenderTargetContext->fContext->priv().abandoned()) {
+            return;
+        }
+        fRenderTargetContext->drawShape(clip, std::move(paint), aa, viewMatrix, shape);
+    }
+
     void makeGrPaint(GrMaskFormat maskFormat, const SkPaint& skPaint, const SkMatrix& viewMatrix,
                      GrPaint* grPaint) override {
         auto context = fRenderTargetContext->fContext;
@@ -1732,6 +1742,99 @@ GrSemaphoresSubmitted GrRenderTargetContext::prepareForExternalIO(
                                                                finishedContext);
 }
 
+bool GrRenderTargetContext::asyncReadPixels(const SkImageInfo& info, int x, int y,
+                                            SkSurface::ReadPixelsCallback callback,
+                                            SkSurface::ReadPixelsContext context) {
+    ASSERT_SINGLE_OWNER
+    RETURN_FALSE_IF_ABANDONED
+    SkDEBUGCODE(this->validate();)
+    GR_CREATE_TRACE_MARKER_CONTEXT("GrRenderTargetContext", "asyncReadPixels", fContext);
+
+    auto direct = fContext->priv().asDirectContext();
+    if (!direct || !this->caps()->fenceSyncSupport()) {
+        return false;
+    }
+    // A draw can change the color type and origin, but color space and unpremul conversions are
+    // left to readPixels().
+    SkColorSpace* srcColorSpace = this->colorSpaceInfo().colorSpace();
+    if (srcColorSpace && !SkColorSpace::Equals(info.colorSpace(), srcColorSpace)) {
+        return false;
+    }
+    GrPixelConfig srcConfig = fRenderTargetProxy->config();
+    if (kUnpremul_SkAlphaType == info.alphaType() && !GrPixelConfigIsOpaque(srcConfig)) {
+        return false;
+    }
+    GrColorType dstColorType = SkColorTypeToGrColorType(info.colorType());
+    if (GrColorType::kUnknown == dstColorType) {
+        return false;
+    }
+
+    if (!fRenderTargetProxy->instantiate(direct->priv().resourceProvider())) {
+        return false;
+    }
+    GrSurface* srcSurface = fRenderTargetProxy->peekSurface();
+    bool canTransfer = kTopLeft_GrSurfaceOrigin == this->origin() &&
+                       this->caps()->surfaceSupportsReadPixels(srcSurface) &&
+                       this->caps()->supportedReadPixelsColorType(srcConfig, dstColorType) ==
+                               dstColorType &&
+                       GrPixelConfigToColorType(srcConfig) == dstColorType;
+    if (!canTransfer) {
+        // Draw the rect into a top-left surface of the requested color type and read that.
+        sk_sp<GrTextureProxy> srcProxy = this->asTextureProxyRef();
+        GrPixelConfig dstConfig = SkColorType2GrPixelConfig(info.colorType());
+        if (!srcProxy || kUnknown_GrPixelConfig == dstConfig) {
+            return false;
+        }
+        const GrBackendFormat format = this->caps()->getBackendFormatFromColorType(
+                info.colorType());
+        sk_sp<GrRenderTargetContext> tempRTC = direct->priv().makeDeferredRenderTargetContext(
+                format, SkBackingFit::kExact, info.width(), info.height(), dstConfig,
+                this->colorSpaceInfo().refColorSpace(), 1, GrMipMapped::kNo,
+                kTopLeft_GrSurfaceOrigin);
+        if (!tempRTC) {
+            return false;
+        }
+        tempRTC->drawTexture(GrNoClip(), std::move(srcProxy), GrSamplerState::Filter::kNearest,
+                             SkBlendMode::kSrc, SK_PMColor4fWHITE,
+                             SkRect::MakeXYWH(x, y, info.width(), info.height()),
+                             SkRect::MakeWH(info.width(), info.height()), GrAA::kNo,
+                             GrQuadAAFlags::kNone, SkCanvas::kFast_SrcRectConstraint,
+                             SkMatrix::I(), nullptr);
+        if (!tempRTC->fRenderTargetProxy->instantiate(direct->priv().resourceProvider())) {
+            return false;
+        }
+        GrSurface* tempSurface = tempRTC->fRenderTargetProxy->peekSurface();
+        if (!this->caps()->surfaceSupportsReadPixels(tempSurface) ||
+            this->caps()->supportedReadPixelsColorType(dstConfig, dstColorType) != dstColorType) {
+            return false;
+        }
+        return tempRTC->transferAndFence(direct, tempSurface, 0, 0, info.width(), info.height(),
+                                         dstColorType, callback, context);
+    }
+    return this->transferAndFence(direct, srcSurface, x, y, info.width(), info.height(),
+                                  dstColorType, callback, context);
+}
+
+bool GrRenderTargetContext::transferAndFence(GrContext* direct, GrSurface* surface, int x, int y,
+                                             int width, int height, GrColorType dstColorType,
+                                             SkSurface::ReadPixelsCallback callback,
+                                             SkSurface::ReadPixelsContext context) {
+    size_t rowBytes = GrColorTypeBytesPerPixel(dstColorType) * width;
+    sk_sp<GrGpuBuffer> buffer = direct->priv().resourceProvider()->createBuffer(
+            rowBytes * height, GrGpuBufferType::kXferGpuToCpu, kStream_GrAccessPattern);
+    if (!buffer) {
+        return false;
+    }
+    // The transfer goes straight to the GrGpu, so the draws it reads have to be executed first.
+    direct->priv().flush(fRenderTargetProxy.get());
+    GrGpu* gpu = direct->priv().getGpu();
+    if (!gpu->transferPixelsFrom(surface, x, y, width, height, dstColorType, buffer.get(), 0)) {
+        return false;
+    }
+    gpu->asyncReadManager()->add(std::move(buffer), rowBytes, callback, context);
+    return true;
+}
+
 bool GrRenderTargetContext::waitOnSemaphores(int numSemaphores,
                                              const GrBackendSemaphore waitSemaphores[]) {
     ASSERT_SINGLE_OWNER
@@ -412,6 +412,16 @@ public:
                                                GrGpuFinishedProc finishedProc,
                                                GrGpuFinishedContext finishedContext);
 
+    /**
+     * Starts reading the pixels at (x, y) with info's dimensions into a transfer buffer and calls
+     * callback with them once the GPU has written them, from a later flush or
+     * GrContext::checkAsyncWorkCompletion(). Returns false, without calling callback, if the read
+     * needs a conversion only readPixels() can do or the backend can't transfer from the surface.
+     */
+    bool asyncReadPixels(const SkImageInfo& info, int x, int y,
+                         SkSurface::ReadPixelsCallback callback,
+                         SkSurface::ReadPixelsContext context);
+
     /**
      *  The next time this GrRenderTargetContext is flushed, the gpu will wait on the passed in
      *  semaphores before executing any commands.
@@ -497,6 +507,12 @@ private:
                              sk_sp<GrTextureProxy>);
 
     void internalClear(const GrFixedClip&, const SkPMColor4f&, CanClearFullscreen);
+
+    // Flushes, transfers the rect of 'surface', which backs this context, into a new buffer and
+    // registers it to be called back once its fence passes.
+    bool transferAndFence(GrContext* direct, GrSurface* surface, int x, int y, int width,
+                          int height, GrColorType, SkSurface::ReadPixelsCallback,
+                          SkSurface::ReadPixelsContext);
     void internalStencilClear(const GrFixedClip&, bool insideStencilMask);
 
     // Only consumes the GrPaint if successful.
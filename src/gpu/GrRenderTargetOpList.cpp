@@ -11,6 +11,7 @@
 #include "GrGpu.h"
 #include "GrGpuCommandBuffer.h"
 #include "GrMemoryPool.h"
+#include "GrOpTimer.h"
 #include "GrRecordingContext.h"
 #include "GrRecordingContextPriv.h"
 #include "GrRect.h"
@@ -351,10 +352,17 @@ inline void GrRenderTargetOpList::OpChain::validate() const {
 GrRenderTargetOpList::GrRenderTargetOpList(GrResourceProvider* resourceProvider,
                                            sk_sp<GrOpMemoryPool> opMemoryPool,
                                            GrRenderTargetProxy* proxy,
-                                           GrAuditTrail* auditTrail)
+                                           GrAuditTrail* auditTrail,
+                                           bool unboundedOpMerging)
         : INHERITED(resourceProvider, std::move(opMemoryPool), proxy, auditTrail)
         , fLastClipStackGenID(SK_InvalidUniqueID)
         SkDEBUGCODE(, fNumClips(0)) {
+    if (unboundedOpMerging) {
+        // A fully lazy target's size isn't known yet. A single cell is still correct, just slower.
+        bool sized = GrSurfaceProxy::LazyState::kFully != proxy->lazyInstantiationState();
+        fOpBoundsGrid.reset(new GrOpBoundsGrid(sized ? proxy->width()  : 1,
+                                               sized ? proxy->height() : 1));
+    }
 }
 
 void GrRenderTargetOpList::deleteOps() {
@@ -362,6 +370,10 @@ void GrRenderTargetOpList::deleteOps() {
         chain.deleteOps(fOpMemoryPool.get());
     }
     fOpChains.reset();
+    if (fOpBoundsGrid) {
+        fOpBoundsGrid->reset();
+        fChainsByClass.reset();
+    }
 }
 
 GrRenderTargetOpList::~GrRenderTargetOpList() {
@@ -435,7 +447,8 @@ static GrGpuRTCommandBuffer* create_command_buffer(GrGpu* gpu,
                                                    const SkRect& bounds,
                                                    GrLoadOp colorLoadOp,
                                                    const SkPMColor4f& loadClearColor,
-                                                   GrLoadOp stencilLoadOp) {
+                                                   GrLoadOp stencilLoadOp,
+                                                   GrStoreOp stencilStoreOp) {
     const GrGpuRTCommandBuffer::LoadAndStoreInfo kColorLoadStoreInfo {
         colorLoadOp,
         GrStoreOp::kStore,
@@ -447,9 +460,11 @@ static GrGpuRTCommandBuffer* create_command_buffer(GrGpu* gpu,
     // to stop splitting up higher level opLists for copyOps to achieve that.
     // Note: we would still need SB loads and stores but they would happen at a
     // lower level (inside the VK command buffer).
+    // The transfers used to clear and copy MSAA and stencil images are why those attachments
+    // can't be made memoryless (transient/lazily allocated) on tilers.
     const GrGpuRTCommandBuffer::StencilLoadAndStoreInfo stencilLoadAndStoreInfo {
         stencilLoadOp,
-        GrStoreOp::kStore,
+        stencilStoreOp,
     };
 
     return gpu->getCommandBuffer(rt, origin, bounds, kColorLoadStoreInfo, stencilLoadAndStoreInfo);
@@ -473,8 +488,16 @@ bool GrRenderTargetOpList::onExecute(GrOpFlushState* flushState) {
     SkASSERT(fTarget.get()->peekRenderTarget());
     TRACE_EVENT0("skia", TRACE_FUNC);
 
-    // TODO: at the very least, we want the stencil store op to always be discard (at this
-    // level). In Vulkan, sub-command buffers would still need to load & store the stencil buffer.
+    // Every opList that draws with the stencil buffer clears it on load (see
+    // GrRenderTargetContext::addDrawOp), and stencil clips are tracked per opList, so nothing
+    // reads the stencil written here after the opList ends. Tilers can then skip writing it back.
+    // That's not so when stencil clears are done as draws, since those are only recorded the first
+    // time the proxy needs a stencil buffer, nor when the render pass belongs to the client.
+    GrStoreOp stencilStoreOp = GrStoreOp::kStore;
+    if (!flushState->gpu()->caps()->performStencilClearsAsDraws() &&
+        !fTarget.get()->asRenderTargetProxy()->wrapsVkSecondaryCB()) {
+        stencilStoreOp = GrStoreOp::kDiscard;
+    }
 
     // Make sure load ops are not kClear if the GPU needs to use draws for clears
     SkASSERT(fColorLoadOp != GrLoadOp::kClear ||
@@ -488,8 +511,13 @@ bool GrRenderTargetOpList::onExecute(GrOpFlushState* flushState) {
                                                     fTarget.get()->getBoundsRect(),
                                                     fColorLoadOp,
                                                     fLoadClearColor,
-                                                    fStencilLoadOp);
+                                                    fStencilLoadOp,
+                                                    stencilStoreOp);
     flushState->setCommandBuffer(commandBuffer);
+    GrOpTimer* opTimer = flushState->gpu()->opTimer();
+    if (opTimer) {
+        opTimer->beginOpList();
+    }
     commandBuffer->begin();
 
     // Draw all the generated geometry.
@@ -511,9 +539,16 @@ bool GrRenderTargetOpList::onExecute(GrOpFlushState* flushState) {
         flushState->setOpArgs(&opArgs);
         chain.head()->execute(flushState, chain.bounds());
         flushState->setOpArgs(nullptr);
+        flushState->gpu()->stats()->incNumOpExecutions();
+        if (opTimer) {
+            opTimer->endOpChain(chain.head()->name());
+        }
     }
 
     commandBuffer->end();
+    if (opTimer) {
+        opTimer->endOpList("GrRenderTargetOpList");
+    }
     flushState->gpu()->submit(commandBuffer);
     flushState->setCommandBuffer(nullptr);
 
@@ -676,7 +711,12 @@ void GrRenderTargetOpList::recordOp(
     GrOP_INFO(SkTabString(op->dumpInfo(), 1).c_str());
     GrOP_INFO("\tOutcome:\n");
     int maxCandidates = SkTMin(kMaxOpChainDistance, fOpChains.count());
-    if (maxCandidates) {
+    if (fOpBoundsGrid) {
+        op = this->appendToAnyChain(std::move(op), processorAnalysis, clip, dstProxy, caps);
+        if (!op) {
+            return;
+        }
+    } else if (maxCandidates) {
         int i = 0;
         while (true) {
             OpChain& candidate = fOpChains.fromBack(i);
@@ -703,9 +743,45 @@ void GrRenderTargetOpList::recordOp(
         clip = fClipAllocator.make<GrAppliedClip>(std::move(*clip));
         SkDEBUGCODE(fNumClips++;)
     }
+    if (fOpBoundsGrid) {
+        fOpBoundsGrid->add(op->bounds(), fOpChains.count());
+        SkTArray<int, true>* chains = fChainsByClass.find(op->classID());
+        if (!chains) {
+            chains = fChainsByClass.set(op->classID(), SkTArray<int, true>());
+        }
+        chains->push_back(fOpChains.count());
+    }
     fOpChains.emplace_back(std::move(op), processorAnalysis, clip, dstProxy);
 }
 
+std::unique_ptr<GrOp> GrRenderTargetOpList::appendToAnyChain(
+        std::unique_ptr<GrOp> op, GrProcessorSet::Analysis processorAnalysis, GrAppliedClip* clip,
+        const DstProxy* dstProxy, const GrCaps& caps) {
+    SkASSERT(fOpBoundsGrid);
+
+    // Chains only ever take ops of their own class, so those are the only candidates. The op can
+    // join any of them recorded no earlier than the last chain it overlaps; it would be drawn
+    // before the chains between, but doesn't touch them.
+    const SkTArray<int, true>* chains = fChainsByClass.find(op->classID());
+    if (!chains) {
+        GrOP_INFO("\t\tBackward: No chains of this class\n");
+        return op;
+    }
+    SkRect bounds = op->bounds();
+    int lastOverlap = fOpBoundsGrid->lastOverlap(bounds);
+    for (int i = chains->count() - 1; i >= 0 && (*chains)[i] >= lastOverlap; --i) {
+        int chainIndex = (*chains)[i];
+        op = fOpChains[chainIndex].appendOp(std::move(op), processorAnalysis, dstProxy, clip, caps,
+                                            fOpMemoryPool.get(), fAuditTrail);
+        if (!op) {
+            fOpBoundsGrid->add(bounds, chainIndex);
+            return nullptr;
+        }
+    }
+    GrOP_INFO("\t\tBackward: No chain took the op before chain %d\n", lastOverlap);
+    return op;
+}
+
 void GrRenderTargetOpList::forwardCombine(const GrCaps& caps) {
     SkASSERT(!this->isClosed());
     GrOP_INFO("opList: %d ForwardCombine %d ops:\n", this->uniqueID(), fOpChains.count());
@@ -9,6 +9,7 @@
 #define GrRenderTargetOpList_DEFINED
 
 #include "GrAppliedClip.h"
+#include "GrOpBoundsGrid.h"
 #include "GrOpList.h"
 #include "GrPathRendering.h"
 #include "GrPrimitiveProcessor.h"
@@ -20,6 +21,7 @@
 #include "SkStringUtils.h"
 #include "SkStrokeRec.h"
 #include "SkTArray.h"
+#include "SkTHash.h"
 #include "SkTLazy.h"
 #include "SkTypes.h"
 
@@ -33,8 +35,10 @@ private:
     using DstProxy = GrXferProcessor::DstProxy;
 
 public:
+    // With unboundedOpMerging, recordOp() considers every earlier chain it can reorder past,
+    // found with a GrOpBoundsGrid, instead of only the last kMaxOpChainDistance chains.
     GrRenderTargetOpList(GrResourceProvider*, sk_sp<GrOpMemoryPool>,
-                         GrRenderTargetProxy*, GrAuditTrail*);
+                         GrRenderTargetProxy*, GrAuditTrail*, bool unboundedOpMerging = false);
 
     ~GrRenderTargetOpList() override;
 
@@ -221,6 +225,10 @@ private:
     void recordOp(std::unique_ptr<GrOp>, GrProcessorSet::Analysis, GrAppliedClip*, const DstProxy*,
                   const GrCaps& caps);
 
+    // recordOp() for unbounded op merging. Returns the op if no earlier chain took it.
+    std::unique_ptr<GrOp> appendToAnyChain(std::unique_ptr<GrOp>, GrProcessorSet::Analysis,
+                                           GrAppliedClip*, const DstProxy*, const GrCaps& caps);
+
     void forwardCombine(const GrCaps&);
 
     uint32_t                       fLastClipStackGenID;
@@ -233,6 +241,11 @@ private:
     // For ops/opList we have mean: 5 stdDev: 28
     SkSTArray<25, OpChain, true> fOpChains;
 
+    // Only used for unbounded op merging, while recording: the bounds of every op in fOpChains
+    // and, for each op class, the indices of the chains of that class in increasing order.
+    std::unique_ptr<GrOpBoundsGrid>           fOpBoundsGrid;
+    SkTHashMap<uint32_t, SkTArray<int, true>> fChainsByClass;
+
     // MDB TODO: 4096 for the first allocation of the clip space will be huge overkill.
     // Gather statistics to determine the correct size.
     SkArenaAlloc                   fClipAllocator{4096};
@@ -127,7 +127,9 @@ GrResourceCache::GrResourceCache(const GrCaps* caps, GrSingleOwner* singleOwner,
         , fFreedGpuResourceInbox(contextUniqueID)
         , fContextUniqueID(contextUniqueID)
         , fSingleOwner(singleOwner)
-        , fPreferVRAMUseOverFlushes(caps->preferVRAMUseOverFlushes()) {
+        , fPreferVRAMUseOverFlushes(caps->preferVRAMUseOverFlushes())
+        , fIncrementalPurgeBytes(0)
+        , fPurgingToLowWatermark(false) {
     SkASSERT(contextUniqueID != SK_InvalidUniqueID);
     SkDEBUGCODE(fCount = 0;)
     SkDEBUGCODE(fNewlyPurgeableResourceForValidation = nullptr;)
@@ -143,6 +145,14 @@ void GrResourceCache::setLimits(int count, size_t bytes) {
     this->purgeAsNeeded();
 }
 
+void GrResourceCache::setIncrementalPurgeBytes(size_t maxBytesPerPurge) {
+    fIncrementalPurgeBytes = maxBytesPerPurge;
+    if (!fIncrementalPurgeBytes) {
+        fPurgingToLowWatermark = false;
+        this->purgeAsNeeded();
+    }
+}
+
 void GrResourceCache::insertResource(GrGpuResource* resource) {
     ASSERT_SINGLE_OWNER
     SkASSERT(resource);
@@ -232,6 +242,7 @@ void GrResourceCache::abandonAll() {
         SkASSERT(!top->wasDestroyed());
         top->cacheAccess().abandon();
     }
+    fPurgingToLowWatermark = false;
 
     SkASSERT(!fScratchMap.count());
     SkASSERT(!fUniqueHash.count());
@@ -269,6 +280,7 @@ void GrResourceCache::releaseAll() {
         SkASSERT(!top->wasDestroyed());
         top->cacheAccess().release();
     }
+    fPurgingToLowWatermark = false;
 
     SkASSERT(!fScratchMap.count());
     SkASSERT(!fUniqueHash.count());
@@ -461,8 +473,10 @@ void GrResourceCache::notifyCntReachedZero(GrGpuResource* resource, uint32_t fla
     if (budgetedType == GrBudgetedType::kBudgeted) {
         // Purge the resource immediately if we're over budget
         // Also purge if the resource has neither a valid scratch key nor a unique key.
+        // When purging incrementally, leave it for the next purgeAsNeeded() so that the release
+        // doesn't happen in the middle of recording.
         bool hasKey = resource->resourcePriv().getScratchKey().isValid() || hasUniqueKey;
-        if (!this->overBudget() && hasKey) {
+        if ((!this->overBudget() || fIncrementalPurgeBytes) && hasKey) {
             return;
         }
     } else {
@@ -531,11 +545,29 @@ void GrResourceCache::purgeAsNeeded() {
             fProxyProvider->processInvalidUniqueKey(invalidKeyMsgs[i].key(), nullptr,
                                                     GrProxyProvider::InvalidateGPUResource::kYes);
             SkASSERT(!this->findAndRefUniqueResource(invalidKeyMsgs[i].key()));
+            if (fCompressedImageCache) {
+                fCompressedImageCache->remove(invalidKeyMsgs[i].key());
+            }
         }
     }
 
     this->processFreedGpuResources();
 
+    if (fIncrementalPurgeBytes) {
+        this->purgeIncrementally(fIncrementalPurgeBytes);
+    } else {
+        this->purgeToBudget();
+    }
+
+    this->validate();
+}
+
+void GrResourceCache::finishIncrementalPurge() {
+    this->purgeIncrementally(SIZE_MAX);
+    this->validate();
+}
+
+void GrResourceCache::purgeToBudget() {
     bool stillOverbudget = this->overBudget();
     while (stillOverbudget && fPurgeableQueue.count()) {
         GrGpuResource* resource = fPurgeableQueue.peek();
@@ -543,8 +575,26 @@ void GrResourceCache::purgeAsNeeded() {
         resource->cacheAccess().release();
         stillOverbudget = this->overBudget();
     }
+}
 
-    this->validate();
+void GrResourceCache::purgeIncrementally(size_t maxBytesToRelease) {
+    // Purging down to a watermark under the budget, rather than to the budget itself, keeps a
+    // cache hovering near its limit from releasing a resource on every flush.
+    if (this->overBudget()) {
+        fPurgingToLowWatermark = true;
+    }
+    const size_t lowWatermarkBytes = fMaxBytes - fMaxBytes / 10;
+    const int lowWatermarkCount = fMaxCount - fMaxCount / 10;
+    size_t releasedBytes = 0;
+    while (fPurgingToLowWatermark && fPurgeableQueue.count() &&
+           releasedBytes < maxBytesToRelease) {
+        GrGpuResource* resource = fPurgeableQueue.peek();
+        SkASSERT(resource->resourcePriv().isPurgeable());
+        releasedBytes += resource->gpuMemorySize();
+        resource->cacheAccess().release();
+        fPurgingToLowWatermark = fBudgetedBytes > lowWatermarkBytes ||
+                                 fBudgetedCount > lowWatermarkCount;
+    }
 }
 
 void GrResourceCache::purgeUnlockedResources(bool scratchResourcesOnly) {
@@ -635,7 +685,10 @@ void GrResourceCache::purgeUnlockedResources(size_t bytesToPurge, bool preferScr
         const size_t cachedByteCount = fMaxBytes;
         fMaxBytes = tmpByteBudget;
         this->purgeAsNeeded();
+        // An explicit request to free memory isn't spread out over later flushes.
+        this->purgeToBudget();
         fMaxBytes = cachedByteCount;
+        fPurgingToLowWatermark = fIncrementalPurgeBytes && this->overBudget();
     }
 }
 
@@ -8,6 +8,7 @@
 #ifndef GrResourceCache_DEFINED
 #define GrResourceCache_DEFINED
 
+#include "GrCompressedImageCache.h"
 #include "GrGpuResource.h"
 #include "GrGpuResourceCacheAccess.h"
 #include "GrGpuResourcePriv.h"
@@ -74,6 +75,15 @@ public:
     /** Sets the cache limits in terms of number of resources and max gpu memory byte size. */
     void setLimits(int count, size_t bytes);
 
+    /**
+     * When non-zero, purgeAsNeeded() no longer releases everything over budget at once. Instead,
+     * going over budget starts a purge down to a low watermark (90% of the limits) that releases
+     * at most 'maxBytesPerPurge' of resources per call, so the release cost is spread across
+     * flushes. Newly purgeable resources with keys are also left for the next purge rather than
+     * being released right away. finishIncrementalPurge() completes any pending purge.
+     */
+    void setIncrementalPurgeBytes(size_t maxBytesPerPurge);
+
     /**
      * Returns the number of resources.
      */
@@ -166,6 +176,9 @@ public:
         keys. */
     void purgeAsNeeded();
 
+    /** Releases all the resources an incremental purge still has pending, with no byte limit. */
+    void finishIncrementalPurge();
+
     /** Purges all resources that don't have external owners. */
     void purgeAllUnlocked() { this->purgeUnlockedResources(false); }
 
@@ -179,6 +192,9 @@ public:
 
     bool overBudget() const { return fBudgetedBytes > fMaxBytes || fBudgetedCount > fMaxCount; }
 
+    /** Returns true if an incremental purge has started and not yet reached the low watermark. */
+    bool isPurgingIncrementally() const { return fPurgingToLowWatermark; }
+
     /**
      * Purge unlocked resources from the cache until the the provided byte count has been reached
      * or we have purged all unlocked resources. The default policy is to purge in LRU order, but
@@ -254,6 +270,19 @@ public:
 
     void setProxyProvider(GrProxyProvider* proxyProvider) { fProxyProvider = proxyProvider; }
 
+    /**
+     * Enables the compressed tier for image textures (see GrCompressedImageCache), with a budget
+     * of maxBytes of CPU memory. Its entries are dropped along with the unique keys they are
+     * stored under.
+     */
+    void enableCompressedImageCache(size_t maxBytes) {
+        fCompressedImageCache = sk_make_sp<GrCompressedImageCache>(maxBytes);
+    }
+
+    /** Returns the compressed tier, or nullptr if it isn't enabled. */
+    GrCompressedImageCache* compressedImageCache() { return fCompressedImageCache.get(); }
+    sk_sp<GrCompressedImageCache> refCompressedImageCache() { return fCompressedImageCache; }
+
 private:
     ///////////////////////////////////////////////////////////////////////////
     /// @name Methods accessible via ResourceAccess
@@ -269,6 +298,8 @@ private:
     /// @}
 
     void processFreedGpuResources();
+    void purgeToBudget();
+    void purgeIncrementally(size_t maxBytesToRelease);
     void addToNonpurgeableArray(GrGpuResource*);
     void removeFromNonpurgeableArray(GrGpuResource*);
 
@@ -383,6 +414,15 @@ private:
     SkDEBUGCODE(GrGpuResource*          fNewlyPurgeableResourceForValidation;)
 
     bool                                fPreferVRAMUseOverFlushes;
+
+    // When non-zero, the most bytes purgeAsNeeded() releases in one call (see
+    // setIncrementalPurgeBytes()). fPurgingToLowWatermark is set once the budget is exceeded and
+    // stays set until the budgeted usage drops back under the low watermark.
+    size_t                              fIncrementalPurgeBytes;
+    bool                                fPurgingToLowWatermark;
+
+    // Ref'ed so that encodes still running on worker threads can outlive the cache.
+    sk_sp<GrCompressedImageCache>       fCompressedImageCache;
 };
 
 GR_MAKE_BITFIELD_CLASS_OPS(GrResourceCache::ScratchFlags);
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrSkSLCompilerPool.h"
+
+#include "SkSLCompiler.h"
+
+GrSkSLCompilerPool::Lease::Lease(GrSkSLCompilerPool* pool,
+                                 std::unique_ptr<SkSL::Compiler> compiler)
+        : fPool(pool)
+        , fCompiler(std::move(compiler)) {}
+
+GrSkSLCompilerPool::Lease::Lease(Lease&& that)
+        : fPool(that.fPool)
+        , fCompiler(std::move(that.fCompiler)) {}
+
+GrSkSLCompilerPool::Lease::~Lease() {
+    if (fCompiler) {
+        fPool->release(std::move(fCompiler));
+    }
+}
+
+GrSkSLCompilerPool::GrSkSLCompilerPool() {}
+
+GrSkSLCompilerPool::~GrSkSLCompilerPool() {}
+
+GrSkSLCompilerPool::Lease GrSkSLCompilerPool::acquire() {
+    {
+        SkAutoMutexAcquire lock(fMutex);
+        if (!fIdle.empty()) {
+            std::unique_ptr<SkSL::Compiler> compiler = std::move(fIdle.back());
+            fIdle.pop_back();
+            return Lease(this, std::move(compiler));
+        }
+    }
+    // Creating a compiler converts the shared built-in module, so do it outside the lock
+    return Lease(this, std::unique_ptr<SkSL::Compiler>(new SkSL::Compiler()));
+}
+
+void GrSkSLCompilerPool::release(std::unique_ptr<SkSL::Compiler> compiler) {
+    SkAutoMutexAcquire lock(fMutex);
+    fIdle.push_back(std::move(compiler));
+}
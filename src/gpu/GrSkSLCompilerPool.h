@@ -0,0 +1,67 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrSkSLCompilerPool_DEFINED
+#define GrSkSLCompilerPool_DEFINED
+
+#include "SkMutex.h"
+#include "SkNoncopyable.h"
+#include "SkTArray.h"
+
+#include <memory>
+
+namespace SkSL {
+    class Compiler;
+}
+
+/**
+ * A thread-safe set of SkSL::Compilers. A Compiler may only be used by one thread at a time, so
+ * each translation borrows one from the pool, and several threads can translate programs in
+ * parallel. Compilers are returned to the pool rather than destroyed, so the built-in modules
+ * each one has converted are reused by later translations.
+ *
+ * A Program refers to the built-in symbols of the Compiler that produced it, so it must be
+ * destroyed before that Compiler's Lease is.
+ */
+class GrSkSLCompilerPool : SkNoncopyable {
+public:
+    class Lease : SkNoncopyable {
+    public:
+        Lease(Lease&& that);
+
+        ~Lease();
+
+        SkSL::Compiler* get() const { return fCompiler.get(); }
+
+        SkSL::Compiler* operator->() const { return fCompiler.get(); }
+
+    private:
+        Lease(GrSkSLCompilerPool* pool, std::unique_ptr<SkSL::Compiler> compiler);
+
+        GrSkSLCompilerPool* fPool;
+        std::unique_ptr<SkSL::Compiler> fCompiler;
+
+        friend class GrSkSLCompilerPool;
+    };
+
+    GrSkSLCompilerPool();
+
+    ~GrSkSLCompilerPool();
+
+    /**
+     * Returns an idle compiler, creating one if every existing compiler is in use.
+     */
+    Lease acquire();
+
+private:
+    void release(std::unique_ptr<SkSL::Compiler> compiler);
+
+    SkMutex fMutex;
+    SkTArray<std::unique_ptr<SkSL::Compiler>> fIdle;
+};
+
+#endif
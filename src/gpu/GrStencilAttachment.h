@@ -28,6 +28,8 @@ public:
     bool isDirty() const { return fIsDirty; }
 
     void cleared() { fIsDirty = false; }
+    // Called when the backend discards the contents, e.g. with glInvalidateFramebuffer.
+    void discarded() { fIsDirty = true; }
 
     // We create a unique stencil buffer at each width, height and sampleCnt and share it for
     // all render targets that require a stencil with those params.
@@ -12,6 +12,7 @@
 #include "GrContextPriv.h"
 #include "GrGpu.h"
 #include "GrMemoryPool.h"
+#include "GrOpTimer.h"
 #include "GrRecordingContext.h"
 #include "GrRecordingContextPriv.h"
 #include "GrResourceAllocator.h"
@@ -106,6 +107,10 @@ bool GrTextureOpList::onExecute(GrOpFlushState* flushState) {
                          flushState->gpu()->getCommandBuffer(fTarget.get()->peekTexture(),
                                                              fTarget.get()->origin()));
     flushState->setCommandBuffer(commandBuffer);
+    GrOpTimer* opTimer = flushState->gpu()->opTimer();
+    if (opTimer) {
+        opTimer->beginOpList();
+    }
 
     for (int i = 0; i < fRecordedOps.count(); ++i) {
         if (!fRecordedOps[i]) {
@@ -121,8 +126,14 @@ bool GrTextureOpList::onExecute(GrOpFlushState* flushState) {
         flushState->setOpArgs(&opArgs);
         fRecordedOps[i]->execute(flushState, fRecordedOps[i].get()->bounds());
         flushState->setOpArgs(nullptr);
+        if (opTimer) {
+            opTimer->endOpChain(fRecordedOps[i]->name());
+        }
     }
 
+    if (opTimer) {
+        opTimer->endOpList("GrTextureOpList");
+    }
     flushState->gpu()->submit(commandBuffer);
     flushState->setCommandBuffer(nullptr);
 
@@ -117,6 +117,13 @@ void GrTextureProxyPriv::scheduleUpload(GrOpFlushState* flushState) {
     }
 }
 
+void GrTextureProxyPriv::uploadDeferredNow(GrGpu* gpu) {
+    // The texture proxy's contents may already have been uploaded or instantiation may have failed
+    if (fTextureProxy->fDeferredUploader && fTextureProxy->fTarget) {
+        fTextureProxy->fDeferredUploader->uploadNow(gpu, fTextureProxy);
+    }
+}
+
 void GrTextureProxyPriv::resetDeferredUploader() {
     SkASSERT(fTextureProxy->fDeferredUploader);
     fTextureProxy->fDeferredUploader.reset();
@@ -11,6 +11,7 @@
 #include "GrTextureProxy.h"
 
 class GrDeferredProxyUploader;
+class GrGpu;
 class GrOpFlushState;
 
 /**
@@ -24,6 +25,9 @@ public:
     // For a deferred proxy (one that has a deferred uploader attached), this schedules an ASAP
     // upload of that data to the instantiated texture.
     void scheduleUpload(GrOpFlushState*);
+    // For a deferred proxy, waits for its data and uploads it immediately. Used before the
+    // texture is read or exported without going through an op list.
+    void uploadDeferredNow(GrGpu*);
     // Clears any deferred uploader object on the proxy. Used to free the CPU data after the
     // contents have been uploaded.
     void resetDeferredUploader();
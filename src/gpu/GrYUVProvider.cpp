@@ -8,6 +8,8 @@
 #include "GrYUVProvider.h"
 #include "GrClip.h"
 #include "GrColorSpaceXform.h"
+#include "GrContextPriv.h"
+#include "GrDeferredProxyUploader.h"
 #include "GrProxyProvider.h"
 #include "GrRecordingContext.h"
 #include "GrRecordingContextPriv.h"
@@ -17,6 +19,8 @@
 #include "SkCachedData.h"
 #include "SkRefCnt.h"
 #include "SkResourceCache.h"
+#include "SkTaskGroup.h"
+#include "SkTraceEvent.h"
 #include "SkYUVPlanesCache.h"
 #include "SkYUVAIndex.h"
 #include "effects/GrYUVtoRGBEffect.h"
@@ -101,6 +105,167 @@ void GrYUVProvider::YUVGen_DataReleaseProc(const void*, void* data) {
     cachedData->unref();
 }
 
+// If the sizes of the components are not all the same we choose to create exact-match textures
+// for the smaller ones rather than add a texture domain to the draw.
+// TODO: revisit this decision to improve texture reuse?
+static SkBackingFit plane_fit(const SkYUVASizeInfo& yuvSizeInfo, int i) {
+    return (yuvSizeInfo.fSizes[i].fWidth  != yuvSizeInfo.fSizes[0].fWidth) ||
+           (yuvSizeInfo.fSizes[i].fHeight != yuvSizeInfo.fSizes[0].fHeight)
+               ? SkBackingFit::kExact : SkBackingFit::kApprox;
+}
+
+namespace {
+
+/**
+ * The planes of one image, decoded on a worker thread and shared by the uploaders of all of its
+ * plane proxies. The worker fills this in before signaling any of the uploaders.
+ */
+class DecodedYUVPlanes : public SkNVRefCnt<DecodedYUVPlanes> {
+public:
+    DecodedYUVPlanes(std::unique_ptr<GrYUVProvider> provider, const SkYUVASizeInfo& sizeInfo)
+            : fProvider(std::move(provider)), fSizeInfo(sizeInfo) {}
+
+    void decode() {
+        SkYUVASizeInfo sizeInfo;
+        SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount];
+        SkYUVColorSpace colorSpace;
+        fData = fProvider->getPlanes(&sizeInfo, yuvaIndices, &colorSpace, fPlanes);
+        // The proxies were sized from the query on the recording thread. Don't upload anything
+        // if the decoder changed its mind.
+        if (fData && !(sizeInfo == fSizeInfo)) {
+            fData.reset();
+        }
+        fProvider.reset();
+    }
+
+    bool isValid() const { return SkToBool(fData); }
+    const void* plane(int i) const { return fPlanes[i]; }
+    size_t rowBytes(int i) const { return fSizeInfo.fWidthBytes[i]; }
+
+private:
+    std::unique_ptr<GrYUVProvider> fProvider;
+    const SkYUVASizeInfo           fSizeInfo;
+    sk_sp<SkCachedData>            fData;
+    const void*                    fPlanes[SkYUVASizeInfo::kMaxCount] = {};
+};
+
+class YUVPlaneUploader : public GrDeferredProxyUploader {
+public:
+    YUVPlaneUploader(sk_sp<DecodedYUVPlanes> planes, int index)
+            : fPlanes(std::move(planes)), fIndex(index) {}
+
+    ~YUVPlaneUploader() override {
+        // The worker thread may still be decoding into fPlanes.
+        this->wait();
+    }
+
+private:
+    void onUpload(GrGpu*, GrTextureProxy* proxy,
+                  GrDeferredTextureUploadWritePixelsFn& writePixelsFn) override {
+        // If the decode failed we'll end up drawing with an uninitialized plane, but at least we
+        // won't crash.
+        if (fPlanes->isValid()) {
+            writePixelsFn(proxy, 0, 0, proxy->width(), proxy->height(), GrColorType::kAlpha_8,
+                          fPlanes->plane(fIndex), fPlanes->rowBytes(fIndex));
+        }
+    }
+
+    sk_sp<DecodedYUVPlanes> fPlanes;
+    int                     fIndex;
+};
+
+}  // anonymous namespace
+
+bool GrYUVProvider::makeThreadedPlaneProxies(GrRecordingContext* ctx,
+                                             SkYUVASizeInfo* yuvSizeInfo,
+                                             SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
+                                             SkYUVColorSpace* yuvColorSpace,
+                                             sk_sp<GrTextureProxy> proxies[]) {
+    if (!ctx->priv().options().fDecodeYUVImagesOnWorkerThreads) {
+        return false;
+    }
+    SkTaskGroup* taskGroup = nullptr;
+    if (auto direct = ctx->priv().asDirectContext()) {
+        taskGroup = direct->priv().getTaskGroup();
+    }
+    if (!taskGroup) {
+        return false;
+    }
+
+    // Planes that are already decoded are cheaper to upload directly.
+    SkYUVPlanesCache::Info cachedInfo;
+    sk_sp<SkCachedData> cachedData(SkYUVPlanesCache::FindAndRef(this->onGetID(), &cachedInfo));
+    if (cachedData) {
+        return false;
+    }
+
+    SkYUVASizeInfo sizeInfo;
+    SkYUVAIndex indices[SkYUVAIndex::kIndexCount];
+    SkYUVColorSpace colorSpace;
+    if (!this->onQueryYUVA8(&sizeInfo, indices, &colorSpace)) {
+        return false;
+    }
+    std::unique_ptr<GrYUVProvider> threadSafeProvider = this->makeThreadSafeProvider();
+    if (!threadSafeProvider) {
+        return false;
+    }
+
+    GrProxyProvider* proxyProvider = ctx->priv().proxyProvider();
+    const GrBackendFormat format =
+            ctx->priv().caps()->getBackendFormatFromColorType(kAlpha_8_SkColorType);
+    sk_sp<GrTextureProxy> planeProxies[SkYUVASizeInfo::kMaxCount];
+    for (int i = 0; i < SkYUVASizeInfo::kMaxCount; ++i) {
+        if (sizeInfo.fSizes[i].isEmpty()) {
+            SkASSERT(!sizeInfo.fWidthBytes[i]);
+            continue;
+        }
+
+        GrSurfaceDesc desc;
+        desc.fWidth = sizeInfo.fSizes[i].fWidth;
+        desc.fHeight = sizeInfo.fSizes[i].fHeight;
+        desc.fConfig = kAlpha_8_GrPixelConfig;
+
+        // We're going to fill this proxy with an ASAP upload (which is out of order wrt to ops),
+        // so it can't have any pending IO.
+        planeProxies[i] = proxyProvider->createProxy(format, desc, kTopLeft_GrSurfaceOrigin,
+                                                     plane_fit(sizeInfo, i), SkBudgeted::kYes,
+                                                     GrInternalSurfaceFlags::kNoPendingIO);
+        if (!planeProxies[i]) {
+            return false;
+        }
+    }
+
+    auto planes = sk_make_sp<DecodedYUVPlanes>(std::move(threadSafeProvider), sizeInfo);
+    GrDeferredProxyUploader* uploaders[SkYUVASizeInfo::kMaxCount] = {};
+    for (int i = 0; i < SkYUVASizeInfo::kMaxCount; ++i) {
+        if (planeProxies[i]) {
+            auto uploader = skstd::make_unique<YUVPlaneUploader>(planes, i);
+            uploaders[i] = uploader.get();
+            planeProxies[i]->texPriv().setDeferredUploader(std::move(uploader));
+        }
+    }
+
+    // Each uploader waits for its signal before it can be destroyed, so they all outlive the task.
+    auto decodeAndSignal = [planes, uploaders] {
+        TRACE_EVENT0("skia", "Threaded YUV Decode");
+        planes->decode();
+        for (GrDeferredProxyUploader* uploader : uploaders) {
+            if (uploader) {
+                uploader->signalAndFreeData();
+            }
+        }
+    };
+    taskGroup->add(std::move(decodeAndSignal));
+
+    *yuvSizeInfo = sizeInfo;
+    memcpy(yuvaIndices, indices, sizeof(indices));
+    *yuvColorSpace = colorSpace;
+    for (int i = 0; i < SkYUVASizeInfo::kMaxCount; ++i) {
+        proxies[i] = std::move(planeProxies[i]);
+    }
+    return true;
+}
+
 sk_sp<GrTextureProxy> GrYUVProvider::refAsTextureProxy(GrRecordingContext* ctx,
                                                        const GrBackendFormat& format,
                                                        const GrSurfaceDesc& desc,
@@ -109,50 +274,50 @@ sk_sp<GrTextureProxy> GrYUVProvider::refAsTextureProxy(GrRecordingContext* ctx,
     SkYUVASizeInfo yuvSizeInfo;
     SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount];
     SkYUVColorSpace yuvColorSpace;
-    const void* planes[SkYUVASizeInfo::kMaxCount];
+    sk_sp<GrTextureProxy> yuvTextureProxies[SkYUVASizeInfo::kMaxCount];
 
-    sk_sp<SkCachedData> dataStorage = this->getPlanes(&yuvSizeInfo, yuvaIndices,
-                                                      &yuvColorSpace, planes);
-    if (!dataStorage) {
-        return nullptr;
-    }
+    if (!this->makeThreadedPlaneProxies(ctx, &yuvSizeInfo, yuvaIndices, &yuvColorSpace,
+                                        yuvTextureProxies)) {
+        const void* planes[SkYUVASizeInfo::kMaxCount];
 
-    sk_sp<GrTextureProxy> yuvTextureProxies[SkYUVASizeInfo::kMaxCount];
-    for (int i = 0; i < SkYUVASizeInfo::kMaxCount; ++i) {
-        if (yuvSizeInfo.fSizes[i].isEmpty()) {
-            SkASSERT(!yuvSizeInfo.fWidthBytes[i]);
-            continue;
+        sk_sp<SkCachedData> dataStorage = this->getPlanes(&yuvSizeInfo, yuvaIndices,
+                                                          &yuvColorSpace, planes);
+        if (!dataStorage) {
+            return nullptr;
         }
 
-        int componentWidth  = yuvSizeInfo.fSizes[i].fWidth;
-        int componentHeight = yuvSizeInfo.fSizes[i].fHeight;
-        // If the sizes of the components are not all the same we choose to create exact-match
-        // textures for the smaller ones rather than add a texture domain to the draw.
-        // TODO: revisit this decision to improve texture reuse?
-        SkBackingFit fit =
-                (componentWidth  != yuvSizeInfo.fSizes[0].fWidth) ||
-                (componentHeight != yuvSizeInfo.fSizes[0].fHeight)
-                    ? SkBackingFit::kExact : SkBackingFit::kApprox;
-
-        SkImageInfo imageInfo = SkImageInfo::MakeA8(componentWidth, componentHeight);
-        SkPixmap pixmap(imageInfo, planes[i], yuvSizeInfo.fWidthBytes[i]);
-        SkCachedData* dataStoragePtr = dataStorage.get();
-        // We grab a ref to cached yuv data. When the SkImage we create below goes away it will call
-        // the YUVGen_DataReleaseProc which will release this ref.
-        // DDL TODO: Currently we end up creating a lazy proxy that will hold onto a ref to the
-        // SkImage in its lambda. This means that we'll keep the ref on the YUV data around for the
-        // life time of the proxy and not just upload. For non-DDL draws we should look into
-        // releasing this SkImage after uploads (by deleting the lambda after instantiation).
-        dataStoragePtr->ref();
-        sk_sp<SkImage> yuvImage = SkImage::MakeFromRaster(pixmap, YUVGen_DataReleaseProc,
-                                                          dataStoragePtr);
-
-        auto proxyProvider = ctx->priv().proxyProvider();
-        yuvTextureProxies[i] = proxyProvider->createTextureProxy(yuvImage, kNone_GrSurfaceFlags,
-                                                                 1, SkBudgeted::kYes, fit);
-
-        SkASSERT(yuvTextureProxies[i]->width() == yuvSizeInfo.fSizes[i].fWidth);
-        SkASSERT(yuvTextureProxies[i]->height() == yuvSizeInfo.fSizes[i].fHeight);
+        for (int i = 0; i < SkYUVASizeInfo::kMaxCount; ++i) {
+            if (yuvSizeInfo.fSizes[i].isEmpty()) {
+                SkASSERT(!yuvSizeInfo.fWidthBytes[i]);
+                continue;
+            }
+
+            int componentWidth  = yuvSizeInfo.fSizes[i].fWidth;
+            int componentHeight = yuvSizeInfo.fSizes[i].fHeight;
+            SkBackingFit fit = plane_fit(yuvSizeInfo, i);
+
+            SkImageInfo imageInfo = SkImageInfo::MakeA8(componentWidth, componentHeight);
+            SkPixmap pixmap(imageInfo, planes[i], yuvSizeInfo.fWidthBytes[i]);
+            SkCachedData* dataStoragePtr = dataStorage.get();
+            // We grab a ref to cached yuv data. When the SkImage we create below goes away it will
+            // call the YUVGen_DataReleaseProc which will release this ref.
+            // DDL TODO: Currently we end up creating a lazy proxy that will hold onto a ref to the
+            // SkImage in its lambda. This means that we'll keep the ref on the YUV data around for
+            // the life time of the proxy and not just upload. For non-DDL draws we should look
+            // into releasing this SkImage after uploads (by deleting the lambda after
+            // instantiation).
+            dataStoragePtr->ref();
+            sk_sp<SkImage> yuvImage = SkImage::MakeFromRaster(pixmap, YUVGen_DataReleaseProc,
+                                                              dataStoragePtr);
+
+            auto proxyProvider = ctx->priv().proxyProvider();
+            yuvTextureProxies[i] = proxyProvider->createTextureProxy(yuvImage,
+                                                                     kNone_GrSurfaceFlags, 1,
+                                                                     SkBudgeted::kYes, fit);
+
+            SkASSERT(yuvTextureProxies[i]->width() == yuvSizeInfo.fSizes[i].fWidth);
+            SkASSERT(yuvTextureProxies[i]->height() == yuvSizeInfo.fSizes[i].fHeight);
+        }
     }
 
     // TODO: investigate preallocating mip maps here
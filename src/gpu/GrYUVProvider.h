@@ -13,6 +13,8 @@
 #include "SkYUVAIndex.h"
 #include "SkYUVASizeInfo.h"
 
+#include <memory>
+
 class GrBackendFormat;
 class GrRecordingContext;
 struct GrSurfaceDesc;
@@ -50,9 +52,23 @@ public:
     sk_sp<SkCachedData> getPlanes(SkYUVASizeInfo*, SkYUVAIndex[SkYUVAIndex::kIndexCount],
                                   SkYUVColorSpace*, const void* planes[SkYUVASizeInfo::kMaxCount]);
 
+    /**
+     *  Returns a provider for the same data that may outlive this one and be used on a worker
+     *  thread. refAsTextureProxy() uses it to decode the planes off of the calling thread when the
+     *  context allows it. The default returns nullptr: the planes are always decoded in place.
+     */
+    virtual std::unique_ptr<GrYUVProvider> makeThreadSafeProvider() const { return nullptr; }
+
 private:
     virtual uint32_t onGetID() const = 0;
 
+    // Creates the plane proxies with deferred uploaders and hands the decode to the context's
+    // task group. Returns false, without modifying the parameters, if the planes should be
+    // decoded on the calling thread instead.
+    bool makeThreadedPlaneProxies(GrRecordingContext*, SkYUVASizeInfo*,
+                                  SkYUVAIndex[SkYUVAIndex::kIndexCount], SkYUVColorSpace*,
+                                  sk_sp<GrTextureProxy>[SkYUVASizeInfo::kMaxCount]);
+
     // These are not meant to be called by a client, only by the implementation
 
     /**
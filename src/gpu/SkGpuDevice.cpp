@@ -14,6 +14,7 @@
 #include "GrContextPriv.h"
 #include "GrGpu.h"
 #include "GrImageTextureMaker.h"
+#include "GrProxyProvider.h"
 #include "GrRenderTargetContextPriv.h"
 #include "GrShape.h"
 #include "GrStyle.h"
@@ -179,11 +180,11 @@ sk_sp<SkSpecialImage> SkGpuDevice::filterTexture(SkSpecialImage* srcImg,
     SkMatrix matrix = this->ctm();
     matrix.postTranslate(SkIntToScalar(-left), SkIntToScalar(-top));
     const SkIRect clipBounds = this->devClipBounds().makeOffset(-left, -top);
-    sk_sp<SkImageFilterCache> cache(this->getImageFilterCache());
     SkColorType colorType;
     if (!GrPixelConfigToColorType(fRenderTargetContext->colorSpaceInfo().config(), &colorType)) {
         colorType = kN32_SkColorType;
     }
+    sk_sp<SkImageFilterCache> cache(this->getImageFilterCache(filter, clipBounds, colorType));
     SkImageFilter::OutputProperties outputProperties(
             colorType, fRenderTargetContext->colorSpaceInfo().colorSpace());
     SkImageFilter::Context ctx(matrix, clipBounds, cache.get(), outputProperties);
@@ -1612,6 +1613,83 @@ void SkGpuDevice::drawDrawable(SkDrawable* drawable, const SkMatrix* matrix, SkC
     this->INHERITED::drawDrawable(drawable, matrix, canvas);
 }
 
+bool SkGpuDevice::drawRetainedPicture(const SkPicture* picture, const SkMatrix* matrix) {
+    // DDL recording contexts can't render the picture now, so they always play it back.
+    if (!fContext->priv().options().fRetainPictureDraws || !fContext->priv().asDirectContext()) {
+        return false;
+    }
+
+    SkMatrix ctm = this->ctm();
+    if (matrix) {
+        ctm.preConcat(*matrix);
+    }
+    if (ctm.hasPerspective()) {
+        return false;
+    }
+    SkIRect bounds = ctm.mapRect(picture->cullRect()).roundOut();
+    static constexpr int kMaxRetainedSize = 2048;
+    int maxSize = SkTMin(kMaxRetainedSize, fContext->priv().caps()->maxRenderTargetSize());
+    if (bounds.isEmpty() || bounds.width() > maxSize || bounds.height() > maxSize) {
+        return false;
+    }
+    // The picture is rendered relative to its device bounds, so only the fractional part of the
+    // translation distinguishes otherwise identical renderings.
+    SkMatrix renderMatrix = ctm;
+    renderMatrix.postTranslate(-SkIntToScalar(bounds.fLeft), -SkIntToScalar(bounds.fTop));
+
+    // Pictures are immutable and their IDs are never reused, so the key never goes stale; unused
+    // renderings are purged like any other budgeted resource.
+    const SkImageInfo& deviceInfo = this->imageInfo();
+    uint64_t colorSpaceHash = deviceInfo.colorSpace() ? deviceInfo.colorSpace()->hash() : 0;
+    GrUniqueKey key;
+    static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
+    GrUniqueKey::Builder builder(&key, kDomain, 11, "Retained Picture");
+    builder[0] = picture->uniqueID();
+    builder[1] = SkFloat2Bits(renderMatrix.getScaleX());
+    builder[2] = SkFloat2Bits(renderMatrix.getSkewX());
+    builder[3] = SkFloat2Bits(renderMatrix.getSkewY());
+    builder[4] = SkFloat2Bits(renderMatrix.getScaleY());
+    builder[5] = SkFloat2Bits(renderMatrix.getTranslateX());
+    builder[6] = SkFloat2Bits(renderMatrix.getTranslateY());
+    builder[7] = bounds.width() | (bounds.height() << 16);
+    builder[8] = deviceInfo.colorType() | (this->surfaceProps().pixelGeometry() << 8);
+    builder[9] = (uint32_t)colorSpaceHash;
+    builder[10] = (uint32_t)(colorSpaceHash >> 32);
+    builder.finish();
+
+    GrProxyProvider* proxyProvider = fContext->priv().proxyProvider();
+    sk_sp<GrTextureProxy> proxy =
+            proxyProvider->findOrCreateProxyByUniqueKey(key, kTopLeft_GrSurfaceOrigin);
+    if (!proxy) {
+        SkImageInfo info = deviceInfo.makeWH(bounds.width(), bounds.height());
+        sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(
+                fContext.get(), SkBudgeted::kYes, info, fRenderTargetContext->numColorSamples(),
+                kTopLeft_GrSurfaceOrigin, &this->surfaceProps());
+        if (!surface) {
+            return false;
+        }
+        SkCanvas* canvas = surface->getCanvas();
+        canvas->clear(SK_ColorTRANSPARENT);
+        canvas->concat(renderMatrix);
+        // Nested pictures reach drawPicture() again and are retained on their own.
+        picture->playback(canvas);
+        sk_sp<SkImage> image = surface->makeImageSnapshot();
+        proxy = image ? as_IB(image)->asTextureProxyRef(fContext.get()) : nullptr;
+        if (!proxy) {
+            return false;
+        }
+        proxyProvider->assignUniqueKeyToProxy(key, proxy.get());
+    }
+
+    fRenderTargetContext->drawTexture(this->clip(), std::move(proxy),
+                                      GrSamplerState::Filter::kNearest, SkBlendMode::kSrcOver,
+                                      SK_PMColor4fWHITE, SkRect::MakeIWH(bounds.width(),
+                                                                         bounds.height()),
+                                      SkRect::Make(bounds), GrAA::kNo, GrQuadAAFlags::kNone,
+                                      SkCanvas::kFast_SrcRectConstraint, SkMatrix::I(), nullptr);
+    return true;
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -1688,10 +1766,13 @@ sk_sp<SkSurface> SkGpuDevice::makeSurface(const SkImageInfo& info, const SkSurfa
                                        fRenderTargetContext->origin(), &props);
 }
 
-SkImageFilterCache* SkGpuDevice::getImageFilterCache() {
+SkImageFilterCache* SkGpuDevice::getImageFilterCache(const SkImageFilter* dag,
+                                                     const SkIRect& clipBounds,
+                                                     SkColorType colorType) {
     ASSERT_SINGLE_OWNER
     // We always return a transient cache, so it is freed after each
     // filter traversal.
-    return SkImageFilterCache::Create(SkImageFilterCache::kDefaultTransientSize);
+    return SkImageFilterCache::Create(
+            SkImageFilterCache::TransientSize(dag, clipBounds, colorType));
 }
 
@@ -110,6 +110,8 @@ public:
 
     void drawDrawable(SkDrawable*, const SkMatrix*, SkCanvas* canvas) override;
 
+    bool drawRetainedPicture(const SkPicture*, const SkMatrix*) override;
+
     void drawSpecial(SkSpecialImage*, int left, int top, const SkPaint& paint,
                      SkImage*, const SkMatrix&) override;
     sk_sp<SkSpecialImage> makeSpecial(const SkBitmap&) override;
@@ -166,7 +168,8 @@ private:
 
     sk_sp<SkSurface> makeSurface(const SkImageInfo&, const SkSurfaceProps&) override;
 
-    SkImageFilterCache* getImageFilterCache() override;
+    SkImageFilterCache* getImageFilterCache(const SkImageFilter*, const SkIRect& clipBounds,
+                                            SkColorType) override;
 
     bool forceConservativeRasterClip() const override { return true; }
 
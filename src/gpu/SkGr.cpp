@@ -322,6 +322,17 @@ GrPixelConfig SkImageInfo2GrPixelConfig(const SkImageInfo& info) {
     return SkColorType2GrPixelConfig(info.colorType());
 }
 
+GrPixelConfig SkCompressionTypeToGrPixelConfig(SkImage::CompressionType type) {
+    switch (type) {
+        case SkImage::kETC1_CompressionType:
+            return kRGB_ETC1_GrPixelConfig;
+        case SkImage::kBC1_CompressionType:
+            return kRGB_BC1_GrPixelConfig;
+    }
+    SkASSERT(0);    // shouldn't get here
+    return kUnknown_GrPixelConfig;
+}
+
 bool GrPixelConfigToColorType(GrPixelConfig config, SkColorType* ctOut) {
     SkColorType ct = GrColorTypeToSkColorType(GrPixelConfigToColorType(config));
     if (kUnknown_SkColorType != ct) {
@@ -366,6 +377,7 @@ static inline int32_t dither_range_type_for_config(GrPixelConfig dstConfig) {
         case kRGBA_half_GrPixelConfig:
         case kRGBA_half_Clamped_GrPixelConfig:
         case kRGB_ETC1_GrPixelConfig:
+        case kRGB_BC1_GrPixelConfig:
         case kAlpha_8_GrPixelConfig:
         case kAlpha_8_as_Alpha_GrPixelConfig:
         case kAlpha_8_as_Red_GrPixelConfig:
@@ -17,6 +17,7 @@
 #include "SkColor.h"
 #include "SkColorData.h"
 #include "SkFilterQuality.h"
+#include "SkImage.h"
 #include "SkImageInfo.h"
 #include "SkMatrix.h"
 #include "SkVertices.h"
@@ -128,6 +129,7 @@ bool SkPaintToGrPaintWithTexture(GrRecordingContext*,
 GrSurfaceDesc GrImageInfoToSurfaceDesc(const SkImageInfo&);
 GrPixelConfig SkColorType2GrPixelConfig(const SkColorType);
 GrPixelConfig SkImageInfo2GrPixelConfig(const SkImageInfo& info);
+GrPixelConfig SkCompressionTypeToGrPixelConfig(SkImage::CompressionType);
 
 bool GrPixelConfigToColorType(GrPixelConfig, SkColorType*);
 
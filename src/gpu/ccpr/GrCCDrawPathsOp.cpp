@@ -7,10 +7,13 @@
 
 #include "GrCCDrawPathsOp.h"
 
+#include "GrContext.h"
+#include "GrContextPriv.h"
 #include "GrMemoryPool.h"
 #include "GrOpFlushState.h"
 #include "GrRecordingContext.h"
 #include "GrRecordingContextPriv.h"
+#include "SkTaskGroup.h"
 #include "ccpr/GrCCPathCache.h"
 #include "ccpr/GrCCPerFlushResources.h"
 #include "ccpr/GrCoverageCountingPathRenderer.h"
@@ -93,8 +96,18 @@ std::unique_ptr<GrCCDrawPathsOp> GrCCDrawPathsOp::InternalMake(
     }
 
     GrOpMemoryPool* pool = context->priv().opMemoryPool();
-    return pool->allocate<GrCCDrawPathsOp>(m, shape, strokeDevWidth, shapeConservativeIBounds,
-                                           maskDevIBounds, conservativeDevBounds, std::move(paint));
+    std::unique_ptr<GrCCDrawPathsOp> op = pool->allocate<GrCCDrawPathsOp>(
+            m, shape, strokeDevWidth, shapeConservativeIBounds, maskDevIBounds,
+            conservativeDevBounds, std::move(paint));
+
+    // Path-heavy content spends most of its flush time chopping fills into CCPR verbs. Do that now
+    // on the context's executor, and leave only atlas placement for preFlush.
+    if (auto direct = context->priv().asDirectContext()) {
+        if (SkTaskGroup* taskGroup = direct->priv().getTaskGroup()) {
+            op->fDraws.head().prepareFillAsync(taskGroup);
+        }
+    }
+    return op;
 }
 
 GrCCDrawPathsOp::GrCCDrawPathsOp(const SkMatrix& m, const GrShape& shape, float strokeDevWidth,
@@ -139,6 +152,25 @@ GrCCDrawPathsOp::SingleDraw::SingleDraw(const SkMatrix& m, const GrShape& shape,
 #endif
 }
 
+void GrCCDrawPathsOp::SingleDraw::prepareFillAsync(SkTaskGroup* taskGroup) {
+    // Small paths aren't worth the overhead of a task.
+    static constexpr int kMinVerbsToPrepareAsync = 16;
+
+    SkASSERT(!fPreparedFill);
+    if (!fShape.style().isSimpleFill() || fShape.inverseFilled()) {
+        return;  // Strokes are still parsed at flush time.
+    }
+    SkPath path;
+    fShape.asPath(&path);
+    if (path.countVerbs() < kMinVerbsToPrepareAsync) {
+        return;
+    }
+
+    fPreparedFill = sk_make_sp<GrCCPreparedFill>(fMatrix, path);
+    sk_sp<GrCCPreparedFill> preparedFill = fPreparedFill;
+    taskGroup->add([preparedFill] { preparedFill->prepare(); });
+}
+
 GrProcessorSet::Analysis GrCCDrawPathsOp::finalize(const GrCaps& caps, const GrAppliedClip* clip,
                                                    GrFSAAType fsaaType, GrClampType clampType) {
     SkASSERT(1 == fNumDraws);  // There should only be one single path draw in this Op right now.
@@ -364,9 +396,19 @@ void GrCCDrawPathsOp::SingleDraw::setupResources(
     SkRect devBounds, devBounds45;
     SkIRect devIBounds;
     SkIVector devToAtlasOffset;
-    if (auto atlas = resources->renderShapeInAtlas(
-                fMaskDevIBounds, fMatrix, fShape, fStrokeDevWidth, &devBounds, &devBounds45,
-                &devIBounds, &devToAtlasOffset)) {
+    GrCCAtlas* atlas;
+    if (fPreparedFill) {
+        fPreparedFill->wait();
+        atlas = resources->renderPreparedFillInAtlas(fMaskDevIBounds, *fPreparedFill, &devBounds,
+                                                     &devBounds45, &devIBounds,
+                                                     &devToAtlasOffset);
+        fPreparedFill.reset();
+    } else {
+        atlas = resources->renderShapeInAtlas(fMaskDevIBounds, fMatrix, fShape, fStrokeDevWidth,
+                                              &devBounds, &devBounds45, &devIBounds,
+                                              &devToAtlasOffset);
+    }
+    if (atlas) {
         op->recordInstance(atlas->textureProxy(), resources->nextPathInstanceIdx());
         resources->appendDrawPathInstance().set(devBounds, devBounds45, devToAtlasOffset,
                                                 SkPMColor4f_toFP16(fColor), doEvenOddFill);
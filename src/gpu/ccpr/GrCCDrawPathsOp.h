@@ -16,10 +16,12 @@
 
 class GrCCAtlas;
 class GrCCPerFlushResources;
+class GrCCPreparedFill;
 struct GrCCPerFlushResourceSpecs;
 struct GrCCPerOpListPaths;
 class GrOnFlushResourceProvider;
 class GrRecordingContext;
+class SkTaskGroup;
 
 /**
  * This is the Op that draws paths to the actual canvas, using atlases generated by CCPR.
@@ -99,6 +101,10 @@ private:
         void setupResources(GrCCPathCache*, GrOnFlushResourceProvider*, GrCCPerFlushResources*,
                             DoCopiesToA8Coverage, GrCCDrawPathsOp*);
 
+        // Starts mapping and chopping a fill path on the task group, so setupResources() doesn't
+        // have to do it on the flush thread.
+        void prepareFillAsync(SkTaskGroup*);
+
     private:
         bool shouldCachePathMask(int maxRenderTargetSize) const;
 
@@ -114,6 +120,8 @@ private:
         bool fDoCopyToA8Coverage = false;
         bool fDoCachePathMask = false;
 
+        sk_sp<GrCCPreparedFill> fPreparedFill;
+
         SingleDraw* fNext = nullptr;
 
         friend class GrCCSTLList<SingleDraw>;  // To access fNext.
@@ -15,6 +15,14 @@
 
 static constexpr float kFlatnessThreshold = 1/16.f; // 1/16 of a pixel.
 
+void GrCCFillGeometry::append(const GrCCFillGeometry& that) {
+    SkASSERT(!fBuildingContour);
+    SkASSERT(!that.fBuildingContour);
+    fPoints.push_back_n(that.fPoints.count(), that.fPoints.begin());
+    fVerbs.push_back_n(that.fVerbs.count(), that.fVerbs.begin());
+    fConicWeights.push_back_n(that.fConicWeights.count(), that.fConicWeights.begin());
+}
+
 void GrCCFillGeometry::beginPath() {
     SkASSERT(!fBuildingContour);
     fVerbs.push_back(Verb::kBeginPath);
@@ -64,6 +64,9 @@ public:
         fVerbs.reset();
     }
 
+    // Appends all of the given geometry's finished paths onto this one.
+    void append(const GrCCFillGeometry&);
+
     void beginPath();
     void beginContour(const SkPoint&);
     void lineTo(const SkPoint P[2]);
@@ -40,9 +40,33 @@ void GrCCFiller::parseDeviceSpaceFill(const SkPath& path, const SkPoint* deviceS
 
     int currPathPointsIdx = fGeometry.points().count();
     int currPathVerbsIdx = fGeometry.verbs().count();
+    PrimitiveTallies currPathPrimitiveCounts = ChopDeviceSpaceFill(path, deviceSpacePts,
+                                                                   &fGeometry);
+    this->finishPath(currPathVerbsIdx, currPathPointsIdx, currPathPrimitiveCounts, scissorTest,
+                     clippedDevIBounds, devToAtlasOffset);
+}
+
+void GrCCFiller::parsePreparedFill(const GrCCFillGeometry& choppedPath,
+                                   const PrimitiveTallies& primitiveCounts,
+                                   GrScissorTest scissorTest, const SkIRect& clippedDevIBounds,
+                                   const SkIVector& devToAtlasOffset) {
+    SkASSERT(!fInstanceBuffer);  // Can't call after prepareToDraw().
+    SkASSERT(!choppedPath.verbs().empty());
+    SkASSERT(GrCCFillGeometry::Verb::kBeginPath == choppedPath.verbs().front());
+
+    int currPathPointsIdx = fGeometry.points().count();
+    int currPathVerbsIdx = fGeometry.verbs().count();
+    fGeometry.append(choppedPath);
+    this->finishPath(currPathVerbsIdx, currPathPointsIdx, primitiveCounts, scissorTest,
+                     clippedDevIBounds, devToAtlasOffset);
+}
+
+GrCCFiller::PrimitiveTallies GrCCFiller::ChopDeviceSpaceFill(const SkPath& path,
+                                                             const SkPoint* deviceSpacePts,
+                                                             GrCCFillGeometry* geometry) {
     PrimitiveTallies currPathPrimitiveCounts = PrimitiveTallies();
 
-    fGeometry.beginPath();
+    geometry->beginPath();
 
     const float* conicWeights = SkPathPriv::ConicWeightData(path);
     int ptsIdx = 0;
@@ -53,32 +77,32 @@ void GrCCFiller::parseDeviceSpaceFill(const SkPath& path, const SkPoint* deviceS
         switch (verb) {
             case SkPath::kMove_Verb:
                 if (insideContour) {
-                    currPathPrimitiveCounts += fGeometry.endContour();
+                    currPathPrimitiveCounts += geometry->endContour();
                 }
-                fGeometry.beginContour(deviceSpacePts[ptsIdx]);
+                geometry->beginContour(deviceSpacePts[ptsIdx]);
                 ++ptsIdx;
                 insideContour = true;
                 continue;
             case SkPath::kClose_Verb:
                 if (insideContour) {
-                    currPathPrimitiveCounts += fGeometry.endContour();
+                    currPathPrimitiveCounts += geometry->endContour();
                 }
                 insideContour = false;
                 continue;
             case SkPath::kLine_Verb:
-                fGeometry.lineTo(&deviceSpacePts[ptsIdx - 1]);
+                geometry->lineTo(&deviceSpacePts[ptsIdx - 1]);
                 ++ptsIdx;
                 continue;
             case SkPath::kQuad_Verb:
-                fGeometry.quadraticTo(&deviceSpacePts[ptsIdx - 1]);
+                geometry->quadraticTo(&deviceSpacePts[ptsIdx - 1]);
                 ptsIdx += 2;
                 continue;
             case SkPath::kCubic_Verb:
-                fGeometry.cubicTo(&deviceSpacePts[ptsIdx - 1]);
+                geometry->cubicTo(&deviceSpacePts[ptsIdx - 1]);
                 ptsIdx += 3;
                 continue;
             case SkPath::kConic_Verb:
-                fGeometry.conicTo(&deviceSpacePts[ptsIdx - 1], conicWeights[conicWeightsIdx]);
+                geometry->conicTo(&deviceSpacePts[ptsIdx - 1], conicWeights[conicWeightsIdx]);
                 ptsIdx += 2;
                 ++conicWeightsIdx;
                 continue;
@@ -90,9 +114,14 @@ void GrCCFiller::parseDeviceSpaceFill(const SkPath& path, const SkPoint* deviceS
     SkASSERT(conicWeightsIdx == SkPathPriv::ConicWeightCnt(path));
 
     if (insideContour) {
-        currPathPrimitiveCounts += fGeometry.endContour();
+        currPathPrimitiveCounts += geometry->endContour();
     }
+    return currPathPrimitiveCounts;
+}
 
+void GrCCFiller::finishPath(int currPathVerbsIdx, int currPathPointsIdx,
+                            PrimitiveTallies currPathPrimitiveCounts, GrScissorTest scissorTest,
+                            const SkIRect& clippedDevIBounds, const SkIVector& devToAtlasOffset) {
     fPathInfos.emplace_back(scissorTest, devToAtlasOffset);
 
     // Tessellate fans from very large and/or simple paths, in order to reduce overdraw.
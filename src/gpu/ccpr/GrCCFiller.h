@@ -34,6 +34,20 @@ public:
     void parseDeviceSpaceFill(const SkPath&, const SkPoint* deviceSpacePts, GrScissorTest,
                               const SkIRect& clippedDevIBounds, const SkIVector& devToAtlasOffset);
 
+    // Same as parseDeviceSpaceFill(), but for a path that was already chopped into CCPR verbs by
+    // ChopDeviceSpaceFill(). 'primitiveCounts' must be the tallies that ChopDeviceSpaceFill()
+    // returned for it.
+    void parsePreparedFill(const GrCCFillGeometry& choppedPath,
+                           const GrCCFillGeometry::PrimitiveTallies& primitiveCounts, GrScissorTest,
+                           const SkIRect& clippedDevIBounds, const SkIVector& devToAtlasOffset);
+
+    // Chops a device-space SkPath into CCPR verbs, appending it to 'geometry' as a single path.
+    // Returns the numbers of primitives needed to draw it. This does not depend on any filler
+    // state, so it is safe to call from other threads (e.g. while recording draws).
+    static GrCCFillGeometry::PrimitiveTallies ChopDeviceSpaceFill(const SkPath&,
+                                                                  const SkPoint* deviceSpacePts,
+                                                                  GrCCFillGeometry* geometry);
+
     using BatchID = int;
 
     // Compiles the outstanding parsed paths into a batch, and returns an ID that can be used to
@@ -95,6 +109,12 @@ private:
         SkIRect fScissor;
     };
 
+    // Records the PathInfo, fan tessellation, and scissor of a path that was just chopped into
+    // fGeometry, starting at the given indices.
+    void finishPath(int currPathVerbsIdx, int currPathPointsIdx,
+                    PrimitiveTallies currPathPrimitiveCounts, GrScissorTest,
+                    const SkIRect& clippedDevIBounds, const SkIVector& devToAtlasOffset);
+
     void drawPrimitives(GrOpFlushState*, const GrPipeline&, BatchID,
                         GrCCCoverageProcessor::PrimitiveType, int PrimitiveTallies::*instanceType,
                         const SkIRect& drawBounds) const;
@@ -332,6 +332,20 @@ static bool transform_path_pts(const SkMatrix& m, const SkPath& path,
     return true;
 }
 
+void GrCCPreparedFill::prepare() {
+    if (!fPath.isEmpty()) {
+        SkAutoSTArray<32, SkPoint> devPts(fPath.countPoints() + 1);
+        if (transform_path_pts(fMatrix, fPath, devPts, &fDevBounds, &fDevBounds45)) {
+            fPrimitiveCounts = GrCCFiller::ChopDeviceSpaceFill(fPath, devPts.begin(),
+                                                               &fChoppedPath);
+            fValid = true;
+        }
+    }
+    // Don't hold a ref on the path past flush.
+    fPath.reset();
+    fDone.signal();
+}
+
 GrCCAtlas* GrCCPerFlushResources::renderShapeInAtlas(
         const SkIRect& clipIBounds, const SkMatrix& m, const GrShape& shape, float strokeDevWidth,
         SkRect* devBounds, SkRect* devBounds45, SkIRect* devIBounds, SkIVector* devToAtlasOffset) {
@@ -383,6 +397,35 @@ GrCCAtlas* GrCCPerFlushResources::renderShapeInAtlas(
     return &fRenderedAtlasStack.current();
 }
 
+GrCCAtlas* GrCCPerFlushResources::renderPreparedFillInAtlas(
+        const SkIRect& clipIBounds, const GrCCPreparedFill& preparedFill, SkRect* devBounds,
+        SkRect* devBounds45, SkIRect* devIBounds, SkIVector* devToAtlasOffset) {
+    SkASSERT(this->isMapped());
+    SkASSERT(fNextPathInstanceIdx < fEndPathInstance);
+
+    if (!preparedFill.isValid()) {
+        // The path was empty, or had infinite or NaN bounds once transformed.
+        SkDEBUGCODE(--fEndPathInstance);
+        return nullptr;
+    }
+
+    *devBounds = preparedFill.devBounds();
+    *devBounds45 = preparedFill.devBounds45();
+    devBounds->roundOut(devIBounds);
+
+    GrScissorTest scissorTest;
+    SkIRect clippedPathIBounds;
+    if (!this->placeRenderedPathInAtlas(clipIBounds, *devIBounds, &scissorTest, &clippedPathIBounds,
+                                        devToAtlasOffset)) {
+        SkDEBUGCODE(--fEndPathInstance);
+        return nullptr;  // Path was degenerate or clipped away.
+    }
+
+    fFiller.parsePreparedFill(preparedFill.choppedPath(), preparedFill.primitiveCounts(),
+                              scissorTest, clippedPathIBounds, *devToAtlasOffset);
+    return &fRenderedAtlasStack.current();
+}
+
 const GrCCAtlas* GrCCPerFlushResources::renderDeviceSpacePathInAtlas(
         const SkIRect& clipIBounds, const SkPath& devPath, const SkIRect& devPathIBounds,
         SkIVector* devToAtlasOffset) {
@@ -9,6 +9,7 @@
 #define GrCCPerFlushResources_DEFINED
 
 #include "GrNonAtomicRef.h"
+#include "SkSemaphore.h"
 #include "ccpr/GrCCAtlas.h"
 #include "ccpr/GrCCFiller.h"
 #include "ccpr/GrCCStroker.h"
@@ -31,6 +32,41 @@ struct GrCCRenderedPathStats {
     void statPath(const SkPath&);
 };
 
+/**
+ * A fill path that has been mapped to device space and chopped into CCPR verbs ahead of time.
+ * GrCCDrawPathsOp builds these on the context's executor while draws are still being recorded, so
+ * that preFlush only has to place them in an atlas.
+ */
+class GrCCPreparedFill : public SkNVRefCnt<GrCCPreparedFill> {
+public:
+    GrCCPreparedFill(const SkMatrix& m, const SkPath& path) : fMatrix(m), fPath(path) {}
+
+    // Maps the path by the matrix and chops it into CCPR verbs. May be called on any thread. The
+    // path is released before this returns.
+    void prepare();
+
+    // Blocks until prepare() has finished. Must only be called once.
+    void wait() { fDone.wait(); }
+
+    // False if the path was empty or its device-space bounds were infinite or NaN.
+    bool isValid() const { return fValid; }
+
+    const GrCCFillGeometry& choppedPath() const { return fChoppedPath; }
+    const GrCCFillGeometry::PrimitiveTallies& primitiveCounts() const { return fPrimitiveCounts; }
+    const SkRect& devBounds() const { return fDevBounds; }
+    const SkRect& devBounds45() const { return fDevBounds45; }
+
+private:
+    const SkMatrix fMatrix;
+    SkPath fPath;
+    GrCCFillGeometry fChoppedPath;
+    GrCCFillGeometry::PrimitiveTallies fPrimitiveCounts;
+    SkRect fDevBounds;
+    SkRect fDevBounds45;
+    bool fValid = false;
+    SkSemaphore fDone;
+};
+
 /**
  * This struct encapsulates the minimum and desired requirements for the GPU resources required by
  * CCPR in a given flush.
@@ -82,6 +118,11 @@ public:
     GrCCAtlas* renderShapeInAtlas(const SkIRect& clipIBounds, const SkMatrix&, const GrShape&,
                                   float strokeDevWidth, SkRect* devBounds, SkRect* devBounds45,
                                   SkIRect* devIBounds, SkIVector* devToAtlasOffset);
+    // Same as renderShapeInAtlas(), for a fill whose device-space geometry was prepared ahead of
+    // time. The caller must have already waited on the GrCCPreparedFill.
+    GrCCAtlas* renderPreparedFillInAtlas(const SkIRect& clipIBounds, const GrCCPreparedFill&,
+                                         SkRect* devBounds, SkRect* devBounds45,
+                                         SkIRect* devIBounds, SkIVector* devToAtlasOffset);
     const GrCCAtlas* renderDeviceSpacePathInAtlas(const SkIRect& clipIBounds, const SkPath& devPath,
                                                   const SkIRect& devPathIBounds,
                                                   SkIVector* devToAtlasOffset);
@@ -8,6 +8,7 @@
 #ifndef GrAtlasedShaderHelpers_DEFINED
 #define GrAtlasedShaderHelpers_DEFINED
 
+#include "GrDrawOpAtlas.h"
 #include "GrShaderCaps.h"
 #include "glsl/GrGLSLPrimitiveProcessor.h"
 #include "glsl/GrGLSLFragmentShaderBuilder.h"
@@ -23,19 +24,27 @@ static void append_index_uv_varyings(GrGLSLPrimitiveProcessor::EmitArgs& args,
     using Interpolation = GrGLSLVaryingHandler::Interpolation;
 
     // This extracts the texture index and texel coordinates from the same variable
-    // Packing structure: texel coordinates are multiplied by 2 (or shifted left 1)
-    //                    texture index is stored as lower bits of both x and y
+    // Packing structure: texel coordinates are shifted left by GrDrawOpAtlas::kPageIndexBits,
+    //                    texture index is stored as lower bits of both x and y (see
+    //                    GrDrawOpAtlas::PackU and PackV)
+    static constexpr int kScale = 1 << GrDrawOpAtlas::kPageIndexBits;
     if (args.fShaderCaps->integerSupport()) {
         args.fVertBuilder->codeAppendf("int2 signedCoords = int2(%s.x, %s.y);",
                                        inTexCoordsName, inTexCoordsName);
-        args.fVertBuilder->codeAppend("int texIdx = 2*(signedCoords.x & 0x1) + (signedCoords.y & 0x1);");
-        args.fVertBuilder->codeAppend("float2 unormTexCoords = float2(signedCoords.x/2, signedCoords.y/2);");
+        args.fVertBuilder->codeAppendf(
+                "int texIdx = %d*(signedCoords.x & %d) + (signedCoords.y & %d);",
+                kScale, kScale - 1, kScale - 1);
+        args.fVertBuilder->codeAppendf(
+                "float2 unormTexCoords = float2(signedCoords.x/%d, signedCoords.y/%d);",
+                kScale, kScale);
     } else {
         args.fVertBuilder->codeAppendf("float2 indexTexCoords = float2(%s.x, %s.y);",
                                        inTexCoordsName, inTexCoordsName);
-        args.fVertBuilder->codeAppend("float2 unormTexCoords = floor(0.5*indexTexCoords);");
-        args.fVertBuilder->codeAppend("float2 diff = indexTexCoords - 2.0*unormTexCoords;");
-        args.fVertBuilder->codeAppend("float texIdx = 2.0*diff.x + diff.y;");
+        args.fVertBuilder->codeAppendf("float2 unormTexCoords = floor(%f*indexTexCoords);",
+                                       1.f / kScale);
+        args.fVertBuilder->codeAppendf("float2 diff = indexTexCoords - %d.0*unormTexCoords;",
+                                       kScale);
+        args.fVertBuilder->codeAppendf("float texIdx = %d.0*diff.x + diff.y;", kScale);
     }
 
     // Multiply by 1/atlasSize to get normalized texture coordinates
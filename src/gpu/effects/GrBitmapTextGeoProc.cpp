@@ -38,11 +38,27 @@ public:
                                                           "AtlasSizeInv",
                                                           &atlasSizeInvName);
 
+        GrShaderVar position = btgp.inPosition().asShaderVar();
+        const char* texCoordsName = btgp.inTextureCoords().name();
+        if (btgp.isInstanced()) {
+            // Pick this vertex's corner of the glyph's device and atlas rects.
+            const char* corner = btgp.inCorner().name();
+            vertBuilder->codeAppendf("float2 position = mix(%s.xy, %s.zw, %s);",
+                                     btgp.inPosition().name(), btgp.inPosition().name(), corner);
+            vertBuilder->codeAppendf("%s texCoords = %s(%s.x < 0.5 ? %s.x : %s.x, "
+                                                       "%s.y < 0.5 ? %s.y : %s.y);",
+                                     GrGLSLTypeString(btgp.inTextureCoords().gpuType()),
+                                     GrGLSLTypeString(btgp.inTextureCoords().gpuType()),
+                                     corner, texCoordsName, btgp.inTextureCoordsRB().name(),
+                                     corner, texCoordsName, btgp.inTextureCoordsRB().name());
+            position = GrShaderVar("position", kFloat2_GrSLType);
+            texCoordsName = "texCoords";
+        }
+
         GrGLSLVarying uv(kFloat2_GrSLType);
         GrSLType texIdxType = args.fShaderCaps->integerSupport() ? kInt_GrSLType : kFloat_GrSLType;
         GrGLSLVarying texIdx(texIdxType);
-        append_index_uv_varyings(args, btgp.inTextureCoords().name(), atlasSizeInvName, &uv,
-                                 &texIdx, nullptr);
+        append_index_uv_varyings(args, texCoordsName, atlasSizeInvName, &uv, &texIdx, nullptr);
 
         GrGLSLFPFragmentBuilder* fragBuilder = args.fFragBuilder;
         // Setup pass through color
@@ -54,13 +70,13 @@ public:
         }
 
         // Setup position
-        gpArgs->fPositionVar = btgp.inPosition().asShaderVar();
+        gpArgs->fPositionVar = position;
 
         // emit transforms
         this->emitTransforms(vertBuilder,
                              varyingHandler,
                              uniformHandler,
-                             btgp.inPosition().asShaderVar(),
+                             position,
                              btgp.localMatrix(),
                              args.fFPCoordTransformHandler);
 
@@ -102,6 +118,7 @@ public:
         uint32_t key = 0;
         key |= btgp.usesW() ? 0x1 : 0x0;
         key |= btgp.maskFormat() << 1;
+        key |= btgp.isInstanced() ? 0x8 : 0x0;
         b->add32(key);
         b->add32(btgp.numTextureSamplers());
     }
@@ -124,15 +141,18 @@ GrBitmapTextGeoProc::GrBitmapTextGeoProc(const GrShaderCaps& caps,
                                          const sk_sp<GrTextureProxy>* proxies,
                                          int numActiveProxies,
                                          const GrSamplerState& params, GrMaskFormat format,
-                                         const SkMatrix& localMatrix, bool usesW)
+                                         const SkMatrix& localMatrix, bool usesW, bool instanced)
         : INHERITED(kGrBitmapTextGeoProc_ClassID)
         , fColor(color)
         , fLocalMatrix(localMatrix)
         , fUsesW(usesW)
         , fMaskFormat(format) {
     SkASSERT(numActiveProxies <= kMaxTextures);
+    SkASSERT(!(usesW && instanced));
 
-    if (usesW) {
+    if (instanced) {
+        fInPosition = {"inRect", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+    } else if (usesW) {
         fInPosition = {"inPosition", kFloat3_GrVertexAttribType, kFloat3_GrSLType};
     } else {
         fInPosition = {"inPosition", kFloat2_GrVertexAttribType, kFloat2_GrSLType};
@@ -146,7 +166,15 @@ GrBitmapTextGeoProc::GrBitmapTextGeoProc(const GrShaderCaps& caps,
 
     fInTextureCoords = {"inTextureCoords", kUShort2_GrVertexAttribType,
                         caps.integerSupport() ? kUShort2_GrSLType : kFloat2_GrSLType};
-    this->setVertexAttributes(&fInPosition, 3);
+    if (instanced) {
+        fInTextureCoordsRB = {"inTextureCoordsRB", kUShort2_GrVertexAttribType,
+                              caps.integerSupport() ? kUShort2_GrSLType : kFloat2_GrSLType};
+        fInCorner = {"inCorner", kFloat2_GrVertexAttribType, kFloat2_GrSLType};
+        this->setVertexAttributes(&fInCorner, 1);
+        this->setInstanceAttributes(&fInPosition, 4);
+    } else {
+        this->setVertexAttributes(&fInPosition, 3);
+    }
 
     if (numActiveProxies) {
         fAtlasSize = proxies[0]->isize();
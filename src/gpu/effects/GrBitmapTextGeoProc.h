@@ -21,7 +21,7 @@ class GrInvariantOutput;
  */
 class GrBitmapTextGeoProc : public GrGeometryProcessor {
 public:
-    static constexpr int kMaxTextures = 4;
+    static constexpr int kMaxTextures = 16;
 
     static sk_sp<GrGeometryProcessor> Make(const GrShaderCaps& caps,
                                            const SkPMColor4f& color, bool wideColor,
@@ -31,7 +31,23 @@ public:
                                            const SkMatrix& localMatrix, bool usesW) {
         return sk_sp<GrGeometryProcessor>(
             new GrBitmapTextGeoProc(caps, color, wideColor, proxies, numActiveProxies, p, format,
-                                    localMatrix, usesW));
+                                    localMatrix, usesW, false));
+    }
+
+    /**
+     * Makes a processor that draws one instance per glyph: each instance holds the glyph's device
+     * space rect, its color (for A8 and LCD masks) and its packed atlas rect, and is expanded by a
+     * static strip of four corners. See GrAtlasTextOp.
+     */
+    static sk_sp<GrGeometryProcessor> MakeInstanced(const GrShaderCaps& caps,
+                                                    const SkPMColor4f& color,
+                                                    const sk_sp<GrTextureProxy>* proxies,
+                                                    int numActiveProxies,
+                                                    const GrSamplerState& p, GrMaskFormat format,
+                                                    const SkMatrix& localMatrix) {
+        return sk_sp<GrGeometryProcessor>(
+            new GrBitmapTextGeoProc(caps, color, false, proxies, numActiveProxies, p, format,
+                                    localMatrix, false, true));
     }
 
     ~GrBitmapTextGeoProc() override {}
@@ -41,6 +57,11 @@ public:
     const Attribute& inPosition() const { return fInPosition; }
     const Attribute& inColor() const { return fInColor; }
     const Attribute& inTextureCoords() const { return fInTextureCoords; }
+    // For instanced processors inPosition is the glyph's device rect, inTextureCoords and
+    // inTextureCoordsRB are the corners of its atlas rect, and inCorner selects the vertex.
+    const Attribute& inTextureCoordsRB() const { return fInTextureCoordsRB; }
+    const Attribute& inCorner() const { return fInCorner; }
+    bool isInstanced() const { return fInCorner.isInitialized(); }
     GrMaskFormat maskFormat() const { return fMaskFormat; }
     const SkPMColor4f& color() const { return fColor; }
     bool hasVertexColor() const { return fInColor.isInitialized(); }
@@ -58,7 +79,7 @@ private:
     GrBitmapTextGeoProc(const GrShaderCaps&, const SkPMColor4f&, bool wideColor,
                         const sk_sp<GrTextureProxy>* proxies, int numProxies,
                         const GrSamplerState& params, GrMaskFormat format,
-                        const SkMatrix& localMatrix, bool usesW);
+                        const SkMatrix& localMatrix, bool usesW, bool instanced);
 
     const TextureSampler& onTextureSampler(int i) const override { return fTextureSamplers[i]; }
 
@@ -70,6 +91,8 @@ private:
     Attribute        fInPosition;
     Attribute        fInColor;
     Attribute        fInTextureCoords;
+    Attribute        fInTextureCoordsRB;
+    Attribute        fInCorner;
     GrMaskFormat     fMaskFormat;
 
     GR_DECLARE_GEOMETRY_PROCESSOR_TEST
@@ -22,6 +22,14 @@
 // Assuming a radius of a little less than the diagonal of the fragment
 #define SK_DistanceFieldAAFactor     "0.65"
 
+// The distance stored at the texel sampled into texColor. For a multi-channel field that's the
+// median of the red, green and blue channels.
+static const char* sampled_distance(uint32_t flags) {
+    return (flags & kMultiChannel_DistanceFieldEffectFlag)
+            ? "max(min(texColor.r, texColor.g), min(max(texColor.r, texColor.g), texColor.b))"
+            : "texColor.r";
+}
+
 class GrGLDistanceFieldA8TextGeoProc : public GrGLSLGeometryProcessor {
 public:
     GrGLDistanceFieldA8TextGeoProc() = default;
@@ -87,8 +95,9 @@ public:
         append_multitexture_lookup(args, dfTexEffect.numTextureSamplers(),
                                    texIdx, "uv", "texColor");
 
-        fragBuilder->codeAppend("half distance = "
-                      SK_DistanceFieldMultiplier "*(texColor.r - " SK_DistanceFieldThreshold ");");
+        fragBuilder->codeAppendf("half distance = "
+                      SK_DistanceFieldMultiplier "*(%s - " SK_DistanceFieldThreshold ");",
+                      sampled_distance(dfTexEffect.getFlags()));
 #ifdef SK_GAMMA_APPLY_TO_A8
         // adjust width based on gamma
         fragBuilder->codeAppendf("distance -= %s;", distanceAdjustUniName);
@@ -301,6 +310,7 @@ sk_sp<GrGeometryProcessor> GrDistanceFieldA8TextGeoProc::TestCreate(GrProcessorT
     if (flags & kSimilarity_DistanceFieldEffectFlag) {
         flags |= d->fRandom->nextBool() ? kScaleOnly_DistanceFieldEffectFlag : 0;
     }
+    flags |= d->fRandom->nextBool() ? kMultiChannel_DistanceFieldEffectFlag : 0;
     SkMatrix localMatrix = GrTest::TestMatrix(d->fRandom);
 #ifdef SK_GAMMA_APPLY_TO_A8
     float lum = d->fRandom->nextF();
@@ -712,17 +722,17 @@ public:
 
         // green is distance to uv center
         fragBuilder->codeAppend("half3 distance;");
-        fragBuilder->codeAppend("distance.y = texColor.r;");
+        fragBuilder->codeAppendf("distance.y = %s;", sampled_distance(dfTexEffect.getFlags()));
         // red is distance to left offset
         fragBuilder->codeAppend("half2 uv_adjusted = half2(uv) - offset;");
         append_multitexture_lookup(args, dfTexEffect.numTextureSamplers(),
                                    texIdx, "uv_adjusted", "texColor");
-        fragBuilder->codeAppend("distance.x = texColor.r;");
+        fragBuilder->codeAppendf("distance.x = %s;", sampled_distance(dfTexEffect.getFlags()));
         // blue is distance to right offset
         fragBuilder->codeAppend("uv_adjusted = half2(uv) + offset;");
         append_multitexture_lookup(args, dfTexEffect.numTextureSamplers(),
                                    texIdx, "uv_adjusted", "texColor");
-        fragBuilder->codeAppend("distance.z = texColor.r;");
+        fragBuilder->codeAppendf("distance.z = %s;", sampled_distance(dfTexEffect.getFlags()));
 
         fragBuilder->codeAppend("distance = "
            "half3(" SK_DistanceFieldMultiplier ")*(distance - half3(" SK_DistanceFieldThreshold"));");
@@ -918,6 +928,7 @@ sk_sp<GrGeometryProcessor> GrDistanceFieldLCDTextGeoProc::TestCreate(GrProcessor
         flags |= d->fRandom->nextBool() ? kScaleOnly_DistanceFieldEffectFlag : 0;
     }
     flags |= d->fRandom->nextBool() ? kBGR_DistanceFieldEffectFlag : 0;
+    flags |= d->fRandom->nextBool() ? kMultiChannel_DistanceFieldEffectFlag : 0;
     SkMatrix localMatrix = GrTest::TestMatrix(d->fRandom);
     return GrDistanceFieldLCDTextGeoProc::Make(*d->caps()->shaderCaps(), proxies, 1, samplerState,
                                                wa, flags, localMatrix);
@@ -29,6 +29,7 @@ protected:
 
 private:
     UniformHandle fKernelUni;
+    UniformHandle fOffsetsUni;
     UniformHandle fImageIncrementUni;
     UniformHandle fBoundsUni;
 
@@ -47,13 +48,17 @@ void GrGLConvolutionEffect::emitCode(EmitArgs& args) {
                                                 "Bounds");
     }
 
-    int width = ce.width();
+    int sampleCount = ce.sampleCount();
 
-    int arrayCount = (width + 3) / 4;
-    SkASSERT(4 * arrayCount >= width);
+    int arrayCount = (sampleCount + 3) / 4;
+    SkASSERT(4 * arrayCount >= sampleCount);
 
     fKernelUni = uniformHandler->addUniformArray(kFragment_GrShaderFlag, kHalf4_GrSLType,
                                                  "Kernel", arrayCount);
+    if (ce.useLinearSampling()) {
+        fOffsetsUni = uniformHandler->addUniformArray(kFragment_GrShaderFlag, kFloat4_GrSLType,
+                                                      "Offsets", arrayCount);
+    }
 
     GrGLSLFPFragmentBuilder* fragBuilder = args.fFragBuilder;
     SkString coords2D = fragBuilder->ensureCoords2D(args.fTransformedCoords[0]);
@@ -62,12 +67,37 @@ void GrGLConvolutionEffect::emitCode(EmitArgs& args) {
 
     const GrShaderVar& kernel = uniformHandler->getUniformVariable(fKernelUni);
     const char* imgInc = uniformHandler->getUniformCStr(fImageIncrementUni);
+    const char* kVecSuffix[4] = {".x", ".y", ".z", ".w"};
+
+    if (ce.useLinearSampling()) {
+        // No domain to apply, so each sample is just read at its offset from the center texel.
+        const GrShaderVar& offsets = uniformHandler->getUniformVariable(fOffsetsUni);
+        for (int i = 0; i < sampleCount; i++) {
+            SkString index;
+            SkString kernelIndex;
+            SkString offsetIndex;
+            index.appendS32(i / 4);
+            kernel.appendArrayAccess(index.c_str(), &kernelIndex);
+            kernelIndex.append(kVecSuffix[i & 0x3]);
+            offsets.appendArrayAccess(index.c_str(), &offsetIndex);
+            offsetIndex.append(kVecSuffix[i & 0x3]);
+
+            SkString coord;
+            coord.printf("%s + %s * %s", coords2D.c_str(), offsetIndex.c_str(), imgInc);
+            fragBuilder->codeAppendf("%s += ", args.fOutputColor);
+            fragBuilder->appendTextureLookup(args.fTexSamplers[0], coord.c_str());
+            fragBuilder->codeAppendf(" * %s;\n", kernelIndex.c_str());
+        }
+        fragBuilder->codeAppendf("%s *= %s;\n", args.fOutputColor, args.fInputColor);
+        return;
+    }
+
+    int width = ce.width();
 
     fragBuilder->codeAppendf("float2 coord = %s - %d.0 * %s;", coords2D.c_str(), ce.radius(), imgInc);
     fragBuilder->codeAppend("float2 coordSampled = half2(0, 0);");
 
     // Manually unroll loop because some drivers don't; yields 20-30% speedup.
-    const char* kVecSuffix[4] = {".x", ".y", ".z", ".w"};
     for (int i = 0; i < width; i++) {
         SkString index;
         SkString kernelIndex;
@@ -163,11 +193,14 @@ void GrGLConvolutionEffect::onSetData(const GrGLSLProgramDataManager& pdman,
         SkASSERT(bounds[0] <= bounds[1]);
         pdman.set2f(fBoundsUni, bounds[0], bounds[1]);
     }
-    int width = conv.width();
+    int sampleCount = conv.sampleCount();
 
-    int arrayCount = (width + 3) / 4;
-    SkASSERT(4 * arrayCount >= width);
+    int arrayCount = (sampleCount + 3) / 4;
+    SkASSERT(4 * arrayCount >= sampleCount);
     pdman.set4fv(fKernelUni, arrayCount, conv.kernel());
+    if (conv.useLinearSampling()) {
+        pdman.set4fv(fOffsetsUni, arrayCount, conv.offsets());
+    }
 }
 
 void GrGLConvolutionEffect::GenKey(const GrProcessor& processor, const GrShaderCaps&,
@@ -175,7 +208,8 @@ void GrGLConvolutionEffect::GenKey(const GrProcessor& processor, const GrShaderC
     const GrGaussianConvolutionFragmentProcessor& conv =
             processor.cast<GrGaussianConvolutionFragmentProcessor>();
     uint32_t key = conv.radius();
-    key <<= 3;
+    key <<= 4;
+    key |= conv.useLinearSampling() ? 0x8 : 0x0;
     key |= Direction::kY == conv.direction() ? 0x4 : 0x0;
     key |= static_cast<uint32_t>(conv.mode());
     b->add32(key);
@@ -208,6 +242,28 @@ static void fill_in_1D_gaussian_kernel(float* kernel, int width, float gaussianS
     }
 }
 
+// Folds each adjacent pair of taps of the kernel into one bilinear sample. Sampling at
+// i + w1 / (w0 + w1), between the centers of texels i and i + 1, and weighting the result by
+// w0 + w1 gives w0 * t[i] + w1 * t[i + 1]. The width is odd, so the last tap is sampled alone.
+static void fold_kernel_for_linear_sampling(float* kernel, float* offsets, int radius) {
+    int width = 2 * radius + 1;
+    int sample = 0;
+    for (int i = 0; i < width; i += 2, ++sample) {
+        float w0 = kernel[i];
+        float w1 = i + 1 < width ? kernel[i + 1] : 0.0f;
+        float sum = w0 + w1;
+        offsets[sample] = static_cast<float>(i - radius);
+        if (sum > 0.0f) {
+            offsets[sample] += w1 / sum;
+        }
+        kernel[sample] = sum;
+    }
+    SkASSERT(sample == radius + 1);
+    for (int i = sample; i < width; ++i) {
+        kernel[i] = offsets[i] = 0.0f;
+    }
+}
+
 GrGaussianConvolutionFragmentProcessor::GrGaussianConvolutionFragmentProcessor(
                                                             sk_sp<GrTextureProxy> proxy,
                                                             Direction direction,
@@ -219,7 +275,9 @@ GrGaussianConvolutionFragmentProcessor::GrGaussianConvolutionFragmentProcessor(
                     ModulateForSamplerOptFlags(proxy->config(),
                                                mode == GrTextureDomain::kDecal_Mode))
         , fCoordTransform(proxy.get())
-        , fTextureSampler(std::move(proxy))
+        , fTextureSampler(std::move(proxy),
+                          GrTextureDomain::kIgnore_Mode == mode ? GrSamplerState::Filter::kBilerp
+                                                                : GrSamplerState::Filter::kNearest)
         , fRadius(radius)
         , fDirection(direction)
         , fMode(mode) {
@@ -232,6 +290,15 @@ GrGaussianConvolutionFragmentProcessor::GrGaussianConvolutionFragmentProcessor(
 
     fill_in_1D_gaussian_kernel(fKernel, this->width(), gaussianSigma, this->radius());
 
+    // The sampler falls back to nearest filtering for textures that can't be bilerped.
+    fUseLinearSampling =
+            GrSamplerState::Filter::kNearest != fTextureSampler.samplerState().filter();
+    if (fUseLinearSampling) {
+        fold_kernel_for_linear_sampling(fKernel, fOffsets, this->radius());
+    } else {
+        memset(fOffsets, 0, sizeof(fOffsets));
+    }
+
     memcpy(fBounds, bounds, sizeof(fBounds));
 }
 
@@ -242,10 +309,12 @@ GrGaussianConvolutionFragmentProcessor::GrGaussianConvolutionFragmentProcessor(
         , fTextureSampler(that.fTextureSampler)
         , fRadius(that.fRadius)
         , fDirection(that.fDirection)
-        , fMode(that.fMode) {
+        , fMode(that.fMode)
+        , fUseLinearSampling(that.fUseLinearSampling) {
     this->addCoordTransform(&fCoordTransform);
     this->setTextureSamplerCnt(1);
-    memcpy(fKernel, that.fKernel, that.width() * sizeof(float));
+    memcpy(fKernel, that.fKernel, sizeof(fKernel));
+    memcpy(fOffsets, that.fOffsets, sizeof(fOffsets));
     memcpy(fBounds, that.fBounds, sizeof(fBounds));
 }
 
@@ -262,9 +331,10 @@ bool GrGaussianConvolutionFragmentProcessor::onIsEqual(const GrFragmentProcessor
     const GrGaussianConvolutionFragmentProcessor& s =
             sBase.cast<GrGaussianConvolutionFragmentProcessor>();
     return (this->radius() == s.radius() && this->direction() == s.direction() &&
-            this->mode() == s.mode() &&
+            this->mode() == s.mode() && fUseLinearSampling == s.fUseLinearSampling &&
             0 == memcmp(fBounds, s.fBounds, sizeof(fBounds)) &&
-            0 == memcmp(fKernel, s.fKernel, this->width() * sizeof(float)));
+            0 == memcmp(fKernel, s.fKernel, this->sampleCount() * sizeof(float)) &&
+            0 == memcmp(fOffsets, s.fOffsets, this->sampleCount() * sizeof(float)));
 }
 
 ///////////////////////////////////////////////////////////////////////////////
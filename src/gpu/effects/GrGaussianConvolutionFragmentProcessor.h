@@ -16,6 +16,10 @@
  * A 1D Gaussian convolution effect. The kernel is computed as an array of 2 * half-width weights.
  * Each texel is multiplied by it's weight and summed to determine the filtered color. The output
  * color is set to a modulation of the filtered and input colors.
+ *
+ * When the texture domain is ignored and the texture can be bilerped, adjacent pairs of texels are
+ * read with a single bilinear sample placed between them in proportion to their weights, which
+ * takes radius + 1 samples instead of 2 * radius + 1.
  */
 class GrGaussianConvolutionFragmentProcessor : public GrFragmentProcessor {
 public:
@@ -33,11 +37,16 @@ public:
     }
 
     const float* kernel() const { return fKernel; }
+    // Offsets of the samples from the center texel, in texels. Only used with linear sampling.
+    const float* offsets() const { return fOffsets; }
 
     const int* bounds() const { return fBounds; }
     bool useBounds() const { return fMode != GrTextureDomain::kIgnore_Mode; }
     int radius() const { return fRadius; }
     int width() const { return 2 * fRadius + 1; }
+    bool useLinearSampling() const { return fUseLinearSampling; }
+    // The number of texture samples taken, and so the number of entries in kernel() and offsets().
+    int sampleCount() const { return fUseLinearSampling ? fRadius + 1 : this->width(); }
     Direction direction() const { return fDirection; }
 
     GrTextureDomain::Mode mode() const { return fMode; }
@@ -47,10 +56,11 @@ public:
 #ifdef SK_DEBUG
     SkString dumpInfo() const override {
         SkString str;
-        str.appendf("dir: %s radius: %d bounds: [%d %d]",
+        str.appendf("dir: %s radius: %d bounds: [%d %d] linear: %s",
                     Direction::kX == fDirection ? "X" : "Y",
                     fRadius,
-                    fBounds[0], fBounds[1]);
+                    fBounds[0], fBounds[1],
+                    fUseLinearSampling ? "yes" : "no");
         return str;
     }
 #endif
@@ -92,10 +102,12 @@ private:
     // TODO: Inline the kernel constants into the generated shader code. This may involve pulling
     // some of the logic from SkGpuBlurUtils into this class related to radius/sigma calculations.
     float                 fKernel[kMaxKernelWidth];
+    float                 fOffsets[kMaxKernelWidth];
     int                   fBounds[2];
     int                   fRadius;
     Direction             fDirection;
     GrTextureDomain::Mode fMode;
+    bool                  fUseLinearSampling;
 
     typedef GrFragmentProcessor INHERITED;
 };
@@ -385,6 +385,10 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLInterface(void *ctx, GrGLGetProc g
         GET_EGL_PROC_SUFFIX(DestroyImage, KHR);
     }
 
+    if (glVer >= GR_GL_VER(4,4) || extensions.has("GL_ARB_buffer_storage")) {
+        GET_PROC(BufferStorage);
+    }
+
     if (glVer >= GR_GL_VER(3, 2) || extensions.has("GL_ARB_sync")) {
         GET_PROC(FenceSync);
         GET_PROC(IsSync);
@@ -820,6 +824,10 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLESInterface(void *ctx, GrGLGetProc
         GET_EGL_PROC_SUFFIX(DestroyImage, KHR);
     }
 
+    if (extensions.has("GL_EXT_buffer_storage")) {
+        GET_PROC_SUFFIX(BufferStorage, EXT);
+    }
+
     if (version >= GR_GL_VER(3, 0)) {
         GET_PROC(FenceSync);
         GET_PROC(IsSync);
@@ -852,6 +860,18 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLESInterface(void *ctx, GrGLGetProc
         GET_PROC(SamplerParameteriv);
     }
 
+    if (extensions.has("GL_EXT_disjoint_timer_query")) {
+        GET_PROC_SUFFIX(BeginQuery, EXT);
+        GET_PROC_SUFFIX(DeleteQueries, EXT);
+        GET_PROC_SUFFIX(EndQuery, EXT);
+        GET_PROC_SUFFIX(GenQueries, EXT);
+        GET_PROC_SUFFIX(GetQueryiv, EXT);
+        GET_PROC_SUFFIX(GetQueryObjecti64v, EXT);
+        GET_PROC_SUFFIX(GetQueryObjectui64v, EXT);
+        GET_PROC_SUFFIX(GetQueryObjectuiv, EXT);
+        GET_PROC_SUFFIX(QueryCounter, EXT);
+    }
+
     interface->fStandard = kGLES_GrGLStandard;
     interface->fExtensions.swap(&extensions);
 
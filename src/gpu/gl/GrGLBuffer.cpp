@@ -36,6 +36,10 @@ sk_sp<GrGLBuffer> GrGLBuffer::Make(GrGLGpu* gpu, size_t size, GrGpuBufferType in
          GrGpuBufferType::kXferGpuToCpu == intendedType)) {
         return nullptr;
     }
+    if (kPersistentlyMapped_GrAccessPattern == accessPattern &&
+        !gpu->glCaps().persistentlyMappedBufferSupport()) {
+        return nullptr;
+    }
 
     sk_sp<GrGLBuffer> buffer(new GrGLBuffer(gpu, size, intendedType, accessPattern, data));
     if (0 == buffer->bufferID()) {
@@ -59,6 +63,9 @@ inline static GrGLenum gr_to_gl_access_pattern(GrGpuBufferType bufferType,
                 return GR_GL_STATIC_DRAW;
             case kStream_GrAccessPattern:
                 return GR_GL_STREAM_DRAW;
+            case kPersistentlyMapped_GrAccessPattern:
+                // Immutable storage has no usage hint.
+                return DYNAMIC_DRAW_PARAM;
         }
         SK_ABORT("Unexpected access pattern");
         return GR_GL_STATIC_DRAW;
@@ -72,6 +79,8 @@ inline static GrGLenum gr_to_gl_access_pattern(GrGpuBufferType bufferType,
                 return GR_GL_STATIC_READ;
             case kStream_GrAccessPattern:
                 return GR_GL_STREAM_READ;
+            case kPersistentlyMapped_GrAccessPattern:
+                return GR_GL_DYNAMIC_READ;
         }
         SK_ABORT("Unexpected access pattern");
         return GR_GL_STATIC_READ;
@@ -82,6 +91,7 @@ inline static GrGLenum gr_to_gl_access_pattern(GrGpuBufferType bufferType,
             case GrGpuBufferType::kVertex:
             case GrGpuBufferType::kIndex:
             case GrGpuBufferType::kXferCpuToGpu:
+            case GrGpuBufferType::kDrawIndirect:
                 return drawUsage(pattern);
             case GrGpuBufferType::kXferGpuToCpu:
                 return readUsage(pattern);
@@ -100,9 +110,28 @@ GrGLBuffer::GrGLBuffer(GrGLGpu* gpu, size_t size, GrGpuBufferType intendedType,
         , fBufferID(0)
         , fUsage(gr_to_gl_access_pattern(intendedType, accessPattern))
         , fGLSizeInBytes(0)
-        , fHasAttachedToTexture(false) {
+        , fHasAttachedToTexture(false)
+        , fPersistentMapPtr(nullptr) {
     GL_CALL(GenBuffers(1, &fBufferID));
-    if (fBufferID) {
+    if (fBufferID && kPersistentlyMapped_GrAccessPattern == accessPattern) {
+        // The storage can never be respecified, so it's mapped once here for the buffer's whole
+        // lifetime. Coherent mapping makes our writes visible to the GPU without any flushes.
+        static constexpr GrGLbitfield kFlags =
+                GR_GL_MAP_WRITE_BIT | GR_GL_MAP_PERSISTENT_BIT | GR_GL_MAP_COHERENT_BIT;
+        GrGLenum target = gpu->bindBuffer(fIntendedType, this);
+        CLEAR_ERROR_BEFORE_ALLOC(gpu->glInterface());
+        GL_ALLOC_CALL(gpu->glInterface(), BufferStorage(target, (GrGLsizeiptr) size, data,
+                                                        kFlags));
+        if (CHECK_ALLOC_ERROR(gpu->glInterface()) == GR_GL_NO_ERROR) {
+            GL_CALL_RET(fPersistentMapPtr, MapBufferRange(target, 0, size, kFlags));
+        }
+        if (!fPersistentMapPtr) {
+            GL_CALL(DeleteBuffers(1, &fBufferID));
+            fBufferID = 0;
+        } else {
+            fGLSizeInBytes = size;
+        }
+    } else if (fBufferID) {
         GrGLenum target = gpu->bindBuffer(fIntendedType, this);
         CLEAR_ERROR_BEFORE_ALLOC(gpu->glInterface());
         // make sure driver can allocate memory for this buffer
@@ -143,6 +172,7 @@ void GrGLBuffer::onRelease() {
             fGLSizeInBytes = 0;
         }
         fMapPtr = nullptr;
+        fPersistentMapPtr = nullptr;
         VALIDATE();
     }
 
@@ -153,6 +183,7 @@ void GrGLBuffer::onAbandon() {
     fBufferID = 0;
     fGLSizeInBytes = 0;
     fMapPtr = nullptr;
+    fPersistentMapPtr = nullptr;
     VALIDATE();
     INHERITED::onAbandon();
 }
@@ -166,6 +197,11 @@ void GrGLBuffer::onMap() {
     VALIDATE();
     SkASSERT(!this->isMapped());
 
+    if (fPersistentMapPtr) {
+        fMapPtr = fPersistentMapPtr;
+        return;
+    }
+
     // TODO: Make this a function parameter.
     bool readOnly = (GrGpuBufferType::kXferGpuToCpu == fIntendedType);
 
@@ -220,7 +256,8 @@ void GrGLBuffer::onUnmap() {
 
     VALIDATE();
     SkASSERT(this->isMapped());
-    if (0 == fBufferID) {
+    if (0 == fBufferID || fPersistentMapPtr) {
+        // Persistent mappings stay valid until the buffer is deleted.
         fMapPtr = nullptr;
         return;
     }
@@ -255,6 +292,10 @@ bool GrGLBuffer::onUpdateData(const void* src, size_t srcSizeInBytes) {
         return false;
     }
     SkASSERT(srcSizeInBytes <= this->size());
+    if (fPersistentMapPtr) {
+        memcpy(fPersistentMapPtr, src, srcSizeInBytes);
+        return true;
+    }
     // bindbuffer handles dirty context
     GrGLenum target = this->glGpu()->bindBuffer(fIntendedType, this);
 
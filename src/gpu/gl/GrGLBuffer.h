@@ -61,6 +61,8 @@ private:
     GrGLenum        fUsage;
     size_t          fGLSizeInBytes;
     bool            fHasAttachedToTexture;
+    // For kPersistentlyMapped_GrAccessPattern, the mapping made when the buffer was created.
+    void*           fPersistentMapPtr;
 
     typedef GrGpuBuffer INHERITED;
 };
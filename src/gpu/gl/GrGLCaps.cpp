@@ -572,6 +572,20 @@ void GrGLCaps::init(const GrContextOptions& contextOptions,
     // Safely moving textures between contexts requires fences.
     fCrossContextTextureSupport = fFenceSyncSupport;
 
+    // Not every client's bindings include the query functions, so check for them too.
+    if (kGL_GrGLStandard == standard) {
+        fTimestampQuerySupport = version >= GR_GL_VER(3, 3) ||
+                                 ctxInfo.hasExtension("GL_ARB_timer_query");
+    } else {
+        fTimestampQuerySupport = ctxInfo.hasExtension("GL_EXT_disjoint_timer_query");
+    }
+    fTimestampQuerySupport = fTimestampQuerySupport &&
+                             gli->fFunctions.fGenQueries &&
+                             gli->fFunctions.fDeleteQueries &&
+                             gli->fFunctions.fGetQueryObjectuiv &&
+                             gli->fFunctions.fGetQueryObjectui64v &&
+                             gli->fFunctions.fQueryCounter;
+
     // Half float vertex attributes requires GL3 or ES3
     // It can also work with OES_VERTEX_HALF_FLOAT, but that requires a different enum.
     if (kGL_GrGLStandard == standard) {
@@ -610,6 +624,13 @@ void GrGLCaps::init(const GrContextOptions& contextOptions,
         this->applyDriverCorrectnessWorkarounds(ctxInfo, contextOptions, shaderCaps);
     }
 
+    // Persistent mappings come from glMapBufferRange on immutable buffer storage, and writes to
+    // them are synchronized with fences. This is checked after the workarounds since those can
+    // disable buffer mapping altogether.
+    fPersistentlyMappedBufferSupport = gli->fFunctions.fBufferStorage &&
+                                       kMapBufferRange_MapBufferType == fMapBufferType &&
+                                       fFenceSyncSupport && !fPreferClientSideDynamicBuffers;
+
     this->applyOptionsOverrides(contextOptions);
     shaderCaps->applyOptionsOverrides(contextOptions);
 
@@ -1961,6 +1982,20 @@ void GrGLCaps::initConfigTable(const GrContextOptions& contextOptions,
     }
     fConfigTable[kRGB_ETC1_GrPixelConfig].fSwizzle = GrSwizzle::RGBA();
 
+    fConfigTable[kRGB_BC1_GrPixelConfig].fFormats.fBaseInternalFormat =
+        GR_GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    fConfigTable[kRGB_BC1_GrPixelConfig].fFormats.fSizedInternalFormat =
+        GR_GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    fConfigTable[kRGB_BC1_GrPixelConfig].fFormats.fExternalFormat[kReadPixels_ExternalFormatUsage]
+        = 0;
+    fConfigTable[kRGB_BC1_GrPixelConfig].fFormats.fExternalType = 0;
+    fConfigTable[kRGB_BC1_GrPixelConfig].fFormatType = kNormalizedFixedPoint_FormatType;
+    if (ctxInfo.hasExtension("GL_EXT_texture_compression_s3tc") ||
+        ctxInfo.hasExtension("GL_EXT_texture_compression_dxt1")) {
+        fConfigTable[kRGB_BC1_GrPixelConfig].fFlags = ConfigInfo::kTextureable_Flag;
+    }
+    fConfigTable[kRGB_BC1_GrPixelConfig].fSwizzle = GrSwizzle::RGBA();
+
     // Bulk populate the texture internal/external formats here and then deal with exceptions below.
 
     // ES 2.0 requires that the internal/external formats match.
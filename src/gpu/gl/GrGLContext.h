@@ -11,14 +11,12 @@
 
 #include "GrGLCaps.h"
 #include "GrGLUtil.h"
+#include "GrSkSLCompilerPool.h"
 #include "gl/GrGLExtensions.h"
 #include "gl/GrGLInterface.h"
 #include "glsl/GrGLSL.h"
 
 struct GrContextOptions;
-namespace SkSL {
-    class Compiler;
-}
 
 /**
  * Encapsulates information about an OpenGL context including the OpenGL
@@ -82,7 +80,8 @@ protected:
 };
 
 /**
- * Extension of GrGLContextInfo that also provides access to GrGLInterface and SkSL::Compiler.
+ * Extension of GrGLContextInfo that also provides access to GrGLInterface and a pool of
+ * SkSL::Compilers.
  */
 class GrGLContext : public GrGLContextInfo {
 public:
@@ -94,14 +93,16 @@ public:
 
     const GrGLInterface* interface() const { return fInterface.get(); }
 
-    SkSL::Compiler* compiler() const;
+    GrSkSLCompilerPool* compilerPool() const { return fCompilerPool.get(); }
 
     ~GrGLContext() override;
 
 private:
-    GrGLContext(ConstructorArgs&& args) : INHERITED(std::move(args)), fCompiler(nullptr) {}
+    GrGLContext(ConstructorArgs&& args)
+            : INHERITED(std::move(args))
+            , fCompilerPool(new GrSkSLCompilerPool()) {}
 
-    mutable SkSL::Compiler* fCompiler;
+    std::unique_ptr<GrSkSLCompilerPool> fCompilerPool;
 
     typedef GrGLContextInfo INHERITED;
 };
@@ -390,6 +390,7 @@ GrGLGpu::GrGLGpu(std::unique_ptr<GrGLContext> ctx, GrContext* context)
 
     this->hwBufferState(GrGpuBufferType::kVertex)->fGLTarget = GR_GL_ARRAY_BUFFER;
     this->hwBufferState(GrGpuBufferType::kIndex)->fGLTarget = GR_GL_ELEMENT_ARRAY_BUFFER;
+    this->hwBufferState(GrGpuBufferType::kDrawIndirect)->fGLTarget = GR_GL_DRAW_INDIRECT_BUFFER;
     if (GrGLCaps::kChromium_TransferBufferType == this->glCaps().transferBufferType()) {
         this->hwBufferState(GrGpuBufferType::kXferCpuToGpu)->fGLTarget =
                 GR_GL_PIXEL_UNPACK_TRANSFER_BUFFER_CHROMIUM;
@@ -402,7 +403,7 @@ GrGLGpu::GrGLGpu(std::unique_ptr<GrGLContext> ctx, GrContext* context)
     for (int i = 0; i < kGrGpuBufferTypeCount; ++i) {
         fHWBufferState[i].invalidate();
     }
-    GR_STATIC_ASSERT(4 == SK_ARRAY_COUNT(fHWBufferState));
+    GR_STATIC_ASSERT(5 == SK_ARRAY_COUNT(fHWBufferState));
 
     if (this->glCaps().shaderCaps()->pathRenderingSupport()) {
         fPathRendering.reset(new GrGLPathRendering(this));
@@ -417,8 +418,11 @@ GrGLGpu::~GrGLGpu() {
     // Ensure any GrGpuResource objects get deleted first, since they may require a working GrGLGpu
     // to release the resources held by the objects themselves.
     fPathRendering.reset();
+    // The op timer's queries must be deleted while this is still a GrGLGpu.
+    this->setOpTimingEnabled(false);
     fCopyProgramArrayBuffer.reset();
     fMipmapProgramArrayBuffer.reset();
+    fIndirectDrawBuffer.reset();
 
     fHWProgram.reset();
     if (fHWProgramID) {
@@ -507,6 +511,7 @@ void GrGLGpu::disconnect(DisconnectType type) {
     for (size_t i = 0; i < SK_ARRAY_COUNT(fMipmapPrograms); ++i) {
         fMipmapPrograms[i].fProgram = 0;
     }
+    fIndirectDrawBuffer.reset();
 
     if (this->glCaps().shaderCaps()->pathRenderingSupport()) {
         this->glPathRendering()->disconnect(type);
@@ -617,6 +622,7 @@ void GrGLGpu::onResetContext(uint32_t resetBits) {
         fHWVertexArrayState.invalidate();
         this->hwBufferState(GrGpuBufferType::kVertex)->invalidate();
         this->hwBufferState(GrGpuBufferType::kIndex)->invalidate();
+        this->hwBufferState(GrGpuBufferType::kDrawIndirect)->invalidate();
     }
 
     if (resetBits & kRenderTarget_GrGLBackendState) {
@@ -875,6 +881,7 @@ static inline GrGLint config_alignment(GrPixelConfig config) {
         case kRG_float_GrPixelConfig:
             return 4;
         case kRGB_ETC1_GrPixelConfig:
+        case kRGB_BC1_GrPixelConfig:
         case kUnknown_GrPixelConfig:
             return 0;
     }
@@ -1147,7 +1154,7 @@ static bool allocate_and_populate_compressed_texture(GrPixelConfig config,
 
             // Make sure that the width and height that we pass to OpenGL
             // is a multiple of the block size.
-            size_t dataSize = GrCompressedFormatDataSize(config, baseWidth, baseHeight);
+            size_t dataSize = GrCompressedFormatDataSize(config, currentWidth, currentHeight);
 
             GL_ALLOC_CALL(&interface,
                           CompressedTexImage2D(target,
@@ -1193,6 +1200,14 @@ void GrGLGpu::unbindCpuToGpuXferBuffer() {
     }
 }
 
+void GrGLGpu::unbindGpuToCpuXferBuffer() {
+    auto* xferBufferState = this->hwBufferState(GrGpuBufferType::kXferGpuToCpu);
+    if (!xferBufferState->fBoundBufferUniqueID.isInvalid()) {
+        GL_CALL(BindBuffer(xferBufferState->fGLTarget, 0));
+        xferBufferState->invalidate();
+    }
+}
+
 // TODO: Make this take a GrColorType instead of dataConfig. This requires updating GrGLCaps to
 // convert from GrColorType to externalFormat/externalType GLenum values.
 bool GrGLGpu::uploadTexData(GrPixelConfig texConfig, int texWidth, int texHeight, GrGLenum target,
@@ -2231,6 +2246,26 @@ void GrGLGpu::clearStencil(GrRenderTarget* target, int clearValue) {
     }
 }
 
+void GrGLGpu::discardStencil(GrRenderTarget* target) {
+    GrStencilAttachment* sb = target->renderTargetPriv().getStencilAttachment();
+    if (!sb || GrGLCaps::kNone_InvalidateFBType == this->glCaps().invalidateFBType()) {
+        return;
+    }
+
+    GrGLRenderTarget* glRT = static_cast<GrGLRenderTarget*>(target);
+    this->flushRenderTargetNoColorWrites(glRT);
+
+    // The default framebuffer names its attachments differently.
+    const GrGLenum attachment = glRT->renderFBOID() ? GR_GL_STENCIL_ATTACHMENT : GR_GL_STENCIL;
+    if (GrGLCaps::kInvalidate_InvalidateFBType == this->glCaps().invalidateFBType()) {
+        GL_CALL(InvalidateFramebuffer(GR_GL_FRAMEBUFFER, 1, &attachment));
+    } else {
+        GL_CALL(DiscardFramebuffer(GR_GL_FRAMEBUFFER, 1, &attachment));
+    }
+    // The next clear of the stencil buffer can't be skipped.
+    sb->discarded();
+}
+
 void GrGLGpu::clearStencilClip(const GrFixedClip& clip,
                                bool insideStencilMask,
                                GrRenderTarget* target, GrSurfaceOrigin origin) {
@@ -2342,8 +2377,9 @@ bool GrGLGpu::readPixelsSupported(GrSurface* surfaceForConfig, GrPixelConfig rea
     }
 }
 
-bool GrGLGpu::onReadPixels(GrSurface* surface, int left, int top, int width, int height,
-                           GrColorType dstColorType, void* buffer, size_t rowBytes) {
+bool GrGLGpu::readOrTransferPixelsFrom(GrSurface* surface, int left, int top, int width,
+                                        int height, GrColorType dstColorType, void* offsetOrPtr,
+                                        int rowWidthInPixels) {
     SkASSERT(surface);
 
     GrGLRenderTarget* renderTarget = static_cast<GrGLRenderTarget*>(surface->asRenderTarget());
@@ -2393,23 +2429,9 @@ bool GrGLGpu::onReadPixels(GrSurface* surface, int left, int top, int width, int
     GrGLIRect readRect;
     readRect.setRelativeTo(glvp, left, top, width, height, kTopLeft_GrSurfaceOrigin);
 
-    int bytesPerPixel = GrBytesPerPixel(dstAsConfig);
-    size_t tightRowBytes = bytesPerPixel * width;
-
-    size_t readDstRowBytes = tightRowBytes;
-    void* readDst = buffer;
-
-    // determine if GL can read using the passed rowBytes or if we need a scratch buffer.
-    SkAutoSMalloc<32 * sizeof(GrColor)> scratch;
-    if (rowBytes != tightRowBytes) {
-        if (this->glCaps().packRowLengthSupport() && !(rowBytes % bytesPerPixel)) {
-            GL_CALL(PixelStorei(GR_GL_PACK_ROW_LENGTH,
-                                static_cast<GrGLint>(rowBytes / bytesPerPixel)));
-            readDstRowBytes = rowBytes;
-        } else {
-            scratch.reset(tightRowBytes * height);
-            readDst = scratch.get();
-        }
+    if (rowWidthInPixels != width) {
+        SkASSERT(this->glCaps().packRowLengthSupport());
+        GL_CALL(PixelStorei(GR_GL_PACK_ROW_LENGTH, rowWidthInPixels));
     }
     GL_CALL(PixelStorei(GR_GL_PACK_ALIGNMENT, config_alignment(dstAsConfig)));
 
@@ -2426,7 +2448,7 @@ bool GrGLGpu::onReadPixels(GrSurface* surface, int left, int top, int width, int
 
     GL_CALL(ReadPixels(readRect.fLeft, readRect.fBottom,
                        readRect.fWidth, readRect.fHeight,
-                       externalFormat, externalType, readDst));
+                       externalFormat, externalType, offsetOrPtr));
 
     if (reattachStencil) {
         GrGLStencilAttachment* stencilAttachment = static_cast<GrGLStencilAttachment*>(
@@ -2435,24 +2457,65 @@ bool GrGLGpu::onReadPixels(GrSurface* surface, int left, int top, int width, int
                                         GR_GL_RENDERBUFFER, stencilAttachment->renderbufferID()));
     }
 
-    if (readDstRowBytes != tightRowBytes) {
+    if (rowWidthInPixels != width) {
         SkASSERT(this->glCaps().packRowLengthSupport());
         GL_CALL(PixelStorei(GR_GL_PACK_ROW_LENGTH, 0));
     }
 
+    if (!renderTarget) {
+        this->unbindTextureFBOForPixelOps(GR_GL_FRAMEBUFFER, surface);
+    }
+    return true;
+}
+
+bool GrGLGpu::onReadPixels(GrSurface* surface, int left, int top, int width, int height,
+                           GrColorType dstColorType, void* buffer, size_t rowBytes) {
+    SkASSERT(surface);
+
+    int bytesPerPixel = GrColorTypeBytesPerPixel(dstColorType);
+    size_t tightRowBytes = bytesPerPixel * width;
+
+    // determine if GL can read using the passed rowBytes or if we need a scratch buffer.
+    size_t readDstRowBytes = tightRowBytes;
+    void* readDst = buffer;
+    SkAutoSMalloc<32 * sizeof(GrColor)> scratch;
+    if (rowBytes != tightRowBytes) {
+        if (this->glCaps().packRowLengthSupport() && !(rowBytes % bytesPerPixel)) {
+            readDstRowBytes = rowBytes;
+        } else {
+            scratch.reset(tightRowBytes * height);
+            readDst = scratch.get();
+        }
+    }
+
+    // Reads into client memory must not go to a bound pack buffer.
+    this->unbindGpuToCpuXferBuffer();
+    if (!this->readOrTransferPixelsFrom(surface, left, top, width, height, dstColorType, readDst,
+                                        readDstRowBytes / bytesPerPixel)) {
+        return false;
+    }
+
     if (readDst != buffer) {
-        SkASSERT(readDst != buffer);
         SkASSERT(rowBytes != tightRowBytes);
         const char* src = reinterpret_cast<const char*>(readDst);
         char* dst = reinterpret_cast<char*>(buffer);
         SkRectMemcpy(dst, rowBytes, src, readDstRowBytes, tightRowBytes, height);
     }
-    if (!renderTarget) {
-        this->unbindTextureFBOForPixelOps(GR_GL_FRAMEBUFFER, surface);
-    }
     return true;
 }
 
+bool GrGLGpu::onTransferPixelsFrom(GrSurface* surface, int left, int top, int width, int height,
+                                   GrColorType dstColorType, GrGpuBuffer* transferBuffer,
+                                   size_t offset) {
+    SkASSERT(!transferBuffer->isMapped());
+    SkASSERT(!transferBuffer->isCpuBuffer());
+    const GrGLBuffer* glBuffer = static_cast<const GrGLBuffer*>(transferBuffer);
+    this->bindBuffer(GrGpuBufferType::kXferGpuToCpu, glBuffer);
+    // With a pack buffer bound, ReadPixels' pointer is an offset into the buffer.
+    return this->readOrTransferPixelsFrom(surface, left, top, width, height, dstColorType,
+                                          reinterpret_cast<void*>(offset), width);
+}
+
 GrGpuRTCommandBuffer* GrGLGpu::getCommandBuffer(
         GrRenderTarget* rt, GrSurfaceOrigin origin, const SkRect& bounds,
         const GrGpuRTCommandBuffer::LoadAndStoreInfo& colorInfo,
@@ -2551,6 +2614,90 @@ void GrGLGpu::flushViewport(const GrGLIRect& viewport) {
     #endif
 #endif
 
+class GrGLGpu::IndirectDrawBatcher : public GrMesh::SendToGpuImpl {
+public:
+    IndirectDrawBatcher(GrGLGpu* gpu) : fGpu(gpu) {}
+
+    ~IndirectDrawBatcher() override { SkASSERT(fCommands.empty()); }
+
+    void sendMeshToGpu(GrPrimitiveType primitiveType, const GrBuffer* vertexBuffer,
+                       int vertexCount, int baseVertex) override {
+        this->flush();
+        fGpu->sendMeshToGpu(primitiveType, vertexBuffer, vertexCount, baseVertex);
+    }
+
+    void sendIndexedMeshToGpu(GrPrimitiveType primitiveType, const GrBuffer* indexBuffer,
+                              int indexCount, int baseIndex, uint16_t minIndexValue,
+                              uint16_t maxIndexValue, const GrBuffer* vertexBuffer,
+                              int baseVertex, GrPrimitiveRestart primitiveRestart) override {
+        // The indirect commands can only reference indices and vertices in GL buffers.
+        if (GrPrimitiveRestart::kYes == primitiveRestart || indexBuffer->isCpuBuffer() ||
+            (vertexBuffer && vertexBuffer->isCpuBuffer())) {
+            this->flush();
+            fGpu->sendIndexedMeshToGpu(primitiveType, indexBuffer, indexCount, baseIndex,
+                                       minIndexValue, maxIndexValue, vertexBuffer, baseVertex,
+                                       primitiveRestart);
+            return;
+        }
+        if (!fCommands.empty() && (primitiveType != fPrimitiveType ||
+                                   indexBuffer != fIndexBuffer || vertexBuffer != fVertexBuffer)) {
+            this->flush();
+        }
+        if (fCommands.empty()) {
+            fPrimitiveType = primitiveType;
+            fIndexBuffer = indexBuffer;
+            fVertexBuffer = vertexBuffer;
+            fFirstMinIndexValue = minIndexValue;
+            fFirstMaxIndexValue = maxIndexValue;
+        }
+        fCommands.push_back({(GrGLuint)indexCount, 1, (GrGLuint)baseIndex, (GrGLuint)baseVertex,
+                             0});
+    }
+
+    void sendInstancedMeshToGpu(GrPrimitiveType primitiveType, const GrBuffer* vertexBuffer,
+                                int vertexCount, int baseVertex, const GrBuffer* instanceBuffer,
+                                int instanceCount, int baseInstance) override {
+        this->flush();
+        fGpu->sendInstancedMeshToGpu(primitiveType, vertexBuffer, vertexCount, baseVertex,
+                                     instanceBuffer, instanceCount, baseInstance);
+    }
+
+    void sendIndexedInstancedMeshToGpu(GrPrimitiveType primitiveType, const GrBuffer* indexBuffer,
+                                       int indexCount, int baseIndex, const GrBuffer* vertexBuffer,
+                                       int baseVertex, const GrBuffer* instanceBuffer,
+                                       int instanceCount, int baseInstance,
+                                       GrPrimitiveRestart primitiveRestart) override {
+        this->flush();
+        fGpu->sendIndexedInstancedMeshToGpu(primitiveType, indexBuffer, indexCount, baseIndex,
+                                            vertexBuffer, baseVertex, instanceBuffer,
+                                            instanceCount, baseInstance, primitiveRestart);
+    }
+
+    void flush() {
+        if (1 == fCommands.count()) {
+            const GrGLDrawElementsIndirectCommand& command = fCommands.front();
+            fGpu->sendIndexedMeshToGpu(fPrimitiveType, fIndexBuffer, command.fCount,
+                                       command.fFirstIndex, fFirstMinIndexValue,
+                                       fFirstMaxIndexValue, fVertexBuffer, command.fBaseVertex,
+                                       GrPrimitiveRestart::kNo);
+        } else if (fCommands.count() > 1) {
+            fGpu->sendIndirectIndexedMeshesToGpu(fPrimitiveType, fIndexBuffer, fVertexBuffer,
+                                                 fCommands.begin(), fCommands.count());
+        }
+        fCommands.reset();
+    }
+
+private:
+    GrGLGpu* fGpu;
+    GrPrimitiveType fPrimitiveType = GrPrimitiveType::kTriangles;
+    const GrBuffer* fIndexBuffer = nullptr;
+    const GrBuffer* fVertexBuffer = nullptr;
+    // Only needed if the batch ends up with a single draw, which is issued directly.
+    uint16_t fFirstMinIndexValue = 0;
+    uint16_t fFirstMaxIndexValue = 0;
+    SkSTArray<16, GrGLDrawElementsIndirectCommand, true> fCommands;
+};
+
 void GrGLGpu::draw(GrRenderTarget* renderTarget, GrSurfaceOrigin origin,
                    const GrPrimitiveProcessor& primProc,
                    const GrPipeline& pipeline,
@@ -2578,6 +2725,19 @@ void GrGLGpu::draw(GrRenderTarget* renderTarget, GrSurfaceOrigin origin,
         dynamicScissor = pipeline.isScissorEnabled() && dynamicStateArrays->fScissorRects;
         dynamicPrimProcTextures = dynamicStateArrays->fPrimitiveProcessorTextures;
     }
+
+    // Consecutive meshes that only differ in the ranges of their buffers they draw are merged
+    // into a single glMultiDrawElementsIndirect. This requires that nothing changes between
+    // the meshes, and instance attributes would need base instance support.
+    IndirectDrawBatcher indirectBatcher(this);
+    GrMesh::SendToGpuImpl* sendImpl = this;
+    if (meshCount > 1 && this->glCaps().multiDrawIndirectSupport() && !dynamicScissor &&
+        !dynamicPrimProcTextures && !fHWProgram->instanceStride() &&
+        !pipeline.xferBarrierType(renderTarget->asTexture(), *this->caps()) &&
+        !this->glCaps().requiresCullFaceEnableDisableWhenDrawingLinesAfterNonLines()) {
+        sendImpl = &indirectBatcher;
+    }
+
     for (int m = 0; m < meshCount; ++m) {
         if (GrXferBarrierType barrierType = pipeline.xferBarrierType(renderTarget->asTexture(),
                                                                      *this->caps())) {
@@ -2600,9 +2760,10 @@ void GrGLGpu::draw(GrRenderTarget* renderTarget, GrSurfaceOrigin origin,
             GL_CALL(Enable(GR_GL_CULL_FACE));
             GL_CALL(Disable(GR_GL_CULL_FACE));
         }
-        meshes[m].sendToGpu(this);
+        meshes[m].sendToGpu(sendImpl);
         fLastPrimitiveType = meshes[m].primitiveType();
     }
+    indirectBatcher.flush();
 
 #if SWAP_PER_DRAW
     glFlush();
@@ -2677,6 +2838,41 @@ void GrGLGpu::sendIndexedMeshToGpu(GrPrimitiveType primitiveType, const GrBuffer
     fStats.incNumDraws();
 }
 
+void GrGLGpu::sendIndirectIndexedMeshesToGpu(GrPrimitiveType primitiveType,
+                                              const GrBuffer* indexBuffer,
+                                              const GrBuffer* vertexBuffer,
+                                              const GrGLDrawElementsIndirectCommand commands[],
+                                              int commandCount) {
+    SkASSERT(this->glCaps().multiDrawIndirectSupport());
+    SkASSERT(commandCount > 0);
+    const GrGLenum glPrimType = gr_primitive_type_to_gl_mode(primitiveType);
+    size_t commandsSize = commandCount * sizeof(GrGLDrawElementsIndirectCommand);
+
+    if (!fIndirectDrawBuffer || fIndirectDrawBuffer->size() < commandsSize) {
+        size_t size = SkTMax(commandsSize,
+                             fIndirectDrawBuffer ? 2 * fIndirectDrawBuffer->size() : 0);
+        fIndirectDrawBuffer = GrGLBuffer::Make(this, size, GrGpuBufferType::kDrawIndirect,
+                                               kStream_GrAccessPattern);
+    }
+    if (!fIndirectDrawBuffer || !fIndirectDrawBuffer->updateData(commands, commandsSize)) {
+        fIndirectDrawBuffer.reset();
+        for (int i = 0; i < commandCount; ++i) {
+            this->setupGeometry(indexBuffer, vertexBuffer, commands[i].fBaseVertex, nullptr, 0,
+                                GrPrimitiveRestart::kNo);
+            GL_CALL(DrawElements(glPrimType, commands[i].fCount, GR_GL_UNSIGNED_SHORT,
+                                 element_ptr(indexBuffer, commands[i].fFirstIndex)));
+            fStats.incNumDraws();
+        }
+        return;
+    }
+
+    this->setupGeometry(indexBuffer, vertexBuffer, 0, nullptr, 0, GrPrimitiveRestart::kNo);
+    this->bindBuffer(GrGpuBufferType::kDrawIndirect, fIndirectDrawBuffer.get());
+    GL_CALL(MultiDrawElementsIndirect(glPrimType, GR_GL_UNSIGNED_SHORT, nullptr, commandCount,
+                                      sizeof(GrGLDrawElementsIndirectCommand)));
+    fStats.incNumDraws();
+}
+
 void GrGLGpu::sendInstancedMeshToGpu(GrPrimitiveType primitiveType, const GrBuffer* vertexBuffer,
                                      int vertexCount, int baseVertex,
                                      const GrBuffer* instanceBuffer, int instanceCount,
@@ -3429,7 +3625,8 @@ bool GrGLGpu::createCopyProgram(GrTexture* srcTex) {
     SkSL::Program::Settings settings;
     settings.fCaps = shaderCaps;
     SkSL::String glsl;
-    std::unique_ptr<SkSL::Program> program = GrSkSLtoGLSL(*fGLContext, GR_GL_VERTEX_SHADER,
+    GrSkSLCompilerPool::Lease compiler = fGLContext->compilerPool()->acquire();
+    std::unique_ptr<SkSL::Program> program = GrSkSLtoGLSL(compiler.get(), GR_GL_VERTEX_SHADER,
                                                           &str, &length, 1, settings, &glsl);
     GrGLuint vshader = GrGLCompileAndAttachShader(*fGLContext, fCopyPrograms[progIdx].fProgram,
                                                   GR_GL_VERTEX_SHADER, glsl.c_str(), glsl.size(),
@@ -3438,7 +3635,8 @@ bool GrGLGpu::createCopyProgram(GrTexture* srcTex) {
 
     str = fshaderTxt.c_str();
     length = SkToInt(fshaderTxt.size());
-    program = GrSkSLtoGLSL(*fGLContext, GR_GL_FRAGMENT_SHADER, &str, &length, 1, settings, &glsl);
+    program = GrSkSLtoGLSL(compiler.get(), GR_GL_FRAGMENT_SHADER, &str, &length, 1, settings,
+                           &glsl);
     GrGLuint fshader = GrGLCompileAndAttachShader(*fGLContext, fCopyPrograms[progIdx].fProgram,
                                                   GR_GL_FRAGMENT_SHADER, glsl.c_str(), glsl.size(),
                                                   &fStats, settings);
@@ -3588,7 +3786,8 @@ bool GrGLGpu::createMipmapProgram(int progIdx) {
     SkSL::Program::Settings settings;
     settings.fCaps = shaderCaps;
     SkSL::String glsl;
-    std::unique_ptr<SkSL::Program> program = GrSkSLtoGLSL(*fGLContext, GR_GL_VERTEX_SHADER,
+    GrSkSLCompilerPool::Lease compiler = fGLContext->compilerPool()->acquire();
+    std::unique_ptr<SkSL::Program> program = GrSkSLtoGLSL(compiler.get(), GR_GL_VERTEX_SHADER,
                                                           &str, &length, 1, settings, &glsl);
     GrGLuint vshader = GrGLCompileAndAttachShader(*fGLContext, fMipmapPrograms[progIdx].fProgram,
                                                   GR_GL_VERTEX_SHADER, glsl.c_str(), glsl.size(),
@@ -3597,7 +3796,8 @@ bool GrGLGpu::createMipmapProgram(int progIdx) {
 
     str = fshaderTxt.c_str();
     length = SkToInt(fshaderTxt.size());
-    program = GrSkSLtoGLSL(*fGLContext, GR_GL_FRAGMENT_SHADER, &str, &length, 1, settings, &glsl);
+    program = GrSkSLtoGLSL(compiler.get(), GR_GL_FRAGMENT_SHADER, &str, &length, 1, settings,
+                           &glsl);
     GrGLuint fshader = GrGLCompileAndAttachShader(*fGLContext, fMipmapPrograms[progIdx].fProgram,
                                                   GR_GL_FRAGMENT_SHADER, glsl.c_str(), glsl.size(),
                                                   &fStats, settings);
@@ -4311,6 +4511,43 @@ void GrGLGpu::deleteFence(GrFence fence) const {
     this->deleteSync((GrGLsync)fence);
 }
 
+GrTimestampQuery GrGLGpu::insertTimestampQuery() {
+    SkASSERT(this->caps()->timestampQuerySupport());
+    GrGLuint query = 0;
+    GL_CALL(GenQueries(1, &query));
+    if (query) {
+        GL_CALL(QueryCounter(query, GR_GL_TIMESTAMP));
+    }
+    return query;
+}
+
+bool GrGLGpu::getTimestampQueryResult(GrTimestampQuery query, uint64_t* nanoseconds) {
+    GrGLuint available = 0;
+    GL_CALL(GetQueryObjectuiv((GrGLuint)query, GR_GL_QUERY_RESULT_AVAILABLE, &available));
+    if (!available) {
+        return false;
+    }
+    GrGLuint64 result = 0;
+    GL_CALL(GetQueryObjectui64v((GrGLuint)query, GR_GL_QUERY_RESULT, &result));
+    *nanoseconds = result;
+    return true;
+}
+
+void GrGLGpu::deleteTimestampQuery(GrTimestampQuery query) {
+    GrGLuint id = (GrGLuint)query;
+    GL_CALL(DeleteQueries(1, &id));
+}
+
+bool GrGLGpu::checkTimestampQueriesDisjoint() {
+    // Only GL_EXT_disjoint_timer_query reports disjoint operations.
+    if (kGLES_GrGLStandard != this->glStandard()) {
+        return false;
+    }
+    GrGLint disjoint = 0;
+    GL_CALL(GetIntegerv(GR_GL_GPU_DISJOINT, &disjoint));
+    return SkToBool(disjoint);
+}
+
 sk_sp<GrSemaphore> SK_WARN_UNUSED_RESULT GrGLGpu::makeSemaphore(bool isOwned) {
     SkASSERT(this->caps()->fenceSyncSupport());
     return GrGLSemaphore::Make(this, isOwned);
@@ -106,6 +106,11 @@ public:
                                        const GrBuffer* instanceBuffer, int instanceCount,
                                        int baseInstance, GrPrimitiveRestart) final;
 
+    // Issues one glMultiDrawElementsIndirect for indexed sub-draws that share their buffers.
+    void sendIndirectIndexedMeshesToGpu(GrPrimitiveType, const GrBuffer* indexBuffer,
+                                        const GrBuffer* vertexBuffer,
+                                        const GrGLDrawElementsIndirectCommand[], int commandCount);
+
     // The GrGLGpuRTCommandBuffer does not buffer up draws before submitting them to the gpu.
     // Thus this is the implementation of the clear call for the corresponding passthrough function
     // on GrGLGpuRTCommandBuffer.
@@ -121,6 +126,10 @@ public:
     // stencil buffer as not dirty?
     void clearStencil(GrRenderTarget*, int clearValue);
 
+    // Tells the driver the render target's stencil contents aren't needed anymore, so a tiler
+    // doesn't have to write them back to memory.
+    void discardStencil(GrRenderTarget*);
+
     GrGpuRTCommandBuffer* getCommandBuffer(
             GrRenderTarget*, GrSurfaceOrigin, const SkRect&,
             const GrGpuRTCommandBuffer::LoadAndStoreInfo&,
@@ -151,6 +160,8 @@ public:
 
     void resetShaderCacheForTesting() const override { fProgramCache->abandon(); }
 
+    bool precompile(const SkData& key) override { return fProgramCache->precompile(key); }
+
     void testingOnly_flushGpuAndSync() override;
 #endif
 
@@ -160,6 +171,11 @@ public:
     bool waitFence(GrFence, uint64_t timeout) override;
     void deleteFence(GrFence) const override;
 
+    GrTimestampQuery insertTimestampQuery() override;
+    bool getTimestampQueryResult(GrTimestampQuery, uint64_t* nanoseconds) override;
+    void deleteTimestampQuery(GrTimestampQuery) override;
+    bool checkTimestampQueriesDisjoint() override;
+
     sk_sp<GrSemaphore> SK_WARN_UNUSED_RESULT makeSemaphore(bool isOwned) override;
     sk_sp<GrSemaphore> wrapBackendSemaphore(const GrBackendSemaphore& semaphore,
                                             GrResourceProvider::SemaphoreWrapType wrapType,
@@ -240,10 +256,23 @@ private:
     bool onTransferPixels(GrTexture*, int left, int top, int width, int height, GrColorType,
                           GrGpuBuffer* transferBuffer, size_t offset, size_t rowBytes) override;
 
+    bool onTransferPixelsFrom(GrSurface*, int left, int top, int width, int height, GrColorType,
+                              GrGpuBuffer* transferBuffer, size_t offset) override;
+
+    // Reads pixels with glReadPixels, either into client memory or, if a PIXEL_PACK_BUFFER is
+    // bound, into that buffer at the offset given as offsetOrPtr. rowWidthInPixels may only differ
+    // from width if the caps have packRowLengthSupport().
+    bool readOrTransferPixelsFrom(GrSurface*, int left, int top, int width, int height,
+                                  GrColorType, void* offsetOrPtr, int rowWidthInPixels);
+
     // Before calling any variation of TexImage, TexSubImage, etc..., call this to ensure that the
     // PIXEL_UNPACK_BUFFER is unbound.
     void unbindCpuToGpuXferBuffer();
 
+    // Before reading pixels into client memory, call this to ensure that the PIXEL_PACK_BUFFER is
+    // unbound.
+    void unbindGpuToCpuXferBuffer();
+
     void onResolveRenderTarget(GrRenderTarget* target) override;
 
     bool onRegenerateMipMapLevels(GrTexture*) override;
@@ -316,12 +345,9 @@ private:
                                 const GrPrimitiveProcessor&,
                                 const GrTextureProxy* const primProcProxies[],
                                 const GrPipeline&, bool hasPointSize);
+        bool precompile(const SkData& key);
 
     private:
-        // We may actually have kMaxEntries+1 shaders in the GL context because we create a new
-        // shader before evicting from the cache.
-        static const int kMaxEntries = 128;
-
         struct Entry;
 
         // binary search for entry matching desc. returns index into fEntries that matches desc or ~
@@ -646,6 +672,11 @@ private:
     }                                       fMipmapPrograms[4];
     sk_sp<GrGLBuffer>                       fMipmapProgramArrayBuffer;
 
+    // A GrMesh::SendToGpuImpl that merges runs of consecutive indexed meshes into
+    // sendIndirectIndexedMeshesToGpu and passes everything else on to the GrGLGpu.
+    class IndirectDrawBatcher;
+    sk_sp<GrGLBuffer>                       fIndirectDrawBuffer;
+
     static int TextureToCopyProgramIdx(GrTexture* texture);
 
     static int TextureSizeToMipmapProgramIdx(int width, int height) {
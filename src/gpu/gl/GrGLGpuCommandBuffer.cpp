@@ -24,6 +24,12 @@ void GrGLGpuRTCommandBuffer::begin() {
     }
 }
 
+void GrGLGpuRTCommandBuffer::end() {
+    if (GrStoreOp::kDiscard == fStencilLoadAndStoreInfo.fStoreOp) {
+        fGpu->discardStencil(fRenderTarget);
+    }
+}
+
 void GrGLGpuRTCommandBuffer::set(GrRenderTarget* rt, GrSurfaceOrigin origin,
                                  const GrGpuRTCommandBuffer::LoadAndStoreInfo& colorInfo,
                                  const GrGpuRTCommandBuffer::StencilLoadAndStoreInfo& stencilInfo) {
@@ -50,7 +50,7 @@ public:
     GrGLGpuRTCommandBuffer(GrGLGpu* gpu) : fGpu(gpu) {}
 
     void begin() override;
-    void end() override {}
+    void end() override;
 
     void discard() override { }
 
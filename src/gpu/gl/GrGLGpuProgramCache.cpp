@@ -8,6 +8,7 @@
 #include "GrGLGpu.h"
 
 #include "builders/GrGLProgramBuilder.h"
+#include "GrContextPriv.h"
 #include "GrProcessor.h"
 #include "GrProgramDesc.h"
 #include "GrGLPathRendering.h"
@@ -24,12 +25,18 @@ typedef GrGLSLProgramDataManager::UniformHandle UniformHandle;
 
 struct GrGLGpu::ProgramCache::Entry {
     Entry(sk_sp<GrGLProgram> program) : fProgram(std::move(program)) {}
+    Entry(std::unique_ptr<GrGLPrecompiledProgram> precompiled)
+            : fPrecompiledProgram(std::move(precompiled)) {}
 
     sk_sp<GrGLProgram> fProgram;
+    // Set by precompile() until the first draw that needs the program creates fProgram.
+    std::unique_ptr<GrGLPrecompiledProgram> fPrecompiledProgram;
 };
 
 GrGLGpu::ProgramCache::ProgramCache(GrGLGpu* gpu)
-    : fMap(kMaxEntries)
+    // We may actually have one more program in the GL context than the cache holds, because we
+    // create a new program before evicting from the cache.
+    : fMap(gpu->getContext()->priv().options().fRuntimeProgramCacheSize)
     , fGpu(gpu)
 #ifdef PROGRAM_CACHE_STATS
     , fTotalRequests(0)
@@ -63,7 +70,12 @@ void GrGLGpu::ProgramCache::abandon() {
 #endif
 
     fMap.foreach([](std::unique_ptr<Entry>* e) {
-        (*e)->fProgram->abandon();
+        if ((*e)->fProgram) {
+            (*e)->fProgram->abandon();
+        }
+        if ((*e)->fPrecompiledProgram) {
+            (*e)->fPrecompiledProgram->abandon();
+        }
     });
     fMap.reset();
 }
@@ -103,7 +115,44 @@ GrGLProgram* GrGLGpu::ProgramCache::refProgram(GrGLGpu* gpu,
             return nullptr;
         }
         entry = fMap.insert(desc, std::unique_ptr<Entry>(new Entry(sk_sp<GrGLProgram>(program))));
+    } else if (!(*entry)->fProgram) {
+        // The program was precompiled, this is the first draw that uses it.
+        std::unique_ptr<GrGLPrecompiledProgram> precompiled =
+                std::move((*entry)->fPrecompiledProgram);
+        GrGLProgram* program = GrGLProgramBuilder::CreateProgram(renderTarget, origin,
+                                                                 primProc, primProcProxies,
+                                                                 pipeline, &desc, fGpu,
+                                                                 precompiled.get());
+        if (nullptr == program) {
+            return nullptr;
+        }
+        (*entry)->fProgram.reset(program);
     }
 
     return SkRef((*entry)->fProgram.get());
 }
+
+bool GrGLGpu::ProgramCache::precompile(const SkData& key) {
+    GrProgramDesc desc;
+    if (!GrProgramDesc::BuildFromData(&desc, key.data(), key.size())) {
+        return false;
+    }
+    if (fMap.find(desc)) {
+        return true;
+    }
+    auto persistentCache = fGpu->getContext()->priv().getPersistentCache();
+    if (!persistentCache) {
+        return false;
+    }
+    sk_sp<SkData> data = persistentCache->load(key);
+    if (!data) {
+        return false;
+    }
+    std::unique_ptr<GrGLPrecompiledProgram> precompiled =
+            GrGLProgramBuilder::PrecompileProgram(fGpu, *data);
+    if (!precompiled) {
+        return false;
+    }
+    fMap.insert(desc, std::unique_ptr<Entry>(new Entry(std::move(precompiled))));
+    return true;
+}
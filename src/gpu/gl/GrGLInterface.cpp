@@ -577,6 +577,14 @@ bool GrGLInterface::validate() const {
         }
     }
 
+    if ((kGL_GrGLStandard == fStandard &&
+         (glVer >= GR_GL_VER(4,4) || fExtensions.has("GL_ARB_buffer_storage"))) ||
+        (kGLES_GrGLStandard == fStandard && fExtensions.has("GL_EXT_buffer_storage"))) {
+        if (!fFunctions.fBufferStorage) {
+            RETURN_FALSE_INTERFACE;
+        }
+    }
+
     if (kGL_GrGLStandard == fStandard) {
         if (glVer >= GR_GL_VER(3, 2) || fExtensions.has("GL_ARB_sync")) {
             if (!fFunctions.fFenceSync ||
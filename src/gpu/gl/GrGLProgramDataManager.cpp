@@ -14,12 +14,38 @@
          SkASSERT((COUNT) <= (UNI).fArrayCount || \
                   (1 == (COUNT) && GrShaderVar::kNonArray == (UNI).fArrayCount))
 
+// The number of 32-bit values that make up the whole uniform, or 0 if it isn't set through the
+// GrGLSLProgramDataManager interface.
+static int uniform_component_count(const GrShaderVar& var) {
+    int perElement;
+    switch (var.getType()) {
+        case kFloat2x2_GrSLType:
+        case kHalf2x2_GrSLType:
+            perElement = 4;
+            break;
+        case kFloat3x3_GrSLType:
+        case kHalf3x3_GrSLType:
+            perElement = 9;
+            break;
+        case kFloat4x4_GrSLType:
+        case kHalf4x4_GrSLType:
+            perElement = 16;
+            break;
+        default:
+            perElement = SkTMax(GrSLTypeVecLength(var.getType()), 0);
+            break;
+    }
+    int arrayCount = var.isArray() ? var.getArrayCount() : 1;
+    return perElement * SkTMax(arrayCount, 0);
+}
+
 GrGLProgramDataManager::GrGLProgramDataManager(GrGLGpu* gpu, GrGLuint programID,
                                                const UniformInfoArray& uniforms,
                                                const VaryingInfoArray& pathProcVaryings)
     : fGpu(gpu)
     , fProgramID(programID) {
     int count = uniforms.count();
+    int shadowCount = 0;
     fUniforms.push_back_n(count);
     for (int i = 0; i < count; i++) {
         Uniform& uniform = fUniforms[i];
@@ -31,7 +57,12 @@ GrGLProgramDataManager::GrGLProgramDataManager(GrGLGpu* gpu, GrGLuint programID,
             uniform.fType = builderUniform.fVariable.getType();
         )
         uniform.fLocation = builderUniform.fLocation;
+        uniform.fShadowOffset = shadowCount;
+        uniform.fShadowCount = uniform_component_count(builderUniform.fVariable);
+        uniform.fShadowValidCount = 0;
+        shadowCount += uniform.fShadowCount;
     }
+    fShadowValues.push_back_n(shadowCount);
 
     // NVPR programs have separable varyings
     count = pathProcVaryings.count();
@@ -61,11 +92,30 @@ void GrGLProgramDataManager::setSamplerUniforms(const UniformInfoArray& samplers
     }
 }
 
+bool GrGLProgramDataManager::needsUpload(const Uniform& uni, const void* values,
+                                         int count) const {
+    // GL keeps uniform values in the program object, so they survive across draws, opLists and
+    // other programs being used in between.
+    if (count > uni.fShadowCount) {
+        return true;
+    }
+    uint32_t* shadow = fShadowValues.begin() + uni.fShadowOffset;
+    size_t bytes = count * sizeof(uint32_t);
+    if (count <= uni.fShadowValidCount && !memcmp(shadow, values, bytes)) {
+        fGpu->stats()->incRedundantCallsSkipped();
+        return false;
+    }
+    memcpy(shadow, values, bytes);
+    uni.fShadowValidCount = SkTMax(uni.fShadowValidCount, count);
+    return true;
+}
+
 void GrGLProgramDataManager::set1i(UniformHandle u, int32_t i) const {
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kInt_GrSLType || uni.fType == kShort_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const int32_t values[] = {i};
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, values, 1)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1i(uni.fLocation, i));
     }
 }
@@ -77,7 +127,7 @@ void GrGLProgramDataManager::set1iv(UniformHandle u,
     SkASSERT(uni.fType == kInt_GrSLType || uni.fType == kShort_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, v, arrayCount)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1iv(uni.fLocation, arrayCount, v));
     }
 }
@@ -86,7 +136,8 @@ void GrGLProgramDataManager::set1f(UniformHandle u, float v0) const {
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kFloat_GrSLType || uni.fType == kHalf_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const float values[] = {v0};
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, values, 1)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1f(uni.fLocation, v0));
     }
 }
@@ -102,7 +153,7 @@ void GrGLProgramDataManager::set1fv(UniformHandle u,
     // Once the uniform manager is responsible for inserting the duplicate uniform
     // arrays in VS and FS driver bug workaround, this can be enabled.
     // this->printUni(uni);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, v, arrayCount)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1fv(uni.fLocation, arrayCount, v));
     }
 }
@@ -111,7 +162,8 @@ void GrGLProgramDataManager::set2i(UniformHandle u, int32_t i0, int32_t i1) cons
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kInt2_GrSLType || uni.fType == kShort2_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const int32_t values[] = {i0, i1};
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, values, 2)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2i(uni.fLocation, i0, i1));
     }
 }
@@ -123,7 +175,7 @@ void GrGLProgramDataManager::set2iv(UniformHandle u,
     SkASSERT(uni.fType == kInt2_GrSLType || uni.fType == kShort2_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, v, 2 * arrayCount)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2iv(uni.fLocation, arrayCount, v));
     }
 }
@@ -132,7 +184,8 @@ void GrGLProgramDataManager::set2f(UniformHandle u, float v0, float v1) const {
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kFloat2_GrSLType || uni.fType == kHalf2_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const float values[] = {v0, v1};
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, values, 2)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2f(uni.fLocation, v0, v1));
     }
 }
@@ -144,7 +197,7 @@ void GrGLProgramDataManager::set2fv(UniformHandle u,
     SkASSERT(uni.fType == kFloat2_GrSLType || uni.fType == kHalf2_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, v, 2 * arrayCount)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2fv(uni.fLocation, arrayCount, v));
     }
 }
@@ -153,7 +206,8 @@ void GrGLProgramDataManager::set3i(UniformHandle u, int32_t i0, int32_t i1, int3
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kInt3_GrSLType || uni.fType == kShort3_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const int32_t values[] = {i0, i1, i2};
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, values, 3)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3i(uni.fLocation, i0, i1, i2));
     }
 }
@@ -165,7 +219,7 @@ void GrGLProgramDataManager::set3iv(UniformHandle u,
     SkASSERT(uni.fType == kInt3_GrSLType || uni.fType == kShort3_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, v, 3 * arrayCount)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3iv(uni.fLocation, arrayCount, v));
     }
 }
@@ -174,7 +228,8 @@ void GrGLProgramDataManager::set3f(UniformHandle u, float v0, float v1, float v2
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kFloat3_GrSLType || uni.fType == kHalf3_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const float values[] = {v0, v1, v2};
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, values, 3)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3f(uni.fLocation, v0, v1, v2));
     }
 }
@@ -186,7 +241,7 @@ void GrGLProgramDataManager::set3fv(UniformHandle u,
     SkASSERT(uni.fType == kFloat3_GrSLType || uni.fType == kHalf3_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, v, 3 * arrayCount)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3fv(uni.fLocation, arrayCount, v));
     }
 }
@@ -199,7 +254,8 @@ void GrGLProgramDataManager::set4i(UniformHandle u,
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kInt4_GrSLType || uni.fType == kShort4_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const int32_t values[] = {i0, i1, i2, i3};
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, values, 4)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4i(uni.fLocation, i0, i1, i2, i3));
     }
 }
@@ -211,7 +267,7 @@ void GrGLProgramDataManager::set4iv(UniformHandle u,
     SkASSERT(uni.fType == kInt4_GrSLType || uni.fType == kShort4_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, v, 4 * arrayCount)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4iv(uni.fLocation, arrayCount, v));
     }
 }
@@ -224,7 +280,8 @@ void GrGLProgramDataManager::set4f(UniformHandle u,
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kFloat4_GrSLType || uni.fType == kHalf4_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const float values[] = {v0, v1, v2, v3};
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, values, 4)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4f(uni.fLocation, v0, v1, v2, v3));
     }
 }
@@ -236,7 +293,7 @@ void GrGLProgramDataManager::set4fv(UniformHandle u,
     SkASSERT(uni.fType == kFloat4_GrSLType || uni.fType == kHalf4_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, v, 4 * arrayCount)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4fv(uni.fLocation, arrayCount, v));
     }
 }
@@ -275,7 +332,7 @@ template<int N> inline void GrGLProgramDataManager::setMatrices(UniformHandle u,
              uni.fType == kHalf2x2_GrSLType + (N - 2));
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, matrices, N * N * arrayCount)) {
         set_uniform_matrix<N>::set(fGpu->glInterface(), uni.fLocation, arrayCount, matrices);
     }
 }
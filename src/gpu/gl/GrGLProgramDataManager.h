@@ -86,6 +86,11 @@ private:
 
     struct Uniform {
         GrGLint     fLocation;
+        // The last values uploaded to the uniform are kept at fShadowOffset in fShadowValues. Only
+        // the first fShadowValidCount of its fShadowCount values are known.
+        int         fShadowOffset;
+        int         fShadowCount;
+        mutable int fShadowValidCount;
 #ifdef SK_DEBUG
         GrSLType    fType;
         int         fArrayCount;
@@ -106,7 +111,12 @@ private:
     template<int N> inline void setMatrices(UniformHandle, int arrayCount,
                                             const float matrices[]) const;
 
+    // Returns false if count 32-bit values are already what the uniform holds, and otherwise
+    // records them as its new values.
+    bool needsUpload(const Uniform&, const void* values, int count) const;
+
     SkTArray<Uniform, true> fUniforms;
+    mutable SkTArray<uint32_t, true> fShadowValues;
     SkTArray<PathProcVarying, true> fPathProcVaryings;
     GrGLGpu* fGpu;
     GrGLuint fProgramID;
@@ -136,6 +136,8 @@ void GrGLAttribArrayState::set(GrGLGpu* gpu,
         array->fGPUType = gpuType;
         array->fStride = stride;
         array->fOffset = offsetAsPtr;
+    } else {
+        gpu->stats()->incRedundantCallsSkipped();
     }
     if (gpu->caps()->instanceAttribSupport() && array->fDivisor != divisor) {
         SkASSERT(0 == divisor || 1 == divisor); // not necessarily a requirement but what we expect.
@@ -34,7 +34,8 @@ GrGLProgram* GrGLProgramBuilder::CreateProgram(GrRenderTarget* renderTarget, GrS
                                                const GrTextureProxy* const primProcProxies[],
                                                const GrPipeline& pipeline,
                                                GrProgramDesc* desc,
-                                               GrGLGpu* gpu) {
+                                               GrGLGpu* gpu,
+                                               GrGLPrecompiledProgram* precompiled) {
     SkASSERT(!pipeline.isBad());
 
     ATRACE_ANDROID_FRAMEWORK("Shader Compile");
@@ -46,7 +47,9 @@ GrGLProgram* GrGLProgramBuilder::CreateProgram(GrRenderTarget* renderTarget, GrS
                                pipeline, primProc, primProcProxies, desc);
 
     auto persistentCache = gpu->getContext()->priv().getPersistentCache();
-    if (persistentCache) {
+    if (precompiled && precompiled->fProgramID) {
+        builder.fPrecompiled = precompiled;
+    } else if (persistentCache) {
         sk_sp<SkData> key = SkData::MakeWithoutCopy(desc->asKey(), desc->keyLength());
         builder.fCached = persistentCache->load(*key);
         // the eventual end goal is to completely skip emitAndInstallProcs on a cache hit, but it's
@@ -56,7 +59,7 @@ GrGLProgram* GrGLProgramBuilder::CreateProgram(GrRenderTarget* renderTarget, GrS
     if (!builder.emitAndInstallProcs()) {
         return nullptr;
     }
-    return builder.finalize();
+    return builder.fPrecompiled ? builder.finalizePrecompiled() : builder.finalize();
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -116,7 +119,8 @@ bool GrGLProgramBuilder::compileAndAttachShaders(GrGLSLShaderBuilder& shader,
                                                  const SkSL::Program::Settings& settings,
                                                  SkSL::Program::Inputs* outInputs) {
     SkSL::String glsl;
-    std::unique_ptr<SkSL::Program> program = GrSkSLtoGLSL(gpu()->glContext(), type,
+    GrSkSLCompilerPool::Lease compiler = gpu()->glContext().compilerPool()->acquire();
+    std::unique_ptr<SkSL::Program> program = GrSkSLtoGLSL(compiler.get(), type,
                                                  shader.fCompilerStrings.begin(),
                                                  shader.fCompilerStringLengths.begin(),
                                                  shader.fCompilerStrings.count(),
@@ -330,12 +334,13 @@ GrGLProgram* GrGLProgramBuilder::finalize() {
     }
     if (!cached || !fGpu->glCaps().programBinarySupport()) {
         // either a cache miss, or we can't store binaries in the cache
+        GrSkSLCompilerPool::Lease compiler = fGpu->glContext().compilerPool()->acquire();
         if (glsl.fs().empty()) {
             // Don't have cached GLSL, need to compile SkSL->GLSL
             if (fFS.fForceHighPrecision) {
                 settings.fForceHighPrecision = true;
             }
-            std::unique_ptr<SkSL::Program> fs = GrSkSLtoGLSL(gpu()->glContext(),
+            std::unique_ptr<SkSL::Program> fs = GrSkSLtoGLSL(compiler.get(),
                                                              GR_GL_FRAGMENT_SHADER,
                                                              fFS.fCompilerStrings.begin(),
                                                              fFS.fCompilerStringLengths.begin(),
@@ -362,7 +367,7 @@ GrGLProgram* GrGLProgramBuilder::finalize() {
 
         if (glsl.vs().empty()) {
             // Don't have cached GLSL, need to compile SkSL->GLSL
-            std::unique_ptr<SkSL::Program> vs = GrSkSLtoGLSL(gpu()->glContext(),
+            std::unique_ptr<SkSL::Program> vs = GrSkSLtoGLSL(compiler.get(),
                                                              GR_GL_VERTEX_SHADER,
                                                              fVS.fCompilerStrings.begin(),
                                                              fVS.fCompilerStringLengths.begin(),
@@ -391,7 +396,7 @@ GrGLProgram* GrGLProgramBuilder::finalize() {
             if (glsl.gs().empty()) {
                 // Don't have cached GLSL, need to compile SkSL->GLSL
                 std::unique_ptr<SkSL::Program> gs;
-                gs = GrSkSLtoGLSL(gpu()->glContext(),
+                gs = GrSkSLtoGLSL(compiler.get(),
                                   GR_GL_GEOMETRY_SHADER,
                                   fGS.fCompilerStrings.begin(),
                                   fGS.fCompilerStringLengths.begin(),
@@ -451,6 +456,137 @@ GrGLProgram* GrGLProgramBuilder::finalize() {
     return this->createProgram(programID);
 }
 
+std::unique_ptr<GrGLPrecompiledProgram> GrGLProgramBuilder::PrecompileProgram(
+        GrGLGpu* gpu, const SkData& data) {
+    TRACE_EVENT0("skia", TRACE_FUNC);
+    const GrGLInterface* gl = gpu->glInterface();
+
+    std::unique_ptr<GrGLPrecompiledProgram> precompiled(new GrGLPrecompiledProgram(gpu));
+    GR_GL_CALL_RET(gl, precompiled->fProgramID, CreateProgram());
+    if (0 == precompiled->fProgramID) {
+        return nullptr;
+    }
+    // Deleting precompiled on any of the failures below cleans up the program and shaders.
+    const uint8_t* bytes = data.bytes();
+    if (gpu->glCaps().programBinarySupport()) {
+        // binary cache entry, see storeShaderInCache()
+        size_t offset = 0;
+        int binaryFormat;
+        if (data.size() <= sizeof(precompiled->fInputs) + sizeof(binaryFormat)) {
+            return nullptr;
+        }
+        memcpy(&precompiled->fInputs, bytes + offset, sizeof(precompiled->fInputs));
+        offset += sizeof(precompiled->fInputs);
+        memcpy(&binaryFormat, bytes + offset, sizeof(binaryFormat));
+        offset += sizeof(binaryFormat);
+        GrGLClearErr(gl);
+        GR_GL_CALL_NOERRCHECK(gl, ProgramBinary(precompiled->fProgramID, binaryFormat,
+                                                (void*) (bytes + offset), data.size() - offset));
+        if (GR_GL_GET_ERROR(gl) != GR_GL_NO_ERROR) {
+            return nullptr;
+        }
+        GrGLint linked = GR_GL_INIT_ZERO;
+        GR_GL_CALL(gl, GetProgramiv(precompiled->fProgramID, GR_GL_LINK_STATUS, &linked));
+        if (!linked) {
+            return nullptr;
+        }
+    } else {
+        // source cache entry
+        if (data.size() < sizeof(GrGLSLCacheEntry)) {
+            return nullptr;
+        }
+        static constexpr GrGLenum kGLShaderTypes[] = {
+            GR_GL_VERTEX_SHADER, GR_GL_GEOMETRY_SHADER, GR_GL_FRAGMENT_SHADER,
+        };
+        GR_STATIC_ASSERT(SK_ARRAY_COUNT(kGLShaderTypes) == kGrShaderTypeCount);
+        const GrGLSLCacheEntry* entry = (const GrGLSLCacheEntry*)(bytes);
+        precompiled->fInputs = entry->fInputs;
+        for (int i = 0; i < kGrShaderTypeCount; ++i) {
+            if (!entry->fOffset[i]) {
+                continue;
+            }
+            if (entry->fOffset[i] >= data.size()) {
+                return nullptr;
+            }
+            const char* glsl = entry->get(i);
+            GrGLuint shaderID = GrGLCompileAndAttachShader(gpu->glContext(),
+                                                           precompiled->fProgramID,
+                                                           kGLShaderTypes[i],
+                                                           glsl,
+                                                           SkToInt(strlen(glsl)),
+                                                           gpu->stats(),
+                                                           SkSL::Program::Settings());
+            if (!shaderID) {
+                return nullptr;
+            }
+            *precompiled->fShaderIDs.append() = shaderID;
+        }
+        if (precompiled->fShaderIDs.isEmpty()) {
+            return nullptr;
+        }
+    }
+    return precompiled;
+}
+
+GrGLProgram* GrGLProgramBuilder::finalizePrecompiled() {
+    TRACE_EVENT0("skia", TRACE_FUNC);
+
+    GrGLuint programID = fPrecompiled->fProgramID;
+    SkTDArray<GrGLuint> shadersToDelete;
+    shadersToDelete.swap(fPrecompiled->fShaderIDs);
+    const SkSL::Program::Inputs inputs = fPrecompiled->fInputs;
+    fPrecompiled->fProgramID = 0;
+
+    this->finalizeShaders();
+
+    const GrPrimitiveProcessor& primProc = this->primitiveProcessor();
+    this->addInputVars(inputs);
+    if (shadersToDelete.isEmpty()) {
+        // The program came from a binary and is already linked.
+        this->computeCountsAndStrides(programID, primProc, false);
+    } else {
+        if (inputs.fFlipY) {
+            GrProgramDesc* d = this->desc();
+            d->setSurfaceOriginKey(
+                    GrGLSLFragmentShaderBuilder::KeyForSurfaceOrigin(this->origin()));
+        }
+        if (!primProc.isPathRendering()) {
+            this->computeCountsAndStrides(programID, primProc, true);
+        }
+        this->bindProgramResourceLocations(programID);
+
+        GL_CALL(LinkProgram(programID));
+        // Calling GetProgramiv is expensive in Chromium. Assume success in release builds.
+        bool checkLinked = kChromium_GrGLDriver != fGpu->ctxInfo().driver();
+#ifdef SK_DEBUG
+        checkLinked = true;
+#endif
+        if (checkLinked && !this->checkLinkStatus(programID)) {
+            this->cleanupProgram(programID, shadersToDelete);
+            return nullptr;
+        }
+    }
+    this->resolveProgramResourceLocations(programID);
+
+    this->cleanupShaders(shadersToDelete);
+    return this->createProgram(programID);
+}
+
+GrGLPrecompiledProgram::~GrGLPrecompiledProgram() {
+    const GrGLInterface* gl = fGpu->glInterface();
+    for (int i = 0; i < fShaderIDs.count(); ++i) {
+        GR_GL_CALL(gl, DeleteShader(fShaderIDs[i]));
+    }
+    if (fProgramID) {
+        GR_GL_CALL(gl, DeleteProgram(fProgramID));
+    }
+}
+
+void GrGLPrecompiledProgram::abandon() {
+    fProgramID = 0;
+    fShaderIDs.reset();
+}
+
 void GrGLProgramBuilder::bindProgramResourceLocations(GrGLuint programID) {
     fUniformHandler.bindUniformLocations(programID, fGpu->glCaps());
 
@@ -24,6 +24,30 @@ struct GrGLSLSet;
 class GrGLSLShaderBuilder;
 class GrShaderCaps;
 
+/**
+ * A GL program object compiled by GrGLProgramBuilder::PrecompileProgram() from PersistentCache
+ * data before any draw asked for it. CreateProgram() adopts it when the first such draw comes.
+ */
+class GrGLPrecompiledProgram {
+public:
+    GrGLPrecompiledProgram(GrGLGpu* gpu) : fGpu(gpu) {}
+    ~GrGLPrecompiledProgram();
+
+    // Forgets the GL objects without deleting them, for when the context is lost.
+    void abandon();
+
+private:
+    GrGLGpu*              fGpu;
+    GrGLuint              fProgramID = 0;
+    // Shaders attached to fProgramID when it was compiled from cached GLSL. Attribute locations
+    // depend on the primitive processor, so those programs are linked by CreateProgram(). Empty
+    // if the program was loaded from a binary and is already linked.
+    SkTDArray<GrGLuint>   fShaderIDs;
+    SkSL::Program::Inputs fInputs;
+
+    friend class GrGLProgramBuilder;
+};
+
 class GrGLProgramBuilder : public GrGLSLProgramBuilder {
 public:
     /** Generates a shader program.
@@ -34,6 +58,8 @@ public:
      * This function may modify the GrProgramDesc by setting the surface origin
      * key to 0 (unspecified) if it turns out the program does not care about
      * the surface origin.
+     * If precompiled is not null, its GL objects are used instead of compiling new ones. They are
+     * taken over by the builder whether or not generation succeeds.
      * @return true if generation was successful.
      */
     static GrGLProgram* CreateProgram(GrRenderTarget*, GrSurfaceOrigin,
@@ -41,7 +67,15 @@ public:
                                       const GrTextureProxy* const primProcProxies[],
                                       const GrPipeline&,
                                       GrProgramDesc*,
-                                      GrGLGpu*);
+                                      GrGLGpu*,
+                                      GrGLPrecompiledProgram* precompiled = nullptr);
+
+    /**
+     * Compiles the shaders in data, which was stored in the PersistentCache by an earlier
+     * CreateProgram(). Returns null if data can't be used with this GrGLGpu.
+     */
+    static std::unique_ptr<GrGLPrecompiledProgram> PrecompileProgram(GrGLGpu*,
+                                                                     const SkData& data);
 
     const GrCaps* caps() const override;
 
@@ -72,6 +106,7 @@ private:
     void storeShaderInCache(const SkSL::Program::Inputs& inputs, GrGLuint programID,
                             const GrGLSLSet& glsl);
     GrGLProgram* finalize();
+    GrGLProgram* finalizePrecompiled();
     void bindProgramResourceLocations(GrGLuint programID);
     bool checkLinkStatus(GrGLuint programID);
     void resolveProgramResourceLocations(GrGLuint programID);
@@ -101,6 +136,8 @@ private:
     // (all remaining bytes) char[] binary
     sk_sp<SkData> fCached;
 
+    GrGLPrecompiledProgram* fPrecompiled = nullptr;
+
     typedef GrGLSLProgramBuilder INHERITED;
 };
 #endif
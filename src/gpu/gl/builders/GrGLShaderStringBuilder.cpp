@@ -60,7 +60,7 @@ void print_shader_banner(GrGLenum type) {
     SkDebugf("---- %s shader ----------------------------------------------------\n", typeName);
 }
 
-std::unique_ptr<SkSL::Program> GrSkSLtoGLSL(const GrGLContext& context, GrGLenum type,
+std::unique_ptr<SkSL::Program> GrSkSLtoGLSL(SkSL::Compiler* compiler, GrGLenum type,
                                             const char** skslStrings, int* lengths, int count,
                                             const SkSL::Program::Settings& settings,
                                             SkSL::String* glsl) {
@@ -86,7 +86,6 @@ std::unique_ptr<SkSL::Program> GrSkSLtoGLSL(const GrGLContext& context, GrGLenum
         sksl.append(skslStrings[i], lengths[i]);
     }
 #endif
-    SkSL::Compiler* compiler = context.compiler();
     std::unique_ptr<SkSL::Program> program;
     SkSL::Program::Kind programKind;
     switch (type) {
@@ -179,7 +178,8 @@ void GrGLPrintShader(const GrGLContext& context, GrGLenum type, const char** sks
                      int* lengths, int count, const SkSL::Program::Settings& settings) {
     print_sksl_line_by_line(skslStrings, lengths, count);
     SkSL::String glsl;
-    if (GrSkSLtoGLSL(context, type, skslStrings, lengths, count, settings, &glsl)) {
+    GrSkSLCompilerPool::Lease compiler = context.compilerPool()->acquire();
+    if (GrSkSLtoGLSL(compiler.get(), type, skslStrings, lengths, count, settings, &glsl)) {
         print_glsl_line_by_line(glsl);
     }
 }
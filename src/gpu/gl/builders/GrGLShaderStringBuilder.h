@@ -14,7 +14,11 @@
 #include "SkSLGLSLCodeGenerator.h"
 #include "SkTypes.h"
 
-std::unique_ptr<SkSL::Program> GrSkSLtoGLSL(const GrGLContext& context, GrGLenum type,
+/**
+ * Translates SkSL to GLSL. The returned Program must be destroyed before the compiler's
+ * GrSkSLCompilerPool::Lease.
+ */
+std::unique_ptr<SkSL::Program> GrSkSLtoGLSL(SkSL::Compiler* compiler, GrGLenum type,
                                             const char** skslStrings, int* lengths, int count,
                                             const SkSL::Program::Settings& settings,
                                             SkSL::String* glsl);
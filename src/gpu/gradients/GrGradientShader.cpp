@@ -24,9 +24,11 @@
 #include "GrCaps.h"
 #include "GrColor.h"
 #include "GrColorSpaceInfo.h"
+#include "GrProxyProvider.h"
 #include "GrRecordingContext.h"
 #include "GrRecordingContextPriv.h"
 #include "SkGr.h"
+#include "SkImagePriv.h"
 
 // Intervals smaller than this (that aren't hard stops) on low-precision-only devices force us to
 // use the textured gradient
@@ -36,6 +38,25 @@ static const SkScalar kLowPrecisionIntervalLimit = 0.01f;
 static const int kMaxNumCachedGradientBitmaps = 32;
 static const int kGradientTextureSize = 256;
 
+// Ramp textures are keyed by their contents rather than by the generation ID of the rasterized
+// bitmap, so a ramp that is drawn again on a later frame finds the texture already in the
+// context's resource cache (which does the LRU purging) and is neither rasterized nor uploaded
+// again, even after the process-wide bitmap cache has evicted it.
+static void make_ramp_key(const SkPMColor4f* colors, const SkScalar* positions, int count,
+                          SkColorType colorType, SkAlphaType alphaType, GrUniqueKey* key) {
+    static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
+    static_assert(sizeof(SkPMColor4f) % sizeof(uint32_t) == 0, "");
+    const int colorsAsIntCount = count * sizeof(SkPMColor4f) / sizeof(uint32_t);
+    GrUniqueKey::Builder builder(key, kDomain, 2 + colorsAsIntCount + count, "Gradient Ramp");
+    builder[0] = count;
+    builder[1] = (static_cast<uint32_t>(colorType) << 8) | static_cast<uint32_t>(alphaType);
+    memcpy(&builder[2], colors, count * sizeof(SkPMColor4f));
+    for (int i = 0; i < count; i++) {
+        builder[2 + colorsAsIntCount + i] = SkFloat2Bits(positions[i]);
+    }
+    builder.finish();
+}
+
 // NOTE: signature takes raw pointers to the color/pos arrays and a count to make it easy for
 // MakeColorizer to transparently take care of hard stops at the end points of the gradient.
 static std::unique_ptr<GrFragmentProcessor> make_textured_colorizer(const SkPMColor4f* colors,
@@ -51,16 +72,27 @@ static std::unique_ptr<GrFragmentProcessor> make_textured_colorizer(const SkPMCo
     }
     SkAlphaType alphaType = premul ? kPremul_SkAlphaType : kUnpremul_SkAlphaType;
 
-    SkBitmap bitmap;
-    gCache.getGradient(colors, positions, count, colorType, alphaType, &bitmap);
-    SkASSERT(1 == bitmap.height() && SkIsPow2(bitmap.width()));
-    SkASSERT(bitmap.isImmutable());
-
-    sk_sp<GrTextureProxy> proxy = GrMakeCachedBitmapProxy(
-            args.fContext->priv().proxyProvider(), bitmap);
-    if (proxy == nullptr) {
-        SkDebugf("Gradient won't draw. Could not create texture.");
-        return nullptr;
+    GrProxyProvider* proxyProvider = args.fContext->priv().proxyProvider();
+    GrUniqueKey key;
+    make_ramp_key(colors, positions, count, colorType, alphaType, &key);
+    sk_sp<GrTextureProxy> proxy =
+            proxyProvider->findOrCreateProxyByUniqueKey(key, kTopLeft_GrSurfaceOrigin);
+    if (!proxy) {
+        SkBitmap bitmap;
+        gCache.getGradient(colors, positions, count, colorType, alphaType, &bitmap);
+        SkASSERT(1 == bitmap.height() && SkIsPow2(bitmap.width()));
+        SkASSERT(bitmap.isImmutable());
+
+        sk_sp<SkImage> image = SkMakeImageFromRasterBitmap(bitmap, kNever_SkCopyPixelsMode);
+        if (image) {
+            proxy = proxyProvider->createTextureProxy(std::move(image), kNone_GrSurfaceFlags, 1,
+                                                      SkBudgeted::kYes, SkBackingFit::kExact);
+        }
+        if (proxy == nullptr) {
+            SkDebugf("Gradient won't draw. Could not create texture.");
+            return nullptr;
+        }
+        proxyProvider->assignUniqueKeyToProxy(key, proxy.get());
     }
 
     return GrTextureGradientColorizer::Make(std::move(proxy));
@@ -171,7 +171,19 @@ void main() {
             intervalCount++;
         }
 
-        // For isEqual to make sense, set the unused values to something consistent
+        // The interval count is part of the program key, so round it up to 4 or 8 to keep every
+        // gradient with more than two intervals on one of two programs. The padding intervals repeat
+        // the last real interval and its end threshold, so the binary search still lands on the same
+        // scale and bias for any t. This also keeps the unused values consistent for isEqual.
+        if (intervalCount > 0) {
+            int paddedCount = intervalCount <= 4 ? 4 : kMaxIntervals;
+            for (int i = intervalCount; i < paddedCount; i++) {
+                scales[i] = scales[intervalCount - 1];
+                biases[i] = biases[intervalCount - 1];
+                thresholds[i] = thresholds[intervalCount - 1];
+            }
+            intervalCount = paddedCount;
+        }
         for (int i = intervalCount; i < kMaxIntervals; i++) {
             scales[i] = SK_PMColor4fTRANSPARENT;
             biases[i] = SK_PMColor4fTRANSPARENT;
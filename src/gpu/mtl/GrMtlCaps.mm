@@ -426,6 +426,14 @@ void GrMtlCaps::initConfigTable() {
 
     info = &fConfigTable[kRGBA_half_Clamped_GrPixelConfig];
     info->fFlags = ConfigInfo::kAllFlags;
+
+    // RGB_ETC1 uses ETC2_RGB8, which is only available on iOS
+    info = &fConfigTable[kRGB_ETC1_GrPixelConfig];
+    if (this->isMac()) {
+        info->fFlags = 0;
+    } else {
+        info->fFlags = ConfigInfo::kTextureable_Flag;
+    }
 }
 
 void GrMtlCaps::initStencilFormat(id<MTLDevice> physDev) {
@@ -9,6 +9,7 @@
 #define GrMtlGpu_DEFINED
 
 #include "GrGpu.h"
+#include "GrSkSLCompilerPool.h"
 #include "GrRenderTarget.h"
 #include "GrSemaphore.h"
 #include "GrTexture.h"
@@ -25,10 +26,6 @@ class GrMtlTexture;
 class GrSemaphore;
 struct GrMtlBackendContext;
 
-namespace SkSL {
-    class Compiler;
-}
-
 // Helper macros for autorelease pools
 #define SK_BEGIN_AUTORELEASE_BLOCK @autoreleasepool {
 #define SK_END_AUTORELEASE_BLOCK }
@@ -98,7 +95,7 @@ public:
 
     GrGpuTextureCommandBuffer* getCommandBuffer(GrTexture*, GrSurfaceOrigin) override;
 
-    SkSL::Compiler* shaderCompiler() const { return fCompiler.get(); }
+    GrSkSLCompilerPool* shaderCompilerPool() const { return fCompilerPool.get(); }
 
     void submit(GrGpuCommandBuffer* buffer) override;
 
@@ -196,6 +193,9 @@ private:
     bool uploadToTexture(GrMtlTexture* tex, int left, int top, int width, int height,
                          GrColorType dataColorType, const GrMipLevel texels[], int mipLevels);
 
+    // Uploads every level of a compressed texture, one tightly packed run of blocks per level.
+    bool uploadCompressedTexData(GrMtlTexture* tex, const GrMipLevel texels[], int mipLevels);
+
     GrStencilAttachment* createStencilAttachmentForRenderTarget(const GrRenderTarget*,
                                                                 int width,
                                                                 int height) override;
@@ -214,7 +214,7 @@ private:
 
     id<MTLCommandBuffer> fCmdBuffer;
 
-    std::unique_ptr<SkSL::Compiler> fCompiler;
+    std::unique_ptr<GrSkSLCompilerPool> fCompilerPool;
     GrMtlCopyManager fCopyManager;
     GrMtlResourceProvider fResourceProvider;
 
@@ -96,7 +96,7 @@ GrMtlGpu::GrMtlGpu(GrContext* context, const GrContextOptions& options,
         : INHERITED(context)
         , fDevice(device)
         , fQueue(queue)
-        , fCompiler(new SkSL::Compiler())
+        , fCompilerPool(new GrSkSLCompilerPool())
         , fCopyManager(this)
         , fResourceProvider(this) {
 
@@ -273,6 +273,66 @@ bool GrMtlGpu::uploadToTexture(GrMtlTexture* tex, int left, int top, int width,
     return true;
 }
 
+bool GrMtlGpu::uploadCompressedTexData(GrMtlTexture* tex, const GrMipLevel texels[],
+                                       int mipLevelCount) {
+    SkASSERT(this->caps()->isConfigTexturable(tex->config()));
+    SkASSERT(GrPixelConfigIsCompressed(tex->config()));
+
+    id<MTLTexture> mtlTexture = tex->mtlTexture();
+    SkASSERT(mtlTexture);
+    SkASSERT(mipLevelCount == (int)mtlTexture.mipmapLevelCount);
+
+    SkTArray<size_t> individualMipOffsets(mipLevelCount);
+    size_t combinedBufferSize = 0;
+    int currentWidth = tex->width();
+    int currentHeight = tex->height();
+    for (int currentMipLevel = 0; currentMipLevel < mipLevelCount; currentMipLevel++) {
+        if (!texels[currentMipLevel].fPixels) {
+            return false;
+        }
+        individualMipOffsets.push_back(combinedBufferSize);
+        combinedBufferSize += GrCompressedFormatDataSize(tex->config(), currentWidth,
+                                                         currentHeight);
+        currentWidth = SkTMax(1, currentWidth/2);
+        currentHeight = SkTMax(1, currentHeight/2);
+    }
+
+    // TODO: Create GrMtlTransferBuffer
+    id<MTLBuffer> transferBuffer = [fDevice newBufferWithLength: combinedBufferSize
+                                                        options: MTLResourceStorageModeShared];
+    if (nil == transferBuffer) {
+        return false;
+    }
+    char* buffer = (char*) transferBuffer.contents;
+
+    currentWidth = tex->width();
+    currentHeight = tex->height();
+    id<MTLBlitCommandEncoder> blitCmdEncoder = [fCmdBuffer blitCommandEncoder];
+    for (int currentMipLevel = 0; currentMipLevel < mipLevelCount; currentMipLevel++) {
+        // All of the compressed configs use 8 byte 4x4 blocks.
+        const size_t rowBytes = ((currentWidth + 3) / 4) * 8;
+        const size_t levelSize = GrCompressedFormatDataSize(tex->config(), currentWidth,
+                                                            currentHeight);
+        memcpy(buffer + individualMipOffsets[currentMipLevel], texels[currentMipLevel].fPixels,
+               levelSize);
+
+        [blitCmdEncoder copyFromBuffer: transferBuffer
+                          sourceOffset: individualMipOffsets[currentMipLevel]
+                     sourceBytesPerRow: rowBytes
+                   sourceBytesPerImage: levelSize
+                            sourceSize: MTLSizeMake(currentWidth, currentHeight, 1)
+                             toTexture: mtlTexture
+                      destinationSlice: 0
+                      destinationLevel: currentMipLevel
+                     destinationOrigin: MTLOriginMake(0, 0, 0)];
+        currentWidth = SkTMax(1, currentWidth/2);
+        currentHeight = SkTMax(1, currentHeight/2);
+    }
+    [blitCmdEncoder endEncoding];
+
+    return true;
+}
+
 GrStencilAttachment* GrMtlGpu::createStencilAttachmentForRenderTarget(const GrRenderTarget* rt,
                                                                       int width,
                                                                       int height) {
@@ -304,9 +364,7 @@ sk_sp<GrTexture> GrMtlGpu::onCreateTexture(const GrSurfaceDesc& desc, SkBudgeted
         return nullptr;
     }
 
-    if (GrPixelConfigIsCompressed(desc.fConfig)) {
-        return nullptr; // TODO: add compressed texture support
-    }
+    bool isCompressed = GrPixelConfigIsCompressed(desc.fConfig);
 
     bool renderTarget = SkToBool(desc.fFlags & kRenderTarget_GrSurfaceFlag);
 
@@ -356,7 +414,12 @@ sk_sp<GrTexture> GrMtlGpu::onCreateTexture(const GrSurfaceDesc& desc, SkBudgeted
     }
 
     auto colorType = GrPixelConfigToColorType(desc.fConfig);
-    if (mipLevelCount && texels[0].fPixels) {
+    if (isCompressed && mipLevelCount && texels[0].fPixels) {
+        if (!this->uploadCompressedTexData(tex.get(), texels, mipLevelCount)) {
+            tex->unref();
+            return nullptr;
+        }
+    } else if (mipLevelCount && texels[0].fPixels) {
         if (!this->uploadToTexture(tex.get(), 0, 0, desc.fWidth, desc.fHeight, colorType, texels,
                                    mipLevelCount)) {
             tex->unref();
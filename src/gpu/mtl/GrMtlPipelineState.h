@@ -37,6 +37,8 @@ public:
             MTLPixelFormat pixelFormat,
             const GrGLSLBuiltinUniformHandles& builtinUniformHandles,
             const UniformInfoArray& uniforms,
+            uint32_t geometryUniformSize,
+            uint32_t fragmentUniformSize,
             sk_sp<GrMtlBuffer> geometryUniformBuffer,
             sk_sp<GrMtlBuffer> fragmentUniformBuffer,
             uint32_t numSamplers,
@@ -112,6 +114,7 @@ private:
 
     GrStencilSettings fStencil;
 
+    // Null for stages whose uniforms are small enough to be set inline on the encoder.
     sk_sp<GrMtlBuffer> fGeometryUniformBuffer;
     sk_sp<GrMtlBuffer> fFragmentUniformBuffer;
 
@@ -37,6 +37,8 @@ GrMtlPipelineState::GrMtlPipelineState(
         MTLPixelFormat pixelFormat,
         const GrGLSLBuiltinUniformHandles& builtinUniformHandles,
         const UniformInfoArray& uniforms,
+        uint32_t geometryUniformSize,
+        uint32_t fragmentUniformSize,
         sk_sp<GrMtlBuffer> geometryUniformBuffer,
         sk_sp<GrMtlBuffer> fragmentUniformBuffer,
         uint32_t numSamplers,
@@ -55,8 +57,7 @@ GrMtlPipelineState::GrMtlPipelineState(
         , fXferProcessor(std::move(xferProcessor))
         , fFragmentProcessors(std::move(fragmentProcessors))
         , fFragmentProcessorCnt(fragmentProcessorCnt)
-        , fDataManager(uniforms, fGeometryUniformBuffer->size(),
-                       fFragmentUniformBuffer->size()) {
+        , fDataManager(uniforms, geometryUniformSize, fragmentUniformSize) {
     (void) fPixelFormat; // Suppress unused-var warning.
 }
 
@@ -129,6 +130,7 @@ void GrMtlPipelineState::bind(id<MTLRenderCommandEncoder> renderCmdEncoder) {
                                      offset: 0
                                     atIndex: GrMtlUniformHandler::kFragBinding];
     }
+    fDataManager.setInlineUniforms(renderCmdEncoder);
     SkASSERT(fNumSamplers == fSamplerBindings.count());
     for (int index = 0; index < fNumSamplers; ++index) {
         [renderCmdEncoder setFragmentTexture: fSamplerBindings[index].fTexture
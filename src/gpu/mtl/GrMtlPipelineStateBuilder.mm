@@ -317,6 +317,13 @@ uint32_t buffer_size(uint32_t offset, uint32_t maxAlignment) {
     return offset + offsetDiff;
 }
 
+static sk_sp<GrMtlBuffer> make_uniform_buffer(GrMtlGpu* gpu, uint32_t size) {
+    if (!size || GrMtlPipelineStateDataManager::UseInlineUniforms(size)) {
+        return nullptr;
+    }
+    return GrMtlBuffer::Make(gpu, size, GrGpuBufferType::kVertex, kStatic_GrAccessPattern);
+}
+
 GrMtlPipelineState* GrMtlPipelineStateBuilder::finalize(GrRenderTarget* renderTarget,
                                                         const GrPrimitiveProcessor& primProc,
                                                         const GrPipeline& pipeline,
@@ -388,14 +395,10 @@ GrMtlPipelineState* GrMtlPipelineStateBuilder::finalize(GrRenderTarget* renderTa
                                   pipelineDescriptor.colorAttachments[0].pixelFormat,
                                   fUniformHandles,
                                   fUniformHandler.fUniforms,
-                                  GrMtlBuffer::Make(fGpu,
-                                                    geomBufferSize,
-                                                    GrGpuBufferType::kVertex,
-                                                    kStatic_GrAccessPattern),
-                                  GrMtlBuffer::Make(fGpu,
-                                                    fragBufferSize,
-                                                    GrGpuBufferType::kVertex,
-                                                    kStatic_GrAccessPattern),
+                                  geomBufferSize,
+                                  fragBufferSize,
+                                  make_uniform_buffer(fGpu, geomBufferSize),
+                                  make_uniform_buffer(fGpu, fragBufferSize),
                                   (uint32_t)fUniformHandler.numSamplers(),
                                   std::move(fGeometryProcessor),
                                   std::move(fXferProcessor),
@@ -12,6 +12,8 @@
 #include "GrMtlUniformHandler.h"
 #include "SkAutoMalloc.h"
 
+#import <metal/metal.h>
+
 class GrMtlBuffer;
 class GrMtlGpu;
 
@@ -54,10 +56,21 @@ public:
         SK_ABORT("Only supported in NVPR, which is not in Metal");
     }
 
+    // Uniform blocks no larger than this are passed to the encoder with setVertexBytes and
+    // setFragmentBytes, which copy them into memory Metal recycles per command buffer. They need
+    // neither a GrMtlBuffer of their own nor a blit from a staging buffer on every change.
+    static constexpr uint32_t kMaxInlineUniformSize = 4096;
+
+    static bool UseInlineUniforms(uint32_t size) { return size <= kMaxInlineUniformSize; }
+
+    // Only stages too large for inline uniforms have buffers; pass nullptr for the others.
     void uploadUniformBuffers(GrMtlGpu* gpu,
                               GrMtlBuffer* geometryBuffer,
                               GrMtlBuffer* fragmentBuffer) const;
 
+    // Sets the uniform blocks of the stages that use inline uniforms on the encoder.
+    void setInlineUniforms(id<MTLRenderCommandEncoder>) const;
+
 private:
     struct Uniform {
         uint32_t fBinding;
@@ -374,3 +374,19 @@ void GrMtlPipelineStateDataManager::uploadUniformBuffers(GrMtlGpu* gpu,
         fFragmentUniformsDirty = false;
     }
 }
+
+void GrMtlPipelineStateDataManager::setInlineUniforms(
+        id<MTLRenderCommandEncoder> renderCmdEncoder) const {
+    if (fGeometryUniformSize && UseInlineUniforms(fGeometryUniformSize)) {
+        [renderCmdEncoder setVertexBytes: fGeometryUniformData.get()
+                                  length: fGeometryUniformSize
+                                 atIndex: GrMtlUniformHandler::kGeometryBinding];
+        fGeometryUniformsDirty = false;
+    }
+    if (fFragmentUniformSize && UseInlineUniforms(fFragmentUniformSize)) {
+        [renderCmdEncoder setFragmentBytes: fFragmentUniformData.get()
+                                    length: fFragmentUniformSize
+                                   atIndex: GrMtlUniformHandler::kFragBinding];
+        fFragmentUniformsDirty = false;
+    }
+}
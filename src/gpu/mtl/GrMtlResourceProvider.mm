@@ -7,6 +7,7 @@
 
 #include "GrMtlResourceProvider.h"
 
+#include "GrContextPriv.h"
 #include "GrMtlCopyManager.h"
 #include "GrMtlGpu.h"
 #include "GrMtlPipelineState.h"
@@ -62,7 +63,9 @@ struct GrMtlResourceProvider::PipelineStateCache::Entry {
 };
 
 GrMtlResourceProvider::PipelineStateCache::PipelineStateCache(GrMtlGpu* gpu)
-    : fMap(kMaxEntries)
+    // We may actually have one more PipelineState in context than the cache holds, because we
+    // create a new PipelineState before evicting from the cache.
+    : fMap(gpu->getContext()->priv().options().fRuntimeProgramCacheSize)
     , fGpu(gpu)
 #ifdef GR_PIPELINE_STATE_CACHE_STATS
     , fTotalRequests(0)
@@ -100,6 +100,10 @@ bool GrPixelConfigToMTLFormat(GrPixelConfig config, MTLPixelFormat* format) {
 #else
             return false;
 #endif
+        case kRGB_BC1_GrPixelConfig:
+            // Metal only has BC1_RGBA, which would make the black texels of 3 color blocks
+            // transparent.
+            return false;
     }
     SK_ABORT("Unexpected config");
     return false;
@@ -152,20 +156,21 @@ id<MTLLibrary> GrCompileMtlShaderLibrary(const GrMtlGpu* gpu,
                                          SkSL::Program::Kind kind,
                                          const SkSL::Program::Settings& settings,
                                          SkSL::Program::Inputs* outInputs) {
+    GrSkSLCompilerPool::Lease compiler = gpu->shaderCompilerPool()->acquire();
     std::unique_ptr<SkSL::Program> program =
-            gpu->shaderCompiler()->convertProgram(kind,
-                                                  SkSL::String(shaderString),
-                                                  settings);
+            compiler->convertProgram(kind,
+                                     SkSL::String(shaderString),
+                                     settings);
 
     if (!program) {
-        SkDebugf("SkSL error:\n%s\n", gpu->shaderCompiler()->errorText().c_str());
+        SkDebugf("SkSL error:\n%s\n", compiler->errorText().c_str());
         SkASSERT(false);
     }
 
     *outInputs = program->fInputs;
     SkSL::String code;
-    if (!gpu->shaderCompiler()->toMetal(*program, &code)) {
-        SkDebugf("%s\n", gpu->shaderCompiler()->errorText().c_str());
+    if (!compiler->toMetal(*program, &code)) {
+        SkDebugf("%s\n", compiler->errorText().c_str());
         SkASSERT(false);
         return nil;
     }
@@ -60,7 +60,8 @@ std::unique_ptr<GrAtlasTextOp> GrAtlasTextOp::MakeDistanceField(
                                             SkColor luminanceColor,
                                             const SkSurfaceProps& props,
                                             bool isAntiAliased,
-                                            bool useLCD) {
+                                            bool useLCD,
+                                            bool isMultiChannel) {
         GrOpMemoryPool* pool = context->priv().opMemoryPool();
 
         std::unique_ptr<GrAtlasTextOp> op = pool->allocate<GrAtlasTextOp>(std::move(paint));
@@ -73,6 +74,7 @@ std::unique_ptr<GrAtlasTextOp> GrAtlasTextOp::MakeDistanceField(
                                                : kGrayscaleDistanceField_MaskType;
         op->fDistanceAdjustTable.reset(SkRef(distanceAdjustTable));
         op->fUseGammaCorrectDistanceTable = useGammaCorrectDistanceTable;
+        op->fIsMultiChannel = isMultiChannel;
         op->fLuminanceColor = luminanceColor;
         op->fNumGlyphs = glyphCount;
         op->fGeoCount = 1;
@@ -95,6 +97,7 @@ void GrAtlasTextOp::init() {
         fDFGPFlags |= (kAliasedDistanceField_MaskType == fMaskType)
                               ? kAliased_DistanceFieldEffectFlag
                               : 0;
+        fDFGPFlags |= fIsMultiChannel ? kMultiChannel_DistanceFieldEffectFlag : 0;
 
         if (isLCD) {
             fDFGPFlags |= kUseLCD_DistanceFieldEffectFlag;
@@ -196,12 +199,12 @@ static void clip_quads(const SkIRect& clipRect, char* currVertex, const char* bl
             auto* blobCoordsRB = reinterpret_cast<const uint16_t*>(blobVertices + 3 * vertexStride +
                                                                    coordOffset);
             // Pull out the texel coordinates and texture index bits
-            uint16_t coordsRectL = blobCoordsLT[0] >> 1;
-            uint16_t coordsRectT = blobCoordsLT[1] >> 1;
-            uint16_t coordsRectR = blobCoordsRB[0] >> 1;
-            uint16_t coordsRectB = blobCoordsRB[1] >> 1;
-            uint16_t pageIndexX = blobCoordsLT[0] & 0x1;
-            uint16_t pageIndexY = blobCoordsLT[1] & 0x1;
+            uint16_t coordsRectL = GrDrawOpAtlas::UnpackTexel(blobCoordsLT[0]);
+            uint16_t coordsRectT = GrDrawOpAtlas::UnpackTexel(blobCoordsLT[1]);
+            uint16_t coordsRectR = GrDrawOpAtlas::UnpackTexel(blobCoordsRB[0]);
+            uint16_t coordsRectB = GrDrawOpAtlas::UnpackTexel(blobCoordsRB[1]);
+            uint16_t pageIndexX = GrDrawOpAtlas::UnpackPageBits(blobCoordsLT[0]);
+            uint16_t pageIndexY = GrDrawOpAtlas::UnpackPageBits(blobCoordsLT[1]);
 
             int positionRectWidth = positionRect.width();
             int positionRectHeight = positionRect.height();
@@ -227,10 +230,10 @@ static void clip_quads(const SkIRect& clipRect, char* currVertex, const char* bl
             positionRect.fBottom -= delta;
 
             // Repack texel coordinates and index
-            coordsRectL = coordsRectL << 1 | pageIndexX;
-            coordsRectT = coordsRectT << 1 | pageIndexY;
-            coordsRectR = coordsRectR << 1 | pageIndexX;
-            coordsRectB = coordsRectB << 1 | pageIndexY;
+            coordsRectL = coordsRectL << GrDrawOpAtlas::kPageIndexBits | pageIndexX;
+            coordsRectT = coordsRectT << GrDrawOpAtlas::kPageIndexBits | pageIndexY;
+            coordsRectR = coordsRectR << GrDrawOpAtlas::kPageIndexBits | pageIndexX;
+            coordsRectB = coordsRectB << GrDrawOpAtlas::kPageIndexBits | pageIndexY;
 
             // Set new positions and coords
             SkPoint* currPosition = reinterpret_cast<SkPoint*>(currVertex);
@@ -274,6 +277,53 @@ static void clip_quads(const SkIRect& clipRect, char* currVertex, const char* bl
     }
 }
 
+GR_DECLARE_STATIC_UNIQUE_KEY(gCornerBufferKey);
+
+// Writes one instance per glyph for GrBitmapTextGeoProc::MakeInstanced: the glyph's device rect,
+// its color if color is non-null, and the top-left and bottom-right corners of its atlas rect.
+static void write_glyph_instances(char* currInstance, const char* blobVertices,
+                                  size_t vertexStride, int glyphCount, SkVector translation,
+                                  const GrColor* color) {
+    size_t coordOffset = vertexStride - 2*sizeof(uint16_t);
+    for (int i = 0; i < glyphCount; ++i) {
+        const char* blobVertexRB = blobVertices + 3 * vertexStride;
+        const SkPoint* blobPositionLT = reinterpret_cast<const SkPoint*>(blobVertices);
+        const SkPoint* blobPositionRB = reinterpret_cast<const SkPoint*>(blobVertexRB);
+
+        SkRect* rect = reinterpret_cast<SkRect*>(currInstance);
+        rect->setLTRB(blobPositionLT->fX, blobPositionLT->fY,
+                      blobPositionRB->fX, blobPositionRB->fY);
+        rect->offset(translation);
+        currInstance += sizeof(SkRect);
+
+        if (color) {
+            *reinterpret_cast<GrColor*>(currInstance) = *color;
+            currInstance += sizeof(GrColor);
+        }
+
+        memcpy(currInstance, blobVertices + coordOffset, 2*sizeof(uint16_t));
+        memcpy(currInstance + 2*sizeof(uint16_t), blobVertexRB + coordOffset, 2*sizeof(uint16_t));
+        currInstance += 4*sizeof(uint16_t);
+
+        blobVertices += 4 * vertexStride;
+    }
+}
+
+bool GrAtlasTextOp::canDrawInstanced(const GrCaps& caps) const {
+    // Distance field and transformed glyphs are mapped by the view matrix per vertex, and clipped
+    // glyphs are cropped per vertex, so only unclipped device space glyphs can be instanced.
+    if (!caps.instanceAttribSupport() || this->usesDistanceFields() || fNeedsGlyphTransform ||
+        fGeoData[0].fViewMatrix.hasPerspective()) {
+        return false;
+    }
+    for (int i = 0; i < fGeoCount; i++) {
+        if (!fGeoData[i].fClipRect.isEmpty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void GrAtlasTextOp::onPrepareDraws(Target* target) {
     auto resourceProvider = target->resourceProvider();
 
@@ -300,6 +350,7 @@ void GrAtlasTextOp::onPrepareDraws(Target* target) {
     static constexpr int kMaxTextures = GrBitmapTextGeoProc::kMaxTextures;
     GR_STATIC_ASSERT(GrDistanceFieldA8TextGeoProc::kMaxTextures == kMaxTextures);
     GR_STATIC_ASSERT(GrDistanceFieldLCDTextGeoProc::kMaxTextures == kMaxTextures);
+    GR_STATIC_ASSERT(GrDrawOpAtlas::kMaxPages <= kMaxTextures);
 
     auto fixedDynamicState = target->makeFixedDynamicState(kMaxTextures);
     for (unsigned i = 0; i < numActiveProxies; ++i) {
@@ -310,9 +361,16 @@ void GrAtlasTextOp::onPrepareDraws(Target* target) {
     flushInfo.fFixedDynamicState = fixedDynamicState;
 
     bool vmPerspective = fGeoData[0].fViewMatrix.hasPerspective();
+    // Instanced glyphs leave the blob's vertices where they are, so moving text, e.g. scrolling,
+    // doesn't rewrite them; the translation is applied as the instances are written.
+    bool instanced = this->canDrawInstanced(target->caps());
     if (this->usesDistanceFields()) {
         flushInfo.fGeometryProcessor = this->setupDfProcessor(*target->caps().shaderCaps(),
                                                               proxies, numActiveProxies);
+    } else if (instanced) {
+        flushInfo.fGeometryProcessor = GrBitmapTextGeoProc::MakeInstanced(
+            *target->caps().shaderCaps(), this->color(), proxies, numActiveProxies,
+            GrSamplerState::ClampNearest(), maskFormat, localMatrix);
     } else {
         GrSamplerState samplerState = fNeedsGlyphTransform ? GrSamplerState::ClampBilerp()
                                                            : GrSamplerState::ClampNearest();
@@ -323,12 +381,30 @@ void GrAtlasTextOp::onPrepareDraws(Target* target) {
 
     flushInfo.fGlyphsToFlush = 0;
     size_t vertexStride = flushInfo.fGeometryProcessor->vertexStride();
+    size_t instanceStride = flushInfo.fGeometryProcessor->instanceStride();
 
     int glyphCount = this->numGlyphs();
 
-    void* vertices = target->makeVertexSpace(vertexStride, glyphCount * kVerticesPerGlyph,
-                                             &flushInfo.fVertexBuffer, &flushInfo.fVertexOffset);
-    flushInfo.fIndexBuffer = target->resourceProvider()->refQuadIndexBuffer();
+    void* vertices;
+    if (instanced) {
+        // Each instance is expanded to a strip over the corners of the glyph's rect, in the same
+        // order as the blob's vertices.
+        static const SkPoint kCorners[] = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+        GR_DEFINE_STATIC_UNIQUE_KEY(gCornerBufferKey);
+        flushInfo.fCornerBuffer = resourceProvider->findOrMakeStaticBuffer(
+                GrGpuBufferType::kVertex, sizeof(kCorners), kCorners, gCornerBufferKey);
+        vertexStride = GrTextBlob::GetVertexStride(maskFormat, false);
+        vertices = target->makeVertexSpace(instanceStride, glyphCount, &flushInfo.fVertexBuffer,
+                                           &flushInfo.fVertexOffset);
+        if (!flushInfo.fCornerBuffer) {
+            SkDebugf("Could not allocate glyph corners\n");
+            return;
+        }
+    } else {
+        vertices = target->makeVertexSpace(vertexStride, glyphCount * kVerticesPerGlyph,
+                                           &flushInfo.fVertexBuffer, &flushInfo.fVertexOffset);
+        flushInfo.fIndexBuffer = target->resourceProvider()->refQuadIndexBuffer();
+    }
     if (!vertices || !flushInfo.fVertexBuffer) {
         SkDebugf("Could not allocate vertices\n");
         return;
@@ -345,7 +421,7 @@ void GrAtlasTextOp::onPrepareDraws(Target* target) {
         GrTextBlob::VertexRegenerator regenerator(
                 resourceProvider, blob, args.fRun, args.fSubRun, args.fViewMatrix, args.fX, args.fY,
                 args.fColor.toBytes_RGBA(), target->deferredUploadTarget(), glyphCache,
-                atlasManager, &autoGlyphCache);
+                atlasManager, &autoGlyphCache, !instanced);
         bool done = false;
         while (!done) {
             GrTextBlob::VertexRegenerator::Result result;
@@ -354,6 +430,19 @@ void GrAtlasTextOp::onPrepareDraws(Target* target) {
             }
             done = result.fFinished;
 
+            if (instanced) {
+                GrColor color = args.fColor.toBytes_RGBA();
+                write_glyph_instances(currVertex, result.fFirstVertex, vertexStride,
+                                      result.fGlyphsRegenerated, regenerator.translation(),
+                                      kARGB_GrMaskFormat != maskFormat ? &color : nullptr);
+                flushInfo.fGlyphsToFlush += result.fGlyphsRegenerated;
+                if (!result.fFinished) {
+                    this->flush(target, &flushInfo);
+                }
+                currVertex += result.fGlyphsRegenerated * instanceStride;
+                continue;
+            }
+
             // Copy regenerated vertices from the blob to our vertex buffer.
             size_t vertexBytes = result.fGlyphsRegenerated * kVerticesPerGlyph * vertexStride;
             if (args.fClipRect.isEmpty()) {
@@ -429,6 +518,18 @@ void GrAtlasTextOp::flush(GrMeshDrawOp::Target* target, FlushInfo* flushInfo) co
                                                                       samplerState);
         }
     }
+    if (flushInfo->fCornerBuffer) {
+        GrMesh* mesh = target->allocMesh(GrPrimitiveType::kTriangleStrip);
+        mesh->setInstanced(flushInfo->fVertexBuffer, flushInfo->fGlyphsToFlush,
+                           flushInfo->fVertexOffset, kVerticesPerGlyph);
+        mesh->setVertexData(flushInfo->fCornerBuffer);
+        target->recordDraw(
+                flushInfo->fGeometryProcessor, mesh, 1, flushInfo->fFixedDynamicState, nullptr);
+        flushInfo->fVertexOffset += flushInfo->fGlyphsToFlush;
+        flushInfo->fGlyphsToFlush = 0;
+        return;
+    }
+
     int maxGlyphsPerDraw = static_cast<int>(flushInfo->fIndexBuffer->size() / sizeof(uint16_t) / 6);
     GrMesh* mesh = target->allocMesh(GrPrimitiveType::kTriangles);
     mesh->setIndexedPatterned(flushInfo->fIndexBuffer, kIndicesPerGlyph, kVerticesPerGlyph,
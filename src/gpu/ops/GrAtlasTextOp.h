@@ -55,7 +55,8 @@ public:
             SkColor luminanceColor,
             const SkSurfaceProps&,
             bool isAntiAliased,
-            bool useLCD);
+            bool useLCD,
+            bool isMultiChannel);
 
     // To avoid even the initial copy of the struct, we have a getter for the first item which
     // is used to seed the op with its initial geometry.  After seeding, the client should call
@@ -105,8 +106,11 @@ private:
             , fProcessors(std::move(paint)) {}
 
     struct FlushInfo {
+        // When drawing instanced glyphs, fVertexBuffer holds the instances, fVertexOffset is the
+        // next instance and fCornerBuffer is the static quad they're drawn with.
         sk_sp<const GrBuffer> fVertexBuffer;
         sk_sp<const GrBuffer> fIndexBuffer;
+        sk_sp<const GrBuffer> fCornerBuffer;
         sk_sp<GrGeometryProcessor> fGeometryProcessor;
         GrPipeline::FixedDynamicState* fFixedDynamicState;
         int fGlyphsToFlush;
@@ -123,11 +127,12 @@ private:
             case kColorBitmapMask_MaskType:
                 return kARGB_GrMaskFormat;
             case kGrayscaleCoverageMask_MaskType:
+                return kA8_GrMaskFormat;
             case kAliasedDistanceField_MaskType:
             case kGrayscaleDistanceField_MaskType:
             case kLCDDistanceField_MaskType:
             case kLCDBGRDistanceField_MaskType:
-                return kA8_GrMaskFormat;
+                return fIsMultiChannel ? kARGB_GrMaskFormat : kA8_GrMaskFormat;
         }
         return kA8_GrMaskFormat;  // suppress warning
     }
@@ -145,6 +150,8 @@ private:
                kLCDBGRDistanceField_MaskType == fMaskType;
     }
 
+    bool canDrawInstanced(const GrCaps&) const;
+
     inline void flush(GrMeshDrawOp::Target* target, FlushInfo* flushInfo) const;
 
     const SkPMColor4f& color() const { SkASSERT(fGeoCount > 0); return fGeoData[0].fColor; }
@@ -164,6 +171,7 @@ private:
         uint32_t fUsesLocalCoords : 1;
         uint32_t fUseGammaCorrectDistanceTable : 1;
         uint32_t fNeedsGlyphTransform : 1;
+        uint32_t fIsMultiChannel : 1;
     };
     int fGeoCount;
     int fNumGlyphs;
@@ -59,15 +59,35 @@ static inline GrVertexWriter::TriStrip<float> origin_centered_tri_strip(float x,
  * types of arcs.
  * Round caps for stroking are allowed as well. The caps are specified as two circle center points
  * in the same space as p.xy.
+ *
+ * Full circles without clip planes or round caps can also be drawn instanced. In that case the
+ * geometry is a static octagon ring and the per-vertex attribute is:
+ *    vec3f : (q.xy, inner)
+ *             q is a point on the unit octagon, inner is 1 for the inner ring and 0 for the outer.
+ * and the position, color and edge attributes become per-instance attributes:
+ *    vec2f : center of the circle in device space
+ *    vec4ub: color
+ *    vec2f : (outerRad, innerRad), as above
  */
 
 class CircleGeometryProcessor : public GrGeometryProcessor {
 public:
     CircleGeometryProcessor(bool stroke, bool clipPlane, bool isectPlane, bool unionPlane,
-                            bool roundCaps, bool wideColor, const SkMatrix& localMatrix)
+                            bool roundCaps, bool wideColor, const SkMatrix& localMatrix,
+                            bool instanced = false)
             : INHERITED(kCircleGeometryProcessor_ClassID)
             , fLocalMatrix(localMatrix)
             , fStroke(stroke) {
+        if (instanced) {
+            SkASSERT(!clipPlane && !isectPlane && !unionPlane && !roundCaps);
+            fInOctagonPoint = {"inOctagonPoint", kFloat3_GrVertexAttribType, kFloat3_GrSLType};
+            fInPosition = {"inCenter", kFloat2_GrVertexAttribType, kFloat2_GrSLType};
+            fInColor = MakeColorAttribute("inColor", wideColor);
+            fInCircleEdge = {"inRadii", kFloat2_GrVertexAttribType, kFloat2_GrSLType};
+            this->setVertexAttributes(&fInOctagonPoint, 1);
+            this->setInstanceAttributes(&fInPosition, 3);
+            return;
+        }
         fInPosition = {"inPosition", kFloat2_GrVertexAttribType, kFloat2_GrSLType};
         fInColor = MakeColorAttribute("inColor", wideColor);
         fInCircleEdge = {"inCircleEdge", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
@@ -116,8 +136,27 @@ private:
 
             // emit attributes
             varyingHandler->emitAttributes(cgp);
-            fragBuilder->codeAppend("float4 circleEdge;");
-            varyingHandler->addPassThroughAttribute(cgp.fInCircleEdge, "circleEdge");
+            GrShaderVar position = cgp.fInPosition.asShaderVar();
+            if (cgp.fInOctagonPoint.isInitialized()) {
+                // Place the octagon ring vertex around the instance's center. A negative inner
+                // radius (fills) collapses the inner ring to the center.
+                const char* octagonPoint = cgp.fInOctagonPoint.name();
+                vertBuilder->codeAppendf("float2 radii = %s;", cgp.fInCircleEdge.name());
+                vertBuilder->codeAppendf(
+                        "float2 offset = %s.xy * mix(1.0, max(radii.y, 0.0), %s.z);",
+                        octagonPoint, octagonPoint);
+                vertBuilder->codeAppendf("float2 devPosition = %s + offset * radii.x;",
+                                         cgp.fInPosition.name());
+                position = GrShaderVar("devPosition", kFloat2_GrSLType);
+
+                GrGLSLVarying circleEdge(kFloat4_GrSLType);
+                varyingHandler->addVarying("circleEdge", &circleEdge);
+                vertBuilder->codeAppendf("%s = float4(offset, radii);", circleEdge.vsOut());
+                fragBuilder->codeAppendf("float4 circleEdge = %s;", circleEdge.fsIn());
+            } else {
+                fragBuilder->codeAppend("float4 circleEdge;");
+                varyingHandler->addPassThroughAttribute(cgp.fInCircleEdge, "circleEdge");
+            }
             if (cgp.fInClipPlane.isInitialized()) {
                 fragBuilder->codeAppend("half3 clipPlane;");
                 varyingHandler->addPassThroughAttribute(cgp.fInClipPlane, "clipPlane");
@@ -147,13 +186,13 @@ private:
             varyingHandler->addPassThroughAttribute(cgp.fInColor, args.fOutputColor);
 
             // Setup position
-            this->writeOutputPosition(vertBuilder, gpArgs, cgp.fInPosition.name());
+            this->writeOutputPosition(vertBuilder, gpArgs, position.c_str());
 
             // emit transforms
             this->emitTransforms(vertBuilder,
                                  varyingHandler,
                                  uniformHandler,
-                                 cgp.fInPosition.asShaderVar(),
+                                 position,
                                  cgp.fLocalMatrix,
                                  args.fFPCoordTransformHandler);
 
@@ -210,6 +249,7 @@ private:
             key |= cgp.fInIsectPlane.isInitialized() ? 0x08 : 0x0;
             key |= cgp.fInUnionPlane.isInitialized() ? 0x10 : 0x0;
             key |= cgp.fInRoundCapCenters.isInitialized() ? 0x20 : 0x0;
+            key |= cgp.fInOctagonPoint.isInitialized() ? 0x40 : 0x0;
             b->add32(key);
         }
 
@@ -233,6 +273,8 @@ private:
     Attribute fInIsectPlane;
     Attribute fInUnionPlane;
     Attribute fInRoundCapCenters;
+    // Only used when instanced.
+    Attribute fInOctagonPoint;
 
     bool fStroke;
     GR_DECLARE_GEOMETRY_PROCESSOR_TEST
@@ -251,6 +293,10 @@ sk_sp<GrGeometryProcessor> CircleGeometryProcessor::TestCreate(GrProcessorTestDa
     bool isectPlane = d->fRandom->nextBool();
     bool unionPlane = d->fRandom->nextBool();
     const SkMatrix& matrix = GrTest::TestMatrix(d->fRandom);
+    if (d->caps()->instanceAttribSupport() && d->fRandom->nextBool()) {
+        return sk_sp<GrGeometryProcessor>(new CircleGeometryProcessor(
+                stroke, false, false, false, false, wideColor, matrix, true));
+    }
     return sk_sp<GrGeometryProcessor>(new CircleGeometryProcessor(
             stroke, clipPlane, isectPlane, unionPlane, roundCaps, wideColor, matrix));
 }
@@ -941,6 +987,27 @@ static constexpr SkPoint kOctagonInner[] = {
     SkPoint::Make(-kCosPi8, -kSinPi8),
 };
 
+// The static geometry for instanced circles: the outer octagon followed by the inner one, with a
+// third component that tells the shader which ring the vertex is on. The fill indices use the
+// first inner ring vertex as the center, which works because fills never have a positive inner
+// radius and so the whole inner ring collapses to the center.
+static const float gInstancedCircleVertices[] = {
+        // clang-format off
+        kOctagonOuter[0].fX, kOctagonOuter[0].fY, 0, kOctagonOuter[1].fX, kOctagonOuter[1].fY, 0,
+        kOctagonOuter[2].fX, kOctagonOuter[2].fY, 0, kOctagonOuter[3].fX, kOctagonOuter[3].fY, 0,
+        kOctagonOuter[4].fX, kOctagonOuter[4].fY, 0, kOctagonOuter[5].fX, kOctagonOuter[5].fY, 0,
+        kOctagonOuter[6].fX, kOctagonOuter[6].fY, 0, kOctagonOuter[7].fX, kOctagonOuter[7].fY, 0,
+        kOctagonInner[0].fX, kOctagonInner[0].fY, 1, kOctagonInner[1].fX, kOctagonInner[1].fY, 1,
+        kOctagonInner[2].fX, kOctagonInner[2].fY, 1, kOctagonInner[3].fX, kOctagonInner[3].fY, 1,
+        kOctagonInner[4].fX, kOctagonInner[4].fY, 1, kOctagonInner[5].fX, kOctagonInner[5].fY, 1,
+        kOctagonInner[6].fX, kOctagonInner[6].fY, 1, kOctagonInner[7].fX, kOctagonInner[7].fY, 1,
+        // clang-format on
+};
+
+GR_DECLARE_STATIC_UNIQUE_KEY(gInstancedCircleVertexBufferKey);
+GR_DECLARE_STATIC_UNIQUE_KEY(gFillCircleIndexBufferKey);
+GR_DECLARE_STATIC_UNIQUE_KEY(gStrokeCircleIndexBufferKey);
+
 static const int kIndicesPerFillCircle = SK_ARRAY_COUNT(gFillCircleIndices);
 static const int kIndicesPerStrokeCircle = SK_ARRAY_COUNT(gStrokeCircleIndices);
 static const int kVertsPerStrokeCircle = 16;
@@ -1236,6 +1303,13 @@ private:
             return;
         }
 
+        // Full circles only differ by center, radii and color, so when we can we just write those
+        // per instance rather than transforming the whole octagon for each circle.
+        if (!fClipPlane && !fRoundCaps && target->caps().instanceAttribSupport()) {
+            this->prepareInstancedDraws(target, localMatrix);
+            return;
+        }
+
         // Setup geometry processor
         sk_sp<GrGeometryProcessor> gp(new CircleGeometryProcessor(
                 !fAllFill, fClipPlane, fClipPlaneIsect, fClipPlaneUnion, fRoundCaps, fWideColor,
@@ -1364,6 +1438,58 @@ private:
         target->recordDraw(std::move(gp), mesh);
     }
 
+    void prepareInstancedDraws(Target* target, const SkMatrix& localMatrix) {
+        sk_sp<GrGeometryProcessor> gp(new CircleGeometryProcessor(
+                !fAllFill, false, false, false, false, fWideColor, localMatrix, true));
+
+        GR_DEFINE_STATIC_UNIQUE_KEY(gInstancedCircleVertexBufferKey);
+        sk_sp<const GrBuffer> vertexBuffer = target->resourceProvider()->findOrMakeStaticBuffer(
+                GrGpuBufferType::kVertex, sizeof(gInstancedCircleVertices),
+                gInstancedCircleVertices, gInstancedCircleVertexBufferKey);
+
+        sk_sp<const GrBuffer> indexBuffer;
+        if (fAllFill) {
+            GR_DEFINE_STATIC_UNIQUE_KEY(gFillCircleIndexBufferKey);
+            indexBuffer = target->resourceProvider()->findOrMakeStaticBuffer(
+                    GrGpuBufferType::kIndex, sizeof(gFillCircleIndices), gFillCircleIndices,
+                    gFillCircleIndexBufferKey);
+        } else {
+            GR_DEFINE_STATIC_UNIQUE_KEY(gStrokeCircleIndexBufferKey);
+            indexBuffer = target->resourceProvider()->findOrMakeStaticBuffer(
+                    GrGpuBufferType::kIndex, sizeof(gStrokeCircleIndices), gStrokeCircleIndices,
+                    gStrokeCircleIndexBufferKey);
+        }
+        if (!vertexBuffer || !indexBuffer) {
+            SkDebugf("Could not allocate static circle geometry\n");
+            return;
+        }
+
+        sk_sp<const GrBuffer> instanceBuffer;
+        int firstInstance;
+        GrVertexWriter instances{target->makeVertexSpace(gp->instanceStride(), fCircles.count(),
+                                                         &instanceBuffer, &firstInstance)};
+        if (!instances.fPtr) {
+            SkDebugf("Could not allocate instances\n");
+            return;
+        }
+
+        for (const auto& circle : fCircles) {
+            const SkRect& bounds = circle.fDevBounds;
+            // The inner radius in the instance data must be specified in normalized space.
+            instances.write(SkPoint::Make(bounds.centerX(), bounds.centerY()),
+                            GrVertexColor(circle.fColor, fWideColor),
+                            SkPoint::Make(circle.fOuterRadius,
+                                          circle.fInnerRadius / circle.fOuterRadius));
+        }
+
+        GrMesh* mesh = target->allocMesh(GrPrimitiveType::kTriangles);
+        mesh->setIndexedInstanced(std::move(indexBuffer), circle_type_to_index_count(!fAllFill),
+                                  std::move(instanceBuffer), fCircles.count(), firstInstance,
+                                  GrPrimitiveRestart::kNo);
+        mesh->setVertexData(std::move(vertexBuffer));
+        target->recordDraw(std::move(gp), mesh);
+    }
+
     void onExecute(GrOpFlushState* flushState, const SkRect& chainBounds) override {
         fHelper.executeDrawsAndUploads(this, flushState, chainBounds);
     }
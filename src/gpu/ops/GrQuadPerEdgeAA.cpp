@@ -7,6 +7,7 @@
 
 #include "GrQuadPerEdgeAA.h"
 #include "GrQuad.h"
+#include "GrShaderCaps.h"
 #include "GrVertexWriter.h"
 #include "glsl/GrGLSLColorSpaceXformHelper.h"
 #include "glsl/GrGLSLGeometryProcessor.h"
@@ -546,6 +547,50 @@ static Sk4f compute_degenerate_quad(GrQuadAAFlags aaFlags, const Sk4f& mask, con
     return coverage;
 }
 
+// Evaluates the bilinear interpolant of the corner values c, in tri strip order, at each (s, t).
+static AI Sk4f bilerp(const Sk4f& c, const Sk4f& s, const Sk4f& t) {
+    return c[0] + s * (c[2] - c[0]) + t * (c[1] - c[0]) + s * t * (c[3] - c[2] - c[1] + c[0]);
+}
+
+static AI void interpolate_vertices(const Vertices& quad, const Sk4f& s, const Sk4f& t,
+                                    Vertices* result) {
+    result->fX = bilerp(quad.fX, s, t);
+    result->fY = bilerp(quad.fY, s, t);
+    if (quad.fUVRCount > 0) {
+        result->fU = bilerp(quad.fU, s, t);
+        result->fV = bilerp(quad.fV, s, t);
+        if (quad.fUVRCount == 3) {
+            result->fR = bilerp(quad.fR, s, t);
+        }
+    }
+}
+
+// Fast path of compute_nested_quad_vertices for quads that are axis-aligned rects. Their AA edges
+// move by exactly .5px, so instead of normalizing edge vectors, the inner and outer corners are
+// found as fractions of the edge lengths and every attribute is interpolated there. Returns false,
+// leaving the quads untouched, if an edge is shorter than a pixel and needs the general path.
+static bool compute_nested_rect_vertices(GrQuadAAFlags aaFlags, Vertices* inner,
+                                         Vertices* outer) {
+    // The rect may be mirrored or rotated by 90 degrees, but one of dx and dy is always 0.
+    float lengthS = SkScalarAbs(inner->fX[2] - inner->fX[0]) +
+                    SkScalarAbs(inner->fY[2] - inner->fY[0]);
+    float lengthT = SkScalarAbs(inner->fX[1] - inner->fX[0]) +
+                    SkScalarAbs(inner->fY[1] - inner->fY[0]);
+    if (lengthS < 1.f || lengthT < 1.f) {
+        return false;
+    }
+
+    float l = (GrQuadAAFlags::kLeft & aaFlags) ? 0.5f / lengthS : 0.f;
+    float r = (GrQuadAAFlags::kRight & aaFlags) ? 0.5f / lengthS : 0.f;
+    float t = (GrQuadAAFlags::kTop & aaFlags) ? 0.5f / lengthT : 0.f;
+    float b = (GrQuadAAFlags::kBottom & aaFlags) ? 0.5f / lengthT : 0.f;
+
+    Vertices quad = *inner;
+    interpolate_vertices(quad, {-l, -l, 1.f + r, 1.f + r}, {-t, 1.f + b, -t, 1.f + b}, outer);
+    interpolate_vertices(quad, {l, l, 1.f - r, 1.f - r}, {t, 1.f - b, t, 1.f - b}, inner);
+    return true;
+}
+
 // Computes the vertices for the two nested quads used to create AA edges. The original single quad
 // should be duplicated as input in 'inner' and 'outer', and the resulting quad frame will be
 // stored in-place on return. Returns per-vertex coverage for the inner vertices.
@@ -622,10 +667,10 @@ static CoverageMode get_mode_for_spec(const GrQuadPerEdgeAA::VertexSpec& spec) {
 }
 
 // Writes four vertices in triangle strip order, including the additional data for local
-// coordinates, domain, color, and coverage as needed to satisfy the vertex spec.
+// coordinates, domain, texture index, color, and coverage as needed to satisfy the vertex spec.
 static void write_quad(GrVertexWriter* vb, const GrQuadPerEdgeAA::VertexSpec& spec,
                        CoverageMode mode, Sk4f coverage, SkPMColor4f color4f, const SkRect& domain,
-                       const Vertices& quad) {
+                       float textureIndex, const Vertices& quad) {
     static constexpr auto If = GrVertexWriter::If<float>;
 
     for (int i = 0; i < 4; ++i) {
@@ -652,6 +697,11 @@ static void write_quad(GrVertexWriter* vb, const GrQuadPerEdgeAA::VertexSpec& sp
         if (spec.hasDomain()) {
             vb->write(domain);
         }
+
+        // save the texture index
+        if (spec.hasTextureIndex()) {
+            vb->write(textureIndex);
+        }
     }
 }
 
@@ -697,8 +747,10 @@ ColorType MinColorType(SkPMColor4f color) {
 
 void* Tessellate(void* vertices, const VertexSpec& spec, const GrPerspQuad& deviceQuad,
                  const SkPMColor4f& color4f, const GrPerspQuad& localQuad, const SkRect& domain,
-                 GrQuadAAFlags aaFlags) {
+                 GrQuadAAFlags aaFlags, int textureIndex) {
     CoverageMode mode = get_mode_for_spec(spec);
+    SkASSERT(spec.hasTextureIndex() || textureIndex == 0);
+    float index = static_cast<float>(textureIndex);
 
     // Load position data into Sk4fs (always x, y, and load w to avoid branching down the road)
     Vertices outer;
@@ -731,21 +783,21 @@ void* Tessellate(void* vertices, const VertexSpec& spec, const GrPerspQuad& devi
         } else if (aaFlags != GrQuadAAFlags::kNone) {
             // In 2D, the simpler corner math does not cause issues with seaming against non-AA
             // inner quads.
-            maxCoverage = compute_nested_quad_vertices(
-                    aaFlags, spec.deviceQuadType() <= GrQuadType::kRectilinear, &inner, &outer);
+            if (spec.deviceQuadType() != GrQuadType::kRect ||
+                !compute_nested_rect_vertices(aaFlags, &inner, &outer)) {
+                maxCoverage = compute_nested_quad_vertices(
+                        aaFlags, spec.deviceQuadType() <= GrQuadType::kRectilinear, &inner,
+                        &outer);
+            }
         }
-        // NOTE: could provide an even more optimized tessellation function for axis-aligned
-        // rects since the positions can be outset by constants without doing vector math,
-        // except it must handle identifying the winding of the quad vertices if the transform
-        // applied a mirror, etc. The current 2D case is already adequately fast.
 
         // Write two quads for inner and outer, inner will use the
-        write_quad(&vb, spec, mode, maxCoverage, color4f, domain, inner);
-        write_quad(&vb, spec, mode, 0.f, color4f, domain, outer);
+        write_quad(&vb, spec, mode, maxCoverage, color4f, domain, index, inner);
+        write_quad(&vb, spec, mode, 0.f, color4f, domain, index, outer);
     } else {
         // No outsetting needed, just write a single quad with full coverage
         SkASSERT(mode == CoverageMode::kNone);
-        write_quad(&vb, spec, mode, 1.f, color4f, domain, outer);
+        write_quad(&vb, spec, mode, 1.f, color4f, domain, index, outer);
     }
 
     return vb.fPtr;
@@ -806,10 +858,11 @@ public:
                                            GrTextureType textureType, GrPixelConfig textureConfig,
                                            const GrSamplerState& samplerState,
                                            uint32_t extraSamplerKey,
-                                           sk_sp<GrColorSpaceXform> textureColorSpaceXform) {
+                                           sk_sp<GrColorSpaceXform> textureColorSpaceXform,
+                                           int numTextures) {
         return sk_sp<QuadPerEdgeAAGeometryProcessor>(new QuadPerEdgeAAGeometryProcessor(
                 vertexSpec, caps, textureType, textureConfig, samplerState, extraSamplerKey,
-                std::move(textureColorSpaceXform)));
+                std::move(textureColorSpaceXform), numTextures));
     }
 
     const char* name() const override { return "QuadPerEdgeAAGeometryProcessor"; }
@@ -817,7 +870,7 @@ public:
     void getGLSLProcessorKey(const GrShaderCaps&, GrProcessorKeyBuilder* b) const override {
         // domain, texturing, device-dimensions are single bit flags
         uint32_t x = fDomain.isInitialized() ? 0 : 1;
-        x |= fSampler.isInitialized() ? 0 : 2;
+        x |= fNumTextures ? 0 : 2;
         x |= fNeedsPerspective ? 0 : 4;
         // local coords require 2 bits (3 choices), 00 for none, 01 for 2d, 10 for 3d
         if (fLocalCoord.isInitialized()) {
@@ -831,6 +884,9 @@ public:
         if (fCoverageMode != CoverageMode::kNone) {
             x |= CoverageMode::kWithPosition == fCoverageMode ? 128 : 256;
         }
+        // the texture count takes the next 4 bits
+        GR_STATIC_ASSERT(kMaxTextures < 16);
+        x |= fNumTextures << 9;
 
         b->add32(GrColorSpaceXform::XformKey(fTextureColorSpaceXform.get()));
         b->add32(x);
@@ -902,7 +958,7 @@ public:
 
                 // If there is a texture, must also handle texture coordinates and reading from
                 // the texture in the fragment shader before continuing to fragment processors.
-                if (gp.fSampler.isInitialized()) {
+                if (gp.fNumTextures) {
                     // Texture coordinates clamped by the domain on the fragment shader; if the GP
                     // has a texture, it's guaranteed to have local coordinates
                     args.fFragBuilder->codeAppend("float2 texCoord;");
@@ -927,12 +983,32 @@ public:
                                 "texCoord = clamp(texCoord, domain.xy, domain.zw);");
                     }
 
+                    // Pick the texture with the index, which is the same across each quad. It is
+                    // passed as a float since integer varyings are not available everywhere.
+                    if (gp.fTextureIndex.isInitialized()) {
+                        args.fFragBuilder->codeAppend("float textureIndex;");
+                        args.fVaryingHandler->addPassThroughAttribute(gp.fTextureIndex,
+                                                                      "textureIndex",
+                                                                      Interpolation::kCanBeFlat);
+                    }
+
                     // Now modulate the starting output color by the texture lookup
-                    args.fFragBuilder->codeAppendf("%s = ", args.fOutputColor);
-                    args.fFragBuilder->appendTextureLookupAndModulate(
-                        args.fOutputColor, args.fTexSamplers[0], "texCoord", kFloat2_GrSLType,
-                        &fTextureColorSpaceXformHelper);
-                    args.fFragBuilder->codeAppend(";");
+                    for (int i = 0; i < gp.fNumTextures; ++i) {
+                        if (i < gp.fNumTextures - 1) {
+                            args.fFragBuilder->codeAppendf("%sif (textureIndex < %d.5) {",
+                                                           i ? "else " : "", i);
+                        } else if (i) {
+                            args.fFragBuilder->codeAppend("else {");
+                        }
+                        args.fFragBuilder->codeAppendf("%s = ", args.fOutputColor);
+                        args.fFragBuilder->appendTextureLookupAndModulate(
+                            args.fOutputColor, args.fTexSamplers[i], "texCoord", kFloat2_GrSLType,
+                            &fTextureColorSpaceXformHelper);
+                        args.fFragBuilder->codeAppend(";");
+                        if (gp.fNumTextures > 1) {
+                            args.fFragBuilder->codeAppend("}");
+                        }
+                    }
                 }
 
                 // And lastly, output the coverage calculation code
@@ -963,8 +1039,9 @@ public:
 private:
     QuadPerEdgeAAGeometryProcessor(const VertexSpec& spec)
             : INHERITED(kQuadPerEdgeAAGeometryProcessor_ClassID)
-            , fTextureColorSpaceXform(nullptr) {
-        SkASSERT(!spec.hasDomain());
+            , fTextureColorSpaceXform(nullptr)
+            , fNumTextures(0) {
+        SkASSERT(!spec.hasDomain() && !spec.hasTextureIndex());
         this->initializeAttrs(spec);
         this->setTextureSamplerCnt(0);
     }
@@ -973,13 +1050,20 @@ private:
                                    GrTextureType textureType, GrPixelConfig textureConfig,
                                    const GrSamplerState& samplerState,
                                    uint32_t extraSamplerKey,
-                                   sk_sp<GrColorSpaceXform> textureColorSpaceXform)
+                                   sk_sp<GrColorSpaceXform> textureColorSpaceXform,
+                                   int numTextures)
             : INHERITED(kQuadPerEdgeAAGeometryProcessor_ClassID)
             , fTextureColorSpaceXform(std::move(textureColorSpaceXform))
-            , fSampler(textureType, textureConfig, samplerState, extraSamplerKey) {
+            , fNumTextures(numTextures) {
         SkASSERT(spec.hasLocalCoords());
+        SkASSERT(numTextures >= 1 && numTextures <= kMaxTextures);
+        SkASSERT(numTextures == 1 || spec.hasTextureIndex());
+        SkASSERT(numTextures <= caps.maxFragmentSamplers());
+        for (int i = 0; i < numTextures; ++i) {
+            fSamplers[i].reset(textureType, textureConfig, samplerState, extraSamplerKey);
+        }
         this->initializeAttrs(spec);
-        this->setTextureSamplerCnt(1);
+        this->setTextureSamplerCnt(numTextures);
     }
 
     void initializeAttrs(const VertexSpec& spec) {
@@ -1017,25 +1101,30 @@ private:
             fDomain = {"domain", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
         }
 
-        this->setVertexAttributes(&fPosition, 4);
+        if (spec.hasTextureIndex()) {
+            fTextureIndex = {"textureIndex", kFloat_GrVertexAttribType, kFloat_GrSLType};
+        }
+
+        this->setVertexAttributes(&fPosition, 5);
     }
 
-    const TextureSampler& onTextureSampler(int) const override { return fSampler; }
+    const TextureSampler& onTextureSampler(int i) const override { return fSamplers[i]; }
 
     Attribute fPosition; // May contain coverage as last channel
     Attribute fColor; // May have coverage modulated in if the FPs support it
     Attribute fLocalCoord;
     Attribute fDomain;
+    Attribute fTextureIndex; // Selects one of fSamplers when there is more than one
 
     // The positions attribute may have coverage built into it, so float3 is an ambiguous type
     // and may mean 2d with coverage, or 3d with no coverage
     bool fNeedsPerspective;
     CoverageMode fCoverageMode;
 
-    // Color space will be null and fSampler.isInitialized() returns false when the GP is configured
-    // to skip texturing.
+    // Color space will be null and fNumTextures is 0 when the GP is configured to skip texturing.
     sk_sp<GrColorSpaceXform> fTextureColorSpaceXform;
-    TextureSampler fSampler;
+    TextureSampler fSamplers[kMaxTextures];
+    int fNumTextures;
 
     typedef GrGeometryProcessor INHERITED;
 };
@@ -1047,10 +1136,10 @@ sk_sp<GrGeometryProcessor> MakeProcessor(const VertexSpec& spec) {
 sk_sp<GrGeometryProcessor> MakeTexturedProcessor(const VertexSpec& spec, const GrShaderCaps& caps,
         GrTextureType textureType, GrPixelConfig textureConfig,
         const GrSamplerState& samplerState, uint32_t extraSamplerKey,
-        sk_sp<GrColorSpaceXform> textureColorSpaceXform) {
+        sk_sp<GrColorSpaceXform> textureColorSpaceXform, int numTextures) {
     return QuadPerEdgeAAGeometryProcessor::Make(spec, caps, textureType, textureConfig,
                                                 samplerState, extraSamplerKey,
-                                                std::move(textureColorSpaceXform));
+                                                std::move(textureColorSpaceXform), numTextures);
 }
 
 } // namespace GrQuadPerEdgeAA
@@ -10,6 +10,7 @@
 
 #include "GrBuffer.h"
 #include "GrCaps.h"
+#include "GrContextPriv.h"
 #include "GrDistanceFieldGenFromVector.h"
 #include "GrDrawOpTest.h"
 #include "GrQuad.h"
@@ -17,13 +18,15 @@
 #include "GrResourceProvider.h"
 #include "GrSimpleMeshDrawOpHelper.h"
 #include "GrVertexWriter.h"
-#include "SkAutoMalloc.h"
 #include "SkAutoPixmapStorage.h"
 #include "SkDistanceFieldGen.h"
 #include "SkDraw.h"
 #include "SkPaint.h"
 #include "SkPointPriv.h"
 #include "SkRasterClip.h"
+#include "SkSemaphore.h"
+#include "SkTaskGroup.h"
+#include "SkTraceEvent.h"
 #include "effects/GrBitmapTextGeoProc.h"
 #include "effects/GrDistanceFieldGeoProc.h"
 #include "ops/GrMeshDrawOp.h"
@@ -220,6 +223,267 @@ GrPathRenderer::CanDrawPath GrSmallPathRenderer::onCanDrawPath(const CanDrawPath
 // padding around path bounds to allow for antialiased pixels
 static const SkScalar kAntiAliasPad = 1.0f;
 
+// Returns the dimension of the distance field to generate for shape when drawn with viewMatrix,
+// and sets scale to the scale from shape space to distance field space.
+static SkScalar distance_field_dimension(const GrShape& shape, const SkMatrix& viewMatrix,
+                                         SkScalar* scale) {
+    // get mip level
+    SkScalar maxScale;
+    const SkRect& bounds = shape.bounds();
+    if (viewMatrix.hasPerspective()) {
+        // approximate the scale since we can't get it from the matrix
+        SkRect xformedBounds;
+        viewMatrix.mapRect(&xformedBounds, bounds);
+        maxScale = SkScalarAbs(SkTMax(xformedBounds.width() / bounds.width(),
+                                      xformedBounds.height() / bounds.height()));
+    } else {
+        maxScale = SkScalarAbs(viewMatrix.getMaxScale());
+    }
+    SkScalar maxDim = SkMaxScalar(bounds.width(), bounds.height());
+    // We try to create the DF at a 2^n scaled path resolution (1/2, 1, 2, 4, etc.)
+    // In the majority of cases this will yield a crisper rendering.
+    SkScalar mipScale = 1.0f;
+    // Our mipscale is the maxScale clamped to the next highest power of 2
+    if (maxScale <= SK_ScalarHalf) {
+        SkScalar log = SkScalarFloorToScalar(SkScalarLog2(SkScalarInvert(maxScale)));
+        mipScale = SkScalarPow(2, -log);
+    } else if (maxScale > SK_Scalar1) {
+        SkScalar log = SkScalarCeilToScalar(SkScalarLog2(maxScale));
+        mipScale = SkScalarPow(2, log);
+    }
+    SkASSERT(maxScale <= mipScale);
+
+    SkScalar mipSize = mipScale*SkScalarAbs(maxDim);
+    // For sizes less than kIdealMinMIP we want to use as large a distance field as we can
+    // so we can preserve as much detail as possible. However, we can't scale down more
+    // than a 1/4 of the size without artifacts. So the idea is that we pick the mipsize
+    // just bigger than the ideal, and then scale down until we are no more than 4x the
+    // original mipsize.
+    if (mipSize < kIdealMinMIP) {
+        SkScalar newMipSize = mipSize;
+        do {
+            newMipSize *= 2;
+        } while (newMipSize < kIdealMinMIP);
+        while (newMipSize > 4 * mipSize) {
+            newMipSize *= 0.25f;
+        }
+        mipSize = newMipSize;
+    }
+    SkScalar desiredDimension = SkTMin(mipSize, kMaxMIP);
+    *scale = desiredDimension / maxDim;
+    return desiredDimension;
+}
+
+// A distance field or coverage mask of a shape, ready to be added to the atlas.
+struct ShapeImage {
+    SkAutoPixmapStorage fPixels;
+    // The area the image covers in shape space (or, for masks, in device space relative to the
+    // integer translate of the view matrix), not counting any distance field padding.
+    SkRect              fBounds;
+};
+
+static bool make_distance_field(const GrShape& shape, SkScalar scale, ShapeImage* image) {
+    const SkRect& bounds = shape.bounds();
+
+    // generate bounding rect for bitmap draw
+    SkRect scaledBounds = bounds;
+    // scale to mip level size
+    scaledBounds.fLeft *= scale;
+    scaledBounds.fTop *= scale;
+    scaledBounds.fRight *= scale;
+    scaledBounds.fBottom *= scale;
+    // subtract out integer portion of origin
+    // (SDF created will be placed with fractional offset burnt in)
+    SkScalar dx = SkScalarFloorToScalar(scaledBounds.fLeft);
+    SkScalar dy = SkScalarFloorToScalar(scaledBounds.fTop);
+    scaledBounds.offset(-dx, -dy);
+    // get integer boundary
+    SkIRect devPathBounds;
+    scaledBounds.roundOut(&devPathBounds);
+    // pad to allow room for antialiasing
+    const int intPad = SkScalarCeilToInt(kAntiAliasPad);
+    // place devBounds at origin
+    int width = devPathBounds.width() + 2*intPad;
+    int height = devPathBounds.height() + 2*intPad;
+    devPathBounds = SkIRect::MakeWH(width, height);
+    SkScalar translateX = intPad - dx;
+    SkScalar translateY = intPad - dy;
+
+    // draw path to bitmap
+    SkMatrix drawMatrix;
+    drawMatrix.setScale(scale, scale);
+    drawMatrix.postTranslate(translateX, translateY);
+
+    SkASSERT(devPathBounds.fLeft == 0);
+    SkASSERT(devPathBounds.fTop == 0);
+    SkASSERT(devPathBounds.width() > 0);
+    SkASSERT(devPathBounds.height() > 0);
+
+    // setup signed distance field storage
+    SkIRect dfBounds = devPathBounds.makeOutset(SK_DistanceFieldPad, SK_DistanceFieldPad);
+    width = dfBounds.width();
+    height = dfBounds.height();
+    if (!image->fPixels.tryAlloc(SkImageInfo::MakeA8(width, height))) {
+        return false;
+    }
+    unsigned char* dfStorage = (unsigned char*)image->fPixels.writable_addr();
+
+    SkPath path;
+    shape.asPath(&path);
+#ifndef SK_USE_LEGACY_DISTANCE_FIELDS
+    // Generate signed distance field directly from SkPath
+    bool succeed = GrGenerateDistanceFieldFromPath(dfStorage,
+                                    path, drawMatrix,
+                                    width, height, image->fPixels.rowBytes());
+    if (!succeed) {
+#endif
+        // setup bitmap backing
+        SkAutoPixmapStorage dst;
+        if (!dst.tryAlloc(SkImageInfo::MakeA8(devPathBounds.width(),
+                                              devPathBounds.height()))) {
+            return false;
+        }
+        sk_bzero(dst.writable_addr(), dst.computeByteSize());
+
+        // rasterize path
+        SkPaint paint;
+        paint.setStyle(SkPaint::kFill_Style);
+        paint.setAntiAlias(true);
+
+        SkDraw draw;
+
+        SkRasterClip rasterClip;
+        rasterClip.setRect(devPathBounds);
+        draw.fRC = &rasterClip;
+        draw.fMatrix = &drawMatrix;
+        draw.fDst = dst;
+
+        draw.drawPathCoverage(path, paint);
+
+        // Generate signed distance field
+        SkGenerateDistanceFieldFromA8Image(dfStorage,
+                                           (const unsigned char*)dst.addr(),
+                                           dst.width(), dst.height(), dst.rowBytes());
+#ifndef SK_USE_LEGACY_DISTANCE_FIELDS
+    }
+#endif
+
+    image->fBounds = SkRect::Make(devPathBounds);
+    image->fBounds.offset(-translateX, -translateY);
+    image->fBounds.fLeft /= scale;
+    image->fBounds.fTop /= scale;
+    image->fBounds.fRight /= scale;
+    image->fBounds.fBottom /= scale;
+    return true;
+}
+
+static bool make_coverage_mask(const GrShape& shape, const SkMatrix& ctm, ShapeImage* image) {
+    const SkRect& bounds = shape.bounds();
+    if (bounds.isEmpty()) {
+        return false;
+    }
+    SkMatrix drawMatrix(ctm);
+    SkScalar tx = ctm.getTranslateX();
+    SkScalar ty = ctm.getTranslateY();
+    tx -= SkScalarFloorToScalar(tx);
+    ty -= SkScalarFloorToScalar(ty);
+    drawMatrix.set(SkMatrix::kMTransX, tx);
+    drawMatrix.set(SkMatrix::kMTransY, ty);
+    SkRect shapeDevBounds;
+    drawMatrix.mapRect(&shapeDevBounds, bounds);
+    SkScalar dx = SkScalarFloorToScalar(shapeDevBounds.fLeft);
+    SkScalar dy = SkScalarFloorToScalar(shapeDevBounds.fTop);
+
+    // get integer boundary
+    SkIRect devPathBounds;
+    shapeDevBounds.roundOut(&devPathBounds);
+    // pad to allow room for antialiasing
+    const int intPad = SkScalarCeilToInt(kAntiAliasPad);
+    // place devBounds at origin
+    int width = devPathBounds.width() + 2 * intPad;
+    int height = devPathBounds.height() + 2 * intPad;
+    devPathBounds = SkIRect::MakeWH(width, height);
+    SkScalar translateX = intPad - dx;
+    SkScalar translateY = intPad - dy;
+
+    SkASSERT(devPathBounds.fLeft == 0);
+    SkASSERT(devPathBounds.fTop == 0);
+    SkASSERT(devPathBounds.width() > 0);
+    SkASSERT(devPathBounds.height() > 0);
+
+    SkPath path;
+    shape.asPath(&path);
+    // setup bitmap backing
+    SkAutoPixmapStorage& dst = image->fPixels;
+    if (!dst.tryAlloc(SkImageInfo::MakeA8(devPathBounds.width(),
+                                          devPathBounds.height()))) {
+        return false;
+    }
+    sk_bzero(dst.writable_addr(), dst.computeByteSize());
+
+    // rasterize path
+    SkPaint paint;
+    paint.setStyle(SkPaint::kFill_Style);
+    paint.setAntiAlias(true);
+
+    SkDraw draw;
+
+    SkRasterClip rasterClip;
+    rasterClip.setRect(devPathBounds);
+    draw.fRC = &rasterClip;
+    drawMatrix.postTranslate(translateX, translateY);
+    draw.fMatrix = &drawMatrix;
+    draw.fDst = dst;
+
+    draw.drawPathCoverage(path, paint);
+
+    image->fBounds = SkRect::Make(devPathBounds);
+    image->fBounds.offset(-translateX, -translateY);
+    return true;
+}
+
+/**
+ * A ShapeImage being generated on a worker thread while the op that needs it waits to be
+ * flushed. The op blocks in onPrepareDraws only if the image isn't ready by then.
+ */
+class PendingShapeImage : public SkNVRefCnt<PendingShapeImage> {
+public:
+    // The scale is only used for distance fields and the view matrix only for coverage masks.
+    PendingShapeImage(const GrShape& shape, const SkMatrix& viewMatrix, SkScalar scale,
+                      bool distanceField)
+            : fShape(shape)
+            , fViewMatrix(viewMatrix)
+            , fScale(scale)
+            , fDistanceField(distanceField) {}
+
+    // Called on the worker thread.
+    void generate() {
+        TRACE_EVENT0("skia", "Threaded small path image");
+        fSucceeded = fDistanceField ? make_distance_field(fShape, fScale, &fImage)
+                                    : make_coverage_mask(fShape, fViewMatrix, &fImage);
+        fReady.signal();
+    }
+
+    // Waits for generate() to finish and returns the image, or nullptr if it couldn't be made.
+    const ShapeImage* wait() {
+        if (!fWaited) {
+            fReady.wait();
+            fWaited = true;
+        }
+        return fSucceeded ? &fImage : nullptr;
+    }
+
+private:
+    GrShape     fShape;
+    SkMatrix    fViewMatrix;
+    SkScalar    fScale;
+    bool        fDistanceField;
+    ShapeImage  fImage;
+    bool        fSucceeded = false;
+    bool        fWaited = false;
+    SkSemaphore fReady;
+};
+
 class GrSmallPathRenderer::SmallPathOp final : public GrMeshDrawOp {
 private:
     using Helper = GrSimpleMeshDrawOpHelperWithStencil;
@@ -238,16 +502,17 @@ public:
                                           ShapeCache* shapeCache,
                                           ShapeDataList* shapeList,
                                           bool gammaCorrect,
-                                          const GrUserStencilSettings* stencilSettings) {
+                                          const GrUserStencilSettings* stencilSettings,
+                                          SkTaskGroup* taskGroup = nullptr) {
         return Helper::FactoryHelper<SmallPathOp>(context, std::move(paint), shape, viewMatrix,
                                                   atlas, shapeCache, shapeList, gammaCorrect,
-                                                  stencilSettings);
+                                                  stencilSettings, taskGroup);
     }
 
     SmallPathOp(Helper::MakeArgs helperArgs, const SkPMColor4f& color, const GrShape& shape,
                 const SkMatrix& viewMatrix, GrDrawOpAtlas* atlas, ShapeCache* shapeCache,
                 ShapeDataList* shapeList, bool gammaCorrect,
-                const GrUserStencilSettings* stencilSettings)
+                const GrUserStencilSettings* stencilSettings, SkTaskGroup* taskGroup)
             : INHERITED(ClassID()), fHelper(helperArgs, GrAAType::kCoverage, stencilSettings) {
         SkASSERT(shape.hasUnstyledKey());
         // Compute bounds
@@ -262,7 +527,7 @@ public:
         // always use distance fields if in perspective
         fUsesDistanceField = fUsesDistanceField || viewMatrix.hasPerspective();
 
-        fShapes.emplace_back(Entry{color, shape, viewMatrix});
+        fShapes.emplace_back(Entry{color, shape, viewMatrix, nullptr});
 
         fAtlas = atlas;
         fShapeCache = shapeCache;
@@ -270,6 +535,9 @@ public:
         fGammaCorrect = gammaCorrect;
         fWideColor = !SkPMColor4fFitsInBytes(color);
 
+        if (taskGroup) {
+            this->generateImageAsync(taskGroup);
+        }
     }
 
     const char* name() const override { return "SmallPathOp"; }
@@ -315,11 +583,20 @@ private:
         int fInstancesToFlush;
     };
 
+    struct Entry {
+        SkPMColor4f fColor;
+        GrShape     fShape;
+        SkMatrix    fViewMatrix;
+        // Set when the shape's image is being generated on a worker thread.
+        sk_sp<PendingShapeImage> fPendingImage;
+    };
+
     void onPrepareDraws(Target* target) override {
         int instanceCount = fShapes.count();
 
         static constexpr int kMaxTextures = GrDistanceFieldPathGeoProc::kMaxTextures;
         GR_STATIC_ASSERT(GrBitmapTextGeoProc::kMaxTextures == kMaxTextures);
+        GR_STATIC_ASSERT(GrDrawOpAtlas::kMaxPages <= kMaxTextures);
 
         FlushInfo flushInfo;
         flushInfo.fFixedDynamicState = target->makeFixedDynamicState(kMaxTextures);
@@ -389,98 +666,29 @@ private:
         for (int i = 0; i < instanceCount; i++) {
             const Entry& args = fShapes[i];
 
-            ShapeData* shapeData;
-            if (fUsesDistanceField) {
-                // get mip level
-                SkScalar maxScale;
-                const SkRect& bounds = args.fShape.bounds();
-                if (args.fViewMatrix.hasPerspective()) {
-                    // approximate the scale since we can't get it from the matrix
-                    SkRect xformedBounds;
-                    args.fViewMatrix.mapRect(&xformedBounds, bounds);
-                    maxScale = SkScalarAbs(SkTMax(xformedBounds.width() / bounds.width(),
-                                                  xformedBounds.height() / bounds.height()));
-                } else {
-                    maxScale = SkScalarAbs(args.fViewMatrix.getMaxScale());
+            // check to see if the df or bitmap path is cached
+            SkScalar scale = SK_Scalar1;
+            ShapeDataKey key;
+            this->makeKey(args, &key, &scale);
+            ShapeData* shapeData = fShapeCache->find(key);
+            if (nullptr == shapeData || !fAtlas->hasID(shapeData->fID)) {
+                // Remove the stale cache entry
+                if (shapeData) {
+                    fShapeCache->remove(shapeData->fKey);
+                    fShapeList->remove(shapeData);
+                    delete shapeData;
                 }
-                SkScalar maxDim = SkMaxScalar(bounds.width(), bounds.height());
-                // We try to create the DF at a 2^n scaled path resolution (1/2, 1, 2, 4, etc.)
-                // In the majority of cases this will yield a crisper rendering.
-                SkScalar mipScale = 1.0f;
-                // Our mipscale is the maxScale clamped to the next highest power of 2
-                if (maxScale <= SK_ScalarHalf) {
-                    SkScalar log = SkScalarFloorToScalar(SkScalarLog2(SkScalarInvert(maxScale)));
-                    mipScale = SkScalarPow(2, -log);
-                } else if (maxScale > SK_Scalar1) {
-                    SkScalar log = SkScalarCeilToScalar(SkScalarLog2(maxScale));
-                    mipScale = SkScalarPow(2, log);
-                }
-                SkASSERT(maxScale <= mipScale);
-
-                SkScalar mipSize = mipScale*SkScalarAbs(maxDim);
-                // For sizes less than kIdealMinMIP we want to use as large a distance field as we can
-                // so we can preserve as much detail as possible. However, we can't scale down more
-                // than a 1/4 of the size without artifacts. So the idea is that we pick the mipsize
-                // just bigger than the ideal, and then scale down until we are no more than 4x the
-                // original mipsize.
-                if (mipSize < kIdealMinMIP) {
-                    SkScalar newMipSize = mipSize;
-                    do {
-                        newMipSize *= 2;
-                    } while (newMipSize < kIdealMinMIP);
-                    while (newMipSize > 4 * mipSize) {
-                        newMipSize *= 0.25f;
-                    }
-                    mipSize = newMipSize;
+
+                ShapeImage storage;
+                const ShapeImage* image = this->findOrMakeImage(args, scale, &storage);
+                if (!image) {
+                    continue;
                 }
-                SkScalar desiredDimension = SkTMin(mipSize, kMaxMIP);
-
-                // check to see if df path is cached
-                ShapeDataKey key(args.fShape, SkScalarCeilToInt(desiredDimension));
-                shapeData = fShapeCache->find(key);
-                if (nullptr == shapeData || !fAtlas->hasID(shapeData->fID)) {
-                    // Remove the stale cache entry
-                    if (shapeData) {
-                        fShapeCache->remove(shapeData->fKey);
-                        fShapeList->remove(shapeData);
-                        delete shapeData;
-                    }
-                    SkScalar scale = desiredDimension / maxDim;
-
-                    shapeData = new ShapeData;
-                    if (!this->addDFPathToAtlas(target,
-                                                &flushInfo,
-                                                fAtlas,
-                                                shapeData,
-                                                args.fShape,
-                                                SkScalarCeilToInt(desiredDimension),
-                                                scale)) {
-                        delete shapeData;
-                        continue;
-                    }
-                }
-            } else {
-                // check to see if bitmap path is cached
-                ShapeDataKey key(args.fShape, args.fViewMatrix);
-                shapeData = fShapeCache->find(key);
-                if (nullptr == shapeData || !fAtlas->hasID(shapeData->fID)) {
-                    // Remove the stale cache entry
-                    if (shapeData) {
-                        fShapeCache->remove(shapeData->fKey);
-                        fShapeList->remove(shapeData);
-                        delete shapeData;
-                    }
-
-                    shapeData = new ShapeData;
-                    if (!this->addBMPathToAtlas(target,
-                                                &flushInfo,
-                                                fAtlas,
-                                                shapeData,
-                                                args.fShape,
-                                                args.fViewMatrix)) {
-                        delete shapeData;
-                        continue;
-                    }
+                shapeData = new ShapeData;
+                shapeData->fKey = key;
+                if (!this->addImageToAtlas(target, &flushInfo, shapeData, *image)) {
+                    delete shapeData;
+                    continue;
                 }
             }
 
@@ -518,219 +726,68 @@ private:
         return GrDrawOpAtlas::ErrorCode::kSucceeded == code;
     }
 
-    bool addDFPathToAtlas(GrMeshDrawOp::Target* target, FlushInfo* flushInfo,
-                          GrDrawOpAtlas* atlas, ShapeData* shapeData, const GrShape& shape,
-                          uint32_t dimension, SkScalar scale) const {
-
-        const SkRect& bounds = shape.bounds();
-
-        // generate bounding rect for bitmap draw
-        SkRect scaledBounds = bounds;
-        // scale to mip level size
-        scaledBounds.fLeft *= scale;
-        scaledBounds.fTop *= scale;
-        scaledBounds.fRight *= scale;
-        scaledBounds.fBottom *= scale;
-        // subtract out integer portion of origin
-        // (SDF created will be placed with fractional offset burnt in)
-        SkScalar dx = SkScalarFloorToScalar(scaledBounds.fLeft);
-        SkScalar dy = SkScalarFloorToScalar(scaledBounds.fTop);
-        scaledBounds.offset(-dx, -dy);
-        // get integer boundary
-        SkIRect devPathBounds;
-        scaledBounds.roundOut(&devPathBounds);
-        // pad to allow room for antialiasing
-        const int intPad = SkScalarCeilToInt(kAntiAliasPad);
-        // place devBounds at origin
-        int width = devPathBounds.width() + 2*intPad;
-        int height = devPathBounds.height() + 2*intPad;
-        devPathBounds = SkIRect::MakeWH(width, height);
-        SkScalar translateX = intPad - dx;
-        SkScalar translateY = intPad - dy;
-
-        // draw path to bitmap
-        SkMatrix drawMatrix;
-        drawMatrix.setScale(scale, scale);
-        drawMatrix.postTranslate(translateX, translateY);
-
-        SkASSERT(devPathBounds.fLeft == 0);
-        SkASSERT(devPathBounds.fTop == 0);
-        SkASSERT(devPathBounds.width() > 0);
-        SkASSERT(devPathBounds.height() > 0);
-
-        // setup signed distance field storage
-        SkIRect dfBounds = devPathBounds.makeOutset(SK_DistanceFieldPad, SK_DistanceFieldPad);
-        width = dfBounds.width();
-        height = dfBounds.height();
-        // TODO We should really generate this directly into the plot somehow
-        SkAutoSMalloc<1024> dfStorage(width * height * sizeof(unsigned char));
-
-        SkPath path;
-        shape.asPath(&path);
-#ifndef SK_USE_LEGACY_DISTANCE_FIELDS
-        // Generate signed distance field directly from SkPath
-        bool succeed = GrGenerateDistanceFieldFromPath((unsigned char*)dfStorage.get(),
-                                        path, drawMatrix,
-                                        width, height, width * sizeof(unsigned char));
-        if (!succeed) {
-#endif
-            // setup bitmap backing
-            SkAutoPixmapStorage dst;
-            if (!dst.tryAlloc(SkImageInfo::MakeA8(devPathBounds.width(),
-                                                  devPathBounds.height()))) {
-                return false;
-            }
-            sk_bzero(dst.writable_addr(), dst.computeByteSize());
-
-            // rasterize path
-            SkPaint paint;
-            paint.setStyle(SkPaint::kFill_Style);
-            paint.setAntiAlias(true);
-
-            SkDraw draw;
-
-            SkRasterClip rasterClip;
-            rasterClip.setRect(devPathBounds);
-            draw.fRC = &rasterClip;
-            draw.fMatrix = &drawMatrix;
-            draw.fDst = dst;
-
-            draw.drawPathCoverage(path, paint);
-
-            // Generate signed distance field
-            SkGenerateDistanceFieldFromA8Image((unsigned char*)dfStorage.get(),
-                                               (const unsigned char*)dst.addr(),
-                                               dst.width(), dst.height(), dst.rowBytes());
-#ifndef SK_USE_LEGACY_DISTANCE_FIELDS
+    // Sets the cache key for the entry's shape and, for distance fields, the scale to generate
+    // the distance field at.
+    void makeKey(const Entry& args, ShapeDataKey* key, SkScalar* scale) const {
+        if (fUsesDistanceField) {
+            SkScalar dimension = distance_field_dimension(args.fShape, args.fViewMatrix, scale);
+            key->set(args.fShape, SkScalarCeilToInt(dimension));
+        } else {
+            key->set(args.fShape, args.fViewMatrix);
         }
-#endif
-
-        // add to atlas
-        SkIPoint16 atlasLocation;
-        GrDrawOpAtlas::AtlasID id;
+    }
 
-        if (!this->addToAtlas(target, flushInfo, atlas,
-                              width, height, dfStorage.get(), &id, &atlasLocation)) {
-            return false;
+    // Starts generating the image for the op's shape on taskGroup, unless it's already cached.
+    void generateImageAsync(SkTaskGroup* taskGroup) {
+        Entry& args = fShapes.front();
+        SkScalar scale = SK_Scalar1;
+        ShapeDataKey key;
+        this->makeKey(args, &key, &scale);
+        ShapeData* shapeData = fShapeCache->find(key);
+        if (shapeData && fAtlas->hasID(shapeData->fID)) {
+            return;
         }
-
-        // add to cache
-        shapeData->fKey.set(shape, dimension);
-        shapeData->fID = id;
-
-        shapeData->fBounds = SkRect::Make(devPathBounds);
-        shapeData->fBounds.offset(-translateX, -translateY);
-        shapeData->fBounds.fLeft /= scale;
-        shapeData->fBounds.fTop /= scale;
-        shapeData->fBounds.fRight /= scale;
-        shapeData->fBounds.fBottom /= scale;
-
-        // We pack the 2bit page index in the low bit of the u and v texture coords
-        uint16_t pageIndex = GrDrawOpAtlas::GetPageIndexFromID(id);
-        SkASSERT(pageIndex < 4);
-        uint16_t uBit = (pageIndex >> 1) & 0x1;
-        uint16_t vBit = pageIndex & 0x1;
-        shapeData->fTextureCoords.set((atlasLocation.fX+SK_DistanceFieldPad) << 1 | uBit,
-                                      (atlasLocation.fY+SK_DistanceFieldPad) << 1 | vBit,
-                                      (atlasLocation.fX+SK_DistanceFieldPad+
-                                       devPathBounds.width()) << 1 | uBit,
-                                      (atlasLocation.fY+SK_DistanceFieldPad+
-                                       devPathBounds.height()) << 1 | vBit);
-
-        fShapeCache->add(shapeData);
-        fShapeList->addToTail(shapeData);
-#ifdef DF_PATH_TRACKING
-        ++g_NumCachedPaths;
-#endif
-        return true;
+        sk_sp<PendingShapeImage> pending = sk_make_sp<PendingShapeImage>(
+                args.fShape, args.fViewMatrix, scale, fUsesDistanceField);
+        args.fPendingImage = pending;
+        taskGroup->add([pending] { pending->generate(); });
     }
 
-    bool addBMPathToAtlas(GrMeshDrawOp::Target* target, FlushInfo* flushInfo,
-                          GrDrawOpAtlas* atlas, ShapeData* shapeData, const GrShape& shape,
-                          const SkMatrix& ctm) const {
-        const SkRect& bounds = shape.bounds();
-        if (bounds.isEmpty()) {
-            return false;
-        }
-        SkMatrix drawMatrix(ctm);
-        SkScalar tx = ctm.getTranslateX();
-        SkScalar ty = ctm.getTranslateY();
-        tx -= SkScalarFloorToScalar(tx);
-        ty -= SkScalarFloorToScalar(ty);
-        drawMatrix.set(SkMatrix::kMTransX, tx);
-        drawMatrix.set(SkMatrix::kMTransY, ty);
-        SkRect shapeDevBounds;
-        drawMatrix.mapRect(&shapeDevBounds, bounds);
-        SkScalar dx = SkScalarFloorToScalar(shapeDevBounds.fLeft);
-        SkScalar dy = SkScalarFloorToScalar(shapeDevBounds.fTop);
-
-        // get integer boundary
-        SkIRect devPathBounds;
-        shapeDevBounds.roundOut(&devPathBounds);
-        // pad to allow room for antialiasing
-        const int intPad = SkScalarCeilToInt(kAntiAliasPad);
-        // place devBounds at origin
-        int width = devPathBounds.width() + 2 * intPad;
-        int height = devPathBounds.height() + 2 * intPad;
-        devPathBounds = SkIRect::MakeWH(width, height);
-        SkScalar translateX = intPad - dx;
-        SkScalar translateY = intPad - dy;
-
-        SkASSERT(devPathBounds.fLeft == 0);
-        SkASSERT(devPathBounds.fTop == 0);
-        SkASSERT(devPathBounds.width() > 0);
-        SkASSERT(devPathBounds.height() > 0);
-
-        SkPath path;
-        shape.asPath(&path);
-        // setup bitmap backing
-        SkAutoPixmapStorage dst;
-        if (!dst.tryAlloc(SkImageInfo::MakeA8(devPathBounds.width(),
-                                              devPathBounds.height()))) {
-            return false;
+    // Returns the image generated for the entry on a worker thread, or else generates it now.
+    const ShapeImage* findOrMakeImage(const Entry& args, SkScalar scale,
+                                      ShapeImage* storage) const {
+        if (args.fPendingImage) {
+            return args.fPendingImage->wait();
         }
-        sk_bzero(dst.writable_addr(), dst.computeByteSize());
-
-        // rasterize path
-        SkPaint paint;
-        paint.setStyle(SkPaint::kFill_Style);
-        paint.setAntiAlias(true);
-
-        SkDraw draw;
-
-        SkRasterClip rasterClip;
-        rasterClip.setRect(devPathBounds);
-        draw.fRC = &rasterClip;
-        drawMatrix.postTranslate(translateX, translateY);
-        draw.fMatrix = &drawMatrix;
-        draw.fDst = dst;
-
-        draw.drawPathCoverage(path, paint);
+        bool succeeded = fUsesDistanceField
+                ? make_distance_field(args.fShape, scale, storage)
+                : make_coverage_mask(args.fShape, args.fViewMatrix, storage);
+        return succeeded ? storage : nullptr;
+    }
 
-        // add to atlas
+    // Adds the image to the atlas and caches shapeData, whose key must already be set.
+    bool addImageToAtlas(GrMeshDrawOp::Target* target, FlushInfo* flushInfo,
+                         ShapeData* shapeData, const ShapeImage& image) const {
+        const SkPixmap& pixels = image.fPixels;
         SkIPoint16 atlasLocation;
         GrDrawOpAtlas::AtlasID id;
 
-        if (!this->addToAtlas(target, flushInfo, atlas,
-                              dst.width(), dst.height(), dst.addr(), &id, &atlasLocation)) {
+        if (!this->addToAtlas(target, flushInfo, fAtlas, pixels.width(), pixels.height(),
+                              pixels.addr(), &id, &atlasLocation)) {
             return false;
         }
 
-        // add to cache
-        shapeData->fKey.set(shape, ctm);
         shapeData->fID = id;
-
-        shapeData->fBounds = SkRect::Make(devPathBounds);
-        shapeData->fBounds.offset(-translateX, -translateY);
+        shapeData->fBounds = image.fBounds;
 
         // We pack the 2bit page index in the low bit of the u and v texture coords
         uint16_t pageIndex = GrDrawOpAtlas::GetPageIndexFromID(id);
-        SkASSERT(pageIndex < 4);
-        uint16_t uBit = (pageIndex >> 1) & 0x1;
-        uint16_t vBit = pageIndex & 0x1;
-        shapeData->fTextureCoords.set(atlasLocation.fX << 1 | uBit, atlasLocation.fY << 1 | vBit,
-                                      (atlasLocation.fX+width) << 1 | uBit,
-                                      (atlasLocation.fY+height) << 1 | vBit);
+        int pad = fUsesDistanceField ? SK_DistanceFieldPad : 0;
+        shapeData->fTextureCoords.set(
+                GrDrawOpAtlas::PackU(atlasLocation.fX + pad, pageIndex),
+                GrDrawOpAtlas::PackV(atlasLocation.fY + pad, pageIndex),
+                GrDrawOpAtlas::PackU(atlasLocation.fX + pixels.width() - pad, pageIndex),
+                GrDrawOpAtlas::PackV(atlasLocation.fY + pixels.height() - pad, pageIndex));
 
         fShapeCache->add(shapeData);
         fShapeList->addToTail(shapeData);
@@ -849,12 +906,6 @@ private:
 
     bool fUsesDistanceField;
 
-    struct Entry {
-        SkPMColor4f fColor;
-        GrShape     fShape;
-        SkMatrix    fViewMatrix;
-    };
-
     SkSTArray<1, Entry> fShapes;
     Helper fHelper;
     GrDrawOpAtlas* fAtlas;
@@ -890,9 +941,14 @@ bool GrSmallPathRenderer::onDrawPath(const DrawPathArgs& args) {
         }
     }
 
+    SkTaskGroup* taskGroup = nullptr;
+    if (auto direct = args.fContext->priv().asDirectContext()) {
+        taskGroup = direct->priv().getTaskGroup();
+    }
+
     std::unique_ptr<GrDrawOp> op = SmallPathOp::Make(
             args.fContext, std::move(args.fPaint), *args.fShape, *args.fViewMatrix, fAtlas.get(),
-            &fShapeCache, &fShapeList, args.fGammaCorrect, args.fUserStencilSettings);
+            &fShapeCache, &fShapeList, args.fGammaCorrect, args.fUserStencilSettings, taskGroup);
     args.fRenderTargetContext->addDrawOp(*args.fClip, std::move(op));
 
     return true;
@@ -10,6 +10,7 @@
 #include "GrAuditTrail.h"
 #include "GrCaps.h"
 #include "GrClip.h"
+#include "GrContextPriv.h"
 #include "GrDefaultGeoProcFactory.h"
 #include "GrDrawOpTest.h"
 #include "GrMesh.h"
@@ -21,13 +22,23 @@
 #include "GrSimpleMeshDrawOpHelper.h"
 #include "GrStyle.h"
 #include "GrTessellator.h"
+#include "SkAutoMalloc.h"
 #include "SkGeometry.h"
+#include "SkSemaphore.h"
+#include "SkTaskGroup.h"
 #include "ops/GrMeshDrawOp.h"
 
 #ifndef GR_AA_TESSELLATOR_MAX_VERB_COUNT
 #define GR_AA_TESSELLATOR_MAX_VERB_COUNT 10
 #endif
 
+// Antialiased tessellations are in device space, and their coverage ramp is one pixel wide
+// there. A cached one is reused under a new view matrix that only translates it, or scales it
+// uniformly by no more than this fraction.
+#ifndef GR_AA_TESSELLATOR_MAX_REUSE_SCALE_CHANGE
+#define GR_AA_TESSELLATOR_MAX_REUSE_SCALE_CHANGE 0.05f
+#endif
+
 /*
  * This path renderer tessellates the path into triangles using GrTessellator, uploads the
  * triangles to a vertex buffer, and renders them with a single draw call. It can do screenspace
@@ -38,6 +49,7 @@ namespace {
 struct TessInfo {
     SkScalar  fTolerance;
     int       fCount;
+    SkMatrix  fViewMatrix;  // AA only: the matrix that took the path to device space
 };
 
 // When the SkPathRef genID changes, invalidate a corresponding GrResource described by key.
@@ -68,6 +80,71 @@ bool cache_match(GrGpuBuffer* vertexBuffer, SkScalar tol, int* actualCount) {
     return false;
 }
 
+// Finds the matrix that takes AA vertices tessellated under the cached view matrix to where
+// viewMatrix would have put them, if it is close enough to identity to reuse them.
+bool aa_cache_match(GrGpuBuffer* vertexBuffer, const SkMatrix& viewMatrix, int* actualCount,
+                    SkMatrix* cachedInverse, SkMatrix* delta) {
+    if (!vertexBuffer) {
+        return false;
+    }
+    const SkData* data = vertexBuffer->getUniqueKey().getCustomData();
+    SkASSERT(data);
+    const TessInfo* info = static_cast<const TessInfo*>(data->data());
+    if (!info->fViewMatrix.invert(cachedInverse)) {
+        return false;
+    }
+    delta->setConcat(viewMatrix, *cachedInverse);
+    if (!delta->isScaleTranslate()) {
+        return false;
+    }
+    SkScalar sx = delta->getScaleX(), sy = delta->getScaleY();
+    if (!SkScalarNearlyEqual(sx, sy) ||
+        SkScalarAbs(sx - 1) > GR_AA_TESSELLATOR_MAX_REUSE_SCALE_CHANGE) {
+        return false;
+    }
+    *actualCount = info->fCount;
+    return true;
+}
+
+// Tessellates into CPU memory, for tessellations done off the flush thread.
+class CpuVertexAllocator : public GrTessellator::VertexAllocator {
+public:
+    CpuVertexAllocator(size_t stride) : VertexAllocator(stride) {}
+    void* lock(int vertexCount) override {
+        return fVertices.reset(vertexCount * stride());
+    }
+    void unlock(int actualCount) override {}
+    const void* vertices() const { return fVertices.get(); }
+
+private:
+    SkAutoMalloc fVertices;
+};
+
+// A tessellation started on the context's task group when the op was recorded.
+class PendingTessellation : public SkNVRefCnt<PendingTessellation> {
+public:
+    PendingTessellation(size_t stride) : fAllocator(stride) {}
+
+    void run(const SkPath& path, SkScalar tol, const SkRect& clipBounds, bool antialias) {
+        fCount = GrTessellator::PathToTriangles(path, tol, clipBounds, &fAllocator, antialias,
+                                                &fIsLinear);
+        fDone.signal();
+    }
+
+    // Blocks until run() has finished.
+    void wait() { fDone.wait(); }
+
+    int count() const { return fCount; }
+    bool isLinear() const { return fIsLinear; }
+    const void* vertices() const { return fAllocator.vertices(); }
+
+private:
+    CpuVertexAllocator fAllocator;
+    int                fCount = 0;
+    bool               fIsLinear = true;
+    SkSemaphore        fDone;
+};
+
 class StaticVertexAllocator : public GrTessellator::VertexAllocator {
 public:
     StaticVertexAllocator(size_t stride, GrResourceProvider* resourceProvider, bool canMapVB)
@@ -147,8 +224,8 @@ GrTessellatingPathRenderer::onCanDrawPath(const CanDrawPathArgs& args) const {
     // ones to simpler algorithms. We pass on paths that have styles, though they may come back
     // around after applying the styling information to the geometry to create a filled path. In
     // the non-AA case, We skip paths that don't have a key since the real advantage of this path
-    // renderer comes from caching the tessellated geometry. In the AA case, we do not cache, so we
-    // accept paths without keys.
+    // renderer comes from caching the tessellated geometry. In the AA case, paths with keys are
+    // cached in device space, but we also accept paths without keys.
     if (!args.fShape->style().isSimpleFill() || args.fShape->knownToBeConvex()) {
         return CanDrawPath::kNo;
     }
@@ -235,6 +312,27 @@ public:
         return fHelper.finalizeProcessors(caps, clip, fsaaType, clampType, coverage, &fColor);
     }
 
+    // If the vertices for this op aren't cached yet, tessellates them on taskGroup while the
+    // rest of the frame is recorded.
+    void tessellateAsync(SkTaskGroup* taskGroup, GrResourceProvider* resourceProvider) {
+        GrUniqueKey key;
+        if (!this->makeKey(&key) || resourceProvider->findByUniqueKey<GrGpuBuffer>(key)) {
+            return;
+        }
+        SkPath path;
+        SkScalar tol;
+        SkRect clipBounds;
+        if (!this->tessellationArgs(&path, &tol, &clipBounds)) {
+            return;
+        }
+        fPending = sk_make_sp<PendingTessellation>(this->vertexStride());
+        sk_sp<PendingTessellation> pending = fPending;
+        bool antialias = fAntiAlias;
+        taskGroup->add([pending, path, tol, clipBounds, antialias] {
+            pending->run(path, tol, clipBounds, antialias);
+        });
+    }
+
 private:
     SkPath getPath() const {
         SkASSERT(!fShape.style().applies());
@@ -243,72 +341,173 @@ private:
         return path;
     }
 
-    void draw(Target* target, sk_sp<const GrGeometryProcessor> gp, size_t vertexStride) {
-        SkASSERT(!fAntiAlias);
-        GrResourceProvider* rp = target->resourceProvider();
-        bool inverseFill = fShape.inverseFilled();
-        // construct a cache key from the path's genID and the view matrix
+    // Non-AA vertices are in the path's space and AA vertices are in device space.
+    size_t vertexStride() const {
+        return fAntiAlias ? sizeof(SkPoint) + sizeof(float) : sizeof(SkPoint);
+    }
+
+    // Gets GrTessellator's inputs for this op. Returns false if there is nothing to draw.
+    bool tessellationArgs(SkPath* path, SkScalar* tol, SkRect* clipBounds) const {
+        *path = this->getPath();
+        *tol = GrPathUtils::kDefaultTolerance;
+        *clipBounds = SkRect::Make(fDevClipBounds);
+        if (fAntiAlias) {
+            if (path->isEmpty()) {
+                return false;
+            }
+            path->transform(fViewMatrix);
+            return true;
+        }
+        *tol = GrPathUtils::scaleToleranceToSrc(*tol, fViewMatrix, fShape.bounds());
+        SkMatrix vmi;
+        if (!fViewMatrix.invert(&vmi)) {
+            return false;
+        }
+        vmi.mapRect(clipBounds);
+        return true;
+    }
+
+    // Builds the key the vertices are cached under, or returns false if they can't be cached.
+    // Inverse AA fills depend on the clip in device space, so only translation-free reuse would
+    // be possible; those aren't cached.
+    bool makeKey(GrUniqueKey* key) const {
+        if (fAntiAlias && (!fShape.hasUnstyledKey() || fShape.inverseFilled())) {
+            return false;
+        }
+        // construct a cache key from the shape, which includes the path's genID
         static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
-        GrUniqueKey key;
+        static const GrUniqueKey::Domain kAADomain = GrUniqueKey::GenerateDomain();
         static constexpr int kClipBoundsCnt = sizeof(fDevClipBounds) / sizeof(uint32_t);
         int shapeKeyDataCnt = fShape.unstyledKeySize();
         SkASSERT(shapeKeyDataCnt >= 0);
-        GrUniqueKey::Builder builder(&key, kDomain, shapeKeyDataCnt + kClipBoundsCnt, "Path");
+        GrUniqueKey::Builder builder(key, fAntiAlias ? kAADomain : kDomain,
+                                     shapeKeyDataCnt + kClipBoundsCnt, "Path");
         fShape.writeUnstyledKey(&builder[0]);
         // For inverse fills, the tessellation is dependent on clip bounds.
-        if (inverseFill) {
+        if (fShape.inverseFilled()) {
             memcpy(&builder[shapeKeyDataCnt], &fDevClipBounds, sizeof(fDevClipBounds));
         } else {
             memset(&builder[shapeKeyDataCnt], 0, sizeof(fDevClipBounds));
         }
         builder.finish();
+        return true;
+    }
+
+    // Makes the geometry processor for vertices that viewMatrix maps to device space, and
+    // localMatrix (if not null) maps to local coordinates.
+    sk_sp<GrGeometryProcessor> makeGP(const GrCaps& caps, const SkMatrix& viewMatrix,
+                                      const SkMatrix* localMatrix) {
+        using namespace GrDefaultGeoProcFactory;
+
+        Color color(fColor);
+        LocalCoords localCoords = fHelper.usesLocalCoords()
+                ? LocalCoords(LocalCoords::kUsePosition_Type, localMatrix)
+                : LocalCoords(LocalCoords::kUnused_Type);
+        Coverage::Type coverageType;
+        if (fAntiAlias) {
+            if (fHelper.compatibleWithAlphaAsCoverage()) {
+                coverageType = Coverage::kAttributeTweakAlpha_Type;
+            } else {
+                coverageType = Coverage::kAttribute_Type;
+            }
+        } else {
+            coverageType = Coverage::kSolid_Type;
+        }
+        sk_sp<GrGeometryProcessor> gp = GrDefaultGeoProcFactory::Make(
+                caps.shaderCaps(), color, coverageType, localCoords, viewMatrix);
+        SkASSERT(!gp || gp->vertexStride() == this->vertexStride());
+        return gp;
+    }
+
+    // Draws the cached vertices for this op, tessellating and caching them first on a miss.
+    void drawCached(Target* target, const GrUniqueKey& key) {
+        GrResourceProvider* rp = target->resourceProvider();
         sk_sp<GrGpuBuffer> cachedVertexBuffer(rp->findByUniqueKey<GrGpuBuffer>(key));
         int actualCount;
-        SkScalar tol = GrPathUtils::kDefaultTolerance;
-        tol = GrPathUtils::scaleToleranceToSrc(tol, fViewMatrix, fShape.bounds());
-        if (cache_match(cachedVertexBuffer.get(), tol, &actualCount)) {
-            this->drawVertices(target, std::move(gp), std::move(cachedVertexBuffer), 0,
-                               actualCount);
-            return;
+        SkMatrix inverseViewMatrix;
+        if (fAntiAlias) {
+            // The cached vertices keep the local coordinates they were tessellated with.
+            SkMatrix cachedInverse, delta;
+            if (aa_cache_match(cachedVertexBuffer.get(), fViewMatrix, &actualCount,
+                               &cachedInverse, &delta)) {
+                this->drawVertices(target, this->makeGP(target->caps(), delta, &cachedInverse),
+                                   std::move(cachedVertexBuffer), 0, actualCount);
+                return;
+            }
+            if (!fViewMatrix.invert(&inverseViewMatrix)) {
+                return;
+            }
+        } else {
+            SkScalar tol = GrPathUtils::scaleToleranceToSrc(GrPathUtils::kDefaultTolerance,
+                                                            fViewMatrix, fShape.bounds());
+            if (cache_match(cachedVertexBuffer.get(), tol, &actualCount)) {
+                this->drawVertices(target, this->makeGP(target->caps(), fViewMatrix, nullptr),
+                                   std::move(cachedVertexBuffer), 0, actualCount);
+                return;
+            }
         }
 
-        SkRect clipBounds = SkRect::Make(fDevClipBounds);
-
-        SkMatrix vmi;
-        if (!fViewMatrix.invert(&vmi)) {
+        SkPath path;
+        SkScalar tol;
+        SkRect clipBounds;
+        if (!this->tessellationArgs(&path, &tol, &clipBounds)) {
             return;
         }
-        vmi.mapRect(&clipBounds);
+        int count;
         bool isLinear;
-        bool canMapVB = GrCaps::kNone_MapFlags != target->caps().mapBufferFlags();
-        StaticVertexAllocator allocator(vertexStride, rp, canMapVB);
-        int count = GrTessellator::PathToTriangles(getPath(), tol, clipBounds, &allocator, false,
+        sk_sp<GrGpuBuffer> vb;
+        if (fPending) {
+            fPending->wait();
+            count = fPending->count();
+            isLinear = fPending->isLinear();
+            if (count > 0) {
+                vb = rp->createBuffer(count * this->vertexStride(), GrGpuBufferType::kVertex,
+                                      kStatic_GrAccessPattern, fPending->vertices());
+            }
+            fPending.reset();
+        } else {
+            bool canMapVB = GrCaps::kNone_MapFlags != target->caps().mapBufferFlags();
+            StaticVertexAllocator allocator(this->vertexStride(), rp, canMapVB);
+            count = GrTessellator::PathToTriangles(path, tol, clipBounds, &allocator, fAntiAlias,
                                                    &isLinear);
-        if (count == 0) {
+            vb = allocator.detachVertexBuffer();
+        }
+        if (count == 0 || !vb) {
             return;
         }
-        sk_sp<GrGpuBuffer> vb = allocator.detachVertexBuffer();
         TessInfo info;
         info.fTolerance = isLinear ? 0 : tol;
         info.fCount = count;
+        info.fViewMatrix = fViewMatrix;
+        GrUniqueKey mutableKey = key;
         fShape.addGenIDChangeListener(sk_make_sp<PathInvalidator>(key, target->contextUniqueID()));
-        key.setCustomData(SkData::MakeWithCopy(&info, sizeof(info)));
-        rp->assignUniqueKeyToResource(key, vb.get());
+        mutableKey.setCustomData(SkData::MakeWithCopy(&info, sizeof(info)));
+        rp->assignUniqueKeyToResource(mutableKey, vb.get());
 
+        sk_sp<GrGeometryProcessor> gp = fAntiAlias
+                ? this->makeGP(target->caps(), SkMatrix::I(), &inverseViewMatrix)
+                : this->makeGP(target->caps(), fViewMatrix, nullptr);
         this->drawVertices(target, std::move(gp), std::move(vb), 0, count);
     }
 
-    void drawAA(Target* target, sk_sp<const GrGeometryProcessor> gp, size_t vertexStride) {
+    // Tessellates AA paths that can't be cached straight into this flush's vertex space.
+    void drawAA(Target* target) {
         SkASSERT(fAntiAlias);
-        SkPath path = getPath();
-        if (path.isEmpty()) {
+        SkPath path;
+        SkScalar tol;
+        SkRect clipBounds;
+        SkMatrix inverseViewMatrix;
+        if (!this->tessellationArgs(&path, &tol, &clipBounds) ||
+            !fViewMatrix.invert(&inverseViewMatrix)) {
+            return;
+        }
+        sk_sp<GrGeometryProcessor> gp =
+                this->makeGP(target->caps(), SkMatrix::I(), &inverseViewMatrix);
+        if (!gp) {
             return;
         }
-        SkRect clipBounds = SkRect::Make(fDevClipBounds);
-        path.transform(fViewMatrix);
-        SkScalar tol = GrPathUtils::kDefaultTolerance;
         bool isLinear;
-        DynamicVertexAllocator allocator(vertexStride, target);
+        DynamicVertexAllocator allocator(this->vertexStride(), target);
         int count = GrTessellator::PathToTriangles(path, tol, clipBounds, &allocator, true,
                                                    &isLinear);
         if (count == 0) {
@@ -319,47 +518,19 @@ private:
     }
 
     void onPrepareDraws(Target* target) override {
-        sk_sp<GrGeometryProcessor> gp;
-        {
-            using namespace GrDefaultGeoProcFactory;
-
-            Color color(fColor);
-            LocalCoords::Type localCoordsType = fHelper.usesLocalCoords()
-                                                        ? LocalCoords::kUsePosition_Type
-                                                        : LocalCoords::kUnused_Type;
-            Coverage::Type coverageType;
-            if (fAntiAlias) {
-                if (fHelper.compatibleWithAlphaAsCoverage()) {
-                    coverageType = Coverage::kAttributeTweakAlpha_Type;
-                } else {
-                    coverageType = Coverage::kAttribute_Type;
-                }
-            } else {
-                coverageType = Coverage::kSolid_Type;
-            }
-            if (fAntiAlias) {
-                gp = GrDefaultGeoProcFactory::MakeForDeviceSpace(target->caps().shaderCaps(),
-                                                                 color, coverageType,
-                                                                 localCoordsType, fViewMatrix);
-            } else {
-                gp = GrDefaultGeoProcFactory::Make(target->caps().shaderCaps(),
-                                                   color, coverageType, localCoordsType,
-                                                   fViewMatrix);
-            }
-        }
-        if (!gp.get()) {
-            return;
-        }
-        size_t vertexStride = gp->vertexStride();
-        if (fAntiAlias) {
-            this->drawAA(target, std::move(gp), vertexStride);
+        GrUniqueKey key;
+        if (this->makeKey(&key)) {
+            this->drawCached(target, key);
         } else {
-            this->draw(target, std::move(gp), vertexStride);
+            this->drawAA(target);
         }
     }
 
     void drawVertices(Target* target, sk_sp<const GrGeometryProcessor> gp, sk_sp<const GrBuffer> vb,
                       int firstVertex, int count) {
+        if (!gp) {
+            return;
+        }
         GrMesh* mesh = target->allocMesh(TESSELLATOR_WIREFRAME ? GrPrimitiveType::kLines
                                                                : GrPrimitiveType::kTriangles);
         mesh->setNonIndexedNonInstanced(count);
@@ -377,6 +548,7 @@ private:
     SkMatrix                fViewMatrix;
     SkIRect                 fDevClipBounds;
     bool                    fAntiAlias;
+    sk_sp<PendingTessellation> fPending;
 
     typedef GrMeshDrawOp INHERITED;
 };
@@ -397,6 +569,13 @@ bool GrTessellatingPathRenderer::onDrawPath(const DrawPathArgs& args) {
                                                             clipBoundsI,
                                                             args.fAAType,
                                                             args.fUserStencilSettings);
+    // Start tessellating cache misses now, on the context's executor, instead of at flush.
+    if (auto direct = args.fContext->priv().asDirectContext()) {
+        if (SkTaskGroup* taskGroup = direct->priv().getTaskGroup()) {
+            static_cast<TessellatingPathOp*>(op.get())->tessellateAsync(
+                    taskGroup, direct->priv().resourceProvider());
+        }
+    }
     args.fRenderTargetContext->addDrawOp(*args.fClip, std::move(op));
     return true;
 }
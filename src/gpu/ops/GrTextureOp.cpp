@@ -377,7 +377,7 @@ private:
     }
 
     void tess(void* v, const VertexSpec& spec, const GrTextureProxy* proxy, int start,
-              int cnt) const {
+              int cnt, int textureIndex) const {
         TRACE_EVENT0("skia", TRACE_FUNC);
         auto origin = proxy->origin();
         const auto* texture = proxy->peekTexture();
@@ -401,7 +401,7 @@ private:
             SkRect domain =
                     compute_domain(info.domain(), this->filter(), origin, info.fSrcRect, iw, ih, h);
             v = GrQuadPerEdgeAA::Tessellate(v, spec, device, info.fColor, srcQuad, domain,
-                                            info.aaFlags());
+                                            info.aaFlags(), textureIndex);
         }
     }
 
@@ -445,8 +445,53 @@ private:
             }
         }
 
+        // When the backend can sample several textures in one draw, consecutive proxies of the
+        // chain are grouped into a mesh and each quad selects its texture with a vertex attribute.
+        // Mip mapped draws are left alone since the texture lookups would be in non-uniform
+        // control flow, where the implicit derivatives are undefined.
+        int maxTexturesPerMesh = 1;
+        if (numProxies > 1 && target->caps().imageMultitexturingSupport() &&
+            this->filter() != GrSamplerState::Filter::kMipMap) {
+            // Leave half the samplers for the clip and any other fragment processors.
+            int maxSamplers = target->caps().shaderCaps()->maxFragmentSamplers() / 2;
+            maxTexturesPerMesh = SkTMin(numProxies,
+                                        SkTMin(GrQuadPerEdgeAA::kMaxTextures, maxSamplers));
+            maxTexturesPerMesh = SkTMax(maxTexturesPerMesh, 1);
+        }
+
+        // Each mesh covers a run of the chain's proxies with at most maxTexturesPerMesh distinct
+        // textures; meshTextures holds maxTexturesPerMesh entries per mesh, padded with the first.
+        SkSTArray<8, int, true> meshQuadCnts;
+        SkSTArray<8, GrTextureProxy*, true> meshTextures;
+        int numMeshTextures = 0;
+        for (const auto& op : ChainRange<TextureOp>(this)) {
+            for (unsigned p = 0; p < op.fProxyCnt; ++p) {
+                auto* proxy = op.fProxies[p].fProxy;
+                int firstTexture = meshTextures.count() - numMeshTextures;
+                bool found = false;
+                for (int t = firstTexture; t < meshTextures.count() && !found; ++t) {
+                    found = meshTextures[t]->uniqueID() == proxy->uniqueID();
+                }
+                if (!found) {
+                    if (meshQuadCnts.empty() || numMeshTextures == maxTexturesPerMesh) {
+                        meshQuadCnts.push_back(0);
+                        numMeshTextures = 0;
+                    }
+                    meshTextures.push_back(proxy);
+                    ++numMeshTextures;
+                }
+                meshQuadCnts.back() += op.fProxies[p].fQuadCnt;
+            }
+        }
+        int numMeshes = meshQuadCnts.count();
+        int numTextures = numMeshes > 1 ? maxTexturesPerMesh : numMeshTextures;
+        for (; numMeshTextures < numTextures; ++numMeshTextures) {
+            meshTextures.push_back(meshTextures[meshTextures.count() - numMeshTextures]);
+        }
+        SkASSERT(meshTextures.count() == numMeshes * numTextures);
+
         VertexSpec vertexSpec(quadType, colorType, srcQuadType, /* hasLocal */ true, domain, aaType,
-                              /* alpha as coverage */ true);
+                              /* alpha as coverage */ true, /* texture index */ numTextures > 1);
 
         GrSamplerState samplerState = GrSamplerState(GrSamplerState::WrapMode::kClamp,
                                                      this->filter());
@@ -457,23 +502,28 @@ private:
         sk_sp<GrGeometryProcessor> gp = GrQuadPerEdgeAA::MakeTexturedProcessor(
                 vertexSpec, *target->caps().shaderCaps(),
                 textureType, config, samplerState, extraSamplerKey,
-                std::move(fTextureColorSpaceXform));
+                std::move(fTextureColorSpaceXform), numTextures);
 
-        // We'll use a dynamic state array for the GP textures when there are multiple ops.
-        // Otherwise, we use fixed dynamic state to specify the single op's proxy.
+        // We'll use a dynamic state array for the GP textures when there are multiple meshes.
+        // Otherwise, we use fixed dynamic state to specify the single mesh's proxies.
         GrPipeline::DynamicStateArrays* dynamicStateArrays = nullptr;
         GrPipeline::FixedDynamicState* fixedDynamicState;
-        if (numProxies > 1) {
-            dynamicStateArrays = target->allocDynamicStateArrays(numProxies, 1, false);
+        if (numMeshes > 1) {
+            dynamicStateArrays = target->allocDynamicStateArrays(numMeshes, numTextures, false);
             fixedDynamicState = target->makeFixedDynamicState(0);
+            for (int t = 0; t < meshTextures.count(); ++t) {
+                dynamicStateArrays->fPrimitiveProcessorTextures[t] = meshTextures[t];
+            }
         } else {
-            fixedDynamicState = target->makeFixedDynamicState(1);
-            fixedDynamicState->fPrimitiveProcessorTextures[0] = fProxies[0].fProxy;
+            fixedDynamicState = target->makeFixedDynamicState(numTextures);
+            for (int t = 0; t < numTextures; ++t) {
+                fixedDynamicState->fPrimitiveProcessorTextures[t] = meshTextures[t];
+            }
         }
 
         size_t vertexSize = gp->vertexStride();
 
-        GrMesh* meshes = target->allocMeshes(numProxies);
+        GrMesh* meshes = target->allocMeshes(numMeshes);
         sk_sp<const GrBuffer> vbuffer;
         int vertexOffsetInBuffer = 0;
         int numQuadVerticesLeft = numTotalQuads * vertexSpec.verticesPerQuad();
@@ -481,47 +531,63 @@ private:
         void* vdata = nullptr;
 
         int m = 0;
+        int meshQuadsLeft = 0;
         for (const auto& op : ChainRange<TextureOp>(this)) {
             int q = 0;
             for (unsigned p = 0; p < op.fProxyCnt; ++p) {
+                if (!meshQuadsLeft) {
+                    // Starting a new mesh, so make sure it has vertices to write to
+                    int meshVertexCnt = meshQuadCnts[m] * vertexSpec.verticesPerQuad();
+                    if (numAllocatedVertices < meshVertexCnt) {
+                        vdata = target->makeVertexSpaceAtLeast(
+                                vertexSize, meshVertexCnt, numQuadVerticesLeft, &vbuffer,
+                                &vertexOffsetInBuffer, &numAllocatedVertices);
+                        SkASSERT(numAllocatedVertices <= numQuadVerticesLeft);
+                        if (!vdata) {
+                            SkDebugf("Could not allocate vertices\n");
+                            return;
+                        }
+                    }
+                    SkASSERT(numAllocatedVertices >= meshVertexCnt);
+                    meshQuadsLeft = meshQuadCnts[m];
+                }
+
                 int quadCnt = op.fProxies[p].fQuadCnt;
                 auto* proxy = op.fProxies[p].fProxy;
                 int meshVertexCnt = quadCnt * vertexSpec.verticesPerQuad();
-                if (numAllocatedVertices < meshVertexCnt) {
-                    vdata = target->makeVertexSpaceAtLeast(
-                            vertexSize, meshVertexCnt, numQuadVerticesLeft, &vbuffer,
-                            &vertexOffsetInBuffer, &numAllocatedVertices);
-                    SkASSERT(numAllocatedVertices <= numQuadVerticesLeft);
-                    if (!vdata) {
-                        SkDebugf("Could not allocate vertices\n");
-                        return;
-                    }
+                int textureIndex = 0;
+                while (meshTextures[m * numTextures + textureIndex]->uniqueID() !=
+                       proxy->uniqueID()) {
+                    ++textureIndex;
+                    SkASSERT(textureIndex < numTextures);
                 }
-                SkASSERT(numAllocatedVertices >= meshVertexCnt);
 
-                op.tess(vdata, vertexSpec, proxy, q, quadCnt);
+                op.tess(vdata, vertexSpec, proxy, q, quadCnt, textureIndex);
 
-                if (!GrQuadPerEdgeAA::ConfigureMeshIndices(target, &(meshes[m]), vertexSpec,
-                                                           quadCnt)) {
-                    SkDebugf("Could not allocate indices");
-                    return;
-                }
-                meshes[m].setVertexData(vbuffer, vertexOffsetInBuffer);
-                if (dynamicStateArrays) {
-                    dynamicStateArrays->fPrimitiveProcessorTextures[m] = proxy;
-                }
-                ++m;
                 numAllocatedVertices -= meshVertexCnt;
                 numQuadVerticesLeft -= meshVertexCnt;
-                vertexOffsetInBuffer += meshVertexCnt;
                 vdata = reinterpret_cast<char*>(vdata) + vertexSize * meshVertexCnt;
                 q += quadCnt;
+
+                meshQuadsLeft -= quadCnt;
+                SkASSERT(meshQuadsLeft >= 0);
+                if (!meshQuadsLeft) {
+                    if (!GrQuadPerEdgeAA::ConfigureMeshIndices(target, &(meshes[m]), vertexSpec,
+                                                               meshQuadCnts[m])) {
+                        SkDebugf("Could not allocate indices");
+                        return;
+                    }
+                    meshes[m].setVertexData(vbuffer, vertexOffsetInBuffer);
+                    vertexOffsetInBuffer += meshQuadCnts[m] * vertexSpec.verticesPerQuad();
+                    ++m;
+                }
             }
         }
+        SkASSERT(m == numMeshes);
         SkASSERT(!numQuadVerticesLeft);
         SkASSERT(!numAllocatedVertices);
         target->recordDraw(
-                std::move(gp), meshes, numProxies, fixedDynamicState, dynamicStateArrays);
+                std::move(gp), meshes, numMeshes, fixedDynamicState, dynamicStateArrays);
     }
 
     void onExecute(GrOpFlushState* flushState, const SkRect& chainBounds) override {
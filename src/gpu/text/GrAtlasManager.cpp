@@ -12,8 +12,10 @@
 
 GrAtlasManager::GrAtlasManager(GrProxyProvider* proxyProvider, GrStrikeCache* glyphCache,
                                size_t maxTextureBytes,
-                               GrDrawOpAtlas::AllowMultitexturing allowMultitexturing)
+                               GrDrawOpAtlas::AllowMultitexturing allowMultitexturing,
+                               int maxPages)
             : fAllowMultitexturing{allowMultitexturing}
+            , fMaxPages{maxPages}
             , fProxyProvider{proxyProvider}
             , fCaps{fProxyProvider->refCaps()}
             , fGlyphCache{glyphCache}
@@ -58,7 +60,7 @@ void GrAtlasManager::freeAll() {
 
 bool GrAtlasManager::hasGlyph(GrGlyph* glyph) {
     SkASSERT(glyph);
-    return this->getAtlas(glyph->fMaskFormat)->hasID(glyph->fID);
+    return this->getAtlas(glyph->atlasFormat())->hasID(glyph->fID);
 }
 
 // add to texture atlas that matches this format
@@ -78,7 +80,7 @@ void GrAtlasManager::addGlyphToBulkAndSetUseToken(GrDrawOpAtlas::BulkUseTokenUpd
                                                   GrDeferredUploadToken token) {
     SkASSERT(glyph);
     if (updater->add(glyph->fID)) {
-        this->getAtlas(glyph->fMaskFormat)->setLastUseToken(glyph->fID, token);
+        this->getAtlas(glyph->atlasFormat())->setLastUseToken(glyph->fID, token);
     }
 }
 
@@ -185,7 +187,7 @@ bool GrAtlasManager::initAtlas(GrMaskFormat format) {
         fAtlases[index] = GrDrawOpAtlas::Make(
                 fProxyProvider, format, config, atlasDimensions.width(), atlasDimensions.height(),
                 plotDimensions.width(), plotDimensions.height(), fAllowMultitexturing,
-                &GrStrikeCache::HandleEviction, fGlyphCache);
+                &GrStrikeCache::HandleEviction, fGlyphCache, fMaxPages);
         if (!fAtlases[index]) {
             return false;
         }
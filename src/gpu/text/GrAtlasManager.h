@@ -26,7 +26,8 @@ class GrTextStrike;
 class GrAtlasManager : public GrOnFlushCallbackObject {
 public:
     GrAtlasManager(GrProxyProvider*, GrStrikeCache*,
-                   size_t maxTextureBytes, GrDrawOpAtlas::AllowMultitexturing);
+                   size_t maxTextureBytes, GrDrawOpAtlas::AllowMultitexturing,
+                   int maxPages = GrDrawOpAtlas::kDefaultMaxPages);
     ~GrAtlasManager() override;
 
     // Change an expected 565 mask format to 8888 if 565 is not supported (will happen when using
@@ -142,6 +143,7 @@ private:
     }
 
     GrDrawOpAtlas::AllowMultitexturing fAllowMultitexturing;
+    int fMaxPages;
     std::unique_ptr<GrDrawOpAtlas> fAtlases[kMaskFormatCount];
     GrProxyProvider* fProxyProvider;
     sk_sp<const GrCaps> fCaps;
@@ -14,10 +14,12 @@
 #include "SkAutoMalloc.h"
 #include "SkDistanceFieldGen.h"
 
-GrStrikeCache::GrStrikeCache(const GrCaps* caps, size_t maxTextureBytes)
+GrStrikeCache::GrStrikeCache(const GrCaps* caps, size_t maxTextureBytes,
+                             bool multiChannelDistanceFields)
         : fPreserveStrike(nullptr)
         , f565Masks(SkMasks::CreateMasks({0xF800, 0x07E0, 0x001F, 0},
-                    GrMaskFormatBytesPerPixel(kA565_GrMaskFormat))) { }
+                    GrMaskFormatBytesPerPixel(kA565_GrMaskFormat)))
+        , fMultiChannelDistanceFields(multiChannelDistanceFields) { }
 
 GrStrikeCache::~GrStrikeCache() {
     StrikeHash::Iter iter(&fCache);
@@ -80,20 +82,15 @@ static void expand_bits(INT_TYPE* dst,
     }
 }
 
-static bool get_packed_glyph_image(SkStrike* cache, const SkGlyph& glyph, int width,
-                                   int height, int dstRB, GrMaskFormat expectedMaskFormat,
-                                   void* dst, const SkMasks& masks) {
-    SkASSERT(glyph.fWidth == width);
-    SkASSERT(glyph.fHeight == height);
-    const void* src = cache->findImage(glyph);
-    if (nullptr == src) {
-        return false;
-    }
-
+// Packs a glyph image of srcFormat into dst in the expected format.
+static void get_packed_glyph_image(const void* src, SkMask::Format srcFormat, int srcRB,
+                                   int width, int height, int dstRB,
+                                   GrMaskFormat expectedMaskFormat, void* dst,
+                                   const SkMasks& masks) {
     // Convert if the glyph uses a 565 mask format since it is using LCD text rendering but the
     // expected format is 8888 (will happen on macOS with Metal since that combination does not
     // support 565).
-    if (kA565_GrMaskFormat == GrGlyph::FormatFromSkGlyph(glyph) &&
+    if (kA565_GrMaskFormat == GrGlyph::FormatFromSkMaskFormat(srcFormat) &&
         kARGB_GrMaskFormat == expectedMaskFormat) {
         const int a565Bpp = GrMaskFormatBytesPerPixel(kA565_GrMaskFormat);
         const int argbBpp = GrMaskFormatBytesPerPixel(kARGB_GrMaskFormat);
@@ -110,26 +107,25 @@ static bool get_packed_glyph_image(SkStrike* cache, const SkGlyph& glyph, int wi
                 dst = (char*)dst + argbBpp;
             }
         }
-        return true;
+        return;
     }
 
     // crbug:510931
     // Retrieving the image from the cache can actually change the mask format.  This case is very
     // uncommon so for now we just draw a clear box for these glyphs.
-    if (GrGlyph::FormatFromSkGlyph(glyph) != expectedMaskFormat) {
+    if (GrGlyph::FormatFromSkMaskFormat(srcFormat) != expectedMaskFormat) {
         const int bpp = GrMaskFormatBytesPerPixel(expectedMaskFormat);
         for (int y = 0; y < height; y++) {
             sk_bzero(dst, width * bpp);
             dst = (char*)dst + dstRB;
         }
-        return true;
+        return;
     }
 
-    int srcRB = glyph.rowBytes();
     // The windows font host sometimes has BW glyphs in a non-BW strike. So it is important here to
     // check the glyph's format, not the strike's format, and to be able to convert to any of the
     // GrMaskFormats.
-    if (SkMask::kBW_Format == glyph.fMaskFormat) {
+    if (SkMask::kBW_Format == srcFormat) {
         // expand bits to our mask type
         const uint8_t* bits = reinterpret_cast<const uint8_t*>(src);
         switch (expectedMaskFormat) {
@@ -156,6 +152,52 @@ static bool get_packed_glyph_image(SkStrike* cache, const SkGlyph& glyph, int wi
             dst = (char*)dst + dstRB;
         }
     }
+}
+
+// The SkMask::Format whose images are laid out like a GrMaskFormat's.
+static SkMask::Format sk_mask_format(GrMaskFormat format) {
+    switch (format) {
+        case kA8_GrMaskFormat:   return SkMask::kA8_Format;
+        case kA565_GrMaskFormat: return SkMask::kLCD16_Format;
+        case kARGB_GrMaskFormat: return SkMask::kARGB32_Format;
+    }
+    SkDEBUGFAIL("unsupported GrMaskFormat");
+    return SkMask::kA8_Format;
+}
+
+// Generates a multi-channel distance field from the glyph's outline. Glyphs without an outline, or
+// with one the generator can't handle, get their single-channel field copied to all four
+// channels, whose median is that same distance.
+static bool get_multichannel_glyph_image(SkStrike* cache, const SkGlyph& glyph, int width,
+                                         int height, int dstRB, void* dst) {
+    SkASSERT(glyph.fWidth == width);
+    SkASSERT(glyph.fHeight == height);
+    if (const SkPath* path = cache->findPath(glyph)) {
+        SkMatrix drawMatrix = SkMatrix::MakeTrans(-(glyph.fLeft + SK_DistanceFieldPad),
+                                                  -(glyph.fTop + SK_DistanceFieldPad));
+        if (GrGenerateMultiChannelDistanceFieldFromPath(reinterpret_cast<unsigned char*>(dst),
+                                                        *path, drawMatrix, width, height, dstRB)) {
+            return true;
+        }
+    }
+
+    const uint8_t* src = reinterpret_cast<const uint8_t*>(cache->findImage(glyph));
+    if (nullptr == src) {
+        return false;
+    }
+    for (int y = 0; y < height; y++) {
+        uint32_t* d = reinterpret_cast<uint32_t*>(dst);
+        if (SkMask::kSDF_Format != glyph.fMaskFormat) {
+            // As in get_packed_glyph_image, draw a clear box if the format changed underneath us.
+            sk_bzero(d, width * sizeof(uint32_t));
+        } else {
+            for (int x = 0; x < width; x++) {
+                d[x] = src[x] * 0x01010101;
+            }
+        }
+        src += glyph.rowBytes();
+        dst = (char*)dst + dstRB;
+    }
     return true;
 }
 
@@ -169,15 +211,36 @@ static bool get_packed_glyph_image(SkStrike* cache, const SkGlyph& glyph, int wi
     atlas and a position within that texture.
  */
 
-GrTextStrike::GrTextStrike(const SkDescriptor& key)
-    : fFontScalerKey(key) {}
+GrTextStrike::GrTextStrike(const SkDescriptor& key, bool multiChannelDistanceFields)
+    : fFontScalerKey(key)
+    , fMultiChannelDistanceFields(multiChannelDistanceFields) {}
 
 GrGlyph* GrTextStrike::generateGlyph(const SkGlyph& skGlyph) {
-    GrGlyph* grGlyph = fAlloc.make<GrGlyph>(skGlyph);
+    GrGlyph* grGlyph = fAlloc.make<GrGlyph>(skGlyph, fMultiChannelDistanceFields);
     fCache.add(grGlyph);
     return grGlyph;
 }
 
+void GrTextStrike::captureGlyphImage(GrGlyph* glyph, const SkGlyph& skGlyph,
+                                     SkStrikeInterface* cache, const SkMasks& masks) {
+    SkASSERT(fCache.find(glyph->fPackedID) == glyph);
+    // Multi-channel distance fields are generated from paths when they're added to the atlas.
+    if (glyph->fImage || GrGlyph::kMultiChannelDistance_MaskStyle == glyph->maskStyle()) {
+        return;
+    }
+    const void* src = cache->findImage(skGlyph);
+    if (nullptr == src) {
+        return;
+    }
+    SkASSERT(skGlyph.fWidth == glyph->width() && skGlyph.fHeight == glyph->height());
+    int rowBytes = glyph->width() * GrMaskFormatBytesPerPixel(glyph->fMaskFormat);
+    void* image = fAlloc.makeArrayDefault<char>(rowBytes * glyph->height());
+    get_packed_glyph_image(src, (SkMask::Format)skGlyph.fMaskFormat, skGlyph.rowBytes(),
+                           glyph->width(), glyph->height(), rowBytes, glyph->fMaskFormat,
+                           image, masks);
+    glyph->fImage = image;
+}
+
 void GrTextStrike::removeID(GrDrawOpAtlas::AtlasID id) {
     SkTDynamicHash<GrGlyph, SkPackedGlyphID>::Iter iter(&fCache);
     while (!iter.done()) {
@@ -200,9 +263,13 @@ GrDrawOpAtlas::ErrorCode GrTextStrike::addGlyphToAtlas(
                                    GrMaskFormat expectedMaskFormat,
                                    bool isScaledGlyph) {
     SkASSERT(glyph);
-    SkASSERT(cache);
+    SkASSERT(cache || glyph->fImage);
     SkASSERT(fCache.find(glyph->fPackedID));
 
+    bool isMultiChannel = GrGlyph::kMultiChannelDistance_MaskStyle == glyph->maskStyle();
+    if (isMultiChannel) {
+        expectedMaskFormat = glyph->atlasFormat();
+    }
     expectedMaskFormat = fullAtlasManager->resolveMaskFormat(expectedMaskFormat);
     int bytesPerPixel = GrMaskFormatBytesPerPixel(expectedMaskFormat);
     int width = glyph->width();
@@ -210,7 +277,7 @@ GrDrawOpAtlas::ErrorCode GrTextStrike::addGlyphToAtlas(
     int rowBytes = width * bytesPerPixel;
 
     size_t size = glyph->fBounds.area() * bytesPerPixel;
-    bool isSDFGlyph = GrGlyph::kDistance_MaskStyle == glyph->maskStyle();
+    bool isSDFGlyph = GrGlyph::kCoverage_MaskStyle != glyph->maskStyle();
     bool addPad = isScaledGlyph && !isSDFGlyph;
     if (addPad) {
         width += 2;
@@ -221,16 +288,34 @@ GrDrawOpAtlas::ErrorCode GrTextStrike::addGlyphToAtlas(
     }
     SkAutoSMalloc<1024> storage(size);
 
-    const SkGlyph& skGlyph = GrToSkGlyph(cache, glyph->fPackedID);
     void* dataPtr = storage.get();
     if (addPad) {
         sk_bzero(dataPtr, size);
         dataPtr = (char*)(dataPtr) + rowBytes + bytesPerPixel;
     }
-    if (!get_packed_glyph_image(cache, skGlyph, glyph->width(), glyph->height(),
-                                rowBytes, expectedMaskFormat,
-                                dataPtr, glyphCache->getMasks())) {
-        return GrDrawOpAtlas::ErrorCode::kError;
+    if (glyph->fImage) {
+        // Captured while recording, so there's no need to go back to the SkStrike.
+        get_packed_glyph_image(glyph->fImage, sk_mask_format(glyph->fMaskFormat),
+                               glyph->width() * GrMaskFormatBytesPerPixel(glyph->fMaskFormat),
+                               glyph->width(), glyph->height(), rowBytes, expectedMaskFormat,
+                               dataPtr, glyphCache->getMasks());
+    } else {
+        const SkGlyph& skGlyph = GrToSkGlyph(cache, glyph->fPackedID);
+        SkASSERT(skGlyph.fWidth == glyph->width() && skGlyph.fHeight == glyph->height());
+        if (isMultiChannel) {
+            if (!get_multichannel_glyph_image(cache, skGlyph, glyph->width(), glyph->height(),
+                                              rowBytes, dataPtr)) {
+                return GrDrawOpAtlas::ErrorCode::kError;
+            }
+        } else {
+            const void* src = cache->findImage(skGlyph);
+            if (nullptr == src) {
+                return GrDrawOpAtlas::ErrorCode::kError;
+            }
+            get_packed_glyph_image(src, (SkMask::Format)skGlyph.fMaskFormat, skGlyph.rowBytes(),
+                                   glyph->width(), glyph->height(), rowBytes,
+                                   expectedMaskFormat, dataPtr, glyphCache->getMasks());
+        }
     }
 
     GrDrawOpAtlas::ErrorCode result = fullAtlasManager->addToAtlas(
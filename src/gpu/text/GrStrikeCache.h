@@ -28,7 +28,7 @@ class GrStrikeCache;
  */
 class GrTextStrike : public SkNVRefCnt<GrTextStrike> {
 public:
-    GrTextStrike(const SkDescriptor& fontScalerKey);
+    GrTextStrike(const SkDescriptor& fontScalerKey, bool multiChannelDistanceFields = false);
 
     GrGlyph* getGlyph(const SkGlyph& skGlyph) {
         GrGlyph* glyph = fCache.find(skGlyph.getPackedID());
@@ -55,9 +55,13 @@ public:
         return glyph;
     }
 
+    // Copies the glyph's image out of the strike into glyph->fImage, so that it can later be added
+    // to the atlas without an SkStrike. Multi-channel distance field glyphs are not captured.
+    void captureGlyphImage(GrGlyph*, const SkGlyph&, SkStrikeInterface*, const SkMasks&);
+
     // returns true if glyph successfully added to texture atlas, false otherwise.  If the glyph's
     // mask format has changed, then addGlyphToAtlas will draw a clear box.  This will almost never
-    // happen.
+    // happen.  The SkStrike may be null if the glyph's image was captured.
     // TODO we can handle some of these cases if we really want to, but the long term solution is to
     // get the actual glyph image itself when we get the glyph metrics.
     GrDrawOpAtlas::ErrorCode addGlyphToAtlas(GrResourceProvider*, GrDeferredUploadTarget*,
@@ -87,6 +91,8 @@ private:
 
     int fAtlasedGlyphs{0};
     bool fIsAbandoned{false};
+    // Distance field glyphs are generated from their outlines with a channel per edge color.
+    const bool fMultiChannelDistanceFields;
 
     static const SkGlyph& GrToSkGlyph(SkStrike* cache, SkPackedGlyphID id) {
         return cache->getGlyphIDMetrics(id.code(), id.getSubXFixed(), id.getSubYFixed());
@@ -103,7 +109,8 @@ private:
  */
 class GrStrikeCache {
 public:
-    GrStrikeCache(const GrCaps* caps, size_t maxTextureBytes);
+    GrStrikeCache(const GrCaps* caps, size_t maxTextureBytes,
+                  bool multiChannelDistanceFields = false);
     ~GrStrikeCache();
 
     void setStrikeToPreserve(GrTextStrike* strike) { fPreserveStrike = strike; }
@@ -122,6 +129,9 @@ public:
 
     const SkMasks& getMasks() const { return *f565Masks; }
 
+    // Whether distance field glyphs are multi-channel, and so live in the ARGB atlas.
+    bool multiChannelDistanceFields() const { return fMultiChannelDistanceFields; }
+
     void freeAll();
 
     static void HandleEviction(GrDrawOpAtlas::AtlasID, void*);
@@ -129,7 +139,8 @@ public:
 private:
     sk_sp<GrTextStrike> generateStrike(const SkDescriptor& desc) {
         // 'fCache' get the construction ref
-        sk_sp<GrTextStrike> strike = sk_ref_sp(new GrTextStrike(desc));
+        sk_sp<GrTextStrike> strike =
+                sk_ref_sp(new GrTextStrike(desc, fMultiChannelDistanceFields));
         fCache.add(strike.get());
         return strike;
     }
@@ -139,6 +150,7 @@ private:
     StrikeHash fCache;
     GrTextStrike* fPreserveStrike;
     std::unique_ptr<const SkMasks> f565Masks;
+    const bool fMultiChannelDistanceFields;
 };
 
 #endif  // GrStrikeCache_DEFINED
@@ -9,6 +9,7 @@
 #include "GrBlurUtils.h"
 #include "GrClip.h"
 #include "GrContext.h"
+#include "GrPaint.h"
 #include "GrShape.h"
 #include "GrStyle.h"
 #include "GrTextTarget.h"
@@ -179,7 +180,7 @@ inline std::unique_ptr<GrAtlasTextOp> GrTextBlob::makeOp(
                 target->getContext(), std::move(grPaint), glyphCount, distanceAdjustTable,
                 target->colorSpaceInfo().isLinearlyBlended(),
                 SkPaintPriv::ComputeLuminanceColor(paint),
-                props, info.isAntiAliased(), info.hasUseLCDText());
+                props, info.isAntiAliased(), info.hasUseLCDText(), info.isMultiChannel());
     } else {
         op = GrAtlasTextOp::MakeBitmap(target->getContext(), std::move(grPaint), format, glyphCount,
                                        info.needsTransform());
@@ -236,6 +237,18 @@ void GrTextBlob::flush(GrTextTarget* target, const SkSurfaceProps& props,
             SkPaint runPaint{paint};
             runPaint.setAntiAlias(run.fAntiAlias);
 
+            // If there are shaders, blurs or styles, the paint depends on each glyph's matrix.
+            // Otherwise it is converted once and shared by all of the run's path glyphs, instead
+            // of once per glyph.
+            GrStyle style(runPaint);
+            bool scalePath = runPaint.getShader()
+                             || style.applies()
+                             || runPaint.getMaskFilter();
+            GrPaint runGrPaint;
+            if (!scalePath) {
+                target->makeGrPaint(kA8_GrMaskFormat, runPaint, viewMatrix, &runGrPaint);
+            }
+
             for (int i = 0; i < run.fPathGlyphs.count(); i++) {
                 GrTextBlob::Run::PathGlyph& pathGlyph = run.fPathGlyphs[i];
 
@@ -265,10 +278,6 @@ void GrTextBlob::flush(GrTextTarget* target, const SkSurfaceProps& props,
                     // If there are shaders, blurs or styles, the path must be scaled into source
                     // space independently of the CTM. This allows the CTM to be correct for the
                     // different effects.
-                    GrStyle style(runPaint);
-                    bool scalePath = runPaint.getShader()
-                                     || style.applies()
-                                     || runPaint.getMaskFilter();
                     if (!scalePath) {
                         // Scale can be applied to CTM -- no effects.
 
@@ -306,7 +315,12 @@ void GrTextBlob::flush(GrTextTarget* target, const SkSurfaceProps& props,
                 // TODO: we are losing the mutability of the path here
                 GrShape shape(*path, paint);
 
-                target->drawShape(clip, runPaint, ctm, shape);
+                if (!scalePath) {
+                    target->drawShape(clip, GrPaint::Clone(runGrPaint), GrAA(runPaint.isAntiAlias()),
+                                      ctm, shape);
+                } else {
+                    target->drawShape(clip, runPaint, ctm, shape);
+                }
             }
         }
 
@@ -448,6 +462,7 @@ void GrTextBlob::AssertEqual(const GrTextBlob& l, const GrTextBlob& r) {
             SkASSERT_RELEASE(lSubRun.glyphEndIndex() == rSubRun.glyphEndIndex());
             SkASSERT_RELEASE(lSubRun.maskFormat() == rSubRun.maskFormat());
             SkASSERT_RELEASE(lSubRun.drawAsDistanceFields() == rSubRun.drawAsDistanceFields());
+            SkASSERT_RELEASE(lSubRun.isMultiChannel() == rSubRun.isMultiChannel());
             SkASSERT_RELEASE(lSubRun.hasUseLCDText() == rSubRun.hasUseLCDText());
         }
 
@@ -472,3 +487,10 @@ void GrTextBlob::SubRun::computeTranslation(const SkMatrix& viewMatrix,
     fX = x;
     fY = y;
 }
+
+void GrTextBlob::SubRun::computeTranslationFromVertices(const SkMatrix& viewMatrix,
+                                                        SkScalar x, SkScalar y, SkScalar* transX,
+                                                        SkScalar* transY) const {
+    calculate_translation(!this->drawAsDistanceFields() && !this->isFallback(), viewMatrix,
+            x, y, fCurrentViewMatrix, fX, fY, transX, transY);
+}
@@ -238,6 +238,10 @@ public:
 
     size_t size() const { return fSize; }
 
+    // When the GrTextBlobCache last handed out this blob.
+    GrStdSteadyClock::time_point lastUseTime() const { return fLastUseTime; }
+    void setLastUseTime(GrStdSteadyClock::time_point time) { fLastUseTime = time; }
+
     ~GrTextBlob() override {
         for (int i = 0; i < fRunCountLimit; i++) {
             fRuns[i].~Run();
@@ -334,6 +338,11 @@ private:
         void computeTranslation(const SkMatrix& viewMatrix, SkScalar x, SkScalar y,
                                 SkScalar* transX, SkScalar* transY);
 
+        // Computes the same translation, but leaves the vertices where they are, for callers
+        // that apply the translation as they copy the vertices out.
+        void computeTranslationFromVertices(const SkMatrix& viewMatrix, SkScalar x, SkScalar y,
+                                            SkScalar* transX, SkScalar* transY) const;
+
         // df properties
         void setDrawAsDistanceFields() { fFlags.drawAsSdf = true; }
         bool drawAsDistanceFields() const { return fFlags.drawAsSdf; }
@@ -343,10 +352,16 @@ private:
         bool isAntiAliased() const { return fFlags.antiAliased; }
         void setHasWCoord(bool hasW) { fFlags.hasWCoord = hasW; }
         bool hasWCoord() const { return fFlags.hasWCoord; }
+        void setMultiChannel(bool multiChannel) { fFlags.multiChannel = multiChannel; }
+        bool isMultiChannel() const { return fFlags.multiChannel; }
+        // Multi-channel distance fields keep the A8 vertex layout but live in the ARGB atlas.
+        GrMaskFormat atlasFormat() const {
+            return fFlags.multiChannel ? kARGB_GrMaskFormat : fMaskFormat;
+        }
         void setNeedsTransform(bool needsTransform) { fFlags.needsTransform = needsTransform; }
         bool needsTransform() const { return fFlags.needsTransform; }
         void setFallback() { fFlags.argbFallback = true; }
-        bool isFallback() { return fFlags.argbFallback; }
+        bool isFallback() const { return fFlags.argbFallback; }
 
         const SkDescriptor* desc() const { return fDesc.getDesc(); }
 
@@ -371,7 +386,8 @@ private:
             bool hasWCoord:1;
             bool needsTransform:1;
             bool argbFallback:1;
-        } fFlags{false, false, false, false, false, false};
+            bool multiChannel:1;
+        } fFlags{false, false, false, false, false, false, false};
         Run* const fRun;
         const SkAutoDescriptor& fDesc;
     };  // SubRunInfo
@@ -452,12 +468,14 @@ private:
         }
 
         // sets the last subrun of runIndex to use distance field text
-        void setSubRunHasDistanceFields(bool hasLCD, bool isAntiAlias, bool hasWCoord) {
+        void setSubRunHasDistanceFields(bool hasLCD, bool isAntiAlias, bool hasWCoord,
+                                        bool isMultiChannel) {
             SubRun& subRun = fSubRunInfo.back();
             subRun.setUseLCDText(hasLCD);
             subRun.setAntiAliased(isAntiAlias);
             subRun.setDrawAsDistanceFields();
             subRun.setHasWCoord(hasWCoord);
+            subRun.setMultiChannel(isMultiChannel);
         }
 
         SubRun* pushBackSubRun(const SkAutoDescriptor& desc, GrColor color) {
@@ -547,6 +565,10 @@ private:
     void processDeviceFallback(SkSpan<const SkGlyphPos> masks,
                                SkStrikeInterface* strike) override;
 
+    // If fCaptureGlyphImages is set, copies the masks' images into their GrGlyphs.
+    void captureGlyphImages(SkSpan<const SkGlyphPos> masks, SkStrikeInterface* strike,
+                            GrTextStrike* grStrike);
+
     struct StrokeInfo {
         SkScalar fFrameWidth;
         SkScalar fMiterLimit;
@@ -575,6 +597,7 @@ private:
     SkColor fLuminanceColor;
     SkScalar fInitialX;
     SkScalar fInitialY;
+    GrStdSteadyClock::time_point fLastUseTime;
 
     // We can reuse distance field text, but only if the new viewmatrix would not result in
     // a mip change.  Because there can be multiple runs in a blob, we track the overall
@@ -584,6 +607,7 @@ private:
     int fRunCount{0};
     int fRunCountLimit;
     uint8_t fTextType{0};
+    bool fCaptureGlyphImages{false};
 };
 
 /**
@@ -600,11 +624,14 @@ public:
      * Consecutive VertexRegenerators often use the same SkGlyphCache. If the same instance of
      * SkAutoGlyphCache is reused then it can save the cost of multiple detach/attach operations of
      * SkGlyphCache.
+     *
+     * If regenPositionsAndColors is false the blob's positions and colors are left alone, and the
+     * caller applies translation() and the color itself while it copies the glyphs out.
      */
     VertexRegenerator(GrResourceProvider*, GrTextBlob*, int runIdx, int subRunIdx,
                       const SkMatrix& viewMatrix, SkScalar x, SkScalar y, GrColor color,
                       GrDeferredUploadTarget*, GrStrikeCache*, GrAtlasManager*,
-                      SkExclusiveStrikePtr*);
+                      SkExclusiveStrikePtr*, bool regenPositionsAndColors = true);
 
     struct Result {
         /**
@@ -627,6 +654,9 @@ public:
 
     bool regenerate(Result*);
 
+    /** The translation from the blob's positions to the draw's, when they aren't regenerated. */
+    SkVector translation() const { return {fTransX, fTransY}; }
+
 private:
     bool doRegen(Result*, bool regenPos, bool regenCol, bool regenTexCoords, bool regenGlyphs);
 
@@ -646,6 +676,7 @@ private:
     uint32_t fRegenFlags = 0;
     int fCurrGlyph = 0;
     bool fBrokenRun = false;
+    bool fRegenPositionsAndColors;
 };
 
 #endif  // GrTextBlob_DEFINED
@@ -28,6 +28,7 @@ void GrTextBlobCache::freeAll() {
     fBlobIDCache.reset();
 
     fCurrentSize = 0;
+    fBlobCount = 0;
 
     // There should be no allocations in the memory pool at this point
     SkASSERT(fBlobList.isEmpty());
@@ -52,6 +53,8 @@ void GrTextBlobCache::purgeStaleBlobs() {
         // remove all blob entries from the LRU list
         for (const auto& blob : idEntry->fBlobs) {
             fCurrentSize -= blob->size();
+            fBlobCount--;
+            fStats.fPurgedStale++;
             fBlobList.remove(blob.get());
         }
 
@@ -74,6 +77,7 @@ void GrTextBlobCache::checkPurge(GrTextBlob* blob) {
             iter.prev();
 
             this->remove(lruBlob);
+            fStats.fPurgedOverBudget++;
         }
 
         // If we break out of the loop with lruBlob == blob, then we haven't purged enough
@@ -93,3 +97,38 @@ void GrTextBlobCache::checkPurge(GrTextBlob* blob) {
 
 
 
+
+void GrTextBlobCache::purgeBlobsNotUsedSince(GrStdSteadyClock::time_point purgeTime) {
+    this->purgeStaleBlobs();
+
+    // The list is in order of use, so the blobs to purge are all at the tail.
+    GrTextBlob* lruBlob;
+    while ((lruBlob = fBlobList.tail()) && lruBlob->lastUseTime() < purgeTime) {
+        this->remove(lruBlob);
+        fStats.fPurgedNotUsed++;
+    }
+}
+
+#if GR_TEST_UTILS
+void GrTextBlobCache::dumpStats(SkString* out) const {
+    out->appendf("Text Blob Cache:\n");
+    out->appendf("\t%d blobs, %zu of %zu bytes\n", fBlobCount, fCurrentSize, fSizeBudget);
+    out->appendf("\t%d hits, %d misses\n", fStats.fHits, fStats.fMisses);
+    out->appendf("\tPurged %d over budget, %d not used, %d stale\n",
+                 fStats.fPurgedOverBudget, fStats.fPurgedNotUsed, fStats.fPurgedStale);
+}
+
+void GrTextBlobCache::dumpStatsKeyValuePairs(SkTArray<SkString>* keys,
+                                             SkTArray<double>* values) const {
+    keys->push_back(SkString("text_blob_hits"));
+    values->push_back(fStats.fHits);
+    keys->push_back(SkString("text_blob_misses"));
+    values->push_back(fStats.fMisses);
+    keys->push_back(SkString("text_blob_purged_over_budget"));
+    values->push_back(fStats.fPurgedOverBudget);
+    keys->push_back(SkString("text_blob_purged_not_used"));
+    values->push_back(fStats.fPurgedNotUsed);
+    keys->push_back(SkString("text_blob_purged_stale"));
+    values->push_back(fStats.fPurgedStale);
+}
+#endif
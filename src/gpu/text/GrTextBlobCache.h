@@ -53,9 +53,15 @@ public:
         return cacheBlob;
     }
 
-    sk_sp<GrTextBlob> find(const GrTextBlob::Key& key) const {
+    sk_sp<GrTextBlob> find(const GrTextBlob::Key& key) {
         const auto* idEntry = fBlobIDCache.find(key.fUniqueID);
-        return idEntry ? idEntry->find(key) : nullptr;
+        sk_sp<GrTextBlob> blob = idEntry ? idEntry->find(key) : nullptr;
+        if (blob) {
+            fStats.fHits++;
+        } else {
+            fStats.fMisses++;
+        }
+        return blob;
     }
 
     void remove(GrTextBlob* blob) {
@@ -64,6 +70,7 @@ public:
         SkASSERT(idEntry);
 
         fCurrentSize -= blob->size();
+        fBlobCount--;
         fBlobList.remove(blob);
         idEntry->removeBlob(blob);
         if (idEntry->fBlobs.empty()) {
@@ -72,6 +79,7 @@ public:
     }
 
     void makeMRU(GrTextBlob* blob) {
+        blob->setLastUseTime(GrStdSteadyClock::now());
         if (fBlobList.head() == blob) {
             return;
         }
@@ -95,6 +103,16 @@ public:
         this->checkPurge();
     }
 
+    size_t getBudget() const { return fSizeBudget; }
+
+    // The budget that goes with a GPU resource budget, keeping the ratio of their defaults.
+    static size_t BudgetForResourceBytes(size_t maxResourceBytes) {
+        return maxResourceBytes / kResourceBytesPerBudgetByte;
+    }
+
+    // Drop the blobs that have not been drawn since purgeTime.
+    void purgeBlobsNotUsedSince(GrStdSteadyClock::time_point purgeTime);
+
     struct PurgeBlobMessage {
         PurgeBlobMessage(uint32_t blobID, uint32_t contextUniqueID)
                 : fBlobID(blobID), fContextID(contextUniqueID) {}
@@ -108,6 +126,24 @@ public:
     void purgeStaleBlobs();
 
     size_t usedBytes() const { return fCurrentSize; }
+    int blobCount() const { return fBlobCount; }
+
+    struct Stats {
+        int fHits = 0;
+        int fMisses = 0;
+        // Blobs dropped to stay in budget, for not being used recently enough, or because their
+        // SkTextBlob was deleted.
+        int fPurgedOverBudget = 0;
+        int fPurgedNotUsed = 0;
+        int fPurgedStale = 0;
+    };
+
+    const Stats& stats() const { return fStats; }
+
+#if GR_TEST_UTILS
+    void dumpStats(SkString*) const;
+    void dumpStatsKeyValuePairs(SkTArray<SkString>* keys, SkTArray<double>* values) const;
+#endif
 
 private:
     using BitmapBlobList = SkTInternalLList<GrTextBlob>;
@@ -167,8 +203,10 @@ private:
 
         // Safe to retain a raw ptr temporarily here, because the cache will hold a ref.
         GrTextBlob* rawBlobPtr = blob.get();
+        rawBlobPtr->setLastUseTime(GrStdSteadyClock::now());
         fBlobList.addToHead(rawBlobPtr);
         fCurrentSize += blob->size();
+        fBlobCount++;
         idEntry->addBlob(std::move(blob));
 
         this->checkPurge(rawBlobPtr);
@@ -178,12 +216,16 @@ private:
 
     static const int kMinGrowthSize = 1 << 16;
     static const int kDefaultBudget = 1 << 22;
+    // GrResourceCache's default budget is 96MB.
+    static const int kResourceBytesPerBudgetByte = 24;
     BitmapBlobList fBlobList;
     SkTHashMap<uint32_t, BlobIDCacheEntry> fBlobIDCache;
     PFOverBudgetCB fCallback;
     void* fData;
     size_t fSizeBudget;
     size_t fCurrentSize{0};
+    int fBlobCount{0};
+    Stats fStats;
     uint32_t fUniqueID;      // unique id to use for messaging
     SkMessageBus<PurgeBlobMessage>::Inbox fPurgeBlobInbox;
 };
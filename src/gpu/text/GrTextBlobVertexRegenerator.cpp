@@ -63,19 +63,12 @@ static void regen_texcoords(char* vertex, size_t vertexStride, const GrGlyph* gl
         u1 = u0 + width;
         v1 = v0 + height;
     }
-    // We pack the 2bit page index in the low bit of the u and v texture coords
+    // We pack the page index in the low bits of the u and v texture coords
     uint32_t pageIndex = glyph->pageIndex();
-    SkASSERT(pageIndex < 4);
-    uint16_t uBit = (pageIndex >> 1) & 0x1;
-    uint16_t vBit = pageIndex & 0x1;
-    u0 <<= 1;
-    u0 |= uBit;
-    v0 <<= 1;
-    v0 |= vBit;
-    u1 <<= 1;
-    u1 |= uBit;
-    v1 <<= 1;
-    v1 |= vBit;
+    u0 = GrDrawOpAtlas::PackU(u0, pageIndex);
+    v0 = GrDrawOpAtlas::PackV(v0, pageIndex);
+    u1 = GrDrawOpAtlas::PackU(u1, pageIndex);
+    v1 = GrDrawOpAtlas::PackV(v1, pageIndex);
 
     uint16_t* textureCoords = reinterpret_cast<uint16_t*>(vertex + texCoordOffset);
     textureCoords[0] = u0;
@@ -123,7 +116,8 @@ GrTextBlob::VertexRegenerator::VertexRegenerator(GrResourceProvider* resourcePro
                                                  GrDeferredUploadTarget* uploadTarget,
                                                  GrStrikeCache* glyphCache,
                                                  GrAtlasManager* fullAtlasManager,
-                                                 SkExclusiveStrikePtr* lazyCache)
+                                                 SkExclusiveStrikePtr* lazyCache,
+                                                 bool regenPositionsAndColors)
         : fResourceProvider(resourceProvider)
         , fViewMatrix(viewMatrix)
         , fBlob(blob)
@@ -133,9 +127,14 @@ GrTextBlob::VertexRegenerator::VertexRegenerator(GrResourceProvider* resourcePro
         , fLazyCache(lazyCache)
         , fRun(&blob->fRuns[runIdx])
         , fSubRun(&blob->fRuns[runIdx].fSubRunInfo[subRunIdx])
-        , fColor(color) {
+        , fColor(color)
+        , fRegenPositionsAndColors(regenPositionsAndColors) {
     // Compute translation if any
-    fSubRun->computeTranslation(fViewMatrix, x, y, &fTransX, &fTransY);
+    if (fRegenPositionsAndColors) {
+        fSubRun->computeTranslation(fViewMatrix, x, y, &fTransX, &fTransY);
+    } else {
+        fSubRun->computeTranslationFromVertices(fViewMatrix, x, y, &fTransX, &fTransY);
+    }
 
     // Because the GrStrikeCache may evict the strike a blob depends on using for
     // generating its texture coords, we have to track whether or not the strike has
@@ -149,11 +148,13 @@ GrTextBlob::VertexRegenerator::VertexRegenerator(GrResourceProvider* resourcePro
         fRegenFlags |= kRegenGlyph;
         fRegenFlags |= kRegenTex;
     }
-    if (kARGB_GrMaskFormat != fSubRun->maskFormat() && fSubRun->color() != color) {
-        fRegenFlags |= kRegenCol;
-    }
-    if (0.f != fTransX || 0.f != fTransY) {
-        fRegenFlags |= kRegenPos;
+    if (fRegenPositionsAndColors) {
+        if (kARGB_GrMaskFormat != fSubRun->maskFormat() && fSubRun->color() != color) {
+            fRegenFlags |= kRegenCol;
+        }
+        if (0.f != fTransX || 0.f != fTransY) {
+            fRegenFlags |= kRegenPos;
+        }
     }
 }
 
@@ -161,12 +162,10 @@ bool GrTextBlob::VertexRegenerator::doRegen(GrTextBlob::VertexRegenerator::Resul
                                             bool regenPos, bool regenCol, bool regenTexCoords,
                                             bool regenGlyphs) {
     SkASSERT(!regenGlyphs || regenTexCoords);
-    sk_sp<GrTextStrike> strike;
-    if (regenTexCoords) {
-        fSubRun->resetBulkUseToken();
-
+    // Glyphs whose images were captured while recording don't need the SkStrike, so only find it
+    // once a glyph does.
+    auto lazyCache = [this]() {
         const SkDescriptor* desc = fSubRun->desc();
-
         if (!*fLazyCache || (*fLazyCache)->getDescriptor() != *desc) {
             SkScalerContextEffects effects;
             effects.fPathEffect = fRun->fPathEffect.get();
@@ -174,9 +173,15 @@ bool GrTextBlob::VertexRegenerator::doRegen(GrTextBlob::VertexRegenerator::Resul
             *fLazyCache =
                 SkStrikeCache::FindOrCreateStrikeExclusive(*desc, effects, *fRun->fTypeface);
         }
+        return fLazyCache->get();
+    };
+
+    sk_sp<GrTextStrike> strike;
+    if (regenTexCoords) {
+        fSubRun->resetBulkUseToken();
 
         if (regenGlyphs) {
-            strike = fGlyphCache->getStrike((*fLazyCache)->getDescriptor());
+            strike = fGlyphCache->getStrike(*fSubRun->desc());
         } else {
             strike = fSubRun->refStrike();
         }
@@ -197,18 +202,19 @@ bool GrTextBlob::VertexRegenerator::doRegen(GrTextBlob::VertexRegenerator::Resul
                 // Get the id from the old glyph, and use the new strike to lookup
                 // the glyph.
                 SkPackedGlyphID id = fBlob->fGlyphs[glyphOffset]->fPackedID;
-                fBlob->fGlyphs[glyphOffset] = strike->getGlyph(id, fLazyCache->get());
+                fBlob->fGlyphs[glyphOffset] = strike->getGlyph(id, lazyCache());
                 SkASSERT(id == fBlob->fGlyphs[glyphOffset]->fPackedID);
             }
             glyph = fBlob->fGlyphs[glyphOffset];
             SkASSERT(glyph && glyph->fMaskFormat == fSubRun->maskFormat());
+            SkASSERT(glyph->atlasFormat() == fSubRun->atlasFormat());
 
             if (!fFullAtlasManager->hasGlyph(glyph)) {
                 GrDrawOpAtlas::ErrorCode code;
                 code = strike->addGlyphToAtlas(fResourceProvider, fUploadTarget, fGlyphCache,
                                               fFullAtlasManager, glyph,
-                                              fLazyCache->get(), fSubRun->maskFormat(),
-                                              fSubRun->needsTransform());
+                                              glyph->fImage ? nullptr : lazyCache(),
+                                              fSubRun->maskFormat(), fSubRun->needsTransform());
                 if (GrDrawOpAtlas::ErrorCode::kError == code) {
                     // Something horrible has happened - drop the op
                     return false;
@@ -240,25 +246,27 @@ bool GrTextBlob::VertexRegenerator::doRegen(GrTextBlob::VertexRegenerator::Resul
     }
 
     // We may have changed the color so update it here
-    fSubRun->setColor(fColor);
+    if (regenCol) {
+        fSubRun->setColor(fColor);
+    }
     if (regenTexCoords) {
         if (regenGlyphs) {
             fSubRun->setStrike(std::move(strike));
         }
         fSubRun->setAtlasGeneration(fBrokenRun
                                     ? GrDrawOpAtlas::kInvalidAtlasGeneration
-                                    : fFullAtlasManager->atlasGeneration(fSubRun->maskFormat()));
+                                    : fFullAtlasManager->atlasGeneration(fSubRun->atlasFormat()));
     } else {
         // For the non-texCoords case we need to ensure that we update the associated use tokens
         fFullAtlasManager->setUseTokenBulk(*fSubRun->bulkUseToken(),
                                            fUploadTarget->tokenTracker()->nextDrawToken(),
-                                           fSubRun->maskFormat());
+                                           fSubRun->atlasFormat());
     }
     return true;
 }
 
 bool GrTextBlob::VertexRegenerator::regenerate(GrTextBlob::VertexRegenerator::Result* result) {
-    uint64_t currentAtlasGen = fFullAtlasManager->atlasGeneration(fSubRun->maskFormat());
+    uint64_t currentAtlasGen = fFullAtlasManager->atlasGeneration(fSubRun->atlasFormat());
     // If regenerate() is called multiple times then the atlas gen may have changed. So we check
     // this each time.
     if (fSubRun->atlasGeneration() != currentAtlasGen) {
@@ -284,7 +292,7 @@ bool GrTextBlob::VertexRegenerator::regenerate(GrTextBlob::VertexRegenerator::Re
         // have a valid atlas generation
         fFullAtlasManager->setUseTokenBulk(*fSubRun->bulkUseToken(),
                                            fUploadTarget->tokenTracker()->nextDrawToken(),
-                                           fSubRun->maskFormat());
+                                           fSubRun->atlasFormat());
         return true;
     }
     SK_ABORT("Should not get here");
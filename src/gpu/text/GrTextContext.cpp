@@ -39,6 +39,8 @@ static const int kDefaultMaxDistanceFieldFontSize = 384;
 #else
 static const int kDefaultMaxDistanceFieldFontSize = 2 * kLargeDFFontSize;
 #endif
+// Multi-channel fields keep corners sharp well past the 2x a single channel tolerates.
+static const int kDefaultMaxMultiChannelDistanceFieldFontSize = 8 * kLargeDFFontSize;
 
 GrTextContext::GrTextContext(const Options& options)
         : fDistanceAdjustTable(new GrDistanceFieldAdjustTable), fOptions(options) {
@@ -84,7 +86,9 @@ SkScalerContextFlags GrTextContext::ComputeScalerContextFlags(
 
 void GrTextContext::SanitizeOptions(Options* options) {
     if (options->fMaxDistanceFieldFontSize < 0.f) {
-        options->fMaxDistanceFieldFontSize = kDefaultMaxDistanceFieldFontSize;
+        options->fMaxDistanceFieldFontSize = options->fMultiChannelDistanceFieldText
+                                                     ? kDefaultMaxMultiChannelDistanceFieldFontSize
+                                                     : kDefaultMaxDistanceFieldFontSize;
     }
     if (options->fMinDistanceFieldFontSize < 0.f) {
         options->fMinDistanceFieldFontSize = kDefaultMinDistanceFieldFontSize;
@@ -41,6 +41,17 @@ public:
         SkScalar fMaxDistanceFieldFontSize = -1.f;
         /** Forces all distance field vertices to use 3 components, not just when in perspective. */
         bool fDistanceFieldVerticesAlwaysHaveW = false;
+        /**
+         * Generates distance fields with one distance per edge color in the RGB channels of the
+         * color atlas, see GrGenerateMultiChannelDistanceFieldFromPath.
+         */
+        bool fMultiChannelDistanceFieldText = false;
+        /**
+         * Copies each glyph's image into the blob's strike as the blob is generated, so that the
+         * glyphs can be added to the atlas without looking them up again. Set when recording DDLs,
+         * whose atlas work happens at replay on another thread.
+         */
+        bool fCaptureGlyphImages = false;
     };
 
     static std::unique_ptr<GrTextContext> Make(const Options& options);
@@ -9,6 +9,7 @@
 #define GrTextTarget_DEFINED
 
 #include "GrColorSpaceInfo.h"
+#include "GrTypesPriv.h"
 #include "SkPaint.h"
 
 class GrAtlasTextOp;
@@ -35,6 +36,13 @@ public:
     virtual void drawShape(const GrClip&, const SkPaint&,
                            const SkMatrix& viewMatrix, const GrShape&) = 0;
 
+    /**
+     * Draws a path glyph with a paint already converted by makeGrPaint. Runs of path glyphs whose
+     * paint doesn't depend on the glyph's matrix use this to convert the paint only once.
+     */
+    virtual void drawShape(const GrClip&, GrPaint&&, GrAA,
+                           const SkMatrix& viewMatrix, const GrShape&) = 0;
+
     virtual void makeGrPaint(GrMaskFormat, const SkPaint&, const SkMatrix& viewMatrix,
                              GrPaint*) = 0;
 
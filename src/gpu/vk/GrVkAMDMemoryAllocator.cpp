@@ -13,10 +13,13 @@
 
 GrVkAMDMemoryAllocator::GrVkAMDMemoryAllocator(VkPhysicalDevice physicalDevice,
                                                VkDevice device,
-                                               sk_sp<const GrVkInterface> interface)
+                                               sk_sp<const GrVkInterface> interface,
+                                               VkDeviceSize blockSize,
+                                               VkDeviceSize dedicatedThreshold)
         : fAllocator(VK_NULL_HANDLE)
         , fInterface(std::move(interface))
-        , fDevice(device) {
+        , fDevice(device)
+        , fDedicatedThreshold(dedicatedThreshold) {
 #define GR_COPY_FUNCTION(NAME) functions.vk##NAME = fInterface->fFunctions.f##NAME
 
     VmaVulkanFunctions functions;
@@ -46,7 +49,7 @@ GrVkAMDMemoryAllocator::GrVkAMDMemoryAllocator(VkPhysicalDevice physicalDevice,
     // Manually testing runs of dm using 64 here instead of the default 256 shows less memory usage
     // on average. Also dm seems to run faster using 64 so it doesn't seem to be trading off speed
     // for memory.
-    info.preferredLargeHeapBlockSize = 4*1024*1024;
+    info.preferredLargeHeapBlockSize = blockSize ? blockSize : 4*1024*1024;
     info.pAllocationCallbacks = nullptr;
     info.pDeviceMemoryCallbacks = nullptr;
     info.frameInUseCount = 0;
@@ -72,6 +75,14 @@ bool GrVkAMDMemoryAllocator::allocateMemoryForImage(VkImage image, AllocationPro
     info.pool = VK_NULL_HANDLE;
     info.pUserData = nullptr;
 
+    if (fDedicatedThreshold) {
+        VkMemoryRequirements memReqs;
+        GR_VK_CALL(fInterface, GetImageMemoryRequirements(fDevice, image, &memReqs));
+        if (memReqs.size >= fDedicatedThreshold) {
+            flags |= AllocationPropertyFlags::kDedicatedAllocation;
+        }
+    }
+
     if (AllocationPropertyFlags::kDedicatedAllocation & flags) {
         info.flags |= VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
     }
@@ -122,6 +133,14 @@ bool GrVkAMDMemoryAllocator::allocateMemoryForBuffer(VkBuffer buffer, BufferUsag
             break;
     }
 
+    if (fDedicatedThreshold) {
+        VkMemoryRequirements memReqs;
+        GR_VK_CALL(fInterface, GetBufferMemoryRequirements(fDevice, buffer, &memReqs));
+        if (memReqs.size >= fDedicatedThreshold) {
+            flags |= AllocationPropertyFlags::kDedicatedAllocation;
+        }
+    }
+
     if (AllocationPropertyFlags::kDedicatedAllocation & flags) {
         info.flags |= VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
     }
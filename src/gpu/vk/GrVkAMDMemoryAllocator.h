@@ -17,8 +17,11 @@ struct GrVkInterface;
 
 class GrVkAMDMemoryAllocator : public GrVkMemoryAllocator {
 public:
+    // A blockSize of 0 uses the default. Allocations of at least dedicatedThreshold bytes get
+    // their own VkDeviceMemory; a threshold of 0 disables this.
     GrVkAMDMemoryAllocator(VkPhysicalDevice physicalDevice, VkDevice device,
-                           sk_sp<const GrVkInterface> interface);
+                           sk_sp<const GrVkInterface> interface, VkDeviceSize blockSize = 0,
+                           VkDeviceSize dedicatedThreshold = 0);
 
     ~GrVkAMDMemoryAllocator() override;
 
@@ -50,6 +53,7 @@ private:
     // vulkan calls.
     sk_sp<const GrVkInterface> fInterface;
     VkDevice fDevice;
+    VkDeviceSize fDedicatedThreshold;
 
     typedef GrVkMemoryAllocator INHERITED;
 };
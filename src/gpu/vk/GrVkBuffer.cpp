@@ -149,7 +149,9 @@ void GrVkBuffer::internalMap(GrVkGpu* gpu, size_t size, bool* createdNewBuffer)
     VALIDATE();
     SkASSERT(!this->vkIsMapped());
 
-    if (!fResource->unique()) {
+    // A buffer the GPU writes for the CPU to read back is only mapped once that work has finished,
+    // and a new buffer wouldn't have the data, so it's mapped even if a command buffer holds it.
+    if (!fResource->unique() && kCopyWrite_Type != fDesc.fType) {
         if (fDesc.fDynamic) {
             // in use by the command buffer, so we need to create a new one
             fResource->recycle(gpu);
@@ -175,6 +177,9 @@ void GrVkBuffer::internalMap(GrVkGpu* gpu, size_t size, bool* createdNewBuffer)
         SkASSERT(0 == fOffset);
 
         fMapPtr = GrVkMemory::MapAlloc(gpu, alloc);
+        if (kCopyWrite_Type == fDesc.fType) {
+            GrVkMemory::InvalidateMappedAlloc(gpu, alloc, 0, alloc.fSize);
+        }
     } else {
         if (!fMapPtr) {
             fMapPtr = new unsigned char[this->size()];
@@ -58,14 +58,18 @@ void GrVkCommandBuffer::freeGPUData(GrVkGpu* gpu) const {
         fTrackedRecordingResources[i]->unref(gpu);
     }
 
-    if (!this->isWrapped()) {
-        GR_VK_CALL(gpu->vkInterface(), FreeCommandBuffers(gpu->device(), fCmdPool->vkCommandPool(),
+    if (!this->isWrapped() && VK_NULL_HANDLE != fCmdBuffer) {
+        GR_VK_CALL(gpu->vkInterface(), FreeCommandBuffers(gpu->device(), this->vkCommandPool(),
                                                           1, &fCmdBuffer));
     }
 
     this->onFreeGPUData(gpu);
 }
 
+VkCommandPool GrVkCommandBuffer::vkCommandPool() const {
+    return fCmdPool->vkCommandPool();
+}
+
 void GrVkCommandBuffer::abandonGPUData() const {
     SkDEBUGCODE(fResourcesReleased = true;)
     for (int i = 0; i < fTrackedResources.count(); ++i) {
@@ -123,6 +127,19 @@ void GrVkCommandBuffer::releaseResources(GrVkGpu* gpu) {
     this->onReleaseResources(gpu);
 }
 
+void GrVkCommandBuffer::deferCommands() {
+    SkASSERT(!fDeferredCommands);
+    fDeferredCommands.reset(new DeferredCommands);
+}
+
+void GrVkCommandBuffer::replayDeferredCommands() {
+    SkASSERT(fDeferredCommands);
+    std::unique_ptr<DeferredCommands> deferred = std::move(fDeferredCommands);
+    for (int i = 0; i < deferred->fCommands.count(); ++i) {
+        deferred->fCommands[i](fCmdBuffer);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // CommandBuffer commands
 ////////////////////////////////////////////////////////////////////////////////
@@ -142,37 +159,45 @@ void GrVkCommandBuffer::pipelineBarrier(const GrVkGpu* gpu,
     // not in a render pass.
     SkASSERT(!fActiveRenderPass);
     VkDependencyFlags dependencyFlags = byRegion ? VK_DEPENDENCY_BY_REGION_BIT : 0;
+    const GrVkInterface* iface = gpu->vkInterface();
 
     switch (barrierType) {
         case kMemory_BarrierType: {
-            const VkMemoryBarrier* barrierPtr = reinterpret_cast<VkMemoryBarrier*>(barrier);
-            GR_VK_CALL(gpu->vkInterface(), CmdPipelineBarrier(fCmdBuffer, srcStageMask,
-                                                              dstStageMask, dependencyFlags,
-                                                              1, barrierPtr,
-                                                              0, nullptr,
-                                                              0, nullptr));
+            const VkMemoryBarrier* barrierPtr =
+                    this->keepForCommand(reinterpret_cast<VkMemoryBarrier*>(barrier), 1);
+            this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+                GR_VK_CALL(iface, CmdPipelineBarrier(cmdBuffer, srcStageMask,
+                                                     dstStageMask, dependencyFlags,
+                                                     1, barrierPtr,
+                                                     0, nullptr,
+                                                     0, nullptr));
+            });
             break;
         }
 
         case kBufferMemory_BarrierType: {
             const VkBufferMemoryBarrier* barrierPtr =
-                                                 reinterpret_cast<VkBufferMemoryBarrier*>(barrier);
-            GR_VK_CALL(gpu->vkInterface(), CmdPipelineBarrier(fCmdBuffer, srcStageMask,
-                                                              dstStageMask, dependencyFlags,
-                                                              0, nullptr,
-                                                              1, barrierPtr,
-                                                              0, nullptr));
+                    this->keepForCommand(reinterpret_cast<VkBufferMemoryBarrier*>(barrier), 1);
+            this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+                GR_VK_CALL(iface, CmdPipelineBarrier(cmdBuffer, srcStageMask,
+                                                     dstStageMask, dependencyFlags,
+                                                     0, nullptr,
+                                                     1, barrierPtr,
+                                                     0, nullptr));
+            });
             break;
         }
 
         case kImageMemory_BarrierType: {
             const VkImageMemoryBarrier* barrierPtr =
-                                                  reinterpret_cast<VkImageMemoryBarrier*>(barrier);
-            GR_VK_CALL(gpu->vkInterface(), CmdPipelineBarrier(fCmdBuffer, srcStageMask,
-                                                              dstStageMask, dependencyFlags,
-                                                              0, nullptr,
-                                                              0, nullptr,
-                                                              1, barrierPtr));
+                    this->keepForCommand(reinterpret_cast<VkImageMemoryBarrier*>(barrier), 1);
+            this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+                GR_VK_CALL(iface, CmdPipelineBarrier(cmdBuffer, srcStageMask,
+                                                     dstStageMask, dependencyFlags,
+                                                     0, nullptr,
+                                                     0, nullptr,
+                                                     1, barrierPtr));
+            });
             break;
         }
     }
@@ -190,11 +215,14 @@ void GrVkCommandBuffer::bindInputBuffer(GrVkGpu* gpu, uint32_t binding,
     // to know if we can skip binding or not.
     if (vkBuffer != fBoundInputBuffers[binding]) {
         VkDeviceSize offset = vbuffer->offset();
-        GR_VK_CALL(gpu->vkInterface(), CmdBindVertexBuffers(fCmdBuffer,
-                                                            binding,
-                                                            1,
-                                                            &vkBuffer,
-                                                            &offset));
+        const GrVkInterface* iface = gpu->vkInterface();
+        this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+            GR_VK_CALL(iface, CmdBindVertexBuffers(cmdBuffer,
+                                                   binding,
+                                                   1,
+                                                   &vkBuffer,
+                                                   &offset));
+        });
         fBoundInputBuffers[binding] = vkBuffer;
         this->addResource(vbuffer->resource());
     }
@@ -206,10 +234,14 @@ void GrVkCommandBuffer::bindIndexBuffer(GrVkGpu* gpu, const GrVkIndexBuffer* ibu
     // TODO: once ibuffer->offset() no longer always returns 0, we will need to track the offset
     // to know if we can skip binding or not.
     if (vkBuffer != fBoundIndexBuffer) {
-        GR_VK_CALL(gpu->vkInterface(), CmdBindIndexBuffer(fCmdBuffer,
-                                                          vkBuffer,
-                                                          ibuffer->offset(),
-                                                          VK_INDEX_TYPE_UINT16));
+        VkDeviceSize offset = ibuffer->offset();
+        const GrVkInterface* iface = gpu->vkInterface();
+        this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+            GR_VK_CALL(iface, CmdBindIndexBuffer(cmdBuffer,
+                                                 vkBuffer,
+                                                 offset,
+                                                 VK_INDEX_TYPE_UINT16));
+        });
         fBoundIndexBuffer = vkBuffer;
         this->addResource(ibuffer->resource());
     }
@@ -233,11 +265,16 @@ void GrVkCommandBuffer::clearAttachments(const GrVkGpu* gpu,
         }
     }
 #endif
-    GR_VK_CALL(gpu->vkInterface(), CmdClearAttachments(fCmdBuffer,
-                                                       numAttachments,
-                                                       attachments,
-                                                       numRects,
-                                                       clearRects));
+    const GrVkInterface* iface = gpu->vkInterface();
+    attachments = this->keepForCommand(attachments, numAttachments);
+    clearRects = this->keepForCommand(clearRects, numRects);
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdClearAttachments(cmdBuffer,
+                                              numAttachments,
+                                              attachments,
+                                              numRects,
+                                              clearRects));
+    });
 }
 
 void GrVkCommandBuffer::bindDescriptorSets(const GrVkGpu* gpu,
@@ -249,14 +286,20 @@ void GrVkCommandBuffer::bindDescriptorSets(const GrVkGpu* gpu,
                                            uint32_t dynamicOffsetCount,
                                            const uint32_t* dynamicOffsets) {
     SkASSERT(fIsActive);
-    GR_VK_CALL(gpu->vkInterface(), CmdBindDescriptorSets(fCmdBuffer,
-                                                         VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                                         layout->layout(),
-                                                         firstSet,
-                                                         setCount,
-                                                         descriptorSets,
-                                                         dynamicOffsetCount,
-                                                         dynamicOffsets));
+    const GrVkInterface* iface = gpu->vkInterface();
+    VkPipelineLayout vkLayout = layout->layout();
+    descriptorSets = this->keepForCommand(descriptorSets, setCount);
+    dynamicOffsets = this->keepForCommand(dynamicOffsets, dynamicOffsetCount);
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdBindDescriptorSets(cmdBuffer,
+                                                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                                vkLayout,
+                                                firstSet,
+                                                setCount,
+                                                descriptorSets,
+                                                dynamicOffsetCount,
+                                                dynamicOffsets));
+    });
     this->addRecordingResource(layout);
 }
 
@@ -270,14 +313,20 @@ void GrVkCommandBuffer::bindDescriptorSets(const GrVkGpu* gpu,
                                            uint32_t dynamicOffsetCount,
                                            const uint32_t* dynamicOffsets) {
     SkASSERT(fIsActive);
-    GR_VK_CALL(gpu->vkInterface(), CmdBindDescriptorSets(fCmdBuffer,
-                                                         VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                                         layout->layout(),
-                                                         firstSet,
-                                                         setCount,
-                                                         descriptorSets,
-                                                         dynamicOffsetCount,
-                                                         dynamicOffsets));
+    const GrVkInterface* iface = gpu->vkInterface();
+    VkPipelineLayout vkLayout = layout->layout();
+    descriptorSets = this->keepForCommand(descriptorSets, setCount);
+    dynamicOffsets = this->keepForCommand(dynamicOffsets, dynamicOffsetCount);
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdBindDescriptorSets(cmdBuffer,
+                                                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                                vkLayout,
+                                                firstSet,
+                                                setCount,
+                                                descriptorSets,
+                                                dynamicOffsetCount,
+                                                dynamicOffsets));
+    });
     this->addRecordingResource(layout);
     for (int i = 0; i < recycled.count(); ++i) {
         this->addRecycledResource(recycled[i]);
@@ -289,9 +338,13 @@ void GrVkCommandBuffer::bindDescriptorSets(const GrVkGpu* gpu,
 
 void GrVkCommandBuffer::bindPipeline(const GrVkGpu* gpu, const GrVkPipeline* pipeline) {
     SkASSERT(fIsActive);
-    GR_VK_CALL(gpu->vkInterface(), CmdBindPipeline(fCmdBuffer,
-                                                   VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                                   pipeline->pipeline()));
+    const GrVkInterface* iface = gpu->vkInterface();
+    VkPipeline vkPipeline = pipeline->pipeline();
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdBindPipeline(cmdBuffer,
+                                          VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                          vkPipeline));
+    });
     this->addResource(pipeline);
 }
 
@@ -303,12 +356,15 @@ void GrVkCommandBuffer::drawIndexed(const GrVkGpu* gpu,
                                     uint32_t firstInstance) const {
     SkASSERT(fIsActive);
     SkASSERT(fActiveRenderPass);
-    GR_VK_CALL(gpu->vkInterface(), CmdDrawIndexed(fCmdBuffer,
-                                                  indexCount,
-                                                  instanceCount,
-                                                  firstIndex,
-                                                  vertexOffset,
-                                                  firstInstance));
+    const GrVkInterface* iface = gpu->vkInterface();
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdDrawIndexed(cmdBuffer,
+                                         indexCount,
+                                         instanceCount,
+                                         firstIndex,
+                                         vertexOffset,
+                                         firstInstance));
+    });
 }
 
 void GrVkCommandBuffer::draw(const GrVkGpu* gpu,
@@ -318,11 +374,14 @@ void GrVkCommandBuffer::draw(const GrVkGpu* gpu,
                              uint32_t firstInstance) const {
     SkASSERT(fIsActive);
     SkASSERT(fActiveRenderPass);
-    GR_VK_CALL(gpu->vkInterface(), CmdDraw(fCmdBuffer,
-                                           vertexCount,
-                                           instanceCount,
-                                           firstVertex,
-                                           firstInstance));
+    const GrVkInterface* iface = gpu->vkInterface();
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdDraw(cmdBuffer,
+                                  vertexCount,
+                                  instanceCount,
+                                  firstVertex,
+                                  firstInstance));
+    });
 }
 
 void GrVkCommandBuffer::setViewport(const GrVkGpu* gpu,
@@ -332,11 +391,12 @@ void GrVkCommandBuffer::setViewport(const GrVkGpu* gpu,
     SkASSERT(fIsActive);
     SkASSERT(1 == viewportCount);
     if (memcmp(viewports, &fCachedViewport, sizeof(VkViewport))) {
-        GR_VK_CALL(gpu->vkInterface(), CmdSetViewport(fCmdBuffer,
-                                                      firstViewport,
-                                                      viewportCount,
-                                                      viewports));
         fCachedViewport = viewports[0];
+        const GrVkInterface* iface = gpu->vkInterface();
+        VkViewport viewport = viewports[0];
+        this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+            GR_VK_CALL(iface, CmdSetViewport(cmdBuffer, firstViewport, 1, &viewport));
+        });
     }
 }
 
@@ -347,11 +407,12 @@ void GrVkCommandBuffer::setScissor(const GrVkGpu* gpu,
     SkASSERT(fIsActive);
     SkASSERT(1 == scissorCount);
     if (memcmp(scissors, &fCachedScissor, sizeof(VkRect2D))) {
-        GR_VK_CALL(gpu->vkInterface(), CmdSetScissor(fCmdBuffer,
-                                                     firstScissor,
-                                                     scissorCount,
-                                                     scissors));
         fCachedScissor = scissors[0];
+        const GrVkInterface* iface = gpu->vkInterface();
+        VkRect2D scissor = scissors[0];
+        this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+            GR_VK_CALL(iface, CmdSetScissor(cmdBuffer, firstScissor, 1, &scissor));
+        });
     }
 }
 
@@ -359,8 +420,12 @@ void GrVkCommandBuffer::setBlendConstants(const GrVkGpu* gpu,
                                           const float blendConstants[4]) {
     SkASSERT(fIsActive);
     if (memcmp(blendConstants, fCachedBlendConstant, 4 * sizeof(float))) {
-        GR_VK_CALL(gpu->vkInterface(), CmdSetBlendConstants(fCmdBuffer, blendConstants));
         memcpy(fCachedBlendConstant, blendConstants, 4 * sizeof(float));
+        const GrVkInterface* iface = gpu->vkInterface();
+        const float* constants = this->keepForCommand(blendConstants, 4);
+        this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+            GR_VK_CALL(iface, CmdSetBlendConstants(cmdBuffer, constants));
+        });
     }
 }
 
@@ -409,6 +474,10 @@ void GrVkPrimaryCommandBuffer::begin(const GrVkGpu* gpu) {
 void GrVkPrimaryCommandBuffer::end(GrVkGpu* gpu) {
     SkASSERT(fIsActive);
     SkASSERT(!fActiveRenderPass);
+    if (this->defersCommands()) {
+        // Any secondary command buffers this executes must have been recorded by now.
+        this->replayDeferredCommands();
+    }
     GR_VK_CALL_ERRCHECK(gpu->vkInterface(), EndCommandBuffer(fCmdBuffer));
     for (int i = 0; i < fTrackedRecordingResources.count(); ++i) {
         fTrackedRecordingResources[i]->unref(gpu);
@@ -440,12 +509,15 @@ void GrVkPrimaryCommandBuffer::beginRenderPass(const GrVkGpu* gpu,
     beginInfo.framebuffer = target.framebuffer()->framebuffer();
     beginInfo.renderArea = renderArea;
     beginInfo.clearValueCount = renderPass->clearValueCount();
-    beginInfo.pClearValues = clearValues;
+    beginInfo.pClearValues = this->keepForCommand(clearValues, beginInfo.clearValueCount);
 
     VkSubpassContents contents = forSecondaryCB ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
                                                 : VK_SUBPASS_CONTENTS_INLINE;
 
-    GR_VK_CALL(gpu->vkInterface(), CmdBeginRenderPass(fCmdBuffer, &beginInfo, contents));
+    const GrVkInterface* iface = gpu->vkInterface();
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdBeginRenderPass(cmdBuffer, &beginInfo, contents));
+    });
     fActiveRenderPass = renderPass;
     this->addResource(renderPass);
     target.addResources(*this);
@@ -454,7 +526,10 @@ void GrVkPrimaryCommandBuffer::beginRenderPass(const GrVkGpu* gpu,
 void GrVkPrimaryCommandBuffer::endRenderPass(const GrVkGpu* gpu) {
     SkASSERT(fIsActive);
     SkASSERT(fActiveRenderPass);
-    GR_VK_CALL(gpu->vkInterface(), CmdEndRenderPass(fCmdBuffer));
+    const GrVkInterface* iface = gpu->vkInterface();
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdEndRenderPass(cmdBuffer));
+    });
     fActiveRenderPass = nullptr;
 }
 
@@ -469,7 +544,19 @@ void GrVkPrimaryCommandBuffer::executeCommands(const GrVkGpu* gpu,
     SkASSERT(fActiveRenderPass);
     SkASSERT(fActiveRenderPass->isCompatible(*buffer->fActiveRenderPass));
 
-    GR_VK_CALL(gpu->vkInterface(), CmdExecuteCommands(fCmdBuffer, 1, &buffer->fCmdBuffer));
+    if (buffer->recordingLane() >= 0 && !this->defersCommands()) {
+        // The secondary command buffer is still being recorded, so hold off on issuing this and
+        // anything after it until we end.
+        this->deferCommands();
+    }
+    const GrVkInterface* iface = gpu->vkInterface();
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        // A command buffer from a recording lane is left without a VkCommandBuffer if we failed
+        // to allocate one.
+        if (VK_NULL_HANDLE != buffer->fCmdBuffer) {
+            GR_VK_CALL(iface, CmdExecuteCommands(cmdBuffer, 1, &buffer->fCmdBuffer));
+        }
+    });
     buffer->ref();
     fSecondaryCommandBuffers.push_back(buffer);
     // When executing a secondary command buffer all state (besides render pass state) becomes
@@ -638,13 +725,19 @@ void GrVkPrimaryCommandBuffer::copyImage(const GrVkGpu* gpu,
     SkASSERT(!fActiveRenderPass);
     this->addResource(srcImage->resource());
     this->addResource(dstImage->resource());
-    GR_VK_CALL(gpu->vkInterface(), CmdCopyImage(fCmdBuffer,
-                                                srcImage->image(),
-                                                srcLayout,
-                                                dstImage->image(),
-                                                dstLayout,
-                                                copyRegionCount,
-                                                copyRegions));
+    const GrVkInterface* iface = gpu->vkInterface();
+    VkImage vkSrcImage = srcImage->image();
+    VkImage vkDstImage = dstImage->image();
+    copyRegions = this->keepForCommand(copyRegions, copyRegionCount);
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdCopyImage(cmdBuffer,
+                                       vkSrcImage,
+                                       srcLayout,
+                                       vkDstImage,
+                                       dstLayout,
+                                       copyRegionCount,
+                                       copyRegions));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::blitImage(const GrVkGpu* gpu,
@@ -661,14 +754,18 @@ void GrVkPrimaryCommandBuffer::blitImage(const GrVkGpu* gpu,
     SkASSERT(!fActiveRenderPass);
     this->addResource(srcResource);
     this->addResource(dstResource);
-    GR_VK_CALL(gpu->vkInterface(), CmdBlitImage(fCmdBuffer,
-                                                srcImage,
-                                                srcLayout,
-                                                dstImage,
-                                                dstLayout,
-                                                blitRegionCount,
-                                                blitRegions,
-                                                filter));
+    const GrVkInterface* iface = gpu->vkInterface();
+    blitRegions = this->keepForCommand(blitRegions, blitRegionCount);
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdBlitImage(cmdBuffer,
+                                       srcImage,
+                                       srcLayout,
+                                       dstImage,
+                                       dstLayout,
+                                       blitRegionCount,
+                                       blitRegions,
+                                       filter));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::blitImage(const GrVkGpu* gpu,
@@ -700,12 +797,18 @@ void GrVkPrimaryCommandBuffer::copyImageToBuffer(const GrVkGpu* gpu,
     SkASSERT(!fActiveRenderPass);
     this->addResource(srcImage->resource());
     this->addResource(dstBuffer->resource());
-    GR_VK_CALL(gpu->vkInterface(), CmdCopyImageToBuffer(fCmdBuffer,
-                                                        srcImage->image(),
-                                                        srcLayout,
-                                                        dstBuffer->buffer(),
-                                                        copyRegionCount,
-                                                        copyRegions));
+    const GrVkInterface* iface = gpu->vkInterface();
+    VkImage vkSrcImage = srcImage->image();
+    VkBuffer vkDstBuffer = dstBuffer->buffer();
+    copyRegions = this->keepForCommand(copyRegions, copyRegionCount);
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdCopyImageToBuffer(cmdBuffer,
+                                               vkSrcImage,
+                                               srcLayout,
+                                               vkDstBuffer,
+                                               copyRegionCount,
+                                               copyRegions));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::copyBufferToImage(const GrVkGpu* gpu,
@@ -718,12 +821,18 @@ void GrVkPrimaryCommandBuffer::copyBufferToImage(const GrVkGpu* gpu,
     SkASSERT(!fActiveRenderPass);
     this->addResource(srcBuffer->resource());
     this->addResource(dstImage->resource());
-    GR_VK_CALL(gpu->vkInterface(), CmdCopyBufferToImage(fCmdBuffer,
-                                                        srcBuffer->buffer(),
-                                                        dstImage->image(),
-                                                        dstLayout,
-                                                        copyRegionCount,
-                                                        copyRegions));
+    const GrVkInterface* iface = gpu->vkInterface();
+    VkBuffer vkSrcBuffer = srcBuffer->buffer();
+    VkImage vkDstImage = dstImage->image();
+    copyRegions = this->keepForCommand(copyRegions, copyRegionCount);
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdCopyBufferToImage(cmdBuffer,
+                                               vkSrcBuffer,
+                                               vkDstImage,
+                                               dstLayout,
+                                               copyRegionCount,
+                                               copyRegions));
+    });
 }
 
 
@@ -746,11 +855,17 @@ void GrVkPrimaryCommandBuffer::copyBuffer(GrVkGpu* gpu,
 #endif
     this->addResource(srcBuffer->resource());
     this->addResource(dstBuffer->resource());
-    GR_VK_CALL(gpu->vkInterface(), CmdCopyBuffer(fCmdBuffer,
-                                                 srcBuffer->buffer(),
-                                                 dstBuffer->buffer(),
-                                                 regionCount,
-                                                 regions));
+    const GrVkInterface* iface = gpu->vkInterface();
+    VkBuffer vkSrcBuffer = srcBuffer->buffer();
+    VkBuffer vkDstBuffer = dstBuffer->buffer();
+    regions = this->keepForCommand(regions, regionCount);
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdCopyBuffer(cmdBuffer,
+                                        vkSrcBuffer,
+                                        vkDstBuffer,
+                                        regionCount,
+                                        regions));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::updateBuffer(GrVkGpu* gpu,
@@ -765,11 +880,16 @@ void GrVkPrimaryCommandBuffer::updateBuffer(GrVkGpu* gpu,
     SkASSERT(dataSize <= 65536);
     SkASSERT(0 == (dataSize & 0x03));    // four byte aligned
     this->addResource(dstBuffer->resource());
-    GR_VK_CALL(gpu->vkInterface(), CmdUpdateBuffer(fCmdBuffer,
-                                                   dstBuffer->buffer(),
-                                                   dstOffset,
-                                                   dataSize,
-                                                   (const uint32_t*) data));
+    const GrVkInterface* iface = gpu->vkInterface();
+    VkBuffer vkDstBuffer = dstBuffer->buffer();
+    const uint32_t* words = this->keepForCommand((const uint32_t*) data, dataSize / 4);
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdUpdateBuffer(cmdBuffer,
+                                          vkDstBuffer,
+                                          dstOffset,
+                                          dataSize,
+                                          words));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::clearColorImage(const GrVkGpu* gpu,
@@ -780,12 +900,19 @@ void GrVkPrimaryCommandBuffer::clearColorImage(const GrVkGpu* gpu,
     SkASSERT(fIsActive);
     SkASSERT(!fActiveRenderPass);
     this->addResource(image->resource());
-    GR_VK_CALL(gpu->vkInterface(), CmdClearColorImage(fCmdBuffer,
-                                                      image->image(),
-                                                      image->currentLayout(),
-                                                      color,
-                                                      subRangeCount,
-                                                      subRanges));
+    const GrVkInterface* iface = gpu->vkInterface();
+    VkImage vkImage = image->image();
+    VkImageLayout layout = image->currentLayout();
+    color = this->keepForCommand(color, 1);
+    subRanges = this->keepForCommand(subRanges, subRangeCount);
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdClearColorImage(cmdBuffer,
+                                             vkImage,
+                                             layout,
+                                             color,
+                                             subRangeCount,
+                                             subRanges));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::clearDepthStencilImage(const GrVkGpu* gpu,
@@ -796,12 +923,19 @@ void GrVkPrimaryCommandBuffer::clearDepthStencilImage(const GrVkGpu* gpu,
     SkASSERT(fIsActive);
     SkASSERT(!fActiveRenderPass);
     this->addResource(image->resource());
-    GR_VK_CALL(gpu->vkInterface(), CmdClearDepthStencilImage(fCmdBuffer,
-                                                             image->image(),
-                                                             image->currentLayout(),
-                                                             color,
-                                                             subRangeCount,
-                                                             subRanges));
+    const GrVkInterface* iface = gpu->vkInterface();
+    VkImage vkImage = image->image();
+    VkImageLayout layout = image->currentLayout();
+    color = this->keepForCommand(color, 1);
+    subRanges = this->keepForCommand(subRanges, subRangeCount);
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdClearDepthStencilImage(cmdBuffer,
+                                                    vkImage,
+                                                    layout,
+                                                    color,
+                                                    subRangeCount,
+                                                    subRanges));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::resolveImage(GrVkGpu* gpu,
@@ -815,13 +949,21 @@ void GrVkPrimaryCommandBuffer::resolveImage(GrVkGpu* gpu,
     this->addResource(srcImage.resource());
     this->addResource(dstImage.resource());
 
-    GR_VK_CALL(gpu->vkInterface(), CmdResolveImage(fCmdBuffer,
-                                                   srcImage.image(),
-                                                   srcImage.currentLayout(),
-                                                   dstImage.image(),
-                                                   dstImage.currentLayout(),
-                                                   regionCount,
-                                                   regions));
+    const GrVkInterface* iface = gpu->vkInterface();
+    VkImage vkSrcImage = srcImage.image();
+    VkImageLayout srcLayout = srcImage.currentLayout();
+    VkImage vkDstImage = dstImage.image();
+    VkImageLayout dstLayout = dstImage.currentLayout();
+    regions = this->keepForCommand(regions, regionCount);
+    this->recordCommand([=](VkCommandBuffer cmdBuffer) {
+        GR_VK_CALL(iface, CmdResolveImage(cmdBuffer,
+                                          vkSrcImage,
+                                          srcLayout,
+                                          vkDstImage,
+                                          dstLayout,
+                                          regionCount,
+                                          regions));
+    });
 }
 
 void GrVkPrimaryCommandBuffer::onFreeGPUData(GrVkGpu* gpu) const {
@@ -871,43 +1013,93 @@ GrVkSecondaryCommandBuffer* GrVkSecondaryCommandBuffer::Create(VkCommandBuffer c
     return new GrVkSecondaryCommandBuffer(cmdBuffer, nullptr);
 }
 
+GrVkSecondaryCommandBuffer* GrVkSecondaryCommandBuffer::CreateForLane(GrVkCommandPool* cmdPool,
+                                                                      int lane) {
+    SkASSERT(cmdPool);
+    SkASSERT(lane >= 0 && lane < GrVkCommandPool::kRecordingLaneCount);
+    return new GrVkSecondaryCommandBuffer(VK_NULL_HANDLE, cmdPool, lane);
+}
+
+VkCommandPool GrVkSecondaryCommandBuffer::vkCommandPool() const {
+    return fRecordingLane >= 0 ? fCmdPool->recordingLanePool(fRecordingLane)
+                               : fCmdPool->vkCommandPool();
+}
+
+static void begin_secondary_command_buffer(const GrVkGpu* gpu, VkCommandBuffer cmdBuffer,
+                                           VkFramebuffer framebuffer, VkRenderPass renderPass) {
+    VkCommandBufferInheritanceInfo inheritanceInfo;
+    memset(&inheritanceInfo, 0, sizeof(VkCommandBufferInheritanceInfo));
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.pNext = nullptr;
+    inheritanceInfo.renderPass = renderPass;
+    inheritanceInfo.subpass = 0; // Currently only using 1 subpass for each render pass
+    inheritanceInfo.framebuffer = framebuffer;
+    inheritanceInfo.occlusionQueryEnable = false;
+    inheritanceInfo.queryFlags = 0;
+    inheritanceInfo.pipelineStatistics = 0;
+
+    VkCommandBufferBeginInfo cmdBufferBeginInfo;
+    memset(&cmdBufferBeginInfo, 0, sizeof(VkCommandBufferBeginInfo));
+    cmdBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    cmdBufferBeginInfo.pNext = nullptr;
+    cmdBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT |
+            VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    cmdBufferBeginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    GR_VK_CALL_ERRCHECK(gpu->vkInterface(), BeginCommandBuffer(cmdBuffer, &cmdBufferBeginInfo));
+}
+
 void GrVkSecondaryCommandBuffer::begin(const GrVkGpu* gpu, const GrVkFramebuffer* framebuffer,
                                        const GrVkRenderPass* compatibleRenderPass) {
     SkASSERT(!fIsActive);
     SkASSERT(compatibleRenderPass);
     fActiveRenderPass = compatibleRenderPass;
-
-    if (!this->isWrapped()) {
-        VkCommandBufferInheritanceInfo inheritanceInfo;
-        memset(&inheritanceInfo, 0, sizeof(VkCommandBufferInheritanceInfo));
-        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
-        inheritanceInfo.pNext = nullptr;
-        inheritanceInfo.renderPass = fActiveRenderPass->vkRenderPass();
-        inheritanceInfo.subpass = 0; // Currently only using 1 subpass for each render pass
-        inheritanceInfo.framebuffer = framebuffer ? framebuffer->framebuffer() : VK_NULL_HANDLE;
-        inheritanceInfo.occlusionQueryEnable = false;
-        inheritanceInfo.queryFlags = 0;
-        inheritanceInfo.pipelineStatistics = 0;
-
-        VkCommandBufferBeginInfo cmdBufferBeginInfo;
-        memset(&cmdBufferBeginInfo, 0, sizeof(VkCommandBufferBeginInfo));
-        cmdBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-        cmdBufferBeginInfo.pNext = nullptr;
-        cmdBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT |
-                VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-        cmdBufferBeginInfo.pInheritanceInfo = &inheritanceInfo;
-
-        GR_VK_CALL_ERRCHECK(gpu->vkInterface(), BeginCommandBuffer(fCmdBuffer,
-                                                                   &cmdBufferBeginInfo));
+    fFramebuffer = framebuffer ? framebuffer->framebuffer() : VK_NULL_HANDLE;
+
+    if (fRecordingLane >= 0) {
+        // The Vulkan begin happens in recordDeferredCommands().
+        this->deferCommands();
+    } else if (!this->isWrapped()) {
+        begin_secondary_command_buffer(gpu, fCmdBuffer, fFramebuffer,
+                                       fActiveRenderPass->vkRenderPass());
     }
     fIsActive = true;
 }
 
 void GrVkSecondaryCommandBuffer::end(GrVkGpu* gpu) {
     SkASSERT(fIsActive);
-    if (!this->isWrapped()) {
+    if (!this->isWrapped() && fRecordingLane < 0) {
         GR_VK_CALL_ERRCHECK(gpu->vkInterface(), EndCommandBuffer(fCmdBuffer));
     }
     this->invalidateState();
     fIsActive = false;
 }
+
+void GrVkSecondaryCommandBuffer::recordDeferredCommands(const GrVkGpu* gpu) {
+    SkASSERT(fRecordingLane >= 0);
+    SkASSERT(!fIsActive);
+    SkASSERT(this->defersCommands());
+
+    if (VK_NULL_HANDLE == fCmdBuffer) {
+        const VkCommandBufferAllocateInfo cmdInfo = {
+            VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,   // sType
+            nullptr,                                          // pNext
+            this->vkCommandPool(),                            // commandPool
+            VK_COMMAND_BUFFER_LEVEL_SECONDARY,                // level
+            1                                                 // bufferCount
+        };
+        VkResult err = GR_VK_CALL(gpu->vkInterface(), AllocateCommandBuffers(gpu->device(),
+                                                                             &cmdInfo,
+                                                                             &fCmdBuffer));
+        if (err) {
+            fCmdBuffer = VK_NULL_HANDLE;
+            fDeferredCommands.reset();
+            return;
+        }
+    }
+
+    begin_secondary_command_buffer(gpu, fCmdBuffer, fFramebuffer,
+                                   fActiveRenderPass->vkRenderPass());
+    this->replayDeferredCommands();
+    GR_VK_CALL_ERRCHECK(gpu->vkInterface(), EndCommandBuffer(fCmdBuffer));
+}
@@ -12,8 +12,11 @@
 #include "GrVkResource.h"
 #include "GrVkSemaphore.h"
 #include "GrVkUtil.h"
+#include "SkArenaAlloc.h"
 #include "vk/GrVkTypes.h"
 
+#include <functional>
+
 class GrVkBuffer;
 class GrVkFramebuffer;
 class GrVkIndexBuffer;
@@ -149,6 +152,38 @@ protected:
             return fCmdPool == nullptr;
         }
 
+        // Issues a Vulkan command on fCmdBuffer. If this command buffer is deferring commands the
+        // call is saved instead, and issued by replayDeferredCommands().
+        template <typename Fn>
+        void recordCommand(Fn&& fn) const {
+            if (fDeferredCommands) {
+                fDeferredCommands->fCommands.emplace_back(std::forward<Fn>(fn));
+            } else {
+                fn(fCmdBuffer);
+            }
+        }
+
+        // Returns a pointer to 'count' elements equal to 'data' that stays valid until any deferred
+        // command using it has been replayed.
+        template <typename T>
+        const T* keepForCommand(const T* data, uint32_t count) const {
+            if (!fDeferredCommands || !data || !count) {
+                return data;
+            }
+            T* copy = fDeferredCommands->fData.makeArrayDefault<T>(count);
+            memcpy(copy, data, count * sizeof(T));
+            return copy;
+        }
+
+        void deferCommands();
+        bool defersCommands() const { return SkToBool(fDeferredCommands); }
+        void replayDeferredCommands();
+
+        struct DeferredCommands {
+            SkTArray<std::function<void(VkCommandBuffer)>> fCommands;
+            SkArenaAlloc                                   fData{1024};
+        };
+
         SkTDArray<const GrVkResource*>          fTrackedResources;
         SkTDArray<const GrVkRecycledResource*>  fTrackedRecycledResources;
         SkTDArray<const GrVkResource*>          fTrackedRecordingResources;
@@ -168,10 +203,15 @@ protected:
         // it's guaranteed to outlive us.
         GrVkCommandPool*          fCmdPool;
 
+        // Non-null while commands are being saved rather than issued to fCmdBuffer.
+        std::unique_ptr<DeferredCommands> fDeferredCommands;
+
 private:
     static const int kInitialTrackedResourcesCount = 32;
 
     void freeGPUData(GrVkGpu* gpu) const final override;
+    // The VkCommandPool that fCmdBuffer was allocated from.
+    virtual VkCommandPool vkCommandPool() const;
     virtual void onFreeGPUData(GrVkGpu* gpu) const = 0;
     void abandonGPUData() const final override;
     virtual void onAbandonGPUData() const = 0;
@@ -336,12 +376,27 @@ public:
     static GrVkSecondaryCommandBuffer* Create(const GrVkGpu* gpu, GrVkCommandPool* cmdPool);
     // Used for wrapping an external secondary command buffer.
     static GrVkSecondaryCommandBuffer* Create(VkCommandBuffer externalSecondaryCB);
+    // Creates a command buffer that saves its commands as they are recorded. They are only issued
+    // to Vulkan by recordDeferredCommands(), which may be called on another thread and allocates
+    // the VkCommandBuffer from the given recording lane of the command pool.
+    static GrVkSecondaryCommandBuffer* CreateForLane(GrVkCommandPool* cmdPool, int lane);
 
     void begin(const GrVkGpu* gpu, const GrVkFramebuffer* framebuffer,
                const GrVkRenderPass* compatibleRenderPass);
     void end(GrVkGpu* gpu);
 
-    VkCommandBuffer vkCommandBuffer() { return fCmdBuffer; }
+    // Only valid for command buffers that don't belong to a recording lane.
+    VkCommandBuffer vkCommandBuffer() {
+        SkASSERT(fRecordingLane < 0);
+        return fCmdBuffer;
+    }
+
+    // The GrVkCommandPool recording lane this uses, or -1 if its commands are issued directly.
+    int recordingLane() const { return fRecordingLane; }
+
+    // Issues the commands saved between begin() and end() to Vulkan. It is only legal to call this
+    // on command buffers from a recording lane, while holding that lane's lock.
+    void recordDeferredCommands(const GrVkGpu* gpu);
 
 #ifdef SK_TRACE_VK_RESOURCES
     void dumpInfo() const override {
@@ -350,13 +405,20 @@ public:
 #endif
 
 private:
-    explicit GrVkSecondaryCommandBuffer(VkCommandBuffer cmdBuffer, GrVkCommandPool* cmdPool)
-        : INHERITED(cmdBuffer, cmdPool) {}
+    explicit GrVkSecondaryCommandBuffer(VkCommandBuffer cmdBuffer, GrVkCommandPool* cmdPool,
+                                        int recordingLane = -1)
+        : INHERITED(cmdBuffer, cmdPool)
+        , fRecordingLane(recordingLane) {}
+
+    VkCommandPool vkCommandPool() const override;
 
     void onFreeGPUData(GrVkGpu* gpu) const override {}
 
     void onAbandonGPUData() const override {}
 
+    int           fRecordingLane;
+    VkFramebuffer fFramebuffer = VK_NULL_HANDLE;
+
     friend class GrVkPrimaryCommandBuffer;
 
     typedef GrVkCommandBuffer INHERITED;
@@ -11,7 +11,7 @@
 #include "GrVkCommandBuffer.h"
 #include "GrVkGpu.h"
 
-GrVkCommandPool* GrVkCommandPool::Create(const GrVkGpu* gpu) {
+static VkResult create_vk_command_pool(const GrVkGpu* gpu, VkCommandPool* pool) {
     const VkCommandPoolCreateInfo cmdPoolInfo = {
         VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,      // sType
         nullptr,                                         // pNext
@@ -19,9 +19,14 @@ GrVkCommandPool* GrVkCommandPool::Create(const GrVkGpu* gpu) {
         VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT, // CmdPoolCreateFlags
         gpu->queueIndex(),                              // queueFamilyIndex
     };
+    return GR_VK_CALL(gpu->vkInterface(), CreateCommandPool(gpu->device(), &cmdPoolInfo,
+                                                            nullptr, pool));
+}
+
+GrVkCommandPool* GrVkCommandPool::Create(const GrVkGpu* gpu) {
     VkCommandPool pool;
-    GR_VK_CALL_ERRCHECK(gpu->vkInterface(), CreateCommandPool(gpu->device(), &cmdPoolInfo,
-                                                               nullptr, &pool));
+    SkDEBUGCODE(VkResult err =) create_vk_command_pool(gpu, &pool);
+    SkASSERT(VK_SUCCESS == err);
     return new GrVkCommandPool(gpu, pool);
 }
 
@@ -39,9 +44,32 @@ GrVkSecondaryCommandBuffer* GrVkCommandPool::findOrCreateSecondaryCommandBuffer(
     return GrVkSecondaryCommandBuffer::Create(gpu, this);
 }
 
+GrVkSecondaryCommandBuffer* GrVkCommandPool::findOrCreateLaneSecondaryCommandBuffer(GrVkGpu* gpu,
+                                                                                   int lane) {
+    SkASSERT(lane >= 0 && lane < kRecordingLaneCount);
+    RecordingLane& recordingLane = fRecordingLanes[lane];
+    if (recordingLane.fAvailableSecondaryBuffers.count()) {
+        GrVkSecondaryCommandBuffer* result = recordingLane.fAvailableSecondaryBuffers.back();
+        recordingLane.fAvailableSecondaryBuffers.pop_back();
+        return result;
+    }
+    // The VkCommandPool is created here, on the thread that owns this GrVkCommandPool, so that the
+    // recording threads only ever read it.
+    if (VK_NULL_HANDLE == recordingLane.fCommandPool &&
+        VK_SUCCESS != create_vk_command_pool(gpu, &recordingLane.fCommandPool)) {
+        recordingLane.fCommandPool = VK_NULL_HANDLE;
+        return nullptr;
+    }
+    return GrVkSecondaryCommandBuffer::CreateForLane(this, lane);
+}
+
 void GrVkCommandPool::recycleSecondaryCommandBuffer(GrVkSecondaryCommandBuffer* buffer) {
     SkASSERT(buffer->commandPool() == this);
-    fAvailableSecondaryBuffers.push_back(buffer);
+    if (buffer->recordingLane() >= 0) {
+        fRecordingLanes[buffer->recordingLane()].fAvailableSecondaryBuffers.push_back(buffer);
+    } else {
+        fAvailableSecondaryBuffers.push_back(buffer);
+    }
 }
 
 void GrVkCommandPool::close() {
@@ -53,6 +81,12 @@ void GrVkCommandPool::reset(GrVkGpu* gpu) {
     fOpen = true;
     fPrimaryCommandBuffer->recycleSecondaryCommandBuffers();
     GR_VK_CALL_ERRCHECK(gpu->vkInterface(), ResetCommandPool(gpu->device(), fCommandPool, 0));
+    for (const RecordingLane& lane : fRecordingLanes) {
+        if (VK_NULL_HANDLE != lane.fCommandPool) {
+            GR_VK_CALL_ERRCHECK(gpu->vkInterface(), ResetCommandPool(gpu->device(),
+                                                                     lane.fCommandPool, 0));
+        }
+    }
 }
 
 void GrVkCommandPool::releaseResources(GrVkGpu* gpu) {
@@ -61,6 +95,11 @@ void GrVkCommandPool::releaseResources(GrVkGpu* gpu) {
     for (GrVkSecondaryCommandBuffer* buffer : fAvailableSecondaryBuffers) {
         buffer->releaseResources(gpu);
     }
+    for (const RecordingLane& lane : fRecordingLanes) {
+        for (GrVkSecondaryCommandBuffer* buffer : lane.fAvailableSecondaryBuffers) {
+            buffer->releaseResources(gpu);
+        }
+    }
 }
 
 void GrVkCommandPool::abandonGPUData() const {
@@ -69,6 +108,12 @@ void GrVkCommandPool::abandonGPUData() const {
         SkASSERT(buffer->unique());
         buffer->unrefAndAbandon();
     }
+    for (const RecordingLane& lane : fRecordingLanes) {
+        for (GrVkSecondaryCommandBuffer* buffer : lane.fAvailableSecondaryBuffers) {
+            SkASSERT(buffer->unique());
+            buffer->unrefAndAbandon();
+        }
+    }
 }
 
 void GrVkCommandPool::freeGPUData(GrVkGpu* gpu) const {
@@ -77,6 +122,16 @@ void GrVkCommandPool::freeGPUData(GrVkGpu* gpu) const {
         SkASSERT(buffer->unique());
         buffer->unref(gpu);
     }
+    for (const RecordingLane& lane : fRecordingLanes) {
+        for (GrVkSecondaryCommandBuffer* buffer : lane.fAvailableSecondaryBuffers) {
+            SkASSERT(buffer->unique());
+            buffer->unref(gpu);
+        }
+        if (VK_NULL_HANDLE != lane.fCommandPool) {
+            GR_VK_CALL(gpu->vkInterface(),
+                       DestroyCommandPool(gpu->device(), lane.fCommandPool, nullptr));
+        }
+    }
     if (fCommandPool != VK_NULL_HANDLE) {
         GR_VK_CALL(gpu->vkInterface(),
                    DestroyCommandPool(gpu->device(), fCommandPool, nullptr));
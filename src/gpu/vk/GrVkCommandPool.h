@@ -19,6 +19,10 @@ class GrVkGpu;
 
 class GrVkCommandPool : public GrVkResource {
 public:
+    // The number of extra VkCommandPools that secondary command buffers can be recorded from on
+    // other threads. Each lane is only used by one thread at a time.
+    static constexpr int kRecordingLaneCount = 4;
+
     static GrVkCommandPool* Create(const GrVkGpu* gpu);
 
     VkCommandPool vkCommandPool() const {
@@ -33,6 +37,16 @@ public:
 
     GrVkSecondaryCommandBuffer* findOrCreateSecondaryCommandBuffer(GrVkGpu* gpu);
 
+    // Returns a secondary command buffer that saves its commands to be recorded on the given lane
+    // by GrVkSecondaryCommandBuffer::recordDeferredCommands(). Returns null if the lane's
+    // VkCommandPool can't be created.
+    GrVkSecondaryCommandBuffer* findOrCreateLaneSecondaryCommandBuffer(GrVkGpu* gpu, int lane);
+
+    VkCommandPool recordingLanePool(int lane) const {
+        SkASSERT(lane >= 0 && lane < kRecordingLaneCount);
+        return fRecordingLanes[lane].fCommandPool;
+    }
+
     void recycleSecondaryCommandBuffer(GrVkSecondaryCommandBuffer* buffer);
 
     // marks that we are finished with this command pool; it is not legal to continue creating or
@@ -65,6 +79,14 @@ private:
 
     // Array of available secondary command buffers that are not in flight
     SkSTArray<4, GrVkSecondaryCommandBuffer*, true> fAvailableSecondaryBuffers;
+
+    // These are created the first time a lane is used. The secondary command buffers in a lane
+    // are allocated from, and reset with, its VkCommandPool.
+    struct RecordingLane {
+        VkCommandPool                                   fCommandPool = VK_NULL_HANDLE;
+        SkSTArray<4, GrVkSecondaryCommandBuffer*, true> fAvailableSecondaryBuffers;
+    };
+    RecordingLane fRecordingLanes[kRecordingLaneCount];
 };
 
 #endif
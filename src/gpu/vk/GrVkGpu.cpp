@@ -36,7 +36,9 @@
 #include "GrVkVertexBuffer.h"
 #include "SkConvertPixels.h"
 #include "SkMipMap.h"
+#include "SkMutex.h"
 #include "SkSLCompiler.h"
+#include "SkTaskGroup.h"
 #include "SkTo.h"
 
 #include "vk/GrVkExtensions.h"
@@ -152,11 +154,12 @@ GrVkGpu::GrVkGpu(GrContext* context, const GrContextOptions& options,
 
     if (!fMemoryAllocator) {
         // We were not given a memory allocator at creation
-        fMemoryAllocator.reset(new GrVkAMDMemoryAllocator(backendContext.fPhysicalDevice,
-                                                          fDevice, fInterface));
+        fMemoryAllocator.reset(new GrVkAMDMemoryAllocator(
+                backendContext.fPhysicalDevice, fDevice, fInterface,
+                options.fVulkanMemoryBlockSize, options.fVulkanDedicatedAllocationThreshold));
     }
 
-    fCompiler = new SkSL::Compiler();
+    fCompilerPool.reset(new GrSkSLCompilerPool());
 
     if (backendContext.fDeviceFeatures2) {
         fVkCaps.reset(new GrVkCaps(options, this->vkInterface(), backendContext.fPhysicalDevice,
@@ -198,9 +201,60 @@ GrVkGpu::GrVkGpu(GrContext* context, const GrContextOptions& options,
     fCurrentCmdBuffer = fCmdPool->getPrimaryCommandBuffer();
     SkASSERT(fCurrentCmdBuffer);
     fCurrentCmdBuffer->begin(this);
+
+    if (options.fExecutor && options.fParallelVulkanRecording) {
+        fRecordingTaskGroup.reset(new SkTaskGroup(*options.fExecutor));
+        fRecordingLaneMutexes.reset(new SkMutex[GrVkCommandPool::kRecordingLaneCount]);
+    }
+}
+
+int GrVkGpu::nextRecordingLane() {
+    if (!fRecordingTaskGroup) {
+        return -1;
+    }
+    int lane = fNextRecordingLane;
+    fNextRecordingLane = (fNextRecordingLane + 1) % GrVkCommandPool::kRecordingLaneCount;
+    return lane;
+}
+
+void GrVkGpu::recordSecondaryCommandBuffers(int lane,
+                                            SkTArray<GrVkSecondaryCommandBuffer*> buffers) {
+    SkASSERT(fRecordingTaskGroup);
+    SkASSERT(lane >= 0 && lane < GrVkCommandPool::kRecordingLaneCount);
+    if (buffers.empty()) {
+        return;
+    }
+    for (GrVkSecondaryCommandBuffer* buffer : buffers) {
+        SkASSERT(buffer->recordingLane() == lane);
+        buffer->ref();
+        fRecordingCommandBuffers.push_back(buffer);
+    }
+    SkMutex* mutex = &fRecordingLaneMutexes[lane];
+    fRecordingTaskGroup->add([this, mutex, buffers] {
+        SkAutoMutexAcquire lock(mutex);
+        for (GrVkSecondaryCommandBuffer* buffer : buffers) {
+            buffer->recordDeferredCommands(this);
+        }
+    });
+}
+
+void GrVkGpu::finishRecordingSecondaryCommandBuffers(bool abandon) {
+    if (!fRecordingTaskGroup) {
+        return;
+    }
+    fRecordingTaskGroup->wait();
+    for (GrVkSecondaryCommandBuffer* buffer : fRecordingCommandBuffers) {
+        if (abandon) {
+            buffer->unrefAndAbandon();
+        } else {
+            buffer->unref(this);
+        }
+    }
+    fRecordingCommandBuffers.reset();
 }
 
 void GrVkGpu::destroyResources() {
+    this->finishRecordingSecondaryCommandBuffers(false);
     if (fCmdPool) {
         fCmdPool->getPrimaryCommandBuffer()->end(this);
         fCmdPool->close();
@@ -259,7 +313,6 @@ GrVkGpu::~GrVkGpu() {
     if (!fDisconnected) {
         this->destroyResources();
     }
-    delete fCompiler;
 }
 
 
@@ -269,6 +322,7 @@ void GrVkGpu::disconnect(DisconnectType type) {
         if (DisconnectType::kCleanup == type) {
             this->destroyResources();
         } else {
+            this->finishRecordingSecondaryCommandBuffers(true);
             if (fCmdPool) {
                 fCmdPool->unrefAndAbandon();
                 fCmdPool = nullptr;
@@ -319,6 +373,8 @@ GrGpuTextureCommandBuffer* GrVkGpu::getCommandBuffer(GrTexture* texture, GrSurfa
 void GrVkGpu::submitCommandBuffer(SyncQueue sync, GrGpuFinishedProc finishedProc,
                                   GrGpuFinishedContext finishedContext) {
     SkASSERT(fCurrentCmdBuffer);
+    // The primary command buffer may be waiting on secondary command buffers from other threads.
+    this->finishRecordingSecondaryCommandBuffers(false);
     fCurrentCmdBuffer->end(this);
     fCmdPool->close();
     fCurrentCmdBuffer->submitToQueue(this, fQueue, sync, fSemaphoresToSignal, fSemaphoresToWaitOn);
@@ -373,6 +429,9 @@ sk_sp<GrGpuBuffer> GrVkGpu::onCreateBuffer(size_t size, GrGpuBufferType type,
                      kStream_GrAccessPattern == accessPattern);
             buff = GrVkTransferBuffer::Make(this, size, GrVkBuffer::kCopyWrite_Type);
             break;
+        case GrGpuBufferType::kDrawIndirect:
+            // Only the GL backend issues indirect draws so far.
+            return nullptr;
         default:
             SK_ABORT("Unknown buffer type.");
             return nullptr;
@@ -876,8 +935,10 @@ bool GrVkGpu::uploadTexDataCompressed(GrVkTexture* tex, int left, int top, int w
             VkBufferImageCopy& region = regions.push_back();
             memset(&region, 0, sizeof(VkBufferImageCopy));
             region.bufferOffset = transferBuffer->offset() + individualMipOffsets[currentMipLevel];
-            region.bufferRowLength = currentWidth;
-            region.bufferImageHeight = currentHeight;
+            // The blocks are tightly packed. A row length of the level's width would not be a
+            // multiple of the block width for the smallest levels, which Vulkan requires.
+            region.bufferRowLength = 0;
+            region.bufferImageHeight = 0;
             region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, SkToU32(currentMipLevel), 0, 1 };
             region.imageOffset = { uploadLeft, uploadTop, 0 };
             region.imageExtent = { (uint32_t)currentWidth, (uint32_t)currentHeight, 1 };
@@ -2075,6 +2136,78 @@ bool GrVkGpu::onCopySurface(GrSurface* dst, GrSurfaceOrigin dstOrigin,
     return false;
 }
 
+bool GrVkGpu::onTransferPixelsFrom(GrSurface* surface, int left, int top, int width, int height,
+                                   GrColorType dstColorType, GrGpuBuffer* transferBuffer,
+                                   size_t offset) {
+    if (GrPixelConfigToColorType(surface->config()) != dstColorType) {
+        return false;
+    }
+    // The buffer is handed to the client as is, so the copy can't include extra rows and columns.
+    if (this->vkCaps().mustDoCopiesFromOrigin()) {
+        return false;
+    }
+
+    GrVkImage* image = nullptr;
+    GrVkRenderTarget* rt = static_cast<GrVkRenderTarget*>(surface->asRenderTarget());
+    if (rt) {
+        if (rt->wrapsSecondaryCommandBuffer()) {
+            return false;
+        }
+        switch (rt->getResolveType()) {
+            case GrVkRenderTarget::kCantResolve_ResolveType:
+                return false;
+            case GrVkRenderTarget::kAutoResolves_ResolveType:
+                break;
+            case GrVkRenderTarget::kCanResolve_ResolveType:
+                this->resolveRenderTargetNoFlush(rt);
+                break;
+            default:
+                SK_ABORT("Unknown resolve type");
+        }
+        image = rt;
+    } else {
+        image = static_cast<GrVkTexture*>(surface->asTexture());
+    }
+
+    // RGB_888x surfaces stored as R8G8B8_UNORM need the intermediate copy onReadPixels makes.
+    if (!image || image->imageFormat() == VK_FORMAT_R8G8B8_UNORM) {
+        return false;
+    }
+
+    image->setImageLayout(this,
+                          VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                          VK_ACCESS_TRANSFER_READ_BIT,
+                          VK_PIPELINE_STAGE_TRANSFER_BIT,
+                          false);
+
+    GrVkTransferBuffer* vkBuffer = static_cast<GrVkTransferBuffer*>(transferBuffer);
+
+    VkBufferImageCopy region;
+    memset(&region, 0, sizeof(VkBufferImageCopy));
+    region.bufferOffset = vkBuffer->offset() + offset;
+    region.bufferRowLength = 0; // Forces RowLength to be width.
+    region.bufferImageHeight = 0;
+    region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+    region.imageOffset = { left, top, 0 };
+    region.imageExtent = { (uint32_t)width, (uint32_t)height, 1 };
+
+    fCurrentCmdBuffer->copyImageToBuffer(this,
+                                         image,
+                                         VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                         vkBuffer,
+                                         1,
+                                         &region);
+
+    // make sure the copy to buffer has finished before the host reads it
+    vkBuffer->addMemoryBarrier(this,
+                               VK_ACCESS_TRANSFER_WRITE_BIT,
+                               VK_ACCESS_HOST_READ_BIT,
+                               VK_PIPELINE_STAGE_TRANSFER_BIT,
+                               VK_PIPELINE_STAGE_HOST_BIT,
+                               false);
+    return true;
+}
+
 bool GrVkGpu::onReadPixels(GrSurface* surface, int left, int top, int width, int height,
                            GrColorType dstColorType, void* buffer, size_t rowBytes) {
     if (GrPixelConfigToColorType(surface->config()) != dstColorType) {
@@ -2229,8 +2362,6 @@ bool GrVkGpu::onReadPixels(GrSurface* surface, int left, int top, int width, int
     // we can copy the data out of the buffer.
     this->submitCommandBuffer(kForce_SyncQueue);
     void* mappedMemory = transferBuffer->map();
-    const GrVkAlloc& transAlloc = transferBuffer->alloc();
-    GrVkMemory::InvalidateMappedAlloc(this, transAlloc, 0, transAlloc.fSize);
 
     if (copyFromOrigin) {
         uint32_t skipRows = region.imageExtent.height - height;
@@ -9,6 +9,7 @@
 #define GrVkGpu_DEFINED
 
 #include "GrGpu.h"
+#include "GrSkSLCompilerPool.h"
 #include "GrVkCaps.h"
 #include "GrVkCopyManager.h"
 #include "GrVkIndexBuffer.h"
@@ -33,12 +34,10 @@ class GrVkPrimaryCommandBuffer;
 class GrVkRenderPass;
 class GrVkSecondaryCommandBuffer;
 class GrVkTexture;
+class SkMutex;
+class SkTaskGroup;
 struct GrVkInterface;
 
-namespace SkSL {
-    class Compiler;
-}
-
 class GrVkGpu : public GrGpu {
 public:
     static sk_sp<GrGpu> Make(const GrVkBackendContext&, const GrContextOptions&, GrContext*);
@@ -68,6 +67,15 @@ public:
 
     GrVkPrimaryCommandBuffer* currentCommandBuffer() { return fCurrentCmdBuffer; }
 
+    // Returns the GrVkCommandPool recording lane that the next render pass's secondary command
+    // buffers should use, or -1 if they should be recorded directly on this thread.
+    int nextRecordingLane();
+
+    // Issues the saved commands of secondary command buffers from the given recording lane to
+    // Vulkan on another thread. They must have been ended and they must be recorded before the
+    // current primary command buffer is submitted.
+    void recordSecondaryCommandBuffers(int lane, SkTArray<GrVkSecondaryCommandBuffer*> buffers);
+
     enum SyncQueue {
         kForce_SyncQueue,
         kSkip_SyncQueue
@@ -121,8 +129,8 @@ public:
                                bool byRegion,
                                VkImageMemoryBarrier* barrier) const;
 
-    SkSL::Compiler* shaderCompiler() const {
-        return fCompiler;
+    GrSkSLCompilerPool* shaderCompilerPool() const {
+        return fCompilerPool.get();
     }
 
     bool onRegenerateMipMapLevels(GrTexture* tex) override;
@@ -189,6 +197,9 @@ private:
 
     void destroyResources();
 
+    // Waits for all the recordSecondaryCommandBuffers() tasks to finish.
+    void finishRecordingSecondaryCommandBuffers(bool abandon);
+
     sk_sp<GrTexture> onCreateTexture(const GrSurfaceDesc&, SkBudgeted, const GrMipLevel[],
                                      int mipLevelCount) override;
 
@@ -218,6 +229,9 @@ private:
     bool onTransferPixels(GrTexture*, int left, int top, int width, int height, GrColorType,
                           GrGpuBuffer* transferBuffer, size_t offset, size_t rowBytes) override;
 
+    bool onTransferPixelsFrom(GrSurface*, int left, int top, int width, int height, GrColorType,
+                              GrGpuBuffer* transferBuffer, size_t offset) override;
+
     bool onCopySurface(GrSurface* dst, GrSurfaceOrigin dstOrigin, GrSurface* src,
                        GrSurfaceOrigin srcOrigin, const SkIRect& srcRect,
                        const SkIPoint& dstPoint, bool canDiscardOutsideDstRect) override;
@@ -299,9 +313,9 @@ private:
 
     GrVkCopyManager                                       fCopyManager;
 
-    // compiler used for compiling sksl into spirv. We only want to create the compiler once since
-    // there is significant overhead to the first compile of any compiler.
-    SkSL::Compiler*                                       fCompiler;
+    // compilers used for compiling sksl into spirv. They are pooled rather than created per
+    // compile since there is significant overhead to the first compile of any compiler.
+    std::unique_ptr<GrSkSLCompilerPool>                   fCompilerPool;
 
     // We need a bool to track whether or not we've already disconnected all the gpu resources from
     // vulkan context.
@@ -310,6 +324,14 @@ private:
     std::unique_ptr<GrVkGpuRTCommandBuffer>               fCachedRTCommandBuffer;
     std::unique_ptr<GrVkGpuTextureCommandBuffer>          fCachedTexCommandBuffer;
 
+    // Only set if secondary command buffers are recorded on other threads. Each recording lane's
+    // mutex is held by the task using that lane's VkCommandPools, and the task's command buffers
+    // are kept alive in fRecordingCommandBuffers until it is done.
+    std::unique_ptr<SkTaskGroup>                          fRecordingTaskGroup;
+    std::unique_ptr<SkMutex[]>                            fRecordingLaneMutexes;
+    SkTArray<GrVkSecondaryCommandBuffer*, true>           fRecordingCommandBuffers;
+    int                                                   fNextRecordingLane = 0;
+
     typedef GrGpu INHERITED;
 };
 
@@ -81,7 +81,8 @@ void get_vk_load_store_ops(GrLoadOp loadOpIn, GrStoreOp storeOpIn,
 GrVkGpuRTCommandBuffer::GrVkGpuRTCommandBuffer(GrVkGpu* gpu)
         : fCurrentCmdInfo(-1)
         , fGpu(gpu)
-        , fLastPipelineState(nullptr) {
+        , fLastPipelineState(nullptr)
+        , fRecordingLane(-1) {
 }
 
 void GrVkGpuRTCommandBuffer::init() {
@@ -124,10 +125,22 @@ void GrVkGpuRTCommandBuffer::init() {
         cbInfo.fLoadStoreState = LoadStoreState::kStartsWithDiscard;
     }
 
-    cbInfo.fCommandBuffers.push_back(fGpu->cmdPool()->findOrCreateSecondaryCommandBuffer(fGpu));
+    cbInfo.fCommandBuffers.push_back(this->findOrCreateSecondaryCommandBuffer());
     cbInfo.currentCmdBuf()->begin(fGpu, vkRT->framebuffer(), cbInfo.fRenderPass);
 }
 
+GrVkSecondaryCommandBuffer* GrVkGpuRTCommandBuffer::findOrCreateSecondaryCommandBuffer() {
+    if (fRecordingLane >= 0) {
+        if (GrVkSecondaryCommandBuffer* buffer =
+                fGpu->cmdPool()->findOrCreateLaneSecondaryCommandBuffer(fGpu, fRecordingLane)) {
+            return buffer;
+        }
+        // Fall back to recording on this thread.
+        fRecordingLane = -1;
+    }
+    return fGpu->cmdPool()->findOrCreateSecondaryCommandBuffer(fGpu);
+}
+
 void GrVkGpuRTCommandBuffer::initWrapped() {
     CommandBufferInfo& cbInfo = fCommandBufferInfos.push_back();
     SkASSERT(fCommandBufferInfos.count() == 1);
@@ -165,6 +178,23 @@ void GrVkGpuRTCommandBuffer::submit() {
     GrVkImage* targetImage = vkRT->msaaImage() ? vkRT->msaaImage() : vkRT;
     GrStencilAttachment* stencil = fRenderTarget->renderTargetPriv().getStencilAttachment();
 
+    // Start issuing the commands of any secondary command buffers from a recording lane. They all
+    // come from the same lane, though some may not belong to one if we had to fall back.
+    SkTArray<GrVkSecondaryCommandBuffer*> laneBuffers;
+    int lane = -1;
+    for (const CommandBufferInfo& cbInfo : fCommandBufferInfos) {
+        for (GrVkSecondaryCommandBuffer* buffer : cbInfo.fCommandBuffers) {
+            if (buffer->recordingLane() >= 0) {
+                SkASSERT(lane < 0 || lane == buffer->recordingLane());
+                lane = buffer->recordingLane();
+                laneBuffers.push_back(buffer);
+            }
+        }
+    }
+    if (lane >= 0) {
+        fGpu->recordSecondaryCommandBuffers(lane, std::move(laneBuffers));
+    }
+
     for (int i = 0; i < fCommandBufferInfos.count(); ++i) {
         CommandBufferInfo& cbInfo = fCommandBufferInfos[i];
 
@@ -278,6 +308,8 @@ void GrVkGpuRTCommandBuffer::set(GrRenderTarget* rt, GrSurfaceOrigin origin,
         return;
     }
 
+    fRecordingLane = fGpu->nextRecordingLane();
+
     fClearColor = colorInfo.fClearColor;
 
     get_vk_load_store_ops(colorInfo.fLoadOp, colorInfo.fStoreOp,
@@ -303,6 +335,7 @@ void GrVkGpuRTCommandBuffer::reset() {
 
     fLastPipelineState = nullptr;
     fRenderTarget = nullptr;
+    fRecordingLane = -1;
 }
 
 bool GrVkGpuRTCommandBuffer::wrapsSecondaryCommandBuffer() const {
@@ -501,7 +534,7 @@ void GrVkGpuRTCommandBuffer::addAdditionalCommandBuffer() {
 
     CommandBufferInfo& cbInfo = fCommandBufferInfos[fCurrentCmdInfo];
     cbInfo.currentCmdBuf()->end(fGpu);
-    cbInfo.fCommandBuffers.push_back(fGpu->cmdPool()->findOrCreateSecondaryCommandBuffer(fGpu));
+    cbInfo.fCommandBuffers.push_back(this->findOrCreateSecondaryCommandBuffer());
     cbInfo.currentCmdBuf()->begin(fGpu, vkRT->framebuffer(), cbInfo.fRenderPass);
 }
 
@@ -510,16 +543,45 @@ void GrVkGpuRTCommandBuffer::addAdditionalRenderPass() {
 
     fCommandBufferInfos[fCurrentCmdInfo].currentCmdBuf()->end(fGpu);
 
+    const GrVkResourceProvider::CompatibleRPHandle& rpHandle =
+            vkRT->compatibleRenderPassHandle();
+
+    if (VK_ATTACHMENT_STORE_OP_STORE != fVkStencilStoreOp) {
+        // Only the last render pass may discard the stencil buffer, since the next one loads it.
+        // Swap the current pass for one that stores it; the load and store ops don't affect
+        // compatibility with the secondary command buffers already recorded for it.
+        CommandBufferInfo& prevInfo = fCommandBufferInfos[fCurrentCmdInfo];
+        bool isFirst = 0 == fCurrentCmdInfo;
+        VkAttachmentLoadOp colorLoadOp = isFirst ? fVkColorLoadOp : VK_ATTACHMENT_LOAD_OP_LOAD;
+        if (LoadStoreState::kStartsWithClear == prevInfo.fLoadStoreState) {
+            colorLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        }
+        GrVkRenderPass::LoadStoreOps prevColorOps(colorLoadOp, VK_ATTACHMENT_STORE_OP_STORE);
+        GrVkRenderPass::LoadStoreOps prevStencilOps(
+                isFirst ? fVkStencilLoadOp : VK_ATTACHMENT_LOAD_OP_LOAD,
+                VK_ATTACHMENT_STORE_OP_STORE);
+
+        const GrVkRenderPass* oldRP = prevInfo.fRenderPass;
+        if (rpHandle.isValid()) {
+            prevInfo.fRenderPass = fGpu->resourceProvider().findRenderPass(rpHandle,
+                                                                           prevColorOps,
+                                                                           prevStencilOps);
+        } else {
+            prevInfo.fRenderPass = fGpu->resourceProvider().findRenderPass(*vkRT,
+                                                                           prevColorOps,
+                                                                           prevStencilOps);
+        }
+        SkASSERT(prevInfo.fRenderPass->isCompatible(*oldRP));
+        oldRP->unref(fGpu);
+    }
+
     CommandBufferInfo& cbInfo = fCommandBufferInfos.push_back();
     fCurrentCmdInfo++;
 
     GrVkRenderPass::LoadStoreOps vkColorOps(VK_ATTACHMENT_LOAD_OP_LOAD,
                                             VK_ATTACHMENT_STORE_OP_STORE);
-    GrVkRenderPass::LoadStoreOps vkStencilOps(VK_ATTACHMENT_LOAD_OP_LOAD,
-                                              VK_ATTACHMENT_STORE_OP_STORE);
+    GrVkRenderPass::LoadStoreOps vkStencilOps(VK_ATTACHMENT_LOAD_OP_LOAD, fVkStencilStoreOp);
 
-    const GrVkResourceProvider::CompatibleRPHandle& rpHandle =
-            vkRT->compatibleRenderPassHandle();
     if (rpHandle.isValid()) {
         cbInfo.fRenderPass = fGpu->resourceProvider().findRenderPass(rpHandle,
                                                                      vkColorOps,
@@ -531,7 +593,7 @@ void GrVkGpuRTCommandBuffer::addAdditionalRenderPass() {
     }
     cbInfo.fLoadStoreState = LoadStoreState::kLoadAndStore;
 
-    cbInfo.fCommandBuffers.push_back(fGpu->cmdPool()->findOrCreateSecondaryCommandBuffer(fGpu));
+    cbInfo.fCommandBuffers.push_back(this->findOrCreateSecondaryCommandBuffer());
     // It shouldn't matter what we set the clear color to here since we will assume loading of the
     // attachment.
     memset(&cbInfo.fColorClearValue, 0, sizeof(VkClearValue));
@@ -841,6 +903,14 @@ void GrVkGpuRTCommandBuffer::executeDrawable(std::unique_ptr<SkDrawable::GpuDraw
 
     GrVkImage* targetImage = target->msaaImage() ? target->msaaImage() : target;
 
+    if (fCurrentCmdInfo >= 0 &&
+        fCommandBufferInfos[fCurrentCmdInfo].currentCmdBuf()->recordingLane() >= 0) {
+        // The drawable records straight into the VkCommandBuffer, so from here on we record on
+        // this thread.
+        fRecordingLane = -1;
+        this->addAdditionalCommandBuffer();
+    }
+
     CommandBufferInfo& cbInfo = fCommandBufferInfos[fCurrentCmdInfo];
     VkRect2D bounds;
     bounds.offset = { 0, 0 };
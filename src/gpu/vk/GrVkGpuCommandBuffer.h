@@ -93,6 +93,9 @@ private:
 
     bool wrapsSecondaryCommandBuffer() const;
 
+    // Gets a secondary command buffer from the GrVkGpu's command pool, on fRecordingLane if set.
+    GrVkSecondaryCommandBuffer* findOrCreateSecondaryCommandBuffer();
+
     GrGpu* gpu() override;
 
     // Bind vertex and index buffers
@@ -210,6 +213,9 @@ private:
     VkAttachmentStoreOp         fVkStencilStoreOp;
     SkPMColor4f                 fClearColor;
     GrVkPipelineState*          fLastPipelineState;
+    // The GrVkCommandPool recording lane our secondary command buffers are recorded on, or -1 if
+    // they are recorded as we go.
+    int                         fRecordingLane;
 
     typedef GrGpuRTCommandBuffer INHERITED;
 };
@@ -67,6 +67,8 @@ GrVkPipelineState::GrVkPipelineState(
         // GrVkUnformHandler.
         fImmutableSamplers.push_back(samplers[i].fImmutableSampler);
     }
+    fBoundTextureViews.push_back_n(fNumSamplers, static_cast<const GrVkImageView*>(nullptr));
+    fBoundSamplers.push_back_n(fNumSamplers, static_cast<const GrVkSampler*>(nullptr));
 }
 
 GrVkPipelineState::~GrVkPipelineState() {
@@ -105,6 +107,8 @@ void GrVkPipelineState::freeGPUResources(GrVkGpu* gpu) {
         fSamplerDescriptorSet->recycle(const_cast<GrVkGpu*>(gpu));
         fSamplerDescriptorSet = nullptr;
     }
+
+    this->releaseBoundSamplers(gpu);
 }
 
 void GrVkPipelineState::abandonGPUResources() {
@@ -137,6 +141,34 @@ void GrVkPipelineState::abandonGPUResources() {
         fSamplerDescriptorSet->unrefAndAbandon();
         fSamplerDescriptorSet = nullptr;
     }
+
+    this->abandonBoundSamplers();
+}
+
+void GrVkPipelineState::releaseBoundSamplers(GrVkGpu* gpu) {
+    for (int i = 0; i < fNumSamplers; ++i) {
+        if (fBoundTextureViews[i]) {
+            fBoundTextureViews[i]->unref(gpu);
+            fBoundTextureViews[i] = nullptr;
+        }
+        if (fBoundSamplers[i]) {
+            fBoundSamplers[i]->unref(gpu);
+            fBoundSamplers[i] = nullptr;
+        }
+    }
+}
+
+void GrVkPipelineState::abandonBoundSamplers() {
+    for (int i = 0; i < fNumSamplers; ++i) {
+        if (fBoundTextureViews[i]) {
+            fBoundTextureViews[i]->unrefAndAbandon();
+            fBoundTextureViews[i] = nullptr;
+        }
+        if (fBoundSamplers[i]) {
+            fBoundSamplers[i]->unrefAndAbandon();
+            fBoundSamplers[i] = nullptr;
+        }
+    }
 }
 
 void GrVkPipelineState::setAndBindUniforms(GrVkGpu* gpu,
@@ -237,53 +269,72 @@ void GrVkPipelineState::setAndBindTextures(GrVkGpu* gpu,
                 static_cast<GrVkTexture*>(dstTextureProxy->peekTexture())};
     }
 
-    // Get new descriptor set
     SkASSERT(fNumSamplers == currTextureBinding);
     if (fNumSamplers) {
-        if (fSamplerDescriptorSet) {
-            fSamplerDescriptorSet->recycle(gpu);
-        }
-        fSamplerDescriptorSet = gpu->resourceProvider().getSamplerDescriptorSet(fSamplerDSHandle);
-        int samplerDSIdx = GrVkUniformHandler::kSamplerDescSet;
-        fDescriptorSets[samplerDSIdx] = fSamplerDescriptorSet->descriptorSet();
+        SkAutoSTMalloc<8, const GrVkSampler*> samplers(fNumSamplers);
+        bool reuseDescriptorSet = SkToBool(fSamplerDescriptorSet);
         for (int i = 0; i < fNumSamplers; ++i) {
             const GrSamplerState& state = samplerBindings[i].fState;
             GrVkTexture* texture = samplerBindings[i].fTexture;
-
-            const GrVkImageView* textureView = texture->textureView();
-            const GrVkSampler* sampler = nullptr;
             if (fImmutableSamplers[i]) {
-                sampler = fImmutableSamplers[i];
+                samplers[i] = fImmutableSamplers[i];
             } else {
-                sampler = gpu->resourceProvider().findOrCreateCompatibleSampler(
+                samplers[i] = gpu->resourceProvider().findOrCreateCompatibleSampler(
                     state, texture->ycbcrConversionInfo());
             }
-            SkASSERT(sampler);
-
-            VkDescriptorImageInfo imageInfo;
-            memset(&imageInfo, 0, sizeof(VkDescriptorImageInfo));
-            imageInfo.sampler = sampler->sampler();
-            imageInfo.imageView = textureView->imageView();
-            imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-            VkWriteDescriptorSet writeInfo;
-            memset(&writeInfo, 0, sizeof(VkWriteDescriptorSet));
-            writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            writeInfo.pNext = nullptr;
-            writeInfo.dstSet = fDescriptorSets[GrVkUniformHandler::kSamplerDescSet];
-            writeInfo.dstBinding = i;
-            writeInfo.dstArrayElement = 0;
-            writeInfo.descriptorCount = 1;
-            writeInfo.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            writeInfo.pImageInfo = &imageInfo;
-            writeInfo.pBufferInfo = nullptr;
-            writeInfo.pTexelBufferView = nullptr;
-
-            GR_VK_CALL(gpu->vkInterface(),
-                       UpdateDescriptorSets(gpu->device(), 1, &writeInfo, 0, nullptr));
-            commandBuffer->addResource(sampler);
+            SkASSERT(samplers[i]);
+            if (texture->textureView() != fBoundTextureViews[i] ||
+                samplers[i] != fBoundSamplers[i]) {
+                reuseDescriptorSet = false;
+            }
+        }
+
+        int samplerDSIdx = GrVkUniformHandler::kSamplerDescSet;
+        if (!reuseDescriptorSet) {
+            // Get new descriptor set
+            if (fSamplerDescriptorSet) {
+                fSamplerDescriptorSet->recycle(gpu);
+            }
+            fSamplerDescriptorSet =
+                    gpu->resourceProvider().getSamplerDescriptorSet(fSamplerDSHandle);
+            fDescriptorSets[samplerDSIdx] = fSamplerDescriptorSet->descriptorSet();
+            this->releaseBoundSamplers(gpu);
+            for (int i = 0; i < fNumSamplers; ++i) {
+                const GrVkImageView* textureView = samplerBindings[i].fTexture->textureView();
+
+                VkDescriptorImageInfo imageInfo;
+                memset(&imageInfo, 0, sizeof(VkDescriptorImageInfo));
+                imageInfo.sampler = samplers[i]->sampler();
+                imageInfo.imageView = textureView->imageView();
+                imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+                VkWriteDescriptorSet writeInfo;
+                memset(&writeInfo, 0, sizeof(VkWriteDescriptorSet));
+                writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                writeInfo.pNext = nullptr;
+                writeInfo.dstSet = fDescriptorSets[GrVkUniformHandler::kSamplerDescSet];
+                writeInfo.dstBinding = i;
+                writeInfo.dstArrayElement = 0;
+                writeInfo.descriptorCount = 1;
+                writeInfo.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                writeInfo.pImageInfo = &imageInfo;
+                writeInfo.pBufferInfo = nullptr;
+                writeInfo.pTexelBufferView = nullptr;
+
+                GR_VK_CALL(gpu->vkInterface(),
+                           UpdateDescriptorSets(gpu->device(), 1, &writeInfo, 0, nullptr));
+
+                textureView->ref();
+                fBoundTextureViews[i] = textureView;
+                samplers[i]->ref();
+                fBoundSamplers[i] = samplers[i];
+            }
+        }
+
+        for (int i = 0; i < fNumSamplers; ++i) {
+            commandBuffer->addResource(samplers[i]);
             if (!fImmutableSamplers[i]) {
-                sampler->unref(gpu);
+                samplers[i]->unref(gpu);
             }
             commandBuffer->addResource(samplerBindings[i].fTexture->textureView());
             commandBuffer->addResource(samplerBindings[i].fTexture->resource());
@@ -116,6 +116,10 @@ private:
     // Helper for setData() that sets the view matrix and loads the render target height uniform
     void setRenderTargetState(const GrRenderTarget*, GrSurfaceOrigin);
 
+    // Drops the refs on the views and samplers that fSamplerDescriptorSet was written with.
+    void releaseBoundSamplers(GrVkGpu*);
+    void abandonBoundSamplers();
+
     // GrVkResources
     GrVkPipeline* fPipeline;
 
@@ -137,6 +141,12 @@ private:
 
     SkSTArray<4, const GrVkSampler*>   fImmutableSamplers;
 
+    // The views and samplers written into fSamplerDescriptorSet. When the next draw uses the same
+    // ones we bind that set again instead of allocating and writing a new one. We hold refs on
+    // them so that a matching pointer can never be a freed object's recycled address.
+    SkSTArray<4, const GrVkImageView*> fBoundTextureViews;
+    SkSTArray<4, const GrVkSampler*>   fBoundSamplers;
+
     std::unique_ptr<GrVkUniformBuffer> fGeometryUniformBuffer;
     std::unique_ptr<GrVkUniformBuffer> fFragmentUniformBuffer;
 
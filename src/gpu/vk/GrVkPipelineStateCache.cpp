@@ -6,6 +6,7 @@
  */
 
 
+#include "GrContextPriv.h"
 #include "GrProcessor.h"
 #include "GrRenderTargetPriv.h"  // TODO: remove once refPipelineState gets passed stencil settings.
 #include "GrStencilSettings.h"
@@ -38,8 +39,9 @@ struct GrVkResourceProvider::PipelineStateCache::Entry {
 };
 
 GrVkResourceProvider::PipelineStateCache::PipelineStateCache(GrVkGpu* gpu)
-    : fMap(kMaxEntries)
+    : fMap(gpu->getContext()->priv().options().fRuntimeProgramCacheSize)
     , fGpu(gpu)
+    , fBaseMaxEntries(fMap.maxCount())
 #ifdef GR_PIPELINE_STATE_CACHE_STATS
     , fTotalRequests(0)
     , fCacheMisses(0)
@@ -74,6 +76,27 @@ void GrVkResourceProvider::PipelineStateCache::release() {
     fMap.reset();
 }
 
+void GrVkResourceProvider::PipelineStateCache::updateSize(bool hit) {
+    if (hit) {
+        fGpu->stats()->incPipelineStateCacheHits();
+    } else {
+        fGpu->stats()->incPipelineStateCacheMisses();
+        if (fMap.count() >= fMap.maxCount()) {
+            ++fWindowThrashingMisses;
+        }
+    }
+    if (++fWindowRequests < fMap.maxCount()) {
+        return;
+    }
+    int maxAllowed = kMaxGrowthFactor * fBaseMaxEntries;
+    if (fWindowThrashingMisses * kThrashingMissDivisor > fWindowRequests &&
+        fMap.maxCount() < maxAllowed) {
+        fMap.setMaxCount(SkTMin(2 * fMap.maxCount(), maxAllowed));
+    }
+    fWindowRequests = 0;
+    fWindowThrashingMisses = 0;
+}
+
 GrVkPipelineState* GrVkResourceProvider::PipelineStateCache::refPipelineState(
         GrRenderTarget* renderTarget,
         GrSurfaceOrigin origin,
@@ -107,6 +130,7 @@ GrVkPipelineState* GrVkResourceProvider::PipelineStateCache::refPipelineState(
         desc.setSurfaceOriginKey(GrGLSLFragmentShaderBuilder::KeyForSurfaceOrigin(origin));
         entry = fMap.find(desc);
     }
+    this->updateSize(SkToBool(entry));
     if (!entry) {
 #ifdef GR_PIPELINE_STATE_CACHE_STATS
         ++fCacheMisses;
@@ -204,24 +204,36 @@ private:
                                             GrPrimitiveType,
                                             VkRenderPass compatibleRenderPass);
 
+        int maxEntries() const { return fMap.maxCount(); }
+
     private:
         enum {
-            // We may actually have kMaxEntries+1 PipelineStates in context because we create a new
-            // PipelineState before evicting from the cache.
-            kMaxEntries = 128,
+            // The cache may grow to this multiple of GrContextOptions::fRuntimeProgramCacheSize.
+            kMaxGrowthFactor = 4,
+            // It grows when more than 1/kThrashingMissDivisor of the requests since the last check
+            // missed while the cache was full, i.e. when the working set does not fit.
+            kThrashingMissDivisor = 8,
         };
 
         struct Entry;
 
+        // Counts a request and, once per cache-full of requests, decides whether to grow.
+        void updateSize(bool hit);
+
         struct DescHash {
             uint32_t operator()(const GrProgramDesc& desc) const {
                 return SkOpts::hash_fn(desc.asKey(), desc.keyLength(), 0);
             }
         };
 
+        // We may actually have one more PipelineState in context than the cache holds, because we
+        // create a new PipelineState before evicting from the cache.
         SkLRUCache<const GrVkPipelineStateBuilder::Desc, std::unique_ptr<Entry>, DescHash> fMap;
 
         GrVkGpu*                    fGpu;
+        const int                   fBaseMaxEntries;
+        int                         fWindowRequests = 0;
+        int                         fWindowThrashingMisses = 0;
 
 #ifdef GR_PIPELINE_STATE_CACHE_STATS
         int                         fTotalRequests;
@@ -79,6 +79,9 @@ bool GrPixelConfigToVkFormat(GrPixelConfig config, VkFormat* format) {
             // converting to ETC2 which is a superset of ETC1
             *format = VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK;
             return true;
+        case kRGB_BC1_GrPixelConfig:
+            *format = VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+            return true;
         case kAlpha_half_GrPixelConfig: // fall through
         case kAlpha_half_as_Red_GrPixelConfig:
             *format = VK_FORMAT_R16_SFLOAT;
@@ -119,6 +122,8 @@ bool GrVkFormatPixelConfigPairIsValid(VkFormat format, GrPixelConfig config) {
                    kGray_8_as_Red_GrPixelConfig == config;
         case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
             return kRGB_ETC1_GrPixelConfig == config;
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+            return kRGB_BC1_GrPixelConfig == config;
         case VK_FORMAT_R32G32B32A32_SFLOAT:
             return kRGBA_float_GrPixelConfig == config;
         case VK_FORMAT_R32G32_SFLOAT:
@@ -149,6 +154,7 @@ bool GrVkFormatIsSupported(VkFormat format) {
         case VK_FORMAT_B4G4R4A4_UNORM_PACK16:
         case VK_FORMAT_R8_UNORM:
         case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+        case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
         case VK_FORMAT_R32G32B32A32_SFLOAT:
         case VK_FORMAT_R32G32_SFLOAT:
         case VK_FORMAT_R16G16B16A16_SFLOAT:
@@ -207,18 +213,19 @@ bool GrCompileVkShaderModule(const GrVkGpu* gpu,
                              const SkSL::Program::Settings& settings,
                              SkSL::String* outSPIRV,
                              SkSL::Program::Inputs* outInputs) {
-    std::unique_ptr<SkSL::Program> program = gpu->shaderCompiler()->convertProgram(
+    GrSkSLCompilerPool::Lease compiler = gpu->shaderCompilerPool()->acquire();
+    std::unique_ptr<SkSL::Program> program = compiler->convertProgram(
                                                               vk_shader_stage_to_skiasl_kind(stage),
                                                               SkSL::String(shaderString),
                                                               settings);
     if (!program) {
         printf("%s\n", shaderString);
-        SkDebugf("SkSL error:\n%s\n", gpu->shaderCompiler()->errorText().c_str());
+        SkDebugf("SkSL error:\n%s\n", compiler->errorText().c_str());
         SkASSERT(false);
     }
     *outInputs = program->fInputs;
-    if (!gpu->shaderCompiler()->toSPIRV(*program, outSPIRV)) {
-        SkDebugf("%s\n", gpu->shaderCompiler()->errorText().c_str());
+    if (!compiler->toSPIRV(*program, outSPIRV)) {
+        SkDebugf("%s\n", compiler->errorText().c_str());
         return false;
     }
 
@@ -280,8 +280,9 @@ sk_sp<SkImage> SkImage::makeWithFilter(GrContext* grContext,
         return nullptr;
     }
 
-    sk_sp<SkImageFilterCache> cache(
-        SkImageFilterCache::Create(SkImageFilterCache::kDefaultTransientSize));
+    sk_sp<SkImageFilterCache> cache(SkImageFilterCache::Create(
+            SkImageFilterCache::TransientSize(filter, clipBounds,
+                                              as_IB(this)->onImageInfo().colorType())));
     SkImageFilter::OutputProperties outputProperties(as_IB(this)->onImageInfo().colorType(),
                                                      as_IB(this)->onImageInfo().colorSpace());
     SkImageFilter::Context context(SkMatrix::I(), clipBounds, cache.get(), outputProperties);
@@ -415,6 +416,11 @@ sk_sp<SkImage> SkImage::MakeFromAdoptedTexture(GrContext* ctx,
     return nullptr;
 }
 
+sk_sp<SkImage> SkImage::MakeFromCompressed(GrContext*, sk_sp<SkData> data, int width, int height,
+                                           CompressionType type, GrMipMapped) {
+    return MakeRasterFromCompressed(std::move(data), width, height, type);
+}
+
 sk_sp<SkImage> SkImage::MakeFromYUVATexturesCopy(GrContext* context,
                                                  SkYUVColorSpace yuvColorSpace,
                                                  const GrBackendTexture yuvaTextures[],
@@ -165,24 +165,32 @@ sk_sp<SkImage> SkImage::MakeFromAdoptedTexture(GrContext* ctx,
 }
 
 sk_sp<SkImage> SkImage::MakeFromCompressed(GrContext* context, sk_sp<SkData> data,
-                                           int width, int height, CompressionType type) {
+                                           int width, int height, CompressionType type,
+                                           GrMipMapped mipMapped) {
+    if (!context) {
+        return MakeRasterFromCompressed(std::move(data), width, height, type);
+    }
+
     // create the backing texture
     GrSurfaceDesc desc;
     desc.fFlags = kNone_GrSurfaceFlags;
     desc.fWidth = width;
     desc.fHeight = height;
-    switch (type) {
-        case kETC1_CompressionType:
-            desc.fConfig = kRGB_ETC1_GrPixelConfig;
-            break;
-        default:
-            desc.fConfig = kUnknown_GrPixelConfig;
-            break;
-    }
+    desc.fConfig = SkCompressionTypeToGrPixelConfig(type);
     desc.fSampleCnt = 1;
 
+    if (!context->priv().caps()->isConfigTexturable(desc.fConfig)) {
+        // Decompress on the CPU and upload RGBA instead.
+        sk_sp<SkImage> raster = MakeRasterFromCompressed(std::move(data), width, height, type);
+        return raster ? raster->makeTextureImage(context, nullptr, mipMapped) : nullptr;
+    }
+
+    if (mipMapped == GrMipMapped::kYes && !context->priv().caps()->mipMapSupport()) {
+        mipMapped = GrMipMapped::kNo;
+    }
+
     GrProxyProvider* proxyProvider = context->priv().proxyProvider();
-    sk_sp<GrTextureProxy> proxy = proxyProvider->createProxy(std::move(data), desc);
+    sk_sp<GrTextureProxy> proxy = proxyProvider->createProxy(std::move(data), desc, mipMapped);
 
     if (!proxy) {
         return nullptr;
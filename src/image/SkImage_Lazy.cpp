@@ -13,19 +13,24 @@
 #include "SkData.h"
 #include "SkImageGenerator.h"
 #include "SkImagePriv.h"
+#include "SkMakeUnique.h"
 #include "SkNextID.h"
 
 #if SK_SUPPORT_GPU
 #include "GrCaps.h"
+#include "GrCompressedImageCache.h"
+#include "GrContextPriv.h"
 #include "GrGpuResourcePriv.h"
 #include "GrImageTextureMaker.h"
 #include "GrResourceKey.h"
 #include "GrProxyProvider.h"
 #include "GrRecordingContext.h"
 #include "GrRecordingContextPriv.h"
+#include "GrResourceCache.h"
 #include "GrSamplerState.h"
 #include "GrYUVProvider.h"
 #include "SkGr.h"
+#include "SkTaskGroup.h"
 #endif
 
 // Ref-counted tuple(SkImageGenerator, SkMutex) which allows sharing one generator among N images
@@ -46,6 +51,7 @@ private:
 
     friend class ScopedGenerator;
     friend class SkImage_Lazy;
+    friend class SharedGenerator_GrYUVProvider;
 
     std::unique_ptr<SkImageGenerator> fGenerator;
     SkMutex                           fMutex;
@@ -192,6 +198,13 @@ bool SkImage_Lazy::getROPixels(SkBitmap* bitmap, SkImage::CachingHint chint) con
     }
 
     if (SkImage::kAllow_CachingHint == chint) {
+        // If another thread is decoding this image, wait for it and use its result.
+        SkAutoExclusive decodeLock(fDecodeMutex);
+        if (SkBitmapCache::Find(desc, bitmap)) {
+            check_output_bitmap();
+            return true;
+        }
+
         SkPixmap pmap;
         SkBitmapCache::RecPtr cacheRec = SkBitmapCache::Alloc(desc, fInfo, &pmap);
         if (!cacheRec ||
@@ -301,9 +314,42 @@ void SkImage_Lazy::makeCacheKeyFromOrigKey(const GrUniqueKey& origKey,
     }
 }
 
+// Locks the shared generator for each call, so it may be used from a worker thread.
+class SharedGenerator_GrYUVProvider : public GrYUVProvider {
+public:
+    SharedGenerator_GrYUVProvider(sk_sp<SharedGenerator> gen) : fSharedGenerator(std::move(gen)) {}
+
+private:
+    uint32_t onGetID() const override { return fSharedGenerator->fGenerator->uniqueID(); }
+    bool onQueryYUVA8(SkYUVASizeInfo* sizeInfo,
+                      SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
+                      SkYUVColorSpace* colorSpace) const override {
+        SkAutoExclusive lock(fSharedGenerator->fMutex);
+        return fSharedGenerator->fGenerator->queryYUVA8(sizeInfo, yuvaIndices, colorSpace);
+    }
+    bool onGetYUVA8Planes(const SkYUVASizeInfo& sizeInfo,
+                          const SkYUVAIndex yuvaIndices[SkYUVAIndex::kIndexCount],
+                          void* planes[]) override {
+        SkAutoExclusive lock(fSharedGenerator->fMutex);
+        return fSharedGenerator->fGenerator->getYUVA8Planes(sizeInfo, yuvaIndices, planes);
+    }
+
+    sk_sp<SharedGenerator> fSharedGenerator;
+
+    typedef GrYUVProvider INHERITED;
+};
+
 class Generator_GrYUVProvider : public GrYUVProvider {
 public:
-    Generator_GrYUVProvider(SkImageGenerator* gen) : fGen(gen) {}
+    Generator_GrYUVProvider(SkImageGenerator* gen, sk_sp<SharedGenerator> shared = nullptr)
+            : fGen(gen), fSharedGenerator(std::move(shared)) {}
+
+    std::unique_ptr<GrYUVProvider> makeThreadSafeProvider() const override {
+        if (!fSharedGenerator) {
+            return nullptr;
+        }
+        return skstd::make_unique<SharedGenerator_GrYUVProvider>(fSharedGenerator);
+    }
 
 private:
     uint32_t onGetID() const override { return fGen->uniqueID(); }
@@ -318,7 +364,8 @@ private:
         return fGen->getYUVA8Planes(sizeInfo, yuvaIndices, planes);
     }
 
-    SkImageGenerator* fGen;
+    SkImageGenerator*      fGen;
+    sk_sp<SharedGenerator> fSharedGenerator;
 
     typedef GrYUVProvider INHERITED;
 };
@@ -377,7 +424,7 @@ sk_sp<GrTextureProxy> SkImage_Lazy::lockTextureProxy(
         kFailure_LockTexturePath,
         kPreExisting_LockTexturePath,
         kNative_LockTexturePath,
-        kCompressed_LockTexturePath, // Deprecated
+        kCompressed_LockTexturePath,
         kYUV_LockTexturePath,
         kRGBA_LockTexturePath,
     };
@@ -407,6 +454,33 @@ sk_sp<GrTextureProxy> SkImage_Lazy::lockTextureProxy(
         }
     }
 
+    // If the context keeps compressed copies of purged image textures (see GrCompressedImageCache)
+    // we can re-upload from that instead of decoding again.
+    sk_sp<GrCompressedImageCache> compressedCache;
+    SkTaskGroup* taskGroup = nullptr;
+    if (auto direct = ctx->priv().asDirectContext()) {
+        compressedCache = direct->priv().getResourceCache()->refCompressedImageCache();
+        taskGroup = direct->priv().getTaskGroup();
+    }
+    if (!proxy && key.isValid() && !willBeMipped && compressedCache) {
+        int width, height;
+        if (sk_sp<SkData> blocks = compressedCache->find(key, &width, &height)) {
+            SkASSERT(width == fInfo.width() && height == fInfo.height());
+            GrSurfaceDesc desc;
+            desc.fWidth = width;
+            desc.fHeight = height;
+            desc.fConfig = kRGB_ETC1_GrPixelConfig;
+            if ((proxy = proxyProvider->createProxy(std::move(blocks), desc))) {
+                SK_HISTOGRAM_ENUMERATION("LockTexturePath", kCompressed_LockTexturePath,
+                                         kLockTexturePathCount);
+                set_key_on_proxy(proxyProvider, proxy.get(), nullptr, key);
+                *fUniqueKeyInvalidatedMessages.append() =
+                        new GrUniqueKeyInvalidatedMessage(key, ctx->priv().contextID());
+                return proxy;
+            }
+        }
+    }
+
     // 2. Ask the generator to natively create one
     if (!proxy) {
         ScopedGenerator generator(fSharedGenerator);
@@ -436,7 +510,7 @@ sk_sp<GrTextureProxy> SkImage_Lazy::lockTextureProxy(
                 ctx->priv().caps()->getBackendFormatFromColorType(colorType);
 
         ScopedGenerator generator(fSharedGenerator);
-        Generator_GrYUVProvider provider(generator);
+        Generator_GrYUVProvider provider(generator, fSharedGenerator);
 
         // The pixels in the texture will be in the generator's color space.
         // If onMakeColorTypeAndColorSpace has been called then this will not match this image's
@@ -473,6 +547,14 @@ sk_sp<GrTextureProxy> SkImage_Lazy::lockTextureProxy(
             set_key_on_proxy(proxyProvider, proxy.get(), nullptr, key);
             *fUniqueKeyInvalidatedMessages.append() =
                     new GrUniqueKeyInvalidatedMessage(key, ctx->priv().contextID());
+            // Compress a copy in the background, in case the texture is purged later. Only
+            // opaque images are compressed, since ETC1 has no alpha.
+            if (key.isValid() && compressedCache && taskGroup && bitmap.isOpaque() &&
+                !compressedCache->has(key)) {
+                taskGroup->add([compressedCache, key, bitmap] {
+                    compressedCache->encodeAndAdd(key, bitmap);
+                });
+            }
             return proxy;
         }
     }
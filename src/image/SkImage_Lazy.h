@@ -90,6 +90,10 @@ private:
     mutable SkMutex             fOnMakeColorTypeAndSpaceMutex;
     mutable sk_sp<SkImage>      fOnMakeColorTypeAndSpaceResult;
 
+    // Held while decoding into the SkBitmapCache, so that threads drawing this image at the same
+    // time wait for one decode instead of each doing their own.
+    mutable SkMutex             fDecodeMutex;
+
 #if SK_SUPPORT_GPU
     // When the SkImage_Lazy goes away, we will iterate over all the unique keys we've used and
     // send messages to the GrContexts to say the unique keys are no longer valid. The GrContexts
@@ -10,6 +10,7 @@
 #include "SkBitmapProcShader.h"
 #include "SkCanvas.h"
 #include "SkColorTable.h"
+#include "SkCompressedDataUtils.h"
 #include "SkConvertPixels.h"
 #include "SkData.h"
 #include "SkImageInfoPriv.h"
@@ -287,6 +288,20 @@ sk_sp<SkImage> SkImage::MakeRasterData(const SkImageInfo& info, sk_sp<SkData> da
     return sk_make_sp<SkImage_Raster>(info, std::move(data), rowBytes);
 }
 
+sk_sp<SkImage> SkImage::MakeRasterFromCompressed(sk_sp<SkData> data, int width, int height,
+                                                 CompressionType type) {
+    if (!data) {
+        return nullptr;
+    }
+
+    SkBitmap bitmap;
+    if (!SkDecompress(data->data(), data->size(), width, height, type, &bitmap)) {
+        return nullptr;
+    }
+    bitmap.setImmutable();
+    return SkImage::MakeFromBitmap(bitmap);
+}
+
 sk_sp<SkImage> SkImage::MakeFromRaster(const SkPixmap& pmap, RasterReleaseProc proc,
                                        ReleaseContext ctx) {
     size_t size;
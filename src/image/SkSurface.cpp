@@ -6,7 +6,10 @@
  */
 
 #include "GrBackendSurface.h"
+#include "SkAutoPixmapStorage.h"
 #include "SkCanvas.h"
+#include "SkColorFilter.h"
+#include "SkConvertPixels.h"
 #include "SkFontLCDConfig.h"
 #include "SkImagePriv.h"
 #include "SkSurface_Base.h"
@@ -86,6 +89,16 @@ void SkSurface_Base::onDraw(SkCanvas* canvas, SkScalar x, SkScalar y, const SkPa
     }
 }
 
+void SkSurface_Base::onAsyncReadPixels(const SkImageInfo& info, int srcX, int srcY,
+                                       ReadPixelsCallback callback, ReadPixelsContext context) {
+    SkAutoPixmapStorage pm;
+    if (pm.tryAlloc(info) && this->getCachedCanvas()->readPixels(pm, srcX, srcY)) {
+        callback(context, pm.addr(), pm.rowBytes());
+    } else {
+        callback(context, nullptr, 0);
+    }
+}
+
 bool SkSurface_Base::outstandingImageSnapshot() const {
     return fCachedImage && !fCachedImage->unique();
 }
@@ -207,6 +220,147 @@ bool SkSurface::readPixels(const SkBitmap& bitmap, int srcX, int srcY) {
     return bitmap.peekPixels(&pm) && this->readPixels(pm, srcX, srcY);
 }
 
+void SkSurface::asyncReadPixels(const SkImageInfo& dstInfo, int srcX, int srcY,
+                                ReadPixelsCallback callback, ReadPixelsContext context) {
+    SkASSERT(callback);
+    SkIRect srcRect = SkIRect::MakeXYWH(srcX, srcY, dstInfo.width(), dstInfo.height());
+    if (dstInfo.isEmpty() || !SkIRect::MakeWH(this->width(), this->height()).contains(srcRect)) {
+        callback(context, nullptr, 0);
+        return;
+    }
+    asSB(this)->onAsyncReadPixels(dstInfo, srcX, srcY, callback, context);
+}
+
+namespace {
+
+// Collects the three planes of an asyncReadPixelsYUV420(), which are read separately.
+struct YUV420Read {
+    struct Plane {
+        YUV420Read*         fRead;
+        SkAutoPixmapStorage fPixels;
+    };
+
+    SkSurface::ReadPixelsYUV420Callback fCallback;
+    SkSurface::ReadPixelsContext        fContext;
+    Plane                               fPlanes[3];
+    int                                 fRemaining = 3;
+    bool                                fFailed = false;
+
+    // The plane's pixels only live for the duration of the callback, so they're copied until
+    // the last plane arrives.
+    static void PlaneDone(SkSurface::ReadPixelsContext context, const void* pixels,
+                          size_t rowBytes) {
+        Plane* plane = static_cast<Plane*>(context);
+        YUV420Read* read = plane->fRead;
+        if (pixels) {
+            const SkPixmap& dst = plane->fPixels;
+            SkRectMemcpy(dst.writable_addr(), dst.rowBytes(), pixels, rowBytes, dst.width(),
+                         dst.height());
+        } else {
+            read->fFailed = true;
+        }
+        if (--read->fRemaining > 0) {
+            return;
+        }
+        if (read->fFailed) {
+            read->fCallback(read->fContext, nullptr, nullptr);
+        } else {
+            const void* planes[3];
+            size_t rowBytes[3];
+            for (int i = 0; i < 3; ++i) {
+                planes[i] = read->fPlanes[i].fPixels.addr();
+                rowBytes[i] = read->fPlanes[i].fPixels.rowBytes();
+            }
+            read->fCallback(read->fContext, planes, rowBytes);
+        }
+        delete read;
+    }
+};
+
+}  // namespace
+
+// Each plane is a color matrix that writes the Y, U or V value of a color to its alpha, so the
+// conversion can be drawn into an A8 surface. The translations are out of 255.
+static void yuv_plane_matrices(SkYUVColorSpace yuvColorSpace, SkScalar matrices[3][20]) {
+    static const SkScalar kCoeffs[][3][4] = {
+        // kJPEG_SkYUVColorSpace
+        {{  0.299000f,  0.587000f,  0.114000f,   0 },
+         { -0.168736f, -0.331264f,  0.500000f, 128 },
+         {  0.500000f, -0.418688f, -0.081312f, 128 }},
+        // kRec601_SkYUVColorSpace
+        {{  0.256788f,  0.504129f,  0.097906f,  16 },
+         { -0.148223f, -0.290993f,  0.439216f, 128 },
+         {  0.439216f, -0.367788f, -0.071427f, 128 }},
+        // kRec709_SkYUVColorSpace
+        {{  0.182586f,  0.614231f,  0.061996f,  16 },
+         { -0.100644f, -0.338572f,  0.439216f, 128 },
+         {  0.439216f, -0.398942f, -0.040274f, 128 }},
+        // kIdentity_SkYUVColorSpace
+        {{ 1, 0, 0, 0 },
+         { 0, 1, 0, 0 },
+         { 0, 0, 1, 0 }},
+    };
+    static_assert(SK_ARRAY_COUNT(kCoeffs) == kLastEnum_SkYUVColorSpace + 1, "missing space");
+    for (int i = 0; i < 3; ++i) {
+        const SkScalar* coeffs = kCoeffs[yuvColorSpace][i];
+        sk_bzero(matrices[i], sizeof(matrices[i]));
+        matrices[i][15] = coeffs[0];
+        matrices[i][16] = coeffs[1];
+        matrices[i][17] = coeffs[2];
+        matrices[i][19] = coeffs[3];
+    }
+}
+
+void SkSurface::asyncReadPixelsYUV420(SkYUVColorSpace yuvColorSpace, const SkIRect& srcRect,
+                                      ReadPixelsYUV420Callback callback,
+                                      ReadPixelsContext context) {
+    SkASSERT(callback);
+    if (srcRect.isEmpty() || !SkIRect::MakeWH(this->width(), this->height()).contains(srcRect)) {
+        callback(context, nullptr, nullptr);
+        return;
+    }
+    sk_sp<SkImage> src = this->makeImageSnapshot();
+    SkScalar matrices[3][20];
+    yuv_plane_matrices(yuvColorSpace, matrices);
+
+    int chromaW = (srcRect.width() + 1) / 2;
+    int chromaH = (srcRect.height() + 1) / 2;
+    const SkImageInfo planeInfos[3] = {
+        SkImageInfo::MakeA8(srcRect.width(), srcRect.height()),
+        SkImageInfo::MakeA8(chromaW, chromaH),
+        SkImageInfo::MakeA8(chromaW, chromaH),
+    };
+    sk_sp<SkSurface> planeSurfaces[3];
+    YUV420Read* read = new YUV420Read;
+    read->fCallback = callback;
+    read->fContext = context;
+    for (int i = 0; i < 3; ++i) {
+        read->fPlanes[i].fRead = read;
+        planeSurfaces[i] = this->makeSurface(planeInfos[i]);
+        if (!src || !planeSurfaces[i] || !read->fPlanes[i].fPixels.tryAlloc(planeInfos[i])) {
+            delete read;
+            callback(context, nullptr, nullptr);
+            return;
+        }
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        SkPaint paint;
+        paint.setBlendMode(SkBlendMode::kSrc);
+        paint.setColorFilter(SkColorFilter::MakeMatrixFilterRowMajor255(matrices[i]));
+        // Bilinear filtering averages 2x2 blocks for the half size chroma planes.
+        paint.setFilterQuality(i ? kLow_SkFilterQuality : kNone_SkFilterQuality);
+        planeSurfaces[i]->getCanvas()->drawImageRect(
+                src, SkRect::Make(srcRect), SkRect::Make(planeInfos[i].bounds()), &paint,
+                SkCanvas::kFast_SrcRectConstraint);
+    }
+    // Planes may call back before this returns, so nothing can touch 'read' after the loop.
+    for (int i = 0; i < 3; ++i) {
+        planeSurfaces[i]->asyncReadPixels(planeInfos[i], 0, 0, YUV420Read::PlaneDone,
+                                          &read->fPlanes[i]);
+    }
+}
+
 void SkSurface::writePixels(const SkPixmap& pmap, int x, int y) {
     if (pmap.addr() == nullptr || pmap.width() <= 0 || pmap.height() <= 0) {
         return;
@@ -56,6 +56,13 @@ public:
      */
     virtual void onDraw(SkCanvas*, SkScalar x, SkScalar y, const SkPaint*);
 
+    /**
+     *  Default implementation reads the pixels with readPixels() and calls back before returning.
+     *  The rect has already been checked to be inside the surface.
+     */
+    virtual void onAsyncReadPixels(const SkImageInfo&, int srcX, int srcY, ReadPixelsCallback,
+                                   ReadPixelsContext);
+
     /**
      * Called as a performance hint when the Surface is allowed to make it's contents
      * undefined.
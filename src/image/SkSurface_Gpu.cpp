@@ -133,6 +133,14 @@ void SkSurface_Gpu::onWritePixels(const SkPixmap& src, int x, int y) {
     fDevice->writePixels(src, x, y);
 }
 
+void SkSurface_Gpu::onAsyncReadPixels(const SkImageInfo& info, int srcX, int srcY,
+                                      ReadPixelsCallback callback, ReadPixelsContext context) {
+    GrRenderTargetContext* rtc = fDevice->accessRenderTargetContext();
+    if (!rtc->asyncReadPixels(info, srcX, srcY, callback, context)) {
+        INHERITED::onAsyncReadPixels(info, srcX, srcY, callback, context);
+    }
+}
+
 // Create a new render target and, if necessary, copy the contents of the old
 // render target into it. Note that this flushes the SkGpuDevice but
 // doesn't force an OpenGL flush.
@@ -30,6 +30,8 @@ public:
     sk_sp<SkSurface> onNewSurface(const SkImageInfo&) override;
     sk_sp<SkImage> onNewImageSnapshot(const SkIRect* subset) override;
     void onWritePixels(const SkPixmap&, int x, int y) override;
+    void onAsyncReadPixels(const SkImageInfo&, int srcX, int srcY, ReadPixelsCallback,
+                           ReadPixelsContext) override;
     void onCopyOnWrite(ContentChangeMode) override;
     void onDiscard() override;
     GrSemaphoresSubmitted onFlush(BackendSurfaceAccess access, GrFlushFlags flags,
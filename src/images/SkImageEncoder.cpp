@@ -15,6 +15,10 @@ bool SkJpegEncoder::Encode(SkWStream*, const SkPixmap&, const Options&) { return
 std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream*, const SkPixmap&, const Options&) {
     return nullptr;
 }
+std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream*, const SkImageInfo&, RowSource*,
+                                               const Options&) {
+    return nullptr;
+}
 #endif
 
 #ifndef SK_HAS_PNG_LIBRARY
@@ -22,10 +26,17 @@ bool SkPngEncoder::Encode(SkWStream*, const SkPixmap&, const Options&) { return
 std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream*, const SkPixmap&, const Options&) {
     return nullptr;
 }
+std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream*, const SkImageInfo&, RowSource*,
+                                              const Options&) {
+    return nullptr;
+}
 #endif
 
 #ifndef SK_HAS_WEBP_LIBRARY
 bool SkWebpEncoder::Encode(SkWStream*, const SkPixmap&, const Options&) { return false; }
+bool SkWebpEncoder::EncodeAnimated(SkWStream*, const Frame[], int, const Options&) {
+    return false;
+}
 #endif
 
 bool SkEncodeImage(SkWStream* dst, const SkPixmap& src,
@@ -85,6 +96,19 @@ bool SkEncoder::encodeRows(int numRows) {
         numRows = fSrc.height() - fCurrRow;
     }
 
+    if (fRowSource) {
+        if (numRows > fRowsAllocated) {
+            fRows.reset(numRows * fSrc.rowBytes());
+            fRowsAllocated = numRows;
+        }
+
+        SkPixmap rows(fSrc.info().makeWH(fSrc.width(), numRows), fRows.get(), fSrc.rowBytes());
+        if (!fRowSource->readRows(fCurrRow, rows)) {
+            fCurrRow = fSrc.height();
+            return false;
+        }
+    }
+
     if (!this->onEncodeRows(numRows)) {
         // If we fail, short circuit any future calls.
         fCurrRow = fSrc.height();
@@ -94,6 +118,15 @@ bool SkEncoder::encodeRows(int numRows) {
     return true;
 }
 
+const void* SkEncoder::srcRow(int y) const {
+    if (fRowSource) {
+        SkASSERT(fCurrRow <= y && y < fCurrRow + fRowsAllocated);
+        return fRows.get() + (y - fCurrRow) * fSrc.rowBytes();
+    }
+
+    return fSrc.addr(0, y);
+}
+
 sk_sp<SkData> SkEncodePixmap(const SkPixmap& src, SkEncodedImageFormat format, int quality) {
     SkDynamicMemoryWStream stream;
     return SkEncodeImage(&stream, src, format, quality) ? stream.detachAsData() : nullptr;
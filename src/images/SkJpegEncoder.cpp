@@ -163,12 +163,8 @@ bool SkJpegEncoderMgr::setParams(const SkImageInfo& srcInfo, const SkJpegEncoder
     return true;
 }
 
-std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream* dst, const SkPixmap& src,
-                                               const Options& options) {
-    if (!SkPixmapIsValid(src)) {
-        return nullptr;
-    }
-
+static std::unique_ptr<SkJpegEncoderMgr> make_encoder_mgr(SkWStream* dst, const SkImageInfo& info,
+                                                          const SkJpegEncoder::Options& options) {
     std::unique_ptr<SkJpegEncoderMgr> encoderMgr = SkJpegEncoderMgr::Make(dst);
 
     skjpeg_error_mgr::AutoPushJmpBuf jmp(encoderMgr->errorMgr());
@@ -176,14 +172,14 @@ std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream* dst, const SkPixmap& s
         return nullptr;
     }
 
-    if (!encoderMgr->setParams(src.info(), options)) {
+    if (!encoderMgr->setParams(info, options)) {
         return nullptr;
     }
 
     jpeg_set_quality(encoderMgr->cinfo(), options.fQuality, TRUE);
     jpeg_start_compress(encoderMgr->cinfo(), TRUE);
 
-    sk_sp<SkData> icc = icc_from_color_space(src.info());
+    sk_sp<SkData> icc = icc_from_color_space(info);
     if (icc) {
         // Create a contiguous block of memory with the icc signature followed by the profile.
         sk_sp<SkData> markerData =
@@ -198,14 +194,49 @@ std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream* dst, const SkPixmap& s
         jpeg_write_marker(encoderMgr->cinfo(), kICCMarker, markerData->bytes(), markerData->size());
     }
 
+    return encoderMgr;
+}
+
+std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream* dst, const SkPixmap& src,
+                                               const Options& options) {
+    if (!SkPixmapIsValid(src)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SkJpegEncoderMgr> encoderMgr = make_encoder_mgr(dst, src.info(), options);
+    if (!encoderMgr) {
+        return nullptr;
+    }
+
     return std::unique_ptr<SkJpegEncoder>(new SkJpegEncoder(std::move(encoderMgr), src));
 }
 
+std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream* dst, const SkImageInfo& info,
+                                               RowSource* source, const Options& options) {
+    if (!SkImageInfoIsValid(info) || !source) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SkJpegEncoderMgr> encoderMgr = make_encoder_mgr(dst, info, options);
+    if (!encoderMgr) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<SkJpegEncoder>(new SkJpegEncoder(std::move(encoderMgr), info, source));
+}
+
 SkJpegEncoder::SkJpegEncoder(std::unique_ptr<SkJpegEncoderMgr> encoderMgr, const SkPixmap& src)
     : INHERITED(src, encoderMgr->proc() ? encoderMgr->cinfo()->input_components*src.width() : 0)
     , fEncoderMgr(std::move(encoderMgr))
 {}
 
+SkJpegEncoder::SkJpegEncoder(std::unique_ptr<SkJpegEncoderMgr> encoderMgr, const SkImageInfo& info,
+                             RowSource* source)
+    : INHERITED(info, source,
+                encoderMgr->proc() ? encoderMgr->cinfo()->input_components*info.width() : 0)
+    , fEncoderMgr(std::move(encoderMgr))
+{}
+
 SkJpegEncoder::~SkJpegEncoder() {}
 
 bool SkJpegEncoder::onEncodeRows(int numRows) {
@@ -214,8 +245,8 @@ bool SkJpegEncoder::onEncodeRows(int numRows) {
         return false;
     }
 
-    const void* srcRow = fSrc.addr(0, fCurrRow);
     for (int i = 0; i < numRows; i++) {
+        const void* srcRow = this->srcRow(fCurrRow + i);
         JSAMPLE* jpegSrcRow = (JSAMPLE*) srcRow;
         if (fEncoderMgr->proc()) {
             fEncoderMgr->proc()((char*)fStorage.get(),
@@ -226,7 +257,6 @@ bool SkJpegEncoder::onEncodeRows(int numRows) {
         }
 
         jpeg_write_scanlines(fEncoderMgr->cinfo(), &jpegSrcRow, 1);
-        srcRow = SkTAddOffset<const void>(srcRow, fSrc.rowBytes());
     }
 
     fCurrRow += numRows;
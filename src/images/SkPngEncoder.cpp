@@ -372,39 +372,68 @@ void SkPngEncoderMgr::chooseProc(const SkImageInfo& srcInfo) {
     fProc = choose_proc(srcInfo);
 }
 
-std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkPixmap& src,
-                                              const Options& options) {
-    if (!SkPixmapIsValid(src)) {
+static std::unique_ptr<SkPngEncoderMgr> make_encoder_mgr(SkWStream* dst, const SkImageInfo& info,
+                                                         const SkPngEncoder::Options& options) {
+    std::unique_ptr<SkPngEncoderMgr> encoderMgr = SkPngEncoderMgr::Make(dst);
+    if (!encoderMgr) {
         return nullptr;
     }
 
-    std::unique_ptr<SkPngEncoderMgr> encoderMgr = SkPngEncoderMgr::Make(dst);
-    if (!encoderMgr) {
+    if (!encoderMgr->setHeader(info, options)) {
         return nullptr;
     }
 
-    if (!encoderMgr->setHeader(src.info(), options)) {
+    if (!encoderMgr->setColorSpace(info)) {
         return nullptr;
     }
 
-    if (!encoderMgr->setColorSpace(src.info())) {
+    if (!encoderMgr->writeInfo(info)) {
         return nullptr;
     }
 
-    if (!encoderMgr->writeInfo(src.info())) {
+    encoderMgr->chooseProc(info);
+    return encoderMgr;
+}
+
+std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkPixmap& src,
+                                              const Options& options) {
+    if (!SkPixmapIsValid(src)) {
         return nullptr;
     }
 
-    encoderMgr->chooseProc(src.info());
+    std::unique_ptr<SkPngEncoderMgr> encoderMgr = make_encoder_mgr(dst, src.info(), options);
+    if (!encoderMgr) {
+        return nullptr;
+    }
 
     return std::unique_ptr<SkPngEncoder>(new SkPngEncoder(std::move(encoderMgr), src));
 }
 
+std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkImageInfo& info,
+                                              RowSource* source, const Options& options) {
+    if (!SkImageInfoIsValid(info) || !source) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SkPngEncoderMgr> encoderMgr = make_encoder_mgr(dst, info, options);
+    if (!encoderMgr) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<SkPngEncoder>(new SkPngEncoder(std::move(encoderMgr), info, source));
+}
+
 SkPngEncoder::SkPngEncoder(std::unique_ptr<SkPngEncoderMgr> encoderMgr, const SkPixmap& src)
     : INHERITED(src, encoderMgr->pngBytesPerPixel() * src.width())
     , fEncoderMgr(std::move(encoderMgr))
 {}
 
+SkPngEncoder::SkPngEncoder(std::unique_ptr<SkPngEncoderMgr> encoderMgr, const SkImageInfo& info,
+                           RowSource* source)
+    : INHERITED(info, source, encoderMgr->pngBytesPerPixel() * info.width())
+    , fEncoderMgr(std::move(encoderMgr))
+{}
+
 SkPngEncoder::~SkPngEncoder() {}
 
 bool SkPngEncoder::onEncodeRows(int numRows) {
@@ -412,16 +441,14 @@ bool SkPngEncoder::onEncodeRows(int numRows) {
         return false;
     }
 
-    const void* srcRow = fSrc.addr(0, fCurrRow);
     for (int y = 0; y < numRows; y++) {
         fEncoderMgr->proc()((char*)fStorage.get(),
-                            (const char*)srcRow,
+                            (const char*)this->srcRow(fCurrRow + y),
                             fSrc.width(),
                             SkColorTypeBytesPerPixel(fSrc.colorType()));
 
         png_bytep rowPtr = (png_bytep) fStorage.get();
         png_write_rows(fEncoderMgr->pngPtr(), &rowPtr, 1);
-        srcRow = SkTAddOffset<const void>(srcRow, fSrc.rowBytes());
     }
 
     fCurrRow += numRows;
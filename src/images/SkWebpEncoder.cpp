@@ -22,6 +22,7 @@
 #include "SkColorData.h"
 #include "SkImageEncoderFns.h"
 #include "SkStream.h"
+#include "SkTaskGroup.h"
 #include "SkTemplates.h"
 #include "SkUnPreMultiply.h"
 #include "SkUTF.h"
@@ -34,6 +35,7 @@
 //   http://review.webmproject.org/gitweb?p=libwebp.git
 
 #include <stdio.h>
+#include <vector>
 extern "C" {
 // If moving libwebp out of skia source tree, path for webp headers must be
 // updated accordingly. Here, we enforce using local copy in webp sub-directory.
@@ -103,11 +105,37 @@ static int stream_writer(const uint8_t* data, size_t data_size,
   return stream->write(data, data_size) ? 1 : 0;
 }
 
-bool SkWebpEncoder::Encode(SkWStream* stream, const SkPixmap& pixmap, const Options& opts) {
-    if (!SkPixmapIsValid(pixmap)) {
-        return false;
+// Sets libwebp's effort knobs for |speed|.  Lossless encodes have no segments or partitions.
+static void set_speed(WebPConfig* config, SkWebpEncoder::Speed speed) {
+    struct Preset { int method, segments, partitions; };
+    static const Preset kLossyPresets[] = {
+        { 3, 4, 0 },  // kDefault
+        { 0, 1, 3 },  // kFastest
+        { 2, 2, 3 },  // kFast
+        { 5, 4, 0 },  // kSmall
+        { 6, 4, 0 },  // kSmallest
+    };
+    static const int kLosslessMethods[] = { 0, 0, 1, 4, 6 };
+
+    const int index = (int)speed;
+    if (config->lossless) {
+        config->method = kLosslessMethods[index];
+        return;
     }
 
+#ifdef SK_WEBP_ENCODER_USE_DEFAULT_METHOD
+    if (SkWebpEncoder::Speed::kDefault == speed) {
+        return;
+    }
+#endif
+    config->method     = kLossyPresets[index].method;
+    config->segments   = kLossyPresets[index].segments;
+    config->partitions = kLossyPresets[index].partitions;
+}
+
+// Encodes |pixmap| to |stream| as a webp bitstream with no ICC profile.
+static bool encode_image(SkWStream* stream, const SkPixmap& pixmap,
+                         const SkWebpEncoder::Options& opts) {
     const transform_scanline_proc proc = choose_proc(pixmap.info());
     if (!proc) {
         return false;
@@ -135,29 +163,19 @@ bool SkWebpEncoder::Encode(SkWStream* stream, const SkPixmap& pixmap, const Opti
     pic.width = pixmap.width();
     pic.height = pixmap.height();
     pic.writer = stream_writer;
+    pic.custom_ptr = (void*)stream;
 
     // Set compression, method, and pixel format.
     // libwebp recommends using BGRA for lossless and YUV for lossy.
-    // The choices of |webp_config.method| currently just match Chrome's defaults.  We
-    // could potentially expose this decision to the client.
-    if (Compression::kLossy == opts.fCompression) {
+    if (SkWebpEncoder::Compression::kLossy == opts.fCompression) {
         webp_config.lossless = 0;
-#ifndef SK_WEBP_ENCODER_USE_DEFAULT_METHOD
-        webp_config.method = 3;
-#endif
         pic.use_argb = 0;
     } else {
         webp_config.lossless = 1;
-        webp_config.method = 0;
         pic.use_argb = 1;
     }
-
-    // If there is no need to embed an ICC profile, we write directly to the input stream.
-    // Otherwise, we will first encode to |tmp| and use a mux to add the ICC chunk.  libwebp
-    // forces us to have an encoded image before we can add a profile.
-    sk_sp<SkData> icc = icc_from_color_space(pixmap.info());
-    SkDynamicMemoryWStream tmp;
-    pic.custom_ptr = icc ? (void*)&tmp : (void*)stream;
+    set_speed(&webp_config, opts.fSpeed);
+    webp_config.thread_level = opts.fExecutor ? 1 : 0;
 
     const uint8_t* src = (uint8_t*)pixmap.addr();
     const int rgbStride = pic.width * bpp;
@@ -186,34 +204,115 @@ bool SkWebpEncoder::Encode(SkWStream* stream, const SkPixmap& pixmap, const Opti
         return false;
     }
 
-    if (!WebPEncode(&webp_config, &pic)) {
-        return false;
-    }
+    return WebPEncode(&webp_config, &pic);
+}
 
+// Adds |icc|, if any, to |mux| and writes the assembled webp to |stream|.
+static bool write_mux(SkWStream* stream, WebPMux* mux, const sk_sp<SkData>& icc) {
     if (icc) {
-        sk_sp<SkData> encodedData = tmp.detachAsData();
-        WebPData encoded = { encodedData->bytes(), encodedData->size() };
         WebPData iccChunk = { icc->bytes(), icc->size() };
+        if (WEBP_MUX_OK != WebPMuxSetChunk(mux, "ICCP", &iccChunk, 0)) {
+            return false;
+        }
+    }
+
+    WebPData assembled;
+    if (WEBP_MUX_OK != WebPMuxAssemble(mux, &assembled)) {
+        return false;
+    }
+
+    bool success = stream->write(assembled.bytes, assembled.size);
+    WebPDataClear(&assembled);
+    return success;
+}
+
+bool SkWebpEncoder::Encode(SkWStream* stream, const SkPixmap& pixmap, const Options& opts) {
+    if (!SkPixmapIsValid(pixmap)) {
+        return false;
+    }
+
+    // If there is no need to embed an ICC profile, we write directly to the input stream.
+    // Otherwise, we will first encode to |tmp| and use a mux to add the ICC chunk.  libwebp
+    // forces us to have an encoded image before we can add a profile.
+    sk_sp<SkData> icc = icc_from_color_space(pixmap.info());
+    if (!icc) {
+        return encode_image(stream, pixmap, opts);
+    }
+
+    SkDynamicMemoryWStream tmp;
+    if (!encode_image(&tmp, pixmap, opts)) {
+        return false;
+    }
+
+    sk_sp<SkData> encodedData = tmp.detachAsData();
+    WebPData encoded = { encodedData->bytes(), encodedData->size() };
+
+    SkAutoTCallVProc<WebPMux, WebPMuxDelete> mux(WebPMuxNew());
+    if (WEBP_MUX_OK != WebPMuxSetImage(mux, &encoded, 0)) {
+        return false;
+    }
+
+    return write_mux(stream, mux, icc);
+}
+
+bool SkWebpEncoder::EncodeAnimated(SkWStream* stream, const Frame frames[], int frameCount,
+                                   const Options& opts) {
+    if (frameCount < 1) {
+        return false;
+    }
 
-        SkAutoTCallVProc<WebPMux, WebPMuxDelete> mux(WebPMuxNew());
-        if (WEBP_MUX_OK != WebPMuxSetImage(mux, &encoded, 0)) {
+    const SkImageInfo& info = frames[0].fPixmap.info();
+    for (int i = 0; i < frameCount; i++) {
+        if (!SkPixmapIsValid(frames[i].fPixmap) ||
+                frames[i].fPixmap.info().dimensions() != info.dimensions() ||
+                frames[i].fDuration < 0) {
             return false;
         }
+    }
 
-        if (WEBP_MUX_OK != WebPMuxSetChunk(mux, "ICCP", &iccChunk, 0)) {
+    // Each frame is independent, so they can all be encoded at once.
+    std::vector<sk_sp<SkData>> encoded(frameCount);
+    auto encodeFrame = [&](int i) {
+        SkDynamicMemoryWStream tmp;
+        if (encode_image(&tmp, frames[i].fPixmap, opts)) {
+            encoded[i] = tmp.detachAsData();
+        }
+    };
+    if (opts.fExecutor) {
+        SkTaskGroup taskGroup(*opts.fExecutor);
+        taskGroup.batch(frameCount, encodeFrame);
+        taskGroup.wait();
+    } else {
+        for (int i = 0; i < frameCount; i++) {
+            encodeFrame(i);
+        }
+    }
+
+    SkAutoTCallVProc<WebPMux, WebPMuxDelete> mux(WebPMuxNew());
+    for (int i = 0; i < frameCount; i++) {
+        if (!encoded[i]) {
             return false;
         }
 
-        WebPData assembled;
-        if (WEBP_MUX_OK != WebPMuxAssemble(mux, &assembled)) {
+        WebPMuxFrameInfo frameInfo;
+        memset(&frameInfo, 0, sizeof(frameInfo));
+        frameInfo.bitstream = { encoded[i]->bytes(), encoded[i]->size() };
+        frameInfo.duration = frames[i].fDuration;
+        frameInfo.id = WEBP_CHUNK_ANMF;
+        frameInfo.dispose_method = WEBP_MUX_DISPOSE_NONE;
+        frameInfo.blend_method = WEBP_MUX_NO_BLEND;
+        if (WEBP_MUX_OK != WebPMuxPushFrame(mux, &frameInfo, 0)) {
             return false;
         }
+    }
 
-        stream->write(assembled.bytes, assembled.size);
-        WebPDataClear(&assembled);
+    WebPMuxAnimParams params = { 0, 0 };  // A transparent background, looping forever.
+    if (WEBP_MUX_OK != WebPMuxSetCanvasSize(mux, info.width(), info.height()) ||
+            WEBP_MUX_OK != WebPMuxSetAnimationParams(mux, &params)) {
+        return false;
     }
 
-    return true;
+    return write_mux(stream, mux, icc_from_color_space(info));
 }
 
 #endif
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMatrix_opts_DEFINED
+#define SkMatrix_opts_DEFINED
+
+#include "SkMatrix.h"
+#include "SkNx.h"
+
+namespace SK_OPTS_NS {
+
+    // These map N points per iteration, with their x's and y's deinterleaved into separate
+    // vectors, then map any leftover points one at a time with the same math.
+#if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX
+    static const int kMapPtsN = 8;
+#else
+    static const int kMapPtsN = 4;
+#endif
+    using MapPtsF = SkNx<kMapPtsN, float>;
+
+    /*not static*/ inline void matrix_map_affine_pts(const SkMatrix& m, SkPoint dst[],
+                                                     const SkPoint src[], int count) {
+        const float sx = m.getScaleX(), kx = m.getSkewX(), tx = m.getTranslateX(),
+                    ky = m.getSkewY(), sy = m.getScaleY(), ty = m.getTranslateY();
+        for (; count >= kMapPtsN; count -= kMapPtsN) {
+            MapPtsF x, y;
+            MapPtsF::Load2(src, &x, &y);
+            MapPtsF::Store2(dst, x * sx + y * kx + tx,
+                                 x * ky + y * sy + ty);
+            src += kMapPtsN;
+            dst += kMapPtsN;
+        }
+        for (; count > 0; --count) {
+            dst->set(src->fX * sx + src->fY * kx + tx,
+                     src->fX * ky + src->fY * sy + ty);
+            src += 1;
+            dst += 1;
+        }
+    }
+
+    /*not static*/ inline void matrix_map_persp_pts(const SkMatrix& m, SkPoint dst[],
+                                                    const SkPoint src[], int count) {
+        const float sx = m.getScaleX(), kx = m.getSkewX(),  tx = m.getTranslateX(),
+                    ky = m.getSkewY(),  sy = m.getScaleY(), ty = m.getTranslateY(),
+                    p0 = m.getPerspX(), p1 = m.getPerspY(), p2 = m.get(SkMatrix::kMPersp2);
+        for (; count >= kMapPtsN; count -= kMapPtsN) {
+            MapPtsF x, y;
+            MapPtsF::Load2(src, &x, &y);
+        #ifdef SK_LEGACY_MATRIX_MATH_ORDER
+            MapPtsF z = x * p0 + (y * p1 + p2);
+        #else
+            MapPtsF z = x * p0 + y * p1 + p2;
+        #endif
+            // Points at infinity map to zero, as they do one at a time below.
+            z = (z != 0).thenElse(MapPtsF(1) / z, 0);
+            MapPtsF::Store2(dst, (x * sx + y * kx + tx) * z,
+                                 (x * ky + y * sy + ty) * z);
+            src += kMapPtsN;
+            dst += kMapPtsN;
+        }
+        for (; count > 0; --count) {
+            float x = src->fX * sx + src->fY * kx + tx,
+                  y = src->fX * ky + src->fY * sy + ty;
+        #ifdef SK_LEGACY_MATRIX_MATH_ORDER
+            float z = src->fX * p0 + (src->fY * p1 + p2);
+        #else
+            float z = src->fX * p0 + src->fY * p1 + p2;
+        #endif
+            if (z) {
+                z = 1 / z;
+            }
+            dst->set(x * z, y * z);
+            src += 1;
+            dst += 1;
+        }
+    }
+
+}  // namespace SK_OPTS_NS
+
+#endif//SkMatrix_opts_DEFINED
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMipMap_opts_DEFINED
+#define SkMipMap_opts_DEFINED
+
+#include "SkNx.h"
+
+namespace SK_OPTS_NS {
+
+// Box filters each 2x2 block of 8888 pixels, from two src rows, down to one dst pixel.
+// This matches the portable filter in SkMipMap.cpp exactly: each channel is (a+b+c+d) >> 2.
+/*not static*/ inline void downsample_2_2_8888(void* dst, const void* src, size_t srcRB,
+                                               int count) {
+    SkASSERT(count > 0);
+    auto p0 = static_cast<const uint32_t*>(src);
+    auto p1 = (const uint32_t*)((const char*)p0 + srcRB);
+    auto d  = static_cast<uint32_t*>(dst);
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    while (count >= 2) {
+        __m128i r0 = _mm_loadu_si128((const __m128i*)p0),
+                r1 = _mm_loadu_si128((const __m128i*)p1);
+
+        // Widen to 16-bit channels and add the two rows: src pixels {0,1} and {2,3}.
+        __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(r0, zero), _mm_unpacklo_epi8(r1, zero)),
+                hi = _mm_add_epi16(_mm_unpackhi_epi8(r0, zero), _mm_unpackhi_epi8(r1, zero));
+
+        // Add neighboring columns, leaving each dst pixel's sums in the low 4 channels.
+        lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+        hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+
+        __m128i sum = _mm_srli_epi16(_mm_unpacklo_epi64(lo, hi), 2);
+        _mm_storel_epi64((__m128i*)d, _mm_packus_epi16(sum, sum));
+
+        p0 += 4;
+        p1 += 4;
+        d  += 2;
+        count -= 2;
+    }
+#elif defined(SK_ARM_HAS_NEON)
+    while (count >= 2) {
+        // De-interleave even and odd src columns, then widen and add all four.
+        uint32x2x2_t r0 = vld2_u32(p0),
+                     r1 = vld2_u32(p1);
+        uint16x8_t sum = vaddq_u16(vaddl_u8(vreinterpret_u8_u32(r0.val[0]),
+                                            vreinterpret_u8_u32(r0.val[1])),
+                                   vaddl_u8(vreinterpret_u8_u32(r1.val[0]),
+                                            vreinterpret_u8_u32(r1.val[1])));
+        vst1_u8((uint8_t*)d, vshrn_n_u16(sum, 2));
+
+        p0 += 4;
+        p1 += 4;
+        d  += 2;
+        count -= 2;
+    }
+#endif
+
+    while (count --> 0) {
+        Sk4h c = SkNx_cast<uint16_t>(Sk4b::Load(p0 + 0)) + SkNx_cast<uint16_t>(Sk4b::Load(p0 + 1))
+               + SkNx_cast<uint16_t>(Sk4b::Load(p1 + 0)) + SkNx_cast<uint16_t>(Sk4b::Load(p1 + 1));
+        SkNx_cast<uint8_t>(c >> 2).store(d);
+
+        p0 += 2;
+        p1 += 2;
+        d  += 1;
+    }
+}
+
+}
+
+#endif//SkMipMap_opts_DEFINED
@@ -0,0 +1,25 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkOpts.h"
+
+// Lowp stages already fill 16 lanes using AVX2, and SkRasterPipeline_kMaxStride is 16,
+// so SKX only replaces the highp stages.  The lowp stages from Init_hsw() stay in place.
+#define SK_DISABLE_LOWP_RASTER_PIPELINE
+
+#define SK_OPTS_NS skx
+#include "SkRasterPipeline_opts.h"
+
+namespace SkOpts {
+    void Init_skx() {
+    #define M(st) stages_highp[SkRasterPipeline::st] = (StageFn)SK_OPTS_NS::st;
+        SK_RASTER_PIPELINE_STAGES(M)
+        just_return_highp = (StageFn)SK_OPTS_NS::just_return;
+        start_pipeline_highp = SK_OPTS_NS::start_pipeline;
+    #undef M
+    }
+}
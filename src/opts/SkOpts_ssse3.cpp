@@ -9,6 +9,7 @@
 #define SK_OPTS_NS ssse3
 #include "SkBitmapProcState_opts.h"
 #include "SkBlitMask_opts.h"
+#include "SkPngFilter_opts.h"
 #include "SkSwizzler_opts.h"
 #include "SkXfermode_opts.h"
 
@@ -27,6 +28,15 @@ namespace SkOpts {
         grayA_to_rgbA         = ssse3::grayA_to_rgbA;
         inverted_CMYK_to_RGB1 = ssse3::inverted_CMYK_to_RGB1;
         inverted_CMYK_to_BGR1 = ssse3::inverted_CMYK_to_BGR1;
+        RGB16_to_RGB1         = ssse3::RGB16_to_RGB1;
+        RGB16_to_BGR1         = ssse3::RGB16_to_BGR1;
+        RGBA16_to_RGBA        = ssse3::RGBA16_to_RGBA;
+        RGBA16_to_BGRA        = ssse3::RGBA16_to_BGRA;
+        RGBA16_to_rgbA        = ssse3::RGBA16_to_rgbA;
+        RGBA16_to_bgrA        = ssse3::RGBA16_to_bgrA;
+
+        png_unfilter_paeth3 = ssse3::png_unfilter_paeth3;
+        png_unfilter_paeth4 = ssse3::png_unfilter_paeth4;
 
         S32_alpha_D32_filter_DX  = ssse3::S32_alpha_D32_filter_DX;
     }
@@ -0,0 +1,231 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPngFilter_opts_DEFINED
+#define SkPngFilter_opts_DEFINED
+
+#include "SkTypes.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSSE3
+    #include <immintrin.h>
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    #include <emmintrin.h>
+#elif defined(SK_ARM_HAS_NEON)
+    #include <arm_neon.h>
+#endif
+
+// Each of these undoes one PNG filter type in place on a row of bytes, given the previous row
+// (already unfiltered, or all zeros for the first row).  Sub, Avg and Paeth depend on the pixel
+// to the left, so there's no parallelism across pixels; the vector versions work on all the
+// channels of one pixel at a time instead, like libpng's own SSE2 and NEON filters.
+
+namespace SK_OPTS_NS {
+
+static void png_unfilter_up(uint8_t* row, const uint8_t* prev, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        row[i] += prev[i];
+    }
+}
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+
+// Loads and stores of one 3- or 4-byte pixel in the low lanes of a vector.
+template <int bpp>
+static __m128i png_load(const uint8_t* p) {
+    int v = 0;
+    memcpy(&v, p, bpp);
+    return _mm_cvtsi32_si128(v);
+}
+
+template <int bpp>
+static void png_store(uint8_t* p, __m128i v) {
+    int x = _mm_cvtsi128_si32(v);
+    memcpy(p, &x, bpp);
+}
+
+template <int bpp>
+static void png_sub(uint8_t* row, const uint8_t*, int bytes) {
+    __m128i a = _mm_setzero_si128();
+    for (int i = 0; i < bytes; i += bpp) {
+        a = _mm_add_epi8(a, png_load<bpp>(row + i));
+        png_store<bpp>(row + i, a);
+    }
+}
+
+template <int bpp>
+static void png_avg(uint8_t* row, const uint8_t* prev, int bytes) {
+    const __m128i ones = _mm_set1_epi8(1);
+    __m128i a = _mm_setzero_si128();
+    for (int i = 0; i < bytes; i += bpp) {
+        __m128i b = png_load<bpp>(prev + i);
+        // _mm_avg_epu8 rounds up; PNG rounds down.
+        __m128i avg = _mm_sub_epi8(_mm_avg_epu8(a, b),
+                                   _mm_and_si128(_mm_xor_si128(a, b), ones));
+        a = _mm_add_epi8(png_load<bpp>(row + i), avg);
+        png_store<bpp>(row + i, a);
+    }
+}
+
+static __m128i png_abs_i16(__m128i x) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSSE3
+    return _mm_abs_epi16(x);
+#else
+    return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+#endif
+}
+
+static __m128i png_select(__m128i c, __m128i t, __m128i e) {
+    return _mm_or_si128(_mm_and_si128(c, t), _mm_andnot_si128(c, e));
+}
+
+template <int bpp>
+static void png_paeth(uint8_t* row, const uint8_t* prev, int bytes) {
+    // All the math is done on 16-bit lanes, so pa, pb and pc can't overflow.
+    const __m128i zero = _mm_setzero_si128();
+    __m128i a = zero,
+            c = zero;
+    for (int i = 0; i < bytes; i += bpp) {
+        __m128i b = _mm_unpacklo_epi8(png_load<bpp>(prev + i), zero),
+                x = _mm_unpacklo_epi8(png_load<bpp>(row  + i), zero);
+
+        __m128i pa = _mm_sub_epi16(b, c),
+                pb = _mm_sub_epi16(a, c),
+                pc = png_abs_i16(_mm_add_epi16(pa, pb));
+        pa = png_abs_i16(pa);
+        pb = png_abs_i16(pb);
+
+        __m128i smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+        __m128i nearest  = png_select(_mm_cmpeq_epi16(smallest, pa), a,
+                           png_select(_mm_cmpeq_epi16(smallest, pb), b,
+                                                                     c));
+
+        a = _mm_and_si128(_mm_add_epi16(x, nearest), _mm_set1_epi16(0xFF));
+        c = b;
+        png_store<bpp>(row + i, _mm_packus_epi16(a, a));
+    }
+}
+
+#elif defined(SK_ARM_HAS_NEON)
+
+template <int bpp>
+static uint8x8_t png_load(const uint8_t* p) {
+    uint32_t v = 0;
+    memcpy(&v, p, bpp);
+    return vreinterpret_u8_u32(vdup_n_u32(v));
+}
+
+template <int bpp>
+static void png_store(uint8_t* p, uint8x8_t v) {
+    uint32_t x = vget_lane_u32(vreinterpret_u32_u8(v), 0);
+    memcpy(p, &x, bpp);
+}
+
+template <int bpp>
+static void png_sub(uint8_t* row, const uint8_t*, int bytes) {
+    uint8x8_t a = vdup_n_u8(0);
+    for (int i = 0; i < bytes; i += bpp) {
+        a = vadd_u8(a, png_load<bpp>(row + i));
+        png_store<bpp>(row + i, a);
+    }
+}
+
+template <int bpp>
+static void png_avg(uint8_t* row, const uint8_t* prev, int bytes) {
+    uint8x8_t a = vdup_n_u8(0);
+    for (int i = 0; i < bytes; i += bpp) {
+        // vhadd_u8 rounds down, just like PNG.
+        a = vadd_u8(png_load<bpp>(row + i), vhadd_u8(a, png_load<bpp>(prev + i)));
+        png_store<bpp>(row + i, a);
+    }
+}
+
+template <int bpp>
+static void png_paeth(uint8_t* row, const uint8_t* prev, int bytes) {
+    uint8x8_t a = vdup_n_u8(0),
+              c = vdup_n_u8(0);
+    for (int i = 0; i < bytes; i += bpp) {
+        uint8x8_t b = png_load<bpp>(prev + i);
+
+        uint16x8_t pa = vabdl_u8(b, c),
+                   pb = vabdl_u8(a, c),
+                   pc = vabdq_u16(vaddl_u8(a, b), vshll_n_u8(c, 1));
+
+        uint16x8_t smallest = vminq_u16(pc, vminq_u16(pa, pb));
+        uint8x8_t  nearest  = vbsl_u8(vmovn_u16(vceqq_u16(smallest, pa)), a,
+                              vbsl_u8(vmovn_u16(vceqq_u16(smallest, pb)), b,
+                                                                          c));
+
+        a = vadd_u8(png_load<bpp>(row + i), nearest);
+        c = b;
+        png_store<bpp>(row + i, a);
+    }
+}
+
+#else
+
+template <int bpp>
+static void png_sub(uint8_t* row, const uint8_t*, int bytes) {
+    for (int i = bpp; i < bytes; i++) {
+        row[i] += row[i - bpp];
+    }
+}
+
+template <int bpp>
+static void png_avg(uint8_t* row, const uint8_t* prev, int bytes) {
+    for (int i = 0; i < bpp; i++) {
+        row[i] += prev[i] >> 1;
+    }
+    for (int i = bpp; i < bytes; i++) {
+        row[i] += (row[i - bpp] + prev[i]) >> 1;
+    }
+}
+
+template <int bpp>
+static void png_paeth(uint8_t* row, const uint8_t* prev, int bytes) {
+    for (int i = 0; i < bpp; i++) {
+        row[i] += prev[i];
+    }
+    for (int i = bpp; i < bytes; i++) {
+        int a = row[i - bpp],
+            b = prev[i],
+            c = prev[i - bpp];
+        int pa = SkTAbs(b - c),
+            pb = SkTAbs(a - c),
+            pc = SkTAbs(a + b - 2*c);
+        row[i] += (pa <= pb && pa <= pc) ? a
+                : (pb <= pc)             ? b
+                :                          c;
+    }
+}
+
+#endif
+
+static void png_unfilter_sub3(uint8_t* row, const uint8_t* prev, int bytes) {
+    png_sub<3>(row, prev, bytes);
+}
+static void png_unfilter_sub4(uint8_t* row, const uint8_t* prev, int bytes) {
+    png_sub<4>(row, prev, bytes);
+}
+static void png_unfilter_avg3(uint8_t* row, const uint8_t* prev, int bytes) {
+    png_avg<3>(row, prev, bytes);
+}
+static void png_unfilter_avg4(uint8_t* row, const uint8_t* prev, int bytes) {
+    png_avg<4>(row, prev, bytes);
+}
+static void png_unfilter_paeth3(uint8_t* row, const uint8_t* prev, int bytes) {
+    png_paeth<3>(row, prev, bytes);
+}
+static void png_unfilter_paeth4(uint8_t* row, const uint8_t* prev, int bytes) {
+    png_paeth<4>(row, prev, bytes);
+}
+
+}  // namespace SK_OPTS_NS
+
+#endif//SkPngFilter_opts_DEFINED
@@ -289,7 +289,114 @@ namespace SK_OPTS_NS {
         }
     }
 
-#elif defined(JUMPER_IS_AVX) || defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#elif defined(JUMPER_IS_AVX512)
+    // These are __m512 and __m512i, but friendlier and strongly-typed.
+    template <typename T> using V = T __attribute__((ext_vector_type(16)));
+    using F   = V<float   >;
+    using I32 = V< int32_t>;
+    using U64 = V<uint64_t>;
+    using U32 = V<uint32_t>;
+    using U16 = V<uint16_t>;
+    using U8  = V<uint8_t >;
+
+    SI F   mad(F f, F m, F a)   { return _mm512_fmadd_ps(f,m,a); }
+    SI F   min(F a, F b)        { return _mm512_min_ps(a,b);     }
+    SI F   max(F a, F b)        { return _mm512_max_ps(a,b);     }
+    SI F   abs_  (F v)          { return _mm512_abs_ps(v);       }
+    SI F   floor_(F v)          { return _mm512_roundscale_ps(v, _MM_FROUND_TO_NEG_INF); }
+    SI F   rcp   (F v)          { return _mm512_rcp14_ps  (v);   }
+    SI F   rsqrt (F v)          { return _mm512_rsqrt14_ps(v);   }
+    SI F    sqrt_(F v)          { return _mm512_sqrt_ps   (v);   }
+    SI U32 round (F v, F scale) { return (U32)_mm512_cvtps_epi32(v*scale); }
+
+    SI U16 pack(U32 v) { return (U16)_mm512_cvtusepi32_epi16((__m512i)v); }
+    SI U8  pack(U16 v) { return (U8 )_mm256_cvtusepi16_epi8 ((__m256i)v); }
+
+    SI F if_then_else(I32 c, F t, F e) {
+        return _mm512_mask_blend_ps(_mm512_test_epi32_mask((__m512i)c, (__m512i)c), e,t);
+    }
+
+    template <typename T>
+    SI V<T> gather(const T* p, U32 ix) {
+        return { p[ix[ 0]], p[ix[ 1]], p[ix[ 2]], p[ix[ 3]],
+                 p[ix[ 4]], p[ix[ 5]], p[ix[ 6]], p[ix[ 7]],
+                 p[ix[ 8]], p[ix[ 9]], p[ix[10]], p[ix[11]],
+                 p[ix[12]], p[ix[13]], p[ix[14]], p[ix[15]], };
+    }
+    SI F   gather(const float*    p, U32 ix) { return _mm512_i32gather_ps((__m512i)ix, p, 4); }
+    SI U32 gather(const uint32_t* p, U32 ix) {
+        return (U32)_mm512_i32gather_epi32((__m512i)ix, p, 4);
+    }
+    SI U64 gather(const uint64_t* p, U32 ix) {
+        __m512i parts[] = {
+            _mm512_i32gather_epi64(_mm512_castsi512_si256   ((__m512i)ix   ), p, 8),
+            _mm512_i32gather_epi64(_mm512_extracti64x4_epi64((__m512i)ix, 1), p, 8),
+        };
+        return bit_cast<U64>(parts);
+    }
+
+    // Only the first tail lanes are active when tail != 0.
+    SI __mmask16 tail_mask(size_t tail) {
+        return tail ? (__mmask16)((1u << tail) - 1) : (__mmask16)0xffff;
+    }
+
+    SI void load3(const uint16_t* ptr, size_t tail, U16* r, U16* g, U16* b) {
+        // Each 6-byte pixel is two overlapping 4-byte gathers, {r,g} and {g,b}.
+        // Reading {g,b} rather than {b,next r} keeps us from running off the end.
+        const I32 ix = { 0, 6,12,18,24,30,36,42, 48,54,60,66,72,78,84,90 };
+        const __mmask16 mask = tail_mask(tail);
+        U32 rg = (U32)_mm512_mask_i32gather_epi32(_mm512_setzero_si512(), mask,
+                                                  (__m512i)ix, ptr+0, 1),
+            gb = (U32)_mm512_mask_i32gather_epi32(_mm512_setzero_si512(), mask,
+                                                  (__m512i)ix, ptr+1, 1);
+        *r = __builtin_convertvector(rg      , U16);
+        *g = __builtin_convertvector(rg >> 16, U16);
+        *b = __builtin_convertvector(gb >> 16, U16);
+    }
+    SI void load4(const uint16_t* ptr, size_t tail, U16* r, U16* g, U16* b, U16* a) {
+        // Each 8-byte pixel fits exactly in a 64-bit lane; narrowing picks out each channel.
+        U64 px{};
+        if (__builtin_expect(tail,0)) {
+            memcpy(&px, ptr, tail*sizeof(uint64_t));
+        } else {
+            px = unaligned_load<U64>(ptr);
+        }
+        *r = __builtin_convertvector(px      , U16);
+        *g = __builtin_convertvector(px >> 16, U16);
+        *b = __builtin_convertvector(px >> 32, U16);
+        *a = __builtin_convertvector(px >> 48, U16);
+    }
+    SI void store4(uint16_t* ptr, size_t tail, U16 r, U16 g, U16 b, U16 a) {
+        U64 px = __builtin_convertvector(r, U64) <<  0
+               | __builtin_convertvector(g, U64) << 16
+               | __builtin_convertvector(b, U64) << 32
+               | __builtin_convertvector(a, U64) << 48;
+        if (__builtin_expect(tail,0)) {
+            memcpy(ptr, &px, tail*sizeof(uint64_t));
+        } else {
+            unaligned_store(ptr, px);
+        }
+    }
+
+    SI void load4(const float* ptr, size_t tail, F* r, F* g, F* b, F* a) {
+        const I32 ix = { 0, 4, 8,12,16,20,24,28, 32,36,40,44,48,52,56,60 };
+        const __mmask16 mask = tail_mask(tail);
+        const __m512 zero = _mm512_setzero_ps();
+        *r = _mm512_mask_i32gather_ps(zero, mask, (__m512i)ix, ptr+0, 4);
+        *g = _mm512_mask_i32gather_ps(zero, mask, (__m512i)ix, ptr+1, 4);
+        *b = _mm512_mask_i32gather_ps(zero, mask, (__m512i)ix, ptr+2, 4);
+        *a = _mm512_mask_i32gather_ps(zero, mask, (__m512i)ix, ptr+3, 4);
+    }
+    SI void store4(float* ptr, size_t tail, F r, F g, F b, F a) {
+        const I32 ix = { 0, 4, 8,12,16,20,24,28, 32,36,40,44,48,52,56,60 };
+        const __mmask16 mask = tail_mask(tail);
+        _mm512_mask_i32scatter_ps(ptr+0, mask, (__m512i)ix, r, 4);
+        _mm512_mask_i32scatter_ps(ptr+1, mask, (__m512i)ix, g, 4);
+        _mm512_mask_i32scatter_ps(ptr+2, mask, (__m512i)ix, b, 4);
+        _mm512_mask_i32scatter_ps(ptr+3, mask, (__m512i)ix, a, 4);
+    }
+
+#elif defined(JUMPER_IS_AVX) || defined(JUMPER_IS_HSW)
     // These are __m256 and __m256i, but friendlier and strongly-typed.
     template <typename T> using V = T __attribute__((ext_vector_type(8)));
     using F   = V<float   >;
@@ -300,7 +407,7 @@ namespace SK_OPTS_NS {
     using U8  = V<uint8_t >;
 
     SI F mad(F f, F m, F a)  {
-    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_HSW)
         return _mm256_fmadd_ps(f,m,a);
     #else
         return f*m+a;
@@ -332,7 +439,7 @@ namespace SK_OPTS_NS {
         return { p[ix[0]], p[ix[1]], p[ix[2]], p[ix[3]],
                  p[ix[4]], p[ix[5]], p[ix[6]], p[ix[7]], };
     }
-    #if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+    #if defined(JUMPER_IS_HSW)
         SI F   gather(const float*    p, U32 ix) { return _mm256_i32gather_ps   (p, ix, 4); }
         SI U32 gather(const uint32_t* p, U32 ix) { return _mm256_i32gather_epi32(p, ix, 4); }
         SI U64 gather(const uint64_t* p, U32 ix) {
@@ -732,7 +839,10 @@ SI F from_half(U16 h) {
 #if defined(SK_CPU_ARM64) && !defined(SK_BUILD_FOR_GOOGLE3)  // Temporary workaround for some Google3 builds.
     return vcvt_f32_f16(h);
 
-#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#elif defined(JUMPER_IS_AVX512)
+    return _mm512_cvtph_ps((__m256i)h);
+
+#elif defined(JUMPER_IS_HSW)
     return _mm256_cvtph_ps(h);
 
 #else
@@ -752,7 +862,10 @@ SI U16 to_half(F f) {
 #if defined(SK_CPU_ARM64) && !defined(SK_BUILD_FOR_GOOGLE3)  // Temporary workaround for some Google3 builds.
     return vcvt_f16_f32(f);
 
-#elif defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#elif defined(JUMPER_IS_AVX512)
+    return (U16)_mm512_cvtps_ph(f, _MM_FROUND_CUR_DIRECTION);
+
+#elif defined(JUMPER_IS_HSW)
     return _mm256_cvtps_ph(f, _MM_FROUND_CUR_DIRECTION);
 
 #else
@@ -892,6 +1005,16 @@ SI V load(const T* src, size_t tail) {
     if (__builtin_expect(tail, 0)) {
         V v{};  // Any inactive lanes are zeroed.
         switch (tail) {
+        #if defined(JUMPER_IS_AVX512)
+            case 15: v[14] = src[14];
+            case 14: v[13] = src[13];
+            case 13: v[12] = src[12];
+            case 12: memcpy(&v, src, 12*sizeof(T)); break;
+            case 11: v[10] = src[10];
+            case 10: v[ 9] = src[ 9];
+            case  9: v[ 8] = src[ 8];
+            case  8: memcpy(&v, src,  8*sizeof(T)); break;
+        #endif
             case 7: v[6] = src[6];
             case 6: v[5] = src[5];
             case 5: v[4] = src[4];
@@ -912,6 +1035,16 @@ SI void store(T* dst, V v, size_t tail) {
     __builtin_assume(tail < N);
     if (__builtin_expect(tail, 0)) {
         switch (tail) {
+        #if defined(JUMPER_IS_AVX512)
+            case 15: dst[14] = v[14];
+            case 14: dst[13] = v[13];
+            case 13: dst[12] = v[12];
+            case 12: memcpy(dst, &v, 12*sizeof(T)); break;
+            case 11: dst[10] = v[10];
+            case 10: dst[ 9] = v[ 9];
+            case  9: dst[ 8] = v[ 8];
+            case  8: memcpy(dst, &v,  8*sizeof(T)); break;
+        #endif
             case 7: dst[6] = v[6];
             case 6: dst[5] = v[5];
             case 5: dst[4] = v[4];
@@ -1011,7 +1144,7 @@ STAGE(seed_shader, Ctx::None) {
 
 STAGE(dither, const float* rate) {
     // Get [(dx,dy), (dx+1,dy), (dx+2,dy), ...] loaded up in integer vectors.
-    uint32_t iota[] = {0,1,2,3,4,5,6,7};
+    uint32_t iota[] = {0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15};
     U32 X = dx + unaligned_load<U32>(iota),
         Y = dy;
 
@@ -1615,6 +1748,69 @@ STAGE(to_srgb, Ctx::None) {
     b = fn(b);
 }
 
+// The BT.2100 PQ and HLG transfer functions.  PQ linear values are scaled so 1 is 10,000 cd/m^2;
+// HLG linear values are relative scene light, without the system gamma (OOTF) applied.
+static const float kPQ_m1 = 2610/16384.0f,
+                   kPQ_m2 = 2523/4096.0f * 128,
+                   kPQ_c1 = 3424/4096.0f,
+                   kPQ_c2 = 2413/4096.0f * 32,
+                   kPQ_c3 = 2392/4096.0f * 32;
+static const float kHLG_a = 0.17883277f,
+                   kHLG_b = 0.28466892f,
+                   kHLG_c = 0.55991073f;
+
+STAGE(from_pq, Ctx::None) {
+    auto fn = [](F e) {
+        U32 sign;
+        e = strip_sign(e, &sign);
+        F p = approx_powf(e, 1/kPQ_m2);
+        return apply_sign(approx_powf(max(p - kPQ_c1, 0) / (kPQ_c2 - kPQ_c3*p), 1/kPQ_m1), sign);
+    };
+    r = fn(r);
+    g = fn(g);
+    b = fn(b);
+}
+STAGE(to_pq, Ctx::None) {
+    auto fn = [](F l) {
+        U32 sign;
+        l = strip_sign(l, &sign);
+        F y = approx_powf(l, kPQ_m1);
+        return apply_sign(approx_powf(mad(y, kPQ_c2, kPQ_c1) / mad(y, kPQ_c3, 1.0f), kPQ_m2),
+                          sign);
+    };
+    r = fn(r);
+    g = fn(g);
+    b = fn(b);
+}
+
+STAGE(from_hlg, Ctx::None) {
+    auto fn = [](F e) {
+        U32 sign;
+        e = strip_sign(e, &sign);
+        const float log2_e = 1.44269504f;
+        auto lo = e*e * (1/3.0f),
+             hi = (approx_pow2((e - kHLG_c) * (log2_e / kHLG_a)) + kHLG_b) * (1/12.0f);
+        return apply_sign(if_then_else(e <= 0.5f, lo, hi), sign);
+    };
+    r = fn(r);
+    g = fn(g);
+    b = fn(b);
+}
+STAGE(to_hlg, Ctx::None) {
+    auto fn = [](F l) {
+        U32 sign;
+        l = strip_sign(l, &sign);
+        const float ln_2 = 0.69314718f;
+        // Keep the log's argument positive in the lanes that take the sqrt branch.
+        auto lo = sqrt_(l * 3.0f),
+             hi = mad(approx_log2(max(mad(l, 12.0f, -kHLG_b), 1.0f/12)), kHLG_a * ln_2, kHLG_c);
+        return apply_sign(if_then_else(l <= 1/12.0f, lo, hi), sign);
+    };
+    r = fn(r);
+    g = fn(g);
+    b = fn(b);
+}
+
 STAGE(load_a8, const SkRasterPipeline_MemoryCtx* ctx) {
     auto ptr = ptr_at_xy<const uint8_t>(ctx, dx,dy);
 
@@ -1933,7 +2129,19 @@ STAGE(matrix_perspective, const float* m) {
 SI void gradient_lookup(const SkRasterPipeline_GradientCtx* c, U32 idx, F t,
                         F* r, F* g, F* b, F* a) {
     F fr, br, fg, bg, fb, bb, fa, ba;
-#if defined(JUMPER_IS_HSW) || defined(JUMPER_IS_AVX512)
+#if defined(JUMPER_IS_AVX512)
+    // SkGradientShader pads fs and bs out to 16 stops, so a single permute covers them all.
+    if (c->stopCount <= 16) {
+        fr = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->fs[0]));
+        br = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->bs[0]));
+        fg = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->fs[1]));
+        bg = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->bs[1]));
+        fb = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->fs[2]));
+        bb = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->bs[2]));
+        fa = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->fs[3]));
+        ba = _mm512_permutexvar_ps((__m512i)idx, _mm512_loadu_ps(c->bs[3]));
+    } else
+#elif defined(JUMPER_IS_HSW)
     if (c->stopCount <=8) {
         fr = _mm256_permutevar8x32_ps(_mm256_loadu_ps(c->fs[0]), idx);
         br = _mm256_permutevar8x32_ps(_mm256_loadu_ps(c->bs[0]), idx);
@@ -1992,6 +2200,19 @@ STAGE(evenly_spaced_2_stop_gradient, const void* ctx) {
     a = mad(t, c->f[3], c->b[3]);
 }
 
+STAGE(three_stop_gradient, const SkRasterPipeline_3StopGradientCtx* c) {
+    auto t  = r;
+    auto hi = t >= c->t_mid;
+    r = mad(t, if_then_else(hi, F(c->f[1][0]), F(c->f[0][0])),
+               if_then_else(hi, F(c->b[1][0]), F(c->b[0][0])));
+    g = mad(t, if_then_else(hi, F(c->f[1][1]), F(c->f[0][1])),
+               if_then_else(hi, F(c->b[1][1]), F(c->b[0][1])));
+    b = mad(t, if_then_else(hi, F(c->f[1][2]), F(c->f[0][2])),
+               if_then_else(hi, F(c->b[1][2]), F(c->b[0][2])));
+    a = mad(t, if_then_else(hi, F(c->f[1][3]), F(c->f[0][3])),
+               if_then_else(hi, F(c->b[1][3]), F(c->b[0][3])));
+}
+
 STAGE(xy_to_unit_angle, Ctx::None) {
     F X = r,
       Y = g;
@@ -2214,19 +2435,17 @@ STAGE(gauss_a_to_rgba, Ctx::None) {
     b = a;
 }
 
-// A specialized fused image shader for clamp-x, clamp-y, non-sRGB sampling.
-STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
-    // (cx,cy) are the center of our sample.
-    F cx = r,
-      cy = g;
-
+// Specialized fused image shaders for clamp-x, clamp-y (or repeat-x, repeat-y) non-sRGB sampling.
+template <bool kRepeat>
+SI void bilerp_8888(const SkRasterPipeline_GatherCtx* ctx, F cx, F cy,
+                    F* r, F* g, F* b, F* a) {
     // All sample points are at the same fractional offset (fx,fy).
     // They're the 4 corners of a logical 1x1 pixel surrounding (x,y) at (0.5,0.5) offsets.
     F fx = fract(cx + 0.5f),
       fy = fract(cy + 0.5f);
 
     // We'll accumulate the color of all four samples into {r,g,b,a} directly.
-    r = g = b = a = 0;
+    *r = *g = *b = *a = 0;
 
     for (float dy = -0.5f; dy <= +0.5f; dy += 1.0f)
     for (float dx = -0.5f; dx <= +0.5f; dx += 1.0f) {
@@ -2234,6 +2453,12 @@ STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
         F x = cx + dx,
           y = cy + dy;
 
+        if (kRepeat) {
+            // Wrap each sample point on its own so the edges filter across the seam.
+            x = x - floor_(x * (1.0f / ctx->width )) * ctx->width;
+            y = y - floor_(y * (1.0f / ctx->height)) * ctx->height;
+        }
+
         // ix_and_ptr() will clamp to the image's bounds for us.
         const uint32_t* ptr;
         U32 ix = ix_and_ptr(&ptr, ctx, x,y);
@@ -2249,13 +2474,21 @@ STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
           sy = (dy > 0) ? fy : 1.0f - fy,
           area = sx * sy;
 
-        r += sr * area;
-        g += sg * area;
-        b += sb * area;
-        a += sa * area;
+        *r += sr * area;
+        *g += sg * area;
+        *b += sb * area;
+        *a += sa * area;
     }
 }
 
+STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+    // (r,g) hold the center of our sample.
+    bilerp_8888<false>(ctx, r,g, &r,&g,&b,&a);
+}
+STAGE(bilerp_repeat_8888, const SkRasterPipeline_GatherCtx* ctx) {
+    bilerp_8888<true>(ctx, r,g, &r,&g,&b,&a);
+}
+
 namespace lowp {
 #if defined(JUMPER_IS_SCALAR) || defined(SK_DISABLE_LOWP_RASTER_PIPELINE)
     // If we're not compiled by Clang, or otherwise switched into scalar mode (old Clang, manually),
@@ -2654,6 +2887,14 @@ STAGE_PP(premul_dst, Ctx::None) {
     dg = div255(dg * da);
     db = div255(db * da);
 }
+STAGE_PP(unpremul, Ctx::None) {
+    // Pixels with zero alpha stay zero, as in highp.
+    F A = cast<F>(a),
+      scale = if_then_else(A == 0, F(0), 255.0f / A);
+    r = cast<U16>(min(cast<F>(r) * scale + 0.5f, 255));
+    g = cast<U16>(min(cast<F>(g) * scale + 0.5f, 255));
+    b = cast<U16>(min(cast<F>(b) * scale + 0.5f, 255));
+}
 
 STAGE_PP(force_opaque    , Ctx::None) {  a = 255; }
 STAGE_PP(force_opaque_dst, Ctx::None) { da = 255; }
@@ -2683,6 +2924,28 @@ STAGE_PP(move_dst_src, Ctx::None) {
     a = da;
 }
 
+STAGE_PP(dither, const float* rate) {
+    // The same 8x8 ordered dither as highp's, see there for the details.
+    static const uint16_t iota[] = {0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15};
+    U16 X = U16((uint16_t)dx) + unaligned_load<U16>(iota),
+        Y = U16((uint16_t)dy) ^ X;
+
+    U16 M = (Y & 1) << 5 | (X & 1) << 4
+          | (Y & 2) << 2 | (X & 2) << 1
+          | (Y & 4) >> 1 | (X & 4) >> 2;
+
+    // Our channels are in [0,255], so scale the (-0.5,+0.5) dither up to match.
+    F dither = (cast<F>(M) * (2/128.0f) - (63/128.0f)) * (*rate * 255.0f);
+
+    F A = cast<F>(a);
+    auto apply = [=](U16 c) {
+        return cast<U16>(max(F(0), min(cast<F>(c) + dither, A)) + 0.5f);
+    };
+    r = apply(r);
+    g = apply(g);
+    b = apply(b);
+}
+
 // ~~~~~~ Blend modes ~~~~~~ //
 
 // The same logic applied to all 4 channels.
@@ -2736,8 +2999,118 @@ STAGE_PP(move_dst_src, Ctx::None) {
         return div255( s*inv(da) + d*inv(sa) +
                        if_then_else(2*d <= da, 2*s*d, sa*da - 2*(sa-s)*(da-d)) );
     }
+
+    // These modes divide, so like highp they work in float, here on channels scaled to [0,1].
+    SI F from_u16(U16 v) { return cast<F>(v) * (1/255.0f); }
+    SI U16 to_u16(F v) { return cast<U16>(max(F(0), min(v, F(1))) * 255.0f + 0.5f); }
+
+    BLEND_MODE(colorburn) {
+        F S = from_u16(s), D = from_u16(d), Sa = from_u16(sa), Da = from_u16(da);
+        return to_u16(
+            if_then_else(D == Da,    D +    S*(1.0f-Da),
+            if_then_else(S ==  0, /* S + */ D*(1.0f-Sa),
+                                  Sa*(Da - min(Da, (Da-D)*Sa*rcp(S))) + S*(1.0f-Da)
+                                                                      + D*(1.0f-Sa))));
+    }
+    BLEND_MODE(colordodge) {
+        F S = from_u16(s), D = from_u16(d), Sa = from_u16(sa), Da = from_u16(da);
+        return to_u16(
+            if_then_else(D ==  0, /* D + */ S*(1.0f-Da),
+            if_then_else(S == Sa,    S +    D*(1.0f-Sa),
+                                  Sa*min(Da, (D*Sa)*rcp(Sa - S)) + S*(1.0f-Da)
+                                                                 + D*(1.0f-Sa))));
+    }
+    BLEND_MODE(softlight) {
+        F S = from_u16(s), D = from_u16(d), Sa = from_u16(sa), Da = from_u16(da);
+        F m  = if_then_else(Da > 0, D / Da, F(0)),
+          s2 = 2.0f*S,
+          m4 = 4.0f*m;
+
+        // The same three-way fork as highp's softlight.
+        F darkSrc = D*(Sa + (s2 - Sa)*(1.0f - m)),
+          darkDst = (m4*m4 + m4)*(m - 1.0f) + 7.0f*m,
+          liteDst = sqrt_(m) - m,
+          liteSrc = D*Sa + Da*(s2 - Sa) * if_then_else(4.0f*D <= Da, darkDst, liteDst);
+        return to_u16(S*(1.0f-Da) + D*(1.0f-Sa) + if_then_else(s2 <= Sa, darkSrc, liteSrc));
+    }
 #undef BLEND_MODE
 
+// The non-separable modes, in float like the modes above, following highp's implementation.
+SI F max(F r, F g, F b) { return max(r, max(g, b)); }
+SI F min(F r, F g, F b) { return min(r, min(g, b)); }
+
+SI F sat(F r, F g, F b) { return max(r,g,b) - min(r,g,b); }
+SI F lum(F r, F g, F b) { return r*0.30f + g*0.59f + b*0.11f; }
+
+SI void set_sat(F* r, F* g, F* b, F s) {
+    F mn  = min(*r,*g,*b),
+      mx  = max(*r,*g,*b),
+      sat = mx - mn;
+
+    auto scale = [=](F c) {
+        return if_then_else(sat == 0, F(0), (c - mn) * s / sat);
+    };
+    *r = scale(*r);
+    *g = scale(*g);
+    *b = scale(*b);
+}
+SI void set_lum(F* r, F* g, F* b, F l) {
+    F diff = l - lum(*r, *g, *b);
+    *r += diff;
+    *g += diff;
+    *b += diff;
+}
+SI void clip_color(F* r, F* g, F* b, F a) {
+    F mn = min(*r, *g, *b),
+      mx = max(*r, *g, *b),
+      l  = lum(*r, *g, *b);
+
+    auto clip = [=](F c) {
+        c = if_then_else(mn >= 0, c, l + (c - l) * (    l) / (l - mn)   );
+        c = if_then_else(mx >  a,    l + (c - l) * (a - l) / (mx - l), c);
+        c = max(c, F(0));
+        return c;
+    };
+    *r = clip(*r);
+    *g = clip(*g);
+    *b = clip(*b);
+}
+
+#define NONSEPARABLE_MODE(name)                                                           \
+    SI void name##_rgb(F r, F g, F b, F a, F dr, F dg, F db, F da, F* R, F* G, F* B);     \
+    STAGE_PP(name, Ctx::None) {                                                           \
+        F S[] = { from_u16( r), from_u16( g), from_u16( b), from_u16( a) },               \
+          D[] = { from_u16(dr), from_u16(dg), from_u16(db), from_u16(da) };               \
+        F R,G,B;                                                                          \
+        name##_rgb(S[0],S[1],S[2],S[3], D[0],D[1],D[2],D[3], &R,&G,&B);                   \
+        clip_color(&R,&G,&B, S[3]*D[3]);                                                  \
+        r = to_u16(S[0]*(1.0f-D[3]) + D[0]*(1.0f-S[3]) + R);                              \
+        g = to_u16(S[1]*(1.0f-D[3]) + D[1]*(1.0f-S[3]) + G);                              \
+        b = to_u16(S[2]*(1.0f-D[3]) + D[2]*(1.0f-S[3]) + B);                              \
+        a = a + div255( da*inv(a) );                                                      \
+    }                                                                                     \
+    SI void name##_rgb(F r, F g, F b, F a, F dr, F dg, F db, F da, F* R, F* G, F* B)
+
+    NONSEPARABLE_MODE(hue) {
+        *R = r*a; *G = g*a; *B = b*a;
+        set_sat(R,G,B, sat(dr,dg,db)*a);
+        set_lum(R,G,B, lum(dr,dg,db)*a);
+    }
+    NONSEPARABLE_MODE(saturation) {
+        *R = dr*a; *G = dg*a; *B = db*a;
+        set_sat(R,G,B, sat( r, g, b)*da);
+        set_lum(R,G,B, lum(dr,dg,db)* a);
+    }
+    NONSEPARABLE_MODE(color) {
+        *R = r*da; *G = g*da; *B = b*da;
+        set_lum(R,G,B, lum(dr,dg,db)*a);
+    }
+    NONSEPARABLE_MODE(luminosity) {
+        *R = dr*a; *G = dg*a; *B = db*a;
+        set_lum(R,G,B, lum(r,g,b)*da);
+    }
+#undef NONSEPARABLE_MODE
+
 // ~~~~~~ Helpers for interacting with memory ~~~~~~ //
 
 template <typename T>
@@ -3060,6 +3433,20 @@ STAGE_PP(luminance_to_alpha, Ctx::None) {
     r = g = b = 0;
 }
 
+STAGE_PP(matrix_4x5, const float* m) {
+    F R = cast<F>(r) * (1/255.0f),
+      G = cast<F>(g) * (1/255.0f),
+      B = cast<F>(b) * (1/255.0f),
+      A = cast<F>(a) * (1/255.0f);
+
+    // clamp_0 and clamp_1 are no-ops in lowp, so clamp here on the way back to bytes.
+    auto round = [](F x) { return cast<U16>(min(max(0, x), 1) * 255.0f + 0.5f); };
+    r = round(mad(R,m[0], mad(G,m[4], mad(B,m[ 8], mad(A,m[12], m[16])))));
+    g = round(mad(R,m[1], mad(G,m[5], mad(B,m[ 9], mad(A,m[13], m[17])))));
+    b = round(mad(R,m[2], mad(G,m[6], mad(B,m[10], mad(A,m[14], m[18])))));
+    a = round(mad(R,m[3], mad(G,m[7], mad(B,m[11], mad(A,m[15], m[19])))));
+}
+
 // ~~~~~~ Coverage scales / lerps ~~~~~~ //
 
 STAGE_PP(scale_1_float, const float* f) {
@@ -3249,6 +3636,21 @@ STAGE_GP(evenly_spaced_2_stop_gradient, const SkRasterPipeline_EvenlySpaced2Stop
                    &r,&g,&b,&a);
 }
 
+STAGE_GP(three_stop_gradient, const SkRasterPipeline_3StopGradientCtx* c) {
+    auto t  = x;
+    auto hi = t >= c->t_mid;
+    round_F_to_U16(mad(t, if_then_else(hi, F(c->f[1][0]), F(c->f[0][0])),
+                          if_then_else(hi, F(c->b[1][0]), F(c->b[0][0]))),
+                   mad(t, if_then_else(hi, F(c->f[1][1]), F(c->f[0][1])),
+                          if_then_else(hi, F(c->b[1][1]), F(c->b[0][1]))),
+                   mad(t, if_then_else(hi, F(c->f[1][2]), F(c->f[0][2])),
+                          if_then_else(hi, F(c->b[1][2]), F(c->b[0][2]))),
+                   mad(t, if_then_else(hi, F(c->f[1][3]), F(c->f[0][3])),
+                          if_then_else(hi, F(c->b[1][3]), F(c->b[0][3]))),
+                   c->interpolatedInPremul,
+                   &r,&g,&b,&a);
+}
+
 STAGE_GG(xy_to_unit_angle, Ctx::None) {
     F xabs = abs_(x),
       yabs = abs_(y);
@@ -3291,19 +3693,18 @@ STAGE_PP(srcover_rgba_8888, const SkRasterPipeline_MemoryCtx* ctx) {
 
 #if defined(SK_DISABLE_LOWP_BILERP_CLAMP_CLAMP_STAGE)
     static void(*bilerp_clamp_8888)(void) = nullptr;
+    static void(*bilerp_repeat_8888)(void) = nullptr;
 #else
-STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
-    // (cx,cy) are the center of our sample.
-    F cx = x,
-      cy = y;
-
+template <bool kRepeat>
+SI void bilerp_8888(const SkRasterPipeline_GatherCtx* ctx, F cx, F cy,
+                    U16* r, U16* g, U16* b, U16* a) {
     // All sample points are at the same fractional offset (fx,fy).
     // They're the 4 corners of a logical 1x1 pixel surrounding (x,y) at (0.5,0.5) offsets.
     F fx = fract(cx + 0.5f),
       fy = fract(cy + 0.5f);
 
     // We'll accumulate the color of all four samples into {r,g,b,a} directly.
-    r = g = b = a = 0;
+    *r = *g = *b = *a = 0;
 
     // The first three sample points will calculate their area using math
     // just like in the float code above, but the fourth will take up all the rest.
@@ -3322,6 +3723,12 @@ STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
         F x = cx + dx,
           y = cy + dy;
 
+        if (kRepeat) {
+            // Wrap each sample point on its own so the edges filter across the seam.
+            x = x - floor_(x * (1.0f / ctx->width )) * ctx->width;
+            y = y - floor_(y * (1.0f / ctx->height)) * ctx->height;
+        }
+
         // ix_and_ptr() will clamp to the image's bounds for us.
         const uint32_t* ptr;
         U32 ix = ix_and_ptr(&ptr, ctx, x,y);
@@ -3343,16 +3750,24 @@ STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
         }
         remaining -= area;
 
-        r += sr * area;
-        g += sg * area;
-        b += sb * area;
-        a += sa * area;
+        *r += sr * area;
+        *g += sg * area;
+        *b += sb * area;
+        *a += sa * area;
     }
 
-    r = (r + bias/2) / bias;
-    g = (g + bias/2) / bias;
-    b = (b + bias/2) / bias;
-    a = (a + bias/2) / bias;
+    *r = (*r + bias/2) / bias;
+    *g = (*g + bias/2) / bias;
+    *b = (*b + bias/2) / bias;
+    *a = (*a + bias/2) / bias;
+}
+
+STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+    // (x,y) are the center of our sample.
+    bilerp_8888<false>(ctx, x,y, &r,&g,&b,&a);
+}
+STAGE_GP(bilerp_repeat_8888, const SkRasterPipeline_GatherCtx* ctx) {
+    bilerp_8888<true>(ctx, x,y, &r,&g,&b,&a);
 }
 #endif
 
@@ -3366,10 +3781,12 @@ STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
     NOT_IMPLEMENTED(store_dst)
     NOT_IMPLEMENTED(unbounded_set_rgb)
     NOT_IMPLEMENTED(unbounded_uniform_color)
-    NOT_IMPLEMENTED(unpremul)
-    NOT_IMPLEMENTED(dither)  // TODO
     NOT_IMPLEMENTED(from_srgb)
     NOT_IMPLEMENTED(to_srgb)
+    NOT_IMPLEMENTED(from_pq)
+    NOT_IMPLEMENTED(to_pq)
+    NOT_IMPLEMENTED(from_hlg)
+    NOT_IMPLEMENTED(to_hlg)
     NOT_IMPLEMENTED(load_f16)
     NOT_IMPLEMENTED(load_f16_dst)
     NOT_IMPLEMENTED(store_f16)
@@ -3384,16 +3801,8 @@ STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
     NOT_IMPLEMENTED(gather_1010102)
     NOT_IMPLEMENTED(store_u16_be)
     NOT_IMPLEMENTED(byte_tables)  // TODO
-    NOT_IMPLEMENTED(colorburn)
-    NOT_IMPLEMENTED(colordodge)
-    NOT_IMPLEMENTED(softlight)
-    NOT_IMPLEMENTED(hue)
-    NOT_IMPLEMENTED(saturation)
-    NOT_IMPLEMENTED(color)
-    NOT_IMPLEMENTED(luminosity)
     NOT_IMPLEMENTED(matrix_3x3)
     NOT_IMPLEMENTED(matrix_3x4)
-    NOT_IMPLEMENTED(matrix_4x5)  // TODO
     NOT_IMPLEMENTED(matrix_4x3)  // TODO
     NOT_IMPLEMENTED(parametric)
     NOT_IMPLEMENTED(gamma)
@@ -158,6 +158,47 @@ static void inverted_CMYK_to_BGR1_portable(uint32_t* dst, const uint32_t* src, i
     }
 }
 
+// 16-bit sources are big-endian, like PNG; we keep the high byte of each component.
+template <bool kSwapRB>
+static void RGB16_to_8888_portable(uint32_t dst[], const uint8_t* src, int count) {
+    for (int i = 0; i < count; i++) {
+        uint8_t r = src[0],
+                g = src[2],
+                b = src[4];
+        src += 6;
+        if (kSwapRB) {
+            std::swap(r, b);
+        }
+        dst[i] = (uint32_t)0xFF << 24
+               | (uint32_t)b    << 16
+               | (uint32_t)g    <<  8
+               | (uint32_t)r    <<  0;
+    }
+}
+
+template <bool kSwapRB, bool kPremul>
+static void RGBA16_to_8888_portable(uint32_t dst[], const uint8_t* src, int count) {
+    for (int i = 0; i < count; i++) {
+        uint8_t r = src[0],
+                g = src[2],
+                b = src[4],
+                a = src[6];
+        src += 8;
+        if (kPremul) {
+            b = (b*a+127)/255;
+            g = (g*a+127)/255;
+            r = (r*a+127)/255;
+        }
+        if (kSwapRB) {
+            std::swap(r, b);
+        }
+        dst[i] = (uint32_t)a << 24
+               | (uint32_t)b << 16
+               | (uint32_t)g <<  8
+               | (uint32_t)r <<  0;
+    }
+}
+
 #if defined(SK_ARM_HAS_NEON)
 
 // Rounded divide by 255, (x + 127) / 255
@@ -477,6 +518,88 @@ static void inverted_cmyk_to(uint32_t* dst, const uint32_t* src, int count) {
     inverted_cmyk_to<kBGR1>(dst, src, count);
 }
 
+template <bool kSwapRB>
+static void rgb16_to_8888(uint32_t dst[], const uint8_t* src, int count) {
+    while (count >= 8) {
+        // Load 8 pixels.  Each component is big-endian, so its high byte is the low byte of
+        // the (little-endian) lane, which is what a narrowing move keeps.
+        uint16x8x3_t rgb = vld3q_u16((const uint16_t*) src);
+
+        uint8x8x4_t rgba;
+        rgba.val[kSwapRB ? 2 : 0] = vmovn_u16(rgb.val[0]);
+        rgba.val[1]               = vmovn_u16(rgb.val[1]);
+        rgba.val[kSwapRB ? 0 : 2] = vmovn_u16(rgb.val[2]);
+        rgba.val[3]               = vdup_n_u8(0xFF);
+
+        // Store 8 pixels.
+        vst4_u8((uint8_t*) dst, rgba);
+        src += 8*6;
+        dst += 8;
+        count -= 8;
+    }
+
+    // Call portable code to finish up the tail of [0,8) pixels.
+    RGB16_to_8888_portable<kSwapRB>(dst, src, count);
+}
+
+template <bool kSwapRB, bool kPremul>
+static void rgba16_to_8888(uint32_t dst[], const uint8_t* src, int count) {
+    while (count >= 8) {
+        // Load 8 pixels, keeping the high byte of each component as above.
+        uint16x8x4_t rgba16 = vld4q_u16((const uint16_t*) src);
+
+        uint8x8_t r = vmovn_u16(rgba16.val[0]),
+                  g = vmovn_u16(rgba16.val[1]),
+                  b = vmovn_u16(rgba16.val[2]),
+                  a = vmovn_u16(rgba16.val[3]);
+
+        if (kPremul) {
+            r = scale(r, a);
+            g = scale(g, a);
+            b = scale(b, a);
+        }
+
+        uint8x8x4_t rgba;
+        rgba.val[kSwapRB ? 2 : 0] = r;
+        rgba.val[1]               = g;
+        rgba.val[kSwapRB ? 0 : 2] = b;
+        rgba.val[3]               = a;
+
+        // Store 8 pixels.
+        vst4_u8((uint8_t*) dst, rgba);
+        src += 8*8;
+        dst += 8;
+        count -= 8;
+    }
+
+    // Call portable code to finish up the tail of [0,8) pixels.
+    RGBA16_to_8888_portable<kSwapRB, kPremul>(dst, src, count);
+}
+
+/*not static*/ inline void RGB16_to_RGB1(uint32_t dst[], const uint8_t* src, int count) {
+    rgb16_to_8888<false>(dst, src, count);
+}
+
+/*not static*/ inline void RGB16_to_BGR1(uint32_t dst[], const uint8_t* src, int count) {
+    rgb16_to_8888<true>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_RGBA(uint32_t dst[], const uint8_t* src, int count) {
+    rgba16_to_8888<false, false>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_BGRA(uint32_t dst[], const uint8_t* src, int count) {
+    rgba16_to_8888<true, false>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_rgbA(uint32_t dst[], const uint8_t* src, int count) {
+    rgba16_to_8888<false, true>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_bgrA(uint32_t dst[], const uint8_t* src, int count) {
+    rgba16_to_8888<true, true>(dst, src, count);
+}
+
 #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSSE3
 
 // Scale a byte by another.
@@ -489,47 +612,48 @@ static __m128i scale(__m128i x, __m128i y) {
     return _mm_mulhi_epu16(_mm_add_epi16(_mm_mullo_epi16(x, y), _128), _257);
 }
 
+// Premultiply 8 pixels, swapping R and B if asked.
 template <bool kSwapRB>
-static void premul_should_swapRB(uint32_t* dst, const uint32_t* src, int count) {
-
-    auto premul8 = [](__m128i* lo, __m128i* hi) {
-        const __m128i zeros = _mm_setzero_si128();
-        __m128i planar;
-        if (kSwapRB) {
-            planar = _mm_setr_epi8(2,6,10,14, 1,5,9,13, 0,4,8,12, 3,7,11,15);
-        } else {
-            planar = _mm_setr_epi8(0,4,8,12, 1,5,9,13, 2,6,10,14, 3,7,11,15);
-        }
-
-        // Swizzle the pixels to 8-bit planar.
-        *lo = _mm_shuffle_epi8(*lo, planar);                      // rrrrgggg bbbbaaaa
-        *hi = _mm_shuffle_epi8(*hi, planar);                      // RRRRGGGG BBBBAAAA
-        __m128i rg = _mm_unpacklo_epi32(*lo, *hi),                // rrrrRRRR ggggGGGG
-                ba = _mm_unpackhi_epi32(*lo, *hi);                // bbbbBBBB aaaaAAAA
-
-        // Unpack to 16-bit planar.
-        __m128i r = _mm_unpacklo_epi8(rg, zeros),                 // r_r_r_r_ R_R_R_R_
-                g = _mm_unpackhi_epi8(rg, zeros),                 // g_g_g_g_ G_G_G_G_
-                b = _mm_unpacklo_epi8(ba, zeros),                 // b_b_b_b_ B_B_B_B_
-                a = _mm_unpackhi_epi8(ba, zeros);                 // a_a_a_a_ A_A_A_A_
-
-        // Premultiply!
-        r = scale(r, a);
-        g = scale(g, a);
-        b = scale(b, a);
+static void premul8(__m128i* lo, __m128i* hi) {
+    const __m128i zeros = _mm_setzero_si128();
+    __m128i planar;
+    if (kSwapRB) {
+        planar = _mm_setr_epi8(2,6,10,14, 1,5,9,13, 0,4,8,12, 3,7,11,15);
+    } else {
+        planar = _mm_setr_epi8(0,4,8,12, 1,5,9,13, 2,6,10,14, 3,7,11,15);
+    }
 
-        // Repack into interlaced pixels.
-        rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));               // rgrgrgrg RGRGRGRG
-        ba = _mm_or_si128(b, _mm_slli_epi16(a, 8));               // babababa BABABABA
-        *lo = _mm_unpacklo_epi16(rg, ba);                         // rgbargba rgbargba
-        *hi = _mm_unpackhi_epi16(rg, ba);                         // RGBARGBA RGBARGBA
-    };
+    // Swizzle the pixels to 8-bit planar.
+    *lo = _mm_shuffle_epi8(*lo, planar);                      // rrrrgggg bbbbaaaa
+    *hi = _mm_shuffle_epi8(*hi, planar);                      // RRRRGGGG BBBBAAAA
+    __m128i rg = _mm_unpacklo_epi32(*lo, *hi),                // rrrrRRRR ggggGGGG
+            ba = _mm_unpackhi_epi32(*lo, *hi);                // bbbbBBBB aaaaAAAA
+
+    // Unpack to 16-bit planar.
+    __m128i r = _mm_unpacklo_epi8(rg, zeros),                 // r_r_r_r_ R_R_R_R_
+            g = _mm_unpackhi_epi8(rg, zeros),                 // g_g_g_g_ G_G_G_G_
+            b = _mm_unpacklo_epi8(ba, zeros),                 // b_b_b_b_ B_B_B_B_
+            a = _mm_unpackhi_epi8(ba, zeros);                 // a_a_a_a_ A_A_A_A_
+
+    // Premultiply!
+    r = scale(r, a);
+    g = scale(g, a);
+    b = scale(b, a);
+
+    // Repack into interlaced pixels.
+    rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));               // rgrgrgrg RGRGRGRG
+    ba = _mm_or_si128(b, _mm_slli_epi16(a, 8));               // babababa BABABABA
+    *lo = _mm_unpacklo_epi16(rg, ba);                         // rgbargba rgbargba
+    *hi = _mm_unpackhi_epi16(rg, ba);                         // RGBARGBA RGBARGBA
+}
 
+template <bool kSwapRB>
+static void premul_should_swapRB(uint32_t* dst, const uint32_t* src, int count) {
     while (count >= 8) {
         __m128i lo = _mm_loadu_si128((const __m128i*) (src + 0)),
                 hi = _mm_loadu_si128((const __m128i*) (src + 4));
 
-        premul8(&lo, &hi);
+        premul8<kSwapRB>(&lo, &hi);
 
         _mm_storeu_si128((__m128i*) (dst + 0), lo);
         _mm_storeu_si128((__m128i*) (dst + 4), hi);
@@ -543,7 +667,7 @@ static void premul_should_swapRB(uint32_t* dst, const uint32_t* src, int count)
         __m128i lo = _mm_loadu_si128((const __m128i*) src),
                 hi = _mm_setzero_si128();
 
-        premul8(&lo, &hi);
+        premul8<kSwapRB>(&lo, &hi);
 
         _mm_storeu_si128((__m128i*) dst, lo);
 
@@ -774,6 +898,113 @@ static void inverted_cmyk_to(uint32_t* dst, const uint32_t* src, int count) {
     inverted_cmyk_to<kBGR1>(dst, src, count);
 }
 
+template <bool kSwapRB>
+static void rgb16_to_8888(uint32_t dst[], const uint8_t* src, int count) {
+    const __m128i alphaMask = _mm_set1_epi32(0xFF000000);
+    const int8_t X = -1;  // Zeroes the byte; the alpha mask fills it in.
+
+    // Four pixels are 24 bytes: bytes [0,16) and [8,24) hold all of them without reading past
+    // the end.  Each component is big-endian, so we pick out the even (high) bytes.
+    __m128i lo, hi;
+    if (kSwapRB) {
+        lo = _mm_setr_epi8(4,2,0,X, 10,8,6,X, X,14,12,X, X,X,X,X);
+        hi = _mm_setr_epi8(X,X,X,X, X,X,X,X, 8,X,X,X, 14,12,10,X);
+    } else {
+        lo = _mm_setr_epi8(0,2,4,X, 6,8,10,X, 12,14,X,X, X,X,X,X);
+        hi = _mm_setr_epi8(X,X,X,X, X,X,X,X, X,X,8,X, 10,12,14,X);
+    }
+
+    while (count >= 4) {
+        __m128i a = _mm_loadu_si128((const __m128i*) (src + 0)),
+                b = _mm_loadu_si128((const __m128i*) (src + 8));
+
+        __m128i rgba = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, lo),
+                                                 _mm_shuffle_epi8(b, hi)), alphaMask);
+        _mm_storeu_si128((__m128i*) dst, rgba);
+
+        src += 4*6;
+        dst += 4;
+        count -= 4;
+    }
+
+    // Call portable code to finish up the tail of [0,4) pixels.
+    RGB16_to_8888_portable<kSwapRB>(dst, src, count);
+}
+
+template <bool kSwapRB, bool kPremul>
+static void rgba16_to_8888(uint32_t dst[], const uint8_t* src, int count) {
+    // Keep the even (high) bytes of two pixels in the low half of a vector.  When we premultiply,
+    // premul8() will swap R and B for us.
+    const int8_t X = -1;
+    const __m128i strip = kSwapRB && !kPremul
+            ? _mm_setr_epi8(4,2,0,6, 12,10,8,14, X,X,X,X, X,X,X,X)
+            : _mm_setr_epi8(0,2,4,6, 8,10,12,14, X,X,X,X, X,X,X,X);
+
+    auto load4 = [&](const uint8_t* p) {
+        __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (p +  0)), strip),
+                b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (p + 16)), strip);
+        return _mm_unpacklo_epi64(a, b);
+    };
+
+    while (count >= 8) {
+        __m128i lo = load4(src +  0),
+                hi = load4(src + 32);
+
+        if (kPremul) {
+            premul8<kSwapRB>(&lo, &hi);
+        }
+
+        _mm_storeu_si128((__m128i*) (dst + 0), lo);
+        _mm_storeu_si128((__m128i*) (dst + 4), hi);
+
+        src += 8*8;
+        dst += 8;
+        count -= 8;
+    }
+
+    if (count >= 4) {
+        __m128i lo = load4(src),
+                hi = _mm_setzero_si128();
+
+        if (kPremul) {
+            premul8<kSwapRB>(&lo, &hi);
+        }
+
+        _mm_storeu_si128((__m128i*) dst, lo);
+
+        src += 4*8;
+        dst += 4;
+        count -= 4;
+    }
+
+    // Call portable code to finish up the tail of [0,4) pixels.
+    RGBA16_to_8888_portable<kSwapRB, kPremul>(dst, src, count);
+}
+
+/*not static*/ inline void RGB16_to_RGB1(uint32_t dst[], const uint8_t* src, int count) {
+    rgb16_to_8888<false>(dst, src, count);
+}
+
+/*not static*/ inline void RGB16_to_BGR1(uint32_t dst[], const uint8_t* src, int count) {
+    rgb16_to_8888<true>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_RGBA(uint32_t dst[], const uint8_t* src, int count) {
+    rgba16_to_8888<false, false>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_BGRA(uint32_t dst[], const uint8_t* src, int count) {
+    rgba16_to_8888<true, false>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_rgbA(uint32_t dst[], const uint8_t* src, int count) {
+    rgba16_to_8888<false, true>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_bgrA(uint32_t dst[], const uint8_t* src, int count) {
+    rgba16_to_8888<true, true>(dst, src, count);
+}
+
 #else
 
 /*not static*/ inline void RGBA_to_rgbA(uint32_t* dst, const uint32_t* src, int count) {
@@ -816,6 +1047,30 @@ static void inverted_cmyk_to(uint32_t* dst, const uint32_t* src, int count) {
     inverted_CMYK_to_BGR1_portable(dst, src, count);
 }
 
+/*not static*/ inline void RGB16_to_RGB1(uint32_t dst[], const uint8_t* src, int count) {
+    RGB16_to_8888_portable<false>(dst, src, count);
+}
+
+/*not static*/ inline void RGB16_to_BGR1(uint32_t dst[], const uint8_t* src, int count) {
+    RGB16_to_8888_portable<true>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_RGBA(uint32_t dst[], const uint8_t* src, int count) {
+    RGBA16_to_8888_portable<false, false>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_BGRA(uint32_t dst[], const uint8_t* src, int count) {
+    RGBA16_to_8888_portable<true, false>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_rgbA(uint32_t dst[], const uint8_t* src, int count) {
+    RGBA16_to_8888_portable<false, true>(dst, src, count);
+}
+
+/*not static*/ inline void RGBA16_to_bgrA(uint32_t dst[], const uint8_t* src, int count) {
+    RGBA16_to_8888_portable<true, true>(dst, src, count);
+}
+
 #endif
 
 }
@@ -7,7 +7,11 @@
 #include "SkAddIntersections.h"
 #include "SkOpCoincidence.h"
 #include "SkPathOpsBounds.h"
+#include "SkTDArray.h"
+#include "SkTSort.h"
 
+#include <algorithm>
+#include <cfloat>
 #include <utility>
 
 #if DEBUG_ADD_INTERSECTING_TS
@@ -577,3 +581,92 @@ bool AddIntersectTs(SkOpContour* test, SkOpContour* next, SkOpCoincidence* coinc
     } while (wt.advance());
     return true;
 }
+
+// Below this many contours, testing every candidate pair's bounds is cheaper than bucketing.
+static constexpr int kMinContoursForGrid = 32;
+
+// Widens x enough to cover the ulps slop in SkPathOpsBounds::Intersects().
+static float ulps_slop(float x) {
+    return (SkTAbs(x) + 1) * FLT_EPSILON * 32;
+}
+
+void AddAllIntersectTs(SkOpContourHead* contourList, SkOpCoincidence* coincidence) {
+    SkTDArray<SkOpContour*> contours;
+    SkOpContour* contour = contourList;
+    do {
+        *contours.append() = contour;
+    } while ((contour = contour->next()));
+    const int count = contours.count();
+
+    if (count < kMinContoursForGrid) {
+        SkOpContour* current = contourList;
+        do {
+            SkOpContour* next = current;
+            while (AddIntersectTs(current, next, coincidence)
+                    && (next = next->next()))
+                ;
+        } while ((current = current->next()));
+        return;
+    }
+
+    // The list is sorted by top, so the contours a given one can reach downwards form a run
+    // ending at the first that starts below it. Within that run, only contours sharing an x
+    // column of a uniform grid are tested, which keeps wide rows of small contours from
+    // degenerating into testing every pair.
+    SkScalar left = SK_ScalarMax, right = -SK_ScalarMax;
+    for (const SkOpContour* c : contours) {
+        left = SkTMin(left, c->bounds().fLeft);
+        right = SkTMax(right, c->bounds().fRight);
+    }
+    left -= ulps_slop(left);
+    right += ulps_slop(right);
+    const int columnCount = SkTPin(SkScalarCeilToInt(SkScalarSqrt(SkIntToScalar(count))), 1, 1024);
+    const float columnScale = columnCount / SkTMax(right - left, FLT_MIN);
+    auto columnOf = [&](float x) {
+        return SkTPin((int) ((x - left) * columnScale), 0, columnCount - 1);
+    };
+
+    // Contour indices per column, ascending because contours are added in list order.
+    SkAutoTArray<SkTDArray<int>> columns(columnCount);
+    SkAutoTMalloc<int> firstColumn(count), lastColumn(count);
+    for (int index = 0; index < count; ++index) {
+        const SkPathOpsBounds& bounds = contours[index]->bounds();
+        firstColumn[index] = columnOf(bounds.fLeft - ulps_slop(bounds.fLeft));
+        lastColumn[index] = columnOf(bounds.fRight + ulps_slop(bounds.fRight));
+        for (int column = firstColumn[index]; column <= lastColumn[index]; ++column) {
+            *columns[column].append() = index;
+        }
+    }
+
+    SkAutoTMalloc<int> lastVisit(count);
+    std::fill(lastVisit.get(), lastVisit.get() + count, -1);
+    SkTDArray<int> candidates;
+    for (int index = 0; index < count; ++index) {
+        SkOpContour* current = contours[index];
+        const float bottom = current->bounds().fBottom;
+        // First contour that starts below this one; AddIntersectTs() would stop there.
+        int end = std::partition_point(contours.begin() + index + 1, contours.end(),
+                [bottom](const SkOpContour* c) {
+                    return !AlmostLessUlps(bottom, c->bounds().fTop);
+                }) - contours.begin();
+
+        candidates.rewind();
+        for (int column = firstColumn[index]; column <= lastColumn[index]; ++column) {
+            const SkTDArray<int>& members = columns[column];
+            for (const int* m = std::lower_bound(members.begin(), members.end(), index);
+                    m < members.end() && *m < end; ++m) {
+                if (lastVisit[*m] != index) {
+                    lastVisit[*m] = index;
+                    *candidates.append() = *m;
+                }
+            }
+        }
+        // Visit in list order, as the exhaustive loop would.
+        if (candidates.count() > 1) {
+            SkTQSort(candidates.begin(), candidates.end() - 1);
+        }
+        for (int next : candidates) {
+            (void) AddIntersectTs(current, contours[next], coincidence);
+        }
+    }
+}
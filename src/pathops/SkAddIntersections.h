@@ -11,7 +11,12 @@
 #include "SkIntersections.h"
 
 class SkOpCoincidence;
+class SkOpContourHead;
 
 bool AddIntersectTs(SkOpContour* test, SkOpContour* next, SkOpCoincidence* coincidence);
 
+// Calls AddIntersectTs on every pair of contours in the sorted list whose bounds may intersect,
+// in list order.
+void AddAllIntersectTs(SkOpContourHead* contourList, SkOpCoincidence* coincidence);
+
 #endif
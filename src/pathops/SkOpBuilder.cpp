@@ -11,6 +11,10 @@
 #include "SkPathPriv.h"
 #include "SkPathOps.h"
 #include "SkPathOpsCommon.h"
+#include "SkRTree.h"
+#include "SkTaskGroup.h"
+
+#include <atomic>
 
 static bool one_contour(const SkPath& path) {
     SkSTArenaAlloc<256> allocator;
@@ -106,6 +110,123 @@ bool SkOpBuilder::FixWinding(SkPath* path) {
     return true;
 }
 
+static int find_group(SkTDArray<int>* parent, int index) {
+    while ((*parent)[index] != index) {
+        (*parent)[index] = (*parent)[(*parent)[index]];
+        index = (*parent)[index];
+    }
+    return index;
+}
+
+// Unions paths pairwise, a tree level at a time, running each level's pairs on executor.
+// Paths are first split into groups whose bounds overlap, directly or through other paths in
+// the group. Different groups can't cover the same area, so each is reduced on its own and the
+// even-odd results are concatenated rather than intersected.
+static bool union_tree(const SkTArray<SkPath>& paths, SkExecutor* executor, SkPath* result) {
+    const int count = paths.count();
+    SkAutoTMalloc<SkRect> bounds(count);
+    for (int index = 0; index < count; ++index) {
+        bounds[index] = paths[index].getBounds();
+    }
+    SkRTree rtree;
+    rtree.insert(bounds, count);
+
+    SkTDArray<int> parent;
+    parent.setCount(count);
+    for (int index = 0; index < count; ++index) {
+        parent[index] = index;
+    }
+    SkTDArray<int> hits;
+    for (int index = 0; index < count; ++index) {
+        hits.rewind();
+        rtree.search(bounds[index], &hits);
+        for (int hit : hits) {
+            int a = find_group(&parent, index);
+            int b = find_group(&parent, hit);
+            if (a != b) {
+                parent[SkTMax(a, b)] = SkTMin(a, b);
+            }
+        }
+    }
+
+    // Operands of each group, in the order they were added.
+    SkTArray<SkTArray<SkPath>> groups;
+    SkTDArray<int> groupOf;
+    groupOf.setCount(count);
+    for (int index = 0; index < count; ++index) {
+        groupOf[index] = -1;
+    }
+    for (int index = 0; index < count; ++index) {
+        int root = find_group(&parent, index);
+        if (groupOf[root] < 0) {
+            groupOf[root] = groups.count();
+            groups.push_back();
+        }
+        groups[groupOf[root]].push_back(paths[index]);
+    }
+
+    struct Job {
+        SkPath*       fDst;
+        const SkPath* fSrc;     // nullptr to simplify fDst alone
+    };
+    SkTDArray<Job> jobs;
+    std::atomic<bool> failed(false);
+    auto run = [&](int i) {
+        const Job& job = jobs[i];
+        bool ok = job.fSrc ? Op(*job.fDst, *job.fSrc, kUnion_SkPathOp, job.fDst)
+                           : Simplify(*job.fDst, job.fDst);
+        if (!ok) {
+            failed.store(true, std::memory_order_relaxed);
+        }
+    };
+
+    auto queuePairs = [&]() {
+        for (SkTArray<SkPath>& group : groups) {
+            for (int index = 0; index + 1 < group.count(); index += 2) {
+                *jobs.append() = { &group[index], &group[index + 1] };
+            }
+        }
+    };
+
+    // Lone paths only need simplifying; every other path is resolved by the ops below.
+    for (SkTArray<SkPath>& group : groups) {
+        if (group.count() == 1) {
+            *jobs.append() = { &group[0], nullptr };
+        }
+    }
+    queuePairs();
+    while (!jobs.isEmpty() && !failed.load(std::memory_order_relaxed)) {
+        SkTaskGroup(*executor).batch(jobs.count(), run);
+        jobs.rewind();
+
+        // Each pair left its union in the even slot; fold those down and pair them again.
+        for (SkTArray<SkPath>& group : groups) {
+            if (group.count() > 1) {
+                for (int index = 2; index < group.count(); index += 2) {
+                    group[index >> 1] = group[index];
+                }
+                group.resize_back((group.count() + 1) >> 1);
+            }
+        }
+        queuePairs();
+    }
+    if (failed.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    if (groups.count() == 1) {
+        *result = groups[0][0];
+        return true;
+    }
+    SkPath sum;
+    for (const SkTArray<SkPath>& group : groups) {
+        sum.addPath(group[0]);
+    }
+    sum.setFillType(SkPath::kEvenOdd_FillType);
+    *result = sum;
+    return true;
+}
+
 void SkOpBuilder::add(const SkPath& path, SkPathOp op) {
     if (0 == fOps.count() && op != kUnion_SkPathOp) {
         fPathRefs.push_back() = SkPath();
@@ -123,9 +244,13 @@ void SkOpBuilder::reset() {
 /* OPTIMIZATION: Union doesn't need to be all-or-nothing. A run of three or more convex
    paths with union ops could be locally resolved and still improve over doing the
    ops one at a time. */
-bool SkOpBuilder::resolve(SkPath* result) {
+bool SkOpBuilder::resolve(SkPath* result, SkExecutor* executor) {
     SkPath original = *result;
     int count = fOps.count();
+    bool unionOnly = count > 1;
+    for (int index = 0; index < count && unionOnly; ++index) {
+        unionOnly = kUnion_SkPathOp == fOps[index] && !fPathRefs[index].isInverseFillType();
+    }
     bool allUnion = true;
     SkPathPriv::FirstDirection firstDir = SkPathPriv::kUnknown_FirstDirection;
     for (int index = 0; index < count; ++index) {
@@ -158,6 +283,14 @@ bool SkOpBuilder::resolve(SkPath* result) {
             }
         }
     }
+    if (!allUnion && unionOnly && executor) {
+        bool success = union_tree(fPathRefs, executor, result);
+        reset();
+        if (!success) {
+            *result = original;
+        }
+        return success;
+    }
     if (!allUnion) {
         *result = fPathRefs[0];
         for (int index = 1; index < count; ++index) {
@@ -8,13 +8,19 @@
 #include "SkDeflate.h"
 
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkMakeUnique.h"
 #include "SkMalloc.h"
+#include "SkSemaphore.h"
 #include "SkTo.h"
 #include "SkTraceEvent.h"
 
 #include "zlib.h"
 
+#include <atomic>
+#include <deque>
+#include <memory>
+
 namespace {
 
 // Different zlib implementations use different T.
@@ -55,32 +61,168 @@ static void do_deflate(int flush,
                  : returnValue == Z_OK);
 }
 
+static void init_z_stream(z_stream* zStream, int compressionLevel, int windowBits) {
+    zStream->next_in = nullptr;
+    zStream->zalloc = &skia_alloc_func;
+    zStream->zfree = &skia_free_func;
+    zStream->opaque = nullptr;
+    SkASSERT(compressionLevel <= 9 && compressionLevel >= -1);
+    SkDEBUGCODE(int r =) deflateInit2(zStream, compressionLevel,
+                                      Z_DEFLATED, windowBits,
+                                      8, Z_DEFAULT_STRATEGY);
+    SkASSERT(Z_OK == r);
+}
+
+// Parallel mode works like pigz: the input is cut into blocks, each block is compressed as raw
+// deflate data on the executor, and the results are written out in order between a zlib header
+// and trailer.  Every block but the last ends with a sync flush so that they concatenate into a
+// single deflate stream, and each block uses the tail of the previous one as its dictionary so
+// little is lost to the cuts.
+static constexpr size_t kParallelBlockSize = 128 * 1024;
+static constexpr size_t kDeflateWindowSize = 32 * 1024;
+static constexpr size_t kMaxPendingBlocks  = 16;
+
+namespace {
+
+struct DeflateBlock {
+    sk_sp<SkData> fInput;       // Only the first fInputSize bytes are used.
+    size_t fInputSize;
+    sk_sp<SkData> fDictionary;  // The previous block's input, or null for the first block.
+    int fCompressionLevel;
+    bool fLast;
+
+    SkDynamicMemoryWStream fOutput;
+    uLong fAdler;
+    std::atomic<bool> fClaimed{false};
+    SkSemaphore fDone;
+
+    // Compresses the block unless some other thread already has.  Returns true if it did.
+    bool tryCompress() {
+        if (fClaimed.exchange(true)) {
+            return false;
+        }
+        TRACE_EVENT0("skia", TRACE_FUNC);
+        // zlib only reads the input, but fDictionary may share it with the next block.
+        unsigned char* input = (unsigned char*)fInput->data();
+        z_stream zStream;
+        init_z_stream(&zStream, fCompressionLevel, -15);  // Raw deflate; no header or trailer.
+        if (fDictionary) {
+            size_t size = SkTMin(fDictionary->size(), kDeflateWindowSize);
+            (void)deflateSetDictionary(&zStream,
+                                       fDictionary->bytes() + fDictionary->size() - size,
+                                       SkToUInt(size));
+        }
+        do_deflate(fLast ? Z_FINISH : Z_SYNC_FLUSH, &zStream, &fOutput, input, fInputSize);
+        (void)deflateEnd(&zStream);
+        fAdler = adler32(adler32(0L, Z_NULL, 0), input, SkToUInt(fInputSize));
+        return true;
+    }
+};
+
+}  // namespace
+
+static void write_zlib_header(SkWStream* out, int compressionLevel) {
+    // Deflate with a 32K window, and the same FLEVEL hint zlib itself would write.
+    unsigned header = (Z_DEFLATED + ((15 - 8) << 4)) << 8;
+    unsigned level = compressionLevel < 0  ? 2
+                   : compressionLevel < 2  ? 0
+                   : compressionLevel < 6  ? 1
+                   : compressionLevel == 6 ? 2
+                   :                         3;
+    header |= level << 6;
+    header += 31 - (header % 31);
+    out->write8(SkToU8(header >> 8));
+    out->write8(SkToU8(header & 0xFF));
+}
+
+static void write_zlib_trailer(SkWStream* out, uLong adler) {
+    for (int shift : {24, 16, 8, 0}) {
+        out->write8(SkToU8((adler >> shift) & 0xFF));
+    }
+}
+
 // Hide all zlib impl details.
 struct SkDeflateWStream::Impl {
     SkWStream* fOut;
     unsigned char fInBuffer[SKDEFLATEWSTREAM_INPUT_BUFFER_SIZE];
     size_t fInBufferIndex;
     z_stream fZStream;
+
+    // Parallel mode only.
+    SkExecutor* fExecutor = nullptr;
+    int fCompressionLevel;
+    sk_sp<SkData> fBlock;  // The block being filled, fInBufferIndex bytes so far.
+    sk_sp<SkData> fPreviousBlock;
+    std::deque<std::shared_ptr<DeflateBlock>> fPending;
+    uLong fAdler;
+    size_t fTotalIn = 0;
+
+    std::shared_ptr<DeflateBlock> makeBlock(bool last) {
+        auto block = std::make_shared<DeflateBlock>();
+        block->fInput = fBlock ? std::move(fBlock) : SkData::MakeEmpty();
+        block->fInputSize = fInBufferIndex;
+        block->fDictionary = fPreviousBlock;
+        block->fCompressionLevel = fCompressionLevel;
+        block->fLast = last;
+        fPreviousBlock = block->fInput;
+        fInBufferIndex = 0;
+        fPending.push_back(block);
+        return block;
+    }
+
+    // Waits for the oldest pending block, compressing it here if nothing has started it yet.
+    void writeOldestBlock() {
+        std::shared_ptr<DeflateBlock> block = std::move(fPending.front());
+        fPending.pop_front();
+        if (!block->tryCompress()) {
+            block->fDone.wait();
+        }
+        block->fOutput.writeToAndReset(fOut);
+        fAdler = adler32_combine(fAdler, block->fAdler, (z_off_t)block->fInputSize);
+    }
+
+    void submitBlock() {
+        std::shared_ptr<DeflateBlock> block = this->makeBlock(false);
+        fExecutor->add([block]() {
+            if (block->tryCompress()) {
+                block->fDone.signal();
+            }
+        });
+        if (fPending.size() > kMaxPendingBlocks) {
+            this->writeOldestBlock();
+        }
+    }
+
+    void finalizeParallel() {
+        // The last block is compressed on this thread when its turn comes.
+        (void)this->makeBlock(true);
+        while (!fPending.empty()) {
+            this->writeOldestBlock();
+        }
+        fPreviousBlock = nullptr;
+        write_zlib_trailer(fOut, fAdler);
+    }
 };
 
 SkDeflateWStream::SkDeflateWStream(SkWStream* out,
                                    int compressionLevel,
-                                   bool gzip)
+                                   bool gzip,
+                                   SkExecutor* executor)
     : fImpl(skstd::make_unique<SkDeflateWStream::Impl>()) {
     fImpl->fOut = out;
     fImpl->fInBufferIndex = 0;
     if (!fImpl->fOut) {
         return;
     }
-    fImpl->fZStream.next_in = nullptr;
-    fImpl->fZStream.zalloc = &skia_alloc_func;
-    fImpl->fZStream.zfree = &skia_free_func;
-    fImpl->fZStream.opaque = nullptr;
-    SkASSERT(compressionLevel <= 9 && compressionLevel >= -1);
-    SkDEBUGCODE(int r =) deflateInit2(&fImpl->fZStream, compressionLevel,
-                                      Z_DEFLATED, gzip ? 0x1F : 0x0F,
-                                      8, Z_DEFAULT_STRATEGY);
-    SkASSERT(Z_OK == r);
+    if (executor && !gzip) {
+        SkASSERT(compressionLevel <= 9 && compressionLevel >= -1);
+        fImpl->fExecutor = executor;
+        fImpl->fCompressionLevel = compressionLevel;
+        fImpl->fAdler = adler32(0L, Z_NULL, 0);
+        write_zlib_header(fImpl->fOut, compressionLevel);
+        return;
+    }
+    init_z_stream(&fImpl->fZStream, compressionLevel, gzip ? 0x1F : 0x0F);
 }
 
 SkDeflateWStream::~SkDeflateWStream() { this->finalize(); }
@@ -90,6 +232,11 @@ void SkDeflateWStream::finalize() {
     if (!fImpl->fOut) {
         return;
     }
+    if (fImpl->fExecutor) {
+        fImpl->finalizeParallel();
+        fImpl->fOut = nullptr;
+        return;
+    }
     do_deflate(Z_FINISH, &fImpl->fZStream, fImpl->fOut, fImpl->fInBuffer,
                fImpl->fInBufferIndex);
     (void)deflateEnd(&fImpl->fZStream);
@@ -102,6 +249,23 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
         return false;
     }
     const char* buffer = (const char*)void_buffer;
+    if (fImpl->fExecutor) {
+        fImpl->fTotalIn += len;
+        while (len > 0) {
+            if (!fImpl->fBlock) {
+                fImpl->fBlock = SkData::MakeUninitialized(kParallelBlockSize);
+            }
+            size_t tocopy = SkTMin(len, kParallelBlockSize - fImpl->fInBufferIndex);
+            memcpy((char*)fImpl->fBlock->writable_data() + fImpl->fInBufferIndex, buffer, tocopy);
+            len -= tocopy;
+            buffer += tocopy;
+            fImpl->fInBufferIndex += tocopy;
+            if (kParallelBlockSize == fImpl->fInBufferIndex) {
+                fImpl->submitBlock();
+            }
+        }
+        return true;
+    }
     while (len > 0) {
         size_t tocopy =
                 SkTMin(len, sizeof(fImpl->fInBuffer) - fImpl->fInBufferIndex);
@@ -122,5 +286,8 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
 }
 
 size_t SkDeflateWStream::bytesWritten() const {
+    if (fImpl->fExecutor) {
+        return fImpl->fTotalIn;
+    }
     return fImpl->fZStream.total_in + fImpl->fInBufferIndex;
 }
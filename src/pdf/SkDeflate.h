@@ -11,6 +11,8 @@
 
 #include "SkStream.h"
 
+class SkExecutor;
+
 /**
   * Wrap a stream in this class to compress the information written to
   * this stream using the Deflate algorithm.
@@ -29,10 +31,19 @@ public:
         a wrapper, documented in RFC 1952, around a deflate stream."
         gzip adds a header with a magic number to the beginning of the
         stream, allowing a client to identify a gzip file.
+
+        @param executor if not null (and gzip is false), the input is cut
+        into 128 KiB blocks that are compressed independently on the
+        executor, each primed with the previous block's last 32 KiB, and
+        their output is stitched back into a single zlib stream.  This
+        costs a few bytes per block.  Waiting on a block that has not
+        started yet runs it on the calling thread, so this is safe to use
+        from within another job on the same executor.
      */
     SkDeflateWStream(SkWStream*,
                      int compressionLevel = -1,
-                     bool gzip = false);
+                     bool gzip = false,
+                     SkExecutor* executor = nullptr);
 
     /** The destructor calls finalize(). */
     ~SkDeflateWStream() override;
@@ -17,6 +17,7 @@
 #include "SkPDFDocumentPriv.h"
 #include "SkPDFTypes.h"
 #include "SkPDFUtils.h"
+#include "SkPngInfo.h"
 #include "SkStream.h"
 #include "SkTo.h"
 
@@ -73,7 +74,8 @@ static void emit_image_stream(SkPDFDocument* doc,
                               const char* colorSpace,
                               SkPDFIndirectReference sMask,
                               int length,
-                              bool isJpeg) {
+                              bool isJpeg,
+                              int pngPredictorColors = 0) {
     SkPDFDict pdfDict("XObject");
     pdfDict.insertName("Subtype", "Image");
     pdfDict.insertInt("Width", size.width());
@@ -94,13 +96,23 @@ static void emit_image_stream(SkPDFDocument* doc,
     if (isJpeg) {
         pdfDict.insertInt("ColorTransform", 0);
     }
+    if (pngPredictorColors) {
+        // The rows were filtered by a PNG encoder, each with its own choice of filter.
+        auto decodeParms = SkPDFMakeDict();
+        decodeParms->insertInt("Predictor", 15);
+        decodeParms->insertInt("Colors", pngPredictorColors);
+        decodeParms->insertInt("BitsPerComponent", 8);
+        decodeParms->insertInt("Columns", size.width());
+        pdfDict.insertObject("DecodeParms", std::move(decodeParms));
+    }
     pdfDict.insertInt("Length", length);
     doc->emitStream(pdfDict, std::move(writeStream), ref);
 }
 
 static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndirectReference ref) {
     SkDynamicMemoryWStream buffer;
-    SkDeflateWStream deflateWStream(&buffer);
+    SkDeflateWStream deflateWStream(&buffer, (int)doc->metadata().fCompressionLevel,
+                                    false, doc->executor());
     if (kAlpha_8_SkColorType == pm.colorType()) {
         SkASSERT(pm.rowBytes() == (size_t)pm.width());
         buffer.write(pm.addr8(), pm.width() * pm.height());
@@ -143,7 +155,8 @@ static void do_deflated_image(const SkPixmap& pm,
         sMask = doc->reserveRef();
     }
     SkDynamicMemoryWStream buffer;
-    SkDeflateWStream deflateWStream(&buffer);
+    SkDeflateWStream deflateWStream(&buffer, (int)doc->metadata().fCompressionLevel,
+                                    false, doc->executor());
     const char* colorSpace = "DeviceGray";
     switch (pm.colorType()) {
         case kAlpha_8_SkColorType:
@@ -222,6 +235,27 @@ static bool do_jpeg(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
     return true;
 }
 
+static bool do_png(const sk_sp<SkData>& data, SkPDFDocument* doc, SkISize size,
+                   SkPDFIndirectReference ref) {
+    SkISize pngSize;
+    int components;
+    sk_sp<SkData> idat;
+    if (!SkGetPngInfo(data, &pngSize, &components, &idat) || pngSize != size) {
+        return false;
+    }
+    #ifdef SK_PDF_BASE85_BINARY
+    SkDynamicMemoryWStream buffer;
+    SkPDFUtils::Base85Encode(SkMemoryStream::MakeDirect(idat->data(), idat->size()), &buffer);
+    idat = buffer.detachAsData();
+    #endif
+
+    emit_image_stream(doc, ref,
+                      [&idat](SkWStream* dst) { dst->write(idat->data(), idat->size()); },
+                      pngSize, components == 3 ? "DeviceRGB" : "DeviceGray",
+                      SkPDFIndirectReference(), SkToInt(idat->size()), false, components);
+    return true;
+}
+
 static SkBitmap to_pixels(const SkImage* image) {
     SkBitmap bm;
     int w = image->width(),
@@ -254,7 +288,8 @@ void serialize_image(const SkImage* img,
     SkASSERT(encodingQuality >= 0);
     SkISize dimensions = img->dimensions();
     sk_sp<SkData> data = img->refEncodedData();
-    if (data && do_jpeg(std::move(data), doc, dimensions, ref)) {
+    if (data && (do_png(data, doc, dimensions, ref) ||
+                 do_jpeg(std::move(data), doc, dimensions, ref))) {
         return;
     }
     SkBitmap bm = to_pixels(img);
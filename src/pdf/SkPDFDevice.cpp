@@ -2033,7 +2033,8 @@ void SkPDFDevice::drawSpecial(SkSpecialImage* srcImg, int x, int y, const SkPain
         matrix.postTranslate(SkIntToScalar(-x), SkIntToScalar(-y));
         const SkIRect clipBounds =
             this->cs().bounds(this->bounds()).roundOut().makeOffset(-x, -y);
-        sk_sp<SkImageFilterCache> cache(this->getImageFilterCache());
+        sk_sp<SkImageFilterCache> cache(
+                this->getImageFilterCache(filter, clipBounds, kN32_SkColorType));
         // TODO: Should PDF be operating in a specified color type/space? For now, run the filter
         // in the same color space as the source (this is different from all other backends).
         SkImageFilter::OutputProperties outputProperties(kN32_SkColorType, srcImg->getColorSpace());
@@ -2066,8 +2067,11 @@ sk_sp<SkSpecialImage> SkPDFDevice::snapSpecial() {
     return nullptr;
 }
 
-SkImageFilterCache* SkPDFDevice::getImageFilterCache() {
+SkImageFilterCache* SkPDFDevice::getImageFilterCache(const SkImageFilter* dag,
+                                                     const SkIRect& clipBounds,
+                                                     SkColorType colorType) {
     // We always return a transient cache, so it is freed after each
     // filter traversal.
-    return SkImageFilterCache::Create(SkImageFilterCache::kDefaultTransientSize);
+    return SkImageFilterCache::Create(
+            SkImageFilterCache::TransientSize(dag, clipBounds, colorType));
 }
@@ -137,7 +137,8 @@ protected:
     sk_sp<SkSpecialImage> makeSpecial(const SkBitmap&) override;
     sk_sp<SkSpecialImage> makeSpecial(const SkImage*) override;
     sk_sp<SkSpecialImage> snapSpecial() override;
-    SkImageFilterCache* getImageFilterCache() override;
+    SkImageFilterCache* getImageFilterCache(const SkImageFilter*, const SkIRect& clipBounds,
+                                            SkColorType) override;
 
 private:
     struct RectWithData {
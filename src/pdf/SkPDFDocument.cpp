@@ -8,6 +8,7 @@
 #include "SkPDFDocument.h"
 #include "SkPDFDocumentPriv.h"
 
+#include "SkExecutor.h"
 #include "SkMakeUnique.h"
 #include "SkPDFDevice.h"
 #include "SkPDFDocument.h"
@@ -113,18 +114,21 @@ static void serialize_footer(const SkPDFOffsetMap& offsetMap,
     wStream->writeText("\n%%EOF");
 }
 
+static constexpr size_t kMaxPageTreeNodeSize = 8;
+
 static SkPDFIndirectReference generate_page_tree(
         SkPDFDocument* doc,
-        std::vector<std::unique_ptr<SkPDFDict>> pages,
-        const std::vector<SkPDFIndirectReference>& pageRefs) {
+        const std::vector<SkPDFIndirectReference>& pageRefs,
+        const std::vector<SkPDFIndirectReference>& leafRefs) {
     // PDF wants a tree describing all the pages in the document.  We arbitrary
-    // choose 8 (kNodeSize) as the number of allowed children.  The internal
-    // nodes have type "Pages" with an array of children, a parent pointer, and
-    // the number of leaves below the node as "Count."  The leaves are passed
-    // into the method, have type "Page" and need a parent pointer. This method
-    // builds the tree bottom up, skipping internal nodes that would have only
-    // one child.
-    SkASSERT(pages.size() > 0);
+    // choose 8 (kMaxPageTreeNodeSize) as the number of allowed children.  The
+    // internal nodes have type "Pages" with an array of children, a parent
+    // pointer, and the number of leaves below the node as "Count."  The pages
+    // have already been written with the references of the lowest nodes as
+    // their parents, so this method builds the tree bottom up from those
+    // nodes, skipping internal nodes that would have only one child.
+    SkASSERT(pageRefs.size() > 0);
+    SkASSERT(leafRefs.size() == (pageRefs.size() - 1) / kMaxPageTreeNodeSize + 1);
     struct PageTreeNode {
         std::unique_ptr<SkPDFDict> fNode;
         SkPDFIndirectReference fReservedRef;
@@ -132,10 +136,9 @@ static SkPDFIndirectReference generate_page_tree(
 
         static std::vector<PageTreeNode> Layer(std::vector<PageTreeNode> vec, SkPDFDocument* doc) {
             std::vector<PageTreeNode> result;
-            static constexpr size_t kMaxNodeSize = 8;
             const size_t n = vec.size();
             SkASSERT(n >= 1);
-            const size_t result_len = (n - 1) / kMaxNodeSize + 1;
+            const size_t result_len = (n - 1) / kMaxPageTreeNodeSize + 1;
             SkASSERT(result_len >= 1);
             SkASSERT(n == 1 || result_len < n);
             result.reserve(result_len);
@@ -148,7 +151,7 @@ static SkPDFIndirectReference generate_page_tree(
                 SkPDFIndirectReference parent = doc->reserveRef();
                 auto kids_list = SkPDFMakeArray();
                 int descendantCount = 0;
-                for (size_t j = 0; j < kMaxNodeSize && index < n; ++j) {
+                for (size_t j = 0; j < kMaxPageTreeNodeSize && index < n; ++j) {
                     PageTreeNode& node = vec[index++];
                     node.fNode->insertRef("Parent", parent);
                     kids_list->appendRef(doc->emit(*node.fNode, node.fReservedRef));
@@ -163,12 +166,21 @@ static SkPDFIndirectReference generate_page_tree(
         }
     };
     std::vector<PageTreeNode> currentLayer;
-    currentLayer.reserve(pages.size());
-    SkASSERT(pages.size() == pageRefs.size());
-    for (size_t i = 0; i < pages.size(); ++i) {
-        currentLayer.push_back(PageTreeNode{std::move(pages[i]), pageRefs[i], 1});
+    currentLayer.reserve(leafRefs.size());
+    size_t index = 0;
+    for (SkPDFIndirectReference leafRef : leafRefs) {
+        auto kids_list = SkPDFMakeArray();
+        int descendantCount = 0;
+        for (size_t j = 0; j < kMaxPageTreeNodeSize && index < pageRefs.size(); ++j) {
+            kids_list->appendRef(pageRefs[index++]);
+            descendantCount++;
+        }
+        auto leaf = SkPDFMakeDict("Pages");
+        leaf->insertInt("Count", descendantCount);
+        leaf->insertObject("Kids", std::move(kids_list));
+        currentLayer.push_back(PageTreeNode{std::move(leaf), leafRef, descendantCount});
     }
-    currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
+    SkASSERT(index == pageRefs.size());
     while (currentLayer.size() > 1) {
         currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
     }
@@ -227,7 +239,7 @@ static SkSize operator*(SkSize u, SkScalar s) { return SkSize{u.width() * s, u.h
 
 SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageRefs.empty()) {
         // if this is the first page if the document.
         {
             SkAutoMutexAcquire autoMutexAcquire(fMutex);
@@ -287,8 +299,20 @@ void SkPDFDocument::onEndPage() {
     page->insertRef("Contents", SkPDFStreamOut(nullptr, std::move(pageContent), this));
     // The StructParents unique identifier for each page is just its
     // 0-based page index.
-    page->insertInt("StructParents", SkToInt(this->currentPageIndex()));
-    fPages.emplace_back(std::move(page));
+    size_t pageIndex = this->currentPageIndex();
+    page->insertInt("StructParents", SkToInt(pageIndex));
+
+    // Write the page now rather than on close, so that memory use does not grow with the
+    // number of pages.
+    if (pageIndex % kMaxPageTreeNodeSize == 0) {
+        fPageTreeLeaves.push_back(this->reserveRef());
+    }
+    page->insertRef("Parent", fPageTreeLeaves.back());
+    this->emit(*page, fPageRefs.back());
+
+    if (fExecutor) {
+        this->waitForJobs(kMaxJobsInFlight);
+    }
 }
 
 void SkPDFDocument::onAbort() {
@@ -450,9 +474,44 @@ static std::vector<const SkPDFFont*> get_fonts(const SkPDFDocument& canon) {
     return fonts;
 }
 
+static void emit_fonts(SkPDFDocument* doc) {
+    std::vector<const SkPDFFont*> fonts = get_fonts(*doc);
+    SkExecutor* executor = doc->executor();
+    if (!executor) {
+        for (const SkPDFFont* f : fonts) {
+            f->emitSubset(doc);
+        }
+        return;
+    }
+    // Multi-byte (Type0) fonts are where the time goes: subsetting and the glyph widths
+    // array.  Once their metrics and unicode maps are cached they only read the document's
+    // canonicalization maps, so they can be emitted in parallel.  The other font types
+    // still insert into those maps, so emit them first, serially.
+    for (const SkPDFFont* f : fonts) {
+        if (!f->multiByteGlyphs()) {
+            f->emitSubset(doc);
+        }
+    }
+    for (const SkPDFFont* f : fonts) {
+        if (f->multiByteGlyphs()) {
+            (void)SkPDFFont::GetMetrics(f->typeface(), doc);
+            (void)SkPDFFont::GetUnicodeMap(f->typeface(), doc);
+        }
+    }
+    for (const SkPDFFont* f : fonts) {
+        if (f->multiByteGlyphs()) {
+            doc->incrementJobCount();
+            executor->add([f, doc]() {
+                f->emitSubset(doc);
+                doc->signalJobComplete();
+            });
+        }
+    }
+}
+
 void SkPDFDocument::onClose(SkWStream* stream) {
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageRefs.empty()) {
         this->waitForJobs();
         return;
     }
@@ -465,7 +524,7 @@ void SkPDFDocument::onClose(SkWStream* stream) {
         docCatalog->insertObject("OutputIntents", make_srgb_output_intents(this));
     }
 
-    docCatalog->insertRef("Pages", generate_page_tree(this, std::move(fPages), fPageRefs));
+    docCatalog->insertRef("Pages", generate_page_tree(this, fPageRefs, fPageTreeLeaves));
 
     if (fDests.size() > 0) {
         docCatalog->insertRef("Dests", this->emit(fDests));
@@ -483,9 +542,7 @@ void SkPDFDocument::onClose(SkWStream* stream) {
 
     auto docCatalogRef = this->emit(*docCatalog);
 
-    for (const SkPDFFont* f : get_fonts(*this)) {
-        f->emitSubset(this);
-    }
+    emit_fonts(this);
 
     this->waitForJobs();
     {
@@ -498,9 +555,9 @@ void SkPDFDocument::incrementJobCount() { fJobCount++; }
 
 void SkPDFDocument::signalJobComplete() { fSemaphore.signal(); }
 
-void SkPDFDocument::waitForJobs() {
+void SkPDFDocument::waitForJobs(int maxJobs) {
      // fJobCount can increase while we wait.
-     while (fJobCount > 0) {
+     while (fJobCount > maxJobs) {
          fSemaphore.wait();
          --fJobCount;
      }
@@ -22,15 +22,18 @@
 class SkExecutor;
 class SkPDFDevice;
 class SkPDFFont;
-struct SkAdvancedTypefaceMetrics;
 struct SkBitmapKey;
 struct SkPDFFillGraphicState;
+struct SkPDFGlyphToUnicode;
 struct SkPDFImageShaderKey;
 struct SkPDFStrokeGraphicState;
+struct SkPDFTypefaceMetrics;
 
 namespace SkPDFGradientShader {
 struct Key;
 struct KeyHash;
+struct RampKey;
+struct RampKeyHash;
 }
 
 const char* SkPDFGetNodeIdKey();
@@ -92,17 +95,24 @@ public:
     SkExecutor* executor() const { return fExecutor; }
     void incrementJobCount();
     void signalJobComplete();
-    size_t currentPageIndex() { return fPages.size(); }
+    size_t currentPageIndex() {
+        SkASSERT(!fPageRefs.empty());
+        return fPageRefs.size() - 1;
+    }
     size_t pageCount() { return fPageRefs.size(); }
 
     // Canonicalized objects
     SkTHashMap<SkPDFImageShaderKey, SkPDFIndirectReference> fImageShaderMap;
     SkTHashMap<SkPDFGradientShader::Key, SkPDFIndirectReference, SkPDFGradientShader::KeyHash>
         fGradientPatternMap;
+    SkTHashMap<SkPDFGradientShader::RampKey, SkPDFIndirectReference,
+               SkPDFGradientShader::RampKeyHash> fGradientStitchFunctionMap;
+    SkTHashMap<SkPDFGradientShader::RampKey, sk_sp<SkData>, SkPDFGradientShader::RampKeyHash>
+        fGradientRampCodeMap;
     SkTHashMap<SkBitmapKey, SkPDFIndirectReference> fPDFBitmapMap;
-    SkTHashMap<uint32_t, std::unique_ptr<SkAdvancedTypefaceMetrics>> fTypefaceMetrics;
+    SkTHashMap<uint32_t, sk_sp<SkPDFTypefaceMetrics>> fTypefaceMetrics;
     SkTHashMap<uint32_t, std::vector<SkString>> fType1GlyphNames;
-    SkTHashMap<uint32_t, std::vector<SkUnichar>> fToUnicodeMap;
+    SkTHashMap<uint32_t, sk_sp<SkPDFGlyphToUnicode>> fToUnicodeMap;
     SkTHashMap<uint32_t, SkPDFIndirectReference> fFontDescriptors;
     SkTHashMap<uint32_t, SkPDFIndirectReference> fType3FontDescriptors;
     SkTHashMap<uint64_t, SkPDFFont> fFontMap;
@@ -114,8 +124,10 @@ public:
 private:
     SkPDFOffsetMap fOffsetMap;
     SkCanvas fCanvas;
-    std::vector<std::unique_ptr<SkPDFDict>> fPages;
     std::vector<SkPDFIndirectReference> fPageRefs;
+    // Each page is written out when it ends, with one of these as its parent; the rest of the
+    // page tree is built from them on close.  Leaf i holds pages [i * 8, i * 8 + 8).
+    std::vector<SkPDFIndirectReference> fPageTreeLeaves;
     SkPDFDict fDests;
     sk_sp<SkPDFDevice> fPageDevice;
     std::atomic<int> fNextObjectNumber = {1};
@@ -134,7 +146,12 @@ private:
     SkMutex fMutex;
     SkSemaphore fSemaphore;
 
-    void waitForJobs();
+    // With an executor, onEndPage() waits once this many jobs are outstanding, so that
+    // pages whose content is still being compressed cannot pile up without bound.
+    static constexpr int kMaxJobsInFlight = 64;
+
+    // Blocks until at most maxJobs jobs are outstanding.  Only called on the main thread.
+    void waitForJobs(int maxJobs = 0);
     SkWStream* beginObject(SkPDFIndirectReference);
     void endObject();
 };
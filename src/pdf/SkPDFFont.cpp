@@ -10,8 +10,10 @@
 #include "SkData.h"
 #include "SkFont.h"
 #include "SkImagePriv.h"
+#include "SkLRUCache.h"
 #include "SkMacros.h"
 #include "SkMakeUnique.h"
+#include "SkMutex.h"
 #include "SkPDFBitmap.h"
 #include "SkPDFDocument.h"
 #include "SkPDFConvertType1FontStream.h"
@@ -105,18 +107,52 @@ static bool can_embed(const SkAdvancedTypefaceMetrics& metrics) {
     return !SkToBool(metrics.fFlags & SkAdvancedTypefaceMetrics::kNotEmbeddable_FontFlag);
 }
 
-const SkAdvancedTypefaceMetrics* SkPDFFont::GetMetrics(const SkTypeface* typeface,
-                                                       SkPDFDocument* canon) {
-    SkASSERT(typeface);
-    SkFontID id = typeface->uniqueID();
-    if (std::unique_ptr<SkAdvancedTypefaceMetrics>* ptr = canon->fTypefaceMetrics.find(id)) {
-        return ptr->get();  // canon retains ownership.
+// Metrics and unicode maps depend only on the typeface, not on the glyphs a document uses, so
+// they are shared by all documents.  Typeface IDs are never reused, so entries never go stale;
+// the least recently used are dropped, while documents keep their own references alive.
+namespace {
+struct SharedFontData {
+    static constexpr int kMaxMetrics = 128;
+    // A unicode map can be as large as 256KB.
+    static constexpr int kMaxUnicodeMaps = 16;
+
+    SkMutex fMutex;
+    SkLRUCache<SkFontID, sk_sp<SkPDFTypefaceMetrics>> fMetrics{kMaxMetrics};
+    SkLRUCache<SkFontID, sk_sp<SkPDFGlyphToUnicode>> fUnicodeMaps{kMaxUnicodeMaps};
+};
+}  // namespace
+
+static SharedFontData& shared_font_data() {
+    static SharedFontData* data = new SharedFontData;
+    return *data;
+}
+
+// Data is computed without holding the lock; if another thread got there first, its result wins.
+template <typename T, typename MakeProc>
+static sk_sp<T> find_or_make_shared(SkLRUCache<SkFontID, sk_sp<T>>* cache, SkFontID id,
+                                    MakeProc make) {
+    SkMutex& mutex = shared_font_data().fMutex;
+    {
+        SkAutoMutexAcquire lock(mutex);
+        if (sk_sp<T>* found = cache->find(id)) {
+            return *found;
+        }
     }
+    sk_sp<T> data = make();
+    SkAutoMutexAcquire lock(mutex);
+    if (sk_sp<T>* found = cache->find(id)) {
+        return *found;
+    }
+    cache->insert(id, data);
+    return data;
+}
+
+sk_sp<SkPDFTypefaceMetrics> SkPDFFont::MakeMetrics(const SkTypeface* typeface) {
+    sk_sp<SkPDFTypefaceMetrics> result = sk_make_sp<SkPDFTypefaceMetrics>();
     int count = typeface->countGlyphs();
     if (count <= 0 || count > 1 + SkTo<int>(UINT16_MAX)) {
-        // Cache nullptr to skip this check.  Use SkSafeUnref().
-        canon->fTypefaceMetrics.set(id, nullptr);
-        return nullptr;
+        // Cache an entry without metrics to skip this check.
+        return result;
     }
     std::unique_ptr<SkAdvancedTypefaceMetrics> metrics = typeface->getAdvancedMetrics();
     if (!metrics) {
@@ -152,7 +188,20 @@ const SkAdvancedTypefaceMetrics* SkPDFFont::GetMetrics(const SkTypeface* typefac
             metrics->fCapHeight = SkToS16(SkScalarRoundToInt(capHeight / 2));
         }
     }
-    return canon->fTypefaceMetrics.set(id, std::move(metrics))->get();
+    result->fMetrics = std::move(metrics);
+    return result;
+}
+
+const SkAdvancedTypefaceMetrics* SkPDFFont::GetMetrics(const SkTypeface* typeface,
+                                                       SkPDFDocument* canon) {
+    SkASSERT(typeface);
+    SkFontID id = typeface->uniqueID();
+    if (sk_sp<SkPDFTypefaceMetrics>* ptr = canon->fTypefaceMetrics.find(id)) {
+        return (*ptr)->fMetrics.get();  // canon retains a reference.
+    }
+    sk_sp<SkPDFTypefaceMetrics> metrics = find_or_make_shared(
+            &shared_font_data().fMetrics, id, [typeface]() { return MakeMetrics(typeface); });
+    return (*canon->fTypefaceMetrics.set(id, std::move(metrics)))->fMetrics.get();
 }
 
 const std::vector<SkUnichar>& SkPDFFont::GetUnicodeMap(const SkTypeface* typeface,
@@ -160,12 +209,17 @@ const std::vector<SkUnichar>& SkPDFFont::GetUnicodeMap(const SkTypeface* typefac
     SkASSERT(typeface);
     SkASSERT(canon);
     SkFontID id = typeface->uniqueID();
-    if (std::vector<SkUnichar>* ptr = canon->fToUnicodeMap.find(id)) {
-        return *ptr;
-    }
-    std::vector<SkUnichar> buffer(typeface->countGlyphs());
-    typeface->getGlyphToUnicodeMap(buffer.data());
-    return *canon->fToUnicodeMap.set(id, std::move(buffer));
+    if (sk_sp<SkPDFGlyphToUnicode>* ptr = canon->fToUnicodeMap.find(id)) {
+        return (*ptr)->fMap;
+    }
+    sk_sp<SkPDFGlyphToUnicode> map = find_or_make_shared(
+            &shared_font_data().fUnicodeMaps, id, [typeface]() {
+                sk_sp<SkPDFGlyphToUnicode> result = sk_make_sp<SkPDFGlyphToUnicode>();
+                result->fMap.resize(typeface->countGlyphs());
+                typeface->getGlyphToUnicodeMap(result->fMap.data());
+                return result;
+            });
+    return (*canon->fToUnicodeMap.set(id, std::move(map)))->fMap;
 }
 
 SkAdvancedTypefaceMetrics::FontType SkPDFFont::FontType(const SkAdvancedTypefaceMetrics& metrics) {
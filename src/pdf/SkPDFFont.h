@@ -14,6 +14,20 @@
 #include "SkStrikeCache.h"
 #include "SkTypeface.h"
 
+#include <vector>
+
+/** The subset-independent data that SkPDFFont needs about a typeface.  Computing it can mean
+    parsing the whole font, so it is cached for the whole process and shared by every document
+    that uses the typeface; each document also keeps a reference of its own.
+*/
+struct SkPDFTypefaceMetrics : public SkNVRefCnt<SkPDFTypefaceMetrics> {
+    std::unique_ptr<SkAdvancedTypefaceMetrics> fMetrics;  // nullptr when the typeface is bad.
+};
+
+struct SkPDFGlyphToUnicode : public SkNVRefCnt<SkPDFGlyphToUnicode> {
+    std::vector<SkUnichar> fMap;
+};
+
 /** \class SkPDFFont
     A PDF Object class representing a font.  The font may have resources
     attached to it in order to embed the font.  SkPDFFonts are canonicalized
@@ -88,7 +102,8 @@ public:
                                       SkTypeface* typeface,
                                       SkGlyphID glyphID);
 
-    /** Gets SkAdvancedTypefaceMetrics, and caches the result.
+    /** Gets SkAdvancedTypefaceMetrics, and caches the result in the document and in a
+     *  process-wide cache shared with other documents.
      *  @param typeface can not be nullptr.
      *  @return nullptr only when typeface is bad.
      */
@@ -127,6 +142,8 @@ private:
 
     SkPDFFont(const SkPDFFont&) = delete;
     SkPDFFont& operator=(const SkPDFFont&) = delete;
+
+    static sk_sp<SkPDFTypefaceMetrics> MakeMetrics(const SkTypeface*);
 };
 
 #endif
@@ -7,6 +7,7 @@
 
 #include "SkPDFGradientShader.h"
 
+#include "SkData.h"
 #include "SkOpts.h"
 #include "SkPDFDocument.h"
 #include "SkPDFDocumentPriv.h"
@@ -40,6 +41,22 @@ static uint32_t hash(const SkPDFGradientShader::Key& k) {
     return SkOpts::hash(buffer, sizeof(buffer));
 }
 
+static SkPDFGradientShader::RampKey make_ramp_key(const SkShader::GradientInfo& info) {
+    SkPDFGradientShader::RampKey key = {
+        std::vector<SkColor>(info.fColors, info.fColors + info.fColorCount),
+        std::vector<SkScalar>(info.fColorOffsets, info.fColorOffsets + info.fColorCount),
+        info.fTileMode,
+        0,
+    };
+    uint32_t buffer[] = {
+        SkOpts::hash(info.fColors, info.fColorCount * sizeof(SkColor)),
+        SkOpts::hash(info.fColorOffsets, info.fColorCount * sizeof(SkScalar)),
+        (uint32_t)info.fTileMode,
+    };
+    key.fHash = SkOpts::hash(buffer, sizeof(buffer));
+    return key;
+}
+
 static void unit_to_points_matrix(const SkPoint pts[2], SkMatrix* matrix) {
     SkVector    vec = pts[1] - pts[0];
     SkScalar    mag = vec.length();
@@ -291,6 +308,19 @@ static std::unique_ptr<SkPDFDict> gradientStitchCode(const SkShader::GradientInf
     return retval;
 }
 
+// Type 2 and 3 functions depend only on the color stops, so gradients that share them share one
+// function object.
+static SkPDFIndirectReference find_stitch_function(SkPDFDocument* doc,
+                                                   const SkShader::GradientInfo& info) {
+    SkPDFGradientShader::RampKey key = make_ramp_key(info);
+    if (SkPDFIndirectReference* ref = doc->fGradientStitchFunctionMap.find(key)) {
+        return *ref;
+    }
+    SkPDFIndirectReference ref = doc->emit(*gradientStitchCode(info));
+    doc->fGradientStitchFunctionMap.set(std::move(key), ref);
+    return ref;
+}
+
 /* Map a value of t on the stack into [0, 1) for Repeat or Mirror tile mode. */
 static void tileModeCode(SkShader::TileMode mode,
                          SkDynamicMemoryWStream* result) {
@@ -317,6 +347,21 @@ static void tileModeCode(SkShader::TileMode mode,
     }
 }
 
+/* Returns Type 4 function code that maps t on the stack to a color, tiling it first.  This is
+   the bulk of the code for every kind of gradient and does not depend on its geometry, so it is
+   generated once per document for each set of color stops and tile mode.
+ */
+static sk_sp<SkData> find_ramp_code(SkPDFDocument* doc, const SkShader::GradientInfo& info) {
+    SkPDFGradientShader::RampKey key = make_ramp_key(info);
+    if (sk_sp<SkData>* code = doc->fGradientRampCodeMap.find(key)) {
+        return *code;
+    }
+    SkDynamicMemoryWStream code;
+    tileModeCode(info.fTileMode, &code);
+    gradient_function_code(info, &code);
+    return *doc->fGradientRampCodeMap.set(std::move(key), code.detachAsData());
+}
+
 /**
  *  Returns PS function code that applies inverse perspective
  *  to a x, y point.
@@ -365,19 +410,20 @@ static void apply_perspective_to_coordinates(const SkMatrix& inversePerspectiveM
 
 static void linearCode(const SkShader::GradientInfo& info,
                        const SkMatrix& perspectiveRemover,
+                       const SkData& rampCode,
                        SkDynamicMemoryWStream* function) {
     function->writeText("{");
 
     apply_perspective_to_coordinates(perspectiveRemover, function);
 
     function->writeText("pop\n");  // Just ditch the y value.
-    tileModeCode(info.fTileMode, function);
-    gradient_function_code(info, function);
+    function->write(rampCode.data(), rampCode.size());
     function->writeText("}");
 }
 
 static void radialCode(const SkShader::GradientInfo& info,
                        const SkMatrix& perspectiveRemover,
+                       const SkData& rampCode,
                        SkDynamicMemoryWStream* function) {
     function->writeText("{");
 
@@ -392,8 +438,7 @@ static void radialCode(const SkShader::GradientInfo& info,
                     "add "      // y^2+x^2
                     "sqrt\n");  // sqrt(y^2+x^2)
 
-    tileModeCode(info.fTileMode, function);
-    gradient_function_code(info, function);
+    function->write(rampCode.data(), rampCode.size());
     function->writeText("}");
 }
 
@@ -402,6 +447,7 @@ static void radialCode(const SkShader::GradientInfo& info,
  */
 static void twoPointConicalCode(const SkShader::GradientInfo& info,
                                 const SkMatrix& perspectiveRemover,
+                                const SkData& rampCode,
                                 SkDynamicMemoryWStream* function) {
     SkScalar dx = info.fPoint[1].fX - info.fPoint[0].fX;
     SkScalar dy = info.fPoint[1].fY - info.fPoint[0].fY;
@@ -504,8 +550,7 @@ static void twoPointConicalCode(const SkShader::GradientInfo& info,
 
     // if the pixel is in the cone, proceed to compute a color
     function->writeText("{");
-    tileModeCode(info.fTileMode, function);
-    gradient_function_code(info, function);
+    function->write(rampCode.data(), rampCode.size());
 
     // otherwise, just write black
     function->writeText("} {0 0 0} ifelse }");
@@ -513,10 +558,10 @@ static void twoPointConicalCode(const SkShader::GradientInfo& info,
 
 static void sweepCode(const SkShader::GradientInfo& info,
                           const SkMatrix& perspectiveRemover,
+                          const SkData& rampCode,
                           SkDynamicMemoryWStream* function) {
     function->writeText("{exch atan 360 div\n");
-    tileModeCode(info.fTileMode, function);
-    gradient_function_code(info, function);
+    function->write(rampCode.data(), rampCode.size());
     function->writeText("}");
 }
 
@@ -605,7 +650,7 @@ static SkPDFIndirectReference make_function_shader(SkPDFDocument* doc,
     // in translating from x, y coordinates to the t parameter. So, we have
     // to transform the points and radii according to the calculated matrix.
     if (doStitchFunctions) {
-        pdfShader->insertObject("Function", gradientStitchCode(info));
+        pdfShader->insertRef("Function", find_stitch_function(doc, info));
         shadingType = (state.fType == SkShader::kLinear_GradientType) ? 2 : 3;
 
         auto extend = SkPDFMakeArray();
@@ -713,18 +758,19 @@ static SkPDFIndirectReference make_function_shader(SkPDFDocument* doc,
             infoCopy.fRadius[0] = inverseMapperMatrix.mapRadius(info.fRadius[0]);
             infoCopy.fRadius[1] = inverseMapperMatrix.mapRadius(info.fRadius[1]);
         }
+        sk_sp<SkData> rampCode = find_ramp_code(doc, info);
         switch (state.fType) {
             case SkShader::kLinear_GradientType:
-                linearCode(infoCopy, perspectiveInverseOnly, &functionCode);
+                linearCode(infoCopy, perspectiveInverseOnly, *rampCode, &functionCode);
                 break;
             case SkShader::kRadial_GradientType:
-                radialCode(infoCopy, perspectiveInverseOnly, &functionCode);
+                radialCode(infoCopy, perspectiveInverseOnly, *rampCode, &functionCode);
                 break;
             case SkShader::kConical_GradientType:
-                twoPointConicalCode(infoCopy, perspectiveInverseOnly, &functionCode);
+                twoPointConicalCode(infoCopy, perspectiveInverseOnly, *rampCode, &functionCode);
                 break;
             case SkShader::kSweep_GradientType:
-                sweepCode(infoCopy, perspectiveInverseOnly, &functionCode);
+                sweepCode(infoCopy, perspectiveInverseOnly, *rampCode, &functionCode);
                 break;
             default:
                 SkASSERT(false);
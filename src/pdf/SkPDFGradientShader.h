@@ -11,6 +11,8 @@
 #include "SkPDFUtils.h"
 #include "SkShader.h"
 
+#include <vector>
+
 class SkMatrix;
 class SkPDFDocument;
 struct SkIRect;
@@ -62,5 +64,24 @@ inline bool operator==(const Key& u, const Key& v) {
 }
 inline bool operator!=(const Key& u, const Key& v) { return !(u == v); }
 
+// The color stops and tile mode of a gradient: everything its PDF function depends on apart from
+// the geometry.  Many gradients in a document often share these.
+struct RampKey {
+    std::vector<SkColor> fColors;
+    std::vector<SkScalar> fStops;
+    SkShader::TileMode fTileMode;
+    uint32_t fHash;
+};
+
+struct RampKeyHash {
+    uint32_t operator()(const RampKey& k) const { return k.fHash; }
+};
+
+inline bool operator==(const RampKey& u, const RampKey& v) {
+    return u.fTileMode == v.fTileMode
+        && u.fColors   == v.fColors
+        && u.fStops    == v.fStops;
+}
+
 }  // namespace SkPDFGradientShader
 #endif  // SkPDFGradientShader_DEFINED
@@ -430,9 +430,12 @@ static void serialize_stream(SkPDFDict* origDict,
     SkPDFDict tmpDict;
     SkPDFDict& dict = origDict ? *origDict : tmpDict;
     static const size_t kMinimumSavings = strlen("/Filter_/FlateDecode_");
-    if (deflate && stream->getLength() > kMinimumSavings) {
+    if (doc->metadata().fCompressionLevel != SkPDF::Metadata::CompressionLevel::None &&
+        deflate && stream->getLength() > kMinimumSavings) {
         SkDynamicMemoryWStream compressedData;
-        SkDeflateWStream deflateWStream(&compressedData);
+        SkDeflateWStream deflateWStream(&compressedData,
+                                        (int)doc->metadata().fCompressionLevel,
+                                        false, doc->executor());
         SkStreamCopy(&deflateWStream, stream);
         deflateWStream.finalize();
         #ifdef SK_PDF_BASE85_BINARY
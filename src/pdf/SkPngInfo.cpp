@@ -0,0 +1,106 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkPngInfo.h"
+
+#include "SkStream.h"
+#include "SkTo.h"
+
+static uint32_t read_bigendian_uint32(const uint8_t* ptr) {
+    return (uint32_t)ptr[0] << 24 | (uint32_t)ptr[1] << 16 | (uint32_t)ptr[2] << 8 | ptr[3];
+}
+
+static bool is_chunk(const uint8_t* type, const char name[4]) {
+    return 0 == memcmp(type, name, 4);
+}
+
+bool SkGetPngInfo(const sk_sp<SkData>& data, SkISize* size, int* components,
+                  sk_sp<SkData>* idat) {
+    static const uint8_t kSignature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    static constexpr size_t kChunkOverhead = 12;  // length, type and CRC
+    static constexpr size_t kIHDRLength = 13;
+
+    const uint8_t* bytes = data->bytes();
+    size_t len = data->size();
+    if (len < sizeof(kSignature) + kChunkOverhead + kIHDRLength ||
+        0 != memcmp(bytes, kSignature, sizeof(kSignature))) {
+        return false;
+    }
+
+    // IHDR must come first.
+    size_t offset = sizeof(kSignature);
+    if (read_bigendian_uint32(bytes + offset) != kIHDRLength ||
+        !is_chunk(bytes + offset + 4, "IHDR")) {
+        return false;
+    }
+    const uint8_t* ihdr = bytes + offset + 8;
+    uint32_t width = read_bigendian_uint32(ihdr),
+             height = read_bigendian_uint32(ihdr + 4);
+    uint8_t bitDepth = ihdr[8],
+            colorType = ihdr[9],
+            compression = ihdr[10],
+            filter = ihdr[11],
+            interlace = ihdr[12];
+    // Gray (0) and RGB (2) are the color types without a palette or an alpha channel.
+    if (width == 0 || width > SK_MaxS32 || height == 0 || height > SK_MaxS32 ||
+        bitDepth != 8 || (colorType != 0 && colorType != 2) ||
+        compression != 0 || filter != 0 || interlace != 0) {
+        return false;
+    }
+    offset += kChunkOverhead + kIHDRLength;
+
+    // Collect the IDAT chunks, which must be consecutive, and give up on any transparency.
+    size_t firstIDAT = 0, idatLength = 0, idatCount = 0;
+    bool idatDone = false;
+    while (true) {
+        if (len - offset < kChunkOverhead) {
+            return false;
+        }
+        size_t chunkLength = read_bigendian_uint32(bytes + offset);
+        const uint8_t* type = bytes + offset + 4;
+        if (chunkLength > len - offset - kChunkOverhead) {
+            return false;
+        }
+        if (is_chunk(type, "IDAT")) {
+            if (idatDone) {
+                return false;
+            }
+            if (0 == idatCount++) {
+                firstIDAT = offset;
+            }
+            idatLength += chunkLength;
+        } else {
+            idatDone = idatCount > 0;
+            if (is_chunk(type, "tRNS")) {
+                return false;
+            }
+            if (is_chunk(type, "IEND")) {
+                break;
+            }
+        }
+        offset += kChunkOverhead + chunkLength;
+    }
+    if (0 == idatLength) {
+        return false;
+    }
+
+    if (1 == idatCount) {
+        *idat = SkData::MakeSubset(data.get(), firstIDAT + 8, idatLength);
+    } else {
+        SkDynamicMemoryWStream stream;
+        offset = firstIDAT;
+        for (size_t i = 0; i < idatCount; ++i) {
+            size_t chunkLength = read_bigendian_uint32(bytes + offset);
+            stream.write(bytes + offset + 8, chunkLength);
+            offset += kChunkOverhead + chunkLength;
+        }
+        *idat = stream.detachAsData();
+    }
+    *size = SkISize::Make(SkToS32(width), SkToS32(height));
+    *components = colorType == 2 ? 3 : 1;
+    return true;
+}
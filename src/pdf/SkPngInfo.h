@@ -0,0 +1,23 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#ifndef SkPngInfo_DEFINED
+#define SkPngInfo_DEFINED
+
+#include "SkData.h"
+#include "SkSize.h"
+
+/** Returns true if the data is a PNG whose compressed pixels a PDF can use as they are: opaque,
+    8 bits per component, gray or RGB, and not interlaced. Such an image's zlib stream decodes
+    with FlateDecode and the PNG predictors (/Predictor 15).
+
+    @param [out] size       Image size in pixels
+    @param [out] components 1 for gray, 3 for RGB.
+    @param [out] idat       The zlib stream, the concatenated contents of the IDAT chunks.
+*/
+bool SkGetPngInfo(const sk_sp<SkData>& data, SkISize* size, int* components, sk_sp<SkData>* idat);
+
+#endif  // SkPngInfo_DEFINED
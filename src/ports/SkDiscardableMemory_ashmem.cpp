@@ -0,0 +1,117 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkDiscardableMemory.h"
+#include "SkDiscardableMemoryPool.h"
+#include "SkTypes.h"
+
+#include <fcntl.h>
+#include <linux/ashmem.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if __ANDROID_API__ >= 26
+    #include <android/sharedmem.h>
+#endif
+
+// Discardable memory backed by ashmem regions.  Unlocking a region unpins it, which lets the
+// kernel reclaim its pages under memory pressure; lock() pins it again and reports whether the
+// pages were reclaimed in the meantime.  Unlike SkDiscardableMemoryPool, unlocked memory does not
+// count against a budget of our own, so caches built on this can be as large as the system lets
+// them be.
+//
+// Plain Linux has no equivalent: memfd with MADV_FREE lets the kernel drop pages, but gives no
+// reliable way to learn afterwards that it did, so other Linux builds keep using the pool.
+namespace {
+
+class SkAshmemDiscardableMemory : public SkDiscardableMemory {
+public:
+    static SkAshmemDiscardableMemory* Make(size_t bytes) {
+        int fd = create_region(bytes);
+        if (fd < 0) {
+            return nullptr;
+        }
+        void* addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (MAP_FAILED == addr) {
+            close(fd);
+            return nullptr;
+        }
+        // New regions start out pinned, i.e. locked.
+        return new SkAshmemDiscardableMemory(fd, addr, bytes);
+    }
+
+    ~SkAshmemDiscardableMemory() override {
+        SkASSERT(!fLocked);
+        munmap(fAddr, fBytes);
+        close(fFD);
+    }
+
+    bool lock() override {
+        SkASSERT(!fLocked);
+        struct ashmem_pin pin = {0, 0};  // A length of 0 covers the whole region.
+        int result = ioctl(fFD, ASHMEM_PIN, &pin);
+        if (result < 0) {
+            return false;
+        }
+        if (ASHMEM_WAS_PURGED == result) {
+            // The pages are pinned again, but their contents are gone.
+            ioctl(fFD, ASHMEM_UNPIN, &pin);
+            return false;
+        }
+        fLocked = true;
+        return true;
+    }
+
+    void* data() override {
+        SkASSERT(fLocked);
+        return fAddr;
+    }
+
+    void unlock() override {
+        SkASSERT(fLocked);
+        struct ashmem_pin pin = {0, 0};
+        ioctl(fFD, ASHMEM_UNPIN, &pin);
+        fLocked = false;
+    }
+
+private:
+    SkAshmemDiscardableMemory(int fd, void* addr, size_t bytes)
+            : fFD(fd), fAddr(addr), fBytes(bytes) {}
+
+    static int create_region(size_t bytes) {
+        static const char kName[] = "skia-discardable";
+#if __ANDROID_API__ >= 26
+        return ASharedMemory_create(kName, bytes);
+#else
+        int fd = open("/dev/ashmem", O_RDWR | O_CLOEXEC);
+        if (fd < 0) {
+            return -1;
+        }
+        if (ioctl(fd, ASHMEM_SET_NAME, kName) < 0 || ioctl(fd, ASHMEM_SET_SIZE, bytes) < 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+#endif
+    }
+
+    const int   fFD;
+    void* const fAddr;
+    const size_t fBytes;
+    bool        fLocked = true;
+};
+
+}  // namespace
+
+SkDiscardableMemory* SkDiscardableMemory::Create(size_t bytes) {
+    if (SkDiscardableMemory* dm = SkAshmemDiscardableMemory::Make(bytes)) {
+        return dm;
+    }
+    // ashmem may be unavailable, e.g. to sandboxed processes; use malloc'd memory instead.
+    return SkGetGlobalDiscardableMemoryPool()->create(bytes);
+}
@@ -42,14 +42,12 @@ public:
     }
 
     sk_sp<SkTypeface> onMakeClone(const SkFontArguments& args) const override {
-        std::unique_ptr<SkFontData> data = this->cloneFontData(args);
-        if (!data) {
-            return nullptr;
-        }
-        return sk_sp<SkTypeface>(new SkTypeface_FCI(std::move(data),
-                                                    fFamilyName,
-                                                    this->fontStyle(),
-                                                    this->isFixedPitch()));
+        return this->makeVariationInstance(args, [this](std::unique_ptr<SkFontData> data) {
+            return sk_sp<SkTypeface_FreeType>(new SkTypeface_FCI(std::move(data),
+                                                                 fFamilyName,
+                                                                 this->fontStyle(),
+                                                                 this->isFixedPitch()));
+        });
     }
 
 protected:
@@ -23,12 +23,14 @@
 #include "SkMatrix22.h"
 #include "SkMutex.h"
 #include "SkOTUtils.h"
+#include "SkOpts.h"
 #include "SkPath.h"
 #include "SkScalerContext.h"
 #include "SkStream.h"
 #include "SkString.h"
 #include "SkTemplates.h"
 #include "SkTo.h"
+#include "SkTypefaceCache.h"
 
 #include <memory>
 
@@ -234,10 +236,12 @@ private:
 };
 
 struct SkFaceRec;
+struct SkSharedFace;
 
 SK_DECLARE_STATIC_MUTEX(gFTMutex);
 static FreeTypeLibrary* gFTLibrary;
 static SkFaceRec* gFaceRecHead;
+static SkSharedFace* gSharedFaceHead;
 
 // Private to ref_ft_library and unref_ft_library
 static int gFTCount;
@@ -263,6 +267,7 @@ static void unref_ft_library() {
     --gFTCount;
     if (0 == gFTCount) {
         SkASSERT(nullptr == gFaceRecHead);
+        SkASSERT(nullptr == gSharedFaceHead);
         SkASSERT(nullptr != gFTLibrary);
         delete gFTLibrary;
         SkDEBUGCODE(gFTLibrary = nullptr;)
@@ -271,12 +276,36 @@ static void unref_ft_library() {
 
 ///////////////////////////////////////////////////////////////////////////
 
-struct SkFaceRec {
-    SkFaceRec* fNext;
+// A FreeType face opened from a font's data. It is shared by the SkFaceRecs of the typeface it
+// was opened for and of every variation instance cloned from it.
+struct SkSharedFace {
+    SkSharedFace* fNext;
     std::unique_ptr<FT_FaceRec, SkFunctionWrapper<FT_Error, FT_FaceRec, FT_Done_Face>> fFace;
     FT_StreamRec fFTStream;
     std::unique_ptr<SkStreamAsset> fSkStream;
     uint32_t fRefCnt;
+    SkFontID fSharedFaceID;
+    int fIndex;
+
+    // The design coordinates of the face before any were set, used by instances which don't
+    // specify any. If these can't be read the face isn't shared.
+    SkAutoSTMalloc<4, FT_Fixed> fDefaultCoords;
+    int fDefaultCoordCount;
+    bool fShareable;
+
+    // The instance whose design coordinates are currently set on fFace, and whether those are
+    // the defaults.
+    const SkFaceRec* fActiveInstance;
+    bool fHasDefaultCoords;
+
+    SkSharedFace(std::unique_ptr<SkStreamAsset> stream, SkFontID sharedFaceID, int index);
+};
+
+struct SkFaceRec {
+    SkFaceRec* fNext;
+    SkSharedFace* fSharedFace;
+    FT_Face fFace;  // Borrowed from fSharedFace.
+    uint32_t fRefCnt;
     uint32_t fFontID;
 
     // FreeType prior to 2.7.1 does not implement retreiving variation design metrics.
@@ -289,7 +318,7 @@ struct SkFaceRec {
     // Manually keep track of when a named variation is requested for 2.6.1 until 2.7.1.
     bool fNamedVariationSpecified;
 
-    SkFaceRec(std::unique_ptr<SkStreamAsset> stream, uint32_t fontID);
+    SkFaceRec(SkSharedFace* sharedFace, uint32_t fontID);
 };
 
 extern "C" {
@@ -312,9 +341,11 @@ extern "C" {
     static void sk_ft_stream_close(FT_Stream) {}
 }
 
-SkFaceRec::SkFaceRec(std::unique_ptr<SkStreamAsset> stream, uint32_t fontID)
-        : fNext(nullptr), fSkStream(std::move(stream)), fRefCnt(1), fFontID(fontID)
-        , fAxesCount(0), fNamedVariationSpecified(false)
+SkSharedFace::SkSharedFace(std::unique_ptr<SkStreamAsset> stream, SkFontID sharedFaceID,
+                           int index)
+        : fNext(nullptr), fSkStream(std::move(stream)), fRefCnt(1), fSharedFaceID(sharedFaceID)
+        , fIndex(index), fDefaultCoordCount(0), fShareable(false), fActiveInstance(nullptr)
+        , fHasDefaultCoords(true)
 {
     sk_bzero(&fFTStream, sizeof(fFTStream));
     fFTStream.size = fSkStream->getLength();
@@ -323,6 +354,55 @@ SkFaceRec::SkFaceRec(std::unique_ptr<SkStreamAsset> stream, uint32_t fontID)
     fFTStream.close = sk_ft_stream_close;
 }
 
+SkFaceRec::SkFaceRec(SkSharedFace* sharedFace, uint32_t fontID)
+        : fNext(nullptr), fSharedFace(sharedFace), fFace(sharedFace->fFace.get())
+        , fRefCnt(1), fFontID(fontID), fAxesCount(0), fNamedVariationSpecified(false)
+{}
+
+// Record the default design coordinates, so instances can go back to them after another
+// instance has set its own.
+static void ft_face_setup_sharing(SkSharedFace* shared) {
+    FT_Face face = shared->fFace.get();
+    if (!(face->face_flags & FT_FACE_FLAG_MULTIPLE_MASTERS)) {
+        shared->fShareable = true;
+        return;
+    }
+
+    FT_MM_Var* variations = nullptr;
+    if (FT_Get_MM_Var(face, &variations)) {
+        return;
+    }
+    SkAutoFree autoFreeVariations(variations);
+
+    shared->fDefaultCoordCount = variations->num_axis;
+    shared->fDefaultCoords.reset(shared->fDefaultCoordCount);
+    shared->fShareable = !FT_Get_Var_Design_Coordinates(face, shared->fDefaultCoordCount,
+                                                        shared->fDefaultCoords.get());
+}
+
+// Sets the design coordinates of 'rec' on its face, if another instance was using it.
+// Caller must lock gFTMutex before calling this function.
+static void ft_face_activate(SkFaceRec* rec) {
+    gFTMutex.assertHeld();
+    SkSharedFace* shared = rec->fSharedFace;
+    if (shared->fActiveInstance == rec) {
+        return;
+    }
+    if (rec->fAxesCount) {
+        SkAutoSTMalloc<4, FT_Fixed> coords(rec->fAxesCount);
+        for (int i = 0; i < rec->fAxesCount; ++i) {
+            coords[i] = rec->fAxes[i];
+        }
+        FT_Set_Var_Design_Coordinates(rec->fFace, rec->fAxesCount, coords.get());
+        shared->fHasDefaultCoords = false;
+    } else if (!shared->fHasDefaultCoords) {
+        FT_Set_Var_Design_Coordinates(rec->fFace, shared->fDefaultCoordCount,
+                                      shared->fDefaultCoords.get());
+        shared->fHasDefaultCoords = true;
+    }
+    shared->fActiveInstance = rec;
+}
+
 static void ft_face_setup_axes(SkFaceRec* rec, const SkFontData& data) {
     if (!(rec->fFace->face_flags & FT_FACE_FLAG_MULTIPLE_MASTERS)) {
         return;
@@ -336,7 +416,7 @@ static void ft_face_setup_axes(SkFaceRec* rec, const SkFontData& data) {
 
     SkDEBUGCODE(
         FT_MM_Var* variations = nullptr;
-        if (FT_Get_MM_Var(rec->fFace.get(), &variations)) {
+        if (FT_Get_MM_Var(rec->fFace, &variations)) {
             SkDEBUGF("INFO: font %s claims variations, but none found.\n",
                      rec->fFace->family_name);
             return;
@@ -354,11 +434,13 @@ static void ft_face_setup_axes(SkFaceRec* rec, const SkFontData& data) {
     for (int i = 0; i < data.getAxisCount(); ++i) {
         coords[i] = data.getAxis()[i];
     }
-    if (FT_Set_Var_Design_Coordinates(rec->fFace.get(), data.getAxisCount(), coords.get())) {
+    if (FT_Set_Var_Design_Coordinates(rec->fFace, data.getAxisCount(), coords.get())) {
         SkDEBUGF("INFO: font %s has variations, but specified variations could not be set.\n",
                  rec->fFace->family_name);
         return;
     }
+    rec->fSharedFace->fActiveInstance = rec;
+    rec->fSharedFace->fHasDefaultCoords = false;
 
     rec->fAxesCount = data.getAxisCount();
     rec->fAxes.reset(rec->fAxesCount);
@@ -369,51 +451,49 @@ static void ft_face_setup_axes(SkFaceRec* rec, const SkFontData& data) {
 
 // Will return nullptr on failure
 // Caller must lock gFTMutex before calling this function.
-static SkFaceRec* ref_ft_face(const SkTypeface* typeface) {
+static SkSharedFace* ref_shared_face(const SkTypeface_FreeType* typeface, SkFontData* data) {
     gFTMutex.assertHeld();
 
-    const SkFontID fontID = typeface->uniqueID();
-    SkFaceRec* cachedRec = gFaceRecHead;
-    while (cachedRec) {
-        if (cachedRec->fFontID == fontID) {
-            SkASSERT(cachedRec->fFace);
-            cachedRec->fRefCnt += 1;
-            return cachedRec;
+    const SkFontID sharedFaceID = typeface->sharedFaceID();
+    for (SkSharedFace* shared = gSharedFaceHead; shared; shared = shared->fNext) {
+        if (shared->fSharedFaceID == sharedFaceID && shared->fShareable &&
+            shared->fIndex == data->getIndex())
+        {
+            shared->fRefCnt += 1;
+            return shared;
         }
-        cachedRec = cachedRec->fNext;
-    }
-
-    std::unique_ptr<SkFontData> data = typeface->makeFontData();
-    if (nullptr == data || !data->hasStream()) {
-        return nullptr;
     }
 
-    std::unique_ptr<SkFaceRec> rec(new SkFaceRec(data->detachStream(), fontID));
+    std::unique_ptr<SkSharedFace> shared(
+            new SkSharedFace(data->detachStream(), sharedFaceID, data->getIndex()));
 
     FT_Open_Args args;
     memset(&args, 0, sizeof(args));
-    const void* memoryBase = rec->fSkStream->getMemoryBase();
+    const void* memoryBase = shared->fSkStream->getMemoryBase();
     if (memoryBase) {
         args.flags = FT_OPEN_MEMORY;
         args.memory_base = (const FT_Byte*)memoryBase;
-        args.memory_size = rec->fSkStream->getLength();
+        args.memory_size = shared->fSkStream->getLength();
     } else {
         args.flags = FT_OPEN_STREAM;
-        args.stream = &rec->fFTStream;
+        args.stream = &shared->fFTStream;
     }
 
     {
         FT_Face rawFace;
         FT_Error err = FT_Open_Face(gFTLibrary->library(), &args, data->getIndex(), &rawFace);
         if (err) {
-            SK_TRACEFTR(err, "unable to open font '%x'", fontID);
+            SK_TRACEFTR(err, "unable to open font '%x'", typeface->uniqueID());
             return nullptr;
         }
-        rec->fFace.reset(rawFace);
+        shared->fFace.reset(rawFace);
     }
-    SkASSERT(rec->fFace);
+    SkASSERT(shared->fFace);
 
-    ft_face_setup_axes(rec.get(), *data);
+    // Named variations are selected when the face is opened, so those faces aren't shared.
+    if (data->getIndex() <= 0xFFFF) {
+        ft_face_setup_sharing(shared.get());
+    }
 
     // FreeType will set the charmap to the "most unicode" cmap if it exists.
     // If there are no unicode cmaps, the charmap is set to nullptr.
@@ -421,10 +501,74 @@ static SkFaceRec* ref_ft_face(const SkTypeface* typeface) {
     // because they are effectively private use area only (even if they aren't).
     // This is the last on the fallback list at
     // https://developer.apple.com/fonts/TrueType-Reference-Manual/RM06/Chap6cmap.html
-    if (!rec->fFace->charmap) {
-        FT_Select_Charmap(rec->fFace.get(), FT_ENCODING_MS_SYMBOL);
+    if (!shared->fFace->charmap) {
+        FT_Select_Charmap(shared->fFace.get(), FT_ENCODING_MS_SYMBOL);
+    }
+
+    shared->fNext = gSharedFaceHead;
+    gSharedFaceHead = shared.get();
+    return shared.release();
+}
+
+// Caller must lock gFTMutex before calling this function.
+static void unref_shared_face(SkSharedFace* sharedFace) {
+    gFTMutex.assertHeld();
+
+    SkSharedFace* shared = gSharedFaceHead;
+    SkSharedFace* prev = nullptr;
+    while (shared) {
+        SkSharedFace* next = shared->fNext;
+        if (shared == sharedFace) {
+            if (--shared->fRefCnt == 0) {
+                if (prev) {
+                    prev->fNext = next;
+                } else {
+                    gSharedFaceHead = next;
+                }
+                delete shared;
+            }
+            return;
+        }
+        prev = shared;
+        shared = next;
+    }
+    SkDEBUGFAIL("shouldn't get here, shared face not in list");
+}
+
+// Will return nullptr on failure
+// Caller must lock gFTMutex before calling this function.
+// The face is left with the typeface's design coordinates set.
+static SkFaceRec* ref_ft_face(const SkTypeface* typeface) {
+    gFTMutex.assertHeld();
+
+    const SkFontID fontID = typeface->uniqueID();
+    SkFaceRec* cachedRec = gFaceRecHead;
+    while (cachedRec) {
+        if (cachedRec->fFontID == fontID) {
+            SkASSERT(cachedRec->fFace);
+            cachedRec->fRefCnt += 1;
+            ft_face_activate(cachedRec);
+            return cachedRec;
+        }
+        cachedRec = cachedRec->fNext;
+    }
+
+    std::unique_ptr<SkFontData> data = typeface->makeFontData();
+    if (nullptr == data || !data->hasStream()) {
+        return nullptr;
     }
 
+    // Only SkTypeface_FreeType makes scaler contexts and AutoFTAccesses that get here.
+    SkSharedFace* shared = ref_shared_face(static_cast<const SkTypeface_FreeType*>(typeface),
+                                           data.get());
+    if (!shared) {
+        return nullptr;
+    }
+    std::unique_ptr<SkFaceRec> rec(new SkFaceRec(shared, fontID));
+
+    ft_face_setup_axes(rec.get(), *data);
+    ft_face_activate(rec.get());
+
     rec->fNext = gFaceRecHead;
     gFaceRecHead = rec.get();
     return rec.release();
@@ -439,14 +583,19 @@ extern /*static*/ void unref_ft_face(SkFaceRec* faceRec) {
     SkFaceRec*  prev = nullptr;
     while (rec) {
         SkFaceRec* next = rec->fNext;
-        if (rec->fFace == faceRec->fFace) {
+        if (rec == faceRec) {
             if (--rec->fRefCnt == 0) {
                 if (prev) {
                     prev->fNext = next;
                 } else {
                     gFaceRecHead = next;
                 }
+                SkSharedFace* shared = rec->fSharedFace;
+                if (shared->fActiveInstance == rec) {
+                    shared->fActiveInstance = nullptr;
+                }
                 delete rec;
+                unref_shared_face(shared);
             }
             return;
         }
@@ -472,7 +621,7 @@ public:
         gFTMutex.release();
     }
 
-    FT_Face face() { return fFaceRec ? fFaceRec->fFace.get() : nullptr; }
+    FT_Face face() { return fFaceRec ? fFaceRec->fFace : nullptr; }
     int getAxesCount() { return fFaceRec ? fFaceRec->fAxesCount : 0; }
     SkFixed* getAxes() { return fFaceRec ? fFaceRec->fAxes.get() : nullptr; }
     bool isNamedVariationSpecified() {
@@ -504,6 +653,8 @@ protected:
     void generateImage(const SkGlyph& glyph) override;
     bool generatePath(SkGlyphID glyphID, SkPath* path) override;
     void generateFontMetrics(SkFontMetrics*) override;
+    void beginGlyphBatch() override;
+    void endGlyphBatch() override;
 
 private:
     using UnrefFTFace = SkFunctionWrapper<void, SkFaceRec, unref_ft_face>;
@@ -527,7 +678,14 @@ private:
     bool      fDoLinearMetrics;
     bool      fLCDIsVert;
 
+    // While in a glyph batch this context holds gFTMutex, and fFace is already set up for it.
+    bool      fInGlyphBatch = false;
+    FT_Error  fGlyphBatchError = 0;
+
     FT_Error setupSize();
+    // The mutex and setupSize() for one glyph call, unless a glyph batch already covers them.
+    SkBaseMutex* glyphMutex() { return fInGlyphBatch ? nullptr : &gFTMutex; }
+    FT_Error setupSizeForGlyph() { return fInGlyphBatch ? fGlyphBatchError : this->setupSize(); }
     void getBBoxForCurrentGlyph(const SkGlyph* glyph, FT_BBox* bbox,
                                 bool snapToPixelBoundary = false);
     bool getCBoxForLetter(char letter, FT_BBox* bbox);
@@ -684,23 +842,80 @@ SkScalerContext* SkTypeface_FreeType::onCreateScalerContext(const SkScalerContex
     return c.release();
 }
 
-std::unique_ptr<SkFontData> SkTypeface_FreeType::cloneFontData(
-                                                            const SkFontArguments& args) const {
+// Requests for variation instances within this fraction of a design unit of a live instance get
+// that instance, so that animating an axis doesn't make a new typeface and strikes every frame.
+static constexpr SkFixed kInstanceAxisQuantum = SK_Fixed1 / 64;
+
+static bool compute_instance_axes(const SkTypeface_FreeType* typeface,
+                                  const SkFontArguments& args,
+                                  SkSTArray<4, SkFixed, true>* axes) {
     SkString name;
-    AutoFTAccess fta(this);
+    AutoFTAccess fta(typeface);
     FT_Face face = fta.face();
-    Scanner::AxisDefinitions axisDefinitions;
+    SkTypeface_FreeType::Scanner::AxisDefinitions axisDefinitions;
+
+    if (!SkTypeface_FreeType::Scanner::GetAxes(face, &axisDefinitions)) {
+        return false;
+    }
+    axes->reset(axisDefinitions.count());
+    SkTypeface_FreeType::Scanner::computeAxisValues(axisDefinitions,
+                                                    args.getVariationDesignPosition(),
+                                                    axes->begin(), name);
+    return true;
+}
 
-    if (!Scanner::GetAxes(face, &axisDefinitions)) {
+// Recently made variation instances, so equal ones can be shared. Like the global typeface
+// cache, unreferenced instances are only purged once it fills up. Only holds SkTypeface_FreeTypes.
+SK_DECLARE_STATIC_MUTEX(gInstanceCacheMutex);
+static SkTypefaceCache* instance_cache() {
+    static SkTypefaceCache* gInstanceCache = new SkTypefaceCache;
+    return gInstanceCache;
+}
+
+namespace {
+struct InstanceKey {
+    SkFontID fSharedFaceID;
+    const SkSTArray<4, SkFixed, true>& fQuantizedAxes;
+};
+}  // namespace
+
+sk_sp<SkTypeface> SkTypeface_FreeType::makeVariationInstance(
+        const SkFontArguments& args, const MakeInstanceProc& makeInstance) const {
+    SkSTArray<4, SkFixed, true> axisValues;
+    if (!compute_instance_axes(this, args, &axisValues)) {
         return nullptr;
     }
-    SkAutoSTMalloc<4, SkFixed> axisValues(axisDefinitions.count());
-    Scanner::computeAxisValues(axisDefinitions, args.getVariationDesignPosition(),
-                               axisValues, name);
+
+    SkSTArray<4, SkFixed, true> quantizedAxes(axisValues);
+    for (SkFixed& value : quantizedAxes) {
+        value = (value + kInstanceAxisQuantum / 2) & ~(kInstanceAxisQuantum - 1);
+    }
+
+    InstanceKey key{this->sharedFaceID(), quantizedAxes};
+    auto matches = [](SkTypeface* cached, void* ctx) {
+        const InstanceKey& key = *static_cast<const InstanceKey*>(ctx);
+        auto* instance = static_cast<SkTypeface_FreeType*>(cached);
+        return instance->sharedFaceID() == key.fSharedFaceID &&
+               instance->fInstanceAxes == key.fQuantizedAxes;
+    };
+    uint32_t hash = SkOpts::hash(quantizedAxes.begin(), quantizedAxes.count() * sizeof(SkFixed),
+                                 this->sharedFaceID());
+    SkAutoMutexAcquire lock(gInstanceCacheMutex);
+    if (sk_sp<SkTypeface> instance = instance_cache()->findByHashAndRef(hash, matches, &key)) {
+        return instance;
+    }
+
     int ttcIndex;
     std::unique_ptr<SkStreamAsset> stream = this->openStream(&ttcIndex);
-    return skstd::make_unique<SkFontData>(std::move(stream), ttcIndex, axisValues.get(),
-                                          axisDefinitions.count());
+    sk_sp<SkTypeface_FreeType> instance = makeInstance(skstd::make_unique<SkFontData>(
+            std::move(stream), ttcIndex, axisValues.begin(), axisValues.count()));
+    if (!instance) {
+        return nullptr;
+    }
+    instance->fSharedFaceID = this->sharedFaceID();
+    instance->fInstanceAxes = quantizedAxes;
+    instance_cache()->add(instance, hash);
+    return std::move(instance);
 }
 
 void SkTypeface_FreeType::onFilterRec(SkScalerContextRec* rec) const {
@@ -909,7 +1124,7 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface> typeface,
     using DoneFTSize = SkFunctionWrapper<FT_Error, skstd::remove_pointer_t<FT_Size>, FT_Done_Size>;
     std::unique_ptr<skstd::remove_pointer_t<FT_Size>, DoneFTSize> ftSize([this]() -> FT_Size {
         FT_Size size;
-        FT_Error err = FT_New_Size(fFaceRec->fFace.get(), &size);
+        FT_Error err = FT_New_Size(fFaceRec->fFace, &size);
         if (err != 0) {
             SK_TRACEFTR(err, "FT_New_Size(%s) failed.", fFaceRec->fFace->family_name);
             return nullptr;
@@ -932,7 +1147,7 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface> typeface,
     FT_F26Dot6 scaleY = SkScalarToFDot6(fScale.fY);
 
     if (FT_IS_SCALABLE(fFaceRec->fFace)) {
-        err = FT_Set_Char_Size(fFaceRec->fFace.get(), scaleX, scaleY, 72, 72);
+        err = FT_Set_Char_Size(fFaceRec->fFace, scaleX, scaleY, 72, 72);
         if (err != 0) {
             SK_TRACEFTR(err, "FT_Set_CharSize(%s, %f, %f) failed.",
                         fFaceRec->fFace->family_name, fScale.fX, fScale.fY);
@@ -951,14 +1166,14 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface> typeface,
         }
 
     } else if (FT_HAS_FIXED_SIZES(fFaceRec->fFace)) {
-        fStrikeIndex = chooseBitmapStrike(fFaceRec->fFace.get(), scaleY);
+        fStrikeIndex = chooseBitmapStrike(fFaceRec->fFace, scaleY);
         if (fStrikeIndex == -1) {
             SkDEBUGF("No glyphs for font \"%s\" size %f.\n",
                      fFaceRec->fFace->family_name, fScale.fY);
             return;
         }
 
-        err = FT_Select_Size(fFaceRec->fFace.get(), fStrikeIndex);
+        err = FT_Select_Size(fFaceRec->fFace, fStrikeIndex);
         if (err != 0) {
             SK_TRACEFTR(err, "FT_Select_Size(%s, %d) failed.",
                         fFaceRec->fFace->family_name, fStrikeIndex);
@@ -992,11 +1207,11 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(sk_sp<SkTypeface> typeface,
     fMatrix22.yy = SkScalarToFixed(fMatrix22Scalar.getScaleY());
 
 #ifdef FT_COLOR_H
-    FT_Palette_Select(fFaceRec->fFace.get(), 0, nullptr);
+    FT_Palette_Select(fFaceRec->fFace, 0, nullptr);
 #endif
 
     fFTSize = ftSize.release();
-    fFace = fFaceRec->fFace.get();
+    fFace = fFaceRec->fFace;
     fDoLinearMetrics = linearMetrics;
 }
 
@@ -1021,10 +1236,25 @@ FT_Error SkScalerContext_FreeType::setupSize() {
     if (err != 0) {
         return err;
     }
+    // Another variation instance sharing the face may have changed its design coordinates.
+    ft_face_activate(fFaceRec.get());
     FT_Set_Transform(fFace, &fMatrix22, nullptr);
     return 0;
 }
 
+void SkScalerContext_FreeType::beginGlyphBatch() {
+    SkASSERT(!fInGlyphBatch);
+    gFTMutex.acquire();
+    fGlyphBatchError = this->setupSize();
+    fInGlyphBatch = true;
+}
+
+void SkScalerContext_FreeType::endGlyphBatch() {
+    SkASSERT(fInGlyphBatch);
+    fInGlyphBatch = false;
+    gFTMutex.release();
+}
+
 unsigned SkScalerContext_FreeType::generateGlyphCount() {
     return fFace->num_glyphs;
 }
@@ -1042,9 +1272,9 @@ bool SkScalerContext_FreeType::generateAdvance(SkGlyph* glyph) {
         return false;
     }
 
-    SkAutoMutexAcquire  ac(gFTMutex);
+    SkAutoMutexAcquire  ac(this->glyphMutex());
 
-    if (this->setupSize()) {
+    if (this->setupSizeForGlyph()) {
         glyph->zeroMetrics();
         return true;
     }
@@ -1147,11 +1377,11 @@ bool SkScalerContext_FreeType::shouldSubpixelBitmap(const SkGlyph& glyph, const
 }
 
 void SkScalerContext_FreeType::generateMetrics(SkGlyph* glyph) {
-    SkAutoMutexAcquire  ac(gFTMutex);
+    SkAutoMutexAcquire  ac(this->glyphMutex());
 
     glyph->fMaskFormat = fRec.fMaskFormat;
 
-    if (this->setupSize()) {
+    if (this->setupSizeForGlyph()) {
         glyph->zeroMetrics();
         return;
     }
@@ -1303,9 +1533,9 @@ static void clear_glyph_image(const SkGlyph& glyph) {
 }
 
 void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
-    SkAutoMutexAcquire  ac(gFTMutex);
+    SkAutoMutexAcquire  ac(this->glyphMutex());
 
-    if (this->setupSize()) {
+    if (this->setupSizeForGlyph()) {
         clear_glyph_image(glyph);
         return;
     }
@@ -1336,10 +1566,10 @@ void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
 bool SkScalerContext_FreeType::generatePath(SkGlyphID glyphID, SkPath* path) {
     SkASSERT(path);
 
-    SkAutoMutexAcquire  ac(gFTMutex);
+    SkAutoMutexAcquire  ac(this->glyphMutex());
 
     // FT_IS_SCALABLE is documented to mean the face contains outline glyphs.
-    if (!FT_IS_SCALABLE(fFace) || this->setupSize()) {
+    if (!FT_IS_SCALABLE(fFace) || this->setupSizeForGlyph()) {
         path->reset();
         return false;
     }
@@ -1923,6 +2153,35 @@ bool SkTypeface_FreeType::Scanner::scanFont(
     return success;
 }
 
+bool SkTypeface_FreeType::Scanner::scanCoverage(SkStreamAsset* stream, int ttcIndex,
+                                                SkTDArray<SkUnichar>* ranges) const
+{
+    SkAutoMutexAcquire libraryLock(fLibraryMutex);
+
+    FT_StreamRec streamRec;
+    FT_Face face = this->openFace(stream, ttcIndex, &streamRec);
+    if (nullptr == face) {
+        return false;
+    }
+
+    FT_UInt glyphIndex;
+    FT_ULong charCode = FT_Get_First_Char(face, &glyphIndex);
+    while (glyphIndex) {
+        SkUnichar uni = SkToS32(charCode);
+        int count = ranges->count();
+        if (count && (*ranges)[count - 1] + 1 == uni) {
+            (*ranges)[count - 1] = uni;
+        } else {
+            *ranges->append() = uni;
+            *ranges->append() = uni;
+        }
+        charCode = FT_Get_Next_Char(face, charCode, &glyphIndex);
+    }
+
+    FT_Done_Face(face);
+    return true;
+}
+
 bool SkTypeface_FreeType::Scanner::GetAxes(FT_Face face, AxisDefinitions* axes) {
     if (axes && face->face_flags & FT_FACE_FLAG_MULTIPLE_MASTERS) {
         FT_MM_Var* variations = nullptr;
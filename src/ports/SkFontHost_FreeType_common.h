@@ -12,11 +12,15 @@
 #include "SkGlyph.h"
 #include "SkMutex.h"
 #include "SkScalerContext.h"
+#include "SkTArray.h"
+#include "SkTDArray.h"
 #include "SkTypeface.h"
 #include "SkTypes.h"
 
 #include "SkFontMgr.h"
 
+#include <functional>
+
 // These are forward declared to avoid pimpl but also hide the FreeType implementation.
 typedef struct FT_LibraryRec_* FT_Library;
 typedef struct FT_FaceRec_* FT_Face;
@@ -72,6 +76,11 @@ public:
         bool scanFont(SkStreamAsset* stream, int ttcIndex,
                       SkString* name, SkFontStyle* style, bool* isFixedPitch,
                       AxisDefinitions* axes) const;
+        /** Appends the Unicode code points the face maps to glyphs to 'ranges', as sorted
+         *  pairs of inclusive first and last code points.
+         */
+        bool scanCoverage(SkStreamAsset* stream, int ttcIndex,
+                          SkTDArray<SkUnichar>* ranges) const;
         static void computeAxisValues(
             AxisDefinitions axisDefinitions,
             const SkFontArguments::VariationPosition position,
@@ -87,12 +96,26 @@ public:
 
     /** Fetch units/EM from "head" table if needed (ie for bitmap fonts) */
     static int GetUnitsPerEm(FT_Face face);
+
+    /** The id of the typeface whose FreeType face this one shares. Variation instances share
+     *  the face of the typeface they were first cloned from, and set their own design
+     *  coordinates on it while they use it.
+     */
+    SkFontID sharedFaceID() const { return fSharedFaceID ? fSharedFaceID : this->uniqueID(); }
+
 protected:
     SkTypeface_FreeType(const SkFontStyle& style, bool isFixedPitch)
         : INHERITED(style, isFixedPitch)
     {}
 
-    std::unique_ptr<SkFontData> cloneFontData(const SkFontArguments&) const;
+    using MakeInstanceProc = std::function<sk_sp<SkTypeface_FreeType>(std::unique_ptr<SkFontData>)>;
+    /** Returns the variation instance of this typeface for 'args', for onMakeClone() overrides.
+     *  A live instance at nearly the same design position is reused, so animating an axis
+     *  doesn't make a new typeface, face and set of strikes for every frame. 'makeInstance'
+     *  makes a typeface from the instance's font data when no live instance matches.
+     */
+    sk_sp<SkTypeface> makeVariationInstance(const SkFontArguments& args,
+                                            const MakeInstanceProc& makeInstance) const;
     virtual SkScalerContext* onCreateScalerContext(const SkScalerContextEffects&,
                                                    const SkDescriptor*) const override;
     void onFilterRec(SkScalerContextRec*) const override;
@@ -117,6 +140,10 @@ protected:
                           size_t length, void* data) const override;
 
 private:
+    SkFontID fSharedFaceID = 0;
+    // The quantized design position makeVariationInstance() made this for.
+    SkSTArray<4, SkFixed, true> fInstanceAxes;
+
     typedef SkTypeface INHERITED;
 };
 
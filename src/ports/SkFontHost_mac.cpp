@@ -766,8 +766,10 @@ static sk_sp<SkTypeface> create_from_CTFontRef(SkUniqueCFRef<CTFontRef> font,
                                                bool isLocalStream) {
     SkASSERT(font);
 
+    // CFEqual fonts have equal CFHashes, so only typefaces with this hash need comparing.
+    uint32_t hash = (uint32_t)CFHash(font.get());
     if (!isLocalStream) {
-        sk_sp<SkTypeface> face = SkTypefaceCache::FindByProcAndRef(find_by_CTFontRef,
+        sk_sp<SkTypeface> face = SkTypefaceCache::FindByHashAndRef(hash, find_by_CTFontRef,
                                                                    (void*)font.get());
         if (face) {
             return face;
@@ -782,7 +784,7 @@ static sk_sp<SkTypeface> create_from_CTFontRef(SkUniqueCFRef<CTFontRef> font,
     sk_sp<SkTypeface> face(new SkTypeface_Mac(std::move(font), std::move(resource),
                                               style, isFixedPitch, isLocalStream));
     if (!isLocalStream) {
-        SkTypefaceCache::Add(face);
+        SkTypefaceCache::Add(face, hash);
     }
     return face;
 }
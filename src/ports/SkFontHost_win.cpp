@@ -26,6 +26,7 @@
 #include "SkOTTable_name.h"
 #include "SkOTUtils.h"
 #include "SkOnce.h"
+#include "SkOpts.h"
 #include "SkPath.h"
 #include "SkSFNTHeader.h"
 #include "SkStream.h"
@@ -336,10 +337,11 @@ static bool FindByLogFont(SkTypeface* face, void* ctx) {
 SkTypeface* SkCreateTypefaceFromLOGFONT(const LOGFONT& origLF) {
     LOGFONT lf = origLF;
     make_canonical(&lf);
-    sk_sp<SkTypeface> face = SkTypefaceCache::FindByProcAndRef(FindByLogFont, &lf);
+    uint32_t hash = SkOpts::hash(&lf, sizeof(lf));
+    sk_sp<SkTypeface> face = SkTypefaceCache::FindByHashAndRef(hash, FindByLogFont, &lf);
     if (!face) {
         face = LogFontTypeface::Make(lf);
-        SkTypefaceCache::Add(face);
+        SkTypefaceCache::Add(face, hash);
     }
     return face.release();
 }
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "SkChecksum.h"
 #include "SkFontConfigInterface.h"
 #include "SkFontConfigTypeface.h"
 #include "SkFontDescriptor.h"
@@ -13,6 +14,7 @@
 #include "SkFontStyle.h"
 #include "SkMakeUnique.h"
 #include "SkMutex.h"
+#include "SkOpts.h"
 #include "SkString.h"
 #include "SkTypeface.h"
 #include "SkTypefaceCache.h"
@@ -150,6 +152,11 @@ static bool find_by_FontIdentity(SkTypeface* cachedTypeface, void* ctx) {
     return cachedFCTypeface->getIdentity() == *identity;
 }
 
+static uint32_t hash_FontIdentity(const SkFontConfigInterface::FontIdentity& identity) {
+    uint32_t hash = SkOpts::hash(identity.fString.c_str(), identity.fString.size());
+    return SkChecksum::Mix(hash ^ identity.fID ^ ((uint32_t)identity.fTTCIndex << 16));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 class SkFontMgr_FCI : public SkFontMgr {
@@ -205,11 +212,13 @@ protected:
         }
 
         // Check if a typeface with this FontIdentity is already in the FontIdentity cache.
-        sk_sp<SkTypeface> face = fTFCache.findByProcAndRef(find_by_FontIdentity, &identity);
+        uint32_t identityHash = hash_FontIdentity(identity);
+        sk_sp<SkTypeface> face = fTFCache.findByHashAndRef(identityHash, find_by_FontIdentity,
+                                                           &identity);
         if (!face) {
             face.reset(SkTypeface_FCI::Create(fFCI, identity, std::move(outFamilyName), outStyle));
             // Add this FontIdentity to the FontIdentity cache.
-            fTFCache.add(face);
+            fTFCache.add(face, identityHash);
         }
         return face.release();
     }
@@ -314,11 +323,12 @@ protected:
         }
 
         // Check if a typeface with this FontIdentity is already in the FontIdentity cache.
-        face = fTFCache.findByProcAndRef(find_by_FontIdentity, &identity);
+        uint32_t identityHash = hash_FontIdentity(identity);
+        face = fTFCache.findByHashAndRef(identityHash, find_by_FontIdentity, &identity);
         if (!face) {
             face.reset(SkTypeface_FCI::Create(fFCI, identity, std::move(outFamilyName), outStyle));
             // Add this FontIdentity to the FontIdentity cache.
-            fTFCache.add(face);
+            fTFCache.add(face, identityHash);
         }
         // Add this request to the request cache.
         fCache.add(face, request.release());
@@ -23,6 +23,7 @@
 #include "SkStream.h"
 #include "SkTArray.h"
 #include "SkTDArray.h"
+#include "SkTHash.h"
 #include "SkTSearch.h"
 #include "SkTemplates.h"
 #include "SkTypefaceCache.h"
@@ -99,20 +100,18 @@ public:
                                               fAxes.begin(), fAxes.count());
     }
     sk_sp<SkTypeface> onMakeClone(const SkFontArguments& args) const override {
-        std::unique_ptr<SkFontData> data = this->cloneFontData(args);
-        if (!data) {
-            return nullptr;
-        }
-        return sk_make_sp<SkTypeface_AndroidSystem>(fPathName,
-                                                    fFile,
-                                                    fIndex,
-                                                    data->getAxis(),
-                                                    data->getAxisCount(),
-                                                    this->fontStyle(),
-                                                    this->isFixedPitch(),
-                                                    fFamilyName,
-                                                    fLang,
-                                                    fVariantStyle);
+        return this->makeVariationInstance(args, [this](std::unique_ptr<SkFontData> data) {
+            return sk_make_sp<SkTypeface_AndroidSystem>(fPathName,
+                                                        fFile,
+                                                        fIndex,
+                                                        data->getAxis(),
+                                                        data->getAxisCount(),
+                                                        this->fontStyle(),
+                                                        this->isFixedPitch(),
+                                                        fFamilyName,
+                                                        fLang,
+                                                        fVariantStyle);
+        });
     }
 
     const SkString fPathName;
@@ -153,14 +152,12 @@ public:
     }
 
     sk_sp<SkTypeface> onMakeClone(const SkFontArguments& args) const override {
-        std::unique_ptr<SkFontData> data = this->cloneFontData(args);
-        if (!data) {
-            return nullptr;
-        }
-        return sk_make_sp<SkTypeface_AndroidStream>(std::move(data),
-                                                    this->fontStyle(),
-                                                    this->isFixedPitch(),
-                                                    fFamilyName);
+        return this->makeVariationInstance(args, [this](std::unique_ptr<SkFontData> data) {
+            return sk_make_sp<SkTypeface_AndroidStream>(std::move(data),
+                                                        this->fontStyle(),
+                                                        this->isFixedPitch(),
+                                                        fFamilyName);
+        });
     }
 
 private:
@@ -340,16 +337,13 @@ protected:
             return nullptr;
         }
         SkAutoAsciiToLC tolc(familyName);
-        for (int i = 0; i < fNameToFamilyMap.count(); ++i) {
-            if (fNameToFamilyMap[i].name.equals(tolc.lc())) {
-                return SkRef(fNameToFamilyMap[i].styleSet);
-            }
+        SkString name(tolc.lc(), tolc.length());
+        if (SkFontStyleSet_Android* const* styleSet = fNameToStyleSet.find(name)) {
+            return SkRef(*styleSet);
         }
         // TODO: eventually we should not need to name fallback families.
-        for (int i = 0; i < fFallbackNameToFamilyMap.count(); ++i) {
-            if (fFallbackNameToFamilyMap[i].name.equals(tolc.lc())) {
-                return SkRef(fFallbackNameToFamilyMap[i].styleSet);
-            }
+        if (SkFontStyleSet_Android* const* styleSet = fFallbackNameToStyleSet.find(name)) {
+            return SkRef(*styleSet);
         }
         return nullptr;
     }
@@ -524,11 +518,17 @@ private:
 
     SkTArray<NameToFamily, true> fNameToFamilyMap;
     SkTArray<NameToFamily, true> fFallbackNameToFamilyMap;
+    // Hashed indexes of the maps above for matchFamily(). A name maps to the first family that
+    // has it, as a scan of the maps would find.
+    SkTHashMap<SkString, SkFontStyleSet_Android*> fNameToStyleSet;
+    SkTHashMap<SkString, SkFontStyleSet_Android*> fFallbackNameToStyleSet;
 
     void addFamily(FontFamily& family, const bool isolated, int familyIndex) {
         SkTArray<NameToFamily, true>* nameToFamily = &fNameToFamilyMap;
+        SkTHashMap<SkString, SkFontStyleSet_Android*>* nameToStyleSet = &fNameToStyleSet;
         if (family.fIsFallbackFont) {
             nameToFamily = &fFallbackNameToFamilyMap;
+            nameToStyleSet = &fFallbackNameToStyleSet;
 
             if (0 == family.fNames.count()) {
                 SkString& fallbackName = family.fNames.push_back();
@@ -544,6 +544,9 @@ private:
 
         for (const SkString& name : family.fNames) {
             nameToFamily->emplace_back(NameToFamily{name, newSet.get()});
+            if (!nameToStyleSet->find(name)) {
+                nameToStyleSet->set(name, newSet.get());
+            }
         }
         fStyleSets.emplace_back(std::move(newSet));
     }
@@ -33,6 +33,26 @@ SkTypeface_Custom::SkTypeface_Custom(const SkFontStyle& style, bool isFixedPitch
 
 bool SkTypeface_Custom::isSysFont() const { return fIsSysFont; }
 
+void SkTypeface_Custom::setCharacterRanges(SkTDArray<SkUnichar> ranges) {
+    SkASSERT(SkIsAlign2(ranges.count()));
+    fCharacterRanges = std::move(ranges);
+}
+
+bool SkTypeface_Custom::containsCharacter(SkUnichar character) const {
+    // Find the first range whose last code point is not before 'character'.
+    int lo = 0;
+    int hi = fCharacterRanges.count() / 2;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (fCharacterRanges[2 * mid + 1] < character) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < fCharacterRanges.count() / 2 && fCharacterRanges[2 * lo] <= character;
+}
+
 void SkTypeface_Custom::onGetFamilyName(SkString* familyName) const {
     *familyName = fFamilyName;
 }
@@ -71,19 +91,16 @@ std::unique_ptr<SkFontData> SkTypeface_Stream::onMakeFontData() const {
 }
 
 sk_sp<SkTypeface> SkTypeface_Stream::onMakeClone(const SkFontArguments& args) const {
-    std::unique_ptr<SkFontData> data = this->cloneFontData(args);
-    if (!data) {
-        return nullptr;
-    }
-
     SkString familyName;
     this->getFamilyName(&familyName);
 
-    return sk_make_sp<SkTypeface_Stream>(std::move(data),
-                                         this->fontStyle(),
-                                         this->isFixedPitch(),
-                                         this->isSysFont(),
-                                         familyName);
+    return this->makeVariationInstance(args, [&](std::unique_ptr<SkFontData> data) {
+        return sk_make_sp<SkTypeface_Stream>(std::move(data),
+                                             this->fontStyle(),
+                                             this->isFixedPitch(),
+                                             this->isSysFont(),
+                                             familyName);
+    });
 }
 
 SkTypeface_File::SkTypeface_File(const SkFontStyle& style, bool isFixedPitch, bool sysFont,
@@ -98,19 +115,16 @@ std::unique_ptr<SkStreamAsset> SkTypeface_File::onOpenStream(int* ttcIndex) cons
 }
 
 sk_sp<SkTypeface> SkTypeface_File::onMakeClone(const SkFontArguments& args) const {
-    std::unique_ptr<SkFontData> data = this->cloneFontData(args);
-    if (!data) {
-        return nullptr;
-    }
-
     SkString familyName;
     this->getFamilyName(&familyName);
 
-    return sk_make_sp<SkTypeface_Stream>(std::move(data),
-                                         this->fontStyle(),
-                                         this->isFixedPitch(),
-                                         this->isSysFont(),
-                                         familyName);
+    return this->makeVariationInstance(args, [&](std::unique_ptr<SkFontData> data) {
+        return sk_make_sp<SkTypeface_Stream>(std::move(data),
+                                             this->fontStyle(),
+                                             this->isFixedPitch(),
+                                             this->isSysFont(),
+                                             familyName);
+    });
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -206,10 +220,23 @@ SkTypeface* SkFontMgr_Custom::onMatchFamilyStyle(const char familyName[],
 }
 
 SkTypeface* SkFontMgr_Custom::onMatchFamilyStyleCharacter(const char familyName[],
-                                                          const SkFontStyle&,
+                                                          const SkFontStyle& style,
                                                           const char* bcp47[], int bcp47Count,
                                                           SkUnichar character) const
 {
+    // Only typefaces whose character ranges were recorded by the loader take part.
+    for (int i = 0; i < fFamilies.count(); ++i) {
+        SkFontStyleSet_Custom* family = fFamilies[i].get();
+        sk_sp<SkTypeface_Custom> best(static_cast<SkTypeface_Custom*>(family->matchStyle(style)));
+        if (best && best->containsCharacter(character)) {
+            return best.release();
+        }
+        for (int j = 0; j < family->fStyles.count(); ++j) {
+            if (family->fStyles[j]->containsCharacter(character)) {
+                return SkRef(family->fStyles[j].get());
+            }
+        }
+    }
     return nullptr;
 }
 
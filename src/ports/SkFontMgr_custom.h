@@ -14,6 +14,7 @@
 #include "SkRefCnt.h"
 #include "SkString.h"
 #include "SkTArray.h"
+#include "SkTDArray.h"
 #include "SkTypes.h"
 
 class SkData;
@@ -28,6 +29,13 @@ public:
                       bool sysFont, const SkString familyName, int index);
     bool isSysFont() const;
 
+    /** Sets the code points this typeface maps, as sorted pairs of inclusive first and last
+     *  code points. Should only be called during the inital build phase.
+     */
+    void setCharacterRanges(SkTDArray<SkUnichar> ranges);
+    /** Returns false if the character ranges are unknown or do not include 'character'. */
+    bool containsCharacter(SkUnichar character) const;
+
 protected:
     void onGetFamilyName(SkString* familyName) const override;
     void onGetFontDescriptor(SkFontDescriptor* desc, bool* isLocal) const override;
@@ -37,6 +45,7 @@ private:
     const bool fIsSysFont;
     const SkString fFamilyName;
     const int fIndex;
+    SkTDArray<SkUnichar> fCharacterRanges;
 
     typedef SkTypeface_FreeType INHERITED;
 };
@@ -5,23 +5,216 @@
  * found in the LICENSE file.
  */
 
+#include "SkData.h"
 #include "SkFontMgr_custom.h"
 #include "SkFontMgr_directory.h"
 #include "SkOSFile.h"
 #include "SkOSPath.h"
 #include "SkStream.h"
+#include "SkTHash.h"
+
+namespace {
+
+/** What the scanner found in one face of a font file. */
+struct IndexedFace {
+    SkString fFamilyName;
+    SkFontStyle fStyle;
+    bool fIsFixedPitch;
+    SkTDArray<SkUnichar> fCharacterRanges;
+};
+
+/** What the scanner found in one file. A file which is not a font has no faces. */
+struct IndexedFile {
+    size_t fSize;
+    SkTArray<IndexedFace> fFaces;
+};
+
+using FontIndex = SkTHashMap<SkString, IndexedFile>;
+
+/*  The index file is a header followed by one record per file.
+ *
+ *  header: 'skfi', version, file count
+ *  file:   path, size, face count, faces
+ *  face:   family name, weight, width, slant, fixed pitch, range count, ranges
+ *
+ *  Strings are a packed length followed by their bytes. A file whose size changed since it was
+ *  indexed is scanned again.
+ */
+static constexpr uint32_t kIndexMagic = SkSetFourByteTag('s', 'k', 'f', 'i');
+static constexpr uint32_t kIndexVersion = 1;
+
+static bool read_string(SkStream* stream, SkString* str) {
+    size_t length;
+    if (!stream->readPackedUInt(&length) || (stream->hasLength() &&
+                                             length > stream->getLength() - stream->getPosition())) {
+        return false;
+    }
+    str->resize(length);
+    return stream->read(str->writable_str(), length) == length;
+}
+
+static bool write_string(SkWStream* stream, const SkString& str) {
+    return stream->writePackedUInt(str.size()) && stream->write(str.c_str(), str.size());
+}
+
+static bool read_face(SkStream* stream, IndexedFace* face) {
+    int32_t weight, width, slant;
+    uint32_t rangeCount;
+    if (!read_string(stream, &face->fFamilyName) ||
+        !stream->readS32(&weight) || !stream->readS32(&width) || !stream->readS32(&slant) ||
+        !stream->readBool(&face->fIsFixedPitch) ||
+        !stream->readU32(&rangeCount) || !SkIsAlign2(rangeCount) ||
+        rangeCount > (stream->getLength() - stream->getPosition()) / sizeof(SkUnichar))
+    {
+        return false;
+    }
+    if (slant < SkFontStyle::kUpright_Slant || slant > SkFontStyle::kOblique_Slant) {
+        return false;
+    }
+    face->fStyle = SkFontStyle(weight, width, (SkFontStyle::Slant)slant);
+    face->fCharacterRanges.setCount(rangeCount);
+    size_t rangeBytes = rangeCount * sizeof(SkUnichar);
+    return stream->read(face->fCharacterRanges.begin(), rangeBytes) == rangeBytes;
+}
+
+static bool write_face(SkWStream* stream, const IndexedFace& face) {
+    return write_string(stream, face.fFamilyName) &&
+           stream->write32(face.fStyle.weight()) &&
+           stream->write32(face.fStyle.width()) &&
+           stream->write32(face.fStyle.slant()) &&
+           stream->writeBool(face.fIsFixedPitch) &&
+           stream->write32(face.fCharacterRanges.count()) &&
+           stream->write(face.fCharacterRanges.begin(),
+                         face.fCharacterRanges.count() * sizeof(SkUnichar));
+}
+
+/** Reads the index at 'path'. A missing, stale or damaged index reads as empty. */
+static void read_index(const char* path, FontIndex* index) {
+    // The index is mapped, not read, so only the pages in use are ever touched.
+    sk_sp<SkData> data = SkData::MakeFromFileName(path);
+    if (!data) {
+        return;
+    }
+    SkMemoryStream stream(std::move(data));
+
+    uint32_t magic, version, fileCount;
+    if (!stream.readU32(&magic) || magic != kIndexMagic ||
+        !stream.readU32(&version) || version != kIndexVersion ||
+        !stream.readU32(&fileCount))
+    {
+        return;
+    }
+    FontIndex result;
+    for (uint32_t i = 0; i < fileCount; ++i) {
+        SkString filename;
+        size_t size, faceCount;
+        if (!read_string(&stream, &filename) ||
+            !stream.readPackedUInt(&size) || !stream.readPackedUInt(&faceCount) ||
+            faceCount > stream.getLength() - stream.getPosition())
+        {
+            return;
+        }
+        IndexedFile* file = result.set(std::move(filename), IndexedFile());
+        file->fSize = size;
+        for (size_t j = 0; j < faceCount; ++j) {
+            if (!read_face(&stream, &file->fFaces.push_back())) {
+                return;
+            }
+        }
+    }
+    *index = std::move(result);
+}
+
+static void write_index(const char* path, const FontIndex& index) {
+    SkFILEWStream stream(path);
+    if (!stream.isValid()) {
+        return;
+    }
+    bool success = stream.write32(kIndexMagic) &&
+                   stream.write32(kIndexVersion) &&
+                   stream.write32(index.count());
+    index.foreach([&](const SkString& filename, const IndexedFile& file) {
+        success = success &&
+                  write_string(&stream, filename) &&
+                  stream.writePackedUInt(file.fSize) &&
+                  stream.writePackedUInt(file.fFaces.count());
+        for (const IndexedFace& face : file.fFaces) {
+            success = success && write_face(&stream, face);
+        }
+    });
+    if (!success) {
+        SkDEBUGF("---- failed to write font index <%s>\n", path);
+    }
+}
+
+static size_t file_size(const char* path) {
+    FILE* file = sk_fopen(path, kRead_SkFILE_Flag);
+    if (!file) {
+        return 0;
+    }
+    size_t size = sk_fgetsize(file);
+    sk_fclose(file);
+    return size;
+}
+
+/** Scans every face of the font file at 'path'. */
+static bool scan_file(const SkTypeface_FreeType::Scanner& scanner, const char* path,
+                      IndexedFile* file)
+{
+    std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(path);
+    if (!stream) {
+        // SkDebugf("---- failed to open <%s>\n", path);
+        return false;
+    }
+    file->fSize = stream->getLength();
+
+    int numFaces;
+    if (!scanner.recognizedFont(stream.get(), &numFaces)) {
+        // SkDebugf("---- failed to open <%s> as a font\n", path);
+        return true;
+    }
+
+    for (int faceIndex = 0; faceIndex < numFaces; ++faceIndex) {
+        IndexedFace face;
+        face.fStyle = SkFontStyle(); // avoid uninitialized warning
+        if (!scanner.scanFont(stream.get(), faceIndex,
+                              &face.fFamilyName, &face.fStyle, &face.fIsFixedPitch, nullptr) ||
+            !scanner.scanCoverage(stream.get(), faceIndex, &face.fCharacterRanges))
+        {
+            // SkDebugf("---- failed to open <%s> <%d> as a font\n", path, faceIndex);
+            continue;
+        }
+        file->fFaces.push_back(std::move(face));
+    }
+    return true;
+}
+
+}  // namespace
 
 class DirectorySystemFontLoader : public SkFontMgr_Custom::SystemFontLoader {
 public:
-    DirectorySystemFontLoader(const char* dir) : fBaseDirectory(dir) { }
+    DirectorySystemFontLoader(const char* dir, const char* indexPath)
+        : fBaseDirectory(dir), fIndexPath(indexPath) { }
 
     void loadSystemFonts(const SkTypeface_FreeType::Scanner& scanner,
                          SkFontMgr_Custom::Families* families) const override
     {
-        load_directory_fonts(scanner, fBaseDirectory, ".ttf", families);
-        load_directory_fonts(scanner, fBaseDirectory, ".ttc", families);
-        load_directory_fonts(scanner, fBaseDirectory, ".otf", families);
-        load_directory_fonts(scanner, fBaseDirectory, ".pfb", families);
+        FontIndex oldIndex;
+        if (!fIndexPath.isEmpty()) {
+            read_index(fIndexPath.c_str(), &oldIndex);
+        }
+
+        FontIndex index;
+        bool changed = false;
+        Context context = { scanner, oldIndex, &index, &changed, families };
+        load_directory_fonts(context, fBaseDirectory, ".ttf");
+        load_directory_fonts(context, fBaseDirectory, ".ttc");
+        load_directory_fonts(context, fBaseDirectory, ".otf");
+        load_directory_fonts(context, fBaseDirectory, ".pfb");
+
+        if (!fIndexPath.isEmpty() && (changed || index.count() != oldIndex.count())) {
+            write_index(fIndexPath.c_str(), index);
+        }
 
         if (families->empty()) {
             SkFontStyleSet_Custom* family = new SkFontStyleSet_Custom(SkString());
@@ -31,6 +224,14 @@ public:
     }
 
 private:
+    struct Context {
+        const SkTypeface_FreeType::Scanner& fScanner;
+        const FontIndex& fOldIndex;
+        FontIndex* fIndex;
+        bool* fChanged;
+        SkFontMgr_Custom::Families* fFamilies;
+    };
+
     static SkFontStyleSet_Custom* find_family(SkFontMgr_Custom::Families& families,
                                               const char familyName[])
     {
@@ -42,47 +243,42 @@ private:
         return nullptr;
     }
 
-    static void load_directory_fonts(const SkTypeface_FreeType::Scanner& scanner,
-                                     const SkString& directory, const char* suffix,
-                                     SkFontMgr_Custom::Families* families)
+    static void load_directory_fonts(const Context& context, const SkString& directory,
+                                     const char* suffix)
     {
         SkOSFile::Iter iter(directory.c_str(), suffix);
         SkString name;
 
         while (iter.next(&name, false)) {
             SkString filename(SkOSPath::Join(directory.c_str(), name.c_str()));
-            std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(filename.c_str());
-            if (!stream) {
-                // SkDebugf("---- failed to open <%s>\n", filename.c_str());
-                continue;
-            }
-
-            int numFaces;
-            if (!scanner.recognizedFont(stream.get(), &numFaces)) {
-                // SkDebugf("---- failed to open <%s> as a font\n", filename.c_str());
-                continue;
-            }
 
-            for (int faceIndex = 0; faceIndex < numFaces; ++faceIndex) {
-                bool isFixedPitch;
-                SkString realname;
-                SkFontStyle style = SkFontStyle(); // avoid uninitialized warning
-                if (!scanner.scanFont(stream.get(), faceIndex,
-                                      &realname, &style, &isFixedPitch, nullptr))
-                {
-                    // SkDebugf("---- failed to open <%s> <%d> as a font\n",
-                    //          filename.c_str(), faceIndex);
+            // Only files which are new or have changed since they were indexed are opened.
+            const IndexedFile* file = context.fOldIndex.find(filename);
+            if (!file || file->fSize != file_size(filename.c_str())) {
+                IndexedFile scanned;
+                if (!scan_file(context.fScanner, filename.c_str(), &scanned)) {
                     continue;
                 }
+                file = context.fIndex->set(filename, std::move(scanned));
+                *context.fChanged = true;
+            } else {
+                file = context.fIndex->set(filename, *file);
+            }
 
-                SkFontStyleSet_Custom* addTo = find_family(*families, realname.c_str());
+            // The faces are opened lazily, when first used.
+            for (int faceIndex = 0; faceIndex < file->fFaces.count(); ++faceIndex) {
+                const IndexedFace& face = file->fFaces[faceIndex];
+                SkFontStyleSet_Custom* addTo = find_family(*context.fFamilies,
+                                                           face.fFamilyName.c_str());
                 if (nullptr == addTo) {
-                    addTo = new SkFontStyleSet_Custom(realname);
-                    families->push_back().reset(addTo);
+                    addTo = new SkFontStyleSet_Custom(face.fFamilyName);
+                    context.fFamilies->push_back().reset(addTo);
                 }
-                addTo->appendTypeface(sk_make_sp<SkTypeface_File>(style, isFixedPitch, true,
-                                                                  realname, filename.c_str(),
-                                                                  faceIndex));
+                auto typeface = sk_make_sp<SkTypeface_File>(face.fStyle, face.fIsFixedPitch, true,
+                                                            face.fFamilyName, filename.c_str(),
+                                                            faceIndex);
+                typeface->setCharacterRanges(face.fCharacterRanges);
+                addTo->appendTypeface(std::move(typeface));
             }
         }
 
@@ -92,13 +288,18 @@ private:
                 continue;
             }
             SkString dirname(SkOSPath::Join(directory.c_str(), name.c_str()));
-            load_directory_fonts(scanner, dirname, suffix, families);
+            load_directory_fonts(context, dirname, suffix);
         }
     }
 
     SkString fBaseDirectory;
+    SkString fIndexPath;
 };
 
 SK_API sk_sp<SkFontMgr> SkFontMgr_New_Custom_Directory(const char* dir) {
-    return sk_make_sp<SkFontMgr_Custom>(DirectorySystemFontLoader(dir));
+    return SkFontMgr_New_Custom_Directory(dir, nullptr);
+}
+
+SK_API sk_sp<SkFontMgr> SkFontMgr_New_Custom_Directory(const char* dir, const char* indexPath) {
+    return sk_make_sp<SkFontMgr_Custom>(DirectorySystemFontLoader(dir, indexPath));
 }
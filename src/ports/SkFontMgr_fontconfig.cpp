@@ -444,14 +444,12 @@ public:
     }
 
     sk_sp<SkTypeface> onMakeClone(const SkFontArguments& args) const override {
-        std::unique_ptr<SkFontData> data = this->cloneFontData(args);
-        if (!data) {
-            return nullptr;
-        }
-        return sk_make_sp<SkTypeface_stream>(std::move(data),
-                                             fFamilyName,
-                                             this->fontStyle(),
-                                             this->isFixedPitch());
+        return this->makeVariationInstance(args, [this](std::unique_ptr<SkFontData> data) {
+            return sk_make_sp<SkTypeface_stream>(std::move(data),
+                                                 fFamilyName,
+                                                 this->fontStyle(),
+                                                 this->isFixedPitch());
+        });
     }
 
 private:
@@ -529,18 +527,15 @@ public:
     }
 
     sk_sp<SkTypeface> onMakeClone(const SkFontArguments& args) const override {
-        std::unique_ptr<SkFontData> data = this->cloneFontData(args);
-        if (!data) {
-            return nullptr;
-        }
-
         SkString familyName;
         this->getFamilyName(&familyName);
 
-        return sk_make_sp<SkTypeface_stream>(std::move(data),
-                                             familyName,
-                                             this->fontStyle(),
-                                             this->isFixedPitch());
+        return this->makeVariationInstance(args, [&](std::unique_ptr<SkFontData> data) {
+            return sk_make_sp<SkTypeface_stream>(std::move(data),
+                                                 familyName,
+                                                 this->fontStyle(),
+                                                 this->isFixedPitch());
+        });
     }
 
     ~SkTypeface_fontconfig() override {
@@ -686,14 +681,16 @@ class SkFontMgr_fontconfig : public SkFontMgr {
     sk_sp<SkTypeface> createTypefaceFromFcPattern(FcPattern* pattern) const {
         FCLocker::AssertHeld();
         SkAutoMutexAcquire ama(fTFCacheMutex);
-        sk_sp<SkTypeface> face = fTFCache.findByProcAndRef(FindByFcPattern, pattern);
+        // Equal patterns have equal hashes, so only typefaces with this hash need comparing.
+        uint32_t patternHash = FcPatternHash(pattern);
+        sk_sp<SkTypeface> face = fTFCache.findByHashAndRef(patternHash, FindByFcPattern, pattern);
         if (!face) {
             FcPatternReference(pattern);
             face = SkTypeface_fontconfig::Make(SkAutoFcPattern(pattern));
             if (face) {
                 // Cannot hold the lock when calling add; an evicted typeface may need to lock.
                 FCLocker::Suspend suspend;
-                fTFCache.add(face);
+                fTFCache.add(face, patternHash);
             }
         }
         return face;
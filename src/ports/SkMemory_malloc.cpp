@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "SkAllocationCounter.h"
 #include "SkMalloc.h"
 
 #include <cstdlib>
@@ -54,11 +55,21 @@ void sk_out_of_memory(void) {
 }
 
 void* sk_realloc_throw(void* addr, size_t size) {
+#ifdef SK_COUNT_ALLOCATIONS
+    SkAllocationCounter::OnFree(addr);
+    void* p = throw_on_failure(size, realloc(addr, size));
+    SkAllocationCounter::OnAlloc(p);
+    return p;
+#else
     return throw_on_failure(size, realloc(addr, size));
+#endif
 }
 
 void sk_free(void* p) {
     if (p) {
+#ifdef SK_COUNT_ALLOCATIONS
+        SkAllocationCounter::OnFree(p);
+#endif
         free(p);
     }
 }
@@ -70,6 +81,9 @@ void* sk_malloc_flags(size_t size, unsigned flags) {
     } else {
         p = malloc(size);
     }
+#ifdef SK_COUNT_ALLOCATIONS
+    SkAllocationCounter::OnAlloc(p);
+#endif
     if (flags & SK_MALLOC_THROW) {
         return throw_on_failure(size, p);
     } else {
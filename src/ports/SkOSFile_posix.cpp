@@ -12,6 +12,7 @@
 #include "SkTypes.h"
 
 #include <dirent.h>
+#include <fcntl.h>
 #include <new>
 #include <stdio.h>
 #include <string.h>
@@ -121,6 +122,16 @@ size_t sk_qread(FILE* file, void* buffer, size_t count, size_t offset) {
     return bytesRead;
 }
 
+void sk_fadvise_sequential(FILE* file) {
+#if !defined(SK_BUILD_FOR_MAC) && !defined(SK_BUILD_FOR_IOS)
+    // Apple platforms have no posix_fadvise(), and read ahead on their own.
+    int fd = sk_fileno(file);
+    if (fd >= 0) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////
 
 struct SkOSFileIterData {
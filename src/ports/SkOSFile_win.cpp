@@ -156,6 +156,10 @@ size_t sk_qread(FILE* file, void* buffer, size_t count, size_t offset) {
     return SIZE_MAX;
 }
 
+void sk_fadvise_sequential(FILE*) {
+    // Windows detects sequential reads and reads ahead on its own.
+}
+
 ////////////////////////////////////////////////////////////////////////////
 
 struct SkOSFileIterData {
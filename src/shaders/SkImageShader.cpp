@@ -422,15 +422,18 @@ bool SkImageShader::onAppendStages(const StageRec& rec) const {
         return true;
     };
 
-    // We've got a fast path for 8888 bilinear clamp/clamp sampling.
+    // We've got fast paths for 8888 bilinear clamp/clamp and repeat/repeat sampling.
     auto ct = info.colorType();
     if (true
         && (ct == kRGBA_8888_SkColorType || ct == kBGRA_8888_SkColorType)
         && quality == kLow_SkFilterQuality
-        && fTileModeX == SkShader::kClamp_TileMode
-        && fTileModeY == SkShader::kClamp_TileMode) {
+        && fTileModeX == fTileModeY
+        && (fTileModeX == SkShader::kClamp_TileMode ||
+            fTileModeX == SkShader::kRepeat_TileMode)) {
 
-        p->append(SkRasterPipeline::bilerp_clamp_8888, gather);
+        p->append(fTileModeX == SkShader::kClamp_TileMode ? SkRasterPipeline::bilerp_clamp_8888
+                                                          : SkRasterPipeline::bilerp_repeat_8888,
+                  gather);
         if (ct == kBGRA_8888_SkColorType) {
             p->append(SkRasterPipeline::swap_rb);
         }
@@ -9,7 +9,9 @@
 
 #include "SkArenaAlloc.h"
 #include "SkColorFilter.h"
+#include "SkFloatBits.h"
 #include "SkMakeUnique.h"
+#include "SkNx.h"
 #include "SkReadBuffer.h"
 #include "SkShader.h"
 #include "SkString.h"
@@ -18,6 +20,7 @@
 
 #if SK_SUPPORT_GPU
 #include "GrCoordTransform.h"
+#include "GrProxyProvider.h"
 #include "GrRecordingContext.h"
 #include "GrRecordingContextPriv.h"
 #include "SkGr.h"
@@ -351,12 +354,10 @@ public:
 
     private:
         SkPMColor shade(const SkPoint& point, StitchData& stitchData) const;
-        SkScalar calculateTurbulenceValueForPoint(
-                                                  int channel,
-                                                  StitchData& stitchData, const SkPoint& point) const;
+        // Computes all four channels at once, in RGBA order; they differ only in their gradients.
+        Sk4f calculateTurbulenceValueForPoint(StitchData& stitchData, const SkPoint& point) const;
         SkScalar calculateImprovedNoiseValueForPoint(int channel, const SkPoint& point) const;
-        SkScalar noise2D(int channel,
-                         const StitchData& stitchData, const SkPoint& noiseVector) const;
+        Sk4f noise2D(const StitchData& stitchData, const SkPoint& noiseVector) const;
 
         SkMatrix     fMatrix;
         PaintingData fPaintingData;
@@ -466,8 +467,8 @@ void SkPerlinNoiseShaderImpl::flatten(SkWriteBuffer& buffer) const {
     buffer.writeInt(fTileSize.fHeight);
 }
 
-SkScalar SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::noise2D(
-        int channel, const StitchData& stitchData, const SkPoint& noiseVector) const {
+Sk4f SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::noise2D(
+        const StitchData& stitchData, const SkPoint& noiseVector) const {
     struct Noise {
         int noisePositionIntegerValue;
         int nextNoisePositionIntegerValue;
@@ -482,7 +483,6 @@ SkScalar SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::noise2D(
     };
     Noise noiseX(noiseVector.x());
     Noise noiseY(noiseVector.y());
-    SkScalar u, v;
     const SkPerlinNoiseShaderImpl& perlinNoiseShader = static_cast<const SkPerlinNoiseShaderImpl&>(fShader);
     // If stitching, adjust lattice points accordingly.
     if (perlinNoiseShader.fStitchTiles) {
@@ -512,36 +512,45 @@ SkScalar SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::noise2D(
         return 0;  // Check for pathological inputs.
     }
 
+    // The dot product of each channel's gradient at lattice point b with fractionValue.
+    auto dot = [this](int b, const SkPoint& fractionValue) {
+        const SkPoint (&gradient)[4][kBlockSize] = fPaintingData.fGradient;
+        Sk4f gx(gradient[0][b].fX, gradient[1][b].fX, gradient[2][b].fX, gradient[3][b].fX),
+             gy(gradient[0][b].fY, gradient[1][b].fY, gradient[2][b].fY, gradient[3][b].fY);
+        return gx * fractionValue.fX + gy * fractionValue.fY;
+    };
+    auto interp = [](const Sk4f& a, const Sk4f& b, SkScalar t) { return a + (b - a) * t; };
+
     // This is taken 1:1 from SVG spec: http://www.w3.org/TR/SVG11/filters.html#feTurbulenceElement
     SkPoint fractionValue = SkPoint::Make(noiseX.noisePositionFractionValue,
                                           noiseY.noisePositionFractionValue); // Offset (0,0)
-    u = fPaintingData.fGradient[channel][b00].dot(fractionValue);
+    Sk4f u = dot(b00, fractionValue);
     fractionValue.fX -= SK_Scalar1; // Offset (-1,0)
-    v = fPaintingData.fGradient[channel][b10].dot(fractionValue);
-    SkScalar a = SkScalarInterp(u, v, sx);
+    Sk4f v = dot(b10, fractionValue);
+    Sk4f a = interp(u, v, sx);
     fractionValue.fY -= SK_Scalar1; // Offset (-1,-1)
-    v = fPaintingData.fGradient[channel][b11].dot(fractionValue);
+    v = dot(b11, fractionValue);
     fractionValue.fX = noiseX.noisePositionFractionValue; // Offset (0,-1)
-    u = fPaintingData.fGradient[channel][b01].dot(fractionValue);
-    SkScalar b = SkScalarInterp(u, v, sx);
-    return SkScalarInterp(a, b, sy);
+    u = dot(b01, fractionValue);
+    Sk4f b = interp(u, v, sx);
+    return interp(a, b, sy);
 }
 
-SkScalar SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::calculateTurbulenceValueForPoint(
-        int channel, StitchData& stitchData, const SkPoint& point) const {
+Sk4f SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::calculateTurbulenceValueForPoint(
+        StitchData& stitchData, const SkPoint& point) const {
     const SkPerlinNoiseShaderImpl& perlinNoiseShader = static_cast<const SkPerlinNoiseShaderImpl&>(fShader);
     if (perlinNoiseShader.fStitchTiles) {
         // Set up TurbulenceInitial stitch values.
         stitchData = fPaintingData.fStitchDataInit;
     }
-    SkScalar turbulenceFunctionResult = 0;
+    Sk4f turbulenceFunctionResult = 0;
     SkPoint noiseVector(SkPoint::Make(point.x() * fPaintingData.fBaseFrequency.fX,
                                       point.y() * fPaintingData.fBaseFrequency.fY));
     SkScalar ratio = SK_Scalar1;
     for (int octave = 0; octave < perlinNoiseShader.fNumOctaves; ++octave) {
-        SkScalar noise = noise2D(channel, stitchData, noiseVector);
-        SkScalar numer = (perlinNoiseShader.fType == kFractalNoise_Type) ?
-                            noise : SkScalarAbs(noise);
+        Sk4f noise = noise2D(stitchData, noiseVector);
+        Sk4f numer = (perlinNoiseShader.fType == kFractalNoise_Type) ?
+                        noise : noise.abs();
         turbulenceFunctionResult += numer / ratio;
         noiseVector.fX *= 2;
         noiseVector.fY *= 2;
@@ -556,15 +565,15 @@ SkScalar SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::calculateTurbulenceV
     // The value of turbulenceFunctionResult comes from ((turbulenceFunctionResult) + 1) / 2
     // by fractalNoise and (turbulenceFunctionResult) by turbulence.
     if (perlinNoiseShader.fType == kFractalNoise_Type) {
-        turbulenceFunctionResult = SkScalarHalf(turbulenceFunctionResult + 1);
+        turbulenceFunctionResult = (turbulenceFunctionResult + 1) * SK_ScalarHalf;
     }
 
-    if (channel == 3) { // Scale alpha by paint value
-        turbulenceFunctionResult *= SkIntToScalar(getPaintAlpha()) / 255;
-    }
+    // Scale alpha by paint value
+    turbulenceFunctionResult = turbulenceFunctionResult *
+                               Sk4f(1, 1, 1, SkIntToScalar(getPaintAlpha()) / 255);
 
     // Clamp result
-    return SkScalarPin(turbulenceFunctionResult, 0, SK_Scalar1);
+    return Sk4f::Min(Sk4f::Max(turbulenceFunctionResult, 0), SK_Scalar1);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -638,15 +647,16 @@ SkPMColor SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::shade(
     newPoint.fY = SkScalarRoundToScalar(newPoint.fY);
 
     U8CPU rgba[4];
-    for (int channel = 3; channel >= 0; --channel) {
-        SkScalar value;
-        if (perlinNoiseShader.fType == kImprovedNoise_Type) {
-            value = calculateImprovedNoiseValueForPoint(channel, newPoint);
+    if (perlinNoiseShader.fType == kImprovedNoise_Type) {
+        for (int channel = 3; channel >= 0; --channel) {
+            SkScalar value = calculateImprovedNoiseValueForPoint(channel, newPoint);
+            rgba[channel] = SkScalarFloorToInt(255 * value);
         }
-        else {
-            value = calculateTurbulenceValueForPoint(channel, stitchData, newPoint);
+    } else {
+        Sk4f value = calculateTurbulenceValueForPoint(stitchData, newPoint) * 255;
+        for (int channel = 0; channel < 4; ++channel) {
+            rgba[channel] = SkScalarFloorToInt(value[channel]);
         }
-        rgba[channel] = SkScalarFloorToInt(255 * value);
     }
     return SkPreMultiplyARGB(rgba[3], rgba[0], rgba[1], rgba[2]);
 }
@@ -1403,6 +1413,39 @@ void GrGLImprovedPerlinNoise::onSetData(const GrGLSLProgramDataManager& pdman,
 }
 
 /////////////////////////////////////////////////////////////////////
+
+enum class NoiseTexture {
+    kPermutations,
+    kNoise,
+    kImprovedPermutations,
+    kGradient,
+};
+
+// The lattice textures depend only on the seed, and the improved noise ones on nothing at all. So
+// they are shared through the resource cache by every shader with the same seed, rather than
+// uploaded again for each shader instance (whose images are new each time).
+static sk_sp<GrTextureProxy> make_noise_texture(GrProxyProvider* proxyProvider,
+                                                sk_sp<SkImage> image, NoiseTexture texture,
+                                                SkScalar seed) {
+    static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
+    GrUniqueKey key;
+    GrUniqueKey::Builder builder(&key, kDomain, 2, "Perlin Noise");
+    builder[0] = static_cast<uint32_t>(texture);
+    builder[1] = SkFloat2Bits(seed);
+    builder.finish();
+
+    sk_sp<GrTextureProxy> proxy =
+            proxyProvider->findOrCreateProxyByUniqueKey(key, kTopLeft_GrSurfaceOrigin);
+    if (!proxy) {
+        proxy = proxyProvider->createTextureProxy(std::move(image), kNone_GrSurfaceFlags, 1,
+                                                  SkBudgeted::kYes, SkBackingFit::kExact);
+        if (proxy) {
+            proxyProvider->assignUniqueKeyToProxy(key, proxy.get());
+        }
+    }
+    return proxy;
+}
+
 std::unique_ptr<GrFragmentProcessor> SkPerlinNoiseShaderImpl::asFragmentProcessor(
         const GrFPArgs& args) const {
     SkASSERT(args.fContext);
@@ -1432,12 +1475,14 @@ std::unique_ptr<GrFragmentProcessor> SkPerlinNoiseShaderImpl::asFragmentProcesso
         const sk_sp<SkImage> permutationsImage = paintingData->getImprovedPermutationsImage();
         SkASSERT(SkIsPow2(permutationsImage->width()) && SkIsPow2(permutationsImage->height()));
         sk_sp<GrTextureProxy> permutationsTexture(
-                GrMakeCachedImageProxy(proxyProvider, std::move(permutationsImage)));
+                make_noise_texture(proxyProvider, std::move(permutationsImage),
+                                   NoiseTexture::kImprovedPermutations, 0));
 
         const sk_sp<SkImage> gradientImage = paintingData->getGradientImage();
         SkASSERT(SkIsPow2(gradientImage->width()) && SkIsPow2(gradientImage->height()));
         sk_sp<GrTextureProxy> gradientTexture(
-                GrMakeCachedImageProxy(proxyProvider, std::move(gradientImage)));
+                make_noise_texture(proxyProvider, std::move(gradientImage),
+                                   NoiseTexture::kGradient, 0));
         return GrImprovedPerlinNoiseEffect::Make(fNumOctaves, fSeed, std::move(paintingData),
                                                  std::move(permutationsTexture),
                                                  std::move(gradientTexture), m);
@@ -1464,13 +1509,13 @@ std::unique_ptr<GrFragmentProcessor> SkPerlinNoiseShaderImpl::asFragmentProcesso
     // through GrBitmapTextureMaker to handle needed copies.
     const sk_sp<SkImage> permutationsImage = paintingData->getPermutationsImage();
     SkASSERT(SkIsPow2(permutationsImage->width()) && SkIsPow2(permutationsImage->height()));
-    sk_sp<GrTextureProxy> permutationsProxy = GrMakeCachedImageProxy(proxyProvider,
-                                                                     std::move(permutationsImage));
+    sk_sp<GrTextureProxy> permutationsProxy = make_noise_texture(
+            proxyProvider, std::move(permutationsImage), NoiseTexture::kPermutations, fSeed);
 
     const sk_sp<SkImage> noiseImage = paintingData->getNoiseImage();
     SkASSERT(SkIsPow2(noiseImage->width()) && SkIsPow2(noiseImage->height()));
-    sk_sp<GrTextureProxy> noiseProxy = GrMakeCachedImageProxy(proxyProvider,
-                                                              std::move(noiseImage));
+    sk_sp<GrTextureProxy> noiseProxy = make_noise_texture(
+            proxyProvider, std::move(noiseImage), NoiseTexture::kNoise, fSeed);
 
     if (permutationsProxy && noiseProxy) {
         auto inner = GrPerlinNoise2Effect::Make(fType,
@@ -18,6 +18,7 @@
 #include "SkPicturePriv.h"
 #include "SkReadBuffer.h"
 #include "SkResourceCache.h"
+#include "SkTaskGroup.h"
 #include <atomic>
 
 #if SK_SUPPORT_GPU
@@ -36,16 +37,19 @@ struct BitmapShaderKey : public SkResourceCache::Key {
 public:
     BitmapShaderKey(SkColorSpace* colorSpace,
                     SkImage::BitDepth bitDepth,
+                    bool rasterTile,
                     uint32_t shaderID,
                     const SkSize& scale)
         : fColorSpaceXYZHash(colorSpace->toXYZD50Hash())
         , fColorSpaceTransferFnHash(colorSpace->transferFnHash())
         , fBitDepth(bitDepth)
+        , fRasterTile(rasterTile)
         , fScale(scale) {
 
         static const size_t keySize = sizeof(fColorSpaceXYZHash) +
                                       sizeof(fColorSpaceTransferFnHash) +
                                       sizeof(fBitDepth) +
+                                      sizeof(fRasterTile) +
                                       sizeof(fScale);
         // This better be packed.
         SkASSERT(sizeof(uint32_t) * (&fEndOfStruct - &fColorSpaceXYZHash) == keySize);
@@ -61,23 +65,27 @@ private:
     uint32_t                   fColorSpaceXYZHash;
     uint32_t                   fColorSpaceTransferFnHash;
     SkImage::BitDepth          fBitDepth;
+    uint32_t                   fRasterTile;
     SkSize                     fScale;
 
     SkDEBUGCODE(uint32_t fEndOfStruct;)
 };
 
 struct BitmapShaderRec : public SkResourceCache::Rec {
-    BitmapShaderRec(const BitmapShaderKey& key, SkShader* tileShader)
+    BitmapShaderRec(const BitmapShaderKey& key, SkShader* tileShader, size_t pixelBytes)
         : fKey(key)
-        , fShader(SkRef(tileShader)) {}
+        , fShader(SkRef(tileShader))
+        , fPixelBytes(pixelBytes) {}
 
     BitmapShaderKey fKey;
     sk_sp<SkShader> fShader;
+    size_t          fPixelBytes;
 
     const Key& getKey() const override { return fKey; }
     size_t bytesUsed() const override {
-        // Just the record overhead -- the actual pixels are accounted by SkImage_Lazy.
-        return sizeof(fKey) + sizeof(SkImageShader);
+        // Lazy tiles only cost the record overhead -- their pixels are accounted by
+        // SkImage_Lazy. Tiles rasterized up front own their pixels.
+        return sizeof(fKey) + sizeof(SkImageShader) + fPixelBytes;
     }
     const char* getCategory() const override { return "bitmap-shader"; }
     SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
@@ -88,12 +96,57 @@ struct BitmapShaderRec : public SkResourceCache::Rec {
 
         *result = rec.fShader;
 
-        // The bitmap shader is backed by an image generator, thus it can always re-generate its
-        // pixels if discarded.
+        // The bitmap shader is backed by an image generator or by pixels it owns, thus it can
+        // always re-generate (or still has) its pixels.
         return true;
     }
 };
 
+// Tiles at least this big are rasterized up front in bands on the default executor, rather than
+// lazily on first use by a single thread.
+static constexpr int kRowsPerBand = 64;
+static constexpr int kMinParallelPixels = 256 * 256;
+
+// A tile cached at a slightly larger scale is reused (and filtered down) instead of rasterizing a
+// new one, so a slowly changing scale (an animated zoom) does not re-rasterize every frame. This
+// is a quarter octave, a small enough step that the extra filtering is not visible.
+static constexpr float kMaxTileReuseRatio = 1.19f;
+
+static constexpr int kMaxRememberedTiles = 8;
+
+static sk_sp<SkImage> rasterize_tile(const sk_sp<SkPicture>& picture, const SkImageInfo& info,
+                                     const SkMatrix& tileMatrix) {
+    SkBitmap bitmap;
+    if (!bitmap.tryAllocPixels(info)) {
+        return nullptr;
+    }
+
+    auto drawRows = [&](int top, int bottom) {
+        SkSurfaceProps props(0, kUnknown_SkPixelGeometry);
+        std::unique_ptr<SkCanvas> canvas =
+                SkCanvas::MakeRasterDirect(info.makeWH(info.width(), bottom - top),
+                                           bitmap.getAddr(0, top), bitmap.rowBytes(), &props);
+        canvas->clear(0);
+        canvas->translate(0, -SkIntToScalar(top));
+        canvas->concat(tileMatrix);
+        canvas->drawPicture(picture);
+    };
+
+    const int bandCount = (info.height() + kRowsPerBand - 1) / kRowsPerBand;
+    if (bandCount > 1 && info.width() * info.height() >= kMinParallelPixels) {
+        SkTaskGroup taskGroup;
+        taskGroup.batch(bandCount, [&](int i) {
+            drawRows(i * kRowsPerBand, SkTMin((i + 1) * kRowsPerBand, info.height()));
+        });
+        taskGroup.wait();
+    } else {
+        drawRows(0, info.height());
+    }
+
+    bitmap.setImmutable();
+    return SkImage::MakeFromBitmap(bitmap);
+}
+
 uint32_t next_id() {
     static std::atomic<uint32_t> nextID{1};
 
@@ -166,6 +219,7 @@ sk_sp<SkShader> SkPictureShader::refBitmapShader(const SkMatrix& viewMatrix,
                                                  SkTCopyOnFirstWrite<SkMatrix>* localMatrix,
                                                  SkColorType dstColorType,
                                                  SkColorSpace* dstColorSpace,
+                                                 bool rasterTile,
                                                  const int maxTextureSize) const {
     SkASSERT(fPicture && !fPicture->cullRect().isEmpty());
 
@@ -209,7 +263,7 @@ sk_sp<SkShader> SkPictureShader::refBitmapShader(const SkMatrix& viewMatrix,
     }
 
     // The actual scale, compensating for rounding & clamping.
-    const SkSize tileScale = SkSize::Make(SkIntToScalar(tileSize.width()) / fTile.width(),
+    SkSize tileScale = SkSize::Make(SkIntToScalar(tileSize.width()) / fTile.width(),
                                           SkIntToScalar(tileSize.height()) / fTile.height());
 
     // |fColorSpace| will only be set when using an SkColorSpaceXformCanvas to do pre-draw xforms.
@@ -227,24 +281,44 @@ sk_sp<SkShader> SkPictureShader::refBitmapShader(const SkMatrix& viewMatrix,
             dstColorType >= kRGBA_F16Norm_SkColorType
             ? SkImage::BitDepth::kF16 : SkImage::BitDepth::kU8;
 
-    BitmapShaderKey key(imgCS.get(), bitDepth, fUniqueID, tileScale);
+    BitmapShaderKey key(imgCS.get(), bitDepth, rasterTile, fUniqueID, tileScale);
 
     sk_sp<SkShader> tileShader;
-    if (!SkResourceCache::Find(key, BitmapShaderRec::Visitor, &tileShader)) {
+    if (!SkResourceCache::Find(key, BitmapShaderRec::Visitor, &tileShader) &&
+        !this->findNearbyTile(imgCS.get(), bitDepth, rasterTile, tileSize, maxTextureSize,
+                              &tileShader, &tileScale)) {
         SkMatrix tileMatrix;
         tileMatrix.setRectToRect(fTile, SkRect::MakeIWH(tileSize.width(), tileSize.height()),
                                  SkMatrix::kFill_ScaleToFit);
 
-        sk_sp<SkImage> tileImage = SkImage::MakeFromPicture(fPicture, tileSize, &tileMatrix,
-                                                            nullptr, bitDepth, std::move(imgCS));
+        sk_sp<SkImage> tileImage;
+        size_t pixelBytes = 0;
+        if (rasterTile) {
+            SkColorType colorType = bitDepth == SkImage::BitDepth::kF16 ? kRGBA_F16_SkColorType
+                                                                        : kN32_SkColorType;
+            SkImageInfo info = SkImageInfo::Make(tileSize.width(), tileSize.height(), colorType,
+                                                 kPremul_SkAlphaType, imgCS);
+            tileImage = rasterize_tile(fPicture, info, tileMatrix);
+            pixelBytes = info.computeMinByteSize();
+        } else {
+            tileImage = SkImage::MakeFromPicture(fPicture, tileSize, &tileMatrix, nullptr,
+                                                 bitDepth, imgCS);
+        }
         if (!tileImage) {
             return nullptr;
         }
 
         tileShader = tileImage->makeShader(fTmx, fTmy);
 
-        SkResourceCache::Add(new BitmapShaderRec(key, tileShader.get()));
+        SkResourceCache::Add(new BitmapShaderRec(key, tileShader.get(), pixelBytes));
         fAddedToCache.store(true);
+
+        SkAutoMutexAcquire lock(fCachedTilesMutex);
+        if (fCachedTiles.count() == kMaxRememberedTiles) {
+            fCachedTiles.removeShuffle(0);
+        }
+        fCachedTiles.push_back({imgCS->toXYZD50Hash(), imgCS->transferFnHash(), bitDepth,
+                                rasterTile, tileSize, tileScale});
     }
 
     if (tileScale.width() != 1 || tileScale.height() != 1) {
@@ -254,12 +328,55 @@ sk_sp<SkShader> SkPictureShader::refBitmapShader(const SkMatrix& viewMatrix,
     return tileShader;
 }
 
+bool SkPictureShader::findNearbyTile(SkColorSpace* colorSpace, SkImage::BitDepth bitDepth,
+                                     bool rasterTile, const SkISize& tileSize, int maxTextureSize,
+                                     sk_sp<SkShader>* tileShader, SkSize* tileScale) const {
+    const uint32_t xyzHash = colorSpace->toXYZD50Hash(),
+                   transferFnHash = colorSpace->transferFnHash();
+    const int maxWidth  = SkScalarFloorToInt(tileSize.width()  * kMaxTileReuseRatio),
+              maxHeight = SkScalarFloorToInt(tileSize.height() * kMaxTileReuseRatio);
+
+    SkAutoMutexAcquire lock(fCachedTilesMutex);
+    for (;;) {
+        // Pick the smallest remembered tile that is at least as big as the one we want.
+        int best = -1;
+        for (int i = 0; i < fCachedTiles.count(); ++i) {
+            const CachedTile& tile = fCachedTiles[i];
+            if (tile.fColorSpaceXYZHash != xyzHash ||
+                tile.fColorSpaceTransferFnHash != transferFnHash ||
+                tile.fBitDepth != bitDepth || tile.fRasterTile != rasterTile ||
+                tile.fSize.width()  < tileSize.width()  || tile.fSize.width()  > maxWidth ||
+                tile.fSize.height() < tileSize.height() || tile.fSize.height() > maxHeight ||
+                (maxTextureSize && (tile.fSize.width()  > maxTextureSize ||
+                                    tile.fSize.height() > maxTextureSize))) {
+                continue;
+            }
+            if (best < 0 || tile.fSize.width() < fCachedTiles[best].fSize.width()) {
+                best = i;
+            }
+        }
+        if (best < 0) {
+            return false;
+        }
+
+        BitmapShaderKey key(colorSpace, bitDepth, rasterTile, fUniqueID,
+                            fCachedTiles[best].fScale);
+        if (SkResourceCache::Find(key, BitmapShaderRec::Visitor, tileShader)) {
+            *tileScale = fCachedTiles[best].fScale;
+            return true;
+        }
+        // The tile has been purged from the cache; forget it and look again.
+        fCachedTiles.removeShuffle(best);
+    }
+}
+
 bool SkPictureShader::onAppendStages(const StageRec& rec) const {
     auto lm = this->totalLocalMatrix(rec.fLocalM);
 
     // Keep bitmapShader alive by using alloc instead of stack memory
     auto& bitmapShader = *rec.fAlloc->make<sk_sp<SkShader>>();
-    bitmapShader = this->refBitmapShader(rec.fCTM, &lm, rec.fDstColorType, rec.fDstCS);
+    bitmapShader = this->refBitmapShader(rec.fCTM, &lm, rec.fDstColorType, rec.fDstCS,
+                                         /*rasterTile=*/true);
 
     if (!bitmapShader) {
         return false;
@@ -278,7 +395,8 @@ SkShaderBase::Context* SkPictureShader::onMakeContext(const ContextRec& rec, SkA
 const {
     auto lm = this->totalLocalMatrix(rec.fLocalMatrix);
     sk_sp<SkShader> bitmapShader = this->refBitmapShader(*rec.fMatrix, &lm, rec.fDstColorType,
-                                                         rec.fDstColorSpace);
+                                                         rec.fDstColorSpace,
+                                                         /*rasterTile=*/true);
     if (!bitmapShader) {
         return nullptr;
     }
@@ -343,7 +461,7 @@ std::unique_ptr<GrFragmentProcessor> SkPictureShader::asFragmentProcessor(
     GrPixelConfigToColorType(args.fDstColorSpaceInfo->config(), &dstColorType);
     sk_sp<SkShader> bitmapShader(this->refBitmapShader(*args.fViewMatrix, &lm, dstColorType,
                                                        args.fDstColorSpaceInfo->colorSpace(),
-                                                       maxTextureSize));
+                                                       /*rasterTile=*/false, maxTextureSize));
     if (!bitmapShader) {
         return nullptr;
     }
@@ -8,7 +8,10 @@
 #ifndef SkPictureShader_DEFINED
 #define SkPictureShader_DEFINED
 
+#include "SkImage.h"
+#include "SkMutex.h"
 #include "SkShaderBase.h"
+#include "SkTArray.h"
 #include <atomic>
 
 class SkArenaAlloc;
@@ -47,9 +50,15 @@ private:
     SkPictureShader(sk_sp<SkPicture>, TileMode, TileMode, const SkMatrix*, const SkRect*,
                     sk_sp<SkColorSpace>);
 
+    // Raster tiles are rasterized up front (in parallel when large); other tiles are lazy
+    // picture-backed images, which the GPU backend renders directly into a texture.
     sk_sp<SkShader> refBitmapShader(const SkMatrix&, SkTCopyOnFirstWrite<SkMatrix>* localMatrix,
                                     SkColorType dstColorType, SkColorSpace* dstColorSpace,
-                                    const int maxTextureSize = 0) const;
+                                    bool rasterTile, const int maxTextureSize = 0) const;
+
+    // Looks for a cached tile slightly larger than tileSize that can be drawn in its place.
+    bool findNearbyTile(SkColorSpace*, SkImage::BitDepth, bool rasterTile, const SkISize& tileSize,
+                        int maxTextureSize, sk_sp<SkShader>* tileShader, SkSize* tileScale) const;
 
     class PictureShaderContext : public Context {
     public:
@@ -78,6 +87,18 @@ private:
     const uint32_t            fUniqueID;
     mutable std::atomic<bool> fAddedToCache;
 
+    // The tiles this shader has added to SkResourceCache, so a nearby scale can find them.
+    struct CachedTile {
+        uint32_t          fColorSpaceXYZHash;
+        uint32_t          fColorSpaceTransferFnHash;
+        SkImage::BitDepth fBitDepth;
+        bool              fRasterTile;
+        SkISize           fSize;
+        SkSize            fScale;
+    };
+    mutable SkMutex                fCachedTilesMutex;
+    mutable SkTArray<CachedTile>   fCachedTiles;
+
     typedef SkShaderBase INHERITED;
 };
 
@@ -288,6 +288,11 @@ bool SkGradientShaderBase::onAppendStages(const StageRec& rec) const {
     p->append_matrix(alloc, matrix);
     this->appendGradientStages(alloc, p, &postPipeline);
 
+    // Three stops with the middle one strictly inside (0,1) have no hard stops at the ends, so
+    // t can be clamped and the interval picked with a select rather than a gather.
+    const bool threeStop = fColorCount == 3 &&
+                           (!fOrigPos || (fOrigPos[1] > 0 && fOrigPos[1] < 1));
+
     switch(fTileMode) {
         case kMirror_TileMode: p->append(SkRasterPipeline::mirror_x_1); break;
         case kRepeat_TileMode: p->append(SkRasterPipeline::repeat_x_1); break;
@@ -298,8 +303,8 @@ bool SkGradientShaderBase::onAppendStages(const StageRec& rec) const {
             p->append(SkRasterPipeline::decal_x, decal_ctx);
             // fall-through to clamp
         case kClamp_TileMode:
-            if (!fOrigPos) {
-                // We clamp only when the stops are evenly spaced.
+            if (!fOrigPos || threeStop) {
+                // We clamp only when the stops are evenly spaced (or there are just three).
                 // If not, there may be hard stops, and clamping ruins hard stops at 0 and/or 1.
                 // In that case, we must make sure we're using the general "gradient" stage,
                 // which is the only stage that will correctly handle unclamped t.
@@ -331,6 +336,23 @@ bool SkGradientShaderBase::onAppendStages(const StageRec& rec) const {
         ctx->interpolatedInPremul = premulGrad;
 
         p->append(SkRasterPipeline::evenly_spaced_2_stop_gradient, ctx);
+    } else if (threeStop) {
+        const SkPMColor4f c_0 = prepareColor(0),
+                          c_1 = prepareColor(1),
+                          c_2 = prepareColor(2);
+        const float t_mid = fOrigPos ? fOrigPos[1] : 0.5f;
+
+        auto ctx = alloc->make<SkRasterPipeline_3StopGradientCtx>();
+        Sk4f f0 = (Sk4f::Load(c_1.vec()) - Sk4f::Load(c_0.vec())) * (1 / t_mid),
+             f1 = (Sk4f::Load(c_2.vec()) - Sk4f::Load(c_1.vec())) * (1 / (1 - t_mid));
+        f0.store(ctx->f[0]);
+        f1.store(ctx->f[1]);
+        Sk4f::Load(c_0.vec()).store(ctx->b[0]);
+        (Sk4f::Load(c_1.vec()) - f1 * t_mid).store(ctx->b[1]);
+        ctx->t_mid = t_mid;
+        ctx->interpolatedInPremul = premulGrad;
+
+        p->append(SkRasterPipeline::three_stop_gradient, ctx);
     } else {
         auto* ctx = alloc->make<SkRasterPipeline_GradientCtx>();
         ctx->interpolatedInPremul = premulGrad;
@@ -338,9 +360,9 @@ bool SkGradientShaderBase::onAppendStages(const StageRec& rec) const {
         // Note: In order to handle clamps in search, the search assumes a stop conceptully placed
         // at -inf. Therefore, the max number of stops is fColorCount+1.
         for (int i = 0; i < 4; i++) {
-            // Allocate at least at for the AVX2 gather from a YMM register.
-            ctx->fs[i] = alloc->makeArray<float>(std::max(fColorCount+1, 8));
-            ctx->bs[i] = alloc->makeArray<float>(std::max(fColorCount+1, 8));
+            // Allocate at least enough for the AVX-512 permute from a ZMM register.
+            ctx->fs[i] = alloc->makeArray<float>(std::max(fColorCount+1, 16));
+            ctx->bs[i] = alloc->makeArray<float>(std::max(fColorCount+1, 16));
         }
 
         if (fOrigPos == nullptr) {
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SKSL_BYTECODE
+#define SKSL_BYTECODE
+
+#include "ir/SkSLFunctionDeclaration.h"
+
+#include <memory>
+#include <vector>
+
+namespace SkSL {
+
+/**
+ * Instructions for SkSL::Interpreter. Every value on the interpreter's stack is a vector of lanes,
+ * so each instruction operates on all lanes at once. Bools are lane masks: ~0 for true, 0 for
+ * false.
+ *
+ * Suffixes give the operand type: B = bool, F = float, I = integer (signed or unsigned),
+ * S = signed integer, U = unsigned integer. Operands that follow the opcode in the code stream
+ * are listed in angle brackets.
+ */
+enum class ByteCodeInstruction : uint8_t {
+    kAddF,
+    kAddI,
+    kAndB,
+    // <stage: u8> appends a stage with no context to the interpreter's pipeline
+    kAppendStage,
+    // <function: u8> appends a callback stage that runs the function over each pixel's r, g, b
+    kAppendCallback,
+    // <target: u16>
+    kBranch,
+    // <target: u16> branches when no lane is active
+    kBranchIfAllFalse,
+    // <function: u8> arguments are on the stack, replaced by the result if there is one
+    kCall,
+    kCompareFEQ,
+    kCompareFGT,
+    kCompareFGTEQ,
+    kCompareFLT,
+    kCompareFLTEQ,
+    kCompareFNEQ,
+    kCompareIEQ,
+    kCompareINEQ,
+    kCompareSGT,
+    kCompareSGTEQ,
+    kCompareSLT,
+    kCompareSLTEQ,
+    kCompareUGT,
+    kCompareUGTEQ,
+    kCompareULT,
+    kCompareULTEQ,
+    kConvertFtoS,
+    kConvertFtoU,
+    kConvertStoF,
+    kConvertUtoF,
+    kDivideF,
+    kDivideS,
+    kDivideU,
+    kDup,
+    // <slot: u16>
+    kLoad,
+    // Loops keep a mask of the lanes still looping, and a mask of the lanes that have not yet
+    // continued in this iteration.
+    kLoopBegin,
+    kLoopBreak,
+    kLoopContinue,
+    kLoopEnd,
+    // pops a bool and removes the lanes where it is false from the loop
+    kLoopMask,
+    kLoopNext,
+    // Condition masks nest for if/else and ternaries. kMaskPush pops a bool and narrows the
+    // active lanes to those where it is true; kMaskNegate flips to the else lanes.
+    kMaskNegate,
+    kMaskPop,
+    kMaskPush,
+    kMultiplyF,
+    kMultiplyI,
+    kNegateF,
+    kNegateI,
+    kNotB,
+    kOrB,
+    kPop,
+    // <value: u32> pushes the same bits in every lane
+    kPushImmediate,
+    kRemainderS,
+    kRemainderU,
+    kReturn,
+    // removes the active lanes from the function, after they have stored their result
+    kReturnMask,
+    // pops false, true and test values, and pushes the selected value
+    kSelect,
+    // <slot: u16> writes the active lanes only
+    kStore,
+    kSubtractF,
+    kSubtractI,
+    kXorB,
+};
+
+struct ByteCodeFunction {
+    ByteCodeFunction(const FunctionDeclaration* declaration)
+    : fDeclaration(*declaration) {}
+
+    const FunctionDeclaration& fDeclaration;
+    // Slots for the parameters, followed by the locals and, if the function returns a value, the
+    // slot holding its result.
+    int fParameterCount = 0;
+    int fLocalCount = 0;
+    int fReturnSlot = -1;
+    // Deepest the operand stack, the condition masks and the loops get
+    int fStackCount = 0;
+    int fConditionCount = 0;
+    int fLoopCount = 0;
+    std::vector<uint8_t> fCode;
+
+    int frameSize() const {
+        return fParameterCount + fLocalCount + fStackCount;
+    }
+};
+
+struct ByteCode {
+    const ByteCodeFunction* getFunction(const char* name) const {
+        for (const auto& f : fFunctions) {
+            if (f->fDeclaration.fName == name) {
+                return f.get();
+            }
+        }
+        return nullptr;
+    }
+
+    std::vector<std::unique_ptr<ByteCodeFunction>> fFunctions;
+};
+
+} // namespace
+
+#endif
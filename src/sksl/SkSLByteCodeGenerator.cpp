@@ -0,0 +1,761 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkSLByteCodeGenerator.h"
+
+#include "SkSLCompiler.h"
+#include "ir/SkSLBoolLiteral.h"
+#include "ir/SkSLConstructor.h"
+#include "ir/SkSLFloatLiteral.h"
+#include "ir/SkSLFunctionReference.h"
+#include "ir/SkSLIntLiteral.h"
+#include "ir/SkSLVarDeclarations.h"
+
+#ifndef SKSL_STANDALONE
+#include "ir/SkSLAppendStage.h"
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+namespace SkSL {
+
+ByteCodeGenerator::ByteCodeGenerator(const Context* context, const Program* program,
+                                     ErrorReporter* errors, ByteCode* output)
+: INHERITED(program, errors, nullptr)
+, fContext(*context)
+, fOutput(output)
+, fFunction(nullptr)
+, fCode(nullptr)
+, fStackDepth(0)
+, fConditionDepth(0)
+, fLoopDepth(0) {}
+
+bool ByteCodeGenerator::generateCode() {
+    // Number the functions first, so calls can refer to functions defined after them.
+    std::vector<const FunctionDefinition*> functions;
+    for (const auto& e : fProgram) {
+        switch (e.fKind) {
+            case ProgramElement::kFunction_Kind: {
+                const FunctionDefinition& f = (const FunctionDefinition&) e;
+                fFunctionIndices[&f.fDeclaration] = (int) functions.size();
+                functions.push_back(&f);
+                break;
+            }
+            case ProgramElement::kVar_Kind:
+                // built-in globals such as sk_x only matter if they are used, which is reported
+                // when the reference is written
+                for (const auto& stmt : ((const VarDeclarations&) e).fVars) {
+                    const Variable& var = *((const VarDeclaration&) *stmt).fVar;
+                    if (var.fModifiers.fLayout.fBuiltin == -1) {
+                        fErrors.error(e.fOffset,
+                                      "global variables are not supported by the interpreter");
+                        break;
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    if (functions.size() > 256) {
+        fErrors.error(0, "too many functions for the interpreter");
+        return false;
+    }
+    for (const FunctionDefinition* f : functions) {
+        fOutput->fFunctions.push_back(this->writeFunction(*f));
+    }
+    return 0 == fErrors.errorCount();
+}
+
+static int slot_count(const Type& type) {
+    return 1;
+}
+
+std::unique_ptr<ByteCodeFunction> ByteCodeGenerator::writeFunction(const FunctionDefinition& f) {
+    std::unique_ptr<ByteCodeFunction> result(new ByteCodeFunction(&f.fDeclaration));
+    fFunction = result.get();
+    fCode = &result->fCode;
+    fLocals.clear();
+    fStackDepth = 0;
+    fConditionDepth = 0;
+    fLoopDepth = 0;
+
+    for (const Variable* p : f.fDeclaration.fParameters) {
+        if (this->checkScalar(p->fOffset, p->fType)) {
+            fLocals[p] = result->fParameterCount;
+            result->fParameterCount += slot_count(p->fType);
+        }
+    }
+    if (f.fDeclaration.fReturnType != *fContext.fVoid_Type &&
+        this->checkScalar(f.fOffset, f.fDeclaration.fReturnType)) {
+        result->fReturnSlot = result->fParameterCount;
+        result->fLocalCount = slot_count(f.fDeclaration.fReturnType);
+    }
+
+    this->writeStatement(*f.fBody);
+    this->write(ByteCodeInstruction::kReturn);
+    SkASSERT(0 == fStackDepth);
+    fFunction = nullptr;
+    fCode = nullptr;
+    return result;
+}
+
+void ByteCodeGenerator::write8(uint8_t b) {
+    fCode->push_back(b);
+}
+
+void ByteCodeGenerator::write16(uint16_t i) {
+    size_t n = fCode->size();
+    fCode->resize(n + sizeof(i));
+    memcpy(fCode->data() + n, &i, sizeof(i));
+}
+
+void ByteCodeGenerator::write32(uint32_t i) {
+    size_t n = fCode->size();
+    fCode->resize(n + sizeof(i));
+    memcpy(fCode->data() + n, &i, sizeof(i));
+}
+
+// How each instruction changes the depth of the operand stack. kCall depends on the callee and is
+// accounted for by writeFunctionCall.
+static int stack_effect(ByteCodeInstruction inst) {
+    switch (inst) {
+        case ByteCodeInstruction::kAddF:
+        case ByteCodeInstruction::kAddI:
+        case ByteCodeInstruction::kAndB:
+        case ByteCodeInstruction::kCompareFEQ:
+        case ByteCodeInstruction::kCompareFGT:
+        case ByteCodeInstruction::kCompareFGTEQ:
+        case ByteCodeInstruction::kCompareFLT:
+        case ByteCodeInstruction::kCompareFLTEQ:
+        case ByteCodeInstruction::kCompareFNEQ:
+        case ByteCodeInstruction::kCompareIEQ:
+        case ByteCodeInstruction::kCompareINEQ:
+        case ByteCodeInstruction::kCompareSGT:
+        case ByteCodeInstruction::kCompareSGTEQ:
+        case ByteCodeInstruction::kCompareSLT:
+        case ByteCodeInstruction::kCompareSLTEQ:
+        case ByteCodeInstruction::kCompareUGT:
+        case ByteCodeInstruction::kCompareUGTEQ:
+        case ByteCodeInstruction::kCompareULT:
+        case ByteCodeInstruction::kCompareULTEQ:
+        case ByteCodeInstruction::kDivideF:
+        case ByteCodeInstruction::kDivideS:
+        case ByteCodeInstruction::kDivideU:
+        case ByteCodeInstruction::kLoopMask:
+        case ByteCodeInstruction::kMaskPush:
+        case ByteCodeInstruction::kMultiplyF:
+        case ByteCodeInstruction::kMultiplyI:
+        case ByteCodeInstruction::kOrB:
+        case ByteCodeInstruction::kPop:
+        case ByteCodeInstruction::kRemainderS:
+        case ByteCodeInstruction::kRemainderU:
+        case ByteCodeInstruction::kStore:
+        case ByteCodeInstruction::kSubtractF:
+        case ByteCodeInstruction::kSubtractI:
+        case ByteCodeInstruction::kXorB:
+            return -1;
+        case ByteCodeInstruction::kDup:
+        case ByteCodeInstruction::kLoad:
+        case ByteCodeInstruction::kPushImmediate:
+            return 1;
+        case ByteCodeInstruction::kSelect:
+            return -2;
+        default:
+            return 0;
+    }
+}
+
+void ByteCodeGenerator::write(ByteCodeInstruction inst) {
+    this->write8((uint8_t) inst);
+    this->adjustStack(stack_effect(inst));
+    switch (inst) {
+        case ByteCodeInstruction::kLoopBegin:
+            fFunction->fLoopCount = std::max(fFunction->fLoopCount, ++fLoopDepth);
+            break;
+        case ByteCodeInstruction::kLoopEnd:
+            --fLoopDepth;
+            break;
+        case ByteCodeInstruction::kMaskPush:
+            fFunction->fConditionCount = std::max(fFunction->fConditionCount, ++fConditionDepth);
+            break;
+        case ByteCodeInstruction::kMaskPop:
+            --fConditionDepth;
+            break;
+        default:
+            break;
+    }
+}
+
+void ByteCodeGenerator::adjustStack(int delta) {
+    fStackDepth += delta;
+    SkASSERT(fStackDepth >= 0);
+    fFunction->fStackCount = std::max(fFunction->fStackCount, fStackDepth);
+}
+
+int ByteCodeGenerator::writeBranch(ByteCodeInstruction inst) {
+    this->write(inst);
+    int location = (int) fCode->size();
+    this->write16(0);
+    return location;
+}
+
+void ByteCodeGenerator::patchBranch(int location) {
+    if (fCode->size() > 0xFFFF) {
+        fErrors.error(0, "function is too large for the interpreter");
+        return;
+    }
+    uint16_t target = (uint16_t) fCode->size();
+    memcpy(fCode->data() + location, &target, sizeof(target));
+}
+
+void ByteCodeGenerator::writeBranchTo(ByteCodeInstruction inst, int target) {
+    this->write(inst);
+    this->write16((uint16_t) target);
+}
+
+int ByteCodeGenerator::getLocation(const Variable& var) {
+    auto found = fLocals.find(&var);
+    if (found != fLocals.end()) {
+        return found->second;
+    }
+    if (var.fStorage != Variable::kLocal_Storage) {
+        fErrors.error(var.fOffset, "only parameters and local variables are supported by the "
+                                   "interpreter");
+        return 0;
+    }
+    int slot = fFunction->fParameterCount + fFunction->fLocalCount;
+    if (slot + slot_count(var.fType) > 0xFFFF) {
+        fErrors.error(var.fOffset, "too many variables for the interpreter");
+        return 0;
+    }
+    fFunction->fLocalCount += slot_count(var.fType);
+    fLocals[&var] = slot;
+    return slot;
+}
+
+bool ByteCodeGenerator::checkScalar(int offset, const Type& type) {
+    if (type.kind() != Type::kScalar_Kind) {
+        fErrors.error(offset, "type '" + type.description() + "' is not supported by the "
+                              "interpreter");
+        return false;
+    }
+    return true;
+}
+
+void ByteCodeGenerator::writeTypedInstruction(const Type& type, ByteCodeInstruction f,
+                                              ByteCodeInstruction s, ByteCodeInstruction u) {
+    if (type.isFloat()) {
+        this->write(f);
+    } else if (type.isSigned() || !type.isNumber()) {
+        this->write(s);
+    } else {
+        this->write(u);
+    }
+}
+
+void ByteCodeGenerator::writeStatement(const Statement& s) {
+    switch (s.fKind) {
+        case Statement::kBlock_Kind:
+            this->writeBlock((const Block&) s);
+            break;
+        case Statement::kBreak_Kind:
+            this->write(ByteCodeInstruction::kLoopBreak);
+            break;
+        case Statement::kContinue_Kind:
+            this->write(ByteCodeInstruction::kLoopContinue);
+            break;
+        case Statement::kDo_Kind:
+            this->writeDoStatement((const DoStatement&) s);
+            break;
+        case Statement::kExpression_Kind:
+            this->writeExpression(*((const ExpressionStatement&) s).fExpression, true);
+            break;
+        case Statement::kFor_Kind:
+            this->writeForStatement((const ForStatement&) s);
+            break;
+        case Statement::kIf_Kind:
+            this->writeIfStatement((const IfStatement&) s);
+            break;
+        case Statement::kNop_Kind:
+            break;
+        case Statement::kReturn_Kind:
+            this->writeReturnStatement((const ReturnStatement&) s);
+            break;
+        case Statement::kVarDeclarations_Kind:
+            this->writeVarDeclarations(*((const VarDeclarationsStatement&) s).fDeclaration);
+            break;
+        case Statement::kWhile_Kind:
+            this->writeWhileStatement((const WhileStatement&) s);
+            break;
+        default:
+            fErrors.error(s.fOffset, "statement is not supported by the interpreter");
+            break;
+    }
+}
+
+void ByteCodeGenerator::writeBlock(const Block& b) {
+    for (const auto& s : b.fStatements) {
+        this->writeStatement(*s);
+    }
+}
+
+void ByteCodeGenerator::writeVarDeclarations(const VarDeclarations& decls) {
+    for (const auto& declStatement : decls.fVars) {
+        const VarDeclaration& decl = (const VarDeclaration&) *declStatement;
+        if (!decl.fSizes.empty()) {
+            fErrors.error(decl.fOffset, "arrays are not supported by the interpreter");
+            continue;
+        }
+        if (!this->checkScalar(decl.fOffset, decl.fVar->fType)) {
+            continue;
+        }
+        int slot = this->getLocation(*decl.fVar);
+        if (decl.fValue) {
+            this->writeExpression(*decl.fValue);
+            this->write(ByteCodeInstruction::kStore);
+            this->write16(slot);
+        }
+    }
+}
+
+void ByteCodeGenerator::writeIfStatement(const IfStatement& s) {
+    this->writeExpression(*s.fTest);
+    this->write(ByteCodeInstruction::kMaskPush);
+    int skipTrue = this->writeBranch(ByteCodeInstruction::kBranchIfAllFalse);
+    this->writeStatement(*s.fIfTrue);
+    this->patchBranch(skipTrue);
+    if (s.fIfFalse) {
+        this->write(ByteCodeInstruction::kMaskNegate);
+        int skipFalse = this->writeBranch(ByteCodeInstruction::kBranchIfAllFalse);
+        this->writeStatement(*s.fIfFalse);
+        this->patchBranch(skipFalse);
+    }
+    this->write(ByteCodeInstruction::kMaskPop);
+}
+
+// Loops run until every lane has left, either by failing the test or by breaking. Lanes that
+// continue sit out the rest of the body, and rejoin for the next expression.
+void ByteCodeGenerator::writeForStatement(const ForStatement& f) {
+    if (f.fInitializer) {
+        this->writeStatement(*f.fInitializer);
+    }
+    this->write(ByteCodeInstruction::kLoopBegin);
+    int top = (int) fCode->size();
+    int exit = -1;
+    if (f.fTest) {
+        this->writeExpression(*f.fTest);
+        this->write(ByteCodeInstruction::kLoopMask);
+    }
+    exit = this->writeBranch(ByteCodeInstruction::kBranchIfAllFalse);
+    this->writeStatement(*f.fStatement);
+    this->write(ByteCodeInstruction::kLoopNext);
+    if (f.fNext) {
+        this->writeExpression(*f.fNext, true);
+    }
+    this->writeBranchTo(ByteCodeInstruction::kBranch, top);
+    this->patchBranch(exit);
+    this->write(ByteCodeInstruction::kLoopEnd);
+}
+
+void ByteCodeGenerator::writeWhileStatement(const WhileStatement& w) {
+    this->write(ByteCodeInstruction::kLoopBegin);
+    int top = (int) fCode->size();
+    this->writeExpression(*w.fTest);
+    this->write(ByteCodeInstruction::kLoopMask);
+    int exit = this->writeBranch(ByteCodeInstruction::kBranchIfAllFalse);
+    this->writeStatement(*w.fStatement);
+    this->write(ByteCodeInstruction::kLoopNext);
+    this->writeBranchTo(ByteCodeInstruction::kBranch, top);
+    this->patchBranch(exit);
+    this->write(ByteCodeInstruction::kLoopEnd);
+}
+
+void ByteCodeGenerator::writeDoStatement(const DoStatement& d) {
+    this->write(ByteCodeInstruction::kLoopBegin);
+    int top = (int) fCode->size();
+    this->writeStatement(*d.fStatement);
+    this->write(ByteCodeInstruction::kLoopNext);
+    this->writeExpression(*d.fTest);
+    this->write(ByteCodeInstruction::kLoopMask);
+    int exit = this->writeBranch(ByteCodeInstruction::kBranchIfAllFalse);
+    this->writeBranchTo(ByteCodeInstruction::kBranch, top);
+    this->patchBranch(exit);
+    this->write(ByteCodeInstruction::kLoopEnd);
+}
+
+void ByteCodeGenerator::writeReturnStatement(const ReturnStatement& r) {
+    if (r.fExpression) {
+        this->writeExpression(*r.fExpression);
+        SkASSERT(fFunction->fReturnSlot >= 0);
+        this->write(ByteCodeInstruction::kStore);
+        this->write16(fFunction->fReturnSlot);
+    }
+    this->write(ByteCodeInstruction::kReturnMask);
+}
+
+void ByteCodeGenerator::writeExpression(const Expression& e, bool discard) {
+    switch (e.fKind) {
+        case Expression::kBinary_Kind:
+            this->writeBinaryExpression((const BinaryExpression&) e, discard);
+            return;
+        case Expression::kPrefix_Kind:
+            this->writePrefixExpression((const PrefixExpression&) e, discard);
+            return;
+        case Expression::kPostfix_Kind:
+            this->writePostfixExpression((const PostfixExpression&) e, discard);
+            return;
+        case Expression::kBoolLiteral_Kind:
+            this->write(ByteCodeInstruction::kPushImmediate);
+            this->write32(((const BoolLiteral&) e).fValue ? ~0 : 0);
+            break;
+        case Expression::kIntLiteral_Kind:
+            this->write(ByteCodeInstruction::kPushImmediate);
+            this->write32((uint32_t) ((const IntLiteral&) e).fValue);
+            break;
+        case Expression::kFloatLiteral_Kind: {
+            float value = (float) ((const FloatLiteral&) e).fValue;
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            this->write(ByteCodeInstruction::kPushImmediate);
+            this->write32(bits);
+            break;
+        }
+        case Expression::kVariableReference_Kind: {
+            const Variable& var = ((const VariableReference&) e).fVariable;
+            if (!this->checkScalar(e.fOffset, var.fType)) {
+                return;
+            }
+            int slot = this->getLocation(var);
+            this->write(ByteCodeInstruction::kLoad);
+            this->write16(slot);
+            break;
+        }
+        case Expression::kConstructor_Kind:
+            this->writeConstructor((const Constructor&) e);
+            break;
+        case Expression::kFunctionCall_Kind:
+            this->writeFunctionCall((const FunctionCall&) e);
+            break;
+        case Expression::kTernary_Kind:
+            this->writeTernaryExpression((const TernaryExpression&) e);
+            break;
+#ifndef SKSL_STANDALONE
+        case Expression::kAppendStage_Kind:
+            this->writeAppendStage((const AppendStage&) e);
+            break;
+#endif
+        default:
+            fErrors.error(e.fOffset, "expression is not supported by the interpreter");
+            return;
+    }
+    if (discard && e.fType != *fContext.fVoid_Type) {
+        this->write(ByteCodeInstruction::kPop);
+    }
+}
+
+void ByteCodeGenerator::writeStore(const Expression& lvalue, bool discard) {
+    if (lvalue.fKind != Expression::kVariableReference_Kind) {
+        fErrors.error(lvalue.fOffset, "only variables can be assigned to in the interpreter");
+        return;
+    }
+    const Variable& var = ((const VariableReference&) lvalue).fVariable;
+    if (!discard) {
+        this->write(ByteCodeInstruction::kDup);
+    }
+    this->write(ByteCodeInstruction::kStore);
+    this->write16(this->getLocation(var));
+}
+
+void ByteCodeGenerator::writeComparison(const Type& operandType, Token::Kind op) {
+    using I = ByteCodeInstruction;
+    switch (op) {
+        case Token::EQEQ:
+            operandType.isFloat() ? this->write(I::kCompareFEQ) : this->write(I::kCompareIEQ);
+            break;
+        case Token::NEQ:
+            operandType.isFloat() ? this->write(I::kCompareFNEQ) : this->write(I::kCompareINEQ);
+            break;
+        case Token::LT:
+            this->writeTypedInstruction(operandType, I::kCompareFLT, I::kCompareSLT,
+                                        I::kCompareULT);
+            break;
+        case Token::LTEQ:
+            this->writeTypedInstruction(operandType, I::kCompareFLTEQ, I::kCompareSLTEQ,
+                                        I::kCompareULTEQ);
+            break;
+        case Token::GT:
+            this->writeTypedInstruction(operandType, I::kCompareFGT, I::kCompareSGT,
+                                        I::kCompareUGT);
+            break;
+        case Token::GTEQ:
+            this->writeTypedInstruction(operandType, I::kCompareFGTEQ, I::kCompareSGTEQ,
+                                        I::kCompareUGTEQ);
+            break;
+        default:
+            SkASSERT(false);
+    }
+}
+
+void ByteCodeGenerator::writeArithmetic(int offset, const Type& type, Token::Kind op) {
+    using I = ByteCodeInstruction;
+    switch (op) {
+        case Token::PLUS:
+            this->writeTypedInstruction(type, I::kAddF, I::kAddI, I::kAddI);
+            break;
+        case Token::MINUS:
+            this->writeTypedInstruction(type, I::kSubtractF, I::kSubtractI, I::kSubtractI);
+            break;
+        case Token::STAR:
+            this->writeTypedInstruction(type, I::kMultiplyF, I::kMultiplyI, I::kMultiplyI);
+            break;
+        case Token::SLASH:
+            this->writeTypedInstruction(type, I::kDivideF, I::kDivideS, I::kDivideU);
+            break;
+        case Token::PERCENT:
+            if (type.isFloat()) {
+                fErrors.error(offset, "'%' is not supported for floats by the interpreter");
+                return;
+            }
+            this->writeTypedInstruction(type, I::kRemainderS, I::kRemainderS, I::kRemainderU);
+            break;
+        case Token::BITWISEAND:
+        case Token::LOGICALAND:
+            this->write(I::kAndB);
+            break;
+        case Token::BITWISEOR:
+        case Token::LOGICALOR:
+            this->write(I::kOrB);
+            break;
+        case Token::BITWISEXOR:
+        case Token::LOGICALXOR:
+            this->write(I::kXorB);
+            break;
+        default:
+            fErrors.error(offset, String("operator '") + Compiler::OperatorName(op) +
+                                  "' is not supported by the interpreter");
+            break;
+    }
+}
+
+void ByteCodeGenerator::writeBinaryExpression(const BinaryExpression& b, bool discard) {
+    const Type& operandType = b.fLeft->fType;
+    if (!this->checkScalar(b.fOffset, operandType) ||
+        !this->checkScalar(b.fOffset, b.fRight->fType)) {
+        return;
+    }
+    switch (b.fOperator) {
+        case Token::EQ:
+            this->writeExpression(*b.fRight);
+            this->writeStore(*b.fLeft, discard);
+            return;
+        case Token::COMMA:
+            this->writeExpression(*b.fLeft, true);
+            this->writeExpression(*b.fRight, discard);
+            return;
+        case Token::LOGICALAND:
+        case Token::LOGICALOR:
+            // The right side only runs in the lanes where the left side doesn't decide the result.
+            this->writeExpression(*b.fLeft);
+            this->write(ByteCodeInstruction::kDup);
+            if (Token::LOGICALOR == b.fOperator) {
+                this->write(ByteCodeInstruction::kNotB);
+            }
+            this->write(ByteCodeInstruction::kMaskPush);
+            this->writeExpression(*b.fRight);
+            this->write(ByteCodeInstruction::kMaskPop);
+            this->writeArithmetic(b.fOffset, operandType, b.fOperator);
+            break;
+        case Token::EQEQ:
+        case Token::NEQ:
+        case Token::LT:
+        case Token::LTEQ:
+        case Token::GT:
+        case Token::GTEQ:
+            this->writeExpression(*b.fLeft);
+            this->writeExpression(*b.fRight);
+            this->writeComparison(operandType, b.fOperator);
+            break;
+        default: {
+            Token::Kind op = remove_assignment(b.fOperator);
+            this->writeExpression(*b.fLeft);
+            this->writeExpression(*b.fRight);
+            this->writeArithmetic(b.fOffset, operandType, op);
+            if (op != b.fOperator) {
+                this->writeStore(*b.fLeft, discard);
+                return;
+            }
+            break;
+        }
+    }
+    if (discard) {
+        this->write(ByteCodeInstruction::kPop);
+    }
+}
+
+void ByteCodeGenerator::writeConstructor(const Constructor& c) {
+    if (c.fArguments.size() != 1 || !this->checkScalar(c.fOffset, c.fType) ||
+        !this->checkScalar(c.fOffset, c.fArguments[0]->fType)) {
+        fErrors.error(c.fOffset, "only scalar conversions are supported by the interpreter");
+        return;
+    }
+    const Type& from = c.fArguments[0]->fType;
+    const Type& to = c.fType;
+    this->writeExpression(*c.fArguments[0]);
+    if (!from.isNumber()) {
+        if (!to.isNumber()) {
+            return;
+        }
+        // true is ~0; keep the low bit to get 1.
+        this->write(ByteCodeInstruction::kPushImmediate);
+        this->write32(1);
+        this->write(ByteCodeInstruction::kAndB);
+        if (to.isFloat()) {
+            this->write(ByteCodeInstruction::kConvertStoF);
+        }
+    } else if (!to.isNumber()) {
+        // 0.0 and 0 have the same bits.
+        this->write(ByteCodeInstruction::kPushImmediate);
+        this->write32(0);
+        this->write(from.isFloat() ? ByteCodeInstruction::kCompareFNEQ
+                                   : ByteCodeInstruction::kCompareINEQ);
+    } else if (from.isFloat() && !to.isFloat()) {
+        this->write(to.isSigned() ? ByteCodeInstruction::kConvertFtoS
+                                  : ByteCodeInstruction::kConvertFtoU);
+    } else if (!from.isFloat() && to.isFloat()) {
+        this->write(from.isSigned() ? ByteCodeInstruction::kConvertStoF
+                                    : ByteCodeInstruction::kConvertUtoF);
+    }
+}
+
+void ByteCodeGenerator::writeFunctionCall(const FunctionCall& c) {
+    auto found = fFunctionIndices.find(&c.fFunction);
+    if (found == fFunctionIndices.end()) {
+        fErrors.error(c.fOffset, String("function '") + c.fFunction.fName +
+                                 "' is not supported by the interpreter");
+        return;
+    }
+    int argumentSlots = 0;
+    for (size_t i = 0; i < c.fArguments.size(); ++i) {
+        if (c.fFunction.fParameters[i]->fModifiers.fFlags & Modifiers::kOut_Flag) {
+            fErrors.error(c.fArguments[i]->fOffset, "out parameters are not supported by the "
+                                                    "interpreter");
+        }
+        this->writeExpression(*c.fArguments[i]);
+        argumentSlots += slot_count(c.fArguments[i]->fType);
+    }
+    this->write(ByteCodeInstruction::kCall);
+    this->write8(found->second);
+    // The callee's frame sits above the arguments, and is accounted for by the interpreter.
+    bool hasResult = c.fFunction.fReturnType != *fContext.fVoid_Type;
+    this->adjustStack(-argumentSlots + (hasResult ? 1 : 0));
+}
+
+void ByteCodeGenerator::writePrefixExpression(const PrefixExpression& p, bool discard) {
+    if (!this->checkScalar(p.fOffset, p.fType)) {
+        return;
+    }
+    switch (p.fOperator) {
+        case Token::PLUSPLUS:
+        case Token::MINUSMINUS:
+            this->writeExpression(*p.fOperand);
+            this->write(ByteCodeInstruction::kPushImmediate);
+            if (p.fType.isFloat()) {
+                float one = 1;
+                uint32_t bits;
+                memcpy(&bits, &one, sizeof(bits));
+                this->write32(bits);
+            } else {
+                this->write32(1);
+            }
+            this->writeArithmetic(p.fOffset, p.fType,
+                                  Token::PLUSPLUS == p.fOperator ? Token::PLUS : Token::MINUS);
+            this->writeStore(*p.fOperand, discard);
+            return;
+        case Token::MINUS:
+            this->writeExpression(*p.fOperand);
+            this->writeTypedInstruction(p.fType, ByteCodeInstruction::kNegateF,
+                                        ByteCodeInstruction::kNegateI,
+                                        ByteCodeInstruction::kNegateI);
+            break;
+        case Token::PLUS:
+            this->writeExpression(*p.fOperand);
+            break;
+        case Token::LOGICALNOT:
+        case Token::BITWISENOT:
+            this->writeExpression(*p.fOperand);
+            this->write(ByteCodeInstruction::kNotB);
+            break;
+        default:
+            fErrors.error(p.fOffset, "prefix operator is not supported by the interpreter");
+            return;
+    }
+    if (discard) {
+        this->write(ByteCodeInstruction::kPop);
+    }
+}
+
+void ByteCodeGenerator::writePostfixExpression(const PostfixExpression& p, bool discard) {
+    if (!this->checkScalar(p.fOffset, p.fType)) {
+        return;
+    }
+    // Leaves the old value under the new one, unless nobody wants it.
+    this->writeExpression(*p.fOperand);
+    if (!discard) {
+        this->write(ByteCodeInstruction::kDup);
+    }
+    this->write(ByteCodeInstruction::kPushImmediate);
+    if (p.fType.isFloat()) {
+        float one = 1;
+        uint32_t bits;
+        memcpy(&bits, &one, sizeof(bits));
+        this->write32(bits);
+    } else {
+        this->write32(1);
+    }
+    this->writeArithmetic(p.fOffset, p.fType,
+                          Token::PLUSPLUS == p.fOperator ? Token::PLUS : Token::MINUS);
+    this->writeStore(*p.fOperand, true);
+}
+
+void ByteCodeGenerator::writeTernaryExpression(const TernaryExpression& t) {
+    // Each side runs in its own lanes, so side effects stay where they belong.
+    this->writeExpression(*t.fTest);
+    this->write(ByteCodeInstruction::kDup);
+    this->write(ByteCodeInstruction::kMaskPush);
+    this->writeExpression(*t.fIfTrue);
+    this->write(ByteCodeInstruction::kMaskNegate);
+    this->writeExpression(*t.fIfFalse);
+    this->write(ByteCodeInstruction::kMaskPop);
+    this->write(ByteCodeInstruction::kSelect);
+}
+
+#ifndef SKSL_STANDALONE
+void ByteCodeGenerator::writeAppendStage(const AppendStage& a) {
+    if (SkRasterPipeline::callback == a.fStage) {
+        SkASSERT(a.fArguments.size() == 1);
+        const FunctionReference& ref = (const FunctionReference&) *a.fArguments[0];
+        auto found = fFunctionIndices.find(ref.fFunctions[0]);
+        if (found == fFunctionIndices.end()) {
+            fErrors.error(a.fOffset, "callback function must be defined in the program");
+            return;
+        }
+        this->write(ByteCodeInstruction::kAppendCallback);
+        this->write8(found->second);
+        return;
+    }
+    if (!a.fArguments.empty()) {
+        fErrors.error(a.fOffset, "stages with arguments are not supported by the interpreter");
+        return;
+    }
+    this->write(ByteCodeInstruction::kAppendStage);
+    this->write8((uint8_t) a.fStage);
+}
+#endif
+
+} // namespace
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SKSL_BYTECODEGENERATOR
+#define SKSL_BYTECODEGENERATOR
+
+#include "SkSLByteCode.h"
+#include "SkSLCodeGenerator.h"
+#include "ir/SkSLAppendStage.h"
+#include "ir/SkSLBinaryExpression.h"
+#include "ir/SkSLBlock.h"
+#include "ir/SkSLConstructor.h"
+#include "ir/SkSLDoStatement.h"
+#include "ir/SkSLExpressionStatement.h"
+#include "ir/SkSLForStatement.h"
+#include "ir/SkSLFunctionCall.h"
+#include "ir/SkSLFunctionDefinition.h"
+#include "ir/SkSLIfStatement.h"
+#include "ir/SkSLPostfixExpression.h"
+#include "ir/SkSLPrefixExpression.h"
+#include "ir/SkSLProgram.h"
+#include "ir/SkSLReturnStatement.h"
+#include "ir/SkSLTernaryExpression.h"
+#include "ir/SkSLVarDeclarationsStatement.h"
+#include "ir/SkSLVariableReference.h"
+#include "ir/SkSLWhileStatement.h"
+
+#include <unordered_map>
+
+namespace SkSL {
+
+/**
+ * Translates a Program into ByteCode for SkSL::Interpreter. Only scalar bool, int and float
+ * values are supported; anything else is reported as an error.
+ */
+class ByteCodeGenerator : public CodeGenerator {
+public:
+    ByteCodeGenerator(const Context* context, const Program* program, ErrorReporter* errors,
+                      ByteCode* output);
+
+    bool generateCode() override;
+
+private:
+    std::unique_ptr<ByteCodeFunction> writeFunction(const FunctionDefinition& f);
+
+    void write8(uint8_t b);
+
+    void write16(uint16_t b);
+
+    void write32(uint32_t b);
+
+    void write(ByteCodeInstruction inst);
+
+    // Emits a forward branch and returns the location of its target, to be patched later
+    int writeBranch(ByteCodeInstruction inst);
+
+    void patchBranch(int location);
+
+    void writeBranchTo(ByteCodeInstruction inst, int target);
+
+    void adjustStack(int delta);
+
+    int getLocation(const Variable& var);
+
+    bool checkScalar(int offset, const Type& type);
+
+    void writeTypedInstruction(const Type& type, ByteCodeInstruction f, ByteCodeInstruction s,
+                               ByteCodeInstruction u);
+
+    void writeStatement(const Statement& s);
+
+    void writeBlock(const Block& b);
+
+    void writeVarDeclarations(const VarDeclarations& decls);
+
+    void writeIfStatement(const IfStatement& s);
+
+    void writeForStatement(const ForStatement& f);
+
+    void writeWhileStatement(const WhileStatement& w);
+
+    void writeDoStatement(const DoStatement& d);
+
+    void writeReturnStatement(const ReturnStatement& r);
+
+    // When discard is true the value of the expression is not needed, and nothing is left on
+    // the stack.
+    void writeExpression(const Expression& e, bool discard = false);
+
+    void writeBinaryExpression(const BinaryExpression& b, bool discard);
+
+    void writeComparison(const Type& operandType, Token::Kind op);
+
+    void writeArithmetic(int offset, const Type& type, Token::Kind op);
+
+    void writeConstructor(const Constructor& c);
+
+    void writeFunctionCall(const FunctionCall& c);
+
+    void writePrefixExpression(const PrefixExpression& p, bool discard);
+
+    void writePostfixExpression(const PostfixExpression& p, bool discard);
+
+    void writeTernaryExpression(const TernaryExpression& t);
+
+    void writeStore(const Expression& lvalue, bool discard);
+
+#ifndef SKSL_STANDALONE
+    void writeAppendStage(const AppendStage& a);
+#endif
+
+    const Context& fContext;
+    ByteCode* fOutput;
+    std::unordered_map<const FunctionDeclaration*, int> fFunctionIndices;
+    ByteCodeFunction* fFunction;
+    std::vector<uint8_t>* fCode;
+    std::unordered_map<const Variable*, int> fLocals;
+    int fStackDepth;
+    int fConditionDepth;
+    int fLoopDepth;
+
+    typedef CodeGenerator INHERITED;
+};
+
+} // namespace
+
+#endif
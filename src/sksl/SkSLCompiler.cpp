@@ -7,6 +7,7 @@
 
 #include "SkSLCompiler.h"
 
+#include "SkSLByteCodeGenerator.h"
 #include "SkSLCFGGenerator.h"
 #include "SkSLCPPCodeGenerator.h"
 #include "SkSLGLSLCodeGenerator.h"
@@ -27,6 +28,8 @@
 #include "ir/SkSLUnresolvedFunction.h"
 #include "ir/SkSLVarDeclarations.h"
 
+#include <functional>
+
 #ifdef SK_ENABLE_SPIRV_VALIDATION
 #include "spirv-tools/libspirv.hpp"
 #endif
@@ -225,29 +228,47 @@ Compiler::Compiler(Flags flags)
         printf("Unexpected errors: %s\n", fErrorText.c_str());
     }
     SkASSERT(!fErrorCount);
+    fRootSymbolTable = fIRGenerator->fSymbolTable;
+}
+
+Compiler::~Compiler() {
+    delete fIRGenerator;
+}
 
+// The vertex, fragment and geometry built-ins are each converted the first time a program that
+// needs them is compiled, rather than up front. A compiler that never sees a geometry shader
+// never pays for sksl_geom.inc. Each module's symbols are a child of the root table.
+void Compiler::loadModule(Program::Kind kind, const char* text,
+                          std::vector<std::unique_ptr<ProgramElement>>* elements,
+                          std::shared_ptr<SymbolTable>* symbols) {
+    if (*symbols) {
+        return;
+    }
     Program::Settings settings;
+    fIRGenerator->fSymbolTable = fRootSymbolTable;
     fIRGenerator->start(&settings, nullptr);
-    fIRGenerator->convertProgram(Program::kFragment_Kind, SKSL_VERT_INCLUDE,
-                                 strlen(SKSL_VERT_INCLUDE), *fTypes, &fVertexInclude);
+    fIRGenerator->convertProgram(kind, text, strlen(text), *fTypes, elements);
     fIRGenerator->fSymbolTable->markAllFunctionsBuiltin();
-    fVertexSymbolTable = fIRGenerator->fSymbolTable;
+    if (fErrorCount) {
+        printf("Unexpected errors: %s\n", fErrorText.c_str());
+    }
+    SkASSERT(!fErrorCount);
+    *symbols = fIRGenerator->fSymbolTable;
+}
 
-    fIRGenerator->start(&settings, nullptr);
-    fIRGenerator->convertProgram(Program::kVertex_Kind, SKSL_FRAG_INCLUDE,
-                                 strlen(SKSL_FRAG_INCLUDE), *fTypes, &fFragmentInclude);
-    fIRGenerator->fSymbolTable->markAllFunctionsBuiltin();
-    fFragmentSymbolTable = fIRGenerator->fSymbolTable;
+void Compiler::loadVertexModule() {
+    this->loadModule(Program::kFragment_Kind, SKSL_VERT_INCLUDE, &fVertexInclude,
+                     &fVertexSymbolTable);
+}
 
-    fIRGenerator->start(&settings, nullptr);
-    fIRGenerator->convertProgram(Program::kGeometry_Kind, SKSL_GEOM_INCLUDE,
-                                 strlen(SKSL_GEOM_INCLUDE), *fTypes, &fGeometryInclude);
-    fIRGenerator->fSymbolTable->markAllFunctionsBuiltin();
-    fGeometrySymbolTable = fIRGenerator->fSymbolTable;
+void Compiler::loadFragmentModule() {
+    this->loadModule(Program::kVertex_Kind, SKSL_FRAG_INCLUDE, &fFragmentInclude,
+                     &fFragmentSymbolTable);
 }
 
-Compiler::~Compiler() {
-    delete fIRGenerator;
+void Compiler::loadGeometryModule() {
+    this->loadModule(Program::kGeometry_Kind, SKSL_GEOM_INCLUDE, &fGeometryInclude,
+                     &fGeometrySymbolTable);
 }
 
 // add the definition created by assigning to the lvalue to the definition set
@@ -1239,29 +1260,37 @@ std::unique_ptr<Program> Compiler::convertProgram(Program::Kind kind, String tex
     std::vector<std::unique_ptr<ProgramElement>> elements;
     switch (kind) {
         case Program::kVertex_Kind:
+            this->loadVertexModule();
             inherited = &fVertexInclude;
             fIRGenerator->fSymbolTable = fVertexSymbolTable;
             fIRGenerator->start(&settings, inherited);
             break;
         case Program::kFragment_Kind:
+            this->loadFragmentModule();
             inherited = &fFragmentInclude;
             fIRGenerator->fSymbolTable = fFragmentSymbolTable;
             fIRGenerator->start(&settings, inherited);
             break;
         case Program::kGeometry_Kind:
+            this->loadGeometryModule();
             inherited = &fGeometryInclude;
             fIRGenerator->fSymbolTable = fGeometrySymbolTable;
             fIRGenerator->start(&settings, inherited);
             break;
         case Program::kFragmentProcessor_Kind:
+            // .fp files use fragment built-ins such as sk_FragCoord
+            this->loadFragmentModule();
             inherited = nullptr;
+            fIRGenerator->fSymbolTable = fFragmentSymbolTable;
             fIRGenerator->start(&settings, nullptr);
             fIRGenerator->convertProgram(kind, SKSL_FP_INCLUDE, strlen(SKSL_FP_INCLUDE), *fTypes,
                                          &elements);
             fIRGenerator->fSymbolTable->markAllFunctionsBuiltin();
             break;
         case Program::kPipelineStage_Kind:
+            this->loadFragmentModule();
             inherited = nullptr;
+            fIRGenerator->fSymbolTable = fFragmentSymbolTable;
             fIRGenerator->start(&settings, nullptr);
             fIRGenerator->convertProgram(kind, SKSL_PIPELINE_STAGE_INCLUDE,
                                          strlen(SKSL_PIPELINE_STAGE_INCLUDE), *fTypes, &elements);
@@ -1290,17 +1319,388 @@ std::unique_ptr<Program> Compiler::convertProgram(Program::Kind kind, String tex
     return result;
 }
 
+typedef std::function<void(std::unique_ptr<Expression>*)> ExpressionVisitor;
+
+typedef std::function<void(Statement*)> StatementVisitor;
+
+// Calls visit on expr and every expression nested within it, children before parents. visit may
+// replace the expression it is given.
+static void visit_expressions(std::unique_ptr<Expression>* expr, const ExpressionVisitor& visit) {
+    switch ((*expr)->fKind) {
+#ifndef SKSL_STANDALONE
+        case Expression::kAppendStage_Kind:
+            for (auto& arg : ((AppendStage&) **expr).fArguments) {
+                visit_expressions(&arg, visit);
+            }
+            break;
+#endif
+        case Expression::kBinary_Kind: {
+            BinaryExpression& b = (BinaryExpression&) **expr;
+            visit_expressions(&b.fLeft, visit);
+            visit_expressions(&b.fRight, visit);
+            break;
+        }
+        case Expression::kConstructor_Kind:
+            for (auto& arg : ((Constructor&) **expr).fArguments) {
+                visit_expressions(&arg, visit);
+            }
+            break;
+        case Expression::kFieldAccess_Kind:
+            visit_expressions(&((FieldAccess&) **expr).fBase, visit);
+            break;
+        case Expression::kFunctionCall_Kind:
+            for (auto& arg : ((FunctionCall&) **expr).fArguments) {
+                visit_expressions(&arg, visit);
+            }
+            break;
+        case Expression::kIndex_Kind: {
+            IndexExpression& i = (IndexExpression&) **expr;
+            visit_expressions(&i.fBase, visit);
+            visit_expressions(&i.fIndex, visit);
+            break;
+        }
+        case Expression::kPrefix_Kind:
+            visit_expressions(&((PrefixExpression&) **expr).fOperand, visit);
+            break;
+        case Expression::kPostfix_Kind:
+            visit_expressions(&((PostfixExpression&) **expr).fOperand, visit);
+            break;
+        case Expression::kSwizzle_Kind:
+            visit_expressions(&((Swizzle&) **expr).fBase, visit);
+            break;
+        case Expression::kTernary_Kind: {
+            TernaryExpression& t = (TernaryExpression&) **expr;
+            visit_expressions(&t.fTest, visit);
+            visit_expressions(&t.fIfTrue, visit);
+            visit_expressions(&t.fIfFalse, visit);
+            break;
+        }
+        default:
+            break;
+    }
+    visit(expr);
+}
+
+// Calls visitStatement on stmt and every statement nested within it, and visitExpression on every
+// expression they contain.
+static void visit_statement(Statement* stmt, const StatementVisitor& visitStatement,
+                            const ExpressionVisitor& visitExpression) {
+    visitStatement(stmt);
+    switch (stmt->fKind) {
+        case Statement::kBlock_Kind:
+            for (auto& s : ((Block*) stmt)->fStatements) {
+                visit_statement(s.get(), visitStatement, visitExpression);
+            }
+            break;
+        case Statement::kDo_Kind: {
+            DoStatement* d = (DoStatement*) stmt;
+            visit_statement(d->fStatement.get(), visitStatement, visitExpression);
+            visit_expressions(&d->fTest, visitExpression);
+            break;
+        }
+        case Statement::kExpression_Kind:
+            visit_expressions(&((ExpressionStatement*) stmt)->fExpression, visitExpression);
+            break;
+        case Statement::kFor_Kind: {
+            ForStatement* f = (ForStatement*) stmt;
+            if (f->fInitializer) {
+                visit_statement(f->fInitializer.get(), visitStatement, visitExpression);
+            }
+            if (f->fTest) {
+                visit_expressions(&f->fTest, visitExpression);
+            }
+            if (f->fNext) {
+                visit_expressions(&f->fNext, visitExpression);
+            }
+            visit_statement(f->fStatement.get(), visitStatement, visitExpression);
+            break;
+        }
+        case Statement::kIf_Kind: {
+            IfStatement* i = (IfStatement*) stmt;
+            visit_expressions(&i->fTest, visitExpression);
+            visit_statement(i->fIfTrue.get(), visitStatement, visitExpression);
+            if (i->fIfFalse) {
+                visit_statement(i->fIfFalse.get(), visitStatement, visitExpression);
+            }
+            break;
+        }
+        case Statement::kReturn_Kind: {
+            ReturnStatement* r = (ReturnStatement*) stmt;
+            if (r->fExpression) {
+                visit_expressions(&r->fExpression, visitExpression);
+            }
+            break;
+        }
+        case Statement::kSwitch_Kind: {
+            SwitchStatement* s = (SwitchStatement*) stmt;
+            visit_expressions(&s->fValue, visitExpression);
+            for (auto& c : s->fCases) {
+                for (auto& caseStatement : c->fStatements) {
+                    visit_statement(caseStatement.get(), visitStatement, visitExpression);
+                }
+            }
+            break;
+        }
+        case Statement::kVarDeclaration_Kind: {
+            VarDeclaration* v = (VarDeclaration*) stmt;
+            for (auto& size : v->fSizes) {
+                if (size) {
+                    visit_expressions(&size, visitExpression);
+                }
+            }
+            if (v->fValue) {
+                visit_expressions(&v->fValue, visitExpression);
+                // the visitor may have replaced the initial value
+                ((Variable*) v->fVar)->fInitialValue = v->fValue.get();
+            }
+            break;
+        }
+        case Statement::kVarDeclarations_Kind:
+            for (auto& v : ((VarDeclarationsStatement*) stmt)->fDeclaration->fVars) {
+                visit_statement(v.get(), visitStatement, visitExpression);
+            }
+            break;
+        case Statement::kWhile_Kind: {
+            WhileStatement* w = (WhileStatement*) stmt;
+            visit_expressions(&w->fTest, visitExpression);
+            visit_statement(w->fStatement.get(), visitStatement, visitExpression);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// Returns the return statement making up the entire body of f, or null if f has any other shape
+static ReturnStatement* single_return(const FunctionDefinition& f) {
+    const Statement* body = f.fBody.get();
+    while (body->fKind == Statement::kBlock_Kind) {
+        const Block& b = (const Block&) *body;
+        if (b.fStatements.size() != 1) {
+            return nullptr;
+        }
+        body = b.fStatements[0].get();
+    }
+    if (body->fKind != Statement::kReturn_Kind || !((ReturnStatement&) *body).fExpression) {
+        return nullptr;
+    }
+    return (ReturnStatement*) body;
+}
+
+static bool is_trivial_argument(const Expression& expr) {
+    switch (expr.fKind) {
+        case Expression::kBoolLiteral_Kind:
+        case Expression::kFloatLiteral_Kind:
+        case Expression::kIntLiteral_Kind:
+        case Expression::kVariableReference_Kind:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void Compiler::inlineFunctions(Program& program) {
+    if (program.fSettings.fInlineThreshold <= 0) {
+        return;
+    }
+    std::unordered_map<const FunctionDeclaration*, int> callCounts;
+    ExpressionVisitor countCalls = [&](std::unique_ptr<Expression>* expr) {
+        if ((*expr)->fKind == Expression::kFunctionCall_Kind) {
+            ++callCounts[&((FunctionCall&) **expr).fFunction];
+        }
+    };
+    StatementVisitor ignoreStatement = [](Statement*) {};
+    for (auto& element : program) {
+        if (element.fKind == ProgramElement::kFunction_Kind) {
+            visit_statement(((FunctionDefinition&) element).fBody.get(), ignoreStatement,
+                            countCalls);
+        }
+    }
+
+    // A function can be inlined if its body is a single side-effect-free return statement which
+    // doesn't write to its parameters. To keep the output from growing, the expression must be
+    // small unless this is the function's only call site.
+    std::unordered_map<const FunctionDeclaration*, ReturnStatement*> candidates;
+    for (auto& element : program) {
+        if (element.fKind != ProgramElement::kFunction_Kind) {
+            continue;
+        }
+        FunctionDefinition& f = (FunctionDefinition&) element;
+        ReturnStatement* r = single_return(f);
+        if (!r || r->fExpression->hasSideEffects()) {
+            continue;
+        }
+        bool valid = true;
+        for (const Variable* p : f.fDeclaration.fParameters) {
+            if ((p->fModifiers.fFlags & Modifiers::kOut_Flag) || p->fWriteCount) {
+                valid = false;
+                break;
+            }
+        }
+        if (!valid) {
+            continue;
+        }
+        int size = 0;
+        visit_expressions(&r->fExpression, [&](std::unique_ptr<Expression>*) { ++size; });
+        if (size <= program.fSettings.fInlineThreshold || callCounts[&f.fDeclaration] == 1) {
+            candidates[&f.fDeclaration] = r;
+        }
+    }
+    if (candidates.empty()) {
+        return;
+    }
+
+    for (auto& element : program) {
+        if (element.fKind != ProgramElement::kFunction_Kind) {
+            continue;
+        }
+        FunctionDefinition& caller = (FunctionDefinition&) element;
+        // An inlined expression refers to globals by name, so it must not be placed where a local
+        // of the same name would hide them.
+        std::unordered_set<String> localNames;
+        for (const Variable* p : caller.fDeclaration.fParameters) {
+            localNames.insert(p->fName);
+        }
+        visit_statement(caller.fBody.get(),
+                        [&](Statement* stmt) {
+                            if (stmt->fKind == Statement::kVarDeclaration_Kind) {
+                                localNames.insert(((VarDeclaration&) *stmt).fVar->fName);
+                            }
+                        },
+                        [](std::unique_ptr<Expression>*) {});
+        visit_statement(caller.fBody.get(), ignoreStatement,
+                        [&](std::unique_ptr<Expression>* expr) {
+            if ((*expr)->fKind != Expression::kFunctionCall_Kind) {
+                return;
+            }
+            FunctionCall& call = (FunctionCall&) **expr;
+            auto found = candidates.find(&call.fFunction);
+            if (found == candidates.end() || &call.fFunction == &caller.fDeclaration) {
+                return;
+            }
+            const std::vector<const Variable*>& parameters = call.fFunction.fParameters;
+            std::unordered_map<const Variable*, const Expression*> arguments;
+            for (size_t i = 0; i < parameters.size(); ++i) {
+                const Expression& arg = *call.fArguments[i];
+                // duplicating a complex argument would repeat its work at each use
+                if (arg.hasSideEffects() ||
+                    (parameters[i]->fReadCount > 1 && !is_trivial_argument(arg))) {
+                    return;
+                }
+                arguments[parameters[i]] = &arg;
+            }
+            std::unique_ptr<Expression> inlined = found->second->fExpression->clone();
+            bool shadowed = false;
+            visit_expressions(&inlined, [&](std::unique_ptr<Expression>* e) {
+                if ((*e)->fKind != Expression::kVariableReference_Kind) {
+                    return;
+                }
+                const Variable& var = ((VariableReference&) **e).fVariable;
+                auto arg = arguments.find(&var);
+                if (arg != arguments.end()) {
+                    *e = arg->second->clone();
+                } else if (localNames.find(var.fName) != localNames.end()) {
+                    shadowed = true;
+                }
+            });
+            if (!shadowed) {
+                *expr = std::move(inlined);
+            }
+        });
+    }
+}
+
+void Compiler::removeUnreachableFunctions(Program& program) {
+    std::unordered_map<const FunctionDeclaration*, FunctionDefinition*> definitions;
+    const FunctionDeclaration* main = nullptr;
+    for (auto& element : program) {
+        if (element.fKind == ProgramElement::kFunction_Kind) {
+            FunctionDefinition& f = (FunctionDefinition&) element;
+            definitions[&f.fDeclaration] = &f;
+            if (f.fDeclaration.fName == "main") {
+                main = &f.fDeclaration;
+            }
+        }
+    }
+    if (!main) {
+        return;
+    }
+    std::unordered_set<const FunctionDeclaration*> reachable;
+    std::vector<const FunctionDeclaration*> workList;
+    reachable.insert(main);
+    workList.push_back(main);
+    while (!workList.empty()) {
+        const FunctionDeclaration* f = workList.back();
+        workList.pop_back();
+        auto found = definitions.find(f);
+        if (found == definitions.end()) {
+            continue;
+        }
+        visit_statement(found->second->fBody.get(), [](Statement*) {},
+                        [&](std::unique_ptr<Expression>* expr) {
+            if ((*expr)->fKind == Expression::kFunctionCall_Kind) {
+                const FunctionDeclaration* callee = &((FunctionCall&) **expr).fFunction;
+                if (reachable.insert(callee).second) {
+                    workList.push_back(callee);
+                }
+            }
+        });
+    }
+    for (auto iter = program.fElements.begin(); iter != program.fElements.end();) {
+        if ((*iter)->fKind == ProgramElement::kFunction_Kind &&
+            reachable.find(&((FunctionDefinition&) **iter).fDeclaration) == reachable.end()) {
+            iter = program.fElements.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void Compiler::removeUnusedUniforms(Program& program) {
+    for (auto iter = program.fElements.begin(); iter != program.fElements.end();) {
+        if ((*iter)->fKind == ProgramElement::kVar_Kind) {
+            VarDeclarations& vars = (VarDeclarations&) **iter;
+            for (auto varIter = vars.fVars.begin(); varIter != vars.fVars.end();) {
+                const Variable& var = *((VarDeclaration&) **varIter).fVar;
+                const Layout& layout = var.fModifiers.fLayout;
+                // uniforms with an explicit layout are part of an interface the caller relies on
+                if ((var.fModifiers.fFlags & Modifiers::kUniform_Flag) && !var.fReadCount &&
+                    !var.fWriteCount && layout.fBuiltin == -1 && layout.fBinding == -1 &&
+                    layout.fSet == -1 && layout.fLocation == -1) {
+                    varIter = vars.fVars.erase(varIter);
+                } else {
+                    ++varIter;
+                }
+            }
+            if (vars.fVars.size() == 0) {
+                iter = program.fElements.erase(iter);
+                continue;
+            }
+        }
+        ++iter;
+    }
+}
+
 bool Compiler::optimize(Program& program) {
     SkASSERT(!fErrorCount);
     if (!program.fIsOptimized) {
         program.fIsOptimized = true;
         fIRGenerator->fKind = program.fKind;
         fIRGenerator->fSettings = &program.fSettings;
+        bool standalone = program.fKind == Program::kFragment_Kind ||
+                          program.fKind == Program::kVertex_Kind ||
+                          program.fKind == Program::kGeometry_Kind;
+        if (standalone) {
+            this->inlineFunctions(program);
+        }
         for (auto& element : program) {
             if (element.fKind == ProgramElement::kFunction_Kind) {
                 this->scanCFG((FunctionDefinition&) element);
             }
         }
+        if (standalone && !fErrorCount) {
+            this->removeUnreachableFunctions(program);
+        }
         if (program.fKind != Program::kFragmentProcessor_Kind) {
             for (auto iter = program.fElements.begin(); iter != program.fElements.end();) {
                 if ((*iter)->fKind == ProgramElement::kVar_Kind) {
@@ -1394,6 +1794,7 @@ bool Compiler::toGLSL(Program& program, OutputStream& out) {
     if (!this->optimize(program)) {
         return false;
     }
+    this->removeUnusedUniforms(program);
     fSource = program.fSource.get();
     GLSLCodeGenerator cg(fContext.get(), &program, this, &out);
     bool result = cg.generateCode();
@@ -1467,6 +1868,18 @@ bool Compiler::toPipelineStage(const Program& program, String* out,
     return result;
 }
 
+std::unique_ptr<ByteCode> Compiler::toByteCode(Program& program) {
+    if (!this->optimize(program)) {
+        return nullptr;
+    }
+    fSource = program.fSource.get();
+    std::unique_ptr<ByteCode> result(new ByteCode());
+    ByteCodeGenerator cg(fContext.get(), &program, this, result.get());
+    bool success = cg.generateCode();
+    fSource = nullptr;
+    return success ? std::move(result) : nullptr;
+}
+
 const char* Compiler::OperatorName(Token::Kind kind) {
     switch (kind) {
         case Token::PLUS:         return "+";
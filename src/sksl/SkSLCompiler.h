@@ -13,6 +13,7 @@
 #include <vector>
 #include "ir/SkSLProgram.h"
 #include "ir/SkSLSymbolTable.h"
+#include "SkSLByteCode.h"
 #include "SkSLCFGGenerator.h"
 #include "SkSLContext.h"
 #include "SkSLErrorReporter.h"
@@ -114,6 +115,8 @@ public:
     bool toPipelineStage(const Program& program, String* out,
                          std::vector<FormatArg>* outFormatArgs);
 
+    std::unique_ptr<ByteCode> toByteCode(Program& program);
+
     void error(int offset, String msg) override;
 
     String errorText();
@@ -166,8 +169,34 @@ private:
 
     void scanCFG(FunctionDefinition& f);
 
+    /**
+     * Replaces calls to small single-expression functions with the functions' bodies.
+     */
+    void inlineFunctions(Program& program);
+
+    /**
+     * Removes functions which cannot be reached from main().
+     */
+    void removeUnreachableFunctions(Program& program);
+
+    /**
+     * Removes uniforms which are never referenced and have no explicit layout.
+     */
+    void removeUnusedUniforms(Program& program);
+
     Position position(int offset);
 
+    void loadModule(Program::Kind kind, const char* text,
+                    std::vector<std::unique_ptr<ProgramElement>>* elements,
+                    std::shared_ptr<SymbolTable>* symbols);
+
+    void loadVertexModule();
+
+    void loadFragmentModule();
+
+    void loadGeometryModule();
+
+    std::shared_ptr<SymbolTable> fRootSymbolTable;
     std::vector<std::unique_ptr<ProgramElement>> fVertexInclude;
     std::shared_ptr<SymbolTable> fVertexSymbolTable;
     std::vector<std::unique_ptr<ProgramElement>> fFragmentInclude;
@@ -8,463 +8,380 @@
 #ifndef SKSL_STANDALONE
 
 #include "SkSLInterpreter.h"
-#include "ir/SkSLBinaryExpression.h"
-#include "ir/SkSLExpressionStatement.h"
-#include "ir/SkSLForStatement.h"
-#include "ir/SkSLFunctionCall.h"
-#include "ir/SkSLFunctionReference.h"
-#include "ir/SkSLIfStatement.h"
-#include "ir/SkSLIndexExpression.h"
-#include "ir/SkSLPostfixExpression.h"
-#include "ir/SkSLPrefixExpression.h"
-#include "ir/SkSLProgram.h"
-#include "ir/SkSLStatement.h"
-#include "ir/SkSLTernaryExpression.h"
-#include "ir/SkSLVarDeclarations.h"
-#include "ir/SkSLVarDeclarationsStatement.h"
-#include "ir/SkSLVariableReference.h"
+#include "SkFloatingPoint.h"
 #include "SkRasterPipeline.h"
+#include "SkTemplates.h"
+
+#include <cstring>
 
 namespace SkSL {
 
-void Interpreter::run() {
-    for (const auto& e : *fProgram) {
-        if (ProgramElement::kFunction_Kind == e.fKind) {
-            const FunctionDefinition& f = (const FunctionDefinition&) e;
-            if ("appendStages" == f.fDeclaration.fName) {
-                this->run(f);
-                return;
-            }
-        }
-    }
-    SkASSERT(false);
-}
+constexpr int Interpreter::VecWidth;
 
-static int SizeOf(const Type& type) {
-    return 1;
-}
+struct Interpreter::CallbackCtx : public SkRasterPipeline_CallbackCtx {
+    Interpreter* fInterpreter;
+    const ByteCodeFunction* fFunction;
+};
 
-void Interpreter::run(const FunctionDefinition& f) {
-    fVars.emplace_back();
-    StackIndex current = (StackIndex) fStack.size();
-    for (int i = f.fDeclaration.fParameters.size() - 1; i >= 0; --i) {
-        current -= SizeOf(f.fDeclaration.fParameters[i]->fType);
-        fVars.back()[f.fDeclaration.fParameters[i]] = current;
-    }
-    fCurrentIndex.push_back({ f.fBody.get(), 0 });
-    while (fCurrentIndex.size()) {
-        this->runStatement();
+Interpreter::Interpreter(std::unique_ptr<Program> program, std::unique_ptr<ByteCode> byteCode,
+                         SkRasterPipeline* pipeline)
+: fProgram(std::move(program))
+, fByteCode(std::move(byteCode))
+, fPipeline(pipeline) {
+    // SkSL has no recursion, so no call chain visits a function twice, and the sum of the frames
+    // is enough for any of them. Slot 0 stays unused so that an empty frame has somewhere to
+    // point below its base.
+    size_t stackSize = 1;
+    for (const auto& f : fByteCode->fFunctions) {
+        stackSize += f->frameSize();
     }
+    fStack.resize(stackSize);
 }
 
-void Interpreter::push(Value value) {
-    fStack.push_back(value);
-}
+Interpreter::~Interpreter() {}
 
-Interpreter::Value Interpreter::pop() {
-    auto iter = fStack.end() - 1;
-    Value result = *iter;
-    fStack.erase(iter);
-    return result;
+void Interpreter::run() {
+    const ByteCodeFunction* f = fByteCode->getFunction("appendStages");
+    SkASSERT(f && 0 == f->fParameterCount);
+    if (f) {
+        this->run(*f, nullptr);
+    }
 }
 
- Interpreter::StackIndex Interpreter::stackAlloc(int count) {
-    int result = fStack.size();
-    for (int i = 0; i < count; ++i) {
-        fStack.push_back(Value((int) 0xDEADBEEF));
+Interpreter::Value Interpreter::run(const ByteCodeFunction& f, Value args[]) {
+    SkAutoSTMalloc<8, Value*> argPtrs(f.fParameterCount);
+    for (int i = 0; i < f.fParameterCount; ++i) {
+        argPtrs[i] = &args[i];
     }
+    Value result((int32_t) 0);
+    this->runStriped(f, 1, argPtrs.get(), &result);
     return result;
 }
 
-void Interpreter::runStatement() {
-    const Statement& stmt = *fCurrentIndex.back().fStatement;
-    const size_t index = fCurrentIndex.back().fIndex;
-    fCurrentIndex.pop_back();
-    switch (stmt.fKind) {
-        case Statement::kBlock_Kind: {
-            const Block& b = (const Block&) stmt;
-            if (!b.fStatements.size()) {
-                break;
-            }
-            SkASSERT(index < b.fStatements.size());
-            if (index < b.fStatements.size() - 1) {
-                fCurrentIndex.push_back({ &b, index + 1 });
-            }
-            fCurrentIndex.push_back({ b.fStatements[index].get(), 0 });
-            break;
+void Interpreter::runStriped(const ByteCodeFunction& f, int N, Value* args[], Value outReturn[]) {
+    VValue* base = fStack.data() + 1;
+    for (int start = 0; start < N; start += VecWidth) {
+        int lanes = SkTMin(N - start, VecWidth);
+        VValue mask;
+        for (int i = 0; i < VecWidth; ++i) {
+            mask.fLane[i].fInt = i < lanes ? ~0 : 0;
         }
-        case Statement::kBreak_Kind:
-            SkASSERT(index == 0);
-            abort();
-        case Statement::kContinue_Kind:
-            SkASSERT(index == 0);
-            abort();
-        case Statement::kDiscard_Kind:
-            SkASSERT(index == 0);
-            abort();
-        case Statement::kDo_Kind:
-            abort();
-        case Statement::kExpression_Kind:
-            SkASSERT(index == 0);
-            this->evaluate(*((const ExpressionStatement&) stmt).fExpression);
-            break;
-        case Statement::kFor_Kind: {
-            ForStatement& f = (ForStatement&) stmt;
-            switch (index) {
-                case 0:
-                    // initializer
-                    fCurrentIndex.push_back({ &f, 1 });
-                    if (f.fInitializer) {
-                        fCurrentIndex.push_back({ f.fInitializer.get(), 0 });
-                    }
-                    break;
-                case 1:
-                    // test & body
-                    if (f.fTest && !evaluate(*f.fTest).fBool) {
-                        break;
-                    } else {
-                        fCurrentIndex.push_back({ &f, 2 });
-                        fCurrentIndex.push_back({ f.fStatement.get(), 0 });
-                    }
-                    break;
-                case 2:
-                    // next
-                    if (f.fNext) {
-                        this->evaluate(*f.fNext);
-                    }
-                    fCurrentIndex.push_back({ &f, 1 });
-                    break;
-                default:
-                    SkASSERT(false);
-            }
-            break;
+        for (int p = 0; p < f.fParameterCount; ++p) {
+            memcpy(base[p].fLane, args[p] + start, lanes * sizeof(Value));
         }
-        case Statement::kGroup_Kind:
-            abort();
-        case Statement::kIf_Kind: {
-            IfStatement& i = (IfStatement&) stmt;
-            if (evaluate(*i.fTest).fBool) {
-                fCurrentIndex.push_back({ i.fIfTrue.get(), 0 });
-            } else if (i.fIfFalse) {
-                fCurrentIndex.push_back({ i.fIfFalse.get(), 0 });
-            }
-            break;
+        this->innerRun(f, base, mask);
+        for (int p = 0; p < f.fParameterCount; ++p) {
+            memcpy(args[p] + start, base[p].fLane, lanes * sizeof(Value));
+        }
+        if (outReturn && f.fReturnSlot >= 0) {
+            memcpy(outReturn + start, base[f.fReturnSlot].fLane, lanes * sizeof(Value));
         }
-        case Statement::kNop_Kind:
-            SkASSERT(index == 0);
-            break;
-        case Statement::kReturn_Kind:
-            SkASSERT(index == 0);
-            abort();
-        case Statement::kSwitch_Kind:
-            abort();
-        case Statement::kVarDeclarations_Kind:
-            SkASSERT(index == 0);
-            for (const auto& decl :((const VarDeclarationsStatement&) stmt).fDeclaration->fVars) {
-                const Variable* var = ((VarDeclaration&) *decl).fVar;
-                StackIndex pos = this->stackAlloc(SizeOf(var->fType));
-                fVars.back()[var] = pos;
-                if (var->fInitialValue) {
-                    fStack[pos] = this->evaluate(*var->fInitialValue);
-                }
-            }
-            break;
-        case Statement::kWhile_Kind:
-            abort();
-        default:
-            abort();
     }
 }
 
-static Interpreter::TypeKind type_kind(const Type& type) {
-    if (type.fName == "int") {
-        return Interpreter::kInt_TypeKind;
-    } else if (type.fName == "float") {
-        return Interpreter::kFloat_TypeKind;
-    }
-    ABORT("unsupported type: %s\n", type.description().c_str());
+#define LANES for (int i = 0; i < VecWidth; ++i)
+
+#define READ8() (*(ip++))
+
+#define READ16() (ip += 2, read16(ip - 2))
+
+#define READ32() (ip += 4, read32(ip - 4))
+
+static uint16_t read16(const uint8_t* ip) {
+    uint16_t result;
+    memcpy(&result, ip, sizeof(result));
+    return result;
 }
 
-Interpreter::StackIndex Interpreter::getLValue(const Expression& expr) {
-    switch (expr.fKind) {
-        case Expression::kFieldAccess_Kind:
-            break;
-        case Expression::kIndex_Kind: {
-            const IndexExpression& idx = (const IndexExpression&) expr;
-            return this->evaluate(*idx.fBase).fInt + this->evaluate(*idx.fIndex).fInt;
-        }
-        case Expression::kSwizzle_Kind:
-            break;
-        case Expression::kVariableReference_Kind:
-            SkASSERT(fVars.size());
-            SkASSERT(fVars.back().find(&((VariableReference&) expr).fVariable) !=
-                   fVars.back().end());
-            return fVars.back()[&((VariableReference&) expr).fVariable];
-        case Expression::kTernary_Kind: {
-            const TernaryExpression& t = (const TernaryExpression&) expr;
-            return this->getLValue(this->evaluate(*t.fTest).fBool ? *t.fIfTrue : *t.fIfFalse);
-        }
-        case Expression::kTypeReference_Kind:
-            break;
-        default:
-            break;
-    }
-    ABORT("unsupported lvalue");
+static uint32_t read32(const uint8_t* ip) {
+    uint32_t result;
+    memcpy(&result, ip, sizeof(result));
+    return result;
 }
 
-struct CallbackCtx : public SkRasterPipeline_CallbackCtx {
-    Interpreter* fInterpreter;
-    const FunctionDefinition* fFunction;
-};
+#define BINARY_OP(inst, type, field, op)                         \
+    case ByteCodeInstruction::inst: {                            \
+        const VValue& b = *(sp--);                               \
+        VValue& a = *sp;                                         \
+        LANES {                                                  \
+            a.fLane[i].field = (type) a.fLane[i].field op        \
+                               (type) b.fLane[i].field;          \
+        }                                                        \
+        break;                                                   \
+    }
 
-static void do_callback(SkRasterPipeline_CallbackCtx* raw, int activePixels) {
-    CallbackCtx& ctx = (CallbackCtx&) *raw;
-    for (int i = 0; i < activePixels; ++i) {
-        ctx.fInterpreter->push(Interpreter::Value(ctx.rgba[i * 4 + 0]));
-        ctx.fInterpreter->push(Interpreter::Value(ctx.rgba[i * 4 + 1]));
-        ctx.fInterpreter->push(Interpreter::Value(ctx.rgba[i * 4 + 2]));
-        ctx.fInterpreter->run(*ctx.fFunction);
-        ctx.read_from[i * 4 + 2] = ctx.fInterpreter->pop().fFloat;
-        ctx.read_from[i * 4 + 1] = ctx.fInterpreter->pop().fFloat;
-        ctx.read_from[i * 4 + 0] = ctx.fInterpreter->pop().fFloat;
+#define COMPARE(inst, type, field, op)                           \
+    case ByteCodeInstruction::inst: {                            \
+        const VValue& b = *(sp--);                               \
+        VValue& a = *sp;                                         \
+        LANES {                                                  \
+            a.fLane[i].fInt = (type) a.fLane[i].field op         \
+                              (type) b.fLane[i].field ? ~0 : 0;  \
+        }                                                        \
+        break;                                                   \
     }
-}
 
-void Interpreter::appendStage(const AppendStage& a) {
-    switch (a.fStage) {
-        case SkRasterPipeline::matrix_4x5: {
-            SkASSERT(a.fArguments.size() == 1);
-            StackIndex transpose = evaluate(*a.fArguments[0]).fInt;
-            fPipeline.append(SkRasterPipeline::matrix_4x5, &fStack[transpose]);
-            break;
-        }
-        case SkRasterPipeline::callback: {
-            SkASSERT(a.fArguments.size() == 1);
-            CallbackCtx* ctx = new CallbackCtx();
-            ctx->fInterpreter = this;
-            ctx->fn = do_callback;
-            for (const auto& e : *fProgram) {
-                if (ProgramElement::kFunction_Kind == e.fKind) {
-                    const FunctionDefinition& f = (const FunctionDefinition&) e;
-                    if (&f.fDeclaration ==
-                                      ((const FunctionReference&) *a.fArguments[0]).fFunctions[0]) {
-                        ctx->fFunction = &f;
-                    }
-                }
-            }
-            fPipeline.append(SkRasterPipeline::callback, ctx);
-            break;
-        }
-        default:
-            fPipeline.append(a.fStage);
+// Integer division by zero, and INT_MIN / -1, trap on some CPUs. They may turn up in lanes that
+// are masked off, so they are given defined results instead.
+#define DIVIDE_S(inst, op, byMinusOne)                           \
+    case ByteCodeInstruction::inst: {                            \
+        const VValue& b = *(sp--);                               \
+        VValue& a = *sp;                                         \
+        LANES {                                                  \
+            int32_t x = a.fLane[i].fInt;                         \
+            int32_t y = b.fLane[i].fInt;                         \
+            a.fLane[i].fInt = 0 == y ? 0 : -1 == y ? (byMinusOne) : x op y; \
+        }                                                        \
+        break;                                                   \
     }
-}
 
-Interpreter::Value Interpreter::call(const FunctionCall& c) {
-    abort();
-}
+#define DIVIDE_U(inst, op)                                       \
+    case ByteCodeInstruction::inst: {                            \
+        const VValue& b = *(sp--);                               \
+        VValue& a = *sp;                                         \
+        LANES {                                                  \
+            uint32_t x = a.fLane[i].fInt;                        \
+            uint32_t y = b.fLane[i].fInt;                        \
+            a.fLane[i].fInt = 0 == y ? 0 : x op y;               \
+        }                                                        \
+        break;                                                   \
+    }
 
-Interpreter::Value Interpreter::evaluate(const Expression& expr) {
-    switch (expr.fKind) {
-        case Expression::kAppendStage_Kind:
-            this->appendStage((const AppendStage&) expr);
-            return Value((int) 0xDEADBEEF);
-        case Expression::kBinary_Kind: {
-            #define ARITHMETIC(op) {                               \
-                Value left = this->evaluate(*b.fLeft);             \
-                Value right = this->evaluate(*b.fRight);           \
-                switch (type_kind(b.fLeft->fType)) {               \
-                    case kFloat_TypeKind:                          \
-                        return Value(left.fFloat op right.fFloat); \
-                    case kInt_TypeKind:                            \
-                        return Value(left.fInt op right.fInt);     \
-                    default:                                       \
-                        abort();                                   \
-                }                                                  \
-            }
-            #define BITWISE(op) {                                  \
-                Value left = this->evaluate(*b.fLeft);             \
-                Value right = this->evaluate(*b.fRight);           \
-                switch (type_kind(b.fLeft->fType)) {               \
-                    case kInt_TypeKind:                            \
-                        return Value(left.fInt op right.fInt);     \
-                    default:                                       \
-                        abort();                                   \
-                }                                                  \
-            }
-            #define LOGIC(op) {                                    \
-                Value left = this->evaluate(*b.fLeft);             \
-                Value right = this->evaluate(*b.fRight);           \
-                switch (type_kind(b.fLeft->fType)) {               \
-                    case kFloat_TypeKind:                          \
-                        return Value(left.fFloat op right.fFloat); \
-                    case kInt_TypeKind:                            \
-                        return Value(left.fInt op right.fInt);     \
-                    default:                                       \
-                        abort();                                   \
-                }                                                  \
-            }
-            #define COMPOUND_ARITHMETIC(op) {                      \
-                StackIndex left = this->getLValue(*b.fLeft);       \
-                Value right = this->evaluate(*b.fRight);           \
-                Value result = fStack[left];                       \
-                switch (type_kind(b.fLeft->fType)) {               \
-                    case kFloat_TypeKind:                          \
-                        result.fFloat op right.fFloat;             \
-                        break;                                     \
-                    case kInt_TypeKind:                            \
-                        result.fInt op right.fInt;                 \
-                        break;                                     \
-                    default:                                       \
-                        abort();                                   \
-                }                                                  \
-                fStack[left] = result;                             \
-                return result;                                     \
-            }
-            #define COMPOUND_BITWISE(op) {                         \
-                StackIndex left = this->getLValue(*b.fLeft);       \
-                Value right = this->evaluate(*b.fRight);           \
-                Value result = fStack[left];                       \
-                switch (type_kind(b.fLeft->fType)) {               \
-                    case kInt_TypeKind:                            \
-                        result.fInt op right.fInt;                 \
-                        break;                                     \
-                    default:                                       \
-                        abort();                                   \
-                }                                                  \
-                fStack[left] = result;                             \
-                return result;                                     \
-            }
-            const BinaryExpression& b = (const BinaryExpression&) expr;
-            switch (b.fOperator) {
-                case Token::PLUS:       ARITHMETIC(+)
-                case Token::MINUS:      ARITHMETIC(-)
-                case Token::STAR:       ARITHMETIC(*)
-                case Token::SLASH:      ARITHMETIC(/)
-                case Token::BITWISEAND: BITWISE(&)
-                case Token::BITWISEOR:  BITWISE(|)
-                case Token::BITWISEXOR: BITWISE(^)
-                case Token::LT:         LOGIC(<)
-                case Token::GT:         LOGIC(>)
-                case Token::LTEQ:       LOGIC(<=)
-                case Token::GTEQ:       LOGIC(>=)
-                case Token::LOGICALAND: {
-                    Value result = this->evaluate(*b.fLeft);
-                    if (result.fBool) {
-                        result = this->evaluate(*b.fRight);
+void Interpreter::innerRun(const ByteCodeFunction& f, VValue* base, const VValue& initialMask) {
+    if (base + f.frameSize() > fStack.data() + fStack.size()) {
+        ABORT("SkSL interpreter stack overflow in %s\n", String(f.fDeclaration.fName).c_str());
+    }
+
+    // The active lanes are those enabled by the innermost condition, the innermost loop and its
+    // continue mask, and the function's own returns.
+    SkAutoSTMalloc<8, VValue> condStack(f.fConditionCount + 1);
+    SkAutoSTMalloc<4, VValue> loopStack(f.fLoopCount + 1);
+    SkAutoSTMalloc<4, VValue> contStack(f.fLoopCount + 1);
+    VValue* cond = condStack.get();
+    VValue* loop = loopStack.get();
+    VValue* cont = contStack.get();
+    VValue ret;
+    VValue mask = initialMask;
+    *cond = initialMask;
+    LANES {
+        loop->fLane[i].fInt = ~0;
+        cont->fLane[i].fInt = ~0;
+        ret.fLane[i].fInt = ~0;
+    }
+    auto updateMask = [&]() {
+        LANES {
+            mask.fLane[i].fInt = cond->fLane[i].fInt & loop->fLane[i].fInt &
+                                 cont->fLane[i].fInt & ret.fLane[i].fInt;
+        }
+    };
+    auto anyActive = [&]() {
+        int32_t any = 0;
+        LANES { any |= mask.fLane[i].fInt; }
+        return any != 0;
+    };
+
+    const uint8_t* code = f.fCode.data();
+    const uint8_t* ip = code;
+    VValue* sp = base + f.fParameterCount + f.fLocalCount - 1;
+    for (;;) {
+        ByteCodeInstruction inst = (ByteCodeInstruction) READ8();
+        switch (inst) {
+            BINARY_OP(kAddF, float, fFloat, +)
+            BINARY_OP(kAddI, uint32_t, fInt, +)
+            BINARY_OP(kAndB, int32_t, fInt, &)
+            case ByteCodeInstruction::kAppendStage:
+                SkASSERT(fPipeline);
+                fPipeline->append((SkRasterPipeline::StockStage) READ8());
+                break;
+            case ByteCodeInstruction::kAppendCallback: {
+                SkASSERT(fPipeline);
+                std::unique_ptr<CallbackCtx> ctx(new CallbackCtx());
+                ctx->fInterpreter = this;
+                ctx->fFunction = fByteCode->fFunctions[READ8()].get();
+                SkASSERT(3 == ctx->fFunction->fParameterCount);
+                ctx->fn = [](SkRasterPipeline_CallbackCtx* raw, int activePixels) {
+                    CallbackCtx& ctx = (CallbackCtx&) *raw;
+                    Value r[SkRasterPipeline_kMaxStride],
+                          g[SkRasterPipeline_kMaxStride],
+                          b[SkRasterPipeline_kMaxStride];
+                    for (int i = 0; i < activePixels; ++i) {
+                        r[i] = Value(ctx.rgba[i * 4 + 0]);
+                        g[i] = Value(ctx.rgba[i * 4 + 1]);
+                        b[i] = Value(ctx.rgba[i * 4 + 2]);
                     }
-                    return result;
-                }
-                case Token::LOGICALOR: {
-                    Value result = this->evaluate(*b.fLeft);
-                    if (!result.fBool) {
-                        result = this->evaluate(*b.fRight);
+                    Value* args[] = { r, g, b };
+                    ctx.fInterpreter->runStriped(*ctx.fFunction, activePixels, args, nullptr);
+                    for (int i = 0; i < activePixels; ++i) {
+                        ctx.read_from[i * 4 + 0] = r[i].fFloat;
+                        ctx.read_from[i * 4 + 1] = g[i].fFloat;
+                        ctx.read_from[i * 4 + 2] = b[i].fFloat;
                     }
-                    return result;
+                };
+                fPipeline->append(SkRasterPipeline::callback, ctx.get());
+                fCallbacks.push_back(std::move(ctx));
+                break;
+            }
+            case ByteCodeInstruction::kBranch:
+                ip = code + READ16();
+                break;
+            case ByteCodeInstruction::kBranchIfAllFalse: {
+                int target = READ16();
+                if (!anyActive()) {
+                    ip = code + target;
                 }
-                case Token::EQ: {
-                    StackIndex left = this->getLValue(*b.fLeft);
-                    Value right = this->evaluate(*b.fRight);
-                    fStack[left] = right;
-                    return right;
+                break;
+            }
+            case ByteCodeInstruction::kCall: {
+                const ByteCodeFunction& callee = *fByteCode->fFunctions[READ8()];
+                VValue* calleeBase = sp - callee.fParameterCount + 1;
+                this->innerRun(callee, calleeBase, mask);
+                if (callee.fReturnSlot >= 0) {
+                    calleeBase[0] = calleeBase[callee.fReturnSlot];
+                    sp = calleeBase;
+                } else {
+                    sp = calleeBase - 1;
                 }
-                case Token::PLUSEQ:       COMPOUND_ARITHMETIC(+=)
-                case Token::MINUSEQ:      COMPOUND_ARITHMETIC(-=)
-                case Token::STAREQ:       COMPOUND_ARITHMETIC(*=)
-                case Token::SLASHEQ:      COMPOUND_ARITHMETIC(/=)
-                case Token::BITWISEANDEQ: COMPOUND_BITWISE(&=)
-                case Token::BITWISEOREQ:  COMPOUND_BITWISE(|=)
-                case Token::BITWISEXOREQ: COMPOUND_BITWISE(^=)
-                default:
-                    ABORT("unsupported operator: %s\n", expr.description().c_str());
+                break;
             }
-            break;
-        }
-        case Expression::kBoolLiteral_Kind:
-            return Value(((const BoolLiteral&) expr).fValue);
-        case Expression::kConstructor_Kind:
-            break;
-        case Expression::kIntLiteral_Kind:
-            return Value((int) ((const IntLiteral&) expr).fValue);
-        case Expression::kFieldAccess_Kind:
-            break;
-        case Expression::kFloatLiteral_Kind:
-            return Value((float) ((const FloatLiteral&) expr).fValue);
-        case Expression::kFunctionCall_Kind:
-            return this->call((const FunctionCall&) expr);
-        case Expression::kIndex_Kind: {
-            const IndexExpression& idx = (const IndexExpression&) expr;
-            StackIndex pos = this->evaluate(*idx.fBase).fInt +
-                             this->evaluate(*idx.fIndex).fInt;
-            return fStack[pos];
-        }
-        case Expression::kPrefix_Kind: {
-            const PrefixExpression& p = (const PrefixExpression&) expr;
-            switch (p.fOperator) {
-                case Token::MINUS: {
-                    Value base = this->evaluate(*p.fOperand);
-                    switch (type_kind(p.fType)) {
-                        case kFloat_TypeKind:
-                            return Value(-base.fFloat);
-                        case kInt_TypeKind:
-                            return Value(-base.fInt);
-                        default:
-                            abort();
-                    }
+            COMPARE(kCompareFEQ, float, fFloat, ==)
+            COMPARE(kCompareFGT, float, fFloat, >)
+            COMPARE(kCompareFGTEQ, float, fFloat, >=)
+            COMPARE(kCompareFLT, float, fFloat, <)
+            COMPARE(kCompareFLTEQ, float, fFloat, <=)
+            COMPARE(kCompareFNEQ, float, fFloat, !=)
+            COMPARE(kCompareIEQ, int32_t, fInt, ==)
+            COMPARE(kCompareINEQ, int32_t, fInt, !=)
+            COMPARE(kCompareSGT, int32_t, fInt, >)
+            COMPARE(kCompareSGTEQ, int32_t, fInt, >=)
+            COMPARE(kCompareSLT, int32_t, fInt, <)
+            COMPARE(kCompareSLTEQ, int32_t, fInt, <=)
+            COMPARE(kCompareUGT, uint32_t, fInt, >)
+            COMPARE(kCompareUGTEQ, uint32_t, fInt, >=)
+            COMPARE(kCompareULT, uint32_t, fInt, <)
+            COMPARE(kCompareULTEQ, uint32_t, fInt, <=)
+            case ByteCodeInstruction::kConvertFtoS:
+                LANES { sp->fLane[i].fInt = sk_float_saturate2int(sp->fLane[i].fFloat); }
+                break;
+            case ByteCodeInstruction::kConvertFtoU:
+                LANES {
+                    float x = sp->fLane[i].fFloat;
+                    sp->fLane[i].fInt = !(x > 0) ? 0 : x < 4294967296.0f ? (uint32_t) x
+                                                                          : 0xFFFFFFFF;
                 }
-                case Token::LOGICALNOT: {
-                    Value base = this->evaluate(*p.fOperand);
-                    return Value(!base.fBool);
+                break;
+            case ByteCodeInstruction::kConvertStoF:
+                LANES { sp->fLane[i].fFloat = (float) sp->fLane[i].fInt; }
+                break;
+            case ByteCodeInstruction::kConvertUtoF:
+                LANES { sp->fLane[i].fFloat = (float) (uint32_t) sp->fLane[i].fInt; }
+                break;
+            BINARY_OP(kDivideF, float, fFloat, /)
+            DIVIDE_S(kDivideS, /, (int32_t) (0 - (uint32_t) x))
+            DIVIDE_U(kDivideU, /)
+            case ByteCodeInstruction::kDup:
+                sp[1] = sp[0];
+                ++sp;
+                break;
+            case ByteCodeInstruction::kLoad:
+                *(++sp) = base[READ16()];
+                break;
+            case ByteCodeInstruction::kLoopBegin:
+                *(++loop) = mask;
+                ++cont;
+                LANES { cont->fLane[i].fInt = ~0; }
+                break;
+            case ByteCodeInstruction::kLoopBreak:
+                LANES { loop->fLane[i].fInt &= ~mask.fLane[i].fInt; }
+                updateMask();
+                break;
+            case ByteCodeInstruction::kLoopContinue:
+                LANES { cont->fLane[i].fInt &= ~mask.fLane[i].fInt; }
+                updateMask();
+                break;
+            case ByteCodeInstruction::kLoopEnd:
+                --loop;
+                --cont;
+                updateMask();
+                break;
+            case ByteCodeInstruction::kLoopMask:
+                LANES { loop->fLane[i].fInt &= sp->fLane[i].fInt; }
+                --sp;
+                updateMask();
+                break;
+            case ByteCodeInstruction::kLoopNext:
+                LANES { cont->fLane[i].fInt = ~0; }
+                updateMask();
+                break;
+            case ByteCodeInstruction::kMaskNegate:
+                LANES { cond[0].fLane[i].fInt = cond[-1].fLane[i].fInt & ~cond[0].fLane[i].fInt; }
+                updateMask();
+                break;
+            case ByteCodeInstruction::kMaskPop:
+                --cond;
+                updateMask();
+                break;
+            case ByteCodeInstruction::kMaskPush:
+                LANES { cond[1].fLane[i].fInt = cond[0].fLane[i].fInt & sp->fLane[i].fInt; }
+                ++cond;
+                --sp;
+                updateMask();
+                break;
+            BINARY_OP(kMultiplyF, float, fFloat, *)
+            BINARY_OP(kMultiplyI, uint32_t, fInt, *)
+            case ByteCodeInstruction::kNegateF:
+                LANES { sp->fLane[i].fFloat = -sp->fLane[i].fFloat; }
+                break;
+            case ByteCodeInstruction::kNegateI:
+                LANES { sp->fLane[i].fInt = (int32_t) (0 - (uint32_t) sp->fLane[i].fInt); }
+                break;
+            case ByteCodeInstruction::kNotB:
+                LANES { sp->fLane[i].fInt = ~sp->fLane[i].fInt; }
+                break;
+            BINARY_OP(kOrB, int32_t, fInt, |)
+            case ByteCodeInstruction::kPop:
+                --sp;
+                break;
+            case ByteCodeInstruction::kPushImmediate: {
+                Value v((int32_t) READ32());
+                ++sp;
+                LANES { sp->fLane[i] = v; }
+                break;
+            }
+            DIVIDE_S(kRemainderS, %, 0)
+            DIVIDE_U(kRemainderU, %)
+            case ByteCodeInstruction::kReturn:
+                SkASSERT(cond == condStack.get() && loop == loopStack.get());
+                return;
+            case ByteCodeInstruction::kReturnMask:
+                LANES { ret.fLane[i].fInt &= ~mask.fLane[i].fInt; }
+                updateMask();
+                break;
+            case ByteCodeInstruction::kSelect: {
+                const VValue& ifFalse = *(sp--);
+                const VValue& ifTrue = *(sp--);
+                VValue& test = *sp;
+                LANES {
+                    test.fLane[i].fInt = (ifTrue.fLane[i].fInt & test.fLane[i].fInt) |
+                                         (ifFalse.fLane[i].fInt & ~test.fLane[i].fInt);
                 }
-                default:
-                    abort();
+                break;
             }
-        }
-        case Expression::kPostfix_Kind: {
-            const PostfixExpression& p = (const PostfixExpression&) expr;
-            StackIndex lvalue = this->getLValue(*p.fOperand);
-            Value result = fStack[lvalue];
-            switch (type_kind(p.fType)) {
-                case kFloat_TypeKind:
-                    if (Token::PLUSPLUS == p.fOperator) {
-                        ++fStack[lvalue].fFloat;
-                    } else {
-                        SkASSERT(Token::MINUSMINUS == p.fOperator);
-                        --fStack[lvalue].fFloat;
-                    }
-                    break;
-                case kInt_TypeKind:
-                    if (Token::PLUSPLUS == p.fOperator) {
-                        ++fStack[lvalue].fInt;
-                    } else {
-                        SkASSERT(Token::MINUSMINUS == p.fOperator);
-                        --fStack[lvalue].fInt;
-                    }
-                    break;
-                default:
-                    abort();
+            case ByteCodeInstruction::kStore: {
+                VValue& dst = base[READ16()];
+                LANES {
+                    dst.fLane[i].fInt = (sp->fLane[i].fInt & mask.fLane[i].fInt) |
+                                        (dst.fLane[i].fInt & ~mask.fLane[i].fInt);
+                }
+                --sp;
+                break;
             }
-            return result;
-        }
-        case Expression::kSetting_Kind:
-            break;
-        case Expression::kSwizzle_Kind:
-            break;
-        case Expression::kVariableReference_Kind:
-            SkASSERT(fVars.size());
-            SkASSERT(fVars.back().find(&((VariableReference&) expr).fVariable) !=
-                   fVars.back().end());
-            return fStack[fVars.back()[&((VariableReference&) expr).fVariable]];
-        case Expression::kTernary_Kind: {
-            const TernaryExpression& t = (const TernaryExpression&) expr;
-            return this->evaluate(this->evaluate(*t.fTest).fBool ? *t.fIfTrue : *t.fIfFalse);
+            BINARY_OP(kSubtractF, float, fFloat, -)
+            BINARY_OP(kSubtractI, uint32_t, fInt, -)
+            BINARY_OP(kXorB, int32_t, fInt, ^)
+            default:
+                ABORT("unsupported instruction %d\n", (int) inst);
         }
-        case Expression::kTypeReference_Kind:
-            break;
-        default:
-            break;
     }
-    ABORT("unsupported expression: %s\n", expr.description().c_str());
 }
 
 } // namespace
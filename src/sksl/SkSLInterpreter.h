@@ -8,80 +8,82 @@
 #ifndef SKSL_INTERPRETER
 #define SKSL_INTERPRETER
 
-#include "ir/SkSLAppendStage.h"
-#include "ir/SkSLExpression.h"
-#include "ir/SkSLFunctionCall.h"
-#include "ir/SkSLFunctionDefinition.h"
+#include "SkSLByteCode.h"
 #include "ir/SkSLProgram.h"
-#include "ir/SkSLStatement.h"
 
-#include <stack>
+#include <memory>
+#include <vector>
 
 class SkRasterPipeline;
 
 namespace SkSL {
 
+/**
+ * Runs ByteCode produced by ByteCodeGenerator. Every instruction operates on VecWidth lanes at
+ * once, so a function can be evaluated for many pixels or particles in one pass. Lanes that take
+ * different paths through the code are handled with masks rather than by diverging.
+ */
 class Interpreter {
-    typedef int StackIndex;
-
-    struct StatementIndex {
-        const Statement* fStatement;
-        size_t fIndex;
-    };
-
 public:
+    static constexpr int VecWidth = 8;
+
     union Value {
+        Value() {}
+
         Value(float f)
         : fFloat(f) {}
 
-        Value(int i)
+        Value(int32_t i)
         : fInt(i) {}
 
+        // bools are lane masks
         Value(bool b)
-        : fBool(b) {}
+        : fInt(b ? ~0 : 0) {}
 
         float fFloat;
-        int fInt;
-        bool fBool;
+        int32_t fInt;
     };
 
-    enum TypeKind {
-        kFloat_TypeKind,
-        kInt_TypeKind,
-        kBool_TypeKind
-    };
+    Interpreter(std::unique_ptr<Program> program, std::unique_ptr<ByteCode> byteCode,
+                SkRasterPipeline* pipeline = nullptr);
 
-    Interpreter(std::unique_ptr<Program> program, SkRasterPipeline* pipeline, std::vector<Value>* stack)
-    : fProgram(std::move(program))
-    , fPipeline(*pipeline)
-    , fStack(*stack) {}
+    ~Interpreter();
 
-    void run();
+    const ByteCode& byteCode() const { return *fByteCode; }
 
-    void run(const FunctionDefinition& f);
-
-    void push(Value value);
-
-    Value pop();
-
-    StackIndex stackAlloc(int count);
+    /**
+     * Runs appendStages(), appending its stages to the pipeline.
+     */
+    void run();
 
-    void runStatement();
+    /**
+     * Runs f once. args holds one Value per parameter, and receives the parameters' final values.
+     * Returns f's result, if it has one.
+     */
+    Value run(const ByteCodeFunction& f, Value args[]);
 
-    StackIndex getLValue(const Expression& expr);
+    /**
+     * Runs f for N independent sets of arguments. args[i] points to N values of parameter i, and
+     * receives their final values. If f returns a value and outReturn is non-null, the N results
+     * are written there.
+     */
+    void runStriped(const ByteCodeFunction& f, int N, Value* args[], Value outReturn[]);
 
-    Value call(const FunctionCall& c);
+private:
+    struct VValue {
+        Value fLane[VecWidth];
+    };
 
-    void appendStage(const AppendStage& c);
+    struct CallbackCtx;
 
-    Value evaluate(const Expression& expr);
+    // Runs f with its frame starting at base, in the lanes enabled by mask.
+    void innerRun(const ByteCodeFunction& f, VValue* base, const VValue& mask);
 
-private:
     std::unique_ptr<Program> fProgram;
-    SkRasterPipeline& fPipeline;
-    std::vector<StatementIndex> fCurrentIndex;
-    std::vector<std::unordered_map<const Variable*, StackIndex>> fVars;
-    std::vector<Value> &fStack;
+    std::unique_ptr<ByteCode> fByteCode;
+    SkRasterPipeline* fPipeline;
+    std::vector<VValue> fStack;
+    std::vector<std::unique_ptr<CallbackCtx>> fCallbacks;
 };
 
 } // namespace
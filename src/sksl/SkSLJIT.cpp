@@ -121,6 +121,7 @@ JIT::JIT(Compiler* compiler)
 }
 
 JIT::~JIT() {
+    fModuleCache.clear();
     LLVMOrcDisposeInstance(fJITStack);
     LLVMContextDispose(fContext);
 }
@@ -259,13 +260,13 @@ LLVMTypeRef JIT::getType(const Type& type) {
             if (type.name() == "float4" || type.name() == "half4") {
                 return fFloat32Vector4Type;
             }
-            if (type.name() == "int2" || type.name() == "short2" || type.name == "byte2") {
+            if (type.name() == "int2" || type.name() == "short2" || type.name() == "byte2") {
                 return fInt32Vector2Type;
             }
-            if (type.name() == "int3" || type.name() == "short3" || type.name == "byte3") {
+            if (type.name() == "int3" || type.name() == "short3" || type.name() == "byte3") {
                 return fInt32Vector3Type;
             }
-            if (type.name() == "int4" || type.name() == "short4" || type.name == "byte3") {
+            if (type.name() == "int4" || type.name() == "short4" || type.name() == "byte4") {
                 return fInt32Vector4Type;
             }
             // fall through
@@ -778,15 +779,21 @@ LLVMValueRef JIT::compilePostfix(LLVMBuilderRef builder, const PostfixExpression
 }
 
 LLVMValueRef JIT::compilePrefix(LLVMBuilderRef builder, const PrefixExpression& p) {
-    LLVMValueRef one = LLVMConstInt(this->getType(p.fType), 1, false);
     if (Token::LOGICALNOT == p.fOperator) {
         LLVMValueRef base = this->compileExpression(builder, *p.fOperand);
-        return LLVMBuildXor(builder, base, one, "!");
+        return LLVMBuildNot(builder, base, "!");
     }
     if (Token::MINUS == p.fOperator) {
         LLVMValueRef base = this->compileExpression(builder, *p.fOperand);
-        return LLVMBuildSub(builder, LLVMConstInt(this->getType(p.fType), 0, false), base, "-");
+        if (kFloat_TypeKind == this->typeKind(p.fType)) {
+            return LLVMBuildFNeg(builder, base, "-");
+        }
+        return LLVMBuildNeg(builder, base, "-");
     }
+    LLVMValueRef one = kFloat_TypeKind == this->typeKind(p.fType)
+                                                     ? LLVMConstReal(this->getType(p.fType), 1)
+                                                     : LLVMConstInt(this->getType(p.fType), 1,
+                                                                    false);
     std::unique_ptr<LValue> lvalue = this->getLValue(builder, *p.fOperand);
     LLVMValueRef raw = lvalue->load(builder);
     LLVMValueRef result;
@@ -1395,12 +1402,19 @@ void JIT::compileStageFunctionLoop(const FunctionDefinition& f, LLVMValueRef new
 bool JIT::getVectorLValue(LLVMBuilderRef builder, const Expression& e,
                           LLVMValueRef out[CHANNELS]) {
     switch (e.fKind) {
-        case Expression::kVariableReference_Kind:
-            if (fColorParam == &((VariableReference&) e).fVariable) {
+        case Expression::kVariableReference_Kind: {
+            const Variable& var = ((VariableReference&) e).fVariable;
+            if (fColorParam == &var) {
                 memcpy(out, fChannels, sizeof(fChannels));
                 return true;
             }
+            auto found = fVectorVariables.find(&var);
+            if (found != fVectorVariables.end()) {
+                memcpy(out, found->second.fChannels, sizeof(found->second.fChannels));
+                return true;
+            }
             return false;
+        }
         case Expression::kSwizzle_Kind: {
             const Swizzle& s = (const Swizzle&) e;
             LLVMValueRef base[CHANNELS];
@@ -1441,32 +1455,133 @@ bool JIT::getVectorBinaryOperands(LLVMBuilderRef builder, const Expression& left
     return true;
 }
 
+LLVMTypeRef JIT::getVectorType(const Type& type) {
+    switch (type.kind()) {
+        case Type::kScalar_Kind:
+            return LLVMVectorType(this->getType(type), fVectorCount);
+        case Type::kVector_Kind:
+            return LLVMVectorType(this->getType(type.componentType()), fVectorCount);
+        default:
+            return nullptr;
+    }
+}
+
+LLVMValueRef JIT::splat(LLVMBuilderRef builder, LLVMValueRef value) {
+    LLVMValueRef result = LLVMBuildInsertElement(builder,
+                                                 LLVMGetUndef(LLVMVectorType(LLVMTypeOf(value),
+                                                                             fVectorCount)),
+                                                 value, LLVMConstInt(fInt32Type, 0, false),
+                                                 "splat insert");
+    return LLVMBuildShuffleVector(builder, result, result, LLVMConstNull(fInt32VectorType),
+                                  "splat");
+}
+
+void JIT::storeVector(LLVMBuilderRef builder, LLVMValueRef value, LLVMValueRef ptr) {
+    if (fVectorMask) {
+        LLVMValueRef old = LLVMBuildLoad(builder, ptr, "masked load");
+        value = LLVMBuildSelect(builder, fVectorMask, value, old, "masked select");
+    }
+    LLVMBuildStore(builder, value, ptr);
+}
+
+LLVMValueRef JIT::compileVectorOperator(LLVMBuilderRef builder, Token::Kind op, const Type& type,
+                                        LLVMValueRef left, LLVMValueRef right) {
+    const Type& component = type.kind() == Type::kVector_Kind ? type.componentType() : type;
+    if (component == *fProgram->fContext->fBool_Type) {
+        switch (op) {
+            case Token::EQEQ:       return LLVMBuildICmp(builder, LLVMIntEQ, left, right, "==");
+            case Token::NEQ:        return LLVMBuildICmp(builder, LLVMIntNE, left, right, "!=");
+            case Token::LOGICALAND: return LLVMBuildAnd(builder, left, right, "&&");
+            case Token::LOGICALOR:  return LLVMBuildOr(builder, left, right, "||");
+            case Token::LOGICALXOR: return LLVMBuildXor(builder, left, right, "^^");
+            default:                return nullptr;
+        }
+    }
+    #define VECTOR_OP(signedOp, unsignedOp, floatOp)                \
+        switch (this->typeKind(type)) {                             \
+            case kInt_TypeKind:                                     \
+                return signedOp(builder, left, right, "binary");    \
+            case kUInt_TypeKind:                                    \
+                return unsignedOp(builder, left, right, "binary");  \
+            case kFloat_TypeKind:                                   \
+                return floatOp(builder, left, right, "binary");     \
+            case kBool_TypeKind:                                    \
+                return nullptr;                                     \
+        }
+    #define VECTOR_COMPARE(signedPred, unsignedPred, floatPred)                         \
+        switch (this->typeKind(type)) {                                                 \
+            case kInt_TypeKind:                                                         \
+                return LLVMBuildICmp(builder, signedPred, left, right, "compare");      \
+            case kUInt_TypeKind:                                                        \
+                return LLVMBuildICmp(builder, unsignedPred, left, right, "compare");    \
+            case kFloat_TypeKind:                                                       \
+                return LLVMBuildFCmp(builder, floatPred, left, right, "compare");       \
+            case kBool_TypeKind:                                                        \
+                return nullptr;                                                         \
+        }
+    switch (op) {
+        case Token::PLUS:
+        case Token::PLUSEQ:
+            VECTOR_OP(LLVMBuildAdd, LLVMBuildAdd, LLVMBuildFAdd);
+            break;
+        case Token::MINUS:
+        case Token::MINUSEQ:
+            VECTOR_OP(LLVMBuildSub, LLVMBuildSub, LLVMBuildFSub);
+            break;
+        case Token::STAR:
+        case Token::STAREQ:
+            VECTOR_OP(LLVMBuildMul, LLVMBuildMul, LLVMBuildFMul);
+            break;
+        case Token::SLASH:
+        case Token::SLASHEQ:
+            VECTOR_OP(LLVMBuildSDiv, LLVMBuildUDiv, LLVMBuildFDiv);
+            break;
+        case Token::PERCENT:
+        case Token::PERCENTEQ:
+            VECTOR_OP(LLVMBuildSRem, LLVMBuildURem, LLVMBuildFRem);
+            break;
+        case Token::BITWISEAND:
+        case Token::BITWISEANDEQ:
+            if (this->typeKind(type) != kFloat_TypeKind) {
+                return LLVMBuildAnd(builder, left, right, "&");
+            }
+            break;
+        case Token::BITWISEOR:
+        case Token::BITWISEOREQ:
+            if (this->typeKind(type) != kFloat_TypeKind) {
+                return LLVMBuildOr(builder, left, right, "|");
+            }
+            break;
+        case Token::EQEQ:
+            VECTOR_COMPARE(LLVMIntEQ, LLVMIntEQ, LLVMRealOEQ);
+            break;
+        case Token::NEQ:
+            VECTOR_COMPARE(LLVMIntNE, LLVMIntNE, LLVMRealONE);
+            break;
+        case Token::LT:
+            VECTOR_COMPARE(LLVMIntSLT, LLVMIntULT, LLVMRealOLT);
+            break;
+        case Token::LTEQ:
+            VECTOR_COMPARE(LLVMIntSLE, LLVMIntULE, LLVMRealOLE);
+            break;
+        case Token::GT:
+            VECTOR_COMPARE(LLVMIntSGT, LLVMIntUGT, LLVMRealOGT);
+            break;
+        case Token::GTEQ:
+            VECTOR_COMPARE(LLVMIntSGE, LLVMIntUGE, LLVMRealOGE);
+            break;
+        default:
+            break;
+    }
+    #undef VECTOR_OP
+    #undef VECTOR_COMPARE
+    return nullptr;
+}
+
 bool JIT::compileVectorBinary(LLVMBuilderRef builder, const BinaryExpression& b,
                               LLVMValueRef out[CHANNELS]) {
     LLVMValueRef left[CHANNELS];
     LLVMValueRef right[CHANNELS];
-    #define VECTOR_BINARY(signedOp, unsignedOp, floatOp) {                               \
-        if (!this->getVectorBinaryOperands(builder, *b.fLeft, left, *b.fRight, right)) { \
-            return false;                                                                \
-        }                                                                                \
-        for (int i = 0; i < b.fLeft->fType.columns(); ++i) {                             \
-            switch (this->typeKind(b.fLeft->fType)) {                                    \
-                case kInt_TypeKind:                                                      \
-                    out[i] = signedOp(builder, left[i], right[i], "binary");             \
-                    break;                                                               \
-                case kUInt_TypeKind:                                                     \
-                    out[i] = unsignedOp(builder, left[i], right[i], "binary");           \
-                    break;                                                               \
-                case kFloat_TypeKind:                                                    \
-                    out[i] = floatOp(builder, left[i], right[i], "binary");              \
-                    break;                                                               \
-                case kBool_TypeKind:                                                     \
-                    SkASSERT(false);                                                       \
-                    break;                                                               \
-            }                                                                            \
-        }                                                                                \
-        return true;                                                                     \
-    }
     switch (b.fOperator) {
         case Token::EQ: {
             if (!this->getVectorLValue(builder, *b.fLeft, left)) {
@@ -1477,28 +1592,80 @@ bool JIT::compileVectorBinary(LLVMBuilderRef builder, const BinaryExpression& b,
             }
             int columns = b.fRight->fType.columns();
             for (int i = 0; i < columns; ++i) {
-                LLVMBuildStore(builder, right[i], left[i]);
+                this->storeVector(builder, right[i], left[i]);
+                out[i] = right[i];
             }
             return true;
         }
-        case Token::PLUS:
-            VECTOR_BINARY(LLVMBuildAdd, LLVMBuildAdd, LLVMBuildFAdd);
-        case Token::MINUS:
-            VECTOR_BINARY(LLVMBuildSub, LLVMBuildSub, LLVMBuildFSub);
-        case Token::STAR:
-            VECTOR_BINARY(LLVMBuildMul, LLVMBuildMul, LLVMBuildFMul);
-        case Token::SLASH:
-            VECTOR_BINARY(LLVMBuildSDiv, LLVMBuildUDiv, LLVMBuildFDiv);
-        case Token::PERCENT:
-            VECTOR_BINARY(LLVMBuildSRem, LLVMBuildURem, LLVMBuildSRem);
-        case Token::BITWISEAND:
-            VECTOR_BINARY(LLVMBuildAnd, LLVMBuildAnd, LLVMBuildAnd);
-        case Token::BITWISEOR:
-            VECTOR_BINARY(LLVMBuildOr, LLVMBuildOr, LLVMBuildOr);
+        case Token::PLUSEQ:       // fall through
+        case Token::MINUSEQ:      // fall through
+        case Token::STAREQ:       // fall through
+        case Token::SLASHEQ:      // fall through
+        case Token::PERCENTEQ:    // fall through
+        case Token::BITWISEANDEQ: // fall through
+        case Token::BITWISEOREQ: {
+            if (!this->getVectorLValue(builder, *b.fLeft, left)) {
+                return false;
+            }
+            if (!this->compileVectorExpression(builder, *b.fRight, right)) {
+                return false;
+            }
+            int columns = b.fLeft->fType.columns();
+            for (int i = 0; i < columns; ++i) {
+                LLVMValueRef value = this->compileVectorOperator(
+                                       builder, b.fOperator, b.fLeft->fType,
+                                       LLVMBuildLoad(builder, left[i], "compound load"),
+                                       b.fRight->fType.columns() == 1 ? right[0] : right[i]);
+                if (!value) {
+                    return false;
+                }
+                this->storeVector(builder, value, left[i]);
+                out[i] = value;
+            }
+            return true;
+        }
+        case Token::LOGICALAND: // fall through
+        case Token::LOGICALOR:
+            // both sides are evaluated for every pixel, which is only safe without side effects
+            if (b.fRight->hasSideEffects()) {
+                return false;
+            }
+            break;
+        case Token::EQEQ: // fall through
+        case Token::NEQ:
+            // comparing vectors produces a single bool, which would need a horizontal reduction
+            if (b.fLeft->fType.columns() > 1) {
+                return false;
+            }
+            break;
         default:
-            printf("unsupported operator: %s\n", b.description().c_str());
+            break;
+    }
+    if (!this->getVectorBinaryOperands(builder, *b.fLeft, left, *b.fRight, right)) {
+        return false;
+    }
+    const Type& operandType = b.fLeft->fType.columns() >= b.fRight->fType.columns()
+                                                                               ? b.fLeft->fType
+                                                                               : b.fRight->fType;
+    for (int i = 0; i < operandType.columns(); ++i) {
+        out[i] = this->compileVectorOperator(builder, b.fOperator, operandType, left[i],
+                                             right[i]);
+        if (!out[i]) {
             return false;
+        }
+    }
+    return true;
+}
+
+bool JIT::compileVectorBoolLiteral(LLVMBuilderRef builder, const BoolLiteral& b,
+                                   LLVMValueRef out[CHANNELS]) {
+    LLVMValueRef value = LLVMConstInt(fInt1Type, b.fValue, false);
+    LLVMValueRef values[MAX_VECTOR_COUNT];
+    for (int i = 0; i < fVectorCount; ++i) {
+        values[i] = value;
     }
+    out[0] = LLVMConstVector(values, fVectorCount);
+    return true;
 }
 
 bool JIT::compileVectorConstructor(LLVMBuilderRef builder, const Constructor& c,
@@ -1506,24 +1673,26 @@ bool JIT::compileVectorConstructor(LLVMBuilderRef builder, const Constructor& c,
     switch (c.fType.kind()) {
         case Type::kScalar_Kind: {
             SkASSERT(c.fArguments.size() == 1);
+            const Type& bool_type = *fProgram->fContext->fBool_Type;
+            if (c.fType == bool_type || c.fArguments[0]->fType == bool_type) {
+                return false;
+            }
             TypeKind from = this->typeKind(c.fArguments[0]->fType);
             TypeKind to = this->typeKind(c.fType);
             LLVMValueRef base[CHANNELS];
             if (!this->compileVectorExpression(builder, *c.fArguments[0], base)) {
                 return false;
             }
-            #define CONSTRUCT(fn)                                                                \
-                out[0] = LLVMGetUndef(LLVMVectorType(this->getType(c.fType), fVectorCount));     \
-                for (int i = 0; i < fVectorCount; ++i) {                                         \
-                    LLVMValueRef index = LLVMConstInt(fInt32Type, i, false);                     \
-                    LLVMValueRef baseVal = LLVMBuildExtractElement(builder, base[0], index,      \
-                                                                   "construct extract");         \
-                    out[0] = LLVMBuildInsertElement(builder, out[0],                             \
-                                                    fn(builder, baseVal, this->getType(c.fType), \
-                                                       "cast"),                                  \
-                                                    index, "construct insert");                  \
-                }                                                                                \
+            // conversions apply to every pixel at once
+            LLVMTypeRef type = this->getVectorType(c.fType);
+            #define CONSTRUCT(fn)                           \
+                out[0] = fn(builder, base[0], type, "cast"); \
+                return true;
+            if (from == to || (kInt_TypeKind == to && kUInt_TypeKind == from) ||
+                (kUInt_TypeKind == to && kInt_TypeKind == from)) {
+                out[0] = base[0];
                 return true;
+            }
             if (kFloat_TypeKind == to) {
                 if (kInt_TypeKind == from) {
                     CONSTRUCT(LLVMBuildSIToFP);
@@ -1536,38 +1705,36 @@ bool JIT::compileVectorConstructor(LLVMBuilderRef builder, const Constructor& c,
                 if (kFloat_TypeKind == from) {
                     CONSTRUCT(LLVMBuildFPToSI);
                 }
-                if (kUInt_TypeKind == from) {
-                    return true;
-                }
             }
             if (kUInt_TypeKind == to) {
                 if (kFloat_TypeKind == from) {
                     CONSTRUCT(LLVMBuildFPToUI);
                 }
-                if (kInt_TypeKind == from) {
-                    return base;
-                }
             }
+            #undef CONSTRUCT
             printf("%s\n", c.description().c_str());
             ABORT("unsupported constructor");
         }
         case Type::kVector_Kind: {
-            if (c.fArguments.size() == 1) {
-                LLVMValueRef base[CHANNELS];
-                if (!this->compileVectorExpression(builder, *c.fArguments[0], base)) {
+            int column = 0;
+            for (const auto& arg : c.fArguments) {
+                if (this->getVectorType(arg->fType) != this->getVectorType(c.fType)) {
+                    // needs a conversion
                     return false;
                 }
-                for (int i = 0; i < c.fType.columns(); ++i) {
-                    out[i] = base[0];
+                LLVMValueRef base[CHANNELS];
+                if (!this->compileVectorExpression(builder, *arg, base)) {
+                    return false;
                 }
-            } else {
-                SkASSERT(c.fArguments.size() == (size_t) c.fType.columns());
-                for (int i = 0; i < c.fType.columns(); ++i) {
-                    LLVMValueRef base[CHANNELS];
-                    if (!this->compileVectorExpression(builder, *c.fArguments[i], base)) {
-                        return false;
+                if (c.fArguments.size() == 1 && arg->fType.columns() == 1) {
+                    for (int i = 0; i < c.fType.columns(); ++i) {
+                        out[i] = base[0];
                     }
-                    out[i] = base[0];
+                    return true;
+                }
+                for (int i = 0; i < arg->fType.columns(); ++i) {
+                    SkASSERT(column < c.fType.columns());
+                    out[column++] = base[i];
                 }
             }
             return true;
@@ -1575,7 +1742,7 @@ bool JIT::compileVectorConstructor(LLVMBuilderRef builder, const Constructor& c,
         default:
             break;
     }
-    ABORT("unsupported constructor");
+    return false;
 }
 
 bool JIT::compileVectorFloatLiteral(LLVMBuilderRef builder,
@@ -1590,6 +1757,44 @@ bool JIT::compileVectorFloatLiteral(LLVMBuilderRef builder,
     return true;
 }
 
+bool JIT::compileVectorIntLiteral(LLVMBuilderRef builder,
+                                  const IntLiteral& i,
+                                  LLVMValueRef out[CHANNELS]) {
+    LLVMValueRef value = LLVMConstInt(this->getType(i.fType), i.fValue, true);
+    LLVMValueRef values[MAX_VECTOR_COUNT];
+    for (int j = 0; j < fVectorCount; ++j) {
+        values[j] = value;
+    }
+    out[0] = LLVMConstVector(values, fVectorCount);
+    return true;
+}
+
+bool JIT::compileVectorPrefix(LLVMBuilderRef builder, const PrefixExpression& p,
+                              LLVMValueRef out[CHANNELS]) {
+    LLVMValueRef base[CHANNELS];
+    switch (p.fOperator) {
+        case Token::MINUS:
+            if (!this->compileVectorExpression(builder, *p.fOperand, base)) {
+                return false;
+            }
+            for (int i = 0; i < p.fType.columns(); ++i) {
+                if (kFloat_TypeKind == this->typeKind(p.fType)) {
+                    out[i] = LLVMBuildFNeg(builder, base[i], "-");
+                } else {
+                    out[i] = LLVMBuildNeg(builder, base[i], "-");
+                }
+            }
+            return true;
+        case Token::LOGICALNOT:
+            if (!this->compileVectorExpression(builder, *p.fOperand, base)) {
+                return false;
+            }
+            out[0] = LLVMBuildNot(builder, base[0], "!");
+            return true;
+        default:
+            return false;
+    }
+}
 
 bool JIT::compileVectorSwizzle(LLVMBuilderRef builder, const Swizzle& s,
                                LLVMValueRef out[CHANNELS]) {
@@ -1603,6 +1808,26 @@ bool JIT::compileVectorSwizzle(LLVMBuilderRef builder, const Swizzle& s,
     return true;
 }
 
+bool JIT::compileVectorTernary(LLVMBuilderRef builder, const TernaryExpression& t,
+                               LLVMValueRef out[CHANNELS]) {
+    // both sides are evaluated for every pixel, which is only safe without side effects
+    if (t.fIfTrue->hasSideEffects() || t.fIfFalse->hasSideEffects()) {
+        return false;
+    }
+    LLVMValueRef test[CHANNELS];
+    LLVMValueRef ifTrue[CHANNELS];
+    LLVMValueRef ifFalse[CHANNELS];
+    if (!this->compileVectorExpression(builder, *t.fTest, test) ||
+        !this->compileVectorExpression(builder, *t.fIfTrue, ifTrue) ||
+        !this->compileVectorExpression(builder, *t.fIfFalse, ifFalse)) {
+        return false;
+    }
+    for (int i = 0; i < t.fType.columns(); ++i) {
+        out[i] = LLVMBuildSelect(builder, test[0], ifTrue[i], ifFalse[i], "?");
+    }
+    return true;
+}
+
 bool JIT::compileVectorVariableReference(LLVMBuilderRef builder, const VariableReference& v,
                                          LLVMValueRef out[CHANNELS]) {
     if (&v.fVariable == fColorParam) {
@@ -1611,6 +1836,13 @@ bool JIT::compileVectorVariableReference(LLVMBuilderRef builder, const VariableR
         }
         return true;
     }
+    auto found = fVectorVariables.find(&v.fVariable);
+    if (found != fVectorVariables.end()) {
+        for (int i = 0; i < v.fVariable.fType.columns(); ++i) {
+            out[i] = LLVMBuildLoad(builder, found->second.fChannels[i], "variable reference");
+        }
+        return true;
+    }
     return false;
 }
 
@@ -1619,12 +1851,20 @@ bool JIT::compileVectorExpression(LLVMBuilderRef builder, const Expression& expr
     switch (expr.fKind) {
         case Expression::kBinary_Kind:
             return this->compileVectorBinary(builder, (const BinaryExpression&) expr, out);
+        case Expression::kBoolLiteral_Kind:
+            return this->compileVectorBoolLiteral(builder, (const BoolLiteral&) expr, out);
         case Expression::kConstructor_Kind:
             return this->compileVectorConstructor(builder, (const Constructor&) expr, out);
         case Expression::kFloatLiteral_Kind:
             return this->compileVectorFloatLiteral(builder, (const FloatLiteral&) expr, out);
+        case Expression::kIntLiteral_Kind:
+            return this->compileVectorIntLiteral(builder, (const IntLiteral&) expr, out);
+        case Expression::kPrefix_Kind:
+            return this->compileVectorPrefix(builder, (const PrefixExpression&) expr, out);
         case Expression::kSwizzle_Kind:
             return this->compileVectorSwizzle(builder, (const Swizzle&) expr, out);
+        case Expression::kTernary_Kind:
+            return this->compileVectorTernary(builder, (const TernaryExpression&) expr, out);
         case Expression::kVariableReference_Kind:
             return this->compileVectorVariableReference(builder, (const VariableReference&) expr,
                                                         out);
@@ -1633,6 +1873,52 @@ bool JIT::compileVectorExpression(LLVMBuilderRef builder, const Expression& expr
     }
 }
 
+bool JIT::compileVectorIf(LLVMBuilderRef builder, const IfStatement& i) {
+    LLVMValueRef test[CHANNELS];
+    if (!this->compileVectorExpression(builder, *i.fTest, test)) {
+        return false;
+    }
+    LLVMValueRef oldMask = fVectorMask;
+    fVectorMask = oldMask ? LLVMBuildAnd(builder, oldMask, test[0], "if true mask") : test[0];
+    bool success = this->compileVectorStatement(builder, *i.fIfTrue);
+    if (success && i.fIfFalse) {
+        LLVMValueRef notTest = LLVMBuildNot(builder, test[0], "!test");
+        fVectorMask = oldMask ? LLVMBuildAnd(builder, oldMask, notTest, "if false mask") : notTest;
+        success = this->compileVectorStatement(builder, *i.fIfFalse);
+    }
+    fVectorMask = oldMask;
+    return success;
+}
+
+bool JIT::compileVectorVarDeclarations(LLVMBuilderRef builder,
+                                       const VarDeclarationsStatement& decls) {
+    for (const auto& declStatement : decls.fDeclaration->fVars) {
+        const VarDeclaration& decl = (VarDeclaration&) *declStatement;
+        LLVMTypeRef type = this->getVectorType(decl.fVar->fType);
+        if (!type) {
+            return false;
+        }
+        VectorVariable& var = fVectorVariables[decl.fVar];
+        LLVMPositionBuilderAtEnd(builder, fAllocaBlock);
+        for (int i = 0; i < decl.fVar->fType.columns(); ++i) {
+            var.fChannels[i] = LLVMBuildAlloca(builder, type, String(decl.fVar->fName).c_str());
+        }
+        LLVMPositionBuilderAtEnd(builder, fCurrentBlock);
+        if (decl.fValue) {
+            LLVMValueRef value[CHANNELS];
+            if (!this->compileVectorExpression(builder, *decl.fValue, value)) {
+                return false;
+            }
+            // the variable is not visible outside of the current mask, so there is no need to
+            // preserve the other pixels
+            for (int i = 0; i < decl.fVar->fType.columns(); ++i) {
+                LLVMBuildStore(builder, value[i], var.fChannels[i]);
+            }
+        }
+    }
+    return true;
+}
+
 bool JIT::compileVectorStatement(LLVMBuilderRef builder, const Statement& stmt) {
     switch (stmt.fKind) {
         case Statement::kBlock_Kind:
@@ -1642,11 +1928,19 @@ bool JIT::compileVectorStatement(LLVMBuilderRef builder, const Statement& stmt)
                 }
             }
             return true;
-        case Statement::kExpression_Kind:
-            LLVMValueRef result;
+        case Statement::kExpression_Kind: {
+            LLVMValueRef result[CHANNELS];
             return this->compileVectorExpression(builder,
                                                  *((const ExpressionStatement&) stmt).fExpression,
-                                                 &result);
+                                                 result);
+        }
+        case Statement::kIf_Kind:
+            return this->compileVectorIf(builder, (const IfStatement&) stmt);
+        case Statement::kNop_Kind:
+            return true;
+        case Statement::kVarDeclarations_Kind:
+            return this->compileVectorVarDeclarations(builder,
+                                                      (const VarDeclarationsStatement&) stmt);
         default:
             return false;
     }
@@ -1671,9 +1965,30 @@ bool JIT::compileStageFunctionVector(const FunctionDefinition& f, LLVMValueRef n
     LLVMBuildStore(builder, params.get()[6], fChannels[2]);
     fChannels[3] = LLVMBuildAlloca(builder, fFloat32VectorType, "aVec");
     LLVMBuildStore(builder, params.get()[7], fChannels[3]);
+    // x counts up across the pixels, y is the same for all of them
+    fVectorVariables.clear();
+    fVectorMask = nullptr;
+    LLVMValueRef xOffsets[MAX_VECTOR_COUNT];
+    for (int i = 0; i < fVectorCount; ++i) {
+        xOffsets[i] = LLVMConstInt(fInt32Type, i, false);
+    }
+    LLVMValueRef xVec = LLVMBuildAdd(builder,
+                                     this->splat(builder, LLVMBuildTrunc(builder, params.get()[2],
+                                                                         fInt32Type, "x->Int32")),
+                                     LLVMConstVector(xOffsets, fVectorCount), "xVec");
+    LLVMValueRef yVec = this->splat(builder, LLVMBuildTrunc(builder, params.get()[3], fInt32Type,
+                                                            "y->Int32"));
+    VectorVariable& x = fVectorVariables[f.fDeclaration.fParameters[0]];
+    x.fChannels[0] = LLVMBuildAlloca(builder, fInt32VectorType, "x");
+    LLVMBuildStore(builder, xVec, x.fChannels[0]);
+    VectorVariable& y = fVectorVariables[f.fDeclaration.fParameters[1]];
+    y.fChannels[0] = LLVMBuildAlloca(builder, fInt32VectorType, "y");
+    LLVMBuildStore(builder, yVec, y.fChannels[0]);
     LLVMBasicBlockRef start = LLVMAppendBasicBlockInContext(fContext, fCurrentFunction, "start");
     this->setBlock(builder, start);
     bool success = this->compileVectorStatement(builder, *f.fBody);
+    fVectorVariables.clear();
+    fVectorMask = nullptr;
     if (success) {
         // increment program pointer, call next
         LLVMValueRef rawNextPtr = LLVMBuildLoad(builder, programParam, "next load");
@@ -1853,6 +2168,22 @@ std::unique_ptr<JIT::Module> JIT::compile(std::unique_ptr<Program> program) {
     return std::unique_ptr<Module>(new Module(std::move(fProgram), fSharedModule, fJITStack));
 }
 
+JIT::Module* JIT::compileCached(const String& source) {
+    auto found = fModuleCache.find(source);
+    if (found != fModuleCache.end()) {
+        return found->second.get();
+    }
+    Program::Settings settings;
+    std::unique_ptr<Program> program = fCompiler.convertProgram(Program::kPipelineStage_Kind,
+                                                                source, settings);
+    if (!program) {
+        return nullptr;
+    }
+    std::unique_ptr<Module>& result = fModuleCache[source];
+    result = this->compile(std::move(program));
+    return result.get();
+}
+
 void JIT::optimize() {
     LLVMPassManagerBuilderRef pmb = LLVMPassManagerBuilderCreate();
     LLVMPassManagerBuilderSetOptLevel(pmb, 3);
@@ -11,6 +11,7 @@
 #ifdef SK_LLVM_AVAILABLE
 
 #include "ir/SkSLBinaryExpression.h"
+#include "ir/SkSLBoolLiteral.h"
 #include "ir/SkSLBreakStatement.h"
 #include "ir/SkSLContinueStatement.h"
 #include "ir/SkSLExpression.h"
@@ -20,6 +21,7 @@
 #include "ir/SkSLFunctionDefinition.h"
 #include "ir/SkSLIfStatement.h"
 #include "ir/SkSLIndexExpression.h"
+#include "ir/SkSLIntLiteral.h"
 #include "ir/SkSLPrefixExpression.h"
 #include "ir/SkSLPostfixExpression.h"
 #include "ir/SkSLProgram.h"
@@ -120,6 +122,13 @@ public:
      */
     std::unique_ptr<Module> compile(std::unique_ptr<Program> program);
 
+    /**
+     * Converts and compiles a pipeline stage program, or returns the Module previously compiled
+     * from the same source. The Module is owned by the JIT. Returns null if the program fails to
+     * convert.
+     */
+    Module* compileCached(const String& source);
+
 private:
     static constexpr int CHANNELS = 4;
 
@@ -218,18 +227,56 @@ private:
     // leaving out[3] uninitialized.
     // As the number of outputs can be inferred from the type of the expression, it is not
     // explicitly signalled anywhere.
+    //
+    // Control flow is vectorized with masks: both sides of an if are run for every pixel, with
+    // stores restricted to the pixels which took that side.
+
+    /**
+     * Returns the type of one channel of a vectorized value of the given type, or null if the
+     * type cannot be vectorized.
+     */
+    LLVMTypeRef getVectorType(const Type& type);
+
+    /**
+     * Returns a vector with every pixel set to the given scalar.
+     */
+    LLVMValueRef splat(LLVMBuilderRef builder, LLVMValueRef value);
+
+    /**
+     * Stores a channel, leaving the pixels which are masked off untouched.
+     */
+    void storeVector(LLVMBuilderRef builder, LLVMValueRef value, LLVMValueRef ptr);
+
+    /**
+     * Applies a binary operator to a single channel, returning null if it is not supported.
+     */
+    LLVMValueRef compileVectorOperator(LLVMBuilderRef builder, Token::Kind op, const Type& type,
+                                       LLVMValueRef left, LLVMValueRef right);
+
     bool compileVectorBinary(LLVMBuilderRef builder, const BinaryExpression& b,
                              LLVMValueRef out[CHANNELS]);
 
+    bool compileVectorBoolLiteral(LLVMBuilderRef builder, const BoolLiteral& b,
+                                  LLVMValueRef out[CHANNELS]);
+
     bool compileVectorConstructor(LLVMBuilderRef builder, const Constructor& c,
                                   LLVMValueRef out[CHANNELS]);
 
     bool compileVectorFloatLiteral(LLVMBuilderRef builder, const FloatLiteral& f,
                                    LLVMValueRef out[CHANNELS]);
 
+    bool compileVectorIntLiteral(LLVMBuilderRef builder, const IntLiteral& i,
+                                 LLVMValueRef out[CHANNELS]);
+
+    bool compileVectorPrefix(LLVMBuilderRef builder, const PrefixExpression& p,
+                             LLVMValueRef out[CHANNELS]);
+
     bool compileVectorSwizzle(LLVMBuilderRef builder, const Swizzle& s,
                               LLVMValueRef out[CHANNELS]);
 
+    bool compileVectorTernary(LLVMBuilderRef builder, const TernaryExpression& t,
+                              LLVMValueRef out[CHANNELS]);
+
     bool compileVectorVariableReference(LLVMBuilderRef builder, const VariableReference& v,
                                         LLVMValueRef out[CHANNELS]);
 
@@ -246,6 +293,11 @@ private:
                                  LLVMValueRef outLeft[CHANNELS], const Expression& right,
                                  LLVMValueRef outRight[CHANNELS]);
 
+    bool compileVectorIf(LLVMBuilderRef builder, const IfStatement& i);
+
+    bool compileVectorVarDeclarations(LLVMBuilderRef builder,
+                                      const VarDeclarationsStatement& decls);
+
     bool compileVectorStatement(LLVMBuilderRef builder, const Statement& stmt);
 
     /**
@@ -293,6 +345,10 @@ private:
 
     static uint64_t resolveSymbol(const char* name, JIT* jit);
 
+    struct VectorVariable {
+        LLVMValueRef fChannels[CHANNELS];
+    };
+
     const char* fCPU;
     int fVectorCount;
     Compiler& fCompiler;
@@ -330,6 +386,12 @@ private:
     LLVMValueRef fChannels[CHANNELS];
     // when processing a stage function, this points to the SkSL color parameter (an inout float4)
     const Variable* fColorParam;
+    // when vectorizing a stage function, the locals and the x and y parameters, one alloca per
+    // component
+    std::unordered_map<const Variable*, VectorVariable> fVectorVariables;
+    // when vectorizing a stage function, the pixels which are running the current code, or null
+    // if all of them are
+    LLVMValueRef fVectorMask;
     std::unordered_map<const FunctionDeclaration*, LLVMValueRef> fFunctions;
     std::unordered_map<const Variable*, LLVMValueRef> fVariables;
     // LLVM function parameters are read-only, so when modifying function parameters we need to
@@ -347,6 +409,8 @@ private:
     LLVMValueRef fAppendFunc;
     LLVMValueRef fAppendCallbackFunc;
     LLVMValueRef fDebugFunc;
+
+    std::unordered_map<String, std::unique_ptr<Module>> fModuleCache;
 };
 
 } // namespace
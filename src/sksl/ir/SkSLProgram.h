@@ -97,6 +97,10 @@ struct Program {
         bool fForceHighPrecision = false;
         // if true, add -0.5 bias to LOD of all texture lookups
         bool fSharpenTextures = false;
+        // functions whose body is a single return of at most this many expression nodes are
+        // inlined; functions with only one call site are inlined regardless of size. Zero disables
+        // inlining.
+        int fInlineThreshold = 20;
         std::unordered_map<String, Value> fArgs;
     };
 
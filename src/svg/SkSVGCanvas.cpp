@@ -10,11 +10,13 @@
 #include "SkMakeUnique.h"
 #include "SkXMLWriter.h"
 
-std::unique_ptr<SkCanvas> SkSVGCanvas::Make(const SkRect& bounds, SkWStream* writer) {
+std::unique_ptr<SkCanvas> SkSVGCanvas::Make(const SkRect& bounds, SkWStream* writer,
+                                            uint32_t flags) {
     // TODO: pass full bounds to the device
     SkISize size = bounds.roundOut().size();
 
-    auto svgDevice = SkSVGDevice::Make(size, skstd::make_unique<SkXMLStreamWriter>(writer));
+    auto svgDevice = SkSVGDevice::Make(size, skstd::make_unique<SkXMLStreamWriter>(writer),
+                                       flags);
 
     return svgDevice ? skstd::make_unique<SkCanvas>(svgDevice)
                      : nullptr;
@@ -23,6 +23,7 @@
 #include "SkPaint.h"
 #include "SkParsePath.h"
 #include "SkPngCodec.h"
+#include "SkSVGCanvas.h"
 #include "SkShader.h"
 #include "SkStream.h"
 #include "SkTHash.h"
@@ -131,12 +132,23 @@ bool RequiresViewportReset(const SkPaint& paint) {
 
 }  // namespace
 
-// For now all this does is serve unique serial IDs, but it will eventually evolve to track
-// and deduplicate resources.
+// Serves unique serial IDs for resources. When deduplicating, it also remembers the resources
+// already written to a <defs>, so that later draws can refer to them instead of repeating them.
 class SkSVGDevice::ResourceBucket : ::SkNoncopyable {
 public:
-    ResourceBucket()
-            : fGradientCount(0)
+    struct ImageKey {
+        uint32_t fGenID;
+        SkIPoint fOrigin;
+        SkISize  fSize;
+
+        bool operator==(const ImageKey& that) const {
+            return fGenID == that.fGenID && fOrigin == that.fOrigin && fSize == that.fSize;
+        }
+    };
+
+    ResourceBucket(bool dedup)
+            : fDedup(dedup)
+            , fGradientCount(0)
             , fClipCount(0)
             , fPathCount(0)
             , fImageCount(0)
@@ -165,7 +177,55 @@ public:
       return SkStringPrintf("pattern_%d", fPatternCount++);
     }
 
+    // Clips are keyed by the clip stack's gen ID, shaders by identity (they're kept alive so
+    // the pointer can't be reused), paths by gen ID and images by their pixels' gen ID. The
+    // find methods return nullptr when not deduplicating.
+    const SkString* findClip(uint32_t genID) const {
+        return fDedup ? fClips.find(genID) : nullptr;
+    }
+    void rememberClip(uint32_t genID, const SkString& url) {
+        if (fDedup && genID != SkClipStack::kInvalidGenID) {
+            fClips.set(genID, url);
+        }
+    }
+
+    const SkString* findPaintServer(const SkShader* shader) const {
+        return fDedup ? fPaintServers.find(shader) : nullptr;
+    }
+    void rememberPaintServer(const SkShader* shader, const SkString& url) {
+        if (fDedup) {
+            fShaderRefs.push_back(sk_ref_sp(shader));
+            fPaintServers.set(shader, url);
+        }
+    }
+
+    bool dedupPaths() const { return fDedup; }
+    const SkString* findPath(uint32_t genID) const {
+        return fDedup ? fPaths.find(genID) : nullptr;
+    }
+    void rememberPath(uint32_t genID, const SkString& id) {
+        if (fDedup) {
+            fPaths.set(genID, id);
+        }
+    }
+
+    const SkString* findImage(const ImageKey& key) const {
+        return fDedup ? fImages.find(key) : nullptr;
+    }
+    void rememberImage(const ImageKey& key, const SkString& id) {
+        if (fDedup) {
+            fImages.set(key, id);
+        }
+    }
+
 private:
+    const bool fDedup;
+    SkTHashMap<uint32_t, SkString>        fClips;
+    SkTHashMap<const SkShader*, SkString> fPaintServers;
+    std::vector<sk_sp<const SkShader>>    fShaderRefs;
+    SkTHashMap<uint32_t, SkString>        fPaths;
+    SkTHashMap<ImageKey, SkString>        fImages;
+
     uint32_t fGradientCount;
     uint32_t fClipCount;
     uint32_t fPathCount;
@@ -322,6 +382,19 @@ Resources SkSVGDevice::AutoElement::addResources(const MxCp& mc, const SkPaint&
     bool hasClip   = !mc.fClipStack->isWideOpen();
     bool hasShader = SkToBool(paint.getShader());
 
+    if (hasClip) {
+        if (const SkString* url = fResourceBucket->findClip(mc.fClipStack->getTopmostGenID())) {
+            resources.fClip = *url;
+            hasClip = false;
+        }
+    }
+    if (hasShader) {
+        if (const SkString* url = fResourceBucket->findPaintServer(paint.getShader())) {
+            resources.fPaintServer = *url;
+            hasShader = false;
+        }
+    }
+
     if (hasClip || hasShader) {
         AutoElement defs("defs", fWriter);
 
@@ -365,6 +438,7 @@ void SkSVGDevice::AutoElement::addGradientShaderResources(const SkShader* shader
     SkASSERT(grInfo.fColorCount <= grOffsets.count());
 
     resources->fPaintServer.printf("url(#%s)", addLinearGradientDef(grInfo, shader).c_str());
+    fResourceBucket->rememberPaintServer(shader, resources->fPaintServer);
 }
 
 void SkSVGDevice::AutoElement::addColorFilterResources(const SkColorFilter& cf,
@@ -488,6 +562,7 @@ void SkSVGDevice::AutoElement::addImageShaderResources(const SkShader* shader, c
         }
     }
     resources->fPaintServer.printf("url(#%s)", patternID.c_str());
+    fResourceBucket->rememberPaintServer(shader, resources->fPaintServer);
 }
 
 void SkSVGDevice::AutoElement::addShaderResources(const SkPaint& paint, Resources* resources) {
@@ -530,6 +605,7 @@ void SkSVGDevice::AutoElement::addClipResources(const MxCp& mc, Resources* resou
     }
 
     resources->fClip.printf("url(#%s)", clipID.c_str());
+    fResourceBucket->rememberClip(mc.fClipStack->getTopmostGenID(), resources->fClip);
 }
 
 SkString SkSVGDevice::AutoElement::addLinearGradientDef(const SkShader::GradientInfo& info,
@@ -637,16 +713,18 @@ void SkSVGDevice::AutoElement::addTextAttributes(const SkFont& font) {
     }
 }
 
-sk_sp<SkBaseDevice> SkSVGDevice::Make(const SkISize& size, std::unique_ptr<SkXMLWriter> writer) {
-    return writer ? sk_sp<SkBaseDevice>(new SkSVGDevice(size, std::move(writer)))
+sk_sp<SkBaseDevice> SkSVGDevice::Make(const SkISize& size, std::unique_ptr<SkXMLWriter> writer,
+                                      uint32_t flags) {
+    return writer ? sk_sp<SkBaseDevice>(new SkSVGDevice(size, std::move(writer), flags))
                   : nullptr;
 }
 
-SkSVGDevice::SkSVGDevice(const SkISize& size, std::unique_ptr<SkXMLWriter> writer)
+SkSVGDevice::SkSVGDevice(const SkISize& size, std::unique_ptr<SkXMLWriter> writer,
+                         uint32_t flags)
     : INHERITED(SkImageInfo::MakeUnknown(size.fWidth, size.fHeight),
                 SkSurfaceProps(0, kUnknown_SkPixelGeometry))
     , fWriter(std::move(writer))
-    , fResourceBucket(new ResourceBucket)
+    , fResourceBucket(new ResourceBucket(SkToBool(flags & SkSVGCanvas::kDedupResources_Flag)))
 {
     SkASSERT(fWriter);
 
@@ -761,6 +839,30 @@ void SkSVGDevice::drawRRect(const SkRRect& rr, const SkPaint& paint) {
 }
 
 void SkSVGDevice::drawPath(const SkPath& path, const SkPaint& paint, bool pathIsMutable) {
+    // When deduplicating, larger paths are written once to a <defs> and drawn with <use>, which
+    // carries the paint and transform.
+    static constexpr int kMinSharedPathVerbs = 8;
+    if (fResourceBucket->dedupPaths() && path.countVerbs() >= kMinSharedPathVerbs) {
+        SkString pathID;
+        if (const SkString* id = fResourceBucket->findPath(path.getGenerationID())) {
+            pathID = *id;
+        } else {
+            pathID = fResourceBucket->addPath();
+            AutoElement defs("defs", fWriter);
+            AutoElement pathElement("path", fWriter);
+            pathElement.addAttribute("id", pathID);
+            pathElement.addPathAttributes(path);
+            fResourceBucket->rememberPath(path.getGenerationID(), pathID);
+        }
+
+        AutoElement use("use", fWriter, fResourceBucket.get(), MxCp(this), paint);
+        use.addAttribute("xlink:href", SkStringPrintf("#%s", pathID.c_str()));
+        if (path.getFillType() == SkPath::kEvenOdd_FillType) {
+            use.addAttribute("fill-rule", "evenodd");
+        }
+        return;
+    }
+
     AutoElement elem("path", fWriter, fResourceBucket.get(), MxCp(this), paint);
     elem.addPathAttributes(path);
 
@@ -776,6 +878,14 @@ static sk_sp<SkData> encode(const SkBitmap& src) {
 }
 
 void SkSVGDevice::drawBitmapCommon(const MxCp& mc, const SkBitmap& bm, const SkPaint& paint) {
+    const ResourceBucket::ImageKey key = {bm.getGenerationID(), bm.pixelRefOrigin(),
+                                          bm.dimensions()};
+    if (const SkString* imageID = fResourceBucket->findImage(key)) {
+        AutoElement imageUse("use", fWriter, fResourceBucket.get(), mc, paint);
+        imageUse.addAttribute("xlink:href", SkStringPrintf("#%s", imageID->c_str()));
+        return;
+    }
+
     sk_sp<SkData> pngData = encode(bm);
     if (!pngData) {
         return;
@@ -799,6 +909,7 @@ void SkSVGDevice::drawBitmapCommon(const MxCp& mc, const SkBitmap& bm, const SkP
             image.addAttribute("xlink:href", svgImageData);
         }
     }
+    fResourceBucket->rememberImage(key, imageID);
 
     {
         AutoElement imageUse("use", fWriter, fResourceBucket.get(), mc, paint);
@@ -15,7 +15,9 @@ class SkXMLWriter;
 
 class SkSVGDevice : public SkClipStackDevice {
 public:
-    static sk_sp<SkBaseDevice> Make(const SkISize& size, std::unique_ptr<SkXMLWriter>);
+    // flags are SkSVGCanvas flags.
+    static sk_sp<SkBaseDevice> Make(const SkISize& size, std::unique_ptr<SkXMLWriter>,
+                                    uint32_t flags = 0);
 
 protected:
     void drawPaint(const SkPaint& paint) override;
@@ -42,7 +44,7 @@ protected:
                     const SkPaint&) override;
 
 private:
-    SkSVGDevice(const SkISize& size, std::unique_ptr<SkXMLWriter>);
+    SkSVGDevice(const SkISize& size, std::unique_ptr<SkXMLWriter>, uint32_t flags);
     ~SkSVGDevice() override;
 
     struct MxCp;
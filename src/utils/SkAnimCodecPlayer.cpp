@@ -9,8 +9,12 @@
 #include "SkCodec.h"
 #include "SkCodecImageGenerator.h"
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkImage.h"
+#include "SkMutex.h"
+#include "SkTaskGroup.h"
 #include <algorithm>
+#include <functional>
 
 SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(std::move(codec)) {
     fImageInfo = fCodec->getInfo();
@@ -40,35 +44,45 @@ SkISize SkAnimCodecPlayer::dimensions() {
     return { fImageInfo.width(), fImageInfo.height() };
 }
 
-sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
-    SkASSERT((unsigned)index < fFrameInfos.size());
-
-    if (fImages[index]) {
-        return fImages[index];
-    }
-
-    size_t rb = fImageInfo.minRowBytes();
-    size_t size = fImageInfo.computeByteSize(rb);
+// Decodes frame index, starting from a copy of requiredImage (its required frame) if there is one.
+static sk_sp<SkImage> decode_frame(SkCodec* codec, const SkImageInfo& info, int index,
+                                   int requiredFrame, const sk_sp<SkImage>& requiredImage) {
+    size_t rb = info.minRowBytes();
+    size_t size = info.computeByteSize(rb);
     auto data = SkData::MakeUninitialized(size);
 
     SkCodec::Options opts;
     opts.fFrameIndex = index;
 
-    const int requiredFrame = fFrameInfos[index].fRequiredFrame;
     if (requiredFrame != SkCodec::kNoFrame) {
-        auto requiredImage = fImages[requiredFrame];
         SkPixmap requiredPM;
         if (requiredImage && requiredImage->peekPixels(&requiredPM)) {
             sk_careful_memcpy(data->writable_data(), requiredPM.addr(), size);
             opts.fPriorFrame = requiredFrame;
         }
     }
-    if (SkCodec::kSuccess == fCodec->getPixels(fImageInfo, data->writable_data(), rb, &opts)) {
-        return fImages[index] = SkImage::MakeRasterData(fImageInfo, std::move(data), rb);
+    if (SkCodec::kSuccess == codec->getPixels(info, data->writable_data(), rb, &opts)) {
+        return SkImage::MakeRasterData(info, std::move(data), rb);
     }
     return nullptr;
 }
 
+sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
+    SkASSERT((unsigned)index < fFrameInfos.size());
+
+    if (fImages[index]) {
+        return fImages[index];
+    }
+
+    const int requiredFrame = fFrameInfos[index].fRequiredFrame;
+    sk_sp<SkImage> requiredImage;
+    if (requiredFrame != SkCodec::kNoFrame) {
+        requiredImage = fImages[requiredFrame];
+    }
+    return fImages[index] = decode_frame(fCodec.get(), fImageInfo, index, requiredFrame,
+                                         requiredImage);
+}
+
 sk_sp<SkImage> SkAnimCodecPlayer::getFrame() {
     SkASSERT(fTotalDuration > 0 || fImages.size() == 1);
 
@@ -94,3 +108,87 @@ bool SkAnimCodecPlayer::seek(uint32_t msec) {
 }
 
 
+
+std::vector<sk_sp<SkImage>> SkAnimCodecPlayer::DecodeFrames(sk_sp<SkData> encoded,
+                                                            SkExecutor* executor) {
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(encoded);
+    if (!codec) {
+        return {};
+    }
+    SkImageInfo info = codec->getInfo();
+    const std::vector<SkCodec::FrameInfo> frameInfos = codec->getFrameInfo();
+    // getInfo() describes the first frame; later ones may not be opaque.
+    for (const auto& frameInfo : frameInfos) {
+        if (kOpaque_SkAlphaType != frameInfo.fAlphaType) {
+            info = info.makeAlphaType(kPremul_SkAlphaType);
+            break;
+        }
+    }
+    // A still image may not report any frame info.
+    const int frameCount = SkTMax(1, (int)frameInfos.size());
+    auto requiredFrame = [&frameInfos](int index) {
+        return frameInfos.empty() ? SkCodec::kNoFrame : frameInfos[index].fRequiredFrame;
+    };
+
+    std::vector<sk_sp<SkImage>> images(frameCount);
+    if (!executor) {
+        // A frame's required frame always comes before it.
+        for (int i = 0; i < frameCount; i++) {
+            const int required = requiredFrame(i);
+            images[i] = decode_frame(codec.get(), info, i, required,
+                                     required == SkCodec::kNoFrame ? nullptr : images[required]);
+        }
+        return images;
+    }
+
+    // Required frames form a forest: start at every root, and start each frame's dependents
+    // when it finishes.
+    std::vector<int> roots;
+    std::vector<std::vector<int>> dependents(frameCount);
+    for (int i = 0; i < frameCount; i++) {
+        const int required = requiredFrame(i);
+        if (required == SkCodec::kNoFrame) {
+            roots.push_back(i);
+        } else {
+            dependents[required].push_back(i);
+        }
+    }
+
+    // SkCodecs can't be shared between threads, so each decode borrows one from this pool,
+    // making a new one from encoded only when they're all in use.
+    SkMutex codecsMutex;
+    std::vector<std::unique_ptr<SkCodec>> codecs;
+    codecs.push_back(std::move(codec));
+
+    SkTaskGroup taskGroup(*executor);
+    std::function<void(int)> decode = [&](int index) {
+        std::unique_ptr<SkCodec> frameCodec;
+        {
+            SkAutoMutexAcquire lock(codecsMutex);
+            if (!codecs.empty()) {
+                frameCodec = std::move(codecs.back());
+                codecs.pop_back();
+            }
+        }
+        if (!frameCodec) {
+            frameCodec = SkCodec::MakeFromData(encoded);
+        }
+        if (frameCodec) {
+            const int required = requiredFrame(index);
+            images[index] = decode_frame(frameCodec.get(), info, index, required,
+                                         required == SkCodec::kNoFrame ? nullptr
+                                                                       : images[required]);
+            SkAutoMutexAcquire lock(codecsMutex);
+            codecs.push_back(std::move(frameCodec));
+        }
+
+        for (int dependent : dependents[index]) {
+            taskGroup.add([&decode, dependent] { decode(dependent); });
+        }
+    };
+    for (int root : roots) {
+        taskGroup.add([&decode, root] { decode(root); });
+    }
+    taskGroup.wait();
+    return images;
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkDDLTiledRenderer.h"
+
+#include "SkCanvas.h"
+#include "SkData.h"
+#include "SkDeferredDisplayListRecorder.h"
+#include "SkImage.h"
+#include "SkPicture.h"
+#include "SkSerialProcs.h"
+#include "SkSurface.h"
+#include "SkTaskGroup.h"
+
+#if SK_SUPPORT_GPU
+#include "GrBackendSurface.h"
+#include "GrContext.h"
+#include "SkPromiseImageTexture.h"
+
+#include <atomic>
+#endif
+
+SkDDLTiledRenderer::SkDDLTiledRenderer(const SkSurfaceCharacterization& characterization,
+                                       int tileSize)
+        : fCharacterization(characterization) {
+    SkASSERT(tileSize > 0);
+    if (!fCharacterization.isValid()) {
+        return;
+    }
+    for (int y = 0; y < fCharacterization.height(); y += tileSize) {
+        for (int x = 0; x < fCharacterization.width(); x += tileSize) {
+            fTiles.push_back(SkIRect::MakeXYWH(x, y, tileSize, tileSize));
+            SkAssertResult(fTiles.back().intersect(SkIRect::MakeWH(fCharacterization.width(),
+                                                                   fCharacterization.height())));
+        }
+    }
+}
+
+SkDDLTiledRenderer::~SkDDLTiledRenderer() {}
+
+void SkDDLTiledRenderer::reset() {
+    fDisplayLists.reset();
+    fImages.reset();
+}
+
+#if SK_SUPPORT_GPU
+
+// One image from the picture, uploaded once and shared by every tile's promise images.  Each
+// promise image holds a ref, dropped by its done proc.
+class SkDDLTiledRenderer::SharedImage : public SkRefCnt {
+public:
+    SharedImage(uint32_t uniqueID, sk_sp<SkImage> image) : fUniqueID(uniqueID) {
+        GrBackendTexture backendTexture = image->getBackendTexture(true);
+        fTexture = SkPromiseImageTexture::Make(backendTexture);
+        if (fTexture) {
+            fFormat = backendTexture.getBackendFormat();
+            fTextureImage = std::move(image);
+        } else {
+            // We couldn't get at the texture (or the upload failed), so each tile will draw a
+            // copy of the raster image instead.
+            fRasterImage = image->makeRasterImage();
+        }
+    }
+
+    uint32_t uniqueID() const { return fUniqueID; }
+
+    sk_sp<SkImage> makeTileImage(SkDeferredDisplayListRecorder* recorder) {
+        if (!fTexture) {
+            return fRasterImage;
+        }
+        this->ref();
+        return recorder->makePromiseTexture(fFormat,
+                                            fTextureImage->width(),
+                                            fTextureImage->height(),
+                                            GrMipMapped::kNo,
+                                            kTopLeft_GrSurfaceOrigin,
+                                            fTextureImage->colorType(),
+                                            fTextureImage->alphaType(),
+                                            fTextureImage->refColorSpace(),
+                                            Fulfill, Release, Done, this);
+    }
+
+private:
+    static sk_sp<SkPromiseImageTexture> Fulfill(void* ctx) {
+        return static_cast<SharedImage*>(ctx)->fTexture;
+    }
+    static void Release(void*) {}
+    static void Done(void* ctx) { static_cast<SharedImage*>(ctx)->unref(); }
+
+    const uint32_t               fUniqueID;
+    sk_sp<SkImage>               fTextureImage;   // Keeps the texture alive.
+    sk_sp<SkPromiseImageTexture> fTexture;
+    GrBackendFormat              fFormat;
+    sk_sp<SkImage>               fRasterImage;
+};
+
+struct SkDDLTiledRenderer::TileContext {
+    SkDeferredDisplayListRecorder* fRecorder;
+    const SkDDLTiledRenderer*      fRenderer;
+};
+
+sk_sp<SkImage> SkDDLTiledRenderer::MakeTileImage(const void* data, size_t length, void* ctx) {
+    auto tileContext = static_cast<TileContext*>(ctx);
+    int index;
+    if (length != sizeof(index)) {
+        return nullptr;
+    }
+    memcpy(&index, data, sizeof(index));
+    if (index < 0 || index >= tileContext->fRenderer->fImages.count()) {
+        return nullptr;
+    }
+    return tileContext->fRenderer->fImages[index]->makeTileImage(tileContext->fRecorder);
+}
+
+bool SkDDLTiledRenderer::record(GrContext* context, const SkPicture* picture,
+                                SkExecutor* executor) {
+    this->reset();
+    if (!context || !picture || fTiles.empty() ||
+        context->threadSafeProxy().get() != fCharacterization.contextInfo()) {
+        return false;
+    }
+
+    // Upload each distinct image once, replacing it in the serialized picture with its index.
+    struct UploadContext {
+        GrContext*                          fContext;
+        SkTArray<sk_sp<SharedImage>, true>* fImages;
+    } uploadContext = { context, &fImages };
+
+    SkSerialProcs serialProcs;
+    serialProcs.fImageCtx  = &uploadContext;
+    serialProcs.fImageProc = [](SkImage* image, void* ctx) -> sk_sp<SkData> {
+        auto uploadContext = static_cast<UploadContext*>(ctx);
+        auto& images = *uploadContext->fImages;
+
+        int index = 0;
+        while (index < images.count() && images[index]->uniqueID() != image->uniqueID()) {
+            index++;
+        }
+        if (index == images.count()) {
+            sk_sp<SkImage> textureImage = image->makeTextureImage(uploadContext->fContext,
+                                                                  nullptr);
+            images.push_back(sk_make_sp<SharedImage>(image->uniqueID(),
+                                                     textureImage ? std::move(textureImage)
+                                                                  : sk_ref_sp(image)));
+        }
+        return SkData::MakeWithCopy(&index, sizeof(index));
+    };
+    sk_sp<SkData> pictureData = picture->serialize(&serialProcs);
+    if (!pictureData) {
+        return false;
+    }
+
+    fDisplayLists.reset(fTiles.count());
+    std::atomic<bool> failed{false};
+    auto recordTile = [&](int i) {
+        SkDeferredDisplayListRecorder recorder(fCharacterization);
+        SkCanvas* canvas = recorder.getCanvas();
+        if (!canvas) {
+            failed = true;
+            return;
+        }
+
+        // The promise images must come from the same recorder as the DDL that draws them,
+        // so each tile reinflates the picture itself.
+        TileContext tileContext = { &recorder, this };
+        SkDeserialProcs deserialProcs;
+        deserialProcs.fImageCtx  = &tileContext;
+        deserialProcs.fImageProc = MakeTileImage;
+        sk_sp<SkPicture> tilePicture = SkPicture::MakeFromData(pictureData.get(),
+                                                               &deserialProcs);
+        if (!tilePicture) {
+            failed = true;
+            return;
+        }
+
+        canvas->clipRect(SkRect::Make(fTiles[i]));
+        canvas->drawPicture(tilePicture);
+        fDisplayLists[i] = recorder.detach();
+    };
+
+    if (executor) {
+        SkTaskGroup(*executor).batch(fTiles.count(), recordTile);
+    } else {
+        for (int i = 0; i < fTiles.count(); ++i) {
+            recordTile(i);
+        }
+    }
+
+    if (failed) {
+        this->reset();
+        return false;
+    }
+    return true;
+}
+
+bool SkDDLTiledRenderer::draw(SkSurface* dst) const {
+    if (!dst || fDisplayLists.empty()) {
+        return false;
+    }
+    for (const auto& displayList : fDisplayLists) {
+        if (!dst->draw(displayList.get())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#else
+
+class SkDDLTiledRenderer::SharedImage : public SkRefCnt {};
+
+bool SkDDLTiledRenderer::record(GrContext*, const SkPicture*, SkExecutor*) {
+    return false;
+}
+
+bool SkDDLTiledRenderer::draw(SkSurface*) const {
+    return false;
+}
+
+#endif
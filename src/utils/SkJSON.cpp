@@ -261,6 +261,22 @@ static inline const char* skip_ws(const char* p) {
     return p;
 }
 
+// Returns true if the 8-byte word |w| contains any string terminator char (see g_token_flags):
+// control chars (< 0x20), '"', '\\', ']' or '}'.  This is a SWAR variant of the is_eostring()
+// test, used to skip over long plain string runs 8 chars at a time.
+static inline bool has_eostring(uint64_t w) {
+    static constexpr uint64_t kOnes = 0x0101010101010101ull,
+                              kHigh = 0x8080808080808080ull;
+
+    const auto has_zero = [](uint64_t v) { return (v - kOnes) & ~v & kHigh; };
+
+    return ((w - kOnes * 0x20) & ~w & kHigh) // < 0x20
+         | has_zero(w ^ (kOnes * '"'))
+         | has_zero(w ^ (kOnes * '\\'))
+         | has_zero(w ^ (kOnes * ']'))
+         | has_zero(w ^ (kOnes * '}'));
+}
+
 static inline float pow10(int32_t exp) {
     static constexpr float g_pow10_table[63] =
     {
@@ -688,7 +704,16 @@ private:
         do {
             // Consume string chars.
             // This is the fast path, and hopefully we only hit it once then quick-exit below.
-            for (p = p + 1; !is_eostring(*p); ++p);
+            // Plain runs are skipped a word at a time, as long as the whole word is in bounds
+            // (p_stop points to the last input char).
+            for (p = p + 1; p_stop - p >= 8; p += 8) {
+                uint64_t w;
+                memcpy(&w, p, sizeof(w));
+                if (has_eostring(w)) {
+                    break;
+                }
+            }
+            for (; !is_eostring(*p); ++p);
 
             if (*p == '"') {
                 // Valid string found.
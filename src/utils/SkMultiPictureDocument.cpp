@@ -22,13 +22,23 @@
   File format:
       BEGINNING_OF_FILE:
         kMagic
-        uint32_t version_number (==2)
+        uint32_t version_number (==3)
         uint32_t page_count
         {
           float sizeX
           float sizeY
         } * page_count
-        skp file
+        {
+          skp file
+          zero padding to a multiple of 4 bytes
+        } * page_count
+        {
+          uint64_t offset   (from BEGINNING_OF_FILE)
+          uint64_t length
+        } * page_count
+
+  Version 2 files have the size array followed by a single skp file holding every page, each one
+  followed by a kEndPage annotation.
 */
 
 namespace {
@@ -37,15 +47,13 @@ static constexpr char kMagic[] = "Skia Multi-Picture Doc\n\n";
 
 static constexpr char kEndPage[] = "SkMultiPictureEndPage";
 
-const uint32_t kVersion = 2;
+const uint32_t kVersion = 3;
+const uint32_t kSinglePicture_Version = 2;
 
-static SkSize join(const SkTArray<SkSize>& sizes) {
-    SkSize joined = {0, 0};
-    for (SkSize s : sizes) {
-        joined = SkSize{SkTMax(joined.width(), s.width()), SkTMax(joined.height(), s.height())};
-    }
-    return joined;
-}
+struct PageSpan {
+    uint64_t fOffset;
+    uint64_t fLength;
+};
 
 struct MultiPictureDocument final : public SkDocument {
     const SkSerialProcs fProcs;
@@ -76,14 +84,16 @@ struct MultiPictureDocument final : public SkDocument {
         for (SkSize s : fSizes) {
             wStream->write(&s, sizeof(s));
         }
-        SkSize bigsize = join(fSizes);
-        SkCanvas* c = fPictureRecorder.beginRecording(SkRect::MakeSize(bigsize));
+        // Each page is its own picture, so that a reader can load any one of them on its own.
+        SkTArray<PageSpan> index(fPages.count());
         for (const sk_sp<SkPicture>& page : fPages) {
-            c->drawPicture(page);
-            c->drawAnnotation(SkRect::MakeEmpty(), kEndPage, nullptr);
+            size_t offset = wStream->bytesWritten();
+            page->serialize(wStream, &fProcs);
+            index.push_back({offset, wStream->bytesWritten() - offset});
+            static const uint8_t kZeros[4] = {0, 0, 0, 0};
+            wStream->write(kZeros, SkAlign4(wStream->bytesWritten()) - wStream->bytesWritten());
         }
-        sk_sp<SkPicture> p = fPictureRecorder.finishRecordingAsPicture();
-        p->serialize(wStream, &fProcs);
+        wStream->write(index.begin(), index.count() * sizeof(PageSpan));
         fPages.reset();
         fSizes.reset();
         return;
@@ -101,7 +111,7 @@ sk_sp<SkDocument> SkMakeMultiPictureDocument(SkWStream* wStream, const SkSerialP
 
 ////////////////////////////////////////////////////////////////////////////////
 
-int SkMultiPictureDocumentReadPageCount(SkStreamSeekable* stream) {
+static int read_page_count(SkStreamSeekable* stream, uint32_t* version) {
     if (!stream) {
         return 0;
     }
@@ -113,9 +123,11 @@ int SkMultiPictureDocumentReadPageCount(SkStreamSeekable* stream) {
         return 0;
     }
     uint32_t versionNumber;
-    if (!stream->readU32(&versionNumber) || versionNumber != kVersion) {
+    if (!stream->readU32(&versionNumber) ||
+        (versionNumber != kVersion && versionNumber != kSinglePicture_Version)) {
         return 0;
     }
+    *version = versionNumber;
     uint32_t pageCount;
     if (!stream->readU32(&pageCount) || pageCount > INT_MAX) {
         return 0;
@@ -124,13 +136,17 @@ int SkMultiPictureDocumentReadPageCount(SkStreamSeekable* stream) {
     return SkTo<int>(pageCount);
 }
 
-bool SkMultiPictureDocumentReadPageSizes(SkStreamSeekable* stream,
-                                         SkDocumentPage* dstArray,
-                                         int dstArrayCount) {
+int SkMultiPictureDocumentReadPageCount(SkStreamSeekable* stream) {
+    uint32_t version;
+    return read_page_count(stream, &version);
+}
+
+static bool read_page_sizes(SkStreamSeekable* stream, SkDocumentPage* dstArray,
+                            int dstArrayCount, uint32_t* version) {
     if (!dstArray || dstArrayCount < 1) {
         return false;
     }
-    int pageCount = SkMultiPictureDocumentReadPageCount(stream);
+    int pageCount = read_page_count(stream, version);
     if (pageCount < 1 || pageCount != dstArrayCount) {
         return false;
     }
@@ -144,6 +160,13 @@ bool SkMultiPictureDocumentReadPageSizes(SkStreamSeekable* stream,
     return true;
 }
 
+bool SkMultiPictureDocumentReadPageSizes(SkStreamSeekable* stream,
+                                         SkDocumentPage* dstArray,
+                                         int dstArrayCount) {
+    uint32_t version;
+    return read_page_sizes(stream, dstArray, dstArrayCount, &version);
+}
+
 namespace {
 struct PagerCanvas : public SkNWayCanvas {
     SkPictureRecorder fRecorder;
@@ -179,9 +202,21 @@ bool SkMultiPictureDocumentRead(SkStreamSeekable* stream,
                                 SkDocumentPage* dstArray,
                                 int dstArrayCount,
                                 const SkDeserialProcs* procs) {
-    if (!SkMultiPictureDocumentReadPageSizes(stream, dstArray, dstArrayCount)) {
+    uint32_t version;
+    if (!read_page_sizes(stream, dstArray, dstArrayCount, &version)) {
         return false;
     }
+    if (version != kSinglePicture_Version) {
+        for (int i = 0; i < dstArrayCount; ++i) {
+            dstArray[i].fPicture = SkPicture::MakeFromStream(stream, procs);
+            if (!dstArray[i].fPicture || !stream->hasPosition() ||
+                !stream->seek(SkAlign4(stream->getPosition()))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     SkSize joined = {0.0f, 0.0f};
     for (int i = 0; i < dstArrayCount; ++i) {
         joined = SkSize{SkTMax(joined.width(), dstArray[i].fSize.width()),
@@ -199,3 +234,66 @@ bool SkMultiPictureDocumentRead(SkStreamSeekable* stream,
     }
     return true;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::unique_ptr<SkMultiPictureDocumentReader> SkMultiPictureDocumentReader::Make(
+        sk_sp<SkData> data, const SkDeserialProcs* procs) {
+    if (!data) {
+        return nullptr;
+    }
+    SkMemoryStream stream(data);
+    uint32_t version;
+    int pageCount = read_page_count(&stream, &version);
+    if (pageCount < 1) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SkMultiPictureDocumentReader> reader(new SkMultiPictureDocumentReader);
+    reader->fProcs = procs ? *procs : SkDeserialProcs();
+    reader->fPages.resize(pageCount);
+    if (version == kSinglePicture_Version) {
+        // There is no index, so every page has to be loaded now.
+        if (!SkMultiPictureDocumentRead(&stream, reader->fPages.data(), pageCount, procs)) {
+            return nullptr;
+        }
+        return reader;
+    }
+
+    for (SkDocumentPage& page : reader->fPages) {
+        if (sizeof(SkSize) != stream.read(&page.fSize, sizeof(SkSize))) {
+            return nullptr;
+        }
+    }
+    static_assert(sizeof(Span) == sizeof(PageSpan), "");
+    size_t indexSize = pageCount * sizeof(PageSpan);
+    if (data->size() - stream.getPosition() < indexSize) {
+        return nullptr;
+    }
+    size_t indexOffset = data->size() - indexSize;
+    reader->fIndex.resize(pageCount);
+    memcpy(reader->fIndex.data(), data->bytes() + indexOffset, indexSize);
+    for (const Span& span : reader->fIndex) {
+        if (span.fOffset < stream.getPosition() || span.fOffset > indexOffset ||
+            span.fLength > indexOffset - span.fOffset) {
+            return nullptr;
+        }
+    }
+    reader->fData = std::move(data);
+    return reader;
+}
+
+SkSize SkMultiPictureDocumentReader::pageSize(int index) const {
+    SkASSERT(index >= 0 && index < this->pageCount());
+    return fPages[index].fSize;
+}
+
+sk_sp<SkPicture> SkMultiPictureDocumentReader::readPage(int index) const {
+    SkASSERT(index >= 0 && index < this->pageCount());
+    if (!fData) {
+        return fPages[index].fPicture;
+    }
+    const Span& span = fIndex[index];
+    return SkPicture::MakeFromMappedData(SkData::MakeSubset(fData.get(), span.fOffset, span.fLength),
+                                         &fProcs);
+}
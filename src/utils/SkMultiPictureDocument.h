@@ -8,12 +8,15 @@
 #ifndef SkMultiPictureDocument_DEFINED
 #define SkMultiPictureDocument_DEFINED
 
+#include "SkData.h"
 #include "SkDocument.h"
 #include "SkPicture.h"
+#include "SkSerialProcs.h"
 #include "SkSize.h"
 
-struct SkDeserialProcs;
-struct SkSerialProcs;
+#include <memory>
+#include <vector>
+
 class SkStreamSeekable;
 
 /**
@@ -41,4 +44,38 @@ SK_API bool SkMultiPictureDocumentRead(SkStreamSeekable* src,
                                        int dstArrayCount,
                                        const SkDeserialProcs* = nullptr);
 
+/**
+ *  Reads the pages of an SkMultiPictureDocument one at a time, using the index at the end of the
+ *  file, so that a large document never has to be in memory all at once. Pass
+ *  SkData::MakeFromFileName() to work from a mapping of the file. readPage() may be called from
+ *  several threads at once.
+ *
+ *  Documents written before the index was added are loaded in full by Make().
+ */
+class SK_API SkMultiPictureDocumentReader {
+public:
+    /** Returns nullptr if data does not hold an SkMultiPictureDocument. */
+    static std::unique_ptr<SkMultiPictureDocumentReader> Make(sk_sp<SkData> data,
+                                                              const SkDeserialProcs* = nullptr);
+
+    int pageCount() const { return (int)fPages.size(); }
+    SkSize pageSize(int index) const;
+
+    /** Deserializes the page. Returns nullptr if the page data is malformed. */
+    sk_sp<SkPicture> readPage(int index) const;
+
+private:
+    SkMultiPictureDocumentReader() = default;
+
+    struct Span {
+        uint64_t fOffset;
+        uint64_t fLength;
+    };
+
+    sk_sp<SkData>               fData;     // nullptr if every page was loaded up front
+    SkDeserialProcs             fProcs;
+    std::vector<SkDocumentPage> fPages;    // fPicture is only set if fData is nullptr
+    std::vector<Span>           fIndex;
+};
+
 #endif  // SkMultiPictureDocument_DEFINED
@@ -92,6 +92,16 @@ void SkNWayCanvas::willRestore() {
     this->INHERITED::willRestore();
 }
 
+// Forwarding translate() keeps the children on their cheap translate-only path instead of the
+// generic concat() the base class would turn this into.
+void SkNWayCanvas::didTranslate(SkScalar dx, SkScalar dy) {
+    Iter iter(fList);
+    while (iter.next()) {
+        iter->translate(dx, dy);
+    }
+    this->INHERITED::didTranslate(dx, dy);
+}
+
 void SkNWayCanvas::didConcat(const SkMatrix& matrix) {
     Iter iter(fList);
     while (iter.next()) {
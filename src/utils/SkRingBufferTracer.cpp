@@ -0,0 +1,235 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkRingBufferTracer.h"
+
+#include "SkJSONWriter.h"
+#include "SkMathPriv.h"
+#include "SkMutex.h"
+#include "SkString.h"
+#include "SkTArray.h"
+#include "SkTLS.h"
+#include "SkTime.h"
+#include "SkTraceEvent.h"
+
+#include <atomic>
+
+namespace {
+
+// A fixed-size record. Names are the string literals passed to the TRACE_EVENT macros, so they
+// can be kept by pointer.
+struct Event {
+    const char*    fName;
+    const uint8_t* fCategory;
+    uint64_t       fID;
+    uint64_t       fBeginNs;
+    uint64_t       fEndNs;     // 0 until updateTraceEventDuration(), or forever if not a duration
+    const char*    fArgName;   // nullptr if there is no argument
+    uint64_t       fArgValue;
+    uint8_t        fArgType;
+    char           fPhase;
+};
+
+struct Category {
+    uint8_t     fEnabled;  // must be first; its address is what trace sites see
+    const char* fName;
+};
+
+// What SkTLS keeps for each thread: which tracer's buffer this thread is writing to.
+struct ThreadSlot {
+    const void* fOwner = nullptr;
+    void*       fBuffer = nullptr;
+};
+
+void* create_slot() { return new ThreadSlot; }
+void delete_slot(void* slot) { delete static_cast<ThreadSlot*>(slot); }
+
+}  // namespace
+
+struct SkRingBufferTracer::ThreadBuffer {
+    ThreadBuffer(int tid, int capacity) : fTid(tid), fEvents(new Event[capacity]) {}
+
+    const int                fTid;
+    std::unique_ptr<Event[]> fEvents;
+    // Total events ever written. Only the owning thread writes it.
+    std::atomic<uint64_t>    fCount{0};
+};
+
+struct SkRingBufferTracer::State {
+    static constexpr int kMaxCategories = 256;
+
+    SkTArray<SkString> fEnabledNames;  // empty means everything is enabled
+    int                fCapacity;      // events per thread, a power of two
+
+    mutable SkMutex    fMutex;         // guards adding categories and threads
+    Category           fCategories[kMaxCategories];
+    int                fNumCategories = 0;
+    SkTArray<std::unique_ptr<ThreadBuffer>> fThreads;
+};
+
+SkRingBufferTracer::SkRingBufferTracer(const char* categories, int eventsPerThread)
+        : fState(new State) {
+    if (categories) {
+        SkStrSplit(categories, ",", kStrict_SkStrSplitMode, &fState->fEnabledNames);
+    }
+    fState->fCapacity = SkNextPow2(SkTMax(eventsPerThread, 2));
+    // Category 0 catches everything once the table is full, and is never enabled.
+    fState->fCategories[0] = {0, "<overflow>"};
+    fState->fNumCategories = 1;
+}
+
+SkRingBufferTracer::~SkRingBufferTracer() {}
+
+const uint8_t* SkRingBufferTracer::getCategoryGroupEnabled(const char* name) {
+    // Trace sites cache the returned pointer, so this is only called once per site.
+    SkAutoMutexAcquire lock(fState->fMutex);
+    for (int i = 1; i < fState->fNumCategories; ++i) {
+        if (0 == strcmp(name, fState->fCategories[i].fName)) {
+            return &fState->fCategories[i].fEnabled;
+        }
+    }
+    if (fState->fNumCategories >= State::kMaxCategories) {
+        SkDEBUGFAIL("Exhausted event tracing categories. Increase kMaxCategories.");
+        return &fState->fCategories[0].fEnabled;
+    }
+
+    const char* unprefixed = name;
+    if (SkStrStartsWith(unprefixed, TRACE_CATEGORY_PREFIX)) {
+        unprefixed += strlen(TRACE_CATEGORY_PREFIX);
+    }
+    bool enabled = fState->fEnabledNames.empty();
+    for (const SkString& enabledName : fState->fEnabledNames) {
+        enabled = enabled || enabledName.equals(unprefixed);
+    }
+
+    Category* category = &fState->fCategories[fState->fNumCategories++];
+    category->fEnabled = enabled ? kEnabledForRecording_CategoryGroupEnabledFlags : 0;
+    category->fName = name;
+    return &category->fEnabled;
+}
+
+const char* SkRingBufferTracer::getCategoryGroupName(const uint8_t* categoryEnabledFlag) {
+    static_assert(0 == offsetof(Category, fEnabled), "Category");
+    if (categoryEnabledFlag) {
+        return reinterpret_cast<const Category*>(categoryEnabledFlag)->fName;
+    }
+    return nullptr;
+}
+
+SkRingBufferTracer::ThreadBuffer* SkRingBufferTracer::threadBuffer() {
+    auto slot = static_cast<ThreadSlot*>(SkTLS::Get(create_slot, delete_slot));
+    if (slot->fOwner != this) {
+        SkAutoMutexAcquire lock(fState->fMutex);
+        fState->fThreads.emplace_back(new ThreadBuffer(fState->fThreads.count(),
+                                                       fState->fCapacity));
+        slot->fOwner = this;
+        slot->fBuffer = fState->fThreads.back().get();
+    }
+    return static_cast<ThreadBuffer*>(slot->fBuffer);
+}
+
+SkEventTracer::Handle SkRingBufferTracer::addTraceEvent(char phase,
+                                                        const uint8_t* categoryEnabledFlag,
+                                                        const char* name,
+                                                        uint64_t id,
+                                                        int32_t numArgs,
+                                                        const char** argNames,
+                                                        const uint8_t* argTypes,
+                                                        const uint64_t* argValues,
+                                                        uint8_t flags) {
+    ThreadBuffer* buffer = this->threadBuffer();
+    uint64_t index = buffer->fCount.load(std::memory_order_relaxed);
+
+    Event* event = &buffer->fEvents[index & (fState->fCapacity - 1)];
+    event->fName     = name;
+    event->fCategory = categoryEnabledFlag;
+    event->fID       = id;
+    event->fBeginNs  = (uint64_t)SkTime::GetNSecs();
+    event->fEndNs    = 0;
+    event->fArgName  = nullptr;
+    event->fPhase    = phase;
+    if (numArgs > 0 && TRACE_VALUE_TYPE_COPY_STRING != argTypes[0]) {
+        event->fArgName  = argNames[0];
+        event->fArgType  = argTypes[0];
+        event->fArgValue = argValues[0];
+    }
+
+    buffer->fCount.store(index + 1, std::memory_order_release);
+    return index;
+}
+
+void SkRingBufferTracer::updateTraceEventDuration(const uint8_t* categoryEnabledFlag,
+                                                  const char* name,
+                                                  SkEventTracer::Handle handle) {
+    // Durations are always closed on the thread that opened them.
+    ThreadBuffer* buffer = this->threadBuffer();
+    uint64_t count = buffer->fCount.load(std::memory_order_relaxed);
+    if (count - handle > (uint64_t)fState->fCapacity) {
+        return;  // Already overwritten.
+    }
+    buffer->fEvents[handle & (fState->fCapacity - 1)].fEndNs = (uint64_t)SkTime::GetNSecs();
+}
+
+static void write_arg(SkJSONWriter* writer, const char* argName, uint8_t argType,
+                      uint64_t argValue) {
+    skia::tracing_internals::TraceValueUnion value;
+    value.as_uint = argValue;
+
+    writer->beginObject("args");
+    switch (argType) {
+        case TRACE_VALUE_TYPE_BOOL:    writer->appendBool(argName, value.as_bool);       break;
+        case TRACE_VALUE_TYPE_UINT:    writer->appendU64(argName, value.as_uint);        break;
+        case TRACE_VALUE_TYPE_INT:     writer->appendS64(argName, value.as_int);         break;
+        case TRACE_VALUE_TYPE_DOUBLE:  writer->appendDouble(argName, value.as_double);   break;
+        case TRACE_VALUE_TYPE_POINTER: writer->appendPointer(argName, value.as_pointer); break;
+        case TRACE_VALUE_TYPE_STRING:  writer->appendString(argName, value.as_string);   break;
+        default:                       writer->appendString(argName, "<unknown type>");  break;
+    }
+    writer->endObject();
+}
+
+void SkRingBufferTracer::dumpJSON(SkWStream* stream) const {
+    SkAutoMutexAcquire lock(fState->fMutex);
+    const uint64_t capacity = fState->fCapacity;
+
+    SkJSONWriter writer(stream, SkJSONWriter::Mode::kFast);
+    writer.beginObject();
+    writer.beginArray("traceEvents");
+    for (const auto& buffer : fState->fThreads) {
+        uint64_t count = buffer->fCount.load(std::memory_order_acquire);
+        for (uint64_t i = count > capacity ? count - capacity : 0; i < count; ++i) {
+            const Event& event = buffer->fEvents[i & (capacity - 1)];
+            if (TRACE_EVENT_PHASE_COMPLETE == event.fPhase && 0 == event.fEndNs) {
+                continue;  // Still open.
+            }
+
+            writer.beginObject();
+            char phaseString[2] = { event.fPhase, 0 };
+            writer.appendString("ph", phaseString);
+            writer.appendString("name", event.fName);
+            writer.appendString("cat",
+                    reinterpret_cast<const Category*>(event.fCategory)->fName);
+            if (0 != event.fID) {
+                writer.appendPointer("id", reinterpret_cast<void*>(event.fID));
+            }
+            // Nanoseconds to microseconds, the standard time unit for tracing JSON.
+            writer.appendDoubleDigits("ts", event.fBeginNs * 1E-3, 3);
+            if (0 != event.fEndNs) {
+                writer.appendDoubleDigits("dur", (event.fEndNs - event.fBeginNs) * 1E-3, 3);
+            }
+            writer.appendS32("tid", buffer->fTid);
+            writer.appendS32("pid", 0);
+            if (event.fArgName) {
+                write_arg(&writer, event.fArgName, event.fArgType, event.fArgValue);
+            }
+            writer.endObject();
+        }
+    }
+    writer.endArray();
+    writer.endObject();
+    writer.flush();
+}
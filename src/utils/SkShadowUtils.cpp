@@ -21,6 +21,7 @@
 #include "SkShadowTessellator.h"
 #include "SkString.h"
 #include "SkTLazy.h"
+#include "SkTaskGroup.h"
 #include "SkVertices.h"
 #include <new>
 #if SK_SUPPORT_GPU
@@ -79,22 +80,40 @@ uint64_t resource_cache_shared_id() {
     return 0x2020776f64616873llu;  // 'shadow  '
 }
 
+// A cached tessellation is reused for a slightly different elevation or light as long as its
+// blurred edge is within this many device pixels, or this fraction of its width, of the exact one.
+// This lets animated elevations reuse tessellations from earlier frames.
+static constexpr SkScalar kMaxBlurRadiusError = 0.5f;
+static constexpr SkScalar kMaxRelativeBlurRadiusError = 1.0f / 16;
+
+static bool blur_radii_match(SkScalar cached, SkScalar wanted) {
+    return SkTAbs(cached - wanted) <= SkTMax(kMaxBlurRadiusError,
+                                             kMaxRelativeBlurRadiusError * wanted);
+}
+
 /** Factory for an ambient shadow mesh with particular shadow properties. */
 struct AmbientVerticesFactory {
     SkScalar fOccluderHeight = SK_ScalarNaN;  // NaN so that isCompatible will fail until init'ed.
     bool fTransparent;
     SkVector fOffset;
 
-    bool isCompatible(const AmbientVerticesFactory& that, SkVector* translate) const {
-        if (fOccluderHeight != that.fOccluderHeight || fTransparent != that.fTransparent) {
+    bool isCompatible(const AmbientVerticesFactory& that, SkMatrix* transform) const {
+        if (fTransparent != that.fTransparent) {
             return false;
         }
-        *translate = that.fOffset;
+        // The outset and the umbra alpha both change slowly with height, so a nearby height can be
+        // drawn with the same mesh.
+        if (fOccluderHeight != that.fOccluderHeight &&
+            !blur_radii_match(SkDrawShadowMetrics::AmbientBlurRadius(fOccluderHeight),
+                              SkDrawShadowMetrics::AmbientBlurRadius(that.fOccluderHeight))) {
+            return false;
+        }
+        transform->setTranslate(that.fOffset.fX, that.fOffset.fY);
         return true;
     }
 
     sk_sp<SkVertices> makeVertices(const SkPath& path, const SkMatrix& ctm,
-                                   SkVector* translate) const {
+                                   SkMatrix* transform) const {
         SkPoint3 zParams = SkPoint3::Make(0, 0, fOccluderHeight);
         // pick a canonical place to generate shadow
         SkMatrix noTrans(ctm);
@@ -102,7 +121,7 @@ struct AmbientVerticesFactory {
             noTrans[SkMatrix::kMTransX] = 0;
             noTrans[SkMatrix::kMTransY] = 0;
         }
-        *translate = fOffset;
+        transform->setTranslate(fOffset.fX, fOffset.fY);
         return SkShadowTessellator::MakeAmbient(path, noTrans, zParams, fTransparent);
     }
 };
@@ -125,24 +144,50 @@ struct SpotVerticesFactory {
     SkPoint3 fDevLightPos;
     SkScalar fLightRadius;
     OccluderType fOccluderType;
+    // The canonical mesh scales the occluder by fScale about fCanonicalCenter (the path's center
+    // mapped by the ctm without its translation) and blurs its edge by fBlurRadius.
+    SkPoint  fCanonicalCenter;
+    SkScalar fScale;
+    SkScalar fBlurRadius;
+    bool     fHasPerspective;
+
+    bool isCanonical() const {
+        return !fHasPerspective && OccluderType::kOpaquePartialUmbra != fOccluderType;
+    }
 
-    bool isCompatible(const SpotVerticesFactory& that, SkVector* translate) const {
-        if (fOccluderHeight != that.fOccluderHeight || fDevLightPos.fZ != that.fDevLightPos.fZ ||
-            fLightRadius != that.fLightRadius || fOccluderType != that.fOccluderType) {
+    bool isCompatible(const SpotVerticesFactory& that, SkMatrix* transform) const {
+        if (fOccluderType != that.fOccluderType) {
             return false;
         }
+        if (fOccluderHeight != that.fOccluderHeight || fDevLightPos.fZ != that.fDevLightPos.fZ ||
+            fLightRadius != that.fLightRadius) {
+            // A different elevation or light only changes the scale of a canonical mesh and the
+            // width of its blurred edge. The scale is applied when the mesh is drawn, as long as
+            // the scaled edge is close enough to the one we want.
+            if (!this->isCanonical() || !that.isCanonical()) {
+                return false;
+            }
+            SkScalar relativeScale = that.fScale / fScale;
+            if (!blur_radii_match(fBlurRadius * relativeScale, that.fBlurRadius)) {
+                return false;
+            }
+            transform->setScale(relativeScale, relativeScale,
+                                fCanonicalCenter.fX, fCanonicalCenter.fY);
+            transform->postTranslate(that.fOffset.fX, that.fOffset.fY);
+            return true;
+        }
         switch (fOccluderType) {
             case OccluderType::kTransparent:
             case OccluderType::kOpaqueNoUmbra:
                 // 'this' and 'that' will either both have no umbra removed or both have all the
                 // umbra removed.
-                *translate = that.fOffset;
+                transform->setTranslate(that.fOffset.fX, that.fOffset.fY);
                 return true;
             case OccluderType::kOpaquePartialUmbra:
                 // In this case we partially remove the umbra differently for 'this' and 'that'
                 // if the offsets don't match.
                 if (fOffset == that.fOffset) {
-                    translate->set(0, 0);
+                    transform->reset();
                     return true;
                 }
                 return false;
@@ -152,11 +197,11 @@ struct SpotVerticesFactory {
     }
 
     sk_sp<SkVertices> makeVertices(const SkPath& path, const SkMatrix& ctm,
-                                   SkVector* translate) const {
+                                   SkMatrix* transform) const {
         bool transparent = OccluderType::kTransparent == fOccluderType;
         SkPoint3 zParams = SkPoint3::Make(0, 0, fOccluderHeight);
         if (ctm.hasPerspective() || OccluderType::kOpaquePartialUmbra == fOccluderType) {
-            translate->set(0, 0);
+            transform->reset();
             return SkShadowTessellator::MakeSpot(path, ctm, zParams,
                                                  fDevLightPos, fLightRadius, transparent);
         } else {
@@ -167,7 +212,7 @@ struct SpotVerticesFactory {
             SkPoint devCenter(fLocalCenter);
             noTrans.mapPoints(&devCenter, 1);
             SkPoint3 centerLightPos = SkPoint3::Make(devCenter.fX, devCenter.fY, fDevLightPos.fZ);
-            *translate = fOffset;
+            transform->setTranslate(fOffset.fX, fOffset.fY);
             return SkShadowTessellator::MakeSpot(path, noTrans, zParams,
                                                  centerLightPos, fLightRadius, transparent);
         }
@@ -185,23 +230,23 @@ public:
     size_t size() const { return fAmbientSet.size() + fSpotSet.size(); }
 
     sk_sp<SkVertices> find(const AmbientVerticesFactory& ambient, const SkMatrix& matrix,
-                           SkVector* translate) const {
-        return fAmbientSet.find(ambient, matrix, translate);
+                           SkMatrix* transform) const {
+        return fAmbientSet.find(ambient, matrix, transform);
     }
 
-    sk_sp<SkVertices> add(const SkPath& devPath, const AmbientVerticesFactory& ambient,
-                          const SkMatrix& matrix, SkVector* translate) {
-        return fAmbientSet.add(devPath, ambient, matrix, translate);
+    void add(const AmbientVerticesFactory& ambient, const SkMatrix& matrix,
+             sk_sp<SkVertices> vertices) {
+        fAmbientSet.add(ambient, matrix, std::move(vertices));
     }
 
     sk_sp<SkVertices> find(const SpotVerticesFactory& spot, const SkMatrix& matrix,
-                           SkVector* translate) const {
-        return fSpotSet.find(spot, matrix, translate);
+                           SkMatrix* transform) const {
+        return fSpotSet.find(spot, matrix, transform);
     }
 
-    sk_sp<SkVertices> add(const SkPath& devPath, const SpotVerticesFactory& spot,
-                          const SkMatrix& matrix, SkVector* translate) {
-        return fSpotSet.add(devPath, spot, matrix, translate);
+    void add(const SpotVerticesFactory& spot, const SkMatrix& matrix,
+             sk_sp<SkVertices> vertices) {
+        fSpotSet.add(spot, matrix, std::move(vertices));
     }
 
 private:
@@ -211,9 +256,9 @@ private:
         size_t size() const { return fSize; }
 
         sk_sp<SkVertices> find(const FACTORY& factory, const SkMatrix& matrix,
-                               SkVector* translate) const {
+                               SkMatrix* transform) const {
             for (int i = 0; i < MAX_ENTRIES; ++i) {
-                if (fEntries[i].fFactory.isCompatible(factory, translate)) {
+                if (fEntries[i].fFactory.isCompatible(factory, transform)) {
                     const SkMatrix& m = fEntries[i].fMatrix;
                     if (matrix.hasPerspective() || m.hasPerspective()) {
                         if (matrix != fEntries[i].fMatrix) {
@@ -231,12 +276,8 @@ private:
             return nullptr;
         }
 
-        sk_sp<SkVertices> add(const SkPath& path, const FACTORY& factory, const SkMatrix& matrix,
-                              SkVector* translate) {
-            sk_sp<SkVertices> vertices = factory.makeVertices(path, matrix, translate);
-            if (!vertices) {
-                return nullptr;
-            }
+        void add(const FACTORY& factory, const SkMatrix& matrix, sk_sp<SkVertices> vertices) {
+            SkASSERT(vertices);
             int i;
             if (fCount < MAX_ENTRIES) {
                 i = fCount++;
@@ -245,10 +286,9 @@ private:
                 fSize -= fEntries[i].fVertices->approximateSize();
             }
             fEntries[i].fFactory = factory;
-            fEntries[i].fVertices = vertices;
             fEntries[i].fMatrix = matrix;
             fSize += vertices->approximateSize();
-            return vertices;
+            fEntries[i].fVertices = std::move(vertices);
         }
 
     private:
@@ -292,8 +332,8 @@ public:
 
     template <typename FACTORY>
     sk_sp<SkVertices> find(const FACTORY& factory, const SkMatrix& matrix,
-                           SkVector* translate) const {
-        return fTessellations->find(factory, matrix, translate);
+                           SkMatrix* transform) const {
+        return fTessellations->find(factory, matrix, transform);
     }
 
 private:
@@ -313,9 +353,9 @@ struct FindContext {
             : fViewMatrix(viewMatrix), fFactory(factory) {}
     const SkMatrix* const fViewMatrix;
     // If this is valid after Find is called then we found the vertices and they should be drawn
-    // with fTranslate applied.
+    // with fTransform applied.
     sk_sp<SkVertices> fVertices;
-    SkVector fTranslate = {0, 0};
+    SkMatrix fTransform = SkMatrix::I();
 
     // If this is valid after Find then the caller should add the vertices to the tessellation set
     // and create a new CachedTessellationsRec and insert it into SkResourceCache.
@@ -334,7 +374,7 @@ bool FindVisitor(const SkResourceCache::Rec& baseRec, void* ctx) {
     FindContext<FACTORY>* findContext = (FindContext<FACTORY>*)ctx;
     const CachedTessellationsRec& rec = static_cast<const CachedTessellationsRec&>(baseRec);
     findContext->fVertices =
-            rec.find(*findContext->fFactory, *findContext->fViewMatrix, &findContext->fTranslate);
+            rec.find(*findContext->fFactory, *findContext->fViewMatrix, &findContext->fTransform);
     if (findContext->fVertices) {
         return true;
     }
@@ -406,57 +446,110 @@ private:
 };
 
 /**
- * Draws a shadow to 'canvas'. The vertices used to draw the shadow are created by 'factory' unless
- * they are first found in SkResourceCache.
+ * The key in SkResourceCache for the tessellations of a path, and the tessellations pulled out of
+ * the cache by a failed lookup. Every shadow of the path is looked up before any missing
+ * tessellations are made, and they are all added back to the cache together.
  */
-template <typename FACTORY>
-bool draw_shadow(const FACTORY& factory,
-                 std::function<void(const SkVertices*, SkBlendMode, const SkPaint&,
-                 SkScalar tx, SkScalar ty, bool)> drawProc, ShadowedPath& path, SkColor color) {
-    FindContext<FACTORY> context(&path.viewMatrix(), &factory);
-
-    SkResourceCache::Key* key = nullptr;
-    SkAutoSTArray<32 * 4, uint8_t> keyStorage;
-    int keyDataBytes = path.keyBytes();
-    if (keyDataBytes >= 0) {
-        keyStorage.reset(keyDataBytes + sizeof(SkResourceCache::Key));
-        key = new (keyStorage.begin()) SkResourceCache::Key();
-        path.writeKey((uint32_t*)(keyStorage.begin() + sizeof(*key)));
-        key->init(&kNamespace, resource_cache_shared_id(), keyDataBytes);
-        SkResourceCache::Find(*key, FindVisitor<FACTORY>, &context);
-    }
-
-    sk_sp<SkVertices> vertices;
-    bool foundInCache = SkToBool(context.fVertices);
-    if (foundInCache) {
-        vertices = std::move(context.fVertices);
-    } else {
-        // TODO: handle transforming the path as part of the tessellator
-        if (key) {
-            // Update or initialize a tessellation set and add it to the cache.
-            sk_sp<CachedTessellations> tessellations;
-            if (context.fTessellationsOnFailure) {
-                tessellations = std::move(context.fTessellationsOnFailure);
-            } else {
-                tessellations.reset(new CachedTessellations());
-            }
-            vertices = tessellations->add(path.path(), factory, path.viewMatrix(),
-                                          &context.fTranslate);
-            if (!vertices) {
-                return false;
-            }
-            auto rec = new CachedTessellationsRec(*key, std::move(tessellations));
-            SkPathPriv::AddGenIDChangeListener(path.path(), sk_make_sp<ShadowInvalidator>(*key));
-            SkResourceCache::Add(rec);
+class ShadowCacheEntry {
+public:
+    ShadowCacheEntry(const ShadowedPath& path) : fPath(path) {
+        int keyDataBytes = path.keyBytes();
+        if (keyDataBytes >= 0) {
+            fKeyStorage.reset(keyDataBytes + sizeof(SkResourceCache::Key));
+            fKey = new (fKeyStorage.begin()) SkResourceCache::Key();
+            path.writeKey((uint32_t*)(fKeyStorage.begin() + sizeof(*fKey)));
+            fKey->init(&kNamespace, resource_cache_shared_id(), keyDataBytes);
+        }
+    }
+
+    /**
+     * Returns cached vertices for 'factory' and the transform to draw them with, or null if the
+     * vertices need to be made and then added with add().
+     */
+    template <typename FACTORY>
+    sk_sp<SkVertices> find(const FACTORY& factory, SkMatrix* transform) {
+        if (!fKey) {
+            return nullptr;
+        }
+        if (fTessellations) {
+            // An earlier lookup already took the tessellations out of the cache.
+            return fTessellations->find(factory, fPath.viewMatrix(), transform);
+        }
+        FindContext<FACTORY> context(&fPath.viewMatrix(), &factory);
+        SkResourceCache::Find(*fKey, FindVisitor<FACTORY>, &context);
+        if (context.fVertices) {
+            *transform = context.fTransform;
+            return std::move(context.fVertices);
+        }
+        if (context.fTessellationsOnFailure) {
+            fTessellations = std::move(context.fTessellationsOnFailure);
         } else {
-            vertices = factory.makeVertices(path.path(), path.viewMatrix(),
-                                            &context.fTranslate);
-            if (!vertices) {
-                return false;
-            }
+            fTessellations.reset(new CachedTessellations());
+        }
+        return nullptr;
+    }
+
+    template <typename FACTORY>
+    void add(const FACTORY& factory, sk_sp<SkVertices> vertices) {
+        if (fTessellations && vertices) {
+            fTessellations->add(factory, fPath.viewMatrix(), std::move(vertices));
+            fDirty = true;
+        }
+    }
+
+    /** Puts updated tessellations back into the cache. */
+    void commit() {
+        if (fDirty) {
+            auto rec = new CachedTessellationsRec(*fKey, std::move(fTessellations));
+            SkPathPriv::AddGenIDChangeListener(fPath.path(), sk_make_sp<ShadowInvalidator>(*fKey));
+            SkResourceCache::Add(rec);
+            fDirty = false;
         }
     }
 
+private:
+    const ShadowedPath& fPath;
+    SkResourceCache::Key* fKey = nullptr;
+    SkAutoSTArray<32 * 4, uint8_t> fKeyStorage;
+    sk_sp<CachedTessellations> fTessellations;
+    bool fDirty = false;
+};
+
+/**
+ * The vertices for one of the shadows of a path, found in the cache or made by the factory, and
+ * the transform to draw them with.
+ */
+struct ShadowVertices {
+    sk_sp<SkVertices> fVertices;
+    SkMatrix fTransform = SkMatrix::I();
+    bool fNeedsTessellation = false;
+
+    template <typename FACTORY>
+    void find(const FACTORY& factory, ShadowCacheEntry* entry) {
+        fVertices = entry->find(factory, &fTransform);
+        fNeedsTessellation = !fVertices;
+    }
+
+    template <typename FACTORY>
+    void tessellate(const FACTORY& factory, const ShadowedPath& path) {
+        if (fNeedsTessellation) {
+            // TODO: handle transforming the path as part of the tessellator
+            fVertices = factory.makeVertices(path.path(), path.viewMatrix(), &fTransform);
+        }
+    }
+};
+
+/**
+ * Draws a shadow with 'vertices', returning false if there are none and the caller should fall
+ * back to drawing a blur.
+ */
+bool draw_shadow(const ShadowVertices& vertices,
+                 std::function<void(const SkVertices*, SkBlendMode, const SkPaint&,
+                 const SkMatrix&, bool)> drawProc, const ShadowedPath& path, SkColor color) {
+    if (!vertices.fVertices) {
+        return false;
+    }
+
     SkPaint paint;
     // Run the vertex color through a GaussianColorFilter and then modulate the grayscale result of
     // that against our 'color' param.
@@ -464,8 +557,8 @@ bool draw_shadow(const FACTORY& factory,
          SkColorFilter::MakeModeFilter(color, SkBlendMode::kModulate)->makeComposed(
                                                                     SkGaussianColorFilter::Make()));
 
-    drawProc(vertices.get(), SkBlendMode::kModulate, paint,
-             context.fTranslate.fX, context.fTranslate.fY, path.viewMatrix().hasPerspective());
+    drawProc(vertices.fVertices.get(), SkBlendMode::kModulate, paint,
+             vertices.fTransform, path.viewMatrix().hasPerspective());
 
     return true;
 }
@@ -566,15 +659,15 @@ static bool validate_rec(const SkDrawShadowRec& rec) {
 
 void SkBaseDevice::drawShadow(const SkPath& path, const SkDrawShadowRec& rec) {
     auto drawVertsProc = [this](const SkVertices* vertices, SkBlendMode mode, const SkPaint& paint,
-                                SkScalar tx, SkScalar ty, bool hasPerspective) {
+                                const SkMatrix& transform, bool hasPerspective) {
         if (vertices->vertexCount()) {
             // For perspective shadows we've already computed the shadow in world space,
-            // and we can't translate it without changing it. Otherwise we concat the
-            // change in translation from the cached version.
+            // and we can't transform it without changing it. Otherwise we concat the
+            // change in translation (and scale) from the cached version.
             SkAutoDeviceCTMRestore adr(
                 this,
                 hasPerspective ? SkMatrix::I()
-                               : SkMatrix::Concat(this->ctm(), SkMatrix::MakeTrans(tx, ty)));
+                               : SkMatrix::Concat(this->ctm(), transform));
             this->drawVertices(vertices, nullptr, 0, mode, paint);
         }
     };
@@ -596,170 +689,179 @@ void SkBaseDevice::drawShadow(const SkPath& path, const SkDrawShadowRec& rec) {
     SkPoint3 devLightPos = map(viewMatrix, rec.fLightPos);
     float lightRadius = rec.fLightRadius;
 
-    if (SkColorGetA(rec.fAmbientColor) > 0) {
-        bool success = false;
-        if (uncached) {
-            sk_sp<SkVertices> vertices = SkShadowTessellator::MakeAmbient(path, viewMatrix,
-                                                                          zPlaneParams,
-                                                                          transparent);
-            if (vertices) {
-                SkPaint paint;
-                // Run the vertex color through a GaussianColorFilter and then modulate the
-                // grayscale result of that against our 'color' param.
-                paint.setColorFilter(
-                    SkColorFilter::MakeModeFilter(rec.fAmbientColor,
-                                                  SkBlendMode::kModulate)->makeComposed(
-                                                                   SkGaussianColorFilter::Make()));
-                this->drawVertices(vertices.get(), nullptr, 0, SkBlendMode::kModulate, paint);
-                success = true;
-            }
+    bool drawAmbient = SkColorGetA(rec.fAmbientColor) > 0;
+    bool drawSpot = SkColorGetA(rec.fSpotColor) > 0;
+
+    ShadowVertices ambient, spot;
+    if (uncached) {
+        if (drawAmbient) {
+            ambient.fVertices = SkShadowTessellator::MakeAmbient(path, viewMatrix, zPlaneParams,
+                                                                 transparent);
+        }
+        if (drawSpot) {
+            spot.fVertices = SkShadowTessellator::MakeSpot(path, viewMatrix, zPlaneParams,
+                                                           devLightPos, lightRadius, transparent);
         }
+    }
 
-        if (!success) {
-            AmbientVerticesFactory factory;
-            factory.fOccluderHeight = zPlaneParams.fZ;
-            factory.fTransparent = transparent;
-            if (viewMatrix.hasPerspective()) {
-                factory.fOffset.set(0, 0);
-            } else {
-                factory.fOffset.fX = viewMatrix.getTranslateX();
-                factory.fOffset.fY = viewMatrix.getTranslateY();
-            }
+    ShadowCacheEntry cacheEntry(shadowedPath);
 
-            if (!draw_shadow(factory, drawVertsProc, shadowedPath, rec.fAmbientColor)) {
-                // Pretransform the path to avoid transforming the stroke, below.
-                SkPath devSpacePath;
-                path.transform(viewMatrix, &devSpacePath);
-
-                // The tesselator outsets by AmbientBlurRadius (or 'r') to get the outer ring of
-                // the tesselation, and sets the alpha on the path to 1/AmbientRecipAlpha (or 'a').
-                //
-                // We want to emulate this with a blur. The full blur width (2*blurRadius or 'f')
-                // can be calculated by interpolating:
-                //
-                //            original edge        outer edge
-                //         |       |<---------- r ------>|
-                //         |<------|--- f -------------->|
-                //         |       |                     |
-                //    alpha = 1  alpha = a          alpha = 0
-                //
-                // Taking ratios, f/1 = r/a, so f = r/a and blurRadius = f/2.
-                //
-                // We now need to outset the path to place the new edge in the center of the
-                // blur region:
-                //
-                //             original   new
-                //         |       |<------|--- r ------>|
-                //         |<------|--- f -|------------>|
-                //         |       |<- o ->|<--- f/2 --->|
-                //
-                //     r = o + f/2, so o = r - f/2
-                //
-                // We outset by using the stroker, so the strokeWidth is o/2.
-                //
-                SkScalar devSpaceOutset = SkDrawShadowMetrics::AmbientBlurRadius(zPlaneParams.fZ);
-                SkScalar oneOverA = SkDrawShadowMetrics::AmbientRecipAlpha(zPlaneParams.fZ);
-                SkScalar blurRadius = 0.5f*devSpaceOutset*oneOverA;
-                SkScalar strokeWidth = 0.5f*(devSpaceOutset - blurRadius);
-
-                // Now draw with blur
-                SkPaint paint;
-                paint.setColor(rec.fAmbientColor);
-                paint.setStrokeWidth(strokeWidth);
-                paint.setStyle(SkPaint::kStrokeAndFill_Style);
-                SkScalar sigma = SkBlurMask::ConvertRadiusToSigma(blurRadius);
-                bool respectCTM = false;
-                paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, sigma, respectCTM));
-                this->drawPath(devSpacePath, paint);
-            }
+    AmbientVerticesFactory ambientFactory;
+    if (drawAmbient && !ambient.fVertices) {
+        ambientFactory.fOccluderHeight = zPlaneParams.fZ;
+        ambientFactory.fTransparent = transparent;
+        if (viewMatrix.hasPerspective()) {
+            ambientFactory.fOffset.set(0, 0);
+        } else {
+            ambientFactory.fOffset.fX = viewMatrix.getTranslateX();
+            ambientFactory.fOffset.fY = viewMatrix.getTranslateY();
         }
+        ambient.find(ambientFactory, &cacheEntry);
     }
 
-    if (SkColorGetA(rec.fSpotColor) > 0) {
-        bool success = false;
-        if (uncached) {
-            sk_sp<SkVertices> vertices = SkShadowTessellator::MakeSpot(path, viewMatrix,
-                                                                       zPlaneParams,
-                                                                       devLightPos, lightRadius,
-                                                                       transparent);
-            if (vertices) {
-                SkPaint paint;
-                // Run the vertex color through a GaussianColorFilter and then modulate the
-                // grayscale result of that against our 'color' param.
-                paint.setColorFilter(
-                    SkColorFilter::MakeModeFilter(rec.fSpotColor,
-                                                  SkBlendMode::kModulate)->makeComposed(
-                                                      SkGaussianColorFilter::Make()));
-                this->drawVertices(vertices.get(), nullptr, 0, SkBlendMode::kModulate, paint);
-                success = true;
-            }
+    SpotVerticesFactory spotFactory;
+    SkScalar radius, scale;
+    SkColor spotColor = rec.fSpotColor;
+    if (drawSpot && !spot.fVertices) {
+        spotFactory.fOccluderHeight = zPlaneParams.fZ;
+        spotFactory.fDevLightPos = devLightPos;
+        spotFactory.fLightRadius = lightRadius;
+
+        SkPoint center = SkPoint::Make(path.getBounds().centerX(), path.getBounds().centerY());
+        spotFactory.fLocalCenter = center;
+        viewMatrix.mapPoints(&center, 1);
+        SkDrawShadowMetrics::GetSpotParams(zPlaneParams.fZ, devLightPos.fX - center.fX,
+                                           devLightPos.fY - center.fY, devLightPos.fZ,
+                                           lightRadius, &radius, &scale, &spotFactory.fOffset);
+        spotFactory.fCanonicalCenter.set(center.fX - viewMatrix.getTranslateX(),
+                                         center.fY - viewMatrix.getTranslateY());
+        spotFactory.fScale = scale;
+        spotFactory.fBlurRadius = radius;
+        spotFactory.fHasPerspective = viewMatrix.hasPerspective();
+        SkRect devBounds;
+        viewMatrix.mapRect(&devBounds, path.getBounds());
+        if (transparent ||
+            SkTAbs(spotFactory.fOffset.fX) > 0.5f*devBounds.width() ||
+            SkTAbs(spotFactory.fOffset.fY) > 0.5f*devBounds.height()) {
+            // if the translation of the shadow is big enough we're going to end up
+            // filling the entire umbra, so we can treat these as all the same
+            spotFactory.fOccluderType = SpotVerticesFactory::OccluderType::kTransparent;
+        } else if (spotFactory.fOffset.length()*scale + scale < radius) {
+            // if we don't translate more than the blur distance, can assume umbra is covered
+            spotFactory.fOccluderType = SpotVerticesFactory::OccluderType::kOpaqueNoUmbra;
+        } else if (path.isConvex()) {
+            spotFactory.fOccluderType = SpotVerticesFactory::OccluderType::kOpaquePartialUmbra;
+        } else {
+            spotFactory.fOccluderType = SpotVerticesFactory::OccluderType::kTransparent;
         }
-
-        if (!success) {
-            SpotVerticesFactory factory;
-            factory.fOccluderHeight = zPlaneParams.fZ;
-            factory.fDevLightPos = devLightPos;
-            factory.fLightRadius = lightRadius;
-
-            SkPoint center = SkPoint::Make(path.getBounds().centerX(), path.getBounds().centerY());
-            factory.fLocalCenter = center;
-            viewMatrix.mapPoints(&center, 1);
-            SkScalar radius, scale;
-            SkDrawShadowMetrics::GetSpotParams(zPlaneParams.fZ, devLightPos.fX - center.fX,
-                                               devLightPos.fY - center.fY, devLightPos.fZ,
-                                               lightRadius, &radius, &scale, &factory.fOffset);
-            SkRect devBounds;
-            viewMatrix.mapRect(&devBounds, path.getBounds());
-            if (transparent ||
-                SkTAbs(factory.fOffset.fX) > 0.5f*devBounds.width() ||
-                SkTAbs(factory.fOffset.fY) > 0.5f*devBounds.height()) {
-                // if the translation of the shadow is big enough we're going to end up
-                // filling the entire umbra, so we can treat these as all the same
-                factory.fOccluderType = SpotVerticesFactory::OccluderType::kTransparent;
-            } else if (factory.fOffset.length()*scale + scale < radius) {
-                // if we don't translate more than the blur distance, can assume umbra is covered
-                factory.fOccluderType = SpotVerticesFactory::OccluderType::kOpaqueNoUmbra;
-            } else if (path.isConvex()) {
-                factory.fOccluderType = SpotVerticesFactory::OccluderType::kOpaquePartialUmbra;
-            } else {
-                factory.fOccluderType = SpotVerticesFactory::OccluderType::kTransparent;
-            }
-            // need to add this after we classify the shadow
-            factory.fOffset.fX += viewMatrix.getTranslateX();
-            factory.fOffset.fY += viewMatrix.getTranslateY();
-
-            SkColor color = rec.fSpotColor;
+        // need to add this after we classify the shadow
+        spotFactory.fOffset.fX += viewMatrix.getTranslateX();
+        spotFactory.fOffset.fY += viewMatrix.getTranslateY();
+        spot.find(spotFactory, &cacheEntry);
 #ifdef DEBUG_SHADOW_CHECKS
-            switch (factory.fOccluderType) {
-                case SpotVerticesFactory::OccluderType::kTransparent:
-                    color = 0xFFD2B48C;  // tan for transparent
-                    break;
-                case SpotVerticesFactory::OccluderType::kOpaquePartialUmbra:
-                    color = 0xFFFFA500;   // orange for opaque
-                    break;
-                case SpotVerticesFactory::OccluderType::kOpaqueNoUmbra:
-                    color = 0xFFE5E500;  // corn yellow for covered
-                    break;
-            }
+        switch (spotFactory.fOccluderType) {
+            case SpotVerticesFactory::OccluderType::kTransparent:
+                spotColor = 0xFFD2B48C;  // tan for transparent
+                break;
+            case SpotVerticesFactory::OccluderType::kOpaquePartialUmbra:
+                spotColor = 0xFFFFA500;   // orange for opaque
+                break;
+            case SpotVerticesFactory::OccluderType::kOpaqueNoUmbra:
+                spotColor = 0xFFE5E500;  // corn yellow for covered
+                break;
+        }
 #endif
-            if (!draw_shadow(factory, drawVertsProc, shadowedPath, color)) {
-                // draw with blur
-                SkMatrix shadowMatrix;
-                if (!SkDrawShadowMetrics::GetSpotShadowTransform(devLightPos, lightRadius,
-                                                                 viewMatrix, zPlaneParams,
-                                                                 path.getBounds(),
-                                                                 &shadowMatrix, &radius)) {
-                    return;
-                }
-                SkAutoDeviceCTMRestore adr(this, shadowMatrix);
-
-                SkPaint paint;
-                paint.setColor(rec.fSpotColor);
-                SkScalar sigma = SkBlurMask::ConvertRadiusToSigma(radius);
-                bool respectCTM = false;
-                paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, sigma, respectCTM));
-                this->drawPath(path, paint);
+    }
+
+    // Animated elevations and lights miss the cache every few frames. When both shadows miss,
+    // tessellate the ambient one on the default executor while the spot one is made here.
+    {
+        SkTaskGroup taskGroup;
+        if (ambient.fNeedsTessellation && spot.fNeedsTessellation) {
+            // Resolve the path's lazily computed bounds before both tessellators read it.
+            path.updateBoundsCache();
+            taskGroup.add([&] { ambient.tessellate(ambientFactory, shadowedPath); });
+        } else {
+            ambient.tessellate(ambientFactory, shadowedPath);
+        }
+        spot.tessellate(spotFactory, shadowedPath);
+        taskGroup.wait();
+    }
+    if (ambient.fNeedsTessellation) {
+        cacheEntry.add(ambientFactory, ambient.fVertices);
+    }
+    if (spot.fNeedsTessellation) {
+        cacheEntry.add(spotFactory, spot.fVertices);
+    }
+    cacheEntry.commit();
+
+    if (drawAmbient) {
+        if (!draw_shadow(ambient, drawVertsProc, shadowedPath, rec.fAmbientColor)) {
+            // Pretransform the path to avoid transforming the stroke, below.
+            SkPath devSpacePath;
+            path.transform(viewMatrix, &devSpacePath);
+
+            // The tesselator outsets by AmbientBlurRadius (or 'r') to get the outer ring of
+            // the tesselation, and sets the alpha on the path to 1/AmbientRecipAlpha (or 'a').
+            //
+            // We want to emulate this with a blur. The full blur width (2*blurRadius or 'f')
+            // can be calculated by interpolating:
+            //
+            //            original edge        outer edge
+            //         |       |<---------- r ------>|
+            //         |<------|--- f -------------->|
+            //         |       |                     |
+            //    alpha = 1  alpha = a          alpha = 0
+            //
+            // Taking ratios, f/1 = r/a, so f = r/a and blurRadius = f/2.
+            //
+            // We now need to outset the path to place the new edge in the center of the
+            // blur region:
+            //
+            //             original   new
+            //         |       |<------|--- r ------>|
+            //         |<------|--- f -|------------>|
+            //         |       |<- o ->|<--- f/2 --->|
+            //
+            //     r = o + f/2, so o = r - f/2
+            //
+            // We outset by using the stroker, so the strokeWidth is o/2.
+            //
+            SkScalar devSpaceOutset = SkDrawShadowMetrics::AmbientBlurRadius(zPlaneParams.fZ);
+            SkScalar oneOverA = SkDrawShadowMetrics::AmbientRecipAlpha(zPlaneParams.fZ);
+            SkScalar blurRadius = 0.5f*devSpaceOutset*oneOverA;
+            SkScalar strokeWidth = 0.5f*(devSpaceOutset - blurRadius);
+
+            // Now draw with blur
+            SkPaint paint;
+            paint.setColor(rec.fAmbientColor);
+            paint.setStrokeWidth(strokeWidth);
+            paint.setStyle(SkPaint::kStrokeAndFill_Style);
+            SkScalar sigma = SkBlurMask::ConvertRadiusToSigma(blurRadius);
+            bool respectCTM = false;
+            paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, sigma, respectCTM));
+            this->drawPath(devSpacePath, paint);
+        }
+    }
+
+    if (drawSpot) {
+        if (!draw_shadow(spot, drawVertsProc, shadowedPath, spotColor)) {
+            // draw with blur
+            SkMatrix shadowMatrix;
+            if (!SkDrawShadowMetrics::GetSpotShadowTransform(devLightPos, lightRadius,
+                                                             viewMatrix, zPlaneParams,
+                                                             path.getBounds(),
+                                                             &shadowMatrix, &radius)) {
+                return;
             }
+            SkAutoDeviceCTMRestore adr(this, shadowMatrix);
+
+            SkPaint paint;
+            paint.setColor(rec.fSpotColor);
+            SkScalar sigma = SkBlurMask::ConvertRadiusToSigma(radius);
+            bool respectCTM = false;
+            paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, sigma, respectCTM));
+            this->drawPath(path, paint);
         }
     }
 }
@@ -46,6 +46,7 @@
 #include "SkStrikeCache.h"
 #include "SkTDArray.h"
 #include "SkTLazy.h"
+#include "SkTaskGroup.h"
 #include "SkTScopedComPtr.h"
 #include "SkTTCFHeader.h"
 #include "SkTo.h"
@@ -117,7 +118,11 @@ SkXPSDevice::SkXPSDevice(SkISize s)
                 SkSurfaceProps(0, kUnknown_SkPixelGeometry))
     , fCurrentPage(0) {}
 
-SkXPSDevice::~SkXPSDevice() {}
+SkXPSDevice::~SkXPSDevice() {
+    fImageResources.foreach([](const ImageKey&, IXpsOMImageResource** resource) {
+        (*resource)->Release();
+    });
+}
 
 SkXPSDevice::TypefaceUse::TypefaceUse()
     : typefaceId(0xffffffff)
@@ -328,7 +333,13 @@ bool SkXPSDevice::endSheet() {
     return true;
 }
 
-static HRESULT subset_typeface(SkXPSDevice::TypefaceUse* current) {
+/**
+   Creates the subset of the font with only the glyphs used.
+   This does not touch the xps font, so it may run on any thread.
+   @return nullptr if the font could not be subset.
+ */
+static std::unique_ptr<SkMemoryStream> make_font_package(
+        const SkXPSDevice::TypefaceUse* current) {
     //CreateFontPackage wants unsigned short.
     //Microsoft, Y U NO stdint.h?
     std::vector<unsigned short> keepList;
@@ -363,7 +374,7 @@ static HRESULT subset_typeface(SkXPSDevice::TypefaceUse* current) {
     SkAutoTMalloc<unsigned char> fontPackageBuffer(fontPackageBufferRaw);
     if (result != NO_ERROR) {
         SkDEBUGF("CreateFontPackage Error %lu", result);
-        return E_UNEXPECTED;
+        return nullptr;
     }
 
     // If it was originally a ttc, keep it a ttc.
@@ -402,9 +413,17 @@ static HRESULT subset_typeface(SkXPSDevice::TypefaceUse* current) {
 
     std::unique_ptr<SkMemoryStream> newStream(new SkMemoryStream());
     newStream->setMemoryOwned(fontPackageBuffer.release(), bytesWritten + extra);
+    return newStream;
+}
+
+static HRESULT subset_typeface(SkXPSDevice::TypefaceUse* current,
+                               std::unique_ptr<SkMemoryStream> fontPackage) {
+    if (!fontPackage) {
+        return E_UNEXPECTED;
+    }
 
     SkTScopedComPtr<IStream> newIStream;
-    SkIStream::CreateFromSkStream(newStream.release(), true, &newIStream);
+    SkIStream::CreateFromSkStream(fontPackage.release(), true, &newIStream);
 
     XPS_FONT_EMBEDDING embedding;
     HRM(current->xpsFont->GetEmbeddingOption(&embedding),
@@ -423,16 +442,27 @@ static HRESULT subset_typeface(SkXPSDevice::TypefaceUse* current) {
     return S_OK;
 }
 
-bool SkXPSDevice::endPortfolio() {
+bool SkXPSDevice::endPortfolio(SkExecutor* executor) {
     //Subset fonts
-    if (!this->fTypefaces.empty()) {
-        SkXPSDevice::TypefaceUse* current = &this->fTypefaces.front();
-        const TypefaceUse* last = &this->fTypefaces.back();
-        for (; current <= last; ++current) {
-            //Ignore return for now, if it didn't subset, let it be.
-            subset_typeface(current);
+    //Creating the font packages is the expensive part and is independent per font,
+    //but the xps fonts themselves are only updated on this thread.
+    const int count = this->fTypefaces.count();
+    std::vector<std::unique_ptr<SkMemoryStream>> fontPackages(count);
+    if (executor && count > 1) {
+        SkTaskGroup taskGroup(*executor);
+        taskGroup.batch(count, [this, &fontPackages](int i) {
+            fontPackages[i] = make_font_package(&this->fTypefaces[i]);
+        });
+        taskGroup.wait();
+    } else {
+        for (int i = 0; i < count; ++i) {
+            fontPackages[i] = make_font_package(&this->fTypefaces[i]);
         }
     }
+    for (int i = 0; i < count; ++i) {
+        //Ignore return for now, if it didn't subset, let it be.
+        subset_typeface(&this->fTypefaces[i], std::move(fontPackages[i]));
+    }
 
     HRBM(this->fPackageWriter->Close(), "Could not close writer.");
 
@@ -623,12 +653,18 @@ static XPS_TILE_MODE SkToXpsTileMode[SkShader::kTileModeCount+1]
     /*None  */ {XTM_N,  XTM_N,   XTM_Y,   XTM_N},
 };
 
-HRESULT SkXPSDevice::createXpsImageBrush(
+HRESULT SkXPSDevice::findOrCreateImageResource(
         const SkBitmap& bitmap,
-        const SkMatrix& localMatrix,
-        const SkShader::TileMode (&xy)[2],
-        const SkAlpha alpha,
-        IXpsOMTileBrush** xpsBrush) {
+        IXpsOMImageResource** imageResource) {
+    //The same pixels are only encoded and stored in the package once.
+    const ImageKey key = { bitmap.getGenerationID(),
+                           bitmap.pixelRefOrigin(),
+                           bitmap.dimensions() };
+    if (IXpsOMImageResource** cached = fImageResources.find(key)) {
+        *imageResource = SkRefComPtr(*cached);
+        return S_OK;
+    }
+
     SkDynamicMemoryWStream write;
     if (!SkEncodeImage(&write, bitmap, SkEncodedImageFormat::kPNG, 100)) {
         HRM(E_FAIL, "Unable to encode bitmap as png.");
@@ -650,14 +686,28 @@ HRESULT SkXPSDevice::createXpsImageBrush(
     HRM(this->fXpsFactory->CreatePartUri(buffer, &imagePartUri),
         "Could not create image part uri.");
 
-    SkTScopedComPtr<IXpsOMImageResource> imageResource;
+    SkTScopedComPtr<IXpsOMImageResource> newImageResource;
     HRM(this->fXpsFactory->CreateImageResource(
             readWrapper.get(),
             XPS_IMAGE_TYPE_PNG,
             imagePartUri.get(),
-            &imageResource),
+            &newImageResource),
         "Could not create image resource.");
 
+    fImageResources.set(key, SkRefComPtr(newImageResource.get()));
+    *imageResource = newImageResource.release();
+    return S_OK;
+}
+
+HRESULT SkXPSDevice::createXpsImageBrush(
+        const SkBitmap& bitmap,
+        const SkMatrix& localMatrix,
+        const SkShader::TileMode (&xy)[2],
+        const SkAlpha alpha,
+        IXpsOMTileBrush** xpsBrush) {
+    SkTScopedComPtr<IXpsOMImageResource> imageResource;
+    HR(this->findOrCreateImageResource(bitmap, &imageResource));
+
     XPS_RECT bitmapRect = {
         0.0, 0.0,
         static_cast<FLOAT>(bitmap.width()), static_cast<FLOAT>(bitmap.height())
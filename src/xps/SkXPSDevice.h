@@ -27,10 +27,13 @@
 #include "SkShader.h"
 #include "SkSize.h"
 #include "SkTArray.h"
+#include "SkTHash.h"
 #include "SkTScopedComPtr.h"
 #include "SkTypeface.h"
 
+class SkExecutor;
 class SkGlyphRunList;
+class SkMemoryStream;
 
 //#define SK_XPS_USE_DETERMINISTIC_IDS
 
@@ -73,7 +76,11 @@ public:
         const SkRect* cropBox = NULL);
 
     bool endSheet();
-    bool endPortfolio();
+    /**
+      Subsets the fonts used by the portfolio and closes it.
+      @param executor if not nullptr, the fonts are subset in parallel on it.
+     */
+    bool endPortfolio(SkExecutor* executor = nullptr);
 
 protected:
     void drawPaint(const SkPaint& paint) override;
@@ -114,7 +121,21 @@ private:
         explicit TypefaceUse();
         ~TypefaceUse();
     };
-    friend HRESULT subset_typeface(TypefaceUse* current);
+    friend std::unique_ptr<SkMemoryStream> make_font_package(const TypefaceUse* current);
+    friend HRESULT subset_typeface(TypefaceUse* current, std::unique_ptr<SkMemoryStream>);
+
+    /** Identifies the pixels of a bitmap, so that repeated draws of the same
+        image can share one encoded image resource.
+     */
+    struct ImageKey {
+        uint32_t fGenID;
+        SkIPoint fOrigin;
+        SkISize fSize;
+
+        bool operator==(const ImageKey& that) const {
+            return fGenID == that.fGenID && fOrigin == that.fOrigin && fSize == that.fSize;
+        }
+    };
 
     bool createCanvasForLayer();
 
@@ -129,6 +150,8 @@ private:
     SkVector fCurrentPixelsPerMeter;
 
     SkTArray<TypefaceUse, true> fTypefaces;
+    // Owns a ref on each image resource.
+    SkTHashMap<ImageKey, IXpsOMImageResource*> fImageResources;
 
     /** Creates a GUID based id and places it into buffer.
         buffer should have space for at least GUID_ID_LEN wide characters.
@@ -166,6 +189,10 @@ private:
         const SkColor skColor, const SkAlpha alpha,
         IXpsOMBrush** xpsBrush);
 
+    HRESULT findOrCreateImageResource(
+        const SkBitmap& bitmap,
+        IXpsOMImageResource** imageResource);
+
     HRESULT createXpsImageBrush(
         const SkBitmap& bitmap,
         const SkMatrix& localMatrix,
@@ -24,8 +24,9 @@ struct SkXPSDocument final : public SkDocument {
     std::unique_ptr<SkCanvas> fCanvas;
     SkVector fUnitsPerMeter;
     SkVector fPixelsPerMeter;
+    SkExecutor* fExecutor;
 
-    SkXPSDocument(SkWStream*, SkScalar dpi, SkTScopedComPtr<IXpsOMObjectFactory>);
+    SkXPSDocument(SkWStream*, SkScalar dpi, SkTScopedComPtr<IXpsOMObjectFactory>, SkExecutor*);
     ~SkXPSDocument() override;
     SkCanvas* onBeginPage(SkScalar w, SkScalar h) override;
     void onEndPage() override;
@@ -36,10 +37,12 @@ struct SkXPSDocument final : public SkDocument {
 
 SkXPSDocument::SkXPSDocument(SkWStream* stream,
                    SkScalar dpi,
-                   SkTScopedComPtr<IXpsOMObjectFactory> xpsFactory)
+                   SkTScopedComPtr<IXpsOMObjectFactory> xpsFactory,
+                   SkExecutor* executor)
         : SkDocument(stream)
         , fXpsFactory(std::move(xpsFactory))
         , fDevice(SkISize{10000, 10000})
+        , fExecutor(executor)
 {
     const SkScalar kPointsPerMeter = SkDoubleToScalar(360000.0 / 127.0);
     fUnitsPerMeter.set(kPointsPerMeter, kPointsPerMeter);
@@ -68,7 +71,7 @@ void SkXPSDocument::onEndPage() {
 
 void SkXPSDocument::onClose(SkWStream*) {
     SkASSERT(!fCanvas.get());
-    (void)fDevice.endPortfolio();
+    (void)fDevice.endPortfolio(fExecutor);
 }
 
 void SkXPSDocument::onAbort() {}
@@ -77,10 +80,11 @@ void SkXPSDocument::onAbort() {}
 
 sk_sp<SkDocument> SkXPS::MakeDocument(SkWStream* stream,
                                       IXpsOMObjectFactory* factoryPtr,
-                                      SkScalar dpi) {
+                                      SkScalar dpi,
+                                      SkExecutor* executor) {
     SkTScopedComPtr<IXpsOMObjectFactory> factory(SkSafeRefComPtr(factoryPtr));
     return stream && factory
-           ? sk_make_sp<SkXPSDocument>(stream, dpi, std::move(factory))
+           ? sk_make_sp<SkXPSDocument>(stream, dpi, std::move(factory), executor)
            : nullptr;
 }
 #endif  // defined(SK_BUILD_FOR_WIN)
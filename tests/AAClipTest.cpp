@@ -429,6 +429,39 @@ static void test_huge(skiatest::Reporter* reporter) {
     clip.setRect(r);
 }
 
+// A repeated antialiased path clip may come back from the cache; it must match a fresh one.
+static void test_repeated_path_clip(skiatest::Reporter* reporter) {
+    SkPath path;
+    path.addCircle(40.5f, 40.5f, 30);
+    path.addCircle(40.5f, 40.5f, 12);
+    path.setFillType(SkPath::kEvenOdd_FillType);
+
+    SkPath volatilePath(path);
+    volatilePath.setIsVolatile(true);
+
+    SkMatrix matrix;
+    matrix.setScale(1.25f, 1.25f);
+    matrix.postTranslate(0.25f, 0.5f);
+
+    const SkIRect bounds = SkIRect::MakeWH(100, 100);
+    SkRasterClip expected(bounds);
+    expected.op(volatilePath, matrix, bounds, SkRegion::kIntersect_Op, true);
+    REPORTER_ASSERT(reporter, expected.isAA());
+
+    for (int i = 0; i < 3; ++i) {
+        SkRasterClip rc(bounds);
+        rc.op(path, matrix, bounds, SkRegion::kIntersect_Op, true);
+        REPORTER_ASSERT(reporter, rc.isAA());
+        REPORTER_ASSERT(reporter, rc.aaRgn() == expected.aaRgn());
+    }
+
+    // A different matrix must not pick up the earlier result.
+    matrix.postTranslate(3, 0);
+    SkRasterClip moved(bounds);
+    moved.op(path, matrix, bounds, SkRegion::kIntersect_Op, true);
+    REPORTER_ASSERT(reporter, moved.getBounds() != expected.getBounds());
+}
+
 DEF_TEST(AAClip, reporter) {
     test_empty(reporter);
     test_path_bounds(reporter);
@@ -440,4 +473,5 @@ DEF_TEST(AAClip, reporter) {
     test_really_a_rect(reporter);
     test_crbug_422693(reporter);
     test_huge(reporter);
+    test_repeated_path_clip(reporter);
 }
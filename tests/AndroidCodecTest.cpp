@@ -295,3 +295,111 @@ DEF_TEST(AndroidCodec_sampledOrientation, r) {
         ERRORF(r, "got result \"%s\"\n", SkCodec::ResultToString(result));
     }
 }
+
+DEF_TEST(AndroidCodec_decodeRegion, r) {
+    if (GetResourcePath().isEmpty()) {
+        return;
+    }
+
+    for (const char* file : { "images/mandrill_512_q075.jpg",
+                              "images/dog.jpg",
+                              "images/color_wheel.png",
+                              "images/yellow_rose.png",
+                              }) {
+        auto data = GetResourceAsData(file);
+        if (!data) {
+            ERRORF(r, "Could not get %s", file);
+            continue;
+        }
+
+        auto codec = SkAndroidCodec::MakeFromCodec(SkCodec::MakeFromData(data));
+        if (!codec) {
+            ERRORF(r, "Could not create codec for %s", file);
+            continue;
+        }
+
+        const auto dims = codec->getInfo().dimensions();
+        const SkIRect subsets[] = {
+            SkIRect::MakeSize(dims),
+            SkIRect::MakeXYWH(dims.width() / 4, dims.height() / 3,
+                              dims.width() / 2, dims.height() / 2),
+            SkIRect::MakeXYWH(dims.width() / 3, 1, dims.width() / 3, dims.height() - 2),
+            SkIRect::MakeXYWH(dims.width() - 20, dims.height() - 31, 20, 31),
+        };
+        for (const SkIRect& subset : subsets) {
+            const SkISize targets[] = {
+                times(subset.size(), .7f), times(subset.size(), .3f), times(subset.size(), .1f),
+                { 1, 1 }, { subset.width(), 1 }, plus(subset.size(), 3),
+            };
+            for (SkISize target : targets) {
+                if (invalid(target)) {
+                    continue;
+                }
+                const SkISize size = codec->getRegionDimensions(subset, target);
+                if (target.width() <= subset.width() && target.height() <= subset.height()) {
+                    REPORTER_ASSERT(r, size.width()  >= target.width() &&
+                                       size.height() >= target.height());
+                } else {
+                    REPORTER_ASSERT(r, size == subset.size());
+                }
+                REPORTER_ASSERT(r, size.width()  <= subset.width() &&
+                                   size.height() <= subset.height());
+
+                SkBitmap bm;
+                bm.allocPixels(codec->getInfo().makeWH(size.width(), size.height()));
+                auto result = codec->decodeRegion(bm.info(), bm.getPixels(), bm.rowBytes(),
+                                                  subset);
+                if (result != SkCodec::kSuccess) {
+                    ERRORF(r, "%s: decodeRegion failed with \"%s\"", file,
+                           SkCodec::ResultToString(result));
+                }
+
+                // Only the dimensions from getRegionDimensions() are supported.
+                auto wrongInfo = bm.info().makeWH(subset.width() + 1, size.height());
+                SkBitmap wrong;
+                wrong.allocPixels(wrongInfo);
+                REPORTER_ASSERT(r, codec->decodeRegion(wrongInfo, wrong.getPixels(),
+                                                       wrong.rowBytes(), subset)
+                                   != SkCodec::kSuccess);
+            }
+        }
+
+        if (codec->getEncodedFormat() != SkEncodedImageFormat::kJPEG) {
+            continue;
+        }
+
+        // DCT scaling can get closer to the target than any sample size.
+        const SkIRect whole = SkIRect::MakeSize(dims);
+        const SkISize scaled = codec->codec()->getScaledDimensions(.75f);
+        REPORTER_ASSERT(r, codec->getRegionDimensions(whole, times(dims, .7f)) == scaled);
+
+        // Decoding all of the image at a DCT scale matches SkCodec's own decode.
+        SkBitmap region, expected;
+        const auto info = codec->getInfo().makeWH(scaled.width(), scaled.height());
+        region.allocPixels(info);
+        expected.allocPixels(info);
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->decodeRegion(
+                info, region.getPixels(), region.rowBytes(), whole));
+        REPORTER_ASSERT(r, SkCodec::kSuccess == SkCodec::MakeFromData(data)->getPixels(
+                info, expected.getPixels(), expected.rowBytes()));
+        REPORTER_ASSERT(r, !memcmp(region.getPixels(), expected.getPixels(),
+                                   region.computeByteSize()));
+
+        // A region at half size matches the equivalent getAndroidPixels() decode.
+        SkIRect subset = SkIRect::MakeXYWH(32, 32, 128, 128);
+        const SkISize half = codec->getRegionDimensions(subset, { 64, 64 });
+        REPORTER_ASSERT(r, half == SkISize::Make(64, 64));
+        const auto halfInfo = codec->getInfo().makeWH(half.width(), half.height());
+        region.allocPixels(halfInfo);
+        expected.allocPixels(halfInfo);
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->decodeRegion(
+                halfInfo, region.getPixels(), region.rowBytes(), subset));
+        SkAndroidCodec::AndroidOptions options;
+        options.fSubset = &subset;
+        options.fSampleSize = 2;
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getAndroidPixels(
+                halfInfo, expected.getPixels(), expected.rowBytes(), &options));
+        REPORTER_ASSERT(r, !memcmp(region.getPixels(), expected.getPixels(),
+                                   region.computeByteSize()));
+    }
+}
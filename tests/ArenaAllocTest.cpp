@@ -6,6 +6,7 @@
  */
 
 #include "SkArenaAlloc.h"
+#include "SkArenaAllocBlockCache.h"
 #include "SkRefCnt.h"
 #include "SkTypes.h"
 #include "Test.h"
@@ -173,3 +174,58 @@ DEF_TEST(ArenaAlloc, r) {
     REPORTER_ASSERT(r, destroyed == 128);
 
 }
+
+DEF_TEST(ArenaAllocBlockCache, r) {
+    SkArenaAllocBlockCache cache;
+    {
+        SkSTArenaAlloc<64> arena(1024);
+        arena.setBlockCache(&cache);
+        arena.makeArrayDefault<char>(256);
+        arena.make<Foo>();
+        REPORTER_ASSERT(r, arena.heapBytes() >= 256);
+        REPORTER_ASSERT(r, cache.count() == 0);
+    }
+    // The arena's heap block is now cached, and the next arena reuses it.
+    REPORTER_ASSERT(r, cache.count() == 1);
+    {
+        SkSTArenaAlloc<64> arena(1024);
+        arena.setBlockCache(&cache);
+        arena.makeArrayDefault<char>(256);
+        REPORTER_ASSERT(r, cache.count() == 0);
+
+        // reset() returns the block and keeps using the cache.
+        arena.reset();
+        REPORTER_ASSERT(r, cache.count() == 1);
+        REPORTER_ASSERT(r, arena.heapBytes() == 0);
+        arena.makeArrayDefault<char>(256);
+        REPORTER_ASSERT(r, cache.count() == 0);
+    }
+    REPORTER_ASSERT(r, cache.count() == 1);
+
+    // Blocks too large to keep go straight back to the heap.
+    {
+        SkArenaAlloc arena(nullptr, 0, SkArenaAllocBlockCache::kMaxBlockSize * 2);
+        arena.setBlockCache(&cache);
+        arena.makeArrayDefault<char>(16);
+    }
+    REPORTER_ASSERT(r, cache.count() == 1);
+
+    cache.purge();
+    REPORTER_ASSERT(r, cache.count() == 0);
+
+    // The hint remembers the largest heap usage it has seen.
+    SkArenaAllocSizeHint hint;
+    REPORTER_ASSERT(r, hint.firstHeapAllocation() == 0);
+    for (size_t size : { 1000, 5000, 2000 }) {
+        SkSTArenaAlloc<64> arena(hint.firstHeapAllocation());
+        arena.makeArrayDefault<char>(size);
+        hint.record(arena);
+    }
+    REPORTER_ASSERT(r, hint.firstHeapAllocation() >= 5000);
+    {
+        // With the hint, one heap block is enough.
+        SkSTArenaAlloc<64> arena(hint.firstHeapAllocation());
+        arena.makeArrayDefault<char>(5000);
+        REPORTER_ASSERT(r, arena.heapBytes() == hint.firstHeapAllocation());
+    }
+}
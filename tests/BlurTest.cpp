@@ -16,6 +16,7 @@
 #include "SkColorPriv.h"
 #include "SkDrawLooper.h"
 #include "SkEmbossMaskFilter.h"
+#include "SkExecutor.h"
 #include "SkFloatBits.h"
 #include "SkImageInfo.h"
 #include "SkLayerDrawLooper.h"
@@ -29,6 +30,7 @@
 #include "SkPerlinNoiseShader.h"
 #include "SkPixmap.h"
 #include "SkPoint.h"
+#include "SkRandom.h"
 #include "SkRRect.h"
 #include "SkRectPriv.h"
 #include "SkRefCnt.h"
@@ -742,3 +744,89 @@ DEF_TEST(zero_blur, reporter) {
     bitmap.extractAlpha(&alpha, &paint, nullptr, &offset);
 }
 
+
+// Blurring a large mask in bands on an executor must match blurring it on one thread exactly.
+DEF_TEST(BlurMaskExecutor, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    for (SkMask::Format format : {SkMask::kA8_Format, SkMask::kARGB32_Format}) {
+        const int bpp = SkMask::kA8_Format == format ? 1 : 4;
+        SkMask src;
+        src.fBounds.set(5, 7, 605, 407);
+        src.fRowBytes = src.fBounds.width() * bpp;
+        src.fFormat = format;
+        src.fImage = SkMask::AllocImage(src.computeImageSize());
+        SkAutoMaskFreeImage srcStorage(src.fImage);
+
+        SkRandom rand;
+        for (size_t i = 0; i < src.computeImageSize(); ++i) {
+            src.fImage[i] = rand.nextBool() ? 0 : SkToU8(rand.nextU());
+        }
+
+        for (SkScalar sigma : {1.5f, 5.0f, 40.0f, 200.0f}) {
+            SkMask serial, banded;
+            SkIPoint serialMargin, bandedMargin;
+            REPORTER_ASSERT(reporter, SkBlurMask::BoxBlur(&serial, src, sigma,
+                                                          kNormal_SkBlurStyle, &serialMargin));
+            REPORTER_ASSERT(reporter, SkBlurMask::BoxBlur(&banded, src, sigma,
+                                                          kNormal_SkBlurStyle, &bandedMargin,
+                                                          executor.get()));
+            SkAutoMaskFreeImage serialStorage(serial.fImage),
+                                bandedStorage(banded.fImage);
+
+            REPORTER_ASSERT(reporter, serialMargin == bandedMargin);
+            REPORTER_ASSERT(reporter, serial.fBounds == banded.fBounds);
+            REPORTER_ASSERT(reporter, serial.fImage && banded.fImage);
+            REPORTER_ASSERT(reporter, serial.fRowBytes == banded.fRowBytes);
+            if (serial.fImage && banded.fImage) {
+                REPORTER_ASSERT(reporter, 0 == memcmp(serial.fImage, banded.fImage,
+                                                      serial.computeImageSize()));
+            }
+        }
+    }
+}
+
+// Sigmas too large to blur directly are blurred on a downsampled mask. The blur should still
+// spread the mask out with the sigma, keep its total coverage, and stay symmetric.
+DEF_TEST(BlurMaskLargeSigma, reporter) {
+    const SkScalar sigma = 300;
+
+    SkMask src;
+    src.fBounds.set(0, 0, 256, 256);
+    src.fRowBytes = src.fBounds.width();
+    src.fFormat = SkMask::kA8_Format;
+    src.fImage = SkMask::AllocImage(src.computeImageSize());
+    SkAutoMaskFreeImage srcStorage(src.fImage);
+    memset(src.fImage, 0xFF, src.computeImageSize());
+
+    SkMask dst;
+    SkIPoint margin;
+    REPORTER_ASSERT(reporter, SkBlurMask::BoxBlur(&dst, src, sigma, kNormal_SkBlurStyle,
+                                                  &margin));
+    SkAutoMaskFreeImage dstStorage(dst.fImage);
+    if (!dst.fImage) {
+        ERRORF(reporter, "Large sigma blur failed.");
+        return;
+    }
+
+    REPORTER_ASSERT(reporter, margin.x() > 2 * sigma && margin.y() == margin.x());
+    REPORTER_ASSERT(reporter, dst.fBounds.width() == src.fBounds.width() + 2 * margin.x());
+
+    const int w = dst.fBounds.width(),
+              h = dst.fBounds.height();
+    double srcSum = 255.0 * src.fBounds.width() * src.fBounds.height(),
+           dstSum = 0;
+    for (int y = 0; y < h; ++y) {
+        const uint8_t* row = dst.getAddr8(dst.fBounds.fLeft, dst.fBounds.fTop + y);
+        const uint8_t* mirror = dst.getAddr8(dst.fBounds.fLeft, dst.fBounds.fBottom - 1 - y);
+        for (int x = 0; x < w; ++x) {
+            dstSum += row[x];
+            REPORTER_ASSERT(reporter, SkTAbs(row[x] - row[w - 1 - x]) <= 1);
+            REPORTER_ASSERT(reporter, SkTAbs(row[x] - mirror[x]) <= 1);
+        }
+    }
+    REPORTER_ASSERT(reporter, SkTAbs(dstSum / srcSum - 1) < 0.05);
+
+    const uint8_t center = *dst.getAddr8(dst.fBounds.fLeft + w / 2, dst.fBounds.fTop + h / 2);
+    REPORTER_ASSERT(reporter, 0 < center && center < 0xFF);
+}
@@ -14,11 +14,13 @@
 #include "SkImageInfo.h"
 #include "SkMakeUnique.h"
 #include "SkRefCnt.h"
+#include "SkTaskGroup.h"
 #include "SkTypes.h"
 #include "SkUtils.h"
 #include "Test.h"
 #include "sk_tool_utils.h"
 
+#include <atomic>
 #include <utility>
 
 class TestImageGenerator : public SkImageGenerator {
@@ -127,3 +129,39 @@ DEF_TEST(Image_NewFromGenerator, r) {
         }
     }
 }
+
+class CountingImageGenerator : public TestImageGenerator {
+public:
+    CountingImageGenerator(skiatest::Reporter* reporter, std::atomic<int>* decodeCount)
+    : INHERITED(kSucceedGetPixels_TestType, reporter), fDecodeCount(decodeCount) {}
+
+protected:
+    bool onGetPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                     const Options& options) override {
+        (*fDecodeCount)++;
+        return this->INHERITED::onGetPixels(info, pixels, rowBytes, options);
+    }
+
+private:
+    std::atomic<int>* const fDecodeCount;
+
+    typedef TestImageGenerator INHERITED;
+};
+
+// Threads that read a lazy image at the same time should share one decode.
+DEF_TEST(Image_NewFromGenerator_DecodeOnce, r) {
+    std::atomic<int> decodeCount{0};
+    sk_sp<SkImage> image(SkImage::MakeFromGenerator(
+            skstd::make_unique<CountingImageGenerator>(r, &decodeCount)));
+    REPORTER_ASSERT(r, image);
+
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(TestImageGenerator::Width(),
+                                                        TestImageGenerator::Height());
+    SkTaskGroup().batch(16, [&](int) {
+        SkBitmap bitmap;
+        bitmap.allocPixels(info);
+        REPORTER_ASSERT(r, image->readPixels(bitmap.pixmap(), 0, 0));
+        REPORTER_ASSERT(r, TestImageGenerator::PMColor() == *bitmap.getAddr32(0, 0));
+    });
+    REPORTER_ASSERT(r, 1 == decodeCount);
+}
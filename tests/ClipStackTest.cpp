@@ -1460,6 +1460,53 @@ static void test_is_rrect_deep_rect_stack(skiatest::Reporter* reporter) {
     REPORTER_ASSERT(reporter, !stack.isRRect(kTargetBounds, &rrect, &isAA));
 }
 
+static void test_single_rrect_deep_stack(skiatest::Reporter* reporter) {
+    static constexpr SkRect kTargetBounds = SkRect::MakeWH(1000, 500);
+    auto nestedRRect = [](int i) {
+        return SkRRect::MakeRectXY(SkRect::MakeLTRB(2 * i, 2 * i + 0.5f, 1000 - 2 * i, 500 - 2 * i),
+                                   4, 4);
+    };
+    SkClipStack stack;
+    for (int i = 0; i <= 100; ++i) {
+        stack.save();
+        if (i % 3) {
+            stack.clipRRect(nestedRRect(i), SkMatrix::I(), SkClipOp::kIntersect, true);
+        } else {
+            // Rects that contain the rrect below them don't change the clip.
+            stack.clipRect(kTargetBounds.makeInset(i / 2, i / 2), SkMatrix::I(),
+                           SkClipOp::kIntersect, false);
+        }
+    }
+    SkRRect rrect;
+    bool isAA;
+    REPORTER_ASSERT(reporter, stack.isSingleRRect(&rrect, &isAA));
+    REPORTER_ASSERT(reporter, rrect == nestedRRect(100) && isAA);
+    // Unlike the walk in isRRect(), the cached answer is not limited in depth.
+    REPORTER_ASSERT(reporter, stack.isRRect(kTargetBounds, &rrect, &isAA));
+    REPORTER_ASSERT(reporter, rrect == nestedRRect(100));
+    REPORTER_ASSERT(reporter, stack.quickContains(SkRect::MakeLTRB(250, 220, 300, 280)));
+    REPORTER_ASSERT(reporter, !stack.quickContains(SkRect::MakeLTRB(190, 220, 300, 280)));
+
+    auto context = GrContext::MakeMock(nullptr);
+    const GrCaps* caps = context->priv().caps();
+    GrReducedClip reduced(stack, kTargetBounds, caps, 0, 1);
+    REPORTER_ASSERT(reporter, reduced.maskElements().isEmpty());
+    REPORTER_ASSERT(reporter, 1 == reduced.numAnalyticFPs());
+    REPORTER_ASSERT(reporter, GrReducedClip::InitialState::kAllIn == reduced.initialState());
+    GrReducedClip reducedToMask(stack, kTargetBounds, caps);
+    REPORTER_ASSERT(reporter, 1 == reducedToMask.maskElements().count());
+    REPORTER_ASSERT(reporter, stack.getTopmostGenID() == reducedToMask.maskGenID());
+
+    // An overlapping rrect makes the clip more complex, and restoring brings the cached rrect back.
+    stack.save();
+    stack.clipRRect(SkRRect::MakeOval(SkRect::MakeLTRB(150, 150, 350, 350)), SkMatrix::I(),
+                    SkClipOp::kIntersect, true);
+    REPORTER_ASSERT(reporter, !stack.isSingleRRect(&rrect, &isAA));
+    stack.restore();
+    REPORTER_ASSERT(reporter, stack.isSingleRRect(&rrect, &isAA));
+    REPORTER_ASSERT(reporter, rrect == nestedRRect(100));
+}
+
 DEF_TEST(ClipStack, reporter) {
     SkClipStack stack;
 
@@ -1513,6 +1560,7 @@ DEF_TEST(ClipStack, reporter) {
     test_reduced_clip_stack_aa(reporter);
     test_tiny_query_bounds_assertion_bug(reporter);
     test_is_rrect_deep_rect_stack(reporter);
+    test_single_rrect_deep_stack(reporter);
 }
 
 //////////////////////////////////////////////////////////////////////////////
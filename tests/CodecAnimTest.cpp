@@ -13,6 +13,8 @@
 #include "SkCodec.h"
 #include "SkCodecAnimation.h"
 #include "SkData.h"
+#include "SkExecutor.h"
+#include "SkImage.h"
 #include "SkImageInfo.h"
 #include "SkMakeUnique.h"
 #include "SkRefCnt.h"
@@ -484,3 +486,41 @@ DEF_TEST(AnimCodecPlayer, r) {
         REPORTER_ASSERT(r, f1->bounds().size() == test.fSize);
     }
 }
+
+// DecodeFrames() on an executor must produce the same frames as decoding them in order.
+DEF_TEST(AnimCodecPlayer_DecodeFrames, r) {
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (const char* file : { "images/required.gif", "images/alphabetAnim.gif",
+                              "images/randPixelsAnim.gif", "images/colorTables.gif",
+                              "images/required.webp", "images/blendBG.webp",
+                              "images/randPixels.png" }) {
+        sk_sp<SkData> data = GetResourceAsData(file);
+        if (!data) {
+            ERRORF(r, "Missing %s", file);
+            continue;
+        }
+
+        auto serial   = SkAnimCodecPlayer::DecodeFrames(data);
+        auto parallel = SkAnimCodecPlayer::DecodeFrames(data, executor.get());
+        REPORTER_ASSERT(r, !serial.empty());
+        REPORTER_ASSERT(r, serial.size() == parallel.size());
+        if (serial.size() != parallel.size()) {
+            continue;
+        }
+
+        for (size_t i = 0; i < serial.size(); i++) {
+            SkPixmap expected, actual;
+            if (!serial[i] || !parallel[i]
+                    || !serial[i]->peekPixels(&expected) || !parallel[i]->peekPixels(&actual)) {
+                ERRORF(r, "%s: frame %zu failed to decode", file, i);
+                continue;
+            }
+            for (int y = 0; y < expected.height(); y++) {
+                if (memcmp(expected.addr(0, y), actual.addr(0, y), expected.info().minRowBytes())) {
+                    ERRORF(r, "%s: frame %zu differs on row %d", file, i, y);
+                    break;
+                }
+            }
+        }
+    }
+}
@@ -13,6 +13,7 @@
 #include "SkData.h"
 #include "SkImageInfo.h"
 #include "SkMakeUnique.h"
+#include "SkRWBuffer.h"
 #include "SkRefCnt.h"
 #include "SkStream.h"
 #include "SkTypes.h"
@@ -135,9 +136,6 @@ static void test_partial(skiatest::Reporter* r, const char* name, size_t minByte
 }
 
 DEF_TEST(Codec_partial, r) {
-#if 0
-    // FIXME (scroggo): SkPngCodec needs to use SkStreamBuffer in order to
-    // support incremental decoding.
     test_partial(r, "images/plane.png");
     test_partial(r, "images/plane_interlaced.png");
     test_partial(r, "images/yellow_rose.png");
@@ -148,10 +146,115 @@ DEF_TEST(Codec_partial, r) {
     test_partial(r, "images/arrow.png");
     test_partial(r, "images/randPixels.png");
     test_partial(r, "images/baby_tux.png");
-#endif
     test_partial(r, "images/box.gif");
     test_partial(r, "images/randPixels.gif", 215);
     test_partial(r, "images/color_wheel.gif");
+    test_partial(r, "images/mandrill_512_q075.jpg");
+    test_partial(r, "images/CMYK.jpg");
+    // Progressive
+    test_partial(r, "images/brickwork-texture.jpg");
+    test_partial(r, "images/flutter_logo.jpg");
+    test_partial(r, "images/grayscale.jpg");
+}
+
+// Decodes with a single codec while the file arrives in an SkRWBuffer, the way a client
+// decodes an image that is still downloading.
+static void test_partial_rwbuffer(skiatest::Reporter* r, const char* name) {
+    sk_sp<SkData> file = GetResourceAsData(name);
+    if (!file) {
+        SkDebugf("missing resource %s\n", name);
+        return;
+    }
+    SkBitmap truth;
+    if (!create_truth(file, &truth)) {
+        ERRORF(r, "Failed to decode %s\n", name);
+        return;
+    }
+
+    constexpr size_t kIncrement = 1000;
+    SkRWBuffer buffer;
+    size_t appended = 0;
+    auto appendMore = [&] {
+        size_t length = SkTMin(kIncrement, file->size() - appended);
+        buffer.append(file->bytes() + appended, length);
+        appended += length;
+    };
+
+    // Until the header arrives, each attempt needs a stream of its own.
+    std::unique_ptr<SkCodec> codec;
+    while (!codec) {
+        if (appended == file->size()) {
+            ERRORF(r, "Failed to create codec for %s", name);
+            return;
+        }
+        appendMore();
+        codec = SkCodec::MakeFromStream(buffer.makeGrowingStream());
+    }
+
+    const SkImageInfo info = standardize_info(codec.get());
+    SkBitmap incremental;
+    incremental.allocPixels(info);
+    while (SkCodec::kSuccess != codec->startIncrementalDecode(info, incremental.getPixels(),
+                                                              incremental.rowBytes())) {
+        if (appended == file->size()) {
+            ERRORF(r, "Failed to start incremental decode of %s", name);
+            return;
+        }
+        appendMore();
+    }
+
+    while (true) {
+        const SkCodec::Result result = codec->incrementalDecode();
+        if (result == SkCodec::kSuccess) {
+            break;
+        }
+        REPORTER_ASSERT(r, result == SkCodec::kIncompleteInput);
+        if (appended == file->size()) {
+            ERRORF(r, "Failed to completely decode %s", name);
+            return;
+        }
+        appendMore();
+    }
+
+    compare_bitmaps(r, truth, incremental);
+}
+
+DEF_TEST(Codec_partialRWBuffer, r) {
+    test_partial_rwbuffer(r, "images/plane.png");
+    test_partial_rwbuffer(r, "images/plane_interlaced.png");
+    test_partial_rwbuffer(r, "images/index8.png");
+    test_partial_rwbuffer(r, "images/randPixels.png");
+    test_partial_rwbuffer(r, "images/box.gif");
+    test_partial_rwbuffer(r, "images/color_wheel.gif");
+    test_partial_rwbuffer(r, "images/mandrill_512_q075.jpg");
+    test_partial_rwbuffer(r, "images/brickwork-texture.jpg");
+}
+
+// Each scan of a progressive jpeg writes a complete, coarser image before the file has arrived.
+DEF_TEST(Codec_partialProgressiveJpeg, r) {
+    sk_sp<SkData> file = GetResourceAsData("images/brickwork-texture.jpg");
+    if (!file) {
+        SkDebugf("missing resource images/brickwork-texture.jpg\n");
+        return;
+    }
+
+    HaltingStream* stream = new HaltingStream(file, file->size() / 4);
+    auto codec = SkCodec::MakeFromStream(std::unique_ptr<SkStream>(stream));
+    if (!codec) {
+        ERRORF(r, "Failed to create codec");
+        return;
+    }
+    const SkImageInfo info = standardize_info(codec.get());
+    SkBitmap bm;
+    bm.allocPixels(info);
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->startIncrementalDecode(info, bm.getPixels(),
+                                                                          bm.rowBytes()));
+    int rowsDecoded = 0;
+    REPORTER_ASSERT(r, SkCodec::kIncompleteInput == codec->incrementalDecode(&rowsDecoded));
+    REPORTER_ASSERT(r, rowsDecoded == info.height());
+
+    stream->addNewData(file->size());
+    REPORTER_ASSERT(r, SkCodec::kSuccess == codec->incrementalDecode());
 }
 
 DEF_TEST(Codec_partialWuffs, r) {
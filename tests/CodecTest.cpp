@@ -18,10 +18,13 @@
 #include "SkColorSpacePriv.h"
 #include "SkData.h"
 #include "SkEncodedImageFormat.h"
+#include "SkExecutor.h"
 #include "SkFrontBufferedStream.h"
+#include "SkHardwareJpeg.h"
 #include "SkImage.h"
 #include "SkImageGenerator.h"
 #include "SkImageInfo.h"
+#include "SkJpegCodec.h"
 #include "SkJpegEncoder.h"
 #include "SkMD5.h"
 #include "SkMakeUnique.h"
@@ -1184,7 +1187,7 @@ static void test_conversion_possible(skiatest::Reporter* r, const char* path,
 
 DEF_TEST(Codec_F16ConversionPossible, r) {
     test_conversion_possible(r, "images/color_wheel.webp", false, false);
-    test_conversion_possible(r, "images/mandrill_512_q075.jpg", true, false);
+    test_conversion_possible(r, "images/mandrill_512_q075.jpg", true, true);
     test_conversion_possible(r, "images/yellow_rose.png", false, true);
 }
 
@@ -1285,7 +1288,6 @@ DEF_TEST(Codec_fallBack, r) {
 
     // Formats that currently do not support incremental decoding
     auto files = {
-            "images/CMYK.jpg",
             "images/color_wheel.ico",
             "images/mandrill.wbmp",
             "images/randPixels.bmp",
@@ -1809,3 +1811,136 @@ DEF_TEST(Codec_crbug807324, r) {
         }
     }
 }
+
+// Decoding restart-interval stripes on an executor must match the serial decode exactly.
+DEF_TEST(Codec_jpeg_restart_stripes, r) {
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (const char* path : { "images/icc-v2-gbr.jpg", "images/mandrill_cmyk.jpg" }) {
+        sk_sp<SkData> data = GetResourceAsData(path);
+        if (!data) {
+            continue;
+        }
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+        REPORTER_ASSERT(r, codec);
+        if (!codec) {
+            continue;
+        }
+
+        for (float scale : { 1.0f, 0.5f, 0.375f }) {
+            SkISize size = codec->getScaledDimensions(scale);
+            auto info = codec->getInfo().makeWH(size.width(), size.height())
+                                        .makeColorType(kN32_SkColorType);
+            SkBitmap serial, parallel;
+            serial.allocPixels(info);
+            parallel.allocPixels(info);
+
+            REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                               codec->getPixels(info, serial.getPixels(), serial.rowBytes()));
+
+            SkCodec::Options options;
+            options.fExecutor = executor.get();
+            REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(info, parallel.getPixels(),
+                                                                     parallel.rowBytes(),
+                                                                     &options));
+
+            for (int y = 0; y < info.height(); ++y) {
+                if (0 != memcmp(serial.getAddr(0, y), parallel.getAddr(0, y),
+                                info.minRowBytes())) {
+                    ERRORF(r, "%s at scale %g differs on row %d", path, scale, y);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// Pipelining PNG rows through an executor must match the serial decode exactly, for both
+// getPixels() and incremental decodes of a subset.
+DEF_TEST(Codec_png_executor, r) {
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (const char* path : { "images/mandrill_512.png", "images/yellow_rose.png",
+                              "images/plane_interlaced.png" }) {
+        sk_sp<SkData> data = GetResourceAsData(path);
+        if (!data) {
+            continue;
+        }
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+        REPORTER_ASSERT(r, codec);
+        if (!codec) {
+            continue;
+        }
+
+        auto info = codec->getInfo().makeColorType(kN32_SkColorType)
+                                    .makeAlphaType(kPremul_SkAlphaType);
+        const SkIRect subset = SkIRect::MakeLTRB(0, info.height() / 5,
+                                                 info.width(), info.height() * 4 / 5);
+        for (bool incremental : { false, true }) {
+            SkBitmap serial, parallel;
+            serial.allocPixels(info);
+            parallel.allocPixels(info);
+            serial.eraseColor(SK_ColorTRANSPARENT);
+            parallel.eraseColor(SK_ColorTRANSPARENT);
+
+            SkCodec::Options options;
+            if (incremental) {
+                options.fSubset = &subset;
+            }
+            for (SkBitmap* bm : { &serial, &parallel }) {
+                if (bm == &parallel) {
+                    options.fExecutor = executor.get();
+                }
+                SkCodec::Result result;
+                if (incremental) {
+                    result = codec->startIncrementalDecode(info, bm->getPixels(), bm->rowBytes(),
+                                                           &options);
+                    if (SkCodec::kSuccess == result) {
+                        result = codec->incrementalDecode();
+                    }
+                } else {
+                    result = codec->getPixels(info, bm->getPixels(), bm->rowBytes(), &options);
+                }
+                REPORTER_ASSERT(r, SkCodec::kSuccess == result);
+            }
+
+            for (int y = 0; y < info.height(); ++y) {
+                if (0 != memcmp(serial.getAddr(0, y), parallel.getAddr(0, y),
+                                info.minRowBytes())) {
+                    ERRORF(r, "%s (%s) differs on row %d", path,
+                           incremental ? "incremental" : "getPixels", y);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+DEF_TEST(Codec_jpegHardwareEligibility, r) {
+    struct {
+        const char* path;
+        bool        baselineYCbCr;
+    } recs[] = {
+        { "images/mandrill_512_q075.jpg", true  },
+        { "images/mandrill_h2v1.jpg",     true  },
+        { "images/grayscale.jpg",         false },
+        { "images/CMYK.jpg",              false },
+    };
+    for (const auto& rec : recs) {
+        auto data = GetResourceAsData(rec.path);
+        if (!data) {
+            continue;
+        }
+        auto codec = SkCodec::MakeFromData(data);
+        if (!codec || SkEncodedImageFormat::kJPEG != codec->getEncodedFormat()) {
+            ERRORF(r, "failed to create a jpeg codec for %s", rec.path);
+            continue;
+        }
+        REPORTER_ASSERT(r, rec.baselineYCbCr ==
+                           static_cast<SkJpegCodec*>(codec.get())->isBaselineYCbCr(), rec.path);
+
+        // These are all too small to be worth a hardware decode, so they stay on the CPU.
+        REPORTER_ASSERT(r, !SkHardwareJpeg::MakeGenerator(data), rec.path);
+    }
+
+    REPORTER_ASSERT(r, !SkHardwareJpeg::MakeGenerator(nullptr));
+    REPORTER_ASSERT(r, !SkHardwareJpeg::MakeGenerator(GetResourceAsData("images/mandrill_128.png")));
+}
@@ -6,10 +6,15 @@
  */
 
 #include "Resources.h"
+#include "SkBitmap.h"
 #include "SkCodec.h"
+#include "SkColorFilter.h"
 #include "SkColorSpace.h"
 #include "SkColorSpacePriv.h"
+#include "SkColorSpaceXformer.h"
 #include "SkData.h"
+#include "SkGradientShader.h"
+#include "SkImage.h"
 #include "SkImageInfo.h"
 #include "SkRefCnt.h"
 #include "SkStream.h"
@@ -333,3 +338,40 @@ DEF_TEST(ColorSpace_skcms_sRGB_exact, r) {
 
     REPORTER_ASSERT(r, 0 == memcmp(&profile, skcms_sRGB_profile(), sizeof(skcms_ICCProfile)));
 }
+
+DEF_TEST(ColorSpaceXformer_Caching, r) {
+    auto p3 = SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB, SkNamedGamut::kDCIP3);
+    auto xformer = SkColorSpaceXformer::Make(p3);
+
+    // Objects reused across draws are only transformed once.
+    SkColor colors[] = { SK_ColorRED, SK_ColorBLUE };
+    SkPoint pts[] = { {0, 0}, {10, 10} };
+    auto shader = SkGradientShader::MakeLinear(pts, colors, nullptr, 2, SkShader::kClamp_TileMode);
+    auto filter = SkColorFilter::MakeModeFilter(SK_ColorGREEN, SkBlendMode::kSrcOver);
+    auto xformedShader = xformer->apply(shader.get());
+    auto xformedFilter = xformer->apply(filter.get());
+    REPORTER_ASSERT(r, xformedShader && xformedShader != shader);
+    REPORTER_ASSERT(r, xformedFilter && xformedFilter != filter);
+    REPORTER_ASSERT(r, xformer->apply(shader.get()) == xformedShader);
+    REPORTER_ASSERT(r, xformer->apply(filter.get()) == xformedFilter);
+
+    // Raster images are converted only when their pixels are read.
+    SkBitmap bm;
+    bm.allocN32Pixels(4, 4);
+    bm.eraseColor(SK_ColorRED);
+    bm.setImmutable();
+    auto image = SkImage::MakeFromBitmap(bm);
+    auto xformedImage = xformer->apply(image.get());
+    REPORTER_ASSERT(r, xformedImage && xformedImage->isLazyGenerated());
+    REPORTER_ASSERT(r, SkColorSpace::Equals(xformedImage->colorSpace(), p3.get()));
+    REPORTER_ASSERT(r, xformer->apply(image.get()) == xformedImage);
+
+    SkBitmap expected, actual;
+    expected.allocPixels(SkImageInfo::MakeN32Premul(4, 4, p3));
+    actual.allocPixels(SkImageInfo::MakeN32Premul(4, 4, p3));
+    REPORTER_ASSERT(r, image->readPixels(expected.pixmap(), 0, 0));
+    REPORTER_ASSERT(r, xformedImage->readPixels(actual.pixmap(), 0, 0));
+    REPORTER_ASSERT(r, !memcmp(expected.getPixels(), actual.getPixels(),
+                               expected.computeByteSize()));
+    REPORTER_ASSERT(r, actual.getColor(0, 0) != SK_ColorRED);
+}
@@ -352,3 +352,42 @@ DEF_TEST(RWBuffer_noAppend, r) {
         REPORTER_ASSERT(r, stream->skip(10) == 0);
     }
 }
+
+// Tests that a growing stream sees bytes appended after it was made, including while another
+// thread is reading it.
+DEF_TEST(RWBuffer_growingStream, r) {
+    const size_t kSize = 1000 * 26;
+    SkRWBuffer buffer;
+    // Made before anything is appended.
+    std::unique_ptr<SkStreamRewindable> stream = buffer.makeGrowingStream();
+    REPORTER_ASSERT(r, stream->isAtEnd());
+    REPORTER_ASSERT(r, stream->read(nullptr, 10) == 0);
+
+    SkTaskGroup tasks;
+    tasks.add([r, &stream, kSize] {
+        SkAutoTMalloc<char> storage(kSize);
+        size_t bytesRead = 0;
+        while (bytesRead < kSize) {
+            // Reads only what has arrived, so this spins until the writer catches up.
+            bytesRead += stream->read(storage.get() + bytesRead, kSize - bytesRead);
+        }
+        check_abcs(r, storage.get(), bytesRead);
+    });
+    for (size_t i = 0; i < kSize; i += 26) {
+        buffer.append(gABC, 26);
+    }
+    tasks.wait();
+    REPORTER_ASSERT(r, stream->isAtEnd());
+
+    // Peeking does not move the stream, and rewinding or duplicating starts over.
+    buffer.append(gABC, 26);
+    char abc[26];
+    REPORTER_ASSERT(r, stream->peek(abc, 26) == 26);
+    check_abcs(r, abc, 26);
+    REPORTER_ASSERT(r, stream->getPosition() == kSize);
+    std::unique_ptr<SkStreamRewindable> duplicate = stream->duplicate();
+    REPORTER_ASSERT(r, duplicate->getPosition() == 0);
+    REPORTER_ASSERT(r, stream->rewind());
+    REPORTER_ASSERT(r, stream->skip(kSize + 26) == kSize + 26);
+    REPORTER_ASSERT(r, stream->isAtEnd());
+}
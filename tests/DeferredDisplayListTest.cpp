@@ -22,15 +22,20 @@
 #include "GrTypesPriv.h"
 #include "SkBitmap.h"
 #include "SkCanvas.h"
+#include "SkDDLTiledRenderer.h"
 #include "SkColorSpace.h"
 #include "SkDeferredDisplayList.h"
 #include "SkDeferredDisplayListPriv.h"
 #include "SkDeferredDisplayListRecorder.h"
+#include "SkExecutor.h"
+#include "SkFont.h"
 #include "SkGpuDevice.h"
 #include "SkImage.h"
 #include "SkImageInfo.h"
 #include "SkImage_Gpu.h"
 #include "SkPaint.h"
+#include "SkPicture.h"
+#include "SkPictureRecorder.h"
 #include "SkPromiseImageTexture.h"
 #include "SkRect.h"
 #include "SkRefCnt.h"
@@ -851,3 +856,123 @@ DEF_GPUTEST_FOR_GL_RENDERING_CONTEXTS(DDLCompatibilityTest, reporter, ctxInfo) {
     }
 
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// Check that SkDDLTiledRenderer's tiles, recorded on several threads and sharing one upload of
+// each image, add up to the same picture drawn directly.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(DDLTiledRenderer, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+
+    SkImageInfo ii = SkImageInfo::MakeN32Premul(200, 150);
+    sk_sp<SkSurface> direct = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, ii);
+    sk_sp<SkSurface> tiled  = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, ii);
+    if (!direct || !tiled) {
+        return;
+    }
+
+    SkBitmap checker;
+    checker.allocPixels(SkImageInfo::MakeN32Premul(16, 16));
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            *checker.getAddr32(x, y) = ((x ^ y) & 4) ? 0xFF0000FF : 0xFF00FF00;
+        }
+    }
+    checker.setImmutable();
+    sk_sp<SkImage> image = SkImage::MakeFromBitmap(checker);
+
+    SkPictureRecorder pictureRecorder;
+    SkCanvas* canvas = pictureRecorder.beginRecording(200, 150);
+    canvas->clear(SK_ColorWHITE);
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeXYWH(50, 40, 100, 70), paint);
+    for (int y = 0; y < 150; y += 37) {
+        for (int x = 0; x < 200; x += 37) {
+            canvas->drawImage(image, x, y);
+        }
+    }
+    sk_sp<SkPicture> picture = pictureRecorder.finishRecordingAsPicture();
+
+    SkSurfaceCharacterization characterization;
+    SkAssertResult(tiled->characterize(&characterization));
+
+    SkDDLTiledRenderer renderer(characterization, 64);
+    REPORTER_ASSERT(reporter, 12 == renderer.numTiles());
+    REPORTER_ASSERT(reporter, SkIRect::MakeXYWH(192, 128, 8, 22) == renderer.tile(11));
+
+    REPORTER_ASSERT(reporter, !renderer.record(nullptr, picture.get(), nullptr));
+    REPORTER_ASSERT(reporter, !renderer.draw(tiled.get()));
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    REPORTER_ASSERT(reporter, renderer.record(context, picture.get(), executor.get()));
+    REPORTER_ASSERT(reporter, renderer.draw(tiled.get()));
+    direct->getCanvas()->drawPicture(picture);
+
+    SkBitmap expected, actual;
+    expected.allocPixels(ii);
+    actual.allocPixels(ii);
+    REPORTER_ASSERT(reporter, direct->readPixels(expected, 0, 0));
+    REPORTER_ASSERT(reporter, tiled->readPixels(actual, 0, 0));
+    for (int y = 0; y < ii.height(); ++y) {
+        if (0 != memcmp(expected.getAddr(0, y), actual.getAddr(0, y), ii.minRowBytes())) {
+            ERRORF(reporter, "tiled DDLs differ from the picture on row %d", y);
+            break;
+        }
+    }
+
+    renderer.reset();
+    REPORTER_ASSERT(reporter, !renderer.draw(tiled.get()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Check that text recorded into a DDL, whose glyph images are captured while recording and only
+// added to the atlas at replay, draws the same as text drawn directly.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(DDLText, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+
+    SkImageInfo ii = SkImageInfo::MakeN32Premul(200, 100);
+    sk_sp<SkSurface> direct = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, ii);
+    sk_sp<SkSurface> ddl    = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, ii);
+    if (!direct || !ddl) {
+        return;
+    }
+
+    auto draw = [](SkCanvas* canvas) {
+        canvas->clear(SK_ColorWHITE);
+        SkPaint paint;
+        SkFont font;
+        font.setSize(20);
+        canvas->drawString("Hamburgefons", 10, 30, font, paint);
+        font.setEdging(SkFont::Edging::kAlias);
+        paint.setColor(SK_ColorBLUE);
+        canvas->drawString("Hamburgefons", 10, 60, font, paint);
+        // Large enough to be drawn as distance fields, where they're supported.
+        font.setSize(80);
+        font.setEdging(SkFont::Edging::kAntiAlias);
+        canvas->save();
+        canvas->scale(0.5f, 0.5f);
+        canvas->drawString("Ham", 10, 190, font, paint);
+        canvas->restore();
+    };
+
+    SkSurfaceCharacterization characterization;
+    SkAssertResult(ddl->characterize(&characterization));
+
+    SkDeferredDisplayListRecorder recorder(characterization);
+    draw(recorder.getCanvas());
+    std::unique_ptr<SkDeferredDisplayList> displayList = recorder.detach();
+    REPORTER_ASSERT(reporter, ddl->draw(displayList.get()));
+    draw(direct->getCanvas());
+
+    SkBitmap expected, actual;
+    expected.allocPixels(ii);
+    actual.allocPixels(ii);
+    REPORTER_ASSERT(reporter, direct->readPixels(expected, 0, 0));
+    REPORTER_ASSERT(reporter, ddl->readPixels(actual, 0, 0));
+    for (int y = 0; y < ii.height(); ++y) {
+        if (0 != memcmp(expected.getAddr(0, y), actual.getAddr(0, y), ii.minRowBytes())) {
+            ERRORF(reporter, "text drawn from a DDL differs on row %d", y);
+            break;
+        }
+    }
+}
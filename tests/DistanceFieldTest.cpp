@@ -0,0 +1,125 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTypes.h"
+
+#if SK_SUPPORT_GPU
+
+#include "GrDistanceFieldGenFromVector.h"
+#include "SkDistanceFieldGen.h"
+#include "SkPath.h"
+#include "Test.h"
+
+#include <vector>
+
+static int median(const unsigned char texel[4]) {
+    return SkTMax(SkTMin(texel[0], texel[1]), SkTMin(SkTMax(texel[0], texel[1]), texel[2]));
+}
+
+// Bilinearly samples the median of a multi-channel field, or a single-channel field, the same way
+// the distance field shaders do.
+static float sample(const std::vector<unsigned char>& field, int width, int height, int bpp,
+                    float x, float y) {
+    x -= 0.5f;
+    y -= 0.5f;
+    int x0 = SkScalarFloorToInt(x);
+    int y0 = SkScalarFloorToInt(y);
+    float fx = x - x0;
+    float fy = y - y0;
+    float channels[3];
+    for (int c = 0; c < SkTMin(bpp, 3); ++c) {
+        auto texel = [&](int tx, int ty) {
+            tx = SkTPin(tx, 0, width - 1);
+            ty = SkTPin(ty, 0, height - 1);
+            return (float)field[(ty * width + tx) * bpp + c];
+        };
+        channels[c] = (texel(x0, y0) * (1 - fx) + texel(x0 + 1, y0) * fx) * (1 - fy) +
+                      (texel(x0, y0 + 1) * (1 - fx) + texel(x0 + 1, y0 + 1) * fx) * fy;
+    }
+    if (1 == bpp) {
+        return channels[0];
+    }
+    return SkTMax(SkTMin(channels[0], channels[1]),
+                  SkTMin(SkTMax(channels[0], channels[1]), channels[2]));
+}
+
+static void test_path(skiatest::Reporter* reporter, const SkPath& path, bool hasCorners) {
+    const SkRect bounds = path.getBounds();
+    const int width = SkScalarCeilToInt(bounds.width()) + 2 * SK_DistanceFieldPad;
+    const int height = SkScalarCeilToInt(bounds.height()) + 2 * SK_DistanceFieldPad;
+    const SkMatrix matrix = SkMatrix::MakeTrans(-bounds.fLeft, -bounds.fTop);
+
+    std::vector<unsigned char> msdf(width * height * 4);
+    std::vector<unsigned char> sdf(width * height);
+    REPORTER_ASSERT(reporter, GrGenerateMultiChannelDistanceFieldFromPath(
+            msdf.data(), path, matrix, width, height, width * 4));
+    REPORTER_ASSERT(reporter, GrGenerateDistanceFieldFromPath(
+            sdf.data(), path, matrix, width, height, width));
+
+    SkPath fieldPath;
+    path.transform(matrix, &fieldPath);
+    fieldPath.offset(SK_DistanceFieldPad, SK_DistanceFieldPad);
+
+    int channelsDiffer = 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const unsigned char* texel = &msdf[(y * width + x) * 4];
+            // The median agrees with the path about which texels are inside.
+            bool inside = fieldPath.contains(x + 0.5f, y + 0.5f);
+            REPORTER_ASSERT(reporter, inside == (median(texel) >= 128));
+            // The alpha channel is the ordinary distance field.
+            REPORTER_ASSERT(reporter, SkTAbs(texel[3] - sdf[y * width + x]) <= 8);
+            channelsDiffer += texel[0] != texel[1] || texel[1] != texel[2];
+        }
+    }
+    REPORTER_ASSERT(reporter, hasCorners == (channelsDiffer > 0));
+
+    // Magnified, the multi-channel field reproduces the shape at least as well as one channel.
+    int msdfErrors = 0;
+    int sdfErrors = 0;
+    for (float y = 0; y < height; y += 0.125f) {
+        for (float x = 0; x < width; x += 0.125f) {
+            bool inside = fieldPath.contains(x, y);
+            msdfErrors += inside != (sample(msdf, width, height, 4, x, y) >= 128);
+            sdfErrors += inside != (sample(sdf, width, height, 1, x, y) >= 128);
+        }
+    }
+    REPORTER_ASSERT(reporter, msdfErrors <= sdfErrors);
+    if (hasCorners) {
+        REPORTER_ASSERT(reporter, msdfErrors < sdfErrors);
+    }
+}
+
+DEF_TEST(MultiChannelDistanceField, reporter) {
+    SkPath square;
+    square.addRect(SkRect::MakeXYWH(10, 10, 20, 20));
+    test_path(reporter, square, true);
+
+    SkPath reversed;
+    reversed.addRect(SkRect::MakeXYWH(10, 10, 20, 20), SkPath::kCCW_Direction);
+    test_path(reporter, reversed, true);
+
+    SkPath triangle;
+    triangle.moveTo(0, 20);
+    triangle.lineTo(10, 0);
+    triangle.lineTo(20, 20);
+    triangle.close();
+    test_path(reporter, triangle, true);
+
+    SkPath frame;
+    frame.addRect(SkRect::MakeWH(24, 24));
+    frame.addRect(SkRect::MakeXYWH(6, 6, 12, 12));
+    frame.setFillType(SkPath::kEvenOdd_FillType);
+    test_path(reporter, frame, true);
+
+    // A smooth outline has no corners, so every channel is the same.
+    SkPath circle;
+    circle.addCircle(15, 15, 15);
+    test_path(reporter, circle, false);
+}
+
+#endif
@@ -176,6 +176,77 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(BasicDrawOpAtlas, reporter, ctxInfo) {
     check(reporter, atlas.get(), 1, 4, 1);
 }
 
+// Verifies that an atlas can grow past the default page count, and that once it is full it evicts
+// the plot whose last use is oldest rather than the first page's.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(DrawOpAtlasManyPages, reporter, ctxInfo) {
+    static constexpr int kMaxPages = 8;
+    static constexpr int kPlotsPerPage = kNumPlots * kNumPlots;
+    static constexpr int kStalePage = 5;
+
+    auto context = ctxInfo.grContext();
+    auto proxyProvider = context->priv().proxyProvider();
+    auto resourceProvider = context->priv().resourceProvider();
+    TestingUploadTarget uploadTarget;
+
+    GrBackendFormat format =
+            context->priv().caps()->getBackendFormatFromColorType(kAlpha_8_SkColorType);
+
+    std::unique_ptr<GrDrawOpAtlas> atlas = GrDrawOpAtlas::Make(
+                                                proxyProvider,
+                                                format,
+                                                kAlpha_8_GrPixelConfig,
+                                                kAtlasSize, kAtlasSize,
+                                                kAtlasSize/kNumPlots, kAtlasSize/kNumPlots,
+                                                GrDrawOpAtlas::AllowMultitexturing::kYes,
+                                                EvictionFunc, nullptr, kMaxPages);
+    check(reporter, atlas.get(), 0, kMaxPages, 0);
+
+    GrDrawOpAtlas::AtlasID atlasIDs[kMaxPages * kPlotsPerPage];
+    for (int i = 0; i < kMaxPages * kPlotsPerPage; ++i) {
+        bool result = fill_plot(atlas.get(), resourceProvider, &uploadTarget, &atlasIDs[i], i);
+        REPORTER_ASSERT(reporter, result);
+        REPORTER_ASSERT(reporter, GrDrawOpAtlas::GetPageIndexFromID(atlasIDs[i]) ==
+                                  (uint32_t)(i / kPlotsPerPage));
+    }
+    check(reporter, atlas.get(), kMaxPages, kMaxPages, kMaxPages);
+
+    // Use the stale page in one draw and every other page in a later one, then flush both.
+    for (int i = 0; i < kMaxPages * kPlotsPerPage; ++i) {
+        if (i / kPlotsPerPage == kStalePage) {
+            atlas->setLastUseToken(atlasIDs[i], uploadTarget.tokenTracker()->nextDrawToken());
+        }
+    }
+    uploadTarget.issueDrawToken();
+    for (int i = 0; i < kMaxPages * kPlotsPerPage; ++i) {
+        if (i / kPlotsPerPage != kStalePage) {
+            atlas->setLastUseToken(atlasIDs[i], uploadTarget.tokenTracker()->nextDrawToken());
+        }
+    }
+    uploadTarget.issueDrawToken();
+    uploadTarget.flushToken();
+    uploadTarget.flushToken();
+
+    GrDrawOpAtlas::AtlasID atlasID;
+    bool result = fill_plot(atlas.get(), resourceProvider, &uploadTarget, &atlasID, 255);
+    REPORTER_ASSERT(reporter, result);
+    REPORTER_ASSERT(reporter, GrDrawOpAtlas::GetPageIndexFromID(atlasID) == kStalePage);
+    check(reporter, atlas.get(), kMaxPages, kMaxPages, kMaxPages);
+}
+
+DEF_TEST(DrawOpAtlas_PageIndexPacking, reporter) {
+    for (uint32_t page = 0; page < GrDrawOpAtlas::kMaxPages; ++page) {
+        for (int texel : {0, 1, 255, 2047, 2048}) {
+            uint16_t u = GrDrawOpAtlas::PackU(texel, page);
+            uint16_t v = GrDrawOpAtlas::PackV(texel, page);
+            REPORTER_ASSERT(reporter, GrDrawOpAtlas::UnpackTexel(u) == texel);
+            REPORTER_ASSERT(reporter, GrDrawOpAtlas::UnpackTexel(v) == texel);
+            uint32_t unpacked = GrDrawOpAtlas::UnpackPageBits(u) << GrDrawOpAtlas::kPageIndexBits |
+                                GrDrawOpAtlas::UnpackPageBits(v);
+            REPORTER_ASSERT(reporter, unpacked == page);
+        }
+    }
+}
+
 // This test verifies that the GrAtlasTextOp::onPrepare method correctly handles a failure
 // when allocating an atlas page.
 DEF_GPUTEST_FOR_RENDERING_CONTEXTS(GrAtlasTextOpPreparation, reporter, ctxInfo) {
@@ -9,10 +9,14 @@
 #include "Test.h"
 
 #include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkCodec.h"
 #include "SkColorPriv.h"
 #include "SkEncodedImageFormat.h"
+#include "SkExecutor.h"
 #include "SkImage.h"
 #include "SkJpegEncoder.h"
+#include "SkPictureRecorder.h"
 #include "SkPngEncoder.h"
 #include "SkStream.h"
 #include "SkWebpEncoder.h"
@@ -99,6 +103,92 @@ DEF_TEST(Encode, r) {
     test_encode(r, SkEncodedImageFormat::kPNG);
 }
 
+// Rasterizes a picture a strip at a time, as if it were too big to draw all at once.
+class PictureRowSource : public SkEncoder::RowSource {
+public:
+    PictureRowSource(sk_sp<SkPicture> picture) : fPicture(std::move(picture)) {}
+
+    bool readRows(int y, const SkPixmap& dst) override {
+        if (y != fNextRow) {
+            return false;
+        }
+        fNextRow += dst.height();
+        fMaxRows = SkTMax(fMaxRows, dst.height());
+
+        auto canvas = SkCanvas::MakeRasterDirect(dst.info(), dst.writable_addr(), dst.rowBytes());
+        canvas->translate(0, -SkIntToScalar(y));
+        canvas->drawPicture(fPicture);
+        return fNextRow <= fFailAfter;
+    }
+
+    int fNextRow   = 0;
+    int fMaxRows   = 0;
+    int fFailAfter = SK_MaxS32;
+
+private:
+    sk_sp<SkPicture> fPicture;
+};
+
+static std::unique_ptr<SkEncoder> make(SkEncodedImageFormat format, SkWStream* dst,
+                                       const SkImageInfo& info, SkEncoder::RowSource* source) {
+    switch (format) {
+        case SkEncodedImageFormat::kJPEG:
+            return SkJpegEncoder::Make(dst, info, source, SkJpegEncoder::Options());
+        case SkEncodedImageFormat::kPNG:
+            return SkPngEncoder::Make(dst, info, source, SkPngEncoder::Options());
+        default:
+            return nullptr;
+    }
+}
+
+static void test_encode_rows_from_source(skiatest::Reporter* r, SkEncodedImageFormat format) {
+    SkBitmap bitmap;
+    if (!GetResourceAsBitmap("images/mandrill_128.png", &bitmap)) {
+        return;
+    }
+
+    SkPictureRecorder recorder;
+    recorder.beginRecording(SkIntToScalar(bitmap.width()), SkIntToScalar(bitmap.height()))
+            ->drawBitmap(bitmap, 0, 0);
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    SkPixmap src;
+    REPORTER_ASSERT(r, bitmap.peekPixels(&src));
+    SkDynamicMemoryWStream expected;
+    REPORTER_ASSERT(r, encode(format, &expected, src));
+    sk_sp<SkData> expectedData = expected.detachAsData();
+
+    // However the rows are chunked, we only buffer one chunk and get the same encoded image.
+    for (int rowsPerCall : { 1, 7, 32, 200 }) {
+        PictureRowSource source(picture);
+        SkDynamicMemoryWStream dst;
+        auto encoder = make(format, &dst, src.info(), &source);
+        REPORTER_ASSERT(r, encoder);
+        for (int y = 0; y < src.height(); y += rowsPerCall) {
+            REPORTER_ASSERT(r, encoder->encodeRows(rowsPerCall));
+        }
+        REPORTER_ASSERT(r, source.fNextRow == src.height());
+        REPORTER_ASSERT(r, source.fMaxRows == SkTMin(rowsPerCall, src.height()));
+        REPORTER_ASSERT(r, dst.detachAsData()->equals(expectedData.get()));
+    }
+
+    // A failure from the source fails the encode.
+    PictureRowSource source(picture);
+    source.fFailAfter = 10;
+    SkDynamicMemoryWStream dst;
+    auto encoder = make(format, &dst, src.info(), &source);
+    REPORTER_ASSERT(r, encoder->encodeRows(10));
+    REPORTER_ASSERT(r, !encoder->encodeRows(10));
+    REPORTER_ASSERT(r, source.fNextRow == 20);
+
+    REPORTER_ASSERT(r, !make(format, &dst, src.info(), nullptr));
+}
+
+DEF_TEST(Encode_RowSource, r) {
+    test_encode_rows_from_source(r, SkEncodedImageFormat::kJPEG);
+    test_encode_rows_from_source(r, SkEncodedImageFormat::kPNG);
+}
+
 static inline bool almost_equals(SkPMColor a, SkPMColor b, int tolerance) {
     if (SkTAbs((int)SkGetPackedR32(a) - (int)SkGetPackedR32(b)) > tolerance) {
         return false;
@@ -391,3 +481,108 @@ DEF_TEST(Encode_WebpOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm0, bm2, 90));
     REPORTER_ASSERT(r, almost_equals(bm2, bm3, 50));
 }
+
+DEF_TEST(Encode_WebpSpeed, r) {
+    SkBitmap bitmap;
+    if (!GetResourceAsBitmap("images/google_chrome.ico", &bitmap)) {
+        return;
+    }
+
+    SkPixmap src;
+    REPORTER_ASSERT(r, bitmap.peekPixels(&src));
+
+    const SkWebpEncoder::Speed kSpeeds[] = {
+        SkWebpEncoder::Speed::kFastest, SkWebpEncoder::Speed::kFast,
+        SkWebpEncoder::Speed::kDefault, SkWebpEncoder::Speed::kSmall,
+        SkWebpEncoder::Speed::kSmallest,
+    };
+    auto encode_all = [&](SkWebpEncoder::Options options) {
+        std::vector<sk_sp<SkData>> encoded;
+        for (SkWebpEncoder::Speed speed : kSpeeds) {
+            options.fSpeed = speed;
+            SkDynamicMemoryWStream dst;
+            REPORTER_ASSERT(r, SkWebpEncoder::Encode(&dst, src, options));
+            encoded.push_back(dst.detachAsData());
+        }
+        return encoded;
+    };
+
+    SkWebpEncoder::Options options;
+    options.fCompression = SkWebpEncoder::Compression::kLossless;
+    for (const sk_sp<SkData>& data : encode_all(options)) {
+        SkBitmap bm;
+        SkImage::MakeFromEncoded(data)->asLegacyBitmap(&bm);
+        REPORTER_ASSERT(r, almost_equals(bitmap, bm, 0));
+    }
+
+    options.fCompression = SkWebpEncoder::Compression::kLossy;
+    options.fQuality = 75.0f;
+    std::vector<sk_sp<SkData>> lossy = encode_all(options);
+    REPORTER_ASSERT(r, lossy.back()->size() <= lossy.front()->size());
+    for (const sk_sp<SkData>& data : lossy) {
+        SkBitmap bm;
+        SkImage::MakeFromEncoded(data)->asLegacyBitmap(&bm);
+        REPORTER_ASSERT(r, almost_equals(bitmap, bm, 90));
+    }
+}
+
+DEF_TEST(Encode_WebpAnimated, r) {
+    SkBitmap bitmap;
+    if (!GetResourceAsBitmap("images/mandrill_128.png", &bitmap)) {
+        return;
+    }
+
+    const SkColor kColors[] = { SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, SK_ColorWHITE };
+    constexpr int kFrameCount = SK_ARRAY_COUNT(kColors);
+    SkBitmap bitmaps[kFrameCount];
+    SkWebpEncoder::Frame frames[kFrameCount];
+    for (int i = 0; i < kFrameCount; i++) {
+        bitmaps[i].allocPixels(bitmap.info().makeAlphaType(kOpaque_SkAlphaType));
+        SkCanvas canvas(bitmaps[i]);
+        canvas.drawBitmap(bitmap, 0, 0);
+        SkPaint paint;
+        paint.setColor(kColors[i]);
+        canvas.drawRect(SkRect::MakeXYWH(16 * i, 16 * i, 32, 32), paint);
+
+        REPORTER_ASSERT(r, bitmaps[i].peekPixels(&frames[i].fPixmap));
+        frames[i].fDuration = 100 * (i + 1);
+    }
+
+    SkWebpEncoder::Options options;
+    options.fCompression = SkWebpEncoder::Compression::kLossless;
+    SkDynamicMemoryWStream serial;
+    REPORTER_ASSERT(r, SkWebpEncoder::EncodeAnimated(&serial, frames, kFrameCount, options));
+    sk_sp<SkData> data = serial.detachAsData();
+
+    // Encoding the frames in parallel gives the same file.
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    options.fExecutor = executor.get();
+    SkDynamicMemoryWStream parallel;
+    REPORTER_ASSERT(r, SkWebpEncoder::EncodeAnimated(&parallel, frames, kFrameCount, options));
+    REPORTER_ASSERT(r, data->equals(parallel.detachAsData().get()));
+
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+    REPORTER_ASSERT(r, codec);
+    if (!codec) {
+        return;
+    }
+    std::vector<SkCodec::FrameInfo> frameInfos = codec->getFrameInfo();
+    REPORTER_ASSERT(r, kFrameCount == (int)frameInfos.size());
+    for (int i = 0; i < (int)frameInfos.size(); i++) {
+        REPORTER_ASSERT(r, frames[i].fDuration == frameInfos[i].fDuration);
+
+        SkBitmap bm;
+        bm.allocPixels(bitmaps[i].info());
+        SkCodec::Options codecOptions;
+        codecOptions.fFrameIndex = i;
+        REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                codec->getPixels(bm.info(), bm.getPixels(), bm.rowBytes(), &codecOptions));
+        REPORTER_ASSERT(r, almost_equals(bitmaps[i], bm, 0));
+    }
+
+    // Frames must all be the same size.
+    frames[1].fPixmap = SkPixmap(frames[1].fPixmap.info().makeWH(64, 64),
+                                 frames[1].fPixmap.addr(), frames[1].fPixmap.rowBytes());
+    SkDynamicMemoryWStream mismatched;
+    REPORTER_ASSERT(r, !SkWebpEncoder::EncodeAnimated(&mismatched, frames, kFrameCount, options));
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkExecutor.h"
+#include "SkTaskGroup.h"
+#include "Test.h"
+
+#include <atomic>
+
+DEF_TEST(SkExecutor_WorkStealing, r) {
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeWorkStealingThreadPool(4);
+
+    std::atomic<int> count{0};
+    SkTaskGroup(*pool).batch(1000, [&](int) {
+        count.fetch_add(1, std::memory_order_relaxed);
+    });
+    REPORTER_ASSERT(r, count.load() == 1000);
+}
+
+DEF_TEST(SkExecutor_WorkStealingNested, r) {
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeWorkStealingThreadPool(4);
+
+    // Work added from inside a task lands on that pool thread's own deque,
+    // and must still be found by wait()ing threads through borrow() and stealing.
+    std::atomic<int> count{0};
+    SkTaskGroup outer(*pool);
+    outer.batch(64, [&](int) {
+        SkTaskGroup inner(*pool);
+        inner.batch(64, [&](int) {
+            count.fetch_add(1, std::memory_order_relaxed);
+        });
+        inner.wait();
+    });
+    outer.wait();
+    REPORTER_ASSERT(r, count.load() == 64*64);
+}
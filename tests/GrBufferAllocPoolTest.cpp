@@ -0,0 +1,59 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTypes.h"
+#include "Test.h"
+
+#include "GrBufferAllocPool.h"
+#include "GrCaps.h"
+#include "GrContext.h"
+#include "GrContextPriv.h"
+#include "GrGpu.h"
+#include "GrGpuBuffer.h"
+
+using PersistentBufferRing = GrBufferAllocPool::PersistentBufferRing;
+
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(PersistentBufferRing, reporter, ctxInfo) {
+    GrGpu* gpu = ctxInfo.grContext()->priv().getGpu();
+    sk_sp<PersistentBufferRing> ring = PersistentBufferRing::Make(gpu);
+    REPORTER_ASSERT(reporter, SkToBool(ring) == gpu->caps()->persistentlyMappedBufferSupport());
+    if (!ring) {
+        return;
+    }
+
+    static constexpr size_t kSize = GrBufferAllocPool::kDefaultBufferSize;
+    sk_sp<GrGpuBuffer> first = ring->makeBuffer(GrGpuBufferType::kVertex, kSize);
+    if (!first) {
+        ERRORF(reporter, "Could not make a persistently mapped buffer.");
+        return;
+    }
+    REPORTER_ASSERT(reporter, kPersistentlyMapped_GrAccessPattern == first->accessPattern());
+
+    // The mapping stays the same across map() and unmap().
+    void* ptr = first->map();
+    REPORTER_ASSERT(reporter, ptr);
+    first->unmap();
+    REPORTER_ASSERT(reporter, !first->isMapped());
+    REPORTER_ASSERT(reporter, ptr == first->map());
+    first->unmap();
+    ring->endFlush();
+
+    // The buffer isn't handed out again until the ring comes back around to its flush.
+    for (int i = 1; i < PersistentBufferRing::kFrameCount; ++i) {
+        sk_sp<GrGpuBuffer> buffer = ring->makeBuffer(GrGpuBufferType::kVertex, kSize);
+        REPORTER_ASSERT(reporter, buffer && buffer != first);
+        ring->endFlush();
+    }
+
+    // It's only reused for requests of the same type that fit.
+    sk_sp<GrGpuBuffer> index = ring->makeBuffer(GrGpuBufferType::kIndex, kSize);
+    REPORTER_ASSERT(reporter, index != first);
+    sk_sp<GrGpuBuffer> large = ring->makeBuffer(GrGpuBufferType::kVertex, 2 * kSize);
+    REPORTER_ASSERT(reporter, large != first);
+    sk_sp<GrGpuBuffer> reused = ring->makeBuffer(GrGpuBufferType::kVertex, kSize);
+    REPORTER_ASSERT(reporter, reused == first);
+}
@@ -20,6 +20,7 @@
 #include "GrShape.h"
 #include "GrTexture.h"
 #include "SkExchange.h"
+#include "SkExecutor.h"
 #include "SkMatrix.h"
 #include "SkPathPriv.h"
 #include "SkRect.h"
@@ -293,6 +294,47 @@ class CCPR_parseEmptyPath : public CCPRTest {
 };
 DEF_CCPR_TEST(CCPR_parseEmptyPath)
 
+class CCPR_prepareFillsOnExecutor : public CCPRTest {
+    void customizeOptions(GrMockOptions*, GrContextOptions* ctxOptions) override {
+        if (!fExecutor) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(2);
+        }
+        ctxOptions->fExecutor = fExecutor.get();
+    }
+
+    void onRun(skiatest::Reporter* reporter, CCPRPathDrawer& ccpr) override {
+        // Build a path with enough verbs that fills get chopped on the executor.
+        SkPath star;
+        star.moveTo(50, 0);
+        for (int i = 1; i < 33; ++i) {
+            SkScalar r = (i & 1) ? 20 : 50;
+            SkScalar theta = i * SK_ScalarPI / 16;
+            star.cubicTo(50 + r * SkScalarSin(theta), 50 - r * SkScalarCos(theta),
+                         50 + r * SkScalarSin(theta), 50 - r * SkScalarCos(theta),
+                         50 + r * SkScalarSin(theta), 50 - r * SkScalarCos(theta));
+        }
+        star.close();
+        REPORTER_ASSERT(reporter, SkPathPriv::TestingOnly_unique(star));
+
+        for (int i = 0; i < 10; ++i) {
+            ccpr.drawPath(star, SkMatrix::MakeTrans(i * 10, i * 5));
+        }
+        ccpr.flush();
+        // Paths must be released by the time flush returns, including the executor's copies.
+        REPORTER_ASSERT(reporter, SkPathPriv::TestingOnly_unique(star));
+
+        // Drawing without a flush must not leak the prepared paths either.
+        for (int i = 0; i < 10; ++i) {
+            ccpr.drawPath(star, SkMatrix::MakeTrans(i * 5, i * 10));
+        }
+        ccpr.destroyGrContext();
+        REPORTER_ASSERT(reporter, SkPathPriv::TestingOnly_unique(star));
+    }
+
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+DEF_CCPR_TEST(CCPR_prepareFillsOnExecutor)
+
 static int get_mock_texture_id(const GrTexture* texture) {
     const GrBackendTexture& backingTexture = texture->getBackendTexture();
     SkASSERT(GrBackendApi::kMock == backingTexture.backend());
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTypes.h"
+
+#if SK_SUPPORT_GPU
+
+#include "GrFilePersistentCache.h"
+#include "SkExecutor.h"
+#include "SkOSPath.h"
+#include "Test.h"
+
+DEF_TEST(GrFilePersistentCache, r) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    SkString path = SkOSPath::Join(tmpDir.c_str(), "persistent_cache_test");
+
+    sk_sp<SkData> key1 = SkData::MakeWithCString("key one"),
+                  key2 = SkData::MakeWithCString("k2"),
+                  val1 = SkData::MakeWithCString("program binary one"),
+                  val2 = SkData::MakeWithCString("sksl");
+    {
+        GrFilePersistentCache cache(path.c_str());
+        cache.store(*key1, *val1);
+        cache.store(*key2, *val2);
+        REPORTER_ASSERT(r, cache.count() == 2);
+        REPORTER_ASSERT(r, cache.flush());
+    }
+    {
+        std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(1);
+        GrFilePersistentCache cache(path.c_str());
+        cache.preload(executor.get());
+        REPORTER_ASSERT(r, cache.count() == 2);
+
+        sk_sp<SkData> loaded = cache.load(*key1);
+        REPORTER_ASSERT(r, loaded && loaded->equals(val1.get()));
+        loaded = cache.load(*key2);
+        REPORTER_ASSERT(r, loaded && loaded->equals(val2.get()));
+        REPORTER_ASSERT(r, !cache.load(*SkData::MakeWithCString("missing")));
+
+        // Nothing new was stored, so this should leave the file alone.
+        REPORTER_ASSERT(r, cache.flush());
+    }
+}
+
+#endif
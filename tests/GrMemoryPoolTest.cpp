@@ -317,4 +317,22 @@ DEF_TEST(GrMemoryPoolAPI, reporter) {
         r.add(pool.allocate(0));
         REPORTER_ASSERT(reporter, pool.size() == hugeBlockSize + kMinAllocSize);
     }
+    // releaseAll() returns every allocation at once and keeps only the prealloc block.
+    {
+        GrMemoryPool pool(kSmallestMinAllocSize, kSmallestMinAllocSize);
+        for (int i = 0; i < 1000; ++i) {
+            pool.allocate(31);
+        }
+        REPORTER_ASSERT(reporter, pool.size() > 0);
+        REPORTER_ASSERT(reporter, !pool.isEmpty());
+
+        pool.releaseAll();
+        REPORTER_ASSERT(reporter, pool.size() == 0);
+        REPORTER_ASSERT(reporter, pool.isEmpty());
+        REPORTER_ASSERT(reporter, pool.preallocSize() == kSmallestMinAllocSize);
+
+        // The pool is usable afterwards.
+        pool.release(pool.allocate(31));
+        REPORTER_ASSERT(reporter, pool.isEmpty());
+    }
 }
@@ -56,7 +56,8 @@ public:
     }
     template<typename T> sk_sp<const GrBuffer> makeVertexBuffer(const T* data, int count);
 
-    void drawMesh(const GrMesh& mesh);
+    void drawMesh(const GrMesh& mesh) { this->drawMeshes(&mesh, 1); }
+    void drawMeshes(const GrMesh meshes[], int meshCount);
 
 private:
     GrOpFlushState* fState;
@@ -185,6 +186,31 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(GrMeshTest, reporter, ctxInfo) {
         }
     });
 
+    run_test(context, "setIndexed (one draw)", reporter, rtc, gold, [&](DrawMeshHelper* helper) {
+        auto ibuff = helper->getIndexBuffer();
+        VALIDATE(ibuff);
+        auto vbuff = helper->makeVertexBuffer(vertexData);
+        VALIDATE(vbuff);
+
+        // Submit all the boxes in one draw, which GL can merge into a multi draw indirect. Vary
+        // the base index and base vertex of each mesh as above.
+        SkTArray<GrMesh> meshes;
+        int baseRepetition = 0;
+        int i = 0;
+        while (i < kBoxCount) {
+            int repetitionCount = SkTMin(3 - baseRepetition, kBoxCount - i);
+
+            GrMesh& mesh = meshes.push_back();
+            mesh.setIndexed(ibuff, repetitionCount * 6, baseRepetition * 6, baseRepetition * 4,
+                            (baseRepetition + repetitionCount) * 4 - 1, GrPrimitiveRestart::kNo);
+            mesh.setVertexData(vbuff, (i - baseRepetition) * 4);
+
+            baseRepetition = (baseRepetition + 1) % 3;
+            i += repetitionCount;
+        }
+        helper->drawMeshes(meshes.begin(), meshes.count());
+    });
+
     run_test(context, "setIndexedPatterned", reporter, rtc, gold, [&](DrawMeshHelper* helper) {
         auto ibuff = helper->getIndexBuffer();
         VALIDATE(ibuff);
@@ -383,10 +409,10 @@ sk_sp<const GrBuffer> DrawMeshHelper::getIndexBuffer() {
             kIndexPattern, 6, kIndexPatternRepeatCount, 4, gIndexBufferKey);
 }
 
-void DrawMeshHelper::drawMesh(const GrMesh& mesh) {
+void DrawMeshHelper::drawMeshes(const GrMesh meshes[], int meshCount) {
     GrPipeline pipeline(GrScissorTest::kDisabled, SkBlendMode::kSrc);
-    GrMeshTestProcessor mtp(mesh.isInstanced(), mesh.hasVertexData());
-    fState->rtCommandBuffer()->draw(mtp, pipeline, nullptr, nullptr, &mesh, 1,
+    GrMeshTestProcessor mtp(meshes[0].isInstanced(), meshes[0].hasVertexData());
+    fState->rtCommandBuffer()->draw(mtp, pipeline, nullptr, nullptr, meshes, meshCount,
                                     SkRect::MakeIWH(kImageWidth, kImageHeight));
 }
 
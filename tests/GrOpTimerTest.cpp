@@ -0,0 +1,74 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTypes.h"
+
+#if SK_SUPPORT_GPU
+
+#include "GrContext.h"
+#include "GrOpTimingDump.h"
+#include "SkCanvas.h"
+#include "SkSurface.h"
+#include "Test.h"
+
+#include <map>
+#include <string>
+
+namespace {
+
+class OpTimings : public GrOpTimingDump {
+public:
+    void dumpOpTiming(const char* name, int count, uint64_t gpuNanoseconds) override {
+        fCounts[name] += count;
+    }
+
+    int count(const char* name) const {
+        auto iter = fCounts.find(name);
+        return iter == fCounts.end() ? 0 : iter->second;
+    }
+
+private:
+    std::map<std::string, int> fCounts;
+};
+
+}  // anonymous namespace
+
+DEF_GPUTEST_FOR_GL_RENDERING_CONTEXTS(GrOpTimer, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    if (!context->setOpTimingEnabled(true)) {
+        return;
+    }
+
+    const SkImageInfo ii = SkImageInfo::MakeN32Premul(32, 32);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, ii);
+    if (!surface) {
+        ERRORF(reporter, "Could not create surface.");
+        return;
+    }
+    static constexpr int kFrameCnt = 3;
+    for (int i = 0; i < kFrameCnt; ++i) {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        surface->getCanvas()->drawCircle(16, 16, 10, paint);
+        surface->flush();
+    }
+    ctxInfo.testContext()->finish();
+
+    OpTimings timings;
+    context->dumpOpTimings(&timings);
+    REPORTER_ASSERT(reporter, timings.count("GrRenderTargetOpList") >= kFrameCnt);
+    REPORTER_ASSERT(reporter, kFrameCnt == timings.count("CircleOp"));
+
+    // Everything was reported already.
+    OpTimings empty;
+    context->dumpOpTimings(&empty);
+    REPORTER_ASSERT(reporter, 0 == empty.count("GrRenderTargetOpList"));
+
+    REPORTER_ASSERT(reporter, context->setOpTimingEnabled(false));
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTypes.h"
+
+#if SK_SUPPORT_GPU
+
+#include "GrContext.h"
+#include "GrContextFactory.h"
+#include "GrContextPriv.h"
+#include "GrGpu.h"
+#include "SkCanvas.h"
+#include "SkSurface.h"
+#include "Test.h"
+
+#include <map>
+#include <string>
+
+using sk_gpu_test::GrContextFactory;
+
+namespace {
+
+class MemoryPersistentCache : public GrContextOptions::PersistentCache {
+public:
+    sk_sp<SkData> load(const SkData& key) override {
+        auto iter = fEntries.find(as_string(key));
+        return iter == fEntries.end() ? nullptr : iter->second;
+    }
+
+    void store(const SkData& key, const SkData& data) override {
+        fEntries[as_string(key)] = SkData::MakeWithCopy(data.data(), data.size());
+    }
+
+    const std::map<std::string, sk_sp<SkData>>& entries() const { return fEntries; }
+
+private:
+    static std::string as_string(const SkData& data) {
+        return std::string(static_cast<const char*>(data.data()), data.size());
+    }
+
+    std::map<std::string, sk_sp<SkData>> fEntries;
+};
+
+}  // anonymous namespace
+
+static void draw_and_check(skiatest::Reporter* reporter, GrContext* context) {
+    const SkImageInfo ii = SkImageInfo::MakeN32Premul(16, 16);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, ii);
+    if (!surface) {
+        ERRORF(reporter, "Could not create surface.");
+        return;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(SK_ColorBLUE);
+    canvas->drawCircle(8, 8, 6, paint);
+
+    uint32_t center;
+    if (!surface->readPixels(ii.makeWH(1, 1), &center, sizeof(center), 8, 8)) {
+        ERRORF(reporter, "Could not read back.");
+        return;
+    }
+    REPORTER_ASSERT(reporter, center == SkPreMultiplyColor(SK_ColorBLUE));
+}
+
+// Programs precompiled from one context's PersistentCache entries are used by another context's
+// draws without compiling anything more.
+DEF_GPUTEST(GrPrecompile, reporter, options) {
+    MemoryPersistentCache cache;
+    GrContextOptions cacheOptions = options;
+    cacheOptions.fPersistentCache = &cache;
+
+    {
+        GrContextFactory factory(cacheOptions);
+        GrContext* context = factory.get(GrContextFactory::kGL_ContextType);
+        if (!context) {
+            return;
+        }
+        draw_and_check(reporter, context);
+    }
+    REPORTER_ASSERT(reporter, !cache.entries().empty());
+
+    GrContextFactory factory(cacheOptions);
+    GrContext* context = factory.get(GrContextFactory::kGL_ContextType);
+    if (!context) {
+        return;
+    }
+    REPORTER_ASSERT(reporter, !context->precompile(*SkData::MakeWithCString("not a key")));
+    for (const auto& entry : cache.entries()) {
+        sk_sp<SkData> key = SkData::MakeWithCopy(entry.first.data(), entry.first.size());
+        REPORTER_ASSERT(reporter, context->precompile(*key));
+    }
+
+#if GR_GPU_STATS
+    int compilations = context->priv().getGpu()->stats()->shaderCompilations();
+#endif
+    draw_and_check(reporter, context);
+#if GR_GPU_STATS
+    REPORTER_ASSERT(reporter,
+                    compilations == context->priv().getGpu()->stats()->shaderCompilations());
+#endif
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTypes.h"
+
+#if SK_SUPPORT_GPU
+
+#include "GrContext.h"
+#include "GrContextFactory.h"
+#include "SkBitmap.h"
+#include "SkCanvas.h"
+#include "SkPictureRecorder.h"
+#include "SkSurface.h"
+#include "Test.h"
+
+using sk_gpu_test::GrContextFactory;
+
+static sk_sp<SkPicture> make_picture() {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(40, 40));
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeXYWH(0, 0, 30, 30), paint);
+    paint.setColor(0x800000FF);
+    canvas->drawRect(SkRect::MakeXYWH(10, 10, 30, 30), paint);
+    return recorder.finishRecordingAsPicture();
+}
+
+// Draws the picture twice, the second time at an integer offset, and returns the pixels.
+static bool draw(GrContext* context, const SkPicture* picture, SkBitmap* bitmap,
+                 int* resourceCounts) {
+    const SkImageInfo ii = SkImageInfo::MakeN32Premul(100, 100);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, ii);
+    if (!surface) {
+        return false;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+    canvas->drawPicture(picture);
+    surface->flush();
+    context->getResourceCacheUsage(&resourceCounts[0], nullptr);
+
+    SkMatrix matrix = SkMatrix::MakeTrans(50, 50);
+    canvas->drawPicture(picture, &matrix, nullptr);
+    surface->flush();
+    context->getResourceCacheUsage(&resourceCounts[1], nullptr);
+
+    bitmap->allocPixels(ii);
+    return surface->readPixels(*bitmap, 0, 0);
+}
+
+// Retained picture draws match played back ones, and drawing the same picture again at an integer
+// offset reuses the retained rendering.
+DEF_GPUTEST(GrRetainedPicture, reporter, options) {
+    sk_sp<SkPicture> picture = make_picture();
+
+    SkBitmap expected;
+    int expectedCounts[2];
+    {
+        GrContextFactory factory(options);
+        GrContext* context = factory.get(GrContextFactory::kGL_ContextType);
+        if (!context || !draw(context, picture.get(), &expected, expectedCounts)) {
+            return;
+        }
+    }
+
+    GrContextOptions retainOptions = options;
+    retainOptions.fRetainPictureDraws = true;
+    GrContextFactory factory(retainOptions);
+    GrContext* context = factory.get(GrContextFactory::kGL_ContextType);
+    if (!context) {
+        return;
+    }
+    SkBitmap actual;
+    int counts[2];
+    if (!draw(context, picture.get(), &actual, counts)) {
+        ERRORF(reporter, "Could not draw with retained pictures.");
+        return;
+    }
+    REPORTER_ASSERT(reporter, counts[0] == counts[1]);
+    for (int y = 0; y < expected.height(); y++) {
+        for (int x = 0; x < expected.width(); x++) {
+            // The translucent rect is composited twice when retained, which may round differently.
+            SkPMColor e = *expected.getAddr32(x, y), a = *actual.getAddr32(x, y);
+            bool close = true;
+            for (int shift = 0; shift < 32; shift += 8) {
+                close &= SkTAbs((int)((e >> shift) & 0xFF) - (int)((a >> shift) & 0xFF)) <= 1;
+            }
+            if (!close) {
+                ERRORF(reporter, "Mismatch at (%d, %d): expected 0x%08x, got 0x%08x", x, y,
+                       e, a);
+                return;
+            }
+        }
+    }
+}
+
+#endif
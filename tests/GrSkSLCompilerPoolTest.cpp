@@ -0,0 +1,58 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrSkSLCompilerPool.h"
+#include "SkSLCompiler.h"
+#include "SkTaskGroup.h"
+
+#include "Test.h"
+
+static bool compile(GrSkSLCompilerPool* pool, const GrShaderCaps* caps, int i,
+                    SkSL::String* glsl) {
+    GrSkSLCompilerPool::Lease compiler = pool->acquire();
+    SkSL::Program::Settings settings;
+    settings.fCaps = caps;
+    SkSL::String src;
+    src.appendf("uniform half4 color;"
+                "half4 scale(half4 c) { return c * %d; }"
+                "void main() { sk_FragColor = scale(color); }", i);
+    std::unique_ptr<SkSL::Program> program =
+            compiler->convertProgram(SkSL::Program::kFragment_Kind, src, settings);
+    return program && compiler->toGLSL(*program, glsl);
+}
+
+DEF_TEST(GrSkSLCompilerPool, r) {
+    static const int kCount = 32;
+    sk_sp<GrShaderCaps> caps = SkSL::ShaderCapsFactory::Default();
+    GrSkSLCompilerPool pool;
+    SkSL::String expected[kCount];
+    for (int i = 0; i < kCount; ++i) {
+        REPORTER_ASSERT(r, compile(&pool, caps.get(), i, &expected[i]));
+    }
+
+    SkSL::String results[kCount];
+    bool succeeded[kCount];
+    SkTaskGroup().batch(kCount, [&](int i) {
+        succeeded[i] = compile(&pool, caps.get(), i, &results[i]);
+    });
+    for (int i = 0; i < kCount; ++i) {
+        REPORTER_ASSERT(r, succeeded[i]);
+        REPORTER_ASSERT(r, results[i] == expected[i]);
+    }
+
+    // A compiler is back in the pool once its lease ends, and a live lease is never shared
+    GrSkSLCompilerPool::Lease first = pool.acquire();
+    GrSkSLCompilerPool::Lease second = pool.acquire();
+    REPORTER_ASSERT(r, first.get() != second.get());
+    SkSL::Compiler* firstCompiler = first.get();
+    {
+        GrSkSLCompilerPool::Lease moved(std::move(first));
+        REPORTER_ASSERT(r, moved.get() == firstCompiler);
+    }
+    GrSkSLCompilerPool::Lease third = pool.acquire();
+    REPORTER_ASSERT(r, third.get() == firstCompiler);
+}
@@ -101,6 +101,7 @@ DEF_GPUTEST_FOR_ALL_CONTEXTS(GrSurfaceRenderability, reporter, ctxInfo) {
         kRGBA_half_GrPixelConfig,
         kRGBA_half_Clamped_GrPixelConfig,
         kRGB_ETC1_GrPixelConfig,
+        kRGB_BC1_GrPixelConfig,
     };
     GR_STATIC_ASSERT(kGrPixelConfigCnt == SK_ARRAY_COUNT(configs));
 
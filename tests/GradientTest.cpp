@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "GrContext.h"
 #include "SkCanvas.h"
 #include "SkColorPriv.h"
 #include "SkColorShader.h"
@@ -538,6 +539,39 @@ static void test_sweep_fuzzer(skiatest::Reporter*) {
     }
 }
 
+// Three stop gradients take a select-based stage; an equivalent four stop gradient (the extra stop
+// lies on the line between the last two) goes through the general search stage.
+static void test_three_stop_matches_general(skiatest::Reporter* reporter) {
+    const SkColor4f colors3[] = { {1, 0, 0, 1}, {0, 1, 0, 1}, {0, 0, 1, 1} };
+    const SkScalar pos3[] = { 0, 0.3f, 1 };
+    const SkColor4f colors4[] = { {1, 0, 0, 1}, {0, 1, 0, 1}, {0, 0.5f, 0.5f, 1}, {0, 0, 1, 1} };
+    const SkScalar pos4[] = { 0, 0.3f, 0.65f, 1 };
+
+    SkBitmap bitmaps[2];
+    for (int i = 0; i < 2; ++i) {
+        SkPaint paint;
+        paint.setShader(SkGradientShader::MakeRadial({32, 32}, 24, i ? colors4 : colors3, nullptr,
+                                                     i ? pos4 : pos3, i ? 4 : 3,
+                                                     SkShader::kClamp_TileMode));
+        bitmaps[i].allocN32Pixels(64, 64);
+        SkCanvas canvas(bitmaps[i]);
+        canvas.drawPaint(paint);
+    }
+
+    for (int y = 0; y < 64; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            SkColor c0 = bitmaps[0].getColor(x, y),
+                    c1 = bitmaps[1].getColor(x, y);
+            if (SkTAbs((int)SkColorGetR(c0) - (int)SkColorGetR(c1)) > 1 ||
+                SkTAbs((int)SkColorGetG(c0) - (int)SkColorGetG(c1)) > 1 ||
+                SkTAbs((int)SkColorGetB(c0) - (int)SkColorGetB(c1)) > 1) {
+                ERRORF(reporter, "three stop gradient %08x != %08x at (%d, %d)", c0, c1, x, y);
+                return;
+            }
+        }
+    }
+}
+
 DEF_TEST(Gradient, reporter) {
     TestGradientShaders(reporter);
     TestGradientOptimization(reporter);
@@ -551,4 +585,38 @@ DEF_TEST(Gradient, reporter) {
     test_degenerate_linear(reporter);
     test_linear_fuzzer(reporter);
     test_sweep_fuzzer(reporter);
+    test_three_stop_matches_general(reporter);
+}
+
+static sk_sp<SkShader> make_many_stop_gradient() {
+    constexpr int kCount = 20;
+    SkColor colors[kCount];
+    SkScalar pos[kCount];
+    for (int i = 0; i < kCount; ++i) {
+        colors[i] = i & 1 ? SK_ColorBLUE : SkColorSetARGB(0xFF, 12 * i, 0xFF - 12 * i, 0);
+        pos[i] = SkIntToScalar(i) / (kCount - 1);
+    }
+    const SkPoint pts[] = {{0, 0}, {64, 0}};
+    return SkGradientShader::MakeLinear(pts, colors, pos, kCount, SkShader::kClamp_TileMode);
+}
+
+// A gradient with too many stops for the analytic colorizers is sampled from a ramp texture. A new
+// shader with the same stops should find the ramp that is already in the resource cache.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(GradientRampTextureReuse, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    auto surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo,
+                                               SkImageInfo::MakeN32Premul(64, 64));
+    if (!surface) {
+        return;
+    }
+
+    int counts[2];
+    for (int i = 0; i < 2; ++i) {
+        SkPaint paint;
+        paint.setShader(make_many_stop_gradient());
+        surface->getCanvas()->drawRect(SkRect::MakeWH(64, 64), paint);
+        surface->getCanvas()->flush();
+        context->getResourceCacheUsage(&counts[i], nullptr);
+    }
+    REPORTER_ASSERT(reporter, counts[0] == counts[1]);
 }
@@ -8,6 +8,8 @@
 #include "SkChecksum.h"
 #include "SkRefCnt.h"
 #include "SkString.h"
+#include "SkRandom.h"
+#include "SkTFlatHashTable.h"
 #include "SkTHash.h"
 #include "Test.h"
 
@@ -199,3 +201,51 @@ DEF_TEST(HashFindOrNull, r) {
 
     REPORTER_ASSERT(r, &seven == table.findOrNull(7));
 }
+
+DEF_TEST(FlatHashTable, r) {
+    struct Entry {
+        int key = 0;
+        int val = 0;
+    };
+
+    struct HashTraits {
+        static int GetKey(const Entry& e) { return e.key; }
+        // A weak hash, so many keys share their control bytes and collide into the same groups.
+        static uint32_t Hash(int key) { return key & 0x3FF; }
+    };
+
+    // Check against SkTHashMap through a random mix of sets and removes.
+    SkTFlatHashTable<Entry, int, HashTraits> table;
+    SkTHashMap<int, int> expected;
+    SkRandom random;
+    for (int i = 0; i < 20000; i++) {
+        int key = random.nextULessThan(3000);
+        if (random.nextBool() && expected.find(key)) {
+            table.remove(key);
+            expected.remove(key);
+        } else {
+            table.set({key, i});
+            expected.set(key, i);
+        }
+        REPORTER_ASSERT(r, table.count() == expected.count());
+    }
+    for (int key = 0; key < 3000; key++) {
+        const Entry* entry = table.find(key);
+        const int* val = expected.find(key);
+        REPORTER_ASSERT(r, !entry == !val);
+        if (entry && val) {
+            REPORTER_ASSERT(r, entry->key == key);
+            REPORTER_ASSERT(r, entry->val == *val);
+        }
+    }
+    int visited = 0;
+    table.foreach([&](Entry* e) {
+        visited++;
+        REPORTER_ASSERT(r, expected.find(e->key) && *expected.find(e->key) == e->val);
+    });
+    REPORTER_ASSERT(r, visited == expected.count());
+
+    table.reset();
+    REPORTER_ASSERT(r, table.count() == 0);
+    REPORTER_ASSERT(r, !table.find(0));
+}
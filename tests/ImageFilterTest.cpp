@@ -17,6 +17,7 @@
 #include "SkDropShadowImageFilter.h"
 #include "SkGradientShader.h"
 #include "SkImage.h"
+#include "SkImageFilterCache.h"
 #include "SkImageFilterPriv.h"
 #include "SkImageSource.h"
 #include "SkLightingImageFilter.h"
@@ -46,6 +47,8 @@
 #include "GrContext.h"
 #include "GrContextPriv.h"
 
+#include <atomic>
+
 static const int kBitmapSize = 4;
 
 namespace {
@@ -1862,6 +1865,98 @@ DEF_TEST(ImageFilterColorSpaceDAG, reporter) {
     REPORTER_ASSERT(reporter, filter->cloneCount() == 1u);
 }
 
+// Helper for counting how often a filter node is evaluated.
+class CountingImageFilter final : public SkImageFilter {
+public:
+    CountingImageFilter() : INHERITED(nullptr, 0, nullptr) {}
+
+    Factory getFactory() const override { return nullptr; }
+    const char* getTypeName() const override { return nullptr; }
+
+    int filterCount() const { return fFilterCount.load(); }
+
+protected:
+    sk_sp<SkSpecialImage> onFilterImage(SkSpecialImage* src, const Context&,
+                                        SkIPoint* offset) const override {
+        fFilterCount++;
+        offset->fX = offset->fY = 0;
+        return sk_ref_sp(src);
+    }
+    sk_sp<SkImageFilter> onMakeColorSpace(SkColorSpaceXformer*) const override {
+        return sk_ref_sp(const_cast<CountingImageFilter*>(this));
+    }
+
+private:
+    typedef SkImageFilter INHERITED;
+
+    mutable std::atomic<int> fFilterCount{0};
+};
+
+// Inputs shared by several slots of a merge or xfermode filter are only evaluated once, even
+// without a cache, and distinct inputs are each evaluated once.
+DEF_TEST(ImageFilterSharedInputsDAG, reporter) {
+    sk_sp<SkSpecialImage> srcImg(create_empty_special_image(nullptr, 10));
+    SkImageFilter::OutputProperties noColorSpace(kN32_SkColorType, nullptr);
+    SkImageFilter::Context ctx(SkMatrix::I(), SkIRect::MakeWH(10, 10), nullptr, noColorSpace);
+    SkIPoint offset;
+
+    auto shared = sk_make_sp<CountingImageFilter>();
+    sk_sp<SkImageFilter> inputs[] = { shared, shared, shared, shared, shared };
+    auto merge = SkMergeImageFilter::Make(inputs, SK_ARRAY_COUNT(inputs));
+    REPORTER_ASSERT(reporter, merge->filterImage(srcImg.get(), ctx, &offset));
+    REPORTER_ASSERT(reporter, shared->filterCount() == 1);
+
+    auto xfermode = SkXfermodeImageFilter::Make(SkBlendMode::kSrcOver, inputs[0], inputs[1],
+                                                nullptr);
+    REPORTER_ASSERT(reporter, xfermode->filterImage(srcImg.get(), ctx, &offset));
+    REPORTER_ASSERT(reporter, shared->filterCount() == 2);
+
+    sk_sp<CountingImageFilter> distinct[] = {
+        sk_make_sp<CountingImageFilter>(),
+        sk_make_sp<CountingImageFilter>(),
+        sk_make_sp<CountingImageFilter>(),
+    };
+    sk_sp<SkImageFilter> distinctInputs[] = { distinct[0], distinct[1], distinct[2] };
+    auto distinctMerge = SkMergeImageFilter::Make(distinctInputs, SK_ARRAY_COUNT(distinctInputs));
+    sk_sp<SkSpecialImage> result(distinctMerge->filterImage(srcImg.get(), ctx, &offset));
+    REPORTER_ASSERT(reporter, result && result->width() == 10 && result->height() == 10);
+    for (const auto& filter : distinct) {
+        REPORTER_ASSERT(reporter, filter->filterCount() == 1);
+    }
+}
+
+// Transient caches are sized to hold a result for every distinct node of the DAG.
+DEF_TEST(ImageFilterCacheTransientSize, reporter) {
+    const SkIRect clip = SkIRect::MakeWH(2000, 2000);
+    const size_t nodeBytes = 4 * 2000 * 2000;
+
+    sk_sp<SkImageFilter> blur = SkBlurImageFilter::Make(5, 5, nullptr);
+    sk_sp<SkImageFilter> sharedInputs[] = { blur, blur, blur };
+    auto shared = SkMergeImageFilter::Make(sharedInputs, SK_ARRAY_COUNT(sharedInputs));
+    sk_sp<SkImageFilter> distinctInputs[] = {
+        SkBlurImageFilter::Make(5, 5, nullptr),
+        SkBlurImageFilter::Make(5, 5, nullptr),
+        SkBlurImageFilter::Make(5, 5, nullptr),
+    };
+    auto distinct = SkMergeImageFilter::Make(distinctInputs, SK_ARRAY_COUNT(distinctInputs));
+
+    REPORTER_ASSERT(reporter, SkImageFilterCache::TransientSize(shared.get(), clip,
+                                                                kN32_SkColorType) ==
+                              std::max<size_t>(2 * nodeBytes,
+                                               SkImageFilterCache::kDefaultTransientSize));
+    REPORTER_ASSERT(reporter, SkImageFilterCache::TransientSize(distinct.get(), clip,
+                                                                kN32_SkColorType) == 4 * nodeBytes);
+    REPORTER_ASSERT(reporter, SkImageFilterCache::TransientSize(distinct.get(), clip,
+                                                                kRGBA_F16_SkColorType) ==
+                              8 * nodeBytes);
+    REPORTER_ASSERT(reporter, SkImageFilterCache::TransientSize(distinct.get(),
+                                                                SkIRect::MakeWH(8000, 8000),
+                                                                kN32_SkColorType) ==
+                              SkImageFilterCache::kMaxTransientSize);
+    REPORTER_ASSERT(reporter, SkImageFilterCache::TransientSize(nullptr, clip, kN32_SkColorType) ==
+                              SkImageFilterCache::kDefaultTransientSize);
+}
+
 // Test SkXfermodeImageFilter::filterBounds with different blending modes.
 DEF_TEST(XfermodeImageFilterBounds, reporter) {
     SkIRect background_rect = SkIRect::MakeXYWH(0, 0, 100, 100);
@@ -2038,3 +2133,46 @@ DEF_TEST(ImageSourceBounds, reporter) {
                                                              &input));
 }
 
+
+// Raster devices filter layers wider than 2048 pixels one tile at a time. The tiles must come out
+// the same as filtering all at once, including across the seams between them.
+DEF_TEST(ImageFilterTiledRaster, reporter) {
+    auto draw = [](SkCanvas* canvas) {
+        SkPaint layerPaint;
+        layerPaint.setImageFilter(SkDilateImageFilter::Make(
+                4, 2, SkOffsetImageFilter::Make(3, 1, nullptr)));
+        canvas->saveLayer(nullptr, &layerPaint);
+        SkPaint paint;
+        for (int x = 0; x < 4200; x += 37) {
+            paint.setColor(SkColorSetARGB(0xFF, x & 0xFF, (x >> 4) & 0xFF, 0x80));
+            canvas->drawRect(SkRect::MakeXYWH(SkIntToScalar(x), SkIntToScalar(x % 40), 5, 9),
+                             paint);
+        }
+        canvas->restore();
+    };
+
+    SkBitmap tiled;
+    tiled.allocN32Pixels(4200, 64);
+    SkCanvas tiledCanvas(tiled);
+    tiledCanvas.clear(SK_ColorWHITE);
+    draw(&tiledCanvas);
+
+    // A narrower canvas, looking at the area around the first seam, is filtered in one piece.
+    const int kRefX = 1600;
+    SkBitmap ref;
+    ref.allocN32Pixels(1024, 64);
+    SkCanvas refCanvas(ref);
+    refCanvas.clear(SK_ColorWHITE);
+    refCanvas.translate(-SkIntToScalar(kRefX), 0);
+    draw(&refCanvas);
+
+    // Skip the edges of the narrower canvas, whose filter inputs are cut off.
+    const int kMargin = 16;
+    bool match = true;
+    for (int y = kMargin; y < ref.height() - kMargin && match; ++y) {
+        for (int x = kMargin; x < ref.width() - kMargin && match; ++x) {
+            match = *ref.getAddr32(x, y) == *tiled.getAddr32(kRefX + x, y);
+        }
+    }
+    REPORTER_ASSERT(reporter, match);
+}
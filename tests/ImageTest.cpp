@@ -13,12 +13,15 @@
 #include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkColorSpacePriv.h"
+#include "SkCompressedDataUtils.h"
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkImageEncoder.h"
 #include "SkImageGenerator.h"
 #include "SkImage_Base.h"
 #include "SkImagePriv.h"
 #include "SkMakeUnique.h"
+#include "SkMipMap.h"
 #include "SkPicture.h"
 #include "SkPictureRecorder.h"
 #include "SkRRect.h"
@@ -454,6 +457,109 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkImage_makeTextureImage, reporter, contextIn
     }
 }
 
+static sk_sp<SkImage> make_async_upload_image() {
+    // Large enough to be staged on a worker thread, with a corner that differs.
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeN32Premul(1024, 512));
+    bitmap.eraseColor(SK_ColorGREEN);
+    bitmap.erase(SK_ColorRED, SkIRect::MakeXYWH(1000, 500, 24, 12));
+    bitmap.setImmutable();
+    return SkImage::MakeFromBitmap(bitmap);
+}
+
+static void check_async_upload_pixels(skiatest::Reporter* reporter, const char* label,
+                                      const std::function<bool(const SkPixmap&, int, int)>& read) {
+    uint32_t pixel;
+    SkPixmap pm(SkImageInfo::MakeN32Premul(1, 1), &pixel, sizeof(pixel));
+    if (!read(pm, 0, 0) || pm.getColor(0, 0) != SK_ColorGREEN ||
+        !read(pm, 1010, 505) || pm.getColor(0, 0) != SK_ColorRED) {
+        ERRORF(reporter, "%s: texture image doesn't have the raster image's pixels.", label);
+    }
+}
+
+DEF_GPUTEST(SkImage_makeTextureImageAsyncUpload, reporter, options) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(1);
+    GrContextOptions contextOptions = options;
+    contextOptions.fExecutor = executor.get();
+    GrContextFactory factory(contextOptions);
+    for (int ct = 0; ct < GrContextFactory::kContextTypeCnt; ++ct) {
+        auto type = static_cast<GrContextFactory::ContextType>(ct);
+        GrContext* context = factory.get(type);
+        if (!GrContextFactory::IsRenderingContext(type) || !context) {
+            continue;
+        }
+
+        // Read back directly, before any op list has scheduled the upload.
+        sk_sp<SkImage> readImage = make_async_upload_image()->makeTextureImage(context, nullptr);
+        REPORTER_ASSERT(reporter, readImage && readImage->isTextureBacked());
+        if (readImage) {
+            check_async_upload_pixels(reporter, "read", [&](const SkPixmap& pm, int x, int y) {
+                return readImage->readPixels(pm, x, y);
+            });
+        }
+
+        // Drawn, so uploaded at the start of the flush.
+        sk_sp<SkImage> drawImage = make_async_upload_image()->makeTextureImage(context, nullptr);
+        sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(
+                context, SkBudgeted::kNo, SkImageInfo::MakeN32Premul(1024, 512));
+        if (drawImage && surface) {
+            surface->getCanvas()->drawImage(drawImage, 0, 0);
+            check_async_upload_pixels(reporter, "draw", [&](const SkPixmap& pm, int x, int y) {
+                return surface->readPixels(pm, x, y);
+            });
+        }
+    }
+}
+
+// Draws a YUV-decodable codec image and returns the result.
+static bool draw_yuv_codec_image(GrContext* context, SkBitmap* result) {
+    sk_sp<SkImage> image = SkImage::MakeFromEncoded(
+            GetResourceAsData("images/mandrill_512_q075.jpg"));
+    if (!image) {
+        return false;
+    }
+    SkImageInfo info = SkImageInfo::MakeN32Premul(image->width(), image->height());
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+    if (!surface) {
+        return false;
+    }
+    surface->getCanvas()->drawImage(image, 0, 0);
+    result->allocPixels(info);
+    return surface->readPixels(result->pixmap(), 0, 0);
+}
+
+DEF_GPUTEST(SkImage_threadedYUVDecode, reporter, options) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(1);
+    GrContextOptions threadedOptions = options;
+    threadedOptions.fExecutor = executor.get();
+    threadedOptions.fDecodeYUVImagesOnWorkerThreads = true;
+    GrContextFactory threadedFactory(threadedOptions);
+    GrContextFactory factory(options);
+    for (int ct = 0; ct < GrContextFactory::kContextTypeCnt; ++ct) {
+        auto type = static_cast<GrContextFactory::ContextType>(ct);
+        GrContext* threadedContext = threadedFactory.get(type);
+        GrContext* context = factory.get(type);
+        if (!GrContextFactory::IsRenderingContext(type) || !threadedContext || !context) {
+            continue;
+        }
+
+        // The planes are decoded and converted the same way; only the thread differs.
+        SkBitmap threaded, expected;
+        if (!draw_yuv_codec_image(threadedContext, &threaded) ||
+            !draw_yuv_codec_image(context, &expected)) {
+            continue;
+        }
+        for (int y = 0; y < expected.height(); ++y) {
+            if (memcmp(threaded.getAddr(0, y), expected.getAddr(0, y),
+                       expected.width() * expected.bytesPerPixel())) {
+                ERRORF(reporter, "%s: row %d differs from the synchronous decode",
+                       GrContextFactory::ContextTypeName(type), y);
+                break;
+            }
+        }
+    }
+}
+
 DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkImage_makeNonTextureImage, reporter, contextInfo) {
     GrContext* context = contextInfo.grContext();
 
@@ -505,6 +611,100 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(GrContext_colorTypeSupportedAsImage, reporter
     }
 }
 
+// Makes BC1 data for a width x height image where every block of level n has endpoints
+// colors[n % 2] and black, and uses the texel index pattern.
+static sk_sp<SkData> make_bc1_data(int width, int height, bool mipMapped, uint32_t pattern) {
+    static const uint16_t kColors[] = { 0xF800 /* red */, 0x07E0 /* green */ };
+    SkDynamicMemoryWStream stream;
+    int levels = mipMapped ? SkMipMap::ComputeLevelCount(width, height) + 1 : 1;
+    for (int level = 0; level < levels; ++level) {
+        int blocks = ((width + 3) / 4) * ((height + 3) / 4);
+        for (int i = 0; i < blocks; ++i) {
+            stream.write16(kColors[level % 2]);
+            stream.write16(0x0000);
+            stream.write32(pattern);
+        }
+        width = SkTMax(1, width / 2);
+        height = SkTMax(1, height / 2);
+    }
+    return stream.detachAsData();
+}
+
+DEF_TEST(Image_MakeRasterFromCompressed, reporter) {
+    // Rows of indices 0, 1, 2 and 3: red, black, 2/3 red and 1/3 red.
+    sk_sp<SkData> data = make_bc1_data(6, 6, false, 0xFFAA5500);
+    sk_sp<SkImage> image = SkImage::MakeRasterFromCompressed(data, 6, 6,
+                                                             SkImage::kBC1_CompressionType);
+    REPORTER_ASSERT(reporter, image && image->isOpaque());
+    if (!image) {
+        return;
+    }
+
+    SkBitmap bm;
+    REPORTER_ASSERT(reporter, bm.tryAllocN32Pixels(6, 6));
+    REPORTER_ASSERT(reporter, image->readPixels(bm.pixmap(), 0, 0));
+    static const SkColor kExpected[] = {
+        SK_ColorRED, SK_ColorBLACK, SkColorSetRGB(170, 0, 0), SkColorSetRGB(85, 0, 0),
+    };
+    for (int y = 0; y < 6; ++y) {
+        for (int x = 0; x < 6; ++x) {
+            REPORTER_ASSERT(reporter, bm.getColor(x, y) == kExpected[y % 4]);
+        }
+    }
+
+    // Too little data fails, and a null context falls back to raster.
+    REPORTER_ASSERT(reporter, !SkImage::MakeRasterFromCompressed(data, 12, 12,
+                                                                 SkImage::kBC1_CompressionType));
+    image = SkImage::MakeFromCompressed(nullptr, data, 6, 6, SkImage::kBC1_CompressionType);
+    REPORTER_ASSERT(reporter, image && !image->isTextureBacked());
+}
+
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkImage_MakeFromCompressed, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    static constexpr int kSize = 12;
+
+    for (auto type : { SkImage::kETC1_CompressionType, SkImage::kBC1_CompressionType }) {
+        for (auto mipMapped : { GrMipMapped::kNo, GrMipMapped::kYes }) {
+            sk_sp<SkData> data;
+            if (SkImage::kBC1_CompressionType == type) {
+                data = make_bc1_data(kSize, kSize, GrMipMapped::kYes == mipMapped, 0);
+            } else {
+                size_t size = SkCompressedDataSize(type, kSize, kSize,
+                                                   GrMipMapped::kYes == mipMapped);
+                data = SkData::MakeUninitialized(size);
+                memset(data->writable_data(), 0, size);
+            }
+            sk_sp<SkImage> raster = SkImage::MakeRasterFromCompressed(data, kSize, kSize, type);
+            SkBitmap expected;
+            REPORTER_ASSERT(reporter, raster && raster->asLegacyBitmap(&expected));
+
+            // The image is created whether or not the context can texture from the data.
+            sk_sp<SkImage> image = SkImage::MakeFromCompressed(context, data, kSize, kSize, type,
+                                                               mipMapped);
+            REPORTER_ASSERT(reporter, image && image->isTextureBacked());
+            if (!image) {
+                continue;
+            }
+
+            SkBitmap bm;
+            bm.allocN32Pixels(kSize, kSize);
+            REPORTER_ASSERT(reporter, image->readPixels(bm.pixmap(), 0, 0));
+            REPORTER_ASSERT(reporter, bm.getColor(0, 0) == expected.getColor(0, 0) &&
+                                      bm.getColor(kSize - 1, kSize - 1) ==
+                                              expected.getColor(kSize - 1, kSize - 1));
+
+            // Data without the mip levels it claims is rejected.
+            if (GrMipMapped::kYes == mipMapped && context->compressionTypeSupported(type) &&
+                context->priv().caps()->mipMapSupport()) {
+                sk_sp<SkData> baseOnly = SkData::MakeSubset(
+                        data.get(), 0, SkCompressedDataSize(type, kSize, kSize, false));
+                REPORTER_ASSERT(reporter, !SkImage::MakeFromCompressed(context, baseOnly, kSize,
+                                                                       kSize, type, mipMapped));
+            }
+        }
+    }
+}
+
 DEF_GPUTEST_FOR_RENDERING_CONTEXTS(UnpremulTextureImage, reporter, ctxInfo) {
     SkBitmap bmp;
     bmp.allocPixels(
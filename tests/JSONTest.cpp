@@ -86,6 +86,14 @@ DEF_TEST(JSON_Parse, reporter) {
         { "[ \"123456789\" ]"            , "[\"123456789\"]" },
         { "[ null , true, false,0,12.8 ]", "[null,true,false,0,12.8]" },
 
+        // Long strings exercise the word-at-a-time scan.
+        { "[ \"abcdefghijklmnopqrstuvwxyz\" ]"    , "[\"abcdefghijklmnopqrstuvwxyz\"]" },
+        { "[ \"abcdefghijklmnop{qr}stu]vwxyz\" ]" , "[\"abcdefghijklmnop{qr}stu]vwxyz\"]" },
+        { "[ \"\xc3\xa9\xc3\xa9\xc3\xa9\xc3\xa9\xc3\xa9\xc3\xa9\" ]",
+          "[\"\xc3\xa9\xc3\xa9\xc3\xa9\xc3\xa9\xc3\xa9\xc3\xa9\"]" },
+        { "[ \"abcdefghijklmnopqrstuvwxyz ]"     , nullptr },
+        { "[ \"abcdefghijklmn\x01opqrstuvwxyz\" ]", nullptr },
+
         { "{}"                          , "{}" },
         { " \n\r\t { \n\r\t } \n\r\t "  , "{}" },
         { "{ \"k\" : null }"            , "{\"k\":null}" },
@@ -128,6 +136,7 @@ DEF_TEST(JSON_Parse, reporter) {
         {R"zzz(["foo\rbar"])zzz"    , "[\"foo\rbar\"]"},
         {R"zzz(["foo\tbar"])zzz"    , "[\"foo\tbar\"]"},
         {R"zzz(["foo\u1234bar"])zzz", "[\"foo\u1234bar\"]"},
+        {R"zzz(["abcdefghijklmnop\"qrstuvwxyz"])zzz", "[\"abcdefghijklmnop\"qrstuvwxyz\"]"},
     };
 
     for (const auto& tst : g_tests) {
@@ -68,3 +68,29 @@ DEF_TEST(LRUCacheRandom, r) {
     }
     REPORTER_ASSERT(r, 0 == instances);
 }
+
+DEF_TEST(LRUCacheSetMaxCount, r) {
+    int instances = 0;
+    {
+        SkLRUCache<int, std::unique_ptr<Value>> test(4);
+        for (int i = 0; i < 4; i++) {
+            test.insert(i, std::unique_ptr<Value>(new Value(i, &instances)));
+        }
+        // Growing keeps every entry and makes room for more.
+        test.setMaxCount(8);
+        REPORTER_ASSERT(r, 8 == test.maxCount());
+        for (int i = 4; i < 8; i++) {
+            test.insert(i, std::unique_ptr<Value>(new Value(i, &instances)));
+        }
+        REPORTER_ASSERT(r, 8 == instances);
+        // Shrinking evicts the least recently used entries.
+        REPORTER_ASSERT(r, test.find(0));
+        test.setMaxCount(3);
+        REPORTER_ASSERT(r, 3 == instances);
+        REPORTER_ASSERT(r, 3 == test.count());
+        for (int k : { 0, 7, 6 }) {
+            REPORTER_ASSERT(r, test.find(k));
+        }
+    }
+    REPORTER_ASSERT(r, 0 == instances);
+}
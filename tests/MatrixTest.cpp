@@ -1066,3 +1066,47 @@ DEF_TEST(Matrix_maprects, r) {
         }
     }
 }
+
+DEF_TEST(Matrix_mapPointsBatches, r) {
+    // mapPoints maps several points at a time and the leftovers one by one; either way the
+    // results should match mapping each point with mapXY().
+    SkMatrix affine;
+    affine.setRotate(30);
+    affine.postScale(1.5f, -2);
+    affine.postTranslate(10, 20);
+
+    SkMatrix persp = affine;
+    persp.setPerspX(0.002f);
+    persp.setPerspY(-0.001f);
+
+    SkRandom rand;
+    SkPoint src[19], dst[19];
+    for (SkPoint& p : src) {
+        p.set(rand.nextSScalar1() * 100, rand.nextSScalar1() * 100);
+    }
+
+    for (const SkMatrix& m : { affine, persp }) {
+        for (int count : { 1, 3, 4, 8, 19 }) {
+            m.mapPoints(dst, src, count);
+            for (int i = 0; i < count; ++i) {
+                SkPoint expected = m.mapXY(src[i].fX, src[i].fY);
+                REPORTER_ASSERT(r, SkScalarNearlyEqual(dst[i].fX, expected.fX, 1e-3f));
+                REPORTER_ASSERT(r, SkScalarNearlyEqual(dst[i].fY, expected.fY, 1e-3f));
+            }
+        }
+    }
+
+    // Points that map to infinity (w == 0) come out as zero, in a batch or not.
+    SkMatrix atInfinity;
+    atInfinity.setAll(1, 0, 0,
+                      0, 1, 0,
+                      1, 0, -1);
+    SkPoint pts[9];
+    for (SkPoint& p : pts) {
+        p.set(1, 5);
+    }
+    atInfinity.mapPoints(pts, SK_ARRAY_COUNT(pts));
+    for (const SkPoint& p : pts) {
+        REPORTER_ASSERT(r, p.fX == 0 && p.fY == 0);
+    }
+}
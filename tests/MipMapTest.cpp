@@ -6,7 +6,9 @@
  */
 
 #include "SkBitmap.h"
+#include "SkExecutor.h"
 #include "SkMipMap.h"
+#include "SkOpts.h"
 #include "SkRandom.h"
 #include "Test.h"
 
@@ -209,3 +211,98 @@ DEF_TEST(MipMap_F16, reporter) {
     bmp.eraseColor(0);
     sk_sp<SkMipMap> mipmap(SkMipMap::Build(bmp, nullptr));
 }
+
+DEF_TEST(MipMap_1010102, reporter) {
+    SkBitmap bmp;
+    bmp.allocPixels(SkImageInfo::Make(10, 10, kRGBA_1010102_SkColorType, kPremul_SkAlphaType));
+    bmp.eraseColor(SK_ColorWHITE);
+    sk_sp<SkMipMap> mipmap(SkMipMap::Build(bmp, nullptr));
+    REPORTER_ASSERT(reporter, mipmap);
+    REPORTER_ASSERT(reporter, mipmap->countLevels() == SkMipMap::ComputeLevelCount(10, 10));
+
+    // Filtering a constant color must not change it.
+    for (int i = 0; i < mipmap->countLevels(); ++i) {
+        SkMipMap::Level level;
+        REPORTER_ASSERT(reporter, mipmap->getLevel(i, &level));
+        REPORTER_ASSERT(reporter, *level.fPixmap.addr32() == *bmp.getAddr32(0, 0));
+    }
+}
+
+DEF_TEST(MipMap_downsample_2_2_8888, reporter) {
+    SkRandom rand;
+    uint32_t src[2][34];
+    for (auto& row : src) {
+        for (uint32_t& px : row) {
+            px = rand.nextU();
+        }
+    }
+
+    // Check every count, so both the vector loop and its tail are exercised.
+    for (int count = 1; count <= 17; ++count) {
+        uint32_t dst[17];
+        SkOpts::downsample_2_2_8888(dst, src[0], sizeof(src[0]), count);
+        for (int i = 0; i < count; ++i) {
+            uint32_t expected = 0;
+            for (int shift = 0; shift < 32; shift += 8) {
+                uint32_t sum = ((src[0][2*i] >> shift) & 0xff) + ((src[0][2*i+1] >> shift) & 0xff)
+                             + ((src[1][2*i] >> shift) & 0xff) + ((src[1][2*i+1] >> shift) & 0xff);
+                expected |= (sum >> 2) << shift;
+            }
+            REPORTER_ASSERT(reporter, dst[i] == expected);
+        }
+    }
+}
+
+DEF_TEST(MipMap_partialLevels, reporter) {
+    SkBitmap bm;
+    make_bitmap(&bm, 300, 200);
+
+    sk_sp<SkMipMap> full(SkMipMap::Build(bm, nullptr));
+    REPORTER_ASSERT(reporter, full->complete());
+
+    sk_sp<SkMipMap> partial(SkMipMap::Build(bm, nullptr, 2));
+    REPORTER_ASSERT(reporter, !partial->complete());
+    REPORTER_ASSERT(reporter, partial->countLevels() == 2);
+    REPORTER_ASSERT(reporter, partial->size() < full->size());
+
+    // A scale of 1/5 needs the 2nd level, so the partial mipmap serves it like the full one.
+    SkSize scale = SkSize::Make(0.2f, 0.2f);
+    REPORTER_ASSERT(reporter, SkMipMap::LevelForScale(scale) == 2);
+    SkMipMap::Level fullLevel, partialLevel;
+    REPORTER_ASSERT(reporter, full->extractLevel(scale, &fullLevel));
+    REPORTER_ASSERT(reporter, partial->extractLevel(scale, &partialLevel));
+    REPORTER_ASSERT(reporter, fullLevel.fPixmap.info() == partialLevel.fPixmap.info());
+}
+
+DEF_TEST(MipMap_executor, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkRandom rand;
+
+    for (SkColorType ct : { kN32_SkColorType, kRGBA_F16_SkColorType }) {
+        for (SkISize size : { SkISize{1024, 1024}, SkISize{1023, 777} }) {
+            SkBitmap bm;
+            bm.allocPixels(SkImageInfo::Make(size.width(), size.height(), ct,
+                                             kPremul_SkAlphaType));
+            for (int y = 0; y < bm.height(); ++y) {
+                uint8_t* row = (uint8_t*)bm.getAddr(0, y);
+                for (size_t x = 0; x < bm.info().minRowBytes(); ++x) {
+                    // Keep F16 values finite by leaving the high byte of each half small.
+                    row[x] = (kRGBA_F16_SkColorType == ct && (x & 1)) ? 0x3b & rand.nextU()
+                                                                       : rand.nextU();
+                }
+            }
+
+            sk_sp<SkMipMap> serial(SkMipMap::Build(bm, nullptr));
+            sk_sp<SkMipMap> parallel(SkMipMap::Build(bm, nullptr, SkMipMap::kAllLevels,
+                                                     executor.get()));
+            REPORTER_ASSERT(reporter, serial->countLevels() == parallel->countLevels());
+            for (int i = 0; i < serial->countLevels(); ++i) {
+                SkMipMap::Level a, b;
+                serial->getLevel(i, &a);
+                parallel->getLevel(i, &b);
+                REPORTER_ASSERT(reporter, 0 == memcmp(a.fPixmap.addr(), b.fPixmap.addr(),
+                                                      a.fPixmap.computeByteSize()));
+            }
+        }
+    }
+}
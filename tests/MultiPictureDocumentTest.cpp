@@ -0,0 +1,71 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkCanvas.h"
+#include "SkMultiPictureDocument.h"
+#include "SkStream.h"
+#include "Test.h"
+
+static sk_sp<SkData> make_document(int pageCount) {
+    SkDynamicMemoryWStream stream;
+    sk_sp<SkDocument> doc = SkMakeMultiPictureDocument(&stream);
+    for (int i = 0; i < pageCount; ++i) {
+        SkCanvas* canvas = doc->beginPage(100 + i, 50);
+        SkPaint paint;
+        paint.setColor(SkColorSetARGB(0xFF, i * 20, 0, 0));
+        // An odd number of ops, so not every page ends on a 4-byte boundary.
+        for (int j = 0; j <= i; ++j) {
+            canvas->drawRect(SkRect::MakeXYWH(j, j, 10, 10), paint);
+        }
+        doc->endPage();
+    }
+    doc->close();
+    return stream.detachAsData();
+}
+
+DEF_TEST(MultiPictureDocument_read, r) {
+    constexpr int kPageCount = 5;
+    sk_sp<SkData> data = make_document(kPageCount);
+
+    SkMemoryStream stream(data);
+    REPORTER_ASSERT(r, SkMultiPictureDocumentReadPageCount(&stream) == kPageCount);
+    SkDocumentPage pages[kPageCount];
+    REPORTER_ASSERT(r, SkMultiPictureDocumentRead(&stream, pages, kPageCount));
+
+    std::unique_ptr<SkMultiPictureDocumentReader> reader =
+            SkMultiPictureDocumentReader::Make(data);
+    REPORTER_ASSERT(r, reader);
+    if (!reader) {
+        return;
+    }
+    REPORTER_ASSERT(r, reader->pageCount() == kPageCount);
+    // Read the pages out of order.
+    for (int i = kPageCount - 1; i >= 0; --i) {
+        REPORTER_ASSERT(r, pages[i].fSize == SkSize::Make(100 + i, 50));
+        REPORTER_ASSERT(r, reader->pageSize(i) == pages[i].fSize);
+        sk_sp<SkPicture> page = reader->readPage(i);
+        REPORTER_ASSERT(r, page && pages[i].fPicture);
+        if (page && pages[i].fPicture) {
+            REPORTER_ASSERT(r, page->approximateOpCount() == i + 1);
+            REPORTER_ASSERT(r, pages[i].fPicture->approximateOpCount() == i + 1);
+        }
+    }
+}
+
+DEF_TEST(MultiPictureDocument_truncated, r) {
+    sk_sp<SkData> data = make_document(3);
+    for (size_t size : { data->size() - 1, data->size() / 2, (size_t)30 }) {
+        std::unique_ptr<SkMultiPictureDocumentReader> reader =
+                SkMultiPictureDocumentReader::Make(SkData::MakeSubset(data.get(), 0, size));
+        if (reader) {
+            for (int i = 0; i < reader->pageCount(); ++i) {
+                (void)reader->readPage(i);
+            }
+        }
+    }
+    REPORTER_ASSERT(r, !SkMultiPictureDocumentReader::Make(SkData::MakeEmpty()));
+}
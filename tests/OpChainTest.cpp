@@ -201,39 +201,44 @@ DEF_GPUTEST(OpChainTest, reporter, /*ctxInfo*/) {
         for (int g = 1; g < kNumOps; ++g) {
             for (int c = 0; c < kNumCombinabilitiesPerGrouping; ++c) {
                 init_combinable(g, &combinable, &random);
-                GrTokenTracker tracker;
-                GrOpFlushState flushState(context->priv().getGpu(),
-                                          context->priv().resourceProvider(), &tracker);
-                GrRenderTargetOpList opList(context->priv().resourceProvider(),
-                                            sk_ref_sp(context->priv().opMemoryPool()),
-                                            proxy->asRenderTargetProxy(),
-                                            context->priv().auditTrail());
-                // This assumes the particular values of kRanges.
-                std::fill_n(result, result_width(), -1);
-                std::fill_n(validResult, result_width(), -1);
-                for (int i = 0; i < kNumOps; ++i) {
-                    int value = permutation[i];
-                    // factor out the repeats and then use the canonical starting position and range
-                    // to determine an actual range.
-                    int j = value % (kNumRanges * kNumOpPositions);
-                    int pos = j % kNumOpPositions;
-                    Range range = kRanges[j / kNumOpPositions];
-                    range.fOffset += pos;
-                    auto op = TestOp::Make(context.get(), value, range, result, &combinable);
-                    op->writeResult(validResult);
-                    opList.addOp(std::move(op), *context->priv().caps());
-                }
-                opList.makeClosed(*context->priv().caps());
-                opList.prepare(&flushState);
-                opList.execute(&flushState);
-                opList.endFlush();
+                // Check both the usual bounded lookback and unbounded merging with GrOpBoundsGrid.
+                for (bool unboundedOpMerging : {false, true}) {
+                    GrTokenTracker tracker;
+                    GrOpFlushState flushState(context->priv().getGpu(),
+                                              context->priv().resourceProvider(), &tracker);
+                    GrRenderTargetOpList opList(context->priv().resourceProvider(),
+                                                sk_ref_sp(context->priv().opMemoryPool()),
+                                                proxy->asRenderTargetProxy(),
+                                                context->priv().auditTrail(),
+                                                unboundedOpMerging);
+                    // This assumes the particular values of kRanges.
+                    std::fill_n(result, result_width(), -1);
+                    std::fill_n(validResult, result_width(), -1);
+                    for (int i = 0; i < kNumOps; ++i) {
+                        int value = permutation[i];
+                        // factor out the repeats and then use the canonical starting position and
+                        // range to determine an actual range.
+                        int j = value % (kNumRanges * kNumOpPositions);
+                        int pos = j % kNumOpPositions;
+                        Range range = kRanges[j / kNumOpPositions];
+                        range.fOffset += pos;
+                        auto op = TestOp::Make(context.get(), value, range, result, &combinable);
+                        op->writeResult(validResult);
+                        opList.addOp(std::move(op), *context->priv().caps());
+                    }
+                    opList.makeClosed(*context->priv().caps());
+                    opList.prepare(&flushState);
+                    opList.execute(&flushState);
+                    opList.endFlush();
 #if 0  // Useful to repeat a random configuration that fails the test while debugger attached.
-                if (!std::equal(result, result + result_width(), validResult)) {
-                    repeat = true;
-                }
+                    if (!std::equal(result, result + result_width(), validResult)) {
+                        repeat = true;
+                    }
 #endif
-                (void)repeat;
-                REPORTER_ASSERT(reporter, std::equal(result, result + result_width(), validResult));
+                    (void)repeat;
+                    REPORTER_ASSERT(reporter,
+                                    std::equal(result, result + result_width(), validResult));
+                }
             }
         }
     }
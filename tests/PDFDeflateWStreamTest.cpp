@@ -10,6 +10,7 @@
 #ifdef SK_SUPPORT_PDF
 
 #include "SkDeflate.h"
+#include "SkExecutor.h"
 #include "SkRandom.h"
 #include "SkTo.h"
 
@@ -167,4 +168,39 @@ DEF_TEST(SkPDF_DeflateWStream, r) {
     REPORTER_ASSERT(r, !emptyDeflateWStream.writeText("FOO"));
 }
 
+// Parallel blocks must stitch back into one zlib stream, whatever the block boundaries.
+DEF_TEST(SkPDF_DeflateWStream_parallel, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkRandom random(654321);
+    for (uint32_t size : {0u, 1u, 128u * 1024u, 128u * 1024u + 1u, 1000000u}) {
+        SkAutoTMalloc<uint8_t> buffer(size);
+        for (uint32_t j = 0; j < size; ++j) {
+            // Mix runs with noise so the blocks' dictionaries matter.
+            buffer[j] = (j % 97 < 50) ? (uint8_t)(j % 13) : (uint8_t)(random.nextU() & 0xff);
+        }
+        for (int level : {-1, 0, 1, 9}) {
+            SkDynamicMemoryWStream dynamicMemoryWStream;
+            {
+                SkDeflateWStream deflateWStream(&dynamicMemoryWStream, level, false,
+                                                executor.get());
+                uint32_t j = 0;
+                while (j < size) {
+                    uint32_t writeSize = SkTMin(size - j, random.nextRangeU(1, 70000));
+                    REPORTER_ASSERT(r, deflateWStream.write(&buffer[j], writeSize));
+                    j += writeSize;
+                }
+                REPORTER_ASSERT(r, deflateWStream.bytesWritten() == size);
+            }
+            std::unique_ptr<SkStreamAsset> compressed(dynamicMemoryWStream.detachAsStream());
+            std::unique_ptr<SkStreamAsset> decompressed(stream_inflate(r, compressed.get()));
+            if (!decompressed || decompressed->getLength() != size) {
+                ERRORF(r, "Decompression failed, size %u level %d.", (unsigned)size, level);
+                continue;
+            }
+            REPORTER_ASSERT(r, size == 0 ||
+                               0 == memcmp(decompressed->getMemoryBase(), buffer.get(), size));
+        }
+    }
+}
+
 #endif
@@ -241,6 +241,26 @@ DEF_TEST(SkPDF_multiple_pages, r) {
     }
 }
 
+// Pages are written as they end, not held until the document is closed.
+DEF_TEST(SkPDF_pages_written_at_end_page, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_pages_written_at_end_page, r);
+    SkDynamicMemoryWStream wStream;
+    auto doc = SkPDF::MakeDocument(&wStream);
+    const int n = 20;
+    for (int i = 0; i < n; ++i) {
+        doc->beginPage(612, 792)->drawColor(SK_ColorGREEN);
+        doc->endPage();
+        SkString structParents;
+        structParents.printf("/StructParents %d", i);
+        sk_sp<SkData> data = SkData::MakeUninitialized(wStream.bytesWritten());
+        wStream.copyTo(data->writable_data());
+        REPORTER_ASSERT(r, contains(data->bytes(), data->size(), structParents.c_str()));
+    }
+    doc->close();
+    sk_sp<SkData> data = wStream.detachAsData();
+    REPORTER_ASSERT(r, contains(data->bytes(), data->size(), "/Count 20"));
+}
+
 // Test to make sure that jobs launched by PDF backend don't cause a segfault
 // after calling abort().
 DEF_TEST(SkPDF_abort_jobs, rep) {
@@ -256,3 +276,51 @@ DEF_TEST(SkPDF_abort_jobs, rep) {
     doc->abort();
 }
 
+
+static int trailer_size(SkDynamicMemoryWStream* stream) {
+    sk_sp<SkData> data = stream->detachAsData();
+    SkString pdf((const char*)data->data(), data->size());
+    int index = pdf.find("/Size ");
+    return index < 0 ? -1 : atoi(pdf.c_str() + index + strlen("/Size "));
+}
+
+static void draw_text_pages(SkDocument* doc, int n) {
+    SkFont portable(sk_tool_utils::create_portable_typeface(), 12);
+    SkFont trueType(MakeResourceAsTypeface("fonts/Roboto-Regular.ttf"), 12);
+    for (int i = 0; i < n; ++i) {
+        SkCanvas* canvas = doc->beginPage(612, 792);
+        SkString text;
+        text.printf("Page %d of %d", i + 1, n);
+        canvas->drawString(text, 72, 72, portable, SkPaint());
+        canvas->drawString(text, 72, 144, trueType, SkPaint());
+        doc->endPage();
+    }
+}
+
+// With an executor, fonts and page contents are serialized on other threads.  The objects may
+// come out in a different order, but the same objects must all be there.
+DEF_TEST(SkPDF_parallel_pages, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_parallel_pages, r);
+    const int n = 200;  // More than the document lets be in flight at once.
+
+    SkDynamicMemoryWStream serial;
+    {
+        auto doc = SkPDF::MakeDocument(&serial);
+        draw_text_pages(doc.get(), n);
+        doc->close();
+    }
+
+    SkDynamicMemoryWStream parallel;
+    {
+        std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+        SkPDF::Metadata metadata;
+        metadata.fExecutor = executor.get();
+        auto doc = SkPDF::MakeDocument(&parallel, metadata);
+        draw_text_pages(doc.get(), n);
+        doc->close();
+    }
+
+    int serialSize = trailer_size(&serial);
+    REPORTER_ASSERT(r, serialSize > n);
+    REPORTER_ASSERT(r, serialSize == trailer_size(&parallel));
+}
@@ -255,4 +255,62 @@ DEF_TEST(SkPDF_JpegIdentification, r) {
         REPORTER_ASSERT(r, !SkIsJFIF(data.get(), &info));
     }
 }
+
+#include "SkImageEncoder.h"
+#include "SkPngInfo.h"
+
+static sk_sp<SkData> encode_png(bool opaque) {
+    SkBitmap bm;
+    bm.allocN32Pixels(37, 21, opaque);
+    for (int y = 0; y < bm.height(); ++y) {
+        for (int x = 0; x < bm.width(); ++x) {
+            *bm.getAddr32(x, y) = SkPreMultiplyARGB(opaque ? 0xFF : (x * 7) & 0xFF,
+                                                    x * 6, y * 12, (x * y) & 0xFF);
+        }
+    }
+    return SkEncodeBitmap(bm, SkEncodedImageFormat::kPNG, 100);
+}
+
+/**
+ *  Test that opaque 8-bit PNGs have their compressed data embedded into the PDF directly, and
+ *  that PNGs with alpha are not.
+ */
+DEF_TEST(SkPDF_PngEmbedTest, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_PngEmbedTest, r);
+    sk_sp<SkData> opaquePng = encode_png(true);
+    sk_sp<SkData> alphaPng = encode_png(false);
+    if (!opaquePng || !alphaPng) {
+        INFOF(r, "\nSkPDF_PngEmbedTest: no PNG encoder.\n");
+        return;
+    }
+
+    SkISize size;
+    int components;
+    sk_sp<SkData> idat;
+    REPORTER_ASSERT(r, !SkGetPngInfo(alphaPng, &size, &components, &idat));
+    REPORTER_ASSERT(r, SkGetPngInfo(opaquePng, &size, &components, &idat));
+    REPORTER_ASSERT(r, size == (SkISize{37, 21}));
+    REPORTER_ASSERT(r, components == 3);
+    REPORTER_ASSERT(r, idat && idat->size() > 0);
+
+    // Truncated data and a broken signature are rejected.
+    sk_sp<SkData> ignored;
+    REPORTER_ASSERT(r, !SkGetPngInfo(SkData::MakeSubset(opaquePng.get(), 0, 40),
+                                     &size, &components, &ignored));
+    REPORTER_ASSERT(r, !SkGetPngInfo(SkData::MakeSubset(opaquePng.get(), 1,
+                                                        opaquePng->size() - 1),
+                                     &size, &components, &ignored));
+
+    SkDynamicMemoryWStream pdf;
+    auto document = SkPDF::MakeDocument(&pdf);
+    SkCanvas* canvas = document->beginPage(100, 100);
+    canvas->drawImage(SkImage::MakeFromEncoded(opaquePng), 0, 0);
+    document->endPage();
+    document->close();
+    sk_sp<SkData> pdfData = pdf.detachAsData();
+
+    #ifndef SK_PDF_BASE85_BINARY
+    REPORTER_ASSERT(r, is_subset_of(idat.get(), pdfData.get()));
+    #endif
+}
 #endif
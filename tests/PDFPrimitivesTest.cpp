@@ -320,6 +320,23 @@ DEF_TEST(SkPDF_FontCanEmbedTypeface, reporter) {
                     SkPDFFont::CanEmbedTypeface(portableTypeface.get(), &doc));
 }
 
+// Typeface metrics and unicode maps are computed once and shared between documents.
+DEF_TEST(SkPDF_FontDataSharedBetweenDocuments, reporter) {
+    sk_sp<SkTypeface> typeface(sk_tool_utils::create_portable_typeface(nullptr, SkFontStyle()));
+    SkNullWStream nullWStream1, nullWStream2;
+    SkPDFDocument doc1(&nullWStream1, SkPDF::Metadata());
+    SkPDFDocument doc2(&nullWStream2, SkPDF::Metadata());
+
+    const SkAdvancedTypefaceMetrics* metrics1 = SkPDFFont::GetMetrics(typeface.get(), &doc1);
+    const SkAdvancedTypefaceMetrics* metrics2 = SkPDFFont::GetMetrics(typeface.get(), &doc2);
+    REPORTER_ASSERT(reporter, metrics1);
+    REPORTER_ASSERT(reporter, metrics1 == metrics2);
+
+    const std::vector<SkUnichar>& map1 = SkPDFFont::GetUnicodeMap(typeface.get(), &doc1);
+    const std::vector<SkUnichar>& map2 = SkPDFFont::GetUnicodeMap(typeface.get(), &doc2);
+    REPORTER_ASSERT(reporter, &map1 == &map2);
+    REPORTER_ASSERT(reporter, (int)map1.size() == typeface->countGlyphs());
+}
 
 // test to see that all finite scalars round trip via scanf().
 static void check_pdf_scalar_serialization(
@@ -306,3 +306,105 @@ DEF_TEST(contour_measure, reporter) {
     test_empty_contours(reporter);
     test_MLM_contours(reporter);
 }
+
+// SkPathMeasure remembers where its last query ended. Its answers must match the unhinted
+// SkContourMeasure ones for queries walking forward, jumping ahead, and going back.
+DEF_TEST(PathMeasure_segmentHint, reporter) {
+    SkPath path;
+    path.moveTo(0, 0);
+    for (int i = 1; i < 200; ++i) {
+        path.lineTo(SkIntToScalar(i), SkIntToScalar((i * 7) % 5));
+    }
+
+    SkPathMeasure meas(path, false);
+    auto contour = SkContourMeasureIter(path, false).next();
+    REPORTER_ASSERT(reporter, contour);
+    const SkScalar length = meas.getLength();
+
+    const SkScalar distances[] = { 0, 0.5f, 1, 1.5f, 3, 3, 10, 200, 2, 150.25f, length };
+    for (SkScalar d : distances) {
+        SkScalar startD = SkTMin(d, length),
+                 stopD  = SkTMin(d + 0.75f, length);
+
+        SkPath hinted, unhinted;
+        REPORTER_ASSERT(reporter, meas.getSegment(startD, stopD, &hinted, true) ==
+                                  contour->getSegment(startD, stopD, &unhinted, true));
+        REPORTER_ASSERT(reporter, hinted == unhinted);
+
+        SkPoint hintedPos, unhintedPos;
+        SkVector hintedTan, unhintedTan;
+        REPORTER_ASSERT(reporter, meas.getPosTan(startD, &hintedPos, &hintedTan));
+        REPORTER_ASSERT(reporter, contour->getPosTan(startD, &unhintedPos, &unhintedTan));
+        REPORTER_ASSERT(reporter, hintedPos == unhintedPos && hintedTan == unhintedTan);
+    }
+}
+
+DEF_TEST(contour_measure_batchPosTan, reporter) {
+    SkPath path;
+    path.moveTo(0, 0);
+    path.cubicTo(100, 0, 0, 100, 100, 100);
+    path.quadTo(200, 0, 300, 100);
+
+    auto contour = SkContourMeasureIter(path, false).next();
+    REPORTER_ASSERT(reporter, contour);
+    const SkScalar length = contour->length();
+
+    const SkScalar distances[] = { -1, 0, 10, 20.5f, 100, length / 2, 5, length, length + 1 };
+    constexpr int kCount = SK_ARRAY_COUNT(distances);
+    SkPoint positions[kCount];
+    SkVector tangents[kCount];
+    REPORTER_ASSERT(reporter, contour->getPosTan(distances, kCount, positions, tangents));
+    REPORTER_ASSERT(reporter, contour->getPosTan(distances, kCount, nullptr, tangents));
+    for (int i = 0; i < kCount; ++i) {
+        SkPoint pos;
+        SkVector tan;
+        REPORTER_ASSERT(reporter, contour->getPosTan(distances[i], &pos, &tan));
+        REPORTER_ASSERT(reporter, pos == positions[i] && tan == tangents[i]);
+    }
+
+    const SkScalar badDistances[] = { 1, SK_ScalarNaN };
+    REPORTER_ASSERT(reporter, !contour->getPosTan(badDistances, 2, positions, nullptr));
+}
+
+#include "SkContourMeasureCache.h"
+
+DEF_TEST(PathMeasure_cache, reporter) {
+    SkPath path;
+    path.moveTo(0, 0);
+    path.cubicTo(100, 0, 0, 100, 100, 100);
+    path.lineTo(0, 100);
+    path.close();
+    path.moveTo(200, 0);
+    path.quadTo(300, 0, 300, 100);
+
+    SkContourMeasureCache::Contours first, second;
+    REPORTER_ASSERT(reporter, SkContourMeasureCache::FindOrMake(path, false, 1, &first));
+    REPORTER_ASSERT(reporter, SkContourMeasureCache::FindOrMake(path, false, 1, &second));
+    REPORTER_ASSERT(reporter, first.count() == 2 && second.count() == 2);
+    for (int i = 0; i < first.count(); ++i) {
+        // Either the second call shared the first's measures, or the cache had no room for them.
+        REPORTER_ASSERT(reporter, first[i]->length() == second[i]->length());
+        REPORTER_ASSERT(reporter, first[i]->isClosed() == second[i]->isClosed());
+    }
+
+    // The cached measures match what SkPathMeasure computes for the same path.
+    SkPathMeasure meas(path, false);
+    for (const auto& contour : first) {
+        REPORTER_ASSERT(reporter, meas.getLength() == contour->length());
+        meas.nextContour();
+    }
+
+    // A different resolution scale or forceClosed gets its own measures.
+    SkContourMeasureCache::Contours closed;
+    REPORTER_ASSERT(reporter, SkContourMeasureCache::FindOrMake(path, true, 1, &closed));
+    REPORTER_ASSERT(reporter, closed.count() == 2 && closed[1]->isClosed());
+
+    // Editing the path gives it a new generation ID, so the old measures aren't returned.
+    path.lineTo(400, 100);
+    SkContourMeasureCache::Contours edited;
+    REPORTER_ASSERT(reporter, SkContourMeasureCache::FindOrMake(path, false, 1, &edited));
+    REPORTER_ASSERT(reporter, edited.count() == 2 && edited[1]->length() > first[1]->length());
+
+    path.setIsVolatile(true);
+    REPORTER_ASSERT(reporter, !SkContourMeasureCache::FindOrMake(path, false, 1, &edited));
+}
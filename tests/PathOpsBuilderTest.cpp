@@ -8,6 +8,7 @@
 #include "PathOpsExtendedTest.h"
 #include "PathOpsTestCommon.h"
 #include "SkBitmap.h"
+#include "SkExecutor.h"
 #include "Test.h"
 
 DEF_TEST(PathOpsBuilder, reporter) {
@@ -361,3 +362,55 @@ SkOpBuilder builder;
     builder.add(path1, SkPathOp::kUnion_SkPathOp);
     builder.resolve(&path);
 }
+
+DEF_TEST(SkOpBuilderUnionTree, reporter) {
+    // Two clusters of overlapping, non-convex shapes, plus a far away loner.
+    SkTArray<SkPath> paths;
+    for (int cluster = 0; cluster < 2; ++cluster) {
+        for (int i = 0; i < 9; ++i) {
+            SkPath path;
+            SkScalar x = cluster * 100 + i * 6;
+            path.moveTo(x, 10);
+            path.lineTo(x + 10, 10);
+            path.lineTo(x + 10, 30);
+            path.lineTo(x + 5, 20);
+            path.lineTo(x, 30);
+            path.close();
+            paths.push_back(path);
+        }
+    }
+    SkPath loner;
+    loner.addCircle(300, 50, 10);
+    paths.push_back(loner);
+
+    SkOpBuilder builder;
+    for (const SkPath& path : paths) {
+        builder.add(path, kUnion_SkPathOp);
+    }
+    SkPath serial;
+    REPORTER_ASSERT(reporter, builder.resolve(&serial));
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (const SkPath& path : paths) {
+        builder.add(path, kUnion_SkPathOp);
+    }
+    SkPath tree;
+    REPORTER_ASSERT(reporter, builder.resolve(&tree, executor.get()));
+    REPORTER_ASSERT(reporter, tree.getBounds() == serial.getBounds());
+    int pixelDiff = comparePaths(reporter, __FUNCTION__, serial, tree);
+    REPORTER_ASSERT(reporter, pixelDiff == 0);
+
+    // A difference anywhere falls back to applying the ops in order.
+    SkPath hole;
+    hole.addRect(SkRect::MakeXYWH(20, 15, 10, 5));
+    SkPath expected;
+    REPORTER_ASSERT(reporter, Op(serial, hole, kDifference_SkPathOp, &expected));
+    for (const SkPath& path : paths) {
+        builder.add(path, kUnion_SkPathOp);
+    }
+    builder.add(hole, kDifference_SkPathOp);
+    SkPath result;
+    REPORTER_ASSERT(reporter, builder.resolve(&result, executor.get()));
+    pixelDiff = comparePaths(reporter, __FUNCTION__, expected, result);
+    REPORTER_ASSERT(reporter, pixelDiff == 0);
+}
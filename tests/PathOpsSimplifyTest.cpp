@@ -9357,11 +9357,28 @@ static void bug8290(skiatest::Reporter* reporter, const char* filename) {
     testSimplify(reporter, path, filename);
 }
 
+// Enough contours to take the grid broad phase in AddAllIntersectTs: a wide row of small,
+// partly overlapping triangles, plus a tall bar crossing many of them.
+static void manyContours(skiatest::Reporter* reporter, const char* filename) {
+    SkPath path;
+    for (int i = 0; i < 60; ++i) {
+        SkScalar x = i * 5.f;
+        SkScalar y = (i % 3) * 2.f;
+        path.moveTo(x, y);
+        path.lineTo(x + 7, y);
+        path.lineTo(x + 3, y + 6);
+        path.close();
+    }
+    path.addRect(SkRect::MakeLTRB(40, -2, 41, 10));
+    testSimplify(reporter, path, filename);
+}
+
 static void (*skipTest)(skiatest::Reporter* , const char* filename) = nullptr;
 static void (*firstTest)(skiatest::Reporter* , const char* filename) = nullptr;
 static void (*stopTest)(skiatest::Reporter* , const char* filename) = nullptr;
 
 static TestDesc tests[] = {
+    TEST(manyContours),
     TEST(bug8290),
     TEST(bug8249),
     TEST(grshapearc),
@@ -33,7 +33,8 @@ static void draw_path(GrContext* ctx,
                       const SkPath& path,
                       GrPathRenderer* pr,
                       GrAAType aaType,
-                      const GrStyle& style) {
+                      const GrStyle& style,
+                      const SkMatrix& matrix = SkMatrix::I()) {
     GrPaint paint;
     paint.setXPFactory(GrPorterDuffXPFactory::Get(SkBlendMode::kSrc));
 
@@ -44,7 +45,6 @@ static void draw_path(GrContext* ctx,
     if (shape.style().applies()) {
         shape = shape.applyStyle(GrStyle::Apply::kPathEffectAndStrokeRec, 1.0f);
     }
-    SkMatrix matrix = SkMatrix::I();
     GrPathRenderer::DrawPathArgs args{ctx,
                                       std::move(paint),
                                       &GrUserStencilSettings::kUnused,
@@ -130,6 +130,49 @@ DEF_GPUTEST(TessellatingPathRendererCacheTest, reporter, /* options */) {
     paint.setStrokeWidth(1);
     GrStyle style(paint);
     test_path(reporter, create_concave_path, createPR, kExpectedResources, GrAAType::kNone, style);
+
+    // AA paths are cached too, in device space.
+    test_path(reporter, create_concave_path, createPR, kExpectedResources, GrAAType::kCoverage);
+}
+
+// Test that AA tessellations are reused when the view matrix only translates or slightly scales
+DEF_GPUTEST(TessellatingPathRendererAAReuseTest, reporter, /* options */) {
+    sk_sp<GrContext> ctx = GrContext::MakeMock(nullptr);
+    ctx->setResourceCacheLimits(100, 8000000);
+    GrResourceCache* cache = ctx->priv().getResourceCache();
+
+    const GrBackendFormat format =
+            ctx->priv().caps()->getBackendFormatFromColorType(kRGBA_8888_SkColorType);
+    sk_sp<GrRenderTargetContext> rtc(ctx->priv().makeDeferredRenderTargetContext(
+            format, SkBackingFit::kApprox, 800, 800, kRGBA_8888_GrPixelConfig, nullptr, 1,
+            GrMipMapped::kNo, kTopLeft_GrSurfaceOrigin));
+    if (!rtc) {
+        return;
+    }
+
+    sk_sp<GrPathRenderer> pathRenderer(new GrTessellatingPathRenderer());
+    SkPath path = create_concave_path();
+    GrStyle style(SkStrokeRec::kFill_InitStyle);
+    auto drawAt = [&](const SkMatrix& matrix) {
+        draw_path(ctx.get(), rtc.get(), path, pathRenderer.get(), GrAAType::kCoverage, style,
+                  matrix);
+        ctx->flush();
+    };
+
+    drawAt(SkMatrix::I());
+    REPORTER_ASSERT(reporter, cache_non_scratch_resources_equals(cache, 1));
+
+    // Translating and scaling by 2% reuse the cached vertices.
+    drawAt(SkMatrix::MakeTrans(13.5f, 7.25f));
+    SkMatrix scaled = SkMatrix::MakeScale(1.02f);
+    scaled.postTranslate(3, 4);
+    drawAt(scaled);
+    REPORTER_ASSERT(reporter, cache_non_scratch_resources_equals(cache, 1));
+
+    // Doubling the scale retessellates, replacing the cached vertices under the same key.
+    drawAt(SkMatrix::MakeScale(2));
+    cache->purgeAsNeeded();
+    REPORTER_ASSERT(reporter, cache_non_scratch_resources_equals(cache, 1));
 }
 
 // Test that deleting the original path invalidates the textures cached by the SW path renderer
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "SkArenaAlloc.h"
 #include "SkAutoMalloc.h"
 #include "SkCanvas.h"
 #include "SkFont.h"
@@ -4921,6 +4922,47 @@ DEF_TEST(PathRefSerialization, reporter) {
     }
 }
 
+DEF_TEST(PathSerialization_contours, reporter) {
+    auto roundTrip = [reporter](const SkPath& path) {
+        sk_sp<SkData> data = path.serialize();
+        SkPath readBack;
+        REPORTER_ASSERT(reporter, readBack.readFromMemory(data->data(), data->size()) ==
+                                  data->size());
+        REPORTER_ASSERT(reporter, readBack == path);
+
+        // Both should also agree on where the next contour starts.
+        SkPath expected = path;
+        expected.lineTo(7, 9);
+        readBack.lineTo(7, 9);
+        REPORTER_ASSERT(reporter, readBack == expected);
+        REPORTER_ASSERT(reporter, readBack.getBounds() == expected.getBounds());
+    };
+
+    SkPath path;
+    roundTrip(path);
+    path.moveTo(1, 2);
+    roundTrip(path);
+    path.lineTo(3, 4).quadTo(5, 6, 7, 8).conicTo(1, 9, 3, 1, 0.5f).cubicTo(2, 2, 4, 4, 6, 0);
+    roundTrip(path);
+    path.close();
+    roundTrip(path);
+    path.moveTo(10, 10).lineTo(20, 10).close().moveTo(5, 5).moveTo(6, 6).lineTo(8, 1);
+    roundTrip(path);
+
+    // A weight of 1 is not kept as a conic when building a path, so reading one back gives
+    // the same path as building it.
+    SkPath conic;
+    conic.moveTo(0, 0).conicTo(10, 0, 10, 10, 0.5f);
+    sk_sp<SkData> data = conic.serialize();
+    SkScalar one = 1;
+    size_t weightOffset = 4 * sizeof(int32_t) + 3 * sizeof(SkPoint);
+    memcpy((char*)data->writable_data() + weightOffset, &one, sizeof(SkScalar));
+    SkPath readBack, quad;
+    quad.moveTo(0, 0).quadTo(10, 0, 10, 10);
+    REPORTER_ASSERT(reporter, readBack.readFromMemory(data->data(), data->size()));
+    REPORTER_ASSERT(reporter, readBack == quad);
+}
+
 DEF_TEST(NonFinitePathIteration, reporter) {
     SkPath path;
     path.moveTo(SK_ScalarInfinity, SK_ScalarInfinity);
@@ -5449,3 +5491,173 @@ DEF_TEST(path_last_move_to_index, r) {
 
     copyPath.rConicTo(1, 1, 3, 3, 0.707107f);
 }
+
+DEF_TEST(Path_arenaStorage, r) {
+    SkPath heapCopy;
+    SkPath expected;
+    {
+        SkSTArenaAlloc<256> arena;
+        SkPath path;
+        SkPathPriv::UseArenaStorage(&path, &arena);
+        REPORTER_ASSERT(r, SkPathPriv::IsArenaBacked(path));
+        REPORTER_ASSERT(r, path.isEmpty());
+
+        // Grow well past the inline storage.
+        for (int i = 0; i < 500; i++) {
+            path.lineTo(SkIntToScalar(i), SkIntToScalar(i % 7));
+            expected.lineTo(SkIntToScalar(i), SkIntToScalar(i % 7));
+        }
+        path.conicTo(1, 2, 3, 4, 0.5f);
+        expected.conicTo(1, 2, 3, 4, 0.5f);
+        REPORTER_ASSERT(r, SkPathPriv::IsArenaBacked(path));
+        REPORTER_ASSERT(r, path == expected);
+        REPORTER_ASSERT(r, path.getBounds() == expected.getBounds());
+
+        // Copies escape to the heap.
+        heapCopy = path;
+        REPORTER_ASSERT(r, !SkPathPriv::IsArenaBacked(heapCopy));
+        SkPath copied(path);
+        REPORTER_ASSERT(r, !SkPathPriv::IsArenaBacked(copied));
+        SkPath transformed;
+        path.transform(SkMatrix::I(), &transformed);
+        REPORTER_ASSERT(r, !SkPathPriv::IsArenaBacked(transformed));
+
+        // Rewinding keeps the arena storage for reuse.
+        path.rewind();
+        REPORTER_ASSERT(r, SkPathPriv::IsArenaBacked(path));
+        path.addRect(SkRect::MakeWH(10, 10));
+        REPORTER_ASSERT(r, path.getBounds() == SkRect::MakeWH(10, 10));
+    }
+    REPORTER_ASSERT(r, heapCopy == expected);
+}
+
+DEF_TEST(Path_Make, r) {
+    SkPath expected;
+    expected.moveTo(1, 2);
+    expected.lineTo(3, 4);
+    expected.quadTo(5, 6, 7, 8);
+    expected.conicTo(9, 10, 11, 12, 0.5f);
+    expected.cubicTo(13, 14, 15, 16, 17, 18);
+    expected.close();
+    expected.setFillType(SkPath::kEvenOdd_FillType);
+
+    const SkPoint pts[] = {
+        {1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10}, {11, 12}, {13, 14}, {15, 16}, {17, 18},
+    };
+    const uint8_t verbs[] = {
+        SkPath::kMove_Verb, SkPath::kLine_Verb, SkPath::kQuad_Verb, SkPath::kConic_Verb,
+        SkPath::kCubic_Verb, SkPath::kClose_Verb,
+    };
+    const SkScalar weights[] = { 0.5f };
+
+    SkPath path = SkPath::Make(pts, SK_ARRAY_COUNT(pts), verbs, SK_ARRAY_COUNT(verbs),
+                               weights, 1, SkPath::kEvenOdd_FillType);
+    REPORTER_ASSERT(r, path == expected);
+    REPORTER_ASSERT(r, path.getBounds() == expected.getBounds());
+    REPORTER_ASSERT(r, path.getSegmentMasks() == expected.getSegmentMasks());
+
+    // Drawing after a trailing close starts a new contour at the last moveTo, as it would have.
+    path.lineTo(20, 20);
+    expected.lineTo(20, 20);
+    REPORTER_ASSERT(r, path == expected);
+
+    // Inconsistent input makes an empty path.
+    REPORTER_ASSERT(r, SkPath::Make(pts, 8, verbs, SK_ARRAY_COUNT(verbs), weights, 1,
+                                    SkPath::kWinding_FillType).isEmpty());
+    REPORTER_ASSERT(r, SkPath::Make(pts, SK_ARRAY_COUNT(pts), verbs, SK_ARRAY_COUNT(verbs),
+                                    weights, 0, SkPath::kWinding_FillType).isEmpty());
+    REPORTER_ASSERT(r, SkPath::Make(pts + 1, 8, verbs + 1, SK_ARRAY_COUNT(verbs) - 1,
+                                    weights, 1, SkPath::kWinding_FillType).isEmpty());
+    const uint8_t badVerb[] = { SkPath::kMove_Verb, SkPath::kDone_Verb };
+    REPORTER_ASSERT(r, SkPath::Make(pts, 1, badVerb, 2, nullptr, 0,
+                                    SkPath::kWinding_FillType).isEmpty());
+}
+
+DEF_TEST(Path_polylineTo, r) {
+    SkPoint pts[100];
+    for (int i = 0; i < 100; ++i) {
+        pts[i].set(SkIntToScalar(i), SkIntToScalar(i * i % 13));
+    }
+
+    SkPath expected;
+    for (const SkPoint& pt : pts) {
+        expected.lineTo(pt);
+    }
+    SkPath path;
+    path.incReserve(100, 101);
+    path.polylineTo(pts, 100);
+    REPORTER_ASSERT(r, path == expected);
+    REPORTER_ASSERT(r, path.getBounds() == expected.getBounds());
+
+    path.close();
+    expected.close();
+    path.polylineTo(pts, 3);
+    expected.lineTo(pts[0]).lineTo(pts[1]).lineTo(pts[2]);
+    REPORTER_ASSERT(r, path == expected);
+
+    path.polylineTo(pts, 0);
+    REPORTER_ASSERT(r, path == expected);
+}
+
+#include "SkPathContainsIndex.h"
+
+DEF_TEST(PathContainsIndex, r) {
+    SkRandom rand;
+    SkPath star;
+    for (int i = 0; i < 50; ++i) {
+        SkScalar radius = (i & 1) ? 40 : 100;
+        SkScalar angle = i * SK_ScalarPI * 2 / 50;
+        SkPoint pt = { 100 + radius * SkScalarCos(angle), 100 + radius * SkScalarSin(angle) };
+        if (i == 0) {
+            star.moveTo(pt);
+        } else {
+            star.lineTo(pt);
+        }
+    }
+    star.close();
+
+    SkPath curves;
+    curves.moveTo(10, 10);
+    curves.quadTo(200, 20, 150, 190);
+    curves.conicTo(100, 250, 30, 150, 0.5f);
+    curves.cubicTo(-50, 100, 100, 50, 10, 10);
+    curves.addOval(SkRect::MakeLTRB(50, 50, 120, 120));
+    curves.addCircle(100, 100, 30, SkPath::kCCW_Direction);
+    curves.addRect(SkRect::MakeLTRB(20, 20, 60, 60));
+    curves.addRect(SkRect::MakeLTRB(60, 20, 100, 60));
+
+    SkPath paths[] = { star, curves, SkPath(), SkPath().addRect(0, 0, 200, 0) };
+    for (SkPath path : paths) {
+        for (SkPath::FillType fillType : { SkPath::kWinding_FillType,
+                                           SkPath::kEvenOdd_FillType,
+                                           SkPath::kInverseWinding_FillType }) {
+            path.setFillType(fillType);
+            SkPathContainsIndex index(path);
+            REPORTER_ASSERT(r, index.isValidFor(path));
+
+            // Random points, plus the path's own points so that on-curve cases are covered.
+            SkTDArray<SkPoint> pts;
+            for (int i = 0; i < 500; ++i) {
+                pts.push_back({ rand.nextRangeScalar(-10, 210), rand.nextRangeScalar(-10, 210) });
+            }
+            for (int i = 0; i < path.countPoints(); ++i) {
+                pts.push_back(path.getPoint(i));
+            }
+            SkAutoTMalloc<bool> results(pts.count());
+            index.contains(pts.begin(), pts.count(), results.get());
+            for (int i = 0; i < pts.count(); ++i) {
+                bool expected = path.contains(pts[i].fX, pts[i].fY);
+                REPORTER_ASSERT(r, index.contains(pts[i].fX, pts[i].fY) == expected);
+                REPORTER_ASSERT(r, results[i] == expected);
+            }
+        }
+    }
+
+    SkPath path(star);
+    SkPathContainsIndex index(path);
+    path.setFillType(SkPath::kEvenOdd_FillType);
+    REPORTER_ASSERT(r, !index.isValidFor(path));
+    path = star;
+    path.lineTo(0, 0);
+    REPORTER_ASSERT(r, !index.isValidFor(path));
+}
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkPicture.h"
 #include "SkPictureRecorder.h"
@@ -78,3 +79,35 @@ DEF_TEST(PictureShader_caching, reporter) {
     // All but the local ref should be gone now.
     REPORTER_ASSERT(reporter, picture->unique());
 }
+
+// Large tiles are rasterized in bands; the seams between bands must not show.
+DEF_TEST(PictureShader_bandedTile, reporter) {
+    SkPictureRecorder recorder;
+    SkCanvas* recordingCanvas = recorder.beginRecording(300, 300);
+    SkPaint circlePaint;
+    circlePaint.setAntiAlias(true);
+    circlePaint.setColor(SK_ColorBLUE);
+    recordingCanvas->drawCircle(150, 150, 140, circlePaint);
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    SkImageInfo info = SkImageInfo::MakeN32Premul(300, 300);
+    SkBitmap expected, actual;
+    expected.allocPixels(info);
+    actual.allocPixels(info);
+    expected.eraseColor(SK_ColorTRANSPARENT);
+    actual.eraseColor(SK_ColorTRANSPARENT);
+
+    SkCanvas(expected).drawPicture(picture);
+
+    SkPaint paint;
+    paint.setShader(SkPictureShader::Make(picture, SkShader::kClamp_TileMode,
+                                          SkShader::kClamp_TileMode, nullptr, nullptr));
+    SkCanvas(actual).drawPaint(paint);
+
+    for (int y = 0; y < 300; ++y) {
+        if (memcmp(expected.getAddr32(0, y), actual.getAddr32(0, y), 300 * sizeof(uint32_t))) {
+            ERRORF(reporter, "picture shader tile differs from the picture on row %d", y);
+            return;
+        }
+    }
+}
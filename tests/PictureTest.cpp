@@ -12,9 +12,12 @@
 #include "SkCanvas.h"
 #include "SkClipOp.h"
 #include "SkClipOpPriv.h"
+#include "SkColorFilter.h"
 #include "SkColor.h"
 #include "SkData.h"
+#include "SkExecutor.h"
 #include "SkFontStyle.h"
+#include "SkImage.h"
 #include "SkImageInfo.h"
 #include "SkMatrix.h"
 #include "SkMiniRecorder.h"
@@ -879,3 +882,217 @@ DEF_TEST(Picture_empty_serial, reporter) {
     REPORTER_ASSERT(reporter, pic2);
 }
 
+
+DEF_TEST(Picture_playbackTiled, r) {
+    SkRTreeFactory factory;
+    SkPictureRecorder recorder;
+    SkCanvas* c = recorder.beginRecording(SkRect::MakeWH(200, 150), &factory);
+    SkRandom rand;
+    SkPaint paint;
+    for (int i = 0; i < 50; i++) {
+        paint.setColor(rand.nextU() | 0xFF000000);
+        c->drawCircle(rand.nextRangeF(0, 200), rand.nextRangeF(0, 150),
+                      rand.nextRangeF(2, 40), paint);
+    }
+    sk_sp<SkPicture> pic = recorder.finishRecordingAsPicture();
+
+    auto info = SkImageInfo::MakeN32Premul(200, 150);
+    SkBitmap serial, tiled;
+    serial.allocPixels(info);
+    tiled .allocPixels(info);
+    serial.eraseColor(SK_ColorWHITE);
+    tiled .eraseColor(SK_ColorWHITE);
+
+    {
+        SkCanvas canvas(serial);
+        canvas.translate(3, 5);
+        pic->playback(&canvas);
+    }
+    {
+        std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+        SkCanvas canvas(tiled);
+        canvas.translate(3, 5);
+        pic->playbackTiled(&canvas, executor.get(), {32, 32});
+    }
+
+    REPORTER_ASSERT(r, 0 == memcmp(serial.getPixels(), tiled.getPixels(),
+                                   serial.computeByteSize()));
+}
+
+DEF_TEST(Picture_MakeFromMappedData, r) {
+    SkBitmap bm;
+    bm.allocN32Pixels(16, 16);
+    bm.eraseColor(SK_ColorBLUE);
+    sk_sp<SkImage> image = SkImage::MakeFromEncoded(SkImage::MakeFromBitmap(bm)->encodeToData());
+    REPORTER_ASSERT(r, image);
+
+    SkPictureRecorder recorder;
+    SkCanvas* c = recorder.beginRecording(SkRect::MakeWH(64, 64));
+    c->drawCircle(20, 20, 10, SkPaint());
+    c->drawImage(image, 30, 30);
+    sk_sp<SkPicture> nested = recorder.finishRecordingAsPicture();
+
+    c = recorder.beginRecording(SkRect::MakeWH(64, 64));
+    c->drawRect(SkRect::MakeXYWH(0, 40, 20, 20), SkPaint());
+    c->drawPicture(nested);
+    c->drawPicture(nested);
+    sk_sp<SkPicture> pic = recorder.finishRecordingAsPicture();
+
+    sk_sp<SkData> data = pic->serialize();
+    sk_sp<SkPicture> mapped = SkPicture::MakeFromMappedData(data);
+    REPORTER_ASSERT(r, mapped);
+    REPORTER_ASSERT(r, mapped->approximateOpCount() == pic->approximateOpCount());
+
+    auto info = SkImageInfo::MakeN32Premul(64, 64);
+    SkBitmap expected, actual;
+    expected.allocPixels(info);
+    actual  .allocPixels(info);
+    expected.eraseColor(SK_ColorWHITE);
+    actual  .eraseColor(SK_ColorWHITE);
+    {
+        SkCanvas canvas(expected);
+        pic->playback(&canvas);
+    }
+    {
+        // The loaded picture must not need the caller's reference to the data.
+        data.reset();
+        SkCanvas canvas(actual);
+        mapped->playback(&canvas);
+    }
+    REPORTER_ASSERT(r, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                   expected.computeByteSize()));
+}
+
+DEF_TEST(Picture_nestedClippedPlayback, r) {
+    // Nested pictures recorded without a BBH build one for clipped playback.
+    // That must not change what is drawn.
+    SkRandom rand;
+    SkPaint paint;
+    SkPictureRecorder recorder;
+    SkCanvas* c = recorder.beginRecording(SkRect::MakeWH(100, 100));
+    for (int i = 0; i < 40; i++) {
+        paint.setColor(rand.nextU() | 0xFF000000);
+        c->drawRect(SkRect::MakeXYWH(rand.nextRangeF(0, 90), rand.nextRangeF(0, 90), 10, 10),
+                    paint);
+    }
+    sk_sp<SkPicture> nested = recorder.finishRecordingAsPicture();
+
+    c = recorder.beginRecording(SkRect::MakeWH(100, 100));
+    for (int i = 0; i < 10; i++) {
+        c->drawPicture(nested);
+        c->translate(3, 2);
+    }
+    sk_sp<SkPicture> pic = recorder.finishRecordingAsPicture();
+
+    auto info = SkImageInfo::MakeN32Premul(100, 100);
+    SkBitmap full, clipped;
+    full   .allocPixels(info);
+    clipped.allocPixels(info);
+    full   .eraseColor(SK_ColorWHITE);
+    clipped.eraseColor(SK_ColorWHITE);
+
+    const SkIRect clip = SkIRect::MakeXYWH(20, 30, 25, 15);
+    {
+        SkCanvas canvas(full);
+        pic->playback(&canvas);
+    }
+    for (int i = 0; i < 2; i++) {
+        // The second pass uses the BBHs the first one built.
+        SkCanvas canvas(clipped);
+        canvas.clipRect(SkRect::Make(clip));
+        pic->playback(&canvas);
+    }
+
+    for (int y = clip.top(); y < clip.bottom(); y++) {
+        REPORTER_ASSERT(r, 0 == memcmp(full.getAddr32(clip.left(), y),
+                                       clipped.getAddr32(clip.left(), y),
+                                       clip.width() * sizeof(uint32_t)));
+    }
+}
+
+DEF_TEST(Picture_reuseUnchanged, r) {
+    SkRTreeFactory factory;
+    SkPictureRecorder recorder;
+    auto record = [&](SkColor color, SkScalar x) {
+        SkCanvas* c = recorder.beginRecording(SkRect::MakeWH(100, 100), &factory,
+                                              SkPictureRecorder::kReuseUnchanged_RecordFlag);
+        SkPaint paint;
+        paint.setColor(color);
+        for (int i = 0; i < 10; i++) {
+            c->drawRect(SkRect::MakeXYWH(x + i, i * 5, 10, 10), paint);
+        }
+        SkPath path;
+        path.moveTo(x, 60);
+        path.lineTo(x + 20, 90);
+        path.lineTo(x, 90);
+        c->drawPath(path, paint);
+        return recorder.finishRecordingAsPicture();
+    };
+
+    sk_sp<SkPicture> first = record(SK_ColorRED, 10);
+    REPORTER_ASSERT(r, record(SK_ColorRED, 10) == first);
+
+    // Changed paints and geometry both produce a new picture.
+    sk_sp<SkPicture> blue = record(SK_ColorBLUE, 10);
+    REPORTER_ASSERT(r, blue != first);
+    REPORTER_ASSERT(r, blue->cullRect() == first->cullRect());
+    sk_sp<SkPicture> moved = record(SK_ColorBLUE, 20);
+    REPORTER_ASSERT(r, moved != blue);
+    REPORTER_ASSERT(r, moved->cullRect() != blue->cullRect());
+
+    // A picture that reused its predecessor's BBH still draws its own content.
+    SkBitmap bm;
+    bm.allocN32Pixels(100, 100);
+    bm.eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(bm);
+    canvas.clipRect(SkRect::MakeXYWH(0, 0, 40, 40));
+    blue->playback(&canvas);
+    REPORTER_ASSERT(r, bm.getColor(15, 5) == SK_ColorBLUE);
+
+    // Recording without the flag never hands back an earlier picture.
+    SkCanvas* c = recorder.beginRecording(SkRect::MakeWH(100, 100), &factory);
+    c->drawRect(SkRect::MakeWH(10, 10), SkPaint());
+    sk_sp<SkPicture> plain = recorder.finishRecordingAsPicture();
+    c = recorder.beginRecording(SkRect::MakeWH(100, 100), &factory);
+    c->drawRect(SkRect::MakeWH(10, 10), SkPaint());
+    REPORTER_ASSERT(r, recorder.finishRecordingAsPicture() != plain);
+}
+
+DEF_TEST(Picture_serializeSharesEqualFlattenables, r) {
+    auto record = [](bool sameFilter) {
+        SkPictureRecorder recorder;
+        SkCanvas* c = recorder.beginRecording(SkRect::MakeWH(100, 100));
+        for (int i = 0; i < 20; i++) {
+            SkPaint paint;
+            paint.setColor(SkColorSetARGB(0xFF, i * 10, 0, 0));
+            // Each paint gets its own filter object, equal or not.
+            paint.setColorFilter(SkColorFilter::MakeModeFilter(
+                    sameFilter ? SK_ColorBLUE : SkColorSetARGB(0x80, 0, 0, i * 10),
+                    SkBlendMode::kSrcATop));
+            c->drawRect(SkRect::MakeXYWH(i * 5, 0, 5, 100), paint);
+        }
+        return recorder.finishRecordingAsPicture();
+    };
+
+    sk_sp<SkData> same = record(true)->serialize();
+    sk_sp<SkData> different = record(false)->serialize();
+    REPORTER_ASSERT(r, same->size() < different->size());
+
+    for (const sk_sp<SkData>& data : { same, different }) {
+        sk_sp<SkPicture> picture = SkPicture::MakeFromData(data.get());
+        REPORTER_ASSERT(r, picture);
+        if (!picture) {
+            continue;
+        }
+        SkBitmap expected, actual;
+        expected.allocN32Pixels(100, 100);
+        actual.allocN32Pixels(100, 100);
+        expected.eraseColor(SK_ColorWHITE);
+        actual.eraseColor(SK_ColorWHITE);
+        SkCanvas expectedCanvas(expected), actualCanvas(actual);
+        record(data == same)->playback(&expectedCanvas);
+        picture->playback(&actualCanvas);
+        REPORTER_ASSERT(r, !memcmp(expected.getPixels(), actual.getPixels(),
+                                   expected.computeByteSize()));
+    }
+}
@@ -51,6 +51,16 @@ static void run_queries(skiatest::Reporter* reporter, SkRandom& rand, SkRect rec
         tree.search(query, &hits);
         REPORTER_ASSERT(reporter, verify_query(query, rects, hits));
     }
+
+    SkRect queries[NUM_QUERIES];
+    SkTDArray<int> results[NUM_QUERIES];
+    for (size_t i = 0; i < NUM_QUERIES; ++i) {
+        queries[i] = random_rect(rand);
+    }
+    tree.batchSearch(queries, NUM_QUERIES, results);
+    for (size_t i = 0; i < NUM_QUERIES; ++i) {
+        REPORTER_ASSERT(reporter, verify_query(queries[i], rects, results[i]));
+    }
 }
 
 DEF_TEST(RTree, reporter) {
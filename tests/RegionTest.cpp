@@ -9,6 +9,7 @@
 #include "SkPath.h"
 #include "SkRandom.h"
 #include "SkRegion.h"
+#include "SkTArray.h"
 #include "Test.h"
 
 static void Union(SkRegion* rgn, const SkIRect& rect) {
@@ -515,3 +516,66 @@ DEF_TEST(region_empty_iter, reporter) {
     REPORTER_ASSERT(reporter, !left);
     REPORTER_ASSERT(reporter, !right);
 }
+
+static SkRegion union_one_at_a_time(const SkIRect rects[], int count) {
+    SkRegion rgn;
+    for (int i = 0; i < count; i++) {
+        rgn.op(rects[i], SkRegion::kUnion_Op);
+    }
+    return rgn;
+}
+
+DEF_TEST(Region_setRects, reporter) {
+    SkRandom rand;
+    for (int count : {0, 1, 2, 3, 7, 64, 301}) {
+        SkTArray<SkIRect> rects;
+        for (int i = 0; i < count; i++) {
+            int x = rand.nextRangeU(0, 200);
+            int y = rand.nextRangeU(0, 200);
+            // Include some empty rects; they contribute nothing.
+            rects.push_back(SkIRect::MakeXYWH(x, y, rand.nextRangeU(0, 40),
+                                              rand.nextRangeU(0, 40)));
+        }
+        SkRegion rgn;
+        bool nonEmpty = rgn.setRects(rects.begin(), count);
+        REPORTER_ASSERT(reporter, nonEmpty == !rgn.isEmpty());
+        REPORTER_ASSERT(reporter, rgn == union_one_at_a_time(rects.begin(), count));
+    }
+}
+
+DEF_TEST(Region_rectRectOps, reporter) {
+    // Every pair of rects on a small grid, run through both the rect-rect fast paths and the
+    // general span merge, must produce the same region.
+    SkTArray<SkIRect> rects;
+    for (int l = 0; l < 4; l++) {
+        for (int t = 0; t < 4; t++) {
+            for (int r = l + 1; r <= 4; r++) {
+                for (int b = t + 1; b <= 4; b++) {
+                    rects.push_back(SkIRect::MakeLTRB(l, t, r, b));
+                }
+            }
+        }
+    }
+    // A fixed complex region to splice in, so the general path is forced.
+    const SkIRect far[] = {{10, 10, 11, 11}, {12, 12, 13, 13}};
+    SkRegion complex;
+    complex.setRects(far, SK_ARRAY_COUNT(far));
+
+    for (const SkIRect& a : rects) {
+        for (const SkIRect& b : rects) {
+            for (SkRegion::Op op : {SkRegion::kUnion_Op, SkRegion::kDifference_Op}) {
+                SkRegion fast(a);
+                fast.op(b, op);
+
+                SkRegion ca(a), cb(b);
+                ca.op(complex, SkRegion::kUnion_Op);
+                cb.op(complex, SkRegion::kUnion_Op);
+                SkRegion slow;
+                slow.op(ca, cb, op);
+                slow.op(complex, SkRegion::kDifference_Op);
+
+                REPORTER_ASSERT(reporter, fast == slow);
+            }
+        }
+    }
+}
@@ -1393,6 +1393,60 @@ static void test_partial_purge(skiatest::Reporter* reporter) {
     }
 }
 
+static void test_incremental_purge(skiatest::Reporter* reporter) {
+    Mock mock(100, 100);
+    GrContext* context = mock.context();
+    GrResourceCache* cache = mock.cache();
+    GrGpu* gpu = context->priv().getGpu();
+
+    cache->setIncrementalPurgeBytes(20);
+
+    auto addResources = [&](int start, int count) {
+        for (int i = start; i < start + count; ++i) {
+            GrUniqueKey key;
+            make_unique_key<0>(&key, i);
+            TestResource* resource = new TestResource(gpu, SkBudgeted::kYes, 10);
+            resource->resourcePriv().setUniqueKey(key);
+            resource->unref();
+        }
+    };
+
+    // Going over budget doesn't release keyed resources right away.
+    addResources(0, 12);
+    REPORTER_ASSERT(reporter, 12 == cache->getBudgetedResourceCount());
+    REPORTER_ASSERT(reporter, 120 == cache->getBudgetedResourceBytes());
+
+    // Each purge releases at most 20 bytes, and keeps going until it is under 90% of the budget,
+    // even once it is back within the budget.
+    cache->purgeAsNeeded();
+    REPORTER_ASSERT(reporter, 100 == cache->getBudgetedResourceBytes());
+    REPORTER_ASSERT(reporter, cache->isPurgingIncrementally());
+    cache->purgeAsNeeded();
+    REPORTER_ASSERT(reporter, 90 == cache->getBudgetedResourceBytes());
+    REPORTER_ASSERT(reporter, !cache->isPurgingIncrementally());
+    cache->purgeAsNeeded();
+    REPORTER_ASSERT(reporter, 90 == cache->getBudgetedResourceBytes());
+
+    // The least recently used resources are the ones released.
+    GrUniqueKey key;
+    make_unique_key<0>(&key, 2);
+    REPORTER_ASSERT(reporter, !cache->hasUniqueKey(key));
+    make_unique_key<0>(&key, 3);
+    REPORTER_ASSERT(reporter, cache->hasUniqueKey(key));
+
+    // Finishing the purge isn't limited to 20 bytes.
+    addResources(12, 3);
+    REPORTER_ASSERT(reporter, 120 == cache->getBudgetedResourceBytes());
+    cache->finishIncrementalPurge();
+    REPORTER_ASSERT(reporter, 90 == cache->getBudgetedResourceBytes());
+    REPORTER_ASSERT(reporter, !cache->isPurgingIncrementally());
+
+    // Turning it off goes back to purging to the budget all at once.
+    addResources(15, 3);
+    cache->setIncrementalPurgeBytes(0);
+    REPORTER_ASSERT(reporter, 100 == cache->getBudgetedResourceBytes());
+}
+
 static void test_large_resource_count(skiatest::Reporter* reporter) {
     // Set the cache size to double the resource count because we're going to create 2x that number
     // resources, using two different key domains. Add a little slop to the bytes because we resize
@@ -1588,6 +1642,48 @@ static void test_free_resource_messages(skiatest::Reporter* reporter) {
     REPORTER_ASSERT(reporter, 0 == TestResource::NumAlive());
 }
 
+static void test_compressed_image_cache(skiatest::Reporter* reporter) {
+    Mock mock(10, 30000);
+    GrContext* context = mock.context();
+    GrResourceCache* cache = mock.cache();
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeN32(10, 6, kOpaque_SkAlphaType));
+    bitmap.eraseColor(SK_ColorBLUE);
+    const size_t blockBytes = 3 * 2 * 8;  // 3x2 4x4 blocks of 8 bytes
+
+    cache->enableCompressedImageCache(2 * blockBytes);
+    GrCompressedImageCache* compressedCache = cache->compressedImageCache();
+
+    GrUniqueKey key1, key2, key3;
+    make_unique_key<0>(&key1, 1);
+    make_unique_key<0>(&key2, 2);
+    make_unique_key<0>(&key3, 3);
+    compressedCache->encodeAndAdd(key1, bitmap);
+    compressedCache->encodeAndAdd(key2, bitmap);
+    REPORTER_ASSERT(reporter, 2 == compressedCache->count());
+    REPORTER_ASSERT(reporter, 2 * blockBytes == compressedCache->getBytes());
+
+    int width, height;
+    sk_sp<SkData> blocks = compressedCache->find(key1, &width, &height);
+    REPORTER_ASSERT(reporter, blocks && blockBytes == blocks->size());
+    REPORTER_ASSERT(reporter, 10 == width && 6 == height);
+
+    // key1 was just used, so key2 is the one dropped to stay in budget.
+    compressedCache->encodeAndAdd(key3, bitmap);
+    REPORTER_ASSERT(reporter, 2 == compressedCache->count());
+    REPORTER_ASSERT(reporter, compressedCache->has(key1));
+    REPORTER_ASSERT(reporter, !compressedCache->has(key2));
+    REPORTER_ASSERT(reporter, compressedCache->has(key3));
+
+    // Entries go away with their unique keys.
+    typedef SkMessageBus<GrUniqueKeyInvalidatedMessage> Bus;
+    Bus::Post(GrUniqueKeyInvalidatedMessage(key1, context->priv().contextID()));
+    cache->purgeAsNeeded();
+    REPORTER_ASSERT(reporter, !compressedCache->has(key1));
+    REPORTER_ASSERT(reporter, blockBytes == compressedCache->getBytes());
+}
+
 
 DEF_GPUTEST(ResourceCacheMisc, reporter, /* options */) {
     // The below tests create their own mock contexts.
@@ -1605,11 +1701,13 @@ DEF_GPUTEST(ResourceCacheMisc, reporter, /* options */) {
     test_timestamp_wrap(reporter);
     test_time_purge(reporter);
     test_partial_purge(reporter);
+    test_incremental_purge(reporter);
     test_large_resource_count(reporter);
     test_custom_data(reporter);
     test_abandoned(reporter);
     test_tags(reporter);
     test_free_resource_messages(reporter);
+    test_compressed_image_cache(reporter);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "Test.h"
+
+#include "SkData.h"
+#include "SkJSON.h"
+#include "SkRingBufferTracer.h"
+#include "SkStream.h"
+#include "SkTraceEventCommon.h"
+
+using namespace skjson;
+
+DEF_TEST(RingBufferTracer, reporter) {
+    static const char* kNames[] = { "a", "b", "c", "d", "e", "f" };
+
+    SkRingBufferTracer tracer("skia", 4);
+    const uint8_t* skia = tracer.getCategoryGroupEnabled("skia");
+    const uint8_t* other = tracer.getCategoryGroupEnabled("other");
+    REPORTER_ASSERT(reporter, *skia);
+    REPORTER_ASSERT(reporter, !*other);
+    REPORTER_ASSERT(reporter, skia == tracer.getCategoryGroupEnabled("skia"));
+    REPORTER_ASSERT(reporter, !strcmp("skia", tracer.getCategoryGroupName(skia)));
+
+    // Six events into a buffer of four: only the last four survive.
+    for (const char* name : kNames) {
+        const char* argName = "n";
+        uint8_t argType = TRACE_VALUE_TYPE_INT;
+        uint64_t argValue = 7;
+        auto handle = tracer.addTraceEvent(TRACE_EVENT_PHASE_COMPLETE, skia, name, 0,
+                                           1, &argName, &argType, &argValue, 0);
+        tracer.updateTraceEventDuration(skia, name, handle);
+    }
+
+    SkDynamicMemoryWStream stream;
+    tracer.dumpJSON(&stream);
+    sk_sp<SkData> data = stream.detachAsData();
+    DOM dom(static_cast<const char*>(data->data()), data->size());
+
+    const auto& events = dom.root().as<ObjectValue>()["traceEvents"].as<ArrayValue>();
+    REPORTER_ASSERT(reporter, 4 == events.size());
+    for (size_t i = 0; i < events.size(); ++i) {
+        const auto& event = events[i].as<ObjectValue>();
+        REPORTER_ASSERT(reporter,
+                        !strcmp(kNames[i + 2], event["name"].as<StringValue>().begin()));
+        REPORTER_ASSERT(reporter, !strcmp("skia", event["cat"].as<StringValue>().begin()));
+        REPORTER_ASSERT(reporter, event["dur"].is<NumberValue>());
+        REPORTER_ASSERT(reporter, 7 == *event["args"].as<ObjectValue>()["n"].as<NumberValue>());
+    }
+}
@@ -17,6 +17,7 @@
 #include "SkCanvas.h"
 #include "SkColorFilter.h"
 #include "SkData.h"
+#include "SkGradientShader.h"
 #include "SkImage.h"
 #include "SkImageShader.h"
 #include "SkMakeUnique.h"
@@ -26,17 +27,20 @@
 #include "SkTo.h"
 #include "Test.h"
 
+#include <functional>
 #include <string.h>
 
 #ifdef SK_XML
 
 #include "SkDOM.h"
 #include "../src/svg/SkSVGDevice.h"
+#include "SkSVGCanvas.h"
 #include "SkXMLWriter.h"
 
-static std::unique_ptr<SkCanvas> MakeDOMCanvas(SkDOM* dom) {
+static std::unique_ptr<SkCanvas> MakeDOMCanvas(SkDOM* dom, uint32_t flags = 0) {
     auto svgDevice = SkSVGDevice::Make(SkISize::Make(100, 100),
-                                       skstd::make_unique<SkXMLParserWriter>(dom->beginParsing()));
+                                       skstd::make_unique<SkXMLParserWriter>(dom->beginParsing()),
+                                       flags);
     return svgDevice ? skstd::make_unique<SkCanvas>(svgDevice)
                      : nullptr;
 }
@@ -389,4 +393,58 @@ DEF_TEST(SVGDevice_ColorFilters, reporter) {
     REPORTER_ASSERT(reporter, strcmp(dom.findAttr(compositeElement, "operator"), "in") == 0);
 }
 
+DEF_TEST(SVGDevice_DedupResources, reporter) {
+    SkPath path;
+    path.moveTo(10, 10);
+    for (int i = 0; i < 10; ++i) {
+        path.lineTo(20 + i * 5, 10 + (i % 2) * 30);
+    }
+    path.close();
+
+    SkPaint paint;
+    const SkPoint pts[] = {{0, 0}, {100, 0}};
+    const SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+    paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2,
+                                                 SkShader::kClamp_TileMode));
+
+    for (uint32_t flags : { 0u, (uint32_t)SkSVGCanvas::kDedupResources_Flag }) {
+        SkDOM dom;
+        {
+            auto svgCanvas = MakeDOMCanvas(&dom, flags);
+            svgCanvas->clipRect(SkRect::MakeWH(50, 50));
+            for (int i = 0; i < 3; ++i) {
+                svgCanvas->drawPath(path, paint);
+                svgCanvas->translate(5, 5);
+            }
+        }
+        const SkDOM::Node* rootElement = dom.finishParsing();
+        ABORT_TEST(reporter, !rootElement, "root element not found");
+
+        int gradients = 0, clips = 0, paths = 0, uses = 0;
+        std::function<void(const SkDOM::Node*)> count = [&](const SkDOM::Node* node) {
+            const char* name = dom.getName(node);
+            gradients += !strcmp(name, "linearGradient");
+            clips += !strcmp(name, "clipPath");
+            paths += !strcmp(name, "path") && dom.findAttr(node, "d") && dom.findAttr(node, "id");
+            uses += !strcmp(name, "use");
+            for (auto* child = dom.getFirstChild(node); child; child = dom.getNextSibling(child)) {
+                count(child);
+            }
+        };
+        count(rootElement);
+
+        if (flags) {
+            REPORTER_ASSERT(reporter, gradients == 1);
+            REPORTER_ASSERT(reporter, clips == 1);
+            REPORTER_ASSERT(reporter, paths == 1);
+            REPORTER_ASSERT(reporter, uses == 3);
+        } else {
+            REPORTER_ASSERT(reporter, gradients == 3);
+            REPORTER_ASSERT(reporter, clips == 3);
+            REPORTER_ASSERT(reporter, paths == 0);
+            REPORTER_ASSERT(reporter, uses == 0);
+        }
+    }
+}
+
 #endif
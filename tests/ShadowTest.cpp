@@ -5,9 +5,11 @@
  * found in the LICENSE file.
  */
 
+#include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkDrawShadowInfo.h"
 #include "SkPath.h"
+#include "SkRRect.h"
 #include "SkShadowTessellator.h"
 #include "SkShadowUtils.h"
 #include "SkVertices.h"
@@ -175,3 +177,36 @@ DEF_TEST(ShadowBounds, reporter) {
     path.cubicTo(100, 50, 20, 100, 0, 0);
     check_bounds(reporter, path);
 }
+
+static void draw_shadow_at(SkBitmap* bitmap, const SkPath& path, SkScalar z) {
+    bitmap->allocN32Pixels(128, 128);
+    bitmap->eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(*bitmap);
+    SkShadowUtils::DrawShadow(&canvas, path, SkPoint3::Make(0, 0, z), SkPoint3::Make(64, 0, 600),
+                              80, 0x40000000, 0x80000000,
+                              SkShadowFlags::kTransparentOccluder_ShadowFlag);
+}
+
+DEF_TEST(ShadowUtilsNearbyElevations, reporter) {
+    // Warm the cache at one elevation, then draw slightly higher. Whether or not the cached
+    // tessellation is reused, the result should be close to an uncached draw at that height.
+    SkPath path;
+    path.addRRect(SkRRect::MakeRectXY(SkRect::MakeLTRB(32, 32, 96, 96), 8, 8));
+    SkPath volatilePath(path);
+    volatilePath.setIsVolatile(true);
+
+    SkBitmap warm, cached, uncached;
+    draw_shadow_at(&warm, path, 10);
+    draw_shadow_at(&cached, path, 10.25f);
+    draw_shadow_at(&uncached, volatilePath, 10.25f);
+
+    int maxDiff = 0;
+    for (int y = 0; y < 128; ++y) {
+        for (int x = 0; x < 128; ++x) {
+            int a0 = SkColorGetA(cached.getColor(x, y));
+            int a1 = SkColorGetA(uncached.getColor(x, y));
+            maxDiff = SkTMax(maxDiff, SkTAbs(a0 - a1));
+        }
+    }
+    REPORTER_ASSERT(reporter, maxDiff <= 16);
+}
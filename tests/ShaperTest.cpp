@@ -0,0 +1,150 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkTypes.h"
+
+#if defined(SK_USING_SKSHAPER)
+
+#include "SkExecutor.h"
+#include "SkFont.h"
+#include "SkMakeUnique.h"
+#include "SkPointPriv.h"
+#include "SkShaper.h"
+#include "SkString.h"
+#include "Test.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+// Counts the calls that reach the wrapped shaper.
+class CountingShaper : public SkShaper {
+public:
+    explicit CountingShaper(int* count) : fShaper(SkShaper::MakePrimitive()), fCount(count) {}
+
+private:
+    SkPoint shape(RunHandler* handler, const SkFont& font, const char* utf8text, size_t textBytes,
+                  bool leftToRight, SkPoint point, SkScalar width) const override {
+        ++*fCount;
+        return fShaper->shape(handler, font, utf8text, textBytes, leftToRight, point, width);
+    }
+
+    std::unique_ptr<SkShaper> fShaper;
+    int* fCount;
+};
+
+// Flattens everything a shaper reports into comparable values.
+class LoggingRunHandler final : public SkShaper::RunHandler {
+public:
+    Buffer newRunBuffer(const RunInfo&, const SkFont&, int glyphCount,
+                        SkSpan<const char> utf8) override {
+        fLog.push_back(std::string(utf8.data(), utf8.size()));
+        fGlyphs.resize(glyphCount);
+        fPositions.resize(glyphCount);
+        fClusters.resize(glyphCount);
+        return { fGlyphs.data(), fPositions.data(), fClusters.data() };
+    }
+
+    void commitRun() override {
+        for (size_t i = 0; i < fGlyphs.size(); ++i) {
+            fLog.push_back(SkStringPrintf("%d %.2f,%.2f %u", fGlyphs[i], fPositions[i].fX,
+                                          fPositions[i].fY, fClusters[i]).c_str());
+        }
+    }
+
+    void commitLine() override { fLog.push_back("line"); }
+
+    std::vector<std::string> fLog;
+
+private:
+    std::vector<SkGlyphID> fGlyphs;
+    std::vector<SkPoint> fPositions;
+    std::vector<uint32_t> fClusters;
+};
+
+}  // anonymous namespace
+
+static std::vector<std::string> shape(const SkShaper& shaper, const SkFont& font,
+                                      const char* text, SkPoint point, SkScalar width,
+                                      SkPoint* end) {
+    LoggingRunHandler handler;
+    *end = shaper.shape(&handler, font, text, strlen(text), true, point, width);
+    return handler.fLog;
+}
+
+DEF_TEST(ShaperCache, reporter) {
+    static const char kText[] = "The quick brown fox jumps over the lazy dog.";
+    SkFont font(nullptr, 12);
+    std::unique_ptr<SkShaper> primitive = SkShaper::MakePrimitive();
+
+    int count = 0;
+    std::unique_ptr<SkShaper> cached =
+            SkShaper::MakeCaching(skstd::make_unique<CountingShaper>(&count), 1 << 20);
+
+    SkPoint expectedEnd, cachedEnd;
+    auto expected = shape(*primitive, font, kText, {10, 20}, 100, &expectedEnd);
+    REPORTER_ASSERT(reporter, expected.size() > 3);
+    REPORTER_ASSERT(reporter, expected == shape(*cached, font, kText, {10, 20}, 100, &cachedEnd));
+    REPORTER_ASSERT(reporter, SkPointPriv::EqualsWithinTolerance(expectedEnd, cachedEnd));
+    REPORTER_ASSERT(reporter, 1 == count);
+
+    // Shaping again, with a copy of the text and somewhere else, is replayed from the cache.
+    std::string copy(kText);
+    expected = shape(*primitive, font, kText, {-5, 7}, 100, &expectedEnd);
+    REPORTER_ASSERT(reporter,
+                    expected == shape(*cached, font, copy.c_str(), {-5, 7}, 100, &cachedEnd));
+    REPORTER_ASSERT(reporter, SkPointPriv::EqualsWithinTolerance(expectedEnd, cachedEnd));
+    REPORTER_ASSERT(reporter, 1 == count);
+
+    // A different width or font has to be shaped.
+    expected = shape(*primitive, font, kText, {-5, 7}, 50, &expectedEnd);
+    REPORTER_ASSERT(reporter, expected == shape(*cached, font, kText, {-5, 7}, 50, &cachedEnd));
+    REPORTER_ASSERT(reporter, 2 == count);
+    font.setSize(13);
+    shape(*cached, font, kText, {-5, 7}, 50, &cachedEnd);
+    REPORTER_ASSERT(reporter, 3 == count);
+    shape(*cached, font, kText, {-5, 7}, 50, &cachedEnd);
+    REPORTER_ASSERT(reporter, 3 == count);
+
+    // Nothing fits in a zero budget, so every call is shaped.
+    count = 0;
+    cached = SkShaper::MakeCaching(skstd::make_unique<CountingShaper>(&count), 0);
+    shape(*cached, font, kText, {0, 0}, 100, &cachedEnd);
+    shape(*cached, font, kText, {0, 0}, 100, &cachedEnd);
+    REPORTER_ASSERT(reporter, 2 == count);
+}
+
+DEF_TEST(ShaperParagraphs, reporter) {
+    static const char* kTexts[] = {
+        "The quick brown fox jumps over the lazy dog.",
+        "",
+        "Pack my box with five dozen liquor jugs.\nHow vexingly quick daft zebras jump!",
+        "Sphinx of black quartz, judge my vow.",
+    };
+    static constexpr int kParagraphCnt = 64;
+    SkFont font(nullptr, 12);
+    std::unique_ptr<SkShaper> primitive = SkShaper::MakePrimitive();
+
+    SkShaper::Paragraph paragraphs[kParagraphCnt];
+    LoggingRunHandler expected;
+    SkPoint expectedEnd = {3, 4};
+    for (int i = 0; i < kParagraphCnt; ++i) {
+        const char* text = kTexts[i % SK_ARRAY_COUNT(kTexts)];
+        paragraphs[i] = { text, strlen(text), true };
+        expectedEnd = primitive->shape(&expected, font, text, strlen(text), true, expectedEnd, 80);
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    LoggingRunHandler actual;
+    SkPoint actualEnd = SkShaper::ShapeParagraphs(*executor, SkShaper::MakePrimitive, &actual,
+                                                  font, paragraphs, kParagraphCnt, {3, 4}, 80);
+    REPORTER_ASSERT(reporter, expected.fLog == actual.fLog);
+    REPORTER_ASSERT(reporter, SkPointPriv::EqualsWithinTolerance(expectedEnd, actualEnd));
+}
+
+#endif
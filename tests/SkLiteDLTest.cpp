@@ -5,9 +5,13 @@
  * found in the LICENSE file.
  */
 
+#include "SkBitmap.h"
 #include "SkLiteDL.h"
 #include "SkLiteRecorder.h"
+#include "SkPicture.h"
+#include "SkPictureRecorder.h"
 #include "SkRSXform.h"
+#include "SkRTree.h"
 #include "Test.h"
 
 DEF_TEST(SkLiteDL_basics, r) {
@@ -63,3 +67,50 @@ DEF_TEST(SkLiteRecorder_RecordsFlush, r) {
     canvas.flush();
     REPORTER_ASSERT(r, !dl.empty());
 }
+
+DEF_TEST(SkLiteDL_dropsNoopSaveRestore, r) {
+    SkLiteDL dl;
+    dl.save();
+        dl.translate(1,2);
+        dl.save();
+            dl.clipRect(SkRect{2,3,4,5}, kIntersect_SkClipOp, true);
+        dl.restore();
+    dl.restore();
+    REPORTER_ASSERT(r, dl.empty());
+
+    // A save() around a draw must be kept, even if it contains a droppable save()/restore().
+    dl.save();
+        dl.save();
+            dl.translate(1,2);
+        dl.restore();
+        dl.drawRect(SkRect{0,0,9,9}, SkPaint{});
+    dl.restore();
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(10, 10);
+    bitmap.eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(bitmap);
+    dl.draw(&canvas);
+    REPORTER_ASSERT(r, bitmap.getColor(0,0) == SK_ColorBLACK);
+
+    // A saveLayer() is never dropped.
+    dl.reset();
+    dl.saveLayer(nullptr, nullptr, nullptr, nullptr, nullptr, 0);
+    dl.restore();
+    REPORTER_ASSERT(r, !dl.empty());
+}
+
+DEF_TEST(SkLiteDL_pictureRoundTrip, r) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect{0,0,100,100});
+    for (int i = 0; i < 10; i++) {
+        canvas->drawRect(SkRect::MakeXYWH(i*10, i*10, 5, 5), SkPaint{});
+    }
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    std::unique_ptr<SkLiteDL> dl = SkLiteDL::MakeFromPicture(*picture);
+    REPORTER_ASSERT(r, !dl->empty());
+
+    SkRTreeFactory factory;
+    sk_sp<SkPicture> roundTrip = dl->makePicture(picture->cullRect(), &factory);
+    REPORTER_ASSERT(r, roundTrip->approximateOpCount() == picture->approximateOpCount());
+}
@@ -7,6 +7,7 @@
 
 #include "SkHalf.h"
 #include "SkRasterPipeline.h"
+#include "SkRasterPipelineJIT.h"
 #include "SkTo.h"
 #include "Test.h"
 
@@ -202,3 +203,136 @@ DEF_TEST(SkRasterPipeline_lowp_clamp01, r) {
     p.append(SkRasterPipeline::store_8888, &ptr);
     p.run(0,0,1,1);
 }
+
+DEF_TEST(SkRasterPipeline_lowp_color_matrix, r) {
+    // unpremul -> matrix_4x5 -> premul, as appended by a color matrix filter.
+    // The matrix swaps red and blue and halves green.
+    uint32_t rgba[64];
+    for (int i = 0; i < 64; i++) {
+        rgba[i] = 0x80000000 | (i << 16) | ((2*i) << 8) | (i/2);
+    }
+    const float m[20] = {
+        0,0,1,0,   0,0.5f,0,0,   1,0,0,0,   0,0,0,1,   0,0,0,0,
+    };
+
+    SkRasterPipeline_MemoryCtx ptr = { rgba, 0 };
+
+    SkRasterPipeline_<256> p;
+    p.append(SkRasterPipeline::load_8888,  &ptr);
+    p.append(SkRasterPipeline::unpremul);
+    p.append(SkRasterPipeline::matrix_4x5, m);
+    p.append(SkRasterPipeline::premul);
+    p.append(SkRasterPipeline::store_8888, &ptr);
+    p.run(0,0,64,1);
+
+    for (int i = 0; i < 64; i++) {
+        int got_r = (rgba[i] >>  0) & 0xff,
+            got_g = (rgba[i] >>  8) & 0xff,
+            got_b = (rgba[i] >> 16) & 0xff,
+            got_a = (rgba[i] >> 24) & 0xff;
+        if (SkTAbs(got_r - i) > 1 || SkTAbs(got_g - i) > 1 || SkTAbs(got_b - i/2) > 1 ||
+            got_a != 0x80) {
+            ERRORF(r, "%d: got %08x\n", i, rgba[i]);
+        }
+    }
+}
+
+DEF_TEST(SkRasterPipeline_bilerp_repeat, r) {
+    // Sampling at x=0 straddles the left edge, so repeat blends in the rightmost pixel.
+    uint32_t image[] = { 0xff000000, 0xffffffff };
+    SkRasterPipeline_GatherCtx gather = { image, 2, 2.0f, 1.0f };
+    const float translate[] = { -0.5f, 0 };
+
+    uint32_t result[2];
+    SkRasterPipeline_MemoryCtx dst = { result, 0 };
+
+    SkRasterPipeline_<256> p;
+    p.append(SkRasterPipeline::seed_shader);
+    p.append(SkRasterPipeline::matrix_translate, translate);
+    p.append(SkRasterPipeline::bilerp_repeat_8888, &gather);
+    p.append(SkRasterPipeline::store_8888, &dst);
+    p.run(0,0,2,1);
+
+    for (uint32_t px : result) {
+        int red = px & 0xff;
+        REPORTER_ASSERT(r, SkTAbs(red - 0x80) <= 1);
+        REPORTER_ASSERT(r, (px >> 24) == 0xff);
+    }
+}
+
+DEF_TEST(SkRasterPipeline_fused, r) {
+    // scale_1_float through srcover is a run of arithmetic stages SkRasterPipelineJIT can fuse.
+    // Building it more than kHotBuilds times makes sure we hit the fused stage when it's enabled.
+    float src[4*20],
+          dst[4*20],
+          out[4*20];
+    for (int i = 0; i < 20; i++) {
+        src[4*i+0] =  1.5f;
+        src[4*i+1] = -0.5f;
+        src[4*i+2] =  0.5f;
+        src[4*i+3] =  0.5f;
+        dst[4*i+0] = dst[4*i+1] = dst[4*i+2] = dst[4*i+3] = 1.0f;
+    }
+    float scale = 0.5f;
+
+    SkRasterPipeline_MemoryCtx src_ctx = { src, 0 },
+                               dst_ctx = { dst, 0 },
+                               out_ctx = { out, 0 };
+
+    for (int build = 0; build < 2*SkRasterPipelineJIT::kHotBuilds; build++) {
+        SkRasterPipeline_<256> p;
+        p.append(SkRasterPipeline::load_f32,     &src_ctx);
+        p.append(SkRasterPipeline::load_f32_dst, &dst_ctx);
+        p.append(SkRasterPipeline::scale_1_float, &scale);
+        p.append(SkRasterPipeline::clamp_0);
+        p.append(SkRasterPipeline::clamp_1);
+        p.append(SkRasterPipeline::premul);
+        p.append(SkRasterPipeline::srcover);
+        p.append(SkRasterPipeline::store_f32, &out_ctx);
+
+        memset(out, 0, sizeof(out));
+        p.run(0,0,20,1);
+
+        for (int i = 0; i < 20; i++) {
+            REPORTER_ASSERT(r, out[4*i+0] == 0.9375f);
+            REPORTER_ASSERT(r, out[4*i+1] == 0.75f);
+            REPORTER_ASSERT(r, out[4*i+2] == 0.8125f);
+            REPORTER_ASSERT(r, out[4*i+3] == 1.0f);
+        }
+    }
+}
+
+DEF_TEST(SkRasterPipeline_pq_hlg, r) {
+    // Decoding and re-encoding each BT.2100 transfer function should round trip, with the ends
+    // of the encoded range mapping to the ends of the linear range.
+    const float encoded[] = { 0.0f, 0.25f, 0.5f, 0.75f, 1.0f };
+    const SkRasterPipeline::StockStage stages[][2] = {
+        { SkRasterPipeline::from_pq,  SkRasterPipeline::to_pq  },
+        { SkRasterPipeline::from_hlg, SkRasterPipeline::to_hlg },
+    };
+    for (const auto& fns : stages) {
+        float in[4*5], linear[4*5], out[4*5];
+        for (int i = 0; i < 5; i++) {
+            in[4*i+0] = in[4*i+1] = in[4*i+2] = encoded[i];
+            in[4*i+3] = 1.0f;
+        }
+        SkRasterPipeline_MemoryCtx src = { in, 0 },
+                                   mid = { linear, 0 },
+                                   dst = { out, 0 };
+
+        SkRasterPipeline_<256> p;
+        p.append(SkRasterPipeline::load_f32, &src);
+        p.append(fns[0]);
+        p.append(SkRasterPipeline::store_f32, &mid);
+        p.append(fns[1]);
+        p.append(SkRasterPipeline::store_f32, &dst);
+        p.run(0,0,5,1);
+
+        REPORTER_ASSERT(r, linear[0] == 0.0f);
+        REPORTER_ASSERT(r, SkTAbs(linear[4*4] - 1.0f) < 0.01f);
+        for (int i = 0; i < 5; i++) {
+            REPORTER_ASSERT(r, SkTAbs(out[4*i] - encoded[i]) < 0.01f);
+            REPORTER_ASSERT(r, out[4*i+3] == 1.0f);
+        }
+    }
+}
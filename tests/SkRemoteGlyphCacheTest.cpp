@@ -192,6 +192,57 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkRemoteGlyphCache_StrikeSerialization, repor
     discardableManager->unlockAndDeleteAll();
 }
 
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkRemoteGlyphCache_BatchedStrikeData, reporter, ctxInfo) {
+    sk_sp<DiscardableManager> discardableManager = sk_make_sp<DiscardableManager>();
+    SkStrikeServer server(discardableManager.get());
+    SkStrikeClient client(discardableManager, false);
+    const SkPaint paint;
+
+    // Server.
+    auto serverTf = SkTypeface::MakeFromName("monospace", SkFontStyle());
+    auto serverTfData = server.serializeTypeface(serverTf.get());
+
+    int glyphCount = 10;
+    auto serverBlob = buildTextBlob(serverTf, glyphCount);
+    auto props = FindSurfaceProps(ctxInfo.grContext());
+    SkMatrix matrix = SkMatrix::MakeScale(16);
+
+    // Two frames, with new glyphs in each, written into one buffer.
+    std::vector<uint8_t> serverStrikeData;
+    {
+        SkTextBlobCacheDiffCanvas cache_diff_canvas(10, 10, props, &server,
+                                                    MakeSettings(ctxInfo.grContext()));
+        cache_diff_canvas.drawTextBlob(serverBlob.get(), 0, 0, paint);
+        server.writeStrikeData(&serverStrikeData);
+    }
+    size_t firstFrameSize = serverStrikeData.size();
+    {
+        SkTextBlobCacheDiffCanvas cache_diff_canvas(160, 160, props, &server,
+                                                    MakeSettings(ctxInfo.grContext()));
+        cache_diff_canvas.concat(matrix);
+        cache_diff_canvas.drawTextBlob(serverBlob.get(), 0, 0, paint);
+        server.writeStrikeData(&serverStrikeData);
+    }
+    REPORTER_ASSERT(reporter, serverStrikeData.size() > firstFrameSize);
+
+    // Client.
+    auto clientTf = client.deserializeTypeface(serverTfData->data(), serverTfData->size());
+    REPORTER_ASSERT(reporter,
+                    client.readStrikeData(serverStrikeData.data(), serverStrikeData.size()));
+    auto clientBlob = buildTextBlob(clientTf, glyphCount);
+
+    SkBitmap expected = RasterBlob(serverBlob, 10, 10, paint, ctxInfo.grContext());
+    SkBitmap actual = RasterBlob(clientBlob, 10, 10, paint, ctxInfo.grContext());
+    compare_blobs(expected, actual, reporter);
+    expected = RasterBlob(serverBlob, 160, 160, paint, ctxInfo.grContext(), &matrix);
+    actual = RasterBlob(clientBlob, 160, 160, paint, ctxInfo.grContext(), &matrix);
+    compare_blobs(expected, actual, reporter);
+    REPORTER_ASSERT(reporter, !discardableManager->hasCacheMiss());
+
+    // Must unlock everything on termination, otherwise valgrind complains about memory leaks.
+    discardableManager->unlockAndDeleteAll();
+}
+
 DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkRemoteGlyphCache_ReleaseTypeFace, reporter, ctxInfo) {
     sk_sp<DiscardableManager> discardableManager = sk_make_sp<DiscardableManager>();
     SkStrikeServer server(discardableManager.get());
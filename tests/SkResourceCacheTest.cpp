@@ -291,3 +291,32 @@ DEF_TEST(ResourceCache_purge, reporter) {
         }
     }
 }
+
+/*
+ *  Test that the global cache finds what it was given, whichever shard each key lands in.
+ */
+DEF_TEST(ResourceCache_global, reporter) {
+    const int kCount = 64;
+    int flags[kCount] = { 0 };
+    for (int i = 0; i < kCount; ++i) {
+        auto rec = skstd::make_unique<TestRec>(1, i, &flags[i]);
+        rec->fCanBePurged = true;
+        SkResourceCache::Add(rec.release());
+        REPORTER_ASSERT(reporter, flags[i] & TestRec::kDidInstall);
+    }
+
+    auto found = [](const SkResourceCache::Rec& rec, void* context) {
+        *(int32_t*)context = static_cast<const TestRec&>(rec).fKey.fData;
+        return true;
+    };
+    auto stale = [](const SkResourceCache::Rec&, void*) { return false; };
+    for (int i = 0; i < kCount; ++i) {
+        int32_t data = -1;
+        REPORTER_ASSERT(reporter, SkResourceCache::Find(TestKey(1, i), found, &data));
+        REPORTER_ASSERT(reporter, data == i);
+
+        // Marking the rec stale purges it, so we leave the global cache as we found it.
+        REPORTER_ASSERT(reporter, !SkResourceCache::Find(TestKey(1, i), stale, nullptr));
+        REPORTER_ASSERT(reporter, !SkResourceCache::Find(TestKey(1, i), found, &data));
+    }
+}
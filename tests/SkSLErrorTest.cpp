@@ -516,3 +516,9 @@ DEF_TEST(SkSLConstantSwizzleNotLast, r) {
                  "void main() { sk_FragColor = half4(1).rg00; }",
                  "error: 1: only the last swizzle component can be a constant\n1 error\n");
 }
+
+DEF_TEST(SkSLVertexBuiltinInFragment, r) {
+    test_failure(r,
+                 "void main() { sk_FragColor = half4(sk_VertexID); }",
+                 "error: 1: unknown identifier 'sk_VertexID'\n1 error\n");
+}
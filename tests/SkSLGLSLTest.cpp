@@ -95,11 +95,16 @@ DEF_TEST(SkSLControl, r) {
 }
 
 DEF_TEST(SkSLFunctions, r) {
+    SkSL::Program::Settings settings;
+    sk_sp<GrShaderCaps> caps = SkSL::ShaderCapsFactory::Default();
+    settings.fCaps = caps.get();
+    settings.fInlineThreshold = 0;
+    SkSL::Program::Inputs inputs;
     test(r,
          "float foo(float v[2]) { return v[0] * v[1]; }"
          "void bar(inout float x) { float y[2], z; y[0] = x; y[1] = x * 2; z = foo(y); x = z; }"
          "void main() { float x = 10; bar(x); sk_FragColor = half4(half(x)); }",
-         *SkSL::ShaderCapsFactory::Default(),
+         settings,
          "#version 400\n"
          "out vec4 sk_FragColor;\n"
          "float foo(float v[2]) {\n"
@@ -116,6 +121,62 @@ DEF_TEST(SkSLFunctions, r) {
          "    float x = 10.0;\n"
          "    bar(x);\n"
          "    sk_FragColor = vec4(x);\n"
+         "}\n",
+         &inputs);
+}
+
+DEF_TEST(SkSLInlining, r) {
+    test(r,
+         "uniform half4 color;"
+         "half square(half x) { return x * x; }"
+         "half inc(half x) { return x + 1; }"
+         "half4 scale(half4 c, half s) { return c * s; }"
+         "void main() { sk_FragColor = scale(color, inc(color.a)) * square(color.a + 1); }",
+         *SkSL::ShaderCapsFactory::Default(),
+         "#version 400\n"
+         "out vec4 sk_FragColor;\n"
+         "uniform vec4 color;\n"
+         "float square(float x) {\n"
+         "    return x * x;\n"
+         "}\n"
+         "void main() {\n"
+         "    sk_FragColor = (color * (color.w + 1.0)) * square(color.w + 1.0);\n"
+         "}\n");
+    test(r,
+         "uniform half4 color;"
+         "half4 global() { return color; }"
+         "half4 twice(half4 c) { return c + c; }"
+         "void main() {"
+         "half4 color = half4(1);"
+         "sk_FragColor = twice(sk_FragColor) + global() + color;"
+         "}",
+         *SkSL::ShaderCapsFactory::Default(),
+         "#version 400\n"
+         "out vec4 sk_FragColor;\n"
+         "uniform vec4 color;\n"
+         "vec4 global() {\n"
+         "    return color;\n"
+         "}\n"
+         "void main() {\n"
+         "    sk_FragColor = ((sk_FragColor + sk_FragColor) + global()) + vec4(1.0);\n"
+         "}\n");
+}
+
+DEF_TEST(SkSLDeadFunctionsAndUniforms, r) {
+    test(r,
+         "uniform half4 used;"
+         "uniform half4 unused;"
+         "uniform half4 onlyInDeadCode;"
+         "layout(binding=1) uniform half4 bound;"
+         "void dead() { sk_FragColor = onlyInDeadCode; }"
+         "void main() { sk_FragColor = used; }",
+         *SkSL::ShaderCapsFactory::Default(),
+         "#version 400\n"
+         "out vec4 sk_FragColor;\n"
+         "uniform vec4 used;\n"
+         "layout (binding = 1) uniform vec4 bound;\n"
+         "void main() {\n"
+         "    sk_FragColor = used;\n"
          "}\n");
 }
 
@@ -1739,10 +1800,6 @@ DEF_TEST(SkSLGeometryShaders, r) {
          "int sk_InvocationID;\n"
          "layout (points) in ;\n"
          "layout (line_strip, max_vertices = 4) out ;\n"
-         "void test() {\n"
-         "    gl_Position = gl_in[0].gl_Position + vec4(0.5, 0.0, 0.0, float(sk_InvocationID));\n"
-         "    EmitVertex();\n"
-         "}\n"
          "void _invoke() {\n"
          "    gl_Position = gl_in[0].gl_Position + vec4(-0.5, 0.0, 0.0, float(sk_InvocationID));\n"
          "    EmitVertex();\n"
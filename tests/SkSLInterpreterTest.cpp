@@ -0,0 +1,100 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkSLCompiler.h"
+#include "SkSLInterpreter.h"
+
+#include "Test.h"
+
+// Runs the function "test" once per input, all in one striped call so that the inputs take
+// different paths through the code, and checks each result.
+template<typename type>
+void test(skiatest::Reporter* r, const char* src, std::vector<type> inputs,
+          std::vector<type> expected) {
+    SkASSERT(inputs.size() == expected.size());
+    SkSL::Compiler compiler;
+    SkSL::Program::Settings settings;
+    std::unique_ptr<SkSL::Program> program = compiler.convertProgram(
+                                                                 SkSL::Program::kPipelineStage_Kind,
+                                                                 SkSL::String(src), settings);
+    REPORTER_ASSERT(r, program);
+    if (!program) {
+        printf("%s", compiler.errorText().c_str());
+        return;
+    }
+    std::unique_ptr<SkSL::ByteCode> byteCode = compiler.toByteCode(*program);
+    REPORTER_ASSERT(r, byteCode);
+    if (!byteCode) {
+        printf("%s", compiler.errorText().c_str());
+        return;
+    }
+    const SkSL::ByteCodeFunction* f = byteCode->getFunction("test");
+    REPORTER_ASSERT(r, f);
+    SkSL::Interpreter interpreter(std::move(program), std::move(byteCode));
+    int count = (int) inputs.size();
+    std::vector<SkSL::Interpreter::Value> args, results(count);
+    for (type x : inputs) {
+        args.push_back(SkSL::Interpreter::Value(x));
+    }
+    SkSL::Interpreter::Value* argPtrs[] = { args.data() };
+    interpreter.runStriped(*f, count, argPtrs, results.data());
+    for (int i = 0; i < count; ++i) {
+        type result;
+        memcpy(&result, &results[i], sizeof(type));
+        if (result != expected[i]) {
+            ERRORF(r, "%s\ninput %d: expected %g, got %g", src, i, (double) expected[i],
+                   (double) result);
+        }
+    }
+
+    SkSL::Interpreter::Value arg(inputs[0]);
+    SkSL::Interpreter::Value result = interpreter.run(*f, &arg);
+    REPORTER_ASSERT(r, !memcmp(&result, &results[0], sizeof(type)));
+}
+
+DEF_TEST(SkSLInterpreterArithmetic, r) {
+    test<float>(r, "float test(float x) { return x * 2 + 1; }", { 1, 2, -3 }, { 3, 5, -5 });
+    test<int>(r, "int test(int x) { return x / 3 - x % 3; }", { 7, 9, -7 }, { 1, 3, -1 });
+    test<int>(r, "int test(int x) { int y = x++; y += ++x; return x * 1000 + y; }",
+              { 1, 5 }, { 3004, 7012 });
+    test<float>(r, "float test(float x) { float y = x; y *= y; y -= x; return y / 2; }",
+                { 2, 4 }, { 1, 6 });
+}
+
+DEF_TEST(SkSLInterpreterIf, r) {
+    test<float>(r, "float test(float x) { if (x > 2) { return 10; } else { x = -x; } return x; }",
+                { 1, 3, 5, 2, 9 }, { -1, 10, 10, -2, 10 });
+    test<float>(r, "float test(float x) { bool b = x > 1 || x < -1; if (!b) return 0; return x; }",
+                { 0.5f, 2, -3, 1 }, { 0, 2, -3, 0 });
+    test<float>(r, "float test(float x) { return x > 0 ? x : -x * 3; }",
+                { 1, -1, 2, -2 }, { 1, 3, 2, 6 });
+}
+
+DEF_TEST(SkSLInterpreterLoops, r) {
+    test<int>(r, "int test(int x) { int s = 0; for (int i = 0; i < x; i++) {"
+                 "    if (i == 2) continue; if (i == 5) break; s += i; } return s; }",
+              { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }, { 0, 0, 1, 1, 4, 8, 8, 8, 8, 8, 8 });
+    test<int>(r, "int test(int x) { int n = 0; while (x > 1) {"
+                 "    if (x % 2 == 0) { x /= 2; } else { x = 3 * x + 1; } n++; } return n; }",
+              { 1, 2, 3, 6, 7, 27 }, { 0, 1, 7, 8, 16, 111 });
+    test<int>(r, "int test(int x) { int n = 0; do { n += x; x--; } while (x > 0 && n < 10);"
+                 "    return n; }",
+              { 1, 3, 5, 0 }, { 1, 6, 12, 0 });
+    test<int>(r, "int test(int x) { for (int i = 0; i < 10; i++) { for (int j = 0; j < 10; j++) {"
+                 "    if (i * j >= x) return i * 100 + j; if (j > i) break; } } return -1; }",
+              { 0, 1, 5, 100 }, { 0, 101, 203, -1 });
+}
+
+DEF_TEST(SkSLInterpreterCalls, r) {
+    test<float>(r, "float sub(float a, float b) { return a - b; }"
+                   "float test(float x) { return sub(x, 1) * sub(3, x); }",
+                { 1, 2, 3, 4 }, { 0, 1, 0, -3 });
+    test<float>(r, "float g(float a) { if (a > 1) return a; return -a; }"
+                   "float test(float x) { float s = 0;"
+                   "    for (int i = 0; i < 3; i++) { s += g(x); x += 1; } return s; }",
+                { 0, 1, 5 }, { 1, 4, 18 });
+}
@@ -118,4 +118,25 @@ DEF_TEST(SkSLJITWhile, r) {
                  "}", 96, 200, 288);
 }
 
+
+DEF_TEST(SkSLJITNegate, r) {
+    test<int>(r, "int test(int x, int y) { return -x + y; }", 12, 5, -7);
+    test<float>(r, "float test(float x, float y) { return -x * y; }", 3, 2, -6);
+}
+
+DEF_TEST(SkSLJITCache, r) {
+    static const char* kStage = "void test(int x, int y, inout half4 color) {"
+                                "    if (color.r > 0.5) { color.g = half(x); } else { color.b = 0; }"
+                                "}";
+    SkSL::Compiler compiler;
+    SkSL::JIT jit(&compiler);
+    SkSL::JIT::Module* module = jit.compileCached(SkSL::String(kStage));
+    REPORTER_ASSERT(r, module);
+    REPORTER_ASSERT(r, module->getJumperStage("test"));
+    REPORTER_ASSERT(r, module == jit.compileCached(SkSL::String(kStage)));
+    REPORTER_ASSERT(r, module != jit.compileCached(SkSL::String(
+                                    "void test(int x, int y, inout half4 color) { color.r = 0; }")));
+    REPORTER_ASSERT(r, !jit.compileCached(SkSL::String("void test(int x) { x = 1.5; }")));
+}
+
 #endif
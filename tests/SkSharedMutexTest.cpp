@@ -20,8 +20,8 @@ DEF_TEST(SkSharedMutexBasic, r) {
     sm.releaseShared();
 }
 
-DEF_TEST(SkSharedMutexMultiThreaded, r) {
-    SkSharedMutex sm;
+static void test_multithreaded(skiatest::Reporter* r, SkSharedMutex::Bias bias) {
+    SkSharedMutex sm(bias);
     static const int kSharedSize = 10;
     int shared[kSharedSize];
     int value = 0;
@@ -52,3 +52,11 @@ DEF_TEST(SkSharedMutexMultiThreaded, r) {
         }
     });
 }
+
+DEF_TEST(SkSharedMutexMultiThreaded, r) {
+    test_multithreaded(r, SkSharedMutex::Bias::kFair);
+}
+
+DEF_TEST(SkSharedMutexReaderBiased, r) {
+    test_multithreaded(r, SkSharedMutex::Bias::kReaders);
+}
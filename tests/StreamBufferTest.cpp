@@ -148,3 +148,25 @@ DEF_TEST(StreamBuffer, r) {
     // Now go back to the data we skipped.
     test_get_data_at_position(r, &buffer, 14, 13);
 }
+
+// A memory-backed stream is never copied: get() and getDataAtPosition() point into its memory.
+DEF_TEST(StreamBuffer_memoryBacked, r) {
+    const size_t size = strlen(gText);
+    SkStreamBuffer buffer(skstd::make_unique<SkMemoryStream>(gText, size, false));
+
+    REPORTER_ASSERT(r, buffer.buffer(5));
+    REPORTER_ASSERT(r, buffer.get() == gText);
+    REPORTER_ASSERT(r, buffer.markPosition() == 0);
+    buffer.flush();
+
+    REPORTER_ASSERT(r, buffer.buffer(10));
+    REPORTER_ASSERT(r, buffer.get() == gText + 5);
+    REPORTER_ASSERT(r, !memcmp(buffer.get(), gText + 5, 10));
+    buffer.flush();
+
+    sk_sp<SkData> data = buffer.getDataAtPosition(5, 10);
+    REPORTER_ASSERT(r, data && data->data() == gText + 5);
+
+    // Reading past the end still fails.
+    REPORTER_ASSERT(r, !buffer.buffer(size));
+}
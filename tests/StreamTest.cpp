@@ -637,6 +637,60 @@ DEF_TEST(FILEStreamWithOffset, r) {
     test_all(&stream2, true);
 }
 
+DEF_TEST(FILEStreamBufferedReads, r) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+
+    SkRandom random;
+    const size_t kSize = 100 * 1024;
+    SkAutoTMalloc<uint8_t> expected(kSize);
+    for (size_t i = 0; i < kSize; ++i) {
+        expected[i] = (uint8_t)random.nextU();
+    }
+    SkString path = SkOSPath::Join(tmpDir.c_str(), "buffered_read_test");
+    {
+        SkFILEWStream writer(path.c_str());
+        if (!writer.isValid()) {
+            ERRORF(r, "Failed to create tmp file %s\n", path.c_str());
+            return;
+        }
+        writer.write(expected.get(), kSize);
+    }
+
+    // Reads of every size, some served by the buffer and some not, must see the file as it is.
+    SkFILEStream stream(path.c_str());
+    REPORTER_ASSERT(r, stream.isValid());
+    SkAutoTMalloc<uint8_t> actual(kSize);
+    for (int i = 0; i < 200; ++i) {
+        size_t position = random.nextULessThan(kSize);
+        if (random.nextBool()) {
+            REPORTER_ASSERT(r, stream.seek(position));
+        } else {
+            position = stream.getPosition();
+        }
+        size_t size = random.nextBool() ? random.nextRangeU(1, 64) : random.nextULessThan(kSize);
+        size_t expectedSize = SkTMin(size, kSize - position);
+        REPORTER_ASSERT(r, stream.read(actual.get(), size) == expectedSize);
+        REPORTER_ASSERT(r, !memcmp(expected.get() + position, actual.get(), expectedSize));
+        REPORTER_ASSERT(r, stream.getPosition() == position + expectedSize);
+    }
+
+    // Small files are read up front and big ones mapped; both share their memory.
+    for (size_t size : { (size_t)1000, kSize }) {
+        SkString sizedPath = SkOSPath::Join(tmpDir.c_str(), "make_from_file_test");
+        {
+            SkFILEWStream writer(sizedPath.c_str());
+            writer.write(expected.get(), size);
+        }
+        std::unique_ptr<SkStreamAsset> asset = SkStream::MakeFromFile(sizedPath.c_str());
+        REPORTER_ASSERT(r, asset && asset->getLength() == size);
+        REPORTER_ASSERT(r, asset && asset->getMemoryBase() &&
+                           !memcmp(asset->getMemoryBase(), expected.get(), size));
+    }
+}
+
 #include "SkBuffer.h"
 
 DEF_TEST(RBuffer, reporter) {
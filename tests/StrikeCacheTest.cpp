@@ -0,0 +1,181 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "SkData.h"
+#include "SkFont.h"
+#include "SkGraphics.h"
+#include "SkOSPath.h"
+#include "SkPaint.h"
+#include "SkScalerContext.h"
+#include "SkStream.h"
+#include "SkStrikeCache.h"
+#include "SkSurfaceProps.h"
+#include "Test.h"
+
+#include <atomic>
+#include <thread>
+
+// Many threads finding, using, and releasing a few strikes while a tiny budget keeps purging.
+DEF_TEST(StrikeCache_threaded, r) {
+    SkStrikeCache cache;
+    cache.setCacheCountLimit(4);
+
+    const int kSizes = 16;
+    std::atomic<int> mismatches{0};
+
+    std::thread threads[4];
+    for (auto& thread : threads) {
+        thread = std::thread([&] {
+            for (int i = 0; i < 1000; ++i) {
+                SkFont font(nullptr, 1 + i % kSizes);
+                SkAutoDescriptor ad;
+                SkScalerContextEffects effects;
+                auto desc = SkScalerContext::CreateDescriptorAndEffectsUsingPaint(
+                        font, SkPaint(), SkSurfaceProps(SkSurfaceProps::kLegacyFontHost_InitType),
+                        kFakeGammaAndBoostContrast, SkMatrix::I(), &ad, &effects);
+
+                auto strike = cache.findOrCreateStrikeExclusive(
+                        *desc, effects, *font.getTypefaceOrDefault());
+                if (!(strike->getDescriptor() == *desc)) {
+                    mismatches++;
+                }
+                // Strikes are mutated while checked out; this races if two threads ever hold the same one.
+                (void)strike->getGlyphIDMetrics(i % 8);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REPORTER_ASSERT(r, mismatches == 0);
+    REPORTER_ASSERT(r, cache.getCacheCountUsed() <= kSizes);
+    cache.validate();
+
+    cache.purgeAll();
+    REPORTER_ASSERT(r, cache.getCacheCountUsed() == 0);
+    REPORTER_ASSERT(r, cache.getTotalMemoryUsed() == 0);
+}
+
+static SkDescriptor* make_descriptor(const SkFont& font, SkAutoDescriptor* ad,
+                                     SkScalerContextEffects* effects) {
+    return SkScalerContext::CreateDescriptorAndEffectsUsingPaint(
+            font, SkPaint(), SkSurfaceProps(SkSurfaceProps::kLegacyFontHost_InitType),
+            kFakeGammaAndBoostContrast, SkMatrix::I(), ad, effects);
+}
+
+// A snapshot brings back the glyph metrics, images, and paths of the strikes it was written from.
+DEF_TEST(StrikeCache_snapshot, r) {
+    SkFont font(nullptr, 24);
+    SkAutoDescriptor ad;
+    SkScalerContextEffects effects;
+    SkDescriptor* desc = make_descriptor(font, &ad, &effects);
+    const SkTypeface& typeface = *font.getTypefaceOrDefault();
+
+    SkStrikeCache cache;
+    {
+        auto strike = cache.findOrCreateStrikeExclusive(*desc, effects, typeface);
+        for (SkGlyphID id = 0; id < 8; ++id) {
+            const SkGlyph& glyph = strike->getGlyphIDMetrics(id);
+            strike->findImage(glyph);
+            strike->findPath(glyph);
+        }
+    }
+    SkDynamicMemoryWStream stream;
+    REPORTER_ASSERT(r, cache.writeSnapshot(&stream));
+    sk_sp<SkData> snapshot = stream.detachAsData();
+
+    SkStrikeCache loaded;
+    REPORTER_ASSERT(r, loaded.readSnapshot(snapshot->data(), snapshot->size()));
+    REPORTER_ASSERT(r, loaded.getCacheCountUsed() == 1);
+
+    auto original = cache.findStrikeExclusive(*desc);
+    auto strike = loaded.findStrikeExclusive(*desc);
+    if (!original || !strike) {
+        ERRORF(r, "Strike missing.");
+        return;
+    }
+    REPORTER_ASSERT(r, strike->countCachedGlyphs() == original->countCachedGlyphs());
+    for (SkGlyphID id = 0; id < 8; ++id) {
+        const SkGlyph* expected = original->getRawGlyphByID(SkPackedGlyphID(id));
+        const SkGlyph* glyph = strike->getRawGlyphByID(SkPackedGlyphID(id));
+        REPORTER_ASSERT(r, glyph->fWidth == expected->fWidth);
+        REPORTER_ASSERT(r, glyph->fHeight == expected->fHeight);
+        REPORTER_ASSERT(r, glyph->fAdvanceX == expected->fAdvanceX);
+        REPORTER_ASSERT(r, (glyph->fImage == nullptr) == (expected->fImage == nullptr));
+        if (glyph->fImage && expected->fImage) {
+            REPORTER_ASSERT(r, 0 == memcmp(glyph->fImage, expected->fImage,
+                                           expected->computeImageSize()));
+        }
+        REPORTER_ASSERT(r, (glyph->path() == nullptr) == (expected->path() == nullptr));
+        if (glyph->path() && expected->path()) {
+            REPORTER_ASSERT(r, *glyph->path() == *expected->path());
+        }
+    }
+
+    // Anything that isn't a snapshot of this version is rejected.
+    SkStrikeCache rejected;
+    REPORTER_ASSERT(r, !rejected.readSnapshot(snapshot->data(), snapshot->size() / 2));
+    sk_sp<SkData> older = SkData::MakeWithCopy(snapshot->data(), snapshot->size());
+    static_cast<uint32_t*>(older->writable_data())[1] += 1;
+    REPORTER_ASSERT(r, !rejected.readSnapshot(older->data(), older->size()));
+}
+
+DEF_TEST(StrikeCache_snapshotFile, r) {
+    SkString tmpDir = skiatest::GetTmpDir();
+    if (tmpDir.isEmpty()) {
+        return;
+    }
+    SkString path = SkOSPath::Join(tmpDir.c_str(), "font_cache_snapshot");
+
+    SkFont font(nullptr, 13);
+    SkAutoDescriptor ad;
+    SkScalerContextEffects effects;
+    SkDescriptor* desc = make_descriptor(font, &ad, &effects);
+    {
+        auto strike = SkStrikeCache::FindOrCreateStrikeExclusive(
+                *desc, effects, *font.getTypefaceOrDefault());
+        strike->findImage(strike->getGlyphIDMetrics(1));
+    }
+    REPORTER_ASSERT(r, SkGraphics::WriteFontCacheSnapshot(path.c_str()));
+    SkGraphics::PurgeFontCache();
+    REPORTER_ASSERT(r, SkGraphics::LoadFontCacheSnapshot(path.c_str()));
+    REPORTER_ASSERT(r, SkStrikeCache::FindStrikeExclusive(*desc));
+
+    SkString missing = SkOSPath::Join(tmpDir.c_str(), "no_such_snapshot");
+    REPORTER_ASSERT(r, !SkGraphics::LoadFontCacheSnapshot(missing.c_str()));
+}
+
+// prepareForDrawing() finds the same glyphs as glyphMetrics(), and they all have their images.
+DEF_TEST(StrikeCache_prepareForDrawing, r) {
+    SkFont font(nullptr, 16);
+    SkAutoDescriptor ad;
+    SkScalerContextEffects effects;
+    SkDescriptor* desc = make_descriptor(font, &ad, &effects);
+
+    SkStrikeCache cache;
+    auto strike = cache.findOrCreateStrikeExclusive(*desc, effects, *font.getTypefaceOrDefault());
+
+    const SkGlyphID ids[] = {3, 1, 4, 1, 5, 9, 2, 6};
+    const int kCount = SK_ARRAY_COUNT(ids);
+    SkPoint positions[kCount];
+    for (int i = 0; i < kCount; ++i) {
+        positions[i] = {10.0f * i, 20};
+    }
+    positions[2] = {SK_ScalarNaN, 20};
+
+    SkGlyphPos prepared[kCount];
+    int count = strike->prepareForDrawing(ids, positions, kCount, prepared);
+    SkGlyphPos expected[kCount];
+    REPORTER_ASSERT(r, count == strike->glyphMetrics(ids, positions, kCount, expected));
+    REPORTER_ASSERT(r, count < kCount);
+    for (int i = 0; i < count; ++i) {
+        REPORTER_ASSERT(r, prepared[i].glyph == expected[i].glyph);
+        REPORTER_ASSERT(r, prepared[i].position == expected[i].position);
+        REPORTER_ASSERT(r, prepared[i].glyph->fImage != nullptr);
+    }
+}
@@ -185,3 +185,45 @@ DEF_TEST(Stroke, reporter) {
     test_strokerec_equality(reporter);
     test_big_stroke(reporter);
 }
+
+// Long non-volatile paths have their strokes cached. The cached outline must follow any edits
+// to the source path and any change of stroke parameters.
+DEF_TEST(Stroke_cachedPolyline, reporter) {
+    SkPath path;
+    path.moveTo(0, 0);
+    for (int i = 1; i < 100; ++i) {
+        path.lineTo(SkIntToScalar(i * 3), SkIntToScalar((i % 2) * 10));
+    }
+
+    SkStroke stroke;
+    stroke.setWidth(4);
+    stroke.setJoin(SkPaint::kMiter_Join);
+
+    SkPath first, second;
+    stroke.strokePath(path, &first);
+    stroke.strokePath(path, &second);
+    REPORTER_ASSERT(reporter, first == second);
+
+    SkPath wider;
+    stroke.setWidth(8);
+    stroke.strokePath(path, &wider);
+    REPORTER_ASSERT(reporter, wider != first);
+
+    SkPath uncached;
+    SkPath volatilePath(path);
+    volatilePath.setIsVolatile(true);
+    stroke.setWidth(4);
+    stroke.strokePath(volatilePath, &uncached);
+    REPORTER_ASSERT(reporter, uncached == first);
+
+    path.lineTo(400, 400);
+    SkPath edited;
+    stroke.strokePath(path, &edited);
+    REPORTER_ASSERT(reporter, edited != first);
+    REPORTER_ASSERT(reporter, edited.getBounds().contains(SkRect::MakeXYWH(399, 399, 2, 2)));
+
+    // Stroking a path into itself must also work on a cache hit.
+    SkPath inPlace(path);
+    stroke.strokePath(inPlace, &inPlace);
+    REPORTER_ASSERT(reporter, inPlace == edited);
+}
@@ -12,7 +12,9 @@
 #include "GrGpuResourcePriv.h"
 #include "GrRenderTargetContext.h"
 #include "GrResourceProvider.h"
+#include "SkAutoPixmapStorage.h"
 #include "SkCanvas.h"
+#include "SkConvertPixels.h"
 #include "SkData.h"
 #include "SkDevice.h"
 #include "SkGpuDevice.h"
@@ -997,6 +999,94 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(OverdrawSurface_Gpu, r, ctxInfo) {
     test_overdraw_surface(r, surface.get());
 }
 
+struct AsyncReadResult {
+    bool                  fCalled = false;
+    SkAutoPixmapStorage   fPixels;
+    std::vector<uint8_t>  fPlanes[3];
+};
+
+static void async_read_callback(SkSurface::ReadPixelsContext context, const void* pixels,
+                                size_t rowBytes) {
+    auto result = static_cast<AsyncReadResult*>(context);
+    result->fCalled = true;
+    if (pixels) {
+        SkRectMemcpy(result->fPixels.writable_addr(), result->fPixels.rowBytes(), pixels, rowBytes,
+                     result->fPixels.info().minRowBytes(), result->fPixels.height());
+    } else {
+        result->fPixels.reset();
+    }
+}
+
+static void async_read_yuv_callback(SkSurface::ReadPixelsContext context, const void* planes[3],
+                                    const size_t rowBytes[3]) {
+    auto result = static_cast<AsyncReadResult*>(context);
+    result->fCalled = true;
+    if (planes) {
+        // Only the first byte of each plane is checked.
+        for (int i = 0; i < 3; ++i) {
+            result->fPlanes[i].assign(static_cast<const uint8_t*>(planes[i]),
+                                      static_cast<const uint8_t*>(planes[i]) + 1);
+        }
+    }
+}
+
+// Left half red, right half blue.
+static void test_async_read_pixels(skiatest::Reporter* r, SkSurface* surface,
+                                   const std::function<void()>& finish) {
+    SkCanvas* canvas = surface->getCanvas();
+    int w = surface->width(), h = surface->height();
+    canvas->clear(SK_ColorBLUE);
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeWH(w / 2, h), paint);
+
+    AsyncReadResult result;
+    SkImageInfo info = SkImageInfo::Make(w / 2, 2, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    result.fPixels.alloc(info);
+    surface->asyncReadPixels(info, w / 4, 1, async_read_callback, &result);
+    finish();
+    REPORTER_ASSERT(r, result.fCalled);
+    REPORTER_ASSERT(r, result.fPixels.addr());
+    if (result.fPixels.addr()) {
+        REPORTER_ASSERT(r, result.fPixels.getColor(0, 0) == SK_ColorRED);
+        REPORTER_ASSERT(r, result.fPixels.getColor(info.width() - 1, 1) == SK_ColorBLUE);
+    }
+
+    // Reads outside the surface fail.
+    AsyncReadResult outside;
+    outside.fPixels.alloc(info);
+    surface->asyncReadPixels(info, w - 1, 0, async_read_callback, &outside);
+    REPORTER_ASSERT(r, outside.fCalled && !outside.fPixels.addr());
+
+    AsyncReadResult yuv;
+    surface->asyncReadPixelsYUV420(kIdentity_SkYUVColorSpace, SkIRect::MakeWH(2, 2),
+                                   async_read_yuv_callback, &yuv);
+    finish();
+    REPORTER_ASSERT(r, yuv.fCalled);
+    if (!yuv.fPlanes[0].empty()) {
+        REPORTER_ASSERT(r, yuv.fPlanes[0][0] == 0xFF && yuv.fPlanes[1][0] == 0 &&
+                           yuv.fPlanes[2][0] == 0);
+    }
+}
+
+DEF_TEST(Surface_asyncReadPixels, r) {
+    sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(16, 16);
+    test_async_read_pixels(r, surface.get(), [] {});
+}
+
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(Surface_asyncReadPixels_Gpu, r, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    for (GrSurfaceOrigin origin : {kTopLeft_GrSurfaceOrigin, kBottomLeft_GrSurfaceOrigin}) {
+        sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(
+                context, SkBudgeted::kNo, SkImageInfo::MakeN32Premul(16, 16), 0, origin, nullptr);
+        if (!surface) {
+            continue;
+        }
+        test_async_read_pixels(r, surface.get(),
+                               [context] { context->checkAsyncWorkCompletion(true); });
+    }
+}
+
 DEF_TEST(Surface_null, r) {
     REPORTER_ASSERT(r, SkSurface::MakeNull(0, 0) == nullptr);
 
@@ -6,11 +6,14 @@
  */
 
 #include "SkImageInfoPriv.h"
+#include "SkRandom.h"
 #include "SkSwizzle.h"
 #include "SkSwizzler.h"
 #include "Test.h"
 #include "SkOpts.h"
 
+#include <vector>
+
 static void check_fill(skiatest::Reporter* r,
                        const SkImageInfo& imageInfo,
                        uint32_t startRow,
@@ -144,6 +147,47 @@ DEF_TEST(SwizzleOpts, r) {
     REPORTER_ASSERT(r, dst == 0xFA04ADCA);
 }
 
+// The 16-bit procs should match narrowing each pixel and then using the 8-bit procs, for every
+// row length around the vector widths.
+DEF_TEST(SwizzleOpts_16bit, r) {
+    SkRandom random;
+    uint8_t src[37 * 8];
+    for (uint8_t& byte : src) {
+        byte = random.nextU() & 0xFF;
+    }
+
+    for (int count = 0; count <= 37; count++) {
+        uint32_t rgba[37], rgb1[37];
+        for (int i = 0; i < count; i++) {
+            const uint8_t* px = src + i*8;
+            rgba[i] = (uint32_t)px[6] << 24 | (uint32_t)px[4] << 16
+                    | (uint32_t)px[2] <<  8 | (uint32_t)px[0] <<  0;
+            px = src + i*6;
+            rgb1[i] = 0xFF000000 | (uint32_t)px[4] << 16 | (uint32_t)px[2] << 8 | px[0];
+        }
+
+        uint32_t want[37], got[37];
+        auto check = [&](SkOpts::Swizzle_8888_u8 proc) {
+            proc(got, src, count);
+            REPORTER_ASSERT(r, 0 == memcmp(got, want, count * sizeof(uint32_t)));
+        };
+
+        memcpy(want, rgb1, sizeof(want));
+        check(SkOpts::RGB16_to_RGB1);
+        SkOpts::RGBA_to_BGRA(want, rgb1, count);
+        check(SkOpts::RGB16_to_BGR1);
+
+        memcpy(want, rgba, sizeof(want));
+        check(SkOpts::RGBA16_to_RGBA);
+        SkOpts::RGBA_to_BGRA(want, rgba, count);
+        check(SkOpts::RGBA16_to_BGRA);
+        SkOpts::RGBA_to_rgbA(want, rgba, count);
+        check(SkOpts::RGBA16_to_rgbA);
+        SkOpts::RGBA_to_bgrA(want, rgba, count);
+        check(SkOpts::RGBA16_to_bgrA);
+    }
+}
+
 DEF_TEST(PublicSwizzleOpts, r) {
     uint32_t dst, src;
 
@@ -152,3 +196,57 @@ DEF_TEST(PublicSwizzleOpts, r) {
     SkSwapRB(&dst, &src, 1);
     REPORTER_ASSERT(r, dst == 0xFA04B0CE);
 }
+
+static int png_paeth(int a, int b, int c) {
+    int pa = SkTAbs(b - c),
+        pb = SkTAbs(a - c),
+        pc = SkTAbs(a + b - 2*c);
+    return (pa <= pb && pa <= pc) ? a
+         : (pb <= pc)             ? b
+         :                          c;
+}
+
+// Straight from the PNG spec, one byte at a time.
+static void png_unfilter(int filter, int bpp, uint8_t* row, const uint8_t* prev, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        int a = i >= bpp ? row[i - bpp]  : 0,
+            b = prev[i],
+            c = i >= bpp ? prev[i - bpp] : 0;
+        switch (filter) {
+            case 1: row[i] += a;                   break;
+            case 2: row[i] += b;                   break;
+            case 3: row[i] += (a + b) >> 1;        break;
+            case 4: row[i] += png_paeth(a, b, c);  break;
+        }
+    }
+}
+
+DEF_TEST(PngUnfilterOpts, r) {
+    const SkOpts::PngUnfilter unfilters[][2] = {
+        { SkOpts::png_unfilter_sub3,   SkOpts::png_unfilter_sub4   },
+        { SkOpts::png_unfilter_up,     SkOpts::png_unfilter_up     },
+        { SkOpts::png_unfilter_avg3,   SkOpts::png_unfilter_avg4   },
+        { SkOpts::png_unfilter_paeth3, SkOpts::png_unfilter_paeth4 },
+    };
+
+    SkRandom rand;
+    for (int bpp = 3; bpp <= 4; bpp++)
+    for (int pixels : { 1, 2, 7, 64, 333 }) {
+        const int bytes = pixels * bpp;
+        std::vector<uint8_t> row(bytes), prev(bytes);
+        for (int i = 0; i < bytes; i++) {
+            // Lots of extremes, to catch any overflow in the vector math.
+            row[i]  = rand.nextBool() ? (rand.nextBool() ? 0xFF : 0x00) : rand.nextU();
+            prev[i] = rand.nextBool() ? (rand.nextBool() ? 0xFF : 0x00) : rand.nextU();
+        }
+
+        for (int filter = 1; filter <= 4; filter++) {
+            std::vector<uint8_t> expected = row,
+                                 actual   = row;
+            png_unfilter(filter, bpp, expected.data(), prev.data(), bytes);
+            unfilters[filter - 1][bpp - 3](actual.data(), prev.data(), bytes);
+            REPORTER_ASSERT(r, expected == actual, "filter %d, bpp %d, %d pixels",
+                            filter, bpp, pixels);
+        }
+    }
+}
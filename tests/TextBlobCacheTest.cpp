@@ -26,6 +26,7 @@
 
 #include "GrContext.h"
 #include "GrContextPriv.h"
+#include "text/GrTextBlobCache.h"
 
 static void draw(SkCanvas* canvas, int redraw, const SkTArray<sk_sp<SkTextBlob>>& blobs) {
     int yOffset = 0;
@@ -170,3 +171,47 @@ DEF_GPUTEST_FOR_NULLGL_CONTEXT(TextBlobAbnormal, reporter, ctxInfo) {
 DEF_GPUTEST_FOR_NULLGL_CONTEXT(TextBlobStressAbnormal, reporter, ctxInfo) {
     text_blob_cache_inner(reporter, ctxInfo.grContext(), 256, 256, 10, false, true);
 }
+
+// Cached blobs are counted, purged once unused for long enough, and budgeted along with the GPU
+// resource cache.
+DEF_GPUTEST_FOR_NULLGL_CONTEXT(TextBlobCachePurgeNotUsed, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    GrTextBlobCache* cache = context->priv().getTextBlobCache();
+
+    SkImageInfo info = SkImageInfo::MakeN32Premul(256, 256);
+    auto surface(SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info));
+    REPORTER_ASSERT(reporter, surface);
+    if (!surface) {
+        return;
+    }
+
+    SkFont font;
+    font.setSize(12);
+    sk_sp<SkTextBlob> blob = SkTextBlob::MakeFromString("cached", font);
+    SkTArray<sk_sp<SkTextBlob>> blobs;
+    blobs.push_back(blob);
+
+    GrTextBlobCache::Stats before = cache->stats();
+    draw(surface->getCanvas(), 2, blobs);
+    REPORTER_ASSERT(reporter, cache->blobCount() == 1);
+    REPORTER_ASSERT(reporter, cache->stats().fMisses == before.fMisses + 1);
+    REPORTER_ASSERT(reporter, cache->stats().fHits == before.fHits + 1);
+
+    // Blobs drawn within the period survive.
+    context->performDeferredCleanup(std::chrono::hours(1));
+    REPORTER_ASSERT(reporter, cache->blobCount() == 1);
+
+    context->performDeferredCleanup(std::chrono::milliseconds(0));
+    REPORTER_ASSERT(reporter, cache->blobCount() == 0);
+    REPORTER_ASSERT(reporter, cache->usedBytes() == 0);
+    REPORTER_ASSERT(reporter, cache->stats().fPurgedNotUsed == before.fPurgedNotUsed + 1);
+
+    int maxResources;
+    size_t maxResourceBytes;
+    context->getResourceCacheLimits(&maxResources, &maxResourceBytes);
+    context->setResourceCacheLimits(maxResources, 2 * maxResourceBytes);
+    REPORTER_ASSERT(reporter,
+                    cache->getBudget() == GrTextBlobCache::BudgetForResourceBytes(
+                                                  2 * maxResourceBytes));
+    context->setResourceCacheLimits(maxResources, maxResourceBytes);
+}
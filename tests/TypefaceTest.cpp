@@ -215,6 +215,44 @@ DEF_TEST(TypefaceVariationIndex, reporter) {
     REPORTER_ASSERT(reporter, positionRead[0].value == 0.5);
 }
 
+DEF_TEST(TypefaceVariationInstances, reporter) {
+    sk_sp<SkFontMgr> fm = SkFontMgr::RefDefault();
+    sk_sp<SkTypeface> typeface = fm->makeFromStream(GetResourceAsStream("fonts/Distortable.ttf"));
+    if (!typeface) {
+        return;
+    }
+
+    auto clone = [&typeface](SkScalar weight) {
+        SkFontArguments::VariationPosition::Coordinate position[] = {
+            { SkSetFourByteTag('w','g','h','t'), weight }
+        };
+        return typeface->makeClone(SkFontArguments().setVariationDesignPosition(
+                {position, SK_ARRAY_COUNT(position)}));
+    };
+    auto weight_of = [](const sk_sp<SkTypeface>& instance) {
+        SkFontArguments::VariationPosition::Coordinate position[1];
+        int count = instance->getVariationDesignPosition(position, SK_ARRAY_COUNT(position));
+        return count == 1 ? position[0].value : -1;
+    };
+
+    sk_sp<SkTypeface> light = clone(0.75f);
+    sk_sp<SkTypeface> heavy = clone(1.5f);
+    if (!light || !heavy || weight_of(light) == -1) {
+        return;
+    }
+    REPORTER_ASSERT(reporter, light->uniqueID() != heavy->uniqueID());
+    REPORTER_ASSERT(reporter, weight_of(heavy) == 1.5f);
+
+    // A backend may hand back a live instance for the same or a nearby position instead of
+    // making a new typeface, but that instance must be at the position it was first made for.
+    sk_sp<SkTypeface> again = clone(0.75f);
+    sk_sp<SkTypeface> nearby = clone(0.751f);
+    REPORTER_ASSERT(reporter, weight_of(again) == 0.75f);
+    if (nearby->uniqueID() == light->uniqueID()) {
+        REPORTER_ASSERT(reporter, weight_of(nearby) == 0.75f);
+    }
+}
+
 DEF_TEST(Typeface, reporter) {
 
     sk_sp<SkTypeface> t1(SkTypeface::MakeFromName(nullptr, SkFontStyle()));
@@ -297,6 +335,41 @@ DEF_TEST(TypefaceCache, reporter) {
     REPORTER_ASSERT(reporter, t1->unique());
 }
 
+static bool match_proc(SkTypeface* face, void* ctx) {
+    return face == ctx;
+}
+
+DEF_TEST(TypefaceCache_hashed, reporter) {
+    sk_sp<SkTypeface> t1(SkTestEmptyTypeface::Make());
+    sk_sp<SkTypeface> t2(SkTestEmptyTypeface::Make());
+    sk_sp<SkTypeface> t3(SkTestEmptyTypeface::Make());
+    {
+        SkTypefaceCache cache;
+        cache.add(t1, 7);
+        cache.add(t2, 7);
+        cache.add(t3);
+        REPORTER_ASSERT(reporter, count(reporter, cache) == 3);
+
+        REPORTER_ASSERT(reporter, cache.findByHashAndRef(7, match_proc, t1.get()) == t1);
+        REPORTER_ASSERT(reporter, cache.findByHashAndRef(7, match_proc, t2.get()) == t2);
+        REPORTER_ASSERT(reporter, !cache.findByHashAndRef(8, match_proc, t1.get()));
+        // Typefaces added without a hash are only found by findByProcAndRef().
+        REPORTER_ASSERT(reporter, !cache.findByHashAndRef(7, match_proc, t3.get()));
+        REPORTER_ASSERT(reporter, cache.findByProcAndRef(match_proc, t3.get()) == t3);
+        REPORTER_ASSERT(reporter, cache.findByProcAndRef(match_proc, t2.get()) == t2);
+
+        // Purging drops uniquely owned typefaces from the hashed index too.
+        void* t1Addr = t1.get();
+        t1.reset();
+        cache.purgeAll();
+        REPORTER_ASSERT(reporter, count(reporter, cache) == 2);
+        REPORTER_ASSERT(reporter, !cache.findByHashAndRef(7, match_proc, t1Addr));
+        REPORTER_ASSERT(reporter, cache.findByHashAndRef(7, match_proc, t2.get()) == t2);
+    }
+    REPORTER_ASSERT(reporter, t2->unique());
+    REPORTER_ASSERT(reporter, t3->unique());
+}
+
 static void check_serialize_behaviors(sk_sp<SkTypeface> tf, bool isLocalData,
                                       skiatest::Reporter* reporter) {
     if (!tf) {
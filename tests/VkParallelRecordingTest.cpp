@@ -0,0 +1,88 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+// This is a GPU-backend specific test. It relies on static intializers to work
+
+#include "SkTypes.h"
+
+#if SK_SUPPORT_GPU && defined(SK_VULKAN)
+
+#include "GrContext.h"
+#include "GrContextFactory.h"
+#include "SkCanvas.h"
+#include "SkExecutor.h"
+#include "SkSurface.h"
+#include "Test.h"
+
+using sk_gpu_test::GrContextFactory;
+
+static const int kSize = 16;
+
+// Draws into several surfaces in one flush, reading some back in the middle, with the secondary
+// command buffers for each render pass recorded on other threads.
+DEF_GPUTEST(VkParallelRecording, reporter, options) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    GrContextOptions parallelOptions = options;
+    parallelOptions.fExecutor = executor.get();
+    parallelOptions.fParallelVulkanRecording = true;
+
+    GrContextFactory factory(parallelOptions);
+    GrContext* context = factory.get(GrContextFactory::kVulkan_ContextType);
+    if (!context) {
+        return;
+    }
+
+    static const SkColor kColors[] = {
+        SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, SK_ColorCYAN, SK_ColorMAGENTA, SK_ColorYELLOW,
+    };
+    static constexpr int kSurfaceCnt = SK_ARRAY_COUNT(kColors);
+
+    const SkImageInfo ii = SkImageInfo::MakeN32Premul(kSize, kSize);
+    sk_sp<SkSurface> surfaces[kSurfaceCnt];
+    for (int i = 0; i < kSurfaceCnt; ++i) {
+        surfaces[i] = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, ii);
+        if (!surfaces[i]) {
+            ERRORF(reporter, "Could not create surface %d.", i);
+            return;
+        }
+    }
+
+    for (int frame = 0; frame < 3; ++frame) {
+        for (int i = 0; i < kSurfaceCnt; ++i) {
+            SkCanvas* canvas = surfaces[i]->getCanvas();
+            canvas->clear(SK_ColorWHITE);
+            SkPaint paint;
+            paint.setColor(kColors[(i + frame) % kSurfaceCnt]);
+            canvas->drawRect(SkRect::MakeWH(kSize, kSize / 2), paint);
+            // Sampling another surface forces a new render pass on this one as well.
+            if (i > 0) {
+                sk_sp<SkImage> image = surfaces[i - 1]->makeImageSnapshot();
+                canvas->drawImageRect(image, SkRect::MakeXYWH(0, kSize / 2, kSize, kSize / 2),
+                                      nullptr);
+            }
+        }
+
+        for (int i = 0; i < kSurfaceCnt; ++i) {
+            SkBitmap bitmap;
+            bitmap.allocPixels(ii);
+            if (!surfaces[i]->readPixels(bitmap, 0, 0)) {
+                ERRORF(reporter, "Could not read surface %d.", i);
+                continue;
+            }
+            SkColor expected = kColors[(i + frame) % kSurfaceCnt];
+            REPORTER_ASSERT(reporter, bitmap.getColor(kSize / 2, 0) == expected,
+                            "frame %d, surface %d", frame, i);
+            if (i > 0) {
+                SkColor previous = kColors[(i - 1 + frame) % kSurfaceCnt];
+                REPORTER_ASSERT(reporter, bitmap.getColor(kSize / 2, kSize / 4 * 3) == previous,
+                                "frame %d, surface %d", frame, i);
+            }
+        }
+    }
+}
+
+#endif
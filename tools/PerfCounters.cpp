@@ -0,0 +1,111 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "PerfCounters.h"
+#include "SkTypes.h"
+
+using sk_tools::PerfCounters;
+
+const char* PerfCounters::Name(Counter c) {
+    switch (c) {
+        case kInstructions: return "instructions";
+        case kCycles:       return "cycles";
+        case kL1DMisses:    return "l1d_misses";
+        case kLLCMisses:    return "llc_misses";
+        case kBranchMisses: return "branch_misses";
+        case kCounterCount: break;
+    }
+    SkASSERT(false);
+    return "";
+}
+
+bool PerfCounters::isAvailable() const {
+    for (int c = 0; c < kCounterCount; ++c) {
+        if (this->isAvailable((Counter)c)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if defined(SK_BUILD_FOR_UNIX) || defined(SK_BUILD_FOR_ANDROID)  // N.B. perf_event is Linux-only.
+    #include <linux/perf_event.h>
+    #include <string.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+
+    static int open_counter(uint32_t type, uint64_t config) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size           = sizeof(attr);
+        attr.type           = type;
+        attr.config         = config;
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        // pid 0, cpu -1: this thread, on whichever cpu it runs.
+        return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+
+    static constexpr uint64_t cache_miss(uint64_t cache) {
+        return cache
+             | (PERF_COUNT_HW_CACHE_OP_READ     <<  8)
+             | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+
+    PerfCounters::PerfCounters() {
+        fFDs[kInstructions] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        fFDs[kCycles]       = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        fFDs[kL1DMisses]    = open_counter(PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D));
+        fFDs[kLLCMisses]    = open_counter(PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL));
+        fFDs[kBranchMisses] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    }
+
+    PerfCounters::~PerfCounters() {
+        for (int fd : fFDs) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    void PerfCounters::start() {
+        for (int fd : fFDs) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    void PerfCounters::stop() {
+        for (int fd : fFDs) {
+            if (fd >= 0) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            }
+        }
+    }
+
+    uint64_t PerfCounters::read(Counter c) const {
+        uint64_t value = 0;
+        if (fFDs[c] < 0 || ::read(fFDs[c], &value, sizeof(value)) != sizeof(value)) {
+            return 0;
+        }
+        return value;
+    }
+#else
+    PerfCounters::PerfCounters() {
+        for (int& fd : fFDs) {
+            fd = -1;
+        }
+    }
+    PerfCounters::~PerfCounters() {}
+    void PerfCounters::start() {}
+    void PerfCounters::stop() {}
+    uint64_t PerfCounters::read(Counter) const { return 0; }
+#endif
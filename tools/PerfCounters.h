@@ -0,0 +1,64 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef PerfCounters_DEFINED
+#define PerfCounters_DEFINED
+
+#include <stdint.h>
+
+namespace sk_tools {
+
+/**
+ *  PerfCounters - hardware performance counters for the calling thread.
+ *
+ *  On Linux and Android this opens one perf_event per counter (user space only). Elsewhere, or
+ *  when the kernel refuses (e.g. perf_event_paranoid is too strict, or the PMU has no such
+ *  event), the affected counters are simply unavailable.
+ */
+class PerfCounters {
+public:
+    enum Counter {
+        kInstructions,
+        kCycles,
+        kL1DMisses,
+        kLLCMisses,
+        kBranchMisses,
+
+        kCounterCount
+    };
+
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /** Short snake_case name for the counter, suitable as a JSON key. */
+    static const char* Name(Counter);
+
+    /** Returns true if the counter could be opened. */
+    bool isAvailable(Counter c) const { return fFDs[c] >= 0; }
+
+    /** Returns true if any counter could be opened. */
+    bool isAvailable() const;
+
+    /** Zeroes and enables all available counters. */
+    void start();
+
+    /** Disables all available counters. Values can then be read with read(). */
+    void stop();
+
+    /** Returns the count between the last start() and stop(), or 0 if unavailable. */
+    uint64_t read(Counter) const;
+
+private:
+    int fFDs[kCounterCount];
+};
+
+}  // namespace sk_tools
+
+#endif  // PerfCounters_DEFINED
@@ -25,14 +25,55 @@
 #define SKDEBUGCANVAS_ATTRIBUTE_COMMANDS          "commands"
 #define SKDEBUGCANVAS_ATTRIBUTE_AUDITTRAIL        "auditTrail"
 
+// drawTo() snapshots the canvas every kCheckpointInterval commands, as long as the snapshots fit
+// in kCheckpointBudget bytes.
+static constexpr int    kCheckpointInterval = 256;
+static constexpr size_t kCheckpointBudget   = 256 * 1024 * 1024;
+
 class DebugPaintFilterCanvas : public SkPaintFilterCanvas {
 public:
     DebugPaintFilterCanvas(SkCanvas* canvas,
                            bool overdrawViz)
         : INHERITED(canvas)
-        , fOverdrawViz(overdrawViz) {}
+        , fOverdrawViz(overdrawViz)
+        , fReplayingState(false)
+        , fOpenLayers(0) {}
+
+    /**
+     * While set, saveLayer() only saves. Used to rebuild the matrix and clip stack up to a
+     * checkpoint, where no layer is open, without drawing anything.
+     */
+    void setReplayingState(bool replayingState) { fReplayingState = replayingState; }
+
+    int openLayerCount() const { return fOpenLayers; }
 
 protected:
+    void willSave() override {
+        fSaveIsLayer.push_back(false);
+        this->INHERITED::willSave();
+    }
+
+    SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec& rec) override {
+        if (fReplayingState) {
+            fSaveIsLayer.push_back(false);
+            this->INHERITED::willSave();
+            return kNoLayer_SaveLayerStrategy;
+        }
+        fSaveIsLayer.push_back(true);
+        fOpenLayers++;
+        return this->INHERITED::getSaveLayerStrategy(rec);
+    }
+
+    void willRestore() override {
+        if (!fSaveIsLayer.empty()) {
+            if (fSaveIsLayer.back()) {
+                fOpenLayers--;
+            }
+            fSaveIsLayer.pop_back();
+        }
+        this->INHERITED::willRestore();
+    }
+
     bool onFilter(SkTCopyOnFirstWrite<SkPaint>* paint, Type) const override {
         if (*paint) {
             if (fOverdrawViz) {
@@ -53,6 +94,9 @@ protected:
 
 private:
     bool fOverdrawViz;
+    bool fReplayingState;
+    int fOpenLayers;
+    SkTArray<bool> fSaveIsLayer;
 
     typedef SkPaintFilterCanvas INHERITED;
 };
@@ -61,7 +105,8 @@ SkDebugCanvas::SkDebugCanvas(int width, int height)
         : INHERITED(width, height)
         , fOverdrawViz(false)
         , fClipVizColor(SK_ColorTRANSPARENT)
-        , fDrawGpuOpBounds(false) {
+        , fDrawGpuOpBounds(false)
+        , fCheckpointBytes(0) {
     // SkPicturePlayback uses the base-class' quickReject calls to cull clipped
     // operations. This can lead to problems in the debugger which expects all
     // the operations in the captured skp to appear in the debug canvas. To
@@ -89,6 +134,26 @@ void SkDebugCanvas::addDrawCommand(SkDrawCommand* command) {
     fCommandVector.push_back(command);
 }
 
+// Commands that only change the matrix and clip stack.
+static bool is_state_command(SkDrawCommand::OpType type) {
+    switch (type) {
+        case SkDrawCommand::kBeginDrawPicture_OpType:
+        case SkDrawCommand::kClipPath_OpType:
+        case SkDrawCommand::kClipRegion_OpType:
+        case SkDrawCommand::kClipRect_OpType:
+        case SkDrawCommand::kClipRRect_OpType:
+        case SkDrawCommand::kConcat_OpType:
+        case SkDrawCommand::kEndDrawPicture_OpType:
+        case SkDrawCommand::kRestore_OpType:
+        case SkDrawCommand::kSave_OpType:
+        case SkDrawCommand::kSaveLayer_OpType:
+        case SkDrawCommand::kSetMatrix_OpType:
+            return true;
+        default:
+            return false;
+    }
+}
+
 void SkDebugCanvas::draw(SkCanvas* canvas) {
     if (!fCommandVector.isEmpty()) {
         this->drawTo(canvas, fCommandVector.count() - 1);
@@ -119,7 +184,39 @@ void SkDebugCanvas::drawTo(SkCanvas* originalCanvas, int index, int m) {
         at = this->getAuditTrail(originalCanvas);
     }
 
-    for (int i = 0; i <= index; i++) {
+    // Checkpoints only hold pixels, so they can't stand in for the ops an audit trail collects.
+    const SkImageInfo info = originalCanvas->imageInfo();
+    const bool useCheckpoints = !at && !info.isEmpty() && kUnknown_SkColorType != info.colorType();
+    if (useCheckpoints && info != fCheckpointInfo) {
+        this->invalidateCheckpoints(0);
+        fCheckpointInfo = info;
+    }
+
+    int start = 0;
+    if (useCheckpoints) {
+        const Checkpoint* checkpoint = nullptr;
+        for (int i = fCheckpoints.count() - 1; i >= 0 && !checkpoint; i--) {
+            if (fCheckpoints[i].fIndex <= index) {
+                checkpoint = &fCheckpoints[i];
+            }
+        }
+        if (checkpoint) {
+            // No layer was open at the checkpoint, so turning the earlier layers into plain saves
+            // rebuilds the same matrix and clip stack.
+            filterCanvas.setReplayingState(true);
+            for (int i = 0; i <= checkpoint->fIndex; i++) {
+                if (fCommandVector[i]->isVisible() &&
+                    is_state_command(fCommandVector[i]->getOpType())) {
+                    fCommandVector[i]->execute(&filterCanvas);
+                }
+            }
+            filterCanvas.setReplayingState(false);
+            originalCanvas->writePixels(checkpoint->fPixels, 0, 0);
+            start = checkpoint->fIndex + 1;
+        }
+    }
+
+    for (int i = start; i <= index; i++) {
         // We need to flush any pending operations, or they might combine with commands below.
         // Previous operations were not registered with the audit trail when they were
         // created, so if we allow them to combine, the audit trail will fail to find them.
@@ -136,6 +233,19 @@ void SkDebugCanvas::drawTo(SkCanvas* originalCanvas, int index, int m) {
         if (at && acb) {
             delete acb;
         }
+
+        if (useCheckpoints && (i + 1) % kCheckpointInterval == 0 &&
+            filterCanvas.openLayerCount() == 0 &&
+            (fCheckpoints.empty() || fCheckpoints.back().fIndex < i) &&
+            info.computeMinByteSize() <= kCheckpointBudget - fCheckpointBytes) {
+            Checkpoint checkpoint;
+            checkpoint.fIndex = i;
+            if (checkpoint.fPixels.tryAllocPixels(info) &&
+                originalCanvas->readPixels(checkpoint.fPixels, 0, 0)) {
+                fCheckpointBytes += checkpoint.fPixels.computeByteSize();
+                fCheckpoints.push_back(std::move(checkpoint));
+            }
+        }
     }
 
     if (SkColorGetA(fClipVizColor) != 0) {
@@ -208,6 +318,14 @@ void SkDebugCanvas::deleteDrawCommandAt(int index) {
     SkASSERT(index < fCommandVector.count());
     delete fCommandVector[index];
     fCommandVector.remove(index);
+    this->invalidateCheckpoints(index);
+}
+
+void SkDebugCanvas::invalidateCheckpoints(int index) {
+    while (!fCheckpoints.empty() && fCheckpoints.back().fIndex >= index) {
+        fCheckpointBytes -= fCheckpoints.back().fPixels.computeByteSize();
+        fCheckpoints.pop_back();
+    }
 }
 
 SkDrawCommand* SkDebugCanvas::getDrawCommandAt(int index) {
@@ -289,6 +407,9 @@ void SkDebugCanvas::toJSONOpList(SkJSONWriter& writer, int n, SkCanvas* canvas)
 }
 
 void SkDebugCanvas::setOverdrawViz(bool overdrawViz) {
+    if (fOverdrawViz != overdrawViz) {
+        this->invalidateCheckpoints(0);
+    }
     fOverdrawViz = overdrawViz;
 }
 
@@ -484,5 +605,8 @@ void SkDebugCanvas::didSetMatrix(const SkMatrix& matrix) {
 
 void SkDebugCanvas::toggleCommand(int index, bool toggle) {
     SkASSERT(index < fCommandVector.count());
+    if (fCommandVector[index]->isVisible() != toggle) {
+        this->invalidateCheckpoints(index);
+    }
     fCommandVector[index]->setVisible(toggle);
 }
@@ -9,6 +9,7 @@
 #ifndef SKDEBUGCANVAS_H_
 #define SKDEBUGCANVAS_H_
 
+#include "SkBitmap.h"
 #include "SkCanvas.h"
 #include "SkCanvasVirtualEnforcer.h"
 #include "SkDrawCommand.h"
@@ -109,6 +110,7 @@ public:
 
     void detachCommands(SkTDArray<SkDrawCommand*>* dst) {
         fCommandVector.swap(*dst);
+        this->invalidateCheckpoints(0);
     }
 
 protected:
@@ -176,12 +178,32 @@ private:
     SkColor fClipVizColor;
     bool fDrawGpuOpBounds;
 
+    /**
+        A snapshot of the canvas' pixels right after the command at fIndex was executed, taken
+        while no layer was open. drawTo() starts from the closest one instead of from command 0,
+        so stepping through a long recording doesn't replay everything before each step.
+     */
+    struct Checkpoint {
+        int      fIndex;
+        SkBitmap fPixels;
+    };
+    // Sorted by fIndex.
+    SkTArray<Checkpoint> fCheckpoints;
+    size_t fCheckpointBytes;
+    // The checkpoints are only valid for canvases like the one they were read from.
+    SkImageInfo fCheckpointInfo;
+
     /**
         Adds the command to the class' vector of commands.
         @param command  The draw command for execution
      */
     void addDrawCommand(SkDrawCommand* command);
 
+    /**
+        Drops the checkpoints taken at or after the command at index.
+     */
+    void invalidateCheckpoints(int index);
+
     GrAuditTrail* getAuditTrail(SkCanvas*);
 
     void drawAndCollectOps(int n, SkCanvas*);
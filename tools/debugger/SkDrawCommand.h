@@ -76,6 +76,8 @@ public:
 
     virtual ~SkDrawCommand() {}
 
+    OpType getOpType() const { return fOpType; }
+
     bool isVisible() const {
         return fVisible;
     }
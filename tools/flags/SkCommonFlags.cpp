@@ -168,6 +168,9 @@ DEFINE_string(pr, "all",
 
 DEFINE_bool(disableExplicitAlloc, false, "Disable explicit allocation of GPU resources");
 DEFINE_bool(reduceOpListSplitting, false, "Improve opList sorting");
+DEFINE_bool(unboundedOpMerging, false, "Merge ops with any earlier op they can be reordered past");
+DEFINE_bool(disableImageMultitexturing, false,
+            "Don't sample several textures in one draw when batching images");
 
 void SetCtxOptionsFromCommonFlags(GrContextOptions* ctxOptions) {
     static std::unique_ptr<SkExecutor> gGpuExecutor = (0 != FLAGS_gpuThreads)
@@ -187,4 +190,6 @@ void SetCtxOptionsFromCommonFlags(GrContextOptions* ctxOptions) {
     if (FLAGS_reduceOpListSplitting) {
         ctxOptions->fReduceOpListSplitting = GrContextOptions::Enable::kYes;
     }
+    ctxOptions->fUnboundedOpMerging = FLAGS_unboundedOpMerging;
+    ctxOptions->fDisableImageMultitexturing = FLAGS_disableImageMultitexturing;
 }
@@ -18,6 +18,8 @@ DECLARE_bool(noGS);
 DECLARE_string(pr);
 DECLARE_bool(disableExplicitAlloc);
 DECLARE_bool(reduceOpListSplitting);
+DECLARE_bool(unboundedOpMerging);
+DECLARE_bool(disableImageMultitexturing);
 
 inline GpuPathRenderers get_named_pathrenderers_flags(const char* name) {
     if (!strcmp(name, "none")) {
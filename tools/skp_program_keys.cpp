@@ -0,0 +1,139 @@
+/*
+ * Copyright 2018 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "GrContext.h"
+#include "GrContextFactory.h"
+#include "GrFilePersistentCache.h"
+#include "SkCanvas.h"
+#include "SkCommandLineFlags.h"
+#include "SkCommonFlagsConfig.h"
+#include "SkCommonFlagsGpu.h"
+#include "SkGraphics.h"
+#include "SkPicture.h"
+#include "SkStream.h"
+#include "SkSurface.h"
+
+#include <set>
+#include <string>
+
+/**
+ * Plays skps through a GrContext and writes out the keys of every program the draws needed, one
+ * per line as hex. An app can read the list back at startup and hand each key to
+ * GrContext::precompile() to compile its programs before the first frame asks for them.
+ *
+ * precompile() builds programs from PersistentCache data, so the keys are only useful together
+ * with that data. Pass --cache to also save it to a GrFilePersistentCache file the app can ship.
+ */
+
+DEFINE_string2(skps, r, "", ".skp files to play back.");
+DEFINE_string2(out, o, "", "File to write the program keys to.");
+DEFINE_string(cache, "", "If set, also store the programs in a GrFilePersistentCache here.");
+
+// Forwards to an optional GrFilePersistentCache and remembers every key the GrContext asks for.
+class KeyRecordingCache : public GrContextOptions::PersistentCache {
+public:
+    explicit KeyRecordingCache(GrFilePersistentCache* cache) : fCache(cache) {}
+
+    sk_sp<SkData> load(const SkData& key) override {
+        this->record(key);
+        return fCache ? fCache->load(key) : nullptr;
+    }
+
+    void store(const SkData& key, const SkData& data) override {
+        this->record(key);
+        if (fCache) {
+            fCache->store(key, data);
+        }
+    }
+
+    const std::set<std::string>& keys() const { return fKeys; }
+
+private:
+    void record(const SkData& key) {
+        fKeys.emplace(static_cast<const char*>(key.data()), key.size());
+    }
+
+    GrFilePersistentCache* fCache;
+    std::set<std::string>  fKeys;
+};
+
+int main(int argc, char** argv) {
+    SkCommandLineFlags::SetUsage("Records the program keys reached when drawing skps.");
+    SkCommandLineFlags::Parse(argc, argv);
+
+    if (FLAGS_skps.isEmpty() || FLAGS_out.count() != 1) {
+        SkDebugf("Usage: skp_program_keys -r <skp>... -o <keys file> [--cache <file>]\n");
+        return 1;
+    }
+
+    SkCommandLineConfigArray configs;
+    ParseConfigs(FLAGS_config, &configs);
+    const SkCommandLineConfigGpu* config = configs.count() ? configs[0]->asConfigGpu() : nullptr;
+    if (configs.count() != 1 || !config) {
+        SkDebugf("Must specify one (and only one) GPU config with --config.\n");
+        return 1;
+    }
+
+    SkGraphics::Init();
+
+    std::unique_ptr<GrFilePersistentCache> fileCache;
+    if (!FLAGS_cache.isEmpty()) {
+        fileCache.reset(new GrFilePersistentCache(FLAGS_cache[0]));
+    }
+    KeyRecordingCache recorder(fileCache.get());
+
+    GrContextOptions ctxOptions;
+    SetCtxOptionsFromCommonFlags(&ctxOptions);
+    ctxOptions.fPersistentCache = &recorder;
+    sk_gpu_test::GrContextFactory factory(ctxOptions);
+    GrContext* context = factory.get(config->getContextType(), config->getContextOverrides());
+    if (!context) {
+        SkDebugf("Could not create a context for config %s.\n", config->getTag().c_str());
+        return 1;
+    }
+
+    for (int i = 0; i < FLAGS_skps.count(); ++i) {
+        std::unique_ptr<SkStream> stream = SkStream::MakeFromFile(FLAGS_skps[i]);
+        sk_sp<SkPicture> skp = stream ? SkPicture::MakeFromStream(stream.get()) : nullptr;
+        if (!skp) {
+            SkDebugf("Could not read %s.\n", FLAGS_skps[i]);
+            return 1;
+        }
+        SkIRect bounds = skp->cullRect().roundOut();
+        SkImageInfo info = SkImageInfo::Make(SkTMin(bounds.width(), 2048),
+                                             SkTMin(bounds.height(), 2048),
+                                             config->getColorType(), config->getAlphaType(),
+                                             sk_ref_sp(config->getColorSpace()));
+        sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info,
+                                                               config->getSamples(), nullptr);
+        if (!surface) {
+            SkDebugf("Could not create a %dx%d surface for %s.\n",
+                     info.width(), info.height(), FLAGS_skps[i]);
+            return 1;
+        }
+        surface->getCanvas()->translate(-bounds.x(), -bounds.y());
+        surface->getCanvas()->drawPicture(skp);
+        surface->flush();
+    }
+
+    SkFILEWStream out(FLAGS_out[0]);
+    if (!out.isValid()) {
+        SkDebugf("Could not open %s for writing.\n", FLAGS_out[0]);
+        return 1;
+    }
+    for (const std::string& key : recorder.keys()) {
+        for (unsigned char c : key) {
+            out.writeHexAsText(c, 2);
+        }
+        out.newline();
+    }
+    if (fileCache && !fileCache->flush()) {
+        SkDebugf("Could not write %s.\n", FLAGS_cache[0]);
+        return 1;
+    }
+    return 0;
+}
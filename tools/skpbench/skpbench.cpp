@@ -11,6 +11,8 @@
 #include "GrCaps.h"
 #include "GrContextFactory.h"
 #include "GrContextPriv.h"
+#include "GrOpTimingDump.h"
+#include "PerfCounters.h"
 #include "SkCanvas.h"
 #include "SkCommonFlags.h"
 #include "SkCommonFlagsGpu.h"
@@ -40,6 +42,7 @@
 #include <array>
 #include <chrono>
 #include <cmath>
+#include <thread>
 #include <vector>
 
 /**
@@ -67,6 +70,10 @@ DEFINE_string(src, "", "path to a single .skp or .svg file, or 'warmup' for a bu
 DEFINE_string(png, "", "if set, save a .png proof to disk at this file location");
 DEFINE_int32(verbosity, 4, "level of verbosity (0=none to 5=debug)");
 DEFINE_bool(suppressHeader, false, "don't print a header row before the results");
+DEFINE_bool(opTiming, false, "print the gpu time spent on each GrOp class to stderr afterwards");
+DEFINE_bool(perfCounters, false, "print per-frame cpu hardware counters to stderr afterwards");
+DEFINE_int32(vsyncHz, 0, "if nonzero, pace frames to a simulated display at this refresh rate "
+                         "(e.g. 60, 90, 120) and report per-frame percentiles instead");
 
 static const char* header =
 "   accum    median       max       min   stddev  samples  sample_ms  clock  metric  config    bench";
@@ -74,6 +81,12 @@ static const char* header =
 static const char* resultFormat =
 "%8.4g  %8.4g  %8.4g  %8.4g  %6.3g%%  %7li  %9i  %-5s  %-6s  %-9s %s";
 
+static const char* pacedHeader =
+"     p50       p90       p99       max  metric     hz  missed  frames  config    bench";
+
+static const char* pacedResultFormat =
+"%8.4g  %8.4g  %8.4g  %8.4g  %-9s %3i  %6i  %6i  %-9s %s";
+
 static constexpr int kNumFlushesToPrimeCache = 3;
 
 struct Sample {
@@ -89,6 +102,15 @@ struct Sample {
     duration   fDuration;
 };
 
+// One frame of a --vsyncHz run. Times are in milliseconds.
+struct PacedFrame {
+    double   fRecordMs;      // cpu time issuing the picture's draws
+    double   fFlushMs;       // cpu time in flush
+    double   fGpuMs;         // from the end of flush until the gpu signals completion
+    double   fFrameMs;       // from vsync until the gpu signals completion
+    int      fMissedVsyncs;  // vsyncs that went by with no new frame
+};
+
 class GpuSync {
 public:
     GpuSync(const sk_gpu_test::FenceSync* fenceSync);
@@ -194,7 +216,8 @@ static void run_ddl_benchmark(const sk_gpu_test::FenceSync* fenceSync,
 }
 
 static void run_benchmark(const sk_gpu_test::FenceSync* fenceSync, SkSurface* surface,
-                          const SkPicture* skp, std::vector<Sample>* samples) {
+                          const SkPicture* skp, std::vector<Sample>* samples,
+                          sk_tools::PerfCounters* counters) {
     using clock = std::chrono::high_resolution_clock;
     const Sample::duration sampleDuration = std::chrono::milliseconds(FLAGS_sampleMs);
     const clock::duration benchDuration = std::chrono::milliseconds(FLAGS_duration);
@@ -208,6 +231,9 @@ static void run_benchmark(const sk_gpu_test::FenceSync* fenceSync, SkSurface* su
         gpuSync.syncToPreviousFrame();
     }
 
+    if (counters) {
+        counters->start();
+    }
     clock::time_point now = clock::now();
     const clock::time_point endTime = now + benchDuration;
 
@@ -225,6 +251,62 @@ static void run_benchmark(const sk_gpu_test::FenceSync* fenceSync, SkSurface* su
             ++sample.fFrames;
         } while (sample.fDuration < sampleDuration);
     } while (now < endTime || 0 == samples->size() % 2);
+
+    if (counters) {
+        counters->stop();
+    }
+}
+
+// Simulates a display that presents at FLAGS_vsyncHz: each frame starts on a vsync, and the next
+// frame waits for the first vsync after the gpu has finished this one. A frame that takes longer
+// than one refresh interval makes the display repeat the previous frame (a missed vsync).
+static void run_paced_benchmark(const sk_gpu_test::FenceSync* fenceSync, SkSurface* surface,
+                                const SkPicture* skp, std::vector<PacedFrame>* frames) {
+    using clock = std::chrono::steady_clock;
+    using ms = std::chrono::duration<double, std::milli>;
+    const clock::duration interval = std::chrono::duration_cast<clock::duration>(
+            std::chrono::duration<double>(1.0 / FLAGS_vsyncHz));
+    const clock::duration benchDuration = std::chrono::milliseconds(FLAGS_duration);
+
+    for (int i = 0; i < kNumFlushesToPrimeCache; ++i) {
+        draw_skp_and_flush(surface, skp);
+    }
+    GpuSync(fenceSync).syncToPreviousFrame();
+
+    SkCanvas* canvas = surface->getCanvas();
+    clock::time_point vsync = clock::now();
+    const clock::time_point endTime = vsync + benchDuration;
+
+    while (vsync < endTime) {
+        std::this_thread::sleep_until(vsync);
+
+        clock::time_point start = clock::now();
+        canvas->drawPicture(skp);
+        clock::time_point recorded = clock::now();
+        surface->flush();
+        clock::time_point flushed = clock::now();
+        sk_gpu_test::PlatformFence fence = fenceSync->insertFence();
+        if (!fenceSync->waitFence(fence)) {
+            exitf(ExitErr::kUnavailable, "failed to wait for fence");
+        }
+        fenceSync->deleteFence(fence);
+        clock::time_point done = clock::now();
+
+        // The frame is presented on the first vsync after it is done.
+        clock::time_point nextVsync = vsync + interval;
+        int missed = 0;
+        while (nextVsync < done) {
+            nextVsync += interval;
+            ++missed;
+        }
+
+        frames->push_back({ms(recorded - start).count(),
+                           ms(flushed - recorded).count(),
+                           ms(done - flushed).count(),
+                           ms(done - vsync).count(),
+                           missed});
+        vsync = nextVsync;
+    }
 }
 
 static void run_gpu_time_benchmark(sk_gpu_test::GpuTimer* gpuTimer,
@@ -322,13 +404,51 @@ void print_result(const std::vector<Sample>& samples, const char* config, const
     fflush(stdout);
 }
 
+static void print_paced_result(const std::vector<PacedFrame>& frames, const char* config,
+                               const char* bench) {
+    if (frames.empty()) {
+        exitf(ExitErr::kSoftware, "attempted to gather stats on zero frames");
+    }
+    int missed = 0;
+    for (const PacedFrame& frame : frames) {
+        missed += frame.fMissedVsyncs;
+    }
+
+    auto print = [&](const char* metric, double PacedFrame::*field) {
+        std::vector<double> values;
+        values.reserve(frames.size());
+        for (const PacedFrame& frame : frames) {
+            values.push_back(frame.*field);
+        }
+        std::sort(values.begin(), values.end());
+        auto percentile = [&](int p) {
+            return values[std::min(values.size() - 1, values.size() * p / 100)];
+        };
+        printf(pacedResultFormat, percentile(50), percentile(90), percentile(99), values.back(),
+               metric, FLAGS_vsyncHz, missed, (int)frames.size(), config, bench);
+        printf("\n");
+    };
+    print("record_ms", &PacedFrame::fRecordMs);
+    print("flush_ms", &PacedFrame::fFlushMs);
+    print("gpu_ms", &PacedFrame::fGpuMs);
+    print("frame_ms", &PacedFrame::fFrameMs);
+    fflush(stdout);
+}
+
+class OpTimingPrinter : public GrOpTimingDump {
+public:
+    void dumpOpTiming(const char* name, int count, uint64_t gpuNanoseconds) override {
+        fprintf(stderr, "%10.3f ms  %8i  %s\n", gpuNanoseconds / 1e6, count, name);
+    }
+};
+
 int main(int argc, char** argv) {
     SkCommandLineFlags::SetUsage("Use skpbench.py instead. "
                                  "You usually don't want to use this program directly.");
     SkCommandLineFlags::Parse(argc, argv);
 
     if (!FLAGS_suppressHeader) {
-        printf("%s\n", header);
+        printf("%s\n", FLAGS_vsyncHz > 0 ? pacedHeader : header);
     }
     if (FLAGS_duration <= 0) {
         exit(0); // This can be used to print the header and quit.
@@ -434,6 +554,22 @@ int main(int argc, char** argv) {
                                      width, height, config->getTag().c_str());
     }
 
+    if (FLAGS_opTiming && !ctx->setOpTimingEnabled(true)) {
+        exitf(ExitErr::kUnavailable, "GPU does not support op timing");
+    }
+
+    std::unique_ptr<sk_tools::PerfCounters> perfCounters;
+    if (FLAGS_perfCounters) {
+        if (FLAGS_ddl || FLAGS_gpuClock || FLAGS_vsyncHz > 0) {
+            exitf(ExitErr::kUsage,
+                  "--perfCounters is not supported with --ddl, --gpuClock or --vsyncHz");
+        }
+        perfCounters.reset(new sk_tools::PerfCounters);
+        if (!perfCounters->isAvailable()) {
+            exitf(ExitErr::kUnavailable, "no hardware counters available");
+        }
+    }
+
     // Run the benchmark.
     std::vector<Sample> samples;
     if (FLAGS_sampleMs > 0) {
@@ -444,11 +580,19 @@ int main(int argc, char** argv) {
     }
     SkCanvas* canvas = surface->getCanvas();
     canvas->translate(-skp->cullRect().x(), -skp->cullRect().y());
-    if (!FLAGS_gpuClock) {
+    if (FLAGS_vsyncHz > 0) {
+        if (FLAGS_ddl || FLAGS_gpuClock) {
+            exitf(ExitErr::kUsage, "--vsyncHz is not supported with --ddl or --gpuClock");
+        }
+        std::vector<PacedFrame> frames;
+        run_paced_benchmark(testCtx->fenceSync(), surface.get(), skp.get(), &frames);
+        print_paced_result(frames, config->getTag().c_str(), srcname.c_str());
+    } else if (!FLAGS_gpuClock) {
         if (FLAGS_ddl) {
             run_ddl_benchmark(testCtx->fenceSync(), ctx, canvas, skp.get(), &samples);
         } else {
-            run_benchmark(testCtx->fenceSync(), surface.get(), skp.get(), &samples);
+            run_benchmark(testCtx->fenceSync(), surface.get(), skp.get(), &samples,
+                          perfCounters.get());
         }
     } else {
         if (FLAGS_ddl) {
@@ -460,7 +604,31 @@ int main(int argc, char** argv) {
         run_gpu_time_benchmark(testCtx->gpuTimer(), testCtx->fenceSync(), surface.get(), skp.get(),
                                &samples);
     }
-    print_result(samples, config->getTag().c_str(), srcname.c_str());
+    if (FLAGS_vsyncHz <= 0) {
+        print_result(samples, config->getTag().c_str(), srcname.c_str());
+    }
+
+    if (FLAGS_opTiming) {
+        testCtx->finish();
+        fprintf(stderr, "   gpu time    chains  op\n");
+        OpTimingPrinter printer;
+        ctx->dumpOpTimings(&printer);
+    }
+
+    if (perfCounters) {
+        int frames = 0;
+        for (const Sample& sample : samples) {
+            frames += sample.fFrames;
+        }
+        fprintf(stderr, "  per frame  counter\n");
+        for (int c = 0; c < sk_tools::PerfCounters::kCounterCount; ++c) {
+            auto counter = (sk_tools::PerfCounters::Counter)c;
+            if (perfCounters->isAvailable(counter)) {
+                fprintf(stderr, "%11.4g  %s\n", (double)perfCounters->read(counter) / frames,
+                        sk_tools::PerfCounters::Name(counter));
+            }
+        }
+    }
 
     // Save a proof (if one was requested).
     if (!FLAGS_png.isEmpty()) {
@@ -142,6 +142,11 @@ int main(int argc, char** argv) {
                 SkDebugf("SK_PICT_BUFFER_SIZE_TAG %d\n", chunkSize);
             }
             break;
+        case SK_PICT_PADDING_TAG:
+            if (FLAGS_tags && !FLAGS_quiet) {
+                SkDebugf("SK_PICT_PADDING_TAG %d\n", chunkSize);
+            }
+            break;
         default:
             if (!FLAGS_quiet) {
                 SkDebugf("Unknown tag %d\n", chunkSize);
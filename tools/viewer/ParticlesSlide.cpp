@@ -10,6 +10,7 @@
 #include "ImGuiLayer.h"
 #include "Resources.h"
 #include "SkAnimTimer.h"
+#include "SkExecutor.h"
 #include "SkOSFile.h"
 #include "SkOSPath.h"
 #include "SkParticleAffector.h"
@@ -324,9 +325,12 @@ void ParticlesSlide::draw(SkCanvas* canvas) {
 
 bool ParticlesSlide::animate(const SkAnimTimer& timer) {
     fTimer = &timer;
+    SkSTArray<16, SkParticleEffect*> effects;
     for (const auto& effect : fRunning) {
-        effect.fEffect->update(timer.secs());
+        effects.push_back(effect.fEffect.get());
     }
+    SkParticleEffect::UpdateAll(effects.begin(), effects.count(), timer.secs(),
+                                &SkExecutor::GetDefault());
     return true;
 }
 
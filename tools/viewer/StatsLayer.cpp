@@ -23,6 +23,10 @@ void StatsLayer::resetMeasurements() {
     for (int i = 0; i < fTimers.count(); ++i) {
         memset(fTimers[i].fTimes, 0, sizeof(fTimers[i].fTimes));
     }
+    for (int i = 0; i < fCounters.count(); ++i) {
+        memset(fCounters[i].fValues, 0, sizeof(fCounters[i].fValues));
+        memset(fCounters[i].fOutOf, 0, sizeof(fCounters[i].fOutOf));
+    }
     fCurrentMeasurement = 0;
     fCumulativeMeasurementTime = 0;
     fCumulativeMeasurementCount = 0;
@@ -46,6 +50,25 @@ void StatsLayer::endTiming(Timer timer) {
     fTimers[timer].fTimes[fCurrentMeasurement] += SkTime::GetMSecs();
 }
 
+void StatsLayer::addTiming(Timer timer, double ms) {
+    fTimers[timer].fTimes[fCurrentMeasurement] += ms;
+}
+
+StatsLayer::Counter StatsLayer::addCounter(const char* label, SkColor color) {
+    Counter newCounter = fCounters.count();
+    CounterData& newData = fCounters.push_back();
+    memset(newData.fValues, 0, sizeof(newData.fValues));
+    memset(newData.fOutOf, 0, sizeof(newData.fOutOf));
+    newData.fLabel = label;
+    newData.fColor = color;
+    return newCounter;
+}
+
+void StatsLayer::setCounter(Counter counter, double value, double outOf) {
+    fCounters[counter].fValues[fCurrentMeasurement] = value;
+    fCounters[counter].fOutOf[fCurrentMeasurement] = outOf;
+}
+
 double StatsLayer::getLastTime(Timer timer) {
     int idx = (fCurrentMeasurement + (kMeasurementCount - 1)) & (kMeasurementCount - 1);
     return fTimers[timer].fTimes[idx];
@@ -62,6 +85,10 @@ void StatsLayer::onPaint(SkSurface* surface) {
     for (int i = 0; i < fTimers.count(); ++i) {
         fTimers[i].fTimes[fCurrentMeasurement] = 0;
     }
+    for (int i = 0; i < fCounters.count(); ++i) {
+        fCounters[i].fValues[fCurrentMeasurement] = 0;
+        fCounters[i].fOutOf[fCurrentMeasurement] = 0;
+    }
 
 #ifdef SK_BUILD_FOR_ANDROID
     // Scale up the stats overlay on Android devices
@@ -72,10 +99,11 @@ void StatsLayer::onPaint(SkSurface* surface) {
 
     // Now draw everything
     static const float kPixelPerMS = 2.0f;
-    static const int kDisplayWidth = 192;
+    static const int kDisplayWidth = 256;
     static const int kGraphHeight = 100;
-    static const int kTextHeight = 60;
-    static const int kDisplayHeight = kGraphHeight + kTextHeight;
+    static const int kLineHeight = 14;
+    const int textHeight = 4 + kLineHeight * (1 + fTimers.count() + fCounters.count());
+    const int displayHeight = kGraphHeight + textHeight;
     static const int kDisplayPadding = 10;
     static const int kGraphPadding = 3;
     static const SkScalar kBaseMS = 1000.f / 60.f;  // ms/frame to hit 60 fps
@@ -84,7 +112,7 @@ void StatsLayer::onPaint(SkSurface* surface) {
     SkISize canvasSize = canvas->getBaseLayerSize();
     SkRect rect = SkRect::MakeXYWH(SkIntToScalar(canvasSize.fWidth-kDisplayWidth-kDisplayPadding),
                                    SkIntToScalar(kDisplayPadding),
-                                   SkIntToScalar(kDisplayWidth), SkIntToScalar(kDisplayHeight));
+                                   SkIntToScalar(kDisplayWidth), SkIntToScalar(displayHeight));
     SkPaint paint;
     canvas->save();
 
@@ -108,7 +136,7 @@ void StatsLayer::onPaint(SkSurface* surface) {
     paint.setStyle(SkPaint::kFill_Style);
 
     int x = SkScalarTruncToInt(rect.fLeft) + kGraphPadding;
-    const int xStep = 3;
+    const int xStep = 4;
     int i = fCurrentMeasurement;
     double ms = 0;
     SkTDArray<double> sumTimes;
@@ -120,7 +148,7 @@ void StatsLayer::onPaint(SkSurface* surface) {
         double inc = 0;
         for (int timer = 0; timer < fTimers.count(); ++timer) {
             int height = (int)(fTimers[timer].fTimes[i] * kPixelPerMS + 0.5);
-            int endY = SkTMax(startY - height, kDisplayPadding + kTextHeight);
+            int endY = SkTMax(startY - height, kDisplayPadding + textHeight);
             paint.setColor(fTimers[timer].fColor);
             canvas->drawLine(SkIntToScalar(x), SkIntToScalar(startY),
                              SkIntToScalar(x), SkIntToScalar(endY), paint);
@@ -146,11 +174,32 @@ void StatsLayer::onPaint(SkSurface* surface) {
     canvas->drawString(SkStringPrintf("%4.3f ms -> %4.3f ms", time, measure),
                        rect.fLeft + 3, rect.fTop + 14, font, paint);
 
+    SkScalar y = rect.fTop + 14;
     for (int timer = 0; timer < fTimers.count(); ++timer) {
+        y += kLineHeight;
         paint.setColor(fTimers[timer].fLabelColor);
         canvas->drawString(SkStringPrintf("%s: %4.3f ms", fTimers[timer].fLabel.c_str(),
                                           sumTimes[timer] / SkTMax(1, count)),
-                           rect.fLeft + 3, rect.fTop + 28 + (14 * timer), font, paint);
+                           rect.fLeft + 3, y, font, paint);
+    }
+
+    for (int counter = 0; counter < fCounters.count(); ++counter) {
+        const CounterData& data = fCounters[counter];
+        double sumValues = 0, sumOutOf = 0;
+        for (int j = 0; j < kMeasurementCount; ++j) {
+            sumValues += data.fValues[j];
+            sumOutOf += data.fOutOf[j];
+        }
+        SkString text;
+        if (sumOutOf > 0) {
+            text.printf("%s: %3.1f%% of %.1f", data.fLabel.c_str(), 100 * sumValues / sumOutOf,
+                        sumOutOf / SkTMax(1, count));
+        } else {
+            text.printf("%s: %.1f", data.fLabel.c_str(), sumValues / SkTMax(1, count));
+        }
+        y += kLineHeight;
+        paint.setColor(data.fColor);
+        canvas->drawString(text, rect.fLeft + 3, y, font, paint);
     }
 
     canvas->restore();
@@ -22,8 +22,17 @@ public:
     Timer addTimer(const char* label, SkColor color, SkColor labelColor = 0);
     void beginTiming(Timer);
     void endTiming(Timer);
+    // Adds time measured some other way, e.g. by GrContext, to this frame's timing.
+    void addTiming(Timer, double ms);
     double getLastTime(Timer);
 
+    typedef int Counter;
+
+    // Counters are listed under the timers, averaged over the frames in the graph. A counter set
+    // with outOf, e.g. cache hits out of lookups, is shown as a percentage.
+    Counter addCounter(const char* label, SkColor color);
+    void setCounter(Counter, double value, double outOf = 0);
+
     void onPaint(SkSurface*) override;
 
     void setDisplayScale(float scale) { fDisplayScale = scale; }
@@ -37,6 +46,13 @@ private:
         SkColor fLabelColor;
     };
     SkTArray<TimerData> fTimers;
+    struct CounterData {
+        double fValues[kMeasurementCount];
+        double fOutOf[kMeasurementCount];
+        SkString fLabel;
+        SkColor fColor;
+    };
+    SkTArray<CounterData> fCounters;
     int fCurrentMeasurement;
     double fCumulativeMeasurementTime;
     int fCumulativeMeasurementCount;
@@ -25,6 +25,7 @@ void SvgSlide::load(SkScalar w, SkScalar h) {
         fDom = SkSVGDOM::MakeFromStream(*svgStream);
         if (fDom) {
             fDom->setContainerSize(fWinSize);
+            fDom->setCacheRendering(true);
         }
     }
 }
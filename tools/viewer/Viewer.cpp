@@ -9,6 +9,8 @@
 #include "GMSlide.h"
 #include "GrContext.h"
 #include "GrContextPriv.h"
+#include "GrGpu.h"
+#include "GrOpTimingDump.h"
 #include "ImageSlide.h"
 #include "ParticlesSlide.h"
 #include "Resources.h"
@@ -41,6 +43,7 @@
 #include "ccpr/GrCoverageCountingPathRenderer.h"
 
 #include <stdlib.h>
+#include <algorithm>
 #include <map>
 
 #include "imgui.h"
@@ -256,6 +259,13 @@ Viewer::Viewer(int argc, char** argv, void* platformData)
     fAnimateTimer = fStatsLayer.addTimer("Animate", SK_ColorMAGENTA, 0xffff66ff);
     fPaintTimer = fStatsLayer.addTimer("Paint", SK_ColorGREEN);
     fFlushTimer = fStatsLayer.addTimer("Flush", SK_ColorRED, 0xffff6666);
+    fSubmitTimer = fStatsLayer.addTimer("Submit", SK_ColorYELLOW);
+    fGpuTimer = fStatsLayer.addTimer("GPU wait", SK_ColorCYAN);
+    fFontCacheCounter = fStatsLayer.addCounter("Strike hits", SK_ColorWHITE);
+    fResourceCacheCounter = fStatsLayer.addCounter("Resource hits", SK_ColorWHITE);
+    fTextureCacheCounter = fStatsLayer.addCounter("Texture hits", SK_ColorWHITE);
+    fAtlasUploadCounter = fStatsLayer.addCounter("Atlas uploads", SK_ColorWHITE);
+    fCompileCounter = fStatsLayer.addCounter("Compiles", SK_ColorWHITE);
 
     // register callbacks
     fCommands.attach(fWindow);
@@ -296,6 +306,10 @@ Viewer::Viewer(int argc, char** argv, void* platformData)
         fStatsLayer.setActive(!fStatsLayer.getActive());
         fWindow->inval();
     });
+    fCommands.addCommand('W', "Overlays", "Toggle waiting for the GPU in stats", [this]() {
+        fStatsWaitForGpu = !fStatsWaitForGpu;
+        fWindow->inval();
+    });
     fCommands.addCommand('0', "Overlays", "Reset stats", [this]() {
         fStatsLayer.resetMeasurements();
         this->updateTitle();
@@ -1165,6 +1179,50 @@ public:
     Viewer::SkFontFields* fFontOverrides;
 };
 
+static double gpu_submit_ms(GrContext* ctx) {
+#if GR_GPU_STATS
+    return ctx ? ctx->priv().getGpu()->stats()->submitMs() : 0;
+#else
+    return 0;
+#endif
+}
+
+void Viewer::updateStatsCounters() {
+    StatsCounts counts;
+    counts.fFontCacheHits = SkGraphics::GetFontCacheHitCount();
+    counts.fFontCacheMisses = SkGraphics::GetFontCacheMissCount();
+    counts.fResourceCacheHits = SkGraphics::GetResourceCacheHitCount();
+    counts.fResourceCacheMisses = SkGraphics::GetResourceCacheMissCount();
+#if GR_GPU_STATS
+    if (GrContext* ctx = fWindow->getGrContext()) {
+        GrGpu::Stats* stats = ctx->priv().getGpu()->stats();
+        counts.fTextureCacheHits = stats->textureCacheHits();
+        counts.fTextureCacheMisses = stats->textureCacheMisses();
+        counts.fAtlasUploads = stats->atlasUploads();
+        counts.fCompiles = stats->shaderCompilations();
+    }
+#endif
+    const StatsCounts& last = fLastStatsCounts;
+
+    // The totals start over when the backend, and with it the GrContext, changes.
+    auto delta = [](int64_t now, int64_t last) { return (double)SkTMax<int64_t>(now - last, 0); };
+    auto setRate = [&](StatsLayer::Counter counter, int64_t hits, int64_t lastHits,
+                       int64_t misses, int64_t lastMisses) {
+        double hitDelta = delta(hits, lastHits);
+        fStatsLayer.setCounter(counter, hitDelta, hitDelta + delta(misses, lastMisses));
+    };
+    setRate(fFontCacheCounter, counts.fFontCacheHits, last.fFontCacheHits,
+            counts.fFontCacheMisses, last.fFontCacheMisses);
+    setRate(fResourceCacheCounter, counts.fResourceCacheHits, last.fResourceCacheHits,
+            counts.fResourceCacheMisses, last.fResourceCacheMisses);
+    setRate(fTextureCacheCounter, counts.fTextureCacheHits, last.fTextureCacheHits,
+            counts.fTextureCacheMisses, last.fTextureCacheMisses);
+    fStatsLayer.setCounter(fAtlasUploadCounter, delta(counts.fAtlasUploads, last.fAtlasUploads));
+    fStatsLayer.setCounter(fCompileCounter, delta(counts.fCompiles, last.fCompiles));
+
+    fLastStatsCounts = counts;
+}
+
 void Viewer::drawSlide(SkSurface* surface) {
     if (fCurrentSlide < 0) {
         return;
@@ -1270,10 +1328,23 @@ void Viewer::drawSlide(SkSurface* surface) {
     fStatsLayer.endTiming(fPaintTimer);
     slideCanvas->restoreToCount(count);
 
-    // Force a flush so we can time that, too
+    // Force a flush so we can time that, too. With a GPU, the part of it spent submitting the
+    // work to the backend is charted on its own.
+    GrContext* ctx = fWindow->getGrContext();
+    double submitMs = gpu_submit_ms(ctx);
     fStatsLayer.beginTiming(fFlushTimer);
     slideSurface->flush();
     fStatsLayer.endTiming(fFlushTimer);
+    submitMs = gpu_submit_ms(ctx) - submitMs;
+    fStatsLayer.addTiming(fFlushTimer, -submitMs);
+    fStatsLayer.addTiming(fSubmitTimer, submitMs);
+
+    if (ctx && fStatsWaitForGpu && fStatsLayer.getActive()) {
+        fStatsLayer.beginTiming(fGpuTimer);
+        ctx->flush(kSyncCpu_GrFlushFlag, 0, nullptr);
+        fStatsLayer.endTiming(fGpuTimer);
+    }
+    this->updateStatsCounters();
 
     // If we rendered offscreen, snap an image and push the results to the window's canvas
     if (offscreenSurface) {
@@ -1908,6 +1979,47 @@ void Viewer::drawImGui() {
                     fAnimTimer.setSpeed(speed);
                 }
             }
+
+            if (ImGui::CollapsingHeader("GPU Op Timing")) {
+                GrContext* ctx = fWindow->getGrContext();
+                if (ImGui::Checkbox("Time ops", &fOpTiming)) {
+                    if (ctx && !fOpTiming) {
+                        ctx->setOpTimingEnabled(false);
+                    }
+                    fOpTimings.reset();
+                }
+                // Enable it again every frame, in case the backend (and context) changed.
+                if (fOpTiming && (!ctx || !ctx->setOpTimingEnabled(true))) {
+                    ImGui::Text("Not supported by this backend");
+                } else if (fOpTiming) {
+                    class Collector : public GrOpTimingDump {
+                    public:
+                        void dumpOpTiming(const char* name, int count, uint64_t ns) override {
+                            fTimings.push_back({SkString(name), count, ns / 1e6});
+                        }
+                        SkTArray<OpTiming> fTimings;
+                    } collector;
+                    ctx->dumpOpTimings(&collector);
+                    // Results arrive a few frames late, keep showing the last ones until then.
+                    if (!collector.fTimings.empty()) {
+                        fOpTimings = std::move(collector.fTimings);
+                        std::sort(fOpTimings.begin(), fOpTimings.end(),
+                                  [](const OpTiming& a, const OpTiming& b) {
+                                      return a.fMs > b.fMs;
+                                  });
+                    }
+                    ImGui::Columns(3, "OpTimings");
+                    ImGui::Text("GPU ms"); ImGui::NextColumn();
+                    ImGui::Text("Count"); ImGui::NextColumn();
+                    ImGui::Text("Op"); ImGui::NextColumn();
+                    for (const OpTiming& timing : fOpTimings) {
+                        ImGui::Text("%.3f", timing.fMs); ImGui::NextColumn();
+                        ImGui::Text("%d", timing.fCount); ImGui::NextColumn();
+                        ImGui::Text("%s", timing.fName.c_str()); ImGui::NextColumn();
+                    }
+                    ImGui::Columns(1);
+                }
+            }
         }
         if (paramsChanged) {
             fDeferredActions.push_back([=]() {
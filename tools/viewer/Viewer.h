@@ -105,6 +105,7 @@ private:
 
     void drawSlide(SkSurface* surface);
     void drawImGui();
+    void updateStatsCounters();
 
     void changeZoomLevel(float delta);
     void preTouchMatrixChanged();
@@ -118,7 +119,30 @@ private:
     StatsLayer             fStatsLayer;
     StatsLayer::Timer      fPaintTimer;
     StatsLayer::Timer      fFlushTimer;
+    StatsLayer::Timer      fSubmitTimer;
+    StatsLayer::Timer      fGpuTimer;
     StatsLayer::Timer      fAnimateTimer;
+    // Waiting for the GPU to finish each frame shows its time, but stops the CPU and GPU from
+    // overlapping, so it is off by default.
+    bool                   fStatsWaitForGpu = false;
+
+    StatsLayer::Counter    fFontCacheCounter;
+    StatsLayer::Counter    fResourceCacheCounter;
+    StatsLayer::Counter    fTextureCacheCounter;
+    StatsLayer::Counter    fAtlasUploadCounter;
+    StatsLayer::Counter    fCompileCounter;
+    // The running totals the counters were last updated from.
+    struct StatsCounts {
+        int64_t fFontCacheHits = 0;
+        int64_t fFontCacheMisses = 0;
+        int64_t fResourceCacheHits = 0;
+        int64_t fResourceCacheMisses = 0;
+        int64_t fTextureCacheHits = 0;
+        int64_t fTextureCacheMisses = 0;
+        int64_t fAtlasUploads = 0;
+        int64_t fCompiles = 0;
+    };
+    StatsCounts            fLastStatsCounts;
 
     SkAnimTimer            fAnimTimer;
     SkTArray<sk_sp<Slide>> fSlides;
@@ -140,6 +164,15 @@ private:
     sk_sp<SkImage>         fLastImage;
     bool                   fZoomUI;
 
+    // GPU time per op class from GrContext::dumpOpTimings(), shown in the Tools window.
+    struct OpTiming {
+        SkString fName;
+        int      fCount;
+        double   fMs;
+    };
+    bool                   fOpTiming = false;
+    SkTArray<OpTiming>     fOpTimings;
+
     sk_app::Window::BackendType fBackendType;
 
     // Color properties for slide rendering